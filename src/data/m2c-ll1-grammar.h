@@ -0,0 +1,645 @@
+/* Modula-2 BSK grammar in LL(1) form for utility gen-ll1-table */
+
+/* #define RULE(_allcaps, ...)  -- _allcaps := symbol1 symbol2 ... */
+/* #define T(_token)     -- terminal symbol */
+/* #define N(_allcaps)   -- non-terminal symbol */
+/* #define EMPTY         -- empty right hand side */
+
+/* The EBNF of grammar/m2c-grammar.gll  desugared into BNF.  Repetitions are
+ * right recursive tail rules,  options are rules with an empty alternative.
+ * Where the EBNF is not LL(1),  the rules are left factored:  the update and
+ * call statements share a single designator rule,  casting formal types are
+ * folded into simple formal types  as Schroedinger's Tokens CAST and ADDRESS
+ * lex as identifiers  and value components do not distinguish constant and
+ * runtime expressions.  The start symbol must come first.  */
+
+/* Compilation Unit */
+
+RULE(COMPILATION_UNIT, N(INTERFACE_MODULE))
+RULE(COMPILATION_UNIT, N(IMPLEMENTATION_MODULE))
+RULE(COMPILATION_UNIT, N(PROGRAM_MODULE))
+
+/* Interface Module */
+
+RULE(INTERFACE_MODULE,
+  T(TOKEN_INTERFACE), T(TOKEN_MODULE), T(TOKEN_IDENT), T(TOKEN_SEMICOLON),
+  N(IMPORT_LIST), N(DECLARATION_LIST), T(TOKEN_END), T(TOKEN_IDENT),
+  T(TOKEN_DOT), T(TOKEN_EOF))
+
+RULE(IMPORT_LIST, N(IMPORT), N(IMPORT_LIST))
+RULE(IMPORT_LIST, EMPTY)
+
+RULE(IMPORT,
+  T(TOKEN_IMPORT), T(TOKEN_IDENT), N(RE_EXPORT), N(IMPORT_TAIL),
+  T(TOKEN_SEMICOLON))
+
+RULE(IMPORT_TAIL,
+  T(TOKEN_COMMA), T(TOKEN_IDENT), N(RE_EXPORT), N(IMPORT_TAIL))
+RULE(IMPORT_TAIL, EMPTY)
+
+RULE(RE_EXPORT, T(TOKEN_PLUS))
+RULE(RE_EXPORT, EMPTY)
+
+RULE(DECLARATION_LIST, N(DECLARATION), N(DECLARATION_LIST))
+RULE(DECLARATION_LIST, EMPTY)
+
+RULE(DECLARATION,
+  T(TOKEN_CONST), N(CONST_DEFINITION), T(TOKEN_SEMICOLON),
+  N(CONST_DEFINITION_TAIL))
+RULE(DECLARATION,
+  T(TOKEN_TYPE), N(TYPE_DEFINITION), T(TOKEN_SEMICOLON),
+  N(TYPE_DEFINITION_TAIL))
+RULE(DECLARATION,
+  T(TOKEN_VAR), N(VAR_DEFINITION), T(TOKEN_SEMICOLON),
+  N(VAR_DEFINITION_TAIL))
+RULE(DECLARATION, N(PROCEDURE_HEADER), T(TOKEN_SEMICOLON))
+RULE(DECLARATION, N(TO_DO_LIST), T(TOKEN_SEMICOLON))
+
+/* Constant Definition */
+
+RULE(CONST_DEFINITION_TAIL,
+  N(CONST_DEFINITION), T(TOKEN_SEMICOLON), N(CONST_DEFINITION_TAIL))
+RULE(CONST_DEFINITION_TAIL, EMPTY)
+
+RULE(CONST_DEFINITION,
+  N(CONST_BINDING), T(TOKEN_IDENT), N(CONST_TYPE), T(TOKEN_EQUAL),
+  N(EXPRESSION))
+
+RULE(CONST_BINDING, T(TOKEN_LBRACKET), T(TOKEN_IDENT), T(TOKEN_RBRACKET))
+RULE(CONST_BINDING, EMPTY)
+
+RULE(CONST_TYPE, T(TOKEN_COLON), N(QUALIDENT))
+RULE(CONST_TYPE, EMPTY)
+
+/* Qualified Identifier */
+
+RULE(QUALIDENT, T(TOKEN_IDENT), N(QUALIDENT_TAIL))
+
+RULE(QUALIDENT_TAIL, T(TOKEN_DOT), T(TOKEN_IDENT), N(QUALIDENT_TAIL))
+RULE(QUALIDENT_TAIL, EMPTY)
+
+/* Type Definition */
+
+RULE(TYPE_DEFINITION_TAIL,
+  N(TYPE_DEFINITION), T(TOKEN_SEMICOLON), N(TYPE_DEFINITION_TAIL))
+RULE(TYPE_DEFINITION_TAIL, EMPTY)
+
+RULE(TYPE_DEFINITION, T(TOKEN_IDENT), T(TOKEN_EQUAL), N(PUBLIC_TYPE))
+
+RULE(PUBLIC_TYPE, N(ALIAS_TYPE))
+RULE(PUBLIC_TYPE, N(QUALIDENT))
+RULE(PUBLIC_TYPE, N(SUBRANGE_TYPE))
+RULE(PUBLIC_TYPE, N(ENUM_TYPE))
+RULE(PUBLIC_TYPE, N(SET_TYPE))
+RULE(PUBLIC_TYPE, N(ARRAY_TYPE))
+RULE(PUBLIC_TYPE, N(RECORD_TYPE))
+RULE(PUBLIC_TYPE, N(POINTER_TYPE))
+RULE(PUBLIC_TYPE, N(OPAQUE_TYPE))
+RULE(PUBLIC_TYPE, N(PROCEDURE_TYPE))
+
+RULE(ALIAS_TYPE, T(TOKEN_ALIAS), T(TOKEN_OF), N(QUALIDENT))
+
+RULE(SUBRANGE_TYPE, N(VALUE_RANGE), T(TOKEN_OF), N(QUALIDENT))
+
+RULE(VALUE_RANGE,
+  T(TOKEN_LBRACKET), N(EXPRESSION), T(TOKEN_DOT_DOT), N(EXPRESSION),
+  T(TOKEN_RBRACKET))
+
+RULE(ENUM_TYPE,
+  T(TOKEN_LPAREN), N(ENUM_BASE), N(IDENT_LIST), T(TOKEN_RPAREN))
+
+RULE(ENUM_BASE, T(TOKEN_PLUS), N(QUALIDENT), T(TOKEN_COMMA))
+RULE(ENUM_BASE, EMPTY)
+
+RULE(IDENT_LIST, T(TOKEN_IDENT), N(IDENT_LIST_TAIL))
+
+RULE(IDENT_LIST_TAIL, T(TOKEN_COMMA), T(TOKEN_IDENT), N(IDENT_LIST_TAIL))
+RULE(IDENT_LIST_TAIL, EMPTY)
+
+RULE(SET_TYPE, T(TOKEN_SET), T(TOKEN_OF), N(QUALIDENT))
+
+RULE(ARRAY_TYPE, T(TOKEN_ARRAY), N(EXPRESSION), T(TOKEN_OF), N(QUALIDENT))
+
+RULE(RECORD_TYPE,
+  T(TOKEN_RECORD), N(RECORD_BASE), N(VAR_DEFINITION), N(FIELD_LIST_TAIL),
+  T(TOKEN_END))
+
+RULE(RECORD_BASE, T(TOKEN_LPAREN), N(QUALIDENT), T(TOKEN_RPAREN))
+RULE(RECORD_BASE, EMPTY)
+
+RULE(FIELD_LIST_TAIL, T(TOKEN_SEMICOLON), N(VAR_DEFINITION), N(FIELD_LIST_TAIL))
+RULE(FIELD_LIST_TAIL, EMPTY)
+
+RULE(POINTER_TYPE, T(TOKEN_POINTER), T(TOKEN_TO), N(QUALIDENT))
+
+RULE(OPAQUE_TYPE, T(TOKEN_OPAQUE), N(ALLOC_SIZE))
+
+RULE(ALLOC_SIZE, T(TOKEN_LBRACKET), N(EXPRESSION), T(TOKEN_RBRACKET))
+RULE(ALLOC_SIZE, EMPTY)
+
+/* Procedure Type */
+
+RULE(PROCEDURE_TYPE, T(TOKEN_PROCEDURE), N(FORMAL_TYPE_LIST), N(RETURN_TYPE))
+
+RULE(FORMAL_TYPE_LIST,
+  T(TOKEN_LPAREN), N(FORMAL_TYPE), N(FORMAL_TYPE_TAIL), T(TOKEN_RPAREN))
+RULE(FORMAL_TYPE_LIST, EMPTY)
+
+RULE(FORMAL_TYPE_TAIL, T(TOKEN_SEMICOLON), N(FORMAL_TYPE), N(FORMAL_TYPE_TAIL))
+RULE(FORMAL_TYPE_TAIL, EMPTY)
+
+RULE(RETURN_TYPE, T(TOKEN_COLON), N(QUALIDENT))
+RULE(RETURN_TYPE, EMPTY)
+
+RULE(FORMAL_TYPE, N(ATTRIBUTE), N(NON_ATTR_FORMAL_TYPE))
+
+RULE(ATTRIBUTE, T(TOKEN_CONST))
+RULE(ATTRIBUTE, T(TOKEN_VAR))
+RULE(ATTRIBUTE, EMPTY)
+
+RULE(NON_ATTR_FORMAL_TYPE, N(SIMPLE_FORMAL_TYPE))
+RULE(NON_ATTR_FORMAL_TYPE, T(TOKEN_ARGLIST), T(TOKEN_OF), N(SIMPLE_FORMAL_TYPE))
+
+RULE(SIMPLE_FORMAL_TYPE, T(TOKEN_ARRAY), T(TOKEN_OF), N(QUALIDENT))
+RULE(SIMPLE_FORMAL_TYPE, N(QUALIDENT), N(CAST_TARGET))
+
+RULE(CAST_TARGET, T(TOKEN_OCTETSEQ))
+RULE(CAST_TARGET, T(TOKEN_IDENT))
+RULE(CAST_TARGET, EMPTY)
+
+/* Variable Definition */
+
+RULE(VAR_DEFINITION_TAIL,
+  N(VAR_DEFINITION), T(TOKEN_SEMICOLON), N(VAR_DEFINITION_TAIL))
+RULE(VAR_DEFINITION_TAIL, EMPTY)
+
+RULE(VAR_DEFINITION, N(IDENT_LIST), T(TOKEN_COLON), N(VAR_TYPE))
+
+RULE(VAR_TYPE, N(QUALIDENT))
+RULE(VAR_TYPE, N(SUBRANGE_TYPE))
+RULE(VAR_TYPE, N(ARRAY_TYPE))
+RULE(VAR_TYPE, N(PROCEDURE_TYPE))
+
+/* Procedure Header */
+
+RULE(PROCEDURE_HEADER,
+  T(TOKEN_PROCEDURE), N(PROC_BINDING), T(TOKEN_IDENT), N(FORMAL_PARAM_LIST),
+  N(RETURN_TYPE))
+
+RULE(PROC_BINDING,
+  T(TOKEN_LBRACKET), N(BINDING_SPECIFIER), T(TOKEN_RBRACKET))
+RULE(PROC_BINDING, EMPTY)
+
+RULE(BINDING_SPECIFIER, T(TOKEN_NEW), N(NEW_BINDING))
+RULE(BINDING_SPECIFIER, T(TOKEN_RETAIN))
+RULE(BINDING_SPECIFIER, T(TOKEN_RELEASE))
+RULE(BINDING_SPECIFIER, T(TOKEN_READ), N(READ_BINDING))
+RULE(BINDING_SPECIFIER, T(TOKEN_WRITE), N(WRITE_BINDING))
+RULE(BINDING_SPECIFIER, T(TOKEN_IDENT))
+
+RULE(NEW_BINDING, T(TOKEN_ARGLIST))
+RULE(NEW_BINDING, T(TOKEN_IDENT))
+RULE(NEW_BINDING, EMPTY)
+
+RULE(READ_BINDING, T(TOKEN_NEW))
+RULE(READ_BINDING, EMPTY)
+
+RULE(WRITE_BINDING, T(TOKEN_HASH))
+RULE(WRITE_BINDING, EMPTY)
+
+RULE(FORMAL_PARAM_LIST,
+  T(TOKEN_LPAREN), N(FORMAL_PARAMS), N(FORMAL_PARAMS_TAIL), T(TOKEN_RPAREN))
+RULE(FORMAL_PARAM_LIST, EMPTY)
+
+RULE(FORMAL_PARAMS_TAIL,
+  T(TOKEN_SEMICOLON), N(FORMAL_PARAMS), N(FORMAL_PARAMS_TAIL))
+RULE(FORMAL_PARAMS_TAIL, EMPTY)
+
+RULE(FORMAL_PARAMS,
+  N(ATTRIBUTE), N(IDENT_LIST), T(TOKEN_COLON), N(NON_ATTR_FORMAL_TYPE))
+
+/* Program Module */
+
+RULE(PROGRAM_MODULE,
+  T(TOKEN_MODULE), T(TOKEN_IDENT), T(TOKEN_SEMICOLON),
+  N(PRIVATE_IMPORT_LIST), N(BLOCK), T(TOKEN_IDENT), T(TOKEN_DOT),
+  T(TOKEN_EOF))
+
+RULE(PRIVATE_IMPORT_LIST, N(PRIVATE_IMPORT), N(PRIVATE_IMPORT_LIST))
+RULE(PRIVATE_IMPORT_LIST, EMPTY)
+
+RULE(PRIVATE_IMPORT,
+  T(TOKEN_IMPORT), T(TOKEN_IDENT), N(IDENT_LIST_TAIL), T(TOKEN_SEMICOLON))
+
+RULE(BLOCK,
+  N(DEFINITION_LIST), T(TOKEN_BEGIN), N(STATEMENT_SEQUENCE), T(TOKEN_END))
+
+RULE(DEFINITION_LIST, N(DEFINITION), N(DEFINITION_LIST))
+RULE(DEFINITION_LIST, EMPTY)
+
+RULE(DEFINITION,
+  T(TOKEN_CONST), N(CONST_DEFINITION), T(TOKEN_SEMICOLON),
+  N(CONST_DEFINITION_TAIL))
+RULE(DEFINITION,
+  T(TOKEN_TYPE), N(PGM_TYPE_DEFINITION), T(TOKEN_SEMICOLON),
+  N(PGM_TYPE_DEFINITION_TAIL))
+RULE(DEFINITION,
+  T(TOKEN_VAR), N(VAR_DEFINITION), T(TOKEN_SEMICOLON),
+  N(VAR_DEFINITION_TAIL))
+RULE(DEFINITION, N(PROCEDURE_DEFINITION), T(TOKEN_SEMICOLON))
+RULE(DEFINITION, N(ALIAS_DEFINITION), T(TOKEN_SEMICOLON))
+RULE(DEFINITION, N(TO_DO_LIST), T(TOKEN_SEMICOLON))
+
+RULE(PGM_TYPE_DEFINITION_TAIL,
+  N(PGM_TYPE_DEFINITION), T(TOKEN_SEMICOLON), N(PGM_TYPE_DEFINITION_TAIL))
+RULE(PGM_TYPE_DEFINITION_TAIL, EMPTY)
+
+RULE(PGM_TYPE_DEFINITION, T(TOKEN_IDENT), T(TOKEN_EQUAL), N(PROGRAM_TYPE))
+
+RULE(PROGRAM_TYPE, N(ALIAS_TYPE))
+RULE(PROGRAM_TYPE, N(QUALIDENT))
+RULE(PROGRAM_TYPE, N(SUBRANGE_TYPE))
+RULE(PROGRAM_TYPE, N(ENUM_TYPE))
+RULE(PROGRAM_TYPE, N(SET_TYPE))
+RULE(PROGRAM_TYPE, N(ARRAY_TYPE))
+RULE(PROGRAM_TYPE, N(RECORD_TYPE))
+RULE(PROGRAM_TYPE, N(POINTER_TYPE))
+RULE(PROGRAM_TYPE, N(PROCEDURE_TYPE))
+
+RULE(PROCEDURE_DEFINITION,
+  N(PROCEDURE_HEADER), T(TOKEN_SEMICOLON), N(BLOCK), T(TOKEN_IDENT))
+
+/* Implementation Module */
+
+RULE(IMPLEMENTATION_MODULE,
+  T(TOKEN_IMPLEMENTATION), T(TOKEN_MODULE), T(TOKEN_IDENT),
+  T(TOKEN_SEMICOLON), N(PRIVATE_IMPORT_LIST), N(PRIVATE_BLOCK),
+  T(TOKEN_IDENT), T(TOKEN_DOT), T(TOKEN_EOF))
+
+RULE(PRIVATE_BLOCK, N(PRIVATE_DEFINITION_LIST), N(MODULE_BODY), T(TOKEN_END))
+
+RULE(MODULE_BODY, T(TOKEN_BEGIN), N(STATEMENT_SEQUENCE))
+RULE(MODULE_BODY, EMPTY)
+
+RULE(PRIVATE_DEFINITION_LIST,
+  N(PRIVATE_DEFINITION), N(PRIVATE_DEFINITION_LIST))
+RULE(PRIVATE_DEFINITION_LIST, EMPTY)
+
+RULE(PRIVATE_DEFINITION,
+  T(TOKEN_CONST), N(CONST_DEFINITION), T(TOKEN_SEMICOLON),
+  N(CONST_DEFINITION_TAIL))
+RULE(PRIVATE_DEFINITION,
+  T(TOKEN_TYPE), N(IMP_TYPE_DEFINITION), T(TOKEN_SEMICOLON),
+  N(IMP_TYPE_DEFINITION_TAIL))
+RULE(PRIVATE_DEFINITION,
+  T(TOKEN_VAR), N(VAR_DEFINITION), T(TOKEN_SEMICOLON),
+  N(VAR_DEFINITION_TAIL))
+RULE(PRIVATE_DEFINITION, N(PROCEDURE_DEFINITION), T(TOKEN_SEMICOLON))
+RULE(PRIVATE_DEFINITION, N(ALIAS_DEFINITION), T(TOKEN_SEMICOLON))
+RULE(PRIVATE_DEFINITION, N(TO_DO_LIST), T(TOKEN_SEMICOLON))
+
+RULE(IMP_TYPE_DEFINITION_TAIL,
+  N(IMP_TYPE_DEFINITION), T(TOKEN_SEMICOLON), N(IMP_TYPE_DEFINITION_TAIL))
+RULE(IMP_TYPE_DEFINITION_TAIL, EMPTY)
+
+RULE(IMP_TYPE_DEFINITION,
+  T(TOKEN_IDENT), T(TOKEN_EQUAL), N(IMPLEMENTATION_TYPE))
+
+RULE(IMPLEMENTATION_TYPE, N(ALIAS_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(QUALIDENT))
+RULE(IMPLEMENTATION_TYPE, N(SUBRANGE_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(ENUM_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(SET_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(ARRAY_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(RECORD_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(PRIVATE_POINTER_TYPE))
+RULE(IMPLEMENTATION_TYPE, N(PROCEDURE_TYPE))
+
+RULE(PRIVATE_POINTER_TYPE, T(TOKEN_POINTER), T(TOKEN_TO), N(POINTER_TARGET))
+
+RULE(POINTER_TARGET, N(QUALIDENT))
+RULE(POINTER_TARGET, T(TOKEN_RECORD), N(INDETERMINATE_FIELDS), T(TOKEN_END))
+
+RULE(INDETERMINATE_FIELDS,
+  N(VAR_DEFINITION), T(TOKEN_SEMICOLON), N(INDETERMINATE_FIELDS))
+RULE(INDETERMINATE_FIELDS,
+  T(TOKEN_PLUS), T(TOKEN_IDENT), T(TOKEN_COLON), T(TOKEN_ARRAY),
+  T(TOKEN_IDENT), T(TOKEN_OF), N(QUALIDENT))
+
+/* Alias Definition */
+
+RULE(ALIAS_DEFINITION,
+  T(TOKEN_UNQUALIFIED), N(NAME_SELECTOR), N(NAME_SELECTOR_TAIL))
+
+RULE(NAME_SELECTOR_TAIL,
+  T(TOKEN_COMMA), N(NAME_SELECTOR), N(NAME_SELECTOR_TAIL))
+RULE(NAME_SELECTOR_TAIL, EMPTY)
+
+RULE(NAME_SELECTOR, N(QUALIDENT), N(WILDCARD))
+
+RULE(WILDCARD, T(TOKEN_WILDCARD))
+RULE(WILDCARD, EMPTY)
+
+/* Statement Sequence */
+
+RULE(STATEMENT_SEQUENCE, N(STATEMENT), N(STATEMENT_TAIL))
+
+RULE(STATEMENT_TAIL, T(TOKEN_SEMICOLON), N(STATEMENT), N(STATEMENT_TAIL))
+RULE(STATEMENT_TAIL, EMPTY)
+
+RULE(STATEMENT, T(TOKEN_NEW), N(DESIGNATOR), N(NEW_TAIL))
+RULE(STATEMENT, T(TOKEN_RETAIN), N(DESIGNATOR))
+RULE(STATEMENT, T(TOKEN_RELEASE), N(DESIGNATOR))
+RULE(STATEMENT, N(TARGET_DESIGNATOR), N(UPDATE_OR_CALL_TAIL))
+RULE(STATEMENT, T(TOKEN_RETURN), N(RETURN_VALUE))
+RULE(STATEMENT,
+  T(TOKEN_COPY), N(TARGET_DESIGNATOR), T(TOKEN_ASSIGN), N(EXPRESSION))
+RULE(STATEMENT,
+  T(TOKEN_READ), N(CHANNEL), N(INPUT_ARG), N(INPUT_ARG_TAIL))
+RULE(STATEMENT,
+  T(TOKEN_WRITE), N(CHANNEL), N(OUTPUT_ARGS), N(OUTPUT_ARGS_TAIL))
+RULE(STATEMENT, N(IF_STATEMENT))
+RULE(STATEMENT, N(CASE_STATEMENT))
+RULE(STATEMENT, T(TOKEN_LOOP), N(STATEMENT_SEQUENCE), T(TOKEN_END))
+RULE(STATEMENT,
+  T(TOKEN_WHILE), N(EXPRESSION), T(TOKEN_DO), N(STATEMENT_SEQUENCE),
+  T(TOKEN_END))
+RULE(STATEMENT,
+  T(TOKEN_REPEAT), N(STATEMENT_SEQUENCE), T(TOKEN_UNTIL), N(EXPRESSION))
+RULE(STATEMENT, N(FOR_STATEMENT))
+RULE(STATEMENT, N(TO_DO_LIST))
+RULE(STATEMENT, T(TOKEN_EXIT))
+RULE(STATEMENT, T(TOKEN_NOP))
+
+RULE(NEW_TAIL, T(TOKEN_ASSIGN), N(STRUCTURED_VALUE))
+RULE(NEW_TAIL, T(TOKEN_IDENT), N(EXPRESSION))
+RULE(NEW_TAIL, EMPTY)
+
+RULE(UPDATE_OR_CALL_TAIL, T(TOKEN_ASSIGN), N(EXPRESSION))
+RULE(UPDATE_OR_CALL_TAIL, T(TOKEN_PLUS_PLUS))
+RULE(UPDATE_OR_CALL_TAIL, T(TOKEN_MINUS_MINUS))
+RULE(UPDATE_OR_CALL_TAIL, N(FUNCTION_CALL_TAIL))
+RULE(UPDATE_OR_CALL_TAIL, EMPTY)
+
+RULE(RETURN_VALUE, N(EXPRESSION))
+RULE(RETURN_VALUE, EMPTY)
+
+/* READ and WRITE Statement */
+
+RULE(CHANNEL, T(TOKEN_AT_SIGN), N(DESIGNATOR), T(TOKEN_COLON))
+RULE(CHANNEL, EMPTY)
+
+RULE(INPUT_ARG, T(TOKEN_NEW), N(DESIGNATOR))
+RULE(INPUT_ARG, N(DESIGNATOR))
+
+RULE(INPUT_ARG_TAIL, T(TOKEN_COMMA), N(INPUT_ARG), N(INPUT_ARG_TAIL))
+RULE(INPUT_ARG_TAIL, EMPTY)
+
+RULE(OUTPUT_ARGS,
+  T(TOKEN_HASH), T(TOKEN_LPAREN), N(EXPRESSION), T(TOKEN_COMMA),
+  N(EXPRESSION_LIST), T(TOKEN_RPAREN))
+RULE(OUTPUT_ARGS, N(EXPRESSION))
+
+RULE(OUTPUT_ARGS_TAIL, T(TOKEN_COMMA), N(OUTPUT_ARGS), N(OUTPUT_ARGS_TAIL))
+RULE(OUTPUT_ARGS_TAIL, EMPTY)
+
+/* IF Statement */
+
+RULE(IF_STATEMENT,
+  T(TOKEN_IF), N(EXPRESSION), T(TOKEN_THEN), N(STATEMENT_SEQUENCE),
+  N(ELSIF_LIST), N(ELSE_BRANCH), T(TOKEN_END))
+
+RULE(ELSIF_LIST,
+  T(TOKEN_ELSIF), N(EXPRESSION), T(TOKEN_THEN), N(STATEMENT_SEQUENCE),
+  N(ELSIF_LIST))
+RULE(ELSIF_LIST, EMPTY)
+
+RULE(ELSE_BRANCH, T(TOKEN_ELSE), N(STATEMENT_SEQUENCE))
+RULE(ELSE_BRANCH, EMPTY)
+
+/* CASE Statement */
+
+RULE(CASE_STATEMENT,
+  T(TOKEN_CASE), N(EXPRESSION), T(TOKEN_OF), T(TOKEN_BAR), N(CASE),
+  N(CASE_LIST_TAIL), N(ELSE_BRANCH), T(TOKEN_END))
+
+RULE(CASE_LIST_TAIL, T(TOKEN_BAR), N(CASE), N(CASE_LIST_TAIL))
+RULE(CASE_LIST_TAIL, EMPTY)
+
+RULE(CASE,
+  N(CASE_LABELS), N(CASE_LABELS_TAIL), T(TOKEN_COLON),
+  N(STATEMENT_SEQUENCE))
+
+RULE(CASE_LABELS_TAIL, T(TOKEN_COMMA), N(CASE_LABELS), N(CASE_LABELS_TAIL))
+RULE(CASE_LABELS_TAIL, EMPTY)
+
+RULE(CASE_LABELS, N(EXPRESSION), N(RANGE_TAIL))
+
+RULE(RANGE_TAIL, T(TOKEN_DOT_DOT), N(EXPRESSION))
+RULE(RANGE_TAIL, EMPTY)
+
+/* FOR Statement */
+
+RULE(FOR_STATEMENT,
+  T(TOKEN_FOR), T(TOKEN_IDENT), N(DESCENDER), N(FOR_VALUE), T(TOKEN_IN),
+  N(ITERABLE_EXPR), T(TOKEN_DO), N(STATEMENT_SEQUENCE), T(TOKEN_END))
+
+RULE(DESCENDER, T(TOKEN_MINUS_MINUS))
+RULE(DESCENDER, EMPTY)
+
+RULE(FOR_VALUE, T(TOKEN_COMMA), T(TOKEN_IDENT))
+RULE(FOR_VALUE, EMPTY)
+
+RULE(ITERABLE_EXPR, N(SUBRANGE_TYPE))
+RULE(ITERABLE_EXPR, N(QUALIDENT), N(ITERABLE_RANGE))
+
+RULE(ITERABLE_RANGE, N(VALUE_RANGE))
+RULE(ITERABLE_RANGE, EMPTY)
+
+/* Designator */
+
+RULE(DESIGNATOR, N(QUALIDENT), N(DESIGNATOR_TAIL))
+
+RULE(DESIGNATOR_TAIL, N(DEREF_TAIL))
+RULE(DESIGNATOR_TAIL, N(SUBSCRIPT_TAIL))
+RULE(DESIGNATOR_TAIL, EMPTY)
+
+RULE(DEREF_TAIL, N(DEREF), N(DEREF_TAIL_REST))
+
+RULE(DEREF_TAIL_REST, T(TOKEN_DOT), N(DESIGNATOR))
+RULE(DEREF_TAIL_REST, N(SUBSCRIPT_TAIL))
+RULE(DEREF_TAIL_REST, EMPTY)
+
+RULE(SUBSCRIPT_TAIL,
+  T(TOKEN_LBRACKET), N(EXPRESSION), T(TOKEN_RBRACKET),
+  N(SUBSCRIPT_TAIL_REST))
+
+RULE(SUBSCRIPT_TAIL_REST, T(TOKEN_DOT), N(DESIGNATOR))
+RULE(SUBSCRIPT_TAIL_REST, N(DEREF_TAIL))
+RULE(SUBSCRIPT_TAIL_REST, EMPTY)
+
+RULE(DEREF, T(TOKEN_DEREF), N(DEREF_TAIL_MORE))
+
+RULE(DEREF_TAIL_MORE, T(TOKEN_DEREF), N(DEREF_TAIL_MORE))
+RULE(DEREF_TAIL_MORE, EMPTY)
+
+/* Target Designator */
+
+RULE(TARGET_DESIGNATOR, N(QUALIDENT), N(TARGET_TAIL))
+
+RULE(TARGET_TAIL, N(DEREF_TARGET_TAIL))
+RULE(TARGET_TAIL, N(BRACKET_TARGET_TAIL))
+RULE(TARGET_TAIL, EMPTY)
+
+RULE(DEREF_TARGET_TAIL, N(DEREF), N(DEREF_TARGET_REST))
+
+RULE(DEREF_TARGET_REST, T(TOKEN_DOT), N(TARGET_DESIGNATOR))
+RULE(DEREF_TARGET_REST, N(BRACKET_TARGET_TAIL))
+RULE(DEREF_TARGET_REST, EMPTY)
+
+RULE(BRACKET_TARGET_TAIL,
+  T(TOKEN_LBRACKET), N(EXPRESSION), N(BRACKET_TARGET_REST))
+
+RULE(BRACKET_TARGET_REST, T(TOKEN_RBRACKET), N(BRACKET_TARGET_AFTER))
+RULE(BRACKET_TARGET_REST,
+  T(TOKEN_DOT_DOT), N(RETURN_VALUE), T(TOKEN_RBRACKET))
+
+RULE(BRACKET_TARGET_AFTER, T(TOKEN_DOT), N(TARGET_DESIGNATOR))
+RULE(BRACKET_TARGET_AFTER, N(DEREF_TARGET_TAIL))
+RULE(BRACKET_TARGET_AFTER, EMPTY)
+
+/* Expression */
+
+RULE(EXPRESSION_LIST, N(EXPRESSION), N(EXPRESSION_LIST_TAIL))
+
+RULE(EXPRESSION_LIST_TAIL,
+  T(TOKEN_COMMA), N(EXPRESSION), N(EXPRESSION_LIST_TAIL))
+RULE(EXPRESSION_LIST_TAIL, EMPTY)
+
+RULE(EXPRESSION, N(SIMPLE_EXPRESSION), N(RELATION))
+
+RULE(RELATION, N(OPER_L1), N(SIMPLE_EXPRESSION))
+RULE(RELATION, EMPTY)
+
+RULE(OPER_L1, T(TOKEN_EQUAL))
+RULE(OPER_L1, T(TOKEN_NOT_EQUAL))
+RULE(OPER_L1, T(TOKEN_LESS))
+RULE(OPER_L1, T(TOKEN_LESS_OR_EQ))
+RULE(OPER_L1, T(TOKEN_GREATER))
+RULE(OPER_L1, T(TOKEN_GREATER_OR_EQ))
+RULE(OPER_L1, T(TOKEN_IDENTITY))
+RULE(OPER_L1, T(TOKEN_IN))
+
+RULE(SIMPLE_EXPRESSION, N(TERM), N(TERM_TAIL))
+RULE(SIMPLE_EXPRESSION, T(TOKEN_MINUS), N(FACTOR))
+
+RULE(TERM_TAIL, N(OPER_L2), N(TERM), N(TERM_TAIL))
+RULE(TERM_TAIL, EMPTY)
+
+RULE(OPER_L2, T(TOKEN_PLUS))
+RULE(OPER_L2, T(TOKEN_MINUS))
+RULE(OPER_L2, T(TOKEN_OR))
+RULE(OPER_L2, T(TOKEN_CONCAT))
+RULE(OPER_L2, T(TOKEN_SET_DIFF))
+
+RULE(TERM, N(SIMPLE_TERM), N(SIMPLE_TERM_TAIL))
+
+RULE(SIMPLE_TERM_TAIL, N(OPER_L3), N(SIMPLE_TERM), N(SIMPLE_TERM_TAIL))
+RULE(SIMPLE_TERM_TAIL, EMPTY)
+
+RULE(OPER_L3, T(TOKEN_ASTERISK))
+RULE(OPER_L3, T(TOKEN_SOLIDUS))
+RULE(OPER_L3, T(TOKEN_DIV))
+RULE(OPER_L3, T(TOKEN_MOD))
+RULE(OPER_L3, T(TOKEN_AND))
+
+RULE(SIMPLE_TERM, T(TOKEN_NOT), N(FACTOR))
+RULE(SIMPLE_TERM, N(FACTOR))
+
+RULE(FACTOR, N(SIMPLE_FACTOR), N(TYPE_CONVERSION))
+
+RULE(TYPE_CONVERSION, T(TOKEN_TYPE_CONV), N(QUALIDENT))
+RULE(TYPE_CONVERSION, EMPTY)
+
+RULE(SIMPLE_FACTOR, T(TOKEN_WHOLE_NUMBER))
+RULE(SIMPLE_FACTOR, T(TOKEN_REAL_NUMBER))
+RULE(SIMPLE_FACTOR, T(TOKEN_CHAR_CODE))
+RULE(SIMPLE_FACTOR, T(TOKEN_QUOTED_STRING))
+RULE(SIMPLE_FACTOR, N(STRUCTURED_VALUE))
+RULE(SIMPLE_FACTOR, N(SOURCE_DESIGNATOR))
+RULE(SIMPLE_FACTOR, T(TOKEN_LPAREN), N(EXPRESSION), T(TOKEN_RPAREN))
+
+/* Source Designator */
+
+RULE(SOURCE_DESIGNATOR, N(QUALIDENT), N(SOURCE_TAIL))
+
+RULE(SOURCE_TAIL, N(FUNCTION_CALL_TAIL))
+RULE(SOURCE_TAIL, N(DEREF_SOURCE_TAIL))
+RULE(SOURCE_TAIL, N(BRACKET_SOURCE_TAIL))
+RULE(SOURCE_TAIL, EMPTY)
+
+RULE(FUNCTION_CALL_TAIL, T(TOKEN_LPAREN), N(ARGUMENTS), T(TOKEN_RPAREN))
+
+RULE(ARGUMENTS, N(EXPRESSION_LIST))
+RULE(ARGUMENTS, EMPTY)
+
+RULE(DEREF_SOURCE_TAIL, N(DEREF), N(DEREF_SOURCE_REST))
+
+RULE(DEREF_SOURCE_REST, T(TOKEN_DOT), N(SOURCE_DESIGNATOR))
+RULE(DEREF_SOURCE_REST, N(FUNCTION_CALL_TAIL))
+RULE(DEREF_SOURCE_REST, N(BRACKET_SOURCE_TAIL))
+RULE(DEREF_SOURCE_REST, EMPTY)
+
+RULE(BRACKET_SOURCE_TAIL,
+  T(TOKEN_LBRACKET), N(EXPRESSION), N(BRACKET_SOURCE_REST))
+
+RULE(BRACKET_SOURCE_REST, T(TOKEN_RBRACKET), N(BRACKET_SOURCE_AFTER))
+RULE(BRACKET_SOURCE_REST,
+  T(TOKEN_DOT_DOT), N(EXPRESSION), T(TOKEN_RBRACKET))
+
+RULE(BRACKET_SOURCE_AFTER, T(TOKEN_DOT), N(SOURCE_DESIGNATOR))
+RULE(BRACKET_SOURCE_AFTER, N(FUNCTION_CALL_TAIL))
+RULE(BRACKET_SOURCE_AFTER, N(DEREF_SOURCE_TAIL))
+RULE(BRACKET_SOURCE_AFTER, EMPTY)
+
+/* Structured Value */
+
+RULE(STRUCTURED_VALUE,
+  T(TOKEN_LBRACE), N(STRUCTURED_VALUE_BODY), T(TOKEN_RBRACE))
+
+RULE(STRUCTURED_VALUE_BODY, N(VALUE_COMPONENT), N(VALUE_COMPONENT_TAIL))
+RULE(STRUCTURED_VALUE_BODY, T(TOKEN_ASTERISK))
+
+RULE(VALUE_COMPONENT_TAIL,
+  T(TOKEN_COMMA), N(VALUE_COMPONENT), N(VALUE_COMPONENT_TAIL))
+RULE(VALUE_COMPONENT_TAIL, EMPTY)
+
+RULE(VALUE_COMPONENT, N(EXPRESSION), N(RANGE_TAIL))
+
+/* TO DO List */
+
+RULE(TO_DO_LIST, T(TOKEN_TO), T(TOKEN_DO), N(TO_DO_BODY))
+
+RULE(TO_DO_BODY,
+  N(TRACKING_REF), N(TASK_TO_DO), N(TASK_TO_DO_TAIL), T(TOKEN_END))
+RULE(TO_DO_BODY, EMPTY)
+
+RULE(TRACKING_REF,
+  T(TOKEN_LPAREN), T(TOKEN_WHOLE_NUMBER), N(TRACKING_DETAIL),
+  T(TOKEN_RPAREN))
+RULE(TRACKING_REF, EMPTY)
+
+RULE(TRACKING_DETAIL,
+  T(TOKEN_COMMA), T(TOKEN_WHOLE_NUMBER), T(TOKEN_COMMA),
+  T(TOKEN_QUOTED_STRING))
+RULE(TRACKING_DETAIL, EMPTY)
+
+RULE(TASK_TO_DO, T(TOKEN_QUOTED_STRING), N(ESTIMATE))
+
+RULE(ESTIMATE, T(TOKEN_COMMA), T(TOKEN_WHOLE_NUMBER), T(TOKEN_IDENT))
+RULE(ESTIMATE, EMPTY)
+
+RULE(TASK_TO_DO_TAIL, T(TOKEN_SEMICOLON), N(TASK_TO_DO), N(TASK_TO_DO_TAIL))
+RULE(TASK_TO_DO_TAIL, EMPTY)
+
+/* END OF FILE */
@@ -0,0 +1,3482 @@
+/* AUTO-GENERATED by utility gen-ll1-table * DO NOT EDIT! */
+
+#define LL1_NONTERMINAL_COUNT 153
+#define LL1_RULE_COUNT 341
+#define LL1_NT(_caps) (TOKEN_END_MARK + LL1_ ## _caps)
+
+typedef enum {
+  LL1_COMPILATION_UNIT, /* 0 */
+  LL1_INTERFACE_MODULE, /* 1 */
+  LL1_IMPORT_LIST, /* 2 */
+  LL1_IMPORT, /* 3 */
+  LL1_IMPORT_TAIL, /* 4 */
+  LL1_RE_EXPORT, /* 5 */
+  LL1_DECLARATION_LIST, /* 6 */
+  LL1_DECLARATION, /* 7 */
+  LL1_CONST_DEFINITION_TAIL, /* 8 */
+  LL1_CONST_DEFINITION, /* 9 */
+  LL1_CONST_BINDING, /* 10 */
+  LL1_CONST_TYPE, /* 11 */
+  LL1_QUALIDENT, /* 12 */
+  LL1_QUALIDENT_TAIL, /* 13 */
+  LL1_TYPE_DEFINITION_TAIL, /* 14 */
+  LL1_TYPE_DEFINITION, /* 15 */
+  LL1_PUBLIC_TYPE, /* 16 */
+  LL1_ALIAS_TYPE, /* 17 */
+  LL1_SUBRANGE_TYPE, /* 18 */
+  LL1_VALUE_RANGE, /* 19 */
+  LL1_ENUM_TYPE, /* 20 */
+  LL1_ENUM_BASE, /* 21 */
+  LL1_IDENT_LIST, /* 22 */
+  LL1_IDENT_LIST_TAIL, /* 23 */
+  LL1_SET_TYPE, /* 24 */
+  LL1_ARRAY_TYPE, /* 25 */
+  LL1_RECORD_TYPE, /* 26 */
+  LL1_RECORD_BASE, /* 27 */
+  LL1_FIELD_LIST_TAIL, /* 28 */
+  LL1_POINTER_TYPE, /* 29 */
+  LL1_OPAQUE_TYPE, /* 30 */
+  LL1_ALLOC_SIZE, /* 31 */
+  LL1_PROCEDURE_TYPE, /* 32 */
+  LL1_FORMAL_TYPE_LIST, /* 33 */
+  LL1_FORMAL_TYPE_TAIL, /* 34 */
+  LL1_RETURN_TYPE, /* 35 */
+  LL1_FORMAL_TYPE, /* 36 */
+  LL1_ATTRIBUTE, /* 37 */
+  LL1_NON_ATTR_FORMAL_TYPE, /* 38 */
+  LL1_SIMPLE_FORMAL_TYPE, /* 39 */
+  LL1_CAST_TARGET, /* 40 */
+  LL1_VAR_DEFINITION_TAIL, /* 41 */
+  LL1_VAR_DEFINITION, /* 42 */
+  LL1_VAR_TYPE, /* 43 */
+  LL1_PROCEDURE_HEADER, /* 44 */
+  LL1_PROC_BINDING, /* 45 */
+  LL1_BINDING_SPECIFIER, /* 46 */
+  LL1_NEW_BINDING, /* 47 */
+  LL1_READ_BINDING, /* 48 */
+  LL1_WRITE_BINDING, /* 49 */
+  LL1_FORMAL_PARAM_LIST, /* 50 */
+  LL1_FORMAL_PARAMS_TAIL, /* 51 */
+  LL1_FORMAL_PARAMS, /* 52 */
+  LL1_PROGRAM_MODULE, /* 53 */
+  LL1_PRIVATE_IMPORT_LIST, /* 54 */
+  LL1_PRIVATE_IMPORT, /* 55 */
+  LL1_BLOCK, /* 56 */
+  LL1_DEFINITION_LIST, /* 57 */
+  LL1_DEFINITION, /* 58 */
+  LL1_PGM_TYPE_DEFINITION_TAIL, /* 59 */
+  LL1_PGM_TYPE_DEFINITION, /* 60 */
+  LL1_PROGRAM_TYPE, /* 61 */
+  LL1_PROCEDURE_DEFINITION, /* 62 */
+  LL1_IMPLEMENTATION_MODULE, /* 63 */
+  LL1_PRIVATE_BLOCK, /* 64 */
+  LL1_MODULE_BODY, /* 65 */
+  LL1_PRIVATE_DEFINITION_LIST, /* 66 */
+  LL1_PRIVATE_DEFINITION, /* 67 */
+  LL1_IMP_TYPE_DEFINITION_TAIL, /* 68 */
+  LL1_IMP_TYPE_DEFINITION, /* 69 */
+  LL1_IMPLEMENTATION_TYPE, /* 70 */
+  LL1_PRIVATE_POINTER_TYPE, /* 71 */
+  LL1_POINTER_TARGET, /* 72 */
+  LL1_INDETERMINATE_FIELDS, /* 73 */
+  LL1_ALIAS_DEFINITION, /* 74 */
+  LL1_NAME_SELECTOR_TAIL, /* 75 */
+  LL1_NAME_SELECTOR, /* 76 */
+  LL1_WILDCARD, /* 77 */
+  LL1_STATEMENT_SEQUENCE, /* 78 */
+  LL1_STATEMENT_TAIL, /* 79 */
+  LL1_STATEMENT, /* 80 */
+  LL1_NEW_TAIL, /* 81 */
+  LL1_UPDATE_OR_CALL_TAIL, /* 82 */
+  LL1_RETURN_VALUE, /* 83 */
+  LL1_CHANNEL, /* 84 */
+  LL1_INPUT_ARG, /* 85 */
+  LL1_INPUT_ARG_TAIL, /* 86 */
+  LL1_OUTPUT_ARGS, /* 87 */
+  LL1_OUTPUT_ARGS_TAIL, /* 88 */
+  LL1_IF_STATEMENT, /* 89 */
+  LL1_ELSIF_LIST, /* 90 */
+  LL1_ELSE_BRANCH, /* 91 */
+  LL1_CASE_STATEMENT, /* 92 */
+  LL1_CASE_LIST_TAIL, /* 93 */
+  LL1_CASE, /* 94 */
+  LL1_CASE_LABELS_TAIL, /* 95 */
+  LL1_CASE_LABELS, /* 96 */
+  LL1_RANGE_TAIL, /* 97 */
+  LL1_FOR_STATEMENT, /* 98 */
+  LL1_DESCENDER, /* 99 */
+  LL1_FOR_VALUE, /* 100 */
+  LL1_ITERABLE_EXPR, /* 101 */
+  LL1_ITERABLE_RANGE, /* 102 */
+  LL1_DESIGNATOR, /* 103 */
+  LL1_DESIGNATOR_TAIL, /* 104 */
+  LL1_DEREF_TAIL, /* 105 */
+  LL1_DEREF_TAIL_REST, /* 106 */
+  LL1_SUBSCRIPT_TAIL, /* 107 */
+  LL1_SUBSCRIPT_TAIL_REST, /* 108 */
+  LL1_DEREF, /* 109 */
+  LL1_DEREF_TAIL_MORE, /* 110 */
+  LL1_TARGET_DESIGNATOR, /* 111 */
+  LL1_TARGET_TAIL, /* 112 */
+  LL1_DEREF_TARGET_TAIL, /* 113 */
+  LL1_DEREF_TARGET_REST, /* 114 */
+  LL1_BRACKET_TARGET_TAIL, /* 115 */
+  LL1_BRACKET_TARGET_REST, /* 116 */
+  LL1_BRACKET_TARGET_AFTER, /* 117 */
+  LL1_EXPRESSION_LIST, /* 118 */
+  LL1_EXPRESSION_LIST_TAIL, /* 119 */
+  LL1_EXPRESSION, /* 120 */
+  LL1_RELATION, /* 121 */
+  LL1_OPER_L1, /* 122 */
+  LL1_SIMPLE_EXPRESSION, /* 123 */
+  LL1_TERM_TAIL, /* 124 */
+  LL1_OPER_L2, /* 125 */
+  LL1_TERM, /* 126 */
+  LL1_SIMPLE_TERM_TAIL, /* 127 */
+  LL1_OPER_L3, /* 128 */
+  LL1_SIMPLE_TERM, /* 129 */
+  LL1_FACTOR, /* 130 */
+  LL1_TYPE_CONVERSION, /* 131 */
+  LL1_SIMPLE_FACTOR, /* 132 */
+  LL1_SOURCE_DESIGNATOR, /* 133 */
+  LL1_SOURCE_TAIL, /* 134 */
+  LL1_FUNCTION_CALL_TAIL, /* 135 */
+  LL1_ARGUMENTS, /* 136 */
+  LL1_DEREF_SOURCE_TAIL, /* 137 */
+  LL1_DEREF_SOURCE_REST, /* 138 */
+  LL1_BRACKET_SOURCE_TAIL, /* 139 */
+  LL1_BRACKET_SOURCE_REST, /* 140 */
+  LL1_BRACKET_SOURCE_AFTER, /* 141 */
+  LL1_STRUCTURED_VALUE, /* 142 */
+  LL1_STRUCTURED_VALUE_BODY, /* 143 */
+  LL1_VALUE_COMPONENT_TAIL, /* 144 */
+  LL1_VALUE_COMPONENT, /* 145 */
+  LL1_TO_DO_LIST, /* 146 */
+  LL1_TO_DO_BODY, /* 147 */
+  LL1_TRACKING_REF, /* 148 */
+  LL1_TRACKING_DETAIL, /* 149 */
+  LL1_TASK_TO_DO, /* 150 */
+  LL1_ESTIMATE, /* 151 */
+  LL1_TASK_TO_DO_TAIL /* 152 */
+} ll1_nonterminal_t;
+
+static const char *const ll1_nonterminal_name[LL1_NONTERMINAL_COUNT] = {
+  "COMPILATION_UNIT",
+  "INTERFACE_MODULE",
+  "IMPORT_LIST",
+  "IMPORT",
+  "IMPORT_TAIL",
+  "RE_EXPORT",
+  "DECLARATION_LIST",
+  "DECLARATION",
+  "CONST_DEFINITION_TAIL",
+  "CONST_DEFINITION",
+  "CONST_BINDING",
+  "CONST_TYPE",
+  "QUALIDENT",
+  "QUALIDENT_TAIL",
+  "TYPE_DEFINITION_TAIL",
+  "TYPE_DEFINITION",
+  "PUBLIC_TYPE",
+  "ALIAS_TYPE",
+  "SUBRANGE_TYPE",
+  "VALUE_RANGE",
+  "ENUM_TYPE",
+  "ENUM_BASE",
+  "IDENT_LIST",
+  "IDENT_LIST_TAIL",
+  "SET_TYPE",
+  "ARRAY_TYPE",
+  "RECORD_TYPE",
+  "RECORD_BASE",
+  "FIELD_LIST_TAIL",
+  "POINTER_TYPE",
+  "OPAQUE_TYPE",
+  "ALLOC_SIZE",
+  "PROCEDURE_TYPE",
+  "FORMAL_TYPE_LIST",
+  "FORMAL_TYPE_TAIL",
+  "RETURN_TYPE",
+  "FORMAL_TYPE",
+  "ATTRIBUTE",
+  "NON_ATTR_FORMAL_TYPE",
+  "SIMPLE_FORMAL_TYPE",
+  "CAST_TARGET",
+  "VAR_DEFINITION_TAIL",
+  "VAR_DEFINITION",
+  "VAR_TYPE",
+  "PROCEDURE_HEADER",
+  "PROC_BINDING",
+  "BINDING_SPECIFIER",
+  "NEW_BINDING",
+  "READ_BINDING",
+  "WRITE_BINDING",
+  "FORMAL_PARAM_LIST",
+  "FORMAL_PARAMS_TAIL",
+  "FORMAL_PARAMS",
+  "PROGRAM_MODULE",
+  "PRIVATE_IMPORT_LIST",
+  "PRIVATE_IMPORT",
+  "BLOCK",
+  "DEFINITION_LIST",
+  "DEFINITION",
+  "PGM_TYPE_DEFINITION_TAIL",
+  "PGM_TYPE_DEFINITION",
+  "PROGRAM_TYPE",
+  "PROCEDURE_DEFINITION",
+  "IMPLEMENTATION_MODULE",
+  "PRIVATE_BLOCK",
+  "MODULE_BODY",
+  "PRIVATE_DEFINITION_LIST",
+  "PRIVATE_DEFINITION",
+  "IMP_TYPE_DEFINITION_TAIL",
+  "IMP_TYPE_DEFINITION",
+  "IMPLEMENTATION_TYPE",
+  "PRIVATE_POINTER_TYPE",
+  "POINTER_TARGET",
+  "INDETERMINATE_FIELDS",
+  "ALIAS_DEFINITION",
+  "NAME_SELECTOR_TAIL",
+  "NAME_SELECTOR",
+  "WILDCARD",
+  "STATEMENT_SEQUENCE",
+  "STATEMENT_TAIL",
+  "STATEMENT",
+  "NEW_TAIL",
+  "UPDATE_OR_CALL_TAIL",
+  "RETURN_VALUE",
+  "CHANNEL",
+  "INPUT_ARG",
+  "INPUT_ARG_TAIL",
+  "OUTPUT_ARGS",
+  "OUTPUT_ARGS_TAIL",
+  "IF_STATEMENT",
+  "ELSIF_LIST",
+  "ELSE_BRANCH",
+  "CASE_STATEMENT",
+  "CASE_LIST_TAIL",
+  "CASE",
+  "CASE_LABELS_TAIL",
+  "CASE_LABELS",
+  "RANGE_TAIL",
+  "FOR_STATEMENT",
+  "DESCENDER",
+  "FOR_VALUE",
+  "ITERABLE_EXPR",
+  "ITERABLE_RANGE",
+  "DESIGNATOR",
+  "DESIGNATOR_TAIL",
+  "DEREF_TAIL",
+  "DEREF_TAIL_REST",
+  "SUBSCRIPT_TAIL",
+  "SUBSCRIPT_TAIL_REST",
+  "DEREF",
+  "DEREF_TAIL_MORE",
+  "TARGET_DESIGNATOR",
+  "TARGET_TAIL",
+  "DEREF_TARGET_TAIL",
+  "DEREF_TARGET_REST",
+  "BRACKET_TARGET_TAIL",
+  "BRACKET_TARGET_REST",
+  "BRACKET_TARGET_AFTER",
+  "EXPRESSION_LIST",
+  "EXPRESSION_LIST_TAIL",
+  "EXPRESSION",
+  "RELATION",
+  "OPER_L1",
+  "SIMPLE_EXPRESSION",
+  "TERM_TAIL",
+  "OPER_L2",
+  "TERM",
+  "SIMPLE_TERM_TAIL",
+  "OPER_L3",
+  "SIMPLE_TERM",
+  "FACTOR",
+  "TYPE_CONVERSION",
+  "SIMPLE_FACTOR",
+  "SOURCE_DESIGNATOR",
+  "SOURCE_TAIL",
+  "FUNCTION_CALL_TAIL",
+  "ARGUMENTS",
+  "DEREF_SOURCE_TAIL",
+  "DEREF_SOURCE_REST",
+  "BRACKET_SOURCE_TAIL",
+  "BRACKET_SOURCE_REST",
+  "BRACKET_SOURCE_AFTER",
+  "STRUCTURED_VALUE",
+  "STRUCTURED_VALUE_BODY",
+  "VALUE_COMPONENT_TAIL",
+  "VALUE_COMPONENT",
+  "TO_DO_LIST",
+  "TO_DO_BODY",
+  "TRACKING_REF",
+  "TRACKING_DETAIL",
+  "TASK_TO_DO",
+  "ESTIMATE",
+  "TASK_TO_DO_TAIL"
+};
+
+static const uint16_t ll1_rhs_symbol[] = {
+  /* 0: COMPILATION_UNIT */
+    LL1_NT(INTERFACE_MODULE),
+  /* 1: COMPILATION_UNIT */
+    LL1_NT(IMPLEMENTATION_MODULE),
+  /* 2: COMPILATION_UNIT */
+    LL1_NT(PROGRAM_MODULE),
+  /* 3: INTERFACE_MODULE */
+    TOKEN_INTERFACE,
+    TOKEN_MODULE,
+    TOKEN_IDENT,
+    TOKEN_SEMICOLON,
+    LL1_NT(IMPORT_LIST),
+    LL1_NT(DECLARATION_LIST),
+    TOKEN_END,
+    TOKEN_IDENT,
+    TOKEN_DOT,
+    TOKEN_EOF,
+  /* 4: IMPORT_LIST */
+    LL1_NT(IMPORT),
+    LL1_NT(IMPORT_LIST),
+  /* 5: IMPORT_LIST */
+  /* 6: IMPORT */
+    TOKEN_IMPORT,
+    TOKEN_IDENT,
+    LL1_NT(RE_EXPORT),
+    LL1_NT(IMPORT_TAIL),
+    TOKEN_SEMICOLON,
+  /* 7: IMPORT_TAIL */
+    TOKEN_COMMA,
+    TOKEN_IDENT,
+    LL1_NT(RE_EXPORT),
+    LL1_NT(IMPORT_TAIL),
+  /* 8: IMPORT_TAIL */
+  /* 9: RE_EXPORT */
+    TOKEN_PLUS,
+  /* 10: RE_EXPORT */
+  /* 11: DECLARATION_LIST */
+    LL1_NT(DECLARATION),
+    LL1_NT(DECLARATION_LIST),
+  /* 12: DECLARATION_LIST */
+  /* 13: DECLARATION */
+    TOKEN_CONST,
+    LL1_NT(CONST_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(CONST_DEFINITION_TAIL),
+  /* 14: DECLARATION */
+    TOKEN_TYPE,
+    LL1_NT(TYPE_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(TYPE_DEFINITION_TAIL),
+  /* 15: DECLARATION */
+    TOKEN_VAR,
+    LL1_NT(VAR_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(VAR_DEFINITION_TAIL),
+  /* 16: DECLARATION */
+    LL1_NT(PROCEDURE_HEADER),
+    TOKEN_SEMICOLON,
+  /* 17: DECLARATION */
+    LL1_NT(TO_DO_LIST),
+    TOKEN_SEMICOLON,
+  /* 18: CONST_DEFINITION_TAIL */
+    LL1_NT(CONST_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(CONST_DEFINITION_TAIL),
+  /* 19: CONST_DEFINITION_TAIL */
+  /* 20: CONST_DEFINITION */
+    LL1_NT(CONST_BINDING),
+    TOKEN_IDENT,
+    LL1_NT(CONST_TYPE),
+    TOKEN_EQUAL,
+    LL1_NT(EXPRESSION),
+  /* 21: CONST_BINDING */
+    TOKEN_LBRACKET,
+    TOKEN_IDENT,
+    TOKEN_RBRACKET,
+  /* 22: CONST_BINDING */
+  /* 23: CONST_TYPE */
+    TOKEN_COLON,
+    LL1_NT(QUALIDENT),
+  /* 24: CONST_TYPE */
+  /* 25: QUALIDENT */
+    TOKEN_IDENT,
+    LL1_NT(QUALIDENT_TAIL),
+  /* 26: QUALIDENT_TAIL */
+    TOKEN_DOT,
+    TOKEN_IDENT,
+    LL1_NT(QUALIDENT_TAIL),
+  /* 27: QUALIDENT_TAIL */
+  /* 28: TYPE_DEFINITION_TAIL */
+    LL1_NT(TYPE_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(TYPE_DEFINITION_TAIL),
+  /* 29: TYPE_DEFINITION_TAIL */
+  /* 30: TYPE_DEFINITION */
+    TOKEN_IDENT,
+    TOKEN_EQUAL,
+    LL1_NT(PUBLIC_TYPE),
+  /* 31: PUBLIC_TYPE */
+    LL1_NT(ALIAS_TYPE),
+  /* 32: PUBLIC_TYPE */
+    LL1_NT(QUALIDENT),
+  /* 33: PUBLIC_TYPE */
+    LL1_NT(SUBRANGE_TYPE),
+  /* 34: PUBLIC_TYPE */
+    LL1_NT(ENUM_TYPE),
+  /* 35: PUBLIC_TYPE */
+    LL1_NT(SET_TYPE),
+  /* 36: PUBLIC_TYPE */
+    LL1_NT(ARRAY_TYPE),
+  /* 37: PUBLIC_TYPE */
+    LL1_NT(RECORD_TYPE),
+  /* 38: PUBLIC_TYPE */
+    LL1_NT(POINTER_TYPE),
+  /* 39: PUBLIC_TYPE */
+    LL1_NT(OPAQUE_TYPE),
+  /* 40: PUBLIC_TYPE */
+    LL1_NT(PROCEDURE_TYPE),
+  /* 41: ALIAS_TYPE */
+    TOKEN_ALIAS,
+    TOKEN_OF,
+    LL1_NT(QUALIDENT),
+  /* 42: SUBRANGE_TYPE */
+    LL1_NT(VALUE_RANGE),
+    TOKEN_OF,
+    LL1_NT(QUALIDENT),
+  /* 43: VALUE_RANGE */
+    TOKEN_LBRACKET,
+    LL1_NT(EXPRESSION),
+    TOKEN_DOT_DOT,
+    LL1_NT(EXPRESSION),
+    TOKEN_RBRACKET,
+  /* 44: ENUM_TYPE */
+    TOKEN_LPAREN,
+    LL1_NT(ENUM_BASE),
+    LL1_NT(IDENT_LIST),
+    TOKEN_RPAREN,
+  /* 45: ENUM_BASE */
+    TOKEN_PLUS,
+    LL1_NT(QUALIDENT),
+    TOKEN_COMMA,
+  /* 46: ENUM_BASE */
+  /* 47: IDENT_LIST */
+    TOKEN_IDENT,
+    LL1_NT(IDENT_LIST_TAIL),
+  /* 48: IDENT_LIST_TAIL */
+    TOKEN_COMMA,
+    TOKEN_IDENT,
+    LL1_NT(IDENT_LIST_TAIL),
+  /* 49: IDENT_LIST_TAIL */
+  /* 50: SET_TYPE */
+    TOKEN_SET,
+    TOKEN_OF,
+    LL1_NT(QUALIDENT),
+  /* 51: ARRAY_TYPE */
+    TOKEN_ARRAY,
+    LL1_NT(EXPRESSION),
+    TOKEN_OF,
+    LL1_NT(QUALIDENT),
+  /* 52: RECORD_TYPE */
+    TOKEN_RECORD,
+    LL1_NT(RECORD_BASE),
+    LL1_NT(VAR_DEFINITION),
+    LL1_NT(FIELD_LIST_TAIL),
+    TOKEN_END,
+  /* 53: RECORD_BASE */
+    TOKEN_LPAREN,
+    LL1_NT(QUALIDENT),
+    TOKEN_RPAREN,
+  /* 54: RECORD_BASE */
+  /* 55: FIELD_LIST_TAIL */
+    TOKEN_SEMICOLON,
+    LL1_NT(VAR_DEFINITION),
+    LL1_NT(FIELD_LIST_TAIL),
+  /* 56: FIELD_LIST_TAIL */
+  /* 57: POINTER_TYPE */
+    TOKEN_POINTER,
+    TOKEN_TO,
+    LL1_NT(QUALIDENT),
+  /* 58: OPAQUE_TYPE */
+    TOKEN_OPAQUE,
+    LL1_NT(ALLOC_SIZE),
+  /* 59: ALLOC_SIZE */
+    TOKEN_LBRACKET,
+    LL1_NT(EXPRESSION),
+    TOKEN_RBRACKET,
+  /* 60: ALLOC_SIZE */
+  /* 61: PROCEDURE_TYPE */
+    TOKEN_PROCEDURE,
+    LL1_NT(FORMAL_TYPE_LIST),
+    LL1_NT(RETURN_TYPE),
+  /* 62: FORMAL_TYPE_LIST */
+    TOKEN_LPAREN,
+    LL1_NT(FORMAL_TYPE),
+    LL1_NT(FORMAL_TYPE_TAIL),
+    TOKEN_RPAREN,
+  /* 63: FORMAL_TYPE_LIST */
+  /* 64: FORMAL_TYPE_TAIL */
+    TOKEN_SEMICOLON,
+    LL1_NT(FORMAL_TYPE),
+    LL1_NT(FORMAL_TYPE_TAIL),
+  /* 65: FORMAL_TYPE_TAIL */
+  /* 66: RETURN_TYPE */
+    TOKEN_COLON,
+    LL1_NT(QUALIDENT),
+  /* 67: RETURN_TYPE */
+  /* 68: FORMAL_TYPE */
+    LL1_NT(ATTRIBUTE),
+    LL1_NT(NON_ATTR_FORMAL_TYPE),
+  /* 69: ATTRIBUTE */
+    TOKEN_CONST,
+  /* 70: ATTRIBUTE */
+    TOKEN_VAR,
+  /* 71: ATTRIBUTE */
+  /* 72: NON_ATTR_FORMAL_TYPE */
+    LL1_NT(SIMPLE_FORMAL_TYPE),
+  /* 73: NON_ATTR_FORMAL_TYPE */
+    TOKEN_ARGLIST,
+    TOKEN_OF,
+    LL1_NT(SIMPLE_FORMAL_TYPE),
+  /* 74: SIMPLE_FORMAL_TYPE */
+    TOKEN_ARRAY,
+    TOKEN_OF,
+    LL1_NT(QUALIDENT),
+  /* 75: SIMPLE_FORMAL_TYPE */
+    LL1_NT(QUALIDENT),
+    LL1_NT(CAST_TARGET),
+  /* 76: CAST_TARGET */
+    TOKEN_OCTETSEQ,
+  /* 77: CAST_TARGET */
+    TOKEN_IDENT,
+  /* 78: CAST_TARGET */
+  /* 79: VAR_DEFINITION_TAIL */
+    LL1_NT(VAR_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(VAR_DEFINITION_TAIL),
+  /* 80: VAR_DEFINITION_TAIL */
+  /* 81: VAR_DEFINITION */
+    LL1_NT(IDENT_LIST),
+    TOKEN_COLON,
+    LL1_NT(VAR_TYPE),
+  /* 82: VAR_TYPE */
+    LL1_NT(QUALIDENT),
+  /* 83: VAR_TYPE */
+    LL1_NT(SUBRANGE_TYPE),
+  /* 84: VAR_TYPE */
+    LL1_NT(ARRAY_TYPE),
+  /* 85: VAR_TYPE */
+    LL1_NT(PROCEDURE_TYPE),
+  /* 86: PROCEDURE_HEADER */
+    TOKEN_PROCEDURE,
+    LL1_NT(PROC_BINDING),
+    TOKEN_IDENT,
+    LL1_NT(FORMAL_PARAM_LIST),
+    LL1_NT(RETURN_TYPE),
+  /* 87: PROC_BINDING */
+    TOKEN_LBRACKET,
+    LL1_NT(BINDING_SPECIFIER),
+    TOKEN_RBRACKET,
+  /* 88: PROC_BINDING */
+  /* 89: BINDING_SPECIFIER */
+    TOKEN_NEW,
+    LL1_NT(NEW_BINDING),
+  /* 90: BINDING_SPECIFIER */
+    TOKEN_RETAIN,
+  /* 91: BINDING_SPECIFIER */
+    TOKEN_RELEASE,
+  /* 92: BINDING_SPECIFIER */
+    TOKEN_READ,
+    LL1_NT(READ_BINDING),
+  /* 93: BINDING_SPECIFIER */
+    TOKEN_WRITE,
+    LL1_NT(WRITE_BINDING),
+  /* 94: BINDING_SPECIFIER */
+    TOKEN_IDENT,
+  /* 95: NEW_BINDING */
+    TOKEN_ARGLIST,
+  /* 96: NEW_BINDING */
+    TOKEN_IDENT,
+  /* 97: NEW_BINDING */
+  /* 98: READ_BINDING */
+    TOKEN_NEW,
+  /* 99: READ_BINDING */
+  /* 100: WRITE_BINDING */
+    TOKEN_HASH,
+  /* 101: WRITE_BINDING */
+  /* 102: FORMAL_PARAM_LIST */
+    TOKEN_LPAREN,
+    LL1_NT(FORMAL_PARAMS),
+    LL1_NT(FORMAL_PARAMS_TAIL),
+    TOKEN_RPAREN,
+  /* 103: FORMAL_PARAM_LIST */
+  /* 104: FORMAL_PARAMS_TAIL */
+    TOKEN_SEMICOLON,
+    LL1_NT(FORMAL_PARAMS),
+    LL1_NT(FORMAL_PARAMS_TAIL),
+  /* 105: FORMAL_PARAMS_TAIL */
+  /* 106: FORMAL_PARAMS */
+    LL1_NT(ATTRIBUTE),
+    LL1_NT(IDENT_LIST),
+    TOKEN_COLON,
+    LL1_NT(NON_ATTR_FORMAL_TYPE),
+  /* 107: PROGRAM_MODULE */
+    TOKEN_MODULE,
+    TOKEN_IDENT,
+    TOKEN_SEMICOLON,
+    LL1_NT(PRIVATE_IMPORT_LIST),
+    LL1_NT(BLOCK),
+    TOKEN_IDENT,
+    TOKEN_DOT,
+    TOKEN_EOF,
+  /* 108: PRIVATE_IMPORT_LIST */
+    LL1_NT(PRIVATE_IMPORT),
+    LL1_NT(PRIVATE_IMPORT_LIST),
+  /* 109: PRIVATE_IMPORT_LIST */
+  /* 110: PRIVATE_IMPORT */
+    TOKEN_IMPORT,
+    TOKEN_IDENT,
+    LL1_NT(IDENT_LIST_TAIL),
+    TOKEN_SEMICOLON,
+  /* 111: BLOCK */
+    LL1_NT(DEFINITION_LIST),
+    TOKEN_BEGIN,
+    LL1_NT(STATEMENT_SEQUENCE),
+    TOKEN_END,
+  /* 112: DEFINITION_LIST */
+    LL1_NT(DEFINITION),
+    LL1_NT(DEFINITION_LIST),
+  /* 113: DEFINITION_LIST */
+  /* 114: DEFINITION */
+    TOKEN_CONST,
+    LL1_NT(CONST_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(CONST_DEFINITION_TAIL),
+  /* 115: DEFINITION */
+    TOKEN_TYPE,
+    LL1_NT(PGM_TYPE_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(PGM_TYPE_DEFINITION_TAIL),
+  /* 116: DEFINITION */
+    TOKEN_VAR,
+    LL1_NT(VAR_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(VAR_DEFINITION_TAIL),
+  /* 117: DEFINITION */
+    LL1_NT(PROCEDURE_DEFINITION),
+    TOKEN_SEMICOLON,
+  /* 118: DEFINITION */
+    LL1_NT(ALIAS_DEFINITION),
+    TOKEN_SEMICOLON,
+  /* 119: DEFINITION */
+    LL1_NT(TO_DO_LIST),
+    TOKEN_SEMICOLON,
+  /* 120: PGM_TYPE_DEFINITION_TAIL */
+    LL1_NT(PGM_TYPE_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(PGM_TYPE_DEFINITION_TAIL),
+  /* 121: PGM_TYPE_DEFINITION_TAIL */
+  /* 122: PGM_TYPE_DEFINITION */
+    TOKEN_IDENT,
+    TOKEN_EQUAL,
+    LL1_NT(PROGRAM_TYPE),
+  /* 123: PROGRAM_TYPE */
+    LL1_NT(ALIAS_TYPE),
+  /* 124: PROGRAM_TYPE */
+    LL1_NT(QUALIDENT),
+  /* 125: PROGRAM_TYPE */
+    LL1_NT(SUBRANGE_TYPE),
+  /* 126: PROGRAM_TYPE */
+    LL1_NT(ENUM_TYPE),
+  /* 127: PROGRAM_TYPE */
+    LL1_NT(SET_TYPE),
+  /* 128: PROGRAM_TYPE */
+    LL1_NT(ARRAY_TYPE),
+  /* 129: PROGRAM_TYPE */
+    LL1_NT(RECORD_TYPE),
+  /* 130: PROGRAM_TYPE */
+    LL1_NT(POINTER_TYPE),
+  /* 131: PROGRAM_TYPE */
+    LL1_NT(PROCEDURE_TYPE),
+  /* 132: PROCEDURE_DEFINITION */
+    LL1_NT(PROCEDURE_HEADER),
+    TOKEN_SEMICOLON,
+    LL1_NT(BLOCK),
+    TOKEN_IDENT,
+  /* 133: IMPLEMENTATION_MODULE */
+    TOKEN_IMPLEMENTATION,
+    TOKEN_MODULE,
+    TOKEN_IDENT,
+    TOKEN_SEMICOLON,
+    LL1_NT(PRIVATE_IMPORT_LIST),
+    LL1_NT(PRIVATE_BLOCK),
+    TOKEN_IDENT,
+    TOKEN_DOT,
+    TOKEN_EOF,
+  /* 134: PRIVATE_BLOCK */
+    LL1_NT(PRIVATE_DEFINITION_LIST),
+    LL1_NT(MODULE_BODY),
+    TOKEN_END,
+  /* 135: MODULE_BODY */
+    TOKEN_BEGIN,
+    LL1_NT(STATEMENT_SEQUENCE),
+  /* 136: MODULE_BODY */
+  /* 137: PRIVATE_DEFINITION_LIST */
+    LL1_NT(PRIVATE_DEFINITION),
+    LL1_NT(PRIVATE_DEFINITION_LIST),
+  /* 138: PRIVATE_DEFINITION_LIST */
+  /* 139: PRIVATE_DEFINITION */
+    TOKEN_CONST,
+    LL1_NT(CONST_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(CONST_DEFINITION_TAIL),
+  /* 140: PRIVATE_DEFINITION */
+    TOKEN_TYPE,
+    LL1_NT(IMP_TYPE_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(IMP_TYPE_DEFINITION_TAIL),
+  /* 141: PRIVATE_DEFINITION */
+    TOKEN_VAR,
+    LL1_NT(VAR_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(VAR_DEFINITION_TAIL),
+  /* 142: PRIVATE_DEFINITION */
+    LL1_NT(PROCEDURE_DEFINITION),
+    TOKEN_SEMICOLON,
+  /* 143: PRIVATE_DEFINITION */
+    LL1_NT(ALIAS_DEFINITION),
+    TOKEN_SEMICOLON,
+  /* 144: PRIVATE_DEFINITION */
+    LL1_NT(TO_DO_LIST),
+    TOKEN_SEMICOLON,
+  /* 145: IMP_TYPE_DEFINITION_TAIL */
+    LL1_NT(IMP_TYPE_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(IMP_TYPE_DEFINITION_TAIL),
+  /* 146: IMP_TYPE_DEFINITION_TAIL */
+  /* 147: IMP_TYPE_DEFINITION */
+    TOKEN_IDENT,
+    TOKEN_EQUAL,
+    LL1_NT(IMPLEMENTATION_TYPE),
+  /* 148: IMPLEMENTATION_TYPE */
+    LL1_NT(ALIAS_TYPE),
+  /* 149: IMPLEMENTATION_TYPE */
+    LL1_NT(QUALIDENT),
+  /* 150: IMPLEMENTATION_TYPE */
+    LL1_NT(SUBRANGE_TYPE),
+  /* 151: IMPLEMENTATION_TYPE */
+    LL1_NT(ENUM_TYPE),
+  /* 152: IMPLEMENTATION_TYPE */
+    LL1_NT(SET_TYPE),
+  /* 153: IMPLEMENTATION_TYPE */
+    LL1_NT(ARRAY_TYPE),
+  /* 154: IMPLEMENTATION_TYPE */
+    LL1_NT(RECORD_TYPE),
+  /* 155: IMPLEMENTATION_TYPE */
+    LL1_NT(PRIVATE_POINTER_TYPE),
+  /* 156: IMPLEMENTATION_TYPE */
+    LL1_NT(PROCEDURE_TYPE),
+  /* 157: PRIVATE_POINTER_TYPE */
+    TOKEN_POINTER,
+    TOKEN_TO,
+    LL1_NT(POINTER_TARGET),
+  /* 158: POINTER_TARGET */
+    LL1_NT(QUALIDENT),
+  /* 159: POINTER_TARGET */
+    TOKEN_RECORD,
+    LL1_NT(INDETERMINATE_FIELDS),
+    TOKEN_END,
+  /* 160: INDETERMINATE_FIELDS */
+    LL1_NT(VAR_DEFINITION),
+    TOKEN_SEMICOLON,
+    LL1_NT(INDETERMINATE_FIELDS),
+  /* 161: INDETERMINATE_FIELDS */
+    TOKEN_PLUS,
+    TOKEN_IDENT,
+    TOKEN_COLON,
+    TOKEN_ARRAY,
+    TOKEN_IDENT,
+    TOKEN_OF,
+    LL1_NT(QUALIDENT),
+  /* 162: ALIAS_DEFINITION */
+    TOKEN_UNQUALIFIED,
+    LL1_NT(NAME_SELECTOR),
+    LL1_NT(NAME_SELECTOR_TAIL),
+  /* 163: NAME_SELECTOR_TAIL */
+    TOKEN_COMMA,
+    LL1_NT(NAME_SELECTOR),
+    LL1_NT(NAME_SELECTOR_TAIL),
+  /* 164: NAME_SELECTOR_TAIL */
+  /* 165: NAME_SELECTOR */
+    LL1_NT(QUALIDENT),
+    LL1_NT(WILDCARD),
+  /* 166: WILDCARD */
+    TOKEN_WILDCARD,
+  /* 167: WILDCARD */
+  /* 168: STATEMENT_SEQUENCE */
+    LL1_NT(STATEMENT),
+    LL1_NT(STATEMENT_TAIL),
+  /* 169: STATEMENT_TAIL */
+    TOKEN_SEMICOLON,
+    LL1_NT(STATEMENT),
+    LL1_NT(STATEMENT_TAIL),
+  /* 170: STATEMENT_TAIL */
+  /* 171: STATEMENT */
+    TOKEN_NEW,
+    LL1_NT(DESIGNATOR),
+    LL1_NT(NEW_TAIL),
+  /* 172: STATEMENT */
+    TOKEN_RETAIN,
+    LL1_NT(DESIGNATOR),
+  /* 173: STATEMENT */
+    TOKEN_RELEASE,
+    LL1_NT(DESIGNATOR),
+  /* 174: STATEMENT */
+    LL1_NT(TARGET_DESIGNATOR),
+    LL1_NT(UPDATE_OR_CALL_TAIL),
+  /* 175: STATEMENT */
+    TOKEN_RETURN,
+    LL1_NT(RETURN_VALUE),
+  /* 176: STATEMENT */
+    TOKEN_COPY,
+    LL1_NT(TARGET_DESIGNATOR),
+    TOKEN_ASSIGN,
+    LL1_NT(EXPRESSION),
+  /* 177: STATEMENT */
+    TOKEN_READ,
+    LL1_NT(CHANNEL),
+    LL1_NT(INPUT_ARG),
+    LL1_NT(INPUT_ARG_TAIL),
+  /* 178: STATEMENT */
+    TOKEN_WRITE,
+    LL1_NT(CHANNEL),
+    LL1_NT(OUTPUT_ARGS),
+    LL1_NT(OUTPUT_ARGS_TAIL),
+  /* 179: STATEMENT */
+    LL1_NT(IF_STATEMENT),
+  /* 180: STATEMENT */
+    LL1_NT(CASE_STATEMENT),
+  /* 181: STATEMENT */
+    TOKEN_LOOP,
+    LL1_NT(STATEMENT_SEQUENCE),
+    TOKEN_END,
+  /* 182: STATEMENT */
+    TOKEN_WHILE,
+    LL1_NT(EXPRESSION),
+    TOKEN_DO,
+    LL1_NT(STATEMENT_SEQUENCE),
+    TOKEN_END,
+  /* 183: STATEMENT */
+    TOKEN_REPEAT,
+    LL1_NT(STATEMENT_SEQUENCE),
+    TOKEN_UNTIL,
+    LL1_NT(EXPRESSION),
+  /* 184: STATEMENT */
+    LL1_NT(FOR_STATEMENT),
+  /* 185: STATEMENT */
+    LL1_NT(TO_DO_LIST),
+  /* 186: STATEMENT */
+    TOKEN_EXIT,
+  /* 187: STATEMENT */
+    TOKEN_NOP,
+  /* 188: NEW_TAIL */
+    TOKEN_ASSIGN,
+    LL1_NT(STRUCTURED_VALUE),
+  /* 189: NEW_TAIL */
+    TOKEN_IDENT,
+    LL1_NT(EXPRESSION),
+  /* 190: NEW_TAIL */
+  /* 191: UPDATE_OR_CALL_TAIL */
+    TOKEN_ASSIGN,
+    LL1_NT(EXPRESSION),
+  /* 192: UPDATE_OR_CALL_TAIL */
+    TOKEN_PLUS_PLUS,
+  /* 193: UPDATE_OR_CALL_TAIL */
+    TOKEN_MINUS_MINUS,
+  /* 194: UPDATE_OR_CALL_TAIL */
+    LL1_NT(FUNCTION_CALL_TAIL),
+  /* 195: UPDATE_OR_CALL_TAIL */
+  /* 196: RETURN_VALUE */
+    LL1_NT(EXPRESSION),
+  /* 197: RETURN_VALUE */
+  /* 198: CHANNEL */
+    TOKEN_AT_SIGN,
+    LL1_NT(DESIGNATOR),
+    TOKEN_COLON,
+  /* 199: CHANNEL */
+  /* 200: INPUT_ARG */
+    TOKEN_NEW,
+    LL1_NT(DESIGNATOR),
+  /* 201: INPUT_ARG */
+    LL1_NT(DESIGNATOR),
+  /* 202: INPUT_ARG_TAIL */
+    TOKEN_COMMA,
+    LL1_NT(INPUT_ARG),
+    LL1_NT(INPUT_ARG_TAIL),
+  /* 203: INPUT_ARG_TAIL */
+  /* 204: OUTPUT_ARGS */
+    TOKEN_HASH,
+    TOKEN_LPAREN,
+    LL1_NT(EXPRESSION),
+    TOKEN_COMMA,
+    LL1_NT(EXPRESSION_LIST),
+    TOKEN_RPAREN,
+  /* 205: OUTPUT_ARGS */
+    LL1_NT(EXPRESSION),
+  /* 206: OUTPUT_ARGS_TAIL */
+    TOKEN_COMMA,
+    LL1_NT(OUTPUT_ARGS),
+    LL1_NT(OUTPUT_ARGS_TAIL),
+  /* 207: OUTPUT_ARGS_TAIL */
+  /* 208: IF_STATEMENT */
+    TOKEN_IF,
+    LL1_NT(EXPRESSION),
+    TOKEN_THEN,
+    LL1_NT(STATEMENT_SEQUENCE),
+    LL1_NT(ELSIF_LIST),
+    LL1_NT(ELSE_BRANCH),
+    TOKEN_END,
+  /* 209: ELSIF_LIST */
+    TOKEN_ELSIF,
+    LL1_NT(EXPRESSION),
+    TOKEN_THEN,
+    LL1_NT(STATEMENT_SEQUENCE),
+    LL1_NT(ELSIF_LIST),
+  /* 210: ELSIF_LIST */
+  /* 211: ELSE_BRANCH */
+    TOKEN_ELSE,
+    LL1_NT(STATEMENT_SEQUENCE),
+  /* 212: ELSE_BRANCH */
+  /* 213: CASE_STATEMENT */
+    TOKEN_CASE,
+    LL1_NT(EXPRESSION),
+    TOKEN_OF,
+    TOKEN_BAR,
+    LL1_NT(CASE),
+    LL1_NT(CASE_LIST_TAIL),
+    LL1_NT(ELSE_BRANCH),
+    TOKEN_END,
+  /* 214: CASE_LIST_TAIL */
+    TOKEN_BAR,
+    LL1_NT(CASE),
+    LL1_NT(CASE_LIST_TAIL),
+  /* 215: CASE_LIST_TAIL */
+  /* 216: CASE */
+    LL1_NT(CASE_LABELS),
+    LL1_NT(CASE_LABELS_TAIL),
+    TOKEN_COLON,
+    LL1_NT(STATEMENT_SEQUENCE),
+  /* 217: CASE_LABELS_TAIL */
+    TOKEN_COMMA,
+    LL1_NT(CASE_LABELS),
+    LL1_NT(CASE_LABELS_TAIL),
+  /* 218: CASE_LABELS_TAIL */
+  /* 219: CASE_LABELS */
+    LL1_NT(EXPRESSION),
+    LL1_NT(RANGE_TAIL),
+  /* 220: RANGE_TAIL */
+    TOKEN_DOT_DOT,
+    LL1_NT(EXPRESSION),
+  /* 221: RANGE_TAIL */
+  /* 222: FOR_STATEMENT */
+    TOKEN_FOR,
+    TOKEN_IDENT,
+    LL1_NT(DESCENDER),
+    LL1_NT(FOR_VALUE),
+    TOKEN_IN,
+    LL1_NT(ITERABLE_EXPR),
+    TOKEN_DO,
+    LL1_NT(STATEMENT_SEQUENCE),
+    TOKEN_END,
+  /* 223: DESCENDER */
+    TOKEN_MINUS_MINUS,
+  /* 224: DESCENDER */
+  /* 225: FOR_VALUE */
+    TOKEN_COMMA,
+    TOKEN_IDENT,
+  /* 226: FOR_VALUE */
+  /* 227: ITERABLE_EXPR */
+    LL1_NT(SUBRANGE_TYPE),
+  /* 228: ITERABLE_EXPR */
+    LL1_NT(QUALIDENT),
+    LL1_NT(ITERABLE_RANGE),
+  /* 229: ITERABLE_RANGE */
+    LL1_NT(VALUE_RANGE),
+  /* 230: ITERABLE_RANGE */
+  /* 231: DESIGNATOR */
+    LL1_NT(QUALIDENT),
+    LL1_NT(DESIGNATOR_TAIL),
+  /* 232: DESIGNATOR_TAIL */
+    LL1_NT(DEREF_TAIL),
+  /* 233: DESIGNATOR_TAIL */
+    LL1_NT(SUBSCRIPT_TAIL),
+  /* 234: DESIGNATOR_TAIL */
+  /* 235: DEREF_TAIL */
+    LL1_NT(DEREF),
+    LL1_NT(DEREF_TAIL_REST),
+  /* 236: DEREF_TAIL_REST */
+    TOKEN_DOT,
+    LL1_NT(DESIGNATOR),
+  /* 237: DEREF_TAIL_REST */
+    LL1_NT(SUBSCRIPT_TAIL),
+  /* 238: DEREF_TAIL_REST */
+  /* 239: SUBSCRIPT_TAIL */
+    TOKEN_LBRACKET,
+    LL1_NT(EXPRESSION),
+    TOKEN_RBRACKET,
+    LL1_NT(SUBSCRIPT_TAIL_REST),
+  /* 240: SUBSCRIPT_TAIL_REST */
+    TOKEN_DOT,
+    LL1_NT(DESIGNATOR),
+  /* 241: SUBSCRIPT_TAIL_REST */
+    LL1_NT(DEREF_TAIL),
+  /* 242: SUBSCRIPT_TAIL_REST */
+  /* 243: DEREF */
+    TOKEN_DEREF,
+    LL1_NT(DEREF_TAIL_MORE),
+  /* 244: DEREF_TAIL_MORE */
+    TOKEN_DEREF,
+    LL1_NT(DEREF_TAIL_MORE),
+  /* 245: DEREF_TAIL_MORE */
+  /* 246: TARGET_DESIGNATOR */
+    LL1_NT(QUALIDENT),
+    LL1_NT(TARGET_TAIL),
+  /* 247: TARGET_TAIL */
+    LL1_NT(DEREF_TARGET_TAIL),
+  /* 248: TARGET_TAIL */
+    LL1_NT(BRACKET_TARGET_TAIL),
+  /* 249: TARGET_TAIL */
+  /* 250: DEREF_TARGET_TAIL */
+    LL1_NT(DEREF),
+    LL1_NT(DEREF_TARGET_REST),
+  /* 251: DEREF_TARGET_REST */
+    TOKEN_DOT,
+    LL1_NT(TARGET_DESIGNATOR),
+  /* 252: DEREF_TARGET_REST */
+    LL1_NT(BRACKET_TARGET_TAIL),
+  /* 253: DEREF_TARGET_REST */
+  /* 254: BRACKET_TARGET_TAIL */
+    TOKEN_LBRACKET,
+    LL1_NT(EXPRESSION),
+    LL1_NT(BRACKET_TARGET_REST),
+  /* 255: BRACKET_TARGET_REST */
+    TOKEN_RBRACKET,
+    LL1_NT(BRACKET_TARGET_AFTER),
+  /* 256: BRACKET_TARGET_REST */
+    TOKEN_DOT_DOT,
+    LL1_NT(RETURN_VALUE),
+    TOKEN_RBRACKET,
+  /* 257: BRACKET_TARGET_AFTER */
+    TOKEN_DOT,
+    LL1_NT(TARGET_DESIGNATOR),
+  /* 258: BRACKET_TARGET_AFTER */
+    LL1_NT(DEREF_TARGET_TAIL),
+  /* 259: BRACKET_TARGET_AFTER */
+  /* 260: EXPRESSION_LIST */
+    LL1_NT(EXPRESSION),
+    LL1_NT(EXPRESSION_LIST_TAIL),
+  /* 261: EXPRESSION_LIST_TAIL */
+    TOKEN_COMMA,
+    LL1_NT(EXPRESSION),
+    LL1_NT(EXPRESSION_LIST_TAIL),
+  /* 262: EXPRESSION_LIST_TAIL */
+  /* 263: EXPRESSION */
+    LL1_NT(SIMPLE_EXPRESSION),
+    LL1_NT(RELATION),
+  /* 264: RELATION */
+    LL1_NT(OPER_L1),
+    LL1_NT(SIMPLE_EXPRESSION),
+  /* 265: RELATION */
+  /* 266: OPER_L1 */
+    TOKEN_EQUAL,
+  /* 267: OPER_L1 */
+    TOKEN_NOT_EQUAL,
+  /* 268: OPER_L1 */
+    TOKEN_LESS,
+  /* 269: OPER_L1 */
+    TOKEN_LESS_OR_EQ,
+  /* 270: OPER_L1 */
+    TOKEN_GREATER,
+  /* 271: OPER_L1 */
+    TOKEN_GREATER_OR_EQ,
+  /* 272: OPER_L1 */
+    TOKEN_IDENTITY,
+  /* 273: OPER_L1 */
+    TOKEN_IN,
+  /* 274: SIMPLE_EXPRESSION */
+    LL1_NT(TERM),
+    LL1_NT(TERM_TAIL),
+  /* 275: SIMPLE_EXPRESSION */
+    TOKEN_MINUS,
+    LL1_NT(FACTOR),
+  /* 276: TERM_TAIL */
+    LL1_NT(OPER_L2),
+    LL1_NT(TERM),
+    LL1_NT(TERM_TAIL),
+  /* 277: TERM_TAIL */
+  /* 278: OPER_L2 */
+    TOKEN_PLUS,
+  /* 279: OPER_L2 */
+    TOKEN_MINUS,
+  /* 280: OPER_L2 */
+    TOKEN_OR,
+  /* 281: OPER_L2 */
+    TOKEN_CONCAT,
+  /* 282: OPER_L2 */
+    TOKEN_SET_DIFF,
+  /* 283: TERM */
+    LL1_NT(SIMPLE_TERM),
+    LL1_NT(SIMPLE_TERM_TAIL),
+  /* 284: SIMPLE_TERM_TAIL */
+    LL1_NT(OPER_L3),
+    LL1_NT(SIMPLE_TERM),
+    LL1_NT(SIMPLE_TERM_TAIL),
+  /* 285: SIMPLE_TERM_TAIL */
+  /* 286: OPER_L3 */
+    TOKEN_ASTERISK,
+  /* 287: OPER_L3 */
+    TOKEN_SOLIDUS,
+  /* 288: OPER_L3 */
+    TOKEN_DIV,
+  /* 289: OPER_L3 */
+    TOKEN_MOD,
+  /* 290: OPER_L3 */
+    TOKEN_AND,
+  /* 291: SIMPLE_TERM */
+    TOKEN_NOT,
+    LL1_NT(FACTOR),
+  /* 292: SIMPLE_TERM */
+    LL1_NT(FACTOR),
+  /* 293: FACTOR */
+    LL1_NT(SIMPLE_FACTOR),
+    LL1_NT(TYPE_CONVERSION),
+  /* 294: TYPE_CONVERSION */
+    TOKEN_TYPE_CONV,
+    LL1_NT(QUALIDENT),
+  /* 295: TYPE_CONVERSION */
+  /* 296: SIMPLE_FACTOR */
+    TOKEN_WHOLE_NUMBER,
+  /* 297: SIMPLE_FACTOR */
+    TOKEN_REAL_NUMBER,
+  /* 298: SIMPLE_FACTOR */
+    TOKEN_CHAR_CODE,
+  /* 299: SIMPLE_FACTOR */
+    TOKEN_QUOTED_STRING,
+  /* 300: SIMPLE_FACTOR */
+    LL1_NT(STRUCTURED_VALUE),
+  /* 301: SIMPLE_FACTOR */
+    LL1_NT(SOURCE_DESIGNATOR),
+  /* 302: SIMPLE_FACTOR */
+    TOKEN_LPAREN,
+    LL1_NT(EXPRESSION),
+    TOKEN_RPAREN,
+  /* 303: SOURCE_DESIGNATOR */
+    LL1_NT(QUALIDENT),
+    LL1_NT(SOURCE_TAIL),
+  /* 304: SOURCE_TAIL */
+    LL1_NT(FUNCTION_CALL_TAIL),
+  /* 305: SOURCE_TAIL */
+    LL1_NT(DEREF_SOURCE_TAIL),
+  /* 306: SOURCE_TAIL */
+    LL1_NT(BRACKET_SOURCE_TAIL),
+  /* 307: SOURCE_TAIL */
+  /* 308: FUNCTION_CALL_TAIL */
+    TOKEN_LPAREN,
+    LL1_NT(ARGUMENTS),
+    TOKEN_RPAREN,
+  /* 309: ARGUMENTS */
+    LL1_NT(EXPRESSION_LIST),
+  /* 310: ARGUMENTS */
+  /* 311: DEREF_SOURCE_TAIL */
+    LL1_NT(DEREF),
+    LL1_NT(DEREF_SOURCE_REST),
+  /* 312: DEREF_SOURCE_REST */
+    TOKEN_DOT,
+    LL1_NT(SOURCE_DESIGNATOR),
+  /* 313: DEREF_SOURCE_REST */
+    LL1_NT(FUNCTION_CALL_TAIL),
+  /* 314: DEREF_SOURCE_REST */
+    LL1_NT(BRACKET_SOURCE_TAIL),
+  /* 315: DEREF_SOURCE_REST */
+  /* 316: BRACKET_SOURCE_TAIL */
+    TOKEN_LBRACKET,
+    LL1_NT(EXPRESSION),
+    LL1_NT(BRACKET_SOURCE_REST),
+  /* 317: BRACKET_SOURCE_REST */
+    TOKEN_RBRACKET,
+    LL1_NT(BRACKET_SOURCE_AFTER),
+  /* 318: BRACKET_SOURCE_REST */
+    TOKEN_DOT_DOT,
+    LL1_NT(EXPRESSION),
+    TOKEN_RBRACKET,
+  /* 319: BRACKET_SOURCE_AFTER */
+    TOKEN_DOT,
+    LL1_NT(SOURCE_DESIGNATOR),
+  /* 320: BRACKET_SOURCE_AFTER */
+    LL1_NT(FUNCTION_CALL_TAIL),
+  /* 321: BRACKET_SOURCE_AFTER */
+    LL1_NT(DEREF_SOURCE_TAIL),
+  /* 322: BRACKET_SOURCE_AFTER */
+  /* 323: STRUCTURED_VALUE */
+    TOKEN_LBRACE,
+    LL1_NT(STRUCTURED_VALUE_BODY),
+    TOKEN_RBRACE,
+  /* 324: STRUCTURED_VALUE_BODY */
+    LL1_NT(VALUE_COMPONENT),
+    LL1_NT(VALUE_COMPONENT_TAIL),
+  /* 325: STRUCTURED_VALUE_BODY */
+    TOKEN_ASTERISK,
+  /* 326: VALUE_COMPONENT_TAIL */
+    TOKEN_COMMA,
+    LL1_NT(VALUE_COMPONENT),
+    LL1_NT(VALUE_COMPONENT_TAIL),
+  /* 327: VALUE_COMPONENT_TAIL */
+  /* 328: VALUE_COMPONENT */
+    LL1_NT(EXPRESSION),
+    LL1_NT(RANGE_TAIL),
+  /* 329: TO_DO_LIST */
+    TOKEN_TO,
+    TOKEN_DO,
+    LL1_NT(TO_DO_BODY),
+  /* 330: TO_DO_BODY */
+    LL1_NT(TRACKING_REF),
+    LL1_NT(TASK_TO_DO),
+    LL1_NT(TASK_TO_DO_TAIL),
+    TOKEN_END,
+  /* 331: TO_DO_BODY */
+  /* 332: TRACKING_REF */
+    TOKEN_LPAREN,
+    TOKEN_WHOLE_NUMBER,
+    LL1_NT(TRACKING_DETAIL),
+    TOKEN_RPAREN,
+  /* 333: TRACKING_REF */
+  /* 334: TRACKING_DETAIL */
+    TOKEN_COMMA,
+    TOKEN_WHOLE_NUMBER,
+    TOKEN_COMMA,
+    TOKEN_QUOTED_STRING,
+  /* 335: TRACKING_DETAIL */
+  /* 336: TASK_TO_DO */
+    TOKEN_QUOTED_STRING,
+    LL1_NT(ESTIMATE),
+  /* 337: ESTIMATE */
+    TOKEN_COMMA,
+    TOKEN_WHOLE_NUMBER,
+    TOKEN_IDENT,
+  /* 338: ESTIMATE */
+  /* 339: TASK_TO_DO_TAIL */
+    TOKEN_SEMICOLON,
+    LL1_NT(TASK_TO_DO),
+    LL1_NT(TASK_TO_DO_TAIL),
+  /* 340: TASK_TO_DO_TAIL */
+  0 /* sentinel */
+};
+
+static const uint16_t ll1_rule_start[LL1_RULE_COUNT] = {
+  0, 1, 2, 3, 13, 15, 15, 20, 24, 24, 25, 25,
+  27, 27, 31, 35, 39, 41, 43, 46, 46, 51, 54, 54,
+  56, 56, 58, 61, 61, 64, 64, 67, 68, 69, 70, 71,
+  72, 73, 74, 75, 76, 77, 80, 83, 88, 92, 95, 95,
+  97, 100, 100, 103, 107, 112, 115, 115, 118, 118, 121, 123,
+  126, 126, 129, 133, 133, 136, 136, 138, 138, 140, 141, 142,
+  142, 143, 146, 149, 151, 152, 153, 153, 156, 156, 159, 160,
+  161, 162, 163, 168, 171, 171, 173, 174, 175, 177, 179, 180,
+  181, 182, 182, 183, 183, 184, 184, 188, 188, 191, 191, 195,
+  203, 205, 205, 209, 213, 215, 215, 219, 223, 227, 229, 231,
+  233, 236, 236, 239, 240, 241, 242, 243, 244, 245, 246, 247,
+  248, 252, 261, 264, 266, 266, 268, 268, 272, 276, 280, 282,
+  284, 286, 289, 289, 292, 293, 294, 295, 296, 297, 298, 299,
+  300, 301, 304, 305, 308, 311, 318, 321, 324, 324, 326, 327,
+  327, 329, 332, 332, 335, 337, 339, 341, 343, 347, 351, 355,
+  356, 357, 360, 365, 369, 370, 371, 372, 373, 375, 377, 377,
+  379, 380, 381, 382, 382, 383, 383, 386, 386, 388, 389, 392,
+  392, 398, 399, 402, 402, 409, 414, 414, 416, 416, 424, 427,
+  427, 431, 434, 434, 436, 438, 438, 447, 448, 448, 450, 450,
+  451, 453, 454, 454, 456, 457, 458, 458, 460, 462, 463, 463,
+  467, 469, 470, 470, 472, 474, 474, 476, 477, 478, 478, 480,
+  482, 483, 483, 486, 488, 491, 493, 494, 494, 496, 499, 499,
+  501, 503, 503, 504, 505, 506, 507, 508, 509, 510, 511, 513,
+  515, 518, 518, 519, 520, 521, 522, 523, 525, 528, 528, 529,
+  530, 531, 532, 533, 535, 536, 538, 540, 540, 541, 542, 543,
+  544, 545, 546, 549, 551, 552, 553, 554, 554, 557, 558, 558,
+  560, 562, 563, 564, 564, 567, 569, 572, 574, 575, 576, 576,
+  579, 581, 582, 585, 585, 587, 590, 594, 594, 598, 598, 602,
+  602, 604, 607, 607, 610
+};
+
+static const uint8_t ll1_rule_length[LL1_RULE_COUNT] = {
+  1, 1, 1, 10, 2, 0, 5, 4, 0, 1, 0, 2, 0, 4, 4, 4,
+  2, 2, 3, 0, 5, 3, 0, 2, 0, 2, 3, 0, 3, 0, 3, 1,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 3, 5, 4, 3, 0, 2,
+  3, 0, 3, 4, 5, 3, 0, 3, 0, 3, 2, 3, 0, 3, 4, 0,
+  3, 0, 2, 0, 2, 1, 1, 0, 1, 3, 3, 2, 1, 1, 0, 3,
+  0, 3, 1, 1, 1, 1, 5, 3, 0, 2, 1, 1, 2, 2, 1, 1,
+  1, 0, 1, 0, 1, 0, 4, 0, 3, 0, 4, 8, 2, 0, 4, 4,
+  2, 0, 4, 4, 4, 2, 2, 2, 3, 0, 3, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 4, 9, 3, 2, 0, 2, 0, 4, 4, 4, 2, 2,
+  2, 3, 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 3,
+  3, 7, 3, 3, 0, 2, 1, 0, 2, 3, 0, 3, 2, 2, 2, 2,
+  4, 4, 4, 1, 1, 3, 5, 4, 1, 1, 1, 1, 2, 2, 0, 2,
+  1, 1, 1, 0, 1, 0, 3, 0, 2, 1, 3, 0, 6, 1, 3, 0,
+  7, 5, 0, 2, 0, 8, 3, 0, 4, 3, 0, 2, 2, 0, 9, 1,
+  0, 2, 0, 1, 2, 1, 0, 2, 1, 1, 0, 2, 2, 1, 0, 4,
+  2, 1, 0, 2, 2, 0, 2, 1, 1, 0, 2, 2, 1, 0, 3, 2,
+  3, 2, 1, 0, 2, 3, 0, 2, 2, 0, 1, 1, 1, 1, 1, 1,
+  1, 1, 2, 2, 3, 0, 1, 1, 1, 1, 1, 2, 3, 0, 1, 1,
+  1, 1, 1, 2, 1, 2, 2, 0, 1, 1, 1, 1, 1, 1, 3, 2,
+  1, 1, 1, 0, 3, 1, 0, 2, 2, 1, 1, 0, 3, 2, 3, 2,
+  1, 1, 0, 3, 2, 1, 3, 0, 2, 3, 4, 0, 4, 0, 4, 0,
+  2, 3, 0, 3, 0
+};
+
+static const uint16_t ll1_table[LL1_NONTERMINAL_COUNT][TOKEN_END_MARK] = {
+  /* COMPILATION_UNIT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 2, 0, 0, 1, 0, 0, 3,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* INTERFACE_MODULE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMPORT_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0,
+    0, 6, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0,
+    0, 0, 0, 0, 0, 6, 6, 0, 0, 6, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMPORT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMPORT_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 8, 0, 9, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RE_EXPORT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 11, 0, 11, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DECLARATION_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0,
+    0, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0,
+    0, 0, 0, 0, 0, 12, 12, 0, 0, 12, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DECLARATION */ {
+    0, 0, 0, 0, 0, 0, 0, 14, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 17, 0, 0, 0,
+    0, 0, 0, 0, 0, 18, 15, 0, 0, 16, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CONST_DEFINITION_TAIL */ {
+    0, 0, 0, 0, 0, 20, 0, 20, 0, 0, 0, 0,
+    0, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 20, 0, 0, 0,
+    0, 0, 0, 0, 0, 20, 20, 20, 0, 20, 0, 0,
+    19, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 19, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CONST_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    21, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 21, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CONST_BINDING */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 22, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CONST_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 24, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* QUALIDENT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* QUALIDENT_TAIL */ {
+    0, 0, 28, 0, 0, 0, 0, 0, 0, 28, 28, 28,
+    28, 28, 0, 0, 0, 0, 0, 28, 0, 0, 28, 0,
+    0, 0, 0, 28, 28, 0, 28, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 28, 0, 0, 0, 28, 0, 0, 0,
+    28, 0, 0, 0, 0, 28, 28, 28, 0, 28, 28, 28,
+    28, 28, 28, 28, 28, 28, 28, 0, 28, 28, 28, 28,
+    28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 27,
+    28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TYPE_DEFINITION_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 30, 0, 0, 0, 0,
+    0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 30, 0, 0, 0,
+    0, 0, 0, 0, 0, 30, 30, 0, 0, 30, 0, 0,
+    29, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TYPE_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PUBLIC_TYPE */ {
+    0, 32, 0, 0, 37, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 40, 0, 39, 41, 0, 38, 0,
+    0, 0, 0, 36, 0, 0, 0, 0, 0, 0, 0, 0,
+    33, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 35, 0, 34, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ALIAS_TYPE */ {
+    0, 42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SUBRANGE_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 43, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* VALUE_RANGE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 44, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ENUM_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 45, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ENUM_BASE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 46, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IDENT_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IDENT_LIST_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 49, 50, 50, 0, 0, 0, 0,
+    0, 0, 0, 0, 50, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SET_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 51, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ARRAY_TYPE */ {
+    0, 0, 0, 0, 52, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RECORD_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RECORD_BASE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FIELD_LIST_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 57, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 56, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* POINTER_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 58, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* OPAQUE_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 59, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ALLOC_SIZE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 61, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 60, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PROCEDURE_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FORMAL_TYPE_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 64, 64, 0, 0, 0, 0,
+    0, 0, 0, 63, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FORMAL_TYPE_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 65, 0, 0, 0, 0,
+    0, 0, 0, 0, 66, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RETURN_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 68, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 67, 68, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FORMAL_TYPE */ {
+    0, 0, 0, 69, 69, 0, 0, 69, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 69, 0, 0,
+    69, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ATTRIBUTE */ {
+    0, 0, 0, 72, 72, 0, 0, 70, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 71, 0, 0,
+    72, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* NON_ATTR_FORMAL_TYPE */ {
+    0, 0, 0, 74, 73, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    73, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SIMPLE_FORMAL_TYPE */ {
+    0, 0, 0, 0, 75, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    76, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CAST_TARGET */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 77, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    78, 0, 0, 0, 0, 0, 0, 79, 0, 0, 0, 0,
+    0, 0, 0, 0, 79, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* VAR_DEFINITION_TAIL */ {
+    0, 0, 0, 0, 0, 81, 0, 81, 0, 0, 0, 0,
+    0, 81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 81, 0, 0, 0,
+    0, 0, 0, 0, 0, 81, 81, 81, 0, 81, 0, 0,
+    80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* VAR_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    82, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* VAR_TYPE */ {
+    0, 0, 0, 0, 85, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 86, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 84, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PROCEDURE_HEADER */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 87, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PROC_BINDING */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    89, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 88, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BINDING_SPECIFIER */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    90, 0, 0, 0, 0, 0, 0, 0, 0, 93, 0, 92,
+    0, 91, 0, 0, 0, 0, 0, 0, 0, 0, 0, 94,
+    95, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* NEW_BINDING */ {
+    0, 0, 0, 96, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    97, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 98, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* READ_BINDING */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    99, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 100, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* WRITE_BINDING */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 102, 0, 0, 0, 101, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FORMAL_PARAM_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 104, 104, 0, 0, 0, 0,
+    0, 0, 0, 103, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FORMAL_PARAMS_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 105, 0, 0, 0, 0,
+    0, 0, 0, 0, 106, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FORMAL_PARAMS */ {
+    0, 0, 0, 0, 0, 0, 0, 107, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 107, 0, 0,
+    107, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PROGRAM_MODULE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 108,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PRIVATE_IMPORT_LIST */ {
+    0, 0, 0, 0, 0, 110, 0, 110, 0, 0, 0, 0,
+    0, 110, 0, 0, 0, 0, 109, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 110, 0, 0, 0,
+    0, 0, 0, 0, 0, 110, 110, 110, 0, 110, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PRIVATE_IMPORT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 111, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BLOCK */ {
+    0, 0, 0, 0, 0, 112, 0, 112, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 112, 0, 0, 0,
+    0, 0, 0, 0, 0, 112, 112, 112, 0, 112, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEFINITION_LIST */ {
+    0, 0, 0, 0, 0, 114, 0, 113, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 113, 0, 0, 0,
+    0, 0, 0, 0, 0, 113, 113, 113, 0, 113, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 115, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 118, 0, 0, 0,
+    0, 0, 0, 0, 0, 120, 116, 119, 0, 117, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PGM_TYPE_DEFINITION_TAIL */ {
+    0, 0, 0, 0, 0, 122, 0, 122, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 122, 0, 0, 0,
+    0, 0, 0, 0, 0, 122, 122, 122, 0, 122, 0, 0,
+    121, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PGM_TYPE_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    123, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PROGRAM_TYPE */ {
+    0, 124, 0, 0, 129, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 131, 132, 0, 130, 0,
+    0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 0,
+    125, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 127, 0, 126, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PROCEDURE_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 133, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMPLEMENTATION_MODULE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 134, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PRIVATE_BLOCK */ {
+    0, 0, 0, 0, 0, 135, 0, 135, 0, 0, 0, 0,
+    0, 135, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 135, 0, 0, 0,
+    0, 0, 0, 0, 0, 135, 135, 135, 0, 135, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* MODULE_BODY */ {
+    0, 0, 0, 0, 0, 136, 0, 0, 0, 0, 0, 0,
+    0, 137, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PRIVATE_DEFINITION_LIST */ {
+    0, 0, 0, 0, 0, 139, 0, 138, 0, 0, 0, 0,
+    0, 139, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 138, 0, 0, 0,
+    0, 0, 0, 0, 0, 138, 138, 138, 0, 138, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PRIVATE_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 140, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 143, 0, 0, 0,
+    0, 0, 0, 0, 0, 145, 141, 144, 0, 142, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMP_TYPE_DEFINITION_TAIL */ {
+    0, 0, 0, 0, 0, 147, 0, 147, 0, 0, 0, 0,
+    0, 147, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 147, 0, 0, 0,
+    0, 0, 0, 0, 0, 147, 147, 147, 0, 147, 0, 0,
+    146, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMP_TYPE_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    148, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IMPLEMENTATION_TYPE */ {
+    0, 149, 0, 0, 154, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 156, 157, 0, 155, 0,
+    0, 0, 0, 153, 0, 0, 0, 0, 0, 0, 0, 0,
+    150, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 152, 0, 151, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* PRIVATE_POINTER_TYPE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 158, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* POINTER_TARGET */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 160, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    159, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* INDETERMINATE_FIELDS */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    161, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 162, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ALIAS_DEFINITION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 163, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* NAME_SELECTOR_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 164, 0, 165, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* NAME_SELECTOR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    166, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* WILDCARD */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 168, 0, 168, 0, 0, 0, 0,
+    0, 0, 167, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* STATEMENT_SEQUENCE */ {
+    0, 0, 0, 0, 0, 0, 169, 0, 169, 0, 0, 0,
+    0, 0, 169, 169, 169, 0, 0, 0, 0, 169, 0, 0,
+    169, 169, 0, 0, 0, 0, 0, 0, 0, 169, 0, 169,
+    169, 169, 169, 0, 0, 169, 0, 0, 0, 0, 169, 169,
+    169, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* STATEMENT_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 171,
+    171, 171, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 171, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 170, 0, 171, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* STATEMENT */ {
+    0, 0, 0, 0, 0, 0, 181, 0, 177, 0, 0, 0,
+    0, 0, 187, 185, 180, 0, 0, 0, 0, 182, 0, 0,
+    172, 188, 0, 0, 0, 0, 0, 0, 0, 178, 0, 174,
+    184, 173, 176, 0, 0, 186, 0, 0, 0, 0, 183, 179,
+    175, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* NEW_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 191,
+    191, 191, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 191, 0, 0, 0,
+    190, 0, 0, 0, 0, 0, 0, 191, 0, 191, 0, 189,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* UPDATE_OR_CALL_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 196,
+    196, 196, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 196, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 196, 0, 196, 0, 192,
+    193, 194, 0, 195, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RETURN_VALUE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 198,
+    198, 198, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 197, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 198, 0, 0, 0,
+    197, 197, 197, 197, 197, 0, 0, 198, 0, 198, 0, 0,
+    0, 0, 0, 197, 0, 0, 198, 197, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 197, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CHANNEL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    200, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    200, 200, 200, 200, 200, 0, 0, 0, 199, 0, 0, 0,
+    0, 0, 0, 200, 0, 0, 0, 200, 0, 0, 200, 0,
+    0, 0, 0, 0, 0, 200, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* INPUT_ARG */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    201, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    202, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* INPUT_ARG_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 204,
+    204, 204, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 204, 0, 0, 0,
+    0, 0, 0, 0, 0, 203, 0, 204, 0, 204, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* OUTPUT_ARGS */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 206, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    206, 206, 206, 206, 206, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 206, 0, 0, 0, 206, 0, 0, 205, 0,
+    0, 0, 0, 0, 0, 206, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* OUTPUT_ARGS_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 208,
+    208, 208, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 208, 0, 0, 0,
+    0, 0, 0, 0, 0, 207, 0, 208, 0, 208, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* IF_STATEMENT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 209, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ELSIF_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 211,
+    210, 211, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ELSE_BRANCH */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 212,
+    0, 213, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CASE_STATEMENT */ {
+    0, 0, 0, 0, 0, 0, 214, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CASE_LIST_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 216,
+    0, 216, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 215, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CASE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 217, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    217, 217, 217, 217, 217, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 217, 0, 0, 0, 217, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 217, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CASE_LABELS_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 218, 219, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* CASE_LABELS */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 220, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    220, 220, 220, 220, 220, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 220, 0, 0, 0, 220, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 220, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RANGE_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 222, 222, 0, 0, 0, 221, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 222, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FOR_STATEMENT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 223, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DESCENDER */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 225, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 225, 0, 0, 0, 0, 0, 0,
+    0, 224, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FOR_VALUE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 227, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 226, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ITERABLE_EXPR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    229, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 228, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ITERABLE_RANGE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 231, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 230, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DESIGNATOR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    232, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DESIGNATOR_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 235,
+    235, 235, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 235, 0, 0, 0,
+    235, 0, 0, 0, 0, 235, 235, 235, 0, 235, 0, 235,
+    0, 0, 0, 0, 0, 234, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    233, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    236, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_TAIL_REST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 239,
+    239, 239, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 239, 0, 0, 0,
+    239, 0, 0, 0, 0, 239, 239, 239, 0, 239, 0, 239,
+    0, 0, 0, 0, 0, 238, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 237,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SUBSCRIPT_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 240, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SUBSCRIPT_TAIL_REST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 243,
+    243, 243, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 243, 0, 0, 0,
+    243, 0, 0, 0, 0, 243, 243, 243, 0, 243, 0, 243,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 241,
+    242, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    244, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_TAIL_MORE */ {
+    0, 0, 246, 0, 0, 0, 0, 0, 0, 246, 246, 246,
+    246, 246, 0, 0, 0, 0, 0, 246, 0, 0, 246, 0,
+    0, 0, 0, 0, 246, 0, 246, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 246, 0, 0, 0, 246, 0, 0, 0,
+    246, 0, 0, 0, 0, 246, 246, 246, 0, 246, 246, 246,
+    246, 246, 0, 246, 246, 246, 246, 0, 246, 246, 246, 246,
+    246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+    245, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TARGET_DESIGNATOR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    247, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TARGET_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 250,
+    250, 250, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 250, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 250, 0, 250, 0, 250,
+    250, 250, 0, 250, 0, 249, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    248, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_TARGET_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    251, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_TARGET_REST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 254,
+    254, 254, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 254, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 254, 0, 254, 0, 254,
+    254, 254, 0, 254, 0, 253, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 252,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BRACKET_TARGET_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 255, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BRACKET_TARGET_REST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 257, 0,
+    0, 0, 0, 0, 0, 0, 256, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BRACKET_TARGET_AFTER */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 260,
+    260, 260, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 260, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 260, 0, 260, 0, 260,
+    260, 260, 0, 260, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 258,
+    259, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* EXPRESSION_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 261, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    261, 261, 261, 261, 261, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 261, 0, 0, 0, 261, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 261, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* EXPRESSION_LIST_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 262, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 263, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* EXPRESSION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 264, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    264, 264, 264, 264, 264, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 264, 0, 0, 0, 264, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 264, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* RELATION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 266, 266,
+    266, 266, 0, 0, 0, 0, 0, 265, 0, 0, 0, 0,
+    0, 0, 0, 0, 266, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 266, 0, 0, 0, 266, 0, 0, 0,
+    0, 0, 0, 0, 0, 266, 266, 266, 0, 266, 266, 0,
+    0, 0, 0, 0, 266, 0, 266, 0, 266, 265, 265, 265,
+    265, 265, 265, 265, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* OPER_L1 */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 274, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 267, 268, 269,
+    270, 271, 272, 273, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SIMPLE_EXPRESSION */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 275, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    275, 275, 275, 275, 275, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 275, 0, 0, 0, 275, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 276, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TERM_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 278, 278,
+    278, 278, 0, 0, 0, 0, 0, 278, 0, 0, 0, 0,
+    0, 0, 0, 0, 278, 0, 277, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 278, 0, 0, 0, 278, 0, 0, 0,
+    0, 0, 0, 0, 0, 278, 278, 278, 0, 278, 278, 0,
+    0, 0, 0, 0, 278, 0, 278, 0, 278, 278, 278, 278,
+    278, 278, 278, 278, 277, 277, 277, 277, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* OPER_L2 */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 281, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 279, 280, 282, 283, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TERM */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 284, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    284, 284, 284, 284, 284, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 284, 0, 0, 0, 284, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SIMPLE_TERM_TAIL */ {
+    0, 0, 285, 0, 0, 0, 0, 0, 0, 285, 286, 286,
+    286, 286, 0, 0, 0, 0, 0, 286, 0, 0, 285, 0,
+    0, 0, 0, 0, 286, 0, 286, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 286, 0, 0, 0, 286, 0, 0, 0,
+    0, 0, 0, 0, 0, 286, 286, 286, 0, 286, 286, 0,
+    0, 0, 0, 0, 286, 0, 286, 0, 286, 286, 286, 286,
+    286, 286, 286, 286, 286, 286, 286, 286, 285, 285, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* OPER_L3 */ {
+    0, 0, 291, 0, 0, 0, 0, 0, 0, 289, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 290, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 287, 288, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SIMPLE_TERM */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 292, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    293, 293, 293, 293, 293, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 293, 0, 0, 0, 293, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FACTOR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    294, 294, 294, 294, 294, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 294, 0, 0, 0, 294, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TYPE_CONVERSION */ {
+    0, 0, 296, 0, 0, 0, 0, 0, 0, 296, 296, 296,
+    296, 296, 0, 0, 0, 0, 0, 296, 0, 0, 296, 0,
+    0, 0, 0, 0, 296, 0, 296, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 296, 0, 0, 0, 296, 0, 0, 0,
+    0, 0, 0, 0, 0, 296, 296, 296, 0, 296, 296, 0,
+    0, 0, 0, 0, 296, 0, 296, 0, 296, 296, 296, 296,
+    296, 296, 296, 296, 296, 296, 296, 296, 296, 296, 295, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SIMPLE_FACTOR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    302, 297, 298, 299, 300, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 303, 0, 0, 0, 301, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SOURCE_DESIGNATOR */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    304, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* SOURCE_TAIL */ {
+    0, 0, 308, 0, 0, 0, 0, 0, 0, 308, 308, 308,
+    308, 308, 0, 0, 0, 0, 0, 308, 0, 0, 308, 0,
+    0, 0, 0, 0, 308, 0, 308, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 308, 0, 0, 0, 308, 0, 0, 0,
+    0, 0, 0, 0, 0, 308, 308, 308, 0, 308, 308, 0,
+    0, 0, 0, 305, 308, 307, 308, 0, 308, 308, 308, 308,
+    308, 308, 308, 308, 308, 308, 308, 308, 308, 308, 308, 0,
+    306, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* FUNCTION_CALL_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 309, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ARGUMENTS */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 310, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    310, 310, 310, 310, 310, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 310, 311, 0, 0, 310, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 310, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_SOURCE_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    312, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* DEREF_SOURCE_REST */ {
+    0, 0, 316, 0, 0, 0, 0, 0, 0, 316, 316, 316,
+    316, 316, 0, 0, 0, 0, 0, 316, 0, 0, 316, 0,
+    0, 0, 0, 0, 316, 0, 316, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 316, 0, 0, 0, 316, 0, 0, 0,
+    0, 0, 0, 0, 0, 316, 316, 316, 0, 316, 316, 0,
+    0, 0, 0, 314, 316, 315, 316, 0, 316, 316, 316, 316,
+    316, 316, 316, 316, 316, 316, 316, 316, 316, 316, 316, 313,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BRACKET_SOURCE_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 317, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BRACKET_SOURCE_REST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 319, 0,
+    0, 0, 0, 0, 0, 0, 318, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* BRACKET_SOURCE_AFTER */ {
+    0, 0, 323, 0, 0, 0, 0, 0, 0, 323, 323, 323,
+    323, 323, 0, 0, 0, 0, 0, 323, 0, 0, 323, 0,
+    0, 0, 0, 0, 323, 0, 323, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 323, 0, 0, 0, 323, 0, 0, 0,
+    0, 0, 0, 0, 0, 323, 323, 323, 0, 323, 323, 0,
+    0, 0, 0, 321, 323, 0, 323, 0, 323, 323, 323, 323,
+    323, 323, 323, 323, 323, 323, 323, 323, 323, 323, 323, 320,
+    322, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* STRUCTURED_VALUE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 324, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* STRUCTURED_VALUE_BODY */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 325, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    325, 325, 325, 325, 325, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 325, 0, 0, 0, 325, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 325, 0, 0, 326, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* VALUE_COMPONENT_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 327, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 328, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* VALUE_COMPONENT */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 329, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    329, 329, 329, 329, 329, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 329, 0, 0, 0, 329, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 329, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TO_DO_LIST */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 330, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TO_DO_BODY */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 332,
+    332, 332, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 332, 0, 0, 0,
+    0, 0, 0, 0, 331, 0, 0, 332, 0, 332, 0, 0,
+    0, 0, 0, 331, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TRACKING_REF */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 334, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 333, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TRACKING_DETAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 335, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 336, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TASK_TO_DO */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 337, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* ESTIMATE */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 339, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 338, 0, 339, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  },
+  /* TASK_TO_DO_TAIL */ {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 341, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 340, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  }
+};
+
+static const m2c_tokenset_s ll1_first_set[LL1_NONTERMINAL_COUNT] = {
+  /* COMPILATION_UNIT */
+  { { 0x00920000, 0x00000000, 0x00000000 }, 3 },
+  /* INTERFACE_MODULE */
+  { { 0x00100000, 0x00000000, 0x00000000 }, 1 },
+  /* IMPORT_LIST */
+  { { 0x00040000, 0x00000000, 0x00000000 }, 1 },
+  /* IMPORT */
+  { { 0x00040000, 0x00000000, 0x00000000 }, 1 },
+  /* IMPORT_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* RE_EXPORT */
+  { { 0x00000000, 0x00000000, 0x00001000 }, 1 },
+  /* DECLARATION_LIST */
+  { { 0x00000080, 0x00002601, 0x00000000 }, 5 },
+  /* DECLARATION */
+  { { 0x00000080, 0x00002601, 0x00000000 }, 5 },
+  /* CONST_DEFINITION_TAIL */
+  { { 0x00000000, 0x00010000, 0x00000002 }, 2 },
+  /* CONST_DEFINITION */
+  { { 0x00000000, 0x00010000, 0x00000002 }, 2 },
+  /* CONST_BINDING */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* CONST_TYPE */
+  { { 0x00000000, 0x00400000, 0x00000000 }, 1 },
+  /* QUALIDENT */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* QUALIDENT_TAIL */
+  { { 0x00000000, 0x00000000, 0x00080000 }, 1 },
+  /* TYPE_DEFINITION_TAIL */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* TYPE_DEFINITION */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* PUBLIC_TYPE */
+  { { 0xA0000012, 0x80010085, 0x00000002 }, 10 },
+  /* ALIAS_TYPE */
+  { { 0x00000002, 0x00000000, 0x00000000 }, 1 },
+  /* SUBRANGE_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* VALUE_RANGE */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* ENUM_TYPE */
+  { { 0x00000000, 0x80000000, 0x00000000 }, 1 },
+  /* ENUM_BASE */
+  { { 0x00000000, 0x00000000, 0x00001000 }, 1 },
+  /* IDENT_LIST */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* IDENT_LIST_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* SET_TYPE */
+  { { 0x00000000, 0x00000080, 0x00000000 }, 1 },
+  /* ARRAY_TYPE */
+  { { 0x00000010, 0x00000000, 0x00000000 }, 1 },
+  /* RECORD_TYPE */
+  { { 0x00000000, 0x00000004, 0x00000000 }, 1 },
+  /* RECORD_BASE */
+  { { 0x00000000, 0x80000000, 0x00000000 }, 1 },
+  /* FIELD_LIST_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* POINTER_TYPE */
+  { { 0x80000000, 0x00000000, 0x00000000 }, 1 },
+  /* OPAQUE_TYPE */
+  { { 0x20000000, 0x00000000, 0x00000000 }, 1 },
+  /* ALLOC_SIZE */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* PROCEDURE_TYPE */
+  { { 0x00000000, 0x00000001, 0x00000000 }, 1 },
+  /* FORMAL_TYPE_LIST */
+  { { 0x00000000, 0x80000000, 0x00000000 }, 1 },
+  /* FORMAL_TYPE_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* RETURN_TYPE */
+  { { 0x00000000, 0x00400000, 0x00000000 }, 1 },
+  /* FORMAL_TYPE */
+  { { 0x00000098, 0x00012000, 0x00000000 }, 5 },
+  /* ATTRIBUTE */
+  { { 0x00000080, 0x00002000, 0x00000000 }, 2 },
+  /* NON_ATTR_FORMAL_TYPE */
+  { { 0x00000018, 0x00010000, 0x00000000 }, 3 },
+  /* SIMPLE_FORMAL_TYPE */
+  { { 0x00000010, 0x00010000, 0x00000000 }, 2 },
+  /* CAST_TARGET */
+  { { 0x08000000, 0x00010000, 0x00000000 }, 2 },
+  /* VAR_DEFINITION_TAIL */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* VAR_DEFINITION */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* VAR_TYPE */
+  { { 0x00000010, 0x00010001, 0x00000002 }, 4 },
+  /* PROCEDURE_HEADER */
+  { { 0x00000000, 0x00000001, 0x00000000 }, 1 },
+  /* PROC_BINDING */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* BINDING_SPECIFIER */
+  { { 0x01000000, 0x0001802A, 0x00000000 }, 6 },
+  /* NEW_BINDING */
+  { { 0x00000008, 0x00010000, 0x00000000 }, 2 },
+  /* READ_BINDING */
+  { { 0x01000000, 0x00000000, 0x00000000 }, 1 },
+  /* WRITE_BINDING */
+  { { 0x00000000, 0x00000000, 0x00000040 }, 1 },
+  /* FORMAL_PARAM_LIST */
+  { { 0x00000000, 0x80000000, 0x00000000 }, 1 },
+  /* FORMAL_PARAMS_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* FORMAL_PARAMS */
+  { { 0x00000080, 0x00012000, 0x00000000 }, 3 },
+  /* PROGRAM_MODULE */
+  { { 0x00800000, 0x00000000, 0x00000000 }, 1 },
+  /* PRIVATE_IMPORT_LIST */
+  { { 0x00040000, 0x00000000, 0x00000000 }, 1 },
+  /* PRIVATE_IMPORT */
+  { { 0x00040000, 0x00000000, 0x00000000 }, 1 },
+  /* BLOCK */
+  { { 0x000000A0, 0x00002E01, 0x00000000 }, 7 },
+  /* DEFINITION_LIST */
+  { { 0x00000080, 0x00002E01, 0x00000000 }, 6 },
+  /* DEFINITION */
+  { { 0x00000080, 0x00002E01, 0x00000000 }, 6 },
+  /* PGM_TYPE_DEFINITION_TAIL */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* PGM_TYPE_DEFINITION */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* PROGRAM_TYPE */
+  { { 0x80000012, 0x80010085, 0x00000002 }, 9 },
+  /* PROCEDURE_DEFINITION */
+  { { 0x00000000, 0x00000001, 0x00000000 }, 1 },
+  /* IMPLEMENTATION_MODULE */
+  { { 0x00020000, 0x00000000, 0x00000000 }, 1 },
+  /* PRIVATE_BLOCK */
+  { { 0x000020A0, 0x00002E01, 0x00000000 }, 8 },
+  /* MODULE_BODY */
+  { { 0x00000020, 0x00000000, 0x00000000 }, 1 },
+  /* PRIVATE_DEFINITION_LIST */
+  { { 0x00000080, 0x00002E01, 0x00000000 }, 6 },
+  /* PRIVATE_DEFINITION */
+  { { 0x00000080, 0x00002E01, 0x00000000 }, 6 },
+  /* IMP_TYPE_DEFINITION_TAIL */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* IMP_TYPE_DEFINITION */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* IMPLEMENTATION_TYPE */
+  { { 0x80000012, 0x80010085, 0x00000002 }, 9 },
+  /* PRIVATE_POINTER_TYPE */
+  { { 0x80000000, 0x00000000, 0x00000000 }, 1 },
+  /* POINTER_TARGET */
+  { { 0x00000000, 0x00010004, 0x00000000 }, 2 },
+  /* INDETERMINATE_FIELDS */
+  { { 0x00000000, 0x00010000, 0x00001000 }, 2 },
+  /* ALIAS_DEFINITION */
+  { { 0x00000000, 0x00000800, 0x00000000 }, 1 },
+  /* NAME_SELECTOR_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* NAME_SELECTOR */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* WILDCARD */
+  { { 0x00000000, 0x40000000, 0x00000000 }, 1 },
+  /* STATEMENT_SEQUENCE */
+  { { 0x0321C140, 0x0001C27A, 0x00000000 }, 17 },
+  /* STATEMENT_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* STATEMENT */
+  { { 0x0321C140, 0x0001C27A, 0x00000000 }, 17 },
+  /* NEW_TAIL */
+  { { 0x00000000, 0x08010000, 0x00000000 }, 2 },
+  /* UPDATE_OR_CALL_TAIL */
+  { { 0x00000000, 0xB8000000, 0x00000000 }, 4 },
+  /* RETURN_VALUE */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* CHANNEL */
+  { { 0x00000000, 0x01000000, 0x00000000 }, 1 },
+  /* INPUT_ARG */
+  { { 0x01000000, 0x00010000, 0x00000000 }, 2 },
+  /* INPUT_ARG_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* OUTPUT_ARGS */
+  { { 0x04000000, 0x801F0000, 0x00002048 }, 10 },
+  /* OUTPUT_ARGS_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* IF_STATEMENT */
+  { { 0x00010000, 0x00000000, 0x00000000 }, 1 },
+  /* ELSIF_LIST */
+  { { 0x00001000, 0x00000000, 0x00000000 }, 1 },
+  /* ELSE_BRANCH */
+  { { 0x00000800, 0x00000000, 0x00000000 }, 1 },
+  /* CASE_STATEMENT */
+  { { 0x00000040, 0x00000000, 0x00000000 }, 1 },
+  /* CASE_LIST_TAIL */
+  { { 0x00000000, 0x02000000, 0x00000000 }, 1 },
+  /* CASE */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* CASE_LABELS_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* CASE_LABELS */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* RANGE_TAIL */
+  { { 0x00000000, 0x04000000, 0x00000000 }, 1 },
+  /* FOR_STATEMENT */
+  { { 0x00008000, 0x00000000, 0x00000000 }, 1 },
+  /* DESCENDER */
+  { { 0x00000000, 0x20000000, 0x00000000 }, 1 },
+  /* FOR_VALUE */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* ITERABLE_EXPR */
+  { { 0x00000000, 0x00010000, 0x00000002 }, 2 },
+  /* ITERABLE_RANGE */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* DESIGNATOR */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* DESIGNATOR_TAIL */
+  { { 0x00000000, 0x00000000, 0x00100002 }, 2 },
+  /* DEREF_TAIL */
+  { { 0x00000000, 0x00000000, 0x00100000 }, 1 },
+  /* DEREF_TAIL_REST */
+  { { 0x00000000, 0x00000000, 0x00080002 }, 2 },
+  /* SUBSCRIPT_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* SUBSCRIPT_TAIL_REST */
+  { { 0x00000000, 0x00000000, 0x00180000 }, 2 },
+  /* DEREF */
+  { { 0x00000000, 0x00000000, 0x00100000 }, 1 },
+  /* DEREF_TAIL_MORE */
+  { { 0x00000000, 0x00000000, 0x00100000 }, 1 },
+  /* TARGET_DESIGNATOR */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* TARGET_TAIL */
+  { { 0x00000000, 0x00000000, 0x00100002 }, 2 },
+  /* DEREF_TARGET_TAIL */
+  { { 0x00000000, 0x00000000, 0x00100000 }, 1 },
+  /* DEREF_TARGET_REST */
+  { { 0x00000000, 0x00000000, 0x00080002 }, 2 },
+  /* BRACKET_TARGET_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* BRACKET_TARGET_REST */
+  { { 0x00000000, 0x04000000, 0x00000004 }, 2 },
+  /* BRACKET_TARGET_AFTER */
+  { { 0x00000000, 0x00000000, 0x00180000 }, 2 },
+  /* EXPRESSION_LIST */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* EXPRESSION_LIST_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* EXPRESSION */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* RELATION */
+  { { 0x00080000, 0x00000000, 0x00000FE0 }, 8 },
+  /* OPER_L1 */
+  { { 0x00080000, 0x00000000, 0x00000FE0 }, 8 },
+  /* SIMPLE_EXPRESSION */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* TERM_TAIL */
+  { { 0x40000000, 0x00000000, 0x0000F000 }, 5 },
+  /* OPER_L2 */
+  { { 0x40000000, 0x00000000, 0x0000F000 }, 5 },
+  /* TERM */
+  { { 0x04000000, 0x801F0000, 0x00000008 }, 8 },
+  /* SIMPLE_TERM_TAIL */
+  { { 0x00400204, 0x00000000, 0x00030000 }, 5 },
+  /* OPER_L3 */
+  { { 0x00400204, 0x00000000, 0x00030000 }, 5 },
+  /* SIMPLE_TERM */
+  { { 0x04000000, 0x801F0000, 0x00000008 }, 8 },
+  /* FACTOR */
+  { { 0x00000000, 0x801F0000, 0x00000008 }, 7 },
+  /* TYPE_CONVERSION */
+  { { 0x00000000, 0x00000000, 0x00040000 }, 1 },
+  /* SIMPLE_FACTOR */
+  { { 0x00000000, 0x801F0000, 0x00000008 }, 7 },
+  /* SOURCE_DESIGNATOR */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* SOURCE_TAIL */
+  { { 0x00000000, 0x80000000, 0x00100002 }, 3 },
+  /* FUNCTION_CALL_TAIL */
+  { { 0x00000000, 0x80000000, 0x00000000 }, 1 },
+  /* ARGUMENTS */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* DEREF_SOURCE_TAIL */
+  { { 0x00000000, 0x00000000, 0x00100000 }, 1 },
+  /* DEREF_SOURCE_REST */
+  { { 0x00000000, 0x80000000, 0x00080002 }, 3 },
+  /* BRACKET_SOURCE_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000002 }, 1 },
+  /* BRACKET_SOURCE_REST */
+  { { 0x00000000, 0x04000000, 0x00000004 }, 2 },
+  /* BRACKET_SOURCE_AFTER */
+  { { 0x00000000, 0x80000000, 0x00180000 }, 3 },
+  /* STRUCTURED_VALUE */
+  { { 0x00000000, 0x00000000, 0x00000008 }, 1 },
+  /* STRUCTURED_VALUE_BODY */
+  { { 0x04000000, 0x801F0000, 0x00012008 }, 10 },
+  /* VALUE_COMPONENT_TAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* VALUE_COMPONENT */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* TO_DO_LIST */
+  { { 0x00000000, 0x00000200, 0x00000000 }, 1 },
+  /* TO_DO_BODY */
+  { { 0x00000000, 0x80100000, 0x00000000 }, 2 },
+  /* TRACKING_REF */
+  { { 0x00000000, 0x80000000, 0x00000000 }, 1 },
+  /* TRACKING_DETAIL */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* TASK_TO_DO */
+  { { 0x00000000, 0x00100000, 0x00000000 }, 1 },
+  /* ESTIMATE */
+  { { 0x00000000, 0x00200000, 0x00000000 }, 1 },
+  /* TASK_TO_DO_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 }
+};
+
+static const m2c_tokenset_s ll1_follow_set[LL1_NONTERMINAL_COUNT] = {
+  /* COMPILATION_UNIT */
+  { { 0x00000000, 0x00000000, 0x00200000 }, 1 },
+  /* INTERFACE_MODULE */
+  { { 0x00000000, 0x00000000, 0x00200000 }, 1 },
+  /* IMPORT_LIST */
+  { { 0x00002080, 0x00002601, 0x00000000 }, 6 },
+  /* IMPORT */
+  { { 0x00042080, 0x00002601, 0x00000000 }, 7 },
+  /* IMPORT_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* RE_EXPORT */
+  { { 0x00000000, 0x00A00000, 0x00000000 }, 2 },
+  /* DECLARATION_LIST */
+  { { 0x00002000, 0x00000000, 0x00000000 }, 1 },
+  /* DECLARATION */
+  { { 0x00002080, 0x00002601, 0x00000000 }, 6 },
+  /* CONST_DEFINITION_TAIL */
+  { { 0x000020A0, 0x00002E01, 0x00000000 }, 8 },
+  /* CONST_DEFINITION */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* CONST_BINDING */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* CONST_TYPE */
+  { { 0x00000000, 0x00000000, 0x00000020 }, 1 },
+  /* QUALIDENT */
+  { { 0x58483E04, 0xFEE11100, 0x0017FFF7 }, 43 },
+  /* QUALIDENT_TAIL */
+  { { 0x58483E04, 0xFEE11100, 0x0017FFF7 }, 43 },
+  /* TYPE_DEFINITION_TAIL */
+  { { 0x00002080, 0x00002601, 0x00000000 }, 6 },
+  /* TYPE_DEFINITION */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* PUBLIC_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* ALIAS_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* SUBRANGE_TYPE */
+  { { 0x00002400, 0x00800000, 0x00000000 }, 3 },
+  /* VALUE_RANGE */
+  { { 0x10000400, 0x00000000, 0x00000000 }, 2 },
+  /* ENUM_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* ENUM_BASE */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* IDENT_LIST */
+  { { 0x00000000, 0x00400000, 0x00000001 }, 2 },
+  /* IDENT_LIST_TAIL */
+  { { 0x00000000, 0x00C00000, 0x00000001 }, 3 },
+  /* SET_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* ARRAY_TYPE */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* RECORD_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* RECORD_BASE */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* FIELD_LIST_TAIL */
+  { { 0x00002000, 0x00000000, 0x00000000 }, 1 },
+  /* POINTER_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* OPAQUE_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* ALLOC_SIZE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* PROCEDURE_TYPE */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* FORMAL_TYPE_LIST */
+  { { 0x00002000, 0x00C00000, 0x00000000 }, 3 },
+  /* FORMAL_TYPE_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000001 }, 1 },
+  /* RETURN_TYPE */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* FORMAL_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000001 }, 2 },
+  /* ATTRIBUTE */
+  { { 0x00000018, 0x00010000, 0x00000000 }, 3 },
+  /* NON_ATTR_FORMAL_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000001 }, 2 },
+  /* SIMPLE_FORMAL_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000001 }, 2 },
+  /* CAST_TARGET */
+  { { 0x00000000, 0x00800000, 0x00000001 }, 2 },
+  /* VAR_DEFINITION_TAIL */
+  { { 0x000020A0, 0x00002E01, 0x00000000 }, 8 },
+  /* VAR_DEFINITION */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* VAR_TYPE */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* PROCEDURE_HEADER */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* PROC_BINDING */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* BINDING_SPECIFIER */
+  { { 0x00000000, 0x00000000, 0x00000004 }, 1 },
+  /* NEW_BINDING */
+  { { 0x00000000, 0x00000000, 0x00000004 }, 1 },
+  /* READ_BINDING */
+  { { 0x00000000, 0x00000000, 0x00000004 }, 1 },
+  /* WRITE_BINDING */
+  { { 0x00000000, 0x00000000, 0x00000004 }, 1 },
+  /* FORMAL_PARAM_LIST */
+  { { 0x00000000, 0x00C00000, 0x00000000 }, 2 },
+  /* FORMAL_PARAMS_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000001 }, 1 },
+  /* FORMAL_PARAMS */
+  { { 0x00000000, 0x00800000, 0x00000001 }, 2 },
+  /* PROGRAM_MODULE */
+  { { 0x00000000, 0x00000000, 0x00200000 }, 1 },
+  /* PRIVATE_IMPORT_LIST */
+  { { 0x000020A0, 0x00002E01, 0x00000000 }, 8 },
+  /* PRIVATE_IMPORT */
+  { { 0x000420A0, 0x00002E01, 0x00000000 }, 9 },
+  /* BLOCK */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* DEFINITION_LIST */
+  { { 0x00000020, 0x00000000, 0x00000000 }, 1 },
+  /* DEFINITION */
+  { { 0x000000A0, 0x00002E01, 0x00000000 }, 7 },
+  /* PGM_TYPE_DEFINITION_TAIL */
+  { { 0x000000A0, 0x00002E01, 0x00000000 }, 7 },
+  /* PGM_TYPE_DEFINITION */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* PROGRAM_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* PROCEDURE_DEFINITION */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* IMPLEMENTATION_MODULE */
+  { { 0x00000000, 0x00000000, 0x00200000 }, 1 },
+  /* PRIVATE_BLOCK */
+  { { 0x00000000, 0x00010000, 0x00000000 }, 1 },
+  /* MODULE_BODY */
+  { { 0x00002000, 0x00000000, 0x00000000 }, 1 },
+  /* PRIVATE_DEFINITION_LIST */
+  { { 0x00002020, 0x00000000, 0x00000000 }, 2 },
+  /* PRIVATE_DEFINITION */
+  { { 0x000020A0, 0x00002E01, 0x00000000 }, 8 },
+  /* IMP_TYPE_DEFINITION_TAIL */
+  { { 0x000020A0, 0x00002E01, 0x00000000 }, 8 },
+  /* IMP_TYPE_DEFINITION */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* IMPLEMENTATION_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* PRIVATE_POINTER_TYPE */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* POINTER_TARGET */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* INDETERMINATE_FIELDS */
+  { { 0x00002000, 0x00000000, 0x00000000 }, 1 },
+  /* ALIAS_DEFINITION */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* NAME_SELECTOR_TAIL */
+  { { 0x00000000, 0x00800000, 0x00000000 }, 1 },
+  /* NAME_SELECTOR */
+  { { 0x00000000, 0x00A00000, 0x00000000 }, 2 },
+  /* WILDCARD */
+  { { 0x00000000, 0x00A00000, 0x00000000 }, 2 },
+  /* STATEMENT_SEQUENCE */
+  { { 0x00003800, 0x02001000, 0x00000000 }, 5 },
+  /* STATEMENT_TAIL */
+  { { 0x00003800, 0x02001000, 0x00000000 }, 5 },
+  /* STATEMENT */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* NEW_TAIL */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* UPDATE_OR_CALL_TAIL */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* RETURN_VALUE */
+  { { 0x00003800, 0x02801000, 0x00000004 }, 7 },
+  /* CHANNEL */
+  { { 0x05000000, 0x801F0000, 0x00002048 }, 11 },
+  /* INPUT_ARG */
+  { { 0x00003800, 0x02A01000, 0x00000000 }, 7 },
+  /* INPUT_ARG_TAIL */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* OUTPUT_ARGS */
+  { { 0x00003800, 0x02A01000, 0x00000000 }, 7 },
+  /* OUTPUT_ARGS_TAIL */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* IF_STATEMENT */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* ELSIF_LIST */
+  { { 0x00002800, 0x00000000, 0x00000000 }, 2 },
+  /* ELSE_BRANCH */
+  { { 0x00002000, 0x00000000, 0x00000000 }, 1 },
+  /* CASE_STATEMENT */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* CASE_LIST_TAIL */
+  { { 0x00002800, 0x00000000, 0x00000000 }, 2 },
+  /* CASE */
+  { { 0x00002800, 0x02000000, 0x00000000 }, 3 },
+  /* CASE_LABELS_TAIL */
+  { { 0x00000000, 0x00400000, 0x00000000 }, 1 },
+  /* CASE_LABELS */
+  { { 0x00000000, 0x00600000, 0x00000000 }, 2 },
+  /* RANGE_TAIL */
+  { { 0x00000000, 0x00600000, 0x00000010 }, 3 },
+  /* FOR_STATEMENT */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* DESCENDER */
+  { { 0x00080000, 0x00200000, 0x00000000 }, 2 },
+  /* FOR_VALUE */
+  { { 0x00080000, 0x00000000, 0x00000000 }, 1 },
+  /* ITERABLE_EXPR */
+  { { 0x00000400, 0x00000000, 0x00000000 }, 1 },
+  /* ITERABLE_RANGE */
+  { { 0x00000400, 0x00000000, 0x00000000 }, 1 },
+  /* DESIGNATOR */
+  { { 0x00003800, 0x0AE11000, 0x00000000 }, 10 },
+  /* DESIGNATOR_TAIL */
+  { { 0x00003800, 0x0AE11000, 0x00000000 }, 10 },
+  /* DEREF_TAIL */
+  { { 0x00003800, 0x0AE11000, 0x00000000 }, 10 },
+  /* DEREF_TAIL_REST */
+  { { 0x00003800, 0x0AE11000, 0x00000000 }, 10 },
+  /* SUBSCRIPT_TAIL */
+  { { 0x00003800, 0x0AE11000, 0x00000000 }, 10 },
+  /* SUBSCRIPT_TAIL_REST */
+  { { 0x00003800, 0x0AE11000, 0x00000000 }, 10 },
+  /* DEREF */
+  { { 0x50483E04, 0xBEE11100, 0x000FFFF7 }, 41 },
+  /* DEREF_TAIL_MORE */
+  { { 0x50483E04, 0xBEE11100, 0x000FFFF7 }, 41 },
+  /* TARGET_DESIGNATOR */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* TARGET_TAIL */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* DEREF_TARGET_TAIL */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* DEREF_TARGET_REST */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* BRACKET_TARGET_TAIL */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* BRACKET_TARGET_REST */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* BRACKET_TARGET_AFTER */
+  { { 0x00003800, 0xBA801000, 0x00000000 }, 10 },
+  /* EXPRESSION_LIST */
+  { { 0x00000000, 0x00000000, 0x00000001 }, 1 },
+  /* EXPRESSION_LIST_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000001 }, 1 },
+  /* EXPRESSION */
+  { { 0x10003C00, 0x06E01100, 0x00000015 }, 15 },
+  /* RELATION */
+  { { 0x10003C00, 0x06E01100, 0x00000015 }, 15 },
+  /* OPER_L1 */
+  { { 0x04000000, 0x801F0000, 0x00002008 }, 9 },
+  /* SIMPLE_EXPRESSION */
+  { { 0x10083C00, 0x06E01100, 0x00000FF5 }, 23 },
+  /* TERM_TAIL */
+  { { 0x10083C00, 0x06E01100, 0x00000FF5 }, 23 },
+  /* OPER_L2 */
+  { { 0x04000000, 0x801F0000, 0x00000008 }, 8 },
+  /* TERM */
+  { { 0x50083C00, 0x06E01100, 0x0000FFF5 }, 28 },
+  /* SIMPLE_TERM_TAIL */
+  { { 0x50083C00, 0x06E01100, 0x0000FFF5 }, 28 },
+  /* OPER_L3 */
+  { { 0x04000000, 0x801F0000, 0x00000008 }, 8 },
+  /* SIMPLE_TERM */
+  { { 0x50483E04, 0x06E01100, 0x0003FFF5 }, 33 },
+  /* FACTOR */
+  { { 0x50483E04, 0x06E01100, 0x0003FFF5 }, 33 },
+  /* TYPE_CONVERSION */
+  { { 0x50483E04, 0x06E01100, 0x0003FFF5 }, 33 },
+  /* SIMPLE_FACTOR */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* SOURCE_DESIGNATOR */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* SOURCE_TAIL */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* FUNCTION_CALL_TAIL */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* ARGUMENTS */
+  { { 0x00000000, 0x00000000, 0x00000001 }, 1 },
+  /* DEREF_SOURCE_TAIL */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* DEREF_SOURCE_REST */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* BRACKET_SOURCE_TAIL */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* BRACKET_SOURCE_REST */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* BRACKET_SOURCE_AFTER */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* STRUCTURED_VALUE */
+  { { 0x50483E04, 0x06E01100, 0x0007FFF5 }, 34 },
+  /* STRUCTURED_VALUE_BODY */
+  { { 0x00000000, 0x00000000, 0x00000010 }, 1 },
+  /* VALUE_COMPONENT_TAIL */
+  { { 0x00000000, 0x00000000, 0x00000010 }, 1 },
+  /* VALUE_COMPONENT */
+  { { 0x00000000, 0x00200000, 0x00000010 }, 2 },
+  /* TO_DO_LIST */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* TO_DO_BODY */
+  { { 0x00003800, 0x02801000, 0x00000000 }, 6 },
+  /* TRACKING_REF */
+  { { 0x00000000, 0x00100000, 0x00000000 }, 1 },
+  /* TRACKING_DETAIL */
+  { { 0x00000000, 0x00000000, 0x00000001 }, 1 },
+  /* TASK_TO_DO */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* ESTIMATE */
+  { { 0x00002000, 0x00800000, 0x00000000 }, 2 },
+  /* TASK_TO_DO_TAIL */
+  { { 0x00002000, 0x00000000, 0x00000000 }, 1 }
+};
+
+/* END OF FILE */
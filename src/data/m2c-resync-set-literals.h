@@ -0,0 +1,148 @@
+/* AUTO-GENERATED by utility gen-resync-sets * DO NOT EDIT! */
+
+DATA(COLON_OR_FIRST_NON_ATTR_FORMAL_TYPE /* data-index: 0 */, (
+    { /* bits: */ 0x00000018, 0x00410000, 0x00000000, /* counter: */ 4 }
+  )
+)
+DATA(COMMA_OR_FIRST_EXPRESSION /* data-index: 1 */, (
+    { /* bits: */ 0x04000000, 0x803F0000, 0x00002008, /* counter: */ 10 }
+  )
+)
+DATA(COMMA_OR_FOLLOW_IDENT_LIST /* data-index: 2 */, (
+    { /* bits: */ 0x00000000, 0x00600000, 0x00000001, /* counter: */ 3 }
+  )
+)
+DATA(DOT_DOT_OR_FIRST_EXPRESSION /* data-index: 3 */, (
+    { /* bits: */ 0x04000000, 0x841F0000, 0x00002008, /* counter: */ 10 }
+  )
+)
+DATA(DO_OR_FIRST_ITERABLE_EXPR /* data-index: 4 */, (
+    { /* bits: */ 0x00000400, 0x00010000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(DO_OR_FIRST_STATEMENT_SEQUENCE /* data-index: 5 */, (
+    { /* bits: */ 0x0321C540, 0x0001C27A, 0x00000000, /* counter: */ 18 }
+  )
+)
+DATA(END_OR_FIRST_STATEMENT_SEQUENCE /* data-index: 6 */, (
+    { /* bits: */ 0x0321E140, 0x0001C27A, 0x00000000, /* counter: */ 18 }
+  )
+)
+DATA(END_OR_FOLLOW_FOR_STATEMENT /* data-index: 7 */, (
+    { /* bits: */ 0x00003800, 0x02801000, 0x00000000, /* counter: */ 6 }
+  )
+)
+DATA(END_OR_FOLLOW_LOOP_STATEMENT /* data-index: 8 */, (
+    { /* bits: */ 0x00003800, 0x02801000, 0x00000000, /* counter: */ 6 }
+  )
+)
+DATA(END_OR_FOLLOW_STATEMENT /* data-index: 9 */, (
+    { /* bits: */ 0x00003800, 0x02801000, 0x00000000, /* counter: */ 6 }
+  )
+)
+DATA(END_OR_FOLLOW_WHILE_STATEMENT /* data-index: 10 */, (
+    { /* bits: */ 0x00003800, 0x02801000, 0x00000000, /* counter: */ 6 }
+  )
+)
+DATA(EQUAL_OR_FIRST_EXPRESSION /* data-index: 11 */, (
+    { /* bits: */ 0x04000000, 0x801F0000, 0x00002028, /* counter: */ 10 }
+  )
+)
+DATA(FIRST_EXPRESSION_OR_FOLLOW_CONST_DEFINITION /* data-index: 12 */, (
+    { /* bits: */ 0x04000000, 0x809F0000, 0x00002008, /* counter: */ 10 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_ARRAY_TYPE /* data-index: 13 */, (
+    { /* bits: */ 0x00000000, 0x00810000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_CONST_DEFINITION /* data-index: 14 */, (
+    { /* bits: */ 0x00000000, 0x00810000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_DEFINITION /* data-index: 15 */, (
+    { /* bits: */ 0x00000080, 0x00012601, 0x00000000, /* counter: */ 6 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_POINTER_TYPE /* data-index: 16 */, (
+    { /* bits: */ 0x00000000, 0x00810000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_PROCEDURE_SIGNATURE /* data-index: 17 */, (
+    { /* bits: */ 0x00000000, 0x00810000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_SET_TYPE /* data-index: 18 */, (
+    { /* bits: */ 0x00000000, 0x00810000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_SIMPLE_FORMAL_TYPE /* data-index: 19 */, (
+    { /* bits: */ 0x00000000, 0x00810000, 0x00000001, /* counter: */ 3 }
+  )
+)
+DATA(IDENT_OR_FOLLOW_SUBRANGE_TYPE /* data-index: 20 */, (
+    { /* bits: */ 0x00002000, 0x00810000, 0x00000000, /* counter: */ 3 }
+  )
+)
+DATA(IMPORT_OR_FOLLOW_IMPORT /* data-index: 21 */, (
+    { /* bits: */ 0x00042080, 0x00002601, 0x00000000, /* counter: */ 7 }
+  )
+)
+DATA(LBRACKET_OR_FOLLOW_ITERABLE_EXPR /* data-index: 22 */, (
+    { /* bits: */ 0x00000400, 0x00000000, 0x00000002, /* counter: */ 2 }
+  )
+)
+DATA(RBRACKET_OR_FIRST_PROCEDURE_SIGNATURE /* data-index: 23 */, (
+    { /* bits: */ 0x00000000, 0x00010000, 0x00000004, /* counter: */ 2 }
+  )
+)
+DATA(RBRACKET_OR_FOLLOW_TYPE_DEFINITION /* data-index: 24 */, (
+    { /* bits: */ 0x00000000, 0x00800000, 0x00000004, /* counter: */ 2 }
+  )
+)
+DATA(RBRACKET_OR_FOLLOW_VALUE_RANGE /* data-index: 25 */, (
+    { /* bits: */ 0x00000400, 0x00000000, 0x00000004, /* counter: */ 2 }
+  )
+)
+DATA(RPAREN_OR_FIRST_FIELD_LIST /* data-index: 26 */, (
+    { /* bits: */ 0x00000000, 0x00010000, 0x00000001, /* counter: */ 2 }
+  )
+)
+DATA(RPAREN_OR_FOLLOW_ENUM_TYPE /* data-index: 27 */, (
+    { /* bits: */ 0x00000000, 0x00800000, 0x00000001, /* counter: */ 2 }
+  )
+)
+DATA(RPAREN_OR_FOLLOW_OUTPUT_ARGS /* data-index: 28 */, (
+    { /* bits: */ 0x00003800, 0x02A01000, 0x00000001, /* counter: */ 8 }
+  )
+)
+DATA(SEMICOLON_OR_FIRST_IMPORT /* data-index: 29 */, (
+    { /* bits: */ 0x00040000, 0x00800000, 0x00000000, /* counter: */ 2 }
+  )
+)
+DATA(SEMICOLON_OR_FOLLOW_FORMAL_PARAMS /* data-index: 30 */, (
+    { /* bits: */ 0x00000000, 0x00800000, 0x00000001, /* counter: */ 2 }
+  )
+)
+DATA(SEMICOLON_OR_FOLLOW_IMPORT /* data-index: 31 */, (
+    { /* bits: */ 0x00042080, 0x00802601, 0x00000000, /* counter: */ 8 }
+  )
+)
+DATA(SEMICOLON_OR_FOLLOW_STATEMENT /* data-index: 32 */, (
+    { /* bits: */ 0x00003800, 0x02801000, 0x00000000, /* counter: */ 6 }
+  )
+)
+DATA(SEMICOLON_OR_FOLLOW_TYPE_DEFINITION /* data-index: 33 */, (
+    { /* bits: */ 0x00000000, 0x00800000, 0x00000000, /* counter: */ 1 }
+  )
+)
+DATA(THEN_OR_FIRST_STATEMENT /* data-index: 34 */, (
+    { /* bits: */ 0x0321C140, 0x0001C37A, 0x00000000, /* counter: */ 18 }
+  )
+)
+DATA(UNTIL_OR_FIRST_EXPRESSION /* data-index: 35 */, (
+    { /* bits: */ 0x04000000, 0x801F1000, 0x00002008, /* counter: */ 10 }
+  )
+)
+
+/* END OF FILE */
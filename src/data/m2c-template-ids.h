@@ -0,0 +1,51 @@
+/* AUTO-GENERATED by utility gen-c-templates * DO NOT EDIT! */
+
+typedef enum {
+  M2C_TEMPLATE_PREAMBLE,
+  M2C_TEMPLATE_EOF,
+  M2C_TEMPLATE_INTERFACE,
+  M2C_TEMPLATE_IMPLEMENTATION,
+  M2C_TEMPLATE_PROGRAM,
+  M2C_TEMPLATE_IMP_LIST,
+  M2C_TEMPLATE_DEF_LIST,
+  M2C_TEMPLATE_CONSTDEF,
+  M2C_TEMPLATE_TYPEDEF,
+  M2C_TEMPLATE_VARDECL,
+  M2C_TEMPLATE_VARDEF,
+  M2C_TEMPLATE_PROCDECL,
+  M2C_TEMPLATE_PROCDEF,
+  M2C_TEMPLATE_HIDDEN_VARDEF,
+  M2C_TEMPLATE_HIDDEN_PROCDECL,
+  M2C_TEMPLATE_HIDDEN_PROCDEF,
+  M2C_TEMPLATE_ALIAS,
+  M2C_TEMPLATE_SUBR,
+  M2C_TEMPLATE_ENUM,
+  M2C_TEMPLATE_SET_WORD,
+  M2C_TEMPLATE_SET_ARRAY,
+  M2C_TEMPLATE_ARRAY,
+  M2C_TEMPLATE_RECORD,
+  M2C_TEMPLATE_OPAQUE,
+  M2C_TEMPLATE_POINTER,
+  M2C_TEMPLATE_PROCTYPE,
+  M2C_TEMPLATE_END_MARK
+} m2c_template_t;
+
+typedef enum {
+  M2C_TEMPLATE_SLOT_TARGET_FILENAME,  /* <%target_filename%> */
+  M2C_TEMPLATE_SLOT_SOURCE_FILENAME,  /* <%source_filename%> */
+  M2C_TEMPLATE_SLOT_MODULE_IDENT,  /* <%module_ident%> */
+  M2C_TEMPLATE_SLOT_MODULE_KEY,  /* <%module_key%> */
+  M2C_TEMPLATE_SLOT_INCL_GUARD_START,  /* <%incl_guard_start%> */
+  M2C_TEMPLATE_SLOT_INCL_GUARD_END,  /* <%incl_guard_end%> */
+  M2C_TEMPLATE_SLOT_BLOCK,  /* <%block%> */
+  M2C_TEMPLATE_SLOT_N,  /* <%n%> */
+  M2C_TEMPLATE_SLOT_0,  /* <%0%> */
+  M2C_TEMPLATE_SLOT_1,  /* <%1%> */
+  M2C_TEMPLATE_SLOT_1_1,  /* <%1.1%> */
+  M2C_TEMPLATE_SLOT_1_0,  /* <%1.0%> */
+  M2C_TEMPLATE_SLOT_0_0,  /* <%0.0%> */
+  M2C_TEMPLATE_SLOT_2,  /* <%2%> */
+  M2C_TEMPLATE_SLOT_END_MARK
+} m2c_template_slot_t;
+
+/* END OF FILE */
@@ -0,0 +1,532 @@
+/* AUTO-GENERATED by utility gen-c-templates * DO NOT EDIT! */
+
+#define M2C_TEMPLATE_ITEM_COUNT 226
+
+static const m2c_template_item_t m2c_template_item[] = {
+  /* preamble */
+  { TEMPLATE_ITEM_SPAN, 82,
+      "// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\n"
+      "// " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_TARGET_FILENAME, NULL },
+  { TEMPLATE_ITEM_SPAN, 128,
+      "\n"
+      "//\n"
+      "// C99 source file, auto-generated by M2C Modula-2 Compiler & Translator\n"
+      "//\n"
+      "// Modula-2 source file details\n"
+      "//   filename : " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_SOURCE_FILENAME, NULL },
+  { TEMPLATE_ITEM_SPAN, 17,
+      "\n"
+      "//   module   : " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_MODULE_IDENT, NULL },
+  { TEMPLATE_ITEM_SPAN, 17,
+      "\n"
+      "//   key      : " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_MODULE_KEY, NULL },
+  { TEMPLATE_ITEM_SPAN, 138,
+      "\n"
+      "//\n"
+      "// For details on M2C, see https://github.com/m2sf/m2c\n"
+      "// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *\n" },
+  /* eof */
+  { TEMPLATE_ITEM_SPAN, 18,
+      "/* END OF FILE */\n" },
+  /* interface */
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_PREAMBLE, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_INCL_GUARD_START, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_IMP_LIST, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_DEF_LIST, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_INCL_GUARD_END, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_EOF, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  /* implementation */
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_PREAMBLE, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_IMP_LIST, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_DEF_LIST, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_BLOCK, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_EOF, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  /* program */
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_PREAMBLE, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_IMP_LIST, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_DEF_LIST, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_BLOCK, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_EOF, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  /* imp-list */
+  { TEMPLATE_ITEM_SPAN, 170,
+      "/* ---------------------------------------------------------------------------\n"
+      " * imports\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n" },
+  { TEMPLATE_ITEM_FOREACH, M2C_TEMPLATE_SLOT_N, NULL },
+  /* def-list */
+  { TEMPLATE_ITEM_FOREACH, M2C_TEMPLATE_SLOT_N, NULL },
+  /* constdef */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * constant " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "#define " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      " (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ")\n" },
+  /* typedef */
+  { TEMPLATE_ITEM_SPAN, 87,
+      "/* ---------------------------------------------------------------------------\n"
+      " * type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* vardecl */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * variable " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 88,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "extern " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* vardef */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * variable " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 81,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* procdecl */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * function " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 81,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* procdef */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * function " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 81,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  /* hidden-vardef */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * variable " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 102,
+      ", not exported\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "static " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* hidden-procdecl */
+  { TEMPLATE_ITEM_SPAN, 7,
+      "static " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* hidden-procdef */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * function " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 102,
+      ", not exported\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "static " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      "\n" },
+  /* alias */
+  { TEMPLATE_ITEM_SPAN, 93,
+      "/* ---------------------------------------------------------------------------\n"
+      " * alias type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* subr */
+  { TEMPLATE_ITEM_SPAN, 96,
+      "/* ---------------------------------------------------------------------------\n"
+      " * subrange type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* enum */
+  { TEMPLATE_ITEM_SPAN, 99,
+      "/* ---------------------------------------------------------------------------\n"
+      " * enumeration type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 96,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef enum {\n" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 3,
+      "\n"
+      "} " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* set-word */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * set type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 98,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef uint64_t " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* set-array */
+  { TEMPLATE_ITEM_SPAN, 91,
+      "/* ---------------------------------------------------------------------------\n"
+      " * set type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 114,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef struct {\n"
+      "  uint64_t word[" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 5,
+      "];\n"
+      "} " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 17,
+      ";\n"
+      "\n"
+      "static inline " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 8,
+      "_union (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 4,
+      " a, " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 38,
+      " b) {\n"
+      "  unsigned i;\n"
+      "  for (i = 0; i < " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 64,
+      "; i++) { a.word[i] |= b.word[i]; }\n"
+      "  return a;\n"
+      "}\n"
+      "\n"
+      "static inline " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 15,
+      "_intersection (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 4,
+      " a, " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 38,
+      " b) {\n"
+      "  unsigned i;\n"
+      "  for (i = 0; i < " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 64,
+      "; i++) { a.word[i] &= b.word[i]; }\n"
+      "  return a;\n"
+      "}\n"
+      "\n"
+      "static inline " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 13,
+      "_difference (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 4,
+      " a, " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 38,
+      " b) {\n"
+      "  unsigned i;\n"
+      "  for (i = 0; i < " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 65,
+      "; i++) { a.word[i] &= ~b.word[i]; }\n"
+      "  return a;\n"
+      "}\n"
+      "\n"
+      "static inline " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 1,
+      " " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 10,
+      "_symdiff (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 4,
+      " a, " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 38,
+      " b) {\n"
+      "  unsigned i;\n"
+      "  for (i = 0; i < " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 68,
+      "; i++) { a.word[i] ^= b.word[i]; }\n"
+      "  return a;\n"
+      "}\n"
+      "\n"
+      "static inline int " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 17,
+      "_in (unsigned e, " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 59,
+      " s) {\n"
+      "  return (int) ((s.word[e >> 6] >> (e & 63)) & 1);\n"
+      "}\n" },
+  /* array */
+  { TEMPLATE_ITEM_SPAN, 93,
+      "/* ---------------------------------------------------------------------------\n"
+      " * array type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 155,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef struct {\n"
+      "  long long unsigned size;\n"
+      "  long long unsigned count;\n"
+      "  " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 7,
+      " value[" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 5,
+      "];\n"
+      "} " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* record */
+  { TEMPLATE_ITEM_SPAN, 94,
+      "/* ---------------------------------------------------------------------------\n"
+      " * record type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 100,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef struct {\n"
+      "  " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 3,
+      "\n"
+      "} " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* opaque */
+  { TEMPLATE_ITEM_SPAN, 94,
+      "/* ---------------------------------------------------------------------------\n"
+      " * opaque type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 8,
+      "_hidden " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* pointer */
+  { TEMPLATE_ITEM_SPAN, 95,
+      "/* ---------------------------------------------------------------------------\n"
+      " * pointer type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      " *" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      ";\n" },
+  /* proctype */
+  { TEMPLATE_ITEM_SPAN, 96,
+      "/* ---------------------------------------------------------------------------\n"
+      " * function type " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 89,
+      "\n"
+      " * ------------------------------------------------------------------------ */\n"
+      "\n"
+      "typedef " },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_2, NULL },
+  { TEMPLATE_ITEM_SPAN, 2,
+      " (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_0, NULL },
+  { TEMPLATE_ITEM_SPAN, 3,
+      ") (" },
+  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_1, NULL },
+  { TEMPLATE_ITEM_SPAN, 3,
+      ");\n" }
+}; /* m2c_template_item */
+
+static const m2c_template_entry_t m2c_template_table[] = {
+  { "preamble", 0, 9 },
+  { "eof", 9, 1 },
+  { "interface", 10, 12 },
+  { "implementation", 22, 10 },
+  { "program", 32, 10 },
+  { "imp-list", 42, 2 },
+  { "def-list", 44, 1 },
+  { "constdef", 45, 7 },
+  { "typedef", 52, 7 },
+  { "vardecl", 59, 7 },
+  { "vardef", 66, 7 },
+  { "procdecl", 73, 9 },
+  { "procdef", 82, 7 },
+  { "hidden-vardef", 89, 7 },
+  { "hidden-procdecl", 96, 7 },
+  { "hidden-procdef", 103, 7 },
+  { "alias", 110, 7 },
+  { "subr", 117, 7 },
+  { "enum", 124, 7 },
+  { "set-word", 131, 5 },
+  { "set-array", 136, 51 },
+  { "array", 187, 9 },
+  { "record", 196, 7 },
+  { "opaque", 203, 7 },
+  { "pointer", 210, 7 },
+  { "proctype", 217, 9 }
+}; /* m2c_template_table */
+
+/* END OF FILE */
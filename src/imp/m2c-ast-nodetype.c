@@ -64,6 +64,7 @@ static uint8_t arity_table[] = {
   3, /* AST_PROCDECL */
   ?, /* AST_UNQ */
   ?, /* AST_TODO */
+  2, /* AST_DECL */
   2, /* AST_ALIAS */
   3, /* AST_SUBR */
   3, /* AST_ENUM */
@@ -147,7 +148,7 @@ static uint8_t arity_table[] = {
 
 static const char *name_table[] = {
   "\0", "EMPTY", "FILE", "INTERFACE", "IMPLEMENTATION", "PROGRAM", "IMPORT",
-  "RE-EXPORT", "CONST", "TYPE", "PROCDEF", "PROCDECL", "UNQ", "TO-DO",
+  "RE-EXPORT", "CONST", "TYPE", "PROCDEF", "PROCDECL", "UNQ", "TO-DO", "DECL",
   "ALIAS", "SUBR", "ENUM", "SET", "ARRAY", "RECORD", "OPAQUE", "POINTER",
   "PROCTYPE", "FIELD", "INDFIELD", "OPEN-ARRAY", "CONSTP", "VARP", "ARGLIST",
   "CAST-ADDR", "CAST-OCTSEQ", "FPARAMS", "BLOCK", "ASSIGN", "COPY", "PCALL",
@@ -159,8 +160,9 @@ static const char *name_table[] = {
   "SUBSCRIPT", "DEREF", "SELECT", "FCALL", "STRUCT", "RANGE", "INSERT",
   "SLICE", "IMPORT-LIST", "RE-EXPORT-LIST", "DEF-LIST", "FIELDLIST-SEQ",
   "FTYPE-LIST", "FPARAM-LIST", "STMT-SEQ", "ELSIF-SEQ", "CASE-LIST",
-  "EXPR-LIST", "ARGS", "IDENT", "FILENAME", "KEY", "INTVAL", "REALVAL",
-  "CHRVAL", "QUOTEDVAL", "IDENT-LIST", "QUALIDENT"
+  "EXPR-LIST", "ARGS", "IDENT", "FILENAME", "KEY", "DECL-KEY", "INTVAL",
+  "REALVAL", "CHRVAL", "QUOTEDVAL", "IDENT-LIST", "QUALIDENT",
+  "LAZY-BODY"
 }; /* end name_table */
 
 
@@ -0,0 +1,869 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-ast-writer.c                                                          *
+ *                                                                           *
+ * Implementation of streaming AST dump writers.                             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-ast-writer.h"
+#include "m2c-ast-nodetype.h"
+#include "m2c-compiler-options.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type node_id_t
+ * --------------------------------------------------------------------------
+ * Identifier of a node in a DOT graph.  Nodes of a flat tree are identified
+ * by their flat position,  written with prefix n,  other nodes by sequence
+ * number,  written with prefix s,  thus the two never collide.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* prefix */ char prefix;
+  /* number */ uint32_t number;
+} node_id_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type writer_context_t
+ * --------------------------------------------------------------------------
+ * State of a dump in progress,  passed to the visitor callbacks.  The DOT
+ * writer keeps the identifiers of the open ancestors of the visited node on
+ * stack parent,  the S-expression writer only counts them in depth.
+ * ----------------------------------------------------------------------- */
+
+#define PARENT_STACK_INITIAL_CAPACITY 64
+
+typedef struct {
+  /* outfile */ outfile_t outfile;
+  /* flat */ m2c_ast_flat_t flat;
+  /* max_depth */ uint_t max_depth;
+  /* depth */ uint_t depth;
+  /* next_seq */ uint32_t next_seq;
+  /* parent */ node_id_t *parent;
+  /* capacity */ uint_t capacity;
+  /* status */ m2c_ast_writer_status_t status;
+} writer_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type search_context_t
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* ident */ intstr_t ident;
+  /* result */ m2c_astnode_t result;
+} search_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type dump_writer_f
+ * --------------------------------------------------------------------------
+ * Type of m2c_ast_write_sexpr and m2c_ast_write_dot.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*dump_writer_f)
+  (outfile_t, m2c_ast_flat_t, m2c_astnode_t, uint_t,
+   m2c_ast_writer_status_t *);
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool defines_ident (m2c_astnode_t node, intstr_t ident);
+
+static m2c_ast_visit_action_t search_pre (m2c_astnode_t node, void *context);
+
+static m2c_ast_visit_action_t sexpr_pre (m2c_astnode_t node, void *context);
+
+static m2c_ast_visit_action_t sexpr_post (m2c_astnode_t node, void *context);
+
+static m2c_ast_visit_action_t dot_pre (m2c_astnode_t node, void *context);
+
+static m2c_ast_visit_action_t dot_post (m2c_astnode_t node, void *context);
+
+static bool is_terminal (m2c_astnode_t node);
+
+static bool at_depth_limit (writer_context_t *ctx, m2c_astnode_t node);
+
+static bool output_failed (writer_context_t *ctx);
+
+static void init_context
+  (writer_context_t *ctx, outfile_t outfile,
+   m2c_ast_flat_t flat, uint_t max_depth);
+
+static void finish_dump
+  (writer_context_t *ctx, bool completed, m2c_ast_writer_status_t *status);
+
+static void write_indent (outfile_t outfile, uint_t depth);
+
+static void write_number (outfile_t outfile, uint32_t value);
+
+static void write_escaped
+  (outfile_t outfile, const char *chars, uint_t length, bool dot);
+
+static void write_node_id (outfile_t outfile, node_id_t id);
+
+static node_id_t id_for_node (writer_context_t *ctx, m2c_astnode_t node);
+
+static bool write_dump
+  (const char *path, m2c_astnode_t root, dump_writer_f writer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_find_subtree(root, ident)
+ * --------------------------------------------------------------------------
+ * Returns the first definition in the tree rooted at root  that defines
+ * identifier ident,  in pre-order,  or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_find_subtree (m2c_astnode_t root, intstr_t ident) {
+  
+  search_context_t search;
+  
+  if ((root == NULL) || (ident == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  search.ident = ident;
+  search.result = NULL;
+  
+  m2c_ast_visit(root, search_pre, NULL, &search);
+  
+  return search.result;
+} /* end m2c_ast_find_subtree */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_write_sexpr(outfile, flat, root, max_depth, status)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to outfile in S-expression format.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_write_sexpr
+  (outfile_t outfile,                 /* in */
+   m2c_ast_flat_t flat,               /* in */
+   m2c_astnode_t root,                /* in */
+   uint_t max_depth,                  /* in */
+   m2c_ast_writer_status_t *status) { /* out */
+
+  writer_context_t ctx;
+  bool completed;
+
+  if ((outfile == NULL) || (root == NULL)) {
+    SET_STATUS(status, M2C_AST_WRITER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  init_context(&ctx, outfile, flat, max_depth);
+  
+  completed = m2c_ast_visit(root, sexpr_pre, sexpr_post, &ctx);
+  outfile_write_newline(outfile);
+  
+  finish_dump(&ctx, completed, status);
+} /* end m2c_ast_write_sexpr */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_write_dot(outfile, flat, root, max_depth, status)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to outfile as a directed graph in DOT
+ * format.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_write_dot
+  (outfile_t outfile,                 /* in */
+   m2c_ast_flat_t flat,               /* in */
+   m2c_astnode_t root,                /* in */
+   uint_t max_depth,                  /* in */
+   m2c_ast_writer_status_t *status) { /* out */
+
+  writer_context_t ctx;
+  bool completed;
+
+  if ((outfile == NULL) || (root == NULL)) {
+    SET_STATUS(status, M2C_AST_WRITER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  init_context(&ctx, outfile, flat, max_depth);
+  
+  /* only use flat positions if root belongs to flat */
+  if ((flat != NULL) && (m2c_ast_flat_node_pos(flat, root) == 0)) {
+    ctx.flat = NULL;
+  } /* end if */
+  
+  ctx.parent = malloc(PARENT_STACK_INITIAL_CAPACITY * sizeof(node_id_t));
+  
+  if (ctx.parent == NULL) {
+    SET_STATUS(status, M2C_AST_WRITER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  ctx.capacity = PARENT_STACK_INITIAL_CAPACITY;
+  
+  outfile_write_chars(outfile, "digraph AST {");
+  outfile_write_newline(outfile);
+  outfile_write_chars(outfile, "  node [shape=box];");
+  outfile_write_newline(outfile);
+  
+  completed = m2c_ast_visit(root, dot_pre, dot_post, &ctx);
+  
+  outfile_write_chars(outfile, "}");
+  outfile_write_newline(outfile);
+  
+  free(ctx.parent);
+  
+  finish_dump(&ctx, completed, status);
+} /* end m2c_ast_write_dot */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_write_tree(path, root)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to a file at path in S-expression format,
+ * applying the dump filters.  Returns true on success,  false otherwise.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_write_tree (const char *path, m2c_astnode_t root) {
+  return write_dump(path, root, m2c_ast_write_sexpr);
+} /* end m2c_ast_write_tree */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_draw_tree(path, root)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to a file at path in DOT format,  applying
+ * the dump filters.  Returns true on success,  false otherwise.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_draw_tree (const char *path, m2c_astnode_t root) {
+  return write_dump(path, root, m2c_ast_write_dot);
+} /* end m2c_ast_draw_tree */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function defines_ident(node, ident)
+ * --------------------------------------------------------------------------
+ * Returns true if node is a definition that defines identifier ident.
+ *
+ * astnode: (CONST bindNode (IDENT constId) typeNode exprNode)
+ *
+ * astnode: (TYPEDEF (IDENT typeId) typeNode)
+ *
+ * astnode: (VARDEF (IDENTLIST ident0 ... identN) typeNode)
+ *
+ * astnode: (PROC (PROCDECL bindSpecNode signatureNode) blockNode)
+ *
+ * astnode: (PROCDECL bindSpecNode (PSIG (IDENT procId) fparams retType))
+ * ----------------------------------------------------------------------- */
+
+static bool defines_ident (m2c_astnode_t node, intstr_t ident) {
+  
+  unsigned short index, count;
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_CONST :
+      node = m2c_ast_subnode_at_index(node, 1);
+      break;
+  
+    case AST_TYPEDEF :
+    case AST_VARDEF :
+      node = m2c_ast_subnode_at_index(node, 0);
+      break;
+  
+    case AST_PROC :
+      node = m2c_ast_subnode_at_index(node, 0);
+      /* fall through */
+  
+    case AST_PROCDECL :
+      if (node != NULL) {
+        node = m2c_ast_subnode_at_index(node, 1);
+      } /* end if */
+  
+      if (node != NULL) {
+        node = m2c_ast_subnode_at_index(node, 0);
+      } /* end if */
+      break;
+  
+    default :
+      return false;
+  } /* end switch */
+  
+  if ((node == NULL) || NOT(is_terminal(node))) {
+    return false;
+  } /* end if */
+  
+  /* interned strings are unique,  compare by address */
+  count = m2c_ast_subnode_count(node);
+  for (index = 0; index < count; index++) {
+    if (m2c_ast_value_at_index(node, index) == ident) {
+      return true;
+    } /* end if */
+  } /* end for */
+  
+  return false;
+} /* end defines_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function search_pre(node, context)
+ * --------------------------------------------------------------------------
+ * Pre-order callback of m2c_ast_find_subtree.  Ends the traversal at the
+ * first node that defines the identifier searched for.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t search_pre (m2c_astnode_t node, void *context) {
+  
+  search_context_t *search = (search_context_t *) context;
+  
+  if (is_terminal(node)) {
+    return M2C_AST_VISIT_SKIP;
+  } /* end if */
+  
+  if (defines_ident(node, search->ident)) {
+    search->result = node;
+    return M2C_AST_VISIT_STOP;
+  } /* end if */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end search_pre */
+
+
+/* --------------------------------------------------------------------------
+ * private function sexpr_pre(node, context)
+ * --------------------------------------------------------------------------
+ * Pre-order callback of m2c_ast_write_sexpr.  Writes the opening of node on
+ * a line of its own,  terminal nodes and nodes at the depth limit in whole.
+ *
+ * output: (TYPE "value0" ... "valueN")  for terminal nodes
+ *
+ * output: (TYPE ...)  for nodes at the depth limit
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t sexpr_pre (m2c_astnode_t node, void *context) {
+  
+  writer_context_t *ctx = (writer_context_t *) context;
+  unsigned short index, count;
+  intstr_t value;
+  
+  if (output_failed(ctx)) {
+    return M2C_AST_VISIT_STOP;
+  } /* end if */
+  
+  if (ctx->depth > 0) {
+    outfile_write_newline(ctx->outfile);
+    write_indent(ctx->outfile, ctx->depth);
+  } /* end if */
+  
+  outfile_write_char(ctx->outfile, '(');
+  outfile_write_chars(ctx->outfile,
+    m2c_name_for_nodetype(m2c_ast_nodetype(node)));
+  
+  if (is_terminal(node)) {
+    count = m2c_ast_subnode_count(node);
+    for (index = 0; index < count; index++) {
+      value = m2c_ast_value_at_index(node, index);
+      outfile_write_chars(ctx->outfile, " \"");
+  
+      if (value != NULL) {
+        write_escaped(ctx->outfile,
+          intstr_char_ptr(value), intstr_length(value), false);
+      } /* end if */
+  
+      outfile_write_char(ctx->outfile, '"');
+    } /* end for */
+  
+    outfile_write_char(ctx->outfile, ')');
+    return M2C_AST_VISIT_SKIP;
+  } /* end if */
+  
+  if (at_depth_limit(ctx, node)) {
+    outfile_write_chars(ctx->outfile, " ...)");
+    return M2C_AST_VISIT_SKIP;
+  } /* end if */
+  
+  ctx->depth++;
+  return M2C_AST_VISIT_CONTINUE;
+} /* end sexpr_pre */
+
+
+/* --------------------------------------------------------------------------
+ * private function sexpr_post(node, context)
+ * --------------------------------------------------------------------------
+ * Post-order callback of m2c_ast_write_sexpr.  Closes node,  which only
+ * takes the depth recorded in context.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t sexpr_post (m2c_astnode_t node, void *context) {
+  
+  writer_context_t *ctx = (writer_context_t *) context;
+  
+  (void) node;
+  
+  outfile_write_char(ctx->outfile, ')');
+  ctx->depth--;
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end sexpr_post */
+
+
+/* --------------------------------------------------------------------------
+ * private function dot_pre(node, context)
+ * --------------------------------------------------------------------------
+ * Pre-order callback of m2c_ast_write_dot.  Writes the vertex of node and
+ * the edge from its parent,  then pushes the identifier of node unless its
+ * subnodes are skipped.
+ *
+ * output: n42 [label="TYPE\n\"value0\"\n...\n\"valueN\""];
+ *         n57 -> n42;
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t dot_pre (m2c_astnode_t node, void *context) {
+  
+  writer_context_t *ctx = (writer_context_t *) context;
+  unsigned short index, count;
+  node_id_t id, *new_stack;
+  uint_t new_capacity;
+  intstr_t value;
+  bool terminal, skip;
+  
+  if (output_failed(ctx)) {
+    return M2C_AST_VISIT_STOP;
+  } /* end if */
+  
+  id = id_for_node(ctx, node);
+  terminal = is_terminal(node);
+  skip = terminal || at_depth_limit(ctx, node);
+  
+  /* vertex */
+  outfile_write_chars(ctx->outfile, "  ");
+  write_node_id(ctx->outfile, id);
+  outfile_write_chars(ctx->outfile, " [label=\"");
+  outfile_write_chars(ctx->outfile,
+    m2c_name_for_nodetype(m2c_ast_nodetype(node)));
+  
+  if (terminal) {
+    count = m2c_ast_subnode_count(node);
+    for (index = 0; index < count; index++) {
+      value = m2c_ast_value_at_index(node, index);
+      outfile_write_chars(ctx->outfile, "\\n\\\"");
+  
+      if (value != NULL) {
+        write_escaped(ctx->outfile,
+          intstr_char_ptr(value), intstr_length(value), true);
+      } /* end if */
+  
+      outfile_write_chars(ctx->outfile, "\\\"");
+    } /* end for */
+  }
+  else if (skip) {
+    outfile_write_chars(ctx->outfile, " ...");
+  } /* end if */
+  
+  outfile_write_chars(ctx->outfile, "\"];");
+  outfile_write_newline(ctx->outfile);
+  
+  /* edge from parent */
+  if (ctx->depth > 0) {
+    outfile_write_chars(ctx->outfile, "  ");
+    write_node_id(ctx->outfile, ctx->parent[ctx->depth - 1]);
+    outfile_write_chars(ctx->outfile, " -> ");
+    write_node_id(ctx->outfile, id);
+    outfile_write_char(ctx->outfile, ';');
+    outfile_write_newline(ctx->outfile);
+  } /* end if */
+  
+  if (skip) {
+    return M2C_AST_VISIT_SKIP;
+  } /* end if */
+  
+  /* grow parent stack if full */
+  if (ctx->depth == ctx->capacity) {
+    new_capacity = 2 * ctx->capacity;
+    new_stack = realloc(ctx->parent, new_capacity * sizeof(node_id_t));
+  
+    if (new_stack == NULL) {
+      ctx->status = M2C_AST_WRITER_STATUS_ALLOCATION_FAILED;
+      return M2C_AST_VISIT_STOP;
+    } /* end if */
+  
+    ctx->parent = new_stack;
+    ctx->capacity = new_capacity;
+  } /* end if */
+  
+  ctx->parent[ctx->depth] = id;
+  ctx->depth++;
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end dot_pre */
+
+
+/* --------------------------------------------------------------------------
+ * private function dot_post(node, context)
+ * --------------------------------------------------------------------------
+ * Post-order callback of m2c_ast_write_dot.  Pops the identifier of node,
+ * which is the top of the parent stack in context.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t dot_post (m2c_astnode_t node, void *context) {
+  
+  writer_context_t *ctx = (writer_context_t *) context;
+  
+  (void) node;
+  
+  ctx->depth--;
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end dot_post */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_terminal(node)
+ * --------------------------------------------------------------------------
+ * Returns true if node is a terminal node or a terminal list node,  whose
+ * subnode count is the number of its values.
+ * ----------------------------------------------------------------------- */
+
+static bool is_terminal (m2c_astnode_t node) {
+  
+  m2c_ast_nodetype_t node_type;
+  
+  node_type = m2c_ast_nodetype(node);
+  
+  return (AST_IS_TERMINAL_NODETYPE(node_type) ||
+    AST_IS_TERMINAL_LIST_NODETYPE(node_type));
+} /* end is_terminal */
+
+
+/* --------------------------------------------------------------------------
+ * private function at_depth_limit(ctx, node)
+ * --------------------------------------------------------------------------
+ * Returns true if the subnodes of non-terminal node are cut off by the depth
+ * limit of ctx.  Nodes without subnodes are never cut off.
+ * ----------------------------------------------------------------------- */
+
+static bool at_depth_limit (writer_context_t *ctx, m2c_astnode_t node) {
+  
+  return ((ctx->max_depth != 0) && (ctx->depth >= ctx->max_depth) &&
+    (m2c_ast_subnode_count(node) > 0));
+} /* end at_depth_limit */
+
+
+/* --------------------------------------------------------------------------
+ * private function output_failed(ctx)
+ * --------------------------------------------------------------------------
+ * Returns true if writing to the outfile of ctx has failed.  The outfile
+ * only reports the status of its last operation,  thus the failure is
+ * recorded in ctx.
+ * ----------------------------------------------------------------------- */
+
+static bool output_failed (writer_context_t *ctx) {
+  
+  if (outfile_status(ctx->outfile) != FILEIO_STATUS_SUCCESS) {
+    ctx->status = M2C_AST_WRITER_STATUS_IO_ERROR;
+  } /* end if */
+  
+  return (ctx->status != M2C_AST_WRITER_STATUS_SUCCESS);
+} /* end output_failed */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure init_context(ctx, outfile, flat, max_depth)
+ * --------------------------------------------------------------------------
+ * Initialises writer context ctx for a dump to outfile.
+ * ----------------------------------------------------------------------- */
+
+static void init_context
+  (writer_context_t *ctx, outfile_t outfile,
+   m2c_ast_flat_t flat, uint_t max_depth) {
+  
+  ctx->outfile = outfile;
+  ctx->flat = flat;
+  ctx->max_depth = max_depth;
+  ctx->depth = 0;
+  ctx->next_seq = 0;
+  ctx->parent = NULL;
+  ctx->capacity = 0;
+  ctx->status = M2C_AST_WRITER_STATUS_SUCCESS;
+  
+} /* end init_context */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure finish_dump(ctx, completed, status)
+ * --------------------------------------------------------------------------
+ * Flushes the outfile of ctx  and passes the outcome of the dump in status.
+ * A traversal that did not complete without a recorded failure could not
+ * allocate its stack.
+ * ----------------------------------------------------------------------- */
+
+static void finish_dump
+  (writer_context_t *ctx, bool completed, m2c_ast_writer_status_t *status) {
+  
+  if (NOT(output_failed(ctx))) {
+    outfile_flush(ctx->outfile);
+    output_failed(ctx);
+  } /* end if */
+  
+  if ((NOT(completed)) && (ctx->status == M2C_AST_WRITER_STATUS_SUCCESS)) {
+    ctx->status = M2C_AST_WRITER_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  SET_STATUS(status, ctx->status);
+  
+} /* end finish_dump */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_indent(outfile, depth)
+ * --------------------------------------------------------------------------
+ * Writes two spaces per level of depth to outfile.
+ * ----------------------------------------------------------------------- */
+
+static void write_indent (outfile_t outfile, uint_t depth) {
+  
+  static const char spaces[] = "                                ";
+  uint_t count;
+  
+  count = 2 * depth;
+  while (count > sizeof(spaces) - 1) {
+    outfile_write_bytes(outfile, spaces, sizeof(spaces) - 1);
+    count = count - (sizeof(spaces) - 1);
+  } /* end while */
+  
+  outfile_write_bytes(outfile, spaces, count);
+  
+} /* end write_indent */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_number(outfile, value)
+ * --------------------------------------------------------------------------
+ * Writes value in decimal notation to outfile.
+ * ----------------------------------------------------------------------- */
+
+#define MAX_DECIMAL_DIGITS 10
+
+static void write_number (outfile_t outfile, uint32_t value) {
+  
+  char digit[MAX_DECIMAL_DIGITS];
+  char *buffer;
+  uint_t count, index;
+  
+  count = 0;
+  do {
+    digit[count] = (char) ('0' + (value % 10));
+    value = value / 10;
+    count++;
+  } while (value > 0);
+  
+  buffer = outfile_reserve(outfile, count);
+  
+  if (buffer == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    buffer[index] = digit[count - index - 1];
+  } /* end for */
+  
+  outfile_commit(outfile, count);
+  
+} /* end write_number */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_escaped(outfile, chars, length, dot)
+ * --------------------------------------------------------------------------
+ * Writes length characters at chars to outfile for use within a quoted
+ * string,  escaping quotation marks and backslashes.  If dot is true,  line
+ * feeds are escaped as in DOT labels,  otherwise as in C.  Runs of characters
+ * that need no escaping are written in one call.
+ * ----------------------------------------------------------------------- */
+
+static void write_escaped
+  (outfile_t outfile, const char *chars, uint_t length, bool dot) {
+  
+  uint_t index, start;
+  char ch;
+  
+  start = 0;
+  for (index = 0; index < length; index++) {
+    ch = chars[index];
+  
+    if ((ch == '"') || (ch == '\\') || (ch == '\n') || (ch == '\r')) {
+      if (index > start) {
+        outfile_write_bytes(outfile, chars + start, index - start);
+      } /* end if */
+  
+      outfile_write_char(outfile, '\\');
+  
+      if (ch == '\n') {
+        outfile_write_char(outfile, 'n');
+      }
+      else if (ch == '\r') {
+        outfile_write_char(outfile, (dot) ? 'n' : 'r');
+      }
+      else /* quotation mark or backslash */ {
+        outfile_write_char(outfile, ch);
+      } /* end if */
+  
+      start = index + 1;
+    } /* end if */
+  } /* end for */
+  
+  if (length > start) {
+    outfile_write_bytes(outfile, chars + start, length - start);
+  } /* end if */
+  
+} /* end write_escaped */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_node_id(outfile, id)
+ * --------------------------------------------------------------------------
+ * Writes node identifier id to outfile.
+ * ----------------------------------------------------------------------- */
+
+static void write_node_id (outfile_t outfile, node_id_t id) {
+  
+  outfile_write_char(outfile, id.prefix);
+  write_number(outfile, id.number);
+  
+} /* end write_node_id */
+
+
+/* --------------------------------------------------------------------------
+ * private function id_for_node(ctx, node)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of node,  its flat position if the flat tree of
+ * ctx holds node,  else the next sequence number.
+ * ----------------------------------------------------------------------- */
+
+static node_id_t id_for_node (writer_context_t *ctx, m2c_astnode_t node) {
+  
+  node_id_t id;
+  
+  if (ctx->flat != NULL) {
+    id.number = m2c_ast_flat_node_pos(ctx->flat, node);
+  
+    if (id.number != 0) {
+      id.prefix = 'n';
+      return id;
+    } /* end if */
+  } /* end if */
+  
+  ctx->next_seq++;
+  id.prefix = 's';
+  id.number = ctx->next_seq;
+  
+  return id;
+} /* end id_for_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_dump(path, root, writer)
+ * --------------------------------------------------------------------------
+ * Flattens the tree rooted at root,  applies the dump filters of options
+ * --dump-subtree and --dump-depth  and writes the result to a file at path
+ * using writer.  If the tree cannot be flattened,  it is written as is.
+ * Returns true on success,  false otherwise.
+ * ----------------------------------------------------------------------- */
+
+static bool write_dump
+  (const char *path, m2c_astnode_t root, dump_writer_f writer) {
+  
+  m2c_ast_writer_status_t status;
+  outfile_status_t file_status;
+  intstr_status_t intstr_status;
+  const char *subtree_name;
+  m2c_ast_flat_t flat;
+  outfile_t outfile;
+  intstr_t ident;
+  
+  if ((path == NULL) || (root == NULL)) {
+    return false;
+  } /* end if */
+  
+  flat = m2c_ast_flatten(root);
+  
+  if (flat != NULL) {
+    root = m2c_ast_flat_root(flat);
+  } /* end if */
+  
+  /* option --dump-subtree */
+  subtree_name = m2c_compiler_option_dump_subtree();
+  
+  if (subtree_name != NULL) {
+    ident = intstr_for_cstr(subtree_name, &intstr_status);
+    root = m2c_ast_find_subtree(root, ident);
+  
+    if (root == NULL) {
+      printf("no definition of %s to dump\n", subtree_name);
+      m2c_ast_release_flat(flat);
+      return false;
+    } /* end if */
+  } /* end if */
+  
+  outfile_open(&outfile, path, &file_status);
+  
+  if (outfile == NULL) {
+    m2c_ast_release_flat(flat);
+    return false;
+  } /* end if */
+  
+  writer(outfile, flat, root, m2c_compiler_option_dump_depth(), &status);
+  
+  outfile_close(&outfile);
+  m2c_ast_release_flat(flat);
+  
+  return (status == M2C_AST_WRITER_STATUS_SUCCESS);
+} /* end write_dump */
+
+/* END OF FILE */
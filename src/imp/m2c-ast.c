@@ -42,9 +42,92 @@
  * ----------------------------------------------------------------------- */
 
 #include "m2c-ast.h"
+#include "m2c-mem-account.h"
+#include "hash.h"
 
+#include <stdio.h>
+#include <stdarg.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped AST files for POSIX and Unix-like host platforms
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  AST files are mapped into the address space
+ * and their nodes are used in place.  On all other hosts  (AmigaOS, OpenVMS,
+ * Windows) the file is read into a buffer.  Define M2C_AST_FILE_USE_MMAP as
+ * 0 to force the buffered implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_AST_FILE_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_AST_FILE_USE_MMAP 1
+#else
+#define M2C_AST_FILE_USE_MMAP 0
+#endif
+#endif
+
+#if (M2C_AST_FILE_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Node flags
+ * ----------------------------------------------------------------------- */
+
+#define AST_FLAG_NONE 0
+
+#define AST_FLAG_IN_REGION 1  /* node storage is owned by a region */
+
+#define AST_FLAG_FLAT 2       /* node is part of a flat tree */
+
+#define AST_FLAG_SHARED 4     /* node is shared by hash-consing */
+
+#define AST_FLAGS_IMMUTABLE (AST_FLAG_FLAT | AST_FLAG_SHARED)
+
+
+/* --------------------------------------------------------------------------
+ * macro CHECK_FIXED_ARITY(node_type, subnode_count)
+ * --------------------------------------------------------------------------
+ * Returns NULL from a fixed-arity constructor  if node_type is not a non-
+ * terminal node type of arity subnode_count.  The check is omitted in builds
+ * with NDEBUG defined,  where fixed-arity construction is straight-line code.
+ * ----------------------------------------------------------------------- */
+
+#if defined(NDEBUG)
+#define CHECK_FIXED_ARITY(_type, _count) /* unchecked */
+#else
+#define CHECK_FIXED_ARITY(_type, _count) \
+  { if ((!AST_IS_NONTERMINAL_NODETYPE(_type)) || \
+        (!m2c_ast_is_legal_subnode_count((_type), (_count)))) { \
+      return NULL; } }
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * macro IS_TERMINAL_OR_TERMINAL_LIST(node_type)
+ * ----------------------------------------------------------------------- */
+
+#define IS_TERMINAL_OR_TERMINAL_LIST(_type) \
+  ((AST_IS_TERMINAL_NODETYPE(_type)) || (AST_IS_TERMINAL_LIST_NODETYPE(_type)))
+
+
+/* --------------------------------------------------------------------------
+ * Region block alignment
+ * ----------------------------------------------------------------------- */
+
+#define AST_REGION_ALIGNMENT (sizeof(void *))
+
+#define REGION_ROUND_UP(_size) \
+  (((_size) + AST_REGION_ALIGNMENT - 1) & ~(AST_REGION_ALIGNMENT - 1))
 
 
 /* --------------------------------------------------------------------------
@@ -53,20 +136,169 @@
  * record type representing an AST node object.
  * ----------------------------------------------------------------------- */
 
+union m2c_astnode_variant {
+  intstr_t terminal;
+  m2c_astnode_t non_terminal;
+};
+
+typedef union m2c_astnode_variant m2c_astnode_variant;
+
 struct m2c_astnode_struct_t {
   /* node_type */     m2c_ast_nodetype_t node_type;
   /* subnode_count */ unsigned short subnode_count;
+  /* flags */         unsigned short flags;
   /* subnode_table */ m2c_astnode_variant subnode_table[];
 };
 
 typedef struct m2c_astnode_struct_t m2c_astnode_struct_t;
 
-union m2c_astnode_variant {
-  intstr_t terminal;
-  m2c_astnode_t non_terminal;
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ast_region_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing an AST storage region.  Nodes are carved from
+ * the most recent block,  blocks are linked from the most recent to the
+ * first.
+ *
+ * If hash-consing is enabled,  field shared is an open addressing table of
+ * the canonical nodes of the region,  shared_capacity is a power of two.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ast_region_block_s *m2c_ast_region_block_t;
+
+struct m2c_ast_region_block_s {
+  m2c_ast_region_block_t prev;
+  size_t size;
+  size_t used;
+  char storage[];
 };
 
-typedef union m2c_astnode_variant m2c_astnode_variant;
+typedef struct m2c_ast_region_block_s m2c_ast_region_block_s;
+
+struct m2c_ast_region_struct_t {
+  size_t block_size;
+  size_t node_count;
+  m2c_ast_region_block_t block;
+  bool hash_consing;
+  m2c_astnode_t *shared;
+  size_t shared_count;
+  size_t shared_capacity;
+  size_t reused_count;
+};
+
+#define AST_SHARED_INITIAL_CAPACITY 1024
+
+typedef struct m2c_ast_region_struct_t m2c_ast_region_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ast_flat_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing a flat tree.  All nodes are stored in post-order
+ * in one array of 32-bit words,  each beginning with the header of a regular
+ * node flagged AST_FLAG_FLAT,  so that node type and subnode count are read
+ * the same way for both representations.  The header is followed by
+ *
+ * o  for non-terminal nodes,  one word per subnode holding the distance in
+ *    words back to the subnode,  FLAT_EMPTY_DISTANCE for the empty node or
+ *    FLAT_NULL_DISTANCE for NULL,
+ *
+ * o  for terminal nodes,  the distance in words back to the array base,
+ *    followed by one index into the value table per value.
+ *
+ * The array base holds a pointer back to the flat tree record.  Nodes are
+ * padded to the alignment of the node header.
+ *
+ * If the tree has been read from an AST file,  file_data holds the contents
+ * of the file,  mapped into memory if is_mapped is set,  and the word array
+ * is part of it.  Values of such a tree are retained by the tree.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_ast_flat_struct_t {
+  uint32_t *word;
+  uint32_t word_count;
+  uint32_t word_capacity;
+  intstr_t *value;
+  uint32_t value_count;
+  uint32_t value_capacity;
+  uint32_t node_count;
+  uint32_t root;
+  void *file_data;
+  size_t file_size;
+  bool is_mapped;
+};
+
+typedef struct m2c_ast_flat_struct_t m2c_ast_flat_struct_t;
+
+#define FLAT_HEADER_WORDS (sizeof(m2c_astnode_struct_t) / sizeof(uint32_t))
+
+#define FLAT_NODE_ALIGN_WORDS FLAT_HEADER_WORDS
+
+#define FLAT_BASE_WORDS \
+  ((sizeof(m2c_ast_flat_t) + sizeof(m2c_astnode_struct_t) - 1) / \
+    sizeof(m2c_astnode_struct_t) * FLAT_HEADER_WORDS)
+
+#define FLAT_EMPTY_DISTANCE 0
+
+#define FLAT_NULL_DISTANCE UINT32_MAX
+
+#define FLAT_NODE(_flat, _pos) ((m2c_astnode_t) &(_flat)->word[_pos])
+
+#define FLAT_TABLE(_node) \
+  (((const uint32_t *) (_node)) + FLAT_HEADER_WORDS)
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_ast_frame_t
+ * --------------------------------------------------------------------------
+ * record type representing a node on the explicit stack of a traversal and
+ * the index of its next subnode to descend into.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_astnode_t node;
+  unsigned short next;
+} m2c_ast_frame_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_ast_file_header_t
+ * --------------------------------------------------------------------------
+ * record type representing the header of a binary AST file.
+ *
+ * The header is followed at offset AST_FILE_WORDS_OFFSET by the word array
+ * of a flat tree exactly as laid out in memory,  except that the base words
+ * are zero,  followed by one record per entry of the value table,  holding
+ * a 32-bit length,  or AST_FILE_NULL_VALUE for NULL,  followed by as many
+ * characters.  All fields are in host byte order.  Field layout records the
+ * node layout and the number of node types of the writing build.
+ * ----------------------------------------------------------------------- */
+
+#define AST_FILE_MAGIC "M2C-AST"
+
+#define AST_FILE_BYTE_ORDER 0x01020304
+
+#define AST_FILE_LAYOUT \
+  (((uint32_t) FLAT_HEADER_WORDS) | \
+   ((uint32_t) FLAT_BASE_WORDS << 4) | \
+   ((uint32_t) sizeof(m2c_astnode_struct_t) << 8) | \
+   ((uint32_t) AST_END_MARK << 16))
+
+#define AST_FILE_NULL_VALUE UINT32_MAX
+
+typedef struct {
+  /* magic */           char magic[8];
+  /* version */         uint32_t version;
+  /* byte_order */      uint32_t byte_order;
+  /* layout */          uint32_t layout;
+  /* node_count */      uint32_t node_count;
+  /* root */            uint32_t root;
+  /* word_count */      uint32_t word_count;
+  /* value_count */     uint32_t value_count;
+  /* string_size */     uint32_t string_size;
+} m2c_ast_file_header_t;
+
+#define AST_FILE_WORDS_OFFSET REGION_ROUND_UP(sizeof(m2c_ast_file_header_t))
 
 
 /* --------------------------------------------------------------------------
@@ -74,391 +306,2064 @@ typedef union m2c_astnode_variant m2c_astnode_variant;
  * ----------------------------------------------------------------------- */
 
 static const m2c_astnode_struct_t m2c_ast_empty_node_struct = {
-  AST_EMPTY, 0, NULL
+  AST_EMPTY, 0, AST_FLAG_NONE
 };
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_empty_node()
+ * private variable current_region
  * --------------------------------------------------------------------------
- * Returns the empty node singleton.
+ * region from which new nodes are allocated,  or NULL to use malloc,  kept
+ * per thread if built with M2C_AST_THREAD_SAFE.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_empty_node (void) {
-  return (m2c_astnode_t) &m2c_ast_empty_node_struct;
-} /* end m2c_ast_empty_node */
+#if (M2C_AST_THREAD_SAFE)
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+#else
+#define THREAD_LOCAL /* single threaded */
+#endif
+
+static THREAD_LOCAL m2c_ast_region_t current_region = NULL;
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_new_node(node_type, subnode0, subnode1, subnode2, ...)
+ * function m2c_ast_new_region(block_size)
  * --------------------------------------------------------------------------
- * Allocates a new branch node of the given node type, stores the subnodes of
- * the argument list in the node and returns the node, or NULL on failure.
- *
- * pre-conditions:
- * o  node_type must be a valid node type
- * o  a NULL terminated argument list of valid ast nodes must be passed
- *    and type and number of subnodes must match the given node type.
- *
- * post-conditions:
- * o  newly allocated and populated ast node is returned
- *
- * error-conditions:
- * o  if allocation fails, no node is allocated and NULL is returned
- * o  if node_type is invalid, no node is allocated and NULL is returned
- * o  if type and number of subnodes does not match the given node type,
- *    no node is allocated and NULL is returned
+ * Returns a new empty AST region,  or NULL on failure.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_new_node
-  (m2c_ast_nodetype_t node_type, ...) {
+m2c_ast_region_t m2c_ast_new_region (size_t block_size) {
   
-  m2c_astnode_t this_subnode, new_node;
-  unsigned short subnode_count, index;
-  va_list subnode_list;
+  m2c_ast_region_t new_region;
   
-  if (!m2c_ast_is_nonterminal_nodetype(node_type)) {
+  if (block_size == 0) {
+    block_size = M2C_AST_REGION_DEFAULT_BLOCK_SIZE;
+  } /* end if */
+  
+  new_region = m2c_mem_alloc(M2C_MEM_AST, sizeof(m2c_ast_region_struct_t));
+  
+  if (new_region == NULL) {
     return NULL;
   } /* end if */
   
-  /* count subnodes in arglist */
-  subnode_count = 0;
-  va_start(subnode_list, node_type);
-  this_subnode = va_arg(subnode_list, m2c_astnode_t);
-  while (this_subnode != NULL) {
-    subnode_count++;
-    this_subnode = va_arg(subnode_list, m2c_astnode_t);
+  new_region->block_size = block_size;
+  new_region->node_count = 0;
+  new_region->block = NULL;
+  new_region->hash_consing = false;
+  new_region->shared = NULL;
+  new_region->shared_count = 0;
+  new_region->shared_capacity = 0;
+  new_region->reused_count = 0;
+  
+  return new_region;
+} /* end m2c_ast_new_region */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_set_region(region)
+ * --------------------------------------------------------------------------
+ * Makes region the current region.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_set_region (m2c_ast_region_t region) {
+  
+  current_region = region;
+} /* end m2c_ast_set_region */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_current_region()
+ * --------------------------------------------------------------------------
+ * Returns the current region,  or NULL if none is set.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_region_t m2c_ast_current_region (void) {
+  
+  return current_region;
+} /* end m2c_ast_current_region */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_region_node_count(region)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes allocated from region.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_ast_region_node_count (m2c_ast_region_t region) {
+  
+  if (region == NULL) {
+    return 0;
+  } /* end if */
+  
+  return region->node_count;
+} /* end m2c_ast_region_node_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_region_set_hash_consing(region, enabled)
+ * --------------------------------------------------------------------------
+ * Enables or disables hash-consing for region.  Nodes already shared remain
+ * shared when hash-consing is disabled.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_region_set_hash_consing (m2c_ast_region_t region, bool enabled) {
+  
+  if (region == NULL) {
+    return;
+  } /* end if */
+  
+  region->hash_consing = enabled;
+} /* end m2c_ast_region_set_hash_consing */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_region_shared_node_count(region)
+ * --------------------------------------------------------------------------
+ * Returns the number of constructions satisfied by an existing node.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_ast_region_shared_node_count (m2c_ast_region_t region) {
+  
+  if (region == NULL) {
+    return 0;
+  } /* end if */
+  
+  return region->reused_count;
+} /* end m2c_ast_region_shared_node_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_region_reset(region)
+ * --------------------------------------------------------------------------
+ * Deallocates all nodes of region,  keeping its most recent block if it is
+ * of the regular block size.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_region_reset (m2c_ast_region_t region) {
+  
+  m2c_ast_region_block_t this_block, prev_block;
+  
+  if (region == NULL) {
+    return;
+  } /* end if */
+  
+  this_block = region->block;
+  
+  /* keep the most recent block unless it is an oversized one */
+  if ((this_block != NULL) && (this_block->size == region->block_size)) {
+    this_block->used = 0;
+    prev_block = this_block->prev;
+    this_block->prev = NULL;
+    this_block = prev_block;
+  }
+  else /* keep none */ {
+    region->block = NULL;
+  } /* end if */
+  
+  while (this_block != NULL) {
+    prev_block = this_block->prev;
+    m2c_mem_free(M2C_MEM_AST, this_block);
+    this_block = prev_block;
   } /* end while */
   
-  va_end(subnode_list);
+  /* clear canonical node table */
+  if (region->shared != NULL) {
+    memset(region->shared, 0, region->shared_capacity * sizeof(m2c_astnode_t));
+  } /* end if */
   
-  /* verify subnode count */
-  if (!m2c_ast_is_legal_subnode_count(node_type, subnode_count)) {
+  region->node_count = 0;
+  region->shared_count = 0;
+  region->reused_count = 0;
+  
+  return;
+} /* end m2c_ast_region_reset */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_region(region)
+ * --------------------------------------------------------------------------
+ * Deallocates region and all nodes allocated from it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_region (m2c_ast_region_t region) {
+  
+  m2c_ast_region_block_t this_block, prev_block;
+  
+  if (region == NULL) {
+    return;
+  } /* end if */
+  
+  if (region == current_region) {
+    current_region = NULL;
+  } /* end if */
+  
+  this_block = region->block;
+  while (this_block != NULL) {
+    prev_block = this_block->prev;
+    m2c_mem_free(M2C_MEM_AST, this_block);
+    this_block = prev_block;
+  } /* end while */
+  
+  m2c_mem_free(M2C_MEM_AST, region->shared);
+  m2c_mem_free(M2C_MEM_AST, region);
+  
+  return;
+} /* end m2c_ast_release_region */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flatten(root)
+ * --------------------------------------------------------------------------
+ * Returns a flat copy of the tree rooted at root,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t flat_node_words (m2c_astnode_t node);
+
+static m2c_ast_flat_t new_flat (void);
+
+static bool flatten_tree (m2c_ast_flat_t flat, m2c_astnode_t root);
+
+m2c_ast_flat_t m2c_ast_flatten (m2c_astnode_t root) {
+  
+  m2c_ast_flat_t flat;
+  
+  if (root == NULL) {
     return NULL;
   } /* end if */
   
-  if (node_type == AST_EMPTY) {
-    return (m2c_astnode_t) &m2c_ast_empty_node_struct;
+  flat = new_flat();
+  
+  if (flat == NULL) {
+    return NULL;
   } /* end if */
   
-  /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + subnode_count * sizeof(m2c_astnode_t));
+  if (NOT(flatten_tree(flat, root))) {
+    m2c_ast_release_flat(flat);
+    return NULL;
+  } /* end if */
   
-  /* initialise fields */
-  new_node->node_type = node_type;
-  new_node->subnode_count = subnode_count;
+  return flat;
+} /* end m2c_ast_flatten */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_root(flat)
+ * --------------------------------------------------------------------------
+ * Returns the root node of flat,  or NULL if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_flat_root (m2c_ast_flat_t flat) {
   
-  /* store subnodes in table */
-  va_start(subnode_list, node_type);
-  for (index = 0; index < subnode_count; index++) {
-    new_node->subnode_table[index].non_terminal =
-      va_arg(subnode_list, m2c_astnode_t);
-  } /* end for */
+  if (flat == NULL) {
+    return NULL;
+  } /* end if */
   
-  va_end(subnode_list);
+  return FLAT_NODE(flat, flat->root);
+} /* end m2c_ast_flat_root */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_node_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in flat.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_ast_flat_node_count (m2c_ast_flat_t flat) {
   
-  return new_node;
-} /* end m2c_ast_new_node */
+  if (flat == NULL) {
+    return 0;
+  } /* end if */
+  
+  return flat->node_count;
+} /* end m2c_ast_flat_node_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_size(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes occupied by the nodes and values of flat.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_ast_flat_size (m2c_ast_flat_t flat) {
+  
+  if (flat == NULL) {
+    return 0;
+  } /* end if */
+  
+  return flat->word_count * sizeof(uint32_t) +
+    flat->value_count * sizeof(intstr_t);
+} /* end m2c_ast_flat_size */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_node_pos(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns the position of node within the word array of flat,  or zero if
+ * node does not lie within it.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2c_ast_flat_node_pos (m2c_ast_flat_t flat, m2c_astnode_t node) {
+  
+  const uint32_t *word;
+  
+  if ((flat == NULL) || (node == NULL)) {
+    return 0;
+  } /* end if */
+  
+  word = (const uint32_t *) node;
+  
+  if ((word < &flat->word[FLAT_BASE_WORDS]) ||
+      (word >= &flat->word[flat->word_count])) {
+    return 0;
+  } /* end if */
+  
+  return (uint32_t) (word - flat->word);
+} /* end m2c_ast_flat_node_pos */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_node_at(flat, pos)
+ * --------------------------------------------------------------------------
+ * Returns the node at position pos within flat,  or NULL if pos is not node
+ * aligned,  lies outside of flat,  or does not hold a flat node header whose
+ * node extends no further than the end of the word array.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_flat_node_at (m2c_ast_flat_t flat, uint32_t pos) {
+  
+  m2c_astnode_t node;
+  
+  if ((flat == NULL) || (pos < FLAT_BASE_WORDS) ||
+      (pos % FLAT_NODE_ALIGN_WORDS != 0) ||
+      (flat->word_count - FLAT_HEADER_WORDS < pos)) {
+    return NULL;
+  } /* end if */
+  
+  node = FLAT_NODE(flat, pos);
+  
+  if ((node->node_type <= AST_INVALID) ||
+      (node->node_type >= AST_END_MARK) ||
+      (node->flags != AST_FLAG_FLAT) ||
+      (flat_node_words(node) > flat->word_count - pos)) {
+    return NULL;
+  } /* end if */
+  
+  return node;
+} /* end m2c_ast_flat_node_at */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_flat(flat)
+ * --------------------------------------------------------------------------
+ * Deallocates flat and all its nodes.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_ast_flat_t flat);
+
+void m2c_ast_release_flat (m2c_ast_flat_t flat) {
+  
+  uint32_t index;
+  
+  if (flat == NULL) {
+    return;
+  } /* end if */
+  
+  if (flat->file_data != NULL) {
+    for (index = 0; index < flat->value_count; index++) {
+      if (flat->value[index] != NULL) {
+        intstr_release(flat->value[index]);
+      } /* end if */
+    } /* end for */
+    release_file_data(flat);
+  }
+  else {
+    m2c_mem_free(M2C_MEM_AST, flat->word);
+  } /* end if */
+  
+  m2c_mem_free(M2C_MEM_AST, flat->value);
+  m2c_mem_free(M2C_MEM_AST, flat);
+  
+  return;
+} /* end m2c_ast_release_flat */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_write_file(flat, path, status)
+ * --------------------------------------------------------------------------
+ * Writes flat to a binary AST file at path,  replacing any existing file.
+ * Passes back M2C_AST_FILE_STATUS_SUCCESS,  INVALID_REFERENCE if flat or path
+ * is NULL,  or IO_ERROR if the file could not be written.
+ * ----------------------------------------------------------------------- */
+
+static bool write_flat_file (m2c_ast_flat_t flat, FILE *file);
+
+void m2c_ast_write_file
+  (m2c_ast_flat_t flat, const char *path, m2c_ast_file_status_t *status) {
+  
+  FILE *file;
+  bool ok;
+  
+  if ((flat == NULL) || (path == NULL)) {
+    SET_STATUS(status, M2C_AST_FILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  file = fopen(path, "wb");
+  
+  if (file == NULL) {
+    SET_STATUS(status, M2C_AST_FILE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  ok = write_flat_file(flat, file);
+  
+  if ((fclose(file) != 0) || NOT(ok)) {
+    remove(path);
+    SET_STATUS(status, M2C_AST_FILE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_AST_FILE_STATUS_SUCCESS);
+  return;
+} /* end m2c_ast_write_file */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_read_file(path, status)
+ * --------------------------------------------------------------------------
+ * Reads a binary AST file at path and returns its tree as a flat tree,  or
+ * NULL on failure.  The word array of the tree is used in place within the
+ * file contents,  which are mapped into memory where mmap() is available.
+ * The file is validated before any of its nodes is handed out.  Passes back
+ * M2C_AST_FILE_STATUS_SUCCESS,  INVALID_REFERENCE if path is NULL,  IO_ERROR
+ * if the file could not be read,  INVALID_FILE if it is not an AST file of
+ * this build,  or ALLOCATION_FAILED.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_file_status_t read_file_data
+  (m2c_ast_flat_t flat, const char *path);
+
+static bool is_valid_file_header
+  (const m2c_ast_file_header_t *header, size_t file_size);
+
+static m2c_ast_file_status_t load_file_values
+  (m2c_ast_flat_t flat, const char *strings, uint32_t value_count,
+   uint32_t string_size);
+
+static bool is_valid_flat_tree (m2c_ast_flat_t flat);
+
+m2c_ast_flat_t m2c_ast_read_file
+  (const char *path, m2c_ast_file_status_t *status) {
+  
+  m2c_ast_file_header_t header;
+  m2c_ast_file_status_t read_status;
+  m2c_ast_flat_t flat;
+  const char *strings;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_AST_FILE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  flat = new_flat();
+  
+  if (flat == NULL) {
+    SET_STATUS(status, M2C_AST_FILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  read_status = read_file_data(flat, path);
+  
+  /* check header */
+  if (read_status == M2C_AST_FILE_STATUS_SUCCESS) {
+    if (flat->file_size >= AST_FILE_WORDS_OFFSET) {
+      memcpy(&header, flat->file_data, sizeof(m2c_ast_file_header_t));
+    } /* end if */
+    
+    if ((flat->file_size < AST_FILE_WORDS_OFFSET) ||
+        NOT(is_valid_file_header(&header, flat->file_size))) {
+      read_status = M2C_AST_FILE_STATUS_INVALID_FILE;
+    } /* end if */
+  } /* end if */
+  
+  /* use word array in place and intern values */
+  if (read_status == M2C_AST_FILE_STATUS_SUCCESS) {
+    flat->word =
+      (uint32_t *) ((char *) flat->file_data + AST_FILE_WORDS_OFFSET);
+    flat->word_count = header.word_count;
+    memcpy(flat->word, &flat, sizeof(m2c_ast_flat_t));
+    
+    strings = (const char *) &flat->word[header.word_count];
+    read_status = load_file_values
+      (flat, strings, header.value_count, header.string_size);
+  } /* end if */
+  
+  /* check nodes */
+  if (read_status == M2C_AST_FILE_STATUS_SUCCESS) {
+    flat->root = header.root;
+    
+    if (NOT(is_valid_flat_tree(flat)) ||
+        (flat->node_count != header.node_count)) {
+      read_status = M2C_AST_FILE_STATUS_INVALID_FILE;
+    } /* end if */
+  } /* end if */
+  
+  if (read_status != M2C_AST_FILE_STATUS_SUCCESS) {
+    m2c_ast_release_flat(flat);
+    SET_STATUS(status, read_status);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_AST_FILE_STATUS_SUCCESS);
+  return flat;
+} /* end m2c_ast_read_file */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_empty_node()
+ * --------------------------------------------------------------------------
+ * Returns the empty node singleton.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_empty_node (void) {
+  return (m2c_astnode_t) &m2c_ast_empty_node_struct;
+} /* end m2c_ast_empty_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node(node_type, subnode0, subnode1, subnode2, ...)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type, stores the subnodes of
+ * the argument list in the node and returns the node, or NULL on failure.
+ *
+ * pre-conditions:
+ * o  node_type must be a valid node type
+ * o  a NULL terminated argument list of valid ast nodes must be passed
+ *    and type and number of subnodes must match the given node type.
+ *
+ * post-conditions:
+ * o  newly allocated and populated ast node is returned
+ *
+ * error-conditions:
+ * o  if allocation fails, no node is allocated and NULL is returned
+ * o  if node_type is invalid, no node is allocated and NULL is returned
+ * o  if type and number of subnodes does not match the given node type,
+ *    no node is allocated and NULL is returned
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t alloc_node
+  (m2c_ast_nodetype_t node_type, unsigned short subnode_count);
+
+static m2c_astnode_t share_node (m2c_astnode_t node);
+
+m2c_astnode_t m2c_ast_new_node
+  (m2c_ast_nodetype_t node_type, ...) {
+  
+  m2c_astnode_t this_subnode, new_node;
+  unsigned short subnode_count, index;
+  va_list subnode_list;
+  
+  if (!AST_IS_NONTERMINAL_NODETYPE(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  /* count subnodes in arglist */
+  subnode_count = 0;
+  va_start(subnode_list, node_type);
+  this_subnode = va_arg(subnode_list, m2c_astnode_t);
+  while (this_subnode != NULL) {
+    subnode_count++;
+    this_subnode = va_arg(subnode_list, m2c_astnode_t);
+  } /* end while */
+  
+  va_end(subnode_list);
+  
+  /* verify subnode count */
+  if (!m2c_ast_is_legal_subnode_count(node_type, subnode_count)) {
+    return NULL;
+  } /* end if */
+  
+  if (node_type == AST_EMPTY) {
+    return (m2c_astnode_t) &m2c_ast_empty_node_struct;
+  } /* end if */
+  
+  /* allocate and initialise node */
+  new_node = alloc_node(node_type, subnode_count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* store subnodes in table */
+  va_start(subnode_list, node_type);
+  for (index = 0; index < subnode_count; index++) {
+    new_node->subnode_table[index].non_terminal =
+      va_arg(subnode_list, m2c_astnode_t);
+  } /* end for */
+  
+  va_end(subnode_list);
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node1(node_type, subnode0)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with one subnode and
+ * returns the node,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node1
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0) {
+  
+  m2c_astnode_t new_node;
+  
+  CHECK_FIXED_ARITY(node_type, 1);
+  
+  new_node = alloc_node(node_type, 1);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_node->subnode_table[0].non_terminal = subnode0;
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_node1 */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node2(node_type, subnode0, subnode1)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with two subnodes and
+ * returns the node,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node2
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0,
+   m2c_astnode_t subnode1) {
+  
+  m2c_astnode_t new_node;
+  
+  CHECK_FIXED_ARITY(node_type, 2);
+  
+  new_node = alloc_node(node_type, 2);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_node->subnode_table[0].non_terminal = subnode0;
+  new_node->subnode_table[1].non_terminal = subnode1;
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_node2 */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node3(node_type, subnode0, subnode1, subnode2)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with three subnodes and
+ * returns the node,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node3
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0,
+   m2c_astnode_t subnode1,
+   m2c_astnode_t subnode2) {
+  
+  m2c_astnode_t new_node;
+  
+  CHECK_FIXED_ARITY(node_type, 3);
+  
+  new_node = alloc_node(node_type, 3);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_node->subnode_table[0].non_terminal = subnode0;
+  new_node->subnode_table[1].non_terminal = subnode1;
+  new_node->subnode_table[2].non_terminal = subnode2;
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_node3 */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node4(node_type, subnode0, subnode1, subnode2, subnode3)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with four subnodes and
+ * returns the node,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node4
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0,
+   m2c_astnode_t subnode1,
+   m2c_astnode_t subnode2,
+   m2c_astnode_t subnode3) {
+  
+  m2c_astnode_t new_node;
+  
+  CHECK_FIXED_ARITY(node_type, 4);
+  
+  new_node = alloc_node(node_type, 4);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_node->subnode_table[0].non_terminal = subnode0;
+  new_node->subnode_table[1].non_terminal = subnode1;
+  new_node->subnode_table[2].non_terminal = subnode2;
+  new_node->subnode_table[3].non_terminal = subnode3;
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_node4 */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_list_node(node_type, node_list)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type, stores the subnodes of
+ * the given node list in the node and returns the node, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_list_node
+  (m2c_ast_nodetype_t node_type, m2c_fifo_t node_list) {
+  
+  m2c_astnode_t new_node;
+  unsigned short subnode_count, index;
+  
+  if (!AST_IS_NONTERMINAL_LIST_NODETYPE(node_type)) {
+    return NULL;
+  } /* end if */
+    
+  if (node_list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  subnode_count = m2c_fifo_entry_count(node_list);
+  
+  if (subnode_count == 0) {
+    return NULL;
+  } /* end if */
+  
+  /* allocate and initialise node */
+  new_node = alloc_node(node_type, subnode_count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* store subnodes in table */
+  for (index = 0; index < subnode_count; index++) {
+    new_node->subnode_table[index].non_terminal = m2c_fifo_dequeue(node_list);
+  } /* end for */
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_list_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_terminal_node(node_type, value)
+ * --------------------------------------------------------------------------
+ * Allocates a  new terminal node  of the given  node type,  stores the given
+ * value in the node and returns the node, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_terminal_node
+  (m2c_ast_nodetype_t node_type, intstr_t value) {
+  
+  m2c_astnode_t new_node;
+  
+  if (!AST_IS_TERMINAL_NODETYPE(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  /* verify subnode count */
+  if (!m2c_ast_is_legal_subnode_count(node_type, 1)) {
+    return NULL;
+  } /* end if */
+  
+  /* allocate and initialise node */
+  new_node = alloc_node(node_type, 1);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* store value */
+  new_node->subnode_table[0].terminal = value;
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_terminal_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_terminal_list_node(node_type, value_list)
+ * --------------------------------------------------------------------------
+ * Allocates a new terminal node of the given node type, stores the values of
+ * the given value list in the node and returns the node, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_terminal_list_node
+  (m2c_ast_nodetype_t node_type, m2c_fifo_t value_list) {
+  
+  m2c_astnode_t new_node;
+  unsigned short subnode_count, index;
+  
+  if (!AST_IS_TERMINAL_LIST_NODETYPE(node_type)) {
+    return NULL;
+  } /* end if */
+  
+  if (value_list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  subnode_count = m2c_fifo_entry_count(value_list);
+  
+  if (subnode_count == 0) {
+    return NULL;
+  } /* end if */
+  
+  /* allocate and initialise node */
+  new_node = alloc_node(node_type, subnode_count);
+  
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* store values in table */
+  for (index = 0; index < subnode_count; index++) {
+    new_node->subnode_table[index].terminal = m2c_fifo_dequeue(value_list);
+  } /* end for */
+  
+  return share_node(new_node);
+} /* end m2c_ast_new_terminal_list_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_nodetype(node)
+ * --------------------------------------------------------------------------
+ * Returns the node type of node,  or AST_INVALID if node is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_nodetype_t m2c_ast_nodetype (m2c_astnode_t node) {
+  
+  if (node == NULL) {
+    return AST_INVALID;
+  } /* end if */
+  
+  return node->node_type;  
+} /* end m2c_ast_nodetype */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_subnode_count(node)
+ * --------------------------------------------------------------------------
+ * Returns the number of subnodes or values of node. 
+ * ----------------------------------------------------------------------- */
+
+unsigned short m2c_ast_subnode_count (m2c_astnode_t node) {
+  
+  if (node == NULL) {
+    return 0;
+  } /* end if */
+  
+  return node->subnode_count;  
+} /* end m2c_ast_subnode_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_subnode_at_index(node, index)
+ * --------------------------------------------------------------------------
+ * Returns the subnode of node with the given index or NULL if no subnode of
+ * the given index is stored in node.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t flat_subnode (m2c_astnode_t node, unsigned short index);
+
+m2c_astnode_t m2c_ast_subnode_at_index
+  (m2c_astnode_t node, unsigned short index) {
+  
+  unsigned short subnode_count;
+  m2c_ast_nodetype_t node_type;
+  
+  if (node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  node_type = node->node_type;
+  subnode_count = node->subnode_count;
+  
+  if ((index < subnode_count)
+    && ((AST_IS_NONTERMINAL_NODETYPE(node_type))
+    || (AST_IS_NONTERMINAL_LIST_NODETYPE(node_type)))) {
+    
+    if ((node->flags & AST_FLAG_FLAT) != 0) {
+      return flat_subnode(node, index);
+    } /* end if */
+    
+    return node->subnode_table[index].non_terminal;
+  }
+  else /* invalid index or node type */ {
+    return NULL;
+  } /* end if */
+} /* end m2c_ast_subnode_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_value_at_index(terminal_node, index)
+ * --------------------------------------------------------------------------
+ * Returns the value stored at the given index in a terminal node,
+ * or NULL if the node does not store any value at the given index.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t flat_value (m2c_astnode_t node, unsigned short index);
+
+intstr_t m2c_ast_value_at_index
+  (m2c_astnode_t node, unsigned short index) {
+  
+  unsigned short value_count;
+  m2c_ast_nodetype_t node_type;
+  
+  if (node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  node_type = node->node_type;
+  value_count = node->subnode_count;
+  
+  if ((index < value_count)
+    && ((AST_IS_TERMINAL_NODETYPE(node_type))
+    || (AST_IS_TERMINAL_LIST_NODETYPE(node_type)))) {
+    
+    if ((node->flags & AST_FLAG_FLAT) != 0) {
+      return flat_value(node, index);
+    } /* end if */
+    
+    return node->subnode_table[index].terminal;
+  }
+  else /* invalid index or node type */ {
+    return NULL;
+  } /* end if */
+} /* end m2c_ast_value_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_replace_subnode(in_node, at_index, with_subnode)
+ * --------------------------------------------------------------------------
+ * Replaces a subnode and returns the replaced node,  or NULL on failure.
+ * Nodes of flat trees and shared nodes cannot be modified.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_replace_subnode
+  (m2c_astnode_t in_node, unsigned short at_index, m2c_astnode_t with_subnode) {
+  
+  m2c_astnode_t replaced_node;
+  m2c_ast_nodetype_t node_type;
+
+  if (in_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  node_type = in_node->node_type;
+  
+  if ((AST_IS_TERMINAL_NODETYPE(node_type))
+    || (AST_IS_TERMINAL_LIST_NODETYPE(node_type))
+    || (at_index >= in_node->subnode_count)
+    || ((in_node->flags & AST_FLAGS_IMMUTABLE) != 0)) {
+    return NULL;
+  } /* end if */
+  
+  replaced_node = in_node->subnode_table[at_index].non_terminal;
+  in_node->subnode_table[at_index].non_terminal = with_subnode;
+  
+  return replaced_node;
+} /* end m2c_ast_replace_subnode */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_replace_value(in_node, at_index, with_value)
+ * --------------------------------------------------------------------------
+ * Replaces a value and returns the replaced value,  or NULL on failure.
+ * Nodes of flat trees and shared nodes cannot be modified.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ast_replace_value
+  (m2c_astnode_t in_node, unsigned short at_index, intstr_t with_value) {
+  
+  intstr_t replaced_value;
+  m2c_ast_nodetype_t node_type;
+
+  if (in_node == NULL) {
+    return NULL;
+  } /* end if */
+  
+  node_type = in_node->node_type;
+  
+  if ((AST_IS_NONTERMINAL_NODETYPE(node_type))
+    || (AST_IS_NONTERMINAL_LIST_NODETYPE(node_type))
+    || (at_index >= in_node->subnode_count)
+    || ((in_node->flags & AST_FLAGS_IMMUTABLE) != 0)) {
+    return NULL;
+  } /* end if */
+  
+  replaced_value = in_node->subnode_table[at_index].terminal;
+  in_node->subnode_table[at_index].terminal = with_value;
+  
+  return replaced_value;
+} /* end m2c_ast_replace_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_release_node(node)
+ * --------------------------------------------------------------------------
+ * Deallocates node.  Has no effect on the empty node singleton,  on nodes
+ * allocated from a region and on nodes of flat trees,  which are deallocated
+ * with their region or tree.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_node (m2c_astnode_t node) {
+  
+  if ((node == NULL) || (node == &m2c_ast_empty_node_struct) ||
+      ((node->flags & (AST_FLAG_IN_REGION | AST_FLAG_FLAT)) != 0)) {
+    return;
+  } /* end if */
+  
+  m2c_mem_free(M2C_MEM_AST, node);
+  
+  /* TO DO: recursively deallocate sub-nodes */
+  
+} /* end m2c_ast_release_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_visit(root, pre, post, context)
+ * --------------------------------------------------------------------------
+ * Traverses the tree rooted at root depth-first with an explicit stack,
+ * calling pre and post for each node.  Returns false if traversal stopped
+ * early or the stack could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+static bool reserve (void **array, uint32_t *capacity,
+  uint32_t needed, size_t elem_size);
+
+bool m2c_ast_visit
+  (m2c_astnode_t root,
+   m2c_ast_visitor_f pre, m2c_ast_visitor_f post, void *context) {
+  
+  m2c_ast_frame_t *frame;
+  uint32_t depth, capacity;
+  m2c_ast_visit_action_t action;
+  m2c_astnode_t node, subnode;
+  bool ok;
+  
+  if (root == NULL) {
+    return true;
+  } /* end if */
+  
+  frame = NULL;
+  depth = 0;
+  capacity = 0;
+  action = M2C_AST_VISIT_CONTINUE;
+  
+  /* visit root and push it unless its subtree is skipped */
+  ok = reserve((void **) &frame, &capacity, 1, sizeof(m2c_ast_frame_t));
+  subnode = root;
+  
+  while (ok && (subnode != NULL)) {
+    if (pre != NULL) {
+      action = pre(subnode, context);
+    } /* end if */
+    
+    if (action == M2C_AST_VISIT_STOP) {
+      ok = false;
+    }
+    else if (action == M2C_AST_VISIT_SKIP) {
+      action = M2C_AST_VISIT_CONTINUE;
+    }
+    else /* continue */ {
+      ok = reserve((void **) &frame, &capacity,
+        depth + 1, sizeof(m2c_ast_frame_t));
+      if (ok) {
+        frame[depth].node = subnode;
+        frame[depth].next = 0;
+        depth++;
+      } /* end if */
+    } /* end if */
+    
+    /* find the next subnode to descend into,  leaving finished nodes */
+    subnode = NULL;
+    while (ok && (subnode == NULL) && (depth > 0)) {
+      node = frame[depth - 1].node;
+      
+      if (NOT(IS_TERMINAL_OR_TERMINAL_LIST(node->node_type)) &&
+          (frame[depth - 1].next < node->subnode_count)) {
+        subnode = m2c_ast_subnode_at_index(node, frame[depth - 1].next);
+        frame[depth - 1].next++;
+      }
+      else {
+        depth--;
+        if ((post != NULL) && (post(node, context) == M2C_AST_VISIT_STOP)) {
+          ok = false;
+        } /* end if */
+      } /* end if */
+    } /* end while */
+  } /* end while */
+  
+  m2c_mem_free(M2C_MEM_AST, frame);
+  
+  return ok;
+} /* end m2c_ast_visit */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_flat()
+ * --------------------------------------------------------------------------
+ * Returns a new empty flat tree record,  or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_flat_t new_flat (void) {
+  
+  m2c_ast_flat_t flat;
+  
+  flat = m2c_mem_alloc(M2C_MEM_AST, sizeof(m2c_ast_flat_struct_t));
+  
+  if (flat == NULL) {
+    return NULL;
+  } /* end if */
+  
+  flat->word = NULL;
+  flat->word_count = 0;
+  flat->word_capacity = 0;
+  flat->value = NULL;
+  flat->value_count = 0;
+  flat->value_capacity = 0;
+  flat->node_count = 0;
+  flat->root = 0;
+  flat->file_data = NULL;
+  flat->file_size = 0;
+  flat->is_mapped = false;
+  
+  return flat;
+} /* end new_flat */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_flat_file(flat, file)
+ * --------------------------------------------------------------------------
+ * Writes header,  word array and value records of flat to file.  Returns
+ * false if any write failed.
+ * ----------------------------------------------------------------------- */
+
+static bool write_flat_file (m2c_ast_flat_t flat, FILE *file) {
+  
+  static const uint32_t zero[FLAT_BASE_WORDS] = { 0 };
+  m2c_ast_file_header_t header;
+  uint32_t index, length;
+  size_t count;
+  
+  /* header */
+  memset(&header, 0, sizeof(m2c_ast_file_header_t));
+  memcpy(header.magic, AST_FILE_MAGIC, sizeof(AST_FILE_MAGIC));
+  header.version = M2C_AST_FILE_VERSION;
+  header.byte_order = AST_FILE_BYTE_ORDER;
+  header.layout = AST_FILE_LAYOUT;
+  header.node_count = flat->node_count;
+  header.root = flat->root;
+  header.word_count = flat->word_count;
+  header.value_count = flat->value_count;
+  
+  for (index = 0; index < flat->value_count; index++) {
+    header.string_size = header.string_size + sizeof(uint32_t);
+    if (flat->value[index] != NULL) {
+      header.string_size =
+        header.string_size + intstr_length(flat->value[index]);
+    } /* end if */
+  } /* end for */
+  
+  if (fwrite(&header, sizeof(m2c_ast_file_header_t), 1, file) != 1) {
+    return false;
+  } /* end if */
+  
+  for (count = sizeof(m2c_ast_file_header_t);
+       count < AST_FILE_WORDS_OFFSET; count++) {
+    if (fputc(0, file) == EOF) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  /* word array,  without the back pointer */
+  count = flat->word_count - FLAT_BASE_WORDS;
+  
+  if ((fwrite(zero, sizeof(uint32_t), FLAT_BASE_WORDS, file)
+       != FLAT_BASE_WORDS) ||
+      (fwrite(&flat->word[FLAT_BASE_WORDS], sizeof(uint32_t), count, file)
+       != count)) {
+    return false;
+  } /* end if */
+  
+  /* value records */
+  for (index = 0; index < flat->value_count; index++) {
+    if (flat->value[index] == NULL) {
+      length = AST_FILE_NULL_VALUE;
+    }
+    else {
+      length = intstr_length(flat->value[index]);
+    } /* end if */
+    
+    if (fwrite(&length, sizeof(uint32_t), 1, file) != 1) {
+      return false;
+    } /* end if */
+    
+    if ((length != AST_FILE_NULL_VALUE) && (length > 0) &&
+        (fwrite(intstr_char_ptr(flat->value[index]), 1, length, file)
+         != length)) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end write_flat_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_file_data(flat, path)
+ * --------------------------------------------------------------------------
+ * Maps or reads the contents of the file at path into memory and records
+ * them in fields file_data,  file_size and is_mapped of flat.  The mapping
+ * is private and writable,  so that the back pointer at the base of the
+ * word array can be stored without modifying the file.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_file_status_t read_file_data
+  (m2c_ast_flat_t flat, const char *path) {
+  
+#if (M2C_AST_FILE_USE_MMAP)
+  struct stat info;
+  void *map;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return M2C_AST_FILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) || NOT(S_ISREG(info.st_mode))) {
+    close(fd);
+    return M2C_AST_FILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) info.st_size < AST_FILE_WORDS_OFFSET) {
+    close(fd);
+    return M2C_AST_FILE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  map = mmap(NULL, (size_t) info.st_size,
+    PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    return M2C_AST_FILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  flat->file_data = map;
+  flat->file_size = (size_t) info.st_size;
+  flat->is_mapped = true;
+  
+  return M2C_AST_FILE_STATUS_SUCCESS;
+#else
+  FILE *file;
+  void *data;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return M2C_AST_FILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return M2C_AST_FILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) size < AST_FILE_WORDS_OFFSET) {
+    fclose(file);
+    return M2C_AST_FILE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* malloc'd storage is suitably aligned for the word array */
+  data = m2c_mem_alloc(M2C_MEM_AST, (size_t) size);
+  
+  if (data == NULL) {
+    fclose(file);
+    return M2C_AST_FILE_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) size, file) != (size_t) size) {
+    m2c_mem_free(M2C_MEM_AST, data);
+    fclose(file);
+    return M2C_AST_FILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  fclose(file);
+  
+  flat->file_data = data;
+  flat->file_size = (size_t) size;
+  flat->is_mapped = false;
+  
+  return M2C_AST_FILE_STATUS_SUCCESS;
+#endif
+} /* end read_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_file_data(flat)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates the file contents of flat.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_ast_flat_t flat) {
+  
+#if (M2C_AST_FILE_USE_MMAP)
+  if (flat->is_mapped) {
+    munmap(flat->file_data, flat->file_size);
+  }
+  else {
+    m2c_mem_free(M2C_MEM_AST, flat->file_data);
+  } /* end if */
+#else
+  m2c_mem_free(M2C_MEM_AST, flat->file_data);
+#endif
+  
+  flat->file_data = NULL;
+  flat->file_size = 0;
+  
+  return;
+} /* end release_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_file_header(header, file_size)
+ * --------------------------------------------------------------------------
+ * Returns true if header is the header of an AST file written by a build of
+ * the same format version and node layout,  and its sections fit file_size.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_file_header
+  (const m2c_ast_file_header_t *header, size_t file_size) {
+  
+  uint64_t expected_size;
+  
+  if ((memcmp(header->magic, AST_FILE_MAGIC, sizeof(AST_FILE_MAGIC)) != 0) ||
+      (header->version != M2C_AST_FILE_VERSION) ||
+      (header->byte_order != AST_FILE_BYTE_ORDER) ||
+      (header->layout != AST_FILE_LAYOUT) ||
+      (header->word_count < FLAT_BASE_WORDS) ||
+      (header->root < FLAT_BASE_WORDS) ||
+      (header->root >= header->word_count)) {
+    return false;
+  } /* end if */
+  
+  expected_size = (uint64_t) AST_FILE_WORDS_OFFSET +
+    (uint64_t) header->word_count * sizeof(uint32_t) +
+    (uint64_t) header->string_size;
+  
+  return (expected_size == (uint64_t) file_size);
+} /* end is_valid_file_header */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_new_list_node(node_type, node_list)
+ * private function load_file_values(flat, strings, value_count, string_size)
  * --------------------------------------------------------------------------
- * Allocates a new branch node of the given node type, stores the subnodes of
- * the given node list in the node and returns the node, or NULL on failure.
+ * Interns the value_count value records at strings  and stores them in the
+ * value table of flat.  Fails with INVALID_FILE if the records do not fill
+ * exactly string_size bytes or hold characters that cannot be interned.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_new_list_node
-  (m2c_ast_nodetype_t node_type, m2c_fifo_t node_list) {
+static m2c_ast_file_status_t load_file_values
+  (m2c_ast_flat_t flat, const char *strings, uint32_t value_count,
+   uint32_t string_size) {
   
-  m2c_astnode_t new_node;
-  unsigned short subnode_count, index;
+  intstr_status_t intstr_status;
+  uint32_t offset, length;
+  intstr_t value;
   
-  if (!AST_IS_NONTERMINAL_LIST_NODETYPE(node_type)) {
-    return NULL;
+  if (value_count > 0) {
+    flat->value = m2c_mem_alloc(M2C_MEM_AST, value_count * sizeof(intstr_t));
+    
+    if (flat->value == NULL) {
+      return M2C_AST_FILE_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
+    flat->value_capacity = value_count;
   } /* end if */
+  
+  offset = 0;
+  while (flat->value_count < value_count) {
+    if (string_size - offset < sizeof(uint32_t)) {
+      return M2C_AST_FILE_STATUS_INVALID_FILE;
+    } /* end if */
     
-  if (node_list == NULL) {
-    return NULL;
+    memcpy(&length, &strings[offset], sizeof(uint32_t));
+    offset = offset + sizeof(uint32_t);
+    
+    if (length == AST_FILE_NULL_VALUE) {
+      value = NULL;
+    }
+    else if (length > string_size - offset) {
+      return M2C_AST_FILE_STATUS_INVALID_FILE;
+    }
+    else {
+      value = intstr_for_slice(strings, offset, length, &intstr_status);
+      
+      if (value == NULL) {
+        if (intstr_status == INTSTR_STATUS_ALLOCATION_FAILED) {
+          return M2C_AST_FILE_STATUS_ALLOCATION_FAILED;
+        } /* end if */
+        return M2C_AST_FILE_STATUS_INVALID_FILE;
+      } /* end if */
+      
+      offset = offset + length;
+    } /* end if */
+    
+    flat->value[flat->value_count] = value;
+    flat->value_count++;
+  } /* end while */
+  
+  if (offset != string_size) {
+    return M2C_AST_FILE_STATUS_INVALID_FILE;
   } /* end if */
   
-  subnode_count = m2c_fifo_entry_count(node_list);
+  return M2C_AST_FILE_STATUS_SUCCESS;
+} /* end load_file_values */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_flat_tree(flat)
+ * --------------------------------------------------------------------------
+ * Walks the word array of flat  and returns true if it consists of nodes of
+ * valid node types in post-order,  every subnode distance leads back to the
+ * start of an earlier node,  every value index is within the value table and
+ * the root is the start of a node.  Counts the nodes in field node_count.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_flat_tree (m2c_ast_flat_t flat) {
   
-  if (subnode_count == 0) {
-    return NULL;
+  const uint32_t *table;
+  m2c_astnode_t node;
+  uint32_t pos, words;
+  unsigned short index;
+  bool *is_node_start, ok;
+  
+  is_node_start = m2c_mem_calloc(M2C_MEM_AST, flat->word_count, sizeof(bool));
+  
+  if (is_node_start == NULL) {
+    return false;
   } /* end if */
   
-  /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + subnode_count * sizeof(m2c_astnode_t));
+  ok = true;
+  flat->node_count = 0;
+  pos = FLAT_BASE_WORDS;
   
-  /* initialise fields */
-  new_node->node_type = node_type;
-  new_node->subnode_count = subnode_count;
+  while (ok && (pos < flat->word_count)) {
+    if (flat->word_count - pos < FLAT_HEADER_WORDS) {
+      ok = false;
+      break;
+    } /* end if */
+    
+    node = FLAT_NODE(flat, pos);
+    
+    if ((node->node_type <= AST_INVALID) ||
+        (node->node_type >= AST_END_MARK) ||
+        (node->flags != AST_FLAG_FLAT)) {
+      ok = false;
+      break;
+    } /* end if */
+    
+    words = flat_node_words(node);
+    
+    if (words > flat->word_count - pos) {
+      ok = false;
+      break;
+    } /* end if */
+    
+    table = FLAT_TABLE(node);
+    
+    if (IS_TERMINAL_OR_TERMINAL_LIST(node->node_type)) {
+      ok = (table[0] == pos);
+      for (index = 0; ok && (index < node->subnode_count); index++) {
+        ok = (table[index + 1] < flat->value_count);
+      } /* end for */
+    }
+    else {
+      for (index = 0; ok && (index < node->subnode_count); index++) {
+        ok = (table[index] == FLAT_EMPTY_DISTANCE) ||
+             (table[index] == FLAT_NULL_DISTANCE) ||
+             ((table[index] <= pos - FLAT_BASE_WORDS) &&
+              (is_node_start[pos - table[index]]));
+      } /* end for */
+    } /* end if */
+    
+    is_node_start[pos] = true;
+    flat->node_count++;
+    pos = pos + words;
+  } /* end while */
   
-  /* store subnodes in table */
-  for (index = 0; index < subnode_count; index++) {
-    new_node->subnode_table[index].non_terminal = m2c_fifo_dequeue(node_list);
-  } /* end for */
+  ok = ok && is_node_start[flat->root];
+  m2c_mem_free(M2C_MEM_AST, is_node_start);
   
-  return new_node;
-} /* end m2c_ast_new_list_node */
+  return ok;
+} /* end is_valid_flat_tree */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_new_terminal_node(node_type, value)
+ * private function flat_subnode(node, index)
  * --------------------------------------------------------------------------
- * Allocates a  new terminal node  of the given  node type,  stores the given
- * value in the node and returns the node, or NULL on failure.
+ * Returns the subnode with index of non-terminal node of a flat tree.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_new_terminal_node
-  (m2c_ast_nodetype_t type, intstr_t value) {
+static m2c_astnode_t flat_subnode (m2c_astnode_t node, unsigned short index) {
   
-  m2c_astnode_t new_node;
+  uint32_t distance;
   
-  if (!AST_IS_TERMINAL_NODETYPE(node_type)) {
-    return NULL;
-  } /* end if */
+  distance = FLAT_TABLE(node)[index];
   
-  /* verify subnode count */
-  if (!m2c_ast_is_legal_subnode_count(node_type, 1)) {
+  if (distance == FLAT_EMPTY_DISTANCE) {
+    return m2c_ast_empty_node();
+  }
+  else if (distance == FLAT_NULL_DISTANCE) {
     return NULL;
   } /* end if */
   
-  /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + sizeof(m2c_astnode_t));
+  return (m2c_astnode_t) (((uint32_t *) node) - distance);
+} /* end flat_subnode */
+
+
+/* --------------------------------------------------------------------------
+ * private function flat_value(node, index)
+ * --------------------------------------------------------------------------
+ * Returns the value with index of terminal node of a flat tree.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t flat_value (m2c_astnode_t node, unsigned short index) {
   
-  /* initialise fields */
-  new_node->node_type = node_type;
-  new_node->subnode_count = 1;
+  const uint32_t *table;
+  m2c_ast_flat_t flat;
   
-  /* store value */
-  new_node->subnode_table[0].terminal = value;
+  table = FLAT_TABLE(node);
+  memcpy(&flat, ((const uint32_t *) node) - table[0], sizeof(m2c_ast_flat_t));
   
-  return new_node;
-} /* end m2c_ast_new_terminal_node */
+  return flat->value[table[index + 1]];
+} /* end flat_value */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_new_terminal_list_node(node_type, value_list)
+ * private function flat_node_words(node)
  * --------------------------------------------------------------------------
- * Allocates a new terminal node of the given node type, stores the values of
- * the given value list in the node and returns the node, or NULL on failure.
+ * Returns the number of words node occupies in a flat tree:  the node header
+ * and one word per subnode or value,  plus the base distance for terminal
+ * nodes,  rounded up to keep nodes aligned like their header.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_new_terminal_list_node
-  (m2c_ast_nodetype_t node_type, m2c_fifo_t value_list) {
+static uint32_t flat_node_words (m2c_astnode_t node) {
   
-  m2c_astnode_t new_node;
-  unsigned short subnode_count, index;
+  uint32_t words;
   
-  if (!AST_IS_TERMINAL_LIST_NODETYPE(node_type)) {
-    return NULL;
-  } /* end if */
+  words = FLAT_HEADER_WORDS + node->subnode_count;
   
-  if (value_list == NULL) {
-    return NULL;
+  if (IS_TERMINAL_OR_TERMINAL_LIST(node->node_type)) {
+    words++;
   } /* end if */
   
-  subnode_count = m2c_fifo_entry_count(value_list);
+  return (words + FLAT_NODE_ALIGN_WORDS - 1) & ~(FLAT_NODE_ALIGN_WORDS - 1);
+} /* end flat_node_words */
+
+
+/* --------------------------------------------------------------------------
+ * private function flatten_tree(flat, root)
+ * --------------------------------------------------------------------------
+ * Appends the nodes of the tree rooted at root to flat in post-order,  so
+ * that every subnode precedes its parent.  Uses an explicit stack instead
+ * of recursion.  Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool emit_flat_node
+  (m2c_ast_flat_t flat, m2c_astnode_t node,
+   const uint32_t *subnode_pos, uint32_t *pos);
+
+static bool flatten_tree (m2c_ast_flat_t flat, m2c_astnode_t root) {
   
-  if (subnode_count == 0) {
-    return NULL;
+  m2c_ast_frame_t *frame;
+  uint32_t *done, frame_depth, frame_capacity, done_depth, done_capacity;
+  uint32_t pos;
+  m2c_astnode_t node, subnode;
+  bool ok;
+  
+  frame = NULL;
+  done = NULL;
+  frame_depth = 0;
+  frame_capacity = 0;
+  done_depth = 0;
+  done_capacity = 0;
+  
+  /* the first words of the array hold a pointer back to flat */
+  ok = reserve((void **) &flat->word, &flat->word_capacity,
+    FLAT_BASE_WORDS, sizeof(uint32_t));
+  
+  if (ok) {
+    memcpy(flat->word, &flat, sizeof(m2c_ast_flat_t));
+    flat->word_count = FLAT_BASE_WORDS;
+    ok = reserve((void **) &frame, &frame_capacity, 1, sizeof(m2c_ast_frame_t));
   } /* end if */
   
-  /* allocate node */
-  new_node = malloc
-    (sizeof(m2c_astnode_struct_t) + subnode_count * sizeof(m2c_astnode_t));
+  if (ok) {
+    frame[0].node = root;
+    frame[0].next = 0;
+    frame_depth = 1;
+  } /* end if */
   
-  /* initialise fields */
-  new_node->node_type = node_type;
-  new_node->subnode_count = subnode_count;
+  while (ok && (frame_depth > 0)) {
+    node = frame[frame_depth - 1].node;
+    
+    /* descend into the next subnode of a non-terminal node */
+    if (NOT(IS_TERMINAL_OR_TERMINAL_LIST(node->node_type)) &&
+        (frame[frame_depth - 1].next < node->subnode_count)) {
+      subnode = node->subnode_table[frame[frame_depth - 1].next].non_terminal;
+      frame[frame_depth - 1].next++;
+      
+      /* NULL and the empty node are encoded without a node of their own */
+      if ((subnode == NULL) || (subnode == m2c_ast_empty_node())) {
+        ok = reserve((void **) &done, &done_capacity,
+          done_depth + 1, sizeof(uint32_t));
+        if (ok) {
+          done[done_depth] =
+            (subnode == NULL) ? FLAT_NULL_DISTANCE : FLAT_EMPTY_DISTANCE;
+          done_depth++;
+        } /* end if */
+      }
+      else {
+        ok = reserve((void **) &frame, &frame_capacity,
+          frame_depth + 1, sizeof(m2c_ast_frame_t));
+        if (ok) {
+          frame[frame_depth].node = subnode;
+          frame[frame_depth].next = 0;
+          frame_depth++;
+        } /* end if */
+      } /* end if */
+    }
+    /* all subnodes emitted, emit node itself */
+    else {
+      if (IS_TERMINAL_OR_TERMINAL_LIST(node->node_type)) {
+        ok = emit_flat_node(flat, node, NULL, &pos);
+      }
+      else {
+        done_depth = done_depth - node->subnode_count;
+        ok = emit_flat_node(flat, node, &done[done_depth], &pos);
+      } /* end if */
+      
+      if (ok) {
+        ok = reserve((void **) &done, &done_capacity,
+          done_depth + 1, sizeof(uint32_t));
+      } /* end if */
+      
+      if (ok) {
+        done[done_depth] = pos;
+        done_depth++;
+        frame_depth--;
+      } /* end if */
+    } /* end if */
+  } /* end while */
   
-  /* store values in table */
-  for (index = 0; index < subnode_count; index++) {
-    new_node->subnode_table[index].terminal = m2c_fifo_dequeue(value_list);
-  } /* end for */
+  if (ok) {
+    flat->root = done[0];
+  } /* end if */
   
-  return new_node;
-} /* end m2c_ast_new_terminal_list_node */
+  m2c_mem_free(M2C_MEM_AST, frame);
+  m2c_mem_free(M2C_MEM_AST, done);
+  
+  return ok;
+} /* end flatten_tree */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_nodetype(node)
+ * private function emit_flat_node(flat, node, subnode_pos, pos)
  * --------------------------------------------------------------------------
- * Returns the node type of node,  or AST_INVALID if node is NULL.
+ * Appends a flat copy of node to flat and passes its word position in pos.
+ * For non-terminal nodes,  subnode_pos holds the positions of the subnodes,
+ * or an encoding for NULL and the empty node.  Values of terminal nodes are
+ * appended to the value table of flat.  Returns false if allocation failed.
  * ----------------------------------------------------------------------- */
 
-m2c_ast_nodetype_t m2c_ast_nodetype (m2c_astnode_t node) {
+static bool emit_flat_node
+  (m2c_ast_flat_t flat, m2c_astnode_t node,
+   const uint32_t *subnode_pos, uint32_t *pos) {
   
-  if (node == NULL) {
-    return AST_INVALID;
+  m2c_astnode_struct_t header;
+  uint32_t words, *table;
+  unsigned short index;
+  
+  words = flat_node_words(node);
+  
+  if (NOT(reserve((void **) &flat->word, &flat->word_capacity,
+      flat->word_count + words, sizeof(uint32_t)))) {
+    return false;
   } /* end if */
   
-  return node->node_type;  
-} /* end m2c_ast_nodetype */
+  *pos = flat->word_count;
+  memset(&flat->word[*pos], 0, words * sizeof(uint32_t));
+  
+  /* header */
+  header.node_type = node->node_type;
+  header.subnode_count = node->subnode_count;
+  header.flags = AST_FLAG_FLAT;
+  memcpy(&flat->word[*pos], &header, FLAT_HEADER_WORDS * sizeof(uint32_t));
+  table = &flat->word[*pos + FLAT_HEADER_WORDS];
+  
+  if (IS_TERMINAL_OR_TERMINAL_LIST(node->node_type)) {
+    /* distance back to the array base, then value indices */
+    if (NOT(reserve((void **) &flat->value, &flat->value_capacity,
+        flat->value_count + node->subnode_count, sizeof(intstr_t)))) {
+      return false;
+    } /* end if */
+    
+    table[0] = *pos;
+    for (index = 0; index < node->subnode_count; index++) {
+      flat->value[flat->value_count] = node->subnode_table[index].terminal;
+      table[index + 1] = flat->value_count;
+      flat->value_count++;
+    } /* end for */
+  }
+  else {
+    /* distances back to the subnodes */
+    for (index = 0; index < node->subnode_count; index++) {
+      if ((subnode_pos[index] == FLAT_NULL_DISTANCE) ||
+          (subnode_pos[index] == FLAT_EMPTY_DISTANCE)) {
+        table[index] = subnode_pos[index];
+      }
+      else {
+        table[index] = *pos - subnode_pos[index];
+      } /* end if */
+    } /* end for */
+  } /* end if */
+  
+  flat->word_count = flat->word_count + words;
+  flat->node_count++;
+  
+  return true;
+} /* end emit_flat_node */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_subnode_count(node)
+ * private function reserve(array, capacity, needed, elem_size)
  * --------------------------------------------------------------------------
- * Returns the number of subnodes or values of node. 
+ * Grows array to hold at least needed elements of elem_size bytes,  doubling
+ * its capacity.  Returns false if allocation failed.
  * ----------------------------------------------------------------------- */
 
-unsigned short m2c_ast_subnode_count (m2c_astnode_t node) {
+static bool reserve (void **array, uint32_t *capacity,
+  uint32_t needed, size_t elem_size) {
   
-  if (node == NULL) {
-    return 0;
+  uint32_t new_capacity;
+  void *new_array;
+  
+  if (needed <= *capacity) {
+    return true;
   } /* end if */
   
-  return node->subnode_count;  
-} /* end m2c_ast_subnode_count */
+  new_capacity = (*capacity == 0) ? 64 : *capacity;
+  while (new_capacity < needed) {
+    new_capacity = 2 * new_capacity;
+  } /* end while */
+  
+  new_array = m2c_mem_realloc(M2C_MEM_AST, *array, new_capacity * elem_size);
+  
+  if (new_array == NULL) {
+    return false;
+  } /* end if */
+  
+  *array = new_array;
+  *capacity = new_capacity;
+  
+  return true;
+} /* end reserve */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_subnode_at_index(node, index)
+ * private function alloc_node(node_type, subnode_count)
  * --------------------------------------------------------------------------
- * Returns the subnode of node with the given index or NULL if no subnode of
- * the given index is stored in node.
+ * Allocates a node with room for subnode_count subnodes from the current
+ * region if one is set,  otherwise by malloc,  and initialises its type,
+ * count and flags.  Returns NULL if allocation failed.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_subnode_at_index
-  (m2c_astnode_t node, unsigned short index) {
+static void *region_alloc (m2c_ast_region_t region, size_t size);
+
+static m2c_astnode_t alloc_node
+  (m2c_ast_nodetype_t node_type, unsigned short subnode_count) {
   
-  unsigned short subnode_count;
-  m2c_ast_nodetype_t node_type;
+  m2c_astnode_t new_node;
+  size_t size;
   
-  if (node == NULL) {
-    return NULL;
+  size = sizeof(m2c_astnode_struct_t) +
+    subnode_count * sizeof(m2c_astnode_variant);
+  
+  if (current_region != NULL) {
+    new_node = region_alloc(current_region, size);
+  }
+  else {
+    new_node = m2c_mem_alloc(M2C_MEM_AST, size);
   } /* end if */
   
-  node_type = node->node_type;
-  subnode_count = node->subnode_count;
+  if (new_node == NULL) {
+    return NULL;
+  } /* end if */
   
-  if ((index < subnode_count)
-    && ((AST_IS_NONTERMINAL_NODETYPE(node_type))
-    || (AST_IS_NONTERMINAL_LIST_NODETYPE(node_type)))) {
+  new_node->node_type = node_type;
+  new_node->subnode_count = subnode_count;
   
-    return node->subnode_table[index].non_terminal;
+  if (current_region != NULL) {
+    new_node->flags = AST_FLAG_IN_REGION;
+    current_region->node_count++;
   }
-  else /* invalid index or node type */ {
-    return NULL;
+  else {
+    new_node->flags = AST_FLAG_NONE;
   } /* end if */
-} /* end m2c_ast_subnode_at_index */
+  
+  return new_node;
+} /* end alloc_node */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_value_at_index(terminal_node, index)
+ * private function region_alloc(region, size)
  * --------------------------------------------------------------------------
- * Returns the value stored at the given index in a terminal node,
- * or NULL if the node does not store any value at the given index.
+ * Allocates size bytes from region.  Requests larger than the block size of
+ * region are given a block of their own behind the current block.  Returns
+ * NULL if allocation failed.
  * ----------------------------------------------------------------------- */
 
-intstr_t m2c_ast_value_at_index
-  (m2c_astnode_t node, unsigned short index) {
+static void *region_alloc (m2c_ast_region_t region, size_t size) {
   
-  unsigned short value_count;
-  m2c_ast_nodetype_t node_type;
+  m2c_ast_region_block_t block;
+  size_t block_size;
+  void *ptr;
   
-  if (node == NULL) {
-    return NULL;
-  } /* end if */
+  size = REGION_ROUND_UP(size);
+  block = region->block;
   
-  node_type = node->node_type;
-  value_count = node->subnode_count;
+  /* start a new block if there is none or the current one is exhausted */
+  if ((block == NULL) || (block->used + size > block->size)) {
+    
+    if (size > region->block_size) {
+      block_size = size;
+    }
+    else {
+      block_size = region->block_size;
+    } /* end if */
+    
+    block = m2c_mem_alloc(M2C_MEM_AST,
+      sizeof(m2c_ast_region_block_s) + block_size);
+    
+    if (block == NULL) {
+      return NULL;
+    } /* end if */
+    
+    block->size = block_size;
+    block->used = 0;
+    
+    /* oversized blocks go behind the current one */
+    if ((size > region->block_size) && (region->block != NULL)) {
+      block->prev = region->block->prev;
+      region->block->prev = block;
+    }
+    else {
+      block->prev = region->block;
+      region->block = block;
+    } /* end if */
+  } /* end if */
   
-  if ((index < value_count)
-    && ((AST_IS_TERMINAL_NODETYPE(node_type))
-    || (AST_IS_TERMINAL_LIST_NODETYPE(node_type)))) {
+  ptr = &block->storage[block->used];
+  block->used = block->used + size;
   
-    return node->subnode_table[index].terminal;
-  }
-  else /* invalid index or node type */ {
-    return NULL;
-  } /* end if */
-} /* end m2c_ast_value_at_index */
+  return ptr;
+} /* end region_alloc */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_replace_subnode(in_node, at_index, with_subnode)
+ * private function share_node(node)
  * --------------------------------------------------------------------------
- * Replaces a subnode and returns the replaced node,  or NULL on failure.
+ * If node has been allocated from the current region  and hash-consing is
+ * enabled for it,  looks up a canonical node of the same node type and with
+ * the same subnodes or values.  If one is found,  node is discarded and the
+ * canonical node is returned,  otherwise node becomes the canonical node and
+ * is returned.  If the table cannot grow,  node is returned unshared.
  * ----------------------------------------------------------------------- */
 
-m2c_astnode_t m2c_ast_replace_subnode
-  (m2c_astnode_t in_node, unsigned short at_index, m2c_astnode_t with_subnode) {
-  
-  m2c_astnode_t replaced_node;
-  m2c_ast_nodetype_t node_type;
+static uint32_t node_hash (m2c_astnode_t node);
 
-  if (in_node == NULL)
-    return NULL;
-  } /* end if */
+static bool nodes_equal (m2c_astnode_t node1, m2c_astnode_t node2);
+
+static bool grow_shared_table (m2c_ast_region_t region);
+
+static void discard_node (m2c_ast_region_t region, m2c_astnode_t node);
+
+static m2c_astnode_t share_node (m2c_astnode_t node) {
   
-  node_type = in_node->node_type;
+  m2c_ast_region_t region;
+  size_t index, mask;
   
-  if ((AST_IS_TERMINAL_NODETYPE(node_type))
-    || (AST_IS_TERMINAL_LIST_NODETYPE(node_type))) {
-    return NULL;
+  region = current_region;
+  
+  if ((region == NULL) || NOT(region->hash_consing)) {
+    return node;
   } /* end if */
   
-  replaced_node = in_node->subnode_table[at_index].non_terminal;
-  in_node->subnode_table[at_index].non_terminal = with_subnode;
+  /* keep load factor at or below three quarters */
+  if (((region->shared_count + 1) * 4 > region->shared_capacity * 3) &&
+      NOT(grow_shared_table(region))) {
+    return node;
+  } /* end if */
   
-  return replaced_node;
-} /* end m2c_ast_replace_subnode */
+  mask = region->shared_capacity - 1;
+  index = node_hash(node) & mask;
+  
+  while (region->shared[index] != NULL) {
+    if (nodes_equal(region->shared[index], node)) {
+      discard_node(region, node);
+      region->reused_count++;
+      return region->shared[index];
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  node->flags = node->flags | AST_FLAG_SHARED;
+  region->shared[index] = node;
+  region->shared_count++;
+  
+  return node;
+} /* end share_node */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_replace_value(in_node, at_index, with_value)
+ * private function node_hash(node)
  * --------------------------------------------------------------------------
- * Replaces a value and returns the replaced value,  or NULL on failure.
+ * Returns a hash of the node type and subnode table of node.  Subnodes and
+ * values are hashed by address,  values are interned and subnodes already
+ * canonical,  so equal addresses mean equal subtrees.
  * ----------------------------------------------------------------------- */
 
-intstr_t m2c_ast_replace_value
-  (m2c_astnode_t in_node, unsigned short at_index, intstr_t with_value) {
+static uint32_t node_hash (m2c_astnode_t node) {
   
-  intstr_t replaced_value;
-  m2c_ast_nodetype_t node_type;
+  return hash_bytes(node->subnode_table,
+    node->subnode_count * sizeof(m2c_astnode_variant)) ^
+    ((uint32_t) node->node_type * 0x9E3779B1u);
+} /* end node_hash */
 
-  if (in_node == NULL)
-    return NULL;
+
+/* --------------------------------------------------------------------------
+ * private function nodes_equal(node1, node2)
+ * --------------------------------------------------------------------------
+ * Returns true if node1 and node2 have the same node type and subnode table.
+ * ----------------------------------------------------------------------- */
+
+static bool nodes_equal (m2c_astnode_t node1, m2c_astnode_t node2) {
+  
+  return (node1->node_type == node2->node_type) &&
+    (node1->subnode_count == node2->subnode_count) &&
+    (memcmp(node1->subnode_table, node2->subnode_table,
+      node1->subnode_count * sizeof(m2c_astnode_variant)) == 0);
+} /* end nodes_equal */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_shared_table(region)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the shared node table of region  and re-inserts
+ * its nodes.  Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_shared_table (m2c_ast_region_t region) {
+  
+  m2c_astnode_t *new_table;
+  size_t new_capacity, index, new_index, mask;
+  
+  if (region->shared_capacity == 0) {
+    new_capacity = AST_SHARED_INITIAL_CAPACITY;
+  }
+  else {
+    new_capacity = 2 * region->shared_capacity;
   } /* end if */
   
-  node_type = in_node->node_type;
+  new_table = m2c_mem_calloc(M2C_MEM_AST, new_capacity, sizeof(m2c_astnode_t));
   
-  if ((AST_IS_NONTERMINAL_NODETYPE(node_type))
-    || (AST_IS_NONTERMINAL_LIST_NODETYPE(node_type))) {
-    return NULL;
+  if (new_table == NULL) {
+    return false;
   } /* end if */
   
-  replaced_value = in_node->subnode_table[at_index].terminal;
-  in_node->subnode_table[at_index].non_terminal = with_value;
+  mask = new_capacity - 1;
   
-  return replaced_value;
-} /* end m2c_ast_replace_value */
+  for (index = 0; index < region->shared_capacity; index++) {
+    if (region->shared[index] != NULL) {
+      new_index = node_hash(region->shared[index]) & mask;
+      while (new_table[new_index] != NULL) {
+        new_index = (new_index + 1) & mask;
+      } /* end while */
+      new_table[new_index] = region->shared[index];
+    } /* end if */
+  } /* end for */
+  
+  m2c_mem_free(M2C_MEM_AST, region->shared);
+  region->shared = new_table;
+  region->shared_capacity = new_capacity;
+  
+  return true;
+} /* end grow_shared_table */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ast_release_node(node)
+ * private procedure discard_node(region, node)
  * --------------------------------------------------------------------------
- * Deallocates node. 
+ * Discards node,  which must be the last node allocated from region.  Its
+ * storage is returned to the current block of region  unless it has been
+ * given a block of its own.
  * ----------------------------------------------------------------------- */
 
-void m2c_ast_release_node (m2c_astnode_t node) {
+static void discard_node (m2c_ast_region_t region, m2c_astnode_t node) {
   
-  if (node == NULL) {
-    return;
-  } /* end if */
+  m2c_ast_region_block_t block;
+  size_t size;
   
-  free(node);
+  size = REGION_ROUND_UP(sizeof(m2c_astnode_struct_t) +
+    node->subnode_count * sizeof(m2c_astnode_variant));
+  block = region->block;
   
-  /* TO DO: recursively deallocate sub-nodes */
+  if ((char *) node + size == &block->storage[block->used]) {
+    block->used = block->used - size;
+  } /* end if */
   
-} /* end m2c_ast_release_node */
+  region->node_count--;
+  
+  return;
+} /* end discard_node */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,968 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-case-codegen.c                                                        *
+ *                                                                           *
+ * Implementation of translation of CASE statements.                         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-case-codegen.h"
+#include "m2c-ast-nodetype.h"
+#include "m2c-build-params.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type label_range_t
+ * --------------------------------------------------------------------------
+ * Record type representing the values lower to upper of the labels of the
+ * case branch with index branch.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  int64_t lower;
+  int64_t upper;
+  uint_t branch;
+} label_range_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_case_plan_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing the analysis of a CASE statement.  The ranges
+ * are sorted by value,  adjacent ranges of the same branch are merged.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_case_plan_struct_t {
+  m2c_astnode_t switch_node;
+  m2c_case_strategy_t strategy;
+  uint_t branch_count;
+  uint_t label_count;
+  uint_t range_count;
+  label_range_t *range;
+};
+
+typedef struct m2c_case_plan_struct_t m2c_case_plan_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type label_source_t
+ * --------------------------------------------------------------------------
+ * Record type holding the means of folding case labels.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_const_fold_t folder;
+  m2c_case_label_resolver_f resolver;
+  void *context;
+} label_source_t;
+
+
+/* --------------------------------------------------------------------------
+ * Names of temporaries in generated code
+ * ----------------------------------------------------------------------- */
+
+#define SELECTOR_TEMP "m2c_case_sel"
+#define BRANCH_TEMP "m2c_case_branch"
+#define TABLE_TEMP "m2c_case_table"
+
+
+/* --------------------------------------------------------------------------
+ * Number of table entries per line of a jump table
+ * ----------------------------------------------------------------------- */
+
+#define TABLE_ENTRIES_PER_LINE 16
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_case_status_t collect_ranges
+  (m2c_case_plan_t plan, label_source_t *source);
+
+static bool label_value
+  (label_source_t *source, m2c_astnode_t label, int64_t *value);
+
+static int compare_ranges (const void *left, const void *right);
+
+static m2c_case_status_t merge_ranges (m2c_case_plan_t plan);
+
+static m2c_case_strategy_t select_strategy (m2c_case_plan_t plan);
+
+static void write_switch
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context);
+
+static void write_jump_table
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context);
+
+static void write_range_search
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context);
+
+static void write_search_node
+  (outfile_t outfile, m2c_case_plan_t plan,
+   uint_t first, uint_t last, uint_t indent);
+
+static void write_branch_switch
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context, uint_t indent);
+
+static void write_branch_body
+  (outfile_t outfile, m2c_astnode_t stmt_seq,
+   m2c_case_node_writer_f writer, void *context, uint_t indent);
+
+static void write_selector
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context);
+
+static void write_whole (outfile_t outfile, int64_t value);
+
+static void write_indent (outfile_t outfile, uint_t indent);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_case_plan(switch_node, folder, resolver, context, status)
+ * --------------------------------------------------------------------------
+ * Analyses the labels of CASE statement node switch_node  and returns a plan
+ * for its translation.
+ * ----------------------------------------------------------------------- */
+
+m2c_case_plan_t m2c_new_case_plan
+  (m2c_astnode_t switch_node,               /* in */
+   m2c_const_fold_t folder,                 /* in */
+   m2c_case_label_resolver_f resolver,      /* in */
+   void *context,                           /* in */
+   m2c_case_status_t *status) {             /* out */
+  
+  m2c_case_plan_t plan;
+  m2c_case_status_t result;
+  label_source_t source;
+  
+  if ((switch_node == NULL) || (folder == NULL) ||
+      (m2c_ast_nodetype(switch_node) != AST_SWITCH)) {
+    SET_STATUS(status, M2C_CASE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  plan = malloc(sizeof(m2c_case_plan_struct_t));
+  
+  if (plan == NULL) {
+    SET_STATUS(status, M2C_CASE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  plan->switch_node = switch_node;
+  plan->strategy = M2C_CASE_SWITCH;
+  plan->branch_count = 0;
+  plan->label_count = 0;
+  plan->range_count = 0;
+  plan->range = NULL;
+  
+  source.folder = folder;
+  source.resolver = resolver;
+  source.context = context;
+  
+  result = collect_ranges(plan, &source);
+  
+  if (result == M2C_CASE_STATUS_SUCCESS) {
+    result = merge_ranges(plan);
+  } /* end if */
+  
+  if (result != M2C_CASE_STATUS_SUCCESS) {
+    m2c_release_case_plan(plan);
+    SET_STATUS(status, result);
+    return NULL;
+  } /* end if */
+  
+  plan->strategy = select_strategy(plan);
+  
+  SET_STATUS(status, M2C_CASE_STATUS_SUCCESS);
+  return plan;
+} /* end m2c_new_case_plan */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_case_plan_strategy(plan)
+ * --------------------------------------------------------------------------
+ * Returns the translation strategy chosen for plan.
+ * ----------------------------------------------------------------------- */
+
+m2c_case_strategy_t m2c_case_plan_strategy (m2c_case_plan_t plan) {
+  
+  if (plan == NULL) {
+    return M2C_CASE_SWITCH;
+  } /* end if */
+  
+  return plan->strategy;
+} /* end m2c_case_plan_strategy */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_case(outfile, plan, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes the C translation of the CASE statement of plan to outfile.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_case
+  (outfile_t outfile,                       /* in */
+   m2c_case_plan_t plan,                    /* in */
+   m2c_case_node_writer_f writer,           /* in */
+   void *context) {                         /* in */
+  
+  if ((outfile == NULL) || (plan == NULL) || (writer == NULL)) {
+    return;
+  } /* end if */
+  
+  switch (plan->strategy) {
+    case M2C_CASE_SWITCH :
+      write_switch(outfile, plan, writer, context);
+      break;
+  
+    case M2C_CASE_JUMP_TABLE :
+      write_jump_table(outfile, plan, writer, context);
+      break;
+  
+    case M2C_CASE_RANGE_SEARCH :
+      write_range_search(outfile, plan, writer, context);
+      break;
+  } /* end switch */
+} /* end m2c_write_case */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_case_plan(plan)
+ * --------------------------------------------------------------------------
+ * Deallocates plan.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_case_plan (m2c_case_plan_t plan) {
+  
+  if (plan == NULL) {
+    return;
+  } /* end if */
+  
+  free(plan->range);
+  free(plan);
+} /* end m2c_release_case_plan */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function collect_ranges(plan, source)
+ * --------------------------------------------------------------------------
+ * Folds the labels of all case branches of plan into label ranges.  Ranges
+ * whose lower bound exceeds their upper bound match no value  and are left
+ * out.
+ *
+ * astnodes:
+ *  (CASELIST caseBranchNode+)
+ *  (CASE (CASELBL label0 ... labelN) stmtSeqNode)
+ *  label: exprNode | (RANGE lowerBound upperBound)
+ * ----------------------------------------------------------------------- */
+
+static m2c_case_status_t collect_ranges
+  (m2c_case_plan_t plan, label_source_t *source) {
+  
+  m2c_astnode_t case_list, branch, label_list, label;
+  unsigned short branch_index, branch_count, label_index, label_count;
+  uint_t capacity;
+  int64_t lower, upper;
+  
+  case_list = m2c_ast_subnode_at_index(plan->switch_node, 1);
+  branch_count = m2c_ast_subnode_count(case_list);
+  plan->branch_count = branch_count;
+  
+  /* count labels to size the range table */
+  capacity = 0;
+  for (branch_index = 0; branch_index < branch_count; branch_index++) {
+    branch = m2c_ast_subnode_at_index(case_list, branch_index);
+    label_list = m2c_ast_subnode_at_index(branch, 0);
+    capacity = capacity + m2c_ast_subnode_count(label_list);
+  } /* end for */
+  
+  if (capacity == 0) {
+    return M2C_CASE_STATUS_SUCCESS;
+  } /* end if */
+  
+  plan->range = malloc(capacity * sizeof(label_range_t));
+  
+  if (plan->range == NULL) {
+    return M2C_CASE_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  for (branch_index = 0; branch_index < branch_count; branch_index++) {
+    branch = m2c_ast_subnode_at_index(case_list, branch_index);
+    label_list = m2c_ast_subnode_at_index(branch, 0);
+    label_count = m2c_ast_subnode_count(label_list);
+  
+    for (label_index = 0; label_index < label_count; label_index++) {
+      label = m2c_ast_subnode_at_index(label_list, label_index);
+  
+      if (m2c_ast_nodetype(label) == AST_RANGE) {
+        if (NOT(label_value(source,
+              m2c_ast_subnode_at_index(label, 0), &lower)) ||
+            NOT(label_value(source,
+              m2c_ast_subnode_at_index(label, 1), &upper))) {
+          return M2C_CASE_STATUS_NONCONST_LABEL;
+        } /* end if */
+      }
+      else if (label_value(source, label, &lower)) {
+        upper = lower;
+      }
+      else /* not constant */ {
+        return M2C_CASE_STATUS_NONCONST_LABEL;
+      } /* end if */
+  
+      plan->label_count++;
+  
+      if (lower <= upper) {
+        plan->range[plan->range_count].lower = lower;
+        plan->range[plan->range_count].upper = upper;
+        plan->range[plan->range_count].branch = branch_index;
+        plan->range_count++;
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  return M2C_CASE_STATUS_SUCCESS;
+} /* end collect_ranges */
+
+
+/* --------------------------------------------------------------------------
+ * private function label_value(source, label, value)
+ * --------------------------------------------------------------------------
+ * Folds label,  passes its ordinal value in value and returns true,  or
+ * returns false if it is not a constant of an ordinal type.
+ * ----------------------------------------------------------------------- */
+
+static bool label_value
+  (label_source_t *source, m2c_astnode_t label, int64_t *value) {
+  
+  m2c_const_value_t folded;
+  
+  if (label == NULL) {
+    return false;
+  } /* end if */
+  
+  if (m2c_const_fold_value(source->folder, label, &folded) &&
+      ((folded.kind == M2C_CONST_WHOLE) || (folded.kind == M2C_CONST_CHAR))) {
+    *value = folded.whole;
+    return true;
+  } /* end if */
+  
+  if (source->resolver != NULL) {
+    return source->resolver(label, source->context, value);
+  } /* end if */
+  
+  return false;
+} /* end label_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_ranges(left, right)
+ * --------------------------------------------------------------------------
+ * Compares two label ranges by lower bound,  for use with qsort().
+ * ----------------------------------------------------------------------- */
+
+static int compare_ranges (const void *left, const void *right) {
+  
+  int64_t left_lower, right_lower;
+  
+  left_lower = ((const label_range_t *) left)->lower;
+  right_lower = ((const label_range_t *) right)->lower;
+  
+  if (left_lower < right_lower) {
+    return -1;
+  }
+  else if (left_lower > right_lower) {
+    return 1;
+  }
+  else {
+    return 0;
+  } /* end if */
+} /* end compare_ranges */
+
+
+/* --------------------------------------------------------------------------
+ * private function merge_ranges(plan)
+ * --------------------------------------------------------------------------
+ * Sorts the label ranges of plan,  fails if any two ranges overlap,  and
+ * merges adjacent ranges of the same branch.
+ * ----------------------------------------------------------------------- */
+
+static m2c_case_status_t merge_ranges (m2c_case_plan_t plan) {
+  
+  uint_t index, count;
+  label_range_t *range;
+  
+  if (plan->range_count < 2) {
+    return M2C_CASE_STATUS_SUCCESS;
+  } /* end if */
+  
+  range = plan->range;
+  qsort(range, plan->range_count, sizeof(label_range_t), compare_ranges);
+  
+  count = 1;
+  for (index = 1; index < plan->range_count; index++) {
+    if (range[index].lower <= range[count - 1].upper) {
+      return M2C_CASE_STATUS_DUPLICATE_LABEL;
+    } /* end if */
+  
+    if ((range[index].branch == range[count - 1].branch) &&
+        (range[index].lower - 1 == range[count - 1].upper)) {
+      range[count - 1].upper = range[index].upper;
+    }
+    else {
+      range[count] = range[index];
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  plan->range_count = count;
+  
+  return M2C_CASE_STATUS_SUCCESS;
+} /* end merge_ranges */
+
+
+/* --------------------------------------------------------------------------
+ * private function select_strategy(plan)
+ * --------------------------------------------------------------------------
+ * Returns the translation strategy for the label ranges of plan.  Labels are
+ * dense if they cover at least M2C_CASE_MIN_DENSITY percent of their span
+ * and the span does not exceed M2C_CASE_MAX_SPAN.  Dense labels are written
+ * as a switch with a case label per value,  unless ranges make that more
+ * than twice the number of labels in the source,  then as a jump table.
+ * ----------------------------------------------------------------------- */
+
+static m2c_case_strategy_t select_strategy (m2c_case_plan_t plan) {
+  
+  uint64_t span, value_count;
+  uint_t index;
+  
+  if (plan->range_count == 0) {
+    return M2C_CASE_SWITCH;
+  } /* end if */
+  
+  /* computed unsigned to avoid overflow,  a span of 2^64 wraps to zero */
+  span = (uint64_t) plan->range[plan->range_count - 1].upper -
+    (uint64_t) plan->range[0].lower + 1;
+  
+  if ((span == 0) || (span > M2C_CASE_MAX_SPAN)) {
+    return M2C_CASE_RANGE_SEARCH;
+  } /* end if */
+  
+  value_count = 0;
+  for (index = 0; index < plan->range_count; index++) {
+    value_count = value_count + (uint64_t) plan->range[index].upper -
+      (uint64_t) plan->range[index].lower + 1;
+  } /* end for */
+  
+  if (value_count * 100 < span * M2C_CASE_MIN_DENSITY) {
+    return M2C_CASE_RANGE_SEARCH;
+  }
+  else if (value_count > 2 * (uint64_t) plan->label_count) {
+    return M2C_CASE_JUMP_TABLE;
+  }
+  else {
+    return M2C_CASE_SWITCH;
+  } /* end if */
+} /* end select_strategy */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_switch(outfile, plan, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes the CASE statement of plan as a switch on the selector:
+ *
+ *   switch (selector) {
+ *     case 1: case 2: case 3:
+ *       stmtSeq0
+ *       break;
+ *     ...
+ *     default:
+ *       elseStmtSeq
+ *   }
+ * ----------------------------------------------------------------------- */
+  
+static void write_switch
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context) {
+  
+  m2c_astnode_t case_list, else_node;
+  uint_t branch, index, column;
+  int64_t value;
+  bool labelled;
+  
+  case_list = m2c_ast_subnode_at_index(plan->switch_node, 1);
+  else_node = m2c_ast_subnode_at_index(plan->switch_node, 2);
+  
+  outfile_write_chars(outfile, "switch (");
+  writer(outfile, m2c_ast_subnode_at_index(plan->switch_node, 0), context);
+  outfile_write_chars(outfile, ") {");
+  outfile_write_newline(outfile);
+  
+  for (branch = 0; branch < plan->branch_count; branch++) {
+    labelled = false;
+    column = 0;
+  
+    /* case labels,  ranges are expanded */
+    for (index = 0; index < plan->range_count; index++) {
+      if (plan->range[index].branch != branch) {
+        continue;
+      } /* end if */
+  
+      value = plan->range[index].lower;
+      while (true) {
+        if (column == 0) {
+          write_indent(outfile, 1);
+        }
+        else {
+          outfile_write_char(outfile, ' ');
+        } /* end if */
+  
+        outfile_write_chars(outfile, "case ");
+        write_whole(outfile, value);
+        outfile_write_char(outfile, ':');
+        labelled = true;
+        column++;
+  
+        if (column == 8) {
+          outfile_write_newline(outfile);
+          column = 0;
+        } /* end if */
+  
+        if (value == plan->range[index].upper) {
+          break;
+        } /* end if */
+        value++;
+      } /* end while */
+    } /* end for */
+  
+    /* branches without values are unreachable */
+    if (NOT(labelled)) {
+      continue;
+    } /* end if */
+  
+    if (column != 0) {
+      outfile_write_newline(outfile);
+    } /* end if */
+  
+    write_branch_body(outfile,
+      m2c_ast_subnode_at_index(m2c_ast_subnode_at_index(case_list, branch), 1),
+      writer, context, 2);
+  } /* end for */
+  
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "default:");
+  outfile_write_newline(outfile);
+  write_branch_body(outfile,
+    m2c_ast_subnode_at_index(else_node, 0), writer, context, 2);
+  
+  outfile_write_chars(outfile, "} /* end switch */");
+  outfile_write_newline(outfile);
+} /* end write_switch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_jump_table(outfile, plan, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes the CASE statement of plan as a lookup of the branch in a table
+ * indexed by the selector,  followed by a switch on the branch.  Branch
+ * numbers in the table are one-based,  zero denotes the ELSE branch.
+ *
+ *   {
+ *     static const unsigned char m2c_case_table[span] = { 1, 1, 0, 2 ... };
+ *     long long m2c_case_sel = (selector);
+ *     unsigned m2c_case_branch = 0;
+ *
+ *     if ((m2c_case_sel >= min) && (m2c_case_sel <= max)) {
+ *       m2c_case_branch = m2c_case_table[m2c_case_sel - min];
+ *     }
+ *     switch (m2c_case_branch) { ... }
+ *   }
+ * ----------------------------------------------------------------------- */
+  
+static void write_jump_table
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context) {
+  
+  int64_t min, max, value;
+  uint_t index, entry, span;
+  
+  min = plan->range[0].lower;
+  max = plan->range[plan->range_count - 1].upper;
+  span = (uint_t) ((uint64_t) max - (uint64_t) min + 1);
+  
+  outfile_write_char(outfile, '{');
+  outfile_write_newline(outfile);
+  
+  /* table */
+  write_indent(outfile, 1);
+  if (plan->branch_count < 255) {
+    outfile_write_chars(outfile, "static const unsigned char ");
+  }
+  else {
+    outfile_write_chars(outfile, "static const unsigned short ");
+  } /* end if */
+  outfile_write_chars(outfile, TABLE_TEMP "[");
+  write_whole(outfile, span);
+  outfile_write_chars(outfile, "] = {");
+  
+  index = 0;
+  for (entry = 0; entry < span; entry++) {
+    value = min + (int64_t) entry;
+  
+    if ((entry % TABLE_ENTRIES_PER_LINE) == 0) {
+      outfile_write_newline(outfile);
+      write_indent(outfile, 2);
+    }
+    else {
+      outfile_write_char(outfile, ' ');
+    } /* end if */
+  
+    if (value > plan->range[index].upper) {
+      index++;
+    } /* end if */
+  
+    if (value >= plan->range[index].lower) {
+      write_whole(outfile, plan->range[index].branch + 1);
+    }
+    else /* gap */ {
+      outfile_write_char(outfile, '0');
+    } /* end if */
+  
+    if (entry + 1 < span) {
+      outfile_write_char(outfile, ',');
+    } /* end if */
+  } /* end for */
+  
+  outfile_write_newline(outfile);
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "};");
+  outfile_write_newline(outfile);
+  
+  write_selector(outfile, plan, writer, context);
+  
+  /* table lookup */
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "if ((" SELECTOR_TEMP " >= ");
+  write_whole(outfile, min);
+  outfile_write_chars(outfile, ") && (" SELECTOR_TEMP " <= ");
+  write_whole(outfile, max);
+  outfile_write_chars(outfile, ")) {");
+  outfile_write_newline(outfile);
+  write_indent(outfile, 2);
+  outfile_write_chars(outfile,
+    BRANCH_TEMP " = " TABLE_TEMP "[" SELECTOR_TEMP " - ");
+  write_whole(outfile, min);
+  outfile_write_chars(outfile, "];");
+  outfile_write_newline(outfile);
+  write_indent(outfile, 1);
+  outfile_write_char(outfile, '}');
+  outfile_write_newline(outfile);
+  
+  write_branch_switch(outfile, plan, writer, context, 1);
+  
+  outfile_write_char(outfile, '}');
+  outfile_write_newline(outfile);
+} /* end write_jump_table */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_range_search(outfile, plan, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes the CASE statement of plan as a binary search over its sorted
+ * label ranges that selects the branch,  followed by a switch on the branch.
+ * Branch numbers are one-based,  zero denotes the ELSE branch.
+ *
+ *   {
+ *     long long m2c_case_sel = (selector);
+ *     unsigned m2c_case_branch = 0;
+ *
+ *     if (m2c_case_sel < 1000) {
+ *       if ((m2c_case_sel >= 1) && (m2c_case_sel <= 9)) {
+ *         m2c_case_branch = 1;
+ *       }
+ *     }
+ *     else { ... }
+ *     switch (m2c_case_branch) { ... }
+ *   }
+ * ----------------------------------------------------------------------- */
+  
+static void write_range_search
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context) {
+  
+  outfile_write_char(outfile, '{');
+  outfile_write_newline(outfile);
+  
+  write_selector(outfile, plan, writer, context);
+  write_search_node(outfile, plan, 0, plan->range_count - 1, 1);
+  write_branch_switch(outfile, plan, writer, context, 1);
+  
+  outfile_write_char(outfile, '}');
+  outfile_write_newline(outfile);
+} /* end write_range_search */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_search_node(outfile, plan, first, last, indent)
+ * --------------------------------------------------------------------------
+ * Writes the binary search over label ranges first to last of plan.  The
+ * recursion depth is logarithmic in the number of ranges.
+ * ----------------------------------------------------------------------- */
+
+static void write_search_node
+  (outfile_t outfile, m2c_case_plan_t plan,
+   uint_t first, uint_t last, uint_t indent) {
+  
+  uint_t middle;
+  label_range_t *range;
+  
+  if (first == last) {
+    range = &plan->range[first];
+  
+    write_indent(outfile, indent);
+    if (range->lower == range->upper) {
+      outfile_write_chars(outfile, "if (" SELECTOR_TEMP " == ");
+      write_whole(outfile, range->lower);
+      outfile_write_chars(outfile, ") {");
+    }
+    else {
+      outfile_write_chars(outfile, "if ((" SELECTOR_TEMP " >= ");
+      write_whole(outfile, range->lower);
+      outfile_write_chars(outfile, ") && (" SELECTOR_TEMP " <= ");
+      write_whole(outfile, range->upper);
+      outfile_write_chars(outfile, ")) {");
+    } /* end if */
+    outfile_write_newline(outfile);
+  
+    write_indent(outfile, indent + 1);
+    outfile_write_chars(outfile, BRANCH_TEMP " = ");
+    write_whole(outfile, range->branch + 1);
+    outfile_write_char(outfile, ';');
+    outfile_write_newline(outfile);
+  
+    write_indent(outfile, indent);
+    outfile_write_char(outfile, '}');
+    outfile_write_newline(outfile);
+    return;
+  } /* end if */
+  
+  middle = first + (last - first + 1) / 2;
+  
+  write_indent(outfile, indent);
+  outfile_write_chars(outfile, "if (" SELECTOR_TEMP " < ");
+  write_whole(outfile, plan->range[middle].lower);
+  outfile_write_chars(outfile, ") {");
+  outfile_write_newline(outfile);
+  
+  write_search_node(outfile, plan, first, middle - 1, indent + 1);
+  
+  write_indent(outfile, indent);
+  outfile_write_chars(outfile, "}");
+  outfile_write_newline(outfile);
+  write_indent(outfile, indent);
+  outfile_write_chars(outfile, "else {");
+  outfile_write_newline(outfile);
+  
+  write_search_node(outfile, plan, middle, last, indent + 1);
+  
+  write_indent(outfile, indent);
+  outfile_write_char(outfile, '}');
+  outfile_write_newline(outfile);
+} /* end write_search_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_branch_switch(outfile, plan, writer, ...)
+ * --------------------------------------------------------------------------
+ * Writes the switch on the one-based branch number selected by a jump table
+ * or range search.  Branches without values are left out.
+ * ----------------------------------------------------------------------- */
+
+static void write_branch_switch
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context, uint_t indent) {
+  
+  m2c_astnode_t case_list, else_node;
+  uint_t branch, index;
+  bool reachable;
+  
+  case_list = m2c_ast_subnode_at_index(plan->switch_node, 1);
+  else_node = m2c_ast_subnode_at_index(plan->switch_node, 2);
+  
+  write_indent(outfile, indent);
+  outfile_write_chars(outfile, "switch (" BRANCH_TEMP ") {");
+  outfile_write_newline(outfile);
+  
+  for (branch = 0; branch < plan->branch_count; branch++) {
+    reachable = false;
+    for (index = 0; index < plan->range_count; index++) {
+      if (plan->range[index].branch == branch) {
+        reachable = true;
+        break;
+      } /* end if */
+    } /* end for */
+  
+    if (NOT(reachable)) {
+      continue;
+    } /* end if */
+  
+    write_indent(outfile, indent + 1);
+    outfile_write_chars(outfile, "case ");
+    write_whole(outfile, branch + 1);
+    outfile_write_char(outfile, ':');
+    outfile_write_newline(outfile);
+  
+    write_branch_body(outfile,
+      m2c_ast_subnode_at_index(m2c_ast_subnode_at_index(case_list, branch), 1),
+      writer, context, indent + 2);
+  } /* end for */
+  
+  write_indent(outfile, indent + 1);
+  outfile_write_chars(outfile, "default:");
+  outfile_write_newline(outfile);
+  write_branch_body(outfile,
+    m2c_ast_subnode_at_index(else_node, 0), writer, context, indent + 2);
+  
+  write_indent(outfile, indent);
+  outfile_write_chars(outfile, "} /* end switch */");
+  outfile_write_newline(outfile);
+} /* end write_branch_switch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_branch_body(outfile, stmt_seq, writer, ...)
+ * --------------------------------------------------------------------------
+ * Writes statement sequence stmt_seq followed by a break.  An empty or
+ * absent statement sequence is written as a call of M2C_CASE_NO_MATCH(),
+ * which is only the case for an absent ELSE branch.
+ * ----------------------------------------------------------------------- */
+
+static void write_branch_body
+  (outfile_t outfile, m2c_astnode_t stmt_seq,
+   m2c_case_node_writer_f writer, void *context, uint_t indent) {
+  
+  write_indent(outfile, indent);
+  
+  if ((stmt_seq == NULL) || (m2c_ast_nodetype(stmt_seq) == AST_EMPTY)) {
+    outfile_write_chars(outfile, "M2C_CASE_NO_MATCH();");
+  }
+  else {
+    writer(outfile, stmt_seq, context);
+  } /* end if */
+  outfile_write_newline(outfile);
+  
+  write_indent(outfile, indent);
+  outfile_write_chars(outfile, "break;");
+  outfile_write_newline(outfile);
+} /* end write_branch_body */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_selector(outfile, plan, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes the declarations of the selector and branch temporaries,  thus the
+ * selector is evaluated once.
+ * ----------------------------------------------------------------------- */
+
+static void write_selector
+  (outfile_t outfile, m2c_case_plan_t plan,
+   m2c_case_node_writer_f writer, void *context) {
+  
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "long long " SELECTOR_TEMP " = (");
+  writer(outfile, m2c_ast_subnode_at_index(plan->switch_node, 0), context);
+  outfile_write_chars(outfile, ");");
+  outfile_write_newline(outfile);
+  
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "unsigned " BRANCH_TEMP " = 0;");
+  outfile_write_newline(outfile);
+  outfile_write_newline(outfile);
+} /* end write_selector */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_whole(outfile, value)
+ * --------------------------------------------------------------------------
+ * Writes value to outfile as a C integer literal.
+ * ----------------------------------------------------------------------- */
+
+#define LITERAL_BUFFER_SIZE 24
+
+static void write_whole (outfile_t outfile, int64_t value) {
+  
+  char buffer[LITERAL_BUFFER_SIZE];
+  
+  /* the least value has no positive counterpart to negate */
+  if (value == INT64_MIN) {
+    outfile_write_chars(outfile, "(-9223372036854775807LL - 1)");
+    return;
+  } /* end if */
+  
+  snprintf(buffer, LITERAL_BUFFER_SIZE, "%lld", (long long) value);
+  outfile_write_chars(outfile, buffer);
+} /* end write_whole */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_indent(outfile, indent)
+ * --------------------------------------------------------------------------
+ * Writes indent levels of indentation of two spaces each.
+ * ----------------------------------------------------------------------- */
+
+static void write_indent (outfile_t outfile, uint_t indent) {
+  
+  while (indent > 0) {
+    outfile_write_chars(outfile, "  ");
+    indent--;
+  } /* end while */
+} /* end write_indent */
+
+/* END OF FILE */
@@ -0,0 +1,180 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-char-class.c                                                          *
+ *                                                                           *
+ * Implementation of character class table.                                  *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "m2c-char-class.h"
+
+
+/* --------------------------------------------------------------------------
+ * Character class table
+ * --------------------------------------------------------------------------
+ * Entries for character codes 128 to 255 are implicitly zero.
+ * ----------------------------------------------------------------------- */
+
+const unsigned char m2c_char_class[256] = {
+  /* 0x00   */ CC_CTRL,
+  /* 0x01   */ CC_CTRL,
+  /* 0x02   */ CC_CTRL,
+  /* 0x03   */ CC_CTRL,
+  /* 0x04   */ CC_CTRL,
+  /* 0x05   */ CC_CTRL,
+  /* 0x06   */ CC_CTRL,
+  /* 0x07   */ CC_CTRL,
+  /* 0x08   */ CC_CTRL,
+  /* 0x09   */ CC_SPACE | CC_CTRL,
+  /* 0x0A   */ CC_SPACE | CC_CTRL,
+  /* 0x0B   */ CC_CTRL,
+  /* 0x0C   */ CC_CTRL,
+  /* 0x0D   */ CC_SPACE | CC_CTRL,
+  /* 0x0E   */ CC_CTRL,
+  /* 0x0F   */ CC_CTRL,
+  /* 0x10   */ CC_CTRL,
+  /* 0x11   */ CC_CTRL,
+  /* 0x12   */ CC_CTRL,
+  /* 0x13   */ CC_CTRL,
+  /* 0x14   */ CC_CTRL,
+  /* 0x15   */ CC_CTRL,
+  /* 0x16   */ CC_CTRL,
+  /* 0x17   */ CC_CTRL,
+  /* 0x18   */ CC_CTRL,
+  /* 0x19   */ CC_CTRL,
+  /* 0x1A   */ CC_CTRL,
+  /* 0x1B   */ CC_CTRL,
+  /* 0x1C   */ CC_CTRL,
+  /* 0x1D   */ CC_CTRL,
+  /* 0x1E   */ CC_CTRL,
+  /* 0x1F   */ CC_CTRL,
+  /* ' '    */ CC_SPACE | CC_PRINT,
+  /* '!'    */ CC_PRINT,
+  /* '"'    */ CC_PRINT,
+  /* '#'    */ CC_PRINT,
+  /* '$'    */ CC_PRINT,
+  /* '%'    */ CC_PRINT,
+  /* '&'    */ CC_PRINT,
+  /* '\''   */ CC_PRINT,
+  /* '('    */ CC_PRINT,
+  /* ')'    */ CC_PRINT,
+  /* '*'    */ CC_PRINT,
+  /* '+'    */ CC_PRINT,
+  /* ','    */ CC_PRINT,
+  /* '-'    */ CC_PRINT,
+  /* '.'    */ CC_PRINT,
+  /* '/'    */ CC_PRINT,
+  /* '0'    */ CC_DIGIT | CC_PRINT,
+  /* '1'    */ CC_DIGIT | CC_PRINT,
+  /* '2'    */ CC_DIGIT | CC_PRINT,
+  /* '3'    */ CC_DIGIT | CC_PRINT,
+  /* '4'    */ CC_DIGIT | CC_PRINT,
+  /* '5'    */ CC_DIGIT | CC_PRINT,
+  /* '6'    */ CC_DIGIT | CC_PRINT,
+  /* '7'    */ CC_DIGIT | CC_PRINT,
+  /* '8'    */ CC_DIGIT | CC_PRINT,
+  /* '9'    */ CC_DIGIT | CC_PRINT,
+  /* ':'    */ CC_PRINT,
+  /* ';'    */ CC_PRINT,
+  /* '<'    */ CC_PRINT,
+  /* '='    */ CC_PRINT,
+  /* '>'    */ CC_PRINT,
+  /* '?'    */ CC_PRINT,
+  /* '@'    */ CC_PRINT,
+  /* 'A'    */ CC_UPPER | CC_HEX | CC_PRINT,
+  /* 'B'    */ CC_UPPER | CC_HEX | CC_PRINT,
+  /* 'C'    */ CC_UPPER | CC_HEX | CC_PRINT,
+  /* 'D'    */ CC_UPPER | CC_HEX | CC_PRINT,
+  /* 'E'    */ CC_UPPER | CC_HEX | CC_PRINT,
+  /* 'F'    */ CC_UPPER | CC_HEX | CC_PRINT,
+  /* 'G'    */ CC_UPPER | CC_PRINT,
+  /* 'H'    */ CC_UPPER | CC_PRINT,
+  /* 'I'    */ CC_UPPER | CC_PRINT,
+  /* 'J'    */ CC_UPPER | CC_PRINT,
+  /* 'K'    */ CC_UPPER | CC_PRINT,
+  /* 'L'    */ CC_UPPER | CC_PRINT,
+  /* 'M'    */ CC_UPPER | CC_PRINT,
+  /* 'N'    */ CC_UPPER | CC_PRINT,
+  /* 'O'    */ CC_UPPER | CC_PRINT,
+  /* 'P'    */ CC_UPPER | CC_PRINT,
+  /* 'Q'    */ CC_UPPER | CC_PRINT,
+  /* 'R'    */ CC_UPPER | CC_PRINT,
+  /* 'S'    */ CC_UPPER | CC_PRINT,
+  /* 'T'    */ CC_UPPER | CC_PRINT,
+  /* 'U'    */ CC_UPPER | CC_PRINT,
+  /* 'V'    */ CC_UPPER | CC_PRINT,
+  /* 'W'    */ CC_UPPER | CC_PRINT,
+  /* 'X'    */ CC_UPPER | CC_PRINT,
+  /* 'Y'    */ CC_UPPER | CC_PRINT,
+  /* 'Z'    */ CC_UPPER | CC_PRINT,
+  /* '['    */ CC_PRINT,
+  /* '\\'   */ CC_PRINT,
+  /* ']'    */ CC_PRINT,
+  /* '^'    */ CC_PRINT,
+  /* '_'    */ CC_LOWLINE | CC_PRINT,
+  /* '`'    */ CC_PRINT,
+  /* 'a'    */ CC_LOWER | CC_PRINT,
+  /* 'b'    */ CC_LOWER | CC_PRINT,
+  /* 'c'    */ CC_LOWER | CC_PRINT,
+  /* 'd'    */ CC_LOWER | CC_PRINT,
+  /* 'e'    */ CC_LOWER | CC_PRINT,
+  /* 'f'    */ CC_LOWER | CC_PRINT,
+  /* 'g'    */ CC_LOWER | CC_PRINT,
+  /* 'h'    */ CC_LOWER | CC_PRINT,
+  /* 'i'    */ CC_LOWER | CC_PRINT,
+  /* 'j'    */ CC_LOWER | CC_PRINT,
+  /* 'k'    */ CC_LOWER | CC_PRINT,
+  /* 'l'    */ CC_LOWER | CC_PRINT,
+  /* 'm'    */ CC_LOWER | CC_PRINT,
+  /* 'n'    */ CC_LOWER | CC_PRINT,
+  /* 'o'    */ CC_LOWER | CC_PRINT,
+  /* 'p'    */ CC_LOWER | CC_PRINT,
+  /* 'q'    */ CC_LOWER | CC_PRINT,
+  /* 'r'    */ CC_LOWER | CC_PRINT,
+  /* 's'    */ CC_LOWER | CC_PRINT,
+  /* 't'    */ CC_LOWER | CC_PRINT,
+  /* 'u'    */ CC_LOWER | CC_PRINT,
+  /* 'v'    */ CC_LOWER | CC_PRINT,
+  /* 'w'    */ CC_LOWER | CC_PRINT,
+  /* 'x'    */ CC_LOWER | CC_PRINT,
+  /* 'y'    */ CC_LOWER | CC_PRINT,
+  /* 'z'    */ CC_LOWER | CC_PRINT,
+  /* '{'    */ CC_PRINT,
+  /* '|'    */ CC_PRINT,
+  /* '}'    */ CC_PRINT,
+  /* '~'    */ CC_PRINT,
+  /* 0x7F   */ CC_CTRL
+}; /* m2c_char_class */
+
+/* END OF FILE */
@@ -122,8 +122,9 @@ cli_token_t cli_next_token (void) {
     token = match_compiler_switch(argstr, length);
   }
   else {
-    /* tentatively parse as pathname */
-    if (is_valid_pathname(argstr)) {
+    /* tentatively parse as pathname, @pathname for a response file */
+    if ((is_valid_pathname(argstr)) ||
+        ((argstr[0] == '@') && (is_valid_pathname(argstr + 1)))) {
       token = CLI_TOKEN_SOURCE_FILE;
     }
     else /* not a valid pathname */ {
@@ -215,6 +216,12 @@ static cli_token_t match_compiler_switch
       
     case /* length == */ 6 :
       switch (argstr[2]) {
+        /* --exlb */
+        case 'e' :
+          if (cstr_match(argstr, "--exlb")) {
+            return CLI_TOKEN_EXLB;
+          } /* end if */
+          
         /* --help */
         case 'h' :
           if (cstr_match(argstr, "--help")) {
@@ -232,10 +239,34 @@ static cli_token_t match_compiler_switch
       } /* end switch */
       
     case /* length == */ 7 :
-      /* --graph */
-      if (cstr_match(argstr, "--graph")) {
-        return CLI_TOKEN_GRAPH;
-      } /* end if */
+      switch (argstr[2]) {
+        /* --cache */
+        case 'c' :
+          if (cstr_match(argstr, "--cache")) {
+            return CLI_TOKEN_CACHE;
+          } /* end if */
+          
+        /* --graph */
+        case 'g' :
+          if (cstr_match(argstr, "--graph")) {
+            return CLI_TOKEN_GRAPH;
+          } /* end if */
+          
+        /* --trace */
+        case 't' :
+          if (cstr_match(argstr, "--trace")) {
+            return CLI_TOKEN_TRACE;
+          } /* end if */
+          
+        /* --unity */
+        case 'u' :
+          if (cstr_match(argstr, "--unity")) {
+            return CLI_TOKEN_UNITY;
+          } /* end if */
+        
+        default :
+          return CLI_TOKEN_INVALID;
+      } /* end switch */
       
     case /* length == */ 8 :
       switch (argstr[5]) {
@@ -263,10 +294,13 @@ static cli_token_t match_compiler_switch
             return CLI_TOKEN_VERBOSE;
           } /* end if */
           
-        /* --license */
+        /* --license, --no-exlb */
         case 'e' :
           if (cstr_match(argstr, "--license")) {
             return CLI_TOKEN_LICENSE;
+          }
+          else if (cstr_match(argstr, "--no-exlb")) {
+            return CLI_TOKEN_NO_EXLB;
           } /* end if */
         
         /* --version */
@@ -293,10 +327,16 @@ static cli_token_t match_compiler_switch
             return CLI_TOKEN_AST_ONLY;
           } /* end if */
           
-        /* --no-graph */
+        /* --no-cache, --no-graph, --no-unity */
         case 'n' :
-          if (cstr_match(argstr, "--no-graph")) {
+          if (cstr_match(argstr, "--no-cache")) {
+            return CLI_TOKEN_NO_CACHE;
+          }
+          else if (cstr_match(argstr, "--no-graph")) {
             return CLI_TOKEN_NO_GRAPH;
+          }
+          else if (cstr_match(argstr, "--no-unity")) {
+            return CLI_TOKEN_NO_UNITY;
           } /* end if */
           
         /* --obj-only */
@@ -310,16 +350,49 @@ static cli_token_t match_compiler_switch
       } /* end switch */
       
     case /* length == */ 11 :
-      /* --xlat-only */
-      if (cstr_match(argstr, "--xlat-only")) {
-        return CLI_TOKEN_XLAT_ONLY;
-      } /* end if */
+      switch (argstr[2]) {
+        /* --telemetry */
+        case 't' :
+          if (cstr_match(argstr, "--telemetry")) {
+            return CLI_TOKEN_TELEMETRY;
+          } /* end if */
+          
+        /* --xlat-only */
+        case 'x' :
+          if (cstr_match(argstr, "--xlat-only")) {
+            return CLI_TOKEN_XLAT_ONLY;
+          } /* end if */
+        
+        default :
+          return CLI_TOKEN_INVALID;
+      } /* end switch */
       
     case /* length == */ 12 :
-      /* --graph-only */
-      if (cstr_match(argstr, "--graph-only")) {
-        return CLI_TOKEN_GRAPH_ONLY;
-      } /* end if */
+      switch (argstr[2]) {
+        /* --dump-depth */
+        case 'd' :
+          if (cstr_match(argstr, "--dump-depth")) {
+            return CLI_TOKEN_DUMP_DEPTH;
+          } /* end if */
+          
+        /* --graph-only */
+        case 'g' :
+          if (cstr_match(argstr, "--graph-only")) {
+            return CLI_TOKEN_GRAPH_ONLY;
+          } /* end if */
+          
+        /* --max-errors, --mem-report */
+        case 'm' :
+          if (cstr_match(argstr, "--max-errors")) {
+            return CLI_TOKEN_MAX_ERRORS;
+          }
+          else if (cstr_match(argstr, "--mem-report")) {
+            return CLI_TOKEN_MEM_REPORT;
+          } /* end if */
+        
+        default :
+          return CLI_TOKEN_INVALID;
+      } /* end switch */
       
     case /* length == */ 13 :
       switch (argstr[2]) {
@@ -335,27 +408,87 @@ static cli_token_t match_compiler_switch
             return CLI_TOKEN_SYNTAX_ONLY;
           } /* end if */
         
+        /* --time-report */
+        case 't' :
+          if (cstr_match(argstr, "--time-report")) {
+            return CLI_TOKEN_TIME_REPORT;
+          } /* end if */
+        
         default :
           return CLI_TOKEN_INVALID;
       } /* end switch */
       
     case /* length == */ 14 :
-      /* --parser-debug */
-      if (cstr_match(argstr, "--parser-debug")) {
-        return CLI_TOKEN_PARSER_DEBUG;
-      } /* end if */
+      switch (argstr[2]) {
+        /* --dump-subtree */
+        case 'd' :
+          if (cstr_match(argstr, "--dump-subtree")) {
+            return CLI_TOKEN_DUMP_SUBTREE;
+          } /* end if */
+          
+        /* --intstr-stats */
+        case 'i' :
+          if (cstr_match(argstr, "--intstr-stats")) {
+            return CLI_TOKEN_INTSTR_STATS;
+          } /* end if */
+          
+        /* --max-warnings */
+        case 'm' :
+          if (cstr_match(argstr, "--max-warnings")) {
+            return CLI_TOKEN_MAX_WARNINGS;
+          } /* end if */
+          
+        /* --parser-debug */
+        case 'p' :
+          if (cstr_match(argstr, "--parser-debug")) {
+            return CLI_TOKEN_PARSER_DEBUG;
+          } /* end if */
+          
+        /* --worker-cache */
+        case 'w' :
+          if (cstr_match(argstr, "--worker-cache")) {
+            return CLI_TOKEN_WORKER_CACHE;
+          } /* end if */
+        
+        default :
+          return CLI_TOKEN_INVALID;
+      } /* end switch */
       
     case /* length == */ 15 :
-      /* --show-settings */
-      if (cstr_match(argstr, "--show-settings")) {
-        return CLI_TOKEN_SHOW_SETTINGS;
-      } /* end if */
+      switch (argstr[2]) {
+        /* --perf-counters */
+        case 'p' :
+          if (cstr_match(argstr, "--perf-counters")) {
+            return CLI_TOKEN_PERF_COUNTERS;
+          } /* end if */
+          
+        /* --show-settings */
+        case 's' :
+          if (cstr_match(argstr, "--show-settings")) {
+            return CLI_TOKEN_SHOW_SETTINGS;
+          } /* end if */
+        
+        default :
+          return CLI_TOKEN_INVALID;
+      } /* end switch */
       
     case /* length == */ 16 :
-      /* --strip-comments */
-      if (cstr_match(argstr, "--strip-comments")) {
-        return CLI_TOKEN_STRIP_COMMENTS;
-      } /* end if */
+      switch (argstr[2]) {
+        /* --parser-profile */
+        case 'p' :
+          if (cstr_match(argstr, "--parser-profile")) {
+            return CLI_TOKEN_PARSER_PROFILE;
+          } /* end if */
+          
+        /* --strip-comments */
+        case 's' :
+          if (cstr_match(argstr, "--strip-comments")) {
+            return CLI_TOKEN_STRIP_COMMENTS;
+          } /* end if */
+        
+        default :
+          return CLI_TOKEN_INVALID;
+      } /* end switch */
       
     case /* length == */ 19 :
       switch (argstr[2]) {
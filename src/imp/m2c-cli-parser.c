@@ -43,9 +43,11 @@
 
 #include "m2c-cli-lexer.h"
 #include "m2c-compiler-options.h"
+#include "m2c-pathnames.h"
 #include "cstring.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
 
 /* ---------------------------------------------------------------------------
@@ -54,7 +56,25 @@
 
 static unsigned err_count = 0;
 static unsigned option_set = 0;
-static const char *source_file = NULL;
+
+/* source file arguments in order of appearance, response files expanded */
+static const char **source_list = NULL;
+static unsigned source_count = 0;
+static unsigned source_capacity = 0;
+
+
+/* ---------------------------------------------------------------------------
+ * Initial capacity of the source list, doubled whenever it is exhausted.
+ * ------------------------------------------------------------------------ */
+
+#define CLI_INITIAL_SOURCE_CAPACITY 16
+
+
+/* ---------------------------------------------------------------------------
+ * Maximum length of a line in a response file, including newline and NUL.
+ * ------------------------------------------------------------------------ */
+
+#define CLI_MAX_RESPONSE_LINE_LENGTH 1024
 
 
 /* ---------------------------------------------------------------------------
@@ -112,14 +132,41 @@ cli_parser_status_t cli_parse_args (void) {
 (* ---------------------------------------------------------------------------
  * function cli_source_file()
  * ---------------------------------------------------------------------------
- * Returns a string with the source file argument.
+ * Returns a string with the first source file argument.
  * ------------------------------------------------------------------------ *)
 
 const char *cli_source_file (void) {
-  return source_file;
+  return cli_source_file_at(0);
 } /* end cli_source_file */
 
 
+/* ---------------------------------------------------------------------------
+ * function cli_source_file_count()
+ * ---------------------------------------------------------------------------
+ * Returns the number of source file arguments.
+ * ------------------------------------------------------------------------ */
+
+unsigned cli_source_file_count (void) {
+  return source_count;
+} /* end cli_source_file_count */
+
+
+/* ---------------------------------------------------------------------------
+ * function cli_source_file_at(index)
+ * ---------------------------------------------------------------------------
+ * Returns the source file argument at index, or NULL if index is out of range.
+ * ------------------------------------------------------------------------ */
+
+const char *cli_source_file_at (unsigned index) {
+  
+  if (index >= source_count) {
+    return NULL;
+  } /* end if */
+  
+  return source_list[index];
+} /* end cli_source_file_at */
+
+
 /* ---------------------------------------------------------------------------
  * function cli_error_count()
  * ---------------------------------------------------------------------------
@@ -168,7 +215,7 @@ cli_token_t parse_info_request (cli_token_t token) {
  * function parse_compilation_request(token)
  * ---------------------------------------------------------------------------
  * compilationRequest :
- *   products? capabilities? sourceFile diagnostics?
+ *   products? capabilities? buildOptions? sourceFile+ diagnostics?
  *   ;
  * ------------------------------------------------------------------------ */
 
@@ -184,7 +231,12 @@ cli_token_t parse_compilation_request (cli_token_t token) {
     token = parse_capabilities(token);
   } /* end if */
   
-  /* sourceFile */
+  /* buildOptions? */
+  if (CLI_IS_BUILD_OPTION(token)) {
+    token = parse_build_options(token);
+  } /* end if */
+  
+  /* sourceFile+ */
   if (token == CLI_TOKEN_SOURCE_FILE) {
     token = parse_source_file(token);
   }
@@ -415,28 +467,243 @@ cli_token_t parse_capabilities (cli_token_t token) {
 } /* end parse_capabilities */
 
 
+/* ---------------------------------------------------------------------------
+ * function parse_build_options(token)
+ * ---------------------------------------------------------------------------
+ * buildOptions :
+ *   ( unityBuild | compileCache | binaryExportList )+
+ *   ;
+ *
+ * unityBuild :
+ *   --unity | --no-unity
+ *   ;
+ *
+ * compileCache :
+ *   --cache | --no-cache
+ *   ;
+ *
+ * binaryExportList :
+ *   --exlb | --no-exlb
+ *   ;
+ *
+ * Option --cache reuses outputs stored in the compile cache.  Option --exlb
+ * writes a binary export list table alongside each export list.
+ *
+ * Option --unity is recognised,  but not supported by this driver yet and
+ * is reported as an error.  It needs the generated C file and dependency
+ * file of every module,  which this driver does not write yet.  Its negated
+ * form is accepted as it selects the default.
+ * ------------------------------------------------------------------------ */
+
+static void report_unsupported_option (const char *argstr);
+
+cli_token_t parse_build_options (cli_token_t token) {
+
+  /* ( unityBuild | compileCache | binaryExportList )+ */
+  while (CLI_IS_BUILD_OPTION(token)) {
+    switch (token) {
+    /* --unity */
+      case CLI_TOKEN_UNITY :
+        report_unsupported_option(cli_last_arg());
+        token = cli_next_token();
+        break;
+    
+    /* --no-unity */
+      case CLI_TOKEN_NO_UNITY :
+        set_option(M2C_COMPILER_OPTION_UNITY_BUILD, false);
+        token = cli_next_token();
+        break;
+    
+    /* --cache */
+      case CLI_TOKEN_CACHE :
+        set_option(M2C_COMPILER_OPTION_COMPILE_CACHE, true);
+        token = cli_next_token();
+        break;
+    
+    /* --no-cache */
+      case CLI_TOKEN_NO_CACHE :
+        set_option(M2C_COMPILER_OPTION_COMPILE_CACHE, false);
+        token = cli_next_token();
+        break;
+    
+    /* --exlb */
+      case CLI_TOKEN_EXLB :
+        set_option(M2C_COMPILER_OPTION_BINARY_EXL, true);
+        token = cli_next_token();
+        break;
+    
+    /* --no-exlb */
+      case CLI_TOKEN_NO_EXLB :
+        set_option(M2C_COMPILER_OPTION_BINARY_EXL, false);
+        token = cli_next_token();
+        break;
+    } /* end switch */
+  } /* end while */
+  
+  return token;
+} /* end parse_build_options */
+
+
 /* ---------------------------------------------------------------------------
  * function parse_source_file(token)
  * ---------------------------------------------------------------------------
  * sourceFile :
+ *   <platform dependent path/filename> | '@' responseFile
+ *   ;
+ *
+ * responseFile :
  *   <platform dependent path/filename>
  *   ;
+ *
+ * A response file lists one source file per line.  Leading and trailing
+ * whitespace is ignored,  so are empty lines and lines starting with '#'.
  * ------------------------------------------------------------------------ */
 
+static void add_source_file (const char *path);
+
+static void read_response_file (const char *path);
+
 cli_token_t parse_source_file (cli_token_t token) {
+  const char *argstr;
   
-  source_file = cli_last_arg();
+  while (token == CLI_TOKEN_SOURCE_FILE) {
+    argstr = cli_last_arg();
+    
+    if (argstr[0] == '@') {
+      read_response_file(argstr + 1);
+    }
+    else {
+      add_source_file(argstr);
+    } /* end if */
+    
+    token = cli_next_token();
+  } /* end while */
   
-  return cli_next_token();
+  return token;
 } /* end parse_source_file */
 
 
+/* ---------------------------------------------------------------------------
+ * procedure add_source_file(path)
+ * ---------------------------------------------------------------------------
+ * Appends path to the source list, growing the list as needed.
+ * ------------------------------------------------------------------------ */
+
+static void add_source_file (const char *path) {
+  const char **new_list;
+  unsigned new_capacity;
+  
+  if (source_count == source_capacity) {
+    if (source_capacity == 0) {
+      new_capacity = CLI_INITIAL_SOURCE_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * source_capacity;
+    } /* end if */
+    
+    new_list = realloc(source_list, new_capacity * sizeof(const char *));
+    
+    if (new_list == NULL) {
+      report_too_many_source_files(path);
+      return;
+    } /* end if */
+    
+    source_list = new_list;
+    source_capacity = new_capacity;
+  } /* end if */
+  
+  source_list[source_count] = path;
+  source_count++;
+  
+} /* end add_source_file */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure read_response_file(path)
+ * ---------------------------------------------------------------------------
+ * Reads the response file at path and appends its entries to the source list.
+ * Response files do not nest,  an entry starting with '@' is an error.
+ * ------------------------------------------------------------------------ */
+
+static void read_response_file (const char *path) {
+  char line[CLI_MAX_RESPONSE_LINE_LENGTH];
+  unsigned start, end, line_no;
+  const char *entry;
+  FILE *file;
+  
+  file = fopen(path, "r");
+  
+  if (file == NULL) {
+    report_unreadable_response_file(path);
+    return;
+  } /* end if */
+  
+  line_no = 0;
+  while (fgets(line, CLI_MAX_RESPONSE_LINE_LENGTH, file) != NULL) {
+    line_no++;
+    
+    /* trim leading and trailing whitespace including the newline */
+    end = cstr_length(line);
+    while ((end > 0) && ((line[end-1] == ' ') || (line[end-1] == '\t') ||
+           (line[end-1] == '\n') || (line[end-1] == '\r'))) {
+      end--;
+    } /* end while */
+    line[end] = ASCII_NUL;
+    
+    start = 0;
+    while ((line[start] == ' ') || (line[start] == '\t')) {
+      start++;
+    } /* end while */
+    
+    /* skip empty lines and comments */
+    if ((start == end) || (line[start] == '#')) {
+      continue;
+    } /* end if */
+    
+    if ((line[start] == '@') || (NOT(is_valid_pathname(line + start)))) {
+      report_invalid_response_entry(path, line_no);
+      continue;
+    } /* end if */
+    
+    entry = new_cstr_from_slice(line, start, end - start);
+    
+    if (entry == NULL) {
+      report_too_many_source_files(line + start);
+      break;
+    } /* end if */
+    
+    add_source_file(entry);
+  } /* end while */
+  
+  fclose(file);
+  
+} /* end read_response_file */
+
+
 /* ---------------------------------------------------------------------------
  * function parse_diagnostics(token)
  * ---------------------------------------------------------------------------
  * diagnostics :
  *   ( --verbose | -v | --lexer-debug | --parser-debug | --print-settings |
- *     --errant-semicolons )+
+ *     --errant-semicolons | --intstr-stats | --parser-profile |
+ *     --time-report | --telemetry | --mem-report | --perf-counters |
+ *     diagnosticLimit | traceFile | dumpFilter | workerCache )+
+ *   ;
+ *
+ * diagnosticLimit :
+ *   ( --max-errors | --max-warnings ) limit
+ *   ;
+ *
+ * traceFile :
+ *   --trace <platform dependent path/filename>
+ *   ;
+ *
+ * dumpFilter :
+ *   --dump-depth limit | --dump-subtree identifier
+ *   ;
+ *
+ * workerCache :
+ *   --worker-cache <platform dependent path/filename>
  *   ;
  * ------------------------------------------------------------------------ */
 
@@ -468,6 +735,58 @@ cli_token_t parse_diagnostics (cli_token_t token) {
       case CLI_TOKEN_ERRANT_SEMICOLONS :
         set_option(M2C_COMPILER_OPTION_ERRANT_SEMICOLONS, true);
         break;
+    
+    /* --intstr-stats | */
+      case CLI_TOKEN_INTSTR_STATS :
+        set_option(M2C_COMPILER_OPTION_INTSTR_STATS, true);
+        break;
+    
+    /* --parser-profile | */
+      case CLI_TOKEN_PARSER_PROFILE :
+        set_option(M2C_COMPILER_OPTION_PARSER_PROFILE, true);
+        break;
+    
+    /* --time-report | */
+      case CLI_TOKEN_TIME_REPORT :
+        set_option(M2C_COMPILER_OPTION_TIME_REPORT, true);
+        break;
+    
+    /* --telemetry | */
+      case CLI_TOKEN_TELEMETRY :
+        set_option(M2C_COMPILER_OPTION_TELEMETRY, true);
+        break;
+    
+    /* --mem-report | */
+      case CLI_TOKEN_MEM_REPORT :
+        set_option(M2C_COMPILER_OPTION_MEM_REPORT, true);
+        break;
+    
+    /* --perf-counters | */
+      case CLI_TOKEN_PERF_COUNTERS :
+        set_option(M2C_COMPILER_OPTION_PERF_COUNTERS, true);
+        break;
+    
+    /* --max-errors limit | --max-warnings limit | */
+      case CLI_TOKEN_MAX_ERRORS :
+      case CLI_TOKEN_MAX_WARNINGS :
+        token = parse_diagnostic_limit(token);
+        continue;
+    
+    /* --trace traceFile | */
+      case CLI_TOKEN_TRACE :
+        token = parse_trace_file(token);
+        continue;
+    
+    /* --dump-depth limit | --dump-subtree identifier | */
+      case CLI_TOKEN_DUMP_DEPTH :
+      case CLI_TOKEN_DUMP_SUBTREE :
+        token = parse_dump_filter(token);
+        continue;
+    
+    /* --worker-cache workerCache */
+      case CLI_TOKEN_WORKER_CACHE :
+        token = parse_worker_cache(token);
+        continue;
     } /* end switch */
     
     token = cli_next_token();
@@ -477,6 +796,198 @@ cli_token_t parse_diagnostics (cli_token_t token) {
 } /* end parse_diagnostics */
 
 
+/* ---------------------------------------------------------------------------
+ * function parse_diagnostic_limit(token)
+ * ---------------------------------------------------------------------------
+ * diagnosticLimit :
+ *   ( --max-errors | --max-warnings ) limit
+ *   ;
+ *
+ * limit : digit+ ;
+ *
+ * Sets the maximum number of errors or warnings reported per module.  Once
+ * the error limit is reached,  the remainder of the module is skipped.  The
+ * limit must be at least one.
+ * ------------------------------------------------------------------------ */
+
+#define MAX_DIAGNOSTIC_LIMIT 1000000
+
+cli_token_t parse_diagnostic_limit (cli_token_t token) {
+  const char *optstr, *argstr;
+  cli_token_t option;
+  uint_t index, value;
+  
+  option = token;
+  optstr = cli_last_arg();
+  
+  if (((option == CLI_TOKEN_MAX_ERRORS) &&
+       (m2c_compiler_option_max_errors() != 0)) ||
+      ((option == CLI_TOKEN_MAX_WARNINGS) &&
+       (m2c_compiler_option_max_warnings() != 0))) {
+    report_duplicate_option(optstr);
+  } /* end if */
+  
+  /* limit */
+  token = cli_next_token();
+  argstr = cli_last_arg();
+  
+  if ((token == CLI_TOKEN_END_OF_INPUT) || (argstr == NULL)) {
+    report_missing_limit(optstr);
+    return token;
+  } /* end if */
+  
+  index = 0;
+  value = 0;
+  while ((argstr[index] >= '0') && (argstr[index] <= '9') &&
+         (value <= MAX_DIAGNOSTIC_LIMIT)) {
+    value = 10 * value + (uint_t) (argstr[index] - '0');
+    index++;
+  } /* end while */
+  
+  if ((index == 0) || (argstr[index] != ASCII_NUL) ||
+      (value == 0) || (value > MAX_DIAGNOSTIC_LIMIT)) {
+    report_invalid_option(argstr);
+  }
+  else if (option == CLI_TOKEN_MAX_ERRORS) {
+    m2c_compiler_option_set_max_errors(value);
+  }
+  else /* CLI_TOKEN_MAX_WARNINGS */ {
+    m2c_compiler_option_set_max_warnings(value);
+  } /* end if */
+  
+  return cli_next_token();
+} /* end parse_diagnostic_limit */
+
+
+/* ---------------------------------------------------------------------------
+ * function parse_trace_file(token)
+ * ---------------------------------------------------------------------------
+ * traceFile :
+ *   --trace <platform dependent path/filename>
+ *   ;
+ *
+ * Sets the path of the trace event file to be written.
+ * ------------------------------------------------------------------------ */
+
+cli_token_t parse_trace_file (cli_token_t token) {
+  const char *argstr;
+  
+  if (m2c_compiler_option_trace_path() != NULL) {
+    report_duplicate_option(cli_last_arg());
+  } /* end if */
+  
+  /* path/filename */
+  token = cli_next_token();
+  argstr = cli_last_arg();
+  
+  if ((token == CLI_TOKEN_END_OF_INPUT) || (argstr == NULL)) {
+    report_missing_trace_path();
+    return token;
+  } /* end if */
+  
+  m2c_compiler_option_set_trace_path(argstr);
+  
+  return cli_next_token();
+} /* end parse_trace_file */
+
+
+/* ---------------------------------------------------------------------------
+ * function parse_dump_filter(token)
+ * ---------------------------------------------------------------------------
+ * dumpFilter :
+ *   --dump-depth limit | --dump-subtree identifier
+ *   ;
+ *
+ * limit : digit+ ;
+ *
+ * Restricts the AST dumps written for options --ast and --graph  to nodes
+ * above the given depth or to the definition of the given identifier.
+ * ------------------------------------------------------------------------ */
+
+#define MAX_DUMP_DEPTH 1000000
+
+cli_token_t parse_dump_filter (cli_token_t token) {
+  const char *optstr, *argstr;
+  cli_token_t option;
+  uint_t index, value;
+  
+  option = token;
+  optstr = cli_last_arg();
+  
+  if (((option == CLI_TOKEN_DUMP_DEPTH) &&
+       (m2c_compiler_option_dump_depth() != 0)) ||
+      ((option == CLI_TOKEN_DUMP_SUBTREE) &&
+       (m2c_compiler_option_dump_subtree() != NULL))) {
+    report_duplicate_option(optstr);
+  } /* end if */
+  
+  /* limit or identifier */
+  token = cli_next_token();
+  argstr = cli_last_arg();
+  
+  if ((token == CLI_TOKEN_END_OF_INPUT) || (argstr == NULL)) {
+    report_missing_dump_argument(optstr);
+    return token;
+  } /* end if */
+  
+  if (option == CLI_TOKEN_DUMP_SUBTREE) {
+    m2c_compiler_option_set_dump_subtree(argstr);
+    return cli_next_token();
+  } /* end if */
+  
+  index = 0;
+  value = 0;
+  while ((argstr[index] >= '0') && (argstr[index] <= '9') &&
+         (value <= MAX_DUMP_DEPTH)) {
+    value = 10 * value + (uint_t) (argstr[index] - '0');
+    index++;
+  } /* end while */
+  
+  if ((index == 0) || (argstr[index] != ASCII_NUL) ||
+      (value == 0) || (value > MAX_DUMP_DEPTH)) {
+    report_invalid_option(argstr);
+  }
+  else {
+    m2c_compiler_option_set_dump_depth(value);
+  } /* end if */
+  
+  return cli_next_token();
+} /* end parse_dump_filter */
+
+
+/* ---------------------------------------------------------------------------
+ * function parse_worker_cache(token)
+ * ---------------------------------------------------------------------------
+ * workerCache :
+ *   --worker-cache <platform dependent path/filename>
+ *   ;
+ *
+ * Sets the path of the string snapshot to be mapped at startup,  passed by
+ * m2make to its workers.
+ * ------------------------------------------------------------------------ */
+
+cli_token_t parse_worker_cache (cli_token_t token) {
+  const char *argstr;
+  
+  if (m2c_compiler_option_worker_cache() != NULL) {
+    report_duplicate_option(cli_last_arg());
+  } /* end if */
+  
+  /* path/filename */
+  token = cli_next_token();
+  argstr = cli_last_arg();
+  
+  if ((token == CLI_TOKEN_END_OF_INPUT) || (argstr == NULL)) {
+    report_missing_worker_cache_path();
+    return token;
+  } /* end if */
+  
+  m2c_compiler_option_set_worker_cache(argstr);
+  
+  return cli_next_token();
+} /* end parse_worker_cache */
+
+
 /* ---------------------------------------------------------------------------
  * procedure set_option(option)
  * ---------------------------------------------------------------------------
@@ -554,6 +1065,105 @@ static void report_missing_source_file (void) {
 } /* end report_missing_source_file */
 
 
+/* ---------------------------------------------------------------------------
+ * procedure report_unreadable_response_file(path)
+ * ---------------------------------------------------------------------------
+ * Reports response file path as not readable to the console.
+ * ------------------------------------------------------------------------ */
+
+static void report_unreadable_response_file (const char *path) {
+
+  printf("unable to read response file %s\n", path);
+  err_count++;
+  
+} /* end report_unreadable_response_file */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure report_invalid_response_entry(path, line_no)
+ * ---------------------------------------------------------------------------
+ * Reports an invalid entry in line line_no of response file path.
+ * ------------------------------------------------------------------------ */
+
+static void report_invalid_response_entry (const char *path, unsigned line_no) {
+
+  printf("invalid source file in line %u of response file %s\n",
+    line_no, path);
+  err_count++;
+  
+} /* end report_invalid_response_entry */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure report_too_many_source_files(path)
+ * ---------------------------------------------------------------------------
+ * Reports that source file path could not be added to the source list.
+ * ------------------------------------------------------------------------ */
+
+static void report_too_many_source_files (const char *path) {
+
+  printf("out of memory for source file %s\n", path);
+  err_count++;
+  
+} /* end report_too_many_source_files */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure report_missing_trace_path
+ * ---------------------------------------------------------------------------
+ * Reports missing path argument of option --trace to the console.
+ * ------------------------------------------------------------------------ */
+
+static void report_missing_trace_path (void) {
+
+  printf("missing trace file path after option --trace\n");
+  err_count++;
+  
+} /* end report_missing_trace_path */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure report_missing_dump_argument(optstr)
+ * ---------------------------------------------------------------------------
+ * Reports missing argument of dump filter option optstr to the console.
+ * ------------------------------------------------------------------------ */
+
+static void report_missing_dump_argument (const char *optstr) {
+
+  printf("missing argument after option %s\n", optstr);
+  err_count++;
+  
+} /* end report_missing_dump_argument */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure report_missing_worker_cache_path
+ * ---------------------------------------------------------------------------
+ * Reports missing path argument of option --worker-cache to the console.
+ * ------------------------------------------------------------------------ */
+
+static void report_missing_worker_cache_path (void) {
+
+  printf("missing cache file path after option --worker-cache\n");
+  err_count++;
+  
+} /* end report_missing_worker_cache_path */
+
+
+/* ---------------------------------------------------------------------------
+ * procedure report_missing_limit(optstr)
+ * ---------------------------------------------------------------------------
+ * Reports missing limit argument of option optstr to the console.
+ * ------------------------------------------------------------------------ */
+
+static void report_missing_limit (const char *optstr) {
+
+  printf("missing limit after option %s\n", optstr);
+  err_count++;
+  
+} /* end report_missing_limit */
+
+
 /* ---------------------------------------------------------------------------
  * procedure report_missing_dependency_for(argstr, depstr)
  * ---------------------------------------------------------------------------
@@ -569,4 +1179,18 @@ static void report_missing_dependency_for
 } /* end report_missing_dependency_for */
 
 
+/* ---------------------------------------------------------------------------
+ * procedure report_unsupported_option(argstr)
+ * ---------------------------------------------------------------------------
+ * Reports argstr as an option not supported by this driver to the console.
+ * ------------------------------------------------------------------------ */
+
+static void report_unsupported_option (const char *argstr) {
+  
+  printf("option %s not supported by this driver yet\n", argstr);
+  err_count++;
+  
+} /* end report_unsupported_option */
+
+
 /* END OF FILE */
\ No newline at end of file
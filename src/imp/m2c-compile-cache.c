@@ -0,0 +1,733 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-compile-cache.c                                                       *
+ *                                                                           *
+ * Implementation of local compile cache module.                             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* getpid, mkdir, rmdir */
+#endif
+
+#include "m2c-compile-cache.h"
+#include "hash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+
+/* --------------------------------------------------------------------------
+ * Options that do not affect the outputs of a compilation
+ * ----------------------------------------------------------------------- */
+
+#define DIAGNOSTIC_OPTIONS \
+  ((1UL << M2C_COMPILER_OPTION_VERBOSE) | \
+   (1UL << M2C_COMPILER_OPTION_LEXER_DEBUG) | \
+   (1UL << M2C_COMPILER_OPTION_PARSER_DEBUG) | \
+   (1UL << M2C_COMPILER_OPTION_SHOW_SETTINGS) | \
+   (1UL << M2C_COMPILER_OPTION_ERRANT_SEMICOLONS) | \
+   (1UL << M2C_COMPILER_OPTION_INTSTR_STATS) | \
+   (1UL << M2C_COMPILER_OPTION_PARSER_PROFILE) | \
+   (1UL << M2C_COMPILER_OPTION_TIME_REPORT) | \
+   (1UL << M2C_COMPILER_OPTION_TELEMETRY) | \
+   (1UL << M2C_COMPILER_OPTION_MEM_REPORT) | \
+   (1UL << M2C_COMPILER_OPTION_PERF_COUNTERS) | \
+   (1UL << M2C_COMPILER_OPTION_COMPILE_CACHE))
+
+
+/* --------------------------------------------------------------------------
+ * Seed of the second lane of key computations
+ * ----------------------------------------------------------------------- */
+
+#define KEY_SECRET 0x589965cc75374cc3ULL
+
+
+/* --------------------------------------------------------------------------
+ * Size of the buffer for reading sources and copying outputs
+ * ----------------------------------------------------------------------- */
+
+#define COPY_BUFFER_SIZE 65536
+
+
+/* --------------------------------------------------------------------------
+ * Length of a key in hexadecimal digits
+ * ----------------------------------------------------------------------- */
+
+#define KEY_DIGITS 32
+
+
+/* --------------------------------------------------------------------------
+ * Filenames of outputs within an entry,  indexed by m2c_cache_output_t
+ * ----------------------------------------------------------------------- */
+
+static const char *const output_name[] = {
+  /* C_SOURCE */ "c",
+  /* C_HEADER */ "h",
+  /* SYMFILE */ "sym",
+  /* EXPORT_LIST */ "exl",
+  /* EXPORT_TABLE */ "exlb",
+  /* OBJECT */ "o"
+}; /* output_name */
+
+
+/* --------------------------------------------------------------------------
+ * type key_state_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a key computation.  Input is processed in
+ * blocks of sixteen bytes by two independently seeded lanes of the mixing
+ * function of hash.h,  each lane yields one half of the key.  Array block
+ * holds an incomplete block of fill bytes.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lane */    uint64_t lane[2];
+  /* length */  uint64_t length;
+  /* block */   unsigned char block[16];
+  /* fill */    uint_t fill;
+} key_state_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void key_reset (key_state_t *state);
+
+static void key_add_bytes
+  (key_state_t *state, const void *data, size_t length);
+
+static void key_add_word (key_state_t *state, uint64_t word);
+
+static void key_finish (key_state_t *state, m2c_cache_key_t *key);
+
+static char *new_entry_path
+  (const char *cache_dir, const m2c_cache_key_t *key, const char *tail);
+
+static char *new_file_path (const char *dir_path, const char *name);
+
+static bool make_dir (const char *path);
+
+static bool copy_file (const char *from_path, const char *to_path);
+
+static void remove_entry (const char *entry_path);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_cache_dir()
+ * --------------------------------------------------------------------------
+ * Returns the path of the cache directory.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_cache_dir (void) {
+  
+  const char *dir;
+  
+  dir = getenv(M2C_CACHE_DIR_ENV);
+  
+  if ((dir == NULL) || (dir[0] == ASCII_NUL)) {
+    return M2C_CACHE_DEFAULT_DIR;
+  } /* end if */
+  
+  return dir;
+} /* end m2c_cache_dir */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_cache_module_key(srcpath, options, count, ..., key, status)
+ * --------------------------------------------------------------------------
+ * Computes the cache key of a module.  The format version,  the compiler
+ * version and the effective options are hashed first,  then the contents of
+ * the source file,  its length and the imports.  Identifiers are hashed with
+ * their length so that no two lists of imports hash the same input.
+ * ----------------------------------------------------------------------- */
+
+void m2c_cache_module_key
+  (const char *srcpath,
+   m2c_compiler_options_t options,
+   uint_t count,
+   const intstr_t import_id[],
+   const m2c_digest_value_t fingerprint[],
+   m2c_cache_key_t *key,
+   m2c_cache_status_t *status) {
+  
+  unsigned char *buffer;
+  key_state_t state;
+  size_t length;
+  uint_t index;
+  FILE *source;
+  
+  /* check pre-conditions */
+  if ((srcpath == NULL) || (key == NULL) || ((count > 0) &&
+      ((import_id == NULL) || (fingerprint == NULL)))) {
+    SET_STATUS(status, M2C_CACHE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  buffer = malloc(COPY_BUFFER_SIZE);
+  
+  if (buffer == NULL) {
+    SET_STATUS(status, M2C_CACHE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  source = fopen(srcpath, "rb");
+  
+  if (source == NULL) {
+    free(buffer);
+    SET_STATUS(status, M2C_CACHE_STATUS_FILE_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  key_reset(&state);
+  key_add_word(&state, M2C_CACHE_FORMAT_VERSION);
+  key_add_bytes(&state, M2C_VERSION, sizeof(M2C_VERSION));
+  key_add_word(&state, (uint64_t) (options & ~DIAGNOSTIC_OPTIONS));
+  
+  /* source contents */
+  while ((length = fread(buffer, 1, COPY_BUFFER_SIZE, source)) > 0) {
+    key_add_bytes(&state, buffer, length);
+  } /* end while */
+  
+  if (ferror(source)) {
+    fclose(source);
+    free(buffer);
+    SET_STATUS(status, M2C_CACHE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  fclose(source);
+  free(buffer);
+  
+  /* the source length separates the contents from the imports */
+  key_add_word(&state, state.length);
+  
+  /* imports and their effective interface fingerprints */
+  key_add_word(&state, count);
+  for (index = 0; index < count; index++) {
+    key_add_word(&state, intstr_length(import_id[index]));
+    key_add_bytes(&state, intstr_char_ptr(import_id[index]),
+      intstr_length(import_id[index]));
+    key_add_word(&state, fingerprint[index]);
+  } /* end for */
+  
+  key_finish(&state, key);
+  
+  SET_STATUS(status, M2C_CACHE_STATUS_SUCCESS);
+} /* end m2c_cache_module_key */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_cache_fetch(cache_dir, key, output_path, status)
+ * --------------------------------------------------------------------------
+ * Copies the requested outputs of the entry for key into place.  All outputs
+ * of the entry are checked before the first one is copied,  so that a miss
+ * leaves all outputs untouched.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_cache_fetch
+  (const char *cache_dir,
+   const m2c_cache_key_t *key,
+   const char *const output_path[],
+   m2c_cache_status_t *status) {
+  
+  char *entry_path, *path[M2C_CACHE_OUTPUT_END_MARK];
+  uint_t index;
+  bool hit;
+  
+  /* check pre-conditions */
+  if ((cache_dir == NULL) || (key == NULL) || (output_path == NULL)) {
+    SET_STATUS(status, M2C_CACHE_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  entry_path = new_entry_path(cache_dir, key, "");
+  
+  if (entry_path == NULL) {
+    SET_STATUS(status, M2C_CACHE_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  /* every requested output must be present */
+  hit = true;
+  for (index = 0; index < M2C_CACHE_OUTPUT_END_MARK; index++) {
+    path[index] = NULL;
+    if (hit && (output_path[index] != NULL)) {
+      path[index] = new_file_path(entry_path, output_name[index]);
+      hit = (path[index] != NULL) && (access(path[index], R_OK) == 0);
+    } /* end if */
+  } /* end for */
+  
+  SET_STATUS(status, M2C_CACHE_STATUS_SUCCESS);
+  
+  for (index = 0; hit && (index < M2C_CACHE_OUTPUT_END_MARK); index++) {
+    if ((path[index] != NULL) &&
+        NOT(copy_file(path[index], output_path[index]))) {
+      SET_STATUS(status, M2C_CACHE_STATUS_IO_ERROR);
+      hit = false;
+    } /* end if */
+  } /* end for */
+  
+  for (index = 0; index < M2C_CACHE_OUTPUT_END_MARK; index++) {
+    free(path[index]);
+  } /* end for */
+  
+  free(entry_path);
+  
+  return hit;
+} /* end m2c_cache_fetch */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_cache_store(cache_dir, key, output_path, status)
+ * --------------------------------------------------------------------------
+ * Stores the given outputs as a new entry for key.  The outputs are copied
+ * into a directory of a name unique to this process,  which is then renamed
+ * to the name of the entry.  If another process stored the entry first,
+ * the rename fails and the copy is removed.
+ * ----------------------------------------------------------------------- */
+
+void m2c_cache_store
+  (const char *cache_dir,
+   const m2c_cache_key_t *key,
+   const char *const output_path[],
+   m2c_cache_status_t *status) {
+  
+  char *fanout_path, *entry_path, *temp_path, *path, tail[32];
+  uint_t index;
+  bool success;
+  
+  /* check pre-conditions */
+  if ((cache_dir == NULL) || (key == NULL) || (output_path == NULL)) {
+    SET_STATUS(status, M2C_CACHE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  sprintf(tail, ".tmp%ld", (long) getpid());
+  
+  fanout_path = new_entry_path(cache_dir, key, NULL);
+  entry_path = new_entry_path(cache_dir, key, "");
+  temp_path = new_entry_path(cache_dir, key, tail);
+  
+  if ((fanout_path == NULL) || (entry_path == NULL) || (temp_path == NULL)) {
+    free(fanout_path);
+    free(entry_path);
+    free(temp_path);
+    SET_STATUS(status, M2C_CACHE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* an existing entry is never replaced */
+  if (access(entry_path, F_OK) == 0) {
+    free(fanout_path);
+    free(entry_path);
+    free(temp_path);
+    SET_STATUS(status, M2C_CACHE_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  success = make_dir(cache_dir) && make_dir(fanout_path) &&
+    make_dir(temp_path);
+  
+  for (index = 0; success && (index < M2C_CACHE_OUTPUT_END_MARK); index++) {
+    if (output_path[index] != NULL) {
+      path = new_file_path(temp_path, output_name[index]);
+      success = (path != NULL) && copy_file(output_path[index], path);
+      free(path);
+    } /* end if */
+  } /* end for */
+  
+  if (success) {
+    if (rename(temp_path, entry_path) != 0) {
+      /* stored by another process meanwhile */
+      success = (access(entry_path, F_OK) == 0);
+      remove_entry(temp_path);
+    } /* end if */
+  }
+  else {
+    remove_entry(temp_path);
+  } /* end if */
+  
+  free(fanout_path);
+  free(entry_path);
+  free(temp_path);
+  
+  if (NOT(success)) {
+    SET_STATUS(status, M2C_CACHE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_CACHE_STATUS_SUCCESS);
+} /* end m2c_cache_store */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_cache_new_output_path(cache_dir, key, output)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path of the file holding output in an entry.
+ * ----------------------------------------------------------------------- */
+
+char *m2c_cache_new_output_path
+  (const char *cache_dir,
+   const m2c_cache_key_t *key,
+   m2c_cache_output_t output) {
+  
+  char *entry_path, *path;
+  
+  if ((cache_dir == NULL) || (key == NULL) ||
+      (output >= M2C_CACHE_OUTPUT_END_MARK)) {
+    return NULL;
+  } /* end if */
+  
+  entry_path = new_entry_path(cache_dir, key, "");
+  
+  if (entry_path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  path = new_file_path(entry_path, output_name[output]);
+  free(entry_path);
+  
+  return path;
+} /* end m2c_cache_new_output_path */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_cache_blob_name(key, output, name)
+ * --------------------------------------------------------------------------
+ * Passes the name of output in the entry for key in name.
+ * ----------------------------------------------------------------------- */
+
+void m2c_cache_blob_name
+  (const m2c_cache_key_t *key, m2c_cache_output_t output, char *name) {
+  
+  if ((key == NULL) || (name == NULL) ||
+      (output >= M2C_CACHE_OUTPUT_END_MARK)) {
+    return;
+  } /* end if */
+  
+  sprintf(name, "%016llx%016llx/%s", (unsigned long long) key->high,
+    (unsigned long long) key->low, output_name[output]);
+} /* end m2c_cache_blob_name */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure key_reset(state)
+ * --------------------------------------------------------------------------
+ * Initialises state for a new key computation.
+ * ----------------------------------------------------------------------- */
+
+static void key_reset (key_state_t *state) {
+  
+  state->lane[0] = HASH_SECRET0;
+  state->lane[1] = HASH_SECRET2;
+  state->length = 0;
+  state->fill = 0;
+} /* end key_reset */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure key_add_bytes(state, data, length)
+ * --------------------------------------------------------------------------
+ * Adds length bytes at data to the key computation of state.
+ * ----------------------------------------------------------------------- */
+
+static void key_add_bytes
+  (key_state_t *state, const void *data, size_t length) {
+  
+  const unsigned char *next;
+  uint64_t word0, word1;
+  size_t chunk;
+  
+  next = (const unsigned char *) data;
+  state->length = state->length + length;
+  
+  while (length > 0) {
+    chunk = 16 - state->fill;
+    if (chunk > length) {
+      chunk = length;
+    } /* end if */
+    
+    memcpy(state->block + state->fill, next, chunk);
+    state->fill = state->fill + (uint_t) chunk;
+    next = next + chunk;
+    length = length - chunk;
+    
+    /* mix each complete block into both lanes */
+    if (state->fill == 16) {
+      word0 = hash_load64(state->block);
+      word1 = hash_load64(state->block + 8);
+      state->lane[0] =
+        hash_mum(word0 ^ HASH_SECRET1, word1 ^ state->lane[0]);
+      state->lane[1] =
+        hash_mum(word1 ^ KEY_SECRET, word0 ^ state->lane[1]);
+      state->fill = 0;
+    } /* end if */
+  } /* end while */
+} /* end key_add_bytes */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure key_add_word(state, word)
+ * --------------------------------------------------------------------------
+ * Adds word to the key computation of state as eight bytes,  least
+ * significant byte first.
+ * ----------------------------------------------------------------------- */
+
+static void key_add_word (key_state_t *state, uint64_t word) {
+  
+  unsigned char bytes[8];
+  uint_t index;
+  
+  for (index = 0; index < 8; index++) {
+    bytes[index] = (unsigned char) (word >> (8 * index));
+  } /* end for */
+  
+  key_add_bytes(state, bytes, 8);
+} /* end key_add_word */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure key_finish(state, key)
+ * --------------------------------------------------------------------------
+ * Mixes any incomplete block and the total length into both lanes of state
+ * and passes the resulting key in key.
+ * ----------------------------------------------------------------------- */
+
+static void key_finish (key_state_t *state, m2c_cache_key_t *key) {
+  
+  uint64_t word0, word1, length;
+  
+  length = state->length;
+  
+  /* pad the last block with zeroes */
+  memset(state->block + state->fill, 0, 16 - state->fill);
+  word0 = hash_load64(state->block);
+  word1 = hash_load64(state->block + 8);
+  
+  key->high = hash_mum(word0 ^ HASH_SECRET1, word1 ^ state->lane[0]);
+  key->high = hash_mum(key->high ^ HASH_SECRET2, length ^ HASH_SECRET1);
+  key->low = hash_mum(word1 ^ KEY_SECRET, word0 ^ state->lane[1]);
+  key->low = hash_mum(key->low ^ HASH_SECRET0, length ^ KEY_SECRET);
+} /* end key_finish */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_entry_path(cache_dir, key, tail)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path  cache_dir/XX/XXXX...tail  where the X are
+ * the hexadecimal digits of key.  If tail is NULL,  returns the path of the
+ * fan-out directory  cache_dir/XX.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_entry_path
+  (const char *cache_dir, const m2c_cache_key_t *key, const char *tail) {
+  
+  char digits[KEY_DIGITS + 1], *path;
+  size_t dir_length, tail_length;
+  
+  sprintf(digits, "%016llx%016llx",
+    (unsigned long long) key->high, (unsigned long long) key->low);
+  
+  dir_length = strlen(cache_dir);
+  tail_length = (tail == NULL) ? 0 : strlen(tail);
+  path = malloc(dir_length + KEY_DIGITS + tail_length + 5);
+  
+  if (path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(path, cache_dir, dir_length);
+  path[dir_length] = '/';
+  path[dir_length + 1] = digits[0];
+  path[dir_length + 2] = digits[1];
+  
+  if (tail == NULL) {
+    path[dir_length + 3] = ASCII_NUL;
+    return path;
+  } /* end if */
+  
+  path[dir_length + 3] = '/';
+  memcpy(path + dir_length + 4, digits, KEY_DIGITS);
+  memcpy(path + dir_length + 4 + KEY_DIGITS, tail, tail_length + 1);
+  
+  return path;
+} /* end new_entry_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_file_path(dir_path, name)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path  dir_path/name,  or NULL if allocation
+ * failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_file_path (const char *dir_path, const char *name) {
+  
+  size_t dir_length, name_length;
+  char *path;
+  
+  dir_length = strlen(dir_path);
+  name_length = strlen(name);
+  path = malloc(dir_length + name_length + 2);
+  
+  if (path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(path, dir_path, dir_length);
+  path[dir_length] = '/';
+  memcpy(path + dir_length + 1, name, name_length + 1);
+  
+  return path;
+} /* end new_file_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function make_dir(path)
+ * --------------------------------------------------------------------------
+ * Creates a directory at path unless it exists.  Returns true on success
+ * or if the directory exists,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool make_dir (const char *path) {
+  
+  if (mkdir(path, 0777) == 0) {
+    return true;
+  } /* end if */
+  
+  return (errno == EEXIST);
+} /* end make_dir */
+
+
+/* --------------------------------------------------------------------------
+ * private function copy_file(from_path, to_path)
+ * --------------------------------------------------------------------------
+ * Copies the file at from_path to a temporary file next to to_path,  then
+ * renames it to to_path.  Returns true on success,  false on failure,  in
+ * which case the file at to_path is left untouched.
+ * ----------------------------------------------------------------------- */
+
+static bool copy_file (const char *from_path, const char *to_path) {
+  
+  char *buffer, *temp_path, tail[32];
+  FILE *from_file, *to_file;
+  size_t length;
+  bool success;
+  
+  sprintf(tail, ".tmp%ld", (long) getpid());
+  temp_path = malloc(strlen(to_path) + strlen(tail) + 1);
+  buffer = malloc(COPY_BUFFER_SIZE);
+  
+  if ((temp_path == NULL) || (buffer == NULL)) {
+    free(temp_path);
+    free(buffer);
+    return false;
+  } /* end if */
+  
+  strcpy(temp_path, to_path);
+  strcat(temp_path, tail);
+  
+  from_file = fopen(from_path, "rb");
+  to_file = (from_file == NULL) ? NULL : fopen(temp_path, "wb");
+  success = (to_file != NULL);
+  
+  while (success &&
+      ((length = fread(buffer, 1, COPY_BUFFER_SIZE, from_file)) > 0)) {
+    success = (fwrite(buffer, 1, length, to_file) == length);
+  } /* end while */
+  
+  if (from_file != NULL) {
+    success = success && NOT(ferror(from_file));
+    fclose(from_file);
+  } /* end if */
+  
+  if (to_file != NULL) {
+    success = (fclose(to_file) == 0) && success;
+    
+    if (success) {
+      success = (rename(temp_path, to_path) == 0);
+    } /* end if */
+    
+    if (NOT(success)) {
+      remove(temp_path);
+    } /* end if */
+  } /* end if */
+  
+  free(temp_path);
+  free(buffer);
+  
+  return success;
+} /* end copy_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure remove_entry(entry_path)
+ * --------------------------------------------------------------------------
+ * Removes the output files of the entry directory at entry_path  and the
+ * directory itself.
+ * ----------------------------------------------------------------------- */
+
+static void remove_entry (const char *entry_path) {
+  
+  uint_t index;
+  char *path;
+  
+  for (index = 0; index < M2C_CACHE_OUTPUT_END_MARK; index++) {
+    path = new_file_path(entry_path, output_name[index]);
+    if (path != NULL) {
+      remove(path);
+      free(path);
+    } /* end if */
+  } /* end for */
+  
+  rmdir(entry_path);
+} /* end remove_entry */
+
+
+/* END OF FILE */
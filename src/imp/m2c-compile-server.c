@@ -0,0 +1,1119 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-compile-server.c                                                      *
+ *                                                                           *
+ * Implementation of resident compile server module.                         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-compile-server.h"
+#include "m2c-compiler-options.h"
+#include "interned-strings.h"
+#include "fileutils.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (M2C_COMPILE_SERVER)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#endif
+
+#if (M2C_SYMFILE_THREAD_SAFE)
+#include <pthread.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Request magic number,  "M2CS" in ASCII
+ * ----------------------------------------------------------------------- */
+
+#define REQUEST_MAGIC 0x5343324dUL
+
+
+/* --------------------------------------------------------------------------
+ * Maximum size of the payload of a request
+ * ----------------------------------------------------------------------- */
+
+#define REQUEST_MAX_PAYLOAD (1024 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of pending connections
+ * ----------------------------------------------------------------------- */
+
+#define LISTEN_BACKLOG 16
+
+
+/* --------------------------------------------------------------------------
+ * Initial number of entries and slots of the interface table
+ * ----------------------------------------------------------------------- */
+
+#define IFACE_INITIAL_CAPACITY 64
+
+#define IFACE_INITIAL_SLOT_COUNT 128
+
+
+/* --------------------------------------------------------------------------
+ * type request_kind_t
+ * --------------------------------------------------------------------------
+ * Kinds of requests.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  REQUEST_COMPILE,
+  REQUEST_SHUTDOWN
+} request_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * type request_header_t
+ * --------------------------------------------------------------------------
+ * Record type for the header of a request.  The header is followed by
+ * length bytes of payload,  the working directory of the client and argc
+ * arguments,  each NUL terminated.  A compile request carries the standard
+ * output and error descriptors of the client as ancillary data.  The reply
+ * to a compile request is the exit code as a 32-bit integer.  Both sides run
+ * on the same host,  thus all fields are in host byte order.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* magic */    uint32_t magic;
+  /* version */  uint32_t version;
+  /* kind */     uint32_t kind;
+  /* argc */     uint32_t argc;
+  /* length */   uint32_t length;
+} request_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * type iface_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for an entry of the interface table,  an open symbol file with
+ * the modification time and size of its file when it was opened.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* path */     intstr_t path;
+  /* symfile */  m2c_symfile_t symfile;
+  /* mtime */    long int mtime;
+  /* size */     long int size;
+} iface_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variable server_active
+ * --------------------------------------------------------------------------
+ * True while m2c_server_run is serving requests.
+ * ----------------------------------------------------------------------- */
+
+static bool server_active = false;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variable shared_search_path
+ * --------------------------------------------------------------------------
+ * Module search path of the process,  or NULL if none has been requested.
+ * ----------------------------------------------------------------------- */
+
+static m2c_search_path_t shared_search_path = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variables of the interface table
+ * --------------------------------------------------------------------------
+ * Open addressing hash table of the symbol files imported within a server,
+ * keyed on interned pathnames.  Slots hold entry index + 1,  zero is empty.
+ * ----------------------------------------------------------------------- */
+
+static iface_entry_t *iface_entry = NULL;
+
+static uint_t iface_count = 0;
+
+static uint_t iface_capacity = 0;
+
+static uint_t *iface_slot = NULL;
+
+static uint_t iface_slot_count = 0;
+
+#if (M2C_SYMFILE_THREAD_SAFE)
+static pthread_mutex_t iface_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_COMPILE_SERVER)
+static int connect_to_server
+  (const char *socket_path, m2c_server_status_t *status);
+
+static bool send_request
+  (int socket_fd, request_kind_t kind,
+   uint_t argc, const char *payload, size_t length);
+
+static void serve_connection
+  (int conn_fd, m2c_server_handler_t handler, void *context, bool *shutdown);
+
+static int run_request
+  (const char *payload, uint_t argc, int out_fd, int err_fd,
+   m2c_server_handler_t handler, void *context);
+
+static uint_t string_count (const char *payload, size_t length);
+
+static bool recv_all (int socket_fd, void *buffer, size_t length);
+
+static bool send_all (int socket_fd, const void *buffer, size_t length);
+#endif
+
+static iface_entry_t *iface_entry_for_path (intstr_t path);
+
+static bool grow_iface_slots (void);
+
+static void release_iface_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_socket_path()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path of the server socket.
+ * ----------------------------------------------------------------------- */
+
+char *m2c_server_socket_path (void) {
+  
+#if (M2C_COMPILE_SERVER)
+  const char *env, *tmpdir;
+  size_t length;
+  char *path;
+  
+  env = getenv(M2C_SERVER_SOCKET_ENV);
+  
+  if ((env != NULL) && (env[0] != ASCII_NUL)) {
+    length = strlen(env);
+    path = malloc(length + 1);
+    if (path != NULL) {
+      memcpy(path, env, length + 1);
+    } /* end if */
+    return path;
+  } /* end if */
+  
+  tmpdir = getenv("TMPDIR");
+  if ((tmpdir == NULL) || (tmpdir[0] == ASCII_NUL)) {
+    tmpdir = "/tmp";
+  } /* end if */
+  
+  /* tmpdir + "/m2c-server-" + uid + ".sock" */
+  length = strlen(tmpdir) + 32;
+  path = malloc(length);
+  
+  if (path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  snprintf(path, length,
+    "%s/m2c-server-%lu.sock", tmpdir, (unsigned long) getuid());
+  
+  return path;
+#else
+  return NULL;
+#endif
+} /* end m2c_server_socket_path */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_server_run(socket_path, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Listens on socket_path and runs requests until shutdown or idle timeout.
+ * ----------------------------------------------------------------------- */
+
+void m2c_server_run
+  (const char *socket_path,
+   m2c_server_handler_t handler,
+   void *context,
+   m2c_server_status_t *status) {
+  
+#if (M2C_COMPILE_SERVER)
+  m2c_server_status_t probe_status;
+  struct sockaddr_un address;
+  struct pollfd poll_fd;
+  int listen_fd, conn_fd, ready;
+  mode_t saved_mask;
+  bool shutdown;
+  
+  /* check pre-conditions */
+  if ((socket_path == NULL) || (handler == NULL)) {
+    SET_STATUS(status, M2C_SERVER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (strlen(socket_path) >= sizeof(address.sun_path)) {
+    SET_STATUS(status, M2C_SERVER_STATUS_PATH_TOO_LONG);
+    return;
+  } /* end if */
+  
+  /* a socket nobody listens on was left by a terminated server */
+  conn_fd = connect_to_server(socket_path, &probe_status);
+  
+  if (conn_fd >= 0) {
+    close(conn_fd);
+    SET_STATUS(status, M2C_SERVER_STATUS_ALREADY_RUNNING);
+    return;
+  } /* end if */
+  
+  unlink(socket_path);
+  
+  listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  
+  if (listen_fd < 0) {
+    SET_STATUS(status, M2C_SERVER_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  memset(&address, 0, sizeof(struct sockaddr_un));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socket_path);
+  
+  /* only the owner may connect */
+  saved_mask = umask(077);
+  
+  if ((bind(listen_fd,
+        (struct sockaddr *) &address, sizeof(struct sockaddr_un)) != 0) ||
+      (listen(listen_fd, LISTEN_BACKLOG) != 0)) {
+    umask(saved_mask);
+    close(listen_fd);
+    SET_STATUS(status, M2C_SERVER_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  umask(saved_mask);
+  fcntl(listen_fd, F_SETFD, FD_CLOEXEC);
+  
+  /* a client that goes away must not terminate the server */
+  signal(SIGPIPE, SIG_IGN);
+  
+  server_active = true;
+  shutdown = false;
+  
+  while (NOT(shutdown)) {
+    poll_fd.fd = listen_fd;
+    poll_fd.events = POLLIN;
+    ready = poll(&poll_fd, 1, M2C_SERVER_IDLE_TIMEOUT * 1000);
+    
+    if (ready == 0) {
+      /* idle timeout */
+      break;
+    } /* end if */
+    
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      } /* end if */
+      break;
+    } /* end if */
+    
+    conn_fd = accept(listen_fd, NULL, NULL);
+    
+    if (conn_fd >= 0) {
+      fcntl(conn_fd, F_SETFD, FD_CLOEXEC);
+      serve_connection(conn_fd, handler, context, &shutdown);
+      close(conn_fd);
+    } /* end if */
+  } /* end while */
+  
+  server_active = false;
+  
+  close(listen_fd);
+  unlink(socket_path);
+  release_iface_table();
+  m2c_release_search_path(&shared_search_path);
+  
+  SET_STATUS(status, M2C_SERVER_STATUS_SUCCESS);
+#else
+  (void) socket_path;
+  (void) handler;
+  (void) context;
+  SET_STATUS(status, M2C_SERVER_STATUS_NOT_AVAILABLE);
+#endif
+} /* end m2c_server_run */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_request(socket_path, argc, argv, exit_code, status)
+ * --------------------------------------------------------------------------
+ * Runs a request on the server at socket_path and waits for its exit code.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_server_request
+  (const char *socket_path,
+   int argc,
+   char *argv[],
+   int *exit_code,
+   m2c_server_status_t *status) {
+  
+#if (M2C_COMPILE_SERVER)
+  size_t length, offset, arg_length;
+  char *payload, *workdir;
+  int socket_fd, index;
+  int32_t reply;
+  bool success;
+  
+  /* check pre-conditions */
+  if ((socket_path == NULL) || (argc < 0) ||
+      ((argc > 0) && (argv == NULL)) || (exit_code == NULL)) {
+    SET_STATUS(status, M2C_SERVER_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  workdir = (char *) new_path_w_current_workdir();
+  
+  if (workdir == NULL) {
+    SET_STATUS(status, M2C_SERVER_STATUS_IO_ERROR);
+    return false;
+  } /* end if */
+  
+  /* payload:  workdir NUL argv[0] NUL ... argv[argc-1] NUL */
+  length = strlen(workdir) + 1;
+  for (index = 0; index < argc; index++) {
+    length = length + strlen(argv[index]) + 1;
+  } /* end for */
+  
+  if (length > REQUEST_MAX_PAYLOAD) {
+    free(workdir);
+    SET_STATUS(status, M2C_SERVER_STATUS_PROTOCOL_ERROR);
+    return false;
+  } /* end if */
+  
+  payload = malloc(length);
+  
+  if (payload == NULL) {
+    free(workdir);
+    SET_STATUS(status, M2C_SERVER_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  offset = strlen(workdir) + 1;
+  memcpy(payload, workdir, offset);
+  for (index = 0; index < argc; index++) {
+    arg_length = strlen(argv[index]) + 1;
+    memcpy(payload + offset, argv[index], arg_length);
+    offset = offset + arg_length;
+  } /* end for */
+  
+  free(workdir);
+  
+  socket_fd = connect_to_server(socket_path, status);
+  
+  if (socket_fd < 0) {
+    free(payload);
+    return false;
+  } /* end if */
+  
+  /* output of the client so far must precede that of the request */
+  fflush(stdout);
+  fflush(stderr);
+  
+  success = send_request(socket_fd,
+    REQUEST_COMPILE, (uint_t) argc, payload, length);
+  free(payload);
+  
+  success = success && recv_all(socket_fd, &reply, sizeof(int32_t));
+  close(socket_fd);
+  
+  if (NOT(success)) {
+    SET_STATUS(status, M2C_SERVER_STATUS_PROTOCOL_ERROR);
+    return false;
+  } /* end if */
+  
+  *exit_code = (int) reply;
+  
+  SET_STATUS(status, M2C_SERVER_STATUS_SUCCESS);
+  return true;
+#else
+  (void) socket_path;
+  (void) argc;
+  (void) argv;
+  (void) exit_code;
+  SET_STATUS(status, M2C_SERVER_STATUS_NOT_AVAILABLE);
+  return false;
+#endif
+} /* end m2c_server_request */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_server_shutdown(socket_path, status)
+ * --------------------------------------------------------------------------
+ * Requests the server listening at socket_path to terminate.
+ * ----------------------------------------------------------------------- */
+
+void m2c_server_shutdown
+  (const char *socket_path, m2c_server_status_t *status) {
+  
+#if (M2C_COMPILE_SERVER)
+  int socket_fd;
+  bool success;
+  
+  /* check pre-conditions */
+  if (socket_path == NULL) {
+    SET_STATUS(status, M2C_SERVER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  socket_fd = connect_to_server(socket_path, status);
+  
+  if (socket_fd < 0) {
+    return;
+  } /* end if */
+  
+  success = send_request(socket_fd, REQUEST_SHUTDOWN, 0, NULL, 0);
+  close(socket_fd);
+  
+  if (NOT(success)) {
+    SET_STATUS(status, M2C_SERVER_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_SERVER_STATUS_SUCCESS);
+#else
+  (void) socket_path;
+  SET_STATUS(status, M2C_SERVER_STATUS_NOT_AVAILABLE);
+#endif
+} /* end m2c_server_shutdown */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_import_symfile(path, status)
+ * --------------------------------------------------------------------------
+ * Returns the shared open symbol file for path,  kept across requests.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_server_import_symfile
+  (const char *path, m2c_symfile_status_t *status) {
+  
+  m2c_symfile_status_t open_status;
+  m2c_symfile_t symfile;
+  iface_entry_t *entry;
+  file_info_t info;
+  intstr_t ipath;
+  
+  /* outside of a server,  the import cache of the symfile module suffices */
+  if (NOT(server_active)) {
+    return m2c_import_symfile(path, status);
+  } /* end if */
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  if (NOT(get_file_info(path, &info)) || (info.type != FILE_TYPE_REGULAR)) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_IO_ERROR);
+    return NULL;
+  } /* end if */
+  
+  ipath = intstr_for_cstr(path, NULL);
+  
+  if (ipath == NULL) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_lock(&iface_lock);
+#endif
+  
+  entry = iface_entry_for_path(ipath);
+  
+  if (entry == NULL) {
+#if (M2C_SYMFILE_THREAD_SAFE)
+    pthread_mutex_unlock(&iface_lock);
+#endif
+    SET_STATUS(status, M2C_SYMFILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* reopen a symbol file whose file has been rewritten */
+  if ((entry->symfile != NULL) &&
+      ((entry->mtime != info.timestamp) || (entry->size != info.size))) {
+    m2c_release_symfile(entry->symfile);
+    entry->symfile = NULL;
+  } /* end if */
+  
+  if (entry->symfile == NULL) {
+    /* opened privately,  the table is the cache within a server */
+    entry->symfile = m2c_open_symfile(path, &open_status);
+    entry->mtime = info.timestamp;
+    entry->size = info.size;
+    
+    if (entry->symfile == NULL) {
+#if (M2C_SYMFILE_THREAD_SAFE)
+      pthread_mutex_unlock(&iface_lock);
+#endif
+      SET_STATUS(status, open_status);
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  symfile = entry->symfile;
+  m2c_retain_symfile(symfile);
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_unlock(&iface_lock);
+#endif
+  
+  SET_STATUS(status, M2C_SYMFILE_STATUS_SUCCESS);
+  return symfile;
+} /* end m2c_server_import_symfile */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_search_path(dir_count, dirs, status)
+ * --------------------------------------------------------------------------
+ * Returns the module search path of the process for the directories in
+ * array dirs,  refreshed if it is kept from an earlier call.
+ * ----------------------------------------------------------------------- */
+
+m2c_search_path_t m2c_server_search_path
+  (uint_t dir_count,                      /* in */
+   const char *const dirs[],              /* in */
+   m2c_search_path_status_t *status) {    /* out */
+  
+  m2c_search_path_status_t refresh_status;
+  
+  if ((dirs == NULL) && (dir_count > 0)) {
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  if (m2c_search_path_matches(shared_search_path, dir_count, dirs)) {
+    m2c_search_path_refresh(shared_search_path, &refresh_status);
+    
+    if (refresh_status == M2C_SEARCH_PATH_STATUS_SUCCESS) {
+      SET_STATUS(status, M2C_SEARCH_PATH_STATUS_SUCCESS);
+      return shared_search_path;
+    } /* end if */
+  } /* end if */
+  
+  /* other directories,  or a refresh that left the search path empty */
+  m2c_release_search_path(&shared_search_path);
+  shared_search_path = m2c_new_search_path(dir_count, dirs, status);
+  
+  return shared_search_path;
+} /* end m2c_server_search_path */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#if (M2C_COMPILE_SERVER)
+/* --------------------------------------------------------------------------
+ * private function connect_to_server(socket_path, status)
+ * --------------------------------------------------------------------------
+ * Connects to the server socket at socket_path and returns the connected
+ * socket,  or -1 with M2C_SERVER_STATUS_NOT_RUNNING passed in status if no
+ * server is listening.
+ * ----------------------------------------------------------------------- */
+
+static int connect_to_server
+  (const char *socket_path, m2c_server_status_t *status) {
+  
+  struct sockaddr_un address;
+  int socket_fd;
+  
+  if (strlen(socket_path) >= sizeof(address.sun_path)) {
+    SET_STATUS(status, M2C_SERVER_STATUS_PATH_TOO_LONG);
+    return -1;
+  } /* end if */
+  
+  socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  
+  if (socket_fd < 0) {
+    SET_STATUS(status, M2C_SERVER_STATUS_IO_ERROR);
+    return -1;
+  } /* end if */
+  
+  memset(&address, 0, sizeof(struct sockaddr_un));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socket_path);
+  
+  if (connect(socket_fd,
+      (struct sockaddr *) &address, sizeof(struct sockaddr_un)) != 0) {
+    close(socket_fd);
+    SET_STATUS(status, M2C_SERVER_STATUS_NOT_RUNNING);
+    return -1;
+  } /* end if */
+  
+  fcntl(socket_fd, F_SETFD, FD_CLOEXEC);
+  
+  SET_STATUS(status, M2C_SERVER_STATUS_SUCCESS);
+  return socket_fd;
+} /* end connect_to_server */
+
+
+/* --------------------------------------------------------------------------
+ * private function send_request(socket_fd, kind, argc, payload, length)
+ * --------------------------------------------------------------------------
+ * Sends a request header with length bytes of payload on socket_fd.  A
+ * compile request carries the standard output and error descriptors of the
+ * calling process.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool send_request
+  (int socket_fd, request_kind_t kind,
+   uint_t argc, const char *payload, size_t length) {
+  
+  union {
+    struct cmsghdr align;
+    char data[CMSG_SPACE(2 * sizeof(int))];
+  } control;
+  request_header_t header;
+  struct cmsghdr *cmsg;
+  struct msghdr message;
+  struct iovec iov;
+  int fds[2];
+  
+  header.magic = REQUEST_MAGIC;
+  header.version = M2C_SERVER_PROTOCOL_VERSION;
+  header.kind = kind;
+  header.argc = argc;
+  header.length = (uint32_t) length;
+  
+  iov.iov_base = &header;
+  iov.iov_len = sizeof(request_header_t);
+  
+  memset(&message, 0, sizeof(struct msghdr));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  
+  if (kind == REQUEST_COMPILE) {
+    fds[0] = STDOUT_FILENO;
+    fds[1] = STDERR_FILENO;
+    
+    memset(&control, 0, sizeof(control));
+    message.msg_control = control.data;
+    message.msg_controllen = sizeof(control.data);
+    
+    cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(2 * sizeof(int));
+    memcpy(CMSG_DATA(cmsg), fds, 2 * sizeof(int));
+  } /* end if */
+  
+  if (sendmsg(socket_fd, &message, 0) != (ssize_t) sizeof(request_header_t)) {
+    return false;
+  } /* end if */
+  
+  return (length == 0) || send_all(socket_fd, payload, length);
+} /* end send_request */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure serve_connection(conn_fd, handler, context, shutdown)
+ * --------------------------------------------------------------------------
+ * Receives a request on conn_fd and runs it.  Passes true in shutdown if
+ * it is a shutdown request.  Malformed requests are dropped.
+ * ----------------------------------------------------------------------- */
+
+static void serve_connection
+  (int conn_fd, m2c_server_handler_t handler, void *context, bool *shutdown) {
+  
+  union {
+    struct cmsghdr align;
+    char data[CMSG_SPACE(2 * sizeof(int))];
+  } control;
+  request_header_t header;
+  struct cmsghdr *cmsg;
+  struct msghdr message;
+  struct iovec iov;
+  int fds[2], code;
+  int32_t reply;
+  char *payload;
+  ssize_t received;
+  
+  iov.iov_base = &header;
+  iov.iov_len = sizeof(request_header_t);
+  
+  memset(&message, 0, sizeof(struct msghdr));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data;
+  message.msg_controllen = sizeof(control.data);
+  
+  do {
+    received = recvmsg(conn_fd, &message, 0);
+  } while ((received < 0) && (errno == EINTR));
+  
+  fds[0] = -1;
+  fds[1] = -1;
+  cmsg = CMSG_FIRSTHDR(&message);
+  if ((received > 0) && (cmsg != NULL) &&
+      (cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS) &&
+      (cmsg->cmsg_len == CMSG_LEN(2 * sizeof(int)))) {
+    memcpy(fds, CMSG_DATA(cmsg), 2 * sizeof(int));
+  } /* end if */
+  
+  /* the header is small enough to arrive in one piece */
+  if ((received != (ssize_t) sizeof(request_header_t)) ||
+      (header.magic != REQUEST_MAGIC) ||
+      (header.version != M2C_SERVER_PROTOCOL_VERSION) ||
+      (header.length > REQUEST_MAX_PAYLOAD)) {
+    header.kind = REQUEST_COMPILE;
+    header.length = 0;
+  } /* end if */
+  
+  if (header.kind == REQUEST_SHUTDOWN) {
+    *shutdown = true;
+  }
+  else if ((header.kind == REQUEST_COMPILE) &&
+      (header.length > 0) && (fds[0] >= 0) &&
+      ((payload = malloc(header.length)) != NULL)) {
+    
+    /* the payload must be a sequence of argc + 1 strings */
+    if (recv_all(conn_fd, payload, header.length) &&
+        (payload[header.length - 1] == ASCII_NUL) &&
+        (string_count(payload, header.length) == header.argc + 1)) {
+      code = run_request(payload,
+        header.argc, fds[0], fds[1], handler, context);
+      
+      reply = (int32_t) code;
+      send_all(conn_fd, &reply, sizeof(int32_t));
+    } /* end if */
+    
+    free(payload);
+  } /* end if */
+  
+  if (fds[0] >= 0) {
+    close(fds[0]);
+    close(fds[1]);
+  } /* end if */
+} /* end serve_connection */
+
+
+/* --------------------------------------------------------------------------
+ * private function run_request(payload, argc, out_fd, err_fd, handler, ...)
+ * --------------------------------------------------------------------------
+ * Runs the request in payload by calling handler in the working directory
+ * of the client  with standard output and error redirected to out_fd and
+ * err_fd.  Restores the working directory and standard streams of the
+ * server and returns the exit code of the request.
+ * ----------------------------------------------------------------------- */
+
+static int run_request
+  (const char *payload, uint_t argc, int out_fd, int err_fd,
+   m2c_server_handler_t handler, void *context) {
+  
+  int saved_dir, saved_out, saved_err, code;
+  const char *workdir, *next;
+  char **argv;
+  uint_t index;
+  
+  argv = malloc((argc + 1) * sizeof(char *));
+  
+  if (argv == NULL) {
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  /* split payload,  which is NUL terminated */
+  workdir = payload;
+  next = workdir + strlen(workdir) + 1;
+  for (index = 0; index < argc; index++) {
+    argv[index] = (char *) next;
+    next = next + strlen(next) + 1;
+  } /* end for */
+  argv[argc] = NULL;
+  
+  saved_dir = open(".", O_RDONLY);
+  saved_out = dup(STDOUT_FILENO);
+  saved_err = dup(STDERR_FILENO);
+  
+  if ((saved_dir < 0) || (saved_out < 0) || (saved_err < 0)) {
+    code = EXIT_FAILURE;
+  }
+  else {
+    fflush(stdout);
+    fflush(stderr);
+    dup2(out_fd, STDOUT_FILENO);
+    dup2(err_fd, STDERR_FILENO);
+    
+    if (chdir(workdir) != 0) {
+      fprintf(stderr, "m2c server: cannot change to directory %s\n", workdir);
+      code = EXIT_FAILURE;
+    }
+    else {
+      m2c_compiler_options_reset();
+      code = handler((int) argc, argv, context);
+    } /* end if */
+    
+    fflush(stdout);
+    fflush(stderr);
+    dup2(saved_out, STDOUT_FILENO);
+    dup2(saved_err, STDERR_FILENO);
+    
+    /* nothing else can be done if the directory has gone */
+    (void) fchdir(saved_dir);
+  } /* end if */
+  
+  if (saved_dir >= 0) {
+    close(saved_dir);
+  } /* end if */
+  if (saved_out >= 0) {
+    close(saved_out);
+  } /* end if */
+  if (saved_err >= 0) {
+    close(saved_err);
+  } /* end if */
+  
+  free(argv);
+  
+  return code;
+} /* end run_request */
+
+
+/* --------------------------------------------------------------------------
+ * private function string_count(payload, length)
+ * --------------------------------------------------------------------------
+ * Returns the number of NUL characters in the length bytes at payload.
+ * ----------------------------------------------------------------------- */
+
+static uint_t string_count (const char *payload, size_t length) {
+  
+  uint_t count;
+  size_t index;
+  
+  count = 0;
+  for (index = 0; index < length; index++) {
+    if (payload[index] == ASCII_NUL) {
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  return count;
+} /* end string_count */
+
+
+/* --------------------------------------------------------------------------
+ * private function recv_all(socket_fd, buffer, length)
+ * --------------------------------------------------------------------------
+ * Receives exactly length bytes from socket_fd into buffer.  Returns true on
+ * success,  false if the connection was closed or failed.
+ * ----------------------------------------------------------------------- */
+
+static bool recv_all (int socket_fd, void *buffer, size_t length) {
+  
+  ssize_t received;
+  char *next;
+  
+  next = (char *) buffer;
+  while (length > 0) {
+    received = recv(socket_fd, next, length, 0);
+    
+    if (received <= 0) {
+      if ((received < 0) && (errno == EINTR)) {
+        continue;
+      } /* end if */
+      return false;
+    } /* end if */
+    
+    next = next + received;
+    length = length - (size_t) received;
+  } /* end while */
+  
+  return true;
+} /* end recv_all */
+
+
+/* --------------------------------------------------------------------------
+ * private function send_all(socket_fd, buffer, length)
+ * --------------------------------------------------------------------------
+ * Sends length bytes at buffer on socket_fd.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool send_all (int socket_fd, const void *buffer, size_t length) {
+  
+  const char *next;
+  ssize_t sent;
+  
+  next = (const char *) buffer;
+  while (length > 0) {
+    sent = send(socket_fd, next, length, 0);
+    
+    if (sent <= 0) {
+      if ((sent < 0) && (errno == EINTR)) {
+        continue;
+      } /* end if */
+      return false;
+    } /* end if */
+    
+    next = next + sent;
+    length = length - (size_t) sent;
+  } /* end while */
+  
+  return true;
+} /* end send_all */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private function iface_entry_for_path(path)
+ * --------------------------------------------------------------------------
+ * Returns the entry of interned pathname path in the interface table,
+ * appending an entry without symbol file if there is none.  Returns NULL if
+ * allocation failed.  The caller must hold the table lock.
+ * ----------------------------------------------------------------------- */
+
+static iface_entry_t *iface_entry_for_path (intstr_t path) {
+  
+  iface_entry_t *new_table, *entry;
+  uint_t index, mask, slot, new_capacity;
+  
+  /* keep the slot table at most half full */
+  if ((2 * (iface_count + 1) > iface_slot_count) && NOT(grow_iface_slots())) {
+    return NULL;
+  } /* end if */
+  
+  mask = iface_slot_count - 1;
+  index = intstr_hash(path) & mask;
+  
+  while (iface_slot[index] != 0) {
+    slot = iface_slot[index] - 1;
+    if (iface_entry[slot].path == path) {
+      return &iface_entry[slot];
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  if (iface_count == iface_capacity) {
+    new_capacity = (iface_capacity == 0) ?
+      IFACE_INITIAL_CAPACITY : 2 * iface_capacity;
+    new_table = realloc(iface_entry, new_capacity * sizeof(iface_entry_t));
+    
+    if (new_table == NULL) {
+      return NULL;
+    } /* end if */
+    
+    iface_entry = new_table;
+    iface_capacity = new_capacity;
+  } /* end if */
+  
+  entry = &iface_entry[iface_count];
+  entry->path = path;
+  entry->symfile = NULL;
+  entry->mtime = 0;
+  entry->size = 0;
+  iface_count++;
+  
+  iface_slot[index] = iface_count;
+  
+  return entry;
+} /* end iface_entry_for_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_iface_slots()
+ * --------------------------------------------------------------------------
+ * Doubles the slot count of the interface table and reenters all entries.
+ * Returns false if allocation failed,  leaving the slot table unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_iface_slots (void) {
+  
+  uint_t *new_slot;
+  uint_t entry, index, mask, new_count;
+  
+  new_count = (iface_slot_count == 0) ?
+    IFACE_INITIAL_SLOT_COUNT : 2 * iface_slot_count;
+  new_slot = calloc(new_count, sizeof(uint_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  free(iface_slot);
+  iface_slot = new_slot;
+  iface_slot_count = new_count;
+  mask = iface_slot_count - 1;
+  
+  for (entry = 0; entry < iface_count; entry++) {
+    index = intstr_hash(iface_entry[entry].path) & mask;
+    while (iface_slot[index] != 0) {
+      index = (index + 1) & mask;
+    } /* end while */
+    iface_slot[index] = entry + 1;
+  } /* end for */
+  
+  return true;
+} /* end grow_iface_slots */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_iface_table()
+ * --------------------------------------------------------------------------
+ * Releases the symbol files of the interface table and deallocates it.
+ * ----------------------------------------------------------------------- */
+
+static void release_iface_table (void) {
+  
+  uint_t index;
+  
+  for (index = 0; index < iface_count; index++) {
+    m2c_release_symfile(iface_entry[index].symfile);
+  } /* end for */
+  
+  free(iface_entry);
+  free(iface_slot);
+  iface_entry = NULL;
+  iface_slot = NULL;
+  iface_count = 0;
+  iface_capacity = 0;
+  iface_slot_count = 0;
+} /* end release_iface_table */
+
+
+/* END OF FILE */
@@ -42,6 +42,9 @@
  * ----------------------------------------------------------------------- */
 
 #include "m2c-compiler-options.h"
+#include "m2c-common.h"
+
+#include <stddef.h>
 
 
 /* --------------------------------------------------------------------------
@@ -54,13 +57,23 @@
   /* parser_debug */ false, \
   /* show_settings */ false, \
   /* errant_semicolon */ false, \
+  /* intstr_stats */ false, \
+  /* parser_profile */ false, \
+  /* time_report */ false, \
+  /* telemetry */ false, \
+  /* mem_report */ false, \
+  /* perf_counters */ false, \
   /* ast_required */ false, \
   /* graph_requre */ false, \
   /* xlat_required */ true, \
   /* obj_required */ false, \
   /* preserve_comments */ true, \
   /* lowline_identifiers */ false, \
-  /* dollar_identifiers */ false \
+  /* dollar_identifiers */ false, \
+  /* unity_build */ false, \
+  /* compile_cache */ false, \
+  /* binary_exl */ false, \
+  /* lazy_bodies */ false \
 } /* DEFAULT_OPTIONS */
 
 
@@ -70,7 +83,39 @@
 
 #define OPTION_COUNT M2C_COMPILER_OPTION_END_MARK
 
-m2t_compiler_option_t compiler_option[OPTION_COUNT] = DEFAULT_OPTIONS;
+static bool compiler_option[OPTION_COUNT] = DEFAULT_OPTIONS;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variables max_errors and max_warnings
+ * ----------------------------------------------------------------------- */
+
+static uint_t max_errors = 0;
+
+static uint_t max_warnings = 0;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variable trace_path
+ * ----------------------------------------------------------------------- */
+
+static const char *trace_path = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variables dump_depth and dump_subtree
+ * ----------------------------------------------------------------------- */
+
+static uint_t dump_depth = 0;
+
+static const char *dump_subtree = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variable worker_cache
+ * ----------------------------------------------------------------------- */
+
+static const char *worker_cache = NULL;
 
 
 /* --------------------------------------------------------------------------
@@ -141,6 +186,72 @@ bool m2c_compiler_option_errant_semicolons (void) {
 } /* end m2c_compiler_option_errant_semicolons */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_intstr_stats()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --intstr-stats is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_intstr_stats (void) {
+  return compiler_option[M2C_COMPILER_OPTION_INTSTR_STATS];
+} /* end m2c_compiler_option_intstr_stats */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_parser_profile()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --parser-profile is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_parser_profile (void) {
+  return compiler_option[M2C_COMPILER_OPTION_PARSER_PROFILE];
+} /* end m2c_compiler_option_parser_profile */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_time_report()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --time-report is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_time_report (void) {
+  return compiler_option[M2C_COMPILER_OPTION_TIME_REPORT];
+} /* end m2c_compiler_option_time_report */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_telemetry()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --telemetry is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_telemetry (void) {
+  return compiler_option[M2C_COMPILER_OPTION_TELEMETRY];
+} /* end m2c_compiler_option_telemetry */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_mem_report()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --mem-report is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_mem_report (void) {
+  return compiler_option[M2C_COMPILER_OPTION_MEM_REPORT];
+} /* end m2c_compiler_option_mem_report */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_perf_counters()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --perf-counters is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_perf_counters (void) {
+  return compiler_option[M2C_COMPILER_OPTION_PERF_COUNTERS];
+} /* end m2c_compiler_option_perf_counters */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_compiler_option_ast_required()
  * ---------------------------------------------------------------------------
@@ -218,6 +329,244 @@ bool m2c_compiler_option_dollar_identifiers (void) {
 } /* end m2c_compiler_option_dollar_identifiers */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_unity_build()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --unity is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_unity_build (void) {
+  return compiler_option[M2C_COMPILER_OPTION_UNITY_BUILD];
+} /* end m2c_compiler_option_unity_build */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_compile_cache()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --cache is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_compile_cache (void) {
+  return compiler_option[M2C_COMPILER_OPTION_COMPILE_CACHE];
+} /* end m2c_compiler_option_compile_cache */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_binary_exl()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --exlb is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_binary_exl (void) {
+  return compiler_option[M2C_COMPILER_OPTION_BINARY_EXL];
+} /* end m2c_compiler_option_binary_exl */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_lazy_bodies()
+ * ---------------------------------------------------------------------------
+ * Returns true if lazy parsing of bodies is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_lazy_bodies (void) {
+  return compiler_option[M2C_COMPILER_OPTION_LAZY_BODIES];
+} /* end m2c_compiler_option_lazy_bodies */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_max_errors(value)
+ * ---------------------------------------------------------------------------
+ * Sets the maximum number of errors reported per module.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_max_errors (uint_t value) {
+  max_errors = value;
+} /* end m2c_compiler_option_set_max_errors */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_max_errors()
+ * ---------------------------------------------------------------------------
+ * Returns the maximum number of errors reported per module,  or zero.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_compiler_option_max_errors (void) {
+  return max_errors;
+} /* end m2c_compiler_option_max_errors */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_max_warnings(value)
+ * ---------------------------------------------------------------------------
+ * Sets the maximum number of warnings reported per module.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_max_warnings (uint_t value) {
+  max_warnings = value;
+} /* end m2c_compiler_option_set_max_warnings */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_max_warnings()
+ * ---------------------------------------------------------------------------
+ * Returns the maximum number of warnings reported per module,  or zero.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_compiler_option_max_warnings (void) {
+  return max_warnings;
+} /* end m2c_compiler_option_max_warnings */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_trace_path(path)
+ * ---------------------------------------------------------------------------
+ * Sets the path of the trace event file.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_trace_path (const char *path) {
+  trace_path = path;
+} /* end m2c_compiler_option_set_trace_path */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_trace_path()
+ * ---------------------------------------------------------------------------
+ * Returns the path of the trace event file,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_compiler_option_trace_path (void) {
+  return trace_path;
+} /* end m2c_compiler_option_trace_path */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_dump_depth(value)
+ * ---------------------------------------------------------------------------
+ * Sets the depth below which AST dumps are cut off.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_dump_depth (uint_t value) {
+  dump_depth = value;
+} /* end m2c_compiler_option_set_dump_depth */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_dump_depth()
+ * ---------------------------------------------------------------------------
+ * Returns the depth below which AST dumps are cut off,  or zero.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_compiler_option_dump_depth (void) {
+  return dump_depth;
+} /* end m2c_compiler_option_dump_depth */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_dump_subtree(ident)
+ * ---------------------------------------------------------------------------
+ * Sets the identifier of the definition to which AST dumps are restricted.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_dump_subtree (const char *ident) {
+  dump_subtree = ident;
+} /* end m2c_compiler_option_set_dump_subtree */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_dump_subtree()
+ * ---------------------------------------------------------------------------
+ * Returns the identifier of the definition to which AST dumps are restricted,
+ * or NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_compiler_option_dump_subtree (void) {
+  return dump_subtree;
+} /* end m2c_compiler_option_dump_subtree */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_worker_cache(path)
+ * ---------------------------------------------------------------------------
+ * Sets the path of the string snapshot to be mapped at startup.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_worker_cache (const char *path) {
+  worker_cache = path;
+} /* end m2c_compiler_option_set_worker_cache */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_worker_cache()
+ * ---------------------------------------------------------------------------
+ * Returns the path of the string snapshot to be mapped at startup,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_compiler_option_worker_cache (void) {
+  return worker_cache;
+} /* end m2c_compiler_option_worker_cache */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_options_snapshot()
+ * ---------------------------------------------------------------------------
+ * Returns a snapshot of the current settings of all options.
+ * ----------------------------------------------------------------------- */
+
+m2c_compiler_options_t m2c_compiler_options_snapshot (void) {
+  
+  m2c_compiler_options_t options;
+  uint_t index;
+  
+  options = 0;
+  index = 0;
+  while (index < OPTION_COUNT) {
+    if (compiler_option[index]) {
+      options = options | (1UL << index);
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  return options;
+} /* end m2c_compiler_options_snapshot */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_options_reset()
+ * ---------------------------------------------------------------------------
+ * Restores the default settings of all options.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_options_reset (void) {
+  
+  static const bool default_option[OPTION_COUNT] = DEFAULT_OPTIONS;
+  uint_t index;
+  
+  index = 0;
+  while (index < OPTION_COUNT) {
+    compiler_option[index] = default_option[index];
+    index++;
+  } /* end while */
+  
+} /* end m2c_compiler_options_reset */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_options_flag(options, option)
+ * ---------------------------------------------------------------------------
+ * Returns true if option is turned on in snapshot options, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_options_flag
+  (m2c_compiler_options_t options, m2c_compiler_option_t option) {
+  
+  if (option >= OPTION_COUNT) {
+    return false;
+  } /* end if */
+  
+  return ((options & (1UL << option)) != 0);
+} /* end m2c_compiler_options_flag */
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_compiler_option_print_settings()
  * ---------------------------------------------------------------------------
@@ -0,0 +1,1035 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-const-fold.c                                                          *
+ *                                                                           *
+ * Implementation of memoizing folding of constant expressions in the AST.  *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-const-fold.h"
+#include "m2c-ast-nodetype.h"
+#include "m2c-build-params.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type value_entry_t
+ * --------------------------------------------------------------------------
+ * Entry of the value cache,  holding the folded value of node.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_astnode_t node;
+  m2c_const_value_t value;
+} value_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type binding_entry_t
+ * --------------------------------------------------------------------------
+ * Entry of the binding table,  holding the expression bound to constant
+ * identifier ident,  or NULL if ident is defined more than once.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  intstr_t ident;
+  m2c_astnode_t expr;
+} binding_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_const_fold_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a constant folder.  Both tables use open
+ * addressing with linear probing,  their capacities are powers of two.
+ * ----------------------------------------------------------------------- */
+
+#define VALUE_CACHE_INITIAL_CAPACITY 256
+
+#define BINDING_TABLE_INITIAL_CAPACITY 64
+
+struct m2c_const_fold_struct_t {
+  value_entry_t *cache;
+  uint_t cache_count;
+  uint_t cache_capacity;
+  binding_entry_t *binding;
+  uint_t binding_count;
+  uint_t binding_capacity;
+  uint_t replaced_count;
+};
+
+typedef struct m2c_const_fold_struct_t m2c_const_fold_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private constant not_constant
+ * ----------------------------------------------------------------------- */
+
+static const m2c_const_value_t not_constant = { M2C_CONST_NONE, 0, 0.0 };
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool lookup_value
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_const_value_t *value);
+
+static void store_value
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_const_value_t value);
+
+static m2c_astnode_t bound_expr (m2c_const_fold_t folder, intstr_t ident);
+
+static m2c_const_value_t fold_node
+  (m2c_const_fold_t folder, m2c_astnode_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_const_folder()
+ * --------------------------------------------------------------------------
+ * Returns a new constant folder with an empty cache,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_const_fold_t m2c_new_const_folder (void) {
+  
+  m2c_const_fold_t folder;
+  
+  folder = malloc(sizeof(m2c_const_fold_struct_t));
+  
+  if (folder == NULL) {
+    return NULL;
+  } /* end if */
+  
+  folder->cache =
+    calloc(VALUE_CACHE_INITIAL_CAPACITY, sizeof(value_entry_t));
+  folder->binding =
+    calloc(BINDING_TABLE_INITIAL_CAPACITY, sizeof(binding_entry_t));
+  
+  if ((folder->cache == NULL) || (folder->binding == NULL)) {
+    free(folder->cache);
+    free(folder->binding);
+    free(folder);
+    return NULL;
+  } /* end if */
+  
+  folder->cache_count = 0;
+  folder->cache_capacity = VALUE_CACHE_INITIAL_CAPACITY;
+  folder->binding_count = 0;
+  folder->binding_capacity = BINDING_TABLE_INITIAL_CAPACITY;
+  folder->replaced_count = 0;
+  
+  return folder;
+} /* end m2c_new_const_folder */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_const_fold_note_literal(folder, node, value)
+ * --------------------------------------------------------------------------
+ * Records value as the value of literal node,  as converted by the lexer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_const_fold_note_literal
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_numeric_value_t value) {
+  
+  m2c_const_value_t folded = not_constant;
+  
+  if ((folder == NULL) || (node == NULL) ||
+      (value.overflow) || ((NOT(value.is_real)) && (value.whole > INT64_MAX))) {
+    return;
+  } /* end if */
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_INTVAL :
+      folded.kind = M2C_CONST_WHOLE;
+      folded.whole = (int64_t) value.whole;
+      break;
+  
+    case AST_CHRVAL :
+      folded.kind = M2C_CONST_CHAR;
+      folded.whole = (int64_t) value.whole;
+      break;
+  
+    case AST_REALVAL :
+      folded.kind = M2C_CONST_REAL;
+      folded.real = value.real;
+      break;
+  
+    default :
+      return;
+  } /* end switch */
+  
+  store_value(folder, node, folded);
+  
+} /* end m2c_const_fold_note_literal */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_const_fold_value(folder, node, value)
+ * --------------------------------------------------------------------------
+ * Folds the expression rooted at node,  passes the result in value and
+ * returns true if it is constant,  else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_const_fold_value
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_const_value_t *value) {
+  
+  m2c_const_value_t folded;
+  
+  if ((folder == NULL) || (node == NULL)) {
+    folded = not_constant;
+  }
+  else {
+    folded = fold_node(folder, node);
+  } /* end if */
+  
+  if (value != NULL) {
+    *value = folded;
+  } /* end if */
+  
+  return (folded.kind != M2C_CONST_NONE);
+} /* end m2c_const_fold_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fold_constants(folder, root)
+ * --------------------------------------------------------------------------
+ * Binds the constant definitions of the tree rooted at root,  then folds and
+ * replaces the expressions in constant positions.  Returns the number of
+ * replaced expressions.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t bind_const_defn
+  (m2c_astnode_t node, void *folder);
+
+static m2c_ast_visit_action_t fold_const_positions
+  (m2c_astnode_t node, void *folder);
+
+uint_t m2c_fold_constants (m2c_const_fold_t folder, m2c_astnode_t root) {
+  
+  uint_t prior_count;
+  
+  if ((folder == NULL) || (root == NULL)) {
+    return 0;
+  } /* end if */
+  
+  prior_count = folder->replaced_count;
+  
+  /* bind all constant definitions first, uses may precede definitions */
+  m2c_ast_visit(root, bind_const_defn, NULL, folder);
+  
+  /* fold and replace */
+  m2c_ast_visit(root, fold_const_positions, NULL, folder);
+  
+  return folder->replaced_count - prior_count;
+} /* end m2c_fold_constants */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_const_folder(folder)
+ * --------------------------------------------------------------------------
+ * Deallocates folder and its cache.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_const_folder (m2c_const_fold_t folder) {
+  
+  if (folder == NULL) {
+    return;
+  } /* end if */
+  
+  free(folder->cache);
+  free(folder->binding);
+  free(folder);
+  
+} /* end m2c_release_const_folder */
+
+
+/* *********************************************************************** *
+ * P R I V A T E   F U N C T I O N S                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private macro NODE_HASH(node)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for the address of node.
+ * ----------------------------------------------------------------------- */
+
+#define NODE_HASH(_node) \
+  ((uint_t) ((((uintptr_t) (_node)) >> 3) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_value(folder, node, value)
+ * --------------------------------------------------------------------------
+ * Looks up node in the value cache of folder.  If found,  passes its value
+ * in value and returns true,  else returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool lookup_value
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_const_value_t *value) {
+  
+  uint_t mask, index;
+  
+  mask = folder->cache_capacity - 1;
+  index = NODE_HASH(node) & mask;
+  
+  while (folder->cache[index].node != NULL) {
+    if (folder->cache[index].node == node) {
+      *value = folder->cache[index].value;
+      return true;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return false;
+} /* end lookup_value */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure store_value(folder, node, value)
+ * --------------------------------------------------------------------------
+ * Enters or updates the value of node in the value cache of folder.  The
+ * cache is doubled when it becomes three quarters full.  If the cache cannot
+ * be enlarged,  the value is not cached and will be folded again.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_cache (m2c_const_fold_t folder);
+
+static void store_value
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_const_value_t value) {
+  
+  uint_t mask, index;
+  
+  mask = folder->cache_capacity - 1;
+  index = NODE_HASH(node) & mask;
+  
+  while (folder->cache[index].node != NULL) {
+    if (folder->cache[index].node == node) {
+      folder->cache[index].value = value;
+      return;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  if ((4 * (folder->cache_count + 1)) > (3 * folder->cache_capacity)) {
+    if (NOT(grow_cache(folder))) {
+      return;
+    } /* end if */
+  
+    mask = folder->cache_capacity - 1;
+    index = NODE_HASH(node) & mask;
+  
+    while (folder->cache[index].node != NULL) {
+      index = (index + 1) & mask;
+    } /* end while */
+  } /* end if */
+  
+  folder->cache[index].node = node;
+  folder->cache[index].value = value;
+  folder->cache_count++;
+  
+} /* end store_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_cache(folder)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the value cache of folder.  Returns false if
+ * allocation failed, in which case the cache remains unchanged, else true.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_cache (m2c_const_fold_t folder) {
+  
+  uint_t new_capacity, mask, index, slot;
+  value_entry_t *new_cache;
+  
+  new_capacity = 2 * folder->cache_capacity;
+  new_cache = calloc(new_capacity, sizeof(value_entry_t));
+  
+  if (new_cache == NULL) {
+    return false;
+  } /* end if */
+  
+  mask = new_capacity - 1;
+  
+  for (index = 0; index < folder->cache_capacity; index++) {
+    if (folder->cache[index].node != NULL) {
+      slot = NODE_HASH(folder->cache[index].node) & mask;
+  
+      while (new_cache[slot].node != NULL) {
+        slot = (slot + 1) & mask;
+      } /* end while */
+  
+      new_cache[slot] = folder->cache[index];
+    } /* end if */
+  } /* end for */
+  
+  free(folder->cache);
+  folder->cache = new_cache;
+  folder->cache_capacity = new_capacity;
+  
+  return true;
+} /* end grow_cache */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure bind(folder, ident, expr)
+ * --------------------------------------------------------------------------
+ * Binds expr to constant identifier ident in the binding table of folder.
+ * An identifier bound more than once is marked ambiguous.  The table is
+ * doubled when it becomes three quarters full.  If it cannot be enlarged,
+ * ident remains unbound.
+ * ----------------------------------------------------------------------- */
+
+static void bind
+  (m2c_const_fold_t folder, intstr_t ident, m2c_astnode_t expr) {
+  
+  uint_t mask, index, slot, new_capacity;
+  binding_entry_t *new_binding;
+  
+  mask = folder->binding_capacity - 1;
+  index = (uint_t) intstr_hash(ident) & mask;
+  
+  while (folder->binding[index].ident != NULL) {
+    if (folder->binding[index].ident == ident) {
+      folder->binding[index].expr = NULL;
+      return;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  if ((4 * (folder->binding_count + 1)) > (3 * folder->binding_capacity)) {
+    new_capacity = 2 * folder->binding_capacity;
+    new_binding = calloc(new_capacity, sizeof(binding_entry_t));
+  
+    if (new_binding == NULL) {
+      return;
+    } /* end if */
+  
+    mask = new_capacity - 1;
+  
+    for (index = 0; index < folder->binding_capacity; index++) {
+      if (folder->binding[index].ident != NULL) {
+        slot = (uint_t) intstr_hash(folder->binding[index].ident) & mask;
+  
+        while (new_binding[slot].ident != NULL) {
+          slot = (slot + 1) & mask;
+        } /* end while */
+  
+        new_binding[slot] = folder->binding[index];
+      } /* end if */
+    } /* end for */
+  
+    free(folder->binding);
+    folder->binding = new_binding;
+    folder->binding_capacity = new_capacity;
+  
+    index = (uint_t) intstr_hash(ident) & mask;
+  
+    while (folder->binding[index].ident != NULL) {
+      index = (index + 1) & mask;
+    } /* end while */
+  } /* end if */
+  
+  folder->binding[index].ident = ident;
+  folder->binding[index].expr = expr;
+  folder->binding_count++;
+  
+} /* end bind */
+
+
+/* --------------------------------------------------------------------------
+ * private function bound_expr(folder, ident)
+ * --------------------------------------------------------------------------
+ * Returns the expression bound to ident,  or NULL if ident is not bound or
+ * ambiguous.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t bound_expr (m2c_const_fold_t folder, intstr_t ident) {
+  
+  uint_t mask, index;
+  
+  mask = folder->binding_capacity - 1;
+  index = (uint_t) intstr_hash(ident) & mask;
+  
+  while (folder->binding[index].ident != NULL) {
+    if (folder->binding[index].ident == ident) {
+      return folder->binding[index].expr;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end bound_expr */
+
+
+/* --------------------------------------------------------------------------
+ * private function bind_const_defn(node, folder)
+ * --------------------------------------------------------------------------
+ * Visitor callback to bind the identifier of constant definition node.
+ *
+ * astnode: (CONST bindNode (IDENT constId) typeNode exprNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t bind_const_defn
+  (m2c_astnode_t node, void *folder) {
+  
+  m2c_astnode_t id_node;
+  
+  if (m2c_ast_nodetype(node) != AST_CONST) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  id_node = m2c_ast_subnode_at_index(node, 1);
+  
+  if (m2c_ast_nodetype(id_node) == AST_IDENT) {
+    bind(folder, m2c_ast_value(id_node), m2c_ast_subnode_at_index(node, 3));
+  } /* end if */
+  
+  /* expressions do not hold constant definitions */
+  return M2C_AST_VISIT_SKIP;
+} /* end bind_const_defn */
+
+
+/* --------------------------------------------------------------------------
+ * private function convert_lexeme(node, lexeme)
+ * --------------------------------------------------------------------------
+ * Converts the lexeme of literal node and returns its value.  Used for
+ * literals whose value has not been recorded by the parser.  Digit
+ * separators are skipped.  Prefix 0b denotes base-2,  0x base-16 and 0u a
+ * base-16 character code.
+ * ----------------------------------------------------------------------- */
+
+#define DIGIT_SEPARATOR '\''
+
+static m2c_const_value_t convert_lexeme
+  (m2c_astnode_t node, intstr_t lexeme) {
+  
+  const char *lexstr;
+  char digits[M2C_MAX_NUMBER_LENGTH + 1];
+  uint_t index, length, base, digit;
+  uint64_t whole;
+  m2c_const_value_t value = not_constant;
+  
+  lexstr = intstr_char_ptr(lexeme);
+  
+  if (lexstr == NULL) {
+    return not_constant;
+  } /* end if */
+  
+  /* copy without digit separators */
+  length = 0;
+  
+  for (index = 0; lexstr[index] != ASCII_NUL; index++) {
+    if (lexstr[index] != DIGIT_SEPARATOR) {
+      if (length == M2C_MAX_NUMBER_LENGTH) {
+        return not_constant;
+      } /* end if */
+  
+      digits[length] = lexstr[index];
+      length++;
+    } /* end if */
+  } /* end for */
+  digits[length] = ASCII_NUL;
+  
+  if (m2c_ast_nodetype(node) == AST_REALVAL) {
+    value.kind = M2C_CONST_REAL;
+    value.real = strtod(digits, NULL);
+  
+    if (NOT(isfinite(value.real))) {
+      return not_constant;
+    } /* end if */
+  
+    return value;
+  } /* end if */
+  
+  /* whole number or character code */
+  index = 0;
+  base = 10;
+  
+  if ((length > 2) && (digits[0] == '0')) {
+    switch (digits[1]) {
+      case 'b' :
+        base = 2;
+        index = 2;
+        break;
+  
+      case 'u' :
+      case 'x' :
+        base = 16;
+        index = 2;
+        break;
+    } /* end switch */
+  } /* end if */
+  
+  whole = 0;
+  
+  while (index < length) {
+    if ((digits[index] >= '0') && (digits[index] <= '9')) {
+      digit = (uint_t) (digits[index] - '0');
+    }
+    else if ((digits[index] >= 'A') && (digits[index] <= 'F')) {
+      digit = (uint_t) (digits[index] - 'A' + 10);
+    }
+    else /* not a digit */ {
+      return not_constant;
+    } /* end if */
+  
+    if ((digit >= base) || (whole > ((uint64_t) INT64_MAX - digit) / base)) {
+      return not_constant;
+    } /* end if */
+  
+    whole = whole * base + digit;
+    index++;
+  } /* end while */
+  
+  if (m2c_ast_nodetype(node) == AST_CHRVAL) {
+    value.kind = M2C_CONST_CHAR;
+  }
+  else {
+    value.kind = M2C_CONST_WHOLE;
+  } /* end if */
+  
+  value.whole = (int64_t) whole;
+  
+  return value;
+} /* end convert_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * private function fold_whole_op(node_type, left, right, result)
+ * --------------------------------------------------------------------------
+ * Applies the operator of node_type to whole numbers left and right,  passes
+ * the result in result and returns true,  or returns false if the operator
+ * does not apply to whole numbers or the result is not representable.
+ * ----------------------------------------------------------------------- */
+
+static bool fold_whole_op
+  (m2c_ast_nodetype_t node_type, int64_t left, int64_t right,
+   int64_t *result) {
+  
+  switch (node_type) {
+    case AST_PLUS :
+      if (((right > 0) && (left > INT64_MAX - right)) ||
+          ((right < 0) && (left < INT64_MIN - right))) {
+        return false;
+      } /* end if */
+      *result = left + right;
+      return true;
+  
+    case AST_MINUS :
+      if (((right < 0) && (left > INT64_MAX + right)) ||
+          ((right > 0) && (left < INT64_MIN + right))) {
+        return false;
+      } /* end if */
+      *result = left - right;
+      return true;
+  
+    case AST_ASTERISK :
+      if (left > 0) {
+        if (((right > 0) && (left > INT64_MAX / right)) ||
+            ((right < 0) && (right < INT64_MIN / left))) {
+          return false;
+        } /* end if */
+      }
+      else if (left < 0) {
+        if (((right > 0) && (left < INT64_MIN / right)) ||
+            ((right < 0) && (right < INT64_MAX / left))) {
+          return false;
+        } /* end if */
+      } /* end if */
+      *result = left * right;
+      return true;
+  
+    case AST_DIV :
+    case AST_MOD :
+      if ((right == 0) || ((left == INT64_MIN) && (right == -1))) {
+        return false;
+      } /* end if */
+      *result = (node_type == AST_DIV) ? left / right : left % right;
+      return true;
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end fold_whole_op */
+
+
+/* --------------------------------------------------------------------------
+ * private function fold_real_op(node_type, left, right, result)
+ * --------------------------------------------------------------------------
+ * Applies the operator of node_type to real numbers left and right,  passes
+ * the result in result and returns true,  or returns false if the operator
+ * does not apply to real numbers or the result is not finite.
+ * ----------------------------------------------------------------------- */
+
+static bool fold_real_op
+  (m2c_ast_nodetype_t node_type, double left, double right, double *result) {
+  
+  switch (node_type) {
+    case AST_PLUS :
+      *result = left + right;
+      break;
+  
+    case AST_MINUS :
+      *result = left - right;
+      break;
+  
+    case AST_ASTERISK :
+      *result = left * right;
+      break;
+  
+    case AST_SOLIDUS :
+      if (right == 0.0) {
+        return false;
+      } /* end if */
+      *result = left / right;
+      break;
+  
+    default :
+      return false;
+  } /* end switch */
+  
+  return isfinite(*result);
+} /* end fold_real_op */
+
+
+/* --------------------------------------------------------------------------
+ * private function fold_node(folder, node)
+ * --------------------------------------------------------------------------
+ * Returns the folded value of the expression rooted at node,  from the value
+ * cache if present,  otherwise folds it and enters the result into the
+ * cache.  The node is entered as not constant before its subnodes are
+ * folded,  thus cyclic constant definitions are not constant.
+ * ----------------------------------------------------------------------- */
+
+static m2c_const_value_t fold_node
+  (m2c_const_fold_t folder, m2c_astnode_t node) {
+  
+  m2c_ast_nodetype_t node_type;
+  m2c_const_value_t value, left, right;
+  m2c_astnode_t expr;
+  
+  if (lookup_value(folder, node, &value)) {
+    return value;
+  } /* end if */
+  
+  store_value(folder, node, not_constant);
+  
+  value = not_constant;
+  node_type = m2c_ast_nodetype(node);
+  
+  switch (node_type) {
+    /* literals not recorded by the parser */
+    case AST_INTVAL :
+    case AST_REALVAL :
+    case AST_CHRVAL :
+      value = convert_lexeme(node, m2c_ast_value(node));
+      break;
+  
+    /* constant identifiers */
+    case AST_IDENT :
+      expr = bound_expr(folder, m2c_ast_value(node));
+  
+      if (expr != NULL) {
+        value = fold_node(folder, expr);
+      } /* end if */
+      break;
+  
+    /* parenthesised expression */
+    case AST_EXPR :
+      if (m2c_ast_subnode_count(node) == 1) {
+        value = fold_node(folder, m2c_ast_subnode_at_index(node, 0));
+      } /* end if */
+      break;
+  
+    /* arithmetic negation */
+    case AST_NEG :
+      left = fold_node(folder, m2c_ast_subnode_at_index(node, 0));
+  
+      if ((left.kind == M2C_CONST_WHOLE) && (left.whole != INT64_MIN)) {
+        value.kind = M2C_CONST_WHOLE;
+        value.whole = -left.whole;
+      }
+      else if (left.kind == M2C_CONST_REAL) {
+        value.kind = M2C_CONST_REAL;
+        value.real = -left.real;
+      } /* end if */
+      break;
+  
+    /* arithmetic operators */
+    case AST_PLUS :
+    case AST_MINUS :
+    case AST_ASTERISK :
+    case AST_SOLIDUS :
+    case AST_DIV :
+    case AST_MOD :
+      left = fold_node(folder, m2c_ast_subnode_at_index(node, 0));
+      right = fold_node(folder, m2c_ast_subnode_at_index(node, 1));
+  
+      if ((left.kind == M2C_CONST_WHOLE) && (right.kind == M2C_CONST_WHOLE)
+          && (fold_whole_op(node_type, left.whole, right.whole,
+            &value.whole))) {
+        value.kind = M2C_CONST_WHOLE;
+      }
+      else if ((left.kind == M2C_CONST_REAL) && (right.kind == M2C_CONST_REAL)
+          && (fold_real_op(node_type, left.real, right.real, &value.real))) {
+        value.kind = M2C_CONST_REAL;
+      } /* end if */
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  if (value.kind == M2C_CONST_NONE) {
+    return not_constant;
+  } /* end if */
+  
+  store_value(folder, node, value);
+  
+  return value;
+} /* end fold_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function literal_for_value(value)
+ * --------------------------------------------------------------------------
+ * Returns a new literal node for folded value,  a negated literal node for
+ * negative numbers,  or NULL if value has no literal representation or
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+#define LITERAL_BUFFER_SIZE 32
+
+static m2c_astnode_t literal_for_value (m2c_const_value_t value) {
+  
+  char buffer[LITERAL_BUFFER_SIZE];
+  m2c_ast_nodetype_t node_type;
+  m2c_astnode_t node;
+  bool negative;
+  intstr_t lexeme;
+  
+  negative = false;
+  
+  switch (value.kind) {
+    case M2C_CONST_WHOLE :
+      if (value.whole == INT64_MIN) {
+        return NULL;
+      } /* end if */
+  
+      negative = (value.whole < 0);
+      snprintf(buffer, LITERAL_BUFFER_SIZE, "%lld",
+        (long long) (negative ? -value.whole : value.whole));
+      node_type = AST_INTVAL;
+      break;
+  
+    case M2C_CONST_CHAR :
+      snprintf(buffer, LITERAL_BUFFER_SIZE, "0u%llX",
+        (unsigned long long) value.whole);
+      node_type = AST_CHRVAL;
+      break;
+  
+    case M2C_CONST_REAL :
+      negative = (value.real < 0.0);
+      snprintf(buffer, LITERAL_BUFFER_SIZE, "%.17e",
+        negative ? -value.real : value.real);
+      node_type = AST_REALVAL;
+      break;
+  
+    default :
+      return NULL;
+  } /* end switch */
+  
+  lexeme = intstr_for_cstr(buffer, NULL);
+  
+  if (lexeme == NULL) {
+    return NULL;
+  } /* end if */
+  
+  node = m2c_ast_new_terminal_node(node_type, lexeme);
+  
+  if ((node != NULL) && (negative)) {
+    node = m2c_ast_new_node1(AST_NEG, node);
+  } /* end if */
+  
+  return node;
+} /* end literal_for_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_literal(node)
+ * --------------------------------------------------------------------------
+ * Returns true if node is a numeric literal or a negated numeric literal,
+ * else false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_literal (m2c_astnode_t node) {
+  
+  m2c_ast_nodetype_t node_type;
+  
+  node_type = m2c_ast_nodetype(node);
+  
+  if (node_type == AST_NEG) {
+    node_type = m2c_ast_nodetype(m2c_ast_subnode_at_index(node, 0));
+  } /* end if */
+  
+  return (node_type == AST_INTVAL) || (node_type == AST_REALVAL) ||
+    (node_type == AST_CHRVAL);
+} /* end is_literal */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure fold_subnode(folder, node, index)
+ * --------------------------------------------------------------------------
+ * Folds the subnode at index of node  and replaces it by a literal node if
+ * it is constant and not already a literal.
+ * ----------------------------------------------------------------------- */
+
+static void fold_subnode
+  (m2c_const_fold_t folder, m2c_astnode_t node, unsigned short index) {
+  
+  m2c_astnode_t expr, literal;
+  m2c_const_value_t value;
+  
+  expr = m2c_ast_subnode_at_index(node, index);
+  
+  if ((expr == NULL) || (is_literal(expr))) {
+    return;
+  } /* end if */
+  
+  value = fold_node(folder, expr);
+  
+  if (value.kind == M2C_CONST_NONE) {
+    return;
+  } /* end if */
+  
+  literal = literal_for_value(value);
+  
+  if ((literal != NULL) &&
+      (m2c_ast_replace_subnode(node, index, literal) != NULL)) {
+    store_value(folder, literal, value);
+    folder->replaced_count++;
+  } /* end if */
+  
+} /* end fold_subnode */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure fold_range_or_label(folder, node, index)
+ * --------------------------------------------------------------------------
+ * Folds the bounds of the value range at index of node,  or the subnode at
+ * index if it is not a value range.
+ *
+ * astnode: (RANGE lowerBound upperBound) | exprNode
+ * ----------------------------------------------------------------------- */
+
+static void fold_range_or_label
+  (m2c_const_fold_t folder, m2c_astnode_t node, unsigned short index) {
+  
+  m2c_astnode_t subnode;
+  
+  subnode = m2c_ast_subnode_at_index(node, index);
+  
+  if (m2c_ast_nodetype(subnode) == AST_RANGE) {
+    fold_subnode(folder, subnode, 0);
+    fold_subnode(folder, subnode, 1);
+  }
+  else {
+    fold_subnode(folder, node, index);
+  } /* end if */
+  
+} /* end fold_range_or_label */
+
+
+/* --------------------------------------------------------------------------
+ * private function fold_const_positions(node, folder)
+ * --------------------------------------------------------------------------
+ * Visitor callback to fold and replace the constant expressions of node.
+ *
+ * astnodes:
+ *  (CONST bindNode identNode typeNode exprNode)
+ *  (ARRAY typeNode valueCountNode)
+ *  (SUBR typeNode (RANGE lowerBound upperBound))
+ *  (CASE (caseLabelList label0 ... labelN) stmtSeqNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t fold_const_positions
+  (m2c_astnode_t node, void *folder) {
+  
+  m2c_astnode_t label_list;
+  unsigned short index, count;
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_CONST :
+      fold_subnode(folder, node, 3);
+      return M2C_AST_VISIT_SKIP;
+  
+    case AST_ARRAY :
+      fold_subnode(folder, node, 1);
+      break;
+  
+    case AST_SUBR :
+      fold_range_or_label(folder, node, 1);
+      return M2C_AST_VISIT_SKIP;
+  
+    case AST_CASE :
+      label_list = m2c_ast_subnode_at_index(node, 0);
+      count = m2c_ast_subnode_count(label_list);
+  
+      for (index = 0; index < count; index++) {
+        fold_range_or_label(folder, label_list, index);
+      } /* end for */
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end fold_const_positions */
+
+
+/* END OF FILE */
@@ -0,0 +1,540 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-dep-file.c                                                            *
+ *                                                                           *
+ * Implementation of dependency file reader.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-dep-file.h"
+
+#include "infile.h"
+#include "outfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of import arrays
+ * ----------------------------------------------------------------------- */
+
+#define DEP_INITIAL_CAPACITY 16
+
+
+/* --------------------------------------------------------------------------
+ * Binary dependency file layout
+ * ----------------------------------------------------------------------- */
+
+#define DEP_BIN_MAGIC "M2CD"
+#define DEP_BIN_MAGIC_LENGTH 4
+#define DEP_BIN_HEADER_SIZE 12
+#define DEP_BIN_MAX_IDENT_LENGTH 0xFFFF
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static char *new_dep_path
+  (const char *dep_dir, intstr_t module_id, const char *suffix);
+
+static char *new_file_contents (const char *path, size_t *size);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_read_dep_file(dep_dir, module_id, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Reads the dependency file of module_id in directory dep_dir.
+ * ----------------------------------------------------------------------- */
+
+void m2c_read_dep_file
+  (const char *dep_dir,
+   intstr_t module_id,
+   uint_t *count,
+   intstr_t **imports,
+   m2c_dep_file_status_t *status) {
+  
+  intstr_t *list, *new_list, import_id;
+  uint_t list_count, capacity;
+  infile_status_t infile_status;
+  infile_t infile;
+  char *path, ch;
+  
+  /* check pre-conditions */
+  if ((dep_dir == NULL) || (module_id == NULL) ||
+    (count == NULL) || (imports == NULL)) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  *count = 0;
+  *imports = NULL;
+  
+  path = new_dep_path(dep_dir, module_id, M2C_DEP_FILE_SUFFIX);
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  infile_open(&infile, path, &infile_status);
+  free(path);
+  
+  if (infile == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_FILE_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  list = NULL;
+  list_count = 0;
+  capacity = 0;
+  
+  ch = infile_lookahead_char(infile);
+  while (NOT(infile_eof(infile))) {
+    
+    /* skip white space */
+    if ((ch == ASCII_SPACE) || (ch == ASCII_TAB) ||
+      (ch == ASCII_LF) || (ch == ASCII_CR)) {
+      ch = infile_skip_char(infile);
+    }
+    
+    /* module identifier */
+    else if (IS_LETTER(ch)) {
+      infile_mark_lexeme(infile);
+      while (IS_ALPHANUMERIC(ch) || (ch == '_') || (ch == '$')) {
+        ch = infile_consume_char(infile);
+      } /* end while */
+      
+      import_id = infile_lexeme(infile);
+      
+      /* grow array by doubling */
+      if ((import_id != NULL) && (list_count == capacity)) {
+        capacity = (capacity == 0) ? DEP_INITIAL_CAPACITY : 2 * capacity;
+        new_list = realloc(list, capacity * sizeof(intstr_t));
+        
+        if (new_list == NULL) {
+          import_id = NULL;
+        }
+        else {
+          list = new_list;
+        } /* end if */
+      } /* end if */
+      
+      if (import_id == NULL) {
+        infile_close(&infile);
+        free(list);
+        SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+        return;
+      } /* end if */
+      
+      list[list_count] = import_id;
+      list_count++;
+    }
+    
+    /* anything else */
+    else {
+      infile_close(&infile);
+      free(list);
+      SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_FORMAT);
+      return;
+    } /* end if */
+  } /* end while */
+  
+  infile_close(&infile);
+  
+  *count = list_count;
+  *imports = list;
+  
+  SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+} /* end m2c_read_dep_file */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_dep_file(dep_dir, module_id, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Writes the dependency file of module_id in directory dep_dir.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_dep_file
+  (const char *dep_dir,
+   intstr_t module_id,
+   uint_t count,
+   const intstr_t imports[],
+   m2c_dep_file_status_t *status) {
+  
+  outfile_status_t outfile_status;
+  outfile_t outfile;
+  uint_t index;
+  bool written;
+  char *path;
+  
+  /* check pre-conditions */
+  if ((dep_dir == NULL) || (module_id == NULL) ||
+    ((count > 0) && (imports == NULL))) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  path = new_dep_path(dep_dir, module_id, M2C_DEP_FILE_SUFFIX);
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* unchanged dependencies must not trigger rebuilds */
+  outfile_open_if_changed(&outfile, path, &outfile_status);
+  free(path);
+  
+  if (outfile == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    outfile_write_string(outfile, imports[index]);
+    outfile_write_char(outfile, ASCII_LF);
+  } /* end for */
+  
+  outfile_close_if_changed(&outfile, &written, &outfile_status);
+  
+  if (outfile_status != FILEIO_STATUS_SUCCESS) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_WRITE_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+} /* end m2c_write_dep_file */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_read_dep_bin_file(dep_dir, module_id, count, imports, ...)
+ * --------------------------------------------------------------------------
+ * Reads the binary dependency file of module_id in directory dep_dir.
+ * ----------------------------------------------------------------------- */
+
+void m2c_read_dep_bin_file
+  (const char *dep_dir,
+   intstr_t module_id,
+   uint_t *count,
+   intstr_t **imports,
+   m2c_dep_file_status_t *status) {
+  
+  uint_t list_count, index, length;
+  intstr_status_t intstr_status;
+  size_t size, offset;
+  intstr_t *list;
+  unsigned char *bytes;
+  char *path, *data;
+  
+  /* check pre-conditions */
+  if ((dep_dir == NULL) || (module_id == NULL) ||
+    (count == NULL) || (imports == NULL)) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  *count = 0;
+  *imports = NULL;
+  
+  path = new_dep_path(dep_dir, module_id, M2C_DEP_BIN_FILE_SUFFIX);
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  data = new_file_contents(path, &size);
+  free(path);
+  
+  if (data == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_FILE_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  bytes = (unsigned char *) data;
+  
+  /* header */
+  if ((size < DEP_BIN_HEADER_SIZE) ||
+    (memcmp(data, DEP_BIN_MAGIC, DEP_BIN_MAGIC_LENGTH) != 0) ||
+    (bytes[4] != M2C_DEP_BIN_FILE_VERSION)) {
+    free(data);
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_FORMAT);
+    return;
+  } /* end if */
+  
+  list_count = (uint_t) bytes[8] | ((uint_t) bytes[9] << 8) |
+    ((uint_t) bytes[10] << 16) | ((uint_t) bytes[11] << 24);
+  
+  /* each entry takes at least its two length bytes */
+  if (list_count > (size - DEP_BIN_HEADER_SIZE) / 2) {
+    free(data);
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_FORMAT);
+    return;
+  } /* end if */
+  
+  if (list_count == 0) {
+    free(data);
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  /* one allocation for the whole list */
+  list = malloc(list_count * sizeof(intstr_t));
+  
+  if (list == NULL) {
+    free(data);
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  offset = DEP_BIN_HEADER_SIZE;
+  for (index = 0; index < list_count; index++) {
+    
+    if (size - offset < 2) {
+      break;
+    } /* end if */
+    
+    length = (uint_t) bytes[offset] | ((uint_t) bytes[offset + 1] << 8);
+    offset = offset + 2;
+    
+    if ((length == 0) || (size - offset < length)) {
+      break;
+    } /* end if */
+    
+    list[index] = intstr_for_slice(data, offset, length, &intstr_status);
+    
+    if (intstr_status == INTSTR_STATUS_ALLOCATION_FAILED) {
+      free(list);
+      free(data);
+      SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+      return;
+    }
+    else if (list[index] == NULL) {
+      break;
+    } /* end if */
+    
+    offset = offset + length;
+  } /* end for */
+  
+  free(data);
+  
+  if ((index < list_count) || (offset != size)) {
+    free(list);
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_FORMAT);
+    return;
+  } /* end if */
+  
+  *count = list_count;
+  *imports = list;
+  
+  SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+} /* end m2c_read_dep_bin_file */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_dep_bin_file(dep_dir, module_id, count, imports, ...)
+ * --------------------------------------------------------------------------
+ * Writes the binary dependency file of module_id in directory dep_dir.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_dep_bin_file
+  (const char *dep_dir,
+   intstr_t module_id,
+   uint_t count,
+   const intstr_t imports[],
+   m2c_dep_file_status_t *status) {
+  
+  char header[DEP_BIN_HEADER_SIZE], prefix[2];
+  outfile_status_t outfile_status;
+  outfile_t outfile;
+  uint_t index, length;
+  bool written;
+  char *path;
+  
+  /* check pre-conditions */
+  if ((dep_dir == NULL) || (module_id == NULL) ||
+    ((count > 0) && (imports == NULL))) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    length = intstr_length(imports[index]);
+    if ((length == 0) || (length > DEP_BIN_MAX_IDENT_LENGTH)) {
+      SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_REFERENCE);
+      return;
+    } /* end if */
+  } /* end for */
+  
+  path = new_dep_path(dep_dir, module_id, M2C_DEP_BIN_FILE_SUFFIX);
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* unchanged dependencies must not trigger rebuilds */
+  outfile_open_if_changed(&outfile, path, &outfile_status);
+  free(path);
+  
+  if (outfile == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* magic, version, three reserved bytes, count */
+  memcpy(header, DEP_BIN_MAGIC, DEP_BIN_MAGIC_LENGTH);
+  header[4] = (char) M2C_DEP_BIN_FILE_VERSION;
+  header[5] = 0;
+  header[6] = 0;
+  header[7] = 0;
+  header[8] = (char) (count & 0xFF);
+  header[9] = (char) ((count >> 8) & 0xFF);
+  header[10] = (char) ((count >> 16) & 0xFF);
+  header[11] = (char) ((count >> 24) & 0xFF);
+  outfile_write_bytes(outfile, header, DEP_BIN_HEADER_SIZE);
+  
+  /* length prefixed identifiers */
+  for (index = 0; index < count; index++) {
+    length = intstr_length(imports[index]);
+    prefix[0] = (char) (length & 0xFF);
+    prefix[1] = (char) ((length >> 8) & 0xFF);
+    outfile_write_bytes(outfile, prefix, 2);
+    outfile_write_bytes(outfile, intstr_char_ptr(imports[index]), length);
+  } /* end for */
+  
+  outfile_close_if_changed(&outfile, &written, &outfile_status);
+  
+  if (outfile_status != FILEIO_STATUS_SUCCESS) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_WRITE_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+} /* end m2c_write_dep_bin_file */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function new_dep_path(dep_dir, module_id, suffix)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path  dep_dir/ModuleId  followed by suffix,  or
+ * NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_dep_path
+  (const char *dep_dir, intstr_t module_id, const char *suffix) {
+  
+  uint_t dir_length, id_length, suffix_length;
+  char *path;
+  
+  dir_length = strlen(dep_dir);
+  id_length = intstr_length(module_id);
+  suffix_length = strlen(suffix);
+  path = malloc(dir_length + id_length + suffix_length + 2);
+  
+  if (path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(path, dep_dir, dir_length);
+  path[dir_length] = '/';
+  memcpy(path + dir_length + 1, intstr_char_ptr(module_id), id_length);
+  memcpy(path + dir_length + 1 + id_length, suffix, suffix_length + 1);
+  
+  return path;
+} /* end new_dep_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_file_contents(path, size)
+ * --------------------------------------------------------------------------
+ * Reads the file at path in one piece.  Returns a newly allocated buffer
+ * with its contents  and passes their length in size,  or returns NULL if
+ * the file cannot be read or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_file_contents (const char *path, size_t *size) {
+  
+  FILE *file;
+  char *data;
+  long length;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((length = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return NULL;
+  } /* end if */
+  
+  /* NUL terminated for interning */
+  data = malloc((size_t) length + 1);
+  
+  if (data == NULL) {
+    fclose(file);
+    return NULL;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) length, file) != (size_t) length) {
+    free(data);
+    fclose(file);
+    return NULL;
+  } /* end if */
+  
+  fclose(file);
+  
+  data[length] = ASCII_NUL;
+  *size = (size_t) length;
+  
+  return data;
+} /* end new_file_contents */
+
+
+/* END OF FILE */
@@ -0,0 +1,960 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-diagnostics.c                                                         *
+ *                                                                           *
+ * Implementation of per-module diagnostic buffer.                           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-diagnostics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#if (M2C_DIAG_THREAD_SAFE)
+#include <pthread.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities,  buffers grow by doubling
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_ENTRY_CAPACITY 16
+
+#define INITIAL_TEXT_CAPACITY 1024
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of the position prefix of a diagnostic
+ * ----------------------------------------------------------------------- */
+
+#define MAX_PREFIX_LENGTH 63
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a note on a diagnostic limit
+ * ----------------------------------------------------------------------- */
+
+#define MAX_NOTE_LENGTH 79
+
+
+/* --------------------------------------------------------------------------
+ * private type text_buffer_t
+ * --------------------------------------------------------------------------
+ * Record type for a growable character buffer.  Field overflow is set when
+ * the buffer could not be grown,  further appends are then ignored.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* chars */     char *chars;
+  /* length */    size_t length;
+  /* capacity */  size_t capacity;
+  /* overflow */  bool overflow;
+} text_buffer_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type diag_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for a pending diagnostic.  Field text holds the offset of its
+ * message in the text buffer of the diagnostic buffer,  field seqno the
+ * order in which it was added,  which breaks ties when sorting.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* line */      uint_t line;
+  /* column */    uint_t column;
+  /* seqno */     uint_t seqno;
+  /* severity */  m2c_diag_severity_t severity;
+  /* text */      size_t text;
+} diag_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type source_line_t
+ * --------------------------------------------------------------------------
+ * Record type for a source line fetched for a flush.  Field chars holds the
+ * offset of its characters in the source text buffer,  field found is set
+ * if the line was fetched.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* line */    uint_t line;
+  /* found */   bool found;
+  /* length */  uint_t length;
+  /* chars */   size_t chars;
+} source_line_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type source_context_t
+ * --------------------------------------------------------------------------
+ * Record type passed to the line visitor while fetching source lines.
+ * Lines are visited in ascending order,  field next is the array index of
+ * the next line expected.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* line */   source_line_t *line;
+  /* count */  uint_t count;
+  /* next */   uint_t next;
+  /* text */   text_buffer_t text;
+} source_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_diag_buffer_s
+ * --------------------------------------------------------------------------
+ * Record type representing a diagnostic buffer.  Field count holds the
+ * number of diagnostics added per severity,  field limit the maximum number
+ * stored per severity or zero,  field discarding is set per severity once
+ * its limit has been exceeded.
+ * ----------------------------------------------------------------------- */
+
+#define SEVERITY_COUNT (M2C_DIAG_NOTE + 1)
+
+struct m2c_diag_buffer_s {
+  /* filename */        const char *filename;
+  /* entry */           diag_entry_t *entry;
+  /* entry_count */     uint_t entry_count;
+  /* entry_capacity */  uint_t entry_capacity;
+  /* text */            text_buffer_t text;
+  /* seqno */           uint_t seqno;
+  /* count */           uint_t count[SEVERITY_COUNT];
+  /* limit */           uint_t limit[SEVERITY_COUNT];
+  /* discarding */      bool discarding[SEVERITY_COUNT];
+};
+
+typedef struct m2c_diag_buffer_s m2c_diag_buffer_s;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variables for the current buffer
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_DIAG_THREAD_SAFE)
+static pthread_key_t current_key;
+static pthread_once_t current_key_once = PTHREAD_ONCE_INIT;
+#else
+static m2c_diag_buffer_t current_buffer = NULL;
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private array severity_label
+ * ----------------------------------------------------------------------- */
+
+static const char *severity_label[SEVERITY_COUNT] = {
+  "error", "warning", "note"
+}; /* end severity_label */
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void add_entry
+  (m2c_diag_buffer_t buffer, m2c_diag_severity_t severity,
+   uint_t line, uint_t column, const char *text);
+
+static bool reserve (text_buffer_t *buf, size_t extra);
+
+static bool append_chars
+  (text_buffer_t *buf, const char *chars, size_t length);
+
+static void append_format (text_buffer_t *buf, const char *format, ...);
+
+static void format_prefix
+  (char *prefix, m2c_diag_severity_t severity, uint_t line, uint_t column);
+
+static int compare_entries (const void *entry1, const void *entry2);
+
+static bool fetch_source_lines
+  (m2c_diag_buffer_t buffer, infile_t infile, source_context_t *source);
+
+static void collect_line
+  (uint_t line_no, const char *chars, uint_t length, void *context);
+
+static void append_source_line
+  (text_buffer_t *out, source_context_t *source, uint_t *index,
+   uint_t line, uint_t column);
+
+#if (M2C_DIAG_THREAD_SAFE)
+static void create_current_key (void);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_new_buffer(filename)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty diagnostic buffer for filename.
+ * ----------------------------------------------------------------------- */
+
+m2c_diag_buffer_t m2c_diag_new_buffer (const char *filename) {
+  
+  m2c_diag_buffer_t buffer;
+  
+  buffer = calloc(1, sizeof(m2c_diag_buffer_s));
+  
+  if (buffer == NULL) {
+    return NULL;
+  } /* end if */
+  
+  buffer->filename = filename;
+  
+  return buffer;
+} /* end m2c_diag_new_buffer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_add(buffer, severity, line, column, text)
+ * --------------------------------------------------------------------------
+ * Adds a diagnostic with message text at line and column to buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_add
+  (m2c_diag_buffer_t buffer,       /* in */
+   m2c_diag_severity_t severity,   /* in */
+   uint_t line,                    /* in */
+   uint_t column,                  /* in */
+   const char *text) {             /* in */
+  
+  char note[MAX_NOTE_LENGTH + 1];
+  
+  if ((buffer == NULL) || (severity >= SEVERITY_COUNT) || (text == NULL)) {
+    return;
+  } /* end if */
+  
+  buffer->count[severity]++;
+  
+  if (buffer->discarding[severity]) {
+    return;
+  } /* end if */
+  
+  /* replace first diagnostic past the limit with a note */
+  if ((buffer->limit[severity] > 0) &&
+      (buffer->count[severity] > buffer->limit[severity])) {
+    snprintf(note, sizeof(note),
+      "%s limit of %u reached, further %ss not reported",
+      severity_label[severity], buffer->limit[severity],
+      severity_label[severity]);
+    add_entry(buffer, M2C_DIAG_NOTE, line, column, note);
+    
+    buffer->discarding[severity] = true;
+    return;
+  } /* end if */
+  
+  add_entry(buffer, severity, line, column, text);
+  
+  return;
+} /* end m2c_diag_add */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_set_limits(buffer, max_errors, max_warnings)
+ * --------------------------------------------------------------------------
+ * Limits the number of errors and warnings stored in buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_set_limits
+  (m2c_diag_buffer_t buffer, uint_t max_errors, uint_t max_warnings) {
+  
+  if (buffer == NULL) {
+    return;
+  } /* end if */
+  
+  buffer->limit[M2C_DIAG_ERROR] = max_errors;
+  buffer->limit[M2C_DIAG_WARNING] = max_warnings;
+  
+  return;
+} /* end m2c_diag_set_limits */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_limit_reached(buffer, severity)
+ * --------------------------------------------------------------------------
+ * Returns true if buffer holds as many diagnostics of severity as permitted.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_diag_limit_reached
+  (m2c_diag_buffer_t buffer, m2c_diag_severity_t severity) {
+  
+  if ((buffer == NULL) || (severity >= SEVERITY_COUNT) ||
+      (buffer->limit[severity] == 0)) {
+    return false;
+  } /* end if */
+  
+  return (buffer->count[severity] >= buffer->limit[severity]);
+} /* end m2c_diag_limit_reached */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_count(buffer, severity)
+ * --------------------------------------------------------------------------
+ * Returns the number of diagnostics of severity added to buffer.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_diag_count
+  (m2c_diag_buffer_t buffer, m2c_diag_severity_t severity) {
+  
+  if ((buffer == NULL) || (severity >= SEVERITY_COUNT)) {
+    return 0;
+  } /* end if */
+  
+  return buffer->count[severity];
+} /* end m2c_diag_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_flush(buffer, infile, show_source, stream)
+ * --------------------------------------------------------------------------
+ * Sorts the pending diagnostics of buffer by position,  writes them to
+ * stream with a single call and empties the buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_flush
+  (m2c_diag_buffer_t buffer,   /* in */
+   infile_t infile,            /* in */
+   bool show_source,           /* in */
+   FILE *stream) {             /* in */
+  
+  char prefix[MAX_PREFIX_LENGTH + 1];
+  source_context_t source;
+  text_buffer_t out;
+  diag_entry_t *entry;
+  uint_t index, line_index;
+  
+  if ((buffer == NULL) || (buffer->entry_count == 0) || (stream == NULL)) {
+    return;
+  } /* end if */
+  
+  qsort(buffer->entry, buffer->entry_count,
+    sizeof(diag_entry_t), compare_entries);
+  
+  /* fetch all source lines in one pass */
+  memset(&source, 0, sizeof(source_context_t));
+  
+  if ((show_source) && (infile != NULL)) {
+    show_source = fetch_source_lines(buffer, infile, &source);
+  }
+  else {
+    show_source = false;
+  } /* end if */
+  
+  /* compose report */
+  memset(&out, 0, sizeof(text_buffer_t));
+  
+  if (buffer->filename != NULL) {
+    append_format(&out, "%s:\n", buffer->filename);
+  } /* end if */
+  
+  line_index = 0;
+  for (index = 0; index < buffer->entry_count; index++) {
+    entry = &buffer->entry[index];
+    
+    format_prefix(prefix, entry->severity, entry->line, entry->column);
+    append_format(&out, "%s%s\n", prefix, &buffer->text.chars[entry->text]);
+    
+    if ((show_source) && (entry->line > 0)) {
+      append_source_line(&out, &source, &line_index,
+        entry->line, entry->column);
+    } /* end if */
+  } /* end for */
+  
+  /* write report with a single call */
+  if (out.length > 0) {
+    fwrite(out.chars, 1, out.length, stream);
+    fflush(stream);
+  } /* end if */
+  
+  free(out.chars);
+  free(source.line);
+  free(source.text.chars);
+  
+  /* empty buffer */
+  buffer->entry_count = 0;
+  buffer->text.length = 0;
+  buffer->text.overflow = false;
+  
+  return;
+} /* end m2c_diag_flush */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_merge(target, source)
+ * --------------------------------------------------------------------------
+ * Moves the pending diagnostics of source to target in order of addition.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_merge (m2c_diag_buffer_t target, m2c_diag_buffer_t source) {
+  
+  diag_entry_t *entry;
+  uint_t index;
+  
+  if ((target == NULL) || (source == NULL) || (target == source)) {
+    return;
+  } /* end if */
+  
+  /* pending entries are only reordered by a flush, which empties them */
+  for (index = 0; index < source->entry_count; index++) {
+    entry = &source->entry[index];
+    
+    m2c_diag_add(target, entry->severity,
+      entry->line, entry->column, &source->text.chars[entry->text]);
+  } /* end for */
+  
+  /* empty source */
+  source->entry_count = 0;
+  source->text.length = 0;
+  source->text.overflow = false;
+  
+  return;
+} /* end m2c_diag_merge */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_visit(buffer, visitor, context)
+ * --------------------------------------------------------------------------
+ * Sorts the pending diagnostics of buffer by position,  calls visitor for
+ * each and empties the buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_visit
+  (m2c_diag_buffer_t buffer,      /* in */
+   m2c_diag_visitor_t visitor,    /* in */
+   void *context) {               /* in */
+  
+  diag_entry_t *entry;
+  uint_t index;
+  
+  if ((buffer == NULL) || (buffer->entry_count == 0) || (visitor == NULL)) {
+    return;
+  } /* end if */
+  
+  qsort(buffer->entry, buffer->entry_count,
+    sizeof(diag_entry_t), compare_entries);
+  
+  for (index = 0; index < buffer->entry_count; index++) {
+    entry = &buffer->entry[index];
+    
+    visitor(entry->severity, entry->line, entry->column,
+      &buffer->text.chars[entry->text], context);
+  } /* end for */
+  
+  /* empty buffer */
+  buffer->entry_count = 0;
+  buffer->text.length = 0;
+  buffer->text.overflow = false;
+  
+  return;
+} /* end m2c_diag_visit */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_release(buffer)
+ * --------------------------------------------------------------------------
+ * Deallocates buffer,  discarding any pending diagnostics.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_release (m2c_diag_buffer_t buffer) {
+  
+  if (buffer == NULL) {
+    return;
+  } /* end if */
+  
+  if (m2c_diag_current() == buffer) {
+    m2c_diag_set_current(NULL);
+  } /* end if */
+  
+  free(buffer->entry);
+  free(buffer->text.chars);
+  free(buffer);
+  
+  return;
+} /* end m2c_diag_release */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_set_current(buffer)
+ * --------------------------------------------------------------------------
+ * Makes buffer the current buffer of the calling thread.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_set_current (m2c_diag_buffer_t buffer) {
+  
+#if (M2C_DIAG_THREAD_SAFE)
+  pthread_once(&current_key_once, create_current_key);
+  pthread_setspecific(current_key, buffer);
+#else
+  current_buffer = buffer;
+#endif
+  
+  return;
+} /* end m2c_diag_set_current */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_current()
+ * --------------------------------------------------------------------------
+ * Returns the current buffer of the calling thread,  or NULL if none.
+ * ----------------------------------------------------------------------- */
+
+m2c_diag_buffer_t m2c_diag_current (void) {
+  
+#if (M2C_DIAG_THREAD_SAFE)
+  pthread_once(&current_key_once, create_current_key);
+  return (m2c_diag_buffer_t) pthread_getspecific(current_key);
+#else
+  return current_buffer;
+#endif
+} /* end m2c_diag_current */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_accepts(severity)
+ * --------------------------------------------------------------------------
+ * Returns false if the current buffer discards diagnostics of severity.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_diag_accepts (m2c_diag_severity_t severity) {
+  
+  m2c_diag_buffer_t buffer;
+  
+  buffer = m2c_diag_current();
+  
+  if ((buffer == NULL) || (severity >= SEVERITY_COUNT)) {
+    return true;
+  } /* end if */
+  
+  return NOT(buffer->discarding[severity]);
+} /* end m2c_diag_accepts */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_emit(severity, line, column, text)
+ * --------------------------------------------------------------------------
+ * Adds a diagnostic to the current buffer,  or writes it at once if none.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_emit
+  (m2c_diag_severity_t severity, uint_t line, uint_t column, const char *text) {
+  
+  char prefix[MAX_PREFIX_LENGTH + 1];
+  m2c_diag_buffer_t buffer;
+  
+  if ((severity >= SEVERITY_COUNT) || (text == NULL)) {
+    return;
+  } /* end if */
+  
+  buffer = m2c_diag_current();
+  
+  if (buffer != NULL) {
+    m2c_diag_add(buffer, severity, line, column, text);
+  }
+  else /* no current buffer */ {
+    format_prefix(prefix, severity, line, column);
+    printf("%s%s\n", prefix, text);
+  } /* end if */
+  
+  return;
+} /* end m2c_diag_emit */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure add_entry(buffer, severity, line, column, text)
+ * --------------------------------------------------------------------------
+ * Stores a diagnostic in buffer,  growing its entry table as needed.  The
+ * diagnostic is lost if buffer cannot be grown.
+ * ----------------------------------------------------------------------- */
+
+static void add_entry
+  (m2c_diag_buffer_t buffer, m2c_diag_severity_t severity,
+   uint_t line, uint_t column, const char *text) {
+  
+  diag_entry_t *new_entry;
+  uint_t new_capacity;
+  size_t offset;
+  
+  /* grow entry table if full */
+  if (buffer->entry_count == buffer->entry_capacity) {
+    if (buffer->entry_capacity == 0) {
+      new_capacity = INITIAL_ENTRY_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * buffer->entry_capacity;
+    } /* end if */
+    
+    new_entry =
+      realloc(buffer->entry, new_capacity * sizeof(diag_entry_t));
+    
+    if (new_entry == NULL) {
+      return;
+    } /* end if */
+    
+    buffer->entry = new_entry;
+    buffer->entry_capacity = new_capacity;
+  } /* end if */
+  
+  /* copy text including its terminator */
+  offset = buffer->text.length;
+  
+  if (NOT(append_chars(&buffer->text, text, strlen(text) + 1))) {
+    return;
+  } /* end if */
+  
+  new_entry = &buffer->entry[buffer->entry_count];
+  new_entry->line = line;
+  new_entry->column = column;
+  new_entry->seqno = buffer->seqno;
+  new_entry->severity = severity;
+  new_entry->text = offset;
+  
+  buffer->entry_count++;
+  buffer->seqno++;
+  
+  return;
+} /* end add_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function reserve(buf, extra)
+ * --------------------------------------------------------------------------
+ * Grows buf to hold at least extra more characters.  Returns true on
+ * success,  false if buf could not be grown,  in which case its overflow
+ * flag is set.
+ * ----------------------------------------------------------------------- */
+
+static bool reserve (text_buffer_t *buf, size_t extra) {
+  
+  size_t new_capacity;
+  char *new_chars;
+  
+  if (buf->overflow) {
+    return false;
+  } /* end if */
+  
+  if (buf->length + extra <= buf->capacity) {
+    return true;
+  } /* end if */
+  
+  if (buf->capacity == 0) {
+    new_capacity = INITIAL_TEXT_CAPACITY;
+  }
+  else {
+    new_capacity = buf->capacity;
+  } /* end if */
+  
+  while (buf->length + extra > new_capacity) {
+    new_capacity = 2 * new_capacity;
+  } /* end while */
+  
+  new_chars = realloc(buf->chars, new_capacity);
+  
+  if (new_chars == NULL) {
+    buf->overflow = true;
+    return false;
+  } /* end if */
+  
+  buf->chars = new_chars;
+  buf->capacity = new_capacity;
+  
+  return true;
+} /* end reserve */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_chars(buf, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends length characters at chars to buf,  growing it as needed.
+ * Returns true on success,  false if buf overflowed.
+ * ----------------------------------------------------------------------- */
+
+static bool append_chars
+  (text_buffer_t *buf, const char *chars, size_t length) {
+  
+  if (NOT(reserve(buf, length))) {
+    return false;
+  } /* end if */
+  
+  memcpy(&buf->chars[buf->length], chars, length);
+  buf->length = buf->length + length;
+  
+  return true;
+} /* end append_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure append_format(buf, format, ...)
+ * --------------------------------------------------------------------------
+ * Appends formatted output to buf,  growing it as needed.
+ * ----------------------------------------------------------------------- */
+
+static void append_format (text_buffer_t *buf, const char *format, ...) {
+  
+  va_list args;
+  int length;
+  
+  va_start(args, format);
+  length = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+  
+  /* room for output and terminator */
+  if ((length <= 0) || (NOT(reserve(buf, (size_t) length + 1)))) {
+    return;
+  } /* end if */
+  
+  va_start(args, format);
+  vsnprintf(&buf->chars[buf->length], (size_t) length + 1, format, args);
+  va_end(args);
+  
+  buf->length = buf->length + (size_t) length;
+  
+  return;
+} /* end append_format */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure format_prefix(prefix, severity, line, column)
+ * --------------------------------------------------------------------------
+ * Writes the position and severity prefix of a diagnostic to prefix,  which
+ * must hold at least MAX_PREFIX_LENGTH + 1 characters.
+ * ----------------------------------------------------------------------- */
+
+static void format_prefix
+  (char *prefix, m2c_diag_severity_t severity, uint_t line, uint_t column) {
+  
+  if (line == 0) {
+    snprintf(prefix, MAX_PREFIX_LENGTH + 1,
+      "%s: ", severity_label[severity]);
+  }
+  else if (column == 0) {
+    snprintf(prefix, MAX_PREFIX_LENGTH + 1,
+      "line %u, %s: ", line, severity_label[severity]);
+  }
+  else {
+    snprintf(prefix, MAX_PREFIX_LENGTH + 1,
+      "line %u, column %u, %s: ", line, column, severity_label[severity]);
+  } /* end if */
+  
+  return;
+} /* end format_prefix */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_entries(entry1, entry2)
+ * --------------------------------------------------------------------------
+ * Compares two diagnostics by line,  column and order added,  for qsort.
+ * ----------------------------------------------------------------------- */
+
+static int compare_entries (const void *entry1, const void *entry2) {
+  
+  const diag_entry_t *e1, *e2;
+  
+  e1 = (const diag_entry_t *) entry1;
+  e2 = (const diag_entry_t *) entry2;
+  
+  if (e1->line != e2->line) {
+    return (e1->line < e2->line) ? -1 : 1;
+  }
+  else if (e1->column != e2->column) {
+    return (e1->column < e2->column) ? -1 : 1;
+  }
+  else if (e1->seqno != e2->seqno) {
+    return (e1->seqno < e2->seqno) ? -1 : 1;
+  } /* end if */
+  
+  return 0;
+} /* end compare_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private function fetch_source_lines(buffer, infile, source)
+ * --------------------------------------------------------------------------
+ * Fetches the source lines referred to by the sorted pending diagnostics of
+ * buffer from infile in a single pass and passes them in source.  Returns
+ * true on success,  false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool fetch_source_lines
+  (m2c_diag_buffer_t buffer, infile_t infile, source_context_t *source) {
+  
+  uint_t *line_no;
+  uint_t index, count, line;
+  
+  line_no = malloc(buffer->entry_count * sizeof(uint_t));
+  source->line = malloc(buffer->entry_count * sizeof(source_line_t));
+  
+  if ((line_no == NULL) || (source->line == NULL)) {
+    free(line_no);
+    return false;
+  } /* end if */
+  
+  /* collect distinct line numbers in ascending order */
+  count = 0;
+  for (index = 0; index < buffer->entry_count; index++) {
+    line = buffer->entry[index].line;
+    
+    if ((line > 0) && ((count == 0) || (line_no[count - 1] != line))) {
+      line_no[count] = line;
+      source->line[count].line = line;
+      source->line[count].found = false;
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  source->count = count;
+  source->next = 0;
+  
+  infile_visit_lines(infile, count, line_no, collect_line, source);
+  
+  free(line_no);
+  
+  return NOT(source->text.overflow);
+} /* end fetch_source_lines */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_line(line_no, chars, length, context)
+ * --------------------------------------------------------------------------
+ * Line visitor to copy a fetched source line into the source context.
+ * ----------------------------------------------------------------------- */
+
+static void collect_line
+  (uint_t line_no, const char *chars, uint_t length, void *context) {
+  
+  source_context_t *source;
+  source_line_t *entry;
+  
+  source = (source_context_t *) context;
+  
+  /* lines arrive in ascending order */
+  while ((source->next < source->count) &&
+         (source->line[source->next].line < line_no)) {
+    source->next++;
+  } /* end while */
+  
+  if ((source->next >= source->count) ||
+      (source->line[source->next].line != line_no)) {
+    return;
+  } /* end if */
+  
+  entry = &source->line[source->next];
+  entry->chars = source->text.length;
+  entry->length = length;
+  
+  if (append_chars(&source->text, chars, length)) {
+    entry->found = true;
+  } /* end if */
+  
+  source->next++;
+  
+  return;
+} /* end collect_line */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure append_source_line(out, source, index, line, column)
+ * --------------------------------------------------------------------------
+ * Appends source line line to out  followed by a line with a caret under
+ * column,  tabs in the source are repeated so that the caret lines up.
+ * The diagnostics are sorted,  index is advanced from its previous value.
+ * ----------------------------------------------------------------------- */
+
+static void append_source_line
+  (text_buffer_t *out, source_context_t *source, uint_t *index,
+   uint_t line, uint_t column) {
+  
+  source_line_t *entry;
+  const char *chars;
+  uint_t n;
+  
+  while ((*index < source->count) && (source->line[*index].line < line)) {
+    (*index)++;
+  } /* end while */
+  
+  if ((*index >= source->count) || (NOT(source->line[*index].found))) {
+    return;
+  } /* end if */
+  
+  entry = &source->line[*index];
+  chars = &source->text.chars[entry->chars];
+  
+  /* print the line */
+  append_chars(out, chars, entry->length);
+  append_chars(out, "\n", 1);
+  
+  /* advance to column */
+  n = 1;
+  while (n < column) {
+    if ((n <= entry->length) && (chars[n - 1] == ASCII_TAB)) {
+      append_chars(out, "\t", 1);
+    }
+    else {
+      append_chars(out, " ", 1);
+    } /* end if */
+    n++;
+  } /* end while */
+  
+  /* mark the column with a caret */
+  append_chars(out, "^\n\n", 3);
+  
+  return;
+} /* end append_source_line */
+
+
+#if (M2C_DIAG_THREAD_SAFE)
+/* --------------------------------------------------------------------------
+ * private procedure create_current_key()
+ * --------------------------------------------------------------------------
+ * Creates the thread specific key holding the current buffer of a thread.
+ * ----------------------------------------------------------------------- */
+
+static void create_current_key (void) {
+  pthread_key_create(&current_key, NULL);
+} /* end create_current_key */
+#endif
+
+
+/* END OF FILE */
@@ -37,32 +37,64 @@
   * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
   * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-#ifndef M2C_DIGEST_H
-#define M2C_DIGEST_H
-
 /* --------------------------------------------------------------------------
  * imports
  * ----------------------------------------------------------------------- */
 
 #include "m2c-digest.h"
+#include "m2c-common.h"
 
+#include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 
 /* --------------------------------------------------------------------------
- * type m2c_digest_t
+ * Maximum number of words between reductions
  * --------------------------------------------------------------------------
- * Type to hold a digest context.
+ * Starting from reduced sums,  up to 359 words of 16 bits may be added to
+ * the 32-bit sums c0 and c1 without overflow.
  * ----------------------------------------------------------------------- */
 
-typedef struct {
-  m2c_digest_value_t c0, c1;
-  char remaining_char;
-  bool finalized;
-} m2c_digest_s;
+#define MAX_WORDS_BEFORE_REDUCTION 359
+
+
+/* --------------------------------------------------------------------------
+ * private macros for Fletcher-32 arithmetic
+ * ----------------------------------------------------------------------- */
+
+#define FLETCHER_MODULUS 0xFFFF
+
+#define BIG_ENDIAN_WORD(_bytes, _index) \
+  ((((uint32_t) (_bytes)[_index]) << 8) | ((uint32_t) (_bytes)[(_index)+1]))
+
+#define ADD_WORD(_c0, _c1, _word) \
+  { _c0 = _c0 + (_word); _c1 = _c1 + _c0; }
+
 
-typedef m2c_digest_s *m2c_digest_t;
+static void digest_add_bytes
+  (m2c_digest_t digest, const uint8_t *bytes, uint_t len);
+
+static void digest_add_cstr
+  (m2c_digest_t digest, m2c_digest_mode_t mode,
+   uint_t len, const char *lexstr);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_digest_reset(context)
+ * --------------------------------------------------------------------------
+ * Initialises an embedded or stack allocated digest context.
+ * ----------------------------------------------------------------------- */
+
+void m2c_digest_reset (m2c_digest_t digest) {
+  
+  digest->c0 = 0;
+  digest->c1 = 0;
+  digest->word_count = 0;
+  digest->odd_byte = 0;
+  digest->has_odd_byte = false;
+  digest->finalized = false;
+} /* end m2c_digest_reset */
 
 
 /* --------------------------------------------------------------------------
@@ -80,11 +112,7 @@ m2c_digest_t m2c_digest_init (void) {
     return NULL;
   } /* end if */
   
-  new_context->c0 = 0;
-  new_context->c1 = 0;
-  new_context->remaining_char = ASCII_NUL;
-  new_context->prepend_spacer = false;
-  new_context->finalized = false;
+  m2c_digest_reset(new_context);
   
   return new_context;
 } /* end m2c_digest_init */
@@ -97,25 +125,24 @@ m2c_digest_t m2c_digest_init (void) {
  * prepending a single whitespace depending on mode.
  * ----------------------------------------------------------------------- */
 
-static void digest_add_cstr
-  (m2c_digest_t digest, m2c_digest_mode_t mode,
-   uint16_t len, const char *lexstr);
-  
 void m2c_digest_add_token
   (m2c_digest_t digest, m2c_digest_mode_t mode, m2c_token_t token) {
   
   const char *lexstr;
-  uint16_t len;
+  uint_t len;
   
   lexstr = m2c_lexeme_for_special_symbol(token);
   
+  if (lexstr == NULL) {
+    return;
+  } /* end if */
+  
   len = 0;
   while (lexstr[len] != ASCII_NUL) {
     len++;
   } /* end while */
   
   digest_add_cstr(digest, mode, len, lexstr);
-  
 } /* end m2c_digest_add_token */
 
 
@@ -128,31 +155,38 @@ void m2c_digest_add_token
 
 void m2c_digest_add_lexeme
   (m2c_digest_t digest, m2c_digest_mode_t mode, intstr_t lexeme) {
- 
+  
+  if (lexeme == NULL) {
+    return;
+  } /* end if */
+  
   digest_add_cstr
     (digest, mode, intstr_length(lexeme), intstr_char_ptr(lexeme));
-  
 } /* end m2c_digest_add_lexeme */
-  
+
 
 /* --------------------------------------------------------------------------
  * function m2c_digest_finalize(context)
  * --------------------------------------------------------------------------
- * Finalizes the digest calculation of context.
+ * Finalizes the digest calculation of context.  A pending odd byte is added
+ * as the high byte of a final word and the sums are fully reduced.
  * ----------------------------------------------------------------------- */
 
 void m2c_digest_finalize (m2c_digest_t digest) {
-  if (digest->remaining_char != ASCII_NUL) {
-    word = digest->remaining_char << 8;
-    digest->remaining_char = ASCII_NUL;
-    
-    digest->c0 = digest->c0 + word;
-    digest->c1 = digest->c1 + digest->c0;
-    
-    digest->c0 = digest->c0 % 0xFFFF;
-    digest->c1 = digest->c1 % 0xFFFF;
+  
+  if (digest->finalized) {
+    return;
   } /* end if */
   
+  if (digest->has_odd_byte) {
+    ADD_WORD(digest->c0, digest->c1, ((uint32_t) digest->odd_byte) << 8);
+    digest->has_odd_byte = false;
+  } /* end if */
+  
+  digest->c0 = digest->c0 % FLETCHER_MODULUS;
+  digest->c1 = digest->c1 % FLETCHER_MODULUS;
+  digest->word_count = 0;
+  
   digest->finalized = true;
 } /* end m2c_digest_finalize */
 
@@ -165,25 +199,28 @@ void m2c_digest_finalize (m2c_digest_t digest) {
 
 m2c_digest_value_t m2c_digest_value (m2c_digest_t digest) {
   
-  return digest->c1 << 16 | digest->c0;
-  
+  return ((digest->c1 % FLETCHER_MODULUS) << 16) |
+    (digest->c0 % FLETCHER_MODULUS);
 } /* end m2c_digest_value */
 
 
 /* --------------------------------------------------------------------------
  * function m2c_digest_release(context)
  * --------------------------------------------------------------------------
- * Releases context, returns NULL.
+ * Releases a context allocated by m2c_digest_init, returns NULL.
  * ----------------------------------------------------------------------- */
 
 m2c_digest_t m2c_digest_release (m2c_digest_t digest) {
-
+  
   free(digest);
   return NULL;
-
 } /* end m2c_digest_release */
 
 
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
 /* --------------------------------------------------------------------------
  * private procedure digest_add_cstr(context, mode, len, lexstr)
  * --------------------------------------------------------------------------
@@ -191,78 +228,103 @@ m2c_digest_t m2c_digest_release (m2c_digest_t digest) {
  * a single whitespace depending on mode.
  * ----------------------------------------------------------------------- */
 
-#define IS_ODD(_n) (_n & 1)
-
 static void digest_add_cstr
-  (m2c_digest_t digest, m2c_digest_mode_t mode, 
-   uint16_t len, const char *lexstr) {
+  (m2c_digest_t digest, m2c_digest_mode_t mode,
+   uint_t len, const char *lexstr) {
+  
+  static const uint8_t spacer = ASCII_SPACE;
+  
+  if (mode == M2C_DIGEST_PREPEND_SPACER) {
+    digest_add_bytes(digest, &spacer, 1);
+  } /* end if */
+  
+  digest_add_bytes(digest, (const uint8_t *) lexstr, len);
+} /* end digest_add_cstr */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure digest_add_bytes(context, bytes, len)
+ * --------------------------------------------------------------------------
+ * Adds len bytes to the rolling Fletcher-32 digest of context as big endian
+ * 16-bit words,  four words per step.  A trailing odd byte is kept pending
+ * and combined with the first byte of the next call.   Reduction modulo
+ * 0xFFFF is deferred until MAX_WORDS_BEFORE_REDUCTION words have been added.
+ * ----------------------------------------------------------------------- */
+
+static void digest_add_bytes
+  (m2c_digest_t digest, const uint8_t *bytes, uint_t len) {
   
-  uint16_t word, index;
+  uint32_t c0, c1, word_count, budget, count;
+  uint_t index;
+  
+  if (len == 0) {
+    return;
+  } /* end if */
   
-  /* rolling fletcher-32 digest calculation */
-  if (digest->remaining_char != ASCII_NUL) {
+  c0 = digest->c0;
+  c1 = digest->c1;
+  word_count = digest->word_count;
+  index = 0;
+  
+  /* complete pending word */
+  if (digest->has_odd_byte) {
+    if (word_count == MAX_WORDS_BEFORE_REDUCTION) {
+      c0 = c0 % FLETCHER_MODULUS;
+      c1 = c1 % FLETCHER_MODULUS;
+      word_count = 0;
+    } /* end if */
     
-    word = digest->remaining_char << 8;
+    ADD_WORD(c0, c1, (((uint32_t) digest->odd_byte) << 8) | bytes[0]);
+    word_count++;
+    digest->has_odd_byte = false;
+    index = 1;
+  } /* end if */
+  
+  /* add whole words */
+  while (len - index >= 2) {
+    budget = MAX_WORDS_BEFORE_REDUCTION - word_count;
     
-    if (mode == M2C_DIGEST_PREPEND_SPACER) {
-      word = word | 0x20;
-      index = 0;
-    }
-    else /* no spacer */ {
-      word = word | lexstr[0];
-      index = 1;
+    if (budget == 0) {
+      c0 = c0 % FLETCHER_MODULUS;
+      c1 = c1 % FLETCHER_MODULUS;
+      word_count = 0;
+      budget = MAX_WORDS_BEFORE_REDUCTION;
     } /* end if */
-        
-    if (IS_ODD(len-index)) {
-      len = len - 1;
-      digest->remaining_char = lexstr[len];
-    }
-    else {
-      digest->remaining_char = ASCII_NUL;
+    
+    count = (len - index) / 2;
+    if (count > budget) {
+      count = budget;
     } /* end if */
-  }
-  else /* no remaining character */ {
     
-    if (mode == M2C_DIGEST_PREPEND_SPACER) {
-      if(IS_ODD(len+1)) {
-        len = len - 1;
-        digest->remaining_char = lexstr[len];
-      } /* end if */
+    word_count = word_count + count;
     
-      word = 0x2000; /* whitespace << 8 */
-      word = word | lexstr[0];
-      index = 1;
-    }
-    else /* no spacer */ {
-      if (len == 1) {
-        digest->remaining_char = lexstr[0];
-        return;
-      }
-      else if (IS_ODD(len)) {
-        len = len - 1;
-        digest->remaining_char = lexstr[len];
-      } /* end if */
+    /* eight bytes per step */
+    while (count >= 4) {
+      ADD_WORD(c0, c1, BIG_ENDIAN_WORD(bytes, index));
+      ADD_WORD(c0, c1, BIG_ENDIAN_WORD(bytes, index + 2));
+      ADD_WORD(c0, c1, BIG_ENDIAN_WORD(bytes, index + 4));
+      ADD_WORD(c0, c1, BIG_ENDIAN_WORD(bytes, index + 6));
+      index = index + 8;
+      count = count - 4;
+    } /* end while */
     
-      word = lexstr[0] << 8;
-      word = word | lexstr[1];
-      index = 2;
-    } /* end if */
-  } /* end if */
-  
-  digest->c0 = digest->c0 + word;
-  digest->c1 = digest->c1 + digest->c0;
-  
-  while (index < len) {
-    word = (lexstr[index] << 8); index++;
-    word = word | lexstr[index]; index++;
-    digest->c0 = digest->c0 + word;
-    digest->c1 = digest->c1 + digest->c0;
+    while (count > 0) {
+      ADD_WORD(c0, c1, BIG_ENDIAN_WORD(bytes, index));
+      index = index + 2;
+      count--;
+    } /* end while */
   } /* end while */
   
-  digest->c0 = digest->c0 % 0xFFFF;
-  digest->c1 = digest->c1 % 0xFFFF;
+  /* keep trailing odd byte pending */
+  if (index < len) {
+    digest->odd_byte = bytes[index];
+    digest->has_odd_byte = true;
+  } /* end if */
   
-  return;
-} /* end digest_add_cstr */
+  digest->c0 = c0;
+  digest->c1 = c1;
+  digest->word_count = word_count;
+} /* end digest_add_bytes */
+
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,1533 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-document.c                                                            *
+ *                                                                           *
+ * Implementation of resident source documents with incremental reparsing.   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-document.h"
+#include "m2c-parser.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Line states
+ * --------------------------------------------------------------------------
+ * The state of the lexer at the start of a line.  The low bits hold the kind
+ * of text the line starts in,  the remaining bits the nesting level of block
+ * comments.  Only a line that starts in code can start a reparse.
+ * ----------------------------------------------------------------------- */
+
+#define LINE_STATE_CODE 0
+#define LINE_STATE_COMMENT 1
+#define LINE_STATE_PRAGMA 2
+#define LINE_STATE_SINGLE_QUOTED 3
+#define LINE_STATE_DOUBLE_QUOTED 4
+#define LINE_STATE_DISABLED 5
+
+#define LINE_STATE_KIND_MASK 0x0F
+#define LINE_STATE_LEVEL_SHIFT 4
+
+
+/* --------------------------------------------------------------------------
+ * private type line_t
+ * --------------------------------------------------------------------------
+ * Record type for the offset of the first character of a line in the text
+ * of a document and the line state at that offset.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* offset */  size_t offset;
+  /* state */   uint_t state;
+} line_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type diag_t
+ * --------------------------------------------------------------------------
+ * Record type for a diagnostic held by a document.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* line */      uint_t line;
+  /* column */    uint_t column;
+  /* severity */  m2c_diag_severity_t severity;
+  /* text */      char *text;
+} diag_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type diag_list_t
+ * --------------------------------------------------------------------------
+ * Record type for a list of diagnostics in order of source position.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* entry */     diag_t *entry;
+  /* count */     uint_t count;
+  /* capacity */  uint_t capacity;
+} diag_list_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type span_t
+ * --------------------------------------------------------------------------
+ * Record type for a top-level definition,  the lines of its first and last
+ * symbol,  the region its AST was built in if it has been reparsed,  the
+ * revision in which its AST was last replaced  and its diagnostics.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* first_line */  uint_t first_line;
+  /* last_line */   uint_t last_line;
+  /* defn */        m2c_astnode_t defn;
+  /* region */      m2c_ast_region_t region;
+  /* revision */    uint_t revision;
+  /* diags */       diag_list_t diags;
+} span_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type parse_state_t
+ * --------------------------------------------------------------------------
+ * Record type for the result of a parse:  the region of the AST,  the AST,
+ * its definition list if its definitions are tracked,  the definitions and
+ * the diagnostics outside of definitions.  Failed is set if allocation
+ * failed while collecting definitions or diagnostics.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* region */         m2c_ast_region_t region;
+  /* ast */            m2c_astnode_t ast;
+  /* defn_list */      m2c_astnode_t defn_list;
+  /* span */           span_t *span;
+  /* span_count */     uint_t span_count;
+  /* span_capacity */  uint_t span_capacity;
+  /* outer */          diag_list_t outer;
+  /* failed */         bool failed;
+} parse_state_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_document_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a resident source document.  If stale is set,
+ * the text has changed since the AST was built  and the next update is to
+ * reparse the whole text.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_document_struct_t {
+  /* name */        char *name;
+  /* options */     m2c_compiler_options_t options;
+  /* text */        char *text;
+  /* length */      size_t length;
+  /* line */        line_t *line;
+  /* line_count */  uint_t line_count;
+  /* state */       parse_state_t state;
+  /* revision */    uint_t revision;
+  /* update */      m2c_document_update_t update;
+  /* stale */       bool stale;
+};
+
+typedef struct m2c_document_struct_t m2c_document_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool scan_lines (m2c_document_t doc);
+
+static bool parse_document (m2c_document_t doc);
+
+static int enclosing_span
+  (m2c_document_t doc, uint_t first_line, uint_t last_line, uint_t *end_line);
+
+static bool splice_text
+  (m2c_document_t doc, size_t start, size_t end,
+   const char *text, size_t length, uint_t last_line, uint_t *converged);
+
+static bool reparse_span
+  (m2c_document_t doc, uint_t index, uint_t end_line, long delta);
+
+static size_t position (m2c_document_t doc, uint_t line, uint_t col);
+
+static size_t line_end (m2c_document_t doc, uint_t line);
+
+static void release_state (parse_state_t *state);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_new(name, text, length, options)
+ * --------------------------------------------------------------------------
+ * Returns a new document for source name with a copy of text,  parsed with
+ * options.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_document_t m2c_document_new
+  (const char *name,                  /* in */
+   const char *text,                  /* in */
+   size_t length,                     /* in */
+   m2c_compiler_options_t options) {  /* in */
+
+  m2c_document_t new_doc;
+
+  if ((name == NULL) || ((text == NULL) && (length > 0))) {
+    return NULL;
+  } /* end if */
+  
+  new_doc = calloc(1, sizeof(m2c_document_struct_t));
+  
+  if (new_doc == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_doc->name = malloc(strlen(name) + 1);
+  new_doc->text = malloc(length + 1);
+  
+  if ((new_doc->name == NULL) || (new_doc->text == NULL)) {
+    free(new_doc->name);
+    free(new_doc->text);
+    free(new_doc);
+    return NULL;
+  } /* end if */
+  
+  strcpy(new_doc->name, name);
+  
+  if (length > 0) {
+    memcpy(new_doc->text, text, length);
+  } /* end if */
+  
+  new_doc->text[length] = ASCII_NUL;
+  new_doc->length = length;
+  new_doc->options = options;
+  new_doc->update = M2C_DOCUMENT_UPDATE_FULL;
+  
+  if ((scan_lines(new_doc) == false) || (parse_document(new_doc) == false)) {
+    m2c_document_release(new_doc);
+    return NULL;
+  } /* end if */
+  
+  return new_doc;
+} /* end m2c_document_new */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_replace_text(doc, text, length)
+ * --------------------------------------------------------------------------
+ * Replaces the contents of doc by a copy of text and reparses it in whole.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_document_replace_text
+  (m2c_document_t doc, const char *text, size_t length) {
+  
+  char *new_text;
+  char *old_text;
+  size_t old_length;
+  
+  if ((doc == NULL) || ((text == NULL) && (length > 0))) {
+    return false;
+  } /* end if */
+  
+  new_text = malloc(length + 1);
+  
+  if (new_text == NULL) {
+    return false;
+  } /* end if */
+  
+  if (length > 0) {
+    memcpy(new_text, text, length);
+  } /* end if */
+  
+  new_text[length] = ASCII_NUL;
+  
+  /* keep the old text until the new lines have been scanned */
+  old_text = doc->text;
+  old_length = doc->length;
+  
+  doc->text = new_text;
+  doc->length = length;
+  
+  if (scan_lines(doc) == false) {
+    doc->text = old_text;
+    doc->length = old_length;
+    free(new_text);
+    return false;
+  } /* end if */
+  
+  free(old_text);
+  
+  doc->update = M2C_DOCUMENT_UPDATE_FULL;
+  doc->stale = true;
+  
+  return parse_document(doc);
+} /* end m2c_document_replace_text */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_edit(doc, first_line, first_col, ...)
+ * --------------------------------------------------------------------------
+ * Replaces a range of characters of doc,  relexes the line states of the
+ * edited lines  and reparses the enclosing definition if the edit is
+ * confined to one,  otherwise the whole text.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_document_edit
+  (m2c_document_t doc,               /* in */
+   uint_t first_line,                /* in */
+   uint_t first_col,                 /* in */
+   uint_t last_line,                 /* in */
+   uint_t last_col,                  /* in */
+   const char *text,                 /* in */
+   size_t length) {                  /* in */
+
+  int index;
+  long delta;
+  size_t start, end;
+  uint_t old_count, end_line, converged;
+  span_t *span;
+
+  /* check pre-conditions */
+  if ((doc == NULL) || ((text == NULL) && (length > 0)) ||
+      (first_line == 0) || (first_col == 0) ||
+      (last_line == 0) || (last_col == 0) ||
+      (first_line > last_line) || (last_line > doc->line_count)) {
+    return false;
+  } /* end if */
+
+  start = position(doc, first_line, first_col);
+  end = position(doc, last_line, last_col);
+
+  if (start > end) {
+    return false;
+  } /* end if */
+  
+  /* find the definition enclosing the edit before the lines move */
+  index = enclosing_span(doc, first_line, last_line, &end_line);
+  old_count = doc->line_count;
+  
+  if (splice_text(doc, start, end, text, length, last_line, &converged)
+      == false) {
+    return false;
+  } /* end if */
+  
+  delta = (long) doc->line_count - (long) old_count;
+  
+  /* reparse the enclosing definition if the edit cannot affect others */
+  if (index >= 0) {
+    span = &doc->state.span[index];
+  
+    if (((doc->line[span->first_line - 1].state) == LINE_STATE_CODE) &&
+        (converged <= end_line + 1) &&
+        ((long) end_line + delta >= (long) span->first_line) &&
+        (reparse_span(doc, (uint_t) index, end_line, delta))) {
+      doc->update = M2C_DOCUMENT_UPDATE_DEFINITION;
+      return true;
+    } /* end if */
+  } /* end if */
+  
+  doc->update = M2C_DOCUMENT_UPDATE_FULL;
+  doc->stale = true;
+  
+  return parse_document(doc);
+} /* end m2c_document_edit */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_last_update(doc)
+ * --------------------------------------------------------------------------
+ * Returns the extent of reparsing done by the most recent update of doc.
+ * ----------------------------------------------------------------------- */
+
+m2c_document_update_t m2c_document_last_update (m2c_document_t doc) {
+  
+  if (doc == NULL) {
+    return M2C_DOCUMENT_UPDATE_FULL;
+  } /* end if */
+  
+  return doc->update;
+} /* end m2c_document_last_update */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_line_count(doc)
+ * --------------------------------------------------------------------------
+ * Returns the number of lines of doc.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_line_count (m2c_document_t doc) {
+  
+  if (doc == NULL) {
+    return 0;
+  } /* end if */
+  
+  return doc->line_count;
+} /* end m2c_document_line_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_line(doc, line, length)
+ * --------------------------------------------------------------------------
+ * Returns the characters of line line of doc  and passes their number in
+ * length.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_document_line
+  (m2c_document_t doc, uint_t line, uint_t *length) {
+  
+  size_t start;
+  
+  if ((doc == NULL) || (line == 0) || (line > doc->line_count)) {
+    SET_STATUS(length, 0);
+    return NULL;
+  } /* end if */
+  
+  start = doc->line[line - 1].offset;
+  SET_STATUS(length, (uint_t) (line_end(doc, line) - start));
+  
+  return &doc->text[start];
+} /* end m2c_document_line */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_ast(doc)
+ * --------------------------------------------------------------------------
+ * Returns the AST of doc.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_document_ast (m2c_document_t doc) {
+  
+  if (doc == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return doc->state.ast;
+} /* end m2c_document_ast */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_revision(doc)
+ * --------------------------------------------------------------------------
+ * Returns the revision of doc.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_revision (m2c_document_t doc) {
+  
+  if (doc == NULL) {
+    return 0;
+  } /* end if */
+  
+  return doc->revision;
+} /* end m2c_document_revision */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_defn_count(doc)
+ * --------------------------------------------------------------------------
+ * Returns the number of top-level definitions of doc that are tracked.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_defn_count (m2c_document_t doc) {
+  
+  if (doc == NULL) {
+    return 0;
+  } /* end if */
+  
+  return doc->state.span_count;
+} /* end m2c_document_defn_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_defn(doc, index)
+ * --------------------------------------------------------------------------
+ * Returns the AST of the top-level definition of doc at index.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_document_defn (m2c_document_t doc, uint_t index) {
+  
+  if ((doc == NULL) || (index >= doc->state.span_count)) {
+    return NULL;
+  } /* end if */
+  
+  return doc->state.span[index].defn;
+} /* end m2c_document_defn */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_defn_revision(doc, index)
+ * --------------------------------------------------------------------------
+ * Returns the revision in which the definition at index was last replaced.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_defn_revision (m2c_document_t doc, uint_t index) {
+  
+  if ((doc == NULL) || (index >= doc->state.span_count)) {
+    return 0;
+  } /* end if */
+  
+  return doc->state.span[index].revision;
+} /* end m2c_document_defn_revision */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_document_visit_diagnostics(doc, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor for each diagnostic of doc in order of source position.  The
+ * diagnostics of the definitions are in order as the definitions are,  they
+ * are merged with those outside of definitions.
+ * ----------------------------------------------------------------------- */
+
+static bool precedes (const diag_t *diag1, const diag_t *diag2);
+
+void m2c_document_visit_diagnostics
+  (m2c_document_t doc, m2c_diag_visitor_t visitor, void *context) {
+  
+  uint_t outer_index, span_index, index;
+  diag_list_t *outer;
+  diag_t *next;
+  
+  if ((doc == NULL) || (visitor == NULL)) {
+    return;
+  } /* end if */
+  
+  outer = &doc->state.outer;
+  outer_index = 0;
+  span_index = 0;
+  index = 0;
+  
+  while (true) {
+  
+    /* next diagnostic of a definition */
+    while ((span_index < doc->state.span_count) &&
+           (index >= doc->state.span[span_index].diags.count)) {
+      span_index++;
+      index = 0;
+    } /* end while */
+  
+    if (span_index < doc->state.span_count) {
+      next = &doc->state.span[span_index].diags.entry[index];
+    }
+    else /* none left */ {
+      next = NULL;
+    } /* end if */
+  
+    /* take the diagnostic outside of definitions if it comes first */
+    if ((outer_index < outer->count) &&
+        ((next == NULL) || (precedes(&outer->entry[outer_index], next)))) {
+      next = &outer->entry[outer_index];
+      outer_index++;
+    }
+    else if (next != NULL) {
+      index++;
+    }
+    else /* all visited */ {
+      break;
+    } /* end if */
+  
+    visitor(next->severity, next->line, next->column, next->text, context);
+  } /* end while */
+  
+  return;
+} /* end m2c_document_visit_diagnostics */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_document_release(doc)
+ * --------------------------------------------------------------------------
+ * Deallocates doc,  its AST and its diagnostics.
+ * ----------------------------------------------------------------------- */
+
+void m2c_document_release (m2c_document_t doc) {
+  
+  if (doc == NULL) {
+    return;
+  } /* end if */
+  
+  release_state(&doc->state);
+  free(doc->line);
+  free(doc->text);
+  free(doc->name);
+  free(doc);
+  
+  return;
+} /* end m2c_document_release */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function scan_line(text, length, pos, state, terminated)
+ * --------------------------------------------------------------------------
+ * Scans the line of text starting at position pos in line state state  and
+ * returns the position of the next line,  passing its line state in state.
+ * Passes false in terminated  if the line is the last line of text.  Block
+ * comments nest,  string literals may span lines,  disabled code sections
+ * start and end at the first column of a line.
+ * ----------------------------------------------------------------------- */
+
+static size_t scan_line
+  (const char *text, size_t length, size_t pos,
+   uint_t *state, bool *terminated) {
+  
+  char ch, next_ch;
+  uint_t kind, level;
+  
+  kind = *state & LINE_STATE_KIND_MASK;
+  level = *state >> LINE_STATE_LEVEL_SHIFT;
+  
+  /* disabled code sections */
+  if ((pos + 1 < length) && (kind == LINE_STATE_CODE) &&
+      (text[pos] == '?') && (text[pos + 1] == '<')) {
+    kind = LINE_STATE_DISABLED;
+    pos = pos + 2;
+  }
+  else if ((pos + 1 < length) && (kind == LINE_STATE_DISABLED) &&
+           (text[pos] == '>') && (text[pos + 1] == '?')) {
+    kind = LINE_STATE_CODE;
+    pos = pos + 2;
+  } /* end if */
+  
+  *terminated = false;
+  
+  while (pos < length) {
+    ch = text[pos];
+  
+    /* line terminator LF, CR or CR LF */
+    if ((ch == ASCII_LF) || (ch == ASCII_CR)) {
+      pos++;
+      if ((ch == ASCII_CR) && (pos < length) && (text[pos] == ASCII_LF)) {
+        pos++;
+      } /* end if */
+      *terminated = true;
+      break;
+    } /* end if */
+  
+    next_ch = (pos + 1 < length) ? text[pos + 1] : ASCII_NUL;
+  
+    switch (kind) {
+  
+      case LINE_STATE_CODE :
+        if (ch == '!') {
+          /* line comment, skip to end of line */
+          while ((pos < length) &&
+                 (text[pos] != ASCII_LF) && (text[pos] != ASCII_CR)) {
+            pos++;
+          } /* end while */
+        }
+        else if ((ch == '(') && (next_ch == '*')) {
+          kind = LINE_STATE_COMMENT;
+          level = 1;
+          pos = pos + 2;
+        }
+        else if ((ch == '<') && (next_ch == '*')) {
+          kind = LINE_STATE_PRAGMA;
+          pos = pos + 2;
+        }
+        else if (ch == '\'') {
+          kind = LINE_STATE_SINGLE_QUOTED;
+          pos++;
+        }
+        else if (ch == '\"') {
+          kind = LINE_STATE_DOUBLE_QUOTED;
+          pos++;
+        }
+        else /* any other character */ {
+          pos++;
+        } /* end if */
+        break;
+  
+      case LINE_STATE_COMMENT :
+        if ((ch == '(') && (next_ch == '*')) {
+          level++;
+          pos = pos + 2;
+        }
+        else if ((ch == '*') && (next_ch == ')')) {
+          level--;
+          pos = pos + 2;
+          if (level == 0) {
+            kind = LINE_STATE_CODE;
+          } /* end if */
+        }
+        else /* comment text */ {
+          pos++;
+        } /* end if */
+        break;
+  
+      case LINE_STATE_PRAGMA :
+        if ((ch == '*') && (next_ch == '>')) {
+          kind = LINE_STATE_CODE;
+          pos = pos + 2;
+        }
+        else /* pragma text */ {
+          pos++;
+        } /* end if */
+        break;
+  
+      case LINE_STATE_SINGLE_QUOTED :
+      case LINE_STATE_DOUBLE_QUOTED :
+        if ((ch == '\\') && (next_ch != ASCII_LF) && (next_ch != ASCII_CR)) {
+          /* escape sequence */
+          pos = pos + 2;
+        }
+        else if (((ch == '\'') && (kind == LINE_STATE_SINGLE_QUOTED)) ||
+                 ((ch == '\"') && (kind == LINE_STATE_DOUBLE_QUOTED))) {
+          kind = LINE_STATE_CODE;
+          pos++;
+        }
+        else /* string text */ {
+          pos++;
+        } /* end if */
+        break;
+  
+      default : /* disabled code */
+        pos++;
+        break;
+    } /* end switch */
+  } /* end while */
+  
+  if (pos > length) {
+    pos = length;
+  } /* end if */
+  
+  if (kind != LINE_STATE_COMMENT) {
+    level = 0;
+  } /* end if */
+  
+  *state = kind | (level << LINE_STATE_LEVEL_SHIFT);
+  
+  return pos;
+} /* end scan_line */
+
+
+/* --------------------------------------------------------------------------
+ * private function count_line_breaks(text, length)
+ * --------------------------------------------------------------------------
+ * Returns the number of line terminators in the length characters at text.
+ * ----------------------------------------------------------------------- */
+
+static uint_t count_line_breaks (const char *text, size_t length) {
+  
+  size_t index;
+  uint_t count;
+  
+  count = 0;
+  for (index = 0; index < length; index++) {
+    if ((text[index] == ASCII_LF) ||
+        ((text[index] == ASCII_CR) &&
+         ((index + 1 == length) || (text[index + 1] != ASCII_LF)))) {
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  return count;
+} /* end count_line_breaks */
+
+
+/* --------------------------------------------------------------------------
+ * private function scan_lines(doc)
+ * --------------------------------------------------------------------------
+ * Builds the line table of doc from its text.  Returns false if allocation
+ * failed,  in which case the line table of doc is unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool scan_lines (m2c_document_t doc) {
+  
+  bool terminated;
+  uint_t count, state;
+  line_t *new_line;
+  size_t pos;
+  
+  new_line =
+    malloc((count_line_breaks(doc->text, doc->length) + 1) * sizeof(line_t));
+  
+  if (new_line == NULL) {
+    return false;
+  } /* end if */
+  
+  count = 0;
+  pos = 0;
+  state = LINE_STATE_CODE;
+  terminated = true;
+  
+  while (terminated) {
+    new_line[count].offset = pos;
+    new_line[count].state = state;
+    count++;
+  
+    pos = scan_line(doc->text, doc->length, pos, &state, &terminated);
+  } /* end while */
+  
+  free(doc->line);
+  doc->line = new_line;
+  doc->line_count = count;
+  
+  return true;
+} /* end scan_lines */
+
+
+/* --------------------------------------------------------------------------
+ * private function splice_text(doc, start, end, text, length, ...)
+ * --------------------------------------------------------------------------
+ * Replaces the characters of doc from position start up to but excluding
+ * position end by the length characters at text  and updates the line table.
+ * The line states are rescanned from the line before first edited line on
+ * until a line is reached past the inserted text whose start and state are
+ * those of a line following last_line before the edit,  the lines from
+ * there on are taken over with their offsets moved.  Passes the number of
+ * that line before the edit in converged,  or the line count before the
+ * edit plus one if the end of text was reached.  Returns false if
+ * allocation failed,  in which case doc is unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool splice_text
+  (m2c_document_t doc, size_t start, size_t end,
+   const char *text, size_t length, uint_t last_line, uint_t *converged) {
+  
+  bool terminated;
+  char *new_text;
+  line_t *new_line;
+  size_t new_length, pos, removed, inserted_end;
+  uint_t from, count, old_line, state;
+  
+  removed = end - start;
+  new_length = doc->length - removed + length;
+  
+  /* the edit cannot add more lines than line breaks are inserted */
+  new_text = malloc(new_length + 1);
+  new_line = malloc((doc->line_count + count_line_breaks(text, length) + 1) *
+    sizeof(line_t));
+  
+  if ((new_text == NULL) || (new_line == NULL)) {
+    free(new_text);
+    free(new_line);
+    return false;
+  } /* end if */
+  
+  memcpy(new_text, doc->text, start);
+  
+  if (length > 0) {
+    memcpy(&new_text[start], text, length);
+  } /* end if */
+  
+  memcpy(&new_text[start + length], &doc->text[end], doc->length - end);
+  new_text[new_length] = ASCII_NUL;
+  inserted_end = start + length;
+  
+  /* a line break inserted at the start may join the previous line break */
+  from = doc->line_count;
+  while ((from > 1) && (doc->line[from - 1].offset > start)) {
+    from--;
+  } /* end while */
+  
+  if (from > 1) {
+    from--;
+  } /* end if */
+  
+  /* lines before from are unchanged */
+  memcpy(new_line, doc->line, (from - 1) * sizeof(line_t));
+  count = from - 1;
+  pos = doc->line[from - 1].offset;
+  state = doc->line[from - 1].state;
+  old_line = last_line + 1;
+  terminated = true;
+  
+  while (terminated) {
+    new_line[count].offset = pos;
+    new_line[count].state = state;
+    count++;
+  
+    pos = scan_line(new_text, new_length, pos, &state, &terminated);
+  
+    if ((terminated) && (pos >= inserted_end)) {
+  
+      /* skip old lines starting before pos */
+      while ((old_line <= doc->line_count) &&
+             (doc->line[old_line - 1].offset + length < pos + removed)) {
+        old_line++;
+      } /* end while */
+  
+      /* converged if an old line starts at pos in the same state */
+      if ((old_line <= doc->line_count) &&
+          (doc->line[old_line - 1].offset + length == pos + removed) &&
+          (doc->line[old_line - 1].state == state)) {
+        break;
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  if (terminated == false) {
+    old_line = doc->line_count + 1;
+  } /* end if */
+  
+  /* take over the remaining lines with moved offsets */
+  *converged = old_line;
+  
+  while (old_line <= doc->line_count) {
+    new_line[count].offset = doc->line[old_line - 1].offset + length - removed;
+    new_line[count].state = doc->line[old_line - 1].state;
+    count++;
+    old_line++;
+  } /* end while */
+  
+  free(doc->text);
+  free(doc->line);
+  doc->text = new_text;
+  doc->length = new_length;
+  doc->line = new_line;
+  doc->line_count = count;
+  
+  return true;
+} /* end splice_text */
+
+
+/* --------------------------------------------------------------------------
+ * private function position(doc, line, col)
+ * --------------------------------------------------------------------------
+ * Returns the offset in the text of doc of column col of line line,  or of
+ * the end of the line if col lies past its end.
+ * ----------------------------------------------------------------------- */
+
+static size_t position (m2c_document_t doc, uint_t line, uint_t col) {
+  
+  size_t start, end;
+  
+  start = doc->line[line - 1].offset;
+  end = line_end(doc, line);
+  
+  if (start + (col - 1) > end) {
+    return end;
+  } /* end if */
+  
+  return start + (col - 1);
+} /* end position */
+
+
+/* --------------------------------------------------------------------------
+ * private function line_end(doc, line)
+ * --------------------------------------------------------------------------
+ * Returns the offset in the text of doc of the terminator of line line,  or
+ * the length of the text if line is the last line.
+ * ----------------------------------------------------------------------- */
+
+static size_t line_end (m2c_document_t doc, uint_t line) {
+  
+  size_t start, end;
+  
+  if (line >= doc->line_count) {
+    return doc->length;
+  } /* end if */
+  
+  start = doc->line[line - 1].offset;
+  end = doc->line[line].offset;
+  
+  if ((end > start) && (doc->text[end - 1] == ASCII_LF)) {
+    end--;
+  } /* end if */
+  
+  if ((end > start) && (doc->text[end - 1] == ASCII_CR)) {
+    end--;
+  } /* end if */
+  
+  return end;
+} /* end line_end */
+
+
+/* --------------------------------------------------------------------------
+ * private function span_end_line(state, index)
+ * --------------------------------------------------------------------------
+ * Returns the last line reparsed with the definition at index,  that is the
+ * line before the next definition,  or the line of the last symbol of the
+ * last definition.
+ * ----------------------------------------------------------------------- */
+
+static uint_t span_end_line (parse_state_t *state, uint_t index) {
+  
+  if (index + 1 < state->span_count) {
+    return state->span[index + 1].first_line - 1;
+  } /* end if */
+  
+  return state->span[index].last_line;
+} /* end span_end_line */
+
+
+/* --------------------------------------------------------------------------
+ * private function enclosing_span(doc, first_line, last_line, end_line)
+ * --------------------------------------------------------------------------
+ * Returns the index of the definition of doc that can be reparsed on its
+ * own and whose lines enclose lines first_line to last_line  and passes its
+ * last line in end_line.  Returns -1 if there is no such definition.
+ * ----------------------------------------------------------------------- */
+
+static int enclosing_span
+  (m2c_document_t doc, uint_t first_line, uint_t last_line, uint_t *end_line) {
+  
+  parse_state_t *state;
+  uint_t lower, upper, middle;
+  
+  state = &doc->state;
+  
+  if ((doc->stale) ||
+      (state->defn_list == NULL) || (state->span_count == 0) ||
+      (first_line < state->span[0].first_line)) {
+    return -1;
+  } /* end if */
+  
+  /* find the last definition starting at or before first_line */
+  lower = 0;
+  upper = state->span_count - 1;
+  
+  while (lower < upper) {
+    middle = (lower + upper + 1) / 2;
+  
+    if (state->span[middle].first_line <= first_line) {
+      lower = middle;
+    }
+    else {
+      upper = middle - 1;
+    } /* end if */
+  } /* end while */
+  
+  *end_line = span_end_line(state, lower);
+  
+  /* definitions sharing a line with the next cannot be reparsed alone */
+  if ((last_line > *end_line) ||
+      (state->span[lower].last_line > *end_line)) {
+    return -1;
+  } /* end if */
+  
+  return (int) lower;
+} /* end enclosing_span */
+
+
+/* --------------------------------------------------------------------------
+ * private function diag_list_add(list, severity, line, column, text)
+ * --------------------------------------------------------------------------
+ * Appends a copy of a diagnostic to list.  Returns false if allocation
+ * failed.
+ * ----------------------------------------------------------------------- */
+
+static bool diag_list_add
+  (diag_list_t *list, m2c_diag_severity_t severity,
+   uint_t line, uint_t column, const char *text) {
+  
+  diag_t *new_entry;
+  uint_t new_capacity;
+  
+  if (list->count == list->capacity) {
+    new_capacity = (list->capacity == 0) ? 4 : 2 * list->capacity;
+    new_entry = realloc(list->entry, new_capacity * sizeof(diag_t));
+  
+    if (new_entry == NULL) {
+      return false;
+    } /* end if */
+  
+    list->entry = new_entry;
+    list->capacity = new_capacity;
+  } /* end if */
+  
+  new_entry = &list->entry[list->count];
+  new_entry->text = malloc(strlen(text) + 1);
+  
+  if (new_entry->text == NULL) {
+    return false;
+  } /* end if */
+  
+  strcpy(new_entry->text, text);
+  new_entry->line = line;
+  new_entry->column = column;
+  new_entry->severity = severity;
+  list->count++;
+  
+  return true;
+} /* end diag_list_add */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure diag_list_release(list)
+ * --------------------------------------------------------------------------
+ * Deallocates the diagnostics of list and leaves it empty.
+ * ----------------------------------------------------------------------- */
+
+static void diag_list_release (diag_list_t *list) {
+  
+  uint_t index;
+  
+  for (index = 0; index < list->count; index++) {
+    free(list->entry[index].text);
+  } /* end for */
+  
+  free(list->entry);
+  list->entry = NULL;
+  list->count = 0;
+  list->capacity = 0;
+  
+  return;
+} /* end diag_list_release */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure diag_list_move(list, after_line, delta)
+ * --------------------------------------------------------------------------
+ * Moves the diagnostics of list past line after_line by delta lines.
+ * ----------------------------------------------------------------------- */
+
+static void diag_list_move (diag_list_t *list, uint_t after_line, long delta) {
+  
+  uint_t index;
+  
+  for (index = 0; index < list->count; index++) {
+    if (list->entry[index].line > after_line) {
+      list->entry[index].line =
+        (uint_t) ((long) list->entry[index].line + delta);
+    } /* end if */
+  } /* end for */
+  
+  return;
+} /* end diag_list_move */
+
+
+/* --------------------------------------------------------------------------
+ * private function precedes(diag1, diag2)
+ * --------------------------------------------------------------------------
+ * Returns true if diag1 precedes diag2 in order of source position.
+ * ----------------------------------------------------------------------- */
+
+static bool precedes (const diag_t *diag1, const diag_t *diag2) {
+  
+  return (diag1->line < diag2->line) ||
+    ((diag1->line == diag2->line) && (diag1->column <= diag2->column));
+} /* end precedes */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_span(defn, first_line, last_line, context)
+ * --------------------------------------------------------------------------
+ * Span handler that appends a top-level definition to the parse state
+ * passed in context.
+ * ----------------------------------------------------------------------- */
+
+static void collect_span
+  (m2c_astnode_t defn, uint_t first_line, uint_t last_line, void *context) {
+  
+  parse_state_t *state = (parse_state_t *) context;
+  span_t *new_span;
+  uint_t new_capacity;
+  
+  if (state->span_count == state->span_capacity) {
+    new_capacity =
+      (state->span_capacity == 0) ? 64 : 2 * state->span_capacity;
+    new_span = realloc(state->span, new_capacity * sizeof(span_t));
+  
+    if (new_span == NULL) {
+      state->failed = true;
+      return;
+    } /* end if */
+  
+    state->span = new_span;
+    state->span_capacity = new_capacity;
+  } /* end if */
+  
+  new_span = &state->span[state->span_count];
+  memset(new_span, 0, sizeof(span_t));
+  new_span->first_line = first_line;
+  new_span->last_line = last_line;
+  new_span->defn = defn;
+  state->span_count++;
+  
+  return;
+} /* end collect_span */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure distribute_diag(severity, line, column, text, context)
+ * --------------------------------------------------------------------------
+ * Diagnostic visitor that adds a diagnostic to the definition of the parse
+ * state passed in context whose lines enclose it,  or to those outside of
+ * definitions.
+ * ----------------------------------------------------------------------- */
+
+static void distribute_diag
+  (m2c_diag_severity_t severity, uint_t line, uint_t column,
+   const char *text, void *context) {
+  
+  parse_state_t *state = (parse_state_t *) context;
+  diag_list_t *list;
+  uint_t lower, upper, middle;
+  
+  list = &state->outer;
+  
+  if ((state->span_count > 0) && (line >= state->span[0].first_line)) {
+    lower = 0;
+    upper = state->span_count - 1;
+  
+    while (lower < upper) {
+      middle = (lower + upper + 1) / 2;
+  
+      if (state->span[middle].first_line <= line) {
+        lower = middle;
+      }
+      else {
+        upper = middle - 1;
+      } /* end if */
+    } /* end while */
+  
+    if (line <= span_end_line(state, lower)) {
+      list = &state->span[lower].diags;
+    } /* end if */
+  } /* end if */
+  
+  if (diag_list_add(list, severity, line, column, text) == false) {
+    state->failed = true;
+  } /* end if */
+  
+  return;
+} /* end distribute_diag */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_defn_list(state)
+ * --------------------------------------------------------------------------
+ * Returns the definition list of the module AST of state  if it holds the
+ * definitions of state in order,  otherwise NULL.
+ *
+ * astnode: (FILE filenameNode keyNode (moduleNode ... (BLOCK defnList ...)))
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t find_defn_list (parse_state_t *state) {
+  
+  m2c_astnode_t module, block, list;
+  uint_t index, count;
+  
+  if ((state->span_count == 0) ||
+      (m2c_ast_nodetype(state->ast) != AST_FILE)) {
+    return NULL;
+  } /* end if */
+  
+  module = m2c_ast_subnode_at_index(state->ast, 2);
+  count = m2c_ast_subnode_count(module);
+  
+  if (count == 0) {
+    return NULL;
+  } /* end if */
+  
+  block = m2c_ast_subnode_at_index(module, (unsigned short) (count - 1));
+  
+  if (m2c_ast_nodetype(block) != AST_BLOCK) {
+    return NULL;
+  } /* end if */
+  
+  list = m2c_ast_subnode_at_index(block, 0);
+  
+  if ((m2c_ast_nodetype(list) != AST_DEFNLIST) ||
+      (m2c_ast_subnode_count(list) != state->span_count)) {
+    return NULL;
+  } /* end if */
+  
+  for (index = 0; index < state->span_count; index++) {
+    if (m2c_ast_subnode_at_index(list, (unsigned short) index) !=
+        state->span[index].defn) {
+      return NULL;
+    } /* end if */
+  } /* end for */
+  
+  return list;
+} /* end find_defn_list */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_document(doc)
+ * --------------------------------------------------------------------------
+ * Parses the text of doc in whole into a new region  and replaces the AST,
+ * definitions and diagnostics of doc by the result.  Returns false if
+ * allocation failed,  in which case doc keeps its previous state.
+ * ----------------------------------------------------------------------- */
+
+static bool parse_document (m2c_document_t doc) {
+  
+  parse_state_t new_state;
+  m2c_ast_region_t prev_region;
+  m2c_diag_buffer_t buffer;
+  uint_t index;
+  
+  memset(&new_state, 0, sizeof(parse_state_t));
+  new_state.region = m2c_ast_new_region(0);
+  buffer = m2c_diag_new_buffer(doc->name);
+  
+  if ((new_state.region == NULL) || (buffer == NULL)) {
+    m2c_ast_release_region(new_state.region);
+    m2c_diag_release(buffer);
+    return false;
+  } /* end if */
+  
+  /* parse into the new region */
+  prev_region = m2c_ast_current_region();
+  m2c_ast_set_region(new_state.region);
+  
+  new_state.ast = m2c_parse_text(doc->name, doc->text, doc->length,
+    doc->options, collect_span, &new_state, buffer, NULL);
+  
+  m2c_ast_set_region(prev_region);
+  
+  if ((new_state.ast == NULL) || (new_state.failed)) {
+    m2c_diag_release(buffer);
+    release_state(&new_state);
+    return false;
+  } /* end if */
+  
+  /* definitions are only tracked if they can be replaced in the AST */
+  new_state.defn_list = find_defn_list(&new_state);
+  
+  if (new_state.defn_list == NULL) {
+    new_state.span_count = 0;
+  } /* end if */
+  
+  m2c_diag_visit(buffer, distribute_diag, &new_state);
+  m2c_diag_release(buffer);
+  
+  if (new_state.failed) {
+    release_state(&new_state);
+    return false;
+  } /* end if */
+  
+  doc->revision++;
+  
+  for (index = 0; index < new_state.span_count; index++) {
+    new_state.span[index].revision = doc->revision;
+  } /* end for */
+  
+  release_state(&doc->state);
+  doc->state = new_state;
+  doc->stale = false;
+  
+  return true;
+} /* end parse_document */
+
+
+/* --------------------------------------------------------------------------
+ * private function same_keys(defn1, defn2)
+ * --------------------------------------------------------------------------
+ * Returns true if definitions defn1 and defn2 are keyed declarations,  or
+ * lists of keyed declarations,  with the same declaration keys.
+ *
+ * astnode: (DECL (DECLKEY "0x...") defnNode) | (xxxDEFLIST declNode+)
+ * ----------------------------------------------------------------------- */
+
+static bool same_keys (m2c_astnode_t defn1, m2c_astnode_t defn2) {
+  
+  m2c_ast_nodetype_t nodetype;
+  uint_t index, count;
+  intstr_t key;
+  
+  nodetype = m2c_ast_nodetype(defn1);
+  
+  if (nodetype != m2c_ast_nodetype(defn2)) {
+    return false;
+  } /* end if */
+  
+  if (nodetype == AST_DECL) {
+    key = m2c_ast_value(m2c_ast_subnode_at_index(defn1, 0));
+    return (key != NULL) &&
+      (key == m2c_ast_value(m2c_ast_subnode_at_index(defn2, 0)));
+  } /* end if */
+  
+  if ((nodetype != AST_CONSTDEFLIST) &&
+      (nodetype != AST_TYPEDEFLIST) && (nodetype != AST_VARDEFLIST)) {
+    return false;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(defn1);
+  
+  if (count != m2c_ast_subnode_count(defn2)) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    if (same_keys(m2c_ast_subnode_at_index(defn1, (unsigned short) index),
+        m2c_ast_subnode_at_index(defn2, (unsigned short) index)) == false) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end same_keys */
+
+
+/* --------------------------------------------------------------------------
+ * private function reparse_span(doc, index, end_line, delta)
+ * --------------------------------------------------------------------------
+ * Reparses the definition of doc at index,  whose lines ended at end_line
+ * before an edit that moved the lines following it by delta lines.  The
+ * result replaces the definition if it is a single definition that extends
+ * to the end of the lines reparsed,  otherwise doc is left unchanged and
+ * false is returned.  The AST of the definition is kept if its declaration
+ * keys are unchanged.  Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool reparse_span
+  (m2c_document_t doc, uint_t index, uint_t end_line, long delta) {
+  
+  bool complete;
+  span_t *span;
+  uint_t new_end, other;
+  size_t start, end;
+  parse_state_t result;
+  m2c_ast_region_t prev_region;
+  m2c_diag_buffer_t buffer;
+  m2c_astnode_t list, defn;
+  
+  span = &doc->state.span[index];
+  new_end = (uint_t) ((long) end_line + delta);
+  
+  start = doc->line[span->first_line - 1].offset;
+  end = (new_end < doc->line_count) ? doc->line[new_end].offset : doc->length;
+  
+  memset(&result, 0, sizeof(parse_state_t));
+  result.region = m2c_ast_new_region(0);
+  buffer = m2c_diag_new_buffer(doc->name);
+  
+  if ((result.region == NULL) || (buffer == NULL)) {
+    m2c_ast_release_region(result.region);
+    m2c_diag_release(buffer);
+    return false;
+  } /* end if */
+  
+  /* parse the lines of the definition into a region of its own */
+  prev_region = m2c_ast_current_region();
+  m2c_ast_set_region(result.region);
+  
+  list = m2c_parse_definitions_text(doc->name, &doc->text[start],
+    end - start, span->first_line, doc->options, collect_span, &result,
+    buffer, &complete, NULL);
+  
+  m2c_ast_set_region(prev_region);
+  
+  /* collect diagnostics as if outside of definitions */
+  result.span_count = (result.failed) ? 0 : result.span_count;
+  defn = (result.span_count == 1) ? result.span[0].defn : NULL;
+  other = result.span_count;
+  result.span_count = 0;
+  
+  m2c_diag_visit(buffer, distribute_diag, &result);
+  m2c_diag_release(buffer);
+  
+  if ((list == NULL) || (result.failed) || (complete == false) ||
+      (other != 1) || (m2c_ast_subnode_count(list) != 1) ||
+      (m2c_ast_subnode_at_index(list, 0) != defn)) {
+    result.span_count = other;
+    release_state(&result);
+    return false;
+  } /* end if */
+  
+  /* keep the AST if the symbols of the definition are unchanged */
+  if (same_keys(span->defn, defn)) {
+    m2c_ast_release_region(result.region);
+  }
+  else if (m2c_ast_replace_subnode(doc->state.defn_list,
+           (unsigned short) index, defn) != NULL) {
+    m2c_ast_release_region(span->region);
+    span->region = result.region;
+    span->defn = defn;
+    doc->revision++;
+    span->revision = doc->revision;
+  }
+  else /* definition list cannot be modified */ {
+    result.span_count = other;
+    release_state(&result);
+    return false;
+  } /* end if */
+  
+  result.region = NULL;
+  span->last_line = result.span[0].last_line;
+  
+  /* replace the diagnostics of the definition */
+  diag_list_release(&span->diags);
+  span->diags = result.outer;
+  result.outer.entry = NULL;
+  result.outer.count = 0;
+  
+  /* move the lines of the definitions and diagnostics that follow */
+  if (delta != 0) {
+    for (other = index + 1; other < doc->state.span_count; other++) {
+      doc->state.span[other].first_line =
+        (uint_t) ((long) doc->state.span[other].first_line + delta);
+      doc->state.span[other].last_line =
+        (uint_t) ((long) doc->state.span[other].last_line + delta);
+      diag_list_move(&doc->state.span[other].diags, 0, delta);
+    } /* end for */
+  
+    diag_list_move(&doc->state.outer, end_line, delta);
+  } /* end if */
+  
+  free(result.span);
+  
+  return true;
+} /* end reparse_span */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_state(state)
+ * --------------------------------------------------------------------------
+ * Deallocates the regions,  definitions and diagnostics of state.
+ * ----------------------------------------------------------------------- */
+
+static void release_state (parse_state_t *state) {
+  
+  uint_t index;
+  
+  for (index = 0; index < state->span_count; index++) {
+    m2c_ast_release_region(state->span[index].region);
+    diag_list_release(&state->span[index].diags);
+  } /* end for */
+  
+  free(state->span);
+  diag_list_release(&state->outer);
+  m2c_ast_release_region(state->region);
+  
+  memset(state, 0, sizeof(parse_state_t));
+  
+  return;
+} /* end release_state */
+
+
+/* END OF FILE */
@@ -0,0 +1,209 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-error-reporter.c                                                      *
+ *                                                                           *
+ * Implementation of error reporter.                                         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-error-reporter.h"
+
+#include <stdio.h>
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a lexical error message
+ * ----------------------------------------------------------------------- */
+
+#define MAX_MESSAGE_LENGTH 127
+
+
+/* --------------------------------------------------------------------------
+ * private array error_text
+ * --------------------------------------------------------------------------
+ * Human readable text for error codes.
+ * ----------------------------------------------------------------------- */
+
+static const char *error_text[] = {
+  "illegal character",
+  "illegal character in",
+  "illegal escape sequence in",
+  "missing digit after decimal point in",
+  "missing digit after digit separator in",
+  "missing exponent after E in",
+  "premature end of file in",
+  "input buffer exceeded by"
+}; /* end error_text */
+
+#define ERROR_CODE_COUNT (M2C_ERROR_LEXEME_TOO_LONG + 1)
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void format_char (char *str, size_t size, char ch);
+
+static const char *token_kind (m2c_token_t token);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_emit_lex_error(code, ch, line, col)
+ * --------------------------------------------------------------------------
+ * Reports a lexical error of type code, without token context,  for the
+ * given offending character at the given line and column.
+ * ----------------------------------------------------------------------- */
+
+void m2c_emit_lex_error
+  (m2c_error_t code, char ch, uint_t line, uint_t col) {
+  
+  char message[MAX_MESSAGE_LENGTH + 1];
+  char offending[16];
+  
+  if ((code >= ERROR_CODE_COUNT) ||
+      (NOT(m2c_diag_accepts(M2C_DIAG_ERROR)))) {
+    return;
+  } /* end if */
+  
+  format_char(offending, sizeof(offending), ch);
+  snprintf(message, sizeof(message),
+    "%s, offending character: %s", error_text[code], offending);
+  
+  m2c_diag_emit(M2C_DIAG_ERROR, line, col, message);
+  
+  return;
+} /* end m2c_emit_lex_error */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_emit_lex_error_in_token(code, token, ch, line, col)
+ * --------------------------------------------------------------------------
+ * Reports a lexical error  of type code  with given token context  for the
+ * given offending character at the given line and column.
+ * ----------------------------------------------------------------------- */
+
+void m2c_emit_lex_error_in_token
+  (m2c_error_t code, m2c_token_t token, char ch, uint_t line, uint_t col) {
+  
+  char message[MAX_MESSAGE_LENGTH + 1];
+  char offending[16];
+  
+  if ((code >= ERROR_CODE_COUNT) ||
+      (NOT(m2c_diag_accepts(M2C_DIAG_ERROR)))) {
+    return;
+  } /* end if */
+  
+  format_char(offending, sizeof(offending), ch);
+  
+  if (code == M2C_ERROR_ILLEGAL_CHAR) {
+    snprintf(message, sizeof(message),
+      "%s, offending character: %s", error_text[code], offending);
+  }
+  else if (code == M2C_ERROR_LEXEME_TOO_LONG) {
+    snprintf(message, sizeof(message),
+      "%s %s", error_text[code], token_kind(token));
+  }
+  else {
+    snprintf(message, sizeof(message), "%s %s, offending character: %s",
+      error_text[code], token_kind(token), offending);
+  } /* end if */
+  
+  m2c_diag_emit(M2C_DIAG_ERROR, line, col, message);
+  
+  return;
+} /* end m2c_emit_lex_error_in_token */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private procedure format_char(str, size, ch)
+ * --------------------------------------------------------------------------
+ * Writes ch quoted to str if it is printable,  otherwise its character code.
+ * ----------------------------------------------------------------------- */
+
+#define IS_PRINTABLE(_ch) \
+  ((_ch >= 32) && (_ch <= 126))
+
+static void format_char (char *str, size_t size, char ch) {
+  
+  if (IS_PRINTABLE(ch)) {
+    snprintf(str, size, "'%c'", ch);
+  }
+  else /* non-printable */ {
+    snprintf(str, size, "0u%X", (unsigned int) (unsigned char) ch);
+  } /* end if */
+  
+  return;
+} /* end format_char */
+
+
+/* --------------------------------------------------------------------------
+ * private function token_kind(token)
+ * --------------------------------------------------------------------------
+ * Returns a human readable description of the kind of lexeme of token.
+ * ----------------------------------------------------------------------- */
+
+static const char *token_kind (m2c_token_t token) {
+  
+  switch (token) {
+    case TOKEN_IDENT :
+      return "identifier";
+    
+    case TOKEN_WHOLE_NUMBER :
+    case TOKEN_REAL_NUMBER :
+      return "number literal";
+    
+    case TOKEN_CHAR_CODE :
+      return "character code literal";
+    
+    case TOKEN_QUOTED_STRING :
+      return "string literal";
+    
+    case TOKEN_PRAGMA :
+      return "pragma";
+    
+    default :
+      return "lexeme";
+  } /* end switch */
+} /* end token_kind */
+
+
+/* END OF FILE */
@@ -0,0 +1,668 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-exl-lexer.c                                                           *
+ *                                                                           *
+ * Implementation of export list lexer module.                               *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-exl-lexer.h"
+#include "hash.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped export list files for POSIX and Unix-like hosts
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  export list files are mapped read-only into
+ * the address space and lexed in place.  On all other hosts  (AmigaOS,
+ * OpenVMS, Windows) the file is read into a buffer.  Define M2C_EXL_LEXER_
+ * USE_MMAP as 0 to force the buffered implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_EXL_LEXER_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_EXL_LEXER_USE_MMAP 1
+#else
+#define M2C_EXL_LEXER_USE_MMAP 0
+#endif
+#endif
+
+#if (M2C_EXL_LEXER_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private table section_prefix
+ * --------------------------------------------------------------------------
+ * Section prefix tokens indexed by the character that precedes the colon of
+ * a section prefix.  All other characters map to EXL_TOKEN_INVALID.
+ * ----------------------------------------------------------------------- */
+
+static const m2c_exl_token_t section_prefix[128] = {
+  ['C'] = EXL_TOKEN_CONSTANTS,
+  ['F'] = EXL_TOKEN_FUNCTIONS,
+  ['I'] = EXL_TOKEN_IMPORTERS,
+  ['K'] = EXL_TOKEN_FINGERPRINT,
+  ['P'] = EXL_TOKEN_PROCEDURES,
+  ['T'] = EXL_TOKEN_TYPES,
+  ['V'] = EXL_TOKEN_VARIABLES,
+  ['X'] = EXL_TOKEN_EXPORTER
+}; /* end section_prefix */
+
+
+/* --------------------------------------------------------------------------
+ * private type exl_symbol_t
+ * --------------------------------------------------------------------------
+ * Record type for a symbol,  its token and its lexeme.  The lexeme is NULL
+ * for symbols other than identifiers and fingerprint values.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* token */   m2c_exl_token_t token;
+  /* lexeme */  intstr_t lexeme;
+} exl_symbol_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_exl_lexer_struct_t
+ * --------------------------------------------------------------------------
+ * Record type to implement the export list lexer.  Field data holds the
+ * mapped or buffered contents of the file,  field index the position of
+ * the next character to be scanned.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_exl_lexer_struct_t {
+  /* data */       const char *data;
+  /* size */       size_t size;
+  /* index */      size_t index;
+  /* is_mapped */  bool is_mapped;
+  /* filename */   intstr_t filename;
+  /* current */    exl_symbol_t current;
+  /* lookahead */  exl_symbol_t lookahead;
+  /* status */     m2c_exl_lexer_status_t status;
+}; /* m2c_exl_lexer_struct_t */
+
+typedef struct m2c_exl_lexer_struct_t m2c_exl_lexer_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_exl_lexer_status_t read_file_data
+  (m2c_exl_lexer_t lexer, const char *path);
+
+static void release_file_data (m2c_exl_lexer_t lexer);
+
+static void get_new_lookahead_sym (m2c_exl_lexer_t lexer);
+
+static void scan_ident (m2c_exl_lexer_t lexer);
+
+static void scan_key (m2c_exl_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_new_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new export list lexer,  maps or reads the file at filename
+ * and reads the first symbol.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_new_lexer
+  (m2c_exl_lexer_t *lexer,
+   intstr_t filename,
+   m2c_exl_lexer_status_t *status) {
+  
+  m2c_exl_lexer_status_t read_status;
+  m2c_exl_lexer_t new_lexer;
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (*lexer != NULL) || (filename == NULL)) {
+    SET_STATUS(status, M2C_EXL_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  new_lexer = malloc(sizeof(m2c_exl_lexer_struct_t));
+  
+  if (new_lexer == NULL) {
+    SET_STATUS(status, M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  read_status = read_file_data(new_lexer, intstr_char_ptr(filename));
+  
+  if (read_status != M2C_EXL_LEXER_STATUS_SUCCESS) {
+    free(new_lexer);
+    SET_STATUS(status, read_status);
+    return;
+  } /* end if */
+  
+  new_lexer->index = 0;
+  new_lexer->filename = filename;
+  new_lexer->current.token = EXL_TOKEN_INVALID;
+  new_lexer->current.lexeme = NULL;
+  new_lexer->status = M2C_EXL_LEXER_STATUS_SUCCESS;
+  
+  /* read first symbol */
+  get_new_lookahead_sym(new_lexer);
+  
+  *lexer = new_lexer;
+  SET_STATUS(status, new_lexer->status);
+} /* end m2c_exl_new_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_read_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Consumes the lookahead symbol and returns its token.
+ * ----------------------------------------------------------------------- */
+
+m2c_exl_token_t m2c_exl_read_sym (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return EXL_TOKEN_INVALID;
+  } /* end if */
+  
+  m2c_exl_consume_sym(lexer);
+  
+  return lexer->current.token;
+} /* end m2c_exl_read_sym */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_next_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the token of the lookahead symbol without consuming it.
+ * ----------------------------------------------------------------------- */
+
+m2c_exl_token_t m2c_exl_next_sym (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return EXL_TOKEN_INVALID;
+  } /* end if */
+  
+  return lexer->lookahead.token;
+} /* end m2c_exl_next_sym */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_consume_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Consumes the lookahead symbol and returns the new lookahead symbol.
+ * ----------------------------------------------------------------------- */
+
+m2c_exl_token_t m2c_exl_consume_sym (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return EXL_TOKEN_INVALID;
+  } /* end if */
+  
+  lexer->current = lexer->lookahead;
+  
+  /* the end of file symbol is never consumed */
+  if (lexer->lookahead.token != EXL_TOKEN_EOF) {
+    get_new_lookahead_sym(lexer);
+  } /* end if */
+  
+  return lexer->lookahead.token;
+} /* end m2c_exl_consume_sym */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_lexer_filename(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the filename associated with lexer.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_lexer_filename (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return lexer->filename;
+} /* end m2c_exl_lexer_filename */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_lexer_status(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the status of the last operation on lexer.
+ * ----------------------------------------------------------------------- */
+
+m2c_exl_lexer_status_t m2c_exl_lexer_status (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return M2C_EXL_LEXER_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  return lexer->status;
+} /* end m2c_exl_lexer_status */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_lexer_lookahead_lexeme(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the lexeme of the lookahead symbol.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_lexer_lookahead_lexeme (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return lexer->lookahead.lexeme;
+} /* end m2c_exl_lexer_lookahead_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_lexer_current_lexeme(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the lexeme of the most recently consumed symbol.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_lexer_current_lexeme (m2c_exl_lexer_t lexer) {
+  
+  if (lexer == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return lexer->current.lexeme;
+} /* end m2c_exl_lexer_current_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_release_lexer(lexer, status)
+ * --------------------------------------------------------------------------
+ * Releases the file contents of lexer,  deallocates it and passes NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_release_lexer
+  (m2c_exl_lexer_t *lexer, m2c_exl_lexer_status_t *status) {
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (*lexer == NULL)) {
+    SET_STATUS(status, M2C_EXL_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  release_file_data(*lexer);
+  free(*lexer);
+  *lexer = NULL;
+  
+  SET_STATUS(status, M2C_EXL_LEXER_STATUS_SUCCESS);
+} /* end m2c_exl_release_lexer */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function read_file_data(lexer, path)
+ * --------------------------------------------------------------------------
+ * Maps or reads the contents of the file at path into memory and records
+ * them in fields data,  size and is_mapped of lexer.  An empty file has no
+ * contents and is neither mapped nor buffered.
+ * ----------------------------------------------------------------------- */
+
+static m2c_exl_lexer_status_t read_file_data
+  (m2c_exl_lexer_t lexer, const char *path) {
+  
+#if (M2C_EXL_LEXER_USE_MMAP)
+  struct stat info;
+  void *map;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return M2C_EXL_LEXER_STATUS_FILE_NOT_FOUND;
+    } /* end if */
+    return M2C_EXL_LEXER_STATUS_FILE_ACCESS_DENIED;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) || NOT(S_ISREG(info.st_mode))) {
+    close(fd);
+    return M2C_EXL_LEXER_STATUS_FILE_ACCESS_DENIED;
+  } /* end if */
+  
+  lexer->data = NULL;
+  lexer->size = 0;
+  lexer->is_mapped = false;
+  
+  if (info.st_size == 0) {
+    close(fd);
+    return M2C_EXL_LEXER_STATUS_SUCCESS;
+  } /* end if */
+  
+  map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    return M2C_EXL_LEXER_STATUS_FILE_ACCESS_DENIED;
+  } /* end if */
+  
+  lexer->data = map;
+  lexer->size = (size_t) info.st_size;
+  lexer->is_mapped = true;
+  
+  return M2C_EXL_LEXER_STATUS_SUCCESS;
+#else
+  FILE *file;
+  char *data;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return M2C_EXL_LEXER_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return M2C_EXL_LEXER_STATUS_FILE_ACCESS_DENIED;
+  } /* end if */
+  
+  lexer->data = NULL;
+  lexer->size = 0;
+  lexer->is_mapped = false;
+  
+  if (size == 0) {
+    fclose(file);
+    return M2C_EXL_LEXER_STATUS_SUCCESS;
+  } /* end if */
+  
+  data = malloc((size_t) size);
+  
+  if (data == NULL) {
+    fclose(file);
+    return M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) size, file) != (size_t) size) {
+    free(data);
+    fclose(file);
+    return M2C_EXL_LEXER_STATUS_FILE_ACCESS_DENIED;
+  } /* end if */
+  
+  fclose(file);
+  
+  lexer->data = data;
+  lexer->size = (size_t) size;
+  
+  return M2C_EXL_LEXER_STATUS_SUCCESS;
+#endif
+} /* end read_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_file_data(lexer)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates the file contents of lexer.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_exl_lexer_t lexer) {
+  
+  if (lexer->data == NULL) {
+    return;
+  } /* end if */
+  
+#if (M2C_EXL_LEXER_USE_MMAP)
+  if (lexer->is_mapped) {
+    munmap((void *) lexer->data, lexer->size);
+  }
+  else {
+    free((void *) lexer->data);
+  } /* end if */
+#else
+  free((void *) lexer->data);
+#endif
+  
+  lexer->data = NULL;
+  lexer->size = 0;
+} /* end release_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure get_new_lookahead_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Scans the next symbol of the file contents of lexer into its lookahead.
+ *
+ * Section prefixes are matched by a table lookup of the character before
+ * the colon,  punctuation by the character itself,  identifiers and keys
+ * by the scanners below.  Any other character yields EXL_TOKEN_INVALID.
+ * ----------------------------------------------------------------------- */
+
+static void get_new_lookahead_sym (m2c_exl_lexer_t lexer) {
+  
+  const char *data;
+  size_t index;
+  char ch;
+  
+  data = lexer->data;
+  index = lexer->index;
+  
+  /* skip white space */
+  while ((index < lexer->size) &&
+    ((data[index] == ASCII_SPACE) || (data[index] == ASCII_TAB) ||
+     (data[index] == ASCII_LF) || (data[index] == ASCII_CR))) {
+    index++;
+  } /* end while */
+  
+  lexer->index = index;
+  lexer->lookahead.lexeme = NULL;
+  
+  if (index >= lexer->size) {
+    lexer->lookahead.token = EXL_TOKEN_EOF;
+    return;
+  } /* end if */
+  
+  ch = data[index];
+  
+  /* section prefix or identifier */
+  if (IS_LETTER(ch)) {
+    if ((index + 1 < lexer->size) && (data[index + 1] == ':') &&
+      (section_prefix[(unsigned char) ch] != EXL_TOKEN_INVALID)) {
+      lexer->lookahead.token = section_prefix[(unsigned char) ch];
+      lexer->index = index + 2;
+    }
+    else /* identifier */ {
+      scan_ident(lexer);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  switch (ch) {
+    case '0' :
+      scan_key(lexer);
+      return;
+    
+    case ',' :
+      lexer->lookahead.token = EXL_TOKEN_COMMA;
+      break;
+    
+    case ';' :
+      lexer->lookahead.token = EXL_TOKEN_SEMICOLON;
+      break;
+    
+    case '*' :
+      lexer->lookahead.token = EXL_TOKEN_ASTERISK;
+      break;
+    
+    default :
+      lexer->lookahead.token = EXL_TOKEN_INVALID;
+  } /* end switch */
+  
+  lexer->index = index + 1;
+} /* end get_new_lookahead_sym */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure scan_ident(lexer)
+ * --------------------------------------------------------------------------
+ * Scans an identifier,  optionally qualified,  hashing it as it is scanned
+ * and interning it straight from the file contents.
+ *
+ * ident :
+ *   Letter ( Letter | Digit | '_' | '$' )* ( '.' ident )?
+ *   ;
+ * ----------------------------------------------------------------------- */
+
+static void scan_ident (m2c_exl_lexer_t lexer) {
+  
+  intstr_status_t intstr_status;
+  size_t start, index;
+  intstr_hash_t key;
+  bool lowline;
+  char ch;
+  
+  start = lexer->index;
+  index = start;
+  key = HASH_INITIAL;
+  lowline = false;
+  
+  while (index < lexer->size) {
+    ch = lexer->data[index];
+    
+    if (ch == '_') {
+      lowline = true;
+    }
+    else if ((ch == '.') && (index + 1 < lexer->size) &&
+      IS_LETTER(lexer->data[index + 1])) {
+      /* qualified identifier */
+    }
+    else if (NOT(IS_ALPHANUMERIC(ch)) && (ch != '$')) {
+      break;
+    } /* end if */
+    
+    key = HASH_NEXT_CHAR(key, ch);
+    index++;
+  } /* end while */
+  
+  lexer->index = index;
+  lexer->lookahead.lexeme = intstr_for_slice_with_hash(lexer->data,
+    start, index - start, HASH_FINAL(key), &intstr_status);
+  
+  if (lexer->lookahead.lexeme == NULL) {
+    lexer->lookahead.token = EXL_TOKEN_INVALID;
+    lexer->status = M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED;
+  }
+  else if (lowline) {
+    lexer->lookahead.token = EXL_TOKEN_LOWLINE_IDENT;
+  }
+  else /* plain identifier */ {
+    lexer->lookahead.token = EXL_TOKEN_IDENT;
+  } /* end if */
+} /* end scan_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure scan_key(lexer)
+ * --------------------------------------------------------------------------
+ * Scans a fingerprint value and interns it straight from the file contents.
+ *
+ * key :
+ *   '0x' HexDigit+
+ *   ;
+ * ----------------------------------------------------------------------- */
+
+static void scan_key (m2c_exl_lexer_t lexer) {
+  
+  intstr_status_t intstr_status;
+  size_t start, index;
+  intstr_hash_t key;
+  char ch;
+  
+  start = lexer->index;
+  
+  if ((start + 2 >= lexer->size) || (lexer->data[start + 1] != 'x')) {
+    lexer->lookahead.token = EXL_TOKEN_INVALID;
+    lexer->index = start + 1;
+    return;
+  } /* end if */
+  
+  key = HASH_NEXT_CHAR(HASH_NEXT_CHAR(HASH_INITIAL, '0'), 'x');
+  index = start + 2;
+  
+  while (index < lexer->size) {
+    ch = lexer->data[index];
+    
+    if (NOT(IS_DIGIT(ch)) && ((ch < 'A') || (ch > 'F'))) {
+      break;
+    } /* end if */
+    
+    key = HASH_NEXT_CHAR(key, ch);
+    index++;
+  } /* end while */
+  
+  lexer->index = index;
+  
+  if (index == start + 2) {
+    lexer->lookahead.token = EXL_TOKEN_INVALID;
+    return;
+  } /* end if */
+  
+  lexer->lookahead.lexeme = intstr_for_slice_with_hash(lexer->data,
+    start, index - start, HASH_FINAL(key), &intstr_status);
+  
+  if (lexer->lookahead.lexeme == NULL) {
+    lexer->lookahead.token = EXL_TOKEN_INVALID;
+    lexer->status = M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED;
+  }
+  else /* fingerprint value */ {
+    lexer->lookahead.token = EXL_TOKEN_KEY;
+  } /* end if */
+} /* end scan_key */
+
+
+/* END OF FILE */
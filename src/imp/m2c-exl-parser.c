@@ -0,0 +1,551 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-exl-parser.c                                                          *
+ *                                                                           *
+ * Implementation of export list file parser module.                         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-exl-parser.h"
+#include "m2c-exl-lexer.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the identifier array while parsing
+ * ----------------------------------------------------------------------- */
+
+#define EXL_INITIAL_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_exl_list_s
+ * --------------------------------------------------------------------------
+ * Record type to implement export lists.  The identifiers of all sections
+ * are stored in array entry in the order listed,  those of section kind
+ * start at index start[kind] and number count[kind].
+ * ----------------------------------------------------------------------- */
+
+struct m2c_exl_list_s {
+  /* exporter */     intstr_t exporter;
+  /* fingerprint */  intstr_t fingerprint;
+  /* start */        uint_t start[M2C_EXL_KIND_END_MARK];
+  /* count */        uint_t count[M2C_EXL_KIND_END_MARK];
+  /* entry_count */  uint_t entry_count;
+  /* entry */        intstr_t entry[];
+}; /* m2c_exl_list_s */
+
+
+/* --------------------------------------------------------------------------
+ * private type exl_parser_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a parse.  Field entry holds the identifiers
+ * collected so far in an array that grows by doubling.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lexer */        m2c_exl_lexer_t lexer;
+  /* exporter */     intstr_t exporter;
+  /* fingerprint */  intstr_t fingerprint;
+  /* start */        uint_t start[M2C_EXL_KIND_END_MARK];
+  /* count */        uint_t count[M2C_EXL_KIND_END_MARK];
+  /* entry */        intstr_t *entry;
+  /* entry_count */  uint_t entry_count;
+  /* capacity */     uint_t capacity;
+  /* status */       m2c_exl_parser_status_t status;
+} exl_parser_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool parse_header (exl_parser_t *p);
+
+static bool parse_section (exl_parser_t *p, m2c_exl_kind_t kind);
+
+static bool match_token (exl_parser_t *p, m2c_exl_token_t token);
+
+static bool append_ident (exl_parser_t *p, intstr_t ident);
+
+static m2c_exl_kind_t kind_for_token (m2c_exl_token_t token);
+
+static m2c_exl_list_t new_list_from_parser (exl_parser_t *p);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_parse_file(exlpath, list, status)
+ * --------------------------------------------------------------------------
+ * Parses the  export list file  referenced by exlpath,  constructs a list of
+ * exported identifiers  by kind  and  passes it back in  list,  or NULL upon
+ * failure.  The status of the operation is passed back in status.
+ *
+ * exlFile :
+ *   header section* EOF
+ *   ;
+ *
+ * Sections must follow in the order T, C, V, F, P  and may be omitted,
+ * thus the identifiers of each section are contiguous in the list.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_parse_file
+  (const char *exlpath,
+   m2c_exl_list_t *list,
+   m2c_exl_parser_status_t *status) {
+  
+  m2c_exl_lexer_status_t lexer_status;
+  m2c_exl_kind_t kind, next_kind;
+  m2c_exl_token_t token;
+  intstr_t filename;
+  exl_parser_t p;
+  
+  /* check pre-conditions */
+  if ((exlpath == NULL) || (list == NULL)) {
+    SET_STATUS(status, M2C_EXL_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  *list = NULL;
+  
+  filename = intstr_for_cstr(exlpath, NULL);
+  
+  if (filename == NULL) {
+    SET_STATUS(status, M2C_EXL_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  p.lexer = NULL;
+  m2c_exl_new_lexer(&p.lexer, filename, &lexer_status);
+  
+  if (p.lexer == NULL) {
+    if (lexer_status == M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED) {
+      SET_STATUS(status, M2C_EXL_PARSER_STATUS_ALLOCATION_FAILED);
+    }
+    else {
+      SET_STATUS(status, M2C_EXL_PARSER_STATUS_FILE_NOT_FOUND);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  p.exporter = NULL;
+  p.fingerprint = NULL;
+  p.entry = NULL;
+  p.entry_count = 0;
+  p.capacity = 0;
+  p.status = M2C_EXL_PARSER_STATUS_SUCCESS;
+  
+  for (kind = 0; kind < M2C_EXL_KIND_END_MARK; kind++) {
+    p.start[kind] = 0;
+    p.count[kind] = 0;
+  } /* end for */
+  
+  /* header section* EOF */
+  if (parse_header(&p)) {
+    next_kind = 0;
+    token = m2c_exl_next_sym(p.lexer);
+    
+    while (token != EXL_TOKEN_EOF) {
+      kind = kind_for_token(token);
+      
+      if ((kind == M2C_EXL_KIND_END_MARK) || (kind < next_kind)) {
+        p.status = M2C_EXL_PARSER_STATUS_SYNTAX_ERROR;
+        break;
+      } /* end if */
+      
+      /* omitted sections start where the next one does */
+      while (next_kind <= kind) {
+        p.start[next_kind] = p.entry_count;
+        next_kind++;
+      } /* end while */
+      
+      if (NOT(parse_section(&p, kind))) {
+        break;
+      } /* end if */
+      
+      token = m2c_exl_next_sym(p.lexer);
+    } /* end while */
+    
+    while (next_kind < M2C_EXL_KIND_END_MARK) {
+      p.start[next_kind] = p.entry_count;
+      next_kind++;
+    } /* end while */
+  } /* end if */
+  
+  if (m2c_exl_lexer_status(p.lexer) == M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED) {
+    p.status = M2C_EXL_PARSER_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  m2c_exl_release_lexer(&p.lexer, NULL);
+  
+  if (p.status == M2C_EXL_PARSER_STATUS_SUCCESS) {
+    *list = new_list_from_parser(&p);
+    
+    if (*list == NULL) {
+      p.status = M2C_EXL_PARSER_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+  } /* end if */
+  
+  free(p.entry);
+  
+  SET_STATUS(status, p.status);
+} /* end m2c_exl_parse_file */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_exporter(list)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the module whose exports are listed in list.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_list_exporter (m2c_exl_list_t list) {
+  
+  if (list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return list->exporter;
+} /* end m2c_exl_list_exporter */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_fingerprint(list)
+ * --------------------------------------------------------------------------
+ * Returns the fingerprint key of list,  or NULL if it has none.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_list_fingerprint (m2c_exl_list_t list) {
+  
+  if (list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return list->fingerprint;
+} /* end m2c_exl_list_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_count(list, kind)
+ * --------------------------------------------------------------------------
+ * Returns the number of identifiers of the given kind in list.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_exl_list_count (m2c_exl_list_t list, m2c_exl_kind_t kind) {
+  
+  if ((list == NULL) || (kind >= M2C_EXL_KIND_END_MARK)) {
+    return 0;
+  } /* end if */
+  
+  return list->count[kind];
+} /* end m2c_exl_list_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_ident_at_index(list, kind, index)
+ * --------------------------------------------------------------------------
+ * Returns the identifier at index of the given kind in list.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_list_ident_at_index
+  (m2c_exl_list_t list, m2c_exl_kind_t kind, uint_t index) {
+  
+  if ((list == NULL) || (kind >= M2C_EXL_KIND_END_MARK) ||
+    (index >= list->count[kind])) {
+    return NULL;
+  } /* end if */
+  
+  return list->entry[list->start[kind] + index];
+} /* end m2c_exl_list_ident_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_release_list(list)
+ * --------------------------------------------------------------------------
+ * Deallocates list and passes NULL in list.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_release_list (m2c_exl_list_t *list) {
+  
+  if (list == NULL) {
+    return;
+  } /* end if */
+  
+  free(*list);
+  *list = NULL;
+} /* end m2c_exl_release_list */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function parse_header(p)
+ * --------------------------------------------------------------------------
+ * header :
+ *   'X:' ident ';' 'I:' ( '*' | identList ) ';' ( 'K:' key ';' )?
+ *   ;
+ *
+ * The importers are not recorded.
+ * ----------------------------------------------------------------------- */
+
+static bool parse_header (exl_parser_t *p) {
+  
+  m2c_exl_token_t token;
+  
+  /* 'X:' ident ';' */
+  if (NOT(match_token(p, EXL_TOKEN_EXPORTER)) ||
+    NOT(match_token(p, EXL_TOKEN_IDENT))) {
+    return false;
+  } /* end if */
+  
+  p->exporter = m2c_exl_lexer_current_lexeme(p->lexer);
+  
+  if (NOT(match_token(p, EXL_TOKEN_SEMICOLON)) ||
+    NOT(match_token(p, EXL_TOKEN_IMPORTERS))) {
+    return false;
+  } /* end if */
+  
+  /* ( '*' | identList ) ';' */
+  token = m2c_exl_next_sym(p->lexer);
+  
+  if (token == EXL_TOKEN_ASTERISK) {
+    m2c_exl_consume_sym(p->lexer);
+  }
+  else {
+    while ((token == EXL_TOKEN_IDENT) || (token == EXL_TOKEN_LOWLINE_IDENT)) {
+      token = m2c_exl_consume_sym(p->lexer);
+      
+      if (token != EXL_TOKEN_COMMA) {
+        break;
+      } /* end if */
+      
+      token = m2c_exl_consume_sym(p->lexer);
+    } /* end while */
+  } /* end if */
+  
+  if (NOT(match_token(p, EXL_TOKEN_SEMICOLON))) {
+    return false;
+  } /* end if */
+  
+  /* ( 'K:' key ';' )? */
+  if (m2c_exl_next_sym(p->lexer) == EXL_TOKEN_FINGERPRINT) {
+    m2c_exl_consume_sym(p->lexer);
+    
+    if (NOT(match_token(p, EXL_TOKEN_KEY))) {
+      return false;
+    } /* end if */
+    
+    p->fingerprint = m2c_exl_lexer_current_lexeme(p->lexer);
+    
+    if (NOT(match_token(p, EXL_TOKEN_SEMICOLON))) {
+      return false;
+    } /* end if */
+  } /* end if */
+  
+  return true;
+} /* end parse_header */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_section(p, kind)
+ * --------------------------------------------------------------------------
+ * section :
+ *   sectionPrefix ident ( ',' ident )* ';'
+ *   ;
+ * ----------------------------------------------------------------------- */
+
+static bool parse_section (exl_parser_t *p, m2c_exl_kind_t kind) {
+  
+  m2c_exl_token_t token;
+  
+  /* sectionPrefix */
+  token = m2c_exl_consume_sym(p->lexer);
+  
+  /* ident ( ',' ident )* */
+  while (true) {
+    if ((token != EXL_TOKEN_IDENT) && (token != EXL_TOKEN_LOWLINE_IDENT)) {
+      p->status = M2C_EXL_PARSER_STATUS_SYNTAX_ERROR;
+      return false;
+    } /* end if */
+    
+    m2c_exl_consume_sym(p->lexer);
+    
+    if (NOT(append_ident(p, m2c_exl_lexer_current_lexeme(p->lexer)))) {
+      return false;
+    } /* end if */
+    
+    p->count[kind]++;
+    
+    if (m2c_exl_next_sym(p->lexer) != EXL_TOKEN_COMMA) {
+      break;
+    } /* end if */
+    
+    token = m2c_exl_consume_sym(p->lexer);
+  } /* end while */
+  
+  /* ';' */
+  return match_token(p, EXL_TOKEN_SEMICOLON);
+} /* end parse_section */
+
+
+/* --------------------------------------------------------------------------
+ * private function match_token(p, token)
+ * --------------------------------------------------------------------------
+ * Consumes the lookahead symbol and returns true if it matches token,
+ * otherwise sets the status of p to a syntax error and returns false.  An
+ * identifier with lowlines matches EXL_TOKEN_IDENT.
+ * ----------------------------------------------------------------------- */
+
+static bool match_token (exl_parser_t *p, m2c_exl_token_t token) {
+  
+  m2c_exl_token_t lookahead;
+  
+  lookahead = m2c_exl_next_sym(p->lexer);
+  
+  if ((lookahead == token) ||
+    ((token == EXL_TOKEN_IDENT) && (lookahead == EXL_TOKEN_LOWLINE_IDENT))) {
+    m2c_exl_consume_sym(p->lexer);
+    return true;
+  } /* end if */
+  
+  p->status = M2C_EXL_PARSER_STATUS_SYNTAX_ERROR;
+  return false;
+} /* end match_token */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_ident(p, ident)
+ * --------------------------------------------------------------------------
+ * Appends ident to the identifier array of p,  growing it by doubling.
+ * Returns true on success,  false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool append_ident (exl_parser_t *p, intstr_t ident) {
+  
+  intstr_t *new_entry;
+  uint_t new_capacity;
+  
+  if (p->entry_count == p->capacity) {
+    new_capacity =
+      (p->capacity == 0) ? EXL_INITIAL_CAPACITY : 2 * p->capacity;
+    new_entry = realloc(p->entry, new_capacity * sizeof(intstr_t));
+    
+    if (new_entry == NULL) {
+      p->status = M2C_EXL_PARSER_STATUS_ALLOCATION_FAILED;
+      return false;
+    } /* end if */
+    
+    p->entry = new_entry;
+    p->capacity = new_capacity;
+  } /* end if */
+  
+  p->entry[p->entry_count] = ident;
+  p->entry_count++;
+  
+  return true;
+} /* end append_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function kind_for_token(token)
+ * --------------------------------------------------------------------------
+ * Returns the section kind of section prefix token,  or M2C_EXL_KIND_END_
+ * MARK if token is not the prefix of an identifier section.
+ * ----------------------------------------------------------------------- */
+
+static m2c_exl_kind_t kind_for_token (m2c_exl_token_t token) {
+  
+  switch (token) {
+    case EXL_TOKEN_TYPES :
+      return M2C_EXL_KIND_TYPE;
+    
+    case EXL_TOKEN_CONSTANTS :
+      return M2C_EXL_KIND_CONST;
+    
+    case EXL_TOKEN_VARIABLES :
+      return M2C_EXL_KIND_VAR;
+    
+    case EXL_TOKEN_FUNCTIONS :
+      return M2C_EXL_KIND_FUNC;
+    
+    case EXL_TOKEN_PROCEDURES :
+      return M2C_EXL_KIND_PROC;
+    
+    default :
+      return M2C_EXL_KIND_END_MARK;
+  } /* end switch */
+} /* end kind_for_token */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_list_from_parser(p)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated export list with the contents collected by p,
+ * or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_exl_list_t new_list_from_parser (exl_parser_t *p) {
+  
+  m2c_exl_list_t list;
+  
+  list = malloc(sizeof(struct m2c_exl_list_s) +
+    p->entry_count * sizeof(intstr_t));
+  
+  if (list == NULL) {
+    return NULL;
+  } /* end if */
+  
+  list->exporter = p->exporter;
+  list->fingerprint = p->fingerprint;
+  memcpy(list->start, p->start, sizeof(list->start));
+  memcpy(list->count, p->count, sizeof(list->count));
+  list->entry_count = p->entry_count;
+  
+  if (p->entry_count > 0) {
+    memcpy(list->entry, p->entry, p->entry_count * sizeof(intstr_t));
+  } /* end if */
+  
+  return list;
+} /* end new_list_from_parser */
+
+
+/* END OF FILE */
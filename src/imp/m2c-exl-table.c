@@ -0,0 +1,678 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-exl-table.c                                                           *
+ *                                                                           *
+ * Implementation of binary export list table module.                        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-exl-table.h"
+#include "outfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped tables for POSIX and Unix-like hosts
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  tables are mapped read-only into the
+ * address space and searched in place.  On all other hosts  (AmigaOS,
+ * OpenVMS, Windows) the file is read into a buffer.  Define M2C_EXL_TABLE_
+ * USE_MMAP as 0 to force the buffered implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_EXL_TABLE_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_EXL_TABLE_USE_MMAP 1
+#else
+#define M2C_EXL_TABLE_USE_MMAP 0
+#endif
+#endif
+
+#if (M2C_EXL_TABLE_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Table file layout
+ * ----------------------------------------------------------------------- */
+
+#define TABLE_MAGIC "M2CX"
+#define TABLE_MAGIC_LENGTH 4
+#define TABLE_HEADER_SIZE 20
+#define TABLE_ENTRY_SIZE 8
+#define TABLE_MAX_NAME_LENGTH 0xFFFF
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_exl_table_s
+ * --------------------------------------------------------------------------
+ * Record type to implement open tables.  Field data holds the mapped or
+ * buffered file contents,  fields entries and pool point into data.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_exl_table_s {
+  /* data */         const unsigned char *data;
+  /* size */         size_t size;
+  /* is_mapped */    bool is_mapped;
+  /* fingerprint */  m2c_digest_value_t fingerprint;
+  /* count */        uint_t count;
+  /* entries */      const unsigned char *entries;
+  /* pool */         const char *pool;
+  /* pool_size */    size_t pool_size;
+}; /* m2c_exl_table_s */
+
+
+/* --------------------------------------------------------------------------
+ * private type name_t
+ * --------------------------------------------------------------------------
+ * Record type for a name to be written,  with its position in the pool.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* chars */   const char *chars;
+  /* length */  uint_t length;
+  /* offset */  uint_t offset;
+  /* kind */    m2c_exl_kind_t kind;
+} name_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint_t load_u32 (const unsigned char *bytes);
+
+static uint_t load_u16 (const unsigned char *bytes);
+
+static void store_u32 (char *bytes, uint_t value);
+
+static int compare_names (const void *name1, const void *name2);
+
+static int compare_chars
+  (const char *chars1, uint_t length1, const char *chars2, uint_t length2);
+
+static m2c_exl_table_status_t read_file_data
+  (m2c_exl_table_t table, const char *path);
+
+static void release_file_data (m2c_exl_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_table_write(path, exporter, fingerprint, count, ...)
+ * --------------------------------------------------------------------------
+ * Writes a table with the given entries to the file at path.  The names of
+ * all entries are built in the pool in the order given,  then sorted.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_table_write
+  (const char *path,
+   intstr_t exporter,
+   m2c_digest_value_t fingerprint,
+   uint_t count,
+   const m2c_exl_table_entry_t entries[],
+   m2c_exl_table_status_t *status) {
+  
+  char header[TABLE_HEADER_SIZE], entry[TABLE_ENTRY_SIZE];
+  outfile_status_t outfile_status;
+  uint_t index, length, pool_size;
+  outfile_t outfile;
+  name_t *names;
+  char *pool;
+  
+  /* check pre-conditions */
+  if ((path == NULL) || (exporter == NULL) ||
+    ((count > 0) && (entries == NULL))) {
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* measure pool */
+  pool_size = intstr_length(exporter) + 1;
+  for (index = 0; index < count; index++) {
+    length = intstr_length(entries[index].ident);
+    if (entries[index].qualifier != NULL) {
+      length = length + intstr_length(entries[index].qualifier) + 1;
+    } /* end if */
+    
+    if (length > TABLE_MAX_NAME_LENGTH) {
+      SET_STATUS(status, M2C_EXL_TABLE_STATUS_INVALID_REFERENCE);
+      return;
+    } /* end if */
+    
+    pool_size = pool_size + length + 1;
+  } /* end for */
+  
+  pool = malloc(pool_size);
+  names = malloc((count + 1) * sizeof(name_t));
+  
+  if ((pool == NULL) || (names == NULL)) {
+    free(pool);
+    free(names);
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* build pool */
+  length = intstr_length(exporter);
+  memcpy(pool, intstr_char_ptr(exporter), length + 1);
+  pool_size = length + 1;
+  
+  for (index = 0; index < count; index++) {
+    names[index].chars = &pool[pool_size];
+    names[index].offset = pool_size;
+    names[index].kind = entries[index].kind;
+    
+    if (entries[index].qualifier != NULL) {
+      length = intstr_length(entries[index].qualifier);
+      memcpy(&pool[pool_size], intstr_char_ptr(entries[index].qualifier),
+        length);
+      pool[pool_size + length] = '.';
+      pool_size = pool_size + length + 1;
+    } /* end if */
+    
+    length = intstr_length(entries[index].ident);
+    memcpy(&pool[pool_size], intstr_char_ptr(entries[index].ident),
+      length + 1);
+    pool_size = pool_size + length + 1;
+    
+    names[index].length =
+      (uint_t) (&pool[pool_size] - names[index].chars) - 1;
+  } /* end for */
+  
+  qsort(names, count, sizeof(name_t), compare_names);
+  
+  /* unchanged tables must not trigger rebuilds */
+  outfile_open_if_changed(&outfile, path, &outfile_status);
+  
+  if (outfile == NULL) {
+    free(pool);
+    free(names);
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* header */
+  memcpy(header, TABLE_MAGIC, TABLE_MAGIC_LENGTH);
+  header[4] = (char) M2C_EXL_TABLE_VERSION;
+  header[5] = 0;
+  header[6] = 0;
+  header[7] = 0;
+  store_u32(&header[8], fingerprint);
+  store_u32(&header[12], count);
+  store_u32(&header[16], pool_size);
+  outfile_write_bytes(outfile, header, TABLE_HEADER_SIZE);
+  
+  /* entries in sorted order */
+  for (index = 0; index < count; index++) {
+    store_u32(&entry[0], names[index].offset);
+    entry[4] = (char) (names[index].length & 0xFF);
+    entry[5] = (char) ((names[index].length >> 8) & 0xFF);
+    entry[6] = (char) names[index].kind;
+    entry[7] = 0;
+    outfile_write_bytes(outfile, entry, TABLE_ENTRY_SIZE);
+  } /* end for */
+  
+  /* pool */
+  outfile_write_bytes(outfile, pool, pool_size);
+  
+  free(pool);
+  free(names);
+  
+  outfile_close_if_changed(&outfile, NULL, &outfile_status);
+  
+  if (outfile_status != FILEIO_STATUS_SUCCESS) {
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_WRITE_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_EXL_TABLE_STATUS_SUCCESS);
+} /* end m2c_exl_table_write */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_open(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the table at path and returns it,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_exl_table_t m2c_exl_table_open
+  (const char *path, m2c_exl_table_status_t *status) {
+  
+  m2c_exl_table_status_t read_status;
+  m2c_exl_table_t table;
+  size_t entries_size;
+  
+  /* check pre-conditions */
+  if (path == NULL) {
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  table = malloc(sizeof(struct m2c_exl_table_s));
+  
+  if (table == NULL) {
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  read_status = read_file_data(table, path);
+  
+  if (read_status != M2C_EXL_TABLE_STATUS_SUCCESS) {
+    free(table);
+    SET_STATUS(status, read_status);
+    return NULL;
+  } /* end if */
+  
+  /* header */
+  if ((memcmp(table->data, TABLE_MAGIC, TABLE_MAGIC_LENGTH) != 0) ||
+    (table->data[4] != M2C_EXL_TABLE_VERSION)) {
+    release_file_data(table);
+    free(table);
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_INVALID_FILE);
+    return NULL;
+  } /* end if */
+  
+  table->fingerprint = (m2c_digest_value_t) load_u32(&table->data[8]);
+  table->count = load_u32(&table->data[12]);
+  table->pool_size = load_u32(&table->data[16]);
+  entries_size = (size_t) table->count * TABLE_ENTRY_SIZE;
+  
+  /* sections must add up, the pool must end in NUL */
+  if ((table->count > (table->size - TABLE_HEADER_SIZE) / TABLE_ENTRY_SIZE) ||
+    (table->pool_size == 0) ||
+    (TABLE_HEADER_SIZE + entries_size + table->pool_size != table->size) ||
+    (table->data[table->size - 1] != ASCII_NUL)) {
+    release_file_data(table);
+    free(table);
+    SET_STATUS(status, M2C_EXL_TABLE_STATUS_INVALID_FILE);
+    return NULL;
+  } /* end if */
+  
+  table->entries = &table->data[TABLE_HEADER_SIZE];
+  table->pool = (const char *) &table->data[TABLE_HEADER_SIZE + entries_size];
+  
+  SET_STATUS(status, M2C_EXL_TABLE_STATUS_SUCCESS);
+  return table;
+} /* end m2c_exl_table_open */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_exporter(table)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the exporting module of table.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_exl_table_exporter (m2c_exl_table_t table) {
+  
+  if (table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return table->pool;
+} /* end m2c_exl_table_exporter */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_fingerprint(table)
+ * --------------------------------------------------------------------------
+ * Returns the interface fingerprint recorded in table.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_exl_table_fingerprint (m2c_exl_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->fingerprint;
+} /* end m2c_exl_table_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of identifiers in table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_exl_table_count (m2c_exl_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->count;
+} /* end m2c_exl_table_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_lookup(table, ident, length, kind)
+ * --------------------------------------------------------------------------
+ * Searches table for the length characters at ident by binary search over
+ * the sorted entries.  An entry whose name lies outside the pool is taken
+ * as a mismatch  and ends the search.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_exl_table_lookup
+  (m2c_exl_table_t table,
+   const char *ident,
+   uint_t length,
+   m2c_exl_kind_t *kind) {
+  
+  uint_t low, high, middle, offset, name_length;
+  const unsigned char *entry;
+  int order;
+  
+  if ((table == NULL) || (ident == NULL)) {
+    return false;
+  } /* end if */
+  
+  low = 0;
+  high = table->count;
+  
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    entry = &table->entries[(size_t) middle * TABLE_ENTRY_SIZE];
+    offset = load_u32(entry);
+    name_length = load_u16(&entry[4]);
+    
+    if ((offset > table->pool_size) ||
+      (name_length > table->pool_size - offset)) {
+      return false;
+    } /* end if */
+    
+    order = compare_chars
+      (ident, length, &table->pool[offset], name_length);
+    
+    if (order == 0) {
+      if (kind != NULL) {
+        *kind = (m2c_exl_kind_t) entry[6];
+      } /* end if */
+      return true;
+    }
+    else if (order < 0) {
+      high = middle;
+    }
+    else /* order > 0 */ {
+      low = middle + 1;
+    } /* end if */
+  } /* end while */
+  
+  return false;
+} /* end m2c_exl_table_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_exports(table, ident)
+ * --------------------------------------------------------------------------
+ * Returns true if interned identifier ident is exported by table.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_exl_table_exports (m2c_exl_table_t table, intstr_t ident) {
+  
+  if (ident == NULL) {
+    return false;
+  } /* end if */
+  
+  return m2c_exl_table_lookup
+    (table, intstr_char_ptr(ident), intstr_length(ident), NULL);
+} /* end m2c_exl_table_exports */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_table_close(table)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates table and passes NULL in table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_table_close (m2c_exl_table_t *table) {
+  
+  if ((table == NULL) || (*table == NULL)) {
+    return;
+  } /* end if */
+  
+  release_file_data(*table);
+  free(*table);
+  *table = NULL;
+} /* end m2c_exl_table_close */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function load_u32(bytes)
+ * --------------------------------------------------------------------------
+ * Returns the little endian 32-bit integer at bytes.
+ * ----------------------------------------------------------------------- */
+
+static uint_t load_u32 (const unsigned char *bytes) {
+  
+  return (uint_t) bytes[0] | ((uint_t) bytes[1] << 8) |
+    ((uint_t) bytes[2] << 16) | ((uint_t) bytes[3] << 24);
+} /* end load_u32 */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_u16(bytes)
+ * --------------------------------------------------------------------------
+ * Returns the little endian 16-bit integer at bytes.
+ * ----------------------------------------------------------------------- */
+
+static uint_t load_u16 (const unsigned char *bytes) {
+  
+  return (uint_t) bytes[0] | ((uint_t) bytes[1] << 8);
+} /* end load_u16 */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure store_u32(bytes, value)
+ * --------------------------------------------------------------------------
+ * Stores value as a little endian 32-bit integer at bytes.
+ * ----------------------------------------------------------------------- */
+
+static void store_u32 (char *bytes, uint_t value) {
+  
+  bytes[0] = (char) (value & 0xFF);
+  bytes[1] = (char) ((value >> 8) & 0xFF);
+  bytes[2] = (char) ((value >> 16) & 0xFF);
+  bytes[3] = (char) ((value >> 24) & 0xFF);
+} /* end store_u32 */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_names(name1, name2)
+ * --------------------------------------------------------------------------
+ * Comparison function for qsort,  orders names by their characters.
+ * ----------------------------------------------------------------------- */
+
+static int compare_names (const void *name1, const void *name2) {
+  
+  const name_t *n1 = name1, *n2 = name2;
+  
+  return compare_chars(n1->chars, n1->length, n2->chars, n2->length);
+} /* end compare_names */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_chars(chars1, length1, chars2, length2)
+ * --------------------------------------------------------------------------
+ * Compares two character sequences bytewise,  a proper prefix ordering
+ * before the longer sequence.  Returns a negative value,  zero or a positive
+ * value if the first sequence orders before,  equal to or after the second.
+ * ----------------------------------------------------------------------- */
+
+static int compare_chars
+  (const char *chars1, uint_t length1, const char *chars2, uint_t length2) {
+  
+  int order;
+  
+  order = memcmp(chars1, chars2, (length1 < length2) ? length1 : length2);
+  
+  if (order != 0) {
+    return order;
+  } /* end if */
+  
+  return (length1 > length2) - (length1 < length2);
+} /* end compare_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_file_data(table, path)
+ * --------------------------------------------------------------------------
+ * Maps or reads the contents of the file at path into memory and records
+ * them in fields data,  size and is_mapped of table.  Files shorter than a
+ * header are rejected.
+ * ----------------------------------------------------------------------- */
+
+static m2c_exl_table_status_t read_file_data
+  (m2c_exl_table_t table, const char *path) {
+  
+#if (M2C_EXL_TABLE_USE_MMAP)
+  struct stat info;
+  void *map;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) || NOT(S_ISREG(info.st_mode))) {
+    close(fd);
+    return M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  if ((size_t) info.st_size < TABLE_HEADER_SIZE) {
+    close(fd);
+    return M2C_EXL_TABLE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    return M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  table->data = map;
+  table->size = (size_t) info.st_size;
+  table->is_mapped = true;
+  
+  return M2C_EXL_TABLE_STATUS_SUCCESS;
+#else
+  unsigned char *data;
+  FILE *file;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  if ((size_t) size < TABLE_HEADER_SIZE) {
+    fclose(file);
+    return M2C_EXL_TABLE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  data = malloc((size_t) size);
+  
+  if (data == NULL) {
+    fclose(file);
+    return M2C_EXL_TABLE_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) size, file) != (size_t) size) {
+    free(data);
+    fclose(file);
+    return M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND;
+  } /* end if */
+  
+  fclose(file);
+  
+  table->data = data;
+  table->size = (size_t) size;
+  table->is_mapped = false;
+  
+  return M2C_EXL_TABLE_STATUS_SUCCESS;
+#endif
+} /* end read_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_file_data(table)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates the file contents of table.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_exl_table_t table) {
+  
+#if (M2C_EXL_TABLE_USE_MMAP)
+  if (table->is_mapped) {
+    munmap((void *) table->data, table->size);
+  }
+  else {
+    free((void *) table->data);
+  } /* end if */
+#else
+  free((void *) table->data);
+#endif
+  
+  table->data = NULL;
+  table->size = 0;
+} /* end release_file_data */
+
+
+/* END OF FILE */
@@ -0,0 +1,793 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-exl-writer.c                                                          *
+ *                                                                           *
+ * Implementation of export list file writer module.                         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-exl-writer.h"
+
+#include "m2c-exl-table.h"
+#include "m2c-ast.h"
+#include "m2c-statistics.h"
+#include "m2c-parser.h"
+#include "m2c-digest.h"
+#include "outfile.h"
+#include "interned-strings.h"
+#include "cstring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of table entry arrays
+ * ----------------------------------------------------------------------- */
+
+#define TABLE_INITIAL_CAPACITY 64
+
+
+/* --------------------------------------------------------------------------
+ * private type table_entries_t
+ * --------------------------------------------------------------------------
+ * Record type for the identifiers collected for a binary export list table
+ * while the export list is written.  Field failed is set if the array could
+ * not be grown.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* entry */     m2c_exl_table_entry_t *entry;
+  /* count */     uint_t count;
+  /* capacity */  uint_t capacity;
+  /* failed */    bool failed;
+} table_entries_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type section_t
+ * --------------------------------------------------------------------------
+ * Record type for a section of an export list being written.  Field count
+ * holds the number of identifiers written to the section so far.  Unless
+ * field table is NULL,  identifiers are also collected there with the kind
+ * of the section.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* file */  outfile_t file;
+  /* tag */   const char *tag;
+  /* kind */  m2c_exl_kind_t kind;
+  /* count */ uint_t count;
+  /* table */ table_entries_t *table;
+} section_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type section_lister_f
+ * --------------------------------------------------------------------------
+ * Function type for listing the identifiers a top-level declaration node
+ * contributes to a section.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*section_lister_f) (m2c_astnode_t decl, section_t *section);
+
+
+/* --------------------------------------------------------------------------
+ * private table section_table
+ * --------------------------------------------------------------------------
+ * Tags and listers of the sections of an export list in the order written.
+ * ----------------------------------------------------------------------- */
+
+static void list_types (m2c_astnode_t decl, section_t *section);
+static void list_consts (m2c_astnode_t decl, section_t *section);
+static void list_vars (m2c_astnode_t decl, section_t *section);
+static void list_funcs (m2c_astnode_t decl, section_t *section);
+static void list_procs (m2c_astnode_t decl, section_t *section);
+
+static const struct {
+  const char *tag;
+  m2c_exl_kind_t kind;
+  section_lister_f lister;
+} section_table[] = {
+  { "T:", M2C_EXL_KIND_TYPE, list_types },
+  { "C:", M2C_EXL_KIND_CONST, list_consts },
+  { "V:", M2C_EXL_KIND_VAR, list_vars },
+  { "F:", M2C_EXL_KIND_FUNC, list_funcs },
+  { "P:", M2C_EXL_KIND_PROC, list_procs }
+}; /* end section_table */
+
+#define SECTION_COUNT (sizeof(section_table) / sizeof(section_table[0]))
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_write_exl_for_def(defpath, exlpath, options, status)
+ * --------------------------------------------------------------------------
+ * Parses the definition module referenced by defpath  and writes the list of
+ * its exported identifiers by kind to the export list file at exlpath,  and
+ * with option --exlb a binary export list table alongside.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast);
+
+static void write_exl_file
+  (m2c_astnode_t module, outfile_t file, table_entries_t *table);
+
+static bool write_table_file
+  (const char *exlpath, m2c_astnode_t module, table_entries_t *table);
+
+void m2c_write_exl_for_def
+  (const char *defpath,
+   const char *exlpath,
+   m2c_compiler_options_t options,
+   m2c_exl_writer_status_t *status) {
+  
+  m2c_ast_region_t region, prev_region;
+  m2c_parser_status_t parser_status;
+  m2c_astnode_t module;
+  m2c_stats_t stats;
+  outfile_t file;
+  outfile_status_t file_status;
+  table_entries_t table, *table_ptr;
+  bool table_written;
+  
+  if ((defpath == NULL) || (exlpath == NULL)) {
+    SET_STATUS(status, M2C_EXL_WRITER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  region = m2c_ast_new_region(0);
+  
+  if (region == NULL) {
+    SET_STATUS(status, M2C_EXL_WRITER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* parse into scratch region */
+  prev_region = m2c_ast_current_region();
+  m2c_ast_set_region(region);
+  
+  stats = NULL;
+  module = module_node(m2c_parse_file_with_options
+    (defpath, options, &stats, &parser_status));
+  
+  m2c_ast_set_region(prev_region);
+  
+  if (stats != NULL) {
+    m2c_stats_release(stats);
+  } /* end if */
+  
+  if (parser_status != M2C_PARSER_STATUS_SUCCESS) {
+    m2c_ast_release_region(region);
+    
+    if (parser_status == M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND) {
+      SET_STATUS(status, M2C_EXL_WRITER_STATUS_SYNTAX_ERRORS_FOUND);
+    }
+    else if (parser_status == M2C_PARSER_STATUS_ALLOCATION_FAILED) {
+      SET_STATUS(status, M2C_EXL_WRITER_STATUS_ALLOCATION_FAILED);
+    }
+    else /* file not found or unsupported source type */ {
+      SET_STATUS(status, M2C_EXL_WRITER_STATUS_FILE_ACCESS_FAILED);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  if (m2c_ast_nodetype(module) != AST_INTERFACE) {
+    m2c_ast_release_region(region);
+    SET_STATUS(status, M2C_EXL_WRITER_STATUS_INVALID_SOURCETYPE);
+    return;
+  } /* end if */
+  
+  /* an unchanged export list keeps its timestamp */
+  outfile_open_if_changed(&file, exlpath, &file_status);
+  
+  if (file == NULL) {
+    m2c_ast_release_region(region);
+    SET_STATUS(status, M2C_EXL_WRITER_STATUS_FILE_ACCESS_FAILED);
+    return;
+  } /* end if */
+  
+  table.entry = NULL;
+  table.count = 0;
+  table.capacity = 0;
+  table.failed = false;
+  
+  if (m2c_compiler_options_flag(options, M2C_COMPILER_OPTION_BINARY_EXL)) {
+    table_ptr = &table;
+  }
+  else {
+    table_ptr = NULL;
+  } /* end if */
+  
+  write_exl_file(module, file, table_ptr);
+  
+  table_written = true;
+  if (table_ptr != NULL) {
+    table_written = write_table_file(exlpath, module, table_ptr);
+    free(table.entry);
+  } /* end if */
+  
+  m2c_ast_release_region(region);
+  
+  outfile_close_if_changed(&file, NULL, &file_status);
+  
+  if ((file_status != FILEIO_STATUS_SUCCESS) || NOT(table_written)) {
+    SET_STATUS(status, M2C_EXL_WRITER_STATUS_FILE_ACCESS_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_EXL_WRITER_STATUS_SUCCESS);
+  return;
+} /* end m2c_write_exl_for_def */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function module_node(ast)
+ * --------------------------------------------------------------------------
+ * Returns the module node of ast,  unwrapping a FILE node if present.
+ *
+ * astnode: (FILE (FNAME "Foobar.def") (KEY 0xF04FC729) moduleNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast) {
+  
+  if (m2c_ast_nodetype(ast) == AST_FILE) {
+    return m2c_ast_subnode_at_index(ast, 2);
+  } /* end if */
+  
+  return ast;
+} /* end module_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_exl_file(module, file, table)
+ * --------------------------------------------------------------------------
+ * Writes the export list of interface module node module to file.  Each
+ * section is written in a pass over the top-level declarations,  thus no
+ * intermediate lists are built.  Unless table is NULL,  the identifiers
+ * are also collected in table.
+ *
+ * astnode: (INTERFACE identNode impList defDeclList)
+ * ----------------------------------------------------------------------- */
+
+static intstr_t fingerprint_key (m2c_astnode_t module);
+
+static void write_exl_file
+  (m2c_astnode_t module, outfile_t file, table_entries_t *table) {
+  m2c_astnode_t decl_list;
+  unsigned short index, decl_count;
+  section_t section;
+  uint_t sect_index;
+  
+  /* header */
+  outfile_write_chars(file, "X:");
+  outfile_write_string(file,
+    m2c_ast_value(m2c_ast_subnode_at_index(module, 0)));
+  outfile_write_chars(file, "; I:*; K:");
+  outfile_write_string(file, fingerprint_key(module));
+  outfile_write_char(file, ';');
+  outfile_write_newline(file);
+  
+  decl_list = m2c_ast_subnode_at_index(module, 2);
+  decl_count = m2c_ast_subnode_count(decl_list);
+  
+  section.file = file;
+  section.table = table;
+  
+  /* sections */
+  for (sect_index = 0; sect_index < SECTION_COUNT; sect_index++) {
+    section.tag = section_table[sect_index].tag;
+    section.kind = section_table[sect_index].kind;
+    section.count = 0;
+    
+    index = 0;
+    while (index < decl_count) {
+      section_table[sect_index].lister
+        (m2c_ast_subnode_at_index(decl_list, index), &section);
+      index++;
+    } /* end while */
+    
+    if (section.count > 0) {
+      outfile_write_char(file, ';');
+      outfile_write_newline(file);
+    } /* end if */
+  } /* end for */
+  
+} /* end write_exl_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function fingerprint_key(module)
+ * --------------------------------------------------------------------------
+ * Returns an interned string  with the hexadecimal notation of the interface
+ * fingerprint of interface module node module.  The fingerprint is a digest
+ * over the module identifier,  the identifiers of the import list  and the
+ * keys of the top-level definitions in order.  Definition keys are digests
+ * of the symbols of a definition,  thus they cover the exported type and
+ * procedure signatures  but not comments,  layout  or the implementation.
+ *
+ * astnode: (INTERFACE identNode impList defDeclList)
+ * ----------------------------------------------------------------------- */
+
+static m2c_digest_value_t fingerprint_value (m2c_astnode_t module);
+
+static intstr_t fingerprint_key (m2c_astnode_t module) {
+  char key[11];
+  
+  snprintf(key, sizeof(key), "0x%08X",
+    (unsigned int) fingerprint_value(module));
+  
+  return intstr_for_cstr(key, NULL);
+} /* end fingerprint_key */
+
+
+/* --------------------------------------------------------------------------
+ * private function fingerprint_value(module)
+ * --------------------------------------------------------------------------
+ * Returns the interface fingerprint of interface module node module.
+ *
+ * astnode: (INTERFACE identNode impList defDeclList)
+ * ----------------------------------------------------------------------- */
+
+static void add_idents (m2c_digest_t digest, m2c_astnode_t node);
+
+static void add_decl_keys (m2c_digest_t digest, m2c_astnode_t node);
+
+static m2c_digest_value_t fingerprint_value (m2c_astnode_t module) {
+  m2c_astnode_t decl_list;
+  unsigned short index, decl_count;
+  m2c_digest_s digest;
+  
+  m2c_digest_reset(&digest);
+  
+  m2c_digest_add_lexeme(&digest, M2C_DIGEST_DONT_PREPEND_SPACER,
+    m2c_ast_value(m2c_ast_subnode_at_index(module, 0)));
+  
+  add_idents(&digest, m2c_ast_subnode_at_index(module, 1));
+  
+  decl_list = m2c_ast_subnode_at_index(module, 2);
+  decl_count = m2c_ast_subnode_count(decl_list);
+  
+  index = 0;
+  while (index < decl_count) {
+    add_decl_keys(&digest, m2c_ast_subnode_at_index(decl_list, index));
+    index++;
+  } /* end while */
+  
+  m2c_digest_finalize(&digest);
+  
+  return m2c_digest_value(&digest);
+} /* end fingerprint_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_table_file(exlpath, module, table)
+ * --------------------------------------------------------------------------
+ * Writes the identifiers collected in table as the binary export list table
+ * of interface module node module  to the path of its export list exlpath
+ * with suffix M2C_EXL_TABLE_SUFFIX appended.  Returns true on success,
+ * otherwise false.
+ *
+ * astnode: (INTERFACE identNode impList defDeclList)
+ * ----------------------------------------------------------------------- */
+
+static bool write_table_file
+  (const char *exlpath, m2c_astnode_t module, table_entries_t *table) {
+  
+  m2c_exl_table_status_t table_status;
+  const char *path;
+  
+  if (table->failed) {
+    return false;
+  } /* end if */
+  
+  path = new_cstr_by_concat(exlpath, M2C_EXL_TABLE_SUFFIX, NULL);
+  
+  if (path == NULL) {
+    return false;
+  } /* end if */
+  
+  m2c_exl_table_write(path,
+    m2c_ast_value(m2c_ast_subnode_at_index(module, 0)),
+    fingerprint_value(module), table->count, table->entry, &table_status);
+  
+  free((void *) path);
+  
+  return (table_status == M2C_EXL_TABLE_STATUS_SUCCESS);
+} /* end write_table_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_idents(digest, node)
+ * --------------------------------------------------------------------------
+ * Adds the values of all IDENT nodes in the subtree of node to digest.
+ *
+ * astnode: (IMPLIST (IMPORT identListNode) ...)
+ * ----------------------------------------------------------------------- */
+
+static void add_idents (m2c_digest_t digest, m2c_astnode_t node) {
+  unsigned short index, count;
+  
+  if (m2c_ast_nodetype(node) == AST_IDENT) {
+    m2c_digest_add_lexeme(digest, M2C_DIGEST_PREPEND_SPACER,
+      m2c_ast_value(node));
+    return;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(node);
+  
+  index = 0;
+  while (index < count) {
+    add_idents(digest, m2c_ast_subnode_at_index(node, index));
+    index++;
+  } /* end while */
+} /* end add_idents */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_decl_keys(digest, node)
+ * --------------------------------------------------------------------------
+ * Adds the definition keys of top-level definition node to digest.  Node is
+ * either a DECL node or a definition list of DECL nodes.
+ *
+ * astnode: (DECL (DECLKEY 0x3A7E01C2) declNode)
+ *
+ * astnode: (CONSTDEFLIST (DECL key constDef) ...)
+ * ----------------------------------------------------------------------- */
+
+static void add_decl_keys (m2c_digest_t digest, m2c_astnode_t node) {
+  unsigned short index, count;
+  
+  if (m2c_ast_nodetype(node) == AST_DECL) {
+    m2c_digest_add_lexeme(digest, M2C_DIGEST_PREPEND_SPACER,
+      m2c_ast_value(m2c_ast_subnode_at_index(node, 0)));
+    return;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(node);
+  
+  index = 0;
+  while (index < count) {
+    if (m2c_ast_nodetype(m2c_ast_subnode_at_index(node, index)) == AST_DECL) {
+      add_decl_keys(digest, m2c_ast_subnode_at_index(node, index));
+    } /* end if */
+    index++;
+  } /* end while */
+} /* end add_decl_keys */
+
+
+/* --------------------------------------------------------------------------
+ * private function defn_of(node)
+ * --------------------------------------------------------------------------
+ * Returns the definition node of node,  unwrapping a DECL node if present.
+ *
+ * astnode: (DECL (DECLKEY 0x3A7E01C2) declNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t defn_of (m2c_astnode_t node) {
+  
+  if (m2c_ast_nodetype(node) == AST_DECL) {
+    return m2c_ast_subnode_at_index(node, 1);
+  } /* end if */
+  
+  return node;
+} /* end defn_of */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_ident(section, qualifier, ident_node)
+ * --------------------------------------------------------------------------
+ * Writes the identifier of ident_node to section,  prefixed by the section
+ * tag if it is the first of the section,  otherwise by a comma.  Qualifies
+ * the identifier with qualifier unless it is NULL.  Adds the identifier to
+ * the table of section unless it is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void add_table_entry
+  (table_entries_t *table, intstr_t qualifier, intstr_t ident,
+   m2c_exl_kind_t kind);
+
+static void write_ident
+  (section_t *section, intstr_t qualifier, m2c_astnode_t ident_node) {
+  
+  if (m2c_ast_nodetype(ident_node) != AST_IDENT) {
+    return;
+  } /* end if */
+  
+  if (section->count == 0) {
+    outfile_write_chars(section->file, section->tag);
+  }
+  else /* subsequent identifier */ {
+    outfile_write_chars(section->file, ", ");
+  } /* end if */
+  
+  if (qualifier != NULL) {
+    outfile_write_string(section->file, qualifier);
+    outfile_write_char(section->file, '.');
+  } /* end if */
+  
+  outfile_write_string(section->file, m2c_ast_value(ident_node));
+  section->count++;
+  
+  if (section->table != NULL) {
+    add_table_entry(section->table,
+      qualifier, m2c_ast_value(ident_node), section->kind);
+  } /* end if */
+} /* end write_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_table_entry(table, qualifier, ident, kind)
+ * --------------------------------------------------------------------------
+ * Appends an entry for ident to table,  growing it by doubling.  Sets field
+ * failed of table if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static void add_table_entry
+  (table_entries_t *table, intstr_t qualifier, intstr_t ident,
+   m2c_exl_kind_t kind) {
+  
+  m2c_exl_table_entry_t *new_entry;
+  uint_t new_capacity;
+  
+  if (table->failed) {
+    return;
+  } /* end if */
+  
+  if (table->count == table->capacity) {
+    new_capacity = (table->capacity == 0) ?
+      TABLE_INITIAL_CAPACITY : 2 * table->capacity;
+    new_entry =
+      realloc(table->entry, new_capacity * sizeof(m2c_exl_table_entry_t));
+    
+    if (new_entry == NULL) {
+      table->failed = true;
+      return;
+    } /* end if */
+    
+    table->entry = new_entry;
+    table->capacity = new_capacity;
+  } /* end if */
+  
+  table->entry[table->count].qualifier = qualifier;
+  table->entry[table->count].ident = ident;
+  table->entry[table->count].kind = kind;
+  table->count++;
+} /* end add_table_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_ident_list(section, qualifier, list_node)
+ * --------------------------------------------------------------------------
+ * Writes the identifiers of list_node to section.
+ *
+ * astnode: (IDENTLIST ident0 ident1 ident2 ... identN)
+ * ----------------------------------------------------------------------- */
+
+static void write_ident_list
+  (section_t *section, intstr_t qualifier, m2c_astnode_t list_node) {
+  unsigned short index, count;
+  m2c_astnode_t ident_node;
+  
+  count = m2c_ast_subnode_count(list_node);
+  
+  index = 0;
+  while (index < count) {
+    ident_node = m2c_ast_subnode_at_index(list_node, index);
+    write_ident(section, qualifier, ident_node);
+    index++;
+  } /* end while */
+} /* end write_ident_list */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure list_types(decl, section)
+ * --------------------------------------------------------------------------
+ * Lists the type identifiers of a type definition list.
+ *
+ * astnode: (TYPEDEFLIST (DECL key (TYPEDEF identNode typeNode)) ...)
+ * ----------------------------------------------------------------------- */
+
+static void list_types (m2c_astnode_t decl, section_t *section) {
+  unsigned short index, count;
+  m2c_astnode_t defn;
+  
+  if (m2c_ast_nodetype(decl) != AST_TYPEDEFLIST) {
+    return;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(decl);
+  
+  index = 0;
+  while (index < count) {
+    defn = defn_of(m2c_ast_subnode_at_index(decl, index));
+    write_ident(section, NULL, m2c_ast_subnode_at_index(defn, 0));
+    index++;
+  } /* end while */
+} /* end list_types */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure list_consts(decl, section)
+ * --------------------------------------------------------------------------
+ * Lists the constant identifiers of a constant definition list  and the
+ * values of enumeration types of a type definition list,  the latter
+ * qualified by the identifier of their type.
+ *
+ * astnode: (CONSTDEFLIST (DECL key (CONST bind constId typeId expr)) ...)
+ *
+ * astnode: (TYPEDEFLIST (DECL key (TYPEDEF identNode typeNode)) ...)
+ *   with typeNode: (ENUM baseType enumValues)
+ * ----------------------------------------------------------------------- */
+
+static void list_consts (m2c_astnode_t decl, section_t *section) {
+  m2c_astnode_t defn, ident_node, type_node;
+  unsigned short index, count;
+  m2c_ast_nodetype_t decl_type;
+  
+  decl_type = m2c_ast_nodetype(decl);
+  
+  if ((decl_type != AST_CONSTDEFLIST) && (decl_type != AST_TYPEDEFLIST)) {
+    return;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(decl);
+  
+  index = 0;
+  while (index < count) {
+    defn = defn_of(m2c_ast_subnode_at_index(decl, index));
+    
+    if (decl_type == AST_CONSTDEFLIST) {
+      write_ident(section, NULL, m2c_ast_subnode_at_index(defn, 1));
+    }
+    else /* type definition */ {
+      ident_node = m2c_ast_subnode_at_index(defn, 0);
+      type_node = m2c_ast_subnode_at_index(defn, 1);
+      
+      if (m2c_ast_nodetype(type_node) == AST_ENUM) {
+        write_ident_list(section, m2c_ast_value(ident_node),
+          m2c_ast_subnode_at_index(type_node, 1));
+      } /* end if */
+    } /* end if */
+    index++;
+  } /* end while */
+} /* end list_consts */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure list_vars(decl, section)
+ * --------------------------------------------------------------------------
+ * Lists the variable identifiers of a variable definition list.
+ *
+ * astnode: (VARDEFLIST (DECL key (VARDEF idlistNode typeId)) ...)
+ * ----------------------------------------------------------------------- */
+
+static void list_vars (m2c_astnode_t decl, section_t *section) {
+  unsigned short index, count;
+  m2c_astnode_t defn;
+  
+  if (m2c_ast_nodetype(decl) != AST_VARDEFLIST) {
+    return;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(decl);
+  
+  index = 0;
+  while (index < count) {
+    defn = defn_of(m2c_ast_subnode_at_index(decl, index));
+    write_ident_list(section, NULL, m2c_ast_subnode_at_index(defn, 0));
+    index++;
+  } /* end while */
+} /* end list_vars */
+
+
+/* --------------------------------------------------------------------------
+ * private function proc_signature(decl, is_function)
+ * --------------------------------------------------------------------------
+ * Returns the signature node of a procedure declaration  if it declares a
+ * function procedure as requested by is_function,  otherwise NULL.
+ *
+ * astnode: (DECL key (PROCDECL bindSpecNode signatureNode))
+ *
+ * signatureNode: (PSIG identNode formalParamListNode returnTypeNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t proc_signature (m2c_astnode_t decl, bool is_function) {
+  m2c_astnode_t defn, psig_node, type_node;
+  
+  defn = defn_of(decl);
+  
+  if (m2c_ast_nodetype(defn) != AST_PROCDECL) {
+    return NULL;
+  } /* end if */
+  
+  psig_node = m2c_ast_subnode_at_index(defn, 1);
+  
+  if (m2c_ast_nodetype(psig_node) != AST_PSIG) {
+    return NULL;
+  } /* end if */
+  
+  type_node = m2c_ast_subnode_at_index(psig_node, 2);
+  
+  if ((m2c_ast_nodetype(type_node) != AST_EMPTY) != is_function) {
+    return NULL;
+  } /* end if */
+  
+  return psig_node;
+} /* end proc_signature */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure list_funcs(decl, section)
+ * --------------------------------------------------------------------------
+ * Lists the identifier of a function procedure declaration.
+ * ----------------------------------------------------------------------- */
+
+static void list_funcs (m2c_astnode_t decl, section_t *section) {
+  m2c_astnode_t psig_node;
+  
+  psig_node = proc_signature(decl, true);
+  
+  if (psig_node != NULL) {
+    write_ident(section, NULL, m2c_ast_subnode_at_index(psig_node, 0));
+  } /* end if */
+} /* end list_funcs */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure list_procs(decl, section)
+ * --------------------------------------------------------------------------
+ * Lists the identifier of a regular procedure declaration.
+ * ----------------------------------------------------------------------- */
+
+static void list_procs (m2c_astnode_t decl, section_t *section) {
+  m2c_astnode_t psig_node;
+  
+  psig_node = proc_signature(decl, false);
+  
+  if (psig_node != NULL) {
+    write_ident(section, NULL, m2c_ast_subnode_at_index(psig_node, 0));
+  } /* end if */
+} /* end list_procs */
+
+
+/* END OF FILE */
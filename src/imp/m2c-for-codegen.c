@@ -0,0 +1,909 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-for-codegen.c                                                         *
+ *                                                                           *
+ * Implementation of translation of FOR loops without bounds checks.         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-for-codegen.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type entry_kind_t
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  ENTRY_LOOP,
+  ENTRY_SUBSCRIPT
+} entry_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type bounds_entry_t
+ * --------------------------------------------------------------------------
+ * Entry of the bounds table,  holding a proven FOR node or SUBSCRTAIL node,
+ * the nesting depth of the proven loop,  which names its element pointer,
+ * and for a loop,  whether its accessor is used other than in proven
+ * subscripts.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_astnode_t node;
+  entry_kind_t kind;
+  uint_t depth;
+  bool accessor_used;
+} bounds_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_bounds_table_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a bounds table.  The table uses open addressing
+ * with linear probing,  its capacity is a power of two.
+ * ----------------------------------------------------------------------- */
+
+#define BOUNDS_TABLE_INITIAL_CAPACITY 64
+
+struct m2c_bounds_table_struct_t {
+  bounds_entry_t *entry;
+  uint_t count;
+  uint_t capacity;
+};
+
+typedef struct m2c_bounds_table_struct_t m2c_bounds_table_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type loop_walk_t
+ * --------------------------------------------------------------------------
+ * Context of the search for FOR loops,  depth is the number of enclosing
+ * proven loops.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_bounds_table_t table;
+  m2c_array_predicate_f is_array;
+  void *context;
+  uint_t depth;
+  uint_t proven_count;
+} loop_walk_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type body_scan_t
+ * --------------------------------------------------------------------------
+ * Context of the scan of the body of a FOR loop for subscripts of array by
+ * accessor.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_bounds_table_t table;
+  m2c_astnode_t array;
+  intstr_t accessor;
+  uint_t depth;
+  uint_t accessor_count;
+  uint_t proven_count;
+} body_scan_t;
+
+
+/* --------------------------------------------------------------------------
+ * Names of temporaries in generated code,  suffixed by loop depth
+ * ----------------------------------------------------------------------- */
+
+#define LOWER_TEMP "m2c_for_lo"
+#define UPPER_TEMP "m2c_for_hi"
+#define POINTER_TEMP "m2c_for_ptr"
+#define STOP_TEMP "m2c_for_stop"
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t enter_loop (m2c_astnode_t node, void *walk);
+
+static m2c_ast_visit_action_t leave_loop (m2c_astnode_t node, void *walk);
+
+static m2c_ast_visit_action_t scan_body (m2c_astnode_t node, void *scan);
+
+static bool is_shadowing_loop (body_scan_t *scan, m2c_astnode_t for_node);
+
+static bool is_proven_subscript
+  (body_scan_t *scan, m2c_astnode_t head, m2c_astnode_t tail);
+
+static bool same_ident (m2c_astnode_t ident1, m2c_astnode_t ident2);
+
+static bounds_entry_t *lookup_entry
+  (m2c_bounds_table_t table, m2c_astnode_t node);
+
+static bool store_entry (m2c_bounds_table_t table, bounds_entry_t entry);
+
+static void write_temp (outfile_t outfile, const char *name, uint_t depth);
+
+static void write_array_field
+  (outfile_t outfile, m2c_astnode_t array, const char *field,
+   m2c_for_node_writer_f writer, void *context);
+
+static void write_indent (outfile_t outfile, uint_t indent);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_bounds_table()
+ * --------------------------------------------------------------------------
+ * Returns a new empty bounds table,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_bounds_table_t m2c_new_bounds_table (void) {
+  
+  m2c_bounds_table_t table;
+  
+  table = malloc(sizeof(m2c_bounds_table_struct_t));
+  
+  if (table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  table->entry =
+    calloc(BOUNDS_TABLE_INITIAL_CAPACITY, sizeof(bounds_entry_t));
+  
+  if (table->entry == NULL) {
+    free(table);
+    return NULL;
+  } /* end if */
+  
+  table->count = 0;
+  table->capacity = BOUNDS_TABLE_INITIAL_CAPACITY;
+  
+  return table;
+} /* end m2c_new_bounds_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_prove_loop_bounds(table, root, is_array, context)
+ * --------------------------------------------------------------------------
+ * Enters the FOR loops over arrays within root and the subscripts within
+ * their bodies that are always in range into table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_prove_loop_bounds
+  (m2c_bounds_table_t table,                /* in */
+   m2c_astnode_t root,                      /* in */
+   m2c_array_predicate_f is_array,          /* in */
+   void *context) {                         /* in */
+  
+  loop_walk_t walk;
+  
+  if ((table == NULL) || (root == NULL) || (is_array == NULL)) {
+    return 0;
+  } /* end if */
+  
+  walk.table = table;
+  walk.is_array = is_array;
+  walk.context = context;
+  walk.depth = 0;
+  walk.proven_count = 0;
+  
+  m2c_ast_visit(root, enter_loop, leave_loop, &walk);
+  
+  return walk.proven_count;
+} /* end m2c_prove_loop_bounds */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bounds_loop_is_proven(table, for_node)
+ * --------------------------------------------------------------------------
+ * Returns true if FOR node for_node is entered in table,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_bounds_loop_is_proven
+  (m2c_bounds_table_t table, m2c_astnode_t for_node) {
+  
+  bounds_entry_t *entry;
+  
+  if ((table == NULL) || (for_node == NULL)) {
+    return false;
+  } /* end if */
+  
+  entry = lookup_entry(table, for_node);
+  
+  return (entry != NULL) && (entry->kind == ENTRY_LOOP);
+} /* end m2c_bounds_loop_is_proven */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bounds_subscript_is_proven(table, tail_node)
+ * --------------------------------------------------------------------------
+ * Returns true if SUBSCRTAIL node tail_node is entered in table.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_bounds_subscript_is_proven
+  (m2c_bounds_table_t table, m2c_astnode_t tail_node) {
+  
+  bounds_entry_t *entry;
+  
+  if ((table == NULL) || (tail_node == NULL)) {
+    return false;
+  } /* end if */
+  
+  entry = lookup_entry(table, tail_node);
+  
+  return (entry != NULL) && (entry->kind == ENTRY_SUBSCRIPT);
+} /* end m2c_bounds_subscript_is_proven */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_proven_loop_head(outfile, table, for_node, ...)
+ * --------------------------------------------------------------------------
+ * Writes the head of proven FOR loop for_node to outfile.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_proven_loop_head
+  (outfile_t outfile,                       /* in */
+   m2c_bounds_table_t table,                /* in */
+   m2c_astnode_t for_node,                  /* in */
+   intstr_t element_type,                   /* in */
+   m2c_for_node_writer_f writer,            /* in */
+   void *context) {                         /* in */
+  
+  m2c_astnode_t iter, accessor, value, array, range;
+  bounds_entry_t *entry;
+  uint_t depth;
+  bool ascending;
+  
+  if ((outfile == NULL) || (writer == NULL) || (element_type == NULL)) {
+    return;
+  } /* end if */
+  
+  entry = lookup_entry(table, for_node);
+  
+  if ((entry == NULL) || (entry->kind != ENTRY_LOOP)) {
+    return;
+  } /* end if */
+  
+  depth = entry->depth;
+  iter = m2c_ast_subnode_at_index(for_node, 0);
+  ascending = (m2c_ast_nodetype(iter) == AST_ASC);
+  accessor = m2c_ast_subnode_at_index(iter, 0);
+  value = m2c_ast_subnode_at_index(iter, 1);
+  array = m2c_ast_subnode_at_index(m2c_ast_subnode_at_index(iter, 2), 0);
+  range = m2c_ast_subnode_at_index(m2c_ast_subnode_at_index(iter, 2), 1);
+  
+  outfile_write_char(outfile, '{');
+  outfile_write_newline(outfile);
+  
+  /* index bounds,  those of a value range are evaluated once */
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "long long ");
+  write_temp(outfile, LOWER_TEMP, depth);
+  if (m2c_ast_nodetype(range) == AST_RANGE) {
+    outfile_write_chars(outfile, " = (");
+    writer(outfile, m2c_ast_subnode_at_index(range, 0), context);
+    outfile_write_chars(outfile, "), ");
+    write_temp(outfile, UPPER_TEMP, depth);
+    outfile_write_chars(outfile, " = (");
+    writer(outfile, m2c_ast_subnode_at_index(range, 1), context);
+    outfile_write_chars(outfile, ");");
+  }
+  else /* whole array */ {
+    outfile_write_chars(outfile, " = 0, ");
+    write_temp(outfile, UPPER_TEMP, depth);
+    outfile_write_chars(outfile, " = (long long) ");
+    write_array_field(outfile, array, "count", writer, context);
+    outfile_write_chars(outfile, " - 1;");
+  } /* end if */
+  outfile_write_newline(outfile);
+  
+  /* element pointer and stop pointer */
+  write_indent(outfile, 1);
+  outfile_write_string(outfile, element_type);
+  outfile_write_chars(outfile, " *");
+  write_temp(outfile, POINTER_TEMP, depth);
+  outfile_write_chars(outfile, " = ");
+  write_array_field(outfile, array, "value", writer, context);
+  outfile_write_chars(outfile, ", *");
+  write_temp(outfile, STOP_TEMP, depth);
+  outfile_write_chars(outfile, " = ");
+  write_array_field(outfile, array, "value", writer, context);
+  outfile_write_char(outfile, ';');
+  outfile_write_newline(outfile);
+  outfile_write_newline(outfile);
+  
+  /* if (lo <= hi) { check range once, position pointers } */
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "if (");
+  write_temp(outfile, LOWER_TEMP, depth);
+  outfile_write_chars(outfile, " <= ");
+  write_temp(outfile, UPPER_TEMP, depth);
+  outfile_write_chars(outfile, ") {");
+  outfile_write_newline(outfile);
+  
+  if (m2c_ast_nodetype(range) == AST_RANGE) {
+    write_indent(outfile, 2);
+    outfile_write_chars(outfile, "if ((");
+    write_temp(outfile, LOWER_TEMP, depth);
+    outfile_write_chars(outfile, " < 0) || (");
+    write_temp(outfile, UPPER_TEMP, depth);
+    outfile_write_chars(outfile, " >= (long long) ");
+    write_array_field(outfile, array, "count", writer, context);
+    outfile_write_chars(outfile, ")) {");
+    outfile_write_newline(outfile);
+    write_indent(outfile, 3);
+    outfile_write_chars(outfile, "M2C_INDEX_ERROR();");
+    outfile_write_newline(outfile);
+    write_indent(outfile, 2);
+    outfile_write_char(outfile, '}');
+    outfile_write_newline(outfile);
+  } /* end if */
+  
+  write_indent(outfile, 2);
+  write_temp(outfile, POINTER_TEMP, depth);
+  outfile_write_chars(outfile, " += ");
+  write_temp(outfile, (ascending ? LOWER_TEMP : UPPER_TEMP), depth);
+  outfile_write_chars(outfile, (ascending ? ";" : " + 1;"));
+  outfile_write_newline(outfile);
+  
+  write_indent(outfile, 2);
+  write_temp(outfile, STOP_TEMP, depth);
+  outfile_write_chars(outfile, " += ");
+  write_temp(outfile, (ascending ? UPPER_TEMP : LOWER_TEMP), depth);
+  outfile_write_chars(outfile, (ascending ? " + 1;" : ";"));
+  outfile_write_newline(outfile);
+  
+  write_indent(outfile, 1);
+  outfile_write_char(outfile, '}');
+  outfile_write_newline(outfile);
+  
+  /* the loop,  descending loops decrement on entry */
+  write_indent(outfile, 1);
+  if (ascending) {
+    outfile_write_chars(outfile, "for (; ");
+    write_temp(outfile, POINTER_TEMP, depth);
+    outfile_write_chars(outfile, " != ");
+    write_temp(outfile, STOP_TEMP, depth);
+    outfile_write_chars(outfile, "; ");
+    write_temp(outfile, POINTER_TEMP, depth);
+    outfile_write_chars(outfile, "++) {");
+    outfile_write_newline(outfile);
+  }
+  else /* descending */ {
+    outfile_write_chars(outfile, "while (");
+    write_temp(outfile, POINTER_TEMP, depth);
+    outfile_write_chars(outfile, " != ");
+    write_temp(outfile, STOP_TEMP, depth);
+    outfile_write_chars(outfile, ") {");
+    outfile_write_newline(outfile);
+    write_indent(outfile, 2);
+    write_temp(outfile, POINTER_TEMP, depth);
+    outfile_write_chars(outfile, "--;");
+    outfile_write_newline(outfile);
+  } /* end if */
+  
+  /* accessor,  if used other than in proven subscripts */
+  if (entry->accessor_used) {
+    write_indent(outfile, 2);
+    outfile_write_chars(outfile, "const size_t ");
+    writer(outfile, accessor, context);
+    outfile_write_chars(outfile, " = (size_t) (");
+    write_temp(outfile, POINTER_TEMP, depth);
+    outfile_write_chars(outfile, " - ");
+    write_array_field(outfile, array, "value", writer, context);
+    outfile_write_chars(outfile, ");");
+    outfile_write_newline(outfile);
+  } /* end if */
+  
+  /* value,  if any */
+  if (m2c_ast_nodetype(value) != AST_EMPTY) {
+    write_indent(outfile, 2);
+    outfile_write_chars(outfile, "const ");
+    outfile_write_string(outfile, element_type);
+    outfile_write_char(outfile, ' ');
+    writer(outfile, value, context);
+    outfile_write_chars(outfile, " = *");
+    write_temp(outfile, POINTER_TEMP, depth);
+    outfile_write_char(outfile, ';');
+    outfile_write_newline(outfile);
+  } /* end if */
+} /* end m2c_write_proven_loop_head */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_proven_loop_tail(outfile, table, for_node)
+ * --------------------------------------------------------------------------
+ * Writes the closing braces of the loop and block of proven loop for_node.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_proven_loop_tail
+  (outfile_t outfile, m2c_bounds_table_t table, m2c_astnode_t for_node) {
+  
+  if ((outfile == NULL) || NOT(m2c_bounds_loop_is_proven(table, for_node))) {
+    return;
+  } /* end if */
+  
+  write_indent(outfile, 1);
+  outfile_write_chars(outfile, "} /* end for */");
+  outfile_write_newline(outfile);
+  outfile_write_char(outfile, '}');
+  outfile_write_newline(outfile);
+} /* end m2c_write_proven_loop_tail */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_proven_subscript(outfile, table, tail_node)
+ * --------------------------------------------------------------------------
+ * Writes proven subscript tail_node as a dereference of the element pointer
+ * of the loop that proved it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_proven_subscript
+  (outfile_t outfile, m2c_bounds_table_t table, m2c_astnode_t tail_node) {
+  
+  bounds_entry_t *entry;
+  
+  if ((outfile == NULL) || (table == NULL) || (tail_node == NULL)) {
+    return;
+  } /* end if */
+  
+  entry = lookup_entry(table, tail_node);
+  
+  if ((entry == NULL) || (entry->kind != ENTRY_SUBSCRIPT)) {
+    return;
+  } /* end if */
+  
+  outfile_write_chars(outfile, "(*");
+  write_temp(outfile, POINTER_TEMP, entry->depth);
+  outfile_write_char(outfile, ')');
+} /* end m2c_write_proven_subscript */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_bounds_table(table)
+ * --------------------------------------------------------------------------
+ * Deallocates table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_bounds_table (m2c_bounds_table_t table) {
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  free(table->entry);
+  free(table);
+} /* end m2c_release_bounds_table */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function enter_loop(node, walk)
+ * --------------------------------------------------------------------------
+ * Pre-order visitor callback.  If node is a FOR loop over an array with an
+ * identifier as accessor,  enters the loop,  scans its body for subscripts
+ * of the array by the accessor  and enters them.
+ *
+ * astnodes:
+ *  (FOR (ASC accessorNode valueNode iterExprNode) statementSeqNode)
+ *  (ITEREXPR identNode rangeNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t enter_loop (m2c_astnode_t node, void *walk) {
+  
+  loop_walk_t *this_walk = (loop_walk_t *) walk;
+  m2c_astnode_t iter, accessor, iter_expr, array;
+  m2c_ast_nodetype_t array_type;
+  bounds_entry_t loop_entry, *entry;
+  body_scan_t scan;
+  
+  if (m2c_ast_nodetype(node) != AST_FOR) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  iter = m2c_ast_subnode_at_index(node, 0);
+  accessor = m2c_ast_subnode_at_index(iter, 0);
+  iter_expr = m2c_ast_subnode_at_index(iter, 2);
+  
+  if ((m2c_ast_nodetype(accessor) != AST_IDENT) ||
+      (m2c_ast_nodetype(iter_expr) != AST_ITEREXPR) ||
+      (m2c_ast_subnode_count(iter_expr) != 2)) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  array = m2c_ast_subnode_at_index(iter_expr, 0);
+  array_type = m2c_ast_nodetype(array);
+  
+  if (((array_type != AST_IDENT) && (array_type != AST_QUALIDENT)) ||
+      NOT(this_walk->is_array(array, this_walk->context))) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  loop_entry.node = node;
+  loop_entry.kind = ENTRY_LOOP;
+  loop_entry.depth = this_walk->depth;
+  loop_entry.accessor_used = true;
+  
+  if (NOT(store_entry(this_walk->table, loop_entry))) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  /* scan the body */
+  scan.table = this_walk->table;
+  scan.array = array;
+  scan.accessor = m2c_ast_value(accessor);
+  scan.depth = this_walk->depth;
+  scan.accessor_count = 0;
+  scan.proven_count = 0;
+  
+  m2c_ast_visit(m2c_ast_subnode_at_index(node, 1), scan_body, NULL, &scan);
+  
+  /* the table may have grown,  look the entry up again */
+  entry = lookup_entry(this_walk->table, node);
+  entry->accessor_used = (scan.accessor_count > scan.proven_count);
+  
+  this_walk->proven_count = this_walk->proven_count + scan.proven_count;
+  this_walk->depth++;
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end enter_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private function leave_loop(node, walk)
+ * --------------------------------------------------------------------------
+ * Post-order visitor callback.  Decrements the depth on leaving an entered
+ * FOR loop.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t leave_loop (m2c_astnode_t node, void *walk) {
+  
+  loop_walk_t *this_walk = (loop_walk_t *) walk;
+  
+  if ((m2c_ast_nodetype(node) == AST_FOR) &&
+      (m2c_bounds_loop_is_proven(this_walk->table, node))) {
+    this_walk->depth--;
+  } /* end if */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end leave_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private function scan_body(node, scan)
+ * --------------------------------------------------------------------------
+ * Pre-order visitor callback for the body of an entered FOR loop.  Enters
+ * subscripts of the array by the accessor and counts uses of the accessor.
+ * Nested loops that declare the accessor or the array again are skipped.
+ *
+ * astnodes:
+ *  (DESIG identNode (SUBSCRTAIL exprNode tailNode))
+ *  (SUBSCR identNode (SUBSCRTAIL exprNode tailNode))
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t scan_body (m2c_astnode_t node, void *scan) {
+  
+  body_scan_t *this_scan = (body_scan_t *) scan;
+  m2c_astnode_t tail;
+  bounds_entry_t entry;
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_FOR :
+      if (is_shadowing_loop(this_scan, node)) {
+        return M2C_AST_VISIT_SKIP;
+      } /* end if */
+      break;
+  
+    case AST_DESIG :
+    case AST_SUBSCR :
+      tail = m2c_ast_subnode_at_index(node, 1);
+  
+      if (is_proven_subscript(this_scan,
+            m2c_ast_subnode_at_index(node, 0), tail)) {
+        entry.node = tail;
+        entry.kind = ENTRY_SUBSCRIPT;
+        entry.depth = this_scan->depth;
+        entry.accessor_used = false;
+  
+        if (store_entry(this_scan->table, entry)) {
+          this_scan->proven_count++;
+        } /* end if */
+      } /* end if */
+      break;
+  
+    case AST_IDENT :
+      if (m2c_ast_value(node) == this_scan->accessor) {
+        this_scan->accessor_count++;
+      } /* end if */
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end scan_body */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_shadowing_loop(scan, for_node)
+ * --------------------------------------------------------------------------
+ * Returns true if the accessor or value of FOR node for_node has the name
+ * of the accessor or the array of scan,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_shadowing_loop (body_scan_t *scan, m2c_astnode_t for_node) {
+  
+  m2c_astnode_t iter, ident;
+  unsigned short index;
+  
+  iter = m2c_ast_subnode_at_index(for_node, 0);
+  
+  for (index = 0; index < 2; index++) {
+    ident = m2c_ast_subnode_at_index(iter, index);
+  
+    if (m2c_ast_nodetype(ident) == AST_IDENT) {
+      if ((m2c_ast_value(ident) == scan->accessor) ||
+          (same_ident(ident, scan->array))) {
+        return true;
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  return false;
+} /* end is_shadowing_loop */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_proven_subscript(scan, head, tail)
+ * --------------------------------------------------------------------------
+ * Returns true if head denotes the array of scan and tail is a subscript by
+ * the accessor of scan,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_proven_subscript
+  (body_scan_t *scan, m2c_astnode_t head, m2c_astnode_t tail) {
+  
+  m2c_astnode_t index;
+  
+  if ((m2c_ast_nodetype(tail) != AST_SUBSCRTAIL) ||
+      NOT(same_ident(head, scan->array))) {
+    return false;
+  } /* end if */
+  
+  index = m2c_ast_subnode_at_index(tail, 0);
+  
+  return (m2c_ast_nodetype(index) == AST_IDENT) &&
+    (m2c_ast_value(index) == scan->accessor);
+} /* end is_proven_subscript */
+
+
+/* --------------------------------------------------------------------------
+ * private function same_ident(ident1, ident2)
+ * --------------------------------------------------------------------------
+ * Returns true if IDENT or QUALIDENT nodes ident1 and ident2 denote the same
+ * identifier,  otherwise false.  Values are interned,  thus compared by
+ * reference.
+ * ----------------------------------------------------------------------- */
+
+static bool same_ident (m2c_astnode_t ident1, m2c_astnode_t ident2) {
+  
+  unsigned short index, count;
+  m2c_ast_nodetype_t node_type;
+  
+  if ((ident1 == NULL) || (ident2 == NULL)) {
+    return false;
+  } /* end if */
+  
+  node_type = m2c_ast_nodetype(ident1);
+  
+  if (((node_type != AST_IDENT) && (node_type != AST_QUALIDENT)) ||
+      (node_type != m2c_ast_nodetype(ident2))) {
+    return false;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(ident1);
+  
+  if (count != m2c_ast_subnode_count(ident2)) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    if (m2c_ast_value_at_index(ident1, index) !=
+        m2c_ast_value_at_index(ident2, index)) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end same_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private macro NODE_HASH(node)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for the address of node.
+ * ----------------------------------------------------------------------- */
+
+#define NODE_HASH(_node) \
+  ((uint_t) ((((uintptr_t) (_node)) >> 3) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_entry(table, node)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the entry of node in table,  or NULL if node is not
+ * entered.  The pointer is valid until the next entry is stored.
+ * ----------------------------------------------------------------------- */
+
+static bounds_entry_t *lookup_entry
+  (m2c_bounds_table_t table, m2c_astnode_t node) {
+  
+  uint_t mask, index;
+  
+  if (table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  index = NODE_HASH(node) & mask;
+  
+  while (table->entry[index].node != NULL) {
+    if (table->entry[index].node == node) {
+      return &table->entry[index];
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end lookup_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function store_entry(table, entry)
+ * --------------------------------------------------------------------------
+ * Enters entry into table.  The table is doubled when it becomes three
+ * quarters full.  Returns false if it could not be enlarged,  else true.
+ * ----------------------------------------------------------------------- */
+
+static bool store_entry (m2c_bounds_table_t table, bounds_entry_t entry) {
+  
+  uint_t mask, index, new_capacity, slot;
+  bounds_entry_t *new_entry;
+  
+  if ((4 * (table->count + 1)) > (3 * table->capacity)) {
+    new_capacity = 2 * table->capacity;
+    new_entry = calloc(new_capacity, sizeof(bounds_entry_t));
+  
+    if (new_entry == NULL) {
+      return false;
+    } /* end if */
+  
+    mask = new_capacity - 1;
+    for (index = 0; index < table->capacity; index++) {
+      if (table->entry[index].node != NULL) {
+        slot = NODE_HASH(table->entry[index].node) & mask;
+  
+        while (new_entry[slot].node != NULL) {
+          slot = (slot + 1) & mask;
+        } /* end while */
+  
+        new_entry[slot] = table->entry[index];
+      } /* end if */
+    } /* end for */
+  
+    free(table->entry);
+    table->entry = new_entry;
+    table->capacity = new_capacity;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  index = NODE_HASH(entry.node) & mask;
+  
+  while (table->entry[index].node != NULL) {
+    if (table->entry[index].node == entry.node) {
+      table->entry[index] = entry;
+      return true;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  table->entry[index] = entry;
+  table->count++;
+  
+  return true;
+} /* end store_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_temp(outfile, name, depth)
+ * --------------------------------------------------------------------------
+ * Writes the name of a temporary suffixed by the loop depth to outfile.
+ * ----------------------------------------------------------------------- */
+
+#define DEPTH_BUFFER_SIZE 12
+
+static void write_temp (outfile_t outfile, const char *name, uint_t depth) {
+  
+  char buffer[DEPTH_BUFFER_SIZE];
+  
+  snprintf(buffer, DEPTH_BUFFER_SIZE, "%u", (unsigned) depth);
+  outfile_write_chars(outfile, name);
+  outfile_write_chars(outfile, buffer);
+} /* end write_temp */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_array_field(outfile, array, field, writer, ...)
+ * --------------------------------------------------------------------------
+ * Writes the selection of field of array,  see template array.
+ * ----------------------------------------------------------------------- */
+
+static void write_array_field
+  (outfile_t outfile, m2c_astnode_t array, const char *field,
+   m2c_for_node_writer_f writer, void *context) {
+  
+  outfile_write_char(outfile, '(');
+  writer(outfile, array, context);
+  outfile_write_chars(outfile, ").");
+  outfile_write_chars(outfile, field);
+} /* end write_array_field */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_indent(outfile, indent)
+ * --------------------------------------------------------------------------
+ * Writes indent levels of indentation of two spaces each.
+ * ----------------------------------------------------------------------- */
+
+static void write_indent (outfile_t outfile, uint_t indent) {
+  
+  while (indent > 0) {
+    outfile_write_chars(outfile, "  ");
+    indent--;
+  } /* end while */
+} /* end write_indent */
+
+/* END OF FILE */
@@ -0,0 +1,325 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-ident-class.c                                                         *
+ *                                                                           *
+ * Implementation of identifier classification by perfect hash lookup.       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-ident-class.h"
+#include "hash.h"
+
+#include <stddef.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * generated perfect hash table
+ * --------------------------------------------------------------------------
+ * The table is generated by utility gen-ident-hash from its ident-data.h
+ * and must be regenerated if the data, the enumerations or hash.h change.
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-ident-hash-table.h"
+
+
+/* --------------------------------------------------------------------------
+ * hash parameters, must match utilities/gen-ident-hash/gen-ident-hash.c
+ * ----------------------------------------------------------------------- */
+
+#define IDENT_HASH_MIX(_key, _seed) \
+  ((uint32_t)(((_key) ^ (_seed)) * 0x9E3779B1u))
+
+#define IDENT_HASH_SLOT(_mixed, _disp, _bits) \
+  ((uint32_t)((((_mixed) ^ (_disp)) * 0x85EBCA6Bu)) >> (32 - (_bits)))
+
+#define IDENT_MAX_LENGTH 14
+
+
+/* --------------------------------------------------------------------------
+ * Tags of classified lexemes
+ * --------------------------------------------------------------------------
+ * The tag of a classified lexeme is its slot index in the hash table plus
+ * one,  that of any other lexeme is INTSTR_TAG_NONE.
+ * ----------------------------------------------------------------------- */
+
+#define TAG_FOR_SLOT(_slot) ((uint_t) (_slot) + 1)
+
+#define SLOT_FOR_TAG(_tag) ((_tag) - 1)
+
+
+static uint_t tag_for_chars (const char *str, uint_t length);
+
+static intstr_t static_lexeme
+  (const char *str, uint_t length, intstr_hash_t key);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ident_class_init()
+ * --------------------------------------------------------------------------
+ * Installs the identifier classifier  as tag handler  of the interned string
+ * repository so that every lexeme is classified once when it is interned,
+ * and the static lexeme table as its static resolver.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ident_class_init (void) {
+  
+  intstr_install_tag_handler(tag_for_chars);
+  intstr_install_static_resolver(static_lexeme);
+} /* end m2c_ident_class_init */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_info_for_lexeme(lexeme)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the entry for lexeme in the generated perfect hash
+ * table,  or NULL if lexeme is not found.  The entry is located by the tag
+ * of lexeme,  or by hash lookup if no classifier is installed.
+ * ----------------------------------------------------------------------- */
+
+const m2c_ident_info_t *m2c_ident_info_for_lexeme (intstr_t lexeme) {
+  uint_t tag;
+  
+  if (lexeme == NULL) {
+    return NULL;
+  } /* end if */
+  
+  tag = intstr_tag(lexeme);
+  
+  if (tag == INTSTR_TAG_UNKNOWN) {
+    tag = tag_for_chars(intstr_char_ptr(lexeme), intstr_length(lexeme));
+  } /* end if */
+  
+  if (tag == INTSTR_TAG_NONE) {
+    return NULL;
+  } /* end if */
+  
+  return &ident_hash_table[SLOT_FOR_TAG(tag)];
+} /* end m2c_ident_info_for_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_info_for_slice(str, length)
+ * --------------------------------------------------------------------------
+ * Looks up  the length  characters at str  in the  generated  perfect hash
+ * table.  Returns a pointer to the entry for the characters,  or NULL if
+ * they do not match a reserved word or classified identifier.
+ * ----------------------------------------------------------------------- */
+
+const m2c_ident_info_t *m2c_ident_info_for_slice
+  (const char *str, uint_t length) {
+  uint_t tag;
+  
+  tag = tag_for_chars(str, length);
+  
+  if (tag == INTSTR_TAG_NONE) {
+    return NULL;
+  } /* end if */
+  
+  return &ident_hash_table[SLOT_FOR_TAG(tag)];
+} /* end m2c_ident_info_for_slice */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_lexeme_for_resword(token)
+ * --------------------------------------------------------------------------
+ * Returns the static interned lexeme of the reserved word represented by
+ * token,  or NULL if token does not represent a reserved word.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ident_lexeme_for_resword (m2c_token_t token) {
+  uint_t tag;
+  
+  if (NOT(M2C_IS_RESWORD_TOKEN(token))) {
+    return NULL;
+  } /* end if */
+  
+  tag = ident_resword_tag[token];
+  
+  if (tag == INTSTR_TAG_NONE) {
+    return NULL;
+  } /* end if */
+  
+  return INTSTR_FOR_STATIC(&ident_lexeme_table[SLOT_FOR_TAG(tag)]);
+} /* end m2c_ident_lexeme_for_resword */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_lexeme_for_predef(value)
+ * --------------------------------------------------------------------------
+ * Returns the static interned lexeme of the predefined identifier represented
+ * by value,  or the empty string if value is invalid.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ident_lexeme_for_predef (m2c_predef_t value) {
+  uint_t tag;
+  
+  if (NOT(M2C_IS_VALID_PREDEF(value))) {
+    return INTSTR_FOR_STATIC(&ident_empty_lexeme);
+  } /* end if */
+  
+  tag = ident_predef_tag[value];
+  
+  if (tag == INTSTR_TAG_NONE) {
+    return INTSTR_FOR_STATIC(&ident_empty_lexeme);
+  } /* end if */
+  
+  return INTSTR_FOR_STATIC(&ident_lexeme_table[SLOT_FOR_TAG(tag)]);
+} /* end m2c_ident_lexeme_for_predef */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_lexeme_for_bindable(value)
+ * --------------------------------------------------------------------------
+ * Returns the static interned lexeme of the bindable identifier represented
+ * by value,  or the empty string if value is invalid.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ident_lexeme_for_bindable (m2c_bindable_t value) {
+  uint_t tag;
+  
+  if (NOT(M2C_IS_VALID_BINDABLE(value))) {
+    return INTSTR_FOR_STATIC(&ident_empty_lexeme);
+  } /* end if */
+  
+  tag = ident_bindable_tag[value];
+  
+  if (tag == INTSTR_TAG_NONE) {
+    return INTSTR_FOR_STATIC(&ident_empty_lexeme);
+  } /* end if */
+  
+  return INTSTR_FOR_STATIC(&ident_lexeme_table[SLOT_FOR_TAG(tag)]);
+} /* end m2c_ident_lexeme_for_bindable */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function tag_for_chars(str, length)
+ * --------------------------------------------------------------------------
+ * Looks up the length characters at str in the generated perfect hash table
+ * using one hash probe and one compare.  Returns the tag for the matching
+ * slot, or INTSTR_TAG_NONE if the characters do not match any entry.
+ * ----------------------------------------------------------------------- */
+
+static uint_t tag_for_key
+  (const char *str, uint_t length, intstr_hash_t key);
+
+static uint_t tag_for_chars (const char *str, uint_t length) {
+  uint_t index;
+  uint32_t key;
+  
+  if ((str == NULL) || (length < 2) || (length > IDENT_MAX_LENGTH)) {
+    return INTSTR_TAG_NONE;
+  } /* end if */
+  
+  key = HASH_INITIAL;
+  for (index = 0; index < length; index++) {
+    key = HASH_NEXT_CHAR(key, (uint32_t) str[index]);
+  } /* end for */
+  key = HASH_FINAL(key);
+  
+  return tag_for_key(str, length, key);
+} /* end tag_for_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private function tag_for_key(str, length, key)
+ * --------------------------------------------------------------------------
+ * Like tag_for_chars but uses the hash key of the characters calculated by
+ * the caller.  The length must be within range.
+ * ----------------------------------------------------------------------- */
+
+static uint_t tag_for_key
+  (const char *str, uint_t length, intstr_hash_t key) {
+  
+  uint32_t mixed, slot;
+  const m2c_ident_info_t *entry;
+  
+  /* one probe */
+  mixed = IDENT_HASH_MIX(key, IDENT_HASH_SEED);
+  slot = IDENT_HASH_SLOT(mixed,
+    ident_hash_displacement[mixed >> (32 - IDENT_HASH_BUCKET_BITS)],
+    IDENT_HASH_SLOT_BITS);
+  
+  entry = &ident_hash_table[slot];
+  
+  /* one compare */
+  if ((entry->length == length) &&
+      (memcmp(entry->lexstr, str, length) == 0)) {
+    return TAG_FOR_SLOT(slot);
+  } /* end if */
+  
+  return INTSTR_TAG_NONE;
+} /* end tag_for_key */
+
+
+/* --------------------------------------------------------------------------
+ * private function static_lexeme(str, length, key)
+ * --------------------------------------------------------------------------
+ * Static resolver of the interned string repository.  Returns the static
+ * interned lexeme for the length characters at str with hash key key,  the
+ * static empty string if length is zero,  or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t static_lexeme
+  (const char *str, uint_t length, intstr_hash_t key) {
+  
+  uint_t tag;
+  
+  if (length == 0) {
+    return INTSTR_FOR_STATIC(&ident_empty_lexeme);
+  } /* end if */
+  
+  if ((length < 2) || (length > IDENT_MAX_LENGTH)) {
+    return NULL;
+  } /* end if */
+  
+  tag = tag_for_key(str, length, key);
+  
+  if (tag == INTSTR_TAG_NONE) {
+    return NULL;
+  } /* end if */
+  
+  return INTSTR_FOR_STATIC(&ident_lexeme_table[SLOT_FOR_TAG(tag)]);
+} /* end static_lexeme */
+
+
+/* END OF FILE */
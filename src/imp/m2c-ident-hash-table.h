@@ -0,0 +1,554 @@
+/* AUTO-GENERATED by utility gen-ident-hash * DO NOT EDIT! */
+
+#define IDENT_HASH_ENTRY_COUNT 113
+#define IDENT_HASH_SEED 0x5BD1E995u
+#define IDENT_HASH_BUCKET_BITS 6
+#define IDENT_HASH_SLOT_BITS 7
+
+static const uint16_t ident_hash_displacement[] = {
+  0x0002, 0x0003, 0x000B, 0x0000, 0x0002, 0x0000, 0x0000, 0x0000,
+  0x000A, 0x0001, 0x0005, 0x0000, 0x0002, 0x0000, 0x0000, 0x0004,
+  0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0002, 0x0000,
+  0x0008, 0x0007, 0x0001, 0x0002, 0x0005, 0x0000, 0x000A, 0x0003,
+  0x0002, 0x000C, 0x000B, 0x0013, 0x0002, 0x0002, 0x001B, 0x0000,
+  0x0000, 0x0002, 0x0000, 0x0000, 0x0005, 0x0000, 0x000E, 0x0005,
+  0x0006, 0x001C, 0x0008, 0x0001, 0x0001, 0x0002, 0x0004, 0x0000
+}; /* ident_hash_displacement */
+
+static const m2c_ident_info_t ident_hash_table[] = {
+  /*   0 */ { "FALSE", 5, 0x02, TOKEN_UNKNOWN,
+              PREDEF_FALSE, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   1 */ { "ELSIF", 5, 0x01, TOKEN_ELSIF,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   2 */ { "SETREG", 6, 0x02, TOKEN_UNKNOWN,
+              PREDEF_SETREG, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   3 */ { "MODULE", 6, 0x01, TOKEN_MODULE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   4 */ { "MOD", 3, 0x01, TOKEN_MOD,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   5 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   6 */ { "LAST", 4, 0x06, TOKEN_UNKNOWN,
+              PREDEF_LAST, BINDABLE_LAST, SCHROED_INVALID },
+  /*   7 */ { "IF", 2, 0x01, TOKEN_IF,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   8 */ { "BYTE", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_BYTE, BINDABLE_INVALID, SCHROED_INVALID },
+  /*   9 */ { "DIV", 3, 0x01, TOKEN_DIV,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  10 */ { "ABS", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ABS, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  11 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  12 */ { "WHILE", 5, 0x01, TOKEN_WHILE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  13 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  14 */ { "MIN", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_MIN, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  15 */ { "AND", 3, 0x01, TOKEN_AND,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  16 */ { "POW2", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_POW2, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  17 */ { "IMPORT", 6, 0x01, TOKEN_IMPORT,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  18 */ { "REAL", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_REAL, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  19 */ { "SUCC", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_SUCC, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  20 */ { "UNSAFE", 6, 0x02, TOKEN_UNKNOWN,
+              PREDEF_UNSAFE, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  21 */ { "OCTET", 5, 0x02, TOKEN_UNKNOWN,
+              PREDEF_OCTET, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  22 */ { "APPEND", 6, 0x06, TOKEN_UNKNOWN,
+              PREDEF_APPEND, BINDABLE_APPEND, SCHROED_INVALID },
+  /*  23 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  24 */ { "ODD", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ODD, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  25 */ { "INTEGER", 7, 0x02, TOKEN_UNKNOWN,
+              PREDEF_INTEGER, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  26 */ { "STORE", 5, 0x06, TOKEN_UNKNOWN,
+              PREDEF_STORE, BINDABLE_STORE, SCHROED_INVALID },
+  /*  27 */ { "REMOVE", 6, 0x06, TOKEN_UNKNOWN,
+              PREDEF_REMOVE, BINDABLE_REMOVE, SCHROED_INVALID },
+  /*  28 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  29 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  30 */ { "CAST", 4, 0x0A, TOKEN_UNKNOWN,
+              PREDEF_CAST, BINDABLE_INVALID, SCHROED_CAST },
+  /*  31 */ { "INSERT", 6, 0x02, TOKEN_UNKNOWN,
+              PREDEF_INSERT, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  32 */ { "LENGTH", 6, 0x06, TOKEN_UNKNOWN,
+              PREDEF_LENGTH, BINDABLE_LENGTH, SCHROED_INVALID },
+  /*  33 */ { "OPAQUE", 6, 0x01, TOKEN_OPAQUE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  34 */ { "OF", 2, 0x01, TOKEN_OF,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  35 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  36 */ { "NEW", 3, 0x01, TOKEN_NEW,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  37 */ { "ALIAS", 5, 0x01, TOKEN_ALIAS,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  38 */ { "UCHR", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_UCHR, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  39 */ { "WRITE", 5, 0x01, TOKEN_WRITE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  40 */ { "UNICHAR", 7, 0x02, TOKEN_UNKNOWN,
+              PREDEF_UNICHAR, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  41 */ { "REGISTER", 8, 0x02, TOKEN_UNKNOWN,
+              PREDEF_REGISTER, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  42 */ { "TRUE", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_TRUE, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  43 */ { "NOP", 3, 0x01, TOKEN_NOP,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  44 */ { "VAR", 3, 0x01, TOKEN_VAR,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  45 */ { "ALLOC", 5, 0x06, TOKEN_UNKNOWN,
+              PREDEF_ALLOC, BINDABLE_ALLOC, SCHROED_INVALID },
+  /*  46 */ { "NIL", 3, 0x0A, TOKEN_UNKNOWN,
+              PREDEF_NIL, BINDABLE_INVALID, SCHROED_NIL },
+  /*  47 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  48 */ { "NEXT", 4, 0x06, TOKEN_UNKNOWN,
+              PREDEF_NEXT, BINDABLE_NEXT, SCHROED_INVALID },
+  /*  49 */ { "WORD", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_WORD, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  50 */ { "ARGLIST", 7, 0x01, TOKEN_ARGLIST,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  51 */ { "LOOP", 4, 0x01, TOKEN_LOOP,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  52 */ { "ADDRESS", 7, 0x0A, TOKEN_UNKNOWN,
+              PREDEF_ADDRESS, BINDABLE_INVALID, SCHROED_ADDRESS },
+  /*  53 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  54 */ { "SET", 3, 0x01, TOKEN_SET,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  55 */ { "CONST", 5, 0x01, TOKEN_CONST,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  56 */ { "CASE", 4, 0x01, TOKEN_CASE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  57 */ { "REPEAT", 6, 0x01, TOKEN_REPEAT,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  58 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  59 */ { "CARDINAL", 8, 0x02, TOKEN_UNKNOWN,
+              PREDEF_CARDINAL, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  60 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  61 */ { "DO", 2, 0x01, TOKEN_DO,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  62 */ { "RELEASE", 7, 0x01, TOKEN_RELEASE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  63 */ { "UNTIL", 5, 0x01, TOKEN_UNTIL,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  64 */ { "DEALLOC", 7, 0x06, TOKEN_UNKNOWN,
+              PREDEF_DEALLOC, BINDABLE_DEALLOC, SCHROED_INVALID },
+  /*  65 */ { "LONGINT", 7, 0x02, TOKEN_UNKNOWN,
+              PREDEF_LONGINT, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  66 */ { "STDOUT", 6, 0x06, TOKEN_UNKNOWN,
+              PREDEF_STDOUT, BINDABLE_STDOUT, SCHROED_INVALID },
+  /*  67 */ { "STDIN", 5, 0x06, TOKEN_UNKNOWN,
+              PREDEF_STDIN, BINDABLE_STDIN, SCHROED_INVALID },
+  /*  68 */ { "ASSEMBLER", 9, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ASSEMBLER, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  69 */ { "TLIMIT", 6, 0x06, TOKEN_UNKNOWN,
+              PREDEF_TLIMIT, BINDABLE_TLIMIT, SCHROED_INVALID },
+  /*  70 */ { "PROCEDURE", 9, 0x01, TOKEN_PROCEDURE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  71 */ { "ARCH", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ARCH, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  72 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  73 */ { "CAPACITY", 8, 0x0A, TOKEN_UNKNOWN,
+              PREDEF_CAPACITY, BINDABLE_INVALID, SCHROED_CAPACITY },
+  /*  74 */ { "LONGWORD", 8, 0x02, TOKEN_UNKNOWN,
+              PREDEF_LONGWORD, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  75 */ { "READ", 4, 0x01, TOKEN_READ,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  76 */ { "UNQUALIFIED", 11, 0x01, TOKEN_UNQUALIFIED,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  77 */ { "SGN", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_SGN, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  78 */ { "MAX", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_MAX, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  79 */ { "EXIT", 4, 0x01, TOKEN_EXIT,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  80 */ { "POINTER", 7, 0x01, TOKEN_POINTER,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  81 */ { "LONGREAL", 8, 0x02, TOKEN_UNKNOWN,
+              PREDEF_LONGREAL, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  82 */ { "COUNT", 5, 0x06, TOKEN_UNKNOWN,
+              PREDEF_COUNT, BINDABLE_COUNT, SCHROED_INVALID },
+  /*  83 */ { "ATSTORE", 7, 0x06, TOKEN_UNKNOWN,
+              PREDEF_ATSTORE, BINDABLE_ATSTORE, SCHROED_INVALID },
+  /*  84 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  85 */ { "TYPE", 4, 0x01, TOKEN_TYPE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  86 */ { "ATVALUE", 7, 0x06, TOKEN_UNKNOWN,
+              PREDEF_ATVALUE, BINDABLE_ATVALUE, SCHROED_INVALID },
+  /*  87 */ { "THEN", 4, 0x01, TOKEN_THEN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  88 */ { "RETAIN", 6, 0x01, TOKEN_RETAIN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  89 */ { "END", 3, 0x01, TOKEN_END,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  90 */ { "PREV", 4, 0x06, TOKEN_UNKNOWN,
+              PREDEF_PREV, BINDABLE_PREV, SCHROED_INVALID },
+  /*  91 */ { "HALT", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_HALT, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  92 */ { "LOG2", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_LOG2, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  93 */ { "VALUE", 5, 0x06, TOKEN_UNKNOWN,
+              PREDEF_VALUE, BINDABLE_VALUE, SCHROED_INVALID },
+  /*  94 */ { "BEGIN", 5, 0x01, TOKEN_BEGIN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  95 */ { "INTERFACE", 9, 0x01, TOKEN_INTERFACE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  96 */ { "GETREG", 6, 0x02, TOKEN_UNKNOWN,
+              PREDEF_GETREG, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  97 */ { "FIRST", 5, 0x06, TOKEN_UNKNOWN,
+              PREDEF_FIRST, BINDABLE_FIRST, SCHROED_INVALID },
+  /*  98 */ { "BOOLEAN", 7, 0x02, TOKEN_UNKNOWN,
+              PREDEF_BOOLEAN, BINDABLE_INVALID, SCHROED_INVALID },
+  /*  99 */ { "RETURN", 6, 0x01, TOKEN_RETURN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 100 */ { "RECORD", 6, 0x01, TOKEN_RECORD,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 101 */ { "CHAR", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_CHAR, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 102 */ { "ARRAY", 5, 0x01, TOKEN_ARRAY,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 103 */ { "NOT", 3, 0x01, TOKEN_NOT,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 104 */ { "IN", 2, 0x01, TOKEN_IN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 105 */ { "COLLATION", 9, 0x06, TOKEN_UNKNOWN,
+              PREDEF_COLLATION, BINDABLE_COLLATION, SCHROED_INVALID },
+  /* 106 */ { "ATINSERT", 8, 0x06, TOKEN_UNKNOWN,
+              PREDEF_ATINSERT, BINDABLE_ATINSERT, SCHROED_INVALID },
+  /* 107 */ { "TSIZE", 5, 0x02, TOKEN_UNKNOWN,
+              PREDEF_TSIZE, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 108 */ { "ATOMIC", 6, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ATOMIC, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 109 */ { "TMIN", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_TMIN, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 110 */ { "OR", 2, 0x01, TOKEN_OR,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 111 */ { "ENTIER", 6, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ENTIER, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 112 */ { "CODE", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_CODE, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 113 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 114 */ { "FOR", 3, 0x01, TOKEN_FOR,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 115 */ { "PTR", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_PTR, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 116 */ { "IMPLEMENTATION", 14, 0x01, TOKEN_IMPLEMENTATION,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 117 */ { "OCTETSEQ", 8, 0x01, TOKEN_OCTETSEQ,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 118 */ { "PRED", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_PRED, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 119 */ { "TO", 2, 0x01, TOKEN_TO,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 120 */ { "ORD", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_ORD, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 121 */ { "ELSE", 4, 0x01, TOKEN_ELSE,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 122 */ { "ATREMOVE", 8, 0x06, TOKEN_UNKNOWN,
+              PREDEF_ATREMOVE, BINDABLE_ATREMOVE, SCHROED_INVALID },
+  /* 123 */ { "CHR", 3, 0x02, TOKEN_UNKNOWN,
+              PREDEF_CHR, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 124 */ { "TMAX", 4, 0x02, TOKEN_UNKNOWN,
+              PREDEF_TMAX, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 125 */ { NULL, 0, 0x00, TOKEN_UNKNOWN,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 126 */ { "LONGCARD", 8, 0x02, TOKEN_UNKNOWN,
+              PREDEF_LONGCARD, BINDABLE_INVALID, SCHROED_INVALID },
+  /* 127 */ { "COPY", 4, 0x01, TOKEN_COPY,
+              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID }
+}; /* ident_hash_table */
+
+static intstr_static_t ident_lexeme_table[] = {
+  /*   0 */ INTSTR_STATIC_INIT(0x089CA9C3u, 5, 1, "FALSE"),
+  /*   1 */ INTSTR_STATIC_INIT(0x47E3AD09u, 5, 2, "ELSIF"),
+  /*   2 */ INTSTR_STATIC_INIT(0x6BFBA9F2u, 6, 3, "SETREG"),
+  /*   3 */ INTSTR_STATIC_INIT(0x27413CCCu, 6, 4, "MODULE"),
+  /*   4 */ INTSTR_STATIC_INIT(0x2639BD82u, 3, 5, "MOD"),
+  /*   5 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*   6 */ INTSTR_STATIC_INIT(0x705AFD36u, 4, 7, "LAST"),
+  /*   7 */ INTSTR_STATIC_INIT(0x0049123Du, 2, 8, "IF"),
+  /*   8 */ INTSTR_STATIC_INIT(0x2AE94A08u, 4, 9, "BYTE"),
+  /*   9 */ INTSTR_STATIC_INIT(0x21C53091u, 3, 10, "DIV"),
+  /*  10 */ INTSTR_STATIC_INIT(0x20440052u, 3, 11, "ABS"),
+  /*  11 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  12 */ INTSTR_STATIC_INIT(0x4F7D7DD1u, 5, 13, "WHILE"),
+  /*  13 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  14 */ INTSTR_STATIC_INIT(0x2633BC12u, 3, 15, "MIN"),
+  /*  15 */ INTSTR_STATIC_INIT(0x20500337u, 3, 16, "AND"),
+  /*  16 */ INTSTR_STATIC_INIT(0x315F1A1Au, 4, 17, "POW2"),
+  /*  17 */ INTSTR_STATIC_INIT(0x721A6745u, 6, 18, "IMPORT"),
+  /*  18 */ INTSTR_STATIC_INIT(0x096A1B3Eu, 4, 19, "REAL"),
+  /*  19 */ INTSTR_STATIC_INIT(0x3FD3E482u, 4, 20, "SUCC"),
+  /*  20 */ INTSTR_STATIC_INIT(0x44BEEB66u, 6, 21, "UNSAFE"),
+  /*  21 */ INTSTR_STATIC_INIT(0x4CDC1AEFu, 5, 22, "OCTET"),
+  /*  22 */ INTSTR_STATIC_INIT(0x078BDE3Au, 6, 23, "APPEND"),
+  /*  23 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  24 */ INTSTR_STATIC_INIT(0x272AD9CFu, 3, 25, "ODD"),
+  /*  25 */ INTSTR_STATIC_INIT(0x4AE471DEu, 7, 26, "INTEGER"),
+  /*  26 */ INTSTR_STATIC_INIT(0x71182941u, 5, 27, "STORE"),
+  /*  27 */ INTSTR_STATIC_INIT(0x0EB66924u, 6, 28, "REMOVE"),
+  /*  28 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  29 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  30 */ INTSTR_STATIC_INIT(0x4D9DA67Fu, 4, 31, "CAST"),
+  /*  31 */ INTSTR_STATIC_INIT(0x3CAE9D79u, 6, 32, "INSERT"),
+  /*  32 */ INTSTR_STATIC_INIT(0x344075E6u, 6, 33, "LENGTH"),
+  /*  33 */ INTSTR_STATIC_INIT(0x0A02B041u, 6, 34, "OPAQUE"),
+  /*  34 */ INTSTR_STATIC_INIT(0x004F13B7u, 2, 35, "OF"),
+  /*  35 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  36 */ INTSTR_STATIC_INIT(0x26ADCAA0u, 3, 37, "NEW"),
+  /*  37 */ INTSTR_STATIC_INIT(0x333D9410u, 5, 38, "ALIAS"),
+  /*  38 */ INTSTR_STATIC_INIT(0x14097038u, 4, 39, "UCHR"),
+  /*  39 */ INTSTR_STATIC_INIT(0x20C9A73Fu, 5, 40, "WRITE"),
+  /*  40 */ INTSTR_STATIC_INIT(0x0D2BF7E6u, 7, 41, "UNICHAR"),
+  /*  41 */ INTSTR_STATIC_INIT(0x394B1D43u, 8, 42, "REGISTER"),
+  /*  42 */ INTSTR_STATIC_INIT(0x6CF28B2Eu, 4, 43, "TRUE"),
+  /*  43 */ INTSTR_STATIC_INIT(0x26B7CD0Fu, 3, 44, "NOP"),
+  /*  44 */ INTSTR_STATIC_INIT(0x2A9A45A7u, 3, 45, "VAR"),
+  /*  45 */ INTSTR_STATIC_INIT(0x34C5C5F5u, 5, 46, "ALLOC"),
+  /*  46 */ INTSTR_STATIC_INIT(0x26B1CB91u, 3, 47, "NIL"),
+  /*  47 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  48 */ INTSTR_STATIC_INIT(0x4F65DDF3u, 4, 49, "NEXT"),
+  /*  49 */ INTSTR_STATIC_INIT(0x7709CE2Au, 4, 50, "WORD"),
+  /*  50 */ INTSTR_STATIC_INIT(0x45F78774u, 7, 51, "ARGLIST"),
+  /*  51 */ INTSTR_STATIC_INIT(0x773BD544u, 4, 52, "LOOP"),
+  /*  52 */ INTSTR_STATIC_INIT(0x58F5BF74u, 7, 53, "ADDRESS"),
+  /*  53 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  54 */ INTSTR_STATIC_INIT(0x29241822u, 3, 55, "SET"),
+  /*  55 */ INTSTR_STATIC_INIT(0x49331643u, 5, 56, "CONST"),
+  /*  56 */ INTSTR_STATIC_INIT(0x4D9DA670u, 4, 57, "CASE"),
+  /*  57 */ INTSTR_STATIC_INIT(0x15493B3Bu, 6, 58, "REPEAT"),
+  /*  58 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  59 */ INTSTR_STATIC_INIT(0x1EA3C640u, 8, 60, "CARDINAL"),
+  /*  60 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  61 */ INTSTR_STATIC_INIT(0x0044110Bu, 2, 62, "DO"),
+  /*  62 */ INTSTR_STATIC_INIT(0x688E1787u, 7, 63, "RELEASE"),
+  /*  63 */ INTSTR_STATIC_INIT(0x64354E1Eu, 5, 64, "UNTIL"),
+  /*  64 */ INTSTR_STATIC_INIT(0x12235634u, 7, 65, "DEALLOC"),
+  /*  65 */ INTSTR_STATIC_INIT(0x2A1A2753u, 7, 66, "LONGINT"),
+  /*  66 */ INTSTR_STATIC_INIT(0x7CFE048Bu, 6, 67, "STDOUT"),
+  /*  67 */ INTSTR_STATIC_INIT(0x6BA47C88u, 5, 68, "STDIN"),
+  /*  68 */ INTSTR_STATIC_INIT(0x74B37920u, 9, 69, "ASSEMBLER"),
+  /*  69 */ INTSTR_STATIC_INIT(0x5B615F87u, 6, 70, "TLIMIT"),
+  /*  70 */ INTSTR_STATIC_INIT(0x6D45A513u, 9, 71, "PROCEDURE"),
+  /*  71 */ INTSTR_STATIC_INIT(0x78DF0896u, 4, 72, "ARCH"),
+  /*  72 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  73 */ INTSTR_STATIC_INIT(0x0CF9B97Au, 8, 74, "CAPACITY"),
+  /*  74 */ INTSTR_STATIC_INIT(0x0F9E2726u, 8, 75, "LONGWORD"),
+  /*  75 */ INTSTR_STATIC_INIT(0x096A1B36u, 4, 76, "READ"),
+  /*  76 */ INTSTR_STATIC_INIT(0x3ABFA3C3u, 11, 77, "UNQUALIFIED"),
+  /*  77 */ INTSTR_STATIC_INIT(0x2926189Au, 3, 78, "SGN"),
+  /*  78 */ INTSTR_STATIC_INIT(0x262BBA24u, 3, 79, "MAX"),
+  /*  79 */ INTSTR_STATIC_INIT(0x35F4AA1Eu, 4, 80, "EXIT"),
+  /*  80 */ INTSTR_STATIC_INIT(0x7A3963DDu, 7, 81, "POINTER"),
+  /*  81 */ INTSTR_STATIC_INIT(0x21FE743Au, 8, 82, "LONGREAL"),
+  /*  82 */ INTSTR_STATIC_INIT(0x4CA0818Fu, 5, 83, "COUNT"),
+  /*  83 */ INTSTR_STATIC_INIT(0x188EA0AEu, 7, 84, "ATSTORE"),
+  /*  84 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /*  85 */ INTSTR_STATIC_INIT(0x705FF67Au, 4, 86, "TYPE"),
+  /*  86 */ INTSTR_STATIC_INIT(0x6EDB11BEu, 7, 87, "ATVALUE"),
+  /*  87 */ INTSTR_STATIC_INIT(0x67F5EC3Du, 4, 88, "THEN"),
+  /*  88 */ INTSTR_STATIC_INIT(0x4D744225u, 6, 89, "RETAIN"),
+  /*  89 */ INTSTR_STATIC_INIT(0x2248413Bu, 3, 90, "END"),
+  /*  90 */ INTSTR_STATIC_INIT(0x32C74453u, 4, 91, "PREV"),
+  /*  91 */ INTSTR_STATIC_INIT(0x3638B881u, 4, 92, "HALT"),
+  /*  92 */ INTSTR_STATIC_INIT(0x7733D32Eu, 4, 93, "LOG2"),
+  /*  93 */ INTSTR_STATIC_INIT(0x47649A51u, 5, 94, "VALUE"),
+  /*  94 */ INTSTR_STATIC_INIT(0x308620C9u, 5, 95, "BEGIN"),
+  /*  95 */ INTSTR_STATIC_INIT(0x3CA051D9u, 9, 96, "INTERFACE"),
+  /*  96 */ INTSTR_STATIC_INIT(0x61E71AFEu, 6, 97, "GETREG"),
+  /*  97 */ INTSTR_STATIC_INIT(0x7FC78CD0u, 5, 98, "FIRST"),
+  /*  98 */ INTSTR_STATIC_INIT(0x76F607C8u, 7, 99, "BOOLEAN"),
+  /*  99 */ INTSTR_STATIC_INIT(0x57567A70u, 6, 100, "RETURN"),
+  /* 100 */ INTSTR_STATIC_INIT(0x3D6E40B1u, 6, 101, "RECORD"),
+  /* 101 */ INTSTR_STATIC_INIT(0x50FE0E96u, 4, 102, "CHAR"),
+  /* 102 */ INTSTR_STATIC_INIT(0x4ED50419u, 5, 103, "ARRAY"),
+  /* 103 */ INTSTR_STATIC_INIT(0x26B7CD13u, 3, 104, "NOT"),
+  /* 104 */ INTSTR_STATIC_INIT(0x00491245u, 2, 105, "IN"),
+  /* 105 */ INTSTR_STATIC_INIT(0x63A05EA9u, 9, 106, "COLLATION"),
+  /* 106 */ INTSTR_STATIC_INIT(0x6A43014Cu, 8, 107, "ATINSERT"),
+  /* 107 */ INTSTR_STATIC_INIT(0x03915C75u, 5, 108, "TSIZE"),
+  /* 108 */ INTSTR_STATIC_INIT(0x6CA2044Bu, 6, 109, "ATOMIC"),
+  /* 109 */ INTSTR_STATIC_INIT(0x6A703ABEu, 4, 110, "TMIN"),
+  /* 110 */ INTSTR_STATIC_INIT(0x004F13C3u, 2, 111, "OR"),
+  /* 111 */ INTSTR_STATIC_INIT(0x146F240Bu, 6, 112, "ENTIER"),
+  /* 112 */ INTSTR_STATIC_INIT(0x54737BCDu, 4, 113, "CODE"),
+  /* 113 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /* 114 */ INTSTR_STATIC_INIT(0x22C75109u, 3, 115, "FOR"),
+  /* 115 */ INTSTR_STATIC_INIT(0x27B8ED4Eu, 3, 116, "PTR"),
+  /* 116 */ INTSTR_STATIC_INIT(0x2781BF72u, 14, 117, "IMPLEMENTATION"),
+  /* 117 */ INTSTR_STATIC_INIT(0x62586070u, 8, 118, "OCTETSEQ"),
+  /* 118 */ INTSTR_STATIC_INIT(0x32C74441u, 4, 119, "PRED"),
+  /* 119 */ INTSTR_STATIC_INIT(0x005414FBu, 2, 120, "TO"),
+  /* 120 */ INTSTR_STATIC_INIT(0x2738DD41u, 3, 121, "ORD"),
+  /* 121 */ INTSTR_STATIC_INIT(0x3015F279u, 4, 122, "ELSE"),
+  /* 122 */ INTSTR_STATIC_INIT(0x3C4ACCF7u, 8, 123, "ATREMOVE"),
+  /* 123 */ INTSTR_STATIC_INIT(0x214620CDu, 3, 124, "CHR"),
+  /* 124 */ INTSTR_STATIC_INIT(0x6A6838D0u, 4, 125, "TMAX"),
+  /* 125 */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, ""),
+  /* 126 */ INTSTR_STATIC_INIT(0x6630FF2Cu, 8, 127, "LONGCARD"),
+  /* 127 */ INTSTR_STATIC_INIT(0x547F7ED5u, 4, 128, "COPY")
+}; /* ident_lexeme_table */
+
+static intstr_static_t ident_empty_lexeme =
+  INTSTR_STATIC_INIT(0x00000000u, 0, 0, "");
+
+static const uint8_t ident_resword_tag[LAST_RESWORD_TOKEN + 1] = {
+  [TOKEN_ELSIF] = 2,
+  [TOKEN_MODULE] = 4,
+  [TOKEN_MOD] = 5,
+  [TOKEN_IF] = 8,
+  [TOKEN_DIV] = 10,
+  [TOKEN_WHILE] = 13,
+  [TOKEN_AND] = 16,
+  [TOKEN_IMPORT] = 18,
+  [TOKEN_OPAQUE] = 34,
+  [TOKEN_OF] = 35,
+  [TOKEN_NEW] = 37,
+  [TOKEN_ALIAS] = 38,
+  [TOKEN_WRITE] = 40,
+  [TOKEN_NOP] = 44,
+  [TOKEN_VAR] = 45,
+  [TOKEN_ARGLIST] = 51,
+  [TOKEN_LOOP] = 52,
+  [TOKEN_SET] = 55,
+  [TOKEN_CONST] = 56,
+  [TOKEN_CASE] = 57,
+  [TOKEN_REPEAT] = 58,
+  [TOKEN_DO] = 62,
+  [TOKEN_RELEASE] = 63,
+  [TOKEN_UNTIL] = 64,
+  [TOKEN_PROCEDURE] = 71,
+  [TOKEN_READ] = 76,
+  [TOKEN_UNQUALIFIED] = 77,
+  [TOKEN_EXIT] = 80,
+  [TOKEN_POINTER] = 81,
+  [TOKEN_TYPE] = 86,
+  [TOKEN_THEN] = 88,
+  [TOKEN_RETAIN] = 89,
+  [TOKEN_END] = 90,
+  [TOKEN_BEGIN] = 95,
+  [TOKEN_INTERFACE] = 96,
+  [TOKEN_RETURN] = 100,
+  [TOKEN_RECORD] = 101,
+  [TOKEN_ARRAY] = 103,
+  [TOKEN_NOT] = 104,
+  [TOKEN_IN] = 105,
+  [TOKEN_OR] = 111,
+  [TOKEN_FOR] = 115,
+  [TOKEN_IMPLEMENTATION] = 117,
+  [TOKEN_OCTETSEQ] = 118,
+  [TOKEN_TO] = 120,
+  [TOKEN_ELSE] = 122,
+  [TOKEN_COPY] = 128
+}; /* ident_resword_tag */
+
+static const uint8_t ident_predef_tag[PREDEF_END_MARK] = {
+  [PREDEF_FALSE] = 1,
+  [PREDEF_SETREG] = 3,
+  [PREDEF_LAST] = 7,
+  [PREDEF_BYTE] = 9,
+  [PREDEF_ABS] = 11,
+  [PREDEF_MIN] = 15,
+  [PREDEF_POW2] = 17,
+  [PREDEF_REAL] = 19,
+  [PREDEF_SUCC] = 20,
+  [PREDEF_UNSAFE] = 21,
+  [PREDEF_OCTET] = 22,
+  [PREDEF_APPEND] = 23,
+  [PREDEF_ODD] = 25,
+  [PREDEF_INTEGER] = 26,
+  [PREDEF_STORE] = 27,
+  [PREDEF_REMOVE] = 28,
+  [PREDEF_CAST] = 31,
+  [PREDEF_INSERT] = 32,
+  [PREDEF_LENGTH] = 33,
+  [PREDEF_UCHR] = 39,
+  [PREDEF_UNICHAR] = 41,
+  [PREDEF_REGISTER] = 42,
+  [PREDEF_TRUE] = 43,
+  [PREDEF_ALLOC] = 46,
+  [PREDEF_NIL] = 47,
+  [PREDEF_NEXT] = 49,
+  [PREDEF_WORD] = 50,
+  [PREDEF_ADDRESS] = 53,
+  [PREDEF_CARDINAL] = 60,
+  [PREDEF_DEALLOC] = 65,
+  [PREDEF_LONGINT] = 66,
+  [PREDEF_STDOUT] = 67,
+  [PREDEF_STDIN] = 68,
+  [PREDEF_ASSEMBLER] = 69,
+  [PREDEF_TLIMIT] = 70,
+  [PREDEF_ARCH] = 72,
+  [PREDEF_CAPACITY] = 74,
+  [PREDEF_LONGWORD] = 75,
+  [PREDEF_SGN] = 78,
+  [PREDEF_MAX] = 79,
+  [PREDEF_LONGREAL] = 82,
+  [PREDEF_COUNT] = 83,
+  [PREDEF_ATSTORE] = 84,
+  [PREDEF_ATVALUE] = 87,
+  [PREDEF_PREV] = 91,
+  [PREDEF_HALT] = 92,
+  [PREDEF_LOG2] = 93,
+  [PREDEF_VALUE] = 94,
+  [PREDEF_GETREG] = 97,
+  [PREDEF_FIRST] = 98,
+  [PREDEF_BOOLEAN] = 99,
+  [PREDEF_CHAR] = 102,
+  [PREDEF_COLLATION] = 106,
+  [PREDEF_ATINSERT] = 107,
+  [PREDEF_TSIZE] = 108,
+  [PREDEF_ATOMIC] = 109,
+  [PREDEF_TMIN] = 110,
+  [PREDEF_ENTIER] = 112,
+  [PREDEF_CODE] = 113,
+  [PREDEF_PTR] = 116,
+  [PREDEF_PRED] = 119,
+  [PREDEF_ORD] = 121,
+  [PREDEF_ATREMOVE] = 123,
+  [PREDEF_CHR] = 124,
+  [PREDEF_TMAX] = 125,
+  [PREDEF_LONGCARD] = 127
+}; /* ident_predef_tag */
+
+static const uint8_t ident_bindable_tag[BINDABLE_END_MARK] = {
+  [BINDABLE_LAST] = 7,
+  [BINDABLE_APPEND] = 23,
+  [BINDABLE_STORE] = 27,
+  [BINDABLE_REMOVE] = 28,
+  [BINDABLE_LENGTH] = 33,
+  [BINDABLE_ALLOC] = 46,
+  [BINDABLE_NEXT] = 49,
+  [BINDABLE_DEALLOC] = 65,
+  [BINDABLE_STDOUT] = 67,
+  [BINDABLE_STDIN] = 68,
+  [BINDABLE_TLIMIT] = 70,
+  [BINDABLE_COUNT] = 83,
+  [BINDABLE_ATSTORE] = 84,
+  [BINDABLE_ATVALUE] = 87,
+  [BINDABLE_PREV] = 91,
+  [BINDABLE_VALUE] = 94,
+  [BINDABLE_FIRST] = 98,
+  [BINDABLE_COLLATION] = 106,
+  [BINDABLE_ATINSERT] = 107,
+  [BINDABLE_ATREMOVE] = 123
+}; /* ident_bindable_tag */
+
+/* END OF FILE */
@@ -38,36 +38,192 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "m2c-ident-xlat.h"
+#include "m2c-compiler-options.h"
 #include "snake-case-conv.h"
-#include "c-reswords.h"
+#include "c_reswords.h"
 #include "base36.h"
 
-#include <stdio.h> /* sprintf */
-#include <stdlib.h> /* NULL, malloc */
+#include <stdlib.h> /* NULL, malloc, calloc, free */
+#include <string.h> /* strlen, memcpy */
 
 
 /* --------------------------------------------------------------------------
- * private function convert_to_upper(str)
+ * Maximum length of a composed C identifier
+ * ----------------------------------------------------------------------- */
+
+#define XLAT_MAX_LENGTH 255
+
+
+/* --------------------------------------------------------------------------
+ * Default slot count of translation caches,  must be a power of two
+ * ----------------------------------------------------------------------- */
+
+#define XLAT_CACHE_DEFAULT_SLOT_COUNT 256
+
+
+/* --------------------------------------------------------------------------
+ * Maximum load factor of translation caches in percent
+ * ----------------------------------------------------------------------- */
+
+#define XLAT_CACHE_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * Size of string blocks of translation caches
+ * ----------------------------------------------------------------------- */
+
+#define XLAT_CACHE_BLOCK_SIZE 4096
+
+
+/* --------------------------------------------------------------------------
+ * Lowline suffix of import guards
+ * ----------------------------------------------------------------------- */
+
+#define IMPORT_GUARD_SUFFIX "_H"
+
+
+/* --------------------------------------------------------------------------
+ * Suffix of C header names
+ * ----------------------------------------------------------------------- */
+
+#define HEADER_NAME_SUFFIX ".h"
+
+
+/* --------------------------------------------------------------------------
+ * Interned string flags
  * --------------------------------------------------------------------------
- * Converts all lowercase characters in str to uppercase in situ. 
+ * XLAT_FLAG_C_CHECKED is set once the snake-case translation of an interned
+ * identifier has been tested against the C reserved words,  the result is
+ * recorded in XLAT_FLAG_C_COLLISION.
  * ----------------------------------------------------------------------- */
 
-static void convert_to_upper (char *str) {
-  
-  uint_t index;
-  char ch;
+#define XLAT_FLAG_C_CHECKED (1 << 0)
 
-  index = 0;
-  ch = str[0];
+#define XLAT_FLAG_C_COLLISION (1 << 1)
 
-  while (ch != ASCII_NUL) {
-    if (IS_LOWER(ch)) {
-      str[index] = ch - 32;
-    }
-    index++;
-    ch = str[index];
-  } /* end while*/
-} /* convert_to_upper */
+
+/* --------------------------------------------------------------------------
+ * Uppercase conversion
+ * ----------------------------------------------------------------------- */
+
+#define TO_UPPER(_ch) (IS_LOWER(_ch) ? ((_ch) - 32) : (_ch))
+
+
+/* --------------------------------------------------------------------------
+ * private type xlat_scope_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the scope of a translated identifier.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  XLAT_SCOPE_EXPORTED,
+  XLAT_SCOPE_HIDDEN,
+  XLAT_SCOPE_LOCAL
+} xlat_scope_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type xlat_buffer_t
+ * --------------------------------------------------------------------------
+ * Record type for composing a C identifier.  Appends beyond the maximum
+ * length are silently truncated.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  uint_t length;
+  char str[XLAT_MAX_LENGTH + 1];
+} xlat_buffer_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type xlat_cache_entry_s
+ * --------------------------------------------------------------------------
+ * Record type representing an entry of a translation cache.  Entries are
+ * stored inline in the slot array of the cache,  a NULL ident marks a free
+ * slot.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  intstr_t ident;
+  intstr_t enum_id;
+  uint8_t scope;
+  uint8_t kind;
+  const char *xlat;
+} xlat_cache_entry_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type xlat_cache_block_s
+ * --------------------------------------------------------------------------
+ * Record type representing a block of translation strings.  Strings never
+ * move once stored,  blocks are only deallocated with their cache.
+ * ----------------------------------------------------------------------- */
+
+typedef struct xlat_cache_block_s *xlat_cache_block_t;
+
+struct xlat_cache_block_s {
+  xlat_cache_block_t prev;
+  uint_t size;
+  uint_t used;
+  char storage[];
+};
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_ident_xlat_cache_s
+ * --------------------------------------------------------------------------
+ * Record type representing the translation cache of a module.  The lower
+ * and upper case module prefixes,  the import guard and the header name are
+ * composed once when the cache is created,  or taken from a symbol file.
+ * Translations are keyed on the scope,  kind,  enumeration and identifier
+ * of the request.  Local names are currently qualified by a hash of the
+ * identifier,  not the enclosing procedure,  so the procedure is not part
+ * of the key.  In unity builds all modules share one C translation unit,
+ * hidden names are then qualified with the module prefix like exported
+ * names,  recorded in qualify_hidden.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_ident_xlat_cache_s {
+  intstr_t module_id;
+  bool qualify_hidden;
+  xlat_buffer_t prefix[2];
+  const char *import_guard;
+  const char *header_name;
+  uint_t entry_count;
+  uint_t slot_count;
+  xlat_cache_entry_s *slot;
+  xlat_cache_block_t block;
+};
+
+typedef struct m2c_ident_xlat_cache_s m2c_ident_xlat_cache_s;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void append_str (xlat_buffer_t *buffer, const char *str);
+
+static void append_upper (xlat_buffer_t *buffer, const char *str);
+
+static void compose_xlat
+  (xlat_buffer_t *buffer,
+   const xlat_buffer_t *prefix,
+   xlat_scope_t scope,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,
+   intstr_t ident);
+
+static void compose_prefixes (xlat_buffer_t *prefix, const char *module_id);
+
+static char *new_cstr_for_buffer (const xlat_buffer_t *buffer);
+
+static const char *cached_xlat
+  (m2c_ident_xlat_cache_t cache,
+   xlat_scope_t scope,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,
+   intstr_t ident);
 
 
 /* --------------------------------------------------------------------------
@@ -78,22 +234,20 @@ static void convert_to_upper (char *str) {
 
 const char* m2c_ident_xlat_import_guard (intstr_t module_id) {
   
-  char *ll_module_id, *import_guard;
-  uint_t len;
-
-  ll_module_id = snake_case_for_ident(intstr_char_ptr(module_id));
+  const char *ll_module_id;
+  xlat_buffer_t buffer;
   
-  len = strlen(ll_module_id) + 2;
-  import_guard = malloc(len * sizeof(char) + 1);
-
-  if (import_guard == NULL) {
+  ll_module_id = snake_case_for_ident(module_id);
+  
+  if (ll_module_id == NULL) {
     return NULL;
-  }; /* end if */
+  } /* end if */
   
-  sprintf(import_guard, "%s _H", ll_module_id);
-  convert_to_upper(import_guard);
+  buffer.length = 0;
+  append_upper(&buffer, ll_module_id);
+  append_str(&buffer, IMPORT_GUARD_SUFFIX);
   
-  return import_guard;
+  return new_cstr_for_buffer(&buffer);
 }; /* end m2c_ident_xlat_import_guard */
 
 
@@ -109,65 +263,16 @@ const char* m2c_ident_xlat_for_exported_name
    intstr_t enum_id,   /* may be NULL */
    intstr_t ident)     /* required */ {
   
-  char *ll_module_id, *ll_enum_id, *ll_ident, *xlat;
-  uint_t len;
-
-  switch (kind) {
-
-    case M2C_IDENT_XLAT_KIND_CONST :
-
-    /* enumerated value */
-      if (enum_id != NULL) {
-        ll_module_id = snake_case_for_ident(intstr_char_ptr(module_id));
-        ll_enum_id = snake_case_for_ident(intstr_char_ptr(enum_id));
-        ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-        len = strlen(ll_module_id)+strlen(ll_enum_id)+strlen(ll_ident)+3;
-        xlat = malloc(len * sizeof(char) + 1);
-        sprintf(xlat, "%s__%s_%s", ll_module_id, ll_enum_id, ll_ident);
-      }
-    /* other constant */
-      else {
-        ll_module_id = snake_case_for_ident(intstr_char_ptr(module_id));
-        ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-        len = strlen(ll_module_id) + strlen(ll_ident) + 2;
-        xlat = malloc(len * sizeof(char) + 1);
-        sprintf(xlat, "%s__%s", ll_ident);
-      }; /* end if */
-      
-      /* ALL-CAPS */
-      convert_to_upper(xlat);
-      break;
-
-    /* type */
-    case M2C_IDENT_XLAT_KIND_TYPE  :
-      ll_module_id = snake_case_for_ident(intstr_char_ptr(module_id));
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_module_id) + strlen(ll_ident) + 3;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s__%s_t", ll_ident);
-      break;
-
-    /* variable or function */
-    case M2C_IDENT_XLAT_KIND_VAR   :
-    case M2C_IDENT_XLAT_KIND_FUNC  :
-      ll_module_id = snake_case_for_ident(intstr_char_ptr(module_id));
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_module_id) + strlen(ll_ident) + 2;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s__%s", ll_module_id, ll_ident);
-      break;
-
-    /* procedure */
-    case M2C_IDENT_XLAT_KIND_PROC  :
-      ll_module_id = snake_case_for_ident(intstr_char_ptr(module_id));
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_module_id) + strlen(ll_ident) + 3;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s__do_%s", ll_module_id, ll_ident);
-    
-  }; /* end switch */
+  xlat_buffer_t prefix[2], buffer;
   
-  return xlat;
+  if ((module_id == NULL) || (ident == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  compose_prefixes(prefix, snake_case_for_ident(module_id));
+  compose_xlat(&buffer, prefix, XLAT_SCOPE_EXPORTED, kind, enum_id, ident);
+  
+  return new_cstr_for_buffer(&buffer);
 }; /* end m2c_ident_xlat_for_exported_name */
 
 
@@ -182,183 +287,703 @@ const char* m2c_ident_xlat_for_hidden_name
    intstr_t enum_id,   /* may be NULL */
    intstr_t ident)     /* required */ {
   
-  char *ll_enum_id, *ll_ident, *xlat;
-  uint_t len;
+  xlat_buffer_t buffer;
+  
+  if (ident == NULL) {
+    return NULL;
+  } /* end if */
+  
+  compose_xlat(&buffer, NULL, XLAT_SCOPE_HIDDEN, kind, enum_id, ident);
+  
+  return new_cstr_for_buffer(&buffer);
+}; /* end m2c_ident_xlat_for_hidden_name */
 
-  switch (kind) {
 
-    case M2C_IDENT_XLAT_KIND_CONST :
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_for_local_name(type, proc_id, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns a local C identifier from proc_id for ident.
+ * ----------------------------------------------------------------------- */
 
-    /* enumerated value */
-      if (enum_id != NULL) {
-        ll_enum_id = snake_case_for_ident(intstr_char_ptr(enum_id));
-        ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-        len = strlen(ll_enum_id) + strlen(ll_ident) + 1;
-        xlat = malloc(len * sizeof(char) + 1);
-        sprintf(xlat, "%s_%s", ll_enum_id, ll_ident);
-      }
-    /* other constant */
-      else {
-        ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-        len = strlen(ll_ident);
-        xlat = malloc(len * sizeof(char) + 1);
-        sprintf(xlat, "%s", ll_ident);
-      }; /* end if */
-
-      /* ALL-CAPS */
-      convert_to_upper(xlat);
-      break;
+const char* m2c_ident_xlat_for_local_name
+  (m2c_ident_xlat_kind_t kind,
+   intstr_t proc_id,   /* required */
+   intstr_t enum_id,   /* may be NULL */
+   intstr_t ident)     /* required */ {
+  
+  xlat_buffer_t buffer;
+  
+  if ((proc_id == NULL) || (ident == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  compose_xlat(&buffer, NULL, XLAT_SCOPE_LOCAL, kind, enum_id, ident);
+  
+  return new_cstr_for_buffer(&buffer);
+}; /* end m2c_ident_xlat_for_local_name */
 
-    /* type */
-    case M2C_IDENT_XLAT_KIND_TYPE  :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident) + 2;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s_t", ll_ident);
-      break;
 
-    /* variable or function */
-    case M2C_IDENT_XLAT_KIND_VAR   :
-    case M2C_IDENT_XLAT_KIND_FUNC  :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident);
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s", ll_ident);
-      if (is_c_resword(xlat)) {
-        /* convert first char to upper */
-        xlat[0] = xlat[0] - 32;
-      } /* end if */
-      break;
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_new_cache(module_id)
+ * --------------------------------------------------------------------------
+ * Returns a new translation cache for module_id,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
 
-    /* procedure */
-    case M2C_IDENT_XLAT_KIND_PROC  :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident) + 3;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "do_%s", ll_ident);
-    
-  }; /* end switch */
+static const char *store_in_cache
+  (m2c_ident_xlat_cache_t cache, const xlat_buffer_t *buffer);
+
+m2c_ident_xlat_cache_t m2c_ident_xlat_new_cache (intstr_t module_id) {
   
-  return xlat;
-}; /* end m2c_ident_xlat_for_hidden_name */
+  m2c_ident_xlat_names_t names;
+  const char *ll_module_id;
+  xlat_buffer_t prefix[2], guard, header;
+  
+  ll_module_id = snake_case_for_ident(module_id);
+  
+  if (ll_module_id == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* module__ and MODULE__ */
+  compose_prefixes(prefix, ll_module_id);
+  
+  /* MODULE_H */
+  guard.length = 0;
+  append_upper(&guard, ll_module_id);
+  append_str(&guard, IMPORT_GUARD_SUFFIX);
+  
+  /* Module.h */
+  header.length = 0;
+  append_str(&header, intstr_char_ptr(module_id));
+  append_str(&header, HEADER_NAME_SUFFIX);
+  
+  names.prefix = prefix[0].str;
+  names.upper_prefix = prefix[1].str;
+  names.import_guard = guard.str;
+  names.header_name = header.str;
+  
+  return m2c_ident_xlat_new_cache_with_names(module_id, &names);
+}; /* end m2c_ident_xlat_new_cache */
 
 
 /* --------------------------------------------------------------------------
- * private procedure get_base36_hash_str_for_ident(ident, hash_str)
+ * function m2c_ident_xlat_new_cache_with_names(module_id, names)
  * --------------------------------------------------------------------------
- * Calculates a base-36 hash string from ident, passes it back in hash_str.
+ * Returns a new translation cache for module_id using the C names in names,
+ * or NULL on failure.
  * ----------------------------------------------------------------------- */
 
-static void get_base36_hash_str_for_ident
-  (const char *ident, char *hash_str) {
+m2c_ident_xlat_cache_t m2c_ident_xlat_new_cache_with_names
+  (intstr_t module_id, const m2c_ident_xlat_names_t *names) {
   
-  uint32_t index, value;
-  char ch;
+  m2c_ident_xlat_cache_t new_cache;
+  xlat_buffer_t buffer;
   
-  /* calculate hash */
-  index = 0;
-  ch = ident[index];
-  hash = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    value = HASH_NEXT_CHAR(value, ch);
-    index++;
-    ch = ident[index];
-  } /* end while */
-  value = HASH_FINAL(value);
+  if ((module_id == NULL) || (names == NULL) ||
+      (names->prefix == NULL) || (names->upper_prefix == NULL) ||
+      (names->import_guard == NULL) || (names->header_name == NULL)) {
+    return NULL;
+  } /* end if */
   
-  /* truncate to prevent overflow */
-  value = truncate_for_n_base36_digits(value);
+  new_cache = malloc(sizeof(m2c_ident_xlat_cache_s));
+  
+  if (new_cache == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_cache->slot =
+    calloc(XLAT_CACHE_DEFAULT_SLOT_COUNT, sizeof(xlat_cache_entry_s));
+  
+  if (new_cache->slot == NULL) {
+    free(new_cache);
+    return NULL;
+  } /* end if */
+  
+  new_cache->module_id = module_id;
+  new_cache->qualify_hidden = m2c_compiler_option_unity_build();
+  new_cache->entry_count = 0;
+  new_cache->slot_count = XLAT_CACHE_DEFAULT_SLOT_COUNT;
+  new_cache->block = NULL;
+  
+  new_cache->prefix[0].length = 0;
+  append_str(&new_cache->prefix[0], names->prefix);
+  
+  new_cache->prefix[1].length = 0;
+  append_str(&new_cache->prefix[1], names->upper_prefix);
+  
+  buffer.length = 0;
+  append_str(&buffer, names->import_guard);
+  new_cache->import_guard = store_in_cache(new_cache, &buffer);
+  
+  buffer.length = 0;
+  append_str(&buffer, names->header_name);
+  new_cache->header_name = store_in_cache(new_cache, &buffer);
+  
+  if ((new_cache->import_guard == NULL) || (new_cache->header_name == NULL)) {
+    m2c_ident_xlat_release_cache(new_cache);
+    return NULL;
+  } /* end if */
+  
+  return new_cache;
+}; /* end m2c_ident_xlat_new_cache_with_names */
 
-  /* pass back base-36 representation */
-  get_base36_str_for_uint(value, &str);
 
-  return;
-}; /* end get_base36_hash_str_for_ident */
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_import_guard(cache)
+ * --------------------------------------------------------------------------
+ * Returns the import guard C macro identifier for the module of cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_import_guard (m2c_ident_xlat_cache_t cache) {
+  
+  if (cache == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return cache->import_guard;
+}; /* end m2c_ident_xlat_cached_import_guard */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_ident_xlat_for_local_name(type, proc_id, enum_id, ident)
+ * procedure m2c_ident_xlat_cached_names(cache, names)
  * --------------------------------------------------------------------------
- * Returns a local C identifier from proc_id for ident.
+ * Passes the C names of the module of cache in names.
  * ----------------------------------------------------------------------- */
 
-const char* m2c_ident_xlat_for_local_name
-  (m2c_ident_xlat_kind_t kind,
+void m2c_ident_xlat_cached_names
+  (m2c_ident_xlat_cache_t cache, m2c_ident_xlat_names_t *names) {
+  
+  if ((cache == NULL) || (names == NULL)) {
+    return;
+  } /* end if */
+  
+  names->prefix = cache->prefix[0].str;
+  names->upper_prefix = cache->prefix[1].str;
+  names->import_guard = cache->import_guard;
+  names->header_name = cache->header_name;
+}; /* end m2c_ident_xlat_cached_names */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_exported_name(cache, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns a fully qualified C identifier for ident within the module of
+ * cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_exported_name
+  (m2c_ident_xlat_cache_t cache,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,   /* may be NULL */
+   intstr_t ident)     /* required */ {
+  
+  return cached_xlat(cache, XLAT_SCOPE_EXPORTED, kind, enum_id, ident);
+}; /* end m2c_ident_xlat_cached_exported_name */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_hidden_name(cache, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns a file level C identifier for ident within the module of cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_hidden_name
+  (m2c_ident_xlat_cache_t cache,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,   /* may be NULL */
+   intstr_t ident)     /* required */ {
+  
+  return cached_xlat(cache, XLAT_SCOPE_HIDDEN, kind, enum_id, ident);
+}; /* end m2c_ident_xlat_cached_hidden_name */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_local_name(cache, kind, proc_id, ...)
+ * --------------------------------------------------------------------------
+ * Returns a local C identifier from proc_id for ident within the module of
+ * cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_local_name
+  (m2c_ident_xlat_cache_t cache,
+   m2c_ident_xlat_kind_t kind,
    intstr_t proc_id,   /* required */
    intstr_t enum_id,   /* may be NULL */
    intstr_t ident)     /* required */ {
   
-  char *ll_enum_id, *ll_ident, *xlat;
-  base36_str_t suffix;
-  uint_t len;
+  if (proc_id == NULL) {
+    return NULL;
+  } /* end if */
   
-  get_base36_hash_str_for_ident(intstr_char_ptr(ident), &suffix);
+  return cached_xlat(cache, XLAT_SCOPE_LOCAL, kind, enum_id, ident);
+}; /* end m2c_ident_xlat_cached_local_name */
 
-  switch (kind) {
 
-    case M2C_IDENT_XLAT_KIND_CONST :
+/* --------------------------------------------------------------------------
+ * procedure m2c_ident_xlat_release_cache(cache)
+ * --------------------------------------------------------------------------
+ * Deallocates cache and all translations it returned.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ident_xlat_release_cache (m2c_ident_xlat_cache_t cache) {
+  
+  xlat_cache_block_t prev;
+  
+  if (cache == NULL) {
+    return;
+  } /* end if */
+  
+  while (cache->block != NULL) {
+    prev = cache->block->prev;
+    free(cache->block);
+    cache->block = prev;
+  } /* end while */
+  
+  free(cache->slot);
+  free(cache);
+}; /* end m2c_ident_xlat_release_cache */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure append_str(buffer, str)
+ * --------------------------------------------------------------------------
+ * Appends str to buffer,  truncating at the maximum length.
+ * ----------------------------------------------------------------------- */
+
+static void append_str (xlat_buffer_t *buffer, const char *str) {
+  
+  uint_t index;
+  
+  if (str == NULL) {
+    return;
+  } /* end if */
+  
+  index = 0;
+  while ((str[index] != ASCII_NUL) && (buffer->length < XLAT_MAX_LENGTH)) {
+    buffer->str[buffer->length] = str[index];
+    buffer->length++;
+    index++;
+  } /* end while */
+  
+  buffer->str[buffer->length] = ASCII_NUL;
+} /* end append_str */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure append_upper(buffer, str)
+ * --------------------------------------------------------------------------
+ * Appends str converted to uppercase to buffer,  truncating at the maximum
+ * length.
+ * ----------------------------------------------------------------------- */
+
+static void append_upper (xlat_buffer_t *buffer, const char *str) {
+  
+  uint_t index;
+  
+  if (str == NULL) {
+    return;
+  } /* end if */
+  
+  index = 0;
+  while ((str[index] != ASCII_NUL) && (buffer->length < XLAT_MAX_LENGTH)) {
+    buffer->str[buffer->length] = TO_UPPER(str[index]);
+    buffer->length++;
+    index++;
+  } /* end while */
+  
+  buffer->str[buffer->length] = ASCII_NUL;
+} /* end append_upper */
+
 
-    /* enumerated value */
+/* --------------------------------------------------------------------------
+ * private procedure compose_xlat(buffer, prefix, scope, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Composes the C identifier for ident of the given scope and kind in buffer.
+ * Exported names are qualified with the lowercase module prefix in prefix[0]
+ * or for constants  the uppercase module prefix in prefix[1].  Prefix must
+ * not be NULL for exported names.  Constants are composed in uppercase.
+ * ----------------------------------------------------------------------- */
+
+static void append_local_suffix (xlat_buffer_t *buffer, intstr_t ident);
+
+static bool collides_with_c (intstr_t ident, const char *ll_ident);
+
+static void compose_xlat
+  (xlat_buffer_t *buffer,
+   const xlat_buffer_t *prefix,
+   xlat_scope_t scope,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,
+   intstr_t ident) {
+  
+  const char *ll_ident;
+  
+  buffer->length = 0;
+  buffer->str[0] = ASCII_NUL;
+  
+  ll_ident = snake_case_for_ident(ident);
+  
+  switch (kind) {
+    
+    /* constant or enumerated value */
+    case M2C_IDENT_XLAT_KIND_CONST :
+      if (scope == XLAT_SCOPE_EXPORTED) {
+        append_str(buffer, prefix[1].str);
+      } /* end if */
+      
       if (enum_id != NULL) {
-        ll_enum_id = snake_case_for_ident(intstr_char_ptr(enum_id));
-        ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-        len = strlen(ll_enum_id) + strlen(ll_ident) + strlen(suffix) + 4;
-        xlat = malloc(len * sizeof(char) + 1);
-        sprintf(xlat, "%s_%s__%s", ll_enum_id, ll_ident, suffix);
-      }
-    /* other constant */
-      else {
-        ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-        len = strlen(ll_ident) + strlen(suffix) + 3;
-        xlat = malloc(len * sizeof(char) + 1);
-        sprintf(xlat, "%s__%s", ll_ident, suffix);
-      }; /* end if */
-
-      /* ALL-CAPS */
-      convert_to_upper(xlat);
+        append_upper(buffer, snake_case_for_ident(enum_id));
+        append_str(buffer, "_");
+      } /* end if */
+      
+      append_upper(buffer, ll_ident);
+      
+      if (scope == XLAT_SCOPE_LOCAL) {
+        append_local_suffix(buffer, ident);
+      } /* end if */
       break;
-
+    
     /* type */
-    case M2C_IDENT_XLAT_KIND_TYPE  :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident) + strlen(suffix) + 5;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s_t__%s", ll_ident, suffix);
-      break;
-
-    /* variable */
-    case M2C_IDENT_XLAT_KIND_VAR   :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident);
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s", ll_ident);
-      if (is_c_resword(xlat)) {
-        /* convert first char to upper */
-        xlat[0] = xlat[0] - 32;
+    case M2C_IDENT_XLAT_KIND_TYPE :
+      if (scope == XLAT_SCOPE_EXPORTED) {
+        append_str(buffer, prefix[0].str);
+      } /* end if */
+      
+      append_str(buffer, ll_ident);
+      append_str(buffer, "_t");
+      
+      if (scope == XLAT_SCOPE_LOCAL) {
+        append_local_suffix(buffer, ident);
       } /* end if */
       break;
     
-    /* function */
-    case M2C_IDENT_XLAT_KIND_FUNC  :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident) + strlen(suffix) + 3;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "%s__%s", ll_ident, suffix);
+    /* variable or function */
+    case M2C_IDENT_XLAT_KIND_VAR :
+    case M2C_IDENT_XLAT_KIND_FUNC :
+      if (scope == XLAT_SCOPE_EXPORTED) {
+        append_str(buffer, prefix[0].str);
+        append_str(buffer, ll_ident);
+      }
+      else if ((scope == XLAT_SCOPE_LOCAL) &&
+        (kind == M2C_IDENT_XLAT_KIND_FUNC)) {
+        append_str(buffer, ll_ident);
+        append_local_suffix(buffer, ident);
+      }
+      else /* hidden, or local variable */ {
+        append_str(buffer, ll_ident);
+        
+        /* avoid clashes with C reserved words */
+        if ((buffer->length > 0) && (collides_with_c(ident, ll_ident))) {
+          buffer->str[0] = TO_UPPER(buffer->str[0]);
+        } /* end if */
+      } /* end if */
       break;
-      
+    
     /* procedure */
-    case M2C_IDENT_XLAT_KIND_PROC  :
-      ll_ident = snake_case_for_ident(intstr_char_ptr(ident));
-      len = strlen(ll_ident) + strlen(suffix) + 6;
-      xlat = malloc(len * sizeof(char) + 1);
-      sprintf(xlat, "do_%s__%s", ll_ident, suffix);
+    case M2C_IDENT_XLAT_KIND_PROC :
+      if (scope == XLAT_SCOPE_EXPORTED) {
+        append_str(buffer, prefix[0].str);
+      } /* end if */
+      
+      append_str(buffer, "do_");
+      append_str(buffer, ll_ident);
+      
+      if (scope == XLAT_SCOPE_LOCAL) {
+        append_local_suffix(buffer, ident);
+      } /* end if */
+      break;
     
-  }; /* end switch */
+  } /* end switch */
   
-  return xlat;  
-}; /* end m2c_ident_xlat_for_local_name */
+  return;
+} /* end compose_xlat */
 
 
-#endif /* M2C_IDENT_XLAT_H */
+/* --------------------------------------------------------------------------
+ * private procedure append_local_suffix(buffer, ident)
+ * --------------------------------------------------------------------------
+ * Appends a double lowline and a base-36 hash string of ident to buffer.
+ * The hash is the key already cached in the interned identifier.
+ * ----------------------------------------------------------------------- */
+
+static void append_local_suffix (xlat_buffer_t *buffer, intstr_t ident) {
+  
+  base36_str_t suffix;
+  uint32_t value;
+  
+  /* truncate to prevent overflow */
+  value = truncate_for_n_base36_digits((uint32_t) intstr_hash(ident));
+  
+  /* base-36 representation */
+  get_base36_str_for_uint(value, &suffix);
+  
+  append_str(buffer, "__");
+  append_str(buffer, suffix);
+} /* end append_local_suffix */
+
+
+/* --------------------------------------------------------------------------
+ * private function collides_with_c(ident, ll_ident)
+ * --------------------------------------------------------------------------
+ * Returns true if ll_ident,  the snake-case translation of ident,  is a C
+ * reserved word.  The test is carried out once per interned identifier,  its
+ * result is cached in the flags of ident.
+ * ----------------------------------------------------------------------- */
+
+static bool collides_with_c (intstr_t ident, const char *ll_ident) {
+  
+  uint_t flags;
+  
+  flags = intstr_flags(ident);
+  
+  if ((flags & XLAT_FLAG_C_CHECKED) == 0) {
+    flags = flags | XLAT_FLAG_C_CHECKED;
+    if (is_c_resword(ll_ident)) {
+      flags = flags | XLAT_FLAG_C_COLLISION;
+    } /* end if */
+    intstr_set_flags(ident, flags);
+  } /* end if */
+  
+  return ((flags & XLAT_FLAG_C_COLLISION) != 0);
+} /* end collides_with_c */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_cstr_for_buffer(buffer)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated copy of the string in buffer,  or NULL if the
+ * buffer is empty or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_cstr_for_buffer (const xlat_buffer_t *buffer) {
+  
+  char *new_str;
+  
+  if (buffer->length == 0) {
+    return NULL;
+  } /* end if */
+  
+  new_str = malloc(buffer->length + 1);
+  
+  if (new_str == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(new_str, buffer->str, buffer->length + 1);
+  
+  return new_str;
+} /* end new_cstr_for_buffer */
+
+
+/* --------------------------------------------------------------------------
+ * private function store_in_cache(cache, buffer)
+ * --------------------------------------------------------------------------
+ * Copies the string in buffer into the string blocks of cache and returns
+ * the stored copy,  or NULL if the buffer is empty or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static const char *store_in_cache
+  (m2c_ident_xlat_cache_t cache, const xlat_buffer_t *buffer) {
+  
+  xlat_cache_block_t new_block;
+  uint_t size;
+  char *str;
+  
+  if (buffer->length == 0) {
+    return NULL;
+  } /* end if */
+  
+  size = buffer->length + 1;
+  
+  /* allocate a new block if there is no room in the current one */
+  if ((cache->block == NULL) ||
+      (cache->block->size - cache->block->used < size)) {
+    
+    new_block = malloc(sizeof(struct xlat_cache_block_s) +
+      XLAT_CACHE_BLOCK_SIZE);
+    
+    if (new_block == NULL) {
+      return NULL;
+    } /* end if */
+    
+    new_block->prev = cache->block;
+    new_block->size = XLAT_CACHE_BLOCK_SIZE;
+    new_block->used = 0;
+    cache->block = new_block;
+  } /* end if */
+  
+  str = &(cache->block->storage[cache->block->used]);
+  memcpy(str, buffer->str, size);
+  cache->block->used = cache->block->used + size;
+  
+  return str;
+} /* end store_in_cache */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure compose_prefixes(prefix, module_id)
+ * --------------------------------------------------------------------------
+ * Composes the lowercase module prefix for snake-case module_id in prefix[0]
+ * and the uppercase module prefix in prefix[1].
+ * ----------------------------------------------------------------------- */
+
+static void compose_prefixes (xlat_buffer_t *prefix, const char *module_id) {
+  
+  /* module__ */
+  prefix[0].length = 0;
+  append_str(&prefix[0], module_id);
+  append_str(&prefix[0], "__");
+  
+  /* MODULE__ */
+  prefix[1].length = 0;
+  append_upper(&prefix[1], module_id);
+  append_str(&prefix[1], "__");
+} /* end compose_prefixes */
+
+
+/* --------------------------------------------------------------------------
+ * private function slot_index_for(cache, scope, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns the index of the slot holding the entry for the given key,  or of
+ * the free slot where it is to be entered.
+ * ----------------------------------------------------------------------- */
+
+static uint_t slot_index_for
+  (m2c_ident_xlat_cache_t cache,
+   xlat_scope_t scope,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,
+   intstr_t ident) {
+  
+  uint_t index, mask, key;
+  xlat_cache_entry_s *entry;
+  
+  key = intstr_hash(ident) + (scope * 8) + kind;
+  if (enum_id != NULL) {
+    key = key ^ (intstr_hash(enum_id) * 31);
+  } /* end if */
+  
+  mask = cache->slot_count - 1;
+  index = key & mask;
+  entry = &(cache->slot[index]);
+  
+  while ((entry->ident != NULL) &&
+    ((entry->ident != ident) || (entry->enum_id != enum_id) ||
+     (entry->scope != scope) || (entry->kind != kind))) {
+    index = (index + 1) & mask;
+    entry = &(cache->slot[index]);
+  } /* end while */
+  
+  return index;
+} /* end slot_index_for */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_cache(cache)
+ * --------------------------------------------------------------------------
+ * Doubles the slot count of cache and reenters all its entries.  Returns
+ * false if allocation failed,  leaving cache unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_cache (m2c_ident_xlat_cache_t cache) {
+  
+  xlat_cache_entry_s *old_slot, *entry;
+  uint_t index, old_slot_count;
+  
+  old_slot = cache->slot;
+  old_slot_count = cache->slot_count;
+  
+  cache->slot = calloc(2 * old_slot_count, sizeof(xlat_cache_entry_s));
+  
+  if (cache->slot == NULL) {
+    cache->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  cache->slot_count = 2 * old_slot_count;
+  
+  index = 0;
+  while (index < old_slot_count) {
+    entry = &(old_slot[index]);
+    if (entry->ident != NULL) {
+      cache->slot[slot_index_for(cache, entry->scope, entry->kind,
+        entry->enum_id, entry->ident)] = *entry;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  free(old_slot);
+  return true;
+} /* end grow_cache */
+
+
+/* --------------------------------------------------------------------------
+ * private function cached_xlat(cache, scope, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns the cached C identifier for the given key,  composing and storing
+ * it on the first request.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static const char *cached_xlat
+  (m2c_ident_xlat_cache_t cache,
+   xlat_scope_t scope,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,
+   intstr_t ident) {
+  
+  xlat_cache_entry_s *entry;
+  xlat_buffer_t buffer;
+  const char *xlat;
+  
+  if ((cache == NULL) || (ident == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  entry = &(cache->slot[slot_index_for(cache, scope, kind, enum_id, ident)]);
+  
+  /* cache hit */
+  if (entry->ident != NULL) {
+    return entry->xlat;
+  } /* end if */
+  
+  /* cache miss, in unity builds hidden names are qualified like exported */
+  if ((scope == XLAT_SCOPE_HIDDEN) && (cache->qualify_hidden)) {
+    compose_xlat(&buffer, cache->prefix,
+      XLAT_SCOPE_EXPORTED, kind, enum_id, ident);
+  }
+  else {
+    compose_xlat(&buffer, cache->prefix, scope, kind, enum_id, ident);
+  } /* end if */
+  xlat = store_in_cache(cache, &buffer);
+  
+  if (xlat == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* make room for a new entry */
+  if ((cache->entry_count + 1) * 100 >
+      cache->slot_count * XLAT_CACHE_MAX_LOAD_PERCENT) {
+    if (grow_cache(cache)) {
+      entry = &(cache->slot[
+        slot_index_for(cache, scope, kind, enum_id, ident)]);
+    }
+    else /* no room */ {
+      return xlat;
+    } /* end if */
+  } /* end if */
+  
+  entry->ident = ident;
+  entry->enum_id = enum_id;
+  entry->scope = (uint8_t) scope;
+  entry->kind = (uint8_t) kind;
+  entry->xlat = xlat;
+  cache->entry_count++;
+  
+  return xlat;
+} /* end cached_xlat */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,746 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-import-loader.c                                                       *
+ *                                                                           *
+ * Implementation of demand-driven loading of imported interfaces.           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-import-loader.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type import_state_t
+ * --------------------------------------------------------------------------
+ * Enumeration type representing the load state of an imported interface.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  IMPORT_PENDING,    /* interface not yet loaded */
+  IMPORT_LOADED,     /* interface loaded */
+  IMPORT_FAILED      /* interface could not be loaded */
+} import_state_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type import_entry_t
+ * --------------------------------------------------------------------------
+ * Record type representing a library of an import table.  Field reexported
+ * is set if the library is re-exported by the module of the table.  Field
+ * xlat holds the identifier translation cache of the library once it has
+ * been requested.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* module_id */   intstr_t module_id;
+  /* reexported */  bool reexported;
+  /* state */       import_state_t state;
+  /* symfile */     m2c_symfile_t symfile;
+  /* xlat */        m2c_ident_xlat_cache_t xlat;
+} import_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_import_table_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing an import table.  Array entry holds the libraries
+ * imported by the module in import order,  followed by the libraries found
+ * through re-exports of their interfaces in the order they were found.
+ * Field direct_count holds the number of the former.  Array slot is a hash
+ * table of indices into entry,  offset by one,  zero marks an empty slot.
+ * Its capacity is a power of two,  at least twice the capacity of entry,
+ * thus it never fills up.
+ * ----------------------------------------------------------------------- */
+
+#define IMPORT_TABLE_INITIAL_CAPACITY 16
+
+struct m2c_import_table_struct_t {
+  import_entry_t *entry;
+  uint_t count;
+  uint_t direct_count;
+  uint_t capacity;
+  uint_t *slot;
+  uint_t slot_capacity;
+  uint_t loaded_count;
+  m2c_import_open_f open;
+  void *context;
+  bool failed;
+};
+
+typedef struct m2c_import_table_struct_t m2c_import_table_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type reexport_context_t
+ * --------------------------------------------------------------------------
+ * Record type representing the state of m2c_import_record_reexports.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_symtab_t symtab;
+  m2c_import_status_t status;
+} reexport_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast);
+
+static void collect_imports
+  (m2c_import_table_t table, m2c_astnode_t node, bool reexported);
+
+static uint_t add_entry
+  (m2c_import_table_t table, intstr_t module_id, bool reexported);
+
+static uint_t entry_index (m2c_import_table_t table, intstr_t module_id);
+
+static uint_t find_reexporter (m2c_import_table_t table, intstr_t module_id);
+
+static m2c_symfile_t load_entry
+  (m2c_import_table_t table, uint_t index, m2c_import_status_t *status);
+
+static void record_module
+  (intstr_t ident, const m2c_sym_attr_t *attributes, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_import_table(module, open, context)
+ * --------------------------------------------------------------------------
+ * Collects the libraries imported and re-exported by module  and returns a
+ * new import table.  No interface is loaded.
+ *
+ * astnode: (IMPMOD moduleIdent (IMPLIST importNode+) blockNode)
+ *
+ * astnode: (INTERFACE identNode (IMPLIST importNode+) defDeclList)
+ *
+ * astnode: (IMPORT importListNode reExportListNode)
+ * ----------------------------------------------------------------------- */
+
+m2c_import_table_t m2c_new_import_table
+  (m2c_astnode_t module, m2c_import_open_f open, void *context) {
+  
+  m2c_import_table_t table;
+  m2c_astnode_t imp_list, imp_node;
+  unsigned short index, count;
+  
+  if (open == NULL) {
+    return NULL;
+  } /* end if */
+  
+  table = malloc(sizeof(m2c_import_table_struct_t));
+  
+  if (table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  table->entry = NULL;
+  table->count = 0;
+  table->direct_count = 0;
+  table->capacity = 0;
+  table->slot = NULL;
+  table->slot_capacity = 0;
+  table->loaded_count = 0;
+  table->open = open;
+  table->context = context;
+  table->failed = false;
+  
+  module = module_node(module);
+  imp_list = m2c_ast_subnode_at_index(module, 1);
+  count = m2c_ast_subnode_count(imp_list);
+  
+  for (index = 0; index < count; index++) {
+    imp_node = m2c_ast_subnode_at_index(imp_list, index);
+  
+    if (m2c_ast_nodetype(imp_node) == AST_IMPORT) {
+      collect_imports(table, m2c_ast_subnode_at_index(imp_node, 0), false);
+      collect_imports(table, m2c_ast_subnode_at_index(imp_node, 1), true);
+    } /* end if */
+  } /* end for */
+  
+  if (table->failed) {
+    m2c_release_import_table(table);
+    return NULL;
+  } /* end if */
+  
+  table->direct_count = table->count;
+  
+  return table;
+} /* end m2c_new_import_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_resolve(table, module_id, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Resolves the qualified identifier module_id.ident,  loading the interface
+ * of module_id on first use.
+ * ----------------------------------------------------------------------- */
+
+m2c_import_status_t m2c_import_resolve
+  (m2c_import_table_t table,
+   intstr_t module_id,
+   intstr_t ident,
+   m2c_sym_attr_t *attributes) {
+  
+  m2c_import_status_t status;
+  m2c_symfile_t symfile;
+  
+  if (ident == NULL) {
+    return M2C_IMPORT_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  symfile = m2c_import_interface(table, module_id, &status);
+  
+  if (symfile == NULL) {
+    return status;
+  } /* end if */
+  
+  switch (m2c_symfile_lookup(symfile, ident, attributes)) {
+    case M2C_SYMFILE_STATUS_SUCCESS :
+    case M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE :
+      return M2C_IMPORT_STATUS_SUCCESS;
+  
+    case M2C_SYMFILE_STATUS_IDENT_NOT_FOUND :
+      return M2C_IMPORT_STATUS_IDENT_NOT_FOUND;
+  
+    case M2C_SYMFILE_STATUS_INVALID_REFERENCE :
+      return M2C_IMPORT_STATUS_INVALID_REFERENCE;
+  
+    default :
+      return M2C_IMPORT_STATUS_LOAD_FAILED;
+  } /* end switch */
+} /* end m2c_import_resolve */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_interface(table, module_id, status)
+ * --------------------------------------------------------------------------
+ * Returns the symbol file of library module_id,  loading it on first use.
+ * A library not imported by the module is searched among the re-exports of
+ * the imported interfaces.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_import_interface
+  (m2c_import_table_t table,
+   intstr_t module_id,
+   m2c_import_status_t *status) {
+  
+  uint_t index;
+  
+  if ((table == NULL) || (module_id == NULL)) {
+    SET_STATUS(status, M2C_IMPORT_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  index = entry_index(table, module_id);
+  
+  if (index == 0) {
+    index = find_reexporter(table, module_id);
+  } /* end if */
+  
+  if (index == 0) {
+    if (table->failed) {
+      table->failed = false;
+      SET_STATUS(status, M2C_IMPORT_STATUS_ALLOCATION_FAILED);
+    }
+    else {
+      SET_STATUS(status, M2C_IMPORT_STATUS_UNKNOWN_MODULE);
+    } /* end if */
+    return NULL;
+  } /* end if */
+  
+  return load_entry(table, index - 1, status);
+} /* end m2c_import_interface */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_xlat_cache(table, module_id, status)
+ * --------------------------------------------------------------------------
+ * Returns the identifier translation cache of library module_id,  creating
+ * it from the C names recorded in its symbol file on first use.
+ * ----------------------------------------------------------------------- */
+
+m2c_ident_xlat_cache_t m2c_import_xlat_cache
+  (m2c_import_table_t table,
+   intstr_t module_id,
+   m2c_import_status_t *status) {
+  
+  m2c_ident_xlat_names_t names;
+  m2c_symfile_t symfile;
+  import_entry_t *entry;
+  
+  symfile = m2c_import_interface(table, module_id, status);
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* the entry exists once its interface is loaded */
+  entry = &table->entry[entry_index(table, module_id) - 1];
+  
+  if (entry->xlat == NULL) {
+    if (m2c_symfile_c_names(symfile, &names)) {
+      entry->xlat = m2c_ident_xlat_new_cache_with_names(module_id, &names);
+    }
+    else /* not recorded */ {
+      entry->xlat = m2c_ident_xlat_new_cache(module_id);
+    } /* end if */
+    
+    if (entry->xlat == NULL) {
+      SET_STATUS(status, M2C_IMPORT_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  return entry->xlat;
+} /* end m2c_import_xlat_cache */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_record_reexports(table, symtab)
+ * --------------------------------------------------------------------------
+ * Inserts the libraries re-exported by the module of table and by their
+ * interfaces into the current scope of symtab as module symbols.
+ * ----------------------------------------------------------------------- */
+
+m2c_import_status_t m2c_import_record_reexports
+  (m2c_import_table_t table, m2c_symtab_t symtab) {
+  
+  reexport_context_t reexport;
+  m2c_import_status_t status;
+  m2c_symfile_status_t visit_status;
+  m2c_symfile_t symfile;
+  uint_t index;
+  
+  if ((table == NULL) || (symtab == NULL)) {
+    return M2C_IMPORT_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  reexport.symtab = symtab;
+  reexport.status = M2C_IMPORT_STATUS_SUCCESS;
+  
+  for (index = 0; index < table->direct_count; index++) {
+    if (NOT(table->entry[index].reexported)) {
+      continue;
+    } /* end if */
+  
+    record_module(table->entry[index].module_id, NULL, &reexport);
+  
+    /* interfaces record their own re-exports transitively */
+    symfile = load_entry(table, index, &status);
+  
+    if (symfile == NULL) {
+      reexport.status = status;
+      continue;
+    } /* end if */
+  
+    visit_status = m2c_symfile_visit_kind
+      (symfile, M2C_SYMTYPE_MODULE, record_module, &reexport);
+  
+    if (visit_status == M2C_SYMFILE_STATUS_ALLOCATION_FAILED) {
+      reexport.status = M2C_IMPORT_STATUS_ALLOCATION_FAILED;
+    }
+    else if (visit_status != M2C_SYMFILE_STATUS_SUCCESS) {
+      reexport.status = M2C_IMPORT_STATUS_LOAD_FAILED;
+    } /* end if */
+  } /* end for */
+  
+  return reexport.status;
+} /* end m2c_import_record_reexports */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of libraries imported or re-exported by the module.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_import_count (m2c_import_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->direct_count;
+} /* end m2c_import_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_loaded_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of interfaces loaded so far.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_import_loaded_count (m2c_import_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->loaded_count;
+} /* end m2c_import_loaded_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_import_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the loaded symbol files and the translation caches of table and
+ * deallocates it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_import_table (m2c_import_table_t table) {
+  
+  uint_t index;
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < table->count; index++) {
+    if (table->entry[index].state == IMPORT_LOADED) {
+      m2c_release_symfile(table->entry[index].symfile);
+    } /* end if */
+    
+    m2c_ident_xlat_release_cache(table->entry[index].xlat);
+  } /* end for */
+  
+  free(table->entry);
+  free(table->slot);
+  free(table);
+} /* end m2c_release_import_table */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private macro KEY_HASH(key)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for the address of interned string key.
+ * ----------------------------------------------------------------------- */
+
+#define KEY_HASH(_key) \
+  ((uint_t) ((((uintptr_t) (_key)) >> 3) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private function module_node(ast)
+ * --------------------------------------------------------------------------
+ * Returns the module node of ast,  unwrapping a FILE node if present.
+ *
+ * astnode: (FILE (FNAME "Foobar.mod") (KEY 0xF04FC729) moduleNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast) {
+  
+  if (m2c_ast_nodetype(ast) == AST_FILE) {
+    return m2c_ast_subnode_at_index(ast, 2);
+  } /* end if */
+  
+  return ast;
+} /* end module_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_imports(table, node, reexported)
+ * --------------------------------------------------------------------------
+ * Adds the module identifiers held in the subtree of node to table,  marking
+ * them re-exported if reexported is true.
+ *
+ * astnode: (IDENT ident) | (IDENTLIST ident0 ident1 ident2 ... identN)
+ * ----------------------------------------------------------------------- */
+
+static void collect_imports
+  (m2c_import_table_t table, m2c_astnode_t node, bool reexported) {
+  
+  unsigned short index, count;
+  
+  count = m2c_ast_subnode_count(node);
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_IDENT :
+      add_entry(table, m2c_ast_value(node), reexported);
+      break;
+  
+    case AST_IDENTLIST :
+      for (index = 0; index < count; index++) {
+        add_entry(table, m2c_ast_value_at_index(node, index), reexported);
+      } /* end for */
+      break;
+  
+    default :
+      for (index = 0; index < count; index++) {
+        collect_imports(table,
+          m2c_ast_subnode_at_index(node, index), reexported);
+      } /* end for */
+      break;
+  } /* end switch */
+} /* end collect_imports */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_entry(table, module_id, reexported)
+ * --------------------------------------------------------------------------
+ * Appends a pending entry for module_id to table unless it is already
+ * present,  in which case it is marked re-exported if reexported is true,
+ * and returns its index plus one.  The entry array grows by doubling,  the
+ * hash table is then rebuilt.  Returns zero and sets field failed of table
+ * if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static uint_t add_entry
+  (m2c_import_table_t table, intstr_t module_id, bool reexported) {
+  
+  import_entry_t *new_entry;
+  uint_t *new_slot;
+  uint_t index, mask, slot, new_capacity, new_slot_capacity;
+  
+  if ((module_id == NULL) || (table->failed)) {
+    return 0;
+  } /* end if */
+  
+  index = entry_index(table, module_id);
+  
+  if (index != 0) {
+    table->entry[index - 1].reexported =
+      table->entry[index - 1].reexported || reexported;
+    return index;
+  } /* end if */
+  
+  if (table->count == table->capacity) {
+    new_capacity = (table->capacity == 0) ?
+      IMPORT_TABLE_INITIAL_CAPACITY : 2 * table->capacity;
+  
+    new_entry = realloc(table->entry, new_capacity * sizeof(import_entry_t));
+  
+    if (new_entry == NULL) {
+      table->failed = true;
+      return 0;
+    } /* end if */
+  
+    table->entry = new_entry;
+  
+    new_slot_capacity = 2 * new_capacity;
+    new_slot = calloc(new_slot_capacity, sizeof(uint_t));
+  
+    if (new_slot == NULL) {
+      table->failed = true;
+      return 0;
+    } /* end if */
+  
+    free(table->slot);
+    table->slot = new_slot;
+    table->slot_capacity = new_slot_capacity;
+    table->capacity = new_capacity;
+  
+    /* rehash the present entries */
+    mask = table->slot_capacity - 1;
+  
+    for (index = 0; index < table->count; index++) {
+      slot = KEY_HASH(table->entry[index].module_id) & mask;
+  
+      while (table->slot[slot] != 0) {
+        slot = (slot + 1) & mask;
+      } /* end while */
+  
+      table->slot[slot] = index + 1;
+    } /* end for */
+  } /* end if */
+  
+  index = table->count;
+  table->entry[index].module_id = module_id;
+  table->entry[index].reexported = reexported;
+  table->entry[index].state = IMPORT_PENDING;
+  table->entry[index].symfile = NULL;
+  table->entry[index].xlat = NULL;
+  table->count++;
+  
+  mask = table->slot_capacity - 1;
+  slot = KEY_HASH(module_id) & mask;
+  
+  while (table->slot[slot] != 0) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  table->slot[slot] = index + 1;
+  
+  return index + 1;
+} /* end add_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function entry_index(table, module_id)
+ * --------------------------------------------------------------------------
+ * Returns the index of the entry for module_id in table plus one,  or zero
+ * if table holds no entry for module_id.
+ * ----------------------------------------------------------------------- */
+
+static uint_t entry_index (m2c_import_table_t table, intstr_t module_id) {
+  
+  uint_t mask, slot;
+  
+  if (table->count == 0) {
+    return 0;
+  } /* end if */
+  
+  mask = table->slot_capacity - 1;
+  slot = KEY_HASH(module_id) & mask;
+  
+  while (table->slot[slot] != 0) {
+    if (table->entry[table->slot[slot] - 1].module_id == module_id) {
+      return table->slot[slot];
+    } /* end if */
+  
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return 0;
+} /* end entry_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_reexporter(table, module_id)
+ * --------------------------------------------------------------------------
+ * Searches the interfaces of table for one that re-exports module_id,  the
+ * loaded interfaces first,  then the pending ones,  loading them in turn.
+ * If found,  adds a pending entry for module_id and returns its index plus
+ * one,  otherwise returns zero.  Interfaces record libraries re-exported
+ * through other interfaces as their own,  thus each is searched once.
+ * ----------------------------------------------------------------------- */
+
+static uint_t find_reexporter (m2c_import_table_t table, intstr_t module_id) {
+  
+  m2c_sym_attr_t attributes;
+  m2c_symfile_t symfile;
+  uint_t pass, index, count;
+  
+  count = table->count;
+  
+  for (pass = 0; pass < 2; pass++) {
+    for (index = 0; index < count; index++) {
+  
+      /* loaded interfaces in the first pass, pending ones in the second */
+      if ((table->entry[index].state == IMPORT_FAILED) ||
+          ((pass == 0) && (table->entry[index].state != IMPORT_LOADED)) ||
+          ((pass == 1) && (table->entry[index].state != IMPORT_PENDING))) {
+        continue;
+      } /* end if */
+  
+      symfile = load_entry(table, index, NULL);
+  
+      if ((symfile != NULL) &&
+          (m2c_symfile_lookup(symfile, module_id, &attributes) ==
+           M2C_SYMFILE_STATUS_SUCCESS) &&
+          (attributes.kind == M2C_SYMTYPE_MODULE)) {
+        return add_entry(table, module_id, false);
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  return 0;
+} /* end find_reexporter */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_entry(table, index, status)
+ * --------------------------------------------------------------------------
+ * Returns the symbol file of the entry at index of table,  opening it with
+ * the open function of table if the entry is pending.  A failed open is not
+ * retried.  Returns NULL and passes M2C_IMPORT_STATUS_LOAD_FAILED in status,
+ * unless NULL,  on failure.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_t load_entry
+  (m2c_import_table_t table, uint_t index, m2c_import_status_t *status) {
+  
+  import_entry_t *entry;
+  
+  entry = &table->entry[index];
+  
+  if (entry->state == IMPORT_PENDING) {
+    entry->symfile = table->open(table->context, entry->module_id, NULL);
+  
+    if (entry->symfile != NULL) {
+      entry->state = IMPORT_LOADED;
+      table->loaded_count++;
+    }
+    else {
+      entry->state = IMPORT_FAILED;
+    } /* end if */
+  } /* end if */
+  
+  if (entry->state == IMPORT_FAILED) {
+    SET_STATUS(status, M2C_IMPORT_STATUS_LOAD_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_IMPORT_STATUS_SUCCESS);
+  return entry->symfile;
+} /* end load_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure record_module(ident, attributes, context)
+ * --------------------------------------------------------------------------
+ * Inserts ident as a module symbol into the current scope of the symbol
+ * table of the reexport context passed in context.  A symbol already
+ * present is left as it is.  Records allocation failure in the context.
+ * ----------------------------------------------------------------------- */
+
+static void record_module
+  (intstr_t ident, const m2c_sym_attr_t *attributes, void *context) {
+  
+  reexport_context_t *reexport = (reexport_context_t *) context;
+  
+  (void) attributes;
+  
+  if (m2c_symtab_insert(reexport->symtab,
+      ident, M2C_SYMTYPE_MODULE, NULL, NULL) ==
+      M2C_SYMTAB_STATUS_ALLOCATION_FAILED) {
+    reexport->status = M2C_IMPORT_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+} /* end record_module */
+
+
+/* END OF FILE */
@@ -0,0 +1,543 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-import-usage.c                                                        *
+ *                                                                           *
+ * Implementation of analysis of the use of imported modules.                *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-import-usage.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_import_usage_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing an import usage analysis.  The identifiers of
+ * the imports are held in import order in array ident,  their use in array
+ * used.  Array slot is a hash table of indices into ident,  offset by one,
+ * zero marks an empty slot.  Its capacity is a power of two,  at least
+ * twice the number of imports,  thus it never fills up.  Array used_ident
+ * holds the used imports once the analysis is complete.
+ * ----------------------------------------------------------------------- */
+
+#define IMPORT_LIST_INITIAL_CAPACITY 16
+
+struct m2c_import_usage_struct_t {
+  intstr_t *ident;
+  bool *used;
+  uint_t count;
+  uint_t capacity;
+  uint_t *slot;
+  uint_t slot_capacity;
+  intstr_t *used_ident;
+  uint_t used_count;
+  m2c_reachability_t reach;
+  bool failed;
+};
+
+typedef struct m2c_import_usage_struct_t m2c_import_usage_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast);
+
+static void collect_imports
+  (m2c_import_usage_t usage, m2c_astnode_t node, bool reexported);
+
+static bool build_slots (m2c_import_usage_t usage);
+
+static m2c_ast_visit_action_t mark_ref (m2c_astnode_t node, void *usage);
+
+static void mark_all (m2c_import_usage_t usage);
+
+static bool collect_used (m2c_import_usage_t usage);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_analyse_import_usage(module, reach)
+ * --------------------------------------------------------------------------
+ * Collects the imports of module,  then marks those referenced outside of
+ * the import list.
+ *
+ * astnode: (IMPMOD moduleIdent (IMPLIST importNode+) blockNode)
+ *
+ * astnode: (INTERFACE identNode (IMPLIST importNode+) defDeclList)
+ *
+ * astnode: (IMPORT importListNode reExportListNode)
+ * ----------------------------------------------------------------------- */
+
+m2c_import_usage_t m2c_analyse_import_usage
+  (m2c_astnode_t module, m2c_reachability_t reach) {
+  
+  m2c_import_usage_t usage;
+  m2c_astnode_t imp_list, imp_node;
+  unsigned short index, count;
+  
+  usage = malloc(sizeof(m2c_import_usage_struct_t));
+  
+  if (usage == NULL) {
+    return NULL;
+  } /* end if */
+  
+  usage->ident = NULL;
+  usage->used = NULL;
+  usage->count = 0;
+  usage->capacity = 0;
+  usage->slot = NULL;
+  usage->slot_capacity = 0;
+  usage->used_ident = NULL;
+  usage->used_count = 0;
+  usage->reach = reach;
+  usage->failed = false;
+  
+  module = module_node(module);
+  imp_list = m2c_ast_subnode_at_index(module, 1);
+  
+  /* collect imports, re-exports are used by clients */
+  count = m2c_ast_subnode_count(imp_list);
+  
+  for (index = 0; index < count; index++) {
+    imp_node = m2c_ast_subnode_at_index(imp_list, index);
+  
+    if (m2c_ast_nodetype(imp_node) == AST_IMPORT) {
+      collect_imports(usage, m2c_ast_subnode_at_index(imp_node, 0), false);
+      collect_imports(usage, m2c_ast_subnode_at_index(imp_node, 1), true);
+    } /* end if */
+  } /* end for */
+  
+  if ((usage->failed) || NOT(build_slots(usage))) {
+    m2c_release_import_usage(usage);
+    return NULL;
+  } /* end if */
+  
+  /* mark imports referenced outside of the import list */
+  if ((usage->count > 0) &&
+      NOT(m2c_ast_visit(module, mark_ref, NULL, usage))) {
+    /* traversal stopped at a lazy body or failed */
+    mark_all(usage);
+  } /* end if */
+  
+  if (NOT(collect_used(usage))) {
+    m2c_release_import_usage(usage);
+    return NULL;
+  } /* end if */
+  
+  return usage;
+} /* end m2c_analyse_import_usage */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_is_used(usage, module_id)
+ * --------------------------------------------------------------------------
+ * Returns false if module_id is imported but was found unused.
+ * ----------------------------------------------------------------------- */
+
+static uint_t import_index (m2c_import_usage_t usage, intstr_t ident);
+
+bool m2c_import_is_used (m2c_import_usage_t usage, intstr_t module_id) {
+  
+  uint_t index;
+  
+  if (usage == NULL) {
+    return true;
+  } /* end if */
+  
+  index = import_index(usage, module_id);
+  
+  return (index == 0) || (usage->used[index - 1]);
+} /* end m2c_import_is_used */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_used_imports(usage, count)
+ * --------------------------------------------------------------------------
+ * Returns an array with the identifiers of the used imports in import order
+ * and passes their number in count.
+ * ----------------------------------------------------------------------- */
+
+const intstr_t *m2c_used_imports (m2c_import_usage_t usage, uint_t *count) {
+  
+  if (usage == NULL) {
+    SET_STATUS(count, 0);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(count, usage->used_count);
+  
+  return usage->used_ident;
+} /* end m2c_used_imports */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unused_import_count(usage)
+ * --------------------------------------------------------------------------
+ * Returns the number of imports found unused.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_unused_import_count (m2c_import_usage_t usage) {
+  
+  if (usage == NULL) {
+    return 0;
+  } /* end if */
+  
+  return usage->count - usage->used_count;
+} /* end m2c_unused_import_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_import_usage(usage)
+ * --------------------------------------------------------------------------
+ * Deallocates usage.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_import_usage (m2c_import_usage_t usage) {
+  
+  if (usage == NULL) {
+    return;
+  } /* end if */
+  
+  free(usage->ident);
+  free(usage->used);
+  free(usage->slot);
+  free(usage->used_ident);
+  free(usage);
+  
+} /* end m2c_release_import_usage */
+
+
+/* *********************************************************************** *
+ * P R I V A T E   F U N C T I O N S                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private macro KEY_HASH(key)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for the address of interned string key.
+ * ----------------------------------------------------------------------- */
+
+#define KEY_HASH(_key) \
+  ((uint_t) ((((uintptr_t) (_key)) >> 3) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private function module_node(ast)
+ * --------------------------------------------------------------------------
+ * Returns the module node of ast,  unwrapping a FILE node if present.
+ *
+ * astnode: (FILE (FNAME "Foobar.mod") (KEY 0xF04FC729) moduleNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast) {
+  
+  if (m2c_ast_nodetype(ast) == AST_FILE) {
+    return m2c_ast_subnode_at_index(ast, 2);
+  } /* end if */
+  
+  return ast;
+} /* end module_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_import(usage, ident, used)
+ * --------------------------------------------------------------------------
+ * Appends ident to the imports of usage unless it is already listed,  and
+ * marks it used if used is true.  The arrays grow by doubling.  Sets field
+ * failed of usage if allocation failed.  Import lists are short,  thus
+ * duplicates are searched linearly.
+ * ----------------------------------------------------------------------- */
+
+static void add_import
+  (m2c_import_usage_t usage, intstr_t ident, bool used) {
+  
+  intstr_t *new_ident;
+  bool *new_used;
+  uint_t index, new_capacity;
+  
+  if ((ident == NULL) || (usage->failed)) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < usage->count; index++) {
+    if (usage->ident[index] == ident) {
+      usage->used[index] = usage->used[index] || used;
+      return;
+    } /* end if */
+  } /* end for */
+  
+  if (usage->count == usage->capacity) {
+    new_capacity = (usage->capacity == 0) ?
+      IMPORT_LIST_INITIAL_CAPACITY : 2 * usage->capacity;
+  
+    new_ident = realloc(usage->ident, new_capacity * sizeof(intstr_t));
+  
+    if (new_ident == NULL) {
+      usage->failed = true;
+      return;
+    } /* end if */
+  
+    usage->ident = new_ident;
+  
+    new_used = realloc(usage->used, new_capacity * sizeof(bool));
+  
+    if (new_used == NULL) {
+      usage->failed = true;
+      return;
+    } /* end if */
+  
+    usage->used = new_used;
+    usage->capacity = new_capacity;
+  } /* end if */
+  
+  usage->ident[usage->count] = ident;
+  usage->used[usage->count] = used;
+  usage->count++;
+  
+} /* end add_import */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_imports(usage, node, reexported)
+ * --------------------------------------------------------------------------
+ * Adds the module identifiers held in the subtree of node to the imports of
+ * usage,  marking them used if reexported is true.
+ *
+ * astnode: (IDENT ident) | (IDENTLIST ident0 ident1 ident2 ... identN)
+ * ----------------------------------------------------------------------- */
+
+static void collect_imports
+  (m2c_import_usage_t usage, m2c_astnode_t node, bool reexported) {
+  
+  unsigned short index, count;
+  
+  count = m2c_ast_subnode_count(node);
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_IDENT :
+      add_import(usage, m2c_ast_value(node), reexported);
+      break;
+  
+    case AST_IDENTLIST :
+      for (index = 0; index < count; index++) {
+        add_import(usage, m2c_ast_value_at_index(node, index), reexported);
+      } /* end for */
+      break;
+  
+    default :
+      for (index = 0; index < count; index++) {
+        collect_imports(usage,
+          m2c_ast_subnode_at_index(node, index), reexported);
+      } /* end for */
+      break;
+  } /* end switch */
+} /* end collect_imports */
+
+
+/* --------------------------------------------------------------------------
+ * private function build_slots(usage)
+ * --------------------------------------------------------------------------
+ * Builds the hash table of the imports of usage.  Returns false if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool build_slots (m2c_import_usage_t usage) {
+  
+  uint_t index, mask, slot;
+  
+  usage->slot_capacity = IMPORT_LIST_INITIAL_CAPACITY;
+  
+  while (usage->slot_capacity < (2 * usage->count)) {
+    usage->slot_capacity = 2 * usage->slot_capacity;
+  } /* end while */
+  
+  usage->slot = calloc(usage->slot_capacity, sizeof(uint_t));
+  
+  if (usage->slot == NULL) {
+    return false;
+  } /* end if */
+  
+  mask = usage->slot_capacity - 1;
+  
+  for (index = 0; index < usage->count; index++) {
+    slot = KEY_HASH(usage->ident[index]) & mask;
+  
+    while (usage->slot[slot] != 0) {
+      slot = (slot + 1) & mask;
+    } /* end while */
+  
+    usage->slot[slot] = index + 1;
+  } /* end for */
+  
+  return true;
+} /* end build_slots */
+
+
+/* --------------------------------------------------------------------------
+ * private function import_index(usage, ident)
+ * --------------------------------------------------------------------------
+ * Returns the index of import ident in usage plus one,  or zero if ident is
+ * not imported.
+ * ----------------------------------------------------------------------- */
+
+static uint_t import_index (m2c_import_usage_t usage, intstr_t ident) {
+  
+  uint_t mask, slot;
+  
+  if ((ident == NULL) || (usage->count == 0)) {
+    return 0;
+  } /* end if */
+  
+  mask = usage->slot_capacity - 1;
+  slot = KEY_HASH(ident) & mask;
+  
+  while (usage->slot[slot] != 0) {
+    if (usage->ident[usage->slot[slot] - 1] == ident) {
+      return usage->slot[slot];
+    } /* end if */
+  
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return 0;
+} /* end import_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function mark_ref(node, usage)
+ * --------------------------------------------------------------------------
+ * Visitor callback to mark the import referenced by node,  if any.  Import
+ * lists and unreachable definitions are skipped.  An unparsed lazy body
+ * hides its references,  the traversal stops.
+ *
+ * astnode: (IDENT ident) | (QUALIDENT q0 q1 q2 ... qN ident)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t mark_ref (m2c_astnode_t node, void *usage) {
+  
+  m2c_import_usage_t u = (m2c_import_usage_t) usage;
+  uint_t index;
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_IDENT :
+    case AST_QUALIDENT :
+      index = import_index(u, m2c_ast_value(node));
+  
+      if (index != 0) {
+        u->used[index - 1] = true;
+      } /* end if */
+      break;
+  
+    case AST_IMPLIST :
+      return M2C_AST_VISIT_SKIP;
+  
+    case AST_CONST :
+    case AST_TYPEDEF :
+    case AST_VARDEF :
+    case AST_PROC :
+      if (NOT(m2c_is_reachable(u->reach, node))) {
+        return M2C_AST_VISIT_SKIP;
+      } /* end if */
+      break;
+  
+    case AST_LAZYBODY :
+      return M2C_AST_VISIT_STOP;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end mark_ref */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure mark_all(usage)
+ * --------------------------------------------------------------------------
+ * Marks all imports of usage used.
+ * ----------------------------------------------------------------------- */
+
+static void mark_all (m2c_import_usage_t usage) {
+  
+  uint_t index;
+  
+  for (index = 0; index < usage->count; index++) {
+    usage->used[index] = true;
+  } /* end for */
+  
+} /* end mark_all */
+
+
+/* --------------------------------------------------------------------------
+ * private function collect_used(usage)
+ * --------------------------------------------------------------------------
+ * Collects the used imports of usage in import order.  Returns false if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool collect_used (m2c_import_usage_t usage) {
+  
+  uint_t index;
+  
+  if (usage->count == 0) {
+    return true;
+  } /* end if */
+  
+  usage->used_ident = malloc(usage->count * sizeof(intstr_t));
+  
+  if (usage->used_ident == NULL) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < usage->count; index++) {
+    if (usage->used[index]) {
+      usage->used_ident[usage->used_count] = usage->ident[index];
+      usage->used_count++;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end collect_used */
+
+
+/* END OF FILE */
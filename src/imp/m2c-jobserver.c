@@ -0,0 +1,508 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-jobserver.c                                                           *
+ *                                                                           *
+ * Implementation of GNU make jobserver client and server.                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* setenv */
+#endif
+
+#include "m2c-jobserver.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (M2C_JOBSERVER_AVAILABLE)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Token byte written by a server
+ * ----------------------------------------------------------------------- */
+
+#define SERVER_TOKEN '+'
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a jobserver fifo path
+ * ----------------------------------------------------------------------- */
+
+#define MAX_FIFO_PATH_LENGTH 256
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_jobserver_s
+ * --------------------------------------------------------------------------
+ * Record type representing a jobserver connection.  Fields read_fd and
+ * write_fd are the descriptors of the token pipe,  both are the same for a
+ * fifo.  Field owns_fds is true if the descriptors were opened here and are
+ * closed on release.  Field prior_makeflags holds the value of MAKEFLAGS
+ * before a server announced itself,  or NULL if it was not set.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_jobserver_s {
+  /* read_fd */          int read_fd;
+  /* write_fd */         int write_fd;
+  /* owns_fds */         bool owns_fds;
+  /* is_server */        bool is_server;
+  /* prior_makeflags */  char *prior_makeflags;
+};
+
+typedef struct m2c_jobserver_s m2c_jobserver_s;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_JOBSERVER_AVAILABLE)
+static const char *find_last (const char *string, const char *pattern);
+
+static m2c_jobserver_t new_jobserver (int read_fd, int write_fd);
+
+static bool announce_server (m2c_jobserver_t jobserver, uint_t jobs);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_connect()
+ * --------------------------------------------------------------------------
+ * Connects to the jobserver announced in MAKEFLAGS,  returns NULL if none.
+ * ----------------------------------------------------------------------- */
+
+m2c_jobserver_t m2c_jobserver_connect (void) {
+  
+#if (M2C_JOBSERVER_AVAILABLE)
+  const char *makeflags, *auth, *value;
+  char path[MAX_FIFO_PATH_LENGTH];
+  m2c_jobserver_t jobserver;
+  long read_fd, write_fd;
+  uint_t length;
+  char *end;
+  int fd;
+  
+  makeflags = getenv("MAKEFLAGS");
+  
+  if (makeflags == NULL) {
+    return NULL;
+  } /* end if */
+  
+  auth = find_last(makeflags, "--jobserver-auth=");
+  value = (auth != NULL) ? auth + strlen("--jobserver-auth=") : NULL;
+  
+  if (auth == NULL) {
+    auth = find_last(makeflags, "--jobserver-fds=");
+    value = (auth != NULL) ? auth + strlen("--jobserver-fds=") : NULL;
+  } /* end if */
+  
+  if (value == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* fifo:PATH */
+  if (strncmp(value, "fifo:", 5) == 0) {
+    value = value + 5;
+    length = 0;
+    while ((value[length] != ASCII_NUL) && (value[length] != ' ') &&
+           (length < sizeof(path) - 1)) {
+      path[length] = value[length];
+      length++;
+    } /* end while */
+    path[length] = ASCII_NUL;
+    
+    fd = open(path, O_RDWR | O_NONBLOCK);
+    
+    if (fd < 0) {
+      return NULL;
+    } /* end if */
+    
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    jobserver = new_jobserver(fd, fd);
+    
+    if (jobserver == NULL) {
+      close(fd);
+      return NULL;
+    } /* end if */
+    
+    jobserver->owns_fds = true;
+    return jobserver;
+  } /* end if */
+  
+  /* R,W */
+  read_fd = strtol(value, &end, 10);
+  
+  if ((end == value) || (*end != ',')) {
+    return NULL;
+  } /* end if */
+  
+  value = end + 1;
+  write_fd = strtol(value, &end, 10);
+  
+  if ((end == value) || (read_fd < 0) || (write_fd < 0)) {
+    return NULL;
+  } /* end if */
+  
+  /* make withholds the descriptors from commands not marked as recursive */
+  if ((fcntl((int) read_fd, F_GETFD) < 0) ||
+      (fcntl((int) write_fd, F_GETFD) < 0)) {
+    return NULL;
+  } /* end if */
+  
+  return new_jobserver((int) read_fd, (int) write_fd);
+#else
+  return NULL;
+#endif
+} /* end m2c_jobserver_connect */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_new_server(jobs, status)
+ * --------------------------------------------------------------------------
+ * Creates and announces a jobserver for jobs concurrent jobs.
+ * ----------------------------------------------------------------------- */
+
+m2c_jobserver_t m2c_jobserver_new_server
+  (uint_t jobs, m2c_jobserver_status_t *status) {
+  
+#if (M2C_JOBSERVER_AVAILABLE)
+  m2c_jobserver_t jobserver;
+  char token;
+  uint_t count;
+  int fd[2];
+  
+  if (jobs < 2) {
+    SET_STATUS(status, M2C_JOBSERVER_STATUS_SUCCESS);
+    return NULL;
+  } /* end if */
+  
+  /* the descriptors are inherited by child processes */
+  if (pipe(fd) < 0) {
+    SET_STATUS(status, M2C_JOBSERVER_STATUS_IO_ERROR);
+    return NULL;
+  } /* end if */
+  
+  jobserver = new_jobserver(fd[0], fd[1]);
+  
+  if (jobserver == NULL) {
+    close(fd[0]);
+    close(fd[1]);
+    SET_STATUS(status, M2C_JOBSERVER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  jobserver->owns_fds = true;
+  
+  /* one token per job beyond the implicit one */
+  token = SERVER_TOKEN;
+  for (count = 1; count < jobs; count++) {
+    if (write(fd[1], &token, 1) != 1) {
+      m2c_jobserver_release(&jobserver);
+      SET_STATUS(status, M2C_JOBSERVER_STATUS_IO_ERROR);
+      return NULL;
+    } /* end if */
+  } /* end for */
+  
+  if (NOT(announce_server(jobserver, jobs))) {
+    m2c_jobserver_release(&jobserver);
+    SET_STATUS(status, M2C_JOBSERVER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* MAKEFLAGS is restored on release */
+  jobserver->is_server = true;
+  
+  SET_STATUS(status, M2C_JOBSERVER_STATUS_SUCCESS);
+  return jobserver;
+#else
+  (void) jobs;
+  SET_STATUS(status, M2C_JOBSERVER_STATUS_NOT_AVAILABLE);
+  return NULL;
+#endif
+} /* end m2c_jobserver_new_server */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_for_jobs(jobs, status)
+ * --------------------------------------------------------------------------
+ * Connects to the jobserver of make,  or creates a server of its own.
+ * ----------------------------------------------------------------------- */
+
+m2c_jobserver_t m2c_jobserver_for_jobs
+  (uint_t jobs, m2c_jobserver_status_t *status) {
+  
+  m2c_jobserver_t jobserver;
+  
+  jobserver = m2c_jobserver_connect();
+  
+  if (jobserver != NULL) {
+    SET_STATUS(status, M2C_JOBSERVER_STATUS_SUCCESS);
+    return jobserver;
+  } /* end if */
+  
+  return m2c_jobserver_new_server(jobs, status);
+} /* end m2c_jobserver_for_jobs */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_is_server(jobserver)
+ * --------------------------------------------------------------------------
+ * Returns true if jobserver is a server of its own.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_jobserver_is_server (m2c_jobserver_t jobserver) {
+  
+  return (jobserver != NULL) && (jobserver->is_server);
+} /* end m2c_jobserver_is_server */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_acquire(jobserver, timeout, token)
+ * --------------------------------------------------------------------------
+ * Waits up to timeout milliseconds for a token of jobserver.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_jobserver_acquire
+  (m2c_jobserver_t jobserver, int timeout, char *token) {
+  
+#if (M2C_JOBSERVER_AVAILABLE)
+  struct pollfd request;
+  ssize_t got;
+  
+  if ((jobserver == NULL) || (token == NULL)) {
+    return false;
+  } /* end if */
+  
+  request.fd = jobserver->read_fd;
+  request.events = POLLIN;
+  
+  do {
+    request.revents = 0;
+    
+    if (poll(&request, 1, timeout) <= 0) {
+      return false;
+    } /* end if */
+    
+    /* another client may have taken the token since,  a fifo does not block */
+    got = read(jobserver->read_fd, token, 1);
+  } while ((got < 0) && (errno == EAGAIN) && (timeout < 0));
+  
+  return (got == 1);
+#else
+  (void) jobserver;
+  (void) timeout;
+  (void) token;
+  return false;
+#endif
+} /* end m2c_jobserver_acquire */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_jobserver_return(jobserver, token)
+ * --------------------------------------------------------------------------
+ * Returns token to jobserver.
+ * ----------------------------------------------------------------------- */
+
+void m2c_jobserver_return (m2c_jobserver_t jobserver, char token) {
+  
+#if (M2C_JOBSERVER_AVAILABLE)
+  if (jobserver == NULL) {
+    return;
+  } /* end if */
+  
+  while ((write(jobserver->write_fd, &token, 1) < 0) && (errno == EINTR)) {
+    /* retry */
+  } /* end while */
+#else
+  (void) jobserver;
+  (void) token;
+#endif
+} /* end m2c_jobserver_return */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_jobserver_release(jobserver)
+ * --------------------------------------------------------------------------
+ * Disconnects from or shuts down jobserver and passes NULL in jobserver.
+ * ----------------------------------------------------------------------- */
+
+void m2c_jobserver_release (m2c_jobserver_t *jobserver) {
+  
+  if ((jobserver == NULL) || (*jobserver == NULL)) {
+    return;
+  } /* end if */
+  
+#if (M2C_JOBSERVER_AVAILABLE)
+  if ((*jobserver)->is_server) {
+    if ((*jobserver)->prior_makeflags != NULL) {
+      setenv("MAKEFLAGS", (*jobserver)->prior_makeflags, 1);
+    }
+    else {
+      unsetenv("MAKEFLAGS");
+    } /* end if */
+  } /* end if */
+  
+  if ((*jobserver)->owns_fds) {
+    close((*jobserver)->read_fd);
+    if ((*jobserver)->write_fd != (*jobserver)->read_fd) {
+      close((*jobserver)->write_fd);
+    } /* end if */
+  } /* end if */
+#endif
+  
+  free((*jobserver)->prior_makeflags);
+  free(*jobserver);
+  *jobserver = NULL;
+} /* end m2c_jobserver_release */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#if (M2C_JOBSERVER_AVAILABLE)
+
+/* --------------------------------------------------------------------------
+ * private function find_last(string, pattern)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the last occurrence of pattern in string,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+static const char *find_last (const char *string, const char *pattern) {
+  
+  const char *found, *next;
+  
+  found = NULL;
+  next = strstr(string, pattern);
+  
+  while (next != NULL) {
+    found = next;
+    next = strstr(next + 1, pattern);
+  } /* end while */
+  
+  return found;
+} /* end find_last */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_jobserver(read_fd, write_fd)
+ * --------------------------------------------------------------------------
+ * Returns a new client connection for descriptors read_fd and write_fd that
+ * does not own them,  or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static m2c_jobserver_t new_jobserver (int read_fd, int write_fd) {
+  
+  m2c_jobserver_t jobserver;
+  
+  jobserver = malloc(sizeof(m2c_jobserver_s));
+  
+  if (jobserver == NULL) {
+    return NULL;
+  } /* end if */
+  
+  jobserver->read_fd = read_fd;
+  jobserver->write_fd = write_fd;
+  jobserver->owns_fds = false;
+  jobserver->is_server = false;
+  jobserver->prior_makeflags = NULL;
+  
+  return jobserver;
+} /* end new_jobserver */
+
+
+/* --------------------------------------------------------------------------
+ * private function announce_server(jobserver, jobs)
+ * --------------------------------------------------------------------------
+ * Appends -j and --jobserver-auth options for server jobserver to MAKEFLAGS,
+ * saving its prior value in jobserver.  The pipe style is announced,  it is
+ * understood by all clients since GNU make 4.2.  Returns true on success,
+ * false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool announce_server (m2c_jobserver_t jobserver, uint_t jobs) {
+  
+  const char *makeflags;
+  char *new_makeflags;
+  size_t size;
+  int result;
+  
+  makeflags = getenv("MAKEFLAGS");
+  
+  if (makeflags != NULL) {
+    jobserver->prior_makeflags = malloc(strlen(makeflags) + 1);
+    
+    if (jobserver->prior_makeflags == NULL) {
+      return false;
+    } /* end if */
+    
+    strcpy(jobserver->prior_makeflags, makeflags);
+  }
+  else {
+    makeflags = "";
+  } /* end if */
+  
+  /* prior flags, blank, -j, two descriptors and the option names */
+  size = strlen(makeflags) + 3 * 20 + sizeof(" -j --jobserver-auth=,");
+  new_makeflags = malloc(size);
+  
+  if (new_makeflags == NULL) {
+    return false;
+  } /* end if */
+  
+  snprintf(new_makeflags, size, "%s%s-j%u --jobserver-auth=%d,%d",
+    makeflags, (makeflags[0] != ASCII_NUL) ? " " : "",
+    (unsigned) jobs, jobserver->read_fd, jobserver->write_fd);
+  
+  result = setenv("MAKEFLAGS", new_makeflags, 1);
+  free(new_makeflags);
+  
+  return (result == 0);
+} /* end announce_server */
+
+#endif /* M2C_JOBSERVER_AVAILABLE */
+
+
+/* END OF FILE */
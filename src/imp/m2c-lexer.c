@@ -45,13 +45,17 @@
 #include "infile.h"
 
 #include "m2c-lexer.h"
-#include "m2c-error.h"
+#include "m2c-error-reporter.h"
 #include "m2c-digest.h"
 #include "m2c-match-lex.h"
+#include "m2c-char-class.h"
+#include "m2c-ident-class.h"
 #include "m2c-compiler-options.h"
 
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 
 /* --------------------------------------------------------------------------
@@ -65,6 +69,8 @@ typedef struct {
   m2c_token_t token;
   unsigned int line;
   unsigned int column;
+  m2c_numeric_value_t value;
+  infile_slice_t slice;
 } m2c_symbol_struct_t;
 
 
@@ -76,17 +82,122 @@ static const m2c_symbol_struct_t nullsym = {
   /* lexeme */ NULL,
   /* token */ TOKEN_UNKNOWN,
   /* line */ 0,
-  /* column */ 0
+  /* column */ 0,
+  /* value */ M2C_NUMERIC_VALUE_NONE,
+  /* slice */ INFILE_SLICE_NONE
 }; /* null_symbol */
 
 
+/* --------------------------------------------------------------------------
+ * private type m2c_token_stream_s
+ * --------------------------------------------------------------------------
+ * record type holding a pre-tokenised source file.
+ *
+ * Each symbol is stored as a packed 64-bit token record,  holding its token
+ * in bits 0-7,  its column in bits 8-15,  its line in bits 16-35  and the
+ * index of its lexeme in the lexeme table of the stream in bits 36-63.  All
+ * token values are less than 256.  Columns beyond the limit of M2C_MAX_IN-
+ * FILE_COLUMNS are clamped to 255.  Lexeme index zero denotes no lexeme.
+ *
+ * The lexeme table holds each distinct lexeme of the stream once,  together
+ * with one reference to it.  It is indexed by an open addressing table of
+ * lexeme indices keyed by the hash of the lexeme,  whose capacity is twice
+ * that of the lexeme table.  A source file cannot hold more than the number
+ * of lexemes that fits into the lexeme index of a token record.
+ *
+ * Index current refers to the most recently consumed symbol,  the symbol
+ * at index lookahead is the lookahead symbol.  The last symbol is EOF.
+ *
+ * Numeric literals are comparatively rare,  their values are therefore not
+ * kept in the token records but in a side table  ordered by symbol index,
+ * which is searched by bisection.  Likewise, string literals and comments
+ * that refer to the source buffer by slice are kept in a slice table.  Their
+ * lexemes are only interned on demand,  the source file is then kept open.
+ * ----------------------------------------------------------------------- */
+
+#define TOKEN_STREAM_INITIAL_CAPACITY 1024
+
+#define RECORD_COLUMN_SHIFT 8
+
+#define RECORD_LINE_SHIFT 16
+
+#define RECORD_LEXEME_SHIFT 36
+
+#define RECORD_MAX_COLUMN 0xFFu
+
+#define RECORD_MAX_LINE 0xFFFFFu
+
+#define RECORD_MAX_LEXEME 0xFFFFFFFu
+
+#define PACK_RECORD(_token, _line, _col, _lexeme) \
+  ((uint64_t) (uint8_t) (_token) | \
+   ((uint64_t) (((_col) > RECORD_MAX_COLUMN) ? \
+     RECORD_MAX_COLUMN : (_col)) << RECORD_COLUMN_SHIFT) | \
+   ((uint64_t) (((_line) > RECORD_MAX_LINE) ? \
+     RECORD_MAX_LINE : (_line)) << RECORD_LINE_SHIFT) | \
+   ((uint64_t) (_lexeme) << RECORD_LEXEME_SHIFT))
+
+#define RECORD_TOKEN(_rec) ((m2c_token_t) ((_rec) & 0xFFu))
+
+#define RECORD_COLUMN(_rec) \
+  ((uint_t) (((_rec) >> RECORD_COLUMN_SHIFT) & RECORD_MAX_COLUMN))
+
+#define RECORD_LINE(_rec) \
+  ((uint_t) (((_rec) >> RECORD_LINE_SHIFT) & RECORD_MAX_LINE))
+
+#define RECORD_LEXEME(_rec) ((uint32_t) ((_rec) >> RECORD_LEXEME_SHIFT))
+
+#define WITH_RECORD_LEXEME(_rec, _lexeme) \
+  (((_rec) & ~((uint64_t) RECORD_MAX_LEXEME << RECORD_LEXEME_SHIFT)) | \
+   ((uint64_t) (_lexeme) << RECORD_LEXEME_SHIFT))
+
+#define STREAM_LEXEME(_stream, _index) \
+  ((_stream)->lexeme[RECORD_LEXEME((_stream)->record[_index])])
+
+#if (M2C_MAX_INFILE_LINES > RECORD_MAX_LINE)
+#error "M2C_MAX_INFILE_LINES exceeds the line field of token records"
+#endif
+
+#define LEXEME_TABLE_INITIAL_CAPACITY 256
+
+#define VALUE_TABLE_INITIAL_CAPACITY 64
+
+#define SLICE_TABLE_INITIAL_CAPACITY 64
+
+#define IS_NUMERIC_VALUE_TOKEN(_t) \
+  ((((_t) >= FIRST_NUMBER_LITERAL_TOKEN) && \
+    ((_t) <= LAST_NUMBER_LITERAL_TOKEN)) || ((_t) == TOKEN_CHAR_CODE))
+
+typedef struct {
+  uint_t count;
+  uint_t capacity;
+  uint_t current;
+  uint_t lookahead;
+  uint64_t *record;
+  uint_t lexeme_count;
+  uint_t lexeme_capacity;
+  intstr_t *lexeme;
+  uint32_t *lexeme_slot;
+  uint_t value_count;
+  uint_t value_capacity;
+  uint_t *value_index;
+  m2c_numeric_value_t *value;
+  uint_t slice_count;
+  uint_t slice_capacity;
+  uint_t *slice_index;
+  infile_slice_t *slice;
+} m2c_token_stream_s;
+
+typedef m2c_token_stream_s *m2c_token_stream_t;
+
+
 /* --------------------------------------------------------------------------
  * private type match_handler_t
  * --------------------------------------------------------------------------
  * function type for lexical matching function.
  * ----------------------------------------------------------------------- */
 
-typedef char (*match_handler_t) (infile_t, *m2c_token_t, *intstr_t);
+typedef char (*match_handler_t) (infile_t, m2c_token_t *, intstr_t *);
 
 
 /* --------------------------------------------------------------------------
@@ -96,12 +207,19 @@ typedef char (*match_handler_t) (infile_t, *m2c_token_t, *intstr_t);
  * ----------------------------------------------------------------------- */
 
 struct m2c_lexer_struct_t {
-  m2c_infile_t infile;
+  infile_t infile;
+  intstr_t filename;
+  m2c_token_stream_t stream;
+  m2c_token_stream_t spare_stream;
   m2c_symbol_struct_t current;
   m2c_symbol_struct_t lookahead;
+  uint_t symbol_index;
   m2c_lexer_status_t status;
-  m2c_digest_context_t digest;
+  m2c_digest_s digest;
   m2c_digest_mode_t digest_mode;
+  m2c_digest_s decl_digest;
+  m2c_digest_mode_t decl_digest_mode;
+  bool decl_digest_active;
   match_handler_t match_ident;
   match_handler_t match_ident_or_resword;
 }; /* m2c_lexer_struct_t */
@@ -109,6 +227,52 @@ struct m2c_lexer_struct_t {
 typedef struct m2c_lexer_struct_t m2c_lexer_struct_t;
 
 
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void get_new_lookahead_sym (m2c_lexer_t lexer);
+
+static void update_decl_digest (m2c_lexer_t lexer);
+
+static bool append_lookahead_sym (m2c_token_stream_t stream, m2c_lexer_t lexer);
+
+static bool grow_token_stream (m2c_token_stream_t stream);
+
+static bool add_lexeme
+  (m2c_token_stream_t stream, intstr_t lexeme, uint32_t *index);
+
+static bool grow_lexeme_table (m2c_token_stream_t stream);
+
+static intstr_t lexeme_at_index (m2c_lexer_t lexer, uint_t index);
+
+static bool append_value
+  (m2c_token_stream_t stream, uint_t index, m2c_numeric_value_t value);
+
+static m2c_numeric_value_t value_at_index
+  (m2c_token_stream_t stream, uint_t index);
+
+static bool append_slice
+  (m2c_token_stream_t stream, uint_t index, infile_slice_t slice);
+
+static infile_slice_t slice_at_index
+  (m2c_token_stream_t stream, uint_t index);
+
+static intstr_t lexeme_for_slice
+  (m2c_lexer_t lexer, intstr_t *lexeme, infile_slice_t slice);
+
+static const char *text_for_symbol
+  (m2c_lexer_t lexer, intstr_t lexeme, infile_slice_t slice, uint_t *length);
+
+static void clear_token_stream (m2c_token_stream_t stream);
+
+static void release_token_stream (m2c_token_stream_t stream);
+
+static void init_lexer_state (m2c_lexer_t lexer, intstr_t filename);
+
+static m2c_lexer_status_t lexer_status_for (infile_status_t infile_status);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_new_lexer(lexer, filename, status)
  * --------------------------------------------------------------------------
@@ -134,8 +298,101 @@ typedef struct m2c_lexer_struct_t m2c_lexer_struct_t;
  *    status M2C_LEXER_STATUS_ALLOCATION_FAILED is returned
  * ----------------------------------------------------------------------- */
 
+static void open_lexer
+  (m2c_lexer_t *lexer, intstr_t filename, bool header_only,
+   m2c_lexer_status_t *status);
+
 void m2c_new_lexer
   (m2c_lexer_t *lexer, intstr_t filename, m2c_lexer_status_t *status) {
+  
+  open_lexer(lexer, filename, false, status);
+  
+} /* end m2c_new_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_new_header_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_new_lexer  but opens the input file for reading of a prefix,  so
+ * that only as much of the file is read as has been lexed.
+ * ----------------------------------------------------------------------- */
+
+void m2c_new_header_lexer
+  (m2c_lexer_t *lexer, intstr_t filename, m2c_lexer_status_t *status) {
+  
+  open_lexer(lexer, filename, true, status);
+  
+} /* end m2c_new_header_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_new_text_lexer(lexer, filename, text, length, ...)
+ * --------------------------------------------------------------------------
+ * Allocates a new lexer object that reads a copy of the length characters
+ * at text with lines counted from first_line  and passes it back in lexer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_new_text_lexer
+  (m2c_lexer_t *lexer,                /* out */
+   intstr_t filename,                 /* in */
+   const char *text,                  /* in */
+   size_t length,                     /* in */
+   uint_t first_line,                 /* in */
+   m2c_lexer_status_t *status) {      /* out */
+  
+  infile_t infile;
+  m2c_lexer_t new_lexer;
+  infile_status_t infile_status;
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (filename == NULL) ||
+      ((text == NULL) && (length > 0))) {
+    SET_STATUS(status, M2C_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  new_lexer = malloc(sizeof(m2c_lexer_struct_t));
+  
+  if (new_lexer == NULL) {
+    SET_STATUS(status, M2C_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* classify lexemes once when they are interned */
+  m2c_ident_class_init();
+  
+  /* copy source text */
+  infile_open_text(&infile, text, length, first_line, &infile_status);
+  
+  if (infile_status != FILEIO_STATUS_SUCCESS) {
+    SET_STATUS(status, lexer_status_for(infile_status));
+    free(new_lexer);
+    return;
+  } /* end if */
+  
+  /* initialise lexer object */
+  new_lexer->infile = infile;
+  new_lexer->stream = NULL;
+  new_lexer->spare_stream = NULL;
+  init_lexer_state(new_lexer, filename);
+  
+  *lexer = new_lexer;
+  SET_STATUS(status, M2C_LEXER_STATUS_SUCCESS);
+  return;
+} /* end m2c_new_text_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure open_lexer(lexer, filename, header_only, status)
+ * --------------------------------------------------------------------------
+ * Allocates a new lexer object for the file represented by filename  and
+ * passes it back in lexer.  If header_only is true,  the file is opened for
+ * reading of a prefix.
+ * ----------------------------------------------------------------------- */
+
+static void open_lexer
+  (m2c_lexer_t *lexer, intstr_t filename, bool header_only,
+   m2c_lexer_status_t *status) {
    
    infile_t infile;
    m2c_lexer_t new_lexer;
@@ -154,51 +411,131 @@ void m2c_new_lexer
      return;
    } /* end if */
    
+   /* classify lexemes once when they are interned */
+   m2c_ident_class_init();
+   
    /* open source file */
-   infile = infile_open(filename, &infile_status);
+   if (header_only) {
+     infile_open_prefix(&infile, intstr_char_ptr(filename), &infile_status);
+   }
+   else /* whole file */ {
+     infile_open(&infile, intstr_char_ptr(filename), &infile_status);
+   } /* end if */
    
   if (infile_status != FILEIO_STATUS_SUCCESS) {
-    switch (infile_status) {
-      case FILEIO_INVALID_FILENAME :
-        SET_STATUS(status, M2C_LEXER_STATUS_INVALID_FILENAME);
-        break;
-      case FILEIO_STATUS_FILE_NOT_FOUND :
-        SET_STATUS(status, M2C_LEXER_STATUS_FILE_NOT_FOUND);
-        break;
-      case FILEIO_STATUS_ACCESS_DENIED :
-        SET_STATUS(status, M2C_LEXER_STATUS_FILE_ACCESS_DENIED);
-        break;
-      case FILEIO_STATUS_DEVICE_ERROR :
-        SET_STATUS(status, M2C_LEXER_STATUS_DEVICE_ERROR);
-        break;
-    } /* end switch */
+    SET_STATUS(status, lexer_status_for(infile_status));
     free(new_lexer);
     return;
   } /* end if */
    
    /* initialise lexer object */
    new_lexer->infile = infile;
-   new_lexer->current = nullsym;
-   new_lexer->lookahead = nullsym;
-   new_lexer->digest = m2c_digest_init();
-   new_lexer->digest_mode = M2C_DIGEST_DONT_PREPEND_SPACER;
-   
-   if (m2c_compiler_option_dollar_identifiers()) {
-    new_lexer->match_ident = m2c_match_lowline_ident;
-    new_lexer->match_ident_or_resword = m2c_match_lowline_ident_or_resword;
-   }
-   else /* no dollar identifiers */ {
-    new_lexer->match_ident = m2c_match_ident;
-    new_lexer->match_ident_or_resword = m2c_match_ident_or_resword;
-   } /* end if */
-      
-   /* read first symbol */
-   get_new_lookahead_sym(new_lexer);
-   new_lexer->digest_mode = M2C_DIGEST_PREPEND_SPACER;
+   new_lexer->stream = NULL;
+   new_lexer->spare_stream = NULL;
+   init_lexer_state(new_lexer, filename);
    
    *lexer = new_lexer;
+   SET_STATUS(status, M2C_LEXER_STATUS_SUCCESS);
    return;
-} /* end m2c_new_lexer */
+} /* end open_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_reset_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Associates lexer with the file represented by filename,  reusing lexer,
+ * its digest contexts, its input buffer and its token stream.
+ * ----------------------------------------------------------------------- */
+
+static void reset_lexer
+  (m2c_lexer_t lexer, intstr_t filename, bool header_only,
+   m2c_lexer_status_t *status);
+
+void m2c_reset_lexer
+  (m2c_lexer_t lexer, intstr_t filename, m2c_lexer_status_t *status) {
+  
+  reset_lexer(lexer, filename, false, status);
+  
+} /* end m2c_reset_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_reset_header_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_reset_lexer but opens the input file for reading of a prefix.
+ * ----------------------------------------------------------------------- */
+
+void m2c_reset_header_lexer
+  (m2c_lexer_t lexer, intstr_t filename, m2c_lexer_status_t *status) {
+  
+  reset_lexer(lexer, filename, true, status);
+  
+} /* end m2c_reset_header_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure reset_lexer(lexer, filename, header_only, status)
+ * --------------------------------------------------------------------------
+ * Releases the symbols of the previous file of lexer,  keeps its token
+ * stream for reuse,  reopens its infile with the file represented by file-
+ * name and reads the first symbol.  If the file cannot be opened,  lexer is
+ * left at the end of an empty input.
+ * ----------------------------------------------------------------------- */
+
+static void reset_lexer
+  (m2c_lexer_t lexer, intstr_t filename, bool header_only,
+   m2c_lexer_status_t *status) {
+  
+  infile_status_t infile_status;
+  
+  /* check pre-conditions */
+  if ((lexer == NULL) || (filename == NULL)) {
+    SET_STATUS(status, M2C_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* release symbols of previous file */
+  intstr_release(lexer->current.lexeme);
+  intstr_release(lexer->lookahead.lexeme);
+  
+  /* keep the token stream and its tables for the next pre-tokenisation */
+  if (lexer->stream != NULL) {
+    clear_token_stream(lexer->stream);
+    
+    if (lexer->spare_stream == NULL) {
+      lexer->spare_stream = lexer->stream;
+    }
+    else {
+      release_token_stream(lexer->stream);
+    } /* end if */
+    
+    lexer->stream = NULL;
+  } /* end if */
+  
+  /* reopen source file, reusing the input buffer */
+  if (header_only) {
+    infile_reopen_prefix(&lexer->infile,
+      intstr_char_ptr(filename), &infile_status);
+  }
+  else /* whole file */ {
+    infile_reopen(&lexer->infile, intstr_char_ptr(filename), &infile_status);
+  } /* end if */
+  
+  if (infile_status != FILEIO_STATUS_SUCCESS) {
+    lexer->filename = filename;
+    lexer->current = nullsym;
+    lexer->lookahead = nullsym;
+    lexer->lookahead.token = TOKEN_EOF;
+    lexer->status = lexer_status_for(infile_status);
+    SET_STATUS(status, lexer->status);
+    return;
+  } /* end if */
+  
+  init_lexer_state(lexer, filename);
+  
+  SET_STATUS(status, M2C_LEXER_STATUS_SUCCESS);
+  return;
+} /* end reset_lexer */
 
 
 /* --------------------------------------------------------------------------
@@ -223,11 +560,28 @@ void m2c_new_lexer
 
 m2c_token_t m2c_read_sym (m2c_lexer_t lexer) {
   
+  m2c_token_stream_t stream;
+  
+  /* pre-tokenised, advance index */
+  if (lexer->stream != NULL) {
+    stream = lexer->stream;
+    stream->current = stream->lookahead;
+    
+    if (stream->lookahead + 1 < stream->count) {
+      stream->lookahead++;
+    } /* end if */
+    
+    update_decl_digest(lexer);
+    return RECORD_TOKEN(stream->record[stream->current]);
+  } /* end if */
+  
   /* release the lexeme of the current symbol */
   intstr_release(lexer->current.lexeme);
   
   /* lookahead symbol becomes current symbol */
   lexer->current = lexer->lookahead;
+  lexer->symbol_index++;
+  update_decl_digest(lexer);
   
   /* read new lookahead symbol */
   get_new_lookahead_sym(lexer);
@@ -246,6 +600,10 @@ m2c_token_t m2c_read_sym (m2c_lexer_t lexer) {
 
 inline m2c_token_t m2c_next_sym (m2c_lexer_t lexer) {
   
+  if (lexer->stream != NULL) {
+    return RECORD_TOKEN(lexer->stream->record[lexer->stream->lookahead]);
+  } /* end if */
+  
   return lexer->lookahead.token;
 
 } /* end m2c_next_sym */
@@ -259,14 +617,31 @@ inline m2c_token_t m2c_next_sym (m2c_lexer_t lexer) {
 
 m2c_token_t m2c_consume_sym (m2c_lexer_t lexer) {
   
+  m2c_token_stream_t stream;
+  
+  /* pre-tokenised, advance index */
+  if (lexer->stream != NULL) {
+    stream = lexer->stream;
+    stream->current = stream->lookahead;
+    
+    if (stream->lookahead + 1 < stream->count) {
+      stream->lookahead++;
+    } /* end if */
+    
+    update_decl_digest(lexer);
+    return RECORD_TOKEN(stream->record[stream->lookahead]);
+  } /* end if */
+  
   /* release the lexeme of the current symbol */
-  m2c_string_release(lexer->current.lexeme);
+  intstr_release(lexer->current.lexeme);
   
   /* lookahead symbol becomes current symbol */
   lexer->current = lexer->lookahead;
+  lexer->symbol_index++;
+  update_decl_digest(lexer);
   
   /* read new lookahead symbol and return it */
-  get_lookahead_sym(lexer);
+  get_new_lookahead_sym(lexer);
   return lexer->lookahead.token;
   
 } /* end m2c_consume_sym */
@@ -278,9 +653,9 @@ m2c_token_t m2c_consume_sym (m2c_lexer_t lexer) {
  * Returns the filename associated with lexer.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_lexer_filename (m2c_lexer_t lexer) {
+intstr_t m2c_lexer_filename (m2c_lexer_t lexer) {
   
-  return infile_filename(lexer->infile);
+  return lexer->filename;
   
 } /* end m2c_lexer_filename */
 
@@ -301,12 +676,22 @@ m2c_lexer_status_t m2c_lexer_status (m2c_lexer_t lexer) {
 /* --------------------------------------------------------------------------
  * function m2c_lexer_lookahead_lexeme(lexer)
  * --------------------------------------------------------------------------
- * Returns the lexeme of the lookahead symbol.
+ * Returns the lexeme of the lookahead symbol.  A lexeme held as a slice of
+ * the source is interned on first request.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_lexer_lookahead_lexeme (m2c_lexer_t lexer) {
+intstr_t m2c_lexer_lookahead_lexeme (m2c_lexer_t lexer) {
   
-  m2c_string_retain(lexer->lookahead.lexeme);
+  intstr_t lexeme;
+  
+  if (lexer->stream != NULL) {
+    lexeme = lexeme_at_index(lexer, lexer->stream->lookahead);
+    intstr_retain(lexeme);
+    return lexeme;
+  } /* end if */
+  
+  lexeme_for_slice(lexer, &lexer->lookahead.lexeme, lexer->lookahead.slice);
+  intstr_retain(lexer->lookahead.lexeme);
   
   return lexer->lookahead.lexeme;
   
@@ -316,18 +701,71 @@ m2c_string_t m2c_lexer_lookahead_lexeme (m2c_lexer_t lexer) {
 /* --------------------------------------------------------------------------
  * function m2c_lexer_current_lexeme(lexer)
  * --------------------------------------------------------------------------
- * Returns the lexeme of the most recently consumed symbol.
+ * Returns the lexeme of the most recently consumed symbol.  A lexeme held as
+ * a slice of the source is interned on first request.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_lexer_current_lexeme (m2c_lexer_t lexer) {
+intstr_t m2c_lexer_current_lexeme (m2c_lexer_t lexer) {
+  
+  intstr_t lexeme;
+  
+  if (lexer->stream != NULL) {
+    lexeme = lexeme_at_index(lexer, lexer->stream->current);
+    intstr_retain(lexeme);
+    return lexeme;
+  } /* end if */
   
-  m2c_string_retain(lexer->current.lexeme);
+  lexeme_for_slice(lexer, &lexer->current.lexeme, lexer->current.slice);
+  intstr_retain(lexer->current.lexeme);
   
   return lexer->current.lexeme;
   
 } /* end m2c_lexer_current_lexeme */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_lookahead_text(lexer, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters of the lexeme of the lookahead symbol
+ * and passes their number in length,  without interning a lexeme held as a
+ * slice of the source.  The characters are not NUL terminated.  Returns NULL
+ * and passes zero in length if the symbol has no lexeme.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_lexer_lookahead_text (m2c_lexer_t lexer, uint_t *length) {
+  
+  if (lexer->stream != NULL) {
+    return text_for_symbol(lexer,
+      STREAM_LEXEME(lexer->stream, lexer->stream->lookahead),
+      slice_at_index(lexer->stream, lexer->stream->lookahead), length);
+  } /* end if */
+  
+  return text_for_symbol
+    (lexer, lexer->lookahead.lexeme, lexer->lookahead.slice, length);
+} /* end m2c_lexer_lookahead_text */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_current_text(lexer, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters of the lexeme of the most recently
+ * consumed symbol and passes their number in length  like function
+ * m2c_lexer_lookahead_text.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_lexer_current_text (m2c_lexer_t lexer, uint_t *length) {
+  
+  if (lexer->stream != NULL) {
+    return text_for_symbol(lexer,
+      STREAM_LEXEME(lexer->stream, lexer->stream->current),
+      slice_at_index(lexer->stream, lexer->stream->current), length);
+  } /* end if */
+  
+  return text_for_symbol
+    (lexer, lexer->current.lexeme, lexer->current.slice, length);
+} /* end m2c_lexer_current_text */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_lexer_lookahead_line(lexer)
  * --------------------------------------------------------------------------
@@ -336,6 +774,10 @@ m2c_string_t m2c_lexer_current_lexeme (m2c_lexer_t lexer) {
 
 uint_t m2c_lexer_lookahead_line (m2c_lexer_t lexer) {
   
+  if (lexer->stream != NULL) {
+    return RECORD_LINE(lexer->stream->record[lexer->stream->lookahead]);
+  } /* end if */
+  
   return lexer->lookahead.line;
   
 } /* end m2c_lexer_lookahead_line */
@@ -349,6 +791,10 @@ uint_t m2c_lexer_lookahead_line (m2c_lexer_t lexer) {
 
 uint_t m2c_lexer_current_line (m2c_lexer_t lexer) {
   
+  if (lexer->stream != NULL) {
+    return RECORD_LINE(lexer->stream->record[lexer->stream->current]);
+  } /* end if */
+  
   return lexer->current.line;
   
 } /* end m2c_lexer_current_line */
@@ -362,6 +808,10 @@ uint_t m2c_lexer_current_line (m2c_lexer_t lexer) {
 
 uint_t m2c_lexer_lookahead_column (m2c_lexer_t lexer) {
   
+  if (lexer->stream != NULL) {
+    return RECORD_COLUMN(lexer->stream->record[lexer->stream->lookahead]);
+  } /* end if */
+  
   return lexer->lookahead.column;
   
 } /* end m2c_lexer_lookahead_column */
@@ -375,104 +825,390 @@ uint_t m2c_lexer_lookahead_column (m2c_lexer_t lexer) {
 
 uint_t m2c_lexer_current_column (m2c_lexer_t lexer) {
   
+  if (lexer->stream != NULL) {
+    return RECORD_COLUMN(lexer->stream->record[lexer->stream->current]);
+  } /* end if */
+  
   return lexer->current.column;
   
 } /* end m2c_lexer_current_column */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_lexer_digest(lexer)
+ * function m2c_lexer_lookahead_value(lexer)
  * --------------------------------------------------------------------------
- * Returns the digest value of the file associated with lexer.
+ * Returns the value of the lookahead symbol if it is a numeric literal,
+ * otherwise M2C_NUMERIC_VALUE_NONE.
  * ----------------------------------------------------------------------- */
 
-m2c_digest_value_t m2c_lexer_digest (m2c_lexer_t lexer) {
+m2c_numeric_value_t m2c_lexer_lookahead_value (m2c_lexer_t lexer) {
   
-  return m2c_digest_value(lexer->digest);
+  if (lexer->stream != NULL) {
+    return value_at_index(lexer->stream, lexer->stream->lookahead);
+  } /* end if */
   
-} /* end m2c_lexer_digest */
+  return lexer->lookahead.value;
+} /* end m2c_lexer_lookahead_value */
 
 
 /* --------------------------------------------------------------------------
- * procedure m2c_release_lexer(lexer, status)
+ * function m2c_lexer_current_value(lexer)
  * --------------------------------------------------------------------------
- * Closes the file associated with lexer, deallocates its file object,
- * deallocates the lexer object and returns NULL in lexer.
- *
- * pre-conditions:
- * o  parameter lexer must not be NULL upon entry
- * o  parameter status may be NULL
- *
- * post-conditions:
- * o  file object is deallocated
- * o  NULL is passed back in lexer
- * o  M2C_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
- *
- * error-conditions:
- * o  if lexer is NULL upon entry, no operation is carried out
- *    and status M2C_LEXER_STATUS_INVALID_REFERENCE is returned
+ * Returns the value of the most recently consumed symbol if it is a numeric
+ * literal, otherwise M2C_NUMERIC_VALUE_NONE.
  * ----------------------------------------------------------------------- */
 
-void m2c_release_lexer (m2c_lexer_t *lexptr, m2c_lexer_status_t *status) {
+m2c_numeric_value_t m2c_lexer_current_value (m2c_lexer_t lexer) {
   
-  m2c_lexer_t lexer;
-  
-  /* check pre-conditions */
-  if ((lexptr == NULL) || (*lexptr == NULL)) {
-    SET_STATUS(status, M2C_LEXER_STATUS_INVALID_REFERENCE);
-    return;
+  if (lexer->stream != NULL) {
+    return value_at_index(lexer->stream, lexer->stream->current);
   } /* end if */
   
-  lexer = *lexptr;
-  
-  m2c_close_infile(&lexer->infile, NULL);
-  m2c_string_release(lexer->current.lexeme);
-  m2c_string_release(lexer->lookahead.lexeme);
+  return lexer->current.value;
+} /* end m2c_lexer_current_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_digest(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the digest value of the file associated with lexer.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_lexer_digest (m2c_lexer_t lexer) {
   
-  free(lexer);
-  *lexptr = NULL;
+  return m2c_digest_value(&lexer->digest);
   
-  return;
-} /* end m2c_release_lexer */
-
+} /* end m2c_lexer_digest */
 
-/* Private Functions */
 
 /* --------------------------------------------------------------------------
- * private procedure get_new_lookahead_sym(lexer)
+ * procedure m2c_lexer_begin_decl_digest(lexer)
  * --------------------------------------------------------------------------
- * Skips any whitespace, newlines, disabled code sections, illegal characters
- * and if compiler switch preserve-comments is off, any comments; matches the
- * remaining input  to a valid symbol,  and  reads it  into lexer's lookahead
- * symbol buffer.  Any errors are reported to the console via error-reporter. 
+ * Starts a declaration digest over the symbols consumed from now on.
  * ----------------------------------------------------------------------- */
 
-static void get_new_lookahead_sym (m2c_lexer_t lexer) {
+void m2c_lexer_begin_decl_digest (m2c_lexer_t lexer) {
   
-  unsigned int line, column;
-  m2c_token_t token;
+  m2c_digest_reset(&lexer->decl_digest);
+  lexer->decl_digest_mode = M2C_DIGEST_DONT_PREPEND_SPACER;
+  lexer->decl_digest_active = true;
+  
+} /* end m2c_lexer_begin_decl_digest */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_end_decl_digest(lexer)
+ * --------------------------------------------------------------------------
+ * Ends the declaration digest and returns its value.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_lexer_end_decl_digest (m2c_lexer_t lexer) {
+  
+  if (NOT(lexer->decl_digest_active)) {
+    return 0;
+  } /* end if */
+  
+  m2c_digest_finalize(&lexer->decl_digest);
+  lexer->decl_digest_active = false;
+  
+  return m2c_digest_value(&lexer->decl_digest);
+  
+} /* end m2c_lexer_end_decl_digest */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_symbol_index(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the index of the lookahead symbol within the source file.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_lexer_symbol_index (m2c_lexer_t lexer) {
+  
+  if (lexer->stream != NULL) {
+    return lexer->stream->lookahead;
+  } /* end if */
+  
+  return lexer->symbol_index;
+  
+} /* end m2c_lexer_symbol_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_bytes_read(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes read from the source file so far.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_lexer_bytes_read (m2c_lexer_t lexer) {
+  
+  return infile_bytes_read(lexer->infile);
+  
+} /* end m2c_lexer_bytes_read */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_lexer_flush_diagnostics(lexer, buffer, show_source)
+ * --------------------------------------------------------------------------
+ * Flushes diagnostic buffer to the console,  with the source lines of the
+ * source file of lexer if show_source is true.
+ * ----------------------------------------------------------------------- */
+
+void m2c_lexer_flush_diagnostics
+  (m2c_lexer_t lexer, m2c_diag_buffer_t buffer, bool show_source) {
+  
+  if (lexer == NULL) {
+    m2c_diag_flush(buffer, NULL, false, stdout);
+  }
+  else {
+    m2c_diag_flush(buffer, lexer->infile, show_source, stdout);
+  } /* end if */
+  
+} /* end m2c_lexer_flush_diagnostics */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_skip_to_symbol(lexer, index)
+ * --------------------------------------------------------------------------
+ * Makes the symbol at index the lookahead symbol and returns it.  Random
+ * access if pre-tokenised,  otherwise forward only.
+ * ----------------------------------------------------------------------- */
+
+m2c_token_t m2c_lexer_skip_to_symbol (m2c_lexer_t lexer, uint_t index) {
+  
+  m2c_token_stream_t stream;
+  
+  /* pre-tokenised, set indices */
+  if (lexer->stream != NULL) {
+    stream = lexer->stream;
+    
+    if (index >= stream->count) {
+      index = stream->count - 1;
+    } /* end if */
+    
+    stream->lookahead = index;
+    stream->current = (index > 0) ? index - 1 : 0;
+    
+    return RECORD_TOKEN(stream->record[stream->lookahead]);
+  } /* end if */
+  
+  while ((lexer->symbol_index < index) &&
+         (lexer->lookahead.token != TOKEN_EOF)) {
+    m2c_consume_sym(lexer);
+  } /* end while */
+  
+  return lexer->lookahead.token;
+  
+} /* end m2c_lexer_skip_to_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_lexer(lexer, status)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with lexer, deallocates its file object,
+ * deallocates the lexer object and returns NULL in lexer.
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  file object is deallocated
+ * o  NULL is passed back in lexer
+ * o  M2C_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer is NULL upon entry, no operation is carried out
+ *    and status M2C_LEXER_STATUS_INVALID_REFERENCE is returned
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_lexer (m2c_lexer_t *lexptr, m2c_lexer_status_t *status) {
+  
+  m2c_lexer_t lexer;
+  
+  /* check pre-conditions */
+  if ((lexptr == NULL) || (*lexptr == NULL)) {
+    SET_STATUS(status, M2C_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  lexer = *lexptr;
+  
+  if (lexer->stream != NULL) {
+    release_token_stream(lexer->stream);
+  } /* end if */
+  
+  if (lexer->spare_stream != NULL) {
+    release_token_stream(lexer->spare_stream);
+  } /* end if */
+  
+  infile_close(&lexer->infile);
+  intstr_release(lexer->current.lexeme);
+  intstr_release(lexer->lookahead.lexeme);
+  
+  free(lexer);
+  *lexptr = NULL;
+  
+  return;
+} /* end m2c_release_lexer */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_lexer_pretokenize(lexer, status)
+ * --------------------------------------------------------------------------
+ * Lexes the remaining input of the source file associated with lexer into a
+ * token stream held by lexer, then closes the source file.
+ * ----------------------------------------------------------------------- */
+
+void m2c_lexer_pretokenize (m2c_lexer_t lexer, m2c_lexer_status_t *status) {
+  
+  m2c_token_stream_t stream;
+  uint32_t lexeme_index;
+  bool ok;
+  
+  /* check pre-conditions */
+  if (lexer == NULL) {
+    SET_STATUS(status, M2C_LEXER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* already pre-tokenised */
+  if (lexer->stream != NULL) {
+    SET_STATUS(status, M2C_LEXER_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  /* reuse the token stream of a previous file, or allocate one */
+  if (lexer->spare_stream != NULL) {
+    stream = lexer->spare_stream;
+    lexer->spare_stream = NULL;
+  }
+  else /* no spare stream */ {
+    stream = malloc(sizeof(m2c_token_stream_s));
+    
+    if (stream == NULL) {
+      SET_STATUS(status, M2C_LEXER_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    stream->count = 0;
+    stream->capacity = 0;
+    stream->record = NULL;
+    stream->lexeme_count = 0;
+    stream->lexeme_capacity = 0;
+    stream->lexeme = NULL;
+    stream->lexeme_slot = NULL;
+    stream->value_count = 0;
+    stream->value_capacity = 0;
+    stream->value_index = NULL;
+    stream->value = NULL;
+    stream->slice_count = 0;
+    stream->slice_capacity = 0;
+    stream->slice_index = NULL;
+    stream->slice = NULL;
+    
+    if ((NOT(grow_token_stream(stream))) ||
+        (NOT(grow_lexeme_table(stream)))) {
+      release_token_stream(stream);
+      SET_STATUS(status, M2C_LEXER_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+  } /* end if */
+  
+  /* the current symbol goes into slot 0, ownership of its lexeme moves */
+  ok = add_lexeme(stream, lexer->current.lexeme, &lexeme_index);
+  
+  if (NOT(ok)) {
+    lexeme_index = 0;
+    intstr_release(lexer->current.lexeme);
+  } /* end if */
+  
+  stream->record[0] = PACK_RECORD(lexer->current.token,
+    lexer->current.line, lexer->current.column, lexeme_index);
+  stream->count = 1;
+  
+  if (ok && IS_NUMERIC_VALUE_TOKEN(lexer->current.token)) {
+    ok = append_value(stream, 0, lexer->current.value);
+  } /* end if */
+  if (ok && (lexer->current.slice.length > 0)) {
+    ok = append_slice(stream, 0, lexer->current.slice);
+  } /* end if */
+  lexer->current = nullsym;
+  
+  /* append lookahead symbols up to and including EOF */
+  while (ok && (lexer->lookahead.token != TOKEN_EOF)) {
+    ok = append_lookahead_sym(stream, lexer);
+    
+    if (ok) {
+      get_new_lookahead_sym(lexer);
+    } /* end if */
+  } /* end while */
+  
+  /* append EOF, there is always a free slot left for it */
+  if (NOT(ok)) {
+    intstr_release(lexer->lookahead.lexeme);
+    lexer->lookahead = nullsym;
+    lexer->lookahead.token = TOKEN_EOF;
+  } /* end if */
+  
+  append_lookahead_sym(stream, lexer);
+  lexer->lookahead = nullsym;
+  
+  stream->current = 0;
+  stream->lookahead = 1;
+  lexer->stream = stream;
+  
+  /* the source file is no longer needed,  buffered input is kept for reuse
+   * and for any slices that refer to it */
+  infile_close_file(lexer->infile);
+  
+  if (NOT(ok)) {
+    SET_STATUS(status, M2C_LEXER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_LEXER_STATUS_SUCCESS);
+  return;
+} /* end m2c_lexer_pretokenize */
+
+
+/* Private Functions */
+
+/* --------------------------------------------------------------------------
+ * private procedure get_new_lookahead_sym(lexer)
+ * --------------------------------------------------------------------------
+ * Skips any whitespace, newlines, disabled code sections, illegal characters
+ * and if compiler switch preserve-comments is off, any comments; matches the
+ * remaining input  to a valid symbol,  and  reads it  into lexer's lookahead
+ * symbol buffer.  Any errors are reported to the console via error-reporter. 
+ * ----------------------------------------------------------------------- */
+
+static void get_new_lookahead_sym (m2c_lexer_t lexer) {
+  
+  unsigned int line, column;
+  m2c_token_t token;
+  intstr_t lexeme = NULL;
+  m2c_numeric_value_t value = M2C_NUMERIC_VALUE_NONE;
+  infile_slice_t slice = INFILE_SLICE_NONE;
   char next_char;
   
   /* no token yet */
   token = TOKEN_UNKNOWN;
   
   /* get the lookahead character */
-  next_char = m2c_next_char(lexer->infile);
+  next_char = infile_lookahead_char(lexer->infile);
   
   while (token == TOKEN_UNKNOWN) {
   
     /* skip all whitespace and line feeds */
-    while ((next_char == ASCII_SPACE) ||
-           (next_char == ASCII_TAB) ||
-           (next_char == ASCII_LF)) {
+    while (IS_WHITESPACE(next_char)) {
       
       /* consume the character and get new lookahead */
       next_char = infile_consume_char(lexer->infile);
     } /* end while */
     
     /* get line and column of lookahead */
-    line = m2c_infile_current_line(lexer->infile);
-    column = m2c_infile_current_column(lexer->infile);
+    line = infile_line(lexer->infile);
+    column = infile_column(lexer->infile);
     
     /* identifier */
     if (IS_LOWER_LETTER(next_char)) {
@@ -484,9 +1220,10 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         lexer->match_ident_or_resword(lexer->infile, &token, &lexeme);
     }
     /* numeric literal */
-    else if (IS_DIGIT(next_char)) {
+    else if (IS_DECIMAL_DIGIT(next_char)) {
       infile_mark_lexeme(lexer->infile);
-      next_char = m2c_match_numeric_literal(lexer->infile, &token, &lexeme);
+      next_char = m2c_match_numeric_literal_with_value
+        (lexer->infile, &token, &lexeme, &value);
     }
     else {
       switch (next_char) {
@@ -494,19 +1231,21 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         case '!' :
           /* line comment */        
           next_char =
-            m2c_match_line_comment(lexer->infile, &token, &lexeme);
+            m2c_match_line_comment_with_slice
+              (lexer->infile, &token, &lexeme, &slice);
           break;
         
         case '\"' :
           /* double quoted literal */
           next_char =
-            m2c_match_quoted_literal(lexer->infile, &token, &lexeme);
+            m2c_match_quoted_literal_with_slice
+              (lexer->infile, &token, &lexeme, &slice);
           break;
         
         case '#' :
           /* not-equal operator */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_NOTEQUAL;
+          token = TOKEN_NOT_EQUAL;
           break;
         
         case '&' :
@@ -518,25 +1257,27 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         case '\'' :
           /* single quoted literal */
           next_char =
-            m2c_match_quoted_literal(lexer->infile, &token, &lexeme);
+            m2c_match_quoted_literal_with_slice
+              (lexer->infile, &token, &lexeme, &slice);
           break;
         
         case '(' :
           /* left parenthesis */
-          if (m2c_la2_char(lexer->infile) != '*') {
+          if (infile_la2_char(lexer->infile) != '*') {
             next_char = infile_consume_char(lexer->infile);
-            token = TOKEN_LEFT_PARENTHESIS;
+            token = TOKEN_LPAREN;
           }
           else /* block comment */ {
             next_char =
-              m2c_match_block_comment(lexer->infile, &token, &lexeme);
+              m2c_match_block_comment_with_slice
+                (lexer->infile, &token, &lexeme, &slice);
           } /* end if */
           break;
         
         case ')' :
           /* right parenthesis */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_RIGHT_PARENTHESIS;
+          token = TOKEN_RPAREN;
           break;
         
         case '*' :
@@ -588,7 +1329,7 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
           /* range */
           if (next_char == '.') {
             next_char = infile_consume_char(lexer->infile);
-            token = TOKEN_RANGE;
+            token = TOKEN_DOT_DOT;
           }
           /* wildcard */
           else if (next_char == '*') {
@@ -614,12 +1355,12 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
           /* conversion */
           if (next_char == ':') {
             next_char = infile_consume_char(lexer->infile);
-            token = TOKEN_CONVERSION;
+            token = TOKEN_TYPE_CONV;
           }
           /* assignment */ 
           else if (next_char == '=') {
             next_char = infile_consume_char(lexer->infile);
-            token = TOKEN_ASSIGNMENT;
+            token = TOKEN_ASSIGN;
           }
           /* colon */
           else {
@@ -635,7 +1376,7 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         
         case '<' :
           /* pragma */
-          if (m2c_la2_char(lexer->infile) == '*') {
+          if (infile_la2_char(lexer->infile) == '*') {
             next_char = m2c_match_pragma(lexer->infile, &token, &lexeme);
             break;
           }
@@ -645,11 +1386,11 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
           /* less-or-equal */
           if (next_char == '=') {
             next_char = infile_consume_char(lexer->infile);
-            token = TOKEN_LESS_THAN_OR_EQUAL;
+            token = TOKEN_LESS_OR_EQ;
           }
           /* less-than */
           else {
-            token = TOKEN_LESS_THAN;
+            token = TOKEN_LESS;
           } /* end if */
           break;
         
@@ -674,11 +1415,11 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
           /* greater-or-equal */
           if (next_char == '=') {
             next_char = infile_consume_char(lexer->infile);
-            token = TOKEN_GREATER_THAN_OR_EQUAL;
+            token = TOKEN_GREATER_OR_EQ;
           }
           /* greater */
           else {
-            token = TOKEN_GREATER_THAN;
+            token = TOKEN_GREATER;
           } /* end if */
           break;
                 
@@ -691,19 +1432,19 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         case '[' :
           /* left bracket */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_LEFT_BRACKET;
+          token = TOKEN_LBRACKET;
           break;
         
         case '\\' :
           /* backslash */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_BACKSLASH;
+          token = TOKEN_SET_DIFF;
           break;
         
         case ']' :
           /* right bracket */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_RIGHT_BRACKET;
+          token = TOKEN_RBRACKET;
           break;
         
         case '^' :
@@ -715,7 +1456,7 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         case '{' :
           /* left brace */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_LEFT_BRACE;
+          token = TOKEN_LBRACE;
           break;
         
         case '|' :
@@ -727,13 +1468,13 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
         case '}' :
           /* right brace */
           next_char = infile_consume_char(lexer->infile);
-          token = TOKEN_RIGHT_BRACE;
+          token = TOKEN_RBRACE;
           break;
                       
         default :
           /* End-of-File marker */        
-          if (m2c_infile_eof(lexer->infile)) {
-            token = TOKEN_END_OF_FILE;
+          if (infile_eof(lexer->infile)) {
+            token = TOKEN_EOF;
           }
           /* disabled code section */
           else if ((next_char == '?') && (column == 1)
@@ -743,35 +1484,666 @@ static void get_new_lookahead_sym (m2c_lexer_t lexer) {
           }
           else /* invalid char */ {
             m2c_emit_lex_error
-              (M2C_ERROR_ILLEGAL_CHAR, lexer->infile,
-               next_char, infile_line(lexer->infile), infile_column(lexer->infile));
+              (M2C_ERROR_ILLEGAL_CHAR, next_char,
+               infile_line(lexer->infile), infile_column(lexer->infile));
             next_char = infile_consume_char(lexer->infile);
             token = TOKEN_UNKNOWN;
           } /* end if */
       } /* end switch */
     } /* end if */
+    
+    /* lexeme exceeded the input buffer of a streamed file */
+    if (infile_status(lexer->infile) == FILEIO_STATUS_LEXEME_TOO_LONG) {
+      m2c_emit_lex_error_in_token
+        (M2C_ERROR_LEXEME_TOO_LONG, token, next_char, line, column);
+    } /* end if */
   } /* end while */
   
   /* update module digest */
   if (M2C_IS_SPECIAL_SYMBOL_TOKEN(token)) {
-    m2c_digest_add_token(lexer->digest, lexer->digest_mode, token);
+    m2c_digest_add_token(&lexer->digest, lexer->digest_mode, token);
   }
-  else if ((token == TOKEN_IDENT) || (M2C_IS_RESWORD_TOKEN)
+  else if ((token == TOKEN_IDENT) || (M2C_IS_RESWORD_TOKEN(token))
     || (M2C_IS_LITERAL_TOKEN(token)) || (token == TOKEN_PRAGMA)) {
-    m2c_digest_add_lexeme(lexer->digest, lexer->digest_mode, lexeme);
+    m2c_digest_add_lexeme(&lexer->digest, lexer->digest_mode, lexeme);
   }
   else if (token == TOKEN_EOF) {
-    m2c_digest_finalize(lexer->digest);
+    m2c_digest_finalize(&lexer->digest);
   } /* end if */
   
   /* update lexer's lookahead symbol */
-  lexer->lexeme = lexeme;
+  lexer->lookahead.lexeme = lexeme;
   lexer->lookahead.token = token;
   lexer->lookahead.line = line;
   lexer->lookahead.column = column;
+  lexer->lookahead.value = value;
+  lexer->lookahead.slice = slice;
   
   return;
 } /* end get_new_lookahead_sym */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* --------------------------------------------------------------------------
+ * private procedure update_decl_digest(lexer)
+ * --------------------------------------------------------------------------
+ * Adds the most recently consumed symbol to the declaration digest of lexer
+ * if one is in progress.  Symbols are added as for the module digest,  which
+ * is updated when symbols are read,  not when they are consumed.
+ * ----------------------------------------------------------------------- */
+
+static void update_decl_digest (m2c_lexer_t lexer) {
+  
+  m2c_token_t token;
+  intstr_t lexeme;
+  
+  if (NOT(lexer->decl_digest_active)) {
+    return;
+  } /* end if */
+  
+  if (lexer->stream != NULL) {
+    token = RECORD_TOKEN(lexer->stream->record[lexer->stream->current]);
+  }
+  else {
+    token = lexer->current.token;
+  } /* end if */
+  
+  if (M2C_IS_SPECIAL_SYMBOL_TOKEN(token)) {
+    m2c_digest_add_token
+      (&lexer->decl_digest, lexer->decl_digest_mode, token);
+  }
+  else if ((token == TOKEN_IDENT) || (M2C_IS_RESWORD_TOKEN(token))
+    || (M2C_IS_LITERAL_TOKEN(token)) || (token == TOKEN_PRAGMA)) {
+    lexeme = m2c_lexer_current_lexeme(lexer);
+    m2c_digest_add_lexeme
+      (&lexer->decl_digest, lexer->decl_digest_mode, lexeme);
+    intstr_release(lexeme);
+  }
+  else /* not part of the digest */ {
+    return;
+  } /* end if */
+  
+  lexer->decl_digest_mode = M2C_DIGEST_PREPEND_SPACER;
+  
+} /* end update_decl_digest */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_lookahead_sym(stream, lexer)
+ * --------------------------------------------------------------------------
+ * Appends the lookahead symbol of lexer to stream, moving ownership of its
+ * lexeme to the lexeme table of stream.  Enlarges stream when only one free
+ * slot is left, thus there is always room left to terminate the stream with
+ * an EOF symbol.
+ * The value of a numeric literal is appended to the value table of stream,
+ * a slice is appended to the slice table of stream.
+ * Returns false if stream could not be enlarged, else true.
+ * ----------------------------------------------------------------------- */
+
+static bool append_lookahead_sym
+  (m2c_token_stream_t stream, m2c_lexer_t lexer) {
+  
+  uint_t index;
+  uint32_t lexeme_index;
+  
+  if (NOT(add_lexeme(stream, lexer->lookahead.lexeme, &lexeme_index))) {
+    return false;
+  } /* end if */
+  
+  /* the reference to the lexeme has moved to the lexeme table */
+  lexer->lookahead.lexeme = NULL;
+  
+  index = stream->count;
+  stream->record[index] = PACK_RECORD(lexer->lookahead.token,
+    lexer->lookahead.line, lexer->lookahead.column, lexeme_index);
+  stream->count++;
+  
+  if ((IS_NUMERIC_VALUE_TOKEN(lexer->lookahead.token)) &&
+      (NOT(append_value(stream, index, lexer->lookahead.value)))) {
+    return false;
+  } /* end if */
+  
+  if ((lexer->lookahead.slice.length > 0) &&
+      (NOT(append_slice(stream, index, lexer->lookahead.slice)))) {
+    return false;
+  } /* end if */
+  
+  if (stream->count + 1 >= stream->capacity) {
+    return grow_token_stream(stream);
+  } /* end if */
+  
+  return true;
+} /* end append_lookahead_sym */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_token_stream(stream)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of stream.  Returns false if allocation failed, in
+ * which case stream remains unchanged, else true.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_token_stream (m2c_token_stream_t stream) {
+  
+  uint_t new_capacity;
+  uint64_t *new_record;
+  
+  if (stream->capacity == 0) {
+    new_capacity = TOKEN_STREAM_INITIAL_CAPACITY;
+  }
+  else {
+    new_capacity = 2 * stream->capacity;
+  } /* end if */
+  
+  new_record = realloc(stream->record, new_capacity * sizeof(uint64_t));
+  
+  if (new_record == NULL) {
+    return false;
+  } /* end if */
+  
+  stream->record = new_record;
+  stream->capacity = new_capacity;
+  
+  return true;
+} /* end grow_token_stream */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_lexeme(stream, lexeme, index)
+ * --------------------------------------------------------------------------
+ * Looks up lexeme in the lexeme table of stream,  adds it if not present and
+ * passes its lexeme index in index,  zero if lexeme is NULL.  On success the
+ * reference held by the caller moves to stream,  a duplicate reference of a
+ * lexeme already present is released.  Returns false if the lexeme table
+ * could not be enlarged,  in which case the reference is not consumed,  else
+ * true.
+ * ----------------------------------------------------------------------- */
+
+static bool add_lexeme
+  (m2c_token_stream_t stream, intstr_t lexeme, uint32_t *index) {
+  
+  uint_t mask, slot;
+  uint32_t entry;
+  
+  if (lexeme == NULL) {
+    *index = 0;
+    return true;
+  } /* end if */
+  
+  mask = 2 * stream->lexeme_capacity - 1;
+  slot = (uint_t) intstr_hash(lexeme) & mask;
+  
+  /* probe for lexeme */
+  while (stream->lexeme_slot[slot] != 0) {
+    entry = stream->lexeme_slot[slot];
+    
+    if (stream->lexeme[entry] == lexeme) {
+      intstr_release(lexeme);
+      *index = entry;
+      return true;
+    } /* end if */
+    
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  if (stream->lexeme_count > RECORD_MAX_LEXEME) {
+    return false;
+  } /* end if */
+  
+  if (stream->lexeme_count == stream->lexeme_capacity) {
+    if (NOT(grow_lexeme_table(stream))) {
+      return false;
+    } /* end if */
+    
+    /* probe again in the enlarged table */
+    mask = 2 * stream->lexeme_capacity - 1;
+    slot = (uint_t) intstr_hash(lexeme) & mask;
+    
+    while (stream->lexeme_slot[slot] != 0) {
+      slot = (slot + 1) & mask;
+    } /* end while */
+  } /* end if */
+  
+  entry = (uint32_t) stream->lexeme_count;
+  stream->lexeme[entry] = lexeme;
+  stream->lexeme_slot[slot] = entry;
+  stream->lexeme_count++;
+  
+  *index = entry;
+  return true;
+} /* end add_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_lexeme_table(stream)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the lexeme table of stream and rebuilds its slot
+ * table.  Entry zero is reserved for no lexeme.  Returns false if allocation
+ * failed, in which case the table remains unchanged, else true.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_lexeme_table (m2c_token_stream_t stream) {
+  
+  uint_t new_capacity, mask, slot, index;
+  intstr_t *new_lexeme;
+  uint32_t *new_slot;
+  
+  if (stream->lexeme_capacity == 0) {
+    new_capacity = LEXEME_TABLE_INITIAL_CAPACITY;
+  }
+  else {
+    new_capacity = 2 * stream->lexeme_capacity;
+  } /* end if */
+  
+  new_slot = calloc(2 * new_capacity, sizeof(uint32_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  new_lexeme = realloc(stream->lexeme, new_capacity * sizeof(intstr_t));
+  
+  if (new_lexeme == NULL) {
+    free(new_slot);
+    return false;
+  } /* end if */
+  
+  if (stream->lexeme_count == 0) {
+    new_lexeme[0] = NULL;
+    stream->lexeme_count = 1;
+  } /* end if */
+  
+  /* re-insert present lexemes */
+  mask = 2 * new_capacity - 1;
+  
+  for (index = 1; index < stream->lexeme_count; index++) {
+    slot = (uint_t) intstr_hash(new_lexeme[index]) & mask;
+    
+    while (new_slot[slot] != 0) {
+      slot = (slot + 1) & mask;
+    } /* end while */
+    
+    new_slot[slot] = (uint32_t) index;
+  } /* end for */
+  
+  free(stream->lexeme_slot);
+  stream->lexeme = new_lexeme;
+  stream->lexeme_slot = new_slot;
+  stream->lexeme_capacity = new_capacity;
+  
+  return true;
+} /* end grow_lexeme_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_value(stream, index, value)
+ * --------------------------------------------------------------------------
+ * Appends value for the symbol at index to the value table of stream,  the
+ * table is enlarged as needed.  Indices must be appended in ascending order.
+ * Returns false if the table could not be enlarged, else true.
+ * ----------------------------------------------------------------------- */
+
+static bool append_value
+  (m2c_token_stream_t stream, uint_t index, m2c_numeric_value_t value) {
+  
+  uint_t new_capacity;
+  uint_t *new_index;
+  m2c_numeric_value_t *new_value;
+  
+  if (stream->value_count == stream->value_capacity) {
+    if (stream->value_capacity == 0) {
+      new_capacity = VALUE_TABLE_INITIAL_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * stream->value_capacity;
+    } /* end if */
+    
+    new_index =
+      realloc(stream->value_index, new_capacity * sizeof(uint_t));
+    
+    if (new_index == NULL) {
+      return false;
+    } /* end if */
+    
+    stream->value_index = new_index;
+    
+    new_value =
+      realloc(stream->value, new_capacity * sizeof(m2c_numeric_value_t));
+    
+    if (new_value == NULL) {
+      return false;
+    } /* end if */
+    
+    stream->value = new_value;
+    stream->value_capacity = new_capacity;
+  } /* end if */
+  
+  stream->value_index[stream->value_count] = index;
+  stream->value[stream->value_count] = value;
+  stream->value_count++;
+  
+  return true;
+} /* end append_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function value_at_index(stream, index)
+ * --------------------------------------------------------------------------
+ * Returns the value of the symbol at index in stream by bisection of the
+ * value table.  Returns M2C_NUMERIC_VALUE_NONE if the symbol has no value.
+ * ----------------------------------------------------------------------- */
+
+static m2c_numeric_value_t value_at_index
+  (m2c_token_stream_t stream, uint_t index) {
+  
+  uint_t low, high, mid;
+  const m2c_numeric_value_t none = M2C_NUMERIC_VALUE_NONE;
+  
+  low = 0;
+  high = stream->value_count;
+  
+  while (low < high) {
+    mid = low + (high - low) / 2;
+    
+    if (stream->value_index[mid] < index) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    } /* end if */
+  } /* end while */
+  
+  if ((low < stream->value_count) && (stream->value_index[low] == index)) {
+    return stream->value[low];
+  } /* end if */
+  
+  return none;
+} /* end value_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_slice(stream, index, slice)
+ * --------------------------------------------------------------------------
+ * Appends slice for the symbol at index to the slice table of stream,  the
+ * table is enlarged as needed.  Indices must be appended in ascending order.
+ * Returns false if the table could not be enlarged, else true.
+ * ----------------------------------------------------------------------- */
+
+static bool append_slice
+  (m2c_token_stream_t stream, uint_t index, infile_slice_t slice) {
+  
+  uint_t new_capacity;
+  uint_t *new_index;
+  infile_slice_t *new_slice;
+  
+  if (stream->slice_count == stream->slice_capacity) {
+    if (stream->slice_capacity == 0) {
+      new_capacity = SLICE_TABLE_INITIAL_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * stream->slice_capacity;
+    } /* end if */
+    
+    new_index =
+      realloc(stream->slice_index, new_capacity * sizeof(uint_t));
+    
+    if (new_index == NULL) {
+      return false;
+    } /* end if */
+    
+    stream->slice_index = new_index;
+    
+    new_slice =
+      realloc(stream->slice, new_capacity * sizeof(infile_slice_t));
+    
+    if (new_slice == NULL) {
+      return false;
+    } /* end if */
+    
+    stream->slice = new_slice;
+    stream->slice_capacity = new_capacity;
+  } /* end if */
+  
+  stream->slice_index[stream->slice_count] = index;
+  stream->slice[stream->slice_count] = slice;
+  stream->slice_count++;
+  
+  return true;
+} /* end append_slice */
+
+
+/* --------------------------------------------------------------------------
+ * private function slice_at_index(stream, index)
+ * --------------------------------------------------------------------------
+ * Returns the slice of the symbol at index in stream by bisection of the
+ * slice table.  Returns an empty slice if the symbol has no slice.
+ * ----------------------------------------------------------------------- */
+
+static infile_slice_t slice_at_index
+  (m2c_token_stream_t stream, uint_t index) {
+  
+  uint_t low, high, mid;
+  const infile_slice_t none = INFILE_SLICE_NONE;
+  
+  low = 0;
+  high = stream->slice_count;
+  
+  while (low < high) {
+    mid = low + (high - low) / 2;
+    
+    if (stream->slice_index[mid] < index) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    } /* end if */
+  } /* end while */
+  
+  if ((low < stream->slice_count) && (stream->slice_index[low] == index)) {
+    return stream->slice[low];
+  } /* end if */
+  
+  return none;
+} /* end slice_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function lexeme_for_slice(lexer, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Interns the characters of slice  and stores the result in lexeme  if no
+ * lexeme has yet been stored and slice is not empty.  Returns lexeme.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t lexeme_for_slice
+  (m2c_lexer_t lexer, intstr_t *lexeme, infile_slice_t slice) {
+  
+  if ((*lexeme == NULL) && (slice.length > 0)) {
+    *lexeme = infile_slice_lexeme(lexer->infile, slice);
+  } /* end if */
+  
+  return *lexeme;
+} /* end lexeme_for_slice */
+
+
+/* --------------------------------------------------------------------------
+ * private function lexeme_at_index(lexer, index)
+ * --------------------------------------------------------------------------
+ * Returns the lexeme of the symbol at index in the token stream of lexer.
+ * A lexeme held as a slice of the source is interned and entered into the
+ * lexeme table on first request.  Returns NULL if the symbol has no lexeme.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t lexeme_at_index (m2c_lexer_t lexer, uint_t index) {
+  
+  m2c_token_stream_t stream;
+  intstr_t lexeme;
+  uint32_t lexeme_index;
+  
+  stream = lexer->stream;
+  lexeme_index = RECORD_LEXEME(stream->record[index]);
+  
+  if (lexeme_index != 0) {
+    return stream->lexeme[lexeme_index];
+  } /* end if */
+  
+  lexeme = NULL;
+  lexeme_for_slice(lexer, &lexeme, slice_at_index(stream, index));
+  
+  /* if the table cannot be enlarged the lexeme remains unrecorded */
+  if ((lexeme != NULL) && (add_lexeme(stream, lexeme, &lexeme_index))) {
+    stream->record[index] =
+      WITH_RECORD_LEXEME(stream->record[index], lexeme_index);
+    return stream->lexeme[lexeme_index];
+  } /* end if */
+  
+  return lexeme;
+} /* end lexeme_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function text_for_symbol(lexer, lexeme, slice, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters of a symbol with lexeme and slice and
+ * passes their number in length.  Characters held as a slice are referenced
+ * in the source buffer,  otherwise those of lexeme are returned.
+ * ----------------------------------------------------------------------- */
+
+static const char *text_for_symbol
+  (m2c_lexer_t lexer, intstr_t lexeme, infile_slice_t slice, uint_t *length) {
+  
+  if ((lexeme == NULL) && (slice.length > 0)) {
+    *length = (uint_t) slice.length;
+    return infile_slice_chars(lexer->infile, slice);
+  } /* end if */
+  
+  if (lexeme == NULL) {
+    *length = 0;
+    return NULL;
+  } /* end if */
+  
+  *length = intstr_length(lexeme);
+  return intstr_char_ptr(lexeme);
+} /* end text_for_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure clear_token_stream(stream)
+ * --------------------------------------------------------------------------
+ * Releases the lexemes of stream and empties it,  keeping its arrays and
+ * tables at their current capacity.
+ * ----------------------------------------------------------------------- */
+
+static void clear_token_stream (m2c_token_stream_t stream) {
+  
+  uint_t index;
+  
+  for (index = 1; index < stream->lexeme_count; index++) {
+    intstr_release(stream->lexeme[index]);
+  } /* end for */
+  
+  if (stream->lexeme_capacity > 0) {
+    memset(stream->lexeme_slot, 0,
+      2 * stream->lexeme_capacity * sizeof(uint32_t));
+    stream->lexeme_count = 1;
+  } /* end if */
+  
+  stream->count = 0;
+  stream->current = 0;
+  stream->lookahead = 0;
+  stream->value_count = 0;
+  stream->slice_count = 0;
+  
+  return;
+} /* end clear_token_stream */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure init_lexer_state(lexer, filename)
+ * --------------------------------------------------------------------------
+ * Initialises the symbols,  digests and match handlers of lexer  for the
+ * file represented by filename,  whose infile must be open,  and reads the
+ * first symbol.
+ * ----------------------------------------------------------------------- */
+
+static void init_lexer_state (m2c_lexer_t lexer, intstr_t filename) {
+  
+  lexer->filename = filename;
+  lexer->current = nullsym;
+  lexer->lookahead = nullsym;
+  lexer->symbol_index = 0;
+  lexer->status = M2C_LEXER_STATUS_SUCCESS;
+  m2c_digest_reset(&lexer->digest);
+  lexer->digest_mode = M2C_DIGEST_DONT_PREPEND_SPACER;
+  m2c_digest_reset(&lexer->decl_digest);
+  lexer->decl_digest_mode = M2C_DIGEST_DONT_PREPEND_SPACER;
+  lexer->decl_digest_active = false;
+  
+  if (m2c_compiler_option_dollar_identifiers()) {
+    lexer->match_ident = m2c_match_lowline_ident;
+    lexer->match_ident_or_resword = m2c_match_lowline_ident_or_resword;
+  }
+  else /* no dollar identifiers */ {
+    lexer->match_ident = m2c_match_ident;
+    lexer->match_ident_or_resword = m2c_match_ident_or_resword;
+  } /* end if */
+  
+  /* read first symbol */
+  get_new_lookahead_sym(lexer);
+  lexer->digest_mode = M2C_DIGEST_PREPEND_SPACER;
+  
+  return;
+} /* end init_lexer_state */
+
+
+/* --------------------------------------------------------------------------
+ * private function lexer_status_for(infile_status)
+ * --------------------------------------------------------------------------
+ * Returns the lexer status corresponding to infile status infile_status.
+ * ----------------------------------------------------------------------- */
+
+static m2c_lexer_status_t lexer_status_for (infile_status_t infile_status) {
+  
+  switch (infile_status) {
+    case FILEIO_STATUS_SUCCESS :
+      return M2C_LEXER_STATUS_SUCCESS;
+    case FILEIO_STATUS_INVALID_FILENAME :
+      return M2C_LEXER_STATUS_INVALID_FILENAME;
+    case FILEIO_STATUS_FILE_NOT_FOUND :
+      return M2C_LEXER_STATUS_FILE_NOT_FOUND;
+    case FILEIO_STATUS_ACCESS_DENIED :
+      return M2C_LEXER_STATUS_FILE_ACCESS_DENIED;
+    case FILEIO_STATUS_ALLOCATION_FAILED :
+      return M2C_LEXER_STATUS_ALLOCATION_FAILED;
+    default :
+      return M2C_LEXER_STATUS_DEVICE_ERROR;
+  } /* end switch */
+} /* end lexer_status_for */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_token_stream(stream)
+ * --------------------------------------------------------------------------
+ * Releases all lexemes held by stream and deallocates stream.
+ * ----------------------------------------------------------------------- */
+
+static void release_token_stream (m2c_token_stream_t stream) {
+  
+  uint_t index;
+  
+  for (index = 1; index < stream->lexeme_count; index++) {
+    intstr_release(stream->lexeme[index]);
+  } /* end for */
+  
+  free(stream->record);
+  free(stream->lexeme);
+  free(stream->lexeme_slot);
+  free(stream->value_index);
+  free(stream->value);
+  free(stream->slice_index);
+  free(stream->slice);
+  free(stream);
+  
+  return;
+} /* end release_token_stream */
+
+
+/* END OF FILE */
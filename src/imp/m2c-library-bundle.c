@@ -0,0 +1,963 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-library-bundle.c                                                      *
+ *                                                                           *
+ * Implementation of library bundle archives.                                *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-library-bundle.h"
+#include "hash.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped bundles for POSIX and Unix-like host platforms
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  bundles are mapped read-only into the
+ * address space and used in place.  On all other hosts  (AmigaOS, OpenVMS,
+ * Windows) the file is read into a buffer.  Define M2C_BUNDLE_USE_MMAP as
+ * 0 to force the buffered implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_BUNDLE_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_BUNDLE_USE_MMAP 1
+#else
+#define M2C_BUNDLE_USE_MMAP 0
+#endif
+#endif
+
+#if (M2C_BUNDLE_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_bundle_header_t
+ * --------------------------------------------------------------------------
+ * record type representing the header of a library bundle.
+ *
+ * The header is followed by member_count records,  an index of slot_count
+ * 32-bit slots and string_size bytes of NUL terminated module identifiers.
+ * A slot holds the number of a record plus one,  or zero if it is free.
+ * Records are found by linear probing from the slot given by the interned
+ * key of their module identifier,  the records of all kinds of a module
+ * share its key.  The contents of the members follow,  each at an offset
+ * that is a multiple of BUNDLE_ALIGNMENT.  Field probe holds the key of
+ * BUNDLE_PROBE to reject bundles whose keys were computed by a different
+ * hash function.
+ * ----------------------------------------------------------------------- */
+
+#define BUNDLE_MAGIC "M2C-LIB"
+
+#define BUNDLE_BYTE_ORDER 0x01020304
+
+#define BUNDLE_PROBE "M2C"
+
+#define BUNDLE_MIN_SLOT_COUNT 8
+
+#define BUNDLE_ALIGNMENT 8
+
+#define ALIGNED_SIZE(_size) \
+  (((_size) + (BUNDLE_ALIGNMENT - 1)) & ~((uint64_t) BUNDLE_ALIGNMENT - 1))
+
+typedef struct {
+  /* magic */           char magic[8];
+  /* version */         uint32_t version;
+  /* byte_order */      uint32_t byte_order;
+  /* probe */           uint32_t probe;
+  /* member_count */    uint32_t member_count;
+  /* slot_count */      uint32_t slot_count;
+  /* string_size */     uint32_t string_size;
+} m2c_bundle_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_bundle_record_t
+ * --------------------------------------------------------------------------
+ * record type representing a member of a library bundle.  Field module is
+ * the offset of the module identifier in the string table,  offset is the
+ * offset of the contents from the start of the bundle.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* key */             uint32_t key;
+  /* module */          uint32_t module;
+  /* length */          uint32_t length;
+  /* kind */            uint32_t kind;
+  /* offset */          uint64_t offset;
+  /* size */            uint64_t size;
+} m2c_bundle_record_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_bundle_s
+ * --------------------------------------------------------------------------
+ * record type representing an open library bundle.  Pointers record,  slot
+ * and string point into the file contents.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_bundle_s {
+  /* file_data */       void *file_data;
+  /* file_size */       size_t file_size;
+  /* is_mapped */       bool is_mapped;
+  /* header */          m2c_bundle_header_t header;
+  /* record */          const m2c_bundle_record_t *record;
+  /* slot */            const uint32_t *slot;
+  /* string */          const char *string;
+};
+
+typedef struct m2c_bundle_s m2c_bundle_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_bundle_member_t
+ * --------------------------------------------------------------------------
+ * record type representing a file to be written into a bundle.  Field name
+ * points to the basename of file,  length is the length of its module
+ * identifier.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *file;
+  const char *name;
+  uint32_t length;
+} m2c_bundle_member_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool member_for_file
+  (const char *file, m2c_bundle_member_t *member, m2c_bundle_kind_t *kind);
+
+static uint32_t *new_index
+  (const m2c_bundle_record_t *record, const char *string,
+   uint32_t count, uint32_t *slot_count, bool *duplicate);
+
+static bool write_padding (FILE *file, uint64_t size);
+
+static bool copy_file (FILE *file, const char *path, uint64_t size);
+
+static uint32_t key_for_chars (const char *str, uint32_t length);
+
+static m2c_bundle_status_t read_file_data
+  (m2c_bundle_t bundle, const char *path);
+
+static void release_file_data (m2c_bundle_t bundle);
+
+static bool is_valid_header (m2c_bundle_t bundle);
+
+static bool is_valid_record
+  (m2c_bundle_t bundle, const m2c_bundle_record_t *record);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_is_bundle_path(path)
+ * --------------------------------------------------------------------------
+ * Returns true if path ends in M2C_BUNDLE_SUFFIX.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_is_bundle_path (const char *path) {
+  
+  size_t length;
+  
+  if (path == NULL) {
+    return false;
+  } /* end if */
+  
+  length = strlen(path);
+  
+  return (length > sizeof(M2C_BUNDLE_SUFFIX) - 1) &&
+    (strcmp(path + length - (sizeof(M2C_BUNDLE_SUFFIX) - 1),
+       M2C_BUNDLE_SUFFIX) == 0);
+} /* end m2c_is_bundle_path */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_bundle(path, count, files, status)
+ * --------------------------------------------------------------------------
+ * Collects a record for each file from its name and size,  writes header,
+ * records,  index and identifiers,  then copies the files in order.  A file
+ * whose size changed since it was measured fails the bundle.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_bundle
+  (const char *path,                    /* in */
+   uint_t count,                        /* in */
+   const char *const files[],           /* in */
+   m2c_bundle_status_t *status) {       /* out */
+  
+  m2c_bundle_status_t result;
+  m2c_bundle_header_t header;
+  m2c_bundle_record_t *record;
+  m2c_bundle_member_t *member;
+  m2c_bundle_kind_t kind;
+  uint32_t *slot, slot_count;
+  uint64_t offset, start;
+  uint_t index;
+  struct stat info;
+  char *string;
+  bool duplicate;
+  FILE *file;
+  
+  if ((path == NULL) || (files == NULL)) {
+    SET_STATUS(status, M2C_BUNDLE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  record = calloc(count + 1, sizeof(m2c_bundle_record_t));
+  member = calloc(count + 1, sizeof(m2c_bundle_member_t));
+  
+  if ((record == NULL) || (member == NULL)) {
+    free(record);
+    free(member);
+    SET_STATUS(status, M2C_BUNDLE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  memset(&header, 0, sizeof(m2c_bundle_header_t));
+  memcpy(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+  header.version = M2C_BUNDLE_VERSION;
+  header.byte_order = BUNDLE_BYTE_ORDER;
+  header.probe = key_for_chars(BUNDLE_PROBE, sizeof(BUNDLE_PROBE) - 1);
+  header.member_count = count;
+  
+  /* records from names and sizes */
+  result = M2C_BUNDLE_STATUS_SUCCESS;
+  index = 0;
+  while ((result == M2C_BUNDLE_STATUS_SUCCESS) && (index < count)) {
+    if (NOT(member_for_file(files[index], &member[index], &kind))) {
+      result = M2C_BUNDLE_STATUS_INVALID_MEMBER_NAME;
+    }
+    else if ((stat(files[index], &info) != 0) ||
+        NOT(S_ISREG(info.st_mode))) {
+      result = M2C_BUNDLE_STATUS_IO_ERROR;
+    }
+    else {
+      record[index].key =
+        key_for_chars(member[index].name, member[index].length);
+      record[index].module = header.string_size;
+      record[index].length = member[index].length;
+      record[index].kind = (uint32_t) kind;
+      record[index].size = (uint64_t) info.st_size;
+      header.string_size += member[index].length + 1;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  /* identifiers */
+  string = NULL;
+  if (result == M2C_BUNDLE_STATUS_SUCCESS) {
+    string = malloc(header.string_size + 1);
+  
+    if (string == NULL) {
+      result = M2C_BUNDLE_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+  } /* end if */
+  
+  if (result == M2C_BUNDLE_STATUS_SUCCESS) {
+    for (index = 0; index < count; index++) {
+      memcpy(&string[record[index].module],
+        member[index].name, member[index].length);
+      string[record[index].module + member[index].length] = ASCII_NUL;
+    } /* end for */
+  } /* end if */
+  
+  /* index */
+  slot = NULL;
+  if (result == M2C_BUNDLE_STATUS_SUCCESS) {
+    slot = new_index(record, string, count, &slot_count, &duplicate);
+  
+    if (slot == NULL) {
+      result = duplicate ? M2C_BUNDLE_STATUS_DUPLICATE_MEMBER :
+        M2C_BUNDLE_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+  } /* end if */
+  
+  if (result != M2C_BUNDLE_STATUS_SUCCESS) {
+    free(string);
+    free(record);
+    free(member);
+    SET_STATUS(status, result);
+    return;
+  } /* end if */
+  
+  header.slot_count = slot_count;
+  
+  /* contents follow the identifiers,  aligned */
+  start = sizeof(m2c_bundle_header_t) +
+    (uint64_t) count * sizeof(m2c_bundle_record_t) +
+    (uint64_t) slot_count * sizeof(uint32_t) + header.string_size;
+  
+  offset = ALIGNED_SIZE(start);
+  for (index = 0; index < count; index++) {
+    record[index].offset = offset;
+    offset = ALIGNED_SIZE(offset + record[index].size);
+  } /* end for */
+  
+  /* write header, records, index, identifiers and contents */
+  file = fopen(path, "wb");
+  
+  if (file == NULL) {
+    result = M2C_BUNDLE_STATUS_IO_ERROR;
+  }
+  else {
+    if ((fwrite(&header, sizeof(m2c_bundle_header_t), 1, file) != 1) ||
+        ((count > 0) &&
+         (fwrite(record, sizeof(m2c_bundle_record_t), count, file) != count)) ||
+        (fwrite(slot, sizeof(uint32_t), slot_count, file) != slot_count) ||
+        ((header.string_size > 0) &&
+         (fwrite(string, 1, header.string_size, file) !=
+            header.string_size)) ||
+        NOT(write_padding(file, ALIGNED_SIZE(start) - start))) {
+      result = M2C_BUNDLE_STATUS_IO_ERROR;
+    } /* end if */
+  
+    index = 0;
+    while ((result == M2C_BUNDLE_STATUS_SUCCESS) && (index < count)) {
+      if (NOT(copy_file(file, files[index], record[index].size)) ||
+          NOT(write_padding(file,
+            ALIGNED_SIZE(record[index].size) - record[index].size))) {
+        result = M2C_BUNDLE_STATUS_IO_ERROR;
+      } /* end if */
+      index++;
+    } /* end while */
+  
+    if ((fclose(file) != 0) || (result != M2C_BUNDLE_STATUS_SUCCESS)) {
+      remove(path);
+      result = M2C_BUNDLE_STATUS_IO_ERROR;
+    } /* end if */
+  } /* end if */
+  
+  free(slot);
+  free(string);
+  free(record);
+  free(member);
+  
+  SET_STATUS(status, result);
+  return;
+} /* end m2c_write_bundle */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_open_bundle(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the library bundle at path and returns it,  or NULL on failure.
+ * Only the header and the sizes of the bundle's sections are checked.
+ * ----------------------------------------------------------------------- */
+
+m2c_bundle_t m2c_open_bundle
+  (const char *path, m2c_bundle_status_t *status) {
+  
+  m2c_bundle_status_t read_status;
+  m2c_bundle_t bundle;
+  const char *data;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_BUNDLE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  bundle = malloc(sizeof(m2c_bundle_s));
+  
+  if (bundle == NULL) {
+    SET_STATUS(status, M2C_BUNDLE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  memset(bundle, 0, sizeof(m2c_bundle_s));
+  read_status = read_file_data(bundle, path);
+  
+  if (read_status == M2C_BUNDLE_STATUS_SUCCESS) {
+    memcpy(&bundle->header, bundle->file_data, sizeof(m2c_bundle_header_t));
+  
+    if (NOT(is_valid_header(bundle))) {
+      read_status = M2C_BUNDLE_STATUS_INVALID_FILE;
+    } /* end if */
+  } /* end if */
+  
+  if (read_status != M2C_BUNDLE_STATUS_SUCCESS) {
+    release_file_data(bundle);
+    free(bundle);
+    SET_STATUS(status, read_status);
+    return NULL;
+  } /* end if */
+  
+  /* locate sections */
+  data = (const char *) bundle->file_data;
+  
+  bundle->record = (const m2c_bundle_record_t *)
+    (data + sizeof(m2c_bundle_header_t));
+  
+  bundle->slot =
+    (const uint32_t *) &bundle->record[bundle->header.member_count];
+  
+  bundle->string = (const char *) &bundle->slot[bundle->header.slot_count];
+  
+  SET_STATUS(status, M2C_BUNDLE_STATUS_SUCCESS);
+  return bundle;
+} /* end m2c_open_bundle */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bundle_member(bundle, module, kind, size)
+ * --------------------------------------------------------------------------
+ * Returns the contents of the member for module of kind,  or NULL.  Probes
+ * the index from the slot given by the key of module,  comparing keys and
+ * kinds first and characters only if they match.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_bundle_member
+  (m2c_bundle_t bundle,                 /* in */
+   intstr_t module,                     /* in */
+   m2c_bundle_kind_t kind,              /* in */
+   size_t *size) {                      /* out */
+  
+  const m2c_bundle_record_t *record;
+  uint32_t key, mask, index, probes, slot, length;
+  
+  if ((bundle == NULL) || (module == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  key = intstr_hash(module);
+  length = intstr_length(module);
+  mask = bundle->header.slot_count - 1;
+  index = key & mask;
+  
+  /* probe at most every slot once,  even if the index is malformed */
+  probes = 0;
+  while (probes < bundle->header.slot_count) {
+    slot = bundle->slot[index];
+  
+    if ((slot == 0) || (slot > bundle->header.member_count)) {
+      return NULL;
+    } /* end if */
+  
+    record = &bundle->record[slot - 1];
+  
+    if ((record->key == key) && (record->kind == (uint32_t) kind) &&
+        (record->length == length) && is_valid_record(bundle, record) &&
+        (memcmp(&bundle->string[record->module],
+           intstr_char_ptr(module), length) == 0)) {
+  
+      if (size != NULL) {
+        *size = (size_t) record->size;
+      } /* end if */
+  
+      return (const char *) bundle->file_data + record->offset;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+    probes++;
+  } /* end while */
+  
+  return NULL;
+} /* end m2c_bundle_member */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bundle_member_count(bundle)
+ * --------------------------------------------------------------------------
+ * Returns the number of members of bundle.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_bundle_member_count (m2c_bundle_t bundle) {
+  
+  if (bundle == NULL) {
+    return 0;
+  } /* end if */
+  
+  return bundle->header.member_count;
+} /* end m2c_bundle_member_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bundle_member_at(bundle, index, module, kind)
+ * --------------------------------------------------------------------------
+ * Passes back module identifier and kind of the member at index in bundle.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_bundle_member_at
+  (m2c_bundle_t bundle,                 /* in */
+   uint_t index,                        /* in */
+   intstr_t *module,                    /* out */
+   m2c_bundle_kind_t *kind) {           /* out */
+  
+  const m2c_bundle_record_t *record;
+  intstr_t ident;
+  
+  if ((bundle == NULL) || (index >= bundle->header.member_count)) {
+    return false;
+  } /* end if */
+  
+  record = &bundle->record[index];
+  
+  if (NOT(is_valid_record(bundle, record))) {
+    return false;
+  } /* end if */
+  
+  ident = intstr_for_slice(bundle->string, record->module, record->length,
+    NULL);
+  
+  if (ident == NULL) {
+    return false;
+  } /* end if */
+  
+  if (module != NULL) {
+    *module = ident;
+  } /* end if */
+  
+  if (kind != NULL) {
+    *kind = (m2c_bundle_kind_t) record->kind;
+  } /* end if */
+  
+  return true;
+} /* end m2c_bundle_member_at */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_bundle(bundle)
+ * --------------------------------------------------------------------------
+ * Closes bundle and passes NULL in bundle.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_bundle (m2c_bundle_t *bundle) {
+  
+  if ((bundle == NULL) || (*bundle == NULL)) {
+    return;
+  } /* end if */
+  
+  release_file_data(*bundle);
+  free(*bundle);
+  *bundle = NULL;
+  
+  return;
+} /* end m2c_release_bundle */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function member_for_file(file, member, kind)
+ * --------------------------------------------------------------------------
+ * Passes back the member for the file at pathname file  and its kind by the
+ * suffix of file.  Returns false if file is NULL,  its suffix is not one of
+ * a bundle member  or its basename is empty or contains characters that
+ * cannot be part of a module identifier.
+ * ----------------------------------------------------------------------- */
+
+static bool member_for_file
+  (const char *file, m2c_bundle_member_t *member, m2c_bundle_kind_t *kind) {
+  
+  const char *name, *suffix, *ch;
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  name = strrchr(file, '/');
+  name = (name == NULL) ? file : name + 1;
+  suffix = strrchr(name, '.');
+  
+  if ((suffix == NULL) || (suffix == name)) {
+    return false;
+  } /* end if */
+  
+  if (strcmp(suffix, ".def") == 0) {
+    *kind = M2C_BUNDLE_KIND_DEF;
+  }
+  else if (strcmp(suffix, ".mod") == 0) {
+    *kind = M2C_BUNDLE_KIND_MOD;
+  }
+  else if (strcmp(suffix, ".sym") == 0) {
+    *kind = M2C_BUNDLE_KIND_SYM;
+  }
+  else if (strcmp(suffix, ".exl") == 0) {
+    *kind = M2C_BUNDLE_KIND_EXL;
+  }
+  else {
+    return false;
+  } /* end if */
+  
+  /* identifiers are printable and have no spaces */
+  for (ch = name; ch < suffix; ch++) {
+    if ((*ch <= ' ') || (*ch > '~')) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  member->file = file;
+  member->name = name;
+  member->length = (uint32_t) (suffix - name);
+  
+  return true;
+} /* end member_for_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_index(record, string, count, slot_count, duplicate)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated hash index on the count records of array record
+ * whose identifiers are in string table string,  and passes back its number
+ * of slots in slot_count.  The index is a power of two at least twice the
+ * number of records.  Returns NULL if allocation failed or two records are
+ * of the same module and kind,  passing back true in duplicate in the
+ * latter case.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t *new_index
+  (const m2c_bundle_record_t *record, const char *string,
+   uint32_t count, uint32_t *slot_count, bool *duplicate) {
+  
+  const m2c_bundle_record_t *other;
+  uint32_t *slot, index, mask, n;
+  
+  *duplicate = false;
+  
+  *slot_count = BUNDLE_MIN_SLOT_COUNT;
+  while (*slot_count < 2 * count) {
+    *slot_count = 2 * *slot_count;
+  } /* end while */
+  
+  slot = calloc(*slot_count, sizeof(uint32_t));
+  
+  if (slot == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = *slot_count - 1;
+  
+  for (n = 0; n < count; n++) {
+    index = record[n].key & mask;
+    while (slot[index] != 0) {
+      other = &record[slot[index] - 1];
+  
+      if ((other->key == record[n].key) &&
+          (other->kind == record[n].kind) &&
+          (other->length == record[n].length) &&
+          (memcmp(&string[other->module],
+             &string[record[n].module], record[n].length) == 0)) {
+        free(slot);
+        *duplicate = true;
+        return NULL;
+      } /* end if */
+  
+      index = (index + 1) & mask;
+    } /* end while */
+    slot[index] = n + 1;
+  } /* end for */
+  
+  return slot;
+} /* end new_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_padding(file, size)
+ * --------------------------------------------------------------------------
+ * Writes size zero bytes to file,  size must be less than BUNDLE_ALIGNMENT.
+ * Returns false on write failure.
+ * ----------------------------------------------------------------------- */
+
+static bool write_padding (FILE *file, uint64_t size) {
+  
+  static const char zero[BUNDLE_ALIGNMENT] = { 0 };
+  
+  return (size == 0) || (fwrite(zero, 1, (size_t) size, file) == size);
+} /* end write_padding */
+
+
+/* --------------------------------------------------------------------------
+ * private function copy_file(file, path, size)
+ * --------------------------------------------------------------------------
+ * Copies the contents of the file at path to file.  Returns false if the
+ * file could not be read,  its size is not size or writing failed.
+ * ----------------------------------------------------------------------- */
+
+#define COPY_BUFFER_SIZE 8192
+
+static bool copy_file (FILE *file, const char *path, uint64_t size) {
+  
+  char buffer[COPY_BUFFER_SIZE];
+  uint64_t copied;
+  size_t chunk;
+  FILE *source;
+  
+  source = fopen(path, "rb");
+  
+  if (source == NULL) {
+    return false;
+  } /* end if */
+  
+  copied = 0;
+  while ((chunk = fread(buffer, 1, COPY_BUFFER_SIZE, source)) > 0) {
+    if ((copied + chunk > size) ||
+        (fwrite(buffer, 1, chunk, file) != chunk)) {
+      fclose(source);
+      return false;
+    } /* end if */
+    copied = copied + chunk;
+  } /* end while */
+  
+  if (ferror(source)) {
+    fclose(source);
+    return false;
+  } /* end if */
+  
+  fclose(source);
+  
+  return (copied == size);
+} /* end copy_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function key_for_chars(str, length)
+ * --------------------------------------------------------------------------
+ * Returns the key of the length characters at str,  computed the way the
+ * string repository computes the keys of interned strings.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t key_for_chars (const char *str, uint32_t length) {
+  
+  intstr_hash_t key;
+  uint32_t index;
+  
+  key = HASH_INITIAL;
+  for (index = 0; index < length; index++) {
+    key = HASH_NEXT_CHAR(key, str[index]);
+  } /* end for */
+  
+  return HASH_FINAL(key);
+} /* end key_for_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_file_data(bundle, path)
+ * --------------------------------------------------------------------------
+ * Maps or reads the contents of the file at path into memory and records
+ * them in fields file_data,  file_size and is_mapped of bundle.  The file
+ * is never modified,  so it is mapped read-only and shared by all processes
+ * using the same library.
+ * ----------------------------------------------------------------------- */
+
+static m2c_bundle_status_t read_file_data
+  (m2c_bundle_t bundle, const char *path) {
+  
+#if (M2C_BUNDLE_USE_MMAP)
+  struct stat info;
+  void *map;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return M2C_BUNDLE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) || NOT(S_ISREG(info.st_mode))) {
+    close(fd);
+    return M2C_BUNDLE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) info.st_size < sizeof(m2c_bundle_header_t)) {
+    close(fd);
+    return M2C_BUNDLE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    return M2C_BUNDLE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  bundle->file_data = map;
+  bundle->file_size = (size_t) info.st_size;
+  bundle->is_mapped = true;
+  
+  return M2C_BUNDLE_STATUS_SUCCESS;
+#else
+  FILE *file;
+  void *data;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return M2C_BUNDLE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return M2C_BUNDLE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) size < sizeof(m2c_bundle_header_t)) {
+    fclose(file);
+    return M2C_BUNDLE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* malloc'd storage is suitably aligned for the records */
+  data = malloc((size_t) size);
+  
+  if (data == NULL) {
+    fclose(file);
+    return M2C_BUNDLE_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) size, file) != (size_t) size) {
+    free(data);
+    fclose(file);
+    return M2C_BUNDLE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  fclose(file);
+  
+  bundle->file_data = data;
+  bundle->file_size = (size_t) size;
+  bundle->is_mapped = false;
+  
+  return M2C_BUNDLE_STATUS_SUCCESS;
+#endif
+} /* end read_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_file_data(bundle)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates the file contents of bundle.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_bundle_t bundle) {
+  
+  if (bundle->file_data == NULL) {
+    return;
+  } /* end if */
+  
+#if (M2C_BUNDLE_USE_MMAP)
+  if (bundle->is_mapped) {
+    munmap(bundle->file_data, bundle->file_size);
+  }
+  else {
+    free(bundle->file_data);
+  } /* end if */
+#else
+  free(bundle->file_data);
+#endif
+  
+  bundle->file_data = NULL;
+  bundle->file_size = 0;
+  
+  return;
+} /* end release_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_header(bundle)
+ * --------------------------------------------------------------------------
+ * Returns true if the header of bundle was written by this build with the
+ * same format,  its index is a power of two larger than its record count,
+ * its string table is NUL terminated and the sections preceding the member
+ * contents fit into the file,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_header (m2c_bundle_t bundle) {
+  
+  const m2c_bundle_header_t *header;
+  uint64_t size;
+  
+  header = &bundle->header;
+  
+  if ((memcmp(header->magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0) ||
+      (header->version != M2C_BUNDLE_VERSION) ||
+      (header->byte_order != BUNDLE_BYTE_ORDER) ||
+      (header->probe !=
+         key_for_chars(BUNDLE_PROBE, sizeof(BUNDLE_PROBE) - 1)) ||
+      (header->slot_count <= header->member_count) ||
+      ((header->slot_count & (header->slot_count - 1)) != 0)) {
+    return false;
+  } /* end if */
+  
+  size = (uint64_t) sizeof(m2c_bundle_header_t) +
+    (uint64_t) header->member_count * sizeof(m2c_bundle_record_t) +
+    (uint64_t) header->slot_count * sizeof(uint32_t) +
+    (uint64_t) header->string_size;
+  
+  if (size > (uint64_t) bundle->file_size) {
+    return false;
+  } /* end if */
+  
+  return (header->string_size == 0) ||
+    (((const char *) bundle->file_data)[size - 1] == ASCII_NUL);
+} /* end is_valid_header */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_record(bundle, record)
+ * --------------------------------------------------------------------------
+ * Returns true if the identifier and contents of record lie within bundle
+ * and its kind is a member kind,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_record
+  (m2c_bundle_t bundle, const m2c_bundle_record_t *record) {
+  
+  return
+    (record->module < bundle->header.string_size) &&
+    (record->length < bundle->header.string_size - record->module) &&
+    (record->kind < M2C_BUNDLE_KIND_COUNT) &&
+    (record->offset <= (uint64_t) bundle->file_size) &&
+    (record->size <= (uint64_t) bundle->file_size - record->offset);
+} /* end is_valid_record */
+
+
+/* END OF FILE */
@@ -0,0 +1,616 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-ll1-parser.c                                                          *
+ *                                                                           *
+ * Implementation of table driven LL(1) syntax checker module.               *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-ll1-parser.h"
+
+#include "m2c-lexer.h"
+#include "m2c-diagnostics.h"
+#include "m2c-tokenset.h"
+#include "m2c-pathnames.h"
+#include "m2c-statistics.h"
+#include "m2c-build-params.h"
+#include "interned-strings.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * generated parse table
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_TOKENSET_SEGMENT_BITWIDTH != 32)
+#error "m2c-ll1-tables.h requires M2C_TOKENSET_SEGMENT_BITWIDTH == 32"
+#endif
+
+#include "m2c-ll1-tables.h"
+
+
+/* --------------------------------------------------------------------------
+ * initial capacity of the parse stack, grows by doubling
+ * ----------------------------------------------------------------------- */
+
+#define LL1_INITIAL_STACK_DEPTH 256
+
+
+/* --------------------------------------------------------------------------
+ * private type ll1_context_t
+ * --------------------------------------------------------------------------
+ * Record type representing the state of a syntax check.  The stack holds
+ * the symbols still to be matched,  terminals as tokens and non-terminals
+ * as TOKEN_END_MARK plus their index.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lexer */ m2c_lexer_t lexer;
+  /* stats */ m2c_stats_t stats;
+  /* diagnostics */ m2c_diag_buffer_t diagnostics;
+  /* prior_diagnostics */ m2c_diag_buffer_t prior_diagnostics;
+  /* options */ m2c_compiler_options_t options;
+  /* filename */ const char *filename;
+  /* stack */ uint16_t *stack;
+  /* top */ size_t top;
+  /* capacity */ size_t capacity;
+  /* error_count */ uint_t error_count;
+  /* panic_mode */ bool panic_mode;
+  /* status */ m2c_parser_status_t status;
+} ll1_context_s;
+
+typedef ll1_context_s *ll1_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ll1_check_file(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Checks the syntax of the Modula-2 source file represented by srcpath.
+ * ----------------------------------------------------------------------- */
+
+static ll1_context_t new_ll1_context
+  (const char *srcpath, m2c_compiler_options_t options);
+
+static void release_ll1_context (ll1_context_t c);
+
+static m2c_token_t run_ll1_parser (ll1_context_t c);
+
+void m2c_ll1_check_file
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status)      /* out */ {
+  
+  ll1_context_t c;
+  
+  if ((srcpath == NULL) || (stats == NULL)) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (is_valid_pathname(srcpath) == false) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_PATHNAME);
+    return;
+  } /* end if */
+  
+  c = new_ll1_context(srcpath, options);
+  
+  if (c == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  m2c_stats_begin_phase(c->stats, M2C_STATS_PHASE_PARSE);
+  run_ll1_parser(c);
+  m2c_stats_end_phase(c->stats, M2C_STATS_PHASE_PARSE);
+  
+  /* update statistics counters */
+  m2c_stats_set_line_count(c->stats, m2c_lexer_current_line(c->lexer));
+  
+  m2c_stats_set(c->stats, M2C_STATS_TOKEN_COUNT,
+    (uint64_t) m2c_lexer_symbol_index(c->lexer) + 1);
+  
+  m2c_stats_set(c->stats, M2C_STATS_BYTES_READ,
+    (uint64_t) m2c_lexer_bytes_read(c->lexer));
+  
+  /* pass back statistics, the caller owns them now */
+  *stats = c->stats;
+  c->stats = NULL;
+  
+  SET_STATUS(status, c->status);
+  
+  release_ll1_context(c);
+} /* end m2c_ll1_check_file */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function new_ll1_context(srcpath, options)
+ * --------------------------------------------------------------------------
+ * Returns a new context with a lexer for the source file represented by
+ * srcpath,  a new statistics object,  a diagnostic buffer made current,  an
+ * empty parse stack  and compiler option snapshot options,  or NULL if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static ll1_context_t new_ll1_context
+  (const char *srcpath, m2c_compiler_options_t options) {
+  
+  ll1_context_t c;
+  m2c_pathname_view_t fnview;
+  
+  c = malloc(sizeof(ll1_context_s));
+  
+  if (c == NULL) {
+    return NULL;
+  } /* end if */
+  
+  c->stack = malloc(LL1_INITIAL_STACK_DEPTH * sizeof(uint16_t));
+  
+  if (c->stack == NULL) {
+    free(c);
+    return NULL;
+  } /* end if */
+  
+  c->diagnostics = m2c_diag_new_buffer(srcpath);
+  
+  if (c->diagnostics == NULL) {
+    free(c->stack);
+    free(c);
+    return NULL;
+  } /* end if */
+  
+  m2c_diag_set_limits(c->diagnostics,
+    m2c_compiler_option_max_errors(), m2c_compiler_option_max_warnings());
+  
+  c->prior_diagnostics = m2c_diag_current();
+  m2c_diag_set_current(c->diagnostics);
+  
+  m2c_new_lexer(&(c->lexer), intstr_for_cstr(srcpath, NULL), NULL);
+  
+  if (c->lexer == NULL) {
+    m2c_diag_flush(c->diagnostics, NULL, false, stdout);
+    m2c_diag_release(c->diagnostics);
+    m2c_diag_set_current(c->prior_diagnostics);
+    free(c->stack);
+    free(c);
+    return NULL;
+  } /* end if */
+  
+  c->stats = m2c_stats_new();
+  
+  if (c->stats == NULL) {
+    m2c_lexer_flush_diagnostics(c->lexer, c->diagnostics, false);
+    m2c_diag_release(c->diagnostics);
+    m2c_diag_set_current(c->prior_diagnostics);
+    m2c_release_lexer(&(c->lexer), NULL);
+    free(c->stack);
+    free(c);
+    return NULL;
+  } /* end if */
+  
+  /* the filename is the tail of srcpath */
+  if (split_pathname_view(srcpath, NULL, &fnview, NULL) !=
+      M2C_PATHNAME_STATUS_SUCCESS) {
+    fnview.offset = 0;
+  } /* end if */
+  
+  c->filename = srcpath + fnview.offset;
+  
+  c->options = options;
+  c->top = 0;
+  c->capacity = LL1_INITIAL_STACK_DEPTH;
+  c->error_count = 0;
+  c->panic_mode = false;
+  c->status = M2C_PARSER_STATUS_SUCCESS;
+  
+  return c;
+} /* end new_ll1_context */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_ll1_context(c)
+ * --------------------------------------------------------------------------
+ * Flushes the diagnostics of c,  with source lines if option --verbose is
+ * on,  releases the statistics object of c unless passed on,  its lexer,
+ * stack,  then c.  Makes the prior diagnostic buffer current again.
+ * ----------------------------------------------------------------------- */
+
+static void release_ll1_context (ll1_context_t c) {
+  
+  if (c->stats != NULL) {
+    m2c_stats_release(c->stats);
+  } /* end if */
+  
+  m2c_lexer_flush_diagnostics(c->lexer, c->diagnostics,
+    m2c_compiler_options_flag(c->options, M2C_COMPILER_OPTION_VERBOSE));
+  m2c_diag_release(c->diagnostics);
+  m2c_diag_set_current(c->prior_diagnostics);
+  
+  m2c_release_lexer(&(c->lexer), NULL);
+  free(c->stack);
+  free(c);
+} /* end release_ll1_context */
+
+
+/* --------------------------------------------------------------------------
+ * private function push_symbol(c, symbol)
+ * --------------------------------------------------------------------------
+ * Pushes symbol onto the parse stack of c,  doubling its capacity if full.
+ * Returns false if the stack could not be grown,  otherwise true.
+ * ----------------------------------------------------------------------- */
+
+static bool push_symbol (ll1_context_t c, uint16_t symbol) {
+  uint16_t *new_stack;
+  
+  if (c->top == c->capacity) {
+    new_stack = realloc(c->stack, 2 * c->capacity * sizeof(uint16_t));
+    
+    if (new_stack == NULL) {
+      return false;
+    } /* end if */
+    
+    c->stack = new_stack;
+    c->capacity = 2 * c->capacity;
+  } /* end if */
+  
+  c->stack[c->top] = symbol;
+  c->top++;
+  
+  return true;
+} /* end push_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private function expand_rule(c, rule)
+ * --------------------------------------------------------------------------
+ * Pushes the right hand side of rule onto the parse stack of c  in reverse
+ * order,  so that its first symbol is on top.  Returns false if the stack
+ * could not be grown,  otherwise true.
+ * ----------------------------------------------------------------------- */
+
+static bool expand_rule (ll1_context_t c, uint_t rule) {
+  uint_t start, index;
+  
+  start = ll1_rule_start[rule];
+  index = start + ll1_rule_length[rule];
+  
+  while (index > start) {
+    index--;
+    
+    if (push_symbol(c, ll1_rhs_symbol[index]) == false) {
+      return false;
+    } /* end if */
+  } /* end while */
+  
+  return true;
+} /* end expand_rule */
+
+
+/* --------------------------------------------------------------------------
+ * private function syntax_error_reportable(c)
+ * --------------------------------------------------------------------------
+ * Counts a syntax error and returns true if it should be reported.  Once
+ * the count exceeds M2C_MAX_SYNTAX_ERRORS,  emits a note,  switches to
+ * panic mode  and returns false for this and all further errors.  With
+ * option --max-errors,  once the diagnostics hold as many errors as the
+ * limit permits,  the remainder of the file is skipped instead.
+ * ----------------------------------------------------------------------- */
+
+static void skip_to_eof (ll1_context_t c);
+
+static bool syntax_error_reportable (ll1_context_t c) {
+  
+  char note[80];
+  
+  m2c_stats_inc(c->stats, M2C_STATS_SYNTAX_ERROR_COUNT);
+  c->status = M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND;
+  
+  if (c->panic_mode) {
+    return false;
+  } /* end if */
+  
+  c->error_count++;
+  
+  if (m2c_compiler_option_max_errors() > 0) {
+    if (m2c_diag_limit_reached(c->diagnostics, M2C_DIAG_ERROR)) {
+      snprintf(note, sizeof(note),
+        "error limit of %u reached, skipping to end of file",
+        m2c_compiler_option_max_errors());
+      m2c_diag_add(c->diagnostics, M2C_DIAG_NOTE,
+        m2c_lexer_lookahead_line(c->lexer),
+        m2c_lexer_lookahead_column(c->lexer), note);
+      
+      skip_to_eof(c);
+      return false;
+    } /* end if */
+    
+    return true;
+  } /* end if */
+  
+  if (c->error_count > M2C_MAX_SYNTAX_ERRORS) {
+    snprintf(note, sizeof(note),
+      "more than %u syntax errors, further errors not reported",
+      (unsigned int) M2C_MAX_SYNTAX_ERRORS);
+    m2c_diag_add(c->diagnostics, M2C_DIAG_NOTE,
+      m2c_lexer_lookahead_line(c->lexer),
+      m2c_lexer_lookahead_column(c->lexer), note);
+    
+    c->panic_mode = true;
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end syntax_error_reportable */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure skip_to_eof(c)
+ * --------------------------------------------------------------------------
+ * Consumes all remaining symbols without checking them  and switches to
+ * panic mode.  Line count and module digest are still updated by the lexer.
+ * ----------------------------------------------------------------------- */
+
+static void skip_to_eof (ll1_context_t c) {
+  
+  m2c_token_t lookahead;
+  
+  c->panic_mode = true;
+  
+  lookahead = m2c_next_sym(c->lexer);
+  
+  while (lookahead != TOKEN_EOF) {
+    lookahead = m2c_consume_sym(c->lexer);
+  } /* end while */
+  
+} /* end skip_to_eof */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_missing_token(c, lookahead, expected_token)
+ * --------------------------------------------------------------------------
+ * Reports a syntax error for lookahead where expected_token was expected.
+ * ----------------------------------------------------------------------- */
+
+static void describe_token
+  (char *str, size_t size, m2c_token_t token, const char *lexeme);
+
+static void report_syntax_error
+  (ll1_context_t c, m2c_token_t lookahead, const char *expected);
+
+static void report_missing_token
+  (ll1_context_t c, m2c_token_t lookahead, m2c_token_t expected_token) {
+  
+  char expected[80];
+  
+  if (syntax_error_reportable(c) == false) {
+    return;
+  } /* end if */
+  
+  describe_token(expected, sizeof(expected), expected_token, NULL);
+  report_syntax_error(c, lookahead, expected);
+} /* end report_missing_token */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_unexpected_token(c, lookahead, nt)
+ * --------------------------------------------------------------------------
+ * Reports a syntax error for lookahead where the FIRST set of non-terminal
+ * nt was expected.
+ * ----------------------------------------------------------------------- */
+
+static void report_unexpected_token
+  (ll1_context_t c, m2c_token_t lookahead, uint_t nt) {
+  
+  char expected[M2C_TOKENSET_LIST_STR_SIZE];
+  
+  if (syntax_error_reportable(c) == false) {
+    return;
+  } /* end if */
+  
+  m2c_tokenset_list_to_str
+    ((m2c_tokenset_t) &ll1_first_set[nt], expected, sizeof(expected));
+  report_syntax_error(c, lookahead, expected);
+} /* end report_unexpected_token */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_syntax_error(c, lookahead, expected)
+ * --------------------------------------------------------------------------
+ * Adds a syntax error for lookahead at the lookahead position to the
+ * diagnostics of c,  with the description of what was expected.
+ * ----------------------------------------------------------------------- */
+
+static void report_syntax_error
+  (ll1_context_t c, m2c_token_t lookahead, const char *expected) {
+  
+  char message[M2C_TOKENSET_LIST_STR_SIZE + 255];
+  char symbol[255];
+  
+  describe_token(symbol, sizeof(symbol), lookahead,
+    intstr_char_ptr(m2c_lexer_lookahead_lexeme(c->lexer)));
+  
+  snprintf(message, sizeof(message),
+    "unexpected %s found\n  expected %s", symbol, expected);
+  
+  m2c_diag_add(c->diagnostics, M2C_DIAG_ERROR,
+    m2c_lexer_lookahead_line(c->lexer),
+    m2c_lexer_lookahead_column(c->lexer), message);
+} /* end report_syntax_error */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure describe_token(str, size, token, lexeme)
+ * --------------------------------------------------------------------------
+ * Writes a description of token to str,  which holds size characters.  The
+ * lexeme of an identifier or literal is included,  unless it is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void describe_token
+  (char *str, size_t size, m2c_token_t token, const char *lexeme) {
+  
+  if (token == TOKEN_IDENT) {
+    if (lexeme != NULL) {
+      snprintf(str, size, "identifier '%s'", lexeme);
+    }
+    else /* no lexeme */ {
+      snprintf(str, size, "identifier");
+    } /* end if */
+  }
+  else if (M2C_IS_LITERAL_TOKEN(token)) {
+    if (lexeme != NULL) {
+      snprintf(str, size, "literal <<%s>>", lexeme);
+    }
+    else /* no lexeme */ {
+      snprintf(str, size, "literal");
+    } /* end if */
+  }
+  else if (M2C_IS_RESWORD_TOKEN(token)) {
+    snprintf(str, size, "reserved word %s", m2c_lexeme_for_resword(token));
+  }
+  else if (M2C_IS_SPECIAL_SYMBOL_TOKEN(token)) {
+    snprintf(str, size,
+      "symbol '%s'", m2c_lexeme_for_special_symbol(token));
+  }
+  else if (token == TOKEN_EOF) {
+    snprintf(str, size, "end of file");
+  }
+  else /* other token */ {
+    snprintf(str, size, "unknown token");
+  } /* end if */
+} /* end describe_token */
+
+
+/* --------------------------------------------------------------------------
+ * private function resync(c, nt, lookahead)
+ * --------------------------------------------------------------------------
+ * Skips symbols until the lookahead is in the FIRST set of non-terminal nt,
+ * in which case nt is pushed back for another attempt,  or in its FOLLOW
+ * set,  in which case nt is abandoned.  Gives up on nt at end of file or
+ * after M2C_MAX_SKIPPED_SYMBOLS symbols.  Returns the new lookahead.
+ * ----------------------------------------------------------------------- */
+
+static m2c_token_t resync (ll1_context_t c, uint_t nt, m2c_token_t lookahead) {
+  uint_t skipped;
+  
+  skipped = 0;
+  while ((lookahead != TOKEN_EOF) && (skipped < M2C_MAX_SKIPPED_SYMBOLS)) {
+    
+    if (m2c_tokenset_element
+        ((m2c_tokenset_t) &ll1_first_set[nt], lookahead)) {
+      /* cannot fail, nt has just been popped */
+      push_symbol(c, (uint16_t) (TOKEN_END_MARK + nt));
+      return lookahead;
+    } /* end if */
+    
+    if (m2c_tokenset_element
+        ((m2c_tokenset_t) &ll1_follow_set[nt], lookahead)) {
+      return lookahead;
+    } /* end if */
+    
+    lookahead = m2c_consume_sym(c->lexer);
+    skipped++;
+  } /* end while */
+  
+  return lookahead;
+} /* end resync */
+
+
+/* --------------------------------------------------------------------------
+ * private function run_ll1_parser(c)
+ * --------------------------------------------------------------------------
+ * Matches the source of c against the start symbol.  Terminals on top of
+ * the stack are matched against the lookahead  and a missing terminal is
+ * reported and assumed present.  Non-terminals are expanded by the rule in
+ * the parse table for the lookahead  or on failure reported and resynced.
+ * Every step consumes a symbol or pops one,  thus the loop terminates.
+ * Returns the final lookahead.
+ * ----------------------------------------------------------------------- */
+
+static m2c_token_t run_ll1_parser (ll1_context_t c) {
+  m2c_token_t lookahead;
+  uint16_t symbol;
+  uint_t nt, rule;
+  
+  push_symbol(c, LL1_NT(COMPILATION_UNIT));
+  
+  lookahead = m2c_next_sym(c->lexer);
+  
+  while (c->top > 0) {
+    c->top--;
+    symbol = c->stack[c->top];
+    
+    /* terminal */
+    if (symbol < TOKEN_END_MARK) {
+      if (symbol == lookahead) {
+        if (lookahead != TOKEN_EOF) {
+          lookahead = m2c_consume_sym(c->lexer);
+        } /* end if */
+      }
+      else /* missing */ {
+        report_missing_token(c, lookahead, symbol);
+      } /* end if */
+    }
+    /* non-terminal */
+    else {
+      nt = symbol - TOKEN_END_MARK;
+      rule = (lookahead < TOKEN_END_MARK) ? ll1_table[nt][lookahead] : 0;
+      
+      if (rule != 0) {
+        if (expand_rule(c, rule - 1) == false) {
+          c->status = M2C_PARSER_STATUS_ALLOCATION_FAILED;
+          return lookahead;
+        } /* end if */
+      }
+      else /* unexpected */ {
+        report_unexpected_token(c, lookahead, nt);
+        lookahead = resync(c, nt, lookahead);
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  return lookahead;
+} /* end run_ll1_parser */
+
+/* END OF FILE */
@@ -0,0 +1,1545 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-lsp-server.c                                                          *
+ *                                                                           *
+ * Implementation of language server mode.                                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-lsp-server.h"
+#include "m2c-document.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+
+/* --------------------------------------------------------------------------
+ * JSON-RPC error codes
+ * ----------------------------------------------------------------------- */
+
+#define LSP_PARSE_ERROR (-32700)
+#define LSP_INVALID_REQUEST (-32600)
+#define LSP_METHOD_NOT_FOUND (-32601)
+#define LSP_SERVER_NOT_INITIALIZED (-32002)
+
+
+/* --------------------------------------------------------------------------
+ * Maximum nesting depth of JSON values
+ * ----------------------------------------------------------------------- */
+
+#define JSON_MAX_DEPTH 64
+
+
+/* --------------------------------------------------------------------------
+ * private type json_kind_t
+ * --------------------------------------------------------------------------
+ * Enumeration representing the kinds of JSON values.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  JSON_NULL,
+  JSON_FALSE,
+  JSON_TRUE,
+  JSON_NUMBER,
+  JSON_STRING,
+  JSON_ARRAY,
+  JSON_OBJECT
+} json_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type json_node_t
+ * --------------------------------------------------------------------------
+ * Record type for a JSON value within a parsed message.  Key is the member
+ * name if the value is an object member.  Chars holds the unescaped value of
+ * a string or the notation of a number.  First is the index of the first
+ * element or member of an array or object,  next that of the following
+ * sibling,  -1 if there is none.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* kind */        json_kind_t kind;
+  /* key */         const char *key;
+  /* key_length */  size_t key_length;
+  /* chars */       const char *chars;
+  /* length */      size_t length;
+  /* first */       int first;
+  /* next */        int next;
+} json_node_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type json_t
+ * --------------------------------------------------------------------------
+ * Record type for a parsed message.  Strings are unescaped in place within
+ * the message text,  values refer to the nodes by index.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* node */      json_node_t *node;
+  /* count */     uint_t count;
+  /* capacity */  uint_t capacity;
+  /* pos */       char *pos;
+  /* end */       char *end;
+  /* failed */    bool failed;
+} json_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type out_buffer_t
+ * --------------------------------------------------------------------------
+ * Record type for a message being written.  Failed is set if allocation
+ * failed,  the message is then dropped.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* chars */     char *chars;
+  /* length */    size_t length;
+  /* capacity */  size_t capacity;
+  /* failed */    bool failed;
+} out_buffer_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type open_doc_t
+ * --------------------------------------------------------------------------
+ * Record type for a source opened by the client.
+ * ----------------------------------------------------------------------- */
+
+typedef struct open_doc_s *open_doc_t;
+
+struct open_doc_s {
+  /* uri */   char *uri;
+  /* doc */   m2c_document_t doc;
+  /* next */  open_doc_t next;
+};
+
+
+/* --------------------------------------------------------------------------
+ * private type server_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a language server.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* in */            FILE *in;
+  /* out */           FILE *out;
+  /* options */       m2c_compiler_options_t options;
+  /* initialized */   bool initialized;
+  /* shutdown */      bool shutdown;
+  /* docs */          open_doc_t docs;
+  /* message */       char *message;
+  /* capacity */      size_t capacity;
+  /* json */          json_t json;
+  /* reply */         out_buffer_t reply;
+} server_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool read_message (server_t *server, size_t *length);
+
+static bool dispatch (server_t *server, size_t length);
+
+static void release_server (server_t *server);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lsp_serve(in, out, options)
+ * --------------------------------------------------------------------------
+ * Serves the messages read from in,  writing to out,  until an exit
+ * notification is received or in reaches its end.  Returns the exit code.
+ * ----------------------------------------------------------------------- */
+
+int m2c_lsp_serve (FILE *in, FILE *out, m2c_compiler_options_t options) {
+  
+  server_t server;
+  size_t length;
+  int exit_code;
+  
+  if ((in == NULL) || (out == NULL)) {
+    return 1;
+  } /* end if */
+  
+  memset(&server, 0, sizeof(server_t));
+  server.in = in;
+  server.out = out;
+  server.options = options;
+  
+  exit_code = 1;
+  
+  while (read_message(&server, &length)) {
+    if (dispatch(&server, length) == false) {
+      exit_code = (server.shutdown) ? 0 : 1;
+      break;
+    } /* end if */
+  } /* end while */
+  
+  release_server(&server);
+  
+  return exit_code;
+} /* end m2c_lsp_serve */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function read_message(server, length)
+ * --------------------------------------------------------------------------
+ * Reads the header and body of the next message into the message buffer of
+ * server  and passes the length of the body in length.  A message with a
+ * missing or invalid Content-Length header is passed with length zero.
+ * Returns false if the end of input has been reached.
+ * ----------------------------------------------------------------------- */
+
+static bool read_message (server_t *server, size_t *length) {
+  
+  char line[256];
+  const char *field = "content-length:";
+  size_t line_length, content_length, index;
+  bool has_length;
+  char *new_message;
+  int ch;
+  
+  has_length = false;
+  content_length = 0;
+  
+  /* read header lines up to the empty line */
+  while (true) {
+    line_length = 0;
+    ch = fgetc(server->in);
+  
+    while ((ch != EOF) && (ch != '\n')) {
+      if ((ch != '\r') && (line_length < sizeof(line) - 1)) {
+        line[line_length] = (char) ch;
+        line_length++;
+      } /* end if */
+      ch = fgetc(server->in);
+    } /* end while */
+  
+    if (ch == EOF) {
+      return false;
+    } /* end if */
+  
+    if (line_length == 0) {
+      break;
+    } /* end if */
+  
+    line[line_length] = ASCII_NUL;
+  
+    /* header names are case insensitive */
+    for (index = 0; (field[index] != ASCII_NUL) &&
+         (tolower((unsigned char) line[index]) == field[index]); index++) {
+    } /* end for */
+  
+    if (field[index] == ASCII_NUL) {
+      while (line[index] == ' ') {
+        index++;
+      } /* end while */
+  
+      has_length = isdigit((unsigned char) line[index]);
+      content_length = 0;
+  
+      while ((isdigit((unsigned char) line[index])) &&
+             (content_length <= M2C_LSP_MAX_MESSAGE_SIZE)) {
+        content_length = 10 * content_length + (size_t) (line[index] - '0');
+        index++;
+      } /* end while */
+    } /* end if */
+  } /* end while */
+  
+  if ((has_length == false) || (content_length > M2C_LSP_MAX_MESSAGE_SIZE)) {
+    *length = 0;
+    return true;
+  } /* end if */
+  
+  /* read body */
+  if (content_length + 1 > server->capacity) {
+    new_message = realloc(server->message, content_length + 1);
+  
+    if (new_message == NULL) {
+      /* skip the body */
+      for (index = 0; index < content_length; index++) {
+        if (fgetc(server->in) == EOF) {
+          return false;
+        } /* end if */
+      } /* end for */
+  
+      *length = 0;
+      return true;
+    } /* end if */
+  
+    server->message = new_message;
+    server->capacity = content_length + 1;
+  } /* end if */
+  
+  if (fread(server->message, 1, content_length, server->in)
+      != content_length) {
+    return false;
+  } /* end if */
+  
+  server->message[content_length] = ASCII_NUL;
+  *length = content_length;
+  
+  return true;
+} /* end read_message */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_json_node(json, kind)
+ * --------------------------------------------------------------------------
+ * Appends a node of kind kind to json and returns its index,  or -1 if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static int new_json_node (json_t *json, json_kind_t kind) {
+  
+  json_node_t *new_node;
+  uint_t new_capacity;
+  
+  if (json->count == json->capacity) {
+    new_capacity = (json->capacity == 0) ? 64 : 2 * json->capacity;
+    new_node = realloc(json->node, new_capacity * sizeof(json_node_t));
+  
+    if (new_node == NULL) {
+      json->failed = true;
+      return -1;
+    } /* end if */
+  
+    json->node = new_node;
+    json->capacity = new_capacity;
+  } /* end if */
+  
+  new_node = &json->node[json->count];
+  new_node->kind = kind;
+  new_node->key = NULL;
+  new_node->key_length = 0;
+  new_node->chars = NULL;
+  new_node->length = 0;
+  new_node->first = -1;
+  new_node->next = -1;
+  
+  json->count++;
+  
+  return (int) json->count - 1;
+} /* end new_json_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure skip_space(json)
+ * --------------------------------------------------------------------------
+ * Skips whitespace at the current position of json.
+ * ----------------------------------------------------------------------- */
+
+static void skip_space (json_t *json) {
+  
+  while ((json->pos < json->end) &&
+         ((*json->pos == ' ') || (*json->pos == ASCII_TAB) ||
+          (*json->pos == ASCII_LF) || (*json->pos == ASCII_CR))) {
+    json->pos++;
+  } /* end while */
+  
+  return;
+} /* end skip_space */
+
+
+/* --------------------------------------------------------------------------
+ * private function hex_value(chars, value)
+ * --------------------------------------------------------------------------
+ * Converts the four hexadecimal digits at chars,  passes their value in
+ * value  and returns true,  or returns false if chars are not hex digits.
+ * ----------------------------------------------------------------------- */
+
+static bool hex_value (const char *chars, unsigned long *value) {
+  
+  uint_t index;
+  int digit;
+  
+  *value = 0;
+  for (index = 0; index < 4; index++) {
+    digit = (unsigned char) chars[index];
+  
+    if (isxdigit(digit) == false) {
+      return false;
+    } /* end if */
+  
+    *value = 16 * *value + (unsigned long)
+      ((isdigit(digit)) ? digit - '0' : tolower(digit) - 'a' + 10);
+  } /* end for */
+  
+  return true;
+} /* end hex_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_string(json, chars, length)
+ * --------------------------------------------------------------------------
+ * Parses the string literal at the current position of json,  unescaping it
+ * in place to UTF-8,  and passes its value in chars and length.  Returns
+ * false if the literal is malformed.
+ * ----------------------------------------------------------------------- */
+
+static bool parse_string (json_t *json, const char **chars, size_t *length) {
+  
+  char *read, *write;
+  unsigned long code, low;
+  
+  /* skip opening quote */
+  read = json->pos + 1;
+  write = read;
+  *chars = read;
+  
+  while ((read < json->end) && (*read != '\"')) {
+  
+    if ((unsigned char) *read < 0x20) {
+      return false;
+    } /* end if */
+  
+    if (*read != '\\') {
+      *write++ = *read++;
+      continue;
+    } /* end if */
+  
+    /* escape sequence */
+    read++;
+    if (read >= json->end) {
+      return false;
+    } /* end if */
+  
+    switch (*read) {
+      case '\"' :
+      case '\\' :
+      case '/' :
+        *write++ = *read;
+        break;
+      case 'b' :
+        *write++ = '\b';
+        break;
+      case 'f' :
+        *write++ = '\f';
+        break;
+      case 'n' :
+        *write++ = '\n';
+        break;
+      case 'r' :
+        *write++ = '\r';
+        break;
+      case 't' :
+        *write++ = '\t';
+        break;
+      case 'u' :
+        if ((json->end - read < 5) || (hex_value(read + 1, &code) == false)) {
+          return false;
+        } /* end if */
+        read = read + 4;
+  
+        /* surrogate pair */
+        if ((code >= 0xD800) && (code <= 0xDBFF) &&
+            (json->end - read >= 7) && (read[1] == '\\') &&
+            (read[2] == 'u') && (hex_value(read + 3, &low)) &&
+            (low >= 0xDC00) && (low <= 0xDFFF)) {
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          read = read + 6;
+        } /* end if */
+  
+        /* encode as UTF-8,  never longer than the escape sequence */
+        if (code < 0x80) {
+          *write++ = (char) code;
+        }
+        else if (code < 0x800) {
+          *write++ = (char) (0xC0 | (code >> 6));
+          *write++ = (char) (0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000) {
+          *write++ = (char) (0xE0 | (code >> 12));
+          *write++ = (char) (0x80 | ((code >> 6) & 0x3F));
+          *write++ = (char) (0x80 | (code & 0x3F));
+        }
+        else /* supplementary plane */ {
+          *write++ = (char) (0xF0 | (code >> 18));
+          *write++ = (char) (0x80 | ((code >> 12) & 0x3F));
+          *write++ = (char) (0x80 | ((code >> 6) & 0x3F));
+          *write++ = (char) (0x80 | (code & 0x3F));
+        } /* end if */
+        break;
+      default :
+        return false;
+    } /* end switch */
+  
+    read++;
+  } /* end while */
+  
+  if (read >= json->end) {
+    return false;
+  } /* end if */
+  
+  *length = (size_t) (write - *chars);
+  json->pos = read + 1;
+  
+  return true;
+} /* end parse_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_value(json, depth)
+ * --------------------------------------------------------------------------
+ * Parses the value at the current position of json  and returns the index
+ * of its node,  or -1 if the value is malformed,  nested deeper than
+ * JSON_MAX_DEPTH or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static int parse_value (json_t *json, uint_t depth) {
+  
+  int index, member, last;
+  const char *key;
+  size_t key_length;
+  char *start;
+  
+  skip_space(json);
+  
+  if ((json->pos >= json->end) || (depth > JSON_MAX_DEPTH)) {
+    return -1;
+  } /* end if */
+  
+  switch (*json->pos) {
+  
+    case '{' :
+      index = new_json_node(json, JSON_OBJECT);
+      json->pos++;
+      skip_space(json);
+      last = -1;
+  
+      while ((index >= 0) && (json->pos < json->end) && (*json->pos != '}')) {
+        if ((last >= 0) && (*json->pos++ != ',')) {
+          return -1;
+        } /* end if */
+  
+        skip_space(json);
+  
+        if ((json->pos >= json->end) || (*json->pos != '\"') ||
+            (parse_string(json, &key, &key_length) == false)) {
+          return -1;
+        } /* end if */
+  
+        skip_space(json);
+  
+        if ((json->pos >= json->end) || (*json->pos++ != ':')) {
+          return -1;
+        } /* end if */
+  
+        member = parse_value(json, depth + 1);
+  
+        if (member < 0) {
+          return -1;
+        } /* end if */
+  
+        json->node[member].key = key;
+        json->node[member].key_length = key_length;
+  
+        if (last < 0) {
+          json->node[index].first = member;
+        }
+        else {
+          json->node[last].next = member;
+        } /* end if */
+  
+        last = member;
+        skip_space(json);
+      } /* end while */
+  
+      if ((index < 0) || (json->pos >= json->end)) {
+        return -1;
+      } /* end if */
+  
+      json->pos++;
+      return index;
+  
+    case '[' :
+      index = new_json_node(json, JSON_ARRAY);
+      json->pos++;
+      skip_space(json);
+      last = -1;
+  
+      while ((index >= 0) && (json->pos < json->end) && (*json->pos != ']')) {
+        if ((last >= 0) && (*json->pos++ != ',')) {
+          return -1;
+        } /* end if */
+  
+        member = parse_value(json, depth + 1);
+  
+        if (member < 0) {
+          return -1;
+        } /* end if */
+  
+        if (last < 0) {
+          json->node[index].first = member;
+        }
+        else {
+          json->node[last].next = member;
+        } /* end if */
+  
+        last = member;
+        skip_space(json);
+      } /* end while */
+  
+      if ((index < 0) || (json->pos >= json->end)) {
+        return -1;
+      } /* end if */
+  
+      json->pos++;
+      return index;
+  
+    case '\"' :
+      index = new_json_node(json, JSON_STRING);
+  
+      if ((index < 0) || (parse_string(json,
+          &json->node[index].chars, &json->node[index].length) == false)) {
+        return -1;
+      } /* end if */
+  
+      return index;
+  
+    default :
+      start = json->pos;
+  
+      while ((json->pos < json->end) &&
+             ((isalnum((unsigned char) *json->pos)) ||
+              (*json->pos == '-') || (*json->pos == '+') ||
+              (*json->pos == '.'))) {
+        json->pos++;
+      } /* end while */
+  
+      key_length = (size_t) (json->pos - start);
+  
+      if ((key_length == 4) && (strncmp(start, "null", 4) == 0)) {
+        return new_json_node(json, JSON_NULL);
+      }
+      else if ((key_length == 4) && (strncmp(start, "true", 4) == 0)) {
+        return new_json_node(json, JSON_TRUE);
+      }
+      else if ((key_length == 5) && (strncmp(start, "false", 5) == 0)) {
+        return new_json_node(json, JSON_FALSE);
+      }
+      else if ((key_length > 0) &&
+               ((isdigit((unsigned char) *start)) || (*start == '-'))) {
+        index = new_json_node(json, JSON_NUMBER);
+  
+        if (index >= 0) {
+          json->node[index].chars = start;
+          json->node[index].length = key_length;
+        } /* end if */
+  
+        return index;
+      } /* end if */
+  
+      return -1;
+  } /* end switch */
+} /* end parse_value */
+
+
+/* --------------------------------------------------------------------------
+ * private function json_member(json, index, name)
+ * --------------------------------------------------------------------------
+ * Returns the index of the member name of the object at index,  or -1 if
+ * the value at index is not an object or has no such member.
+ * ----------------------------------------------------------------------- */
+
+static int json_member (json_t *json, int index, const char *name) {
+  
+  size_t length;
+  int member;
+  
+  if ((index < 0) || (json->node[index].kind != JSON_OBJECT)) {
+    return -1;
+  } /* end if */
+  
+  length = strlen(name);
+  member = json->node[index].first;
+  
+  while (member >= 0) {
+    if ((json->node[member].key_length == length) &&
+        (memcmp(json->node[member].key, name, length) == 0)) {
+      return member;
+    } /* end if */
+  
+    member = json->node[member].next;
+  } /* end while */
+  
+  return -1;
+} /* end json_member */
+
+
+/* --------------------------------------------------------------------------
+ * private function json_path(json, index, name1, name2)
+ * --------------------------------------------------------------------------
+ * Returns the index of member name2 of member name1 of the object at index,
+ * or -1 if there is no such member.
+ * ----------------------------------------------------------------------- */
+
+static int json_path
+  (json_t *json, int index, const char *name1, const char *name2) {
+  
+  return json_member(json, json_member(json, index, name1), name2);
+} /* end json_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function json_uint(json, index, value)
+ * --------------------------------------------------------------------------
+ * Passes the value of the non-negative integer at index in value  and
+ * returns true,  or returns false if the value at index is not one.
+ * ----------------------------------------------------------------------- */
+
+static bool json_uint (json_t *json, int index, uint_t *value) {
+  
+  size_t pos;
+  
+  if ((index < 0) || (json->node[index].kind != JSON_NUMBER)) {
+    return false;
+  } /* end if */
+  
+  *value = 0;
+  for (pos = 0; pos < json->node[index].length; pos++) {
+    if ((isdigit((unsigned char) json->node[index].chars[pos]) == false) ||
+        (*value > (~(uint_t) 0 - 9) / 10)) {
+      return false;
+    } /* end if */
+  
+    *value = 10 * *value + (uint_t) (json->node[index].chars[pos] - '0');
+  } /* end for */
+  
+  return true;
+} /* end json_uint */
+
+
+/* --------------------------------------------------------------------------
+ * private function json_equals(json, index, str)
+ * --------------------------------------------------------------------------
+ * Returns true if the value at index is a string equal to str.
+ * ----------------------------------------------------------------------- */
+
+static bool json_equals (json_t *json, int index, const char *str) {
+  
+  size_t length;
+  
+  if ((index < 0) || (json->node[index].kind != JSON_STRING)) {
+    return false;
+  } /* end if */
+  
+  length = strlen(str);
+  
+  return (json->node[index].length == length) &&
+    (memcmp(json->node[index].chars, str, length) == 0);
+} /* end json_equals */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure out_chars(out, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends the length characters at chars to out.
+ * ----------------------------------------------------------------------- */
+
+static void out_chars (out_buffer_t *out, const char *chars, size_t length) {
+  
+  char *new_chars;
+  size_t new_capacity;
+  
+  if (out->failed) {
+    return;
+  } /* end if */
+  
+  if (out->length + length > out->capacity) {
+    new_capacity = (out->capacity == 0) ? 4096 : 2 * out->capacity;
+  
+    while (out->length + length > new_capacity) {
+      new_capacity = 2 * new_capacity;
+    } /* end while */
+  
+    new_chars = realloc(out->chars, new_capacity);
+  
+    if (new_chars == NULL) {
+      out->failed = true;
+      return;
+    } /* end if */
+  
+    out->chars = new_chars;
+    out->capacity = new_capacity;
+  } /* end if */
+  
+  memcpy(&out->chars[out->length], chars, length);
+  out->length = out->length + length;
+  
+  return;
+} /* end out_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure out_cstr(out, cstr)
+ * --------------------------------------------------------------------------
+ * Appends C string cstr to out.
+ * ----------------------------------------------------------------------- */
+
+static void out_cstr (out_buffer_t *out, const char *cstr) {
+  
+  out_chars(out, cstr, strlen(cstr));
+  
+  return;
+} /* end out_cstr */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure out_int(out, value)
+ * --------------------------------------------------------------------------
+ * Appends the decimal notation of value to out.
+ * ----------------------------------------------------------------------- */
+
+static void out_int (out_buffer_t *out, long value) {
+  
+  char digits[24];
+  
+  snprintf(digits, sizeof(digits), "%ld", value);
+  out_cstr(out, digits);
+  
+  return;
+} /* end out_int */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure out_string(out, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends the length characters at chars to out as a JSON string literal.
+ * ----------------------------------------------------------------------- */
+
+static void out_string (out_buffer_t *out, const char *chars, size_t length) {
+  
+  const char *hex = "0123456789abcdef";
+  char escape[6] = { '\\', 'u', '0', '0', '0', '0' };
+  size_t index, start;
+  unsigned char ch;
+  
+  out_chars(out, "\"", 1);
+  
+  start = 0;
+  for (index = 0; index < length; index++) {
+    ch = (unsigned char) chars[index];
+  
+    if ((ch < 0x20) || (ch == '\"') || (ch == '\\')) {
+      out_chars(out, &chars[start], index - start);
+      start = index + 1;
+  
+      if ((ch == '\"') || (ch == '\\')) {
+        escape[1] = (char) ch;
+        out_chars(out, escape, 2);
+        escape[1] = 'u';
+      }
+      else if (ch == ASCII_LF) {
+        out_chars(out, "\\n", 2);
+      }
+      else if (ch == ASCII_TAB) {
+        out_chars(out, "\\t", 2);
+      }
+      else /* other control character */ {
+        escape[4] = hex[ch >> 4];
+        escape[5] = hex[ch & 0x0F];
+        out_chars(out, escape, 6);
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  out_chars(out, &chars[start], length - start);
+  out_chars(out, "\"", 1);
+  
+  return;
+} /* end out_string */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure begin_response(server, id)
+ * --------------------------------------------------------------------------
+ * Starts a response to the request with id at index id in the reply buffer
+ * of server.  The id is null if index id is negative.
+ * ----------------------------------------------------------------------- */
+
+static void begin_response (server_t *server, int id) {
+  
+  json_node_t *node;
+  
+  server->reply.length = 0;
+  server->reply.failed = false;
+  out_cstr(&server->reply, "{\"jsonrpc\":\"2.0\",\"id\":");
+  
+  if (id < 0) {
+    out_cstr(&server->reply, "null");
+  }
+  else {
+    node = &server->json.node[id];
+  
+    if (node->kind == JSON_STRING) {
+      out_string(&server->reply, node->chars, node->length);
+    }
+    else /* number */ {
+      out_chars(&server->reply, node->chars, node->length);
+    } /* end if */
+  } /* end if */
+  
+  return;
+} /* end begin_response */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure send_reply(server)
+ * --------------------------------------------------------------------------
+ * Closes the message in the reply buffer of server and writes it to the
+ * output stream,  preceded by its header.
+ * ----------------------------------------------------------------------- */
+
+static void send_reply (server_t *server) {
+  
+  out_chars(&server->reply, "}", 1);
+  
+  if (server->reply.failed) {
+    return;
+  } /* end if */
+  
+  fprintf(server->out, "Content-Length: %lu\r\n\r\n",
+    (unsigned long) server->reply.length);
+  fwrite(server->reply.chars, 1, server->reply.length, server->out);
+  fflush(server->out);
+  
+  return;
+} /* end send_reply */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure send_error(server, id, code, message)
+ * --------------------------------------------------------------------------
+ * Sends an error response with code and message to the request with id at
+ * index id.
+ * ----------------------------------------------------------------------- */
+
+static void send_error
+  (server_t *server, int id, long code, const char *message) {
+  
+  begin_response(server, id);
+  out_cstr(&server->reply, ",\"error\":{\"code\":");
+  out_int(&server->reply, code);
+  out_cstr(&server->reply, ",\"message\":");
+  out_string(&server->reply, message, strlen(message));
+  out_cstr(&server->reply, "}");
+  send_reply(server);
+  
+  return;
+} /* end send_error */
+
+
+/* --------------------------------------------------------------------------
+ * private function utf16_column(chars, length, bytes)
+ * --------------------------------------------------------------------------
+ * Returns the number of UTF-16 code units of the first bytes of the length
+ * UTF-8 characters at chars.
+ * ----------------------------------------------------------------------- */
+
+static uint_t utf16_column (const char *chars, uint_t length, uint_t bytes) {
+  
+  uint_t index, units;
+  unsigned char ch;
+  
+  if (bytes > length) {
+    bytes = length;
+  } /* end if */
+  
+  units = 0;
+  for (index = 0; index < bytes; index++) {
+    ch = (unsigned char) chars[index];
+  
+    /* count lead bytes,  four byte sequences are surrogate pairs */
+    if ((ch & 0xC0) != 0x80) {
+      units = (ch >= 0xF0) ? units + 2 : units + 1;
+    } /* end if */
+  } /* end for */
+  
+  return units;
+} /* end utf16_column */
+
+
+/* --------------------------------------------------------------------------
+ * private function byte_column(chars, length, units)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes of the length UTF-8 characters at chars that
+ * encode the first units UTF-16 code units,  at most length.
+ * ----------------------------------------------------------------------- */
+
+static uint_t byte_column (const char *chars, uint_t length, uint_t units) {
+  
+  uint_t index, count;
+  
+  index = 0;
+  count = 0;
+  
+  while ((index < length) && (count < units)) {
+    count = ((unsigned char) chars[index] >= 0xF0) ? count + 2 : count + 1;
+  
+    /* skip continuation bytes */
+    index++;
+    while ((index < length) &&
+           (((unsigned char) chars[index] & 0xC0) == 0x80)) {
+      index++;
+    } /* end while */
+  } /* end while */
+  
+  return index;
+} /* end byte_column */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure doc_position(server, doc, pos, line, col)
+ * --------------------------------------------------------------------------
+ * Converts the protocol position at index pos to a line and byte column of
+ * doc counted from one.  Positions past the end of doc denote its end.
+ * ----------------------------------------------------------------------- */
+
+static void doc_position
+  (server_t *server, m2c_document_t doc, int pos, uint_t *line, uint_t *col) {
+  
+  const char *chars;
+  uint_t line_no, units, length;
+  
+  if (json_uint(&server->json, json_member(&server->json, pos, "line"),
+      &line_no) == false) {
+    line_no = 0;
+  } /* end if */
+  
+  if (json_uint(&server->json, json_member(&server->json, pos, "character"),
+      &units) == false) {
+    units = 0;
+  } /* end if */
+  
+  if (line_no >= m2c_document_line_count(doc)) {
+    *line = m2c_document_line_count(doc);
+    chars = m2c_document_line(doc, *line, &length);
+    *col = length + 1;
+  }
+  else {
+    *line = line_no + 1;
+    chars = m2c_document_line(doc, *line, &length);
+    *col = byte_column(chars, length, units) + 1;
+  } /* end if */
+  
+  return;
+} /* end doc_position */
+
+
+/* --------------------------------------------------------------------------
+ * private type diag_writer_t
+ * --------------------------------------------------------------------------
+ * Record type for the context of writing the diagnostics of a document.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* out */    out_buffer_t *out;
+  /* doc */    m2c_document_t doc;
+  /* count */  uint_t count;
+} diag_writer_t;
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_diag(severity, line, column, text, context)
+ * --------------------------------------------------------------------------
+ * Diagnostic visitor that writes a diagnostic as a protocol diagnostic.  A
+ * diagnostic with column zero covers its line,  others one character.
+ * ----------------------------------------------------------------------- */
+
+static void write_diag
+  (m2c_diag_severity_t severity, uint_t line, uint_t column,
+   const char *text, void *context) {
+  
+  diag_writer_t *writer = (diag_writer_t *) context;
+  const char *chars;
+  uint_t length, first, last;
+  
+  chars = m2c_document_line(writer->doc, line, &length);
+  
+  if (column == 0) {
+    first = 0;
+    last = utf16_column(chars, length, length);
+  }
+  else {
+    first = utf16_column(chars, length, column - 1);
+    last = first + 1;
+  } /* end if */
+  
+  line = (line > 0) ? line - 1 : 0;
+  
+  if (writer->count > 0) {
+    out_chars(writer->out, ",", 1);
+  } /* end if */
+  
+  out_cstr(writer->out, "{\"range\":{\"start\":{\"line\":");
+  out_int(writer->out, (long) line);
+  out_cstr(writer->out, ",\"character\":");
+  out_int(writer->out, (long) first);
+  out_cstr(writer->out, "},\"end\":{\"line\":");
+  out_int(writer->out, (long) line);
+  out_cstr(writer->out, ",\"character\":");
+  out_int(writer->out, (long) last);
+  out_cstr(writer->out, "}},\"severity\":");
+  out_int(writer->out, (severity == M2C_DIAG_ERROR) ? 1 :
+    (severity == M2C_DIAG_WARNING) ? 2 : 3);
+  out_cstr(writer->out, ",\"source\":\"m2c\",\"message\":");
+  out_string(writer->out, text, strlen(text));
+  out_chars(writer->out, "}", 1);
+  
+  writer->count++;
+  
+  return;
+} /* end write_diag */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure publish_diagnostics(server, uri, doc)
+ * --------------------------------------------------------------------------
+ * Sends the diagnostics of doc for uri to the client.  Sends an empty list
+ * if doc is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void publish_diagnostics
+  (server_t *server, const char *uri, m2c_document_t doc) {
+  
+  diag_writer_t writer;
+  
+  server->reply.length = 0;
+  server->reply.failed = false;
+  
+  out_cstr(&server->reply, "{\"jsonrpc\":\"2.0\",");
+  out_cstr(&server->reply, "\"method\":\"textDocument/publishDiagnostics\",");
+  out_cstr(&server->reply, "\"params\":{\"uri\":");
+  out_string(&server->reply, uri, strlen(uri));
+  out_cstr(&server->reply, ",\"diagnostics\":[");
+  
+  writer.out = &server->reply;
+  writer.doc = doc;
+  writer.count = 0;
+  
+  m2c_document_visit_diagnostics(doc, write_diag, &writer);
+  
+  out_cstr(&server->reply, "]}");
+  send_reply(server);
+  
+  return;
+} /* end publish_diagnostics */
+
+
+/* --------------------------------------------------------------------------
+ * private function path_for_uri(uri)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path for uri,  percent-decoded if uri is a file
+ * URI,  otherwise a copy of uri.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *path_for_uri (const char *uri) {
+  
+  const char *scheme = "file://";
+  unsigned long value;
+  char *path, *write;
+  char code[4];
+  
+  path = malloc(strlen(uri) + 1);
+  
+  if (path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  if (strncmp(uri, scheme, strlen(scheme)) != 0) {
+    strcpy(path, uri);
+    return path;
+  } /* end if */
+  
+  write = path;
+  uri = uri + strlen(scheme);
+  
+  while (*uri != ASCII_NUL) {
+    code[0] = '0';
+    code[1] = '0';
+  
+    if ((*uri == '%') && (isxdigit((unsigned char) uri[1])) &&
+        (isxdigit((unsigned char) uri[2]))) {
+      code[2] = uri[1];
+      code[3] = uri[2];
+      hex_value(code, &value);
+      *write++ = (char) value;
+      uri = uri + 3;
+    }
+    else {
+      *write++ = *uri++;
+    } /* end if */
+  } /* end while */
+  
+  *write = ASCII_NUL;
+  
+  return path;
+} /* end path_for_uri */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_doc(server, uri, length)
+ * --------------------------------------------------------------------------
+ * Returns the open document for the length characters of uri,  or NULL if
+ * no such document is open.
+ * ----------------------------------------------------------------------- */
+
+static open_doc_t find_doc (server_t *server, const char *uri, size_t length) {
+  
+  open_doc_t this_doc;
+  
+  this_doc = server->docs;
+  
+  while (this_doc != NULL) {
+    if ((strlen(this_doc->uri) == length) &&
+        (memcmp(this_doc->uri, uri, length) == 0)) {
+      return this_doc;
+    } /* end if */
+  
+    this_doc = this_doc->next;
+  } /* end while */
+  
+  return NULL;
+} /* end find_doc */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure did_open(server, params)
+ * --------------------------------------------------------------------------
+ * Handles notification textDocument/didOpen with parameters at params.
+ * ----------------------------------------------------------------------- */
+
+static void did_open (server_t *server, int params) {
+  
+  json_t *json = &server->json;
+  int uri, text;
+  char *path;
+  open_doc_t this_doc;
+  
+  uri = json_path(json, params, "textDocument", "uri");
+  text = json_path(json, params, "textDocument", "text");
+  
+  if ((uri < 0) || (json->node[uri].kind != JSON_STRING) ||
+      (text < 0) || (json->node[text].kind != JSON_STRING)) {
+    return;
+  } /* end if */
+  
+  this_doc = find_doc(server, json->node[uri].chars, json->node[uri].length);
+  
+  /* reopened without close */
+  if (this_doc != NULL) {
+    m2c_document_replace_text(this_doc->doc,
+      json->node[text].chars, json->node[text].length);
+    publish_diagnostics(server, this_doc->uri, this_doc->doc);
+    return;
+  } /* end if */
+  
+  this_doc = calloc(1, sizeof(struct open_doc_s));
+  
+  if (this_doc == NULL) {
+    return;
+  } /* end if */
+  
+  this_doc->uri = malloc(json->node[uri].length + 1);
+  
+  if (this_doc->uri == NULL) {
+    free(this_doc);
+    return;
+  } /* end if */
+  
+  memcpy(this_doc->uri, json->node[uri].chars, json->node[uri].length);
+  this_doc->uri[json->node[uri].length] = ASCII_NUL;
+  
+  path = path_for_uri(this_doc->uri);
+  
+  if (path != NULL) {
+    this_doc->doc = m2c_document_new(path,
+      json->node[text].chars, json->node[text].length, server->options);
+    free(path);
+  } /* end if */
+  
+  if (this_doc->doc == NULL) {
+    free(this_doc->uri);
+    free(this_doc);
+    return;
+  } /* end if */
+  
+  this_doc->next = server->docs;
+  server->docs = this_doc;
+  
+  publish_diagnostics(server, this_doc->uri, this_doc->doc);
+  
+  return;
+} /* end did_open */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure did_change(server, params)
+ * --------------------------------------------------------------------------
+ * Handles notification textDocument/didChange with parameters at params.
+ * Changes with a range are applied as edits,  others replace the text.
+ * ----------------------------------------------------------------------- */
+
+static void did_change (server_t *server, int params) {
+  
+  json_t *json = &server->json;
+  int uri, change, range, text;
+  uint_t first_line, first_col, last_line, last_col;
+  open_doc_t this_doc;
+  
+  uri = json_path(json, params, "textDocument", "uri");
+  change = json_member(json, params, "contentChanges");
+  
+  if ((uri < 0) || (json->node[uri].kind != JSON_STRING) ||
+      (change < 0) || (json->node[change].kind != JSON_ARRAY)) {
+    return;
+  } /* end if */
+  
+  this_doc = find_doc(server, json->node[uri].chars, json->node[uri].length);
+  
+  if (this_doc == NULL) {
+    return;
+  } /* end if */
+  
+  /* apply changes in order */
+  change = json->node[change].first;
+  
+  while (change >= 0) {
+    range = json_member(json, change, "range");
+    text = json_member(json, change, "text");
+  
+    if ((text >= 0) && (json->node[text].kind == JSON_STRING)) {
+  
+      if (range >= 0) {
+        doc_position(server, this_doc->doc,
+          json_member(json, range, "start"), &first_line, &first_col);
+        doc_position(server, this_doc->doc,
+          json_member(json, range, "end"), &last_line, &last_col);
+  
+        m2c_document_edit(this_doc->doc, first_line, first_col,
+          last_line, last_col, json->node[text].chars, json->node[text].length);
+      }
+      else /* whole text */ {
+        m2c_document_replace_text(this_doc->doc,
+          json->node[text].chars, json->node[text].length);
+      } /* end if */
+    } /* end if */
+  
+    change = json->node[change].next;
+  } /* end while */
+  
+  publish_diagnostics(server, this_doc->uri, this_doc->doc);
+  
+  return;
+} /* end did_change */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure did_close(server, params)
+ * --------------------------------------------------------------------------
+ * Handles notification textDocument/didClose with parameters at params.
+ * ----------------------------------------------------------------------- */
+
+static void did_close (server_t *server, int params) {
+  
+  json_t *json = &server->json;
+  open_doc_t this_doc, *link;
+  int uri;
+  
+  uri = json_path(json, params, "textDocument", "uri");
+  
+  if ((uri < 0) || (json->node[uri].kind != JSON_STRING)) {
+    return;
+  } /* end if */
+  
+  this_doc = find_doc(server, json->node[uri].chars, json->node[uri].length);
+  
+  if (this_doc == NULL) {
+    return;
+  } /* end if */
+  
+  /* unlink */
+  link = &server->docs;
+  while (*link != this_doc) {
+    link = &(*link)->next;
+  } /* end while */
+  
+  *link = this_doc->next;
+  
+  publish_diagnostics(server, this_doc->uri, NULL);
+  
+  m2c_document_release(this_doc->doc);
+  free(this_doc->uri);
+  free(this_doc);
+  
+  return;
+} /* end did_close */
+
+
+/* --------------------------------------------------------------------------
+ * private function dispatch(server, length)
+ * --------------------------------------------------------------------------
+ * Handles the message of length length in the message buffer of server.
+ * Returns false if the message is an exit notification.
+ * ----------------------------------------------------------------------- */
+
+static bool dispatch (server_t *server, size_t length) {
+  
+  json_t *json = &server->json;
+  int root, method, id, params;
+  
+  json->count = 0;
+  json->failed = false;
+  json->pos = server->message;
+  json->end = server->message + length;
+  
+  root = (length > 0) ? parse_value(json, 0) : -1;
+  
+  if ((root < 0) || (json->node[root].kind != JSON_OBJECT)) {
+    send_error(server, -1, LSP_PARSE_ERROR, "Parse error");
+    return true;
+  } /* end if */
+  
+  method = json_member(json, root, "method");
+  id = json_member(json, root, "id");
+  params = json_member(json, root, "params");
+  
+  if ((id >= 0) && (json->node[id].kind != JSON_NUMBER) &&
+      (json->node[id].kind != JSON_STRING)) {
+    send_error(server, -1, LSP_INVALID_REQUEST, "Invalid request");
+    return true;
+  } /* end if */
+  
+  /* responses to requests of the server are ignored */
+  if (method < 0) {
+    return true;
+  } /* end if */
+  
+  if (json_equals(json, method, "exit")) {
+    return false;
+  } /* end if */
+  
+  if (server->initialized == false) {
+  
+    if (json_equals(json, method, "initialize") && (id >= 0)) {
+      server->initialized = true;
+  
+      begin_response(server, id);
+      out_cstr(&server->reply, ",\"result\":{\"capabilities\":{");
+      out_cstr(&server->reply,
+        "\"textDocumentSync\":{\"openClose\":true,\"change\":2}},");
+      out_cstr(&server->reply, "\"serverInfo\":{\"name\":\"m2c\",");
+      out_cstr(&server->reply, "\"version\":\"" M2C_VERSION "\"}}");
+      send_reply(server);
+    }
+    else if (id >= 0) {
+      send_error(server, id,
+        LSP_SERVER_NOT_INITIALIZED, "Server not initialized");
+    } /* end if */
+  
+    return true;
+  } /* end if */
+  
+  if (json_equals(json, method, "shutdown")) {
+    server->shutdown = true;
+  
+    if (id >= 0) {
+      begin_response(server, id);
+      out_cstr(&server->reply, ",\"result\":null");
+      send_reply(server);
+    } /* end if */
+  }
+  else if (server->shutdown) {
+    if (id >= 0) {
+      send_error(server, id, LSP_INVALID_REQUEST, "Server shut down");
+    } /* end if */
+  }
+  else if (json_equals(json, method, "textDocument/didOpen")) {
+    did_open(server, params);
+  }
+  else if (json_equals(json, method, "textDocument/didChange")) {
+    did_change(server, params);
+  }
+  else if (json_equals(json, method, "textDocument/didClose")) {
+    did_close(server, params);
+  }
+  else if (id >= 0) {
+    send_error(server, id, LSP_METHOD_NOT_FOUND, "Method not found");
+  } /* end if */
+  
+  return true;
+} /* end dispatch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_server(server)
+ * --------------------------------------------------------------------------
+ * Deallocates the open documents and buffers of server.
+ * ----------------------------------------------------------------------- */
+
+static void release_server (server_t *server) {
+  
+  open_doc_t this_doc, next_doc;
+  
+  this_doc = server->docs;
+  
+  while (this_doc != NULL) {
+    next_doc = this_doc->next;
+    m2c_document_release(this_doc->doc);
+    free(this_doc->uri);
+    free(this_doc);
+    this_doc = next_doc;
+  } /* end while */
+  
+  free(server->message);
+  free(server->json.node);
+  free(server->reply.chars);
+  
+  return;
+} /* end release_server */
+
+
+/* END OF FILE */
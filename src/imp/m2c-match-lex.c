@@ -41,13 +41,22 @@
  * imports
  * ----------------------------------------------------------------------- */
 
+#include "m2c-match-lex.h"
+
 #include "iso646.h"
 #include "infile.h"
 #include "m2c-token.h"
-#include "m2c-resword.h"
+#include "m2c-char-class.h"
+#include "hash.h"
+#include "m2c-reswords.h"
 #include "m2c-error-reporter.h"
 #include "m2c-compiler-options.h"
 
+#include "m2c-build-params.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <stdbool.h>
 
 
@@ -64,16 +73,20 @@
 char m2c_match_ident
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
   char next_char;
+  intstr_hash_t key;
   
   infile_mark_lexeme(infile);
 
-  next_char := infile_lookahead_char(infile);
+  /* hash while scanning */
+  key = HASH_INITIAL;
+  next_char = infile_lookahead_char(infile);
   while (IS_LETTER_OR_DIGIT(next_char)) {
+    key = HASH_NEXT_CHAR(key, next_char);
     next_char = infile_consume_char(infile);
   } /* end while */
 
   *token = TOKEN_IDENT;
-  *lexeme = infile_lexeme(infile);
+  *lexeme = infile_lexeme_with_hash(infile, HASH_FINAL(key));
   
   return next_char;
 } /* end m2c_match_ident */
@@ -93,24 +106,26 @@ static char match_lowline_ident_tail(infile_t infile, m2c_token_t *token);
 char m2c_match_lowline_ident
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
   char next_char;
-  m2c_token_t result;
-  bool malformed = false;
+  intstr_hash_t key;
   
   infile_mark_lexeme(infile);
   
-  /* (Letter | Digit)* */
+  /* (Letter | Digit)*, hash while scanning */
+  key = HASH_INITIAL;
+  next_char = infile_lookahead_char(infile);
   while (IS_LETTER_OR_DIGIT(next_char)) {
-    next_char := infile_lookahead_char(infile);
-  } /* end if */
+    key = HASH_NEXT_CHAR(key, next_char);
+    next_char = infile_consume_char(infile);
+  } /* end while */
   
   if (next_char != '_') {
     *token = TOKEN_IDENT;
+    *lexeme = infile_lexeme_with_hash(infile, HASH_FINAL(key));
   }
-  else /* lowline ident tail */
+  else /* lowline ident tail, rare enough to be hashed on interning */ {
     next_char = match_lowline_ident_tail(infile, token);
+    *lexeme = infile_lexeme(infile);
   } /* end if */
-
-  *lexeme = infile_lexeme(infile);
   
   return next_char;
 } /* end m2c_match_lowline_ident */
@@ -127,31 +142,36 @@ char m2c_match_lowline_ident
 char m2c_match_ident_or_resword
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
   char next_char;
+  intstr_hash_t key;
   
   infile_mark_lexeme(infile);
   
-  /* collect all uppercase letters */
+  /* collect all uppercase letters, hash while scanning */
+  key = HASH_INITIAL;
   next_char = infile_lookahead_char(infile);
   while (IS_UPPER_LETTER(next_char)) {
+    key = HASH_NEXT_CHAR(key, next_char);
     next_char = infile_consume_char(infile);
   } /* end while */
   
   /* check if followed by lowercase letter or digit */
-  if (IS_LOWER_LETTER(next_char) || IS_DIGIT(next_char)) {
+  if (CHAR_HAS_CLASS(next_char, CC_LOWER | CC_DIGIT)) {
+    key = HASH_NEXT_CHAR(key, next_char);
     next_char = infile_consume_char(infile);
     
     /* collect any remaining letters and digits */
     while (IS_LETTER_OR_DIGIT(next_char)) {
+      key = HASH_NEXT_CHAR(key, next_char);
       next_char = infile_consume_char(infile);
     } /* end while */
     
     /* cannot be a resword */
-    *lexeme = infile_lexeme(infile);
-    *token = TOKEN_STDIDENT;
+    *lexeme = infile_lexeme_with_hash(infile, HASH_FINAL(key));
+    *token = TOKEN_IDENT;
   }
   else /* identifier or resword */ {
-    *lexeme = infile_lexeme(infile);
-    *token = m2c_token_for_ident_or_resword(TOKEN_IDENT, lexeme);
+    *lexeme = infile_lexeme_with_hash(infile, HASH_FINAL(key));
+    *token = m2c_resword_token_for_lexeme(*lexeme, TOKEN_IDENT);
   } /* end if*/
   
   return next_char;
@@ -170,40 +190,90 @@ char m2c_match_ident_or_resword
 char m2c_match_lowline_ident_or_resword
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
   char next_char;
+  intstr_hash_t key;
   
   infile_mark_lexeme(infile);
   
-  /* collect all uppercase letters */
+  /* collect all uppercase letters, hash while scanning */
+  key = HASH_INITIAL;
   next_char = infile_lookahead_char(infile);
   while (IS_UPPER_LETTER(next_char)) {
+    key = HASH_NEXT_CHAR(key, next_char);
     next_char = infile_consume_char(infile);
   } /* end while */
   
   /* check if followed by lowercase letter or digit */
-  if (IS_LOWER_LETTER(next_char) || IS_DIGIT(next_char)) {
+  if (CHAR_HAS_CLASS(next_char, CC_LOWER | CC_DIGIT)) {
+    key = HASH_NEXT_CHAR(key, next_char);
     next_char = infile_consume_char(infile);
     
     /* collect any remaining letters and digits */
     while (IS_LETTER_OR_DIGIT(next_char)) {
+      key = HASH_NEXT_CHAR(key, next_char);
       next_char = infile_consume_char(infile);
     } /* end while */
 
     if (next_char != '_') {
       *token = TOKEN_IDENT;
+      *lexeme = infile_lexeme_with_hash(infile, HASH_FINAL(key));
     }
-    else /* lowline ident tail */
+    else /* lowline ident tail, hashed on interning */ {
       next_char = match_lowline_ident_tail(infile, token);
+      *lexeme = infile_lexeme(infile);
     } /* end if */
-
-    *lexeme = infile_lexeme(infile);
   }
   else /* identifier or resword */ {
-    *lexeme = infile_lexeme(infile);
-    *token = m2c_token_for_ident_or_resword(TOKEN_IDENT, lexeme);
+    *lexeme = infile_lexeme_with_hash(infile, HASH_FINAL(key));
+    *token = m2c_resword_token_for_lexeme(*lexeme, TOKEN_IDENT);
   } /* end if*/
   
   return next_char;
-} /* end m2c_match_ident_or_resword */
+} /* end m2c_match_lowline_ident_or_resword */
+
+
+/* --------------------------------------------------------------------------
+ * private type num_accum_t
+ * --------------------------------------------------------------------------
+ * Record type to accumulate the value of a numeric literal while its digits
+ * are consumed.  Whole numbers and character codes accumulate in mantissa.
+ * Real numbers accumulate up to 19 significant digits in mantissa  with a
+ * decimal exponent;  if further digits had to be dropped,  truncated is set
+ * and the value is converted from the lexeme instead.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  uint64_t mantissa;    /* accumulated digits */
+  int exponent;         /* decimal exponent of mantissa */
+  uint_t exp_digits;    /* value of explicit exponent */
+  bool exp_negative;    /* true if explicit exponent is negative */
+  bool overflow;        /* true if an integral digit did not fit */
+  bool truncated;       /* true if a significant digit was dropped */
+} num_accum_t;
+
+#define NUM_ACCUM_INITIAL { 0, 0, 0, false, false, false }
+
+
+/* --------------------------------------------------------------------------
+ * private type digit_role_t
+ * --------------------------------------------------------------------------
+ * Role of the digits of a decimal digit sequence within a numeric literal.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  DIGITS_INTEGRAL,      /* digits before the decimal point */
+  DIGITS_FRACTIONAL,    /* digits after the decimal point */
+  DIGITS_EXPONENT       /* digits of the exponent */
+} digit_role_t;
+
+
+/* --------------------------------------------------------------------------
+ * private macro DIGIT_VALUE(ch)
+ * --------------------------------------------------------------------------
+ * Returns the value of decimal or uppercase base-16 digit ch.
+ * ----------------------------------------------------------------------- */
+
+#define DIGIT_VALUE(_ch) \
+  (IS_DECIMAL_DIGIT(_ch) ? (uint_t) ((_ch) - '0') : (uint_t) ((_ch) - 'A' + 10))
 
 
 /* --------------------------------------------------------------------------
@@ -214,77 +284,112 @@ char m2c_match_lowline_ident_or_resword
  * its lexeme in lexeme.  Returns the new lookahead character.
  * ----------------------------------------------------------------------- */
 
-static char match_decimal_number_tail(infile_t infile, m2c_token_t *token);
-static char match_real_number_tail(infile_t infile, m2c_token_t *token);
-static char match_base2_digit_seq(infile_t infile, m2c_token_t *token);
-static char match_base16_digit_seq(infile_t infile, m2c_token_t *token);
-
 char m2c_match_numeric_literal
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
+  
+  return m2c_match_numeric_literal_with_value(infile, token, lexeme, NULL);
+} /* end m2c_match_numeric_literal */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_match_numeric_literal_with_value(infile, token, lexeme, value)
+ * --------------------------------------------------------------------------
+ * Matches  the  input  at  the  current  reading position  of  infile  to  a
+ * numeric literal and consumes it.  Passes the associated token in token,
+ * its lexeme in lexeme and,  unless value is NULL,  its converted value in
+ * value.  The value is accumulated while the digits are consumed.  Returns
+ * the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+static char match_decimal_number_tail
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc);
+
+static char match_real_number_tail
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc);
+
+static char match_digit_seq
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc, digit_role_t role);
+
+static char match_base2_digit_seq
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc);
+
+static char match_base16_digit_seq
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc);
+
+static void convert_accum
+  (const num_accum_t *acc, m2c_token_t token, intstr_t lexeme,
+   m2c_numeric_value_t *value);
+
+char m2c_match_numeric_literal_with_value
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   m2c_numeric_value_t *value) {
+  
   char next_char;
+  num_accum_t acc = NUM_ACCUM_INITIAL;
   
   infile_mark_lexeme(infile);
   
   next_char = infile_lookahead_char(infile);
-
+  
   if (next_char == '0') {
     next_char = infile_consume_char(infile);
+    *token = TOKEN_WHOLE_NUMBER;
     
     switch (next_char) {
-      /* real number */
+      /* real number, unless range operator */
       case '.' :
-        next_char = match_real_number_tail(infile, token);
+        if (infile_la2_char(infile) != '.') {
+          next_char = match_real_number_tail(infile, token, &acc);
+        } /* end if */
         break;
-
+      
       /* base-2 integer */
       case 'b' :
-        next_char = match_base2_digit_seq(infile, token);
+        next_char = match_base2_digit_seq(infile, token, &acc);
         break;
-
+      
       /* character code */
       case 'u' :
-        next_char = match_base16_digit_seq(infile, token);
+        *token = TOKEN_CHAR_CODE;
+        next_char = match_base16_digit_seq(infile, token, &acc);
         break;
-        
+      
       /* base-16 integer */
       case 'x' :
-        next_char = match_base16_digit_seq(infile, token);
+        next_char = match_base16_digit_seq(infile, token, &acc);
         break;
-
+      
       default :
-        /* single zero */
-        if (IS_NOT_DIGIT(next_char)
-          && IS_NOT_UPPER_LETTER(next_char)
-          && IS_NOT_LOWER_LETTER(next_char)) {
-            *token = TOKEN_WHOLE_NUMBER;
-        }
         /* malformed literal */
-        else {
+        if (IS_LETTER_OR_DIGIT(next_char)) {
           /* emit error - illegal char in number literal */
           m2c_emit_lex_error_in_token
-            (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, infile, TOKEN_WHOLE_NUMBER,
+            (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, TOKEN_WHOLE_NUMBER,
              next_char, infile_line(infile), infile_column(infile));
           
           /* collect all illegal chars */
-          while (IS_LOWER_LETTER(next_char)
-            || IS_UPPER_LETTER(next_char)
-            || IS_DIGIT(next_char)) {
+          while (IS_LETTER_OR_DIGIT(next_char)) {
             next_char = infile_consume_char(infile);
-            *token = TOKEN_MALFORMED_INTEGER;
           } /* end while */
+          
+          *token = TOKEN_MALFORMED_INTEGER;
         } /* end if */
     } /* end switch */
   }
-  else if ((next_char >= '1') && (next_char <= '9')) {
-
+  else if (IS_DECIMAL_DIGIT(next_char)) {
+    
     /* decimal integer or real number */
-    next_char = match_decimal_number_tail(infile, token);
+    next_char = match_decimal_number_tail(infile, token, &acc);
   } /* end if */
   
   *lexeme = infile_lexeme(infile);
-
+  
+  if (value != NULL) {
+    convert_accum(&acc, *token, *lexeme, value);
+  } /* end if */
+  
   return next_char;
-} /* end m2c_match_numeric_literal */
+} /* end m2c_match_numeric_literal_with_value */
 
 
 /* --------------------------------------------------------------------------
@@ -297,54 +402,75 @@ char m2c_match_numeric_literal
 
 char m2c_match_quoted_literal
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
+  
+  return m2c_match_quoted_literal_with_slice(infile, token, lexeme, NULL);
+} /* end m2c_match_quoted_literal */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_match_quoted_literal_with_slice(infile, token, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Matches  the  input  at  the  current  reading position  of  infile  to  a
+ * quoted literal  and consumes it.  Passes the associated token in token.
+ * If slice is not NULL  and the literal can be referenced in the buffer of
+ * infile,  passes a slice for it in slice and NULL in lexeme,  otherwise
+ * passes its lexeme in lexeme.  Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+static void get_lexeme_or_slice
+  (infile_t infile, intstr_t *lexeme, infile_slice_t *slice);
+
+char m2c_match_quoted_literal_with_slice
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   infile_slice_t *slice) {
+  
   char next_char, delimiter;
   bool malformed = false;
   
   infile_mark_lexeme(infile);
-
+  
   /* consume opening string delimiter */
   delimiter = infile_lookahead_char(infile);
   next_char = infile_consume_char(infile);
-
+  
   while (next_char != delimiter) {
     /* EOF */
     if (infile_eof(infile)) {
       /* emit error -- unexpected EOF in string literal */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_EOF_IN_TOKEN, infile, TOKEN_QUOTED_STRING,
+        (M2C_ERROR_EOF_IN_TOKEN, TOKEN_QUOTED_STRING,
          next_char, infile_line(infile), infile_column(infile));
-        *token = TOKEN_MALFORMED_STRING;
-        *lexeme = infile_lexeme(infile);
-        return next_char;
-      } /* end if */
-
+      *token = TOKEN_MALFORMED_STRING;
+      get_lexeme_or_slice(infile, lexeme, slice);
+      return next_char;
+    } /* end if */
+    
     /* check for control characters */
     if (IS_CTRL_CHAR(next_char)) {
       malformed = true;
       
       /* emit error -- control character in string literal */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, infile, TOKEN_QUOTED_STRING,
+        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, TOKEN_QUOTED_STRING,
          next_char, infile_line(infile), infile_column(infile));
-       } /* end if */
     } /* end if */
     
     if (next_char == '\\') {
-      next_char - infile_consume_char(infile);
-
-      if ((next_char != 'n') && (next_char != 't') && (next_char != '//')) {
+      next_char = infile_consume_char(infile);
+      
+      if ((next_char != 'n') && (next_char != 't') && (next_char != '\\')) {
         malformed = true;
         /* emit error -- invalid escape sequence */
         m2c_emit_lex_error_in_token
-          (M2C_ERROR_INVALID_ESCAPE_SEQUENCE, infile, TOKEN_QUOTED_STRING,
+          (M2C_ERROR_ILLEGAL_ESCAPE_SEQUENCE, TOKEN_QUOTED_STRING,
            next_char, infile_line(infile), infile_column(infile));
-       } /* end if */
+      } /* end if */
     } /* end if */
     next_char = infile_consume_char(infile);
   } /* end while */
   
   /* consume closing string delimiter */
-  if (next_char = delimiter) {
+  if (next_char == delimiter) {
     next_char = infile_consume_char(infile);
   } /* end if */
   
@@ -355,11 +481,11 @@ char m2c_match_quoted_literal
   else {
     *token = TOKEN_QUOTED_STRING;
   } /* end if */
-
-  *lexeme = infile_lexeme(infile);
-
+  
+  get_lexeme_or_slice(infile, lexeme, slice);
+  
   return next_char;
-} /* end m2c_match_quoted_literal */
+} /* end m2c_match_quoted_literal_with_slice */
 
 
 /* Non-Semantic Symbols */
@@ -375,35 +501,58 @@ char m2c_match_quoted_literal
 
 char m2c_match_line_comment
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
+  
+  return m2c_match_line_comment_with_slice(infile, token, lexeme, NULL);
+} /* end m2c_match_line_comment */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_match_line_comment_with_slice(infile, token, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Matches the input  at the  current reading position  of  infile  to a line
+ * comment and consumes it.  Passes the associated token in token.  If option
+ * preserve-comments is enabled,  passes the comment like function
+ * m2c_match_quoted_literal_with_slice,  otherwise passes NULL in lexeme.
+ * Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+char m2c_match_line_comment_with_slice
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   infile_slice_t *slice) {
+  
   char next_char;
   
   if (m2c_compiler_option_preserve_comments()) {
     infile_mark_lexeme(infile);
   } /* end if */
-
+  
   next_char = infile_skip_char(infile);
-
+  
   while (infile_eof(infile) == false) {
-
+    
     /* end of line terminates line comment */
     if (next_char == ASCII_LF) {
       next_char = infile_skip_char(infile);
-      exit;
+      break;
     }
     /* illegal control char */
     else if (IS_CTRL_CHAR(next_char) && (next_char != ASCII_TAB)) {
       /* emit error - illegal control char in comment */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, infile, TOKEN_LINE_COMMENT,
+        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, TOKEN_LINE_COMMENT,
          next_char, infile_line(infile), infile_column(infile));
-     } /* end if */
-    
-    next_char = infile_skip_char(infile);
+      next_char = infile_skip_char(infile);
+    }
+    /* legal char, skip ahead to end of line or next illegal char */
+    else {
+      next_char = infile_skip_char(infile);
+      next_char = infile_skip_to_delimiter(infile, ASCII_LF, ASCII_LF);
+    } /* end if */
   } /* end while */
   
   if (m2c_compiler_option_preserve_comments()) {
     *token = TOKEN_LINE_COMMENT;
-    *lexeme = infile_lexeme(infile);
+    get_lexeme_or_slice(infile, lexeme, slice);
   }
   else /* don't preserve */ {
     *token = TOKEN_UNKNOWN;
@@ -411,7 +560,7 @@ char m2c_match_line_comment
   } /* end if */
   
   return next_char;
-} /* end m2c_match_line_comment */
+} /* end m2c_match_line_comment_with_slice */
 
 
 /* --------------------------------------------------------------------------
@@ -423,10 +572,29 @@ char m2c_match_line_comment
  * otherwise NULL.  Returns the new lookahead character.
  * ----------------------------------------------------------------------- */
 
-#define COMMENT_NESTING_LIMIT 10
-
 char m2c_match_block_comment
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
+  
+  return m2c_match_block_comment_with_slice(infile, token, lexeme, NULL);
+} /* end m2c_match_block_comment */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_match_block_comment_with_slice(infile, token, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Matches the input  at the  current reading position  of infile  to a block
+ * comment and consumes it.  Passes the associated token in token.  If option
+ * preserve-comments is enabled,  passes the comment like function
+ * m2c_match_quoted_literal_with_slice,  otherwise passes NULL in lexeme.
+ * Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+#define COMMENT_NESTING_LIMIT 10
+
+char m2c_match_block_comment_with_slice
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   infile_slice_t *slice) {
+  
   char next_char;
   uint_t nest_level;
   
@@ -456,30 +624,31 @@ char m2c_match_block_comment
     else if (infile_eof(infile)) {
       /* emit error - premature EOF in comment */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_EOF_IN_TOKEN, infile, TOKEN_BLOCK_COMMENT,
+        (M2C_ERROR_EOF_IN_TOKEN, TOKEN_BLOCK_COMMENT,
          next_char, infile_line(infile), infile_column(infile));
       *token = TOKEN_MALFORMED_COMMENT;
-      *lexeme = infile_lexeme(infile);
+      get_lexeme_or_slice(infile, lexeme, slice);
       return next_char;
     }
-    /* legal char */
+    /* legal char, skip ahead to next candidate delimiter */
     else if (IS_PRINTABLE_CHAR(next_char)
       || IS_LEGAL_CTRL_CHAR(next_char)) {
       next_char = infile_skip_char(infile);
+      next_char = infile_skip_to_delimiter(infile, '*', '(');
     }
     /* illegal control char */
     else {
       next_char = infile_skip_char(infile);
       /* emit error - illegal control char in comment */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, infile, TOKEN_BLOCK_COMMENT,
+        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, TOKEN_BLOCK_COMMENT,
          next_char, infile_line(infile), infile_column(infile));
     } /* end if */
   } /* end while */
   
   if (m2c_compiler_option_preserve_comments()) {
     *token = TOKEN_BLOCK_COMMENT;
-    *lexeme = infile_lexeme(infile);
+    get_lexeme_or_slice(infile, lexeme, slice);
   }
   else /* don't preserve */ {
     *token = TOKEN_UNKNOWN;
@@ -487,7 +656,7 @@ char m2c_match_block_comment
   } /* end if */
 
   return next_char;
-} /* end m2c_match_block_comment */
+} /* end m2c_match_block_comment_with_slice */
 
 
 /* --------------------------------------------------------------------------
@@ -501,6 +670,10 @@ char m2c_match_block_comment
 char m2c_match_pragma
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme) {
   char next_char;
+  bool clean;
+  
+  /* validated input holds no illegal control chars */
+  clean = infile_is_clean(infile);
   
   infile_mark_lexeme(infile);
 
@@ -508,23 +681,23 @@ char m2c_match_pragma
   next_char = infile_consume_char(infile);
   next_char = infile_consume_char(infile);
   
-  while ((next_char != '*') && (infile_la2_char(infile) != '>')) {
+  while (NOT((next_char == '*') && (infile_la2_char(infile) == '>'))) {
     next_char = infile_consume_char(infile);
 
     if (infile_eof(infile)) {
       /* emit error : unexpected EOF in pragma */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_EOF_IN_TOKEN, infile, TOKEN_PRAGMA,
+        (M2C_ERROR_EOF_IN_TOKEN, TOKEN_PRAGMA,
          next_char, infile_line(infile), infile_column(infile));
-      *token TOKEN_MALFORMED_PRAGMA;
+      *token = TOKEN_MALFORMED_PRAGMA;
       *lexeme = infile_lexeme(infile);
       return next_char;
-
+    }
     /* illegal control char */
-    else if (IS_ILLEGAL_CTRL_CHAR(next_char)) {
+    else if (NOT(clean) && IS_ILLEGAL_CTRL_CHAR(next_char)) {
       /* emit error - illegal control char in pragma */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, infile, TOKEN_PRAGMA,
+        (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, TOKEN_PRAGMA,
          next_char, infile_line(infile), infile_column(infile));
     } /* end if */
   } /* end while */
@@ -566,7 +739,9 @@ char m2c_match_disabled_code_block (infile_t infile) {
       return next_char;
     } /* end if */
 
+    /* skip ahead to next '>', line feeds are counted in bulk */
     next_char = infile_skip_char(infile);
+    next_char = infile_skip_to_delimiter(infile, '>', '>');
   } /* end while */
   
   /* consume '>' and '?' */
@@ -583,6 +758,8 @@ char m2c_match_disabled_code_block (infile_t infile) {
  * private function match_lowline_ident_tail(infile)
  * --------------------------------------------------------------------------
  * Matches input in infile to a lowline identifier tail, returns lookahead.
+ * There is no malformed identifier token,  a malformed tail is reported and
+ * passed as an identifier.
  *
  * EBNF
  *
@@ -606,39 +783,26 @@ char m2c_match_disabled_code_block (infile_t infile) {
  *       TO DO
  * ----------------------------------------------------------------------- */
 
-static char match_lowline_letter_ident_seq
-  (infile_t infile, m2c_token_t *token);
+static char match_lowline_letter_digit_seq (infile_t infile);
 
 static char match_lowline_ident_tail (infile_t infile, m2c_token_t *token) {
   char next_char;
-  bool malformed;
-  m2c_token_t result;
   
-  malformed = false;
   next_char = infile_lookahead_char(infile);
   
   /* ( Lowline (Letter | Digit)+ )+ */
-  while (next_char == '_') {
-    next_char = match_lowline_letter_digit_seq(infile, &result);
-
-    if (result == TOKEN_MALFORMED_IDENT) {
-      malformed = true;
-    } /* end if */
+  while ((next_char == '_') && (NOT(infile_eof(infile)))) {
+    next_char = match_lowline_letter_digit_seq(infile);
   } /* end while */
   
-  if (malformed) {
-    *token = TOKEN_MALFORMED_IDENT;
-  }
-  else {
-    *token = TOKEN_IDENT;
-  } /* end if */
-
+  *token = TOKEN_IDENT;
+  
   return next_char;
 } /* end match_lowline_ident_tail */
 
 
 /* --------------------------------------------------------------------------
- * private function match_lowline_letter_digit_seq(infile, token)
+ * private function match_lowline_letter_digit_seq(infile)
  * --------------------------------------------------------------------------
  * Matches the input  in infile to a  lowline preceded letter-digit sequence,
  * returns lookahead.
@@ -663,8 +827,7 @@ static char match_lowline_ident_tail (infile_t infile, m2c_token_t *token) {
  *       TO DO
  * ----------------------------------------------------------------------- */
 
-static char match_lowline_letter_ident_seq
-  (infile_t infile, m2c_token_t *token) {
+static char match_lowline_letter_digit_seq (infile_t infile) {
   char next_char;
   
   /* '_' */
@@ -674,35 +837,33 @@ static char match_lowline_letter_ident_seq
   if (infile_eof(infile)) {
     /* emit error -- unexpected EOF in identifier */
     m2c_emit_lex_error_in_token
-      (M2C_ERROR_EOF_IN_TOKEN, infile, TOKEN_IDENT,
+      (M2C_ERROR_EOF_IN_TOKEN, TOKEN_IDENT,
        next_char, infile_line(infile), infile_column(infile));
-    *token = TOKEN_MALFORMED_IDENT;
     return next_char;
   } /* end if */
     
   /* (Letter | Digit)+ */
-  if (IS_LETTER_OR_DIGIT(next_char) {
+  if (IS_LETTER_OR_DIGIT(next_char)) {
     while (IS_LETTER_OR_DIGIT(next_char)) {
       next_char = infile_consume_char(infile);
-    } /* end if */
-    *token = TOKEN_IDENT;
+    } /* end while */
   }
   else /* illegal char */ {
     /* emit error - illegal char in identifier */
     m2c_emit_lex_error_in_token
-      (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, infile, TOKEN_IDENT,
+      (M2C_ERROR_ILLEGAL_CHAR_IN_TOKEN, TOKEN_IDENT,
        next_char, infile_line(infile), infile_column(infile));
-    *token = TOKEN_MALFORMED_IDENT;
   } /* end if */
   
   return next_char;
-} /* end match_lowline_letter_ident_seq */
+} /* end match_lowline_letter_digit_seq */
 
 
 /* --------------------------------------------------------------------------
- * private function match_decimal_number_tail(infile)
+ * private function match_decimal_number_tail(infile, token, acc)
  * --------------------------------------------------------------------------
  * Matches the input in infile to a decimal number tail, returns lookahead.
+ * The value of the literal is accumulated in acc.
  *
  * EBNF
  *
@@ -714,7 +875,7 @@ static char match_lowline_letter_ident_seq
  *
  * pre-conditions:
  *  (1) infile is the current input file and it must not be NIL.
- *  (2) lookahead of infile is a digit between 1 and 9 or a decimal point.
+ *  (2) lookahead of infile is a digit between 1 and 9.
  *
  * post-conditions:
  *  (1) lookahead of infile is the character immediately following the last
@@ -722,36 +883,25 @@ static char match_lowline_letter_ident_seq
  *      upon entry into the procedure.
  *
  * error-conditions:
- *  (1) illegal character encountered
- *       TO DO
+ *  (1) missing digit after digit separator
+ *       error is reported, lookahead is the offending character.
  * ----------------------------------------------------------------------- */
 
 #define DIGIT_SEPARATOR '\''
 
-char match_decimal_number_tail (infile_t infile, m2c_token_t *token) {
-  char next_char;
+static char match_decimal_number_tail
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc) {
   
-  next_char = infile_consume_char(infile);
+  char next_char;
   
-  /* DigitSep? */
-  if (next == DIGIT_SEPARATOR) {
-    next_char = infile_consume_char(infile);
-  } /* end if */
+  *token = TOKEN_WHOLE_NUMBER;
   
-  /* DigitSeq */
-  if (IS_DIGIT(next_char)) {
-    next_char := match_digit_seq(infile, token);
-  }
-  else /* lookahead is not a decimal digit */ {
-    /* emit error -- missing digit after digit separator in number */
-    m2c_emit_lex_error_in_token
-      (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, infile, TOKEN_WHOLE_NUMBER,
-       next_char, infile_line(infile), infile_column(infile));
-  } /* end if */
+  /* leading digit and any further digits */
+  next_char = match_digit_seq(infile, token, acc, DIGITS_INTEGRAL);
   
-  /* RealNumberTail? */
-  if (next_char == '.') {
-    next_char = match_real_number_tail(infile, token);
+  /* RealNumberTail?, unless range operator */
+  if ((next_char == '.') && (infile_la2_char(infile) != '.')) {
+    next_char = match_real_number_tail(infile, token, acc);
   } /* end if */
   
   return next_char;
@@ -759,9 +909,10 @@ char match_decimal_number_tail (infile_t infile, m2c_token_t *token) {
 
 
 /* --------------------------------------------------------------------------
- * private function match_real_number_tail(infile, token)
+ * private function match_real_number_tail(infile, token, acc)
  * --------------------------------------------------------------------------
  * Matches the input in infile to a real number tail, returns lookahead.
+ * The value of the literal is accumulated in acc.
  *
  * EBNF
  *
@@ -779,25 +930,27 @@ char match_decimal_number_tail (infile_t infile, m2c_token_t *token) {
  *      upon entry into the procedure.
  *
  * error-conditions:
- *  (1) illegal character encountered
- *       TO DO
+ *  (1) missing digit after decimal point or missing exponent
+ *       error is reported, lookahead is the offending character.
  * ----------------------------------------------------------------------- */
 
-static char match_real_Number_tail (infile_t infile, m2c_token_t *token) {
+static char match_real_number_tail
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc) {
+  
   char next_char;
-    
+  
   /* '.' */
-  next_char := infile_consume_char(infile);
+  next_char = infile_consume_char(infile);
   *token = TOKEN_REAL_NUMBER;
   
   /* DigitSeq */
-  if (IS_DIGIT(next_char)) {
-    next_char = match_digit_seq(infile, token);
+  if (IS_DECIMAL_DIGIT(next_char)) {
+    next_char = match_digit_seq(infile, token, acc, DIGITS_FRACTIONAL);
   }
   else /* lookahead is not a decimal digit */ {
     /* emit error - missing digit after decimal point in real number */
     m2c_emit_lex_error_in_token
-      (M2C_ERROR_MISSING_DIGIT_AFTER_DP, infile, TOKEN_REAL_NUMBER,
+      (M2C_ERROR_MISSING_DIGIT_AFTER_DP, TOKEN_REAL_NUMBER,
        next_char, infile_line(infile), infile_column(infile));
   } /* end if */
   
@@ -808,34 +961,96 @@ static char match_real_Number_tail (infile_t infile, m2c_token_t *token) {
     
     /* ( '+' | '-' )?  */
     if ((next_char == '+') || (next_char == '-')) {
+      acc->exp_negative = (next_char == '-');
+      
       /* consume sign */
       next_char = infile_consume_char(infile);
     } /* end if */
     
     /* DigitSeq */
-    if (IS_DIGIT(next_char)) {
-      next_char = match_digit_seq(infile, token);
+    if (IS_DECIMAL_DIGIT(next_char)) {
+      next_char = match_digit_seq(infile, token, acc, DIGITS_EXPONENT);
     }
     else /* lookahead is not a decimal digit */ {
       /* emit error - missing exponent in real number */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_MISSING_EXPONENT_AFTER_E, infile, TOKEN_REAL_NUMBER,
+        (M2C_ERROR_MISSING_EXPONENT_AFTER_E, TOKEN_REAL_NUMBER,
          next_char, infile_line(infile), infile_column(infile));
     } /* end if */
   } /* end if */
   
   return next_char;
-} /* end match_real_Number_tail */
+} /* end match_real_number_tail */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_decimal_digit(acc, digit, role)
+ * --------------------------------------------------------------------------
+ * Adds decimal digit to the value accumulated in acc according to role.
+ * ----------------------------------------------------------------------- */
+
+#define MAX_EXPONENT_DIGITS 99999
+
+static void add_decimal_digit (num_accum_t *acc, uint_t digit, digit_role_t role) {
+  
+  switch (role) {
+    case DIGITS_INTEGRAL :
+      if (acc->mantissa <= (UINT64_MAX - digit) / 10) {
+        acc->mantissa = acc->mantissa * 10 + digit;
+      }
+      else /* digit dropped */ {
+        acc->overflow = true;
+        acc->truncated = true;
+        acc->exponent++;
+      } /* end if */
+      break;
+    
+    case DIGITS_FRACTIONAL :
+      if (acc->mantissa <= (UINT64_MAX - digit) / 10) {
+        acc->mantissa = acc->mantissa * 10 + digit;
+        acc->exponent--;
+      }
+      else /* digit dropped */ {
+        acc->truncated = true;
+      } /* end if */
+      break;
+    
+    case DIGITS_EXPONENT :
+      if (acc->exp_digits <= MAX_EXPONENT_DIGITS) {
+        acc->exp_digits = acc->exp_digits * 10 + digit;
+      } /* end if */
+      break;
+  } /* end switch */
+} /* end add_decimal_digit */
 
 
 /* --------------------------------------------------------------------------
- * private function match_digit_seq(infile, token)
+ * private procedure add_based_digit(acc, base_bits, digit)
+ * --------------------------------------------------------------------------
+ * Adds a base-2 or base-16 digit  to the value accumulated in acc,  where
+ * base_bits is the number of bits per digit.  Sets the overflow flag if
+ * the value exceeds 64 bits.
+ * ----------------------------------------------------------------------- */
+
+static void add_based_digit (num_accum_t *acc, uint_t base_bits, uint_t digit) {
+  
+  if ((acc->mantissa >> (64 - base_bits)) != 0) {
+    acc->overflow = true;
+  } /* end if */
+  
+  acc->mantissa = (acc->mantissa << base_bits) | digit;
+} /* end add_based_digit */
+
+
+/* --------------------------------------------------------------------------
+ * private function match_digit_seq(infile, token, acc, role)
  * --------------------------------------------------------------------------
  * Matches input in infile to a decimal digit sequence, returns lookahead.
+ * The digits are added to acc according to role.
  *
  * EBNF
  *
- * matchDigitSeq :=
+ * DigitSeq :=
  *   Digit+ ( DigitSep Digit+ )*
  *   ;
  *
@@ -849,50 +1064,47 @@ static char match_real_Number_tail (infile_t infile, m2c_token_t *token) {
  *      upon entry into the procedure.
  *
  * error-conditions:
- *  (1) illegal character encountered
- *       TO DO
+ *  (1) missing digit after digit separator
+ *       error is reported, lookahead is the offending character.
  * ----------------------------------------------------------------------- */
 
-static char match_digit_seq (infile_t infile, m2c_token_t *token) {
+static char match_digit_seq
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc, digit_role_t role) {
+  
   char next_char;
-    
-  /* Digit */
-  next_char = infile_consume_char(infile);
   
-  /* Digit* */
-  while (IS_DIGIT(next_char)) {
-    next_char = infile_consume_char(infile);
-  } /* end while */
+  next_char = infile_lookahead_char(infile);
   
-  /* ( DigitSep Digit+ )? */
-  if (next_char = DIGIT_SEPARATOR) {
+  while (true) {
+    /* Digit+ */
+    while (IS_DECIMAL_DIGIT(next_char)) {
+      add_decimal_digit(acc, DIGIT_VALUE(next_char), role);
+      next_char = infile_consume_char(infile);
+    } /* end while */
+    
+    /* ( DigitSep Digit+ )* */
+    if (next_char != DIGIT_SEPARATOR) {
+      return next_char;
+    } /* end if */
+    
     next_char = infile_consume_char(infile);
     
-    /* Digit */
-    if (IS_DIGIT(next_char)) {
-      next_char = infile_consume_char(infile);
-      
-      /* Digit* */
-      while (IS_DIGIT(next_char)) {
-        next_char = infile_consume_char(infile);
-      } /* end while */
-
-    else /* lookahead not a decimal digit */ {
+    if (NOT(IS_DECIMAL_DIGIT(next_char))) {
       /* emit error - missing digit after digit separator in number */
       m2c_emit_lex_error_in_token
-        (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, infile, *token,
+        (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, *token,
          next_char, infile_line(infile), infile_column(infile));
+      return next_char;
     } /* end if */
-  } /* end if */
-  
-  return next_char;
+  } /* end while */
 } /* end match_digit_seq */
 
 
 /* --------------------------------------------------------------------------
- * private function match_base2_digit_seq(infile, token)
+ * private function match_base2_digit_seq(infile, token, acc)
  * --------------------------------------------------------------------------
  * Matches the input in infile to a base-2 digit sequence, returns lookahead.
+ * The value of the digits is accumulated in acc.
  *
  * EBNF
  *
@@ -902,58 +1114,56 @@ static char match_digit_seq (infile_t infile, m2c_token_t *token) {
  *
  * pre-conditions:
  *  (1) infile is the current input file and it must not be NIL.
- *  (2) lookahead of infile is a base-2 digit.
+ *  (2) lookahead of infile is the base-2 prefix 'b'.
  *
  * post-conditions:
  *  (1) lookahead of infile is the character immediately following the last
- *      digit of the literal whose first digit was the lookahead of infile
- *      upon entry into the procedure.
+ *      digit of the literal.
  *
  * error-conditions:
- *  (1) illegal character encountered
- *       TO DO
+ *  (1) missing digit after prefix or digit separator
+ *       error is reported, lookahead is the offending character.
  * ----------------------------------------------------------------------- */
 
-static char match_base2_digit_seq (infile_t infile, m2c_token_t *token) {
+#define IS_BASE2_DIGIT(_ch) (((_ch) == '0') || ((_ch) == '1'))
+
+static char match_base2_digit_seq
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc) {
+  
   char next_char;
   
-  /* Base2Digit */
+  /* consume prefix */
   next_char = infile_consume_char(infile);
   
-  /* Base2Digit* */
-  while ((next_char == '0') || (next_char == '1')) {
+  while (IS_BASE2_DIGIT(next_char)) {
+    /* Base2Digit+ */
+    while (IS_BASE2_DIGIT(next_char)) {
+      add_based_digit(acc, 1, DIGIT_VALUE(next_char));
+      next_char = infile_consume_char(infile);
+    } /* end while */
+    
+    /* ( DigitSep Base2Digit+ )* */
+    if (next_char != DIGIT_SEPARATOR) {
+      return next_char;
+    } /* end if */
+    
     next_char = infile_consume_char(infile);
   } /* end while */
   
-  /* ( DigitSep Base2Digit+ )? */
-  if (next_char == DIGIT_SEPARATOR) {
-    next_char = infile_consume_char(infile);
-    
-    /* Base2Digit */
-    if ((next_char == '0') || (next_char == '1')) {
-      next_char = infile_consume_char(infile);
-      
-      /* Base2Digit* */
-      while ((next_char == '0') || (next_char == '1')) {
-        next_char = infile_consume_char(infile);
-      } /* end while */
-
-    else /* lookahead not a base-2 digit */ {
-      /* emit error - missing digit after digit separator in number */
-      m2c_emit_lex_error_in_token
-        (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, infile, TOKEN_WHOLE_NUMBER,
-         next_char, infile_line(infile), infile_column(infile));
-    } /* end if */
-  } /* end if */
+  /* emit error - missing digit after prefix or digit separator */
+  m2c_emit_lex_error_in_token
+    (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, *token,
+     next_char, infile_line(infile), infile_column(infile));
   
   return next_char;
 } /* end match_base2_digit_seq */
 
 
 /* --------------------------------------------------------------------------
- * private function match_base16_digit_seq(infile, token)
+ * private function match_base16_digit_seq(infile, token, acc)
  * --------------------------------------------------------------------------
  * Matches input in infile to a base-16 digit sequence, returns lookahead.
+ * The value of the digits is accumulated in acc.
  *
  * EBNF
  *
@@ -963,52 +1173,160 @@ static char match_base2_digit_seq (infile_t infile, m2c_token_t *token) {
  *
  * pre-conditions:
  *  (1) infile is the current input file and it must not be NIL.
- *  (2) lookahead of infile is a base-16 digit.
+ *  (2) lookahead of infile is the base-16 prefix 'x' or 'u'.
  *
  * post-conditions:
  *  (1) lookahead of infile is the character immediately following the last
- *      digit of the literal whose first digit was the lookahead of infile
- *      upon entry into the procedure.
+ *      digit of the literal.
  *
  * error-conditions:
- *  (1) illegal character encountered
- *       TO DO
+ *  (1) missing digit after prefix or digit separator
+ *       error is reported, lookahead is the offending character.
  * ----------------------------------------------------------------------- */
 
-static char match_base16_digit_seq (infile_t infile, m2c_token_t *token) {
+static char match_base16_digit_seq
+  (infile_t infile, m2c_token_t *token, num_accum_t *acc) {
+  
   char next_char;
-    
-  /* Base16Digit */
+  
+  /* consume prefix */
   next_char = infile_consume_char(infile);
   
-  /* Base16Digit* */
-  while (IS_DIGIT(next_char) || IS_A_TO_F(next_char)) {
+  while (IS_BASE16_DIGIT(next_char)) {
+    /* Base16Digit+ */
+    while (IS_BASE16_DIGIT(next_char)) {
+      add_based_digit(acc, 4, DIGIT_VALUE(next_char));
+      next_char = infile_consume_char(infile);
+    } /* end while */
+    
+    /* ( DigitSep Base16Digit+ )* */
+    if (next_char != DIGIT_SEPARATOR) {
+      return next_char;
+    } /* end if */
+    
     next_char = infile_consume_char(infile);
   } /* end while */
   
-  /* ( DigitSep Base16Digit+ )? */
-  if (next_char == DIGIT_SEPARATOR) {
-    next_char = infile_consume_char(infile);
+  /* emit error - missing digit after prefix or digit separator */
+  m2c_emit_lex_error_in_token
+    (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, *token,
+     next_char, infile_line(infile), infile_column(infile));
+  
+  return next_char;
+} /* end match_base16_digit_seq */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure convert_accum(acc, token, lexeme, value)
+ * --------------------------------------------------------------------------
+ * Converts the value accumulated in acc for a literal with token and lexeme
+ * and passes the result in value.
+ *
+ * Whole numbers and character codes are taken from the mantissa.  A real
+ * number whose mantissa does not exceed 2^53 and whose decimal exponent
+ * lies within -22 and 22 is converted exactly  by a single multiplication
+ * or division.  Any other real number is converted from its lexeme.
+ * ----------------------------------------------------------------------- */
+
+#define MAX_EXACT_MANTISSA (((uint64_t) 1) << 53)
+
+#define MAX_EXACT_EXPONENT 22
+
+#define MAX_UNICODE_CODE_POINT 0x10FFFF
+
+static const double power_of_ten[MAX_EXACT_EXPONENT + 1] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+}; /* power_of_ten */
+
+static void convert_accum
+  (const num_accum_t *acc, m2c_token_t token, intstr_t lexeme,
+   m2c_numeric_value_t *value) {
+  
+  int exponent;
+  uint_t index, length;
+  const char *lexstr;
+  char digits[M2C_MAX_NUMBER_LENGTH + 1];
+  
+  value->whole = 0;
+  value->real = 0.0;
+  value->is_real = false;
+  value->overflow = false;
+  
+  /* whole number or character code */
+  if (token != TOKEN_REAL_NUMBER) {
+    value->whole = acc->mantissa;
+    value->overflow = acc->overflow ||
+      ((token == TOKEN_CHAR_CODE) && (acc->mantissa > MAX_UNICODE_CODE_POINT));
+    return;
+  } /* end if */
+  
+  value->is_real = true;
+  
+  if (acc->exp_negative) {
+    exponent = acc->exponent - (int) acc->exp_digits;
+  }
+  else {
+    exponent = acc->exponent + (int) acc->exp_digits;
+  } /* end if */
+  
+  /* fast path */
+  if ((NOT(acc->truncated)) && (acc->mantissa <= MAX_EXACT_MANTISSA) &&
+      (exponent >= -MAX_EXACT_EXPONENT) && (exponent <= MAX_EXACT_EXPONENT)) {
     
-    /* Base16Digit */
-    if (IS_DIGIT(next_char) || IS_A_TO_F(next_char)) {
-      next_char = infile_consume_char(infile);
+    if (exponent >= 0) {
+      value->real = (double) acc->mantissa * power_of_ten[exponent];
+    }
+    else {
+      value->real = (double) acc->mantissa / power_of_ten[-exponent];
+    } /* end if */
+    
+    return;
+  } /* end if */
+  
+  /* slow path, convert from lexeme without digit separators */
+  lexstr = intstr_char_ptr(lexeme);
+  length = 0;
+  
+  for (index = 0; (lexstr != NULL) && (lexstr[index] != ASCII_NUL); index++) {
+    if (lexstr[index] != DIGIT_SEPARATOR) {
+      if (length == M2C_MAX_NUMBER_LENGTH) {
+        value->overflow = true;
+        return;
+      } /* end if */
       
-      /* Base16Digit* */
-      while (IS_DIGIT(next_char) || IS_A_TO_F(next_char)) {
-        next_char = infile_consume_char(infile);
-        } /* end while */
+      digits[length] = lexstr[index];
+      length++;
+    } /* end if */
+  } /* end for */
+  digits[length] = ASCII_NUL;
+  
+  errno = 0;
+  value->real = strtod(digits, NULL);
+  value->overflow = (errno == ERANGE) && (value->real != 0.0);
+} /* end convert_accum */
 
-    else /* lookahead not a base-16 digit */ {
-      /* emit error - missing digit after digit separator in number */
-      m2c_emit_lex_error_in_token
-        (M2C_ERROR_MISSING_DIGIT_AFTER_DSEP, infile, TOKEN_WHOLE_NUMBER,
-         next_char, infile_line(infile), infile_column(infile));
-    } /* IF */
-  } /* IF */
+
+/* --------------------------------------------------------------------------
+ * private procedure get_lexeme_or_slice(infile, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Passes a slice for the current lexeme of infile in slice and  NULL in
+ * lexeme if slice is not NULL and the lexeme can be referenced in place,
+ * otherwise passes the interned lexeme in lexeme.
+ * ----------------------------------------------------------------------- */
+
+static void get_lexeme_or_slice
+  (infile_t infile, intstr_t *lexeme, infile_slice_t *slice) {
   
-  return next_char;
-} /* end match_base16_digit_seq */
+  if ((slice != NULL) && (infile_lexeme_slice(infile, slice))) {
+    *lexeme = NULL;
+  }
+  else /* copy */ {
+    *lexeme = infile_lexeme(infile);
+  } /* end if */
+  
+  return;
+} /* end get_lexeme_or_slice */
 
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,956 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-parallel-check.c                                                      *
+ *                                                                           *
+ * Implementation of parallel semantic checking of procedure bodies.         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-parallel-check.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type entry_t
+ * --------------------------------------------------------------------------
+ * Entry of a local scope table.  Key is an identifier and defn the node
+ * that defines it.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const void *key;
+  m2c_astnode_t defn;
+} entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type table_t
+ * --------------------------------------------------------------------------
+ * Lookup table keyed by address.  Interned strings are unique,  thus
+ * identifiers are compared by address.  The table uses open addressing with
+ * linear probing,  its capacity is a power of two.
+ * ----------------------------------------------------------------------- */
+
+#define TABLE_INITIAL_CAPACITY 16
+
+typedef struct {
+  entry_t *entry;
+  uint_t count;
+  uint_t capacity;
+} table_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_local_scope_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing the local scope of procedure definition proc.
+ * If failed is set,  an identifier could not be entered for lack of memory.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_local_scope_struct_t {
+  m2c_astnode_t proc;
+  table_t ident;
+  bool failed;
+};
+
+typedef struct m2c_local_scope_struct_t m2c_local_scope_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type task_queue_t
+ * --------------------------------------------------------------------------
+ * Record type for the unchecked procedures of a worker,  which are those
+ * with an index from head to tail minus one.  The owning worker takes
+ * procedures from the head,  other workers steal them from the tail.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* head */  uint_t head;
+  /* tail */  uint_t tail;
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  /* lock */  pthread_mutex_t lock;
+#endif
+} task_queue_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type batch_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the work shared by the workers of a call to function
+ * m2c_check_procedures.  Each worker owns one task queue.  The diagnostics
+ * of the procedure with a given index are collected in the buffer with the
+ * same index,  which remains NULL if the procedure could not be checked.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* count */    uint_t count;
+  /* proc */     m2c_astnode_t *proc;
+  /* handler */  m2c_check_proc_handler_t handler;
+  /* context */  void *context;
+  /* workers */  uint_t workers;
+  /* queue */    task_queue_t *queue;
+  /* buffer */   m2c_diag_buffer_t *buffer;
+} batch_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type worker_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the arguments of a single worker.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* batch */   batch_context_t *batch;
+  /* worker */  uint_t worker;
+} worker_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+static uint_t default_thread_count (void);
+#endif
+
+static m2c_astnode_t defn_of (m2c_astnode_t node);
+
+static entry_t *table_lookup (table_t *table, const void *key);
+
+static m2c_local_scope_t new_local_scope (m2c_astnode_t proc);
+
+static void release_local_scope (m2c_local_scope_t scope);
+
+static void *check_worker (void *arg);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_local_scope_lookup(scope, ident)
+ * --------------------------------------------------------------------------
+ * Returns the node that defines ident in scope,  or NULL if none.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_local_scope_lookup
+  (m2c_local_scope_t scope, intstr_t ident) {
+  
+  entry_t *entry;
+  
+  if (scope == NULL) {
+    return NULL;
+  } /* end if */
+  
+  entry = table_lookup(&scope->ident, ident);
+  
+  if (entry == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return entry->defn;
+} /* end m2c_local_scope_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_local_scope_proc(scope)
+ * --------------------------------------------------------------------------
+ * Returns the procedure definition of scope.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_local_scope_proc (m2c_local_scope_t scope) {
+  
+  if (scope == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return scope->proc;
+} /* end m2c_local_scope_proc */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_local_scope_count(scope)
+ * --------------------------------------------------------------------------
+ * Returns the number of identifiers defined in scope.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_local_scope_count (m2c_local_scope_t scope) {
+  
+  if (scope == NULL) {
+    return 0;
+  } /* end if */
+  
+  return scope->ident.count;
+} /* end m2c_local_scope_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_check_worker_count(count, threads)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers used for count procedures and a requested
+ * number of threads.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_check_worker_count (uint_t count, uint_t threads) {
+  
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  if (threads == 0) {
+    threads = default_thread_count();
+  } /* end if */
+  
+  if (threads > count) {
+    threads = count;
+  } /* end if */
+  
+  if (threads == 0) {
+    threads = 1;
+  } /* end if */
+  
+  return threads;
+#else
+  (void) count;
+  (void) threads;
+  return 1;
+#endif
+} /* end m2c_check_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_collect_procedures(module, reach, count)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated array of the reachable module level procedure
+ * definitions of module in source order and passes their number in count.
+ *
+ * astnode: (FILE (FNAME "Foobar.mod") (KEY 0xF04FC729) moduleNode)
+ *
+ * astnode: (IMPMOD moduleIdent implist (BLOCK defnListNode stmtSeqNode))
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t *m2c_collect_procedures
+  (m2c_astnode_t module, m2c_reachability_t reach, uint_t *count) {
+  
+  m2c_astnode_t list, defn, *proc;
+  unsigned short index, list_count;
+  uint_t proc_count;
+  
+  SET_STATUS(count, 0);
+  
+  if (m2c_ast_nodetype(module) == AST_FILE) {
+    module = m2c_ast_subnode_at_index(module, 2);
+  } /* end if */
+  
+  if (m2c_ast_nodetype(module) != AST_IMPMOD) {
+    return NULL;
+  } /* end if */
+  
+  list = m2c_ast_subnode_at_index(m2c_ast_subnode_at_index(module, 2), 0);
+  
+  if (m2c_ast_nodetype(list) != AST_DEFNLIST) {
+    return NULL;
+  } /* end if */
+  
+  list_count = m2c_ast_subnode_count(list);
+  proc = malloc(list_count * sizeof(m2c_astnode_t));
+  
+  if (proc == NULL) {
+    return NULL;
+  } /* end if */
+  
+  proc_count = 0;
+  for (index = 0; index < list_count; index++) {
+    defn = defn_of(m2c_ast_subnode_at_index(list, index));
+  
+    if ((m2c_ast_nodetype(defn) == AST_PROC) &&
+        (m2c_is_reachable(reach, defn))) {
+      proc[proc_count] = defn;
+      proc_count++;
+    } /* end if */
+  } /* end for */
+  
+  if (proc_count == 0) {
+    free(proc);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(count, proc_count);
+  return proc;
+} /* end m2c_collect_procedures */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_check_procedures(count, proc, handler, ...)
+ * --------------------------------------------------------------------------
+ * Checks the bodies of the count procedure definitions in array proc on up
+ * to threads worker threads  and adds their diagnostics to diagnostics in
+ * array order.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_check_procedures
+  (uint_t count,                      /* in */
+   m2c_astnode_t proc[],              /* in */
+   m2c_check_proc_handler_t handler,  /* in */
+   void *context,                     /* in */
+   uint_t threads,                    /* in */
+   m2c_diag_buffer_t diagnostics) {   /* in */
+
+  batch_context_t batch;
+  worker_context_t *worker;
+  uint_t index, workers;
+  bool complete;
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  pthread_t *thread;
+  uint_t started;
+#endif
+
+  if ((handler == NULL) || (diagnostics == NULL) ||
+      ((proc == NULL) && (count > 0))) {
+    return false;
+  } /* end if */
+
+  if (count == 0) {
+    return true;
+  } /* end if */
+  
+  workers = m2c_check_worker_count(count, threads);
+  
+  batch.buffer = calloc(count, sizeof(m2c_diag_buffer_t));
+  batch.queue = malloc(workers * sizeof(task_queue_t));
+  worker = malloc(workers * sizeof(worker_context_t));
+  
+  if ((batch.buffer == NULL) || (batch.queue == NULL) || (worker == NULL)) {
+    free(batch.buffer);
+    free(batch.queue);
+    free(worker);
+    return false;
+  } /* end if */
+  
+  batch.count = count;
+  batch.proc = proc;
+  batch.handler = handler;
+  batch.context = context;
+  batch.workers = workers;
+  
+  /* each worker starts out with an equal share of consecutive procedures */
+  index = 0;
+  while (index < workers) {
+    batch.queue[index].head = (uint_t) (((uint64_t) count * index) / workers);
+    batch.queue[index].tail =
+      (uint_t) (((uint64_t) count * (index + 1)) / workers);
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+    pthread_mutex_init(&batch.queue[index].lock, NULL);
+#endif
+    worker[index].batch = &batch;
+    worker[index].worker = index;
+    index++;
+  } /* end while */
+  
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  thread = NULL;
+  started = 0;
+  
+  if (workers > 1) {
+    thread = malloc((workers - 1) * sizeof(pthread_t));
+  } /* end if */
+  
+  /* start helper threads, the calling thread is worker zero */
+  if (thread != NULL) {
+    while ((started < workers - 1) &&
+      (pthread_create(&thread[started], NULL,
+        check_worker, &worker[started + 1]) == 0)) {
+      started++;
+    } /* end while */
+  } /* end if */
+  
+  /* shares of workers that did not start are stolen by the others */
+  check_worker(&worker[0]);
+  
+  /* wait for helper threads to finish */
+  index = 0;
+  while (index < started) {
+    pthread_join(thread[index], NULL);
+    index++;
+  } /* end while */
+  
+  index = 0;
+  while (index < workers) {
+    pthread_mutex_destroy(&batch.queue[index].lock);
+    index++;
+  } /* end while */
+  
+  free(thread);
+#else
+  /* sequential fallback */
+  check_worker(&worker[0]);
+#endif
+  
+  /* merge diagnostics in source order */
+  complete = true;
+  index = 0;
+  while (index < count) {
+    if (batch.buffer[index] != NULL) {
+      m2c_diag_merge(diagnostics, batch.buffer[index]);
+      m2c_diag_release(batch.buffer[index]);
+    }
+    else /* not checked */ {
+      complete = false;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  free(batch.buffer);
+  free(batch.queue);
+  free(worker);
+  
+  return complete;
+} /* end m2c_check_procedures */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function default_thread_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of online processors,  or one if it is unknown.
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+static uint_t default_thread_count (void) {
+  
+#if defined(_SC_NPROCESSORS_ONLN)
+  long cpu_count;
+  
+  cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+  
+  if (cpu_count > 1) {
+    return (uint_t) cpu_count;
+  } /* end if */
+#endif
+  
+  return 1;
+} /* end default_thread_count */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private function defn_of(node)
+ * --------------------------------------------------------------------------
+ * Returns the definition node of node,  unwrapping a DECL node if present.
+ *
+ * astnode: (DECL (DECLKEY 0x3A7E01C2) declNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t defn_of (m2c_astnode_t node) {
+  
+  if (m2c_ast_nodetype(node) == AST_DECL) {
+    return m2c_ast_subnode_at_index(node, 1);
+  } /* end if */
+  
+  return node;
+} /* end defn_of */
+
+
+/* --------------------------------------------------------------------------
+ * private function KEY_HASH(key)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for address key.
+ * ----------------------------------------------------------------------- */
+
+#define KEY_HASH(_key) \
+  ((uint_t) ((((uintptr_t) (_key)) >> 3) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private function table_lookup(table, key)
+ * --------------------------------------------------------------------------
+ * Returns the entry of table for key,  or NULL if key is not in table.
+ * ----------------------------------------------------------------------- */
+
+static entry_t *table_lookup (table_t *table, const void *key) {
+  
+  uint_t mask, index;
+  
+  if (key == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  index = KEY_HASH(key) & mask;
+  
+  while (table->entry[index].key != NULL) {
+    if (table->entry[index].key == key) {
+      return &table->entry[index];
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end table_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_enter(table, key, defn)
+ * --------------------------------------------------------------------------
+ * Enters key with definition defn into table unless key is already in
+ * table,  in which case the first definition is kept.  The table is doubled
+ * when it becomes three quarters full.  Returns false if the table could
+ * not be enlarged.
+ * ----------------------------------------------------------------------- */
+
+static bool table_enter
+  (table_t *table, const void *key, m2c_astnode_t defn) {
+  
+  uint_t new_capacity, mask, index, slot;
+  entry_t *new_entry;
+  
+  if ((key == NULL) || (table_lookup(table, key) != NULL)) {
+    return true;
+  } /* end if */
+  
+  if ((4 * (table->count + 1)) > (3 * table->capacity)) {
+    new_capacity = 2 * table->capacity;
+    new_entry = calloc(new_capacity, sizeof(entry_t));
+  
+    if (new_entry == NULL) {
+      return false;
+    } /* end if */
+  
+    mask = new_capacity - 1;
+  
+    for (index = 0; index < table->capacity; index++) {
+      if (table->entry[index].key != NULL) {
+        slot = KEY_HASH(table->entry[index].key) & mask;
+  
+        while (new_entry[slot].key != NULL) {
+          slot = (slot + 1) & mask;
+        } /* end while */
+  
+        new_entry[slot] = table->entry[index];
+      } /* end if */
+    } /* end for */
+  
+    free(table->entry);
+    table->entry = new_entry;
+    table->capacity = new_capacity;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  index = KEY_HASH(key) & mask;
+  
+  while (table->entry[index].key != NULL) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  table->entry[index].key = key;
+  table->entry[index].defn = defn;
+  table->count++;
+  
+  return true;
+} /* end table_enter */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure enter_idents(scope, node, defn)
+ * --------------------------------------------------------------------------
+ * Enters the identifier of IDENT node node  or each of the identifiers of
+ * IDENTLIST node node into scope with definition defn.
+ *
+ * astnode: (IDENT ident) | (IDENTLIST ident0 ident1 ident2 ... identN)
+ * ----------------------------------------------------------------------- */
+
+static void enter_idents
+  (m2c_local_scope_t scope, m2c_astnode_t node, m2c_astnode_t defn) {
+  
+  unsigned short index, count;
+  
+  if (m2c_ast_nodetype(node) == AST_IDENT) {
+    if (NOT(table_enter(&scope->ident, m2c_ast_value(node), defn))) {
+      scope->failed = true;
+    } /* end if */
+  }
+  else if (m2c_ast_nodetype(node) == AST_IDENTLIST) {
+    count = m2c_ast_subnode_count(node);
+  
+    for (index = 0; index < count; index++) {
+      if (NOT(table_enter(&scope->ident,
+          m2c_ast_value_at_index(node, index), defn))) {
+        scope->failed = true;
+      } /* end if */
+    } /* end for */
+  } /* end if */
+} /* end enter_idents */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure enter_defn(scope, defn)
+ * --------------------------------------------------------------------------
+ * Enters the identifiers defined by local definition defn into scope,
+ * including the values of enumeration types.  The formal parameters and
+ * local definitions of a local procedure belong to its own scope.
+ *
+ * astnode: (CONST bindNode (IDENT constId) typeNode exprNode)
+ *
+ * astnode: (TYPEDEF (IDENT typeId) typeNode)
+ *   with typeNode: (ENUM baseType (IDENTLIST value0 ... valueN))
+ *
+ * astnode: (VARDEF (IDENTLIST ident0 ... identN) typeNode)
+ *
+ * astnode: (PROC (PROCDECL bindSpecNode signatureNode) blockNode)
+ * ----------------------------------------------------------------------- */
+
+static void enter_defn (m2c_local_scope_t scope, m2c_astnode_t defn) {
+  
+  m2c_astnode_t node;
+  
+  switch (m2c_ast_nodetype(defn)) {
+    case AST_CONST :
+      node = m2c_ast_subnode_at_index(defn, 1);
+      break;
+  
+    case AST_TYPEDEF :
+      node = m2c_ast_subnode_at_index(defn, 1);
+  
+      if (m2c_ast_nodetype(node) == AST_ENUM) {
+        enter_idents(scope, m2c_ast_subnode_at_index(node, 1), defn);
+      } /* end if */
+  
+      node = m2c_ast_subnode_at_index(defn, 0);
+      break;
+  
+    case AST_VARDEF :
+      node = m2c_ast_subnode_at_index(defn, 0);
+      break;
+  
+    case AST_PROC :
+      node = m2c_ast_subnode_at_index(defn, 0);
+      node = m2c_ast_subnode_at_index(node, 1);
+      node = m2c_ast_subnode_at_index(node, 0);
+      break;
+  
+    default :
+      return;
+  } /* end switch */
+  
+  enter_idents(scope, node, defn);
+  
+} /* end enter_defn */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_local_scope(proc)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated local scope holding the formal parameters and
+ * the local definitions of procedure definition proc,  or NULL if
+ * allocation failed.
+ *
+ * astnode: (PROC (PROCDECL bindSpecNode signatureNode) blockNode)
+ *
+ * astnode: (PSIG (IDENT procId) (FPARAMLIST fparams0 ... fparamsN) retType)
+ *   with fparams: (FPARAMS attr (IDENTLIST ident0 ... identN) formalType)
+ *
+ * astnode: (BLOCK (DEFNLIST defnNode0 ... defnNodeN) stmtSeqNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_local_scope_t new_local_scope (m2c_astnode_t proc) {
+  
+  m2c_local_scope_t scope;
+  m2c_astnode_t list, item;
+  unsigned short index, count, sub_index, sub_count;
+  
+  scope = malloc(sizeof(m2c_local_scope_struct_t));
+  
+  if (scope == NULL) {
+    return NULL;
+  } /* end if */
+  
+  scope->proc = proc;
+  scope->ident.entry = calloc(TABLE_INITIAL_CAPACITY, sizeof(entry_t));
+  scope->ident.count = 0;
+  scope->ident.capacity = TABLE_INITIAL_CAPACITY;
+  scope->failed = false;
+  
+  if (scope->ident.entry == NULL) {
+    free(scope);
+    return NULL;
+  } /* end if */
+  
+  /* formal parameters */
+  list = m2c_ast_subnode_at_index(proc, 0);
+  list = m2c_ast_subnode_at_index(list, 1);
+  list = m2c_ast_subnode_at_index(list, 1);
+  
+  if (m2c_ast_nodetype(list) == AST_FPARAMLIST) {
+    count = m2c_ast_subnode_count(list);
+  
+    for (index = 0; index < count; index++) {
+      item = m2c_ast_subnode_at_index(list, index);
+      enter_idents(scope, m2c_ast_subnode_at_index(item, 1), item);
+    } /* end for */
+  } /* end if */
+  
+  /* local definitions */
+  list = m2c_ast_subnode_at_index(proc, 1);
+  list = m2c_ast_subnode_at_index(list, 0);
+  
+  if (m2c_ast_nodetype(list) == AST_DEFNLIST) {
+    count = m2c_ast_subnode_count(list);
+  
+    for (index = 0; index < count; index++) {
+      item = defn_of(m2c_ast_subnode_at_index(list, index));
+  
+      switch (m2c_ast_nodetype(item)) {
+        case AST_CONSTDEFLIST :
+        case AST_TYPEDEFLIST :
+        case AST_VARDEFLIST :
+          sub_count = m2c_ast_subnode_count(item);
+  
+          for (sub_index = 0; sub_index < sub_count; sub_index++) {
+            enter_defn(scope,
+              defn_of(m2c_ast_subnode_at_index(item, sub_index)));
+          } /* end for */
+          break;
+  
+        default :
+          enter_defn(scope, item);
+          break;
+      } /* end switch */
+    } /* end for */
+  } /* end if */
+  
+  if (scope->failed) {
+    release_local_scope(scope);
+    return NULL;
+  } /* end if */
+  
+  return scope;
+} /* end new_local_scope */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_local_scope(scope)
+ * --------------------------------------------------------------------------
+ * Deallocates scope.
+ * ----------------------------------------------------------------------- */
+
+static void release_local_scope (m2c_local_scope_t scope) {
+  
+  free(scope->ident.entry);
+  free(scope);
+  
+} /* end release_local_scope */
+
+
+/* --------------------------------------------------------------------------
+ * private function take_own_task(batch, worker)
+ * --------------------------------------------------------------------------
+ * Returns the index of the procedure at the head of the task queue of worker
+ * and removes it,  or returns the procedure count if the queue is empty.
+ * ----------------------------------------------------------------------- */
+
+static uint_t take_own_task (batch_context_t *batch, uint_t worker) {
+  
+  task_queue_t *queue = &batch->queue[worker];
+  uint_t index;
+  
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  pthread_mutex_lock(&queue->lock);
+#endif
+  
+  if (queue->head < queue->tail) {
+    index = queue->head;
+    queue->head++;
+  }
+  else /* empty */ {
+    index = batch->count;
+  } /* end if */
+  
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  pthread_mutex_unlock(&queue->lock);
+#endif
+  
+  return index;
+} /* end take_own_task */
+
+
+/* --------------------------------------------------------------------------
+ * private function steal_tasks(batch, thief)
+ * --------------------------------------------------------------------------
+ * Moves the upper half of the task queue of the worker with the most
+ * unchecked procedures into the empty task queue of worker thief.  Returns
+ * true on success,  false if the task queues of all other workers are empty.
+ * ----------------------------------------------------------------------- */
+
+static bool steal_tasks (batch_context_t *batch, uint_t thief) {
+  
+#if (M2C_PARALLEL_CHECK_SUPPORTED)
+  task_queue_t *queue;
+  uint_t index, victim, most, remaining, share, tail;
+  
+  while (true) {
+    /* find the worker with the most unchecked procedures */
+    victim = thief;
+    most = 0;
+  
+    for (index = 0; index < batch->workers; index++) {
+      if (index != thief) {
+        queue = &batch->queue[index];
+  
+        pthread_mutex_lock(&queue->lock);
+        remaining = queue->tail - queue->head;
+        pthread_mutex_unlock(&queue->lock);
+  
+        if (remaining > most) {
+          victim = index;
+          most = remaining;
+        } /* end if */
+      } /* end if */
+    } /* end for */
+  
+    if (most == 0) {
+      return false;
+    } /* end if */
+  
+    /* take the upper half, its owner may have drained it meanwhile */
+    queue = &batch->queue[victim];
+  
+    pthread_mutex_lock(&queue->lock);
+    remaining = queue->tail - queue->head;
+    share = (remaining + 1) / 2;
+    tail = queue->tail;
+    queue->tail = tail - share;
+    pthread_mutex_unlock(&queue->lock);
+  
+    if (share > 0) {
+      queue = &batch->queue[thief];
+  
+      pthread_mutex_lock(&queue->lock);
+      queue->head = tail - share;
+      queue->tail = tail;
+      pthread_mutex_unlock(&queue->lock);
+  
+      return true;
+    } /* end if */
+  } /* end while */
+#else
+  (void) batch;
+  (void) thief;
+  return false;
+#endif
+} /* end steal_tasks */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure check_task(batch, index, worker)
+ * --------------------------------------------------------------------------
+ * Builds the local scope of the procedure with index index of batch  and
+ * calls the handler of batch with a diagnostic buffer of its own as the
+ * current buffer.  The buffer is recorded in batch if the procedure has
+ * been checked,  otherwise it is released.
+ * ----------------------------------------------------------------------- */
+
+static void check_task (batch_context_t *batch, uint_t index, uint_t worker) {
+  
+  m2c_diag_buffer_t buffer;
+  m2c_local_scope_t scope;
+  
+  buffer = m2c_diag_new_buffer(NULL);
+  
+  if (buffer == NULL) {
+    return;
+  } /* end if */
+  
+  scope = new_local_scope(batch->proc[index]);
+  
+  if (scope == NULL) {
+    m2c_diag_release(buffer);
+    return;
+  } /* end if */
+  
+  m2c_diag_set_current(buffer);
+  batch->handler(batch->proc[index], scope, worker, batch->context);
+  m2c_diag_set_current(NULL);
+  
+  release_local_scope(scope);
+  
+  /* each index is checked by exactly one worker */
+  batch->buffer[index] = buffer;
+  
+} /* end check_task */
+
+
+/* --------------------------------------------------------------------------
+ * private function check_worker(arg)
+ * --------------------------------------------------------------------------
+ * Checks the procedures of the task queue of worker context arg,  then
+ * steals procedures from other workers until there are none left.  The
+ * current diagnostic buffer of the calling thread is preserved.  Always
+ * returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *check_worker (void *arg) {
+  
+  worker_context_t *w = (worker_context_t *) arg;
+  batch_context_t *b = w->batch;
+  m2c_diag_buffer_t saved;
+  uint_t index;
+  
+  saved = m2c_diag_current();
+  
+  do {
+    index = take_own_task(b, w->worker);
+  
+    while (index < b->count) {
+      check_task(b, index, w->worker);
+      index = take_own_task(b, w->worker);
+    } /* end while */
+  } while (steal_tasks(b, w->worker));
+  
+  m2c_diag_set_current(saved);
+  
+  return NULL;
+} /* end check_worker */
+
+
+/* END OF FILE */
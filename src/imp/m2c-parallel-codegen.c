@@ -0,0 +1,367 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-parallel-codegen.c                                                    *
+ *                                                                           *
+ * Implementation of parallel code generation module.                        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-parallel-codegen.h"
+
+#include <stdlib.h>
+
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type chunk_t
+ * --------------------------------------------------------------------------
+ * Record type for the translation of a single procedure definition.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* output */  char *output;
+  /* length */  size_t length;
+} chunk_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type batch_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the work shared by the workers of a call to procedure
+ * m2c_generate_procedures.  Workers claim the next untranslated index and
+ * record failures under lock.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* count */       uint_t count;
+  /* proc */        m2c_astnode_t *proc;
+  /* handler */     m2c_codegen_proc_handler_t handler;
+  /* context */     void *context;
+  /* chunk */       chunk_t *chunk;
+  /* next_index */  uint_t next_index;
+  /* status */      outfile_status_t status;
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+  /* lock */        pthread_mutex_t lock;
+#endif
+} batch_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type worker_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the arguments of a single worker.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* batch */   batch_context_t *batch;
+  /* worker */  uint_t worker;
+} worker_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint_t default_thread_count (void);
+
+static void *codegen_worker (void *arg);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_codegen_worker_count(count, threads)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers used for count procedures and a requested
+ * number of threads.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_codegen_worker_count (uint_t count, uint_t threads) {
+  
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+  if (threads == 0) {
+    threads = default_thread_count();
+  } /* end if */
+  
+  if (threads > count) {
+    threads = count;
+  } /* end if */
+  
+  if (threads == 0) {
+    threads = 1;
+  } /* end if */
+  
+  return threads;
+#else
+  (void) count;
+  (void) threads;
+  return 1;
+#endif
+} /* end m2c_codegen_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_generate_procedures(outfile, count, proc, ...)
+ * --------------------------------------------------------------------------
+ * Translates the count procedure definitions in array proc on up to threads
+ * worker threads  and writes their translations to outfile in array order.
+ * ----------------------------------------------------------------------- */
+
+void m2c_generate_procedures
+  (outfile_t outfile,                 /* in */
+   uint_t count,                      /* in */
+   m2c_astnode_t proc[],              /* in */
+   m2c_codegen_proc_handler_t handler, /* in */
+   void *context,                     /* in */
+   uint_t threads,                    /* in */
+   outfile_status_t *status)          /* out */ {
+  
+  batch_context_t batch;
+  worker_context_t *worker;
+  uint_t index, workers;
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+  pthread_t *thread;
+  uint_t started;
+#endif
+  
+  if ((outfile == NULL) || (handler == NULL) ||
+      ((proc == NULL) && (count > 0))) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  if (count == 0) {
+    SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  workers = m2c_codegen_worker_count(count, threads);
+  
+  batch.chunk = calloc(count, sizeof(chunk_t));
+  worker = malloc(workers * sizeof(worker_context_t));
+  
+  if ((batch.chunk == NULL) || (worker == NULL)) {
+    free(batch.chunk);
+    free(worker);
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  batch.count = count;
+  batch.proc = proc;
+  batch.handler = handler;
+  batch.context = context;
+  batch.next_index = 0;
+  batch.status = FILEIO_STATUS_SUCCESS;
+  
+  index = 0;
+  while (index < workers) {
+    worker[index].batch = &batch;
+    worker[index].worker = index;
+    index++;
+  } /* end while */
+  
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+  thread = NULL;
+  started = 0;
+  
+  if (workers > 1) {
+    thread = malloc((workers - 1) * sizeof(pthread_t));
+  } /* end if */
+  
+  pthread_mutex_init(&batch.lock, NULL);
+  
+  /* start helper threads, the calling thread is worker zero */
+  if (thread != NULL) {
+    while ((started < workers - 1) &&
+      (pthread_create(&thread[started], NULL,
+        codegen_worker, &worker[started + 1]) == 0)) {
+      started++;
+    } /* end while */
+  } /* end if */
+  
+  codegen_worker(&worker[0]);
+  
+  /* wait for helper threads to finish */
+  index = 0;
+  while (index < started) {
+    pthread_join(thread[index], NULL);
+    index++;
+  } /* end while */
+  
+  pthread_mutex_destroy(&batch.lock);
+  free(thread);
+#else
+  /* sequential fallback */
+  codegen_worker(&worker[0]);
+#endif
+  
+  /* merge translations in source order */
+  index = 0;
+  while (index < count) {
+    if (batch.status == FILEIO_STATUS_SUCCESS) {
+      outfile_write_bytes
+        (outfile, batch.chunk[index].output, batch.chunk[index].length);
+    } /* end if */
+    free(batch.chunk[index].output);
+    index++;
+  } /* end while */
+  
+  if (batch.status == FILEIO_STATUS_SUCCESS) {
+    batch.status = outfile_status(outfile);
+  } /* end if */
+  
+  free(batch.chunk);
+  free(worker);
+  
+  SET_STATUS(status, batch.status);
+  return;
+} /* end m2c_generate_procedures */
+
+
+/* Private Functions */
+
+/* --------------------------------------------------------------------------
+ * private function default_thread_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of online processors,  or one if it is unknown or if
+ * parallel code generation is not supported.
+ * ----------------------------------------------------------------------- */
+
+static uint_t default_thread_count (void) {
+  
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED) && defined(_SC_NPROCESSORS_ONLN)
+  long cpu_count;
+  
+  cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+  
+  if (cpu_count > 1) {
+    return (uint_t) cpu_count;
+  } /* end if */
+#endif
+  
+  return 1;
+} /* end default_thread_count */
+
+
+/* --------------------------------------------------------------------------
+ * private function claim_next_index(batch, failure)
+ * --------------------------------------------------------------------------
+ * Records failure in batch unless it is FILEIO_STATUS_SUCCESS  or another
+ * failure has been recorded before.  Returns the index of the next untrans-
+ * lated procedure of batch and advances it,  or returns the procedure count
+ * if all procedures have been claimed or a failure has been recorded.
+ * ----------------------------------------------------------------------- */
+
+static uint_t claim_next_index
+  (batch_context_t *batch, outfile_status_t failure) {
+  
+  uint_t index;
+  
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+  pthread_mutex_lock(&batch->lock);
+#endif
+  
+  if ((failure != FILEIO_STATUS_SUCCESS) &&
+      (batch->status == FILEIO_STATUS_SUCCESS)) {
+    batch->status = failure;
+  } /* end if */
+  
+  if (batch->status != FILEIO_STATUS_SUCCESS) {
+    batch->next_index = batch->count;
+  } /* end if */
+  
+  index = batch->next_index;
+  
+  if (index < batch->count) {
+    batch->next_index++;
+  } /* end if */
+  
+#if (M2C_PARALLEL_CODEGEN_SUPPORTED)
+  pthread_mutex_unlock(&batch->lock);
+#endif
+  
+  return index;
+} /* end claim_next_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function codegen_worker(arg)
+ * --------------------------------------------------------------------------
+ * Claims and translates procedures of the batch of worker context arg into
+ * a memory outfile of its own,  taking the output of each procedure into
+ * its chunk,  until all procedures have been claimed.  Always returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *codegen_worker (void *arg) {
+  
+  worker_context_t *w = (worker_context_t *) arg;
+  batch_context_t *b = w->batch;
+  outfile_status_t status;
+  outfile_t buffer;
+  chunk_t *chunk;
+  uint_t index;
+  
+  outfile_open_memory(&buffer, &status);
+  
+  if (status != FILEIO_STATUS_SUCCESS) {
+    claim_next_index(b, status);
+    return NULL;
+  } /* end if */
+  
+  index = claim_next_index(b, FILEIO_STATUS_SUCCESS);
+  
+  while (index < b->count) {
+    chunk = &b->chunk[index];
+    
+    b->handler(buffer, b->proc[index], w->worker, b->context);
+    chunk->output = outfile_take_output(buffer, &chunk->length);
+    
+    index = claim_next_index(b, outfile_status(buffer));
+  } /* end while */
+  
+  outfile_close(&buffer);
+  
+  return NULL;
+} /* end codegen_worker */
+
+
+/* END OF FILE */
@@ -0,0 +1,317 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-parallel-parser.c                                                     *
+ *                                                                           *
+ * Implementation of parallel front end module.                              *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-parallel-parser.h"
+#include "m2c-ident-class.h"
+#include "m2c-trace.h"
+
+#include <stdlib.h>
+
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type batch_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the work shared by the workers of a call to procedure
+ * m2c_parse_files.  Workers claim the next unparsed index under lock.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* count */       uint_t count;
+  /* srcpath */     const char **srcpath;
+  /* options */     m2c_compiler_options_t options;
+  /* result */      m2c_parse_result_t *result;
+  /* next_index */  uint_t next_index;
+  /* next_lane */   uint_t next_lane;
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  /* lock */        pthread_mutex_t lock;
+#endif
+} batch_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_parse_files(count, srcpath, options, threads, result)
+ * --------------------------------------------------------------------------
+ * Parses the count source files in array srcpath  on up to threads worker
+ * threads  and passes the outcome for srcpath[i] back in result[i].
+ * ----------------------------------------------------------------------- */
+
+static uint_t default_thread_count (void);
+
+static void *parse_worker (void *batch);
+
+void m2c_parse_files
+  (uint_t count,                      /* in */
+   const char *srcpath[],             /* in */
+   m2c_compiler_options_t options,    /* in */
+   uint_t threads,                    /* in */
+   m2c_parse_result_t result[])       /* out */ {
+  
+  batch_context_t batch;
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  pthread_t *worker;
+  uint_t index, started;
+#endif
+  
+  if ((count == 0) || (srcpath == NULL) || (result == NULL)) {
+    return;
+  } /* end if */
+  
+  /* install classifier and static lexemes before workers start to intern */
+  m2c_ident_class_init();
+  
+  batch.count = count;
+  batch.srcpath = srcpath;
+  batch.options = options;
+  batch.result = result;
+  batch.next_index = 0;
+  batch.next_lane = 0;
+  
+  if (threads == 0) {
+    threads = default_thread_count();
+  } /* end if */
+  
+  if (threads > count) {
+    threads = count;
+  } /* end if */
+  
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  worker = NULL;
+  started = 0;
+  
+  if (threads > 1) {
+    worker = malloc((threads - 1) * sizeof(pthread_t));
+  } /* end if */
+  
+  pthread_mutex_init(&batch.lock, NULL);
+  
+  /* start helper threads, the calling thread is the last worker */
+  if (worker != NULL) {
+    while ((started < threads - 1) &&
+      (pthread_create(&worker[started], NULL, parse_worker, &batch) == 0)) {
+      started++;
+    } /* end while */
+  } /* end if */
+  
+  parse_worker(&batch);
+  
+  /* wait for helper threads to finish */
+  index = 0;
+  while (index < started) {
+    pthread_join(worker[index], NULL);
+    index++;
+  } /* end while */
+  
+  pthread_mutex_destroy(&batch.lock);
+  free(worker);
+#else
+  /* sequential fallback */
+  parse_worker(&batch);
+#endif
+  
+} /* end m2c_parse_files */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_parse_results(count, result)
+ * --------------------------------------------------------------------------
+ * Releases the AST regions and statistics objects of the count results in
+ * array result  and clears the results.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_parse_results (uint_t count, m2c_parse_result_t result[]) {
+  
+  uint_t index;
+  
+  if (result == NULL) {
+    return;
+  } /* end if */
+  
+  index = 0;
+  while (index < count) {
+    if (result[index].region != NULL) {
+      m2c_ast_release_region(result[index].region);
+    } /* end if */
+    
+    if (result[index].stats != NULL) {
+      m2c_stats_release(result[index].stats);
+    } /* end if */
+    
+    result[index].ast = NULL;
+    result[index].region = NULL;
+    result[index].stats = NULL;
+    index++;
+  } /* end while */
+  
+} /* end m2c_release_parse_results */
+
+
+/* Private Functions */
+
+/* --------------------------------------------------------------------------
+ * private function default_thread_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of online processors,  or one if it is unknown or if
+ * parallel parsing is not supported.
+ * ----------------------------------------------------------------------- */
+
+static uint_t default_thread_count (void) {
+  
+#if (M2C_PARALLEL_PARSER_SUPPORTED) && defined(_SC_NPROCESSORS_ONLN)
+  long cpu_count;
+  
+  cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+  
+  if (cpu_count > 1) {
+    return (uint_t) cpu_count;
+  } /* end if */
+#endif
+  
+  return 1;
+} /* end default_thread_count */
+
+
+/* --------------------------------------------------------------------------
+ * private function claim_next_index(batch)
+ * --------------------------------------------------------------------------
+ * Returns the index of the next unparsed unit of batch  and advances it,  or
+ * returns the unit count if all units have been claimed.
+ * ----------------------------------------------------------------------- */
+
+static uint_t claim_next_index (batch_context_t *batch) {
+  
+  uint_t index;
+  
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  pthread_mutex_lock(&batch->lock);
+#endif
+  
+  index = batch->next_index;
+  
+  if (index < batch->count) {
+    batch->next_index++;
+  } /* end if */
+  
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  pthread_mutex_unlock(&batch->lock);
+#endif
+  
+  return index;
+} /* end claim_next_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function claim_next_lane(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of the calling worker of batch for its trace lane.
+ * ----------------------------------------------------------------------- */
+
+static uint_t claim_next_lane (batch_context_t *batch) {
+  
+  uint_t lane;
+  
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  pthread_mutex_lock(&batch->lock);
+#endif
+  
+  lane = batch->next_lane;
+  batch->next_lane++;
+  
+#if (M2C_PARALLEL_PARSER_SUPPORTED)
+  pthread_mutex_unlock(&batch->lock);
+#endif
+  
+  return lane;
+} /* end claim_next_lane */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_worker(batch)
+ * --------------------------------------------------------------------------
+ * Claims and parses units of batch,  each in an AST region of its own,
+ * until all units have been claimed.  Always returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *parse_worker (void *batch) {
+  
+  batch_context_t *b = (batch_context_t *) batch;
+  m2c_parse_result_t *result;
+  uint_t index;
+  
+  if (m2c_trace_enabled()) {
+    m2c_trace_name_thread("parse worker", claim_next_lane(b));
+  } /* end if */
+  
+  index = claim_next_index(b);
+  
+  while (index < b->count) {
+    result = &b->result[index];
+    result->ast = NULL;
+    result->stats = NULL;
+    result->region = m2c_ast_new_region(0);
+    
+    if (result->region == NULL) {
+      result->status = M2C_PARSER_STATUS_ALLOCATION_FAILED;
+    }
+    else /* parse into new region */ {
+      m2c_trace_begin("module", b->srcpath[index]);
+      m2c_ast_set_region(result->region);
+      result->ast = m2c_parse_file_with_options
+        (b->srcpath[index], b->options, &result->stats, &result->status);
+      m2c_ast_set_region(NULL);
+      m2c_trace_end("module");
+    } /* end if */
+    
+    index = claim_next_index(b);
+  } /* end while */
+  
+  return NULL;
+} /* end parse_worker */
+
+
+/* END OF FILE */
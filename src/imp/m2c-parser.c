@@ -45,27 +45,57 @@
 #include "m2c-digest.h"
 #include "m2c-tokenset.h"
 #include "m2c-fileutils.h"
+#include "m2c-pathnames.h"
 #include "m2c-production.h"
 #include "m2c-first-sets.h"
 #include "m2c-follow-sets.h"
+#include "m2c-resync-sets.h"
 #include "m2c-statistics.h"
+#include "m2c-diagnostics.h"
+#include "m2c-const-fold.h"
+#include "m2c-build-params.h"
 #include "m2c-predef-ident.h"
 #include "m2c-schroed-token.h"
 #include "m2c-bindable-ident.h"
 #include "m2c-compiler-options.h"
 
+#if (M2C_PARSER_ENGINE_LL1)
+#include "m2c-ll1-parser.h"
+#endif
+
+#include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 
 #define PARSER_DEBUG_INFO(_str) \
-  { if (m2c_option_parser_debug()) \
+  { if (m2c_compiler_options_flag(p->options, \
+        M2C_COMPILER_OPTION_PARSER_DEBUG)) \
       printf("*** %s ***\n  @ line: %u, column: %u, lookahead: %s\n", _str, \
         m2c_lexer_lookahead_line(p->lexer), \
         m2c_lexer_lookahead_column(p->lexer), \
         m2c_string_char_ptr(m2c_lexer_lookahead_lexeme(p->lexer))); }
 
 
+/* --------------------------------------------------------------------------
+ * macros PARSER_PROFILE_ENTER(name), PARSER_PROFILE_EXIT()
+ * --------------------------------------------------------------------------
+ * Mark entry to and exit from the parse function of a production.  Count
+ * calls,  symbols consumed and time spent  if option --parser-profile is
+ * on.  PARSER_PROFILE_EXIT must precede each return of the function.  The
+ * counters are kept in the parser context,  the address of the immutable
+ * name string of each function serves as its key.
+ * ----------------------------------------------------------------------- */
+
+#define PARSER_PROFILE_ENTER(_str) \
+  static const char profile_name[] = _str; \
+  profile_entry_t *profile_entry = \
+    (p->profile_table != NULL) ? profile_enter(p, profile_name) : NULL;
+
+#define PARSER_PROFILE_EXIT() \
+  { if (profile_entry != NULL) { profile_exit(p, profile_entry); } }
+
+
 /* --------------------------------------------------------------------------
  * private type m2c_module_context_t
  * --------------------------------------------------------------------------
@@ -107,7 +137,7 @@ typedef struct {
 
 static deflist_context_t *const_defn = {
   const_definition,   /* parse function */
-  CONST_DEFINITION,   /* production rule */
+  P_CONST_DEFINITION, /* production rule */
   AST_CONSTDEFLIST    /* AST node type */
 };
 
@@ -117,7 +147,7 @@ static deflist_context_t *const_defn = {
 
 static deflist_context_t *type_defn = {
   type_definition,   /* parse function */
-  TYPE_DEFINITION,   /* production rule */
+  P_TYPE_DEFINITION, /* production rule */
   AST_TYPEDEFLIST    /* AST node type */
 };
 
@@ -127,7 +157,7 @@ static deflist_context_t *type_defn = {
 
 static deflist_context_t *var_defn = {
   var_definition,   /* parse function */
-  VAR_DEFINITION,   /* production rule */
+  P_VAR_DEFINITION, /* production rule */
   AST_VARDEFLIST    /* AST node type */
 };
 
@@ -141,6 +171,47 @@ static deflist_context_t *var_defn = {
 typedef struct m2c_parser_context_s *m2c_parser_context_t;
 
 
+/* --------------------------------------------------------------------------
+ * private type bindspec_aliases_t
+ * --------------------------------------------------------------------------
+ * Strings representing attributed binding specifiers in BINDTO astnode.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  intstr_t newarg;    /* "NEWARG" represents [NEW ARGLIST] in AST node */
+  intstr_t newcap;    /* "NEWCAP" represents [NEW CAPACITY] in AST node */
+  intstr_t readnew;   /* "READNEW" represents [READ NEW] in AST node */
+  intstr_t writef;    /* "WRITEF" represents [WRITE #] in AST node */
+} bindspec_aliases_t;
+
+#define BINDSPEC_NEWARG (p->bindspec.newarg)
+#define BINDSPEC_NEWCAP (p->bindspec.newcap)
+#define BINDSPEC_READNEW (p->bindspec.readnew)
+#define BINDSPEC_WRITEF (p->bindspec.writef)
+
+
+/* --------------------------------------------------------------------------
+ * private type profile_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for the profile counters of a production.  Time and symbols
+ * are counted for the outermost activation only  so that recursion is not
+ * counted twice.  Entries are kept in an open addressing table of size
+ * PROFILE_TABLE_SIZE in the parser context.
+ * ----------------------------------------------------------------------- */
+
+#define PROFILE_TABLE_SIZE 256 /* power of two, above production count */
+
+typedef struct {
+  /* name */         const char *name;
+  /* calls */        unsigned long calls;
+  /* symbols */      unsigned long symbols;
+  /* time */         clock_t time;
+  /* active */       uint_t active;
+  /* entry_index */  uint_t entry_index;
+  /* entry_time */   clock_t entry_time;
+} profile_entry_t;
+
+
 /* --------------------------------------------------------------------------
  * private type m2c_parser_context_s
  * --------------------------------------------------------------------------
@@ -149,13 +220,32 @@ typedef struct m2c_parser_context_s *m2c_parser_context_t;
 
 struct m2c_parser_context_s {
   /* filename */           const char *filename;
-  /* basename */           const char *basename;
+  /* basename_length */    uint_t basename_length;
   /* suffix */             const char *suffix;
   /* lexer */              m2c_lexer_t lexer;
   /* stats */              m2c_stats_t stats;
+  /* diagnostics */        m2c_diag_buffer_t diagnostics;
+  /* prior_diagnostics */  m2c_diag_buffer_t prior_diagnostics;
   /* ast */                m2c_astnode_t ast;
   /* module_context */     m2c_module_context_t module_context;
   /* module_ident */       intstr_t module_ident;
+  /* decl_depth */         uint_t decl_depth;
+  /* error_count */        uint_t error_count;
+  /* panic_mode */         bool panic_mode;
+  /* options */            m2c_compiler_options_t options;
+  /* lazy_bodies */        bool lazy_bodies;
+  /* header_only */        bool header_only;
+  /* bindspec */           bindspec_aliases_t bindspec;
+  /* profile_table */      profile_entry_t *profile_table;
+  /* defn_handler */       m2c_parser_defn_handler_t defn_handler;
+  /* defn_context */       void *defn_context;
+  /* defn_region */        m2c_ast_region_t defn_region;
+  /* block_depth */        uint_t block_depth;
+  /* streamed_nodes */     size_t streamed_nodes;
+  /* folder */             m2c_const_fold_t folder;
+  /* diag_target */        m2c_diag_buffer_t diag_target;
+  /* span_handler */       m2c_parser_span_handler_t span_handler;
+  /* span_context */       void *span_context;
   /* status */             m2c_parser_status_t status;
 };
 
@@ -163,117 +253,1042 @@ typedef struct m2c_parser_context_s m2c_parser_context_s;
 
 
 /* --------------------------------------------------------------------------
- * strings representing attributed binding specifiers in BINDTO astnode
+ * private function profile_enter(p, name)
+ * --------------------------------------------------------------------------
+ * Looks up the profile entry for name in the profile table of p,  counts a
+ * call and records lookahead and time if it is the outermost activation.
+ * Returns the entry,  or NULL if the table is full.
+ * ----------------------------------------------------------------------- */
+
+static profile_entry_t *profile_enter
+  (m2c_parser_context_t p, const char *name) {
+  
+  profile_entry_t *entry;
+  uint_t index, probes;
+  
+  index = (uint_t) (((size_t) name >> 3) & (PROFILE_TABLE_SIZE - 1));
+  entry = &p->profile_table[index];
+  probes = 0;
+  
+  /* linear probing, name pointers are unique per production */
+  while ((entry->name != name) && (entry->name != NULL)) {
+    probes++;
+    if (probes == PROFILE_TABLE_SIZE) {
+      return NULL;
+    } /* end if */
+    index = (index + 1) & (PROFILE_TABLE_SIZE - 1);
+    entry = &p->profile_table[index];
+  } /* end while */
+  
+  entry->name = name;
+  entry->calls++;
+  
+  if (entry->active == 0) {
+    entry->entry_index = m2c_lexer_symbol_index(p->lexer);
+    entry->entry_time = clock();
+  } /* end if */
+  
+  entry->active++;
+  
+  return entry;
+} /* end profile_enter */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure profile_exit(p, entry)
+ * --------------------------------------------------------------------------
+ * Adds symbols consumed and time spent  since the outermost activation of
+ * the production of entry when that activation returns.
+ * ----------------------------------------------------------------------- */
+
+static void profile_exit (m2c_parser_context_t p, profile_entry_t *entry) {
+  
+  if (entry->active == 0) {
+    return;
+  } /* end if */
+  
+  entry->active--;
+  
+  if (entry->active == 0) {
+    entry->symbols +=
+      m2c_lexer_symbol_index(p->lexer) - entry->entry_index;
+    entry->time += clock() - entry->entry_time;
+  } /* end if */
+} /* end profile_exit */
+
+
+/* --------------------------------------------------------------------------
+ * private type source_text_t
+ * --------------------------------------------------------------------------
+ * Record type describing source text held in memory,  see m2c_parse_text.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* chars */        const char *chars;
+  /* length */       size_t length;
+  /* first_line */   uint_t first_line;
+} source_text_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_parser_context_t new_parser_context
+  (const char *srcpath, const source_text_t *text,
+   m2c_compiler_options_t options, bool header_only);
+
+static void release_parser_context (m2c_parser_context_t p);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file(srcpath, stats, status)
+ * --------------------------------------------------------------------------
+ * Parses the Modula-2 source file represented by srcpath, builds an abstract
+ * syntax tree (AST) and returns it.  Returns an incomplete AST if errors are
+ * encountered, or an empty AST if the source file cannot be found or opened,
+ * or NULL if memory allocation failed.  Prints warnings and errors to stderr
+ * and passes statistics in stats.  Passes the status in status.
+ * ----------------------------------------------------------------------- */
+ 
+m2c_astnode_t m2c_parse_file
+  (const char *srcpath,           /* in */
+   m2c_stats_t *stats,            /* out */
+   m2c_parser_status_t *status)   /* out */ {
+  
+  return m2c_parse_file_with_options
+    (srcpath, m2c_compiler_options_snapshot(), stats, status);
+  
+} /* end m2c_parse_file */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file_with_options(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file  but uses the compiler option snapshot options.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t parse_file
+  (const char *srcpath, m2c_compiler_options_t options,
+   m2c_const_fold_t folder, m2c_stats_t *stats, m2c_parser_status_t *status);
+ 
+m2c_astnode_t m2c_parse_file_with_options
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status)      /* out */ {
+  
+  return parse_file(srcpath, options, NULL, stats, status);
+  
+} /* end m2c_parse_file_with_options */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file_folding(srcpath, options, folder, stats, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file_with_options  but records the values of numeric
+ * literals as converted by the lexer in folder.
+ * ----------------------------------------------------------------------- */
+ 
+m2c_astnode_t m2c_parse_file_folding
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_const_fold_t folder,          /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status)      /* out */ {
+  
+  return parse_file(srcpath, options, folder, stats, status);
+  
+} /* end m2c_parse_file_folding */
+
+
+/* --------------------------------------------------------------------------
+ * private function parse_file(srcpath, options, folder, stats, status)
+ * --------------------------------------------------------------------------
+ * Parses the source file represented by srcpath with options,  records the
+ * values of numeric literals in folder unless it is NULL  and returns the
+ * AST.  Statistics and status are those of m2c_parse_file_with_options.
+ * ----------------------------------------------------------------------- */
+
+static void record_parse_stats (m2c_parser_context_t p, size_t prior_nodes);
+
+static m2c_astnode_t parse_file
+  (const char *srcpath, m2c_compiler_options_t options,
+   m2c_const_fold_t folder, m2c_stats_t *stats, m2c_parser_status_t *status) {
+   
+  m2c_parser_context_t p;
+  m2c_astnode_t ast;
+  size_t prior_nodes;
+  
+  if (srcpath == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  if (is_valid_pathname(srcpath) == false) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_PATHNAME);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  /* set up parser context */
+  p = new_parser_context(srcpath, NULL, options, false);
+  
+  if (p == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  p->folder = folder;
+  
+  /* parse and build AST */
+  prior_nodes = m2c_ast_region_node_count(m2c_ast_current_region());
+  m2c_stats_begin_phase(p->stats, M2C_STATS_PHASE_PARSE);
+  
+  parse_start_symbol(p);
+  ast = p->ast;
+  
+  m2c_stats_end_phase(p->stats, M2C_STATS_PHASE_PARSE);
+  
+  /* update statistics counters */
+  record_parse_stats(p, prior_nodes);
+  
+  /* pass back statistics, the caller owns them now */
+  *stats = p->stats;
+  p->stats = NULL;
+  
+  /* pass back status */
+  SET_STATUS(status, p->status);
+  
+  /* clean up and return */
+  release_parser_context(p);
+  
+  return ast;
+} /* end parse_file */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_header(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Parses the module header and import list of the Modula-2 source file
+ * represented by srcpath,  stops after the last import  and returns the AST.
+ * ----------------------------------------------------------------------- */
+ 
+m2c_astnode_t m2c_parse_header
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status)      /* out */ {
+   
+  m2c_parser_context_t p;
+  m2c_astnode_t ast;
+  size_t prior_nodes;
+  
+  if (srcpath == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  if (is_valid_pathname(srcpath) == false) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_PATHNAME);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  /* set up parser context with a prefix reading lexer */
+  p = new_parser_context(srcpath, NULL, options, true);
+  
+  if (p == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* parse and build AST, stops after the last import */
+  prior_nodes = m2c_ast_region_node_count(m2c_ast_current_region());
+  m2c_stats_begin_phase(p->stats, M2C_STATS_PHASE_PARSE);
+  
+  parse_start_symbol(p);
+  ast = p->ast;
+  
+  m2c_stats_end_phase(p->stats, M2C_STATS_PHASE_PARSE);
+  
+  record_parse_stats(p, prior_nodes);
+  
+  /* pass back statistics, the caller owns them now */
+  *stats = p->stats;
+  p->stats = NULL;
+  
+  SET_STATUS(status, p->status);
+  
+  /* clean up and return */
+  release_parser_context(p);
+  
+  return ast;
+} /* end m2c_parse_header */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file_streaming(srcpath, options, ...)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file_with_options  but passes each top-level definition
+ * to handler as soon as it has been parsed  and deallocates it thereafter.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_parse_file_streaming
+  (const char *srcpath,                /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_parser_defn_handler_t handler,  /* in */
+   void *context,                      /* in */
+   m2c_stats_t *stats,                 /* out */
+   m2c_parser_status_t *status)        /* out */ {
+  
+  m2c_parser_context_t p;
+  m2c_astnode_t ast;
+  size_t prior_nodes;
+  
+  if ((srcpath == NULL) || (handler == NULL)) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  if (is_valid_pathname(srcpath) == false) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_PATHNAME);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  /* set up parser context with a scratch region for definitions */
+  p = new_parser_context(srcpath, NULL, options, false);
+  
+  if (p == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  p->defn_region = m2c_ast_new_region(0);
+  
+  if (p->defn_region == NULL) {
+    release_parser_context(p);
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  p->defn_handler = handler;
+  p->defn_context = context;
+  
+  /* parse, stream definitions and build module AST */
+  prior_nodes = m2c_ast_region_node_count(m2c_ast_current_region());
+  m2c_stats_begin_phase(p->stats, M2C_STATS_PHASE_PARSE);
+  
+  parse_start_symbol(p);
+  ast = p->ast;
+  
+  m2c_stats_end_phase(p->stats, M2C_STATS_PHASE_PARSE);
+  
+  /* update statistics counters, streamed nodes included */
+  record_parse_stats(p, prior_nodes);
+  
+  /* pass back statistics, the caller owns them now */
+  *stats = p->stats;
+  p->stats = NULL;
+  
+  /* pass back status */
+  SET_STATUS(status, p->status);
+  
+  /* clean up and return */
+  m2c_ast_release_region(p->defn_region);
+  release_parser_context(p);
+  
+  return ast;
+} /* end m2c_parse_file_streaming */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_check_syntax(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Checks the syntax of the source file represented by srcpath  with the
+ * engine selected by build parameter M2C_PARSER_ENGINE_LL1.  The recursive
+ * descent parser builds its AST in a scratch region  released on return.
+ * ----------------------------------------------------------------------- */
+
+void m2c_check_syntax
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status)      /* out */ {
+  
+#if (M2C_PARSER_ENGINE_LL1)
+  m2c_ll1_check_file(srcpath, options, stats, status);
+#else
+  m2c_ast_region_t region, prev_region;
+  
+  region = m2c_ast_new_region(0);
+  
+  if (region == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  prev_region = m2c_ast_current_region();
+  m2c_ast_set_region(region);
+  
+  m2c_parse_file_with_options(srcpath, options, stats, status);
+  
+  m2c_ast_set_region(prev_region);
+  m2c_ast_release_region(region);
+#endif
+} /* end m2c_check_syntax */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_parser_set_lazy_bodies(enabled)
+ * --------------------------------------------------------------------------
+ * Enables or disables lazy parsing of bodies.
+ * ----------------------------------------------------------------------- */
+
+void m2c_parser_set_lazy_bodies (bool enabled) {
+  
+  m2c_compiler_option_set(M2C_COMPILER_OPTION_LAZY_BODIES, enabled);
+  
+} /* end m2c_parser_set_lazy_bodies */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_lazy_body(srcpath, options, body_node, status)
+ * --------------------------------------------------------------------------
+ * Parses the statement sequence recorded in LAZYBODY node body_node  and
+ * returns its AST.  Only the symbols of the body are parsed,  the symbols
+ * before it are merely lexed.
+ * ----------------------------------------------------------------------- */
+
+static bool match_set
+  (m2c_parser_context_t p, m2c_tokenset_t expected_set);
+
+static m2c_token_t statement_sequence (m2c_parser_context_t p);
+
+m2c_astnode_t m2c_parse_lazy_body
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_astnode_t body_node,          /* in */
+   m2c_parser_status_t *status)      /* out */ {
+  
+  m2c_parser_context_t p;
+  m2c_astnode_t ast;
+  uint_t first, count;
+  
+  if ((srcpath == NULL) || (m2c_ast_nodetype(body_node) != AST_LAZYBODY)) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  first = strtoul(intstr_char_ptr(m2c_ast_value_at_index(body_node, 0)),
+    NULL, 10);
+  count = strtoul(intstr_char_ptr(m2c_ast_value_at_index(body_node, 1)),
+    NULL, 10);
+  
+  if (count == 0) {
+    SET_STATUS(status, M2C_PARSER_STATUS_SUCCESS);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  /* a body is always parsed in full */
+  options = options & ~(1UL << M2C_COMPILER_OPTION_LAZY_BODIES);
+  
+  p = new_parser_context(srcpath, NULL, options, false);
+  
+  if (p == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* position lexer at the first symbol of the body */
+  m2c_lexer_skip_to_symbol(p->lexer, first);
+  
+  if (match_set(p, FIRST(STATEMENT_SEQUENCE))) {
+    statement_sequence(p);
+    ast = p->ast;
+    
+    if (m2c_lexer_symbol_index(p->lexer) != first + count) {
+      m2c_diag_add(p->diagnostics, M2C_DIAG_ERROR,
+        m2c_lexer_lookahead_line(p->lexer),
+        m2c_lexer_lookahead_column(p->lexer),
+        "body does not end where recorded, source changed since lazy parse");
+      m2c_stats_inc(p->stats, M2C_STATS_SYNTAX_ERROR_COUNT);
+      p->status = M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND;
+    } /* end if */
+  }
+  else /* source changed */ {
+    ast = m2c_ast_empty_node();
+    p->status = M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND;
+  } /* end if */
+  
+  SET_STATUS(status, p->status);
+  release_parser_context(p);
+  
+  return ast;
+} /* end m2c_parse_lazy_body */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_text(name, text, length, options, handler, ...)
+ * --------------------------------------------------------------------------
+ * Parses the length characters at text as the source represented by name,
+ * reports the line span of each top-level definition to handler  and adds
+ * the diagnostics to buffer diagnostics.  Returns the AST.
+ * ----------------------------------------------------------------------- */
+
+static void parse_start_symbol (m2c_parser_context_t p);
+
+m2c_astnode_t m2c_parse_text
+  (const char *name,                   /* in */
+   const char *text,                   /* in */
+   size_t length,                      /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_parser_span_handler_t handler,  /* in */
+   void *context,                      /* in */
+   m2c_diag_buffer_t diagnostics,      /* in */
+   m2c_parser_status_t *status)        /* out */ {
+  
+  m2c_parser_context_t p;
+  m2c_astnode_t ast;
+  source_text_t source;
+  
+  if ((name == NULL) || ((text == NULL) && (length > 0))) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return m2c_ast_empty_node();
+  } /* end if */
+  
+  source.chars = text;
+  source.length = length;
+  source.first_line = 1;
+  
+  /* bodies are always parsed in full */
+  options = options & ~(1UL << M2C_COMPILER_OPTION_LAZY_BODIES);
+  
+  p = new_parser_context(name, &source, options, false);
+  
+  if (p == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  p->diag_target = diagnostics;
+  p->span_handler = handler;
+  p->span_context = context;
+  
+  /* parse and build AST */
+  parse_start_symbol(p);
+  ast = p->ast;
+  
+  SET_STATUS(status, p->status);
+  release_parser_context(p);
+  
+  return ast;
+} /* end m2c_parse_text */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_definitions_text(name, text, length, first_line, ...)
+ * --------------------------------------------------------------------------
+ * Parses a sequence of top-level definitions from the length characters at
+ * text whose first line is line first_line of the source represented by
+ * name,  adds the diagnostics to buffer diagnostics  and returns the list of
+ * definitions.  Passes in complete whether the end of text was reached.
+ *
+ * astnode: (DEFNLIST defnNode+) | EMPTY
+ * ----------------------------------------------------------------------- */
+
+static m2c_token_t spanned_definition (m2c_parser_context_t p);
+
+m2c_astnode_t m2c_parse_definitions_text
+  (const char *name,                   /* in */
+   const char *text,                   /* in */
+   size_t length,                      /* in */
+   uint_t first_line,                  /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_parser_span_handler_t handler,  /* in */
+   void *context,                      /* in */
+   m2c_diag_buffer_t diagnostics,      /* in */
+   bool *complete,                     /* out */
+   m2c_parser_status_t *status)        /* out */ {
+  
+  m2c_parser_context_t p;
+  m2c_token_t lookahead;
+  m2c_fifo_t defn_list;
+  m2c_astnode_t list_node;
+  source_text_t source;
+  
+  if ((name == NULL) || (complete == NULL) ||
+      ((text == NULL) && (length > 0))) {
+    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  source.chars = text;
+  source.length = length;
+  source.first_line = first_line;
+  
+  /* bodies are always parsed in full */
+  options = options & ~(1UL << M2C_COMPILER_OPTION_LAZY_BODIES);
+  
+  p = new_parser_context(name, &source, options, false);
+  
+  if (p == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  p->diag_target = diagnostics;
+  p->span_handler = handler;
+  p->span_context = context;
+  
+  defn_list = m2c_fifo_new_queue(NULL);
+  
+  /* definitions are parsed as within the module block */
+  p->block_depth = 1;
+  lookahead = m2c_next_sym(p->lexer);
+  
+  while (m2c_tokenset_element(FIRST(DEFINITION), lookahead)) {
+    lookahead = spanned_definition(p);
+    m2c_fifo_enqueue(defn_list, p->ast);
+  } /* end while */
+  
+  *complete = (lookahead == TOKEN_EOF);
+  
+  if (m2c_fifo_entry_count(defn_list) > 0) {
+    list_node = m2c_ast_new_list_node(AST_DEFNLIST, defn_list);
+  }
+  else /* no definitions */ {
+    list_node = m2c_ast_empty_node();
+  } /* end if */
+  
+  m2c_fifo_release(defn_list);
+  
+  SET_STATUS(status, p->status);
+  release_parser_context(p);
+  
+  return list_node;
+} /* end m2c_parse_definitions_text */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure record_parse_stats(p, prior_nodes)
+ * --------------------------------------------------------------------------
+ * Records the line,  token and byte counts of the lexer of p  and the number
+ * of AST nodes allocated in the current region  beyond prior_nodes,  plus
+ * those of streamed definitions,  in the statistics of p.  Nodes allocated
+ * outside of regions are not counted.
  * ----------------------------------------------------------------------- */
 
-#define BINDSPEC_NEWARG attr_bindspec.newarg;
-#define BINDSPEC_NEWCAP attr_bindspec.necap;
-#define BINDSPEC_READNEW attr_bindspec.readnew;
-#define BINDSPEC_WRITEF attr_bindspec.writef;
+static void record_parse_stats (m2c_parser_context_t p, size_t prior_nodes) {
+  size_t node_count;
+  
+  node_count = m2c_ast_region_node_count(m2c_ast_current_region());
+  
+  /* nodes of streamed definitions have been deallocated already */
+  node_count = node_count + p->streamed_nodes;
+  
+  m2c_stats_set_line_count(p->stats, m2c_lexer_current_line(p->lexer));
+  
+  m2c_stats_set(p->stats, M2C_STATS_TOKEN_COUNT,
+    (uint64_t) m2c_lexer_symbol_index(p->lexer) + 1);
+  
+  m2c_stats_set(p->stats, M2C_STATS_BYTES_READ,
+    (uint64_t) m2c_lexer_bytes_read(p->lexer));
+  
+  if (node_count > prior_nodes) {
+    m2c_stats_set(p->stats, M2C_STATS_AST_NODE_COUNT,
+      (uint64_t) (node_count - prior_nodes));
+  } /* end if */
+} /* end record_parse_stats */
 
-static struct {
-  intstr_t newarg;    /* "NEWARG" represents [NEW ARGLIST] in AST node */
-  intstr_t newcap;    /* "NEWCAP" represents [NEW CAPACITY] in AST node */
-  intstr_t readnew;   /* "READNEW" represents [READ NEW] in AST node */
-  intstr_t writef;    /* "WRITEF" represents [WRITE #] in AST node */
-} attr_bindspec;
+
+/* --------------------------------------------------------------------------
+ * private procedure note_literal_value(p)
+ * --------------------------------------------------------------------------
+ * Records the value of the most recently consumed numeric literal as the
+ * value of literal node p->ast in the constant folder of p,  if any.
+ * ----------------------------------------------------------------------- */
+
+static void note_literal_value (m2c_parser_context_t p) {
+  
+  if (p->folder != NULL) {
+    m2c_const_fold_note_literal(p->folder, p->ast,
+      m2c_lexer_current_value(p->lexer));
+  } /* end if */
+} /* end note_literal_value */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_parse_file(srcpath, stats, status)
+ * private function new_parser_context(srcpath, text, options, header_only)
  * --------------------------------------------------------------------------
- * Parses the Modula-2 source file represented by srcpath, builds an abstract
- * syntax tree (AST) and returns it.  Returns an incomplete AST if errors are
- * encountered, or an empty AST if the source file cannot be found or opened,
- * or NULL if memory allocation failed.  Prints warnings and errors to stderr
- * and passes statistics in stats.  Passes the status in status.
+ * Returns a new parser context with a lexer for the source file represented
+ * by srcpath,  a new statistics object and compiler option snapshot options,
+ * or NULL if allocation failed.  If text is not NULL,  the lexer reads text
+ * instead of the file and srcpath only identifies the source.  If header_only
+ * is true,  the lexer reads only as much of the file as is parsed.
  * ----------------------------------------------------------------------- */
- 
-m2c_ast_t m2c_parse_file
-  (const char *srcpath,           /* in */
-   m2c_stats_t *stats,            /* out */
-   m2c_parser_status_t *status)   /* out */ {
-   
+
+static m2c_parser_context_t new_parser_context
+  (const char *srcpath, const source_text_t *text,
+   m2c_compiler_options_t options, bool header_only) {
+  
   const char *filename;
-  const char *basename;
   const char *suffix;
+  m2c_pathname_view_t fnview, baseview, suffixview;
   m2c_parser_context_t p;
-  m2c_astnode_t ast;
   
-  if (srcpath == NULL) {
-    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_REFERENCE);
-    return m2c_ast_empty_node();
+  p = malloc(sizeof(m2c_parser_context_s));
+  
+  if (p == NULL) {
+    return NULL;
   } /* end if */
   
-  if (is_valid_pathname(srcpath) == false) {
-    SET_STATUS(status, M2C_PARSER_STATUS_INVALID_PATHNAME);
-    return m2c_ast_empty_node();
+  /* create new statistics object */
+  p->stats = m2c_stats_new();
+  
+  if (p->stats == NULL) {
+    free(p);
+    return NULL;
   } /* end if */
-      
-  /* set up parser context */
-  p = malloc(sizeof(m2c_parser_context_s));
   
-  if (p == NULL) {
-    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+  /* sample hardware counters if option --perf-counters is on */
+  if (m2c_compiler_options_flag(options, M2C_COMPILER_OPTION_PERF_COUNTERS)) {
+    m2c_stats_open_perf_counters(p->stats);
+  } /* end if */
+  
+  /* collect diagnostics of this module until the context is released */
+  p->diagnostics = m2c_diag_new_buffer(srcpath);
+  
+  if (p->diagnostics == NULL) {
+    m2c_stats_release(p->stats);
+    free(p);
     return NULL;
   } /* end if */
   
+  m2c_diag_set_limits(p->diagnostics,
+    m2c_compiler_option_max_errors(), m2c_compiler_option_max_warnings());
+  
+  p->prior_diagnostics = m2c_diag_current();
+  m2c_diag_set_current(p->diagnostics);
+  
   /* create lexer object */
-  m2c_new_lexer(&(p->lexer), srcpath, NULL);
+  m2c_stats_begin_phase(p->stats, M2C_STATS_PHASE_LOAD);
+  
+  if (text != NULL) {
+    m2c_new_text_lexer(&(p->lexer), srcpath,
+      text->chars, text->length, text->first_line, NULL);
+  }
+  else if (header_only) {
+    m2c_new_header_lexer(&(p->lexer), srcpath, NULL);
+  }
+  else /* whole file */ {
+    m2c_new_lexer(&(p->lexer), srcpath, NULL);
+  } /* end if */
+  
+  m2c_stats_end_phase(p->stats, M2C_STATS_PHASE_LOAD);
   
   if (p->lexer == NULL) {
-    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    m2c_diag_flush(p->diagnostics, NULL, false, stdout);
+    m2c_diag_release(p->diagnostics);
+    m2c_diag_set_current(p->prior_diagnostics);
+    m2c_stats_release(p->stats);
     free(p);
     return NULL;
   } /* end if */
   
-  /* create new statistics object */
-  p->stats = m2c_stats_new();
+  /* lex ahead of parsing if option --time-report or --perf-counters is on */
+  /* the time report notes that lexing was timed in pretokenize mode */
+  if ((NOT(header_only)) &&
+      ((m2c_compiler_options_flag(options, M2C_COMPILER_OPTION_TIME_REPORT)) ||
+       (m2c_compiler_options_flag(options,
+         M2C_COMPILER_OPTION_PERF_COUNTERS)))) {
+    m2c_stats_begin_phase(p->stats, M2C_STATS_PHASE_LEX);
+    m2c_lexer_pretokenize(p->lexer, NULL);
+    m2c_stats_end_phase(p->stats, M2C_STATS_PHASE_LEX);
+  } /* end if */
   
-  if (p->stats == NULL) {
-    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
-    free(p->lexer);
-    free(p);
-    return NULL;
+  /* create profile table if option --parser-profile is on */
+  p->profile_table = NULL;
+  
+  if (m2c_compiler_options_flag(options, M2C_COMPILER_OPTION_PARSER_PROFILE)) {
+    p->profile_table = calloc(PROFILE_TABLE_SIZE, sizeof(profile_entry_t));
+    
+    if (p->profile_table == NULL) {
+      m2c_lexer_flush_diagnostics(p->lexer, p->diagnostics, false);
+      m2c_diag_release(p->diagnostics);
+      m2c_diag_set_current(p->prior_diagnostics);
+      m2c_stats_release(p->stats);
+      m2c_release_lexer(&(p->lexer), NULL);
+      free(p);
+      return NULL;
+    } /* end if */
   } /* end if */
   
   /* init aliases for attributed binding specifiers */
-  attr_bindspec.newarg = intstr_for_cstr("NEWARG", NULL);
-  attr_bindspec.newcap = intstr_for_cstr("NEWCAP", NULL);
-  attr_bindspec.readnew = intstr_for_cstr("READNEW", NULL);
-  attr_bindspec.writef = intstr_for_cstr("WRITEF", NULL);
+  p->bindspec.newarg = intstr_for_cstr("NEWARG", NULL);
+  p->bindspec.newcap = intstr_for_cstr("NEWCAP", NULL);
+  p->bindspec.readnew = intstr_for_cstr("READNEW", NULL);
+  p->bindspec.writef = intstr_for_cstr("WRITEF", NULL);
   
-  /* get filename, basename and suffix */
-  split_pathname(srcpath, NULL, &filename, NULL);
-  split_filename(filename, &basename, &suffix, NULL);
+  /* get filename, basename and suffix within srcpath */
+  if (split_pathname_view(srcpath, NULL, &fnview, NULL) !=
+      M2C_PATHNAME_STATUS_SUCCESS) {
+    fnview.offset = 0;
+  } /* end if */
+  
+  filename = srcpath + fnview.offset;
+  
+  if (split_filename_view(filename, &baseview, &suffixview, NULL) ==
+      M2C_PATHNAME_STATUS_SUCCESS) {
+    suffix = filename + suffixview.offset;
+  }
+  else /* no valid basename and suffix */ {
+    baseview.length = 0;
+    suffix = "";
+  } /* end if */
   
   /* init parser context */
   p->filename = filename;
-  p->basename = basename;
+  p->basename_length = baseview.length;
   p->suffix = suffix;
   p->module_context = 0;
   p->module_ident = NULL;
+  p->decl_depth = 0;
+  p->error_count = 0;
+  p->panic_mode = false;
+  p->options = options;
+  p->header_only = header_only;
+  p->lazy_bodies =
+    m2c_compiler_options_flag(options, M2C_COMPILER_OPTION_LAZY_BODIES);
+  p->folder = NULL;
+  p->diag_target = NULL;
+  p->span_handler = NULL;
+  p->span_context = NULL;
+  p->defn_handler = NULL;
+  p->defn_context = NULL;
+  p->defn_region = NULL;
+  p->block_depth = 0;
+  p->streamed_nodes = 0;
   p->ast = NULL;
   p->status = 0;
-    
-  /* parse and build AST */
-  parse_start_symbol(p);
-  ast = p->ast;
   
-  /* update statistics line counter */
-  m2c_stats_set_line_count(p->stats, m2c_lexer_current_line(p->lexer));
+  return p;
+} /* end new_parser_context */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_parser_context(p)
+ * --------------------------------------------------------------------------
+ * Prints the profile of parser context p  if option --parser-profile is on,
+ * flushes its diagnostics,  with source lines if option --verbose is on,  or
+ * moves them to the target buffer of p if it has one,
+ * releases its profile table,  statistics object unless passed on,  lexer,
+ * then p.  The diagnostic buffer that was current when p was created is
+ * made current again.
+ * ----------------------------------------------------------------------- */
+
+static void print_profile (m2c_parser_context_t p);
+
+static void release_parser_context (m2c_parser_context_t p) {
   
-  /* pass back statistics and return status */
-  *stats = p->stats;
-  SET_STATUS(status, p->status);
+  if (p->profile_table != NULL) {
+    print_profile(p);
+    free(p->profile_table);
+  } /* end if */
   
-  /* clean up and return */
-  m2c_stats_release(p->stats);
-  m2c_release_lexer(p->lexer);
+  if (p->stats != NULL) {
+    m2c_stats_release(p->stats);
+  } /* end if */
+  
+  if (p->diag_target != NULL) {
+    m2c_diag_merge(p->diag_target, p->diagnostics);
+  }
+  else /* report */ {
+    m2c_lexer_flush_diagnostics(p->lexer, p->diagnostics,
+      m2c_compiler_options_flag(p->options, M2C_COMPILER_OPTION_VERBOSE));
+  } /* end if */
+  
+  m2c_diag_release(p->diagnostics);
+  m2c_diag_set_current(p->prior_diagnostics);
+  
+  m2c_release_lexer(&(p->lexer), NULL);
   free(p);
   
-  return ast;
-} /* end m2c_parse_file */
+} /* end release_parser_context */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure print_profile(p)
+ * --------------------------------------------------------------------------
+ * Prints the number of calls,  symbols consumed and time spent  for each
+ * production parsed in parser context p,  sorted by time spent.  Time and
+ * symbols of a production include those of nested productions.  The report
+ * is printed with a single call  so that reports of parsers running in
+ * parallel do not interleave.
+ * ----------------------------------------------------------------------- */
+
+#define PROFILE_LINE_LENGTH 80
+
+static int compare_profile_entries (const void *entry1, const void *entry2);
+
+static void print_profile (m2c_parser_context_t p) {
+  
+  profile_entry_t *table;
+  uint_t index, count;
+  char *report, *next;
+  double msec;
+  
+  table = p->profile_table;
+  
+  /* move used entries to the front and sort them */
+  count = 0;
+  index = 0;
+  while (index < PROFILE_TABLE_SIZE) {
+    if (table[index].name != NULL) {
+      table[count] = table[index];
+      count++;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  if (count == 0) {
+    return;
+  } /* end if */
+  
+  qsort(table, count, sizeof(profile_entry_t), compare_profile_entries);
+  
+  /* header line, column line, one line per entry, terminator */
+  report = malloc((count + 2) * PROFILE_LINE_LENGTH + 1);
+  
+  if (report == NULL) {
+    return;
+  } /* end if */
+  
+  next = report;
+  next += sprintf(next, "parser profile: %.*s\n",
+    PROFILE_LINE_LENGTH - 18, p->filename);
+  next += sprintf(next, "%-32s %10s %10s %10s\n",
+    "production", "calls", "symbols", "msec");
+  
+  index = 0;
+  while (index < count) {
+    msec = ((double) table[index].time * 1000.0) / CLOCKS_PER_SEC;
+    next += sprintf(next, "%-32.32s %10lu %10lu %10.3f\n",
+      table[index].name, table[index].calls, table[index].symbols, msec);
+    index++;
+  } /* end while */
+  
+  fputs(report, stdout);
+  free(report);
+} /* end print_profile */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_profile_entries(entry1, entry2)
+ * --------------------------------------------------------------------------
+ * Orders profile entries by time,  then calls,  both in descending order.
+ * ----------------------------------------------------------------------- */
+
+static int compare_profile_entries (const void *entry1, const void *entry2) {
+  
+  const profile_entry_t *e1 = (const profile_entry_t *) entry1;
+  const profile_entry_t *e2 = (const profile_entry_t *) entry2;
+  
+  if (e1->time != e2->time) {
+    return (e1->time < e2->time) ? 1 : -1;
+  } /* end if */
+  
+  if (e1->calls != e2->calls) {
+    return (e1->calls < e2->calls) ? 1 : -1;
+  } /* end if */
+  
+  return 0;
+} /* end compare_profile_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private function syntax_error_reportable(p)
+ * --------------------------------------------------------------------------
+ * Counts a syntax error and returns true if it should be reported.
+ *
+ * (1) without option --max-errors:
+ *
+ * Once the count exceeds M2C_MAX_SYNTAX_ERRORS,  adds a note to the
+ * diagnostics,  switches the parser to panic mode and returns false for
+ * this and all further errors.
+ *
+ * (2) with option --max-errors:
+ *
+ * Once the diagnostics hold as many errors as the limit permits,  adds a
+ * note,  skips the remainder of the module  and returns false for this and
+ * all further errors.
+ * ----------------------------------------------------------------------- */
+
+static void skip_to_eof (m2c_parser_context_t p);
+
+static bool syntax_error_reportable (m2c_parser_context_t p) {
+  
+  char note[80];
+  
+  if (p->panic_mode) {
+    return false;
+  } /* end if */
+  
+  p->error_count++;
+  
+  if (m2c_compiler_option_max_errors() > 0) {
+    if (m2c_diag_limit_reached(p->diagnostics, M2C_DIAG_ERROR)) {
+      snprintf(note, sizeof(note),
+        "error limit of %u reached, skipping to end of file",
+        m2c_compiler_option_max_errors());
+      m2c_diag_add(p->diagnostics, M2C_DIAG_NOTE,
+        m2c_lexer_lookahead_line(p->lexer),
+        m2c_lexer_lookahead_column(p->lexer), note);
+      
+      skip_to_eof(p);
+      return false;
+    } /* end if */
+    
+    return true;
+  } /* end if */
+  
+  if (p->error_count > M2C_MAX_SYNTAX_ERRORS) {
+    snprintf(note, sizeof(note),
+      "more than %u syntax errors, resuming at declarations only",
+      (unsigned int) M2C_MAX_SYNTAX_ERRORS);
+    m2c_diag_add(p->diagnostics, M2C_DIAG_NOTE,
+      m2c_lexer_lookahead_line(p->lexer),
+      m2c_lexer_lookahead_column(p->lexer), note);
+    
+    p->panic_mode = true;
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end syntax_error_reportable */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure skip_to_eof(p)
+ * --------------------------------------------------------------------------
+ * Consumes all remaining symbols without parsing them  and switches the
+ * parser to panic mode.  The lexer thus still counts lines and updates the
+ * module digest,  while the pending productions unwind at end of file
+ * without reporting further errors.
+ * ----------------------------------------------------------------------- */
+
+static void skip_to_eof (m2c_parser_context_t p) {
+  
+  m2c_token_t lookahead;
+  
+  p->panic_mode = true;
+  
+  lookahead = m2c_next_sym(p->lexer);
+  
+  while (lookahead != TOKEN_EOF) {
+    lookahead = m2c_consume_sym(p->lexer);
+  } /* end while */
+  
+  return;
+} /* end skip_to_eof */
 
 
 /* --------------------------------------------------------------------------
@@ -304,13 +1319,10 @@ static bool match_token
     lexeme = m2c_lexer_lookahead_lexeme(p->lexer);
     lexstr = intstr_char_ptr(lexeme);
     
-    /* report error */
-    m2c_emit_syntax_error_w_token
-      (line, column, lookahead, lexstr, expected_token);
-    
-    /* print source line */
-    if (m2c_option_verbose()) {
-      m2c_print_line_and_mark_column(p->lexer, line, column);
+    /* report error unless past the error limit */
+    if (syntax_error_reportable(p)) {
+      m2c_emit_syntax_error_w_token
+        (line, column, lookahead, lexstr, expected_token);
     } /* end if */
     
     /* update error count */
@@ -349,13 +1361,10 @@ static bool match_ident
     column = m2c_lexer_lookahead_column(p->lexer);
     lexstr = intstr_char_ptr(lexeme);
     
-    /* report error */
-    m2c_emit_syntax_error_w_lexeme
-      (line, column, lookahead, lexstr, expected_lexeme);
-    
-    /* print source line */
-    if (m2c_option_verbose()) {
-      m2c_print_line_and_mark_column(p->lexer, line, column);
+    /* report error unless past the error limit */
+    if (syntax_error_reportable(p)) {
+      m2c_emit_syntax_error_w_lexeme
+        (line, column, lookahead, lexstr, expected_lexeme);
     } /* end if */
     
     /* update error count */
@@ -395,13 +1404,10 @@ static bool match_set
     lexeme = m2c_lexer_lookahead_lexeme(p->lexer);
     lexstr = intstr_char_ptr(lexeme);
     
-    /* report error */
-    m2c_emit_syntax_error_w_set
-      (line, column, lookahead, lexstr, expected_set);
-    
-    /* print source line */
-    if (m2c_option_verbose()) {
-      m2c_print_line_and_mark_column(p->lexer, line, column);
+    /* report error unless past the error limit */
+    if (syntax_error_reportable(p)) {
+      m2c_emit_syntax_error_w_set
+        (line, column, lookahead, lexstr, expected_set);
     } /* end if */
         
     /* update error count */
@@ -412,22 +1418,71 @@ static bool match_set
 } /* end match_set */
 
 
+/* --------------------------------------------------------------------------
+ * private function skip_done(p, lookahead, at_target, skipped)
+ * --------------------------------------------------------------------------
+ * Returns true if a resync that has consumed skipped symbols  should stop at
+ * symbol lookahead,  where at_target indicates whether lookahead is one of
+ * the symbols sought.  A resync always stops at the end of the file.
+ *
+ * (1) normal mode:
+ *
+ * Stops at the symbols sought  or after M2C_MAX_SKIPPED_SYMBOLS symbols,
+ * thus the cost of recovering from any single error is bounded.
+ *
+ * (2) panic mode:
+ *
+ * Ignores the symbols sought  and stops only at the start of the next
+ * declaration or block,  thus the pending productions unwind without
+ * consuming further symbols until parsing resumes at that declaration.
+ * ----------------------------------------------------------------------- */
+
+static bool skip_done
+  (m2c_parser_context_t p,
+   m2c_token_t lookahead, bool at_target, uint_t skipped) {
+  
+  if (lookahead == TOKEN_EOF) {
+    return true;
+  } /* end if */
+  
+  if (p->panic_mode) {
+    switch (lookahead) {
+      case TOKEN_CONST :
+      case TOKEN_TYPE :
+      case TOKEN_VAR :
+      case TOKEN_PROCEDURE :
+      case TOKEN_BEGIN :
+      case TOKEN_END :
+        return true;
+      
+      default :
+        return false;
+    } /* end switch */
+  } /* end if */
+  
+  return (at_target || (skipped >= M2C_MAX_SKIPPED_SYMBOLS));
+} /* end skip_done */
+
+
 /* --------------------------------------------------------------------------
  * private function skip_to_token(p, token);
  * --------------------------------------------------------------------------
- * Consumes symbols  until the lookahead symbol  matches  token target_token.
- * Returns the new lookahead symbol.
+ * Consumes symbols  until the lookahead symbol  matches  token target_token
+ * or function skip_done ends the resync.  Returns the new lookahead symbol.
  * ----------------------------------------------------------------------- */
 
 static m2c_token_t skip_to_token
   (m2c_parser_context_t p, m2c_token_t target_token) {
   
   m2c_token_t lookahead;
+  uint_t skipped;
   
   lookahead = m2c_next_sym(p->lexer);
+  skipped = 0;
   
-  while (lookahead != target_token) {
+  while (NOT(skip_done(p, lookahead, (lookahead == target_token), skipped))) {
     lookahead = m2c_consume_sym(p->lexer);
+    skipped++;
   } /* end while */
   
   return lookahead;
@@ -438,18 +1493,23 @@ static m2c_token_t skip_to_token
  * private function skip_to_set(p, set);
  * --------------------------------------------------------------------------
  * Consumes symbols until the lookahead symbol  matches  any token within set
- * target_set.  Returns the new lookahead symbol.
+ * target_set  or function skip_done ends the resync.  Returns the new
+ * lookahead symbol.
  * ----------------------------------------------------------------------- */
 
 static m2c_token_t skip_to_set
   (m2c_parser_context_t p, m2c_tokenset_t target_set) {
   
   m2c_token_t lookahead;
+  uint_t skipped;
   
   lookahead = m2c_next_sym(p->lexer);
+  skipped = 0;
   
-  while (m2c_tokenset_member(target_set, lookahead) == false) {
+  while (NOT(skip_done(p, lookahead,
+    m2c_tokenset_element(target_set, lookahead), skipped))) {
     lookahead = m2c_consume_sym(p->lexer);
+    skipped++;
   } /* end while */
   
   return lookahead;
@@ -460,7 +1520,10 @@ static m2c_token_t skip_to_set
  * private function skip_to_token_or_set(p, token, set);
  * --------------------------------------------------------------------------
  * Consumes symbols  until the lookahead symbol matches token target_token or
- * any token within set target_set.  Returns the new lookahead symbol.
+ * any token within set target_set  or function skip_done ends the resync.
+ * Returns the new lookahead symbol.  Where both are known at compile time,
+ * skip_to_set with a precomputed resync set is used instead,  see
+ * m2c-resync-sets.h.
  * ----------------------------------------------------------------------- */
 
 static m2c_token_t skip_to_token_or_set
@@ -468,12 +1531,15 @@ static m2c_token_t skip_to_token_or_set
    m2c_token_t target_token, m2c_tokenset_t target_set) {
   
   m2c_token_t lookahead;
+  uint_t skipped;
   
   lookahead = m2c_next_sym(p->lexer);
+  skipped = 0;
   
-  while ((lookahead != target_token)
-    && (m2c_tokenset_member(target_set, lookahead) == false)) {
+  while (NOT(skip_done(p, lookahead, ((lookahead == target_token)
+    || m2c_tokenset_element(target_set, lookahead)), skipped))) {
     lookahead = m2c_consume_sym(p->lexer);
+    skipped++;
   } /* end while */
   
   return lookahead;
@@ -484,16 +1550,19 @@ static m2c_token_t skip_to_token_or_set
  * private function skip_to_token_list(p, ...);
  * --------------------------------------------------------------------------
  * Consumes symbols  until the lookahead symbol matches any token in the list
- * of tokens passed in.  Returns the new lookahead symbol.
+ * of tokens passed in  or function skip_done ends the resync.  Returns the
+ * new lookahead symbol.
  * ----------------------------------------------------------------------- */
 
 static m2c_token_t skip_to_token_list
   (m2c_parser_context_t p, m2c_token_t first_token, ...) {
   m2c_token_t token, lookahead;
+  uint_t skipped;
   
   va_list token_list;
   
   lookahead = m2c_next_sym(p->lexer);
+  skipped = 0;
   
   while (lookahead != TOKEN_EOF) {
     va_start(token_list, first_token);
@@ -506,17 +1575,137 @@ static m2c_token_t skip_to_token_list
     
     va_end(token_list);
     
-    /* match found */
-    if (lookahead == token) {
+    /* match found or resync ended */
+    if (skip_done(p, lookahead, (lookahead == token), skipped)) {
       break;
     } /* end if */
     
-    /* skip to next symbol */
+    /* skip to next symbol */
+    lookahead = m2c_consume_sym(p->lexer);
+    skipped++;
+  } /* end while */
+    
+  return lookahead;
+} /* end skip_to_token_list */
+
+
+/* --------------------------------------------------------------------------
+ * private function key_for_digest(digest)
+ * --------------------------------------------------------------------------
+ * Returns an interned string with the hexadecimal notation of digest,  for
+ * use as the value of KEY and DECLKEY nodes.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t key_for_digest (m2c_digest_value_t digest) {
+  char key[11];
+  
+  snprintf(key, sizeof(key), "0x%08X", (unsigned int) digest);
+  
+  return intstr_for_cstr(key, NULL);
+} /* end key_for_digest */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure begin_decl(p)
+ * --------------------------------------------------------------------------
+ * Marks the start of a declaration at the lookahead symbol.  Starts a
+ * declaration digest if the declaration is at the top level.
+ * ----------------------------------------------------------------------- */
+
+static void begin_decl (m2c_parser_context_t p) {
+  
+  if (p->decl_depth == 0) {
+    m2c_lexer_begin_decl_digest(p->lexer);
+  } /* end if */
+  
+  p->decl_depth++;
+} /* end begin_decl */
+
+
+/* --------------------------------------------------------------------------
+ * private function keyed_decl(p, decl_node)
+ * --------------------------------------------------------------------------
+ * Marks the end of the declaration started by the matching begin_decl.  For
+ * a top-level declaration,  returns decl_node wrapped with the digest of its
+ * symbols,  otherwise decl_node itself.
+ *
+ * astnode: (DECL (DECLKEY 0x3A7E01C2) declNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t keyed_decl
+  (m2c_parser_context_t p, m2c_astnode_t decl_node) {
+  m2c_astnode_t key_node;
+  
+  p->decl_depth--;
+  
+  if (p->decl_depth > 0) {
+    return decl_node;
+  } /* end if */
+  
+  key_node = m2c_ast_new_terminal_node(AST_DECLKEY,
+    key_for_digest(m2c_lexer_end_decl_digest(p->lexer)));
+  
+  return m2c_ast_new_node2(AST_DECL, key_node, decl_node);
+} /* end keyed_decl */
+
+
+/* --------------------------------------------------------------------------
+ * private function skip_body(p)
+ * --------------------------------------------------------------------------
+ * Skips the statement sequence  starting at the lookahead symbol  up to but
+ * not including the END that closes it,  tracking the nesting of statements
+ * that are closed by END.  Passes a LAZYBODY node  with the symbol index of
+ * the first symbol and the number of skipped symbols back in p->ast.
+ *
+ * astnode: (LAZYBODY "1234" "56")
+ * ----------------------------------------------------------------------- */
+
+static m2c_token_t skip_body (m2c_parser_context_t p) {
+  m2c_token_t lookahead;
+  m2c_fifo_t value_list;
+  uint_t first, depth;
+  char index[12];
+  
+  first = m2c_lexer_symbol_index(p->lexer);
+  lookahead = m2c_next_sym(p->lexer);
+  depth = 0;
+  
+  while ((lookahead != TOKEN_EOF) &&
+         ((lookahead != TOKEN_END) || (depth > 0))) {
+    switch (lookahead) {
+      case TOKEN_CASE :
+      case TOKEN_FOR :
+      case TOKEN_IF :
+      case TOKEN_LOOP :
+      case TOKEN_WHILE :
+        depth++;
+        break;
+      
+      case TOKEN_END :
+        depth--;
+        break;
+      
+      default :
+        break;
+    } /* end switch */
+    
     lookahead = m2c_consume_sym(p->lexer);
   } /* end while */
-    
+  
+  value_list = m2c_fifo_new_queue(NULL);
+  
+  snprintf(index, sizeof(index), "%u", (unsigned int) first);
+  m2c_fifo_enqueue(value_list, intstr_for_cstr(index, NULL));
+  
+  snprintf(index, sizeof(index), "%u",
+    (unsigned int) (m2c_lexer_symbol_index(p->lexer) - first));
+  m2c_fifo_enqueue(value_list, intstr_for_cstr(index, NULL));
+  
+  p->ast = m2c_ast_new_terminal_list_node(AST_LAZYBODY, value_list);
+  m2c_fifo_release(value_list);
+  
   return lookahead;
-} /* end skip_to_token_list */
+} /* end skip_body */
 
 
 /* ************************************************************************ *
@@ -529,6 +1718,9 @@ static m2c_token_t skip_to_token_list
  * startSymbol = compilationUnit ;
  *
  * astnode: (FILE (FNAME "Foobar.mod") (KEY 0xF04FC729) moduleNode)
+ *
+ * In header only mode,  the module node holds the module identifier and the
+ * import list only  and the key is that of the symbols up to the last import.
  * ----------------------------------------------------------------------- */
 
 static void parse_start_symbol (m2c_parser_context_t p) {
@@ -540,7 +1732,8 @@ static void parse_start_symbol (m2c_parser_context_t p) {
   lookahead = compilation_unit(p);
   module_node = p->ast;
   
-  if (lookahead != TOKEN_EOF) {
+  /* in header only mode the rest of the file is not read */
+  if ((lookahead != TOKEN_EOF) && (p->header_only == false)) {
     /* TO DO: report error -- symbols after end of compilation unit */
     m2c_stats_inc(p->stats, M2C_STATS_SYNTAX_ERROR_COUNT);
     skip_to_token(p, TOKEN_EOF);
@@ -551,11 +1744,12 @@ static void parse_start_symbol (m2c_parser_context_t p) {
   filename_node = m2c_ast_new_terminal_node(AST_FNAME, filename);
   
   /* module-key node */
-  key_node = m2c_ast_new_terminal_node(AST_KEY, m2c_lexer_digest(p->lexer));
+  key_node = m2c_ast_new_terminal_node(AST_KEY,
+    key_for_digest(m2c_lexer_digest(p->lexer)));
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_FILE,
-    filename_node, key_node, module_node, NULL);
+  p->ast = m2c_ast_new_node3(AST_FILE,
+    filename_node, key_node, module_node);
   
   return;
 } /* end parse_start_symbol */
@@ -575,6 +1769,7 @@ static m2c_token_t compilation_unit (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("compilationUnit");
+  PARSER_PROFILE_ENTER("compilationUnit");
   
   m2c_token_t lookahead = m2c_next_sym(p->lexer);
   
@@ -610,6 +1805,7 @@ static m2c_token_t compilation_unit (m2c_parser_context_t p) {
       break;
   } /* end switch */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end compilation_unit */
 
@@ -639,7 +1835,8 @@ static m2c_token_t module_header (m2c_parser_context_t p) {
     
     p->module_ident = m2c_lexer_current_lexeme(p->lexer);
     
-    if (p->module_ident != intstr_for_cstr(p->basename)) {
+    if (p->module_ident !=
+        intstr_for_slice(p->filename, 0, p->basename_length, NULL)) {
       /* TO DO: report error -- module identifier does not match filename */
       m2c_stats_inc(p->stats, M2C_STATS_SEMANTIC_ERROR_COUNT);
     } /* end if */
@@ -650,7 +1847,7 @@ static m2c_token_t module_header (m2c_parser_context_t p) {
     } /* end if */
   }
   else /* resync */ {
-    lookahead = skipt_to_token_or_set(p, TOKEN_SEMICOLON, FIRST(IMPORT));
+    lookahead = skip_to_set(p, RESYNC(SEMICOLON_OR_FIRST_IMPORT));
     id_node = m2c_ast_empty_node();
   } /* end if */
   
@@ -659,7 +1856,7 @@ static m2c_token_t module_header (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skipt_token_or_set(p, TOKEN_IMPORT, FOLLOW(IMPORT));
+    lookahead = skip_to_set(p, RESYNC(IMPORT_OR_FOLLOW_IMPORT));
   } /* end if */
   
   /* pass AST node back in p->ast */
@@ -700,6 +1897,7 @@ static m2c_token_t interface_module (m2c_parser_context_t p) {
   m2c_astnode_t id_node, imp_node, dd_node;
   
   PARSER_DEBUG_INFO("interfaceModule");
+  PARSER_PROFILE_ENTER("interfaceModule");
   
   /* INTERFACE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -722,6 +1920,17 @@ static m2c_token_t interface_module (m2c_parser_context_t p) {
     m2c_fifo_enqueue(imp_list, p->ast);
   } /* end while */
   
+  /* header only: stop after the last import */
+  if (p->header_only) {
+    imp_node = m2c_ast_new_term_list_node(AST_IMPORT, imp_list);
+    p->ast = m2c_ast_new_node3(AST_INTERFACE,
+      id_node, imp_node, m2c_ast_empty_node());
+    m2c_fifo_release(imp_list);
+    
+    PARSER_PROFILE_EXIT();
+    return lookahead;
+  } /* end if */
+  
   dd_list = m2c_fifo_new_queue(NULL);
   
   /* declaration* */
@@ -764,11 +1973,12 @@ static m2c_token_t interface_module (m2c_parser_context_t p) {
   imp_node = m2c_ast_new_term_list_node(AST_IMPORT, imp_list);
   dd_node = m2c_ast_new_term_list_node(AST_DECL, dd_list);
   
-  p->ast = m2c_ast_new_node(AST_INTERFACE, id_node, imp_node, dd_node, NULL);
+  p->ast = m2c_ast_new_node3(AST_INTERFACE, id_node, imp_node, dd_node);
   
   m2c_fifo_release(imp_list);
   m2c_fifo_release(dd_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end interface_module */
 
@@ -792,6 +2002,7 @@ static m2c_token_t import (m2c_parser_context_t p) {
   m2c_fifo_t imp_list, rxp_list;
   
   PARSER_DEBUG_INFO("import");
+  PARSER_PROFILE_ENTER("import");
   
   /* IMPORT */
   lookahead = m2c_consume_sym(p->lexer);
@@ -859,7 +2070,7 @@ static m2c_token_t import (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */
-    lookahead = skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(IMPORT));
+    lookahead = skip_to_set(p, RESYNC(SEMICOLON_OR_FOLLOW_IMPORT));
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
@@ -868,6 +2079,7 @@ static m2c_token_t import (m2c_parser_context_t p) {
   m2c_fifo_release_queue(imp_list);
   m2c_fifo_release_queue(rxp_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end import */
 
@@ -906,6 +2118,7 @@ m2c_token_t declaration (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("declaration");
+  PARSER_PROFILE_ENTER("declaration");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -931,7 +2144,9 @@ m2c_token_t declaration (m2c_parser_context_t p) {
       
     /* | procDeclaration */
     case TOKEN_PROCEDURE :
+      begin_decl(p);
       lookahead = proc_declaration(p); /* p->ast holds ast-node */
+      p->ast = keyed_decl(p, p->ast);
       
       /* ';' */
       if (match_token(p, TOKEN_SEMICOLON)) {
@@ -962,6 +2177,7 @@ m2c_token_t declaration (m2c_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end declaration */
 
@@ -996,6 +2212,9 @@ m2c_token_t declaration (m2c_parser_context_t p) {
  *   ;
  *
  * astnode: (VARDEFLIST varDefnNode1 varDefnNode2 ... varDefnNodeN)
+ *
+ * At the top level,  each definition node is wrapped by function keyed_decl
+ * in a DECL node holding the digest of the symbols of the definition.
  * ----------------------------------------------------------------------- */
 
 static m2c_token_t definition_list
@@ -1010,8 +2229,9 @@ static m2c_token_t definition_list
   
   /* const/type/varDefinition */
   if (match_token(p, TOKEN_IDENT)) {
+    begin_decl(p);
     lookahead = context->parse_defn(p);
-    m2c_fifo_enqueue(node_list, p->ast);
+    m2c_fifo_enqueue(node_list, keyed_decl(p, p->ast));
       
     /* ';' */
     if (match_token(p, TOKEN_SEMICOLON)) {
@@ -1020,19 +2240,20 @@ static m2c_token_t definition_list
     else /* resync */ {
       lookahead =
         skip_to_token_or_set
-          (p, TOKEN_SEMICOLON, FOLLOW(context->production));
+          (p, TOKEN_SEMICOLON, m2c_follow_set(context->production));
     } /* end if */
   }
   else /* resync */ {
-    lookahead = skip_to_set(p, FOLLOW(context->production));
+    lookahead = skip_to_set(p, m2c_follow_set(context->production));
   } /* end if */
   
   /* (const/type/varDefinition ';')* */
   
   /* const/type/varDefinition */
   while (match_token(p, TOKEN_IDENT)) {
+    begin_decl(p);
     lookahead = context->parse_defn(p); /* p-ast holds ast-node */
-    m2c_fifo_enqueue(node_list, p->ast);
+    m2c_fifo_enqueue(node_list, keyed_decl(p, p->ast));
     
     /* ';' */
     if (match_token == TOKEN_SEMICOLON) {
@@ -1040,7 +2261,8 @@ static m2c_token_t definition_list
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(context->production));
+        skip_to_token_or_set
+          (p, TOKEN_SEMICOLON, m2c_follow_set(context->production));
     } /* end if */
   } /* end while */
   
@@ -1086,6 +2308,7 @@ static m2c_token_t const_definition (m2c_parser_context_t p) {
   m2c_astnode_t bind_node, const_id, type_id, expr_node;
     
   PARSER_DEBUG_INFO("constDefinition");
+  PARSER_PROFILE_ENTER("constDefinition");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -1120,7 +2343,7 @@ static m2c_token_t const_definition (m2c_parser_context_t p) {
       type_id = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_EQUAL, FIRST(EXPRESSION));
+      lookahead = skip_to_set(p, RESYNC(EQUAL_OR_FIRST_EXPRESSION));
       type_id = NULL;
     } /* end if */
   } /* end if */
@@ -1131,7 +2354,7 @@ static m2c_token_t const_definition (m2c_parser_context_t p) {
   }
   else /* resync */ {
     lookahead =
-      skip_to_set_or_set(p, FIRST(EXPRESSION), FOLLOW(CONST_DEFINITION));
+      skip_to_set(p, RESYNC(FIRST_EXPRESSION_OR_FOLLOW_CONST_DEFINITION));
   } /* end if */
   
   /* constExpression */
@@ -1149,6 +2372,7 @@ static m2c_token_t const_definition (m2c_parser_context_t p) {
     m2c_ast_new_node
       (AST_CONST, bind_node, const_id, type_id, expr_node, NULL);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end const_definition */
 
@@ -1169,6 +2393,7 @@ static m2c_token_t const_binding (m2c_parser_context_t p) {
   m2c_astnode_t bind_node;
     
   PARSER_DEBUG_INFO("constBinding");
+  PARSER_PROFILE_ENTER("constBinding");
       
   /* '[' */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1200,12 +2425,13 @@ static m2c_token_t const_binding (m2c_parser_context_t p) {
   }
   else /* resync */ {
     lookahead =
-      skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(CONST_DEFINITION));
+      skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_CONST_DEFINITION));
   } /* end if */
   
   /* pass AST node back in p->ast */
   p->ast = bind_node;
 
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end const_binding */
 
@@ -1223,6 +2449,7 @@ static m2c_token_t ident (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("ident");
+  PARSER_PROFILE_ENTER("ident");
   
   lookahead = m2c_consume_sym(p->lexer);
   lexeme = m2c_current_lexeme(p->lexer);
@@ -1230,6 +2457,7 @@ static m2c_token_t ident (m2c_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2c_ast_new_terminal_node(IDENT, lexeme);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end ident */
 
@@ -1250,6 +2478,7 @@ static m2c_token_t qualident (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("qualident");
+  PARSER_PROFILE_ENTER("qualident");
   
   /* Ident */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1284,6 +2513,7 @@ static m2c_token_t qualident (m2c_parser_context_t p) {
   
   m2c_fifo_release(lex_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end qualident */
 
@@ -1333,6 +2563,7 @@ static m2c_token_t type_definition (m2c_parser_context_t p) {
   m2c_astnode_t ident_node, type_node;
     
   PARSER_DEBUG_INFO("typeDefinition");
+  PARSER_PROFILE_ENTER("typeDefinition");
   
   /* FIRST(interfaceType) | FIRST(implementationType) | FIRST(programType) */
   switch (p->module_context) {
@@ -1358,7 +2589,7 @@ static m2c_token_t type_definition (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_set(p, FIRST(first_set));
+    lookahead = skip_to_set(p, first_set);
   } /* end if */
   
   /* type */
@@ -1372,8 +2603,9 @@ static m2c_token_t type_definition (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_TYPEDEF, ident_node, type_node);
+  p->ast = m2c_ast_new_node2(AST_TYPEDEF, ident_node, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end type_definition */
 
@@ -1425,6 +2657,7 @@ static m2c_token_t type (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("type");
+  PARSER_PROFILE_ENTER("type");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -1498,6 +2731,7 @@ static m2c_token_t type (m2c_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end type */
 
@@ -1517,6 +2751,7 @@ static m2c_token_t alias_type (m2c_parser_context_t p) {
   m2c_ast_node_t type_node;
   
   PARSER_DEBUG_INFO("aliasType");
+  PARSER_PROFILE_ENTER("aliasType");
   
   /* ALIAS */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1536,12 +2771,13 @@ static m2c_token_t alias_type (m2c_parser_context_t p) {
   }
   else /* resync */ {
     lookahead =
-      skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(TYPE_DEFINITION));
+      skip_to_set(p, RESYNC(SEMICOLON_OR_FOLLOW_TYPE_DEFINITION));
   } /* end if */
   
   /* build AST node and pass back in p->ast */
-  p->ast = m2c_ast_new_node(AST_ALIAS, type_node);
+  p->ast = m2c_ast_new_node1(AST_ALIAS, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end alias_type */
 
@@ -1564,6 +2800,7 @@ static m2c_token_t subrange_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node, lower_bound, upper_bound;
   
   PARSER_DEBUG_INFO("subrangeType");
+  PARSER_PROFILE_ENTER("subrangeType");
   
   /* constRange */
   lookahead = value_range(p);
@@ -1574,7 +2811,7 @@ static m2c_token_t subrange_type (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(SUBRANGE_TYPE));
+    lookahead = skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_SUBRANGE_TYPE));
   } /* end if */
   
   /* countableType */
@@ -1586,8 +2823,9 @@ static m2c_token_t subrange_type (m2c_parser_context_t p) {
   } /* end if */
     
   /* build AST node and pass back in p->ast */
-  p->ast = m2c_ast_new_node(AST_SUBR, type_node, range_node);
+  p->ast = m2c_ast_new_node2(AST_SUBR, type_node, range_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end subrange_type */
 
@@ -1610,6 +2848,7 @@ static m2c_token_t value_range (m2c_parser_context_t p) {
   m2c_astnode_t lower_bound, upper_bound;
   
   PARSER_DEBUG_INFO("valueRange");
+  PARSER_PROFILE_ENTER("valueRange");
   
   /* '[' */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1620,7 +2859,7 @@ static m2c_token_t value_range (m2c_parser_context_t p) {
     lower_bound = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_DOT_DOT, FIRST(EXPRESSION));
+    lookahead = skip_to_set(p, RESYNC(DOT_DOT_OR_FIRST_EXPRESSION));
     lower_bound = m2c_ast_empty_node();
   } /* end if */
   
@@ -1638,7 +2877,7 @@ static m2c_token_t value_range (m2c_parser_context_t p) {
     upper_bound = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_RBRACKET, FOLLOW(VALUE_RANGE));
+    lookahead = skip_to_set(p, RESYNC(RBRACKET_OR_FOLLOW_VALUE_RANGE));
     upper_bound = m2c_ast_empty_node();
   } /* end if */
   
@@ -1647,12 +2886,13 @@ static m2c_token_t value_range (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, FOLLOW(VALUE_RANGE));
+    lookahead = skip_to_set(p, FOLLOW(VALUE_RANGE));
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_RANGE, lower_bound, upper_bound, NULL);
+  p->ast = m2c_ast_new_node2(AST_RANGE, lower_bound, upper_bound);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end value_range */
 
@@ -1678,6 +2918,7 @@ static m2c_token_t enum_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node, list_node;
   
   PARSER_DEBUG_INFO("enumType");
+  PARSER_PROFILE_ENTER("enumType");
   
   /* '(' */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1715,7 +2956,7 @@ static m2c_token_t enum_type (m2c_parser_context_t p) {
     list_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_RPAREN, FOLLOW(ENUM_TYPE));
+    lookahead = skip_to_set(p, RESYNC(RPAREN_OR_FOLLOW_ENUM_TYPE));
   } /* end if */
   
   /* ')' */
@@ -1727,8 +2968,9 @@ static m2c_token_t enum_type (m2c_parser_context_t p) {
   } /* end if */
     
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_ENUM, type_node, list_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_ENUM, type_node, list_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end enum_type */
 
@@ -1750,6 +2992,7 @@ static m2c_token_t ident_list (m2c_parser_context_t p) {
   unsigned short line, column;
   
   PARSER_DEBUG_INFO("identList");
+  PARSER_PROFILE_ENTER("identList");
   
   /* Ident */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1782,7 +3025,7 @@ static m2c_token_t ident_list (m2c_parser_context_t p) {
       } /* end if */
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_COMMA, FOLLOW(IDENT_LIST));
+      lookahead = skip_to_set(p, RESYNC(COMMA_OR_FOLLOW_IDENT_LIST));
     } /* end if */
   } /* end while */
   
@@ -1791,6 +3034,7 @@ static m2c_token_t ident_list (m2c_parser_context_t p) {
   
   m2c_fifo_release_queue(tmp_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end ident_list */
 
@@ -1812,6 +3056,7 @@ static m2c_token_t set_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node;
   
   PARSER_DEBUG_INFO("setType");
+  PARSER_PROFILE_ENTER("setType");
   
   /* SET */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1821,7 +3066,7 @@ static m2c_token_t set_type (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(SET_TYPE));
+    lookahead = skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_SET_TYPE));
   } /* end if */
   
   /* enumTypeIdent */
@@ -1835,8 +3080,9 @@ static m2c_token_t set_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_SET, type_node);
+  p->ast = m2c_ast_new_node1(AST_SET, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end set_type */
 
@@ -1858,6 +3104,7 @@ static m2c_token_t array_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node, value_node;
   
   PARSER_DEBUG_INFO("arrayType");
+  PARSER_PROFILE_ENTER("arrayType");
   
   /* ARRAY */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1877,7 +3124,7 @@ static m2c_token_t array_type (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(ARRAY_TYPE));
+    lookahead = skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_ARRAY_TYPE));
   } /* end if */
   
   /* typeIdent */
@@ -1891,8 +3138,9 @@ static m2c_token_t array_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_ARRAY, type_node, value_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_ARRAY, type_node, value_node);
     
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end array_type */
 
@@ -1919,6 +3167,7 @@ static m2c_token_t record_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node, list_node;
   
   PARSER_DEBUG_INFO("recordType");
+  PARSER_PROFILE_ENTER("recordType");
   
   /* RECORD */
   lookahead = m2c_consume_sym(p->lexer);
@@ -1934,7 +3183,7 @@ static m2c_token_t record_type (m2c_parser_context_t p) {
       type_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_RPAREN, FIRST(FIELD_LIST));
+      lookahead = skip_to_set(p, RESYNC(RPAREN_OR_FIRST_FIELD_LIST));
       type_node = m2c_ast_empty_node();
     } /* end if */
     
@@ -1970,8 +3219,9 @@ static m2c_token_t record_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_RECORD, type_node, list_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_RECORD, type_node, list_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end record_type */
 
@@ -1991,6 +3241,7 @@ static m2c_token_t field_list_sequence (m2c_parser_context_t p) {
   m2c_fifo_t tmp_list;
   
   PARSER_DEBUG_INFO("fieldListSequence");
+  PARSER_PROFILE_ENTER("fieldListSequence");
   
   /* fieldList */
   lookahead = field_list(p);
@@ -2017,6 +3268,7 @@ static m2c_token_t field_list_sequence (m2c_parser_context_t p) {
   
   m2c_fifo_release(tmp_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end field_list_sequence */
 
@@ -2045,6 +3297,7 @@ static m2c_token_t pointer_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node;
   
   PARSER_DEBUG_INFO("pointerType");
+  PARSER_PROFILE_ENTER("pointerType");
   
   /* POINTER */
   lookahead = m2c_consume_sym(p->lexer);
@@ -2054,7 +3307,7 @@ static m2c_token_t pointer_type (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(POINTER_TYPE));
+    lookahead = skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_POINTER_TYPE));
   } /* end if */
   
   /* typeIdent */
@@ -2068,8 +3321,9 @@ static m2c_token_t pointer_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_POINTER, type_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_POINTER, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end pointer_type */
 
@@ -2090,6 +3344,7 @@ static m2c_token_t opaque_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node;
   
   PARSER_DEBUG_INFO("opaqueType");
+  PARSER_PROFILE_ENTER("opaqueType");
   
   /* OPAQUE */
   lookahead = m2c_consume_sym(p);
@@ -2105,7 +3360,7 @@ static m2c_token_t opaque_type (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_RBRACKET, FOLLOW(TYPE_DEFINITION));
+        skip_to_set(p, RESYNC(RBRACKET_OR_FOLLOW_TYPE_DEFINITION));
         size_node = m2c_ast_empty_node();
     } /* end if */
   
@@ -2118,8 +3373,9 @@ static m2c_token_t opaque_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_OPAQUE, size_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_OPAQUE, size_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end pointer_type */
 
@@ -2144,6 +3400,7 @@ static m2c_token_t procedure_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node, list_node;
   
   PARSER_DEBUG_INFO("procedureType");
+  PARSER_PROFILE_ENTER("procedureType");
   
   /* PROCEDURE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -2196,8 +3453,9 @@ static m2c_token_t procedure_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_PROCTYPE, type_node, list_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_PROCTYPE, type_node, list_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end procedure_type */
 
@@ -2217,6 +3475,7 @@ static m2c_token_t formal_type (m2c_parser_context_t p) {
   m2c_fifo_t tmp_list;
   
   PARSER_DEBUG_INFO("formalTypeList");
+  PARSER_PROFILE_ENTER("formalTypeList");
   
   /* formalType */
   lookahead = formal_type(p);
@@ -2239,6 +3498,7 @@ static m2c_token_t formal_type (m2c_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2c_ast_new_node(AST_FTYPELIST, tmp_list, NULL);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end formal_type */
 
@@ -2260,6 +3520,7 @@ static m2c_token_t formal_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node;
   
   PARSER_DEBUG_INFO("formalType");
+  PARSER_PROFILE_ENTER("formalType");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -2289,8 +3550,9 @@ static m2c_token_t formal_type (m2c_parser_context_t p) {
   } /* end if */
     
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(node_type, type_node, NULL);
+  p->ast = m2c_ast_new_node1(node_type, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end formal_type */
 
@@ -2309,6 +3571,7 @@ static m2c_token_t non_attr_formal_type (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("nonAttrFormalType");
+  PARSER_PROFILE_ENTER("nonAttrFormalType");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -2340,11 +3603,13 @@ static m2c_token_t non_attr_formal_type (m2c_parser_context_t p) {
     
     default :
     /* fatal error -- abort */
+    PARSER_PROFILE_EXIT();
     return (-1);
   } /* end switch */
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end non_attr_formal_type */
 
@@ -2366,6 +3631,7 @@ static m2c_token_t simple_formal_type (m2c_parser_context_t p) {
   bool open_array;
   
   PARSER_DEBUG_INFO("simpleFormalType");
+  PARSER_PROFILE_ENTER("simpleFormalType");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -2381,7 +3647,7 @@ static m2c_token_t simple_formal_type (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(SIMPLE_FORMAL_TYPE));
+        skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_SIMPLE_FORMAL_TYPE));
     } /* end if */
   }
   else /* not an open array */ {
@@ -2402,13 +3668,14 @@ static m2c_token_t simple_formal_type (m2c_parser_context_t p) {
   
   if (open_array) {
     /* astnode: (OPENARRAY identNode) */
-    p->ast = m2c_ast_new_node(AST_OPENARRAY, type_node, NULL);
+    p->ast = m2c_ast_new_node1(AST_OPENARRAY, type_node);
   }
   else {
     /* astnode: (IDENT ident) | (QUALIDENT q0 q1 q2 ... qN ident) */
     p->ast = type_node;
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end simple_formal_type */
 
@@ -2429,6 +3696,7 @@ static m2c_token_t casting_formal_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node;
   
   PARSER_DEBUG_INFO("castingFormalType");
+  PARSER_PROFILE_ENTER("castingFormalType");
   
   /* CAST */
   lookahead = m2c_consume_sym(p->lexer);
@@ -2448,13 +3716,14 @@ static m2c_token_t casting_formal_type (m2c_parser_context_t p) {
     } /* end if */
   }
   else /* resync */ {
-    lookahead = skip_to_set(p, FOLLOW(CASTING_FORMALTYPE));
+    lookahead = skip_to_set(p, FOLLOW(CASTING_FORMAL_TYPE));
     type_node = m2c_ast_empty_node();
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_CASTP, type_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_CASTP, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end casting_formal_type */
 
@@ -2475,6 +3744,7 @@ static m2c_token_t variadic_formal_type (m2c_parser_context_t p) {
   m2c_astnode_t type_node;
   
   PARSER_DEBUG_INFO("variadicFormalType");
+  PARSER_PROFILE_ENTER("variadicFormalType");
   
   /* ARGLIST */
   lookahead = m2c_consume_sym(p->lexer);
@@ -2498,8 +3768,9 @@ static m2c_token_t variadic_formal_type (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_VARGP, type_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_VARGP, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end variadic_formal_type */
 
@@ -2520,6 +3791,7 @@ static m2c_token_t var_definition (m2c_parser_context_t p) {
   m2c_astnode_t list_node, type_node;
   
   PARSER_DEBUG_INFO("varDefinition");
+  PARSER_PROFILE_ENTER("varDefinition");
   
   /* identList */
   lookahead = ident_list(p);
@@ -2545,8 +3817,9 @@ static m2c_token_t var_definition (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_VARDEF, list_node, type_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_VARDEF, list_node, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end var_definition */
 
@@ -2563,6 +3836,7 @@ static m2c_token_t anon_type (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("anonType");
+  PARSER_PROFILE_ENTER("anonType");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -2590,6 +3864,7 @@ static m2c_token_t anon_type (m2c_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end anon_type */
 
@@ -2611,6 +3886,7 @@ static m2c_token_t procedure_header (m2c_parser_context_t p) {
   m2c_astnode_t bind_node, psig_node;
   
   PARSER_DEBUG_INFO("procedureHeader");
+  PARSER_PROFILE_ENTER("procedureHeader");
   
   /* PROCEDURE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -2627,7 +3903,7 @@ static m2c_token_t procedure_header (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_RBRACKET, FIRST(PROCEDURE_SIGNATURE));
+        skip_to_set(p, RESYNC(RBRACKET_OR_FIRST_PROCEDURE_SIGNATURE));
       bind_node = m2c_ast_empty_node();
     } /* end if */
     
@@ -2654,8 +3930,9 @@ static m2c_token_t procedure_header (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_PROCDECL, bind_node, psig_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_PROCDECL, bind_node, psig_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end procedure_header */
 
@@ -2776,6 +4053,7 @@ static m2c_token_t procedure_signature (m2c_parser_context_t p) {
   m2c_astnode_t id_node, list_node, type_node;
   
   PARSER_DEBUG_INFO("procedureSignature");
+  PARSER_PROFILE_ENTER("procedureSignature");
   
   /* Ident */
   lookahead = ident(p);
@@ -2804,7 +4082,7 @@ static m2c_token_t procedure_signature (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(PROCEDURE_SIGNATURE));
+        skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_PROCEDURE_SIGNATURE));
     } /* end if */
   }
   else /* no formal parameter list */ {
@@ -2831,8 +4109,9 @@ static m2c_token_t procedure_signature (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_PSIG, id_node, list_node, type_node, NULL);
+  p->ast = m2c_ast_new_node3(AST_PSIG, id_node, list_node, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end procedure_signature */
 
@@ -2854,6 +4133,7 @@ static m2c_token_t formal_param_list (m2c_parser_context_t p) {
   m2c_fifo_t param_list;
   
   PARSER_DEBUG_INFO("formalParamList");
+  PARSER_PROFILE_ENTER("formalParamList");
   
   /* formalParams */
   lookahead = formal_params(p);
@@ -2870,7 +4150,7 @@ static m2c_token_t formal_param_list (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(FORMAL_PARAMS));
+        skip_to_set(p, RESYNC(SEMICOLON_OR_FOLLOW_FORMAL_PARAMS));
     } /* end if */
   } /* end while */
   
@@ -2879,6 +4159,7 @@ static m2c_token_t formal_param_list (m2c_parser_context_t p) {
   
   m2c_fifo_releast(param_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end formal_param_list */
 
@@ -2898,6 +4179,7 @@ static m2c_token_t formal_params (m2c_parser_context_t p) {
   m2c_astnode_t attr_node, list_node, type_node;
   
   PARSER_DEBUG_INFO("formalParams");
+  PARSER_PROFILE_ENTER("formalParams");
   
   lookahead = m2c_next_sym(p->lexer);
     
@@ -2921,7 +4203,7 @@ static m2c_token_t formal_params (m2c_parser_context_t p) {
   }
   else /* resync */ {
     lookahead =
-      skip_to_token_or_set(p, TOKEN_COLON, FIRST(NON_ATTR_FORMAL_TYPE));
+      skip_to_set(p, RESYNC(COLON_OR_FIRST_NON_ATTR_FORMAL_TYPE));
     list_node = m2c_ast_node_empty();
   } /* end if */
   
@@ -2945,8 +4227,9 @@ static m2c_token_t formal_params (m2c_parser_context_t p) {
   
   /* build AST node and pass it back in p->ast */
   p->ast =
-    m2c_ast_new_node(AST_FPARAMS, attr_node, list_node, type_node, NULL);
+    m2c_ast_new_node3(AST_FPARAMS, attr_node, list_node, type_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end formal_params */
 
@@ -2976,6 +4259,7 @@ static m2c_token_t program_module (m2c_parser_context_t p) {
   m2c_astnode_t id_node, list_node, block_node;
   
   PARSER_DEBUG_INFO("programModule");
+  PARSER_PROFILE_ENTER("programModule");
   
   /* moduleHeader */
   lookahead = module_header(p);
@@ -3006,6 +4290,15 @@ static m2c_token_t program_module (m2c_parser_context_t p) {
   
   m2c_fifo_release(imp_list);
   
+  /* header only: stop after the last import */
+  if (p->header_only) {
+    p->ast = m2c_ast_new_node3(AST_IMPMOD,
+      id_node, list_node, m2c_ast_empty_node());
+    
+    PARSER_PROFILE_EXIT();
+    return lookahead;
+  } /* end if */
+  
   /* block */
   if (match_set(p, FIRST(BLOCK))) {
     lookahead = block(p);
@@ -3044,8 +4337,9 @@ static m2c_token_t program_module (m2c_parser_context_t p) {
   } /* end if */  
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_IMPMOD, id_node, imp_node, block_node, NULL);
+  p->ast = m2c_ast_new_node3(AST_IMPMOD, id_node, imp_node, block_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end program_module */
 
@@ -3067,6 +4361,7 @@ static m2c_token_t private_import (m2c_parser_context_t p) {
   m2c_astnode_t list_node, empty_node;
   
   PARSER_DEBUG_INFO("privateImport");
+  PARSER_PROFILE_ENTER("privateImport");
   
   empty_node = m2c_ast_empty_node();
   
@@ -3084,8 +4379,9 @@ static m2c_token_t private_import (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_IMPORT, list_node, empty_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_IMPORT, list_node, empty_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end private_import */
 
@@ -3101,23 +4397,36 @@ static m2c_token_t private_import (m2c_parser_context_t p) {
  * ----------------------------------------------------------------------- */
 
 static m2c_token_t definition (m2c_parser_context_t p);
+static m2c_token_t streamed_definition (m2c_parser_context_t p);
+static m2c_token_t spanned_definition (m2c_parser_context_t p);
 static m2c_token_t statement_sequence (m2c_parser_context_t p);
 
 static m2c_token_t block (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   m2c_fifo_t defn_list;
   m2c_astnode_t list_node, sseq_node;
+  bool streaming;
   
   PARSER_DEBUG_INFO("block");
+  PARSER_PROFILE_ENTER("block");
   
   lookahead = m2c_next_sym(p->lexer);
   
   defn_list = m2c_fifo_new_queue(NULL);
+  
+  /* only definitions of the module block are streamed */
+  streaming = (p->defn_handler != NULL) && (p->block_depth == 0);
+  p->block_depth++;
     
   /* definition */
   while (m2c_tokenset_element(FIRST(DECLARATION), lookahead)) {
-    lookahead = definition(p);
-    m2c_fifo_enqueue(defn_list, p->ast);
+    if (streaming) {
+      lookahead = streamed_definition(p);
+    }
+    else /* retain */ {
+      lookahead = spanned_definition(p);
+      m2c_fifo_enqueue(defn_list, p->ast);
+    } /* end if */
   } /* end while */
   
   /* construct definition list node */
@@ -3139,7 +4448,11 @@ static m2c_token_t block (m2c_parser_context_t p) {
   } /* end if */
   
   /* statementSequence */
-  if (match_set(p, FIRST(STATEMENT_SEQUENCE))) {
+  if (p->lazy_bodies) {
+    lookahead = skip_body(p);
+    sseq_node = p->ast;
+  }
+  else if (match_set(p, FIRST(STATEMENT_SEQUENCE))) {
     lookahead = statement_sequence(p);
     sseq_node = p->ast;
   }
@@ -3148,9 +4461,12 @@ static m2c_token_t block (m2c_parser_context_t p) {
     sseq_node = m2c_ast_empty_node();
   } /* end if */
   
+  p->block_depth--;
+  
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_BLOCK, list_node, sseq_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_BLOCK, list_node, sseq_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end block */
 
@@ -3179,6 +4495,7 @@ static m2c_token_t definition (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("definition");
+  PARSER_PROFILE_ENTER("definition");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -3192,7 +4509,9 @@ static m2c_token_t definition (m2c_parser_context_t p) {
       
     /* | procedureDefinition */
     case TOKEN_PROCEDURE :
+      begin_decl(p);
       lookahead = procedure_definition(p); /* p->ast holds ast-node */
+      p->ast = keyed_decl(p, p->ast);
       
       /* ';' */
       if (match_token(p, TOKEN_SEMICOLON)) {
@@ -3249,10 +4568,72 @@ static m2c_token_t definition (m2c_parser_context_t p) {
   
   /* AST node is passed through in p->ast */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end definition */
 
 
+/* --------------------------------------------------------------------------
+ * private function streamed_definition()
+ * --------------------------------------------------------------------------
+ * Parses a definition into the scratch region of p,  passes its AST to the
+ * definition handler of p  and resets the scratch region.  The nodes of the
+ * definition are counted in p->streamed_nodes.  Passes an empty node back
+ * in p->ast.
+ * ----------------------------------------------------------------------- */
+
+static m2c_token_t streamed_definition (m2c_parser_context_t p) {
+  m2c_token_t lookahead;
+  m2c_ast_region_t module_region;
+  
+  /* build definition in scratch region */
+  module_region = m2c_ast_current_region();
+  m2c_ast_set_region(p->defn_region);
+  
+  lookahead = definition(p);
+  
+  /* emit definition, then deallocate it */
+  p->defn_handler(p->ast, p->defn_context);
+  
+  p->streamed_nodes = p->streamed_nodes +
+    m2c_ast_region_node_count(p->defn_region);
+  
+  m2c_ast_region_reset(p->defn_region);
+  m2c_ast_set_region(module_region);
+  
+  p->ast = m2c_ast_empty_node();
+  
+  return lookahead;
+} /* end streamed_definition */
+
+
+/* --------------------------------------------------------------------------
+ * private function spanned_definition()
+ * --------------------------------------------------------------------------
+ * Parses a definition  and if it is a definition of the module block and p
+ * has a span handler,  passes its AST and the lines of its first and last
+ * symbol to the handler.  Passes the AST of the definition back in p->ast.
+ * ----------------------------------------------------------------------- */
+
+static m2c_token_t spanned_definition (m2c_parser_context_t p) {
+  m2c_token_t lookahead;
+  uint_t first_line;
+  
+  if ((p->span_handler == NULL) || (p->block_depth != 1)) {
+    return definition(p);
+  } /* end if */
+  
+  first_line = m2c_lexer_lookahead_line(p->lexer);
+  
+  lookahead = definition(p);
+  
+  p->span_handler(p->ast,
+    first_line, m2c_lexer_current_line(p->lexer), p->span_context);
+  
+  return lookahead;
+} /* end spanned_definition */
+
+
 /* --------------------------------------------------------------------------
  * private function implementation_module()
  * --------------------------------------------------------------------------
@@ -3271,6 +4652,7 @@ static m2c_token_t implementation_module (m2c_parser_context_t p) {
   m2c_astnode_t id_node, imp_node, block_node;
   
   PARSER_DEBUG_INFO("implementationModule");
+  PARSER_PROFILE_ENTER("implementationModule");
   
   /* IMPLEMENTATION */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3310,6 +4692,15 @@ static m2c_token_t implementation_module (m2c_parser_context_t p) {
   
   m2c_fifo_release(imp_list);
   
+  /* header only: stop after the last import */
+  if (p->header_only) {
+    p->ast = m2c_ast_new_node3(AST_IMPMOD,
+      id_node, imp_node, m2c_ast_empty_node());
+    
+    PARSER_PROFILE_EXIT();
+    return lookahead;
+  } /* end if */
+  
   /* privateBlock */
   if (match_set(p, FIRST(BLOCK))) {
     lookahead = private_block(p);
@@ -3348,8 +4739,9 @@ static m2c_token_t implementation_module (m2c_parser_context_t p) {
   } /* end if */  
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_IMPMOD, id_node, imp_node, block_node, NULL);
+  p->ast = m2c_ast_new_node3(AST_IMPMOD, id_node, imp_node, block_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end implementation_module */
 
@@ -3367,18 +4759,29 @@ static m2c_token_t private_block (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   m2c_fifo_t defn_list;
   m2c_astnode_t list_node, sseq_node, empty_node;
+  bool streaming;
   
   PARSER_DEBUG_INFO("privateBlock");
+  PARSER_PROFILE_ENTER("privateBlock");
   
   lookahead = m2c_next_sym(p->lexer);
   
   empty_node = m2c_ast_empty_node();
   defn_list = m2c_fifo_new_queue(NULL);
+  
+  /* nested blocks of procedure definitions are not streamed */
+  streaming = (p->defn_handler != NULL) && (p->block_depth == 0);
+  p->block_depth++;
     
   /* privateDefinition */
   while (m2c_tokenset_element(FIRST(DEFINITION), lookahead)) {
-    lookahead = definition(p);
-    m2c_fifo_enqueue(defn_list, p->ast);
+    if (streaming) {
+      lookahead = streamed_definition(p);
+    }
+    else /* retain */ {
+      lookahead = spanned_definition(p);
+      m2c_fifo_enqueue(defn_list, p->ast);
+    } /* end if */
   } /* end while */
   
   /* construct definition list node */
@@ -3397,7 +4800,11 @@ static m2c_token_t private_block (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
     
     /* statementSequence */
-    if (match_set(p, FIRST(STATEMENT_SEQUENCE))) {
+    if (p->lazy_bodies) {
+      lookahead = skip_body(p);
+      sseq_node = p->ast;
+    }
+    else if (match_set(p, FIRST(STATEMENT_SEQUENCE))) {
       lookahead = statement_sequence(p);
       sseq_node = p->ast;
     }
@@ -3410,13 +4817,17 @@ static m2c_token_t private_block (m2c_parser_context_t p) {
     sseq_node = m2c_ast_empty_node();
   } /* end if */
   
-  if ((list_node == empty_node) && (sseq_node == empty_node)) {
+  p->block_depth--;
+  
+  if ((list_node == empty_node) && (sseq_node == empty_node) &&
+      (streaming == false)) {
     /* TO DO: issue warning -- empty implementation module */
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_BLOCK, list_node, sseq_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_BLOCK, list_node, sseq_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end private_block */
 
@@ -3437,6 +4848,7 @@ static m2c_token_t private_pointer_type (m2c_parser_context_t p) {
   m2c_astnode_t tgt_node;
     
   PARSER_DEBUG_INFO("privatePointerType");
+  PARSER_PROFILE_ENTER("privatePointerType");
   
   /* POINTER */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3476,6 +4888,7 @@ static m2c_token_t private_pointer_type (m2c_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2c_ast_new_node(PRIVPTR tgt_node, NULL);
    
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end private_pointer_type */
 
@@ -3496,6 +4909,7 @@ static m2c_token_t procedure_definition (m2c_parser_context_t p) {
   m2c_astnode_t decl_node, block_node;
   
   PARSER_DEBUG_INFO("procedureDefinition");
+  PARSER_PROFILE_ENTER("procedureDefinition");
   
   /* procedureHeader */
   lookahead = procedure_header(p);
@@ -3515,7 +4929,7 @@ static m2c_token_t procedure_definition (m2c_parser_context_t p) {
     block_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_IDENT, FOLLOW(DEFINITION));
+    lookahead = skip_to_set(p, RESYNC(IDENT_OR_FOLLOW_DEFINITION));
     block_node = m2c_ast_empty_node();
   } /* end if */
       
@@ -3531,8 +4945,9 @@ static m2c_token_t procedure_definition (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_PROC, decl_node, block_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_PROC, decl_node, block_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end procedure_definition */
 
@@ -3554,6 +4969,7 @@ static m2c_token_t statement_sequence (m2c_parser_context_t p) {
   m2c_fifo_t stmt_list;
   
   PARSER_DEBUG_INFO("statementSequence");
+  PARSER_PROFILE_ENTER("statementSequence");
   
   /* statement */
   lookahead = statement(p);
@@ -3571,7 +4987,7 @@ static m2c_token_t statement_sequence (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(STATEMENT));
+        skip_to_set(p, RESYNC(SEMICOLON_OR_FOLLOW_STATEMENT));
     } /* end if */
   } /* end while */
   
@@ -3580,6 +4996,7 @@ static m2c_token_t statement_sequence (m2c_parser_context_t p) {
   
   m2c_fifo_release(stmt_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end statement_sequence */
 
@@ -3614,6 +5031,7 @@ static m2c_token_t statement (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("statement");
+  PARSER_PROFILE_ENTER("statement");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -3711,6 +5129,7 @@ static m2c_token_t statement (m2c_parser_context_t p) {
       exit(-1);
     } /* end switch */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end statement */
 
@@ -3735,6 +5154,7 @@ static m2c_token_t new_statement (m2c_parser_context_t p) {
   m2c_astnode_t id_node, init_node, capv_node;
   
   PARSER_DEBUG_INFO("newStatement");
+  PARSER_PROFILE_ENTER("newStatement");
   
   /* NEW */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3763,10 +5183,10 @@ static m2c_token_t new_statement (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(STATEMENT));
+        skip_to_set(p, RESYNC(SEMICOLON_OR_FOLLOW_STATEMENT));
       init_node = m2c_ast_empty_node();
     } /* end if */
-    p->ast = m2c_ast_new_node(AST_NEWINIT, id_node, init_node, NULL);
+    p->ast = m2c_ast_new_node2(AST_NEWINIT, id_node, init_node);
   }
   else if ((lookahead == TOKEN_IDENT) 
     && (lexeme == m2c_lexeme_for_schroed(SCHROED_CAPACITY))) {
@@ -3780,15 +5200,16 @@ static m2c_token_t new_statement (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_SEMICOLON, FOLLOW(STATEMENT));
+        skip_to_set(p, RESYNC(SEMICOLON_OR_FOLLOW_STATEMENT));
       capv_node = m2c_ast_empty_node();
     } /* end if */
-    p->ast = m2c_ast_new_node(AST_NEWCAP, id_node, capv_node, NULL);
+    p->ast = m2c_ast_new_node2(AST_NEWCAP, id_node, capv_node);
   }
   else /* no parameters */ {
-    p->ast = m2c_ast_new_node(AST_NEW, id_node, NULL);
+    p->ast = m2c_ast_new_node1(AST_NEW, id_node);
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end new_statement */
 
@@ -3810,6 +5231,7 @@ static m2c_token_t retain_statement (m2c_parser_context_t p) {
   m2c_astnode_t id_node;
   
   PARSER_DEBUG_INFO("retainStatement");
+  PARSER_PROFILE_ENTER("retainStatement");
   
   /* RETAIN */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3824,8 +5246,9 @@ static m2c_token_t retain_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_RETAIN, id_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_RETAIN, id_node);
       
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end retain_statement */
 
@@ -3847,6 +5270,7 @@ static m2c_token_t release_statement (m2c_parser_context_t p) {
   m2c_astnode_t id_node;
   
   PARSER_DEBUG_INFO("releaseStatement");
+  PARSER_PROFILE_ENTER("releaseStatement");
   
   /* RELEASE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3861,8 +5285,9 @@ static m2c_token_t release_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_RELEASE, id_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_RELEASE, id_node);
       
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end release_statement */
 
@@ -3883,9 +5308,11 @@ static m2c_token_t update_or_proc_call (m2c_parser_context_t p) {
   m2c_token_t lookahead;
     
   PARSER_DEBUG_INFO("updateOrProcCall");
+  PARSER_PROFILE_ENTER("updateOrProcCall");
   
   /* TO DO */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end update_or_proc_call */
 
@@ -3905,6 +5332,7 @@ static m2c_token_t return_statement (m2c_parser_context_t p) {
   m2c_token_t lookahead;
     
   PARSER_DEBUG_INFO("returnStatement");
+  PARSER_PROFILE_ENTER("returnStatement");
   
   /* RETURN */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3919,8 +5347,9 @@ static m2c_token_t return_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_RETURN, expr_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_RETURN, expr_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end return_statement */
 
@@ -3940,6 +5369,7 @@ static m2c_token_t copy_statement (m2c_parser_context_t p) {
   m2c_token_t lookahead;
     
   PARSER_DEBUG_INFO("copyStatement");
+  PARSER_PROFILE_ENTER("copyStatement");
   
   /* COPY */
   lookahead = m2c_consume_sym(p->lexer);
@@ -3973,8 +5403,9 @@ static m2c_token_t copy_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_COPY, id_node, expr_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_COPY, id_node, expr_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end copy_statement */
 
@@ -3999,6 +5430,7 @@ static m2c_token_t read_statement (m2c_parser_context_t p) {
   m2c_astnode_t chan_node;
     
   PARSER_DEBUG_INFO("readStatement");
+  PARSER_PROFILE_ENTER("readStatement");
   
   /* READ */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4061,6 +5493,7 @@ static m2c_token_t read_statement (m2c_parser_context_t p) {
   
   m2c_fifo_release(arg_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end read_statement */
 
@@ -4104,7 +5537,7 @@ static m2c_token_t input_arg (m2c_parser_context_t p) {
   } /* end if */
     
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(node_type, id_node, NULL);
+  p->ast = m2c_ast_new_node1(node_type, id_node);
   
   return lookahead;
 } /* end input_arg */
@@ -4128,6 +5561,7 @@ static m2c_token_t write_statement (m2c_parser_context_t p) {
   m2c_astnode_t chan_node;
     
   PARSER_DEBUG_INFO("writeStatement");
+  PARSER_PROFILE_ENTER("writeStatement");
   
   /* WRITE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4190,6 +5624,7 @@ static m2c_token_t write_statement (m2c_parser_context_t p) {
   
   m2c_fifo_release(arg_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end write_statement */
 
@@ -4238,7 +5673,7 @@ static m2c_token_t output_args (m2c_parser_context_t p) {
       fmt_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_COMMA, FIRST(EXPRESSION));
+      lookahead = skip_to_set(p, RESYNC(COMMA_OR_FIRST_EXPRESSION));
       fmt_node = m2c_ast_empty_node();
     } /* end if */
     
@@ -4256,7 +5691,7 @@ static m2c_token_t output_args (m2c_parser_context_t p) {
       args_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_RPAREN, FOLLOW(OUTPUT_ARGS));
+      lookahead = skip_to_set(p, RESYNC(RPAREN_OR_FOLLOW_OUTPUT_ARGS));
       args_node = m2c_ast_empty_node();
     } /* end if */
     
@@ -4269,11 +5704,11 @@ static m2c_token_t output_args (m2c_parser_context_t p) {
     } /* end if */
     
     /* build AST node and pass it back in p->ast */
-    p->ast = m2c_ast_new_node(AST_FMTARG, fmt_node, args_node, NULL);
+    p->ast = m2c_ast_new_node2(AST_FMTARG, fmt_node, args_node);
   }
   else /* unformattedArg */ {
     lookahead = expression(p);
-    p->ast = m2c_ast_new_node(AST_WRITEARG, p->ast, NULL);
+    p->ast = m2c_ast_new_node1(AST_WRITEARG, p->ast);
   } /* end if */
   
   return lookahead;
@@ -4304,6 +5739,7 @@ static m2c_token_t if_statement (m2c_parser_context_t p) {
   m2c_astnode_t elif_node, else_node;
   
   PARSER_DEBUG_INFO("ifStatement");
+  PARSER_PROFILE_ENTER("ifStatement");
   
   /* IF */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4314,7 +5750,7 @@ static m2c_token_t if_statement (m2c_parser_context_t p) {
     if_expr_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_THEN, FIRST(STATEMENT));
+    lookahead = skip_to_set(p, RESYNC(THEN_OR_FIRST_STATEMENT));
     if_expr_node = m2c_ast_empty_node();
   } /* end if */
   
@@ -4350,7 +5786,7 @@ static m2c_token_t if_statement (m2c_parser_context_t p) {
       expr_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_THEN, FIRST(STATEMENT));
+      lookahead = skip_to_set(p, RESYNC(THEN_OR_FIRST_STATEMENT));
       expr_node = m2c_ast_empty_node();
     } /* end if */
   
@@ -4391,7 +5827,7 @@ static m2c_token_t if_statement (m2c_parser_context_t p) {
       stmt_seq_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_END, FOLLOW(STATEMENT));
+      lookahead = skip_to_set(p, RESYNC(END_OR_FOLLOW_STATEMENT));
       stmt_seq_node = m2c_ast_empty_node();
     } /* end if */
   }
@@ -4400,7 +5836,7 @@ static m2c_token_t if_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build else AST node */
-  else_node = m2c_ast_new_node(AST_ELSE, stmt_seq_node, NULL);
+  else_node = m2c_ast_new_node1(AST_ELSE, stmt_seq_node);
   
   /* END */
   if (match_token(p, TOKEN_END)) {
@@ -4417,6 +5853,7 @@ static m2c_token_t if_statement (m2c_parser_context_t p) {
   
   m2c_fifo_release(elif_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end if_statement */
 
@@ -4443,6 +5880,7 @@ static m2c_token_t case_statement (m2c_parser_context_t p) {
   m2c_astnode_t expr_node, case_list_node, else_node;
   
   PARSER_DEBUG_INFO("caseStatement");
+  PARSER_PROFILE_ENTER("caseStatement");
   
   /* CASE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4502,7 +5940,7 @@ static m2c_token_t case_statement (m2c_parser_context_t p) {
       stmt_seq_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_token_or_set(p, TOKEN_END, FOLLOW(STATEMENT));
+      lookahead = skip_to_set(p, RESYNC(END_OR_FOLLOW_STATEMENT));
       stmt_seq_node = m2c_ast_empty_node();
     } /* end if */
   }
@@ -4511,7 +5949,7 @@ static m2c_token_t case_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build else AST node */
-  else_node = m2c_ast_new_node(AST_ELSE, stmt_seq_node, NULL);
+  else_node = m2c_ast_new_node1(AST_ELSE, stmt_seq_node);
   
   /* END */
   if (match_token(p, TOKEN_END)) {
@@ -4523,10 +5961,11 @@ static m2c_token_t case_statement (m2c_parser_context_t p) {
   
   /* build AST node and pass it back in p->ast */
   p->ast =
-    m2c_ast_new_node(AST_SWITCH, expr_node, case_list_node, else_node, NULL);
+    m2c_ast_new_node3(AST_SWITCH, expr_node, case_list_node, else_node);
   
   m2c_fifo_release(case_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end case_statement */
 
@@ -4547,6 +5986,7 @@ static m2c_token_t case_branch (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("case");
+  PARSER_PROFILE_ENTER("case");
   
   /* caseLabels */
   lookahead = case_labels(p);
@@ -4590,6 +6030,7 @@ static m2c_token_t case_branch (m2c_parser_context_t p) {
   
   m2c_fifo_release(case_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;  
 } /* end case_branch */
 
@@ -4609,6 +6050,7 @@ static m2c_token_t loop_statement (m2c_parser_context_t p) {
   m2c_astnode_t stmt_seq_node;
   
   PARSER_DEBUG_INFO("loopStatement");
+  PARSER_PROFILE_ENTER("loopStatement");
   
   /* LOOP */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4619,7 +6061,7 @@ static m2c_token_t loop_statement (m2c_parser_context_t p) {
     stmt_seq_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_END, FOLLOW(LOOP_STATEMENT));
+    lookahead = skip_to_set(p, RESYNC(END_OR_FOLLOW_LOOP_STATEMENT));
     stmt_seq_node = m2c_ast_empty_node();
   } /* end if */
   
@@ -4632,8 +6074,9 @@ static m2c_token_t loop_statement (m2c_parser_context_t p) {
   } /* end if*/
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_LOOP, stmt_seq_node, NULL);
+  p->ast = m2c_ast_new_node1(AST_LOOP, stmt_seq_node);
     
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end loop_statement */
 
@@ -4655,6 +6098,7 @@ static m2c_token_t while_statement (m2c_parser_context_t p) {
   m2c_astnode_t expr_node, stmt_seq_node;
   
   PARSER_DEBUG_INFO("whileStatement");
+  PARSER_PROFILE_ENTER("whileStatement");
   
   /* WHILE */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4665,7 +6109,7 @@ static m2c_token_t while_statement (m2c_parser_context_t p) {
     expr_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_DO, FIRST(STATEMENT_SEQUENCE));
+    lookahead = skip_to_set(p, RESYNC(DO_OR_FIRST_STATEMENT_SEQUENCE));
     expr_node = m2c_ast_empty_node();
   } /* end if */
   
@@ -4683,7 +6127,7 @@ static m2c_token_t while_statement (m2c_parser_context_t p) {
     stmt_seq_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_END, FOLLOW(WHILE_STATEMENT));
+    lookahead = skip_to_set(p, RESYNC(END_OR_FOLLOW_WHILE_STATEMENT));
     stmt_seq_node = m2c_ast_empty_node();
   } /* end if */
   
@@ -4696,8 +6140,9 @@ static m2c_token_t while_statement (m2c_parser_context_t p) {
   } /* end if*/
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_WHILE, expr_node, stmt_seq_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_WHILE, expr_node, stmt_seq_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end while_statement */
 
@@ -4719,6 +6164,7 @@ static m2c_token_t repeat_statement (m2c_parser_context_t p) {
   m2c_astnode_t expr_node, stmt_seq_node;
   
   PARSER_DEBUG_INFO("repeatStatement");
+  PARSER_PROFILE_ENTER("repeatStatement");
   
   /* REPEAT */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4729,7 +6175,7 @@ static m2c_token_t repeat_statement (m2c_parser_context_t p) {
   }
   else /* resync */ {
     lookahead =
-      skip_to_token_or_set(p, TOKEN_UNTIL, FIRST(EXPRESSION));
+      skip_to_set(p, RESYNC(UNTIL_OR_FIRST_EXPRESSION));
       stmt_seq_node = m2c_ast_empty_node();
   } /* end if */
     
@@ -4752,8 +6198,9 @@ static m2c_token_t repeat_statement (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_REPEAT, expr_node, stmt_seq_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_REPEAT, expr_node, stmt_seq_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end repeat_statement */
 
@@ -4783,6 +6230,7 @@ static m2c_token_t for_statement (m2c_parser_context_t p) {
   m2c_astnode_t acc_node, val_node, expr_node, iter_node, stmt_seq_node;
   
   PARSER_DEBUG_INFO("forStatement");
+  PARSER_PROFILE_ENTER("forStatement");
   
   /* FOR */
   lookahead = m2c_consume_sym(p->lexer);
@@ -4838,7 +6286,7 @@ static m2c_token_t for_statement (m2c_parser_context_t p) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_DO, FIRST(ITERABLE_EXPR));
+    lookahead = skip_to_set(p, RESYNC(DO_OR_FIRST_ITERABLE_EXPR));
   } /* end if */
   
   /* iterableExpr */
@@ -4847,19 +6295,19 @@ static m2c_token_t for_statement (m2c_parser_context_t p) {
     expr_node = p->ast;
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_DO, FIRST(STATEMENT_SEQUENCE));
+    lookahead = skip_to_set(p, RESYNC(DO_OR_FIRST_STATEMENT_SEQUENCE));
     expr_node = m2c_ast_empty_node();
   } /* end if */
   
   /* build iterator AST node */
-  iter_node = m2c_ast_new_node(node_type, acc_node, val_node, expr_node, NULL);
+  iter_node = m2c_ast_new_node3(node_type, acc_node, val_node, expr_node);
   
   /* DO */
   if (match_token(p, TOKEN_IN)) {
     lookahead = m2c_consume_sym(p->lexer);
   }
   else /* resync */ {
-    lookahead = skip_to_token_or_set(p, TOKEN_END, FIRST(STATEMENT_SEQUENCE));
+    lookahead = skip_to_set(p, RESYNC(END_OR_FIRST_STATEMENT_SEQUENCE));
   } /* end if */
   
   /* statementSequence */
@@ -4868,13 +6316,14 @@ static m2c_token_t for_statement (m2c_parser_context_t p) {
   }
   else /* resync */ {
     lookahead =
-      skip_to_token_or_set(p, TOKEN_END, FOLLOW(FOR_STATEMENT));
+      skip_to_set(p, RESYNC(END_OR_FOLLOW_FOR_STATEMENT));
       stmt_seq_node = m2c_ast_empty_node();
   } /* end if */
     
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_FOR, iter_node, stmt_seq_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_FOR, iter_node, stmt_seq_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end for_statement */
 
@@ -4908,7 +6357,7 @@ static m2c_token_t iterable_expr (m2c_parser_context_t p) {
       type_node = m2c_ast_empty_node();
     } /* end if */
     
-    p->ast = m2c_ast_new_node(AST_ITEREXPR, type_node, NULL);
+    p->ast = m2c_ast_new_node1(AST_ITEREXPR, type_node);
   }
   /* | qualident valueRange? */
   else {
@@ -4919,7 +6368,7 @@ static m2c_token_t iterable_expr (m2c_parser_context_t p) {
     }
     else /* resync */ {
       lookahead =
-        skip_to_token_or_set(p, TOKEN_LBRACKET, FOLLOW(ITERABLE_EXPR));
+        skip_to_set(p, RESYNC(LBRACKET_OR_FOLLOW_ITERABLE_EXPR));
       id_node = m2c_ast_empty_node();
     } /* end if */
     
@@ -4933,7 +6382,7 @@ static m2c_token_t iterable_expr (m2c_parser_context_t p) {
       range_node = m2c_ast_empty_node();
     } /* end if */
     
-    p->ast = m2c_ast_new_node(AST_ITEREXPR, id_node, range_node, NULL);
+    p->ast = m2c_ast_new_node2(AST_ITEREXPR, id_node, range_node);
   } /* end if */  
   
   return lookahead;
@@ -4957,6 +6406,7 @@ static m2c_token_t designator (m2c_parser_context_t p) {
   m2c_astnode_t id_node, tail_node;
     
   PARSER_DEBUG_INFO("designator");
+  PARSER_PROFILE_ENTER("designator");
   
   /* qualident */
   lookahead = qualident(p);
@@ -4976,9 +6426,10 @@ static m2c_token_t designator (m2c_parser_context_t p) {
       tail_node = p->ast;
     } /* end if */
     
-    p->ast = m2c_ast_new_node(AST_DESIG, id_node, tail_node, NULL);
+    p->ast = m2c_ast_new_node2(AST_DESIG, id_node, tail_node);
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end designator */
 
@@ -4997,6 +6448,7 @@ static m2c_token_t deref_tail (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("derefTail");
+  PARSER_PROFILE_ENTER("derefTail");
   
   /* deref */
   lookahead = deref(p);
@@ -5029,8 +6481,9 @@ static m2c_token_t deref_tail (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_DEREFTAIL, deref_node, tail_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_DEREFTAIL, deref_node, tail_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end deref_tail */
 
@@ -5049,6 +6502,7 @@ static m2c_token_t subscript_tail (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("subscriptTail");
+  PARSER_PROFILE_ENTER("subscriptTail");
   
   /* '[' */
   lookahead = m2c_consume_sym(p->lexer);
@@ -5099,8 +6553,9 @@ static m2c_token_t subscript_tail (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_SUBSCRTAIL, expr_node, tail_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_SUBSCRTAIL, expr_node, tail_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end subscript_tail */
 
@@ -5120,6 +6575,7 @@ static m2c_token_t target_designator (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("targetDesignator");
+  PARSER_PROFILE_ENTER("targetDesignator");
   
   /* qualident */
   lookahead = qualident(p);
@@ -5129,13 +6585,14 @@ static m2c_token_t target_designator (m2c_parser_context_t p) {
   /* ( derefTargetTail | bracketTargetTail )? */
   if (lookahead == TOKEN_LBRACKET) {
     lookahead = bracket_target_tail(p);
-    p->ast = m2c_ast_new_node(AST_SUBSCR, id_node, p->ast, NULL);
+    p->ast = m2c_ast_new_node2(AST_SUBSCR, id_node, p->ast);
   }
   else if (lookahead == TOKEN_DEREF) {
     lookahead = deref_target_tail(p);
-    p->ast = m2c_ast_new_node(AST_DEREF, id_node, p->ast, NULL);
+    p->ast = m2c_ast_new_node2(AST_DEREF, id_node, p->ast);
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end target_designator */
 
@@ -5154,6 +6611,7 @@ static m2c_token_t deref_target_tail (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("derefTargetTail");
+  PARSER_PROFILE_ENTER("derefTargetTail");
   
   /* deref */
   lookahead = deref(p);
@@ -5186,8 +6644,9 @@ static m2c_token_t deref_target_tail (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_DEREFTAIL, deref_node, tail_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_DEREFTAIL, deref_node, tail_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end deref_target_tail */
 
@@ -5207,9 +6666,11 @@ static m2c_token_t bracket_target_tail (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("bracketTargetTail");
+  PARSER_PROFILE_ENTER("bracketTargetTail");
   
   /* TO DO */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end bracket_target_tail */
 
@@ -5228,13 +6689,15 @@ static m2c_token_t deref (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("deref");
+  PARSER_PROFILE_ENTER("deref");
   
   /* '^'+ */
   while (lookahead == TOKEN_DEREF) {
     lookahead = m2c_consume_sym(p->lexer);
-    p->ast = m2c_ast_new_node(AST_DEREF, p->ast);
+    p->ast = m2c_ast_new_node1(AST_DEREF, p->ast);
   } /* end while */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end deref */
 
@@ -5254,6 +6717,7 @@ static m2c_token_t expression_list (m2c_parser_context_t p) {
   m2c_fifo_t expr_list;
   
   PARSER_DEBUG_INFO("expressionList");
+  PARSER_PROFILE_ENTER("expressionList");
   
   /* expression */
   lookahead = expression(p);
@@ -5280,10 +6744,74 @@ static m2c_token_t expression_list (m2c_parser_context_t p) {
   
   m2c_fifo_release(expr_list);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end expression_list */
 
 
+/* --------------------------------------------------------------------------
+ * private type operator_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for the precedence level and AST node type of an operator.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* level */      uint_t level;
+  /* node_type */  m2c_ast_nodetype_t node_type;
+} operator_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private table operator_table
+ * --------------------------------------------------------------------------
+ * Binary operators by token,  with precedence levels as in the grammar.
+ * Tokens that do not represent binary operators have level zero.
+ * ----------------------------------------------------------------------- */
+
+static const operator_entry_t operator_table[TOKEN_END_MARK] = {
+  /* OperL1 */
+  [TOKEN_EQUAL]          = { 1, AST_EQ },
+  [TOKEN_NOT_EQUAL]      = { 1, AST_NEQ },
+  [TOKEN_LESS]           = { 1, AST_LT },
+  [TOKEN_LESS_OR_EQ]     = { 1, AST_LTEQ },
+  [TOKEN_GREATER]        = { 1, AST_GT },
+  [TOKEN_GREATER_OR_EQ]  = { 1, AST_GTEQ },
+  [TOKEN_IDENTITY]       = { 1, AST_IDTY },
+  [TOKEN_IN]             = { 1, AST_IN },
+  
+  /* OperL2 */
+  [TOKEN_PLUS]           = { 2, AST_PLUS },
+  [TOKEN_MINUS]          = { 2, AST_MINUS },
+  [TOKEN_OR]             = { 2, AST_OR },
+  [TOKEN_CONCAT]         = { 2, AST_CONCAT },
+  [TOKEN_SET_DIFF]       = { 2, AST_SETDIFF },
+  
+  /* OperL3 */
+  [TOKEN_ASTERISK]       = { 3, AST_ASTERISK },
+  [TOKEN_SOLIDUS]        = { 3, AST_SOLIDUS },
+  [TOKEN_DIV]            = { 3, AST_DIV },
+  [TOKEN_MOD]            = { 3, AST_MOD },
+  [TOKEN_AND]            = { 3, AST_AND }
+}; /* end operator_table */
+
+#define OPERATOR_LEVEL(_token) (operator_table[_token].level)
+
+
+/* --------------------------------------------------------------------------
+ * private table operand_production
+ * --------------------------------------------------------------------------
+ * Productions of the right operands of operators by precedence level,  for
+ * lookahead checks and resync.
+ * ----------------------------------------------------------------------- */
+
+static const m2c_production_t operand_production[] = {
+  /* unused */  0,
+  /* OperL1 */  P_SIMPLE_EXPRESSION,
+  /* OperL2 */  P_TERM,
+  /* OperL3 */  P_SIMPLE_TERM
+}; /* end operand_production */
+
+
 /* --------------------------------------------------------------------------
  * private function expression()
  * --------------------------------------------------------------------------
@@ -5291,297 +6819,164 @@ static m2c_token_t expression_list (m2c_parser_context_t p) {
  *   simpleExpression ( OperL1 simpleExpression )?
  *   ;
  *
+ * simpleExpression :=
+ *   '-' factor | term ( OperL2 term )*
+ *   ;
+ *
+ * term :=
+ *   simpleTerm ( OperL3 simpleTerm )*
+ *   ;
+ *
+ * simpleTerm :=
+ *   NOT? factor
+ *   ;
+ *
  * .OperL1 := '=' | '#' | '<' | '<=' | '>' | '>=' | '==' | IN ;
  *
+ * .OperL2 := '+' | '-' | OR | ConcatOp | SetDiffOp ;
+ *
+ * .OperL3 := '*' | '/' | DIV | MOD | AND ;
+ *
+ * alias ConcatOp = '&' ;
+ * alias SetDiffOp = '\' ;
+ *
+ * The four rules are parsed together by function climb_expression.
+ *
  * astnode:
- *  simpleExprNode |
+ *  factorNode | (NEG expr) | (NOT expr) |
  *  (EQ expr expr) | (NEQ expr expr) | (LT expr expr) | (LTEQ expr expr) |
- *  (GT expr expr) | (GTEQ expr expr) | (IDTY expr expr) | (IN expr expr) 
+ *  (GT expr expr) | (GTEQ expr expr) | (IDTY expr expr) | (IN expr expr) |
+ *  (PLUS expr expr) | (MINUS expr expr) | (OR expr expr) |
+ *  (CONCAT expr expr) | (SETDIFF expr expr) |
+ *  (ASTERISK expr expr) | (SOLIDUS expr expr) |
+ *  (DIV expr expr) | (MOD expr expr) | (AND expr expr)
  * ----------------------------------------------------------------------- */
 
-static m2c_token_t simple_expression (m2c_parser_context_t p);
+static m2c_token_t climb_expression
+  (m2c_parser_context_t p, uint_t min_level);
 
 static m2c_token_t expression (m2c_parser_context_t p) {
   m2c_token_t lookahead;
-  m2c_ast_nodetype_t node_type;
-  m2c_astnode_t left_node, right_node;
-    
-  PARSER_DEBUG_INFO("expression");
   
-  /* simpleExpression */
-  lookahead = simple_expression(p);
+  PARSER_DEBUG_INFO("expression");
+  PARSER_PROFILE_ENTER("expression");
   
-  /* ( OperL1 simpleExpression )? */
-  if (M2C_IS_OPER_L1_TOKEN(lookahead)) {
-    left_node = p->ast;
-    
-    switch (lookahead) {
-      case TOKEN_IN :
-        node_type = AST_IN;
-        break;
-      
-      case TOKEN_EQUAL :
-        node_type = AST_EQ;
-        break;
-      
-      case TOKEN_NOT_EQUAL :
-        node_type = AST_NEQ;
-        break;
-      
-      case TOKEN_LESS :
-        node_type = AST_LT;
-        break;
-      
-      case TOKEN_LESS_OR_EQ :
-        node_type = AST_LTEQ;
-        break;
-      
-      case TOKEN_GREATER :
-        node_type = AST_GT;
-        break;
-      
-      case TOKEN_GREATER_OR_EQ :
-        nodetype = AST_GTEQ;
-        break;
-        
-      case TOKEN_IDENTITY :
-        nodetype = AST_IDTY;
-        break;
-    } /* end switch */
-    lookahead = m2c_consume_sym(p->lexer);
-    
-    /* simpleExpression */
-    if (match_set(p, FIRST(EXPRESSION))) {
-      lookahead = simple_expression(p);
-      right_node = p->ast;
-    }
-    else /* resync */ {
-      lookahead = skip_to_set(p, FOLLOW(EXPRESSION));
-      right_node = m2c_ast_empty_node();
-    } /* end if */
-    
-    p->ast = m2c_ast_new_node(node_type, left_node, right_node, NULL);
-  } /* end if */
+  lookahead = climb_expression(p, 1);
+  /* p->ast holds expression node */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end expression */
 
 
 /* --------------------------------------------------------------------------
- * private function simple_expression()
+ * private function climb_expression(p, min_level)
  * --------------------------------------------------------------------------
- * simpleExpression :=
- *   '-' factor | term ( OperL2 term )*
- *   ;
- *
- * .OperL2 := '+' | '-' | OR | ConcatOp | SetDiffOp ;
- *
- * alias ConcatOp = '&' ;
- * alias SetDiffOp = '\' ;
- *
- * astnode:
- *  termNode | (NEG expr) | (PLUS expr expr) | (MINUS expr expr) |
- *  (OR expr expr) | (CONCAT expr expr) | (SETDIFF expr expr)
+ * Parses an operand followed by any operators of precedence min_level and
+ * above with their right operands,  builds the AST node,  passes it back in
+ * p->ast and returns the new lookahead symbol.  Operators are looked up in
+ * operator_table,  thus each operand and operator takes a single dispatch
+ * instead of one call per precedence level.  Operators of the same level
+ * associate to the left,  those of level one do not associate.
+ *
+ * An operand is  NOT? factor,  or  '-' factor  where a simpleExpression
+ * starts,  that is for min_level up to two.  As in the grammar,  a negated
+ * factor is not followed by operators of level two or three.
  * ----------------------------------------------------------------------- */
 
-static m2c_token_t term (m2c_parser_context_t p);
+static m2c_token_t factor (m2c_parser_context_t p);
 
-static m2c_token_t simple_expression (m2c_parser_context_t p) {
+static m2c_token_t climb_expression
+  (m2c_parser_context_t p, uint_t min_level) {
+  
   m2c_token_t lookahead;
   m2c_ast_nodetype_t node_type;
   m2c_astnode_t left_node, right_node;
-  
-  PARSER_DEBUG_INFO("simpleExpression");
+  m2c_production_t operand;
+  uint_t level, max_level;
+  bool not_flag;
   
   lookahead = m2c_next_sym(p->lexer);
   
   /* '-' factor */
-  if (lookahead = TOKEN_MINUS) {
+  if ((lookahead == TOKEN_MINUS) && (min_level <= 2)) {
     /* '-' */
     lookahead = m2c_consume_sym(p->lexer);
     
     /* factor */
     if (match_set(p, FIRST(FACTOR))) {
       lookahead = factor(p);
-      expr_node = p->ast;
+      left_node = p->ast;
     }
     else /* resync */ {
       lookahead = skip_to_set(p, FOLLOW(SIMPLE_EXPRESSION));
-      expr_node = m2c_ast_empty_node();
+      left_node = m2c_ast_empty_node();
     } /* end if */
     
-    p->ast = m2c_ast_new_node(AST_NEG, expr_node, NULL);
+    left_node = m2c_ast_new_node1(AST_NEG, left_node);
+    max_level = 1;
   }
-  /* term (OperL2 term)* */
+  /* | NOT? factor */
   else {
-    /* term */
-    lookahead = term(p);
-    /* p->ast holds simple term node */
+    /* NOT? */
+    not_flag = (lookahead == TOKEN_NOT);
+    
+    if (not_flag) {
+      lookahead = m2c_consume_sym(p->lexer);
+    } /* end if */
     
-    /* (OperL2 term)* */
-    while (M2C_IS_OPER_L2_TOKEN(lookahead)) {
+    /* factor */
+    if (match_set(p, FIRST(FACTOR))) {
+      lookahead = factor(p);
       left_node = p->ast;
-      
-      /* OperL2 */
-      switch (lookahead) {
-        case TOKEN_OR :
-          node_type = AST_OR;
-          break;
-      
-        case TOKEN_PLUS :
-          node_type = AST_PLUS;
-          break;
-      
-        case TOKEN_MINUS :
-          node_type = AST_MINUS;
-          break;
-          
-        case TOKEN_CONCAT :
-          node_type = AST_CONCAT;
-          break;
-          
-        case TOKEN_SET_DIFF :
-          node_type = AST_SETDIFF;
-          break;
-      } /* end switch */
-      
-      /* term */
-      if (match_set(p, FIRST(TERM))) {
-        lookahead = term(p);
-        right_node = p->ast;
-      }
-      else /* resync */ {
-        lookahead = skip_to_set(p, FIRST_OPERL2_AND_FOLLOW_SIMPLE_EXPRESSION);
-        right_node = m2c_ast_empty_node();
-      } /* end if */
-      
-      p->ast = m2c_ast_new_node(node_type, left_node, right_node, NULL);
-    } /* end while */
+    }
+    else /* resync */ {
+      lookahead = skip_to_set(p, FOLLOW(SIMPLE_TERM));
+      left_node = m2c_ast_empty_node();
+    } /* end if */
+    
+    if (not_flag) {
+      left_node = m2c_ast_new_node1(AST_NOT, left_node);
+    } /* end if */
+    
+    max_level = 3;
   } /* end if */
-      
-  return lookahead;
-} /* end simple_expression */
-
-
-/* --------------------------------------------------------------------------
- * private function term()
- * --------------------------------------------------------------------------
- * term :=
- *   simpleTerm ( OperL3 simpleTerm )*
- *   ;
- *
- * .OperL3 := '*' | '/' | DIV | MOD | AND ;
- *
- * astnode:
- *  (ASTERISK expr expr) | (SOLIDUS expr expr) |
- *  (DIV expr expr) | (MOD expr expr) | (AND expr expr) | simpleTermNode
- * ----------------------------------------------------------------------- */
-
-static m2c_token_t simple_term (m2c_parser_context_t p);
-
-static m2c_token_t term (m2c_parser_context_t p) {
-  m2c_token_t lookahead;
-  m2c_ast_nodetype_t node_type;
-  m2c_astnode_t left_node, right_node;
-  
-  PARSER_DEBUG_INFO("term");
   
-  /* simpleTerm */
-  lookahead = simple_term(p);
-  /* p->ast holds simple term node */
+  /* ( operator operand )* */
+  level = OPERATOR_LEVEL(lookahead);
   
-  /* (OperL3 simpleTerm)* */
-  while (M2C_IS_OPER_L3_TOKEN(lookahead)) {
-    left_node = p->ast;
+  while ((level >= min_level) && (level <= max_level)) {
+    node_type = operator_table[lookahead].node_type;
+    operand = operand_production[level];
     
-    /* OperL3 */
-    switch (lookahead) {
-      case TOKEN_AND :
-        node_type = AST_AND;
-        break;
-    
-      case TOKEN_DIV :
-        node_type = AST_DIV;
-        break;
-    
-      case TOKEN_MOD :
-        node_type = AST_MOD;
-        break;
-    
-      case TOKEN_ASTERISK :
-        node_type = AST_ASTERISK;
-        break;
-    
-      case TOKEN_SOLIDUS :
-        node_type = AST_SOLIDUS;
-        break;
-    } /* end switch */
+    /* operator */
     lookahead = m2c_consume_sym(p->lexer);
     
-    /* simpleTerm */
-    if (match_set(p, FIRST(SIMPLE_TERM))) {
-      lookahead = simple_term(p);
+    /* operand with operators of higher precedence */
+    if (match_set(p, m2c_first_set(operand))) {
+      lookahead = climb_expression(p, level + 1);
       right_node = p->ast;
     }
     else /* resync */ {
-      lookahead = skip_to_set(p, FIRST_OPERL3_AND_FOLLOW_TERM);
+      lookahead = skip_to_set(p, m2c_follow_set(operand));
       right_node = m2c_ast_empty_node();
     } /* end if */
-      
-    p->ast = m2c_ast_new_node(node_type, left_node, right_node, NULL);
+    
+    left_node = m2c_ast_new_node2(node_type, left_node, right_node);
+    
+    /* OperL1 does not associate */
+    if (level == 1) {
+      break;
+    } /* end if */
+    
+    level = OPERATOR_LEVEL(lookahead);
   } /* end while */
   
-  return lookahead;
-} /* end term */
-
-
-/* --------------------------------------------------------------------------
- * private function simple_term()
- * --------------------------------------------------------------------------
- * simpleTerm :=
- *   NOT? factor
- *   ;
- *
- * astnode: factorNode | (NOT factorNode)
- * ----------------------------------------------------------------------- */
-
-static m2c_token_t factor (m2c_parser_context_t p);
-
-static m2c_token_t simple_term (m2c_parser_context_t p) {
-  m2c_token_t lookahead;
-  m2c_astnode_t value_node;
-  bool not_flag;
-  
-  PARSER_DEBUG_INFO("simpleTerm");
-  
-  /* NOT? */
-  if (lookahead == TOKEN_NOT) {
-    lookahead = m2c_consume_sym(p->lexer);
-    not_flag = true;
-  }
-  else {
-    not_flag = false;
-  } /* end if */
-  
-  /* factor */
-  if (match_set(p, FIRST(FACTOR))) {
-    lookahead = factor(p);
-    value_node = p->ast;
-  }
-  else /* resync */ {
-    lookahead = skip_to_set(p, FOLLOW(SIMPLE_TERM));
-    value_node = m2c_ast_empty_node();
-  } /* end if */
-  
-  if (not_flag == true) {
-    p->ast = m2c_ast_new_node(AST_NOT, value_node, NULL);
-  }
-  else /* not_flag == false */ {
-    p->ast = value_node;
-  } /* end if */
+  /* pass AST node back in p->ast */
+  p->ast = left_node;
   
   return lookahead;
-} /* end simple_term */
+} /* end climb_expression */
 
 
 /* --------------------------------------------------------------------------
@@ -5601,6 +6996,7 @@ static m2c_token_t factor (m2c_parser_context_t p) {
   m2c_astnode_t value_node, type_node;
   
   PARSER_DEBUG_INFO("factor");
+  PARSER_PROFILE_ENTER("factor");
   
   /* simpleFactor */
   lookahead = simple_factor(p);
@@ -5624,9 +7020,10 @@ static m2c_token_t factor (m2c_parser_context_t p) {
     } /* end if */
     
     /* build type conversion AST node */
-    p->ast = m2c_ast_new_node(AST_CONV, value_node, type_node, NULL);
+    p->ast = m2c_ast_new_node2(AST_CONV, value_node, type_node);
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end factor */
 
@@ -5652,6 +7049,7 @@ static m2c_token_t simple_factor (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("simpleFactor");
+  PARSER_PROFILE_ENTER("simpleFactor");
   
   lookahead = m2c_next_sym(p->lexer);
   
@@ -5667,6 +7065,7 @@ static m2c_token_t simple_factor (m2c_parser_context_t p) {
       lookahead = m2c_consume_sym(p->lexer);
       lexeme = m2c_current_lexeme(p->lexer);
       p->ast = ast_new_terminal_node(AST_INTVAL, lexeme);
+      note_literal_value(p);
       break;
       
     /* | RealNumber */
@@ -5674,6 +7073,7 @@ static m2c_token_t simple_factor (m2c_parser_context_t p) {
       lookahead = m2c_consume_sym(p->lexer);
       lexeme = m2c_current_lexeme(p->lexer);
       p->ast = ast_new_terminal_node(AST_REALVAL, lexeme);
+      note_literal_value(p);
       break;
     
     /* | CharCode */
@@ -5681,6 +7081,7 @@ static m2c_token_t simple_factor (m2c_parser_context_t p) {
       lookahead = m2c_consume_sym(p->lexer);
       lexeme = m2c_current_lexeme(p->lexer);
       p->ast = ast_new_terminal_node(AST_CHRVAL, lexeme);
+      note_literal_value(p);
       break;
     
     /* | QuotedString */
@@ -5720,6 +7121,7 @@ static m2c_token_t simple_factor (m2c_parser_context_t p) {
       break;
   } /* end switch */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end simple_factor */
 
@@ -5742,6 +7144,7 @@ static m2c_token_t source_designator (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("sourceDesignator");
+  PARSER_PROFILE_ENTER("sourceDesignator");
   
   /* qualident */
   lookahead = qualident(p);
@@ -5751,17 +7154,18 @@ static m2c_token_t source_designator (m2c_parser_context_t p) {
   /* ( functionCallTail | derefSourceTail | bracketSourceTail )? */
   if ((lookahead == TOKEN_LPAREN) {
     lookahead = function_call_tail(p);
-    p->ast = m2c_ast_new_node(AST_FCALL, id_node, p->ast, NULL);
+    p->ast = m2c_ast_new_node2(AST_FCALL, id_node, p->ast);
   }
   else if (lookahead == TOKEN_LBRACKET) {
     lookahead = bracket_source_tail(p);
-    p->ast = m2c_ast_new_node(AST_SUBSCR, id_node, p->ast, NULL);
+    p->ast = m2c_ast_new_node2(AST_SUBSCR, id_node, p->ast);
   }
   else if (lookahead == TOKEN_DEREF) {
     lookahead = deref_source_tail(p);
-    p->ast = m2c_ast_new_node(AST_DEREF, id_node, p->ast, NULL);
+    p->ast = m2c_ast_new_node2(AST_DEREF, id_node, p->ast);
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end source_designator */
 
@@ -5781,6 +7185,7 @@ static m2c_token_t function_call_tail (m2c_parser_context_t p) {
   m2c_astnode_t expr_list_node;
   
   PARSER_DEBUG_INFO("functionCallTail");
+  PARSER_PROFILE_ENTER("functionCallTail");
   
   /* '(' */
   lookahead = m2c_consume_sym(p->lexer);
@@ -5805,6 +7210,7 @@ static m2c_token_t function_call_tail (m2c_parser_context_t p) {
   /* pass AST back in p->ast */
   p->ast = expr_list_node;
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end function_call_tail */
 
@@ -5823,6 +7229,7 @@ static m2c_token_t deref_source_tail (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("derefSourceTail");
+  PARSER_PROFILE_ENTER("derefSourceTail");
   
   /* deref */
   lookahead = deref(p);
@@ -5863,8 +7270,9 @@ static m2c_token_t deref_source_tail (m2c_parser_context_t p) {
   } /* end if */
   
   /* build AST node and pass it back in p->ast */
-  p->ast = m2c_ast_new_node(AST_DEREFTAIL, deref_node, tail_node, NULL);
+  p->ast = m2c_ast_new_node2(AST_DEREFTAIL, deref_node, tail_node);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end deref_source_tail */
 
@@ -5885,9 +7293,11 @@ static m2c_token_t bracket_source_tail (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("bracketSourceTail");
+  PARSER_PROFILE_ENTER("bracketSourceTail");
   
   /* TO DO */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end bracket_source_tail */
 
@@ -5908,6 +7318,7 @@ static m2c_token_t structured_value (m2c_parser_context_t p) {
   m2c_token_t lookahead;
   
   PARSER_DEBUG_INFO("structuredValue");
+  PARSER_PROFILE_ENTER("structuredValue");
   
   /* '{' */
   lookahead = m2c_consume_sym(p->lexer);
@@ -5915,7 +7326,7 @@ static m2c_token_t structured_value (m2c_parser_context_t p) {
   val_list = m2c_fifo_new_queue(NULL);
   
   /* ( valueComponent (',' valueComponent)* )? */
-  if (m2c_tokenset_element(FIRST(VALUE_COMPONENT, lookahead))) {
+  if (m2c_tokenset_element(FIRST(VALUE_COMPONENT), lookahead)) {
     /* valueComponent */
     lookahead = value_component(p);
     m2c_fifo_enqueue(val_list, p->ast);
@@ -5931,7 +7342,7 @@ static m2c_token_t structured_value (m2c_parser_context_t p) {
         m2c_fifo_enqueue(val_list, p->ast);
       }
       else /* resync */ {
-        lookahead = skip_to_token_or_set(p, TOKEN_COMMA, TOKEN_RBRACE, NULL);
+        lookahead = skip_to_token_list(p, TOKEN_COMMA, TOKEN_RBRACE, NULL);
       } /* end if */
     } /* end while */
   } /* end if */
@@ -5947,6 +7358,7 @@ static m2c_token_t structured_value (m2c_parser_context_t p) {
   /* build AST node and pass it back in p->ast */
   p->ast = m2c_ast_new_list_node(AST_STRUCT, val_list, NULL);
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end structured_value */
 
@@ -5967,6 +7379,7 @@ static m2c_token_t value_component (m2c_parser_context_t p) {
   m2c_astnode_t expr1_node, expr2_node;
     
   PARSER_DEBUG_INFO("valueComponent");
+  PARSER_PROFILE_ENTER("valueComponent");
   
   /* expression */
   lookahead = expression(p);
@@ -5994,6 +7407,7 @@ static m2c_token_t value_component (m2c_parser_context_t p) {
       m2c_ast_new_list_node(AST_CONSTRANGE, expr1_node, expr2_node, NULL);
   } /* end if */
   
+  PARSER_PROFILE_EXIT();
   return lookahead;
 } /* end value_component */
 
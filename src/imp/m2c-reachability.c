@@ -0,0 +1,768 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-reachability.c                                                        *
+ *                                                                           *
+ * Implementation of reachability analysis of module level definitions.      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-reachability.h"
+#include "m2c-ast-nodetype.h"
+#include "interned-strings.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type entry_t
+ * --------------------------------------------------------------------------
+ * Entry of a lookup table.  In the identifier table,  key is an identifier
+ * and defn the definition that defines it.  In the definition table,  key
+ * and defn are the definition and marked is set once it has been reached.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const void *key;
+  m2c_astnode_t defn;
+  bool marked;
+} entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type table_t
+ * --------------------------------------------------------------------------
+ * Lookup table keyed by address.  Interned strings are unique,  thus both
+ * identifiers and nodes are compared by address.  The table uses open
+ * addressing with linear probing,  its capacity is a power of two.
+ * ----------------------------------------------------------------------- */
+
+#define TABLE_INITIAL_CAPACITY 64
+
+typedef struct {
+  entry_t *entry;
+  uint_t count;
+  uint_t capacity;
+} table_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_reachability_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a reachability analysis.  Definitions that have
+ * been marked but whose references have not yet been followed are held on
+ * the work stack.  If conservative is set,  all definitions are reachable.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_reachability_struct_t {
+  table_t ident;
+  table_t defn;
+  m2c_astnode_t *stack;
+  uint_t stack_count;
+  uint_t stack_capacity;
+  uint_t marked_count;
+  bool conservative;
+};
+
+typedef struct m2c_reachability_struct_t m2c_reachability_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type ident_handler_f
+ * --------------------------------------------------------------------------
+ * Type of a procedure called for each identifier ident defined by defn.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*ident_handler_f)
+  (m2c_reachability_t reach, intstr_t ident, m2c_astnode_t defn);
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool init_table (table_t *table);
+
+static m2c_astnode_t module_node (m2c_astnode_t ast);
+
+static m2c_astnode_t defn_of (m2c_astnode_t node);
+
+static void visit_defns
+  (m2c_reachability_t reach, m2c_astnode_t list, ident_handler_f handler);
+
+static void bind_ident
+  (m2c_reachability_t reach, intstr_t ident, m2c_astnode_t defn);
+
+static void mark_export
+  (m2c_reachability_t reach, intstr_t ident, m2c_astnode_t defn);
+
+static void mark_refs (m2c_reachability_t reach, m2c_astnode_t node);
+
+static entry_t *table_lookup (table_t *table, const void *key);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_analyse_reachability(module, interface)
+ * --------------------------------------------------------------------------
+ * Binds the module level definitions of module,  marks the definitions
+ * referenced by the roots  and follows the references of marked definitions
+ * until no unvisited definition remains.
+ *
+ * astnode: (IMPMOD moduleIdent implist (BLOCK defnListNode stmtSeqNode))
+ *
+ * astnode: (INTERFACE identNode impList defDeclList)
+ * ----------------------------------------------------------------------- */
+
+m2c_reachability_t m2c_analyse_reachability
+  (m2c_astnode_t module, m2c_astnode_t interface) {
+  
+  m2c_reachability_t reach;
+  m2c_astnode_t block, defn;
+  
+  reach = malloc(sizeof(m2c_reachability_struct_t));
+  
+  if (reach == NULL) {
+    return NULL;
+  } /* end if */
+  
+  reach->stack = NULL;
+  reach->stack_count = 0;
+  reach->stack_capacity = 0;
+  reach->marked_count = 0;
+  reach->conservative = false;
+  
+  if (NOT(init_table(&reach->ident)) || NOT(init_table(&reach->defn))) {
+    free(reach->ident.entry);
+    free(reach);
+    return NULL;
+  } /* end if */
+  
+  module = module_node(module);
+  
+  if (m2c_ast_nodetype(module) != AST_IMPMOD) {
+    /* unknown structure, keep everything */
+    reach->conservative = true;
+    return reach;
+  } /* end if */
+  
+  block = m2c_ast_subnode_at_index(module, 2);
+  
+  /* bind all definitions first, uses may precede definitions */
+  visit_defns(reach, m2c_ast_subnode_at_index(block, 0), bind_ident);
+  
+  /* exported identifiers are roots */
+  interface = module_node(interface);
+  
+  if (m2c_ast_nodetype(interface) == AST_INTERFACE) {
+    visit_defns(reach, m2c_ast_subnode_at_index(interface, 2), mark_export);
+  } /* end if */
+  
+  /* the module body is a root */
+  mark_refs(reach, m2c_ast_subnode_at_index(block, 1));
+  
+  /* follow references of marked definitions */
+  while ((reach->stack_count > 0) && NOT(reach->conservative)) {
+    reach->stack_count--;
+    defn = reach->stack[reach->stack_count];
+    mark_refs(reach, defn);
+  } /* end while */
+  
+  free(reach->stack);
+  reach->stack = NULL;
+  reach->stack_count = 0;
+  reach->stack_capacity = 0;
+  
+  return reach;
+} /* end m2c_analyse_reachability */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_is_reachable(reach, defn)
+ * --------------------------------------------------------------------------
+ * Returns false if module level definition defn was found unreachable.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_is_reachable (m2c_reachability_t reach, m2c_astnode_t defn) {
+  
+  entry_t *entry;
+  
+  if ((reach == NULL) || (reach->conservative)) {
+    return true;
+  } /* end if */
+  
+  entry = table_lookup(&reach->defn, defn_of(defn));
+  
+  return (entry == NULL) || (entry->marked);
+} /* end m2c_is_reachable */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unreachable_count(reach)
+ * --------------------------------------------------------------------------
+ * Returns the number of module level definitions found unreachable.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_unreachable_count (m2c_reachability_t reach) {
+  
+  if ((reach == NULL) || (reach->conservative)) {
+    return 0;
+  } /* end if */
+  
+  return reach->defn.count - reach->marked_count;
+} /* end m2c_unreachable_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_filter_reachable(reach, count, defn)
+ * --------------------------------------------------------------------------
+ * Removes unreachable definitions from array defn,  returns the new count.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_filter_reachable
+  (m2c_reachability_t reach, uint_t count, m2c_astnode_t defn[]) {
+  
+  uint_t index, kept;
+  
+  kept = 0;
+  for (index = 0; index < count; index++) {
+    if (m2c_is_reachable(reach, defn[index])) {
+      defn[kept] = defn[index];
+      kept++;
+    } /* end if */
+  } /* end for */
+  
+  return kept;
+} /* end m2c_filter_reachable */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_reachability(reach)
+ * --------------------------------------------------------------------------
+ * Deallocates reach.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_reachability (m2c_reachability_t reach) {
+  
+  if (reach == NULL) {
+    return;
+  } /* end if */
+  
+  free(reach->ident.entry);
+  free(reach->defn.entry);
+  free(reach->stack);
+  free(reach);
+  
+} /* end m2c_release_reachability */
+
+
+/* *********************************************************************** *
+ * P R I V A T E   F U N C T I O N S                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private macro KEY_HASH(key)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for address key.
+ * ----------------------------------------------------------------------- */
+
+#define KEY_HASH(_key) \
+  ((uint_t) ((((uintptr_t) (_key)) >> 3) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private function init_table(table)
+ * --------------------------------------------------------------------------
+ * Allocates an empty table.  Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool init_table (table_t *table) {
+  
+  table->entry = calloc(TABLE_INITIAL_CAPACITY, sizeof(entry_t));
+  table->count = 0;
+  table->capacity = TABLE_INITIAL_CAPACITY;
+  
+  return (table->entry != NULL);
+} /* end init_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_lookup(table, key)
+ * --------------------------------------------------------------------------
+ * Returns the entry of table for key,  or NULL if key is not in table.
+ * ----------------------------------------------------------------------- */
+
+static entry_t *table_lookup (table_t *table, const void *key) {
+  
+  uint_t mask, index;
+  
+  if (key == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  index = KEY_HASH(key) & mask;
+  
+  while (table->entry[index].key != NULL) {
+    if (table->entry[index].key == key) {
+      return &table->entry[index];
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end table_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * private function table_insert(table, key)
+ * --------------------------------------------------------------------------
+ * Returns the entry of table for key,  entering a cleared entry if key is
+ * not yet in table.  The table is doubled when it becomes three quarters
+ * full.  Returns NULL if the table could not be enlarged.
+ * ----------------------------------------------------------------------- */
+
+static entry_t *table_insert (table_t *table, const void *key) {
+  
+  uint_t new_capacity, mask, index, slot;
+  entry_t *entry, *new_entry;
+  
+  entry = table_lookup(table, key);
+  
+  if (entry != NULL) {
+    return entry;
+  } /* end if */
+  
+  if ((4 * (table->count + 1)) > (3 * table->capacity)) {
+    new_capacity = 2 * table->capacity;
+    new_entry = calloc(new_capacity, sizeof(entry_t));
+  
+    if (new_entry == NULL) {
+      return NULL;
+    } /* end if */
+  
+    mask = new_capacity - 1;
+  
+    for (index = 0; index < table->capacity; index++) {
+      if (table->entry[index].key != NULL) {
+        slot = KEY_HASH(table->entry[index].key) & mask;
+  
+        while (new_entry[slot].key != NULL) {
+          slot = (slot + 1) & mask;
+        } /* end while */
+  
+        new_entry[slot] = table->entry[index];
+      } /* end if */
+    } /* end for */
+  
+    free(table->entry);
+    table->entry = new_entry;
+    table->capacity = new_capacity;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  index = KEY_HASH(key) & mask;
+  
+  while (table->entry[index].key != NULL) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  table->entry[index].key = key;
+  table->entry[index].defn = NULL;
+  table->entry[index].marked = false;
+  table->count++;
+  
+  return &table->entry[index];
+} /* end table_insert */
+
+
+/* --------------------------------------------------------------------------
+ * private function module_node(ast)
+ * --------------------------------------------------------------------------
+ * Returns the module node of ast,  unwrapping a FILE node if present.
+ *
+ * astnode: (FILE (FNAME "Foobar.mod") (KEY 0xF04FC729) moduleNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t module_node (m2c_astnode_t ast) {
+  
+  if (m2c_ast_nodetype(ast) == AST_FILE) {
+    return m2c_ast_subnode_at_index(ast, 2);
+  } /* end if */
+  
+  return ast;
+} /* end module_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function defn_of(node)
+ * --------------------------------------------------------------------------
+ * Returns the definition node of node,  unwrapping a DECL node if present.
+ *
+ * astnode: (DECL (DECLKEY 0x3A7E01C2) declNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t defn_of (m2c_astnode_t node) {
+  
+  if (m2c_ast_nodetype(node) == AST_DECL) {
+    return m2c_ast_subnode_at_index(node, 1);
+  } /* end if */
+  
+  return node;
+} /* end defn_of */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure apply_handler(reach, node, defn, handler)
+ * --------------------------------------------------------------------------
+ * Calls handler for the identifier of IDENT node node  or for each of the
+ * identifiers of IDENTLIST node node,  passing defn as their definition.
+ *
+ * astnode: (IDENT ident) | (IDENTLIST ident0 ident1 ident2 ... identN)
+ * ----------------------------------------------------------------------- */
+
+static void apply_handler
+  (m2c_reachability_t reach, m2c_astnode_t node,
+   m2c_astnode_t defn, ident_handler_f handler) {
+  
+  unsigned short index, count;
+  
+  if (m2c_ast_nodetype(node) == AST_IDENT) {
+    handler(reach, m2c_ast_value(node), defn);
+  }
+  else if (m2c_ast_nodetype(node) == AST_IDENTLIST) {
+    count = m2c_ast_subnode_count(node);
+  
+    for (index = 0; index < count; index++) {
+      handler(reach, m2c_ast_value_at_index(node, index), defn);
+    } /* end for */
+  } /* end if */
+} /* end apply_handler */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure defined_idents(reach, defn, handler)
+ * --------------------------------------------------------------------------
+ * Calls handler for each identifier defined by definition defn,  including
+ * the values of enumeration types.
+ *
+ * astnode: (CONST bindNode (IDENT constId) typeNode exprNode)
+ *
+ * astnode: (TYPEDEF (IDENT typeId) typeNode)
+ *   with typeNode: (ENUM baseType (IDENTLIST value0 ... valueN))
+ *
+ * astnode: (VARDEF (IDENTLIST ident0 ... identN) typeNode)
+ *
+ * astnode: (PROC (PROCDECL bindSpecNode signatureNode) blockNode)
+ *
+ * astnode: (PROCDECL bindSpecNode (PSIG (IDENT procId) fparams retType))
+ * ----------------------------------------------------------------------- */
+
+static void defined_idents
+  (m2c_reachability_t reach, m2c_astnode_t defn, ident_handler_f handler) {
+  
+  m2c_astnode_t node;
+  
+  switch (m2c_ast_nodetype(defn)) {
+    case AST_CONST :
+      node = m2c_ast_subnode_at_index(defn, 1);
+      break;
+  
+    case AST_TYPEDEF :
+      node = m2c_ast_subnode_at_index(defn, 1);
+  
+      if (m2c_ast_nodetype(node) == AST_ENUM) {
+        apply_handler(reach, m2c_ast_subnode_at_index(node, 1), defn, handler);
+      } /* end if */
+  
+      node = m2c_ast_subnode_at_index(defn, 0);
+      break;
+  
+    case AST_VARDEF :
+      node = m2c_ast_subnode_at_index(defn, 0);
+      break;
+  
+    case AST_PROC :
+      node = m2c_ast_subnode_at_index(defn, 0);
+      node = m2c_ast_subnode_at_index(node, 1);
+      node = m2c_ast_subnode_at_index(node, 0);
+      break;
+  
+    case AST_PROCDECL :
+      node = m2c_ast_subnode_at_index(defn, 1);
+      node = m2c_ast_subnode_at_index(node, 0);
+      break;
+  
+    default :
+      return;
+  } /* end switch */
+  
+  apply_handler(reach, node, defn, handler);
+  
+} /* end defined_idents */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure visit_defns(reach, list, handler)
+ * --------------------------------------------------------------------------
+ * Calls handler for each identifier defined by the definitions of list.
+ *
+ * astnode: (DEFNLIST defnNode0 ... defnNodeN)
+ *
+ * astnode: (CONSTDEFLIST (DECL key (CONST bind constId typeId expr)) ...)
+ * ----------------------------------------------------------------------- */
+
+static void visit_defns
+  (m2c_reachability_t reach, m2c_astnode_t list, ident_handler_f handler) {
+  
+  m2c_astnode_t item;
+  unsigned short index, count, sub_index, sub_count;
+  
+  count = m2c_ast_subnode_count(list);
+  
+  for (index = 0; index < count; index++) {
+    item = defn_of(m2c_ast_subnode_at_index(list, index));
+  
+    switch (m2c_ast_nodetype(item)) {
+      case AST_CONSTDEFLIST :
+      case AST_TYPEDEFLIST :
+      case AST_VARDEFLIST :
+        sub_count = m2c_ast_subnode_count(item);
+  
+        for (sub_index = 0; sub_index < sub_count; sub_index++) {
+          defined_idents(reach,
+            defn_of(m2c_ast_subnode_at_index(item, sub_index)), handler);
+        } /* end for */
+        break;
+  
+      default :
+        defined_idents(reach, item, handler);
+        break;
+    } /* end switch */
+  } /* end for */
+} /* end visit_defns */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure mark_defn(reach, defn)
+ * --------------------------------------------------------------------------
+ * Marks defn reachable and pushes it onto the work stack unless it is not
+ * a module level definition or has been marked already.  The stack grows by
+ * doubling.  If it cannot be enlarged,  the analysis turns conservative.
+ * ----------------------------------------------------------------------- */
+
+static void mark_defn (m2c_reachability_t reach, m2c_astnode_t defn) {
+  
+  entry_t *entry;
+  m2c_astnode_t *new_stack;
+  uint_t new_capacity;
+  
+  entry = table_lookup(&reach->defn, defn);
+  
+  if ((entry == NULL) || (entry->marked)) {
+    return;
+  } /* end if */
+  
+  entry->marked = true;
+  reach->marked_count++;
+  
+  if (reach->stack_count == reach->stack_capacity) {
+    new_capacity = (reach->stack_capacity == 0) ?
+      TABLE_INITIAL_CAPACITY : 2 * reach->stack_capacity;
+    new_stack =
+      realloc(reach->stack, new_capacity * sizeof(m2c_astnode_t));
+  
+    if (new_stack == NULL) {
+      reach->conservative = true;
+      return;
+    } /* end if */
+  
+    reach->stack = new_stack;
+    reach->stack_capacity = new_capacity;
+  } /* end if */
+  
+  reach->stack[reach->stack_count] = defn;
+  reach->stack_count++;
+  
+} /* end mark_defn */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure mark_ident(reach, ident)
+ * --------------------------------------------------------------------------
+ * Marks the module level definition of ident reachable,  if any.
+ * ----------------------------------------------------------------------- */
+
+static void mark_ident (m2c_reachability_t reach, intstr_t ident) {
+  
+  entry_t *entry;
+  
+  entry = table_lookup(&reach->ident, ident);
+  
+  if (entry != NULL) {
+    mark_defn(reach, entry->defn);
+  } /* end if */
+} /* end mark_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure bind_ident(reach, ident, defn)
+ * --------------------------------------------------------------------------
+ * Binds ident to module level definition defn.  Procedures bound to built-in
+ * syntax are marked,  they are called implicitly.  Should ident be defined
+ * more than once,  all its definitions are marked.  If a table cannot be
+ * enlarged,  the analysis turns conservative.
+ *
+ * astnode: (PROC (PROCDECL bindSpecNode signatureNode) blockNode)
+ * ----------------------------------------------------------------------- */
+
+static void bind_ident
+  (m2c_reachability_t reach, intstr_t ident, m2c_astnode_t defn) {
+  
+  entry_t *entry;
+  m2c_astnode_t bind_node;
+  
+  if ((ident == NULL) || (table_insert(&reach->defn, defn) == NULL)) {
+    reach->conservative = true;
+    return;
+  } /* end if */
+  
+  entry = table_insert(&reach->ident, ident);
+  
+  if (entry == NULL) {
+    reach->conservative = true;
+    return;
+  }
+  else if (entry->defn == NULL) {
+    entry->defn = defn;
+  }
+  else if (entry->defn != defn) {
+    /* duplicate definition, keep both */
+    mark_defn(reach, entry->defn);
+    mark_defn(reach, defn);
+  } /* end if */
+  
+  if (m2c_ast_nodetype(defn) == AST_PROC) {
+    bind_node = m2c_ast_subnode_at_index(defn, 0);
+    bind_node = m2c_ast_subnode_at_index(bind_node, 0);
+  
+    if (m2c_ast_nodetype(bind_node) == AST_BINDTO) {
+      mark_defn(reach, defn);
+    } /* end if */
+  } /* end if */
+} /* end bind_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure mark_export(reach, ident, defn)
+ * --------------------------------------------------------------------------
+ * Marks the module level definition of exported identifier ident.  Defn is
+ * the definition of ident in the interface module and is ignored.
+ * ----------------------------------------------------------------------- */
+
+static void mark_export
+  (m2c_reachability_t reach, intstr_t ident, m2c_astnode_t defn) {
+  
+  (void) defn;
+  
+  mark_ident(reach, ident);
+  
+} /* end mark_export */
+
+
+/* --------------------------------------------------------------------------
+ * private function mark_ref(node, reach)
+ * --------------------------------------------------------------------------
+ * Visitor callback to mark the definitions of the identifiers referenced by
+ * node.  Only the first component of a qualified identifier can refer to a
+ * module level definition,  such as an enumeration type or record variable.
+ * An unparsed lazy body hides its references,  the analysis turns
+ * conservative and the traversal stops.
+ *
+ * astnode: (IDENT ident) | (QUALIDENT q0 q1 q2 ... qN ident)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t mark_ref (m2c_astnode_t node, void *reach) {
+  
+  m2c_reachability_t r = (m2c_reachability_t) reach;
+  unsigned short index, count;
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_IDENT :
+    case AST_QUALIDENT :
+      mark_ident(r, m2c_ast_value(node));
+      break;
+  
+    case AST_IDENTLIST :
+      count = m2c_ast_subnode_count(node);
+  
+      for (index = 0; index < count; index++) {
+        mark_ident(r, m2c_ast_value_at_index(node, index));
+      } /* end for */
+      break;
+  
+    case AST_LAZYBODY :
+      r->conservative = true;
+      return M2C_AST_VISIT_STOP;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end mark_ref */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure mark_refs(reach, node)
+ * --------------------------------------------------------------------------
+ * Marks the definitions of all identifiers referenced in the subtree of
+ * node.  If the subtree cannot be traversed,  the analysis turns
+ * conservative.
+ * ----------------------------------------------------------------------- */
+
+static void mark_refs (m2c_reachability_t reach, m2c_astnode_t node) {
+  
+  if (NOT(m2c_ast_visit(node, mark_ref, NULL, reach))) {
+    reach->conservative = true;
+  } /* end if */
+  
+} /* end mark_refs */
+
+
+/* END OF FILE */
@@ -0,0 +1,918 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-refcount.c                                                            *
+ *                                                                           *
+ * Implementation of analysis and translation of reference count updates.    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-refcount.h"
+#include "m2c-ast-nodetype.h"
+#include "interned-strings.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type mode_entry_t
+ * --------------------------------------------------------------------------
+ * Entry of the refcount table,  holding the disposition of the statement at
+ * index in statement sequence seq.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_astnode_t seq;
+  uint_t index;
+  m2c_refcount_mode_t mode;
+} mode_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_refcount_table_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a refcount table.  The table uses open
+ * addressing with linear probing,  its capacity is a power of two.
+ * ----------------------------------------------------------------------- */
+
+#define REFCOUNT_TABLE_INITIAL_CAPACITY 64
+
+struct m2c_refcount_table_struct_t {
+  mode_entry_t *entry;
+  uint_t count;
+  uint_t capacity;
+};
+
+typedef struct m2c_refcount_table_struct_t m2c_refcount_table_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type candidate_t
+ * --------------------------------------------------------------------------
+ * A local variable that is the target of NEW,  with the number of its uses
+ * and the number of those uses that do not let its value escape.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  intstr_t ident;
+  uint_t use_count;
+  uint_t confined_count;
+} candidate_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type analysis_t
+ * --------------------------------------------------------------------------
+ * Context of the analysis of a procedure body.
+ * ----------------------------------------------------------------------- */
+
+#define CANDIDATES_INITIAL_CAPACITY 8
+
+typedef struct {
+  m2c_refcount_table_t table;
+  m2c_local_predicate_f is_local;
+  void *context;
+  candidate_t *candidate;
+  uint_t candidate_count;
+  uint_t candidate_capacity;
+  uint_t result;
+} analysis_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t collect_candidates
+  (m2c_astnode_t node, void *analysis);
+
+static m2c_ast_visit_action_t count_uses
+  (m2c_astnode_t node, void *analysis);
+
+static m2c_ast_visit_action_t analyse_stmt_seq
+  (m2c_astnode_t node, void *analysis);
+
+static bool is_cancellable
+  (m2c_astnode_t stmt_seq, uint_t retain_index, uint_t release_index);
+
+static bool is_transparent (m2c_astnode_t stmt, m2c_astnode_t desig);
+
+static candidate_t *lookup_candidate
+  (analysis_t *analysis, m2c_astnode_t node);
+
+static bool is_new_statement (m2c_astnode_t node);
+
+static bool is_refcount_statement (m2c_astnode_t node);
+
+static m2c_astnode_t head_ident (m2c_astnode_t desig);
+
+static bool mentions_ident (m2c_astnode_t tree, m2c_astnode_t ident);
+
+static bool contains_call (m2c_astnode_t tree);
+
+static bool same_tree (m2c_astnode_t tree1, m2c_astnode_t tree2);
+
+static void store_mode
+  (m2c_refcount_table_t table, m2c_astnode_t seq, uint_t index,
+   m2c_refcount_mode_t mode);
+
+static mode_entry_t *lookup_entry
+  (m2c_refcount_table_t table, m2c_astnode_t seq, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_refcount_table()
+ * --------------------------------------------------------------------------
+ * Returns a new empty refcount table,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_refcount_table_t m2c_new_refcount_table (void) {
+  
+  m2c_refcount_table_t table;
+  
+  table = malloc(sizeof(m2c_refcount_table_struct_t));
+  
+  if (table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  table->entry =
+    calloc(REFCOUNT_TABLE_INITIAL_CAPACITY, sizeof(mode_entry_t));
+  
+  if (table->entry == NULL) {
+    free(table);
+    return NULL;
+  } /* end if */
+  
+  table->count = 0;
+  table->capacity = REFCOUNT_TABLE_INITIAL_CAPACITY;
+  
+  return table;
+} /* end m2c_new_refcount_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_analyse_refcounts(table, body, is_local, context)
+ * --------------------------------------------------------------------------
+ * Analyses the RETAIN and RELEASE statements of procedure body body  and
+ * enters their dispositions into table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_analyse_refcounts
+  (m2c_refcount_table_t table,              /* in */
+   m2c_astnode_t body,                      /* in */
+   m2c_local_predicate_f is_local,          /* in */
+   void *context) {                         /* in */
+  
+  analysis_t analysis;
+  
+  if ((table == NULL) || (body == NULL) || (is_local == NULL)) {
+    return 0;
+  } /* end if */
+  
+  analysis.table = table;
+  analysis.is_local = is_local;
+  analysis.context = context;
+  analysis.candidate = NULL;
+  analysis.candidate_count = 0;
+  analysis.candidate_capacity = 0;
+  analysis.result = 0;
+  
+  /* find local targets of NEW,  then count their escaping uses */
+  m2c_ast_visit(body, collect_candidates, NULL, &analysis);
+  
+  if (analysis.candidate_count > 0) {
+    m2c_ast_visit(body, count_uses, NULL, &analysis);
+  } /* end if */
+  
+  /* cancel pairs and enter dispositions per statement sequence */
+  m2c_ast_visit(body, analyse_stmt_seq, NULL, &analysis);
+  
+  free(analysis.candidate);
+  
+  return analysis.result;
+} /* end m2c_analyse_refcounts */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_refcount_mode(table, stmt_seq, index)
+ * --------------------------------------------------------------------------
+ * Returns the disposition of the statement at index in stmt_seq.
+ * ----------------------------------------------------------------------- */
+
+m2c_refcount_mode_t m2c_refcount_mode
+  (m2c_refcount_table_t table, m2c_astnode_t stmt_seq, uint_t index) {
+  
+  mode_entry_t *entry;
+  
+  if ((table == NULL) || (stmt_seq == NULL)) {
+    return M2C_REFCOUNT_ATOMIC;
+  } /* end if */
+  
+  entry = lookup_entry(table, stmt_seq, index);
+  
+  if (entry == NULL) {
+    return M2C_REFCOUNT_ATOMIC;
+  } /* end if */
+  
+  return entry->mode;
+} /* end m2c_refcount_mode */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_refcount_update(outfile, table, stmt_seq, index, ...)
+ * --------------------------------------------------------------------------
+ * Writes the translation of the RETAIN or RELEASE statement at index in
+ * stmt_seq by its disposition.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_refcount_update
+  (outfile_t outfile,                       /* in */
+   m2c_refcount_table_t table,              /* in */
+   m2c_astnode_t stmt_seq,                  /* in */
+   uint_t index,                            /* in */
+   m2c_refcount_node_writer_f writer,       /* in */
+   void *context) {                         /* in */
+  
+  m2c_astnode_t stmt;
+  m2c_refcount_mode_t mode;
+  bool retain;
+  
+  if ((outfile == NULL) || (stmt_seq == NULL) || (writer == NULL)) {
+    return;
+  } /* end if */
+  
+  stmt = m2c_ast_subnode_at_index(stmt_seq, index);
+  
+  if (NOT(is_refcount_statement(stmt))) {
+    return;
+  } /* end if */
+  
+  mode = m2c_refcount_mode(table, stmt_seq, index);
+  
+  if (mode == M2C_REFCOUNT_ELIDED) {
+    return;
+  } /* end if */
+  
+  retain = (m2c_ast_nodetype(stmt) == AST_RETAIN);
+  
+  if (mode == M2C_REFCOUNT_PLAIN) {
+    outfile_write_chars(outfile,
+      (retain ? "M2C_RETAIN_LOCAL(" : "M2C_RELEASE_LOCAL("));
+  }
+  else /* atomic */ {
+    outfile_write_chars(outfile, (retain ? "M2C_RETAIN(" : "M2C_RELEASE("));
+  } /* end if */
+  
+  writer(outfile, m2c_ast_subnode_at_index(stmt, 0), context);
+  outfile_write_chars(outfile, ");");
+} /* end m2c_write_refcount_update */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_refcount_table(table)
+ * --------------------------------------------------------------------------
+ * Deallocates table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_refcount_table (m2c_refcount_table_t table) {
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  free(table->entry);
+  free(table);
+} /* end m2c_release_refcount_table */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function collect_candidates(node, analysis)
+ * --------------------------------------------------------------------------
+ * Visitor callback.  Enters the target of a NEW statement as a candidate if
+ * it is an identifier that denotes a local variable.  If the candidate list
+ * cannot be enlarged,  the target is not entered and keeps atomic updates.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t collect_candidates
+  (m2c_astnode_t node, void *analysis) {
+  
+  analysis_t *this_analysis = (analysis_t *) analysis;
+  m2c_astnode_t target;
+  candidate_t *new_candidate;
+  uint_t new_capacity;
+  
+  if (NOT(is_new_statement(node))) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  target = m2c_ast_subnode_at_index(node, 0);
+  
+  if ((m2c_ast_nodetype(target) != AST_IDENT) ||
+      (lookup_candidate(this_analysis, target) != NULL) ||
+      NOT(this_analysis->is_local(target, this_analysis->context))) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  if (this_analysis->candidate_count == this_analysis->candidate_capacity) {
+    if (this_analysis->candidate_capacity == 0) {
+      new_capacity = CANDIDATES_INITIAL_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * this_analysis->candidate_capacity;
+    } /* end if */
+  
+    new_candidate = realloc(this_analysis->candidate,
+      new_capacity * sizeof(candidate_t));
+  
+    if (new_candidate == NULL) {
+      return M2C_AST_VISIT_CONTINUE;
+    } /* end if */
+  
+    this_analysis->candidate = new_candidate;
+    this_analysis->candidate_capacity = new_capacity;
+  } /* end if */
+  
+  new_candidate = &this_analysis->candidate[this_analysis->candidate_count];
+  new_candidate->ident = m2c_ast_value(target);
+  new_candidate->use_count = 0;
+  new_candidate->confined_count = 0;
+  this_analysis->candidate_count++;
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end collect_candidates */
+
+
+/* --------------------------------------------------------------------------
+ * private function count_uses(node, analysis)
+ * --------------------------------------------------------------------------
+ * Visitor callback.  Counts every use of a candidate and those uses that do
+ * not let its value escape:  as the designator of NEW,  RETAIN or RELEASE
+ * and as the head of a dereference,  selection or subscript.  A candidate
+ * is confined if all its uses are of these kinds.  As the parent is visited
+ * before its subnodes,  subtrees shared by hash-consing are counted once
+ * per parent.
+ *
+ * astnodes:
+ *  (DESIG identNode tailNode) | (DEREF identNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t count_uses
+  (m2c_astnode_t node, void *analysis) {
+  
+  analysis_t *this_analysis = (analysis_t *) analysis;
+  candidate_t *candidate;
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_IDENT :
+      candidate = lookup_candidate(this_analysis, node);
+      if (candidate != NULL) {
+        candidate->use_count++;
+      } /* end if */
+      break;
+  
+    case AST_NEW :
+    case AST_NEWARG :
+    case AST_NEWCAP :
+    case AST_RETAIN :
+    case AST_RELEASE :
+    case AST_DESIG :
+    case AST_DEREF :
+      candidate =
+        lookup_candidate(this_analysis, m2c_ast_subnode_at_index(node, 0));
+      if (candidate != NULL) {
+        candidate->confined_count++;
+      } /* end if */
+      break;
+  
+    default :
+      break;
+  } /* end switch */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end count_uses */
+
+
+/* --------------------------------------------------------------------------
+ * private function analyse_stmt_seq(node, analysis)
+ * --------------------------------------------------------------------------
+ * Visitor callback.  For a statement sequence,  cancels each RETAIN with a
+ * following RELEASE of the same designator where permitted,  then enters
+ * the disposition of each remaining RETAIN and RELEASE statement.
+ *
+ * astnode: (STMTSEQ stmtNode+)
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t analyse_stmt_seq
+  (m2c_astnode_t node, void *analysis) {
+  
+  analysis_t *this_analysis = (analysis_t *) analysis;
+  m2c_astnode_t stmt, desig;
+  uint_t index, match, count;
+  candidate_t *candidate;
+  bool *elided;
+  
+  if (m2c_ast_nodetype(node) != AST_STMTSEQ) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(node);
+  elided = calloc(count, sizeof(bool));
+  
+  if (elided == NULL) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  /* cancel pairs */
+  for (index = 0; index < count; index++) {
+    stmt = m2c_ast_subnode_at_index(node, index);
+  
+    if ((m2c_ast_nodetype(stmt) != AST_RETAIN) || (elided[index])) {
+      continue;
+    } /* end if */
+  
+    for (match = index + 1; match < count; match++) {
+      if (m2c_ast_nodetype(m2c_ast_subnode_at_index(node, match)) ==
+          AST_RELEASE) {
+        break;
+      } /* end if */
+    } /* end for */
+  
+    if ((match < count) && NOT(elided[match]) &&
+        is_cancellable(node, index, match)) {
+      elided[index] = true;
+      elided[match] = true;
+    } /* end if */
+  } /* end for */
+  
+  /* enter dispositions */
+  for (index = 0; index < count; index++) {
+    stmt = m2c_ast_subnode_at_index(node, index);
+  
+    if (NOT(is_refcount_statement(stmt))) {
+      continue;
+    } /* end if */
+  
+    if (elided[index]) {
+      store_mode(this_analysis->table, node, index, M2C_REFCOUNT_ELIDED);
+      this_analysis->result++;
+      continue;
+    } /* end if */
+  
+    desig = m2c_ast_subnode_at_index(stmt, 0);
+    candidate = lookup_candidate(this_analysis, desig);
+  
+    if ((m2c_ast_nodetype(desig) == AST_IDENT) && (candidate != NULL) &&
+        (candidate->use_count == candidate->confined_count)) {
+      store_mode(this_analysis->table, node, index, M2C_REFCOUNT_PLAIN);
+      this_analysis->result++;
+    }
+    else {
+      store_mode(this_analysis->table, node, index, M2C_REFCOUNT_ATOMIC);
+    } /* end if */
+  } /* end for */
+  
+  free(elided);
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end analyse_stmt_seq */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_cancellable(stmt_seq, retain_index, release_index)
+ * --------------------------------------------------------------------------
+ * Returns true if the RETAIN and RELEASE statements at the given indices of
+ * stmt_seq are of the same designator and all statements in between are
+ * transparent to it,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_cancellable
+  (m2c_astnode_t stmt_seq, uint_t retain_index, uint_t release_index) {
+  
+  m2c_astnode_t retain, release, desig;
+  uint_t index;
+  
+  retain = m2c_ast_subnode_at_index(stmt_seq, retain_index);
+  release = m2c_ast_subnode_at_index(stmt_seq, release_index);
+  desig = m2c_ast_subnode_at_index(retain, 0);
+  
+  if (NOT(same_tree(desig, m2c_ast_subnode_at_index(release, 0))) ||
+      contains_call(desig)) {
+    return false;
+  } /* end if */
+  
+  for (index = retain_index + 1; index < release_index; index++) {
+    if (NOT(is_transparent(m2c_ast_subnode_at_index(stmt_seq, index), desig))) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end is_cancellable */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_transparent(stmt, desig)
+ * --------------------------------------------------------------------------
+ * Returns true if statement stmt can neither release an object nor change
+ * the object that desig denotes,  otherwise false.  These are RETAIN and
+ * NOP,  and assignments without calls to variables desig does not depend
+ * on.  An assignment through a designator whose head is desig itself,  such
+ * as p^.next := q,  does not change p.
+ *
+ * astnodes:
+ *  (ASSIGN targetNode exprNode) | (COPY targetNode exprNode)
+ * ----------------------------------------------------------------------- */
+
+static bool is_transparent (m2c_astnode_t stmt, m2c_astnode_t desig) {
+  
+  m2c_astnode_t target, head;
+  m2c_ast_nodetype_t target_type, desig_type;
+  
+  switch (m2c_ast_nodetype(stmt)) {
+    case AST_RETAIN :
+    case AST_NOP :
+      return true;
+  
+    case AST_ASSIGN :
+    case AST_COPY :
+      if (contains_call(stmt)) {
+        return false;
+      } /* end if */
+  
+      target = m2c_ast_subnode_at_index(stmt, 0);
+      head = head_ident(target);
+  
+      if (head == NULL) {
+        return false;
+      } /* end if */
+  
+      target_type = m2c_ast_nodetype(target);
+      desig_type = m2c_ast_nodetype(desig);
+  
+      /* writes through desig do not change desig */
+      if (((desig_type == AST_IDENT) || (desig_type == AST_QUALIDENT)) &&
+          (target_type != AST_IDENT) && (target_type != AST_QUALIDENT) &&
+          (same_tree(head, desig))) {
+        return true;
+      } /* end if */
+  
+      return NOT(mentions_ident(desig, head));
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end is_transparent */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_candidate(analysis, node)
+ * --------------------------------------------------------------------------
+ * Returns the candidate for IDENT node node,  or NULL if node is not the
+ * identifier of a candidate.
+ * ----------------------------------------------------------------------- */
+
+static candidate_t *lookup_candidate
+  (analysis_t *analysis, m2c_astnode_t node) {
+  
+  intstr_t ident;
+  uint_t index;
+  
+  if ((node == NULL) || (m2c_ast_nodetype(node) != AST_IDENT)) {
+    return NULL;
+  } /* end if */
+  
+  ident = m2c_ast_value(node);
+  
+  for (index = 0; index < analysis->candidate_count; index++) {
+    if (analysis->candidate[index].ident == ident) {
+      return &analysis->candidate[index];
+    } /* end if */
+  } /* end for */
+  
+  return NULL;
+} /* end lookup_candidate */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_new_statement(node)
+ * ----------------------------------------------------------------------- */
+
+static bool is_new_statement (m2c_astnode_t node) {
+  
+  m2c_ast_nodetype_t node_type;
+  
+  node_type = m2c_ast_nodetype(node);
+  
+  return (node_type == AST_NEW) ||
+    (node_type == AST_NEWARG) || (node_type == AST_NEWCAP);
+} /* end is_new_statement */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_refcount_statement(node)
+ * ----------------------------------------------------------------------- */
+
+static bool is_refcount_statement (m2c_astnode_t node) {
+  
+  m2c_ast_nodetype_t node_type;
+  
+  if (node == NULL) {
+    return false;
+  } /* end if */
+  
+  node_type = m2c_ast_nodetype(node);
+  
+  return (node_type == AST_RETAIN) || (node_type == AST_RELEASE);
+} /* end is_refcount_statement */
+
+
+/* --------------------------------------------------------------------------
+ * private function head_ident(desig)
+ * --------------------------------------------------------------------------
+ * Returns the identifier at the head of designator desig,  or NULL if it
+ * has none.
+ *
+ * astnodes:
+ *  identNode | (DESIG identNode tailNode) | (DEREF desigNode)
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t head_ident (m2c_astnode_t desig) {
+  
+  while (desig != NULL) {
+    switch (m2c_ast_nodetype(desig)) {
+      case AST_IDENT :
+      case AST_QUALIDENT :
+        return desig;
+  
+      case AST_DESIG :
+      case AST_DEREF :
+        desig = m2c_ast_subnode_at_index(desig, 0);
+        break;
+  
+      default :
+        return NULL;
+    } /* end switch */
+  } /* end while */
+  
+  return NULL;
+} /* end head_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function mentions_ident(tree, ident)
+ * --------------------------------------------------------------------------
+ * Returns true if the tree rooted at tree contains identifier ident.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_astnode_t ident;
+  bool found;
+} ident_search_t;
+
+static m2c_ast_visit_action_t find_ident (m2c_astnode_t node, void *search) {
+  
+  ident_search_t *this_search = (ident_search_t *) search;
+  
+  if (same_tree(node, this_search->ident)) {
+    this_search->found = true;
+    return M2C_AST_VISIT_STOP;
+  } /* end if */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end find_ident */
+
+static bool mentions_ident (m2c_astnode_t tree, m2c_astnode_t ident) {
+  
+  ident_search_t search;
+  
+  search.ident = ident;
+  search.found = false;
+  
+  /* if the traversal fails for want of memory,  assume a mention */
+  if (NOT(m2c_ast_visit(tree, find_ident, NULL, &search))) {
+    return true;
+  } /* end if */
+  
+  return search.found;
+} /* end mentions_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function contains_call(tree)
+ * --------------------------------------------------------------------------
+ * Returns true if the tree rooted at tree contains a function call.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t find_call (m2c_astnode_t node, void *found) {
+  
+  if (m2c_ast_nodetype(node) == AST_FCALL) {
+    *((bool *) found) = true;
+    return M2C_AST_VISIT_STOP;
+  } /* end if */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end find_call */
+
+static bool contains_call (m2c_astnode_t tree) {
+  
+  bool found = false;
+  
+  /* if the traversal fails for want of memory,  assume a call */
+  if (NOT(m2c_ast_visit(tree, find_call, NULL, &found))) {
+    return true;
+  } /* end if */
+  
+  return found;
+} /* end contains_call */
+
+
+/* --------------------------------------------------------------------------
+ * private function same_tree(tree1, tree2)
+ * --------------------------------------------------------------------------
+ * Returns true if the trees rooted at tree1 and tree2 are structurally
+ * identical,  otherwise false.  Designators are shallow,  the recursion
+ * depth is that of the trees.
+ * ----------------------------------------------------------------------- */
+
+static bool same_tree (m2c_astnode_t tree1, m2c_astnode_t tree2) {
+  
+  unsigned short index, count;
+  m2c_ast_nodetype_t node_type;
+  
+  if (tree1 == tree2) {
+    return true;
+  } /* end if */
+  
+  if ((tree1 == NULL) || (tree2 == NULL)) {
+    return false;
+  } /* end if */
+  
+  node_type = m2c_ast_nodetype(tree1);
+  count = m2c_ast_subnode_count(tree1);
+  
+  if ((node_type != m2c_ast_nodetype(tree2)) ||
+      (count != m2c_ast_subnode_count(tree2))) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    if (node_type >= AST_FIRST_TERMINAL) {
+      if (m2c_ast_value_at_index(tree1, index) !=
+          m2c_ast_value_at_index(tree2, index)) {
+        return false;
+      } /* end if */
+    }
+    else if (NOT(same_tree(m2c_ast_subnode_at_index(tree1, index),
+        m2c_ast_subnode_at_index(tree2, index)))) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end same_tree */
+
+
+/* --------------------------------------------------------------------------
+ * private macro ENTRY_HASH(seq, index)
+ * --------------------------------------------------------------------------
+ * Returns a hash value for the position index in statement sequence seq.
+ * ----------------------------------------------------------------------- */
+
+#define ENTRY_HASH(_seq, _index) \
+  ((uint_t) (((((uintptr_t) (_seq)) >> 3) + (_index)) * 2654435761u))
+
+
+/* --------------------------------------------------------------------------
+ * private procedure store_mode(table, seq, index, mode)
+ * --------------------------------------------------------------------------
+ * Enters mode as the disposition of the statement at index in seq.  If a
+ * different disposition is already entered,  M2C_REFCOUNT_ATOMIC is entered
+ * instead.  The table is doubled when it becomes three quarters full.  If
+ * it cannot be enlarged,  the disposition is not entered.
+ * ----------------------------------------------------------------------- */
+
+static void store_mode
+  (m2c_refcount_table_t table, m2c_astnode_t seq, uint_t index,
+   m2c_refcount_mode_t mode) {
+  
+  uint_t mask, slot, old_slot, new_capacity;
+  mode_entry_t *entry, *new_entry;
+  
+  entry = lookup_entry(table, seq, index);
+  
+  if (entry != NULL) {
+    if (entry->mode != mode) {
+      entry->mode = M2C_REFCOUNT_ATOMIC;
+    } /* end if */
+    return;
+  } /* end if */
+  
+  if ((4 * (table->count + 1)) > (3 * table->capacity)) {
+    new_capacity = 2 * table->capacity;
+    new_entry = calloc(new_capacity, sizeof(mode_entry_t));
+  
+    if (new_entry == NULL) {
+      return;
+    } /* end if */
+  
+    mask = new_capacity - 1;
+    for (old_slot = 0; old_slot < table->capacity; old_slot++) {
+      if (table->entry[old_slot].seq != NULL) {
+        slot = ENTRY_HASH(table->entry[old_slot].seq,
+          table->entry[old_slot].index) & mask;
+  
+        while (new_entry[slot].seq != NULL) {
+          slot = (slot + 1) & mask;
+        } /* end while */
+  
+        new_entry[slot] = table->entry[old_slot];
+      } /* end if */
+    } /* end for */
+  
+    free(table->entry);
+    table->entry = new_entry;
+    table->capacity = new_capacity;
+  } /* end if */
+  
+  mask = table->capacity - 1;
+  slot = ENTRY_HASH(seq, index) & mask;
+  
+  while (table->entry[slot].seq != NULL) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  table->entry[slot].seq = seq;
+  table->entry[slot].index = index;
+  table->entry[slot].mode = mode;
+  table->count++;
+} /* end store_mode */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_entry(table, seq, index)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the entry for index in seq,  or NULL if there is
+ * none.  The pointer is valid until the next entry is stored.
+ * ----------------------------------------------------------------------- */
+
+static mode_entry_t *lookup_entry
+  (m2c_refcount_table_t table, m2c_astnode_t seq, uint_t index) {
+  
+  uint_t mask, slot;
+  
+  mask = table->capacity - 1;
+  slot = ENTRY_HASH(seq, index) & mask;
+  
+  while (table->entry[slot].seq != NULL) {
+    if ((table->entry[slot].seq == seq) &&
+        (table->entry[slot].index == index)) {
+      return &table->entry[slot];
+    } /* end if */
+  
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end lookup_entry */
+
+/* END OF FILE */
@@ -0,0 +1,916 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-remote-cache.c                                                        *
+ *                                                                           *
+ * Implementation of remote compile cache module.                            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* getaddrinfo */
+#endif
+
+#include "m2c-remote-cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select the socket based HTTP backend and detached uploads on POSIX hosts
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_REMOTE_CACHE_SOCKETS)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_REMOTE_CACHE_SOCKETS 1
+#else
+#define M2C_REMOTE_CACHE_SOCKETS 0
+#endif
+#endif
+
+#if (M2C_REMOTE_CACHE_SOCKETS)
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Maximum size of HTTP request and response headers
+ * ----------------------------------------------------------------------- */
+
+#define HTTP_HEADER_SIZE 4096
+
+
+/* --------------------------------------------------------------------------
+ * Size of the buffer for transferring blob contents
+ * ----------------------------------------------------------------------- */
+
+#define HTTP_BUFFER_SIZE 65536
+
+
+/* --------------------------------------------------------------------------
+ * Suffix of outputs staged while they are fetched
+ * ----------------------------------------------------------------------- */
+
+#define STAGING_SUFFIX ".remote"
+
+
+/* --------------------------------------------------------------------------
+ * type http_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the context of an HTTP backend.  Field prefix holds the
+ * path of the URL without trailing slash,  possibly empty.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* host */    char *host;
+  /* port */    char *port;
+  /* prefix */  char *prefix;
+} http_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool http_get
+  (void *context, const char *name, const char *path,
+   m2c_remote_status_t *status);
+
+static bool http_put
+  (void *context, const char *name, const char *path,
+   m2c_remote_status_t *status);
+
+static void http_release (void *context);
+
+static char *new_substring (const char *start, size_t length);
+
+static char *new_staging_path (const char *path);
+
+#if (M2C_REMOTE_CACHE_SOCKETS)
+static int http_connect
+  (const http_context_t *http, m2c_remote_status_t *status);
+
+static bool send_all (int socket_fd, const char *data, size_t length);
+
+static int read_response_header
+  (int socket_fd, char *buffer, size_t *length, size_t *body_start);
+#endif
+
+static void upload_outputs
+  (const m2c_remote_backend_t *backend,
+   const char *cache_dir,
+   const m2c_cache_key_t *key,
+   const bool outputs[]);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_remote_http_backend(url, backend, status)
+ * --------------------------------------------------------------------------
+ * Initialises backend as an HTTP backend for the remote cache at url.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_remote_http_backend
+  (const char *url,
+   m2c_remote_backend_t *backend,
+   m2c_remote_status_t *status) {
+  
+  const char *host_start, *host_end, *path_start;
+  http_context_t *http;
+  size_t path_length;
+  
+  /* check pre-conditions */
+  if ((url == NULL) || (backend == NULL)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+#if (M2C_REMOTE_CACHE_SOCKETS)
+  /* http://host[:port][/path] */
+  if (strncmp(url, "http://", 7) != 0) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_INVALID_URL);
+    return false;
+  } /* end if */
+  
+  host_start = url + 7;
+  path_start = strchr(host_start, '/');
+  if (path_start == NULL) {
+    path_start = host_start + strlen(host_start);
+  } /* end if */
+  
+  host_end = memchr(host_start, ':', (size_t) (path_start - host_start));
+  if (host_end == NULL) {
+    host_end = path_start;
+  } /* end if */
+  
+  if ((host_end == host_start) ||
+      ((host_end != path_start) && (host_end + 1 == path_start))) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_INVALID_URL);
+    return false;
+  } /* end if */
+  
+  /* drop trailing slashes of the path */
+  path_length = strlen(path_start);
+  while ((path_length > 0) && (path_start[path_length - 1] == '/')) {
+    path_length--;
+  } /* end while */
+  
+  http = malloc(sizeof(http_context_t));
+  
+  if (http == NULL) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  http->host = new_substring(host_start, (size_t) (host_end - host_start));
+  
+  if (host_end == path_start) {
+    http->port = new_substring("80", 2);
+  }
+  else /* explicit port */ {
+    http->port = new_substring(host_end + 1,
+      (size_t) (path_start - host_end - 1));
+  } /* end if */
+  
+  http->prefix = new_substring(path_start, path_length);
+  
+  if ((http->host == NULL) || (http->port == NULL) || (http->prefix == NULL)) {
+    http_release(http);
+    SET_STATUS(status, M2C_REMOTE_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  backend->get = http_get;
+  backend->put = http_put;
+  backend->release = http_release;
+  backend->context = http;
+  
+  SET_STATUS(status, M2C_REMOTE_STATUS_SUCCESS);
+  return true;
+#else
+  (void) host_start;
+  (void) host_end;
+  (void) path_start;
+  (void) http;
+  (void) path_length;
+  SET_STATUS(status, M2C_REMOTE_STATUS_NOT_CONFIGURED);
+  return false;
+#endif
+} /* end m2c_remote_http_backend */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_remote_backend_from_env(backend, status)
+ * --------------------------------------------------------------------------
+ * Initialises backend for the URL in environment variable M2C_REMOTE_CACHE.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_remote_backend_from_env
+  (m2c_remote_backend_t *backend, m2c_remote_status_t *status) {
+  
+  const char *url;
+  
+  url = getenv(M2C_REMOTE_CACHE_URL_ENV);
+  
+  if ((url == NULL) || (url[0] == ASCII_NUL)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_NOT_CONFIGURED);
+    return false;
+  } /* end if */
+  
+  return m2c_remote_http_backend(url, backend, status);
+} /* end m2c_remote_backend_from_env */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_remote_cache_fetch(backend, cache_dir, key, output_path, ...)
+ * --------------------------------------------------------------------------
+ * Fetches outputs from the local cache,  or on a local miss,  from the
+ * remote cache of backend.  Remote outputs are first staged next to their
+ * paths,  only once all of them have arrived are they renamed into place
+ * and entered into the local cache.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_remote_cache_fetch
+  (const m2c_remote_backend_t *backend,
+   const char *cache_dir,
+   const m2c_cache_key_t *key,
+   const char *const output_path[],
+   m2c_remote_status_t *status) {
+  
+  char *staged[M2C_CACHE_OUTPUT_END_MARK], name[M2C_CACHE_BLOB_NAME_SIZE];
+  m2c_cache_status_t cache_status;
+  m2c_remote_status_t get_status;
+  uint_t index;
+  bool hit;
+  
+  /* check pre-conditions */
+  if ((backend == NULL) || (cache_dir == NULL) ||
+      (key == NULL) || (output_path == NULL)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  /* local first */
+  if (m2c_cache_fetch(cache_dir, key, output_path, &cache_status)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_SUCCESS);
+    return true;
+  } /* end if */
+  
+  get_status = M2C_REMOTE_STATUS_SUCCESS;
+  hit = true;
+  
+  for (index = 0; index < M2C_CACHE_OUTPUT_END_MARK; index++) {
+    staged[index] = NULL;
+    if (hit && (output_path[index] != NULL)) {
+      staged[index] = new_staging_path(output_path[index]);
+      
+      if (staged[index] == NULL) {
+        get_status = M2C_REMOTE_STATUS_ALLOCATION_FAILED;
+        hit = false;
+      }
+      else {
+        m2c_cache_blob_name(key, index, name);
+        hit = backend->get(backend->context, name, staged[index], &get_status);
+      } /* end if */
+    } /* end if */
+  } /* end for */
+  
+  for (index = 0; index < M2C_CACHE_OUTPUT_END_MARK; index++) {
+    if (staged[index] != NULL) {
+      if (hit && (rename(staged[index], output_path[index]) != 0)) {
+        get_status = M2C_REMOTE_STATUS_IO_ERROR;
+        hit = false;
+      } /* end if */
+      
+      /* a partial fetch leaves no staged file behind */
+      remove(staged[index]);
+      free(staged[index]);
+    } /* end if */
+  } /* end for */
+  
+  /* the next lookup of this key is local */
+  if (hit) {
+    m2c_cache_store(cache_dir, key, output_path, &cache_status);
+  } /* end if */
+  
+  SET_STATUS(status, get_status);
+  return hit;
+} /* end m2c_remote_cache_fetch */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_remote_cache_upload(backend, cache_dir, key, outputs, ...)
+ * --------------------------------------------------------------------------
+ * Starts a detached process to upload outputs of a local entry.  The child
+ * forks the uploader and exits at once,  thus the caller reaps it right
+ * away  and the uploader,  orphaned,  never becomes a zombie of the caller.
+ * ----------------------------------------------------------------------- */
+
+void m2c_remote_cache_upload
+  (const m2c_remote_backend_t *backend,
+   const char *cache_dir,
+   const m2c_cache_key_t *key,
+   const bool outputs[],
+   m2c_remote_status_t *status) {
+  
+#if (M2C_REMOTE_CACHE_SOCKETS)
+  pid_t pid;
+#endif
+  
+  /* check pre-conditions */
+  if ((backend == NULL) || (cache_dir == NULL) ||
+      (key == NULL) || (outputs == NULL)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+#if (M2C_REMOTE_CACHE_SOCKETS)
+  /* buffered output must not be written twice */
+  fflush(NULL);
+  
+  pid = fork();
+  
+  if (pid == 0) {
+    if (fork() == 0) {
+      upload_outputs(backend, cache_dir, key, outputs);
+    } /* end if */
+    _exit(0);
+  } /* end if */
+  
+  if (pid < 0) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  waitpid(pid, NULL, 0);
+#else
+  upload_outputs(backend, cache_dir, key, outputs);
+#endif
+  
+  SET_STATUS(status, M2C_REMOTE_STATUS_SUCCESS);
+} /* end m2c_remote_cache_upload */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_remote_backend_release(backend)
+ * --------------------------------------------------------------------------
+ * Deallocates the context of backend and clears backend.
+ * ----------------------------------------------------------------------- */
+
+void m2c_remote_backend_release (m2c_remote_backend_t *backend) {
+  
+  if (backend == NULL) {
+    return;
+  } /* end if */
+  
+  if ((backend->release != NULL) && (backend->context != NULL)) {
+    backend->release(backend->context);
+  } /* end if */
+  
+  backend->get = NULL;
+  backend->put = NULL;
+  backend->release = NULL;
+  backend->context = NULL;
+} /* end m2c_remote_backend_release */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function http_get(context, name, path, status)
+ * --------------------------------------------------------------------------
+ * Backend procedure to get blob name with an HTTP GET request.  Writes the
+ * response body to a temporary file that is renamed to path if the status
+ * is 200 and the body is complete.  Status 404 is reported as not found.
+ * ----------------------------------------------------------------------- */
+
+static bool http_get
+  (void *context, const char *name, const char *path,
+   m2c_remote_status_t *status) {
+  
+#if (M2C_REMOTE_CACHE_SOCKETS)
+  size_t length, body_start, body_length;
+  char *buffer, *temp_path;
+  const char *field;
+  long content_length;
+  http_context_t *http;
+  int socket_fd, code;
+  ssize_t received;
+  FILE *file;
+  bool success;
+  
+  http = (http_context_t *) context;
+  buffer = malloc(HTTP_BUFFER_SIZE);
+  temp_path = new_staging_path(path);
+  
+  if ((buffer == NULL) || (temp_path == NULL)) {
+    free(buffer);
+    free(temp_path);
+    SET_STATUS(status, M2C_REMOTE_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  socket_fd = http_connect(http, status);
+  
+  if (socket_fd < 0) {
+    free(buffer);
+    free(temp_path);
+    return false;
+  } /* end if */
+  
+  length = (size_t) snprintf(buffer, HTTP_HEADER_SIZE,
+    "GET %s/%s HTTP/1.0\r\nHost: %s\r\nConnection: close\r\n\r\n",
+    http->prefix, name, http->host);
+  
+  code = -1;
+  if ((length < HTTP_HEADER_SIZE) && send_all(socket_fd, buffer, length)) {
+    code = read_response_header(socket_fd, buffer, &length, &body_start);
+  } /* end if */
+  
+  if (code != 200) {
+    close(socket_fd);
+    free(buffer);
+    free(temp_path);
+    
+    if (code == 404) {
+      SET_STATUS(status, M2C_REMOTE_STATUS_BLOB_NOT_FOUND);
+    }
+    else {
+      SET_STATUS(status, M2C_REMOTE_STATUS_PROTOCOL_ERROR);
+    } /* end if */
+    
+    return false;
+  } /* end if */
+  
+  /* Content-Length is optional with HTTP/1.0,  the body ends at close */
+  content_length = -1;
+  buffer[body_start - 1] = ASCII_NUL;
+  field = strstr(buffer, "\nContent-Length:");
+  if (field == NULL) {
+    field = strstr(buffer, "\ncontent-length:");
+  } /* end if */
+  if (field != NULL) {
+    content_length = strtol(field + 16, NULL, 10);
+  } /* end if */
+  
+  file = fopen(temp_path, "wb");
+  success = (file != NULL);
+  
+  /* part of the body may have arrived with the header */
+  body_length = length - body_start;
+  if (success && (body_length > 0)) {
+    success = (fwrite(buffer + body_start, 1, body_length, file) ==
+      body_length);
+  } /* end if */
+  
+  while (success &&
+      ((received = recv(socket_fd, buffer, HTTP_BUFFER_SIZE, 0)) != 0)) {
+    if (received < 0) {
+      success = false;
+    }
+    else {
+      success = (fwrite(buffer, 1, (size_t) received, file) ==
+        (size_t) received);
+      body_length = body_length + (size_t) received;
+    } /* end if */
+  } /* end while */
+  
+  close(socket_fd);
+  
+  if (file != NULL) {
+    success = (fclose(file) == 0) && success;
+  } /* end if */
+  
+  if ((content_length >= 0) && (body_length != (size_t) content_length)) {
+    success = false;
+  } /* end if */
+  
+  if (success) {
+    success = (rename(temp_path, path) == 0);
+  } /* end if */
+  
+  if (NOT(success)) {
+    remove(temp_path);
+  } /* end if */
+  
+  free(buffer);
+  free(temp_path);
+  
+  if (NOT(success)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_IO_ERROR);
+    return false;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_REMOTE_STATUS_SUCCESS);
+  return true;
+#else
+  (void) context;
+  (void) name;
+  (void) path;
+  SET_STATUS(status, M2C_REMOTE_STATUS_NOT_CONFIGURED);
+  return false;
+#endif
+} /* end http_get */
+
+
+/* --------------------------------------------------------------------------
+ * private function http_put(context, name, path, status)
+ * --------------------------------------------------------------------------
+ * Backend procedure to put the file at path as blob name with an HTTP PUT
+ * request.  Status 200, 201 and 204 are accepted as success.
+ * ----------------------------------------------------------------------- */
+
+static bool http_put
+  (void *context, const char *name, const char *path,
+   m2c_remote_status_t *status) {
+  
+#if (M2C_REMOTE_CACHE_SOCKETS)
+  size_t length, body_start;
+  http_context_t *http;
+  int socket_fd, code;
+  long file_size;
+  char *buffer;
+  FILE *file;
+  bool success;
+  
+  http = (http_context_t *) context;
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_IO_ERROR);
+    return false;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((file_size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    SET_STATUS(status, M2C_REMOTE_STATUS_IO_ERROR);
+    return false;
+  } /* end if */
+  
+  buffer = malloc(HTTP_BUFFER_SIZE);
+  
+  if (buffer == NULL) {
+    fclose(file);
+    SET_STATUS(status, M2C_REMOTE_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  socket_fd = http_connect(http, status);
+  
+  if (socket_fd < 0) {
+    fclose(file);
+    free(buffer);
+    return false;
+  } /* end if */
+  
+  length = (size_t) snprintf(buffer, HTTP_HEADER_SIZE,
+    "PUT %s/%s HTTP/1.0\r\nHost: %s\r\nContent-Length: %ld\r\n"
+    "Content-Type: application/octet-stream\r\nConnection: close\r\n\r\n",
+    http->prefix, name, http->host, file_size);
+  
+  success = (length < HTTP_HEADER_SIZE) && send_all(socket_fd, buffer, length);
+  
+  while (success &&
+      ((length = fread(buffer, 1, HTTP_BUFFER_SIZE, file)) > 0)) {
+    success = send_all(socket_fd, buffer, length);
+  } /* end while */
+  
+  success = success && NOT(ferror(file));
+  fclose(file);
+  
+  code = -1;
+  if (success) {
+    code = read_response_header(socket_fd, buffer, &length, &body_start);
+  } /* end if */
+  
+  close(socket_fd);
+  free(buffer);
+  
+  if ((code != 200) && (code != 201) && (code != 204)) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_PROTOCOL_ERROR);
+    return false;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_REMOTE_STATUS_SUCCESS);
+  return true;
+#else
+  (void) context;
+  (void) name;
+  (void) path;
+  SET_STATUS(status, M2C_REMOTE_STATUS_NOT_CONFIGURED);
+  return false;
+#endif
+} /* end http_put */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure http_release(context)
+ * --------------------------------------------------------------------------
+ * Deallocates the context of an HTTP backend.
+ * ----------------------------------------------------------------------- */
+
+static void http_release (void *context) {
+  
+  http_context_t *http;
+  
+  http = (http_context_t *) context;
+  
+  free(http->host);
+  free(http->port);
+  free(http->prefix);
+  free(http);
+} /* end http_release */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_substring(start, length)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated NUL terminated copy of the length characters at
+ * start,  or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_substring (const char *start, size_t length) {
+  
+  char *str;
+  
+  str = malloc(length + 1);
+  
+  if (str == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(str, start, length);
+  str[length] = ASCII_NUL;
+  
+  return str;
+} /* end new_substring */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_staging_path(path)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path  path.remote,  or NULL if allocation
+ * failed.
+ * ----------------------------------------------------------------------- */
+
+static char *new_staging_path (const char *path) {
+  
+  size_t length;
+  char *staged;
+  
+  length = strlen(path);
+  staged = malloc(length + sizeof(STAGING_SUFFIX));
+  
+  if (staged == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(staged, path, length);
+  memcpy(staged + length, STAGING_SUFFIX, sizeof(STAGING_SUFFIX));
+  
+  return staged;
+} /* end new_staging_path */
+
+
+#if (M2C_REMOTE_CACHE_SOCKETS)
+/* --------------------------------------------------------------------------
+ * private function http_connect(http, status)
+ * --------------------------------------------------------------------------
+ * Connects to the host of http and returns the socket,  or -1 on failure.
+ * Connecting and each subsequent send and receive on the socket time out
+ * after M2C_REMOTE_CACHE_TIMEOUT_MS milliseconds.
+ * ----------------------------------------------------------------------- */
+
+static int http_connect
+  (const http_context_t *http, m2c_remote_status_t *status) {
+  
+  struct addrinfo hints, *addresses, *address;
+  struct pollfd poll_fd;
+  struct timeval timeout;
+  socklen_t error_size;
+  int socket_fd, flags, error;
+  
+  memset(&hints, 0, sizeof(struct addrinfo));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  
+  if (getaddrinfo(http->host, http->port, &hints, &addresses) != 0) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_CONNECTION_FAILED);
+    return -1;
+  } /* end if */
+  
+  timeout.tv_sec = M2C_REMOTE_CACHE_TIMEOUT_MS / 1000;
+  timeout.tv_usec = (M2C_REMOTE_CACHE_TIMEOUT_MS % 1000) * 1000;
+  
+  socket_fd = -1;
+  for (address = addresses; address != NULL; address = address->ai_next) {
+    socket_fd = socket(address->ai_family,
+      address->ai_socktype, address->ai_protocol);
+    
+    if (socket_fd < 0) {
+      continue;
+    } /* end if */
+    
+    /* connect without blocking to bound the time it takes */
+    flags = fcntl(socket_fd, F_GETFL, 0);
+    fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK);
+    
+    error = 0;
+    if (connect(socket_fd, address->ai_addr, address->ai_addrlen) != 0) {
+      error = errno;
+      if (error == EINPROGRESS) {
+        poll_fd.fd = socket_fd;
+        poll_fd.events = POLLOUT;
+        error = ETIMEDOUT;
+        if (poll(&poll_fd, 1, M2C_REMOTE_CACHE_TIMEOUT_MS) == 1) {
+          error_size = sizeof(int);
+          if (getsockopt(socket_fd,
+              SOL_SOCKET, SO_ERROR, &error, &error_size) != 0) {
+            error = errno;
+          } /* end if */
+        } /* end if */
+      } /* end if */
+    } /* end if */
+    
+    if (error == 0) {
+      fcntl(socket_fd, F_SETFL, flags);
+      setsockopt(socket_fd, SOL_SOCKET, SO_RCVTIMEO,
+        &timeout, sizeof(struct timeval));
+      setsockopt(socket_fd, SOL_SOCKET, SO_SNDTIMEO,
+        &timeout, sizeof(struct timeval));
+      break;
+    } /* end if */
+    
+    close(socket_fd);
+    socket_fd = -1;
+  } /* end for */
+  
+  freeaddrinfo(addresses);
+  
+  if (socket_fd < 0) {
+    SET_STATUS(status, M2C_REMOTE_STATUS_CONNECTION_FAILED);
+    return -1;
+  } /* end if */
+  
+  return socket_fd;
+} /* end http_connect */
+
+
+/* --------------------------------------------------------------------------
+ * private function send_all(socket_fd, data, length)
+ * --------------------------------------------------------------------------
+ * Sends length bytes at data on socket_fd.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool send_all (int socket_fd, const char *data, size_t length) {
+  
+  ssize_t sent;
+  
+  while (length > 0) {
+    sent = send(socket_fd, data, length, MSG_NOSIGNAL);
+    
+    if (sent <= 0) {
+      if ((sent < 0) && (errno == EINTR)) {
+        continue;
+      } /* end if */
+      return false;
+    } /* end if */
+    
+    data = data + sent;
+    length = length - (size_t) sent;
+  } /* end while */
+  
+  return true;
+} /* end send_all */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_response_header(socket_fd, buffer, length, ...)
+ * --------------------------------------------------------------------------
+ * Receives from socket_fd into buffer until the end of the response header
+ * and returns the status code of the response,  or -1 if the response is
+ * malformed or its header exceeds HTTP_HEADER_SIZE bytes.  Passes the
+ * number of bytes received in length  and the index of the first byte of
+ * the body in body_start.
+ * ----------------------------------------------------------------------- */
+
+static int read_response_header
+  (int socket_fd, char *buffer, size_t *length, size_t *body_start) {
+  
+  char *header_end;
+  ssize_t received;
+  size_t count;
+  int code;
+  
+  count = 0;
+  header_end = NULL;
+  
+  while ((header_end == NULL) && (count < HTTP_HEADER_SIZE)) {
+    received = recv(socket_fd, buffer + count, HTTP_HEADER_SIZE - count, 0);
+    
+    if (received <= 0) {
+      return -1;
+    } /* end if */
+    
+    count = count + (size_t) received;
+    buffer[count] = ASCII_NUL;
+    header_end = strstr(buffer, "\r\n\r\n");
+  } /* end while */
+  
+  /* HTTP/1.x NNN */
+  if ((header_end == NULL) || (strncmp(buffer, "HTTP/1.", 7) != 0) ||
+      (buffer[8] != ' ') || (sscanf(buffer + 9, "%3d", &code) != 1)) {
+    return -1;
+  } /* end if */
+  
+  *length = count;
+  *body_start = (size_t) (header_end - buffer) + 4;
+  
+  return code;
+} /* end read_response_header */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private procedure upload_outputs(backend, cache_dir, key, outputs)
+ * --------------------------------------------------------------------------
+ * Puts the selected outputs of the local entry for key to the remote cache
+ * of backend,  stopping at the first failure.
+ * ----------------------------------------------------------------------- */
+
+static void upload_outputs
+  (const m2c_remote_backend_t *backend,
+   const char *cache_dir,
+   const m2c_cache_key_t *key,
+   const bool outputs[]) {
+  
+  char name[M2C_CACHE_BLOB_NAME_SIZE], *path;
+  uint_t index;
+  bool success;
+  
+  success = true;
+  for (index = 0; success && (index < M2C_CACHE_OUTPUT_END_MARK); index++) {
+    if (outputs[index]) {
+      path = m2c_cache_new_output_path(cache_dir, key, index);
+      m2c_cache_blob_name(key, index, name);
+      success = (path != NULL) &&
+        backend->put(backend->context, name, path, NULL);
+      free(path);
+    } /* end if */
+  } /* end for */
+} /* end upload_outputs */
+
+
+/* END OF FILE */
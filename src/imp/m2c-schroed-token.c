@@ -42,6 +42,7 @@
  * ----------------------------------------------------------------------- */
 
 #include "m2c-schroed-token.h"
+#include "m2c-ident-class.h"
 
 
 /* --------------------------------------------------------------------------
@@ -74,8 +75,9 @@ static bool initialized = false;
 
 static void init_lexeme_table (void) {
   unsigned short index;
-  for (index = 0; index++; index < SCHROED_END_MARK) {
-    schroed_lexeme_table[index] = intstr_for_cstr(schroed_cstr_table[index]);
+  for (index = 0; index < SCHROED_END_MARK; index++) {
+    schroed_lexeme_table[index] =
+      intstr_for_cstr(schroed_cstr_table[index], NULL);
   } /* end for */
   initialized = true;
 } /* end init_lexeme_table */
@@ -104,52 +106,16 @@ bool m2c_ident_is_schroed (intstr_t lexeme) {
  * ----------------------------------------------------------------------- */
 
 m2c_schroed_t m2c_schroed_for_lexeme (intstr_t lexeme) {
-  unsigned short length;
-  const char *lexstr;
+  const m2c_ident_info_t *info;
   
-  if (lexeme == NULL) {
-    return SCHROED_INVALID;
-  } /* end if */
+  /* one hash probe and one compare */
+  info = m2c_ident_info_for_lexeme(lexeme);
   
-  if (initialized == false) {
-    init_lexeme_table();
+  if (info == NULL) {
+    return SCHROED_INVALID;
   } /* end if */
   
-  lexstr = intstr_char_pointer(lexeme, NULL);
-  length = intstr_length(lexeme);
-  
-  switch (length) {
-    /* NIL */
-    case /* length = */ 3 :
-      if (lexeme == schroed_lexeme_table[SCHROED_NIL]) {
-        return SCHROED_NIL;
-      } /* end if */
-      break;
-      
-    /* CAST */
-    case /* length = */ 4 :
-      if (lexeme == schroed_lexeme_table[SCHROED_CAST]) {
-        return SCHROED_CAST;
-      } /* end if */
-      break;
-      
-    /* ADDRESS */
-    case /* length = */ 7 :
-      if (lexeme == schroed_lexeme_table[SCHROED_ADDRESS]) {
-        return SCHROED_ADDRESS;
-      } /* end if */
-      break;
-      
-    /* CAPACITY */
-    case /* length = */ 8 :
-      if (lexeme == schroed_lexeme_table[SCHROED_CAPACITY]) {
-        return SCHROED_CAPACITY;
-      } /* end if */
-      break;
-      
-  } /* end switch */
-  return SCHROED_INVALID;
-  
+  return (m2c_schroed_t) info->schroed;
 } /* end m2c_schroed_for_lexeme */
 
 
@@ -0,0 +1,768 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-search-path.c                                                         *
+ *                                                                           *
+ * Implementation of module search path resolution.                          *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-search-path.h"
+#include "m2c-library-bundle.h"
+#include "m2c-pathnames.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial number of entries and slots of the module table
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_ENTRY_CAPACITY 64
+
+#define INITIAL_SLOT_COUNT 128
+
+
+/* --------------------------------------------------------------------------
+ * Modification time recorded for a directory or bundle that could not be read
+ * ----------------------------------------------------------------------- */
+
+#define NO_MTIME ((time_t) -1)
+
+
+/* --------------------------------------------------------------------------
+ * private type module_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for the files of a module of each kind in the first directory
+ * holding one,  NULL if there is none.  Table dir holds the index of that
+ * directory in the search path.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* module */    intstr_t module;
+  /* path */      intstr_t path[M2C_SOURCE_KIND_COUNT];
+  /* dir */       uint_t dir[M2C_SOURCE_KIND_COUNT];
+} module_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_search_path_s
+ * --------------------------------------------------------------------------
+ * Record type representing a search path.  Table dir holds the interned
+ * directory names,  table mtime their modification times when they were
+ * last listed at time listed_at  and table bundle the open bundle of each
+ * directory that is a library bundle,  NULL for others.  The slot table maps
+ * interned module identifiers to entries by open addressing with linear
+ * probing,  a slot holds its entry plus one,  or zero if it is free.  The
+ * slot count is a power of two and at least twice the entry count.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_search_path_s {
+  /* dir_count */       uint_t dir_count;
+  /* dir */             intstr_t *dir;
+  /* mtime */           time_t *mtime;
+  /* bundle */          m2c_bundle_t *bundle;
+  /* listed_at */       time_t listed_at;
+  /* entry_count */     uint_t entry_count;
+  /* entry_capacity */  uint_t entry_capacity;
+  /* entry */           module_entry_t *entry;
+  /* slot_count */      uint_t slot_count;
+  /* slot */            uint_t *slot;
+};
+
+typedef struct m2c_search_path_s m2c_search_path_s;
+
+
+/* --------------------------------------------------------------------------
+ * private table member_suffix
+ * --------------------------------------------------------------------------
+ * Suffixes of the files of bundle members,  indexed by bundle member kind.
+ * ----------------------------------------------------------------------- */
+
+static const char *const member_suffix[M2C_BUNDLE_KIND_COUNT] = {
+  ".def", ".mod", ".sym", ".exl"
+}; /* end member_suffix */
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool list_all (m2c_search_path_t search_path);
+
+static bool list_directory (m2c_search_path_t search_path, uint_t index);
+
+static bool list_bundle (m2c_search_path_t search_path, uint_t index);
+
+static bool enter_file
+  (m2c_search_path_t search_path, uint_t index, intstr_t module,
+   m2c_source_kind_t kind, const char *name, const char *suffix);
+
+static void release_bundles (m2c_search_path_t search_path);
+
+static module_entry_t *entry_for_module
+  (m2c_search_path_t search_path, intstr_t module);
+
+static bool grow_slot_table (m2c_search_path_t search_path);
+
+static const module_entry_t *find_entry
+  (m2c_search_path_t search_path, intstr_t module);
+
+static time_t directory_mtime (const char *path);
+
+static bool kind_for_suffix (const char *suffix, m2c_source_kind_t *kind);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_search_path(dir_count, dirs, status)
+ * --------------------------------------------------------------------------
+ * Returns a new search path listing the directories in array dirs.
+ * ----------------------------------------------------------------------- */
+
+m2c_search_path_t m2c_new_search_path
+  (uint_t dir_count,                      /* in */
+   const char *const dirs[],              /* in */
+   m2c_search_path_status_t *status) {    /* out */
+  
+  m2c_search_path_t search_path;
+  uint_t index;
+  
+  /* check pre-conditions */
+  if ((dirs == NULL) && (dir_count > 0)) {
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  search_path = malloc(sizeof(m2c_search_path_s));
+  
+  if (search_path == NULL) {
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  search_path->dir_count = dir_count;
+  search_path->dir = malloc((dir_count + 1) * sizeof(intstr_t));
+  search_path->mtime = malloc((dir_count + 1) * sizeof(time_t));
+  search_path->bundle = calloc(dir_count + 1, sizeof(m2c_bundle_t));
+  search_path->listed_at = 0;
+  search_path->entry_count = 0;
+  search_path->entry_capacity = INITIAL_ENTRY_CAPACITY;
+  search_path->entry =
+    malloc(INITIAL_ENTRY_CAPACITY * sizeof(module_entry_t));
+  search_path->slot_count = INITIAL_SLOT_COUNT;
+  search_path->slot = calloc(INITIAL_SLOT_COUNT, sizeof(uint_t));
+  
+  if ((search_path->dir == NULL) || (search_path->mtime == NULL) ||
+      (search_path->bundle == NULL) || (search_path->entry == NULL) ||
+      (search_path->slot == NULL)) {
+    search_path->dir_count = 0;
+    m2c_release_search_path(&search_path);
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  for (index = 0; index < dir_count; index++) {
+    search_path->dir[index] = intstr_for_cstr(dirs[index], NULL);
+    
+    if (search_path->dir[index] == NULL) {
+      m2c_release_search_path(&search_path);
+      SET_STATUS(status, M2C_SEARCH_PATH_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+  } /* end for */
+  
+  if (NOT(list_all(search_path))) {
+    m2c_release_search_path(&search_path);
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_SEARCH_PATH_STATUS_SUCCESS);
+  return search_path;
+} /* end m2c_new_search_path */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_find(search_path, module, kind)
+ * --------------------------------------------------------------------------
+ * Returns the interned pathname of the file of module of kind,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_search_path_find
+  (m2c_search_path_t search_path, intstr_t module, m2c_source_kind_t kind) {
+  
+  const module_entry_t *entry;
+  
+  if ((search_path == NULL) || (module == NULL) ||
+      ((uint_t) kind >= M2C_SOURCE_KIND_COUNT)) {
+    return NULL;
+  } /* end if */
+  
+  entry = find_entry(search_path, module);
+  
+  if (entry == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return entry->path[kind];
+} /* end m2c_search_path_find */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_contents(search_path, module, kind, size)
+ * --------------------------------------------------------------------------
+ * Returns the contents of the file of module of kind if it is a member of
+ * a bundle,  otherwise NULL.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_search_path_contents
+  (m2c_search_path_t search_path,         /* in */
+   intstr_t module,                       /* in */
+   m2c_source_kind_t kind,                /* in */
+   size_t *size) {                        /* out */
+  
+  const module_entry_t *entry;
+  m2c_bundle_t bundle;
+  
+  if ((search_path == NULL) || (module == NULL) ||
+      ((uint_t) kind >= M2C_SOURCE_KIND_COUNT)) {
+    return NULL;
+  } /* end if */
+  
+  entry = find_entry(search_path, module);
+  
+  if ((entry == NULL) || (entry->path[kind] == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  bundle = search_path->bundle[entry->dir[kind]];
+  
+  /* source kinds and bundle kinds are in the same order */
+  return m2c_bundle_member(bundle, module, (m2c_bundle_kind_t) kind, size);
+} /* end m2c_search_path_contents */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_matches(search_path, dir_count, dirs)
+ * --------------------------------------------------------------------------
+ * Returns true if search_path consists of the directories in array dirs.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_search_path_matches
+  (m2c_search_path_t search_path, uint_t dir_count, const char *const dirs[]) {
+  
+  uint_t index;
+  
+  if ((search_path == NULL) || (search_path->dir_count != dir_count)) {
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < dir_count; index++) {
+    if (strcmp(intstr_char_ptr(search_path->dir[index]), dirs[index]) != 0) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end m2c_search_path_matches */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_refresh(search_path, status)
+ * --------------------------------------------------------------------------
+ * Relists the directories of search_path if any of them has changed.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_search_path_refresh
+  (m2c_search_path_t search_path, m2c_search_path_status_t *status) {
+  
+  uint_t index;
+  bool changed;
+  time_t mtime;
+  
+  if (search_path == NULL) {
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  changed = false;
+  index = 0;
+  while (NOT(changed) && (index < search_path->dir_count)) {
+    mtime = directory_mtime(intstr_char_ptr(search_path->dir[index]));
+    
+    /* a change within the second of listing does not change the time */
+    changed = (mtime != search_path->mtime[index]) ||
+      ((mtime != NO_MTIME) && (mtime >= search_path->listed_at));
+    index++;
+  } /* end while */
+  
+  if (NOT(changed)) {
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_SUCCESS);
+    return false;
+  } /* end if */
+  
+  if (NOT(list_all(search_path))) {
+    search_path->entry_count = 0;
+    memset(search_path->slot, 0, search_path->slot_count * sizeof(uint_t));
+    SET_STATUS(status, M2C_SEARCH_PATH_STATUS_ALLOCATION_FAILED);
+    return true;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_SEARCH_PATH_STATUS_SUCCESS);
+  return true;
+} /* end m2c_search_path_refresh */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_search_path(search_path)
+ * --------------------------------------------------------------------------
+ * Deallocates search_path and passes NULL in search_path.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_search_path (m2c_search_path_t *search_path) {
+  
+  if ((search_path == NULL) || (*search_path == NULL)) {
+    return;
+  } /* end if */
+  
+  release_bundles(*search_path);
+  
+  free((*search_path)->dir);
+  free((*search_path)->mtime);
+  free((*search_path)->bundle);
+  free((*search_path)->entry);
+  free((*search_path)->slot);
+  free(*search_path);
+  *search_path = NULL;
+} /* end m2c_release_search_path */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function list_all(search_path)
+ * --------------------------------------------------------------------------
+ * Empties the module table of search_path,  closes its bundles  and lists
+ * its directories and bundles in order.  Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool list_all (m2c_search_path_t search_path) {
+  
+  uint_t index;
+  bool ok;
+  
+  search_path->entry_count = 0;
+  memset(search_path->slot, 0, search_path->slot_count * sizeof(uint_t));
+  release_bundles(search_path);
+  
+  /* changes from here on are seen by the next refresh */
+  search_path->listed_at = time(NULL);
+  
+  for (index = 0; index < search_path->dir_count; index++) {
+    if (m2c_is_bundle_path(intstr_char_ptr(search_path->dir[index]))) {
+      ok = list_bundle(search_path, index);
+    }
+    else {
+      ok = list_directory(search_path, index);
+    } /* end if */
+    
+    if (NOT(ok)) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end list_all */
+
+
+/* --------------------------------------------------------------------------
+ * private function list_directory(search_path, index)
+ * --------------------------------------------------------------------------
+ * Records the modification time of the directory at index in search_path
+ * and enters its module files into the module table,  unless an earlier
+ * directory holds a file of the same module and kind.  Entries are not
+ * checked to be regular files,  opening them reports any error.  Returns
+ * false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool list_directory (m2c_search_path_t search_path, uint_t index) {
+  
+  const char *dir_path, *name, *suffix;
+  struct dirent *dir_entry;
+  m2c_source_kind_t kind;
+  intstr_t module;
+  DIR *dir;
+  
+  dir_path = intstr_char_ptr(search_path->dir[index]);
+  search_path->mtime[index] = directory_mtime(dir_path);
+  
+  dir = opendir(dir_path);
+  
+  /* an unreadable directory contributes no sources */
+  if (dir == NULL) {
+    return true;
+  } /* end if */
+  
+  while ((dir_entry = readdir(dir)) != NULL) {
+    name = dir_entry->d_name;
+    suffix = strrchr(name, '.');
+    
+    if ((suffix == NULL) || (suffix == name)) {
+      continue;
+    } /* end if */
+    
+    if (NOT(kind_for_suffix(suffix, &kind))) {
+      continue;
+    } /* end if */
+    
+    module = intstr_for_slice(name, 0, (uint_t) (suffix - name), NULL);
+    
+    if ((module == NULL) ||
+        NOT(enter_file(search_path, index, module, kind, name, ""))) {
+      closedir(dir);
+      return false;
+    } /* end if */
+  } /* end while */
+  
+  closedir(dir);
+  
+  return true;
+} /* end list_directory */
+
+
+/* --------------------------------------------------------------------------
+ * private function list_bundle(search_path, index)
+ * --------------------------------------------------------------------------
+ * Records the modification time of the bundle at index in search_path,
+ * opens it and enters its members into the module table,  unless an earlier
+ * directory holds a file of the same module and kind.  Returns false if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool list_bundle (m2c_search_path_t search_path, uint_t index) {
+  
+  const char *bundle_path;
+  m2c_bundle_status_t status;
+  m2c_bundle_kind_t kind;
+  m2c_bundle_t bundle;
+  uint_t member;
+  intstr_t module;
+  
+  bundle_path = intstr_char_ptr(search_path->dir[index]);
+  search_path->mtime[index] = directory_mtime(bundle_path);
+  
+  bundle = m2c_open_bundle(bundle_path, &status);
+  
+  /* an unreadable bundle contributes no files */
+  if (bundle == NULL) {
+    return (status != M2C_BUNDLE_STATUS_ALLOCATION_FAILED);
+  } /* end if */
+  
+  search_path->bundle[index] = bundle;
+  
+  for (member = 0; member < m2c_bundle_member_count(bundle); member++) {
+    /* a malformed record is skipped */
+    if (NOT(m2c_bundle_member_at(bundle, member, &module, &kind))) {
+      continue;
+    } /* end if */
+    
+    if (NOT(enter_file(search_path, index, module,
+        (m2c_source_kind_t) kind, intstr_char_ptr(module),
+        member_suffix[kind]))) {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end list_bundle */
+
+
+/* --------------------------------------------------------------------------
+ * private function enter_file(search_path, index, module, kind, name, ...)
+ * --------------------------------------------------------------------------
+ * Enters the file of module of kind,  named name followed by suffix,  of the
+ * directory or bundle at index in search_path into the module table,  unless
+ * an earlier directory holds a file of the same module and kind.  Returns
+ * false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool enter_file
+  (m2c_search_path_t search_path, uint_t index, intstr_t module,
+   m2c_source_kind_t kind, const char *name, const char *suffix) {
+  
+  size_t dir_length, name_length, suffix_length;
+  module_entry_t *entry;
+  const char *dir_path;
+  char *buffer;
+  intstr_t path;
+  
+  entry = entry_for_module(search_path, module);
+  
+  if (entry == NULL) {
+    return false;
+  } /* end if */
+  
+  /* an earlier directory takes precedence */
+  if (entry->path[kind] != NULL) {
+    return true;
+  } /* end if */
+  
+  dir_path = intstr_char_ptr(search_path->dir[index]);
+  dir_length = strlen(dir_path);
+  name_length = strlen(name);
+  suffix_length = strlen(suffix);
+  buffer = malloc(dir_length + name_length + suffix_length + 2);
+  
+  if (buffer == NULL) {
+    return false;
+  } /* end if */
+  
+  memcpy(buffer, dir_path, dir_length);
+  buffer[dir_length] = '/';
+  memcpy(buffer + dir_length + 1, name, name_length);
+  memcpy(buffer + dir_length + 1 + name_length, suffix, suffix_length + 1);
+  
+  path = intstr_for_cstr(buffer, NULL);
+  free(buffer);
+  
+  if (path == NULL) {
+    return false;
+  } /* end if */
+  
+  entry->path[kind] = path;
+  entry->dir[kind] = index;
+  
+  return true;
+} /* end enter_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_bundles(search_path)
+ * --------------------------------------------------------------------------
+ * Closes the open bundles of search_path.
+ * ----------------------------------------------------------------------- */
+
+static void release_bundles (m2c_search_path_t search_path) {
+  
+  uint_t index;
+  
+  if (search_path->bundle == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < search_path->dir_count; index++) {
+    m2c_release_bundle(&search_path->bundle[index]);
+  } /* end for */
+  
+  return;
+} /* end release_bundles */
+
+
+/* --------------------------------------------------------------------------
+ * private function entry_for_module(search_path, module)
+ * --------------------------------------------------------------------------
+ * Returns the entry of module in search_path,  appending an entry without
+ * files if there is none.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static module_entry_t *entry_for_module
+  (m2c_search_path_t search_path, intstr_t module) {
+  
+  module_entry_t *new_table, *entry;
+  uint_t index, mask, slot;
+  
+  /* keep the slot table at most half full */
+  if ((2 * (search_path->entry_count + 1) > search_path->slot_count) &&
+      NOT(grow_slot_table(search_path))) {
+    return NULL;
+  } /* end if */
+  
+  mask = search_path->slot_count - 1;
+  index = intstr_hash(module) & mask;
+  
+  while (search_path->slot[index] != 0) {
+    slot = search_path->slot[index] - 1;
+    if (search_path->entry[slot].module == module) {
+      return &search_path->entry[slot];
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  if (search_path->entry_count == search_path->entry_capacity) {
+    new_table = realloc(search_path->entry,
+      2 * search_path->entry_capacity * sizeof(module_entry_t));
+    
+    if (new_table == NULL) {
+      return NULL;
+    } /* end if */
+    
+    search_path->entry = new_table;
+    search_path->entry_capacity = 2 * search_path->entry_capacity;
+  } /* end if */
+  
+  entry = &search_path->entry[search_path->entry_count];
+  memset(entry, 0, sizeof(module_entry_t));
+  entry->module = module;
+  search_path->entry_count++;
+  
+  search_path->slot[index] = search_path->entry_count;
+  
+  return entry;
+} /* end entry_for_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_entry(search_path, module)
+ * --------------------------------------------------------------------------
+ * Returns the entry of module in search_path,  or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+static const module_entry_t *find_entry
+  (m2c_search_path_t search_path, intstr_t module) {
+  
+  uint_t index, mask, entry;
+  
+  mask = search_path->slot_count - 1;
+  index = intstr_hash(module) & mask;
+  
+  while (search_path->slot[index] != 0) {
+    entry = search_path->slot[index] - 1;
+    
+    if (search_path->entry[entry].module == module) {
+      return &search_path->entry[entry];
+    } /* end if */
+    
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end find_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_slot_table(search_path)
+ * --------------------------------------------------------------------------
+ * Doubles the slot count of search_path and reenters all entries.  Returns
+ * false if allocation failed,  leaving the slot table unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_slot_table (m2c_search_path_t search_path) {
+  
+  uint_t *new_slot;
+  uint_t entry, index, mask, new_count;
+  
+  new_count = 2 * search_path->slot_count;
+  new_slot = calloc(new_count, sizeof(uint_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  free(search_path->slot);
+  search_path->slot = new_slot;
+  search_path->slot_count = new_count;
+  mask = new_count - 1;
+  
+  for (entry = 0; entry < search_path->entry_count; entry++) {
+    index = intstr_hash(search_path->entry[entry].module) & mask;
+    while (new_slot[index] != 0) {
+      index = (index + 1) & mask;
+    } /* end while */
+    new_slot[index] = entry + 1;
+  } /* end for */
+  
+  return true;
+} /* end grow_slot_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function directory_mtime(path)
+ * --------------------------------------------------------------------------
+ * Returns the modification time of the directory or bundle at path,  or
+ * NO_MTIME if there is neither at path.
+ * ----------------------------------------------------------------------- */
+
+static time_t directory_mtime (const char *path) {
+  
+  struct stat st;
+  
+  if ((stat(path, &st) != 0) ||
+      (NOT(S_ISDIR(st.st_mode)) && NOT(S_ISREG(st.st_mode)))) {
+    return NO_MTIME;
+  } /* end if */
+  
+  return st.st_mtime;
+} /* end directory_mtime */
+
+
+/* --------------------------------------------------------------------------
+ * private function kind_for_suffix(suffix, kind)
+ * --------------------------------------------------------------------------
+ * Passes back the kind of a module file with suffix in kind and returns
+ * true,  or returns false if suffix is not that of a module file.  Suffixes
+ * of sources are matched in either case.
+ * ----------------------------------------------------------------------- */
+
+static bool kind_for_suffix (const char *suffix, m2c_source_kind_t *kind) {
+  
+  if (is_def_suffix(suffix)) {
+    *kind = M2C_SOURCE_KIND_DEF;
+  }
+  else if (is_mod_suffix(suffix)) {
+    *kind = M2C_SOURCE_KIND_MOD;
+  }
+  else if (strcmp(suffix, ".sym") == 0) {
+    *kind = M2C_SOURCE_KIND_SYM;
+  }
+  else if (strcmp(suffix, ".exl") == 0) {
+    *kind = M2C_SOURCE_KIND_EXL;
+  }
+  else {
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end kind_for_suffix */
+
+
+/* END OF FILE */
@@ -0,0 +1,228 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-set-codegen.c                                                         *
+ *                                                                           *
+ * Implementation of translation of SET types and set operations.            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "m2c-set-codegen.h"
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void write_word_op
+  (outfile_t outfile, m2c_set_op_t op,
+   m2c_astnode_t left, m2c_astnode_t right,
+   m2c_set_operand_writer_t writer, void *context);
+
+static void write_array_op
+  (outfile_t outfile, m2c_set_op_t op, intstr_t type,
+   m2c_astnode_t left, m2c_astnode_t right,
+   m2c_set_operand_writer_t writer, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * C operators and function suffixes of set operations
+ * ----------------------------------------------------------------------- */
+
+static const char *const word_operator[] = {
+  /* M2C_SET_OP_UNION */        ") | (",
+  /* M2C_SET_OP_DIFFERENCE */   ") & ~(",
+  /* M2C_SET_OP_INTERSECTION */ ") & (",
+  /* M2C_SET_OP_SYMDIFF */      ") ^ (",
+  /* M2C_SET_OP_IN */           NULL
+}; /* word_operator */
+
+static const char *const array_function[] = {
+  /* M2C_SET_OP_UNION */        "_union(",
+  /* M2C_SET_OP_DIFFERENCE */   "_difference(",
+  /* M2C_SET_OP_INTERSECTION */ "_intersection(",
+  /* M2C_SET_OP_SYMDIFF */      "_symdiff(",
+  /* M2C_SET_OP_IN */           "_in("
+}; /* array_function */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_enum_value_count(enum_node)
+ * --------------------------------------------------------------------------
+ * Returns the number of values declared in enumeration type node enum_node.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_enum_value_count (m2c_astnode_t enum_node) {
+  m2c_astnode_t list_node;
+  
+  if ((enum_node == NULL) || (m2c_ast_nodetype(enum_node) != AST_ENUM)) {
+    return 0;
+  } /* end if */
+  
+  list_node = m2c_ast_subnode_at_index(enum_node, 1);
+  
+  if ((list_node == NULL) || (m2c_ast_nodetype(list_node) != AST_IDENTLIST)) {
+    return 0;
+  } /* end if */
+  
+  return m2c_ast_subnode_count(list_node);
+} /* end m2c_enum_value_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_set_word_count(element_count)
+ * --------------------------------------------------------------------------
+ * Returns the number of words needed for a set of element_count elements.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_set_word_count (uint_t element_count) {
+  
+  if (element_count == 0) {
+    return 1;
+  } /* end if */
+  
+  return (element_count + M2C_SET_WORD_BITS - 1) / M2C_SET_WORD_BITS;
+} /* end m2c_set_word_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_set_template(element_count)
+ * --------------------------------------------------------------------------
+ * Returns the template for a set type of element_count elements.
+ * ----------------------------------------------------------------------- */
+
+m2c_template_t m2c_set_template (uint_t element_count) {
+  
+  if (element_count <= M2C_SET_WORD_BITS) {
+    return M2C_TEMPLATE_SET_WORD;
+  }
+  else {
+    return M2C_TEMPLATE_SET_ARRAY;
+  } /* end if */
+} /* end m2c_set_template */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_set_op(outfile, op, type, count, left, right, ...)
+ * --------------------------------------------------------------------------
+ * Writes the C expression for set operation op on operands left and right.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_set_op
+  (outfile_t outfile,                   /* in */
+   m2c_set_op_t op,                     /* in */
+   intstr_t type,                       /* in */
+   uint_t element_count,                /* in */
+   m2c_astnode_t left,                  /* in */
+   m2c_astnode_t right,                 /* in */
+   m2c_set_operand_writer_t writer,     /* in */
+   void *context) {                     /* in */
+  
+  if ((outfile == NULL) || (writer == NULL) || (op > M2C_SET_OP_IN)) {
+    return;
+  } /* end if */
+  
+  if (element_count <= M2C_SET_WORD_BITS) {
+    write_word_op(outfile, op, left, right, writer, context);
+  }
+  else {
+    write_array_op(outfile, op, type, left, right, writer, context);
+  } /* end if */
+} /* end m2c_write_set_op */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_word_op(outfile, op, left, right, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes set operation op on single word sets as a bitwise expression:
+ *
+ *   a + b    => ((a) | (b))
+ *   a - b    => ((a) & ~(b))
+ *   a * b    => ((a) & (b))
+ *   a / b    => ((a) ^ (b))
+ *   e IN s   => (((s) >> (e)) & 1)
+ * ----------------------------------------------------------------------- */
+
+static void write_word_op
+  (outfile_t outfile, m2c_set_op_t op,
+   m2c_astnode_t left, m2c_astnode_t right,
+   m2c_set_operand_writer_t writer, void *context) {
+  
+  if (op == M2C_SET_OP_IN) {
+    outfile_write_chars(outfile, "(((");
+    writer(outfile, right, context);
+    outfile_write_chars(outfile, ") >> (");
+    writer(outfile, left, context);
+    outfile_write_chars(outfile, ")) & 1)");
+  }
+  else {
+    outfile_write_chars(outfile, "((");
+    writer(outfile, left, context);
+    outfile_write_chars(outfile, word_operator[op]);
+    writer(outfile, right, context);
+    outfile_write_chars(outfile, "))");
+  } /* end if */
+} /* end write_word_op */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_array_op(outfile, op, type, left, right, ...)
+ * --------------------------------------------------------------------------
+ * Writes set operation op on multi-word sets of type as a call to the inline
+ * function defined for op by template set-array:
+ *
+ *   a + b    => T_union(a, b)
+ *   a - b    => T_difference(a, b)
+ *   a * b    => T_intersection(a, b)
+ *   a / b    => T_symdiff(a, b)
+ *   e IN s   => T_in(e, s)
+ * ----------------------------------------------------------------------- */
+
+static void write_array_op
+  (outfile_t outfile, m2c_set_op_t op, intstr_t type,
+   m2c_astnode_t left, m2c_astnode_t right,
+   m2c_set_operand_writer_t writer, void *context) {
+  
+  outfile_write_string(outfile, type);
+  outfile_write_chars(outfile, array_function[op]);
+  writer(outfile, left, context);
+  outfile_write_chars(outfile, ", ");
+  writer(outfile, right, context);
+  outfile_write_char(outfile, ')');
+} /* end write_array_op */
+
+/* END OF FILE */
@@ -41,46 +41,156 @@
  * imports
  * ----------------------------------------------------------------------- */
 
-#include "statistics.h"
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
 
-#include <bool.h>
+#if !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 500 /* getrusage */
+#endif
+
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE /* syscall */
+#endif
+
+#include "m2c-statistics.h"
+#include "m2c-trace.h"
+#include "fileutils.h"
+
+#include <time.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdbool.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#if (M2C_STATS_PERF_COUNTERS)
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a telemetry record
+ * ----------------------------------------------------------------------- */
+
+#define TELEMETRY_RECORD_SIZE 8192
+
+
+/* --------------------------------------------------------------------------
+ * private table phase_label
+ * --------------------------------------------------------------------------
+ * Labels of the compiler phases in the time report.
+ * ----------------------------------------------------------------------- */
+
+static const char *phase_label[STATS_PHASE_COUNT] = {
+  /* M2C_STATS_PHASE_LOAD */      "file load",
+  /* M2C_STATS_PHASE_LEX */       "lexing",
+  /* M2C_STATS_PHASE_PARSE */     "parsing",
+  /* M2C_STATS_PHASE_ANALYSIS */  "symbol resolution",
+  /* M2C_STATS_PHASE_CODEGEN */   "code generation",
+  /* M2C_STATS_PHASE_OUTPUT */    "output write"
+}; /* end phase_label */
+
+
+/* --------------------------------------------------------------------------
+ * private table phase_key
+ * --------------------------------------------------------------------------
+ * Keys of the compiler phases in telemetry records.
+ * ----------------------------------------------------------------------- */
+
+static const char *phase_key[STATS_PHASE_COUNT] = {
+  /* M2C_STATS_PHASE_LOAD */      "load",
+  /* M2C_STATS_PHASE_LEX */       "lex",
+  /* M2C_STATS_PHASE_PARSE */     "parse",
+  /* M2C_STATS_PHASE_ANALYSIS */  "analysis",
+  /* M2C_STATS_PHASE_CODEGEN */   "codegen",
+  /* M2C_STATS_PHASE_OUTPUT */    "output"
+}; /* end phase_key */
+
+
+#if (M2C_STATS_PERF_COUNTERS)
+/* --------------------------------------------------------------------------
+ * private table perf_event_config
+ * --------------------------------------------------------------------------
+ * Generalised hardware event of each counter.
+ * ----------------------------------------------------------------------- */
+
+static const uint64_t perf_event_config[STATS_PERF_EVENT_COUNT] = {
+  /* M2C_STATS_PERF_CYCLES */         PERF_COUNT_HW_CPU_CYCLES,
+  /* M2C_STATS_PERF_INSTRUCTIONS */   PERF_COUNT_HW_INSTRUCTIONS,
+  /* M2C_STATS_PERF_CACHE_MISSES */   PERF_COUNT_HW_CACHE_MISSES,
+  /* M2C_STATS_PERF_BRANCHES */       PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+  /* M2C_STATS_PERF_BRANCH_MISSES */  PERF_COUNT_HW_BRANCH_MISSES
+}; /* end perf_event_config */
+#endif
 
 
 /* --------------------------------------------------------------------------
- * type m2c_stats_t
+ * private type record_buffer_t
  * --------------------------------------------------------------------------
- * Type to hold all statistics counters.
+ * Record type for a telemetry record under construction.  Field overflow is
+ * set when the record did not fit.
  * ----------------------------------------------------------------------- */
 
 typedef struct {
-  unsigned short value[STATS_TYPE_COUNT];
-  unsigned short line_count;
-} m2c_stats_s;
+  /* length */    uint_t length;
+  /* overflow */  bool overflow;
+  /* chars */     char chars[TELEMETRY_RECORD_SIZE];
+} record_buffer_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type phase_timer_t
+ * --------------------------------------------------------------------------
+ * Record type for the timers of a compiler phase,  times in nanoseconds,
+ * and the hardware counter values at its start and accumulated.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* running */     bool running;
+  /* wall_start */  uint64_t wall_start;
+  /* cpu_start */   uint64_t cpu_start;
+  /* wall_total */  uint64_t wall_total;
+  /* cpu_total */   uint64_t cpu_total;
+  /* perf_start */  uint64_t perf_start[STATS_PERF_EVENT_COUNT];
+  /* perf_total */  uint64_t perf_total[STATS_PERF_EVENT_COUNT];
+} phase_timer_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_stats_s
+ * --------------------------------------------------------------------------
+ * Record type to hold all statistics counters and phase timers.  Field
+ * perf_fd holds the hardware counter descriptors if perf_open is set,  the
+ * first of which leads the counter group.
+ * ----------------------------------------------------------------------- */
 
-typedef m2c_stats_s *m2c_stats_t;
+struct m2c_stats_s {
+  /* value */       uint64_t value[STATS_TYPE_COUNT];
+  /* line_count */  uint64_t line_count;
+  /* timer */       phase_timer_t timer[STATS_PHASE_COUNT];
+  /* perf_open */   bool perf_open;
+  /* perf_fd */     int perf_fd[STATS_PERF_EVENT_COUNT];
+};
+
+typedef struct m2c_stats_s m2c_stats_s;
 
 
 /* --------------------------------------------------------------------------
  * function m2c_stats_new()
  * --------------------------------------------------------------------------
- * Returns a new statistics record.
+ * Returns a new statistics record with all counters and timers zero.
  * ----------------------------------------------------------------------- */
 
 m2c_stats_t m2c_stats_new (void) {
-  m2c_stat_type_t index;
+  m2c_stats_t stats;
   
-  /* allocate */
-  stats = malloc(sizeof(m2c_stats_s));
-  if (stats == NULL) {
-    return NULL;
-  } /* end if */
-  
-  /* initialise */
-  for (index = 0; index++; index < STATS_TYPE_COUNT) {
-    stats->value[index] = 0;
-  } /* end for */
-  stats->line_count = 0;
+  /* allocate and initialise */
+  stats = calloc(1, sizeof(m2c_stats_s));
   
   return stats;
 } /* end m2c_stats_new */
@@ -92,20 +202,57 @@ m2c_stats_t m2c_stats_new (void) {
  * Increments the counter for statistic param of statistics record stats.
  * ----------------------------------------------------------------------- */
 
-void m2c_stats_inc (m2c_stats_t stats, m2c_stat_type_t param) {
-  if ((stats != NULL) && (IS_VALID_STATS_TYPE(param))) {
+void m2c_stats_inc (m2c_stats_t stats, m2c_stats_type_t param) {
+  if ((stats != NULL) && (IS_VALID_STATS_TYPE(param))
+    && (stats->value[param] < UINT64_MAX)) {
     stats->value[param]++;
   } /* end if */
 } /* end m2c_stats_inc */
 
 
 /* --------------------------------------------------------------------------
- * function m2c_stats_value(stats)
+ * function m2c_stats_add(stats, param, amount)
+ * --------------------------------------------------------------------------
+ * Adds amount to the counter for statistic param of statistics record stats.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_add
+  (m2c_stats_t stats, m2c_stats_type_t param, uint64_t amount) {
+  
+  if ((stats == NULL) || (IS_VALID_STATS_TYPE(param) == false)) {
+    return;
+  } /* end if */
+  
+  if (amount > UINT64_MAX - stats->value[param]) {
+    stats->value[param] = UINT64_MAX;
+  }
+  else /* no overflow */ {
+    stats->value[param] = stats->value[param] + amount;
+  } /* end if */
+} /* end m2c_stats_add */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_set(stats, param, value)
+ * --------------------------------------------------------------------------
+ * Sets the counter for statistic param of statistics record stats to value.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_set
+  (m2c_stats_t stats, m2c_stats_type_t param, uint64_t value) {
+  if ((stats != NULL) && (IS_VALID_STATS_TYPE(param))) {
+    stats->value[param] = value;
+  } /* end if */
+} /* end m2c_stats_set */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_value(stats, param)
  * --------------------------------------------------------------------------
  * Returns the counter for statistic param of statistics record stats.
  * ----------------------------------------------------------------------- */
 
-unsigned short m2c_stats_value (m2c_stats_t stats, m2c_stat_type_t param) {
+uint64_t m2c_stats_value (m2c_stats_t stats, m2c_stats_type_t param) {
   if ((stats == NULL) || (IS_VALID_STATS_TYPE(param) == false)) {
     return 0;
   } /* end if */
@@ -120,7 +267,7 @@ unsigned short m2c_stats_value (m2c_stats_t stats, m2c_stat_type_t param) {
  * Sets the line count of statistics record stats to value.
  * ----------------------------------------------------------------------- */
 
-void m2c_stats_set_line_count (m2c_stats_t stats, unsigned short value) {
+void m2c_stats_set_line_count (m2c_stats_t stats, uint64_t value) {
   if (stats != NULL) {
     stats->line_count = value;
   } /* end if */
@@ -133,7 +280,7 @@ void m2c_stats_set_line_count (m2c_stats_t stats, unsigned short value) {
  * Returns the line count of statistics record stats.
  * ----------------------------------------------------------------------- */
 
-unsigned short m2c_stats_line_count (m2c_stats_t stats) {
+uint64_t m2c_stats_line_count (m2c_stats_t stats) {
   if (stats == NULL) {
     return 0;
   } /* end if */
@@ -142,15 +289,635 @@ unsigned short m2c_stats_line_count (m2c_stats_t stats) {
 } /* end m2c_stats_line_count */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_stats_begin_phase(stats, phase)
+ * --------------------------------------------------------------------------
+ * Starts the wall clock and CPU timers of phase in statistics record stats.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t wall_clock_ns (void);
+
+static uint64_t cpu_clock_ns (void);
+
+static void read_perf_counters
+  (m2c_stats_t stats, uint64_t count[STATS_PERF_EVENT_COUNT]);
+
+void m2c_stats_begin_phase (m2c_stats_t stats, m2c_stats_phase_t phase) {
+  phase_timer_t *timer;
+  
+  if ((stats == NULL) || (IS_VALID_STATS_PHASE(phase) == false)) {
+    return;
+  } /* end if */
+  
+  timer = &stats->timer[phase];
+  
+  if (timer->running) {
+    return;
+  } /* end if */
+  
+  timer->running = true;
+  
+  if (stats->perf_open) {
+    read_perf_counters(stats, timer->perf_start);
+  } /* end if */
+  
+  timer->wall_start = wall_clock_ns();
+  timer->cpu_start = cpu_clock_ns();
+  
+  m2c_trace_begin(phase_label[phase], NULL);
+} /* end m2c_stats_begin_phase */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_end_phase(stats, phase)
+ * --------------------------------------------------------------------------
+ * Stops the timers of phase in statistics record stats  and adds the time
+ * elapsed since the matching m2c_stats_begin_phase to their totals.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_end_phase (m2c_stats_t stats, m2c_stats_phase_t phase) {
+  uint64_t now[STATS_PERF_EVENT_COUNT];
+  phase_timer_t *timer;
+  uint_t event;
+  
+  if ((stats == NULL) || (IS_VALID_STATS_PHASE(phase) == false)) {
+    return;
+  } /* end if */
+  
+  timer = &stats->timer[phase];
+  
+  if (NOT(timer->running)) {
+    return;
+  } /* end if */
+  
+  timer->wall_total = timer->wall_total + (wall_clock_ns() - timer->wall_start);
+  timer->cpu_total = timer->cpu_total + (cpu_clock_ns() - timer->cpu_start);
+  timer->running = false;
+  
+  if (stats->perf_open) {
+    read_perf_counters(stats, now);
+    for (event = 0; event < STATS_PERF_EVENT_COUNT; event++) {
+      timer->perf_total[event] =
+        timer->perf_total[event] + (now[event] - timer->perf_start[event]);
+    } /* end for */
+  } /* end if */
+  
+  m2c_trace_end(phase_label[phase]);
+} /* end m2c_stats_end_phase */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_wall_time(stats, phase)
+ * --------------------------------------------------------------------------
+ * Returns the total wall clock time of phase in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_stats_wall_time (m2c_stats_t stats, m2c_stats_phase_t phase) {
+  if ((stats == NULL) || (IS_VALID_STATS_PHASE(phase) == false)) {
+    return 0;
+  } /* end if */
+  
+  return stats->timer[phase].wall_total;
+} /* end m2c_stats_wall_time */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_cpu_time(stats, phase)
+ * --------------------------------------------------------------------------
+ * Returns the total CPU time of phase in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_stats_cpu_time (m2c_stats_t stats, m2c_stats_phase_t phase) {
+  if ((stats == NULL) || (IS_VALID_STATS_PHASE(phase) == false)) {
+    return 0;
+  } /* end if */
+  
+  return stats->timer[phase].cpu_total;
+} /* end m2c_stats_cpu_time */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_open_perf_counters(stats)
+ * --------------------------------------------------------------------------
+ * Opens a group of hardware performance counters for the calling thread
+ * and attaches it to statistics record stats.  Counting excludes the kernel
+ * so that unprivileged processes may count.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_stats_open_perf_counters (m2c_stats_t stats) {
+#if (M2C_STATS_PERF_COUNTERS)
+  struct perf_event_attr attr;
+  uint_t event, index;
+  long fd;
+  
+  if ((stats == NULL) || (stats->perf_open)) {
+    return false;
+  } /* end if */
+  
+  for (event = 0; event < STATS_PERF_EVENT_COUNT; event++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = perf_event_config[event];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    
+    /* the first counter leads the group,  all are read at once */
+    fd = syscall(__NR_perf_event_open, &attr, 0, -1,
+      (event == 0) ? -1 : stats->perf_fd[0], 0);
+    
+    if (fd < 0) {
+      for (index = event; index > 0; index--) {
+        close(stats->perf_fd[index - 1]);
+      } /* end for */
+      return false;
+    } /* end if */
+    
+    stats->perf_fd[event] = (int) fd;
+  } /* end for */
+  
+  stats->perf_open = true;
+  return true;
+#else
+  (void) stats;
+  return false;
+#endif
+} /* end m2c_stats_open_perf_counters */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_has_perf_counters(stats)
+ * --------------------------------------------------------------------------
+ * Returns true if hardware counters are attached to stats.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_stats_has_perf_counters (m2c_stats_t stats) {
+  return ((stats != NULL) && (stats->perf_open));
+} /* end m2c_stats_has_perf_counters */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_perf_count(stats, phase, event)
+ * --------------------------------------------------------------------------
+ * Returns the total count of hardware event event during phase.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_stats_perf_count
+  (m2c_stats_t stats, m2c_stats_phase_t phase, m2c_stats_perf_event_t event) {
+  
+  if ((stats == NULL) || (NOT(stats->perf_open)) ||
+      (IS_VALID_STATS_PHASE(phase) == false) ||
+      (event < 0) || (event >= STATS_PERF_EVENT_COUNT)) {
+    return 0;
+  } /* end if */
+  
+  return stats->timer[phase].perf_total[event];
+} /* end m2c_stats_perf_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_stats_print_time_report(stats, filename)
+ * --------------------------------------------------------------------------
+ * Prints the phase times and hot counters of statistics record stats.
+ * Tokens per second are taken over lexing and parsing,  nodes per second
+ * over parsing alone.
+ * ----------------------------------------------------------------------- */
+
+static double per_second (uint64_t count, uint64_t nsec);
+
+static double ratio (uint64_t count, uint64_t base, double scale);
+
+void m2c_stats_print_time_report (m2c_stats_t stats, const char *filename) {
+  uint64_t wall_total, cpu_total, lex_parse_time;
+  phase_timer_t *timer;
+  uint_t phase;
+  
+  if (stats == NULL) {
+    return;
+  } /* end if */
+  
+  printf("time report: %s\n", (filename != NULL) ? filename : "");
+  
+  /* the lexer is only timed on its own when it tokenizes ahead */
+  if (stats->timer[M2C_STATS_PHASE_LEX].wall_total > 0) {
+    printf("note: source pretokenized ahead of parsing to time lexing,\n"
+      "      the streaming lexer interleaved with parsing was not timed\n");
+  } /* end if */
+  
+  printf("%-20s %12s %12s\n", "phase", "wall msec", "cpu msec");
+  
+  wall_total = 0;
+  cpu_total = 0;
+  for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+    timer = &stats->timer[phase];
+    
+    if ((timer->wall_total == 0) && (timer->cpu_total == 0)) {
+      printf("%-20s %12s %12s\n", phase_label[phase], "-", "-");
+    }
+    else {
+      printf("%-20s %12.3f %12.3f\n", phase_label[phase],
+        (double) timer->wall_total / 1.0e6,
+        (double) timer->cpu_total / 1.0e6);
+      wall_total = wall_total + timer->wall_total;
+      cpu_total = cpu_total + timer->cpu_total;
+    } /* end if */
+  } /* end for */
+  
+  printf("%-20s %12.3f %12.3f\n", "total",
+    (double) wall_total / 1.0e6, (double) cpu_total / 1.0e6);
+  
+  lex_parse_time = stats->timer[M2C_STATS_PHASE_LEX].wall_total +
+    stats->timer[M2C_STATS_PHASE_PARSE].wall_total;
+  
+  printf("tokens: %llu (%.0f/sec)\n",
+    (unsigned long long) stats->value[M2C_STATS_TOKEN_COUNT],
+    per_second(stats->value[M2C_STATS_TOKEN_COUNT], lex_parse_time));
+  printf("AST nodes: %llu (%.0f/sec)\n",
+    (unsigned long long) stats->value[M2C_STATS_AST_NODE_COUNT],
+    per_second(stats->value[M2C_STATS_AST_NODE_COUNT],
+      stats->timer[M2C_STATS_PHASE_PARSE].wall_total));
+  printf("lines: %llu, bytes: %llu\n",
+    (unsigned long long) stats->line_count,
+    (unsigned long long) stats->value[M2C_STATS_BYTES_READ]);
+  
+  if (NOT(stats->perf_open)) {
+    return;
+  } /* end if */
+  
+  /* hardware counters */
+  printf("%-20s %14s %14s %6s %8s %8s\n",
+    "phase", "cycles", "instructions", "IPC", "LLC MPKI", "br miss%");
+  
+  for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+    timer = &stats->timer[phase];
+    
+    if (timer->perf_total[M2C_STATS_PERF_INSTRUCTIONS] == 0) {
+      continue;
+    } /* end if */
+    
+    printf("%-20s %14llu %14llu %6.2f %8.2f %8.2f\n", phase_label[phase],
+      (unsigned long long) timer->perf_total[M2C_STATS_PERF_CYCLES],
+      (unsigned long long) timer->perf_total[M2C_STATS_PERF_INSTRUCTIONS],
+      ratio(timer->perf_total[M2C_STATS_PERF_INSTRUCTIONS],
+        timer->perf_total[M2C_STATS_PERF_CYCLES], 1.0),
+      ratio(timer->perf_total[M2C_STATS_PERF_CACHE_MISSES],
+        timer->perf_total[M2C_STATS_PERF_INSTRUCTIONS], 1000.0),
+      ratio(timer->perf_total[M2C_STATS_PERF_BRANCH_MISSES],
+        timer->perf_total[M2C_STATS_PERF_BRANCHES], 100.0));
+  } /* end for */
+} /* end m2c_stats_print_time_report */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_write_telemetry(stats, path, module, srcpath)
+ * --------------------------------------------------------------------------
+ * Appends a JSON lines telemetry record of stats to the file at path.
+ * ----------------------------------------------------------------------- */
+
+static void append_format (record_buffer_t *buf, const char *format, ...);
+
+static void append_json_string (record_buffer_t *buf, const char *str);
+
+static uint64_t peak_memory_kib (void);
+
+bool m2c_stats_write_telemetry
+  (m2c_stats_t stats, const char *path,
+   const char *module, const char *srcpath) {
+  
+  record_buffer_t *buf;
+  phase_timer_t *timer;
+  long int source_size;
+  uint64_t hits, misses;
+  ssize_t written;
+  uint_t phase;
+  int fd;
+  
+  if ((stats == NULL) || (path == NULL)) {
+    return false;
+  } /* end if */
+  
+  buf = malloc(sizeof(record_buffer_t));
+  
+  if (buf == NULL) {
+    return false;
+  } /* end if */
+  
+  buf->length = 0;
+  buf->overflow = false;
+  
+  if ((srcpath == NULL) || (NOT(get_filesize(srcpath, &source_size)))) {
+    source_size = -1;
+  } /* end if */
+  
+  /* module and source */
+  append_format(buf, "{\"module\":");
+  append_json_string(buf, module);
+  append_format(buf, ",\"source\":");
+  append_json_string(buf, srcpath);
+  
+  /* counters */
+  append_format(buf, ",\"source_size\":%ld", source_size);
+  append_format(buf, ",\"lines\":%llu",
+    (unsigned long long) stats->line_count);
+  append_format(buf, ",\"tokens\":%llu",
+    (unsigned long long) stats->value[M2C_STATS_TOKEN_COUNT]);
+  append_format(buf, ",\"ast_nodes\":%llu",
+    (unsigned long long) stats->value[M2C_STATS_AST_NODE_COUNT]);
+  append_format(buf, ",\"interned\":%llu",
+    (unsigned long long) stats->value[M2C_STATS_INTERN_COUNT]);
+  append_format(buf, ",\"intern_hits\":%llu",
+    (unsigned long long) stats->value[M2C_STATS_INTERN_HIT_COUNT]);
+  append_format(buf, ",\"errors\":%llu",
+    (unsigned long long) (stats->value[M2C_STATS_LEX_ERROR_COUNT] +
+      stats->value[M2C_STATS_SYNTAX_ERROR_COUNT] +
+      stats->value[M2C_STATS_SEMANTIC_ERROR_COUNT]));
+  
+  /* phase timings */
+  append_format(buf, ",\"phases\":{");
+  for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+    timer = &stats->timer[phase];
+    
+    append_format(buf, "%s\"%s\":",
+      (phase == 0) ? "" : ",", phase_key[phase]);
+    
+    if ((timer->wall_total == 0) && (timer->cpu_total == 0)) {
+      append_format(buf, "null");
+    }
+    else {
+      append_format(buf, "{\"wall_ns\":%llu,\"cpu_ns\":%llu}",
+        (unsigned long long) timer->wall_total,
+        (unsigned long long) timer->cpu_total);
+    } /* end if */
+  } /* end for */
+  append_format(buf, "}");
+  
+  /* peak memory and cache outcome */
+  append_format(buf, ",\"peak_rss_kib\":%llu",
+    (unsigned long long) peak_memory_kib());
+  
+  hits = stats->value[M2C_STATS_CACHE_HIT_COUNT];
+  misses = stats->value[M2C_STATS_CACHE_MISS_COUNT];
+  
+  if (hits > 0) {
+    append_format(buf, ",\"cache\":\"hit\"}\n");
+  }
+  else if (misses > 0) {
+    append_format(buf, ",\"cache\":\"miss\"}\n");
+  }
+  else /* not consulted */ {
+    append_format(buf, ",\"cache\":null}\n");
+  } /* end if */
+  
+  if (buf->overflow) {
+    free(buf);
+    return false;
+  } /* end if */
+  
+  /* append in a single write */
+  fd = open(path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+  
+  if (fd < 0) {
+    free(buf);
+    return false;
+  } /* end if */
+  
+  written = write(fd, buf->chars, buf->length);
+  close(fd);
+  
+  if (written != (ssize_t) buf->length) {
+    free(buf);
+    return false;
+  } /* end if */
+  
+  free(buf);
+  return true;
+} /* end m2c_stats_write_telemetry */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_stats_release(stats)
  * --------------------------------------------------------------------------
- * Deallocates statistics record stats.
+ * Closes any hardware counters of statistics record stats,  deallocates it.
  * ----------------------------------------------------------------------- */
 
 void m2c_stats_release (m2c_stats_t stats) {
+#if (M2C_STATS_PERF_COUNTERS)
+  uint_t event;
+  
+  if ((stats != NULL) && (stats->perf_open)) {
+    for (event = 0; event < STATS_PERF_EVENT_COUNT; event++) {
+      close(stats->perf_fd[event]);
+    } /* end for */
+  } /* end if */
+#endif
+  
   free(stats);
 } /* end m2c_stats_release */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function per_second(count, nsec)
+ * --------------------------------------------------------------------------
+ * Returns count per second for a duration of nsec nanoseconds,  or zero if
+ * the duration is zero.
+ * ----------------------------------------------------------------------- */
+
+static double per_second (uint64_t count, uint64_t nsec) {
+  
+  if (nsec == 0) {
+    return 0.0;
+  } /* end if */
+  
+  return ((double) count * 1.0e9) / (double) nsec;
+} /* end per_second */
+
+
+/* --------------------------------------------------------------------------
+ * private function ratio(count, base, scale)
+ * --------------------------------------------------------------------------
+ * Returns count per base multiplied by scale,  or zero if base is zero.
+ * ----------------------------------------------------------------------- */
+
+static double ratio (uint64_t count, uint64_t base, double scale) {
+  
+  if (base == 0) {
+    return 0.0;
+  } /* end if */
+  
+  return ((double) count * scale) / (double) base;
+} /* end ratio */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure read_perf_counters(stats, count)
+ * --------------------------------------------------------------------------
+ * Reads the hardware counter group of statistics record stats into count.
+ * Passes zero counts if the group cannot be read.
+ * ----------------------------------------------------------------------- */
+
+static void read_perf_counters
+  (m2c_stats_t stats, uint64_t count[STATS_PERF_EVENT_COUNT]) {
+  
+  uint_t event;
+#if (M2C_STATS_PERF_COUNTERS)
+  /* layout of a group read without time fields */
+  struct {
+    uint64_t nr;
+    uint64_t value[STATS_PERF_EVENT_COUNT];
+  } group;
+  
+  if ((read(stats->perf_fd[0], &group, sizeof(group)) == sizeof(group)) &&
+      (group.nr == STATS_PERF_EVENT_COUNT)) {
+    for (event = 0; event < STATS_PERF_EVENT_COUNT; event++) {
+      count[event] = group.value[event];
+    } /* end for */
+    return;
+  } /* end if */
+#else
+  (void) stats;
+#endif
+  
+  for (event = 0; event < STATS_PERF_EVENT_COUNT; event++) {
+    count[event] = 0;
+  } /* end for */
+} /* end read_perf_counters */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure append_format(buf, format, ...)
+ * --------------------------------------------------------------------------
+ * Appends formatted output to telemetry record buf,  sets the overflow flag
+ * of buf if the output does not fit.
+ * ----------------------------------------------------------------------- */
+
+static void append_format (record_buffer_t *buf, const char *format, ...) {
+  va_list args;
+  uint_t avail;
+  int len;
+  
+  if (buf->overflow) {
+    return;
+  } /* end if */
+  
+  avail = TELEMETRY_RECORD_SIZE - buf->length;
+  
+  va_start(args, format);
+  len = vsnprintf(buf->chars + buf->length, avail, format, args);
+  va_end(args);
+  
+  if ((len < 0) || ((uint_t) len >= avail)) {
+    buf->overflow = true;
+    return;
+  } /* end if */
+  
+  buf->length = buf->length + (uint_t) len;
+} /* end append_format */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure append_json_string(buf, str)
+ * --------------------------------------------------------------------------
+ * Appends str as a quoted JSON string to telemetry record buf,  escaping
+ * quotes,  backslashes and control characters.  Appends null if str is NULL.
+ * ----------------------------------------------------------------------- */
+
+static void append_json_string (record_buffer_t *buf, const char *str) {
+  unsigned char ch;
+  
+  if (str == NULL) {
+    append_format(buf, "null");
+    return;
+  } /* end if */
+  
+  append_format(buf, "\"");
+  
+  while ((*str != ASCII_NUL) && (NOT(buf->overflow))) {
+    ch = (unsigned char) *str;
+    
+    if ((ch == '"') || (ch == '\\')) {
+      append_format(buf, "\\%c", ch);
+    }
+    else if (ch < 0x20) {
+      append_format(buf, "\\u%04x", ch);
+    }
+    else /* plain character */ {
+      append_format(buf, "%c", ch);
+    } /* end if */
+    
+    str++;
+  } /* end while */
+  
+  append_format(buf, "\"");
+} /* end append_json_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function peak_memory_kib()
+ * --------------------------------------------------------------------------
+ * Returns the peak resident memory of the process in KiB,  or zero if it is
+ * not available.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t peak_memory_kib (void) {
+  struct rusage usage;
+  
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  } /* end if */
+  
+#if defined(__MACH__)
+  /* reported in bytes */
+  return (uint64_t) usage.ru_maxrss / 1024;
+#else
+  /* reported in KiB */
+  return (uint64_t) usage.ru_maxrss;
+#endif
+} /* end peak_memory_kib */
+
+
+/* --------------------------------------------------------------------------
+ * private function wall_clock_ns()
+ * --------------------------------------------------------------------------
+ * Returns the time of a monotonic clock in nanoseconds,  or wall clock time
+ * in whole seconds where no monotonic clock is available.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t wall_clock_ns (void) {
+#if defined(CLOCK_MONOTONIC)
+  struct timespec now;
+  
+  if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+  } /* end if */
+#endif
+  
+  return (uint64_t) time(NULL) * 1000000000;
+} /* end wall_clock_ns */
+
+
+/* --------------------------------------------------------------------------
+ * private function cpu_clock_ns()
+ * --------------------------------------------------------------------------
+ * Returns the CPU time of the calling thread in nanoseconds,  or that of the
+ * process where no thread CPU clock is available.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t cpu_clock_ns (void) {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec now;
+  
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+  } /* end if */
+#endif
+  
+  return (uint64_t) ((double) clock() * 1.0e9 / CLOCKS_PER_SEC);
+} /* end cpu_clock_ns */
+
+
+/* END OF FILE */
@@ -0,0 +1,582 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-string-pool.c                                                         *
+ *                                                                           *
+ * Implementation of pooling of string literals in generated C.              *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-string-pool.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type pool_entry_t
+ * --------------------------------------------------------------------------
+ * Entry of a string pool,  holding the first lexeme added for a string,
+ * the hash of the string and its length,  both without delimiters.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  intstr_t lexeme;
+  uint64_t hash;
+  uint_t length;
+} pool_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_string_pool_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a string pool.  Entries are kept in the order
+ * they were added.  They are indexed by a hash table of entry indices plus
+ * one,  zero marking an empty slot,  with open addressing and linear
+ * probing.  The number of slots is a power of two.
+ * ----------------------------------------------------------------------- */
+
+#define POOL_INITIAL_CAPACITY 32
+
+struct m2c_string_pool_struct_t {
+  pool_entry_t *entry;
+  uint_t count;
+  uint_t capacity;
+  uint_t *slot;
+  uint_t slot_count;
+};
+
+typedef struct m2c_string_pool_struct_t m2c_string_pool_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type collector_t
+ * --------------------------------------------------------------------------
+ * Context of m2c_string_pool_add_literals.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_string_pool_t pool;
+  m2c_string_use_f is_pooled;
+  void *context;
+  uint_t added;
+} collector_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t collect_literal (m2c_astnode_t node, void *data);
+
+static bool string_of_lexeme
+  (intstr_t lexeme, const char **text, uint_t *length);
+
+static uint64_t string_hash (const char *text, uint_t length);
+
+static pool_entry_t *lookup_entry
+  (m2c_string_pool_t pool, const char *text, uint_t length, uint64_t hash);
+
+static bool grow_pool (m2c_string_pool_t pool);
+
+static void write_name (outfile_t outfile, pool_entry_t *entry, bool upper);
+
+static void write_string_text (outfile_t outfile, const char *text,
+  uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_string_pool()
+ * --------------------------------------------------------------------------
+ * Returns a new empty string literal pool,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_pool_t m2c_new_string_pool (void) {
+  
+  m2c_string_pool_t pool;
+  
+  pool = malloc(sizeof(m2c_string_pool_struct_t));
+  
+  if (pool == NULL) {
+    return NULL;
+  } /* end if */
+  
+  pool->entry = malloc(POOL_INITIAL_CAPACITY * sizeof(pool_entry_t));
+  pool->slot = calloc(2 * POOL_INITIAL_CAPACITY, sizeof(uint_t));
+  
+  if ((pool->entry == NULL) || (pool->slot == NULL)) {
+    free(pool->entry);
+    free(pool->slot);
+    free(pool);
+    return NULL;
+  } /* end if */
+  
+  pool->count = 0;
+  pool->capacity = POOL_INITIAL_CAPACITY;
+  pool->slot_count = 2 * POOL_INITIAL_CAPACITY;
+  
+  return pool;
+} /* end m2c_new_string_pool */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_pool_add(pool, lexeme)
+ * --------------------------------------------------------------------------
+ * Adds quoted literal lexeme to pool unless its string is already in pool.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_string_pool_add (m2c_string_pool_t pool, intstr_t lexeme) {
+  
+  const char *text;
+  uint_t length, mask, index;
+  pool_entry_t *entry;
+  uint64_t hash;
+  
+  if ((pool == NULL) || NOT(string_of_lexeme(lexeme, &text, &length))) {
+    return false;
+  } /* end if */
+  
+  hash = string_hash(text, length);
+  
+  if (lookup_entry(pool, text, length, hash) != NULL) {
+    return true;
+  } /* end if */
+  
+  if ((pool->count == pool->capacity) && NOT(grow_pool(pool))) {
+    return false;
+  } /* end if */
+  
+  entry = &pool->entry[pool->count];
+  entry->lexeme = lexeme;
+  entry->hash = hash;
+  entry->length = length;
+  pool->count++;
+  
+  mask = pool->slot_count - 1;
+  index = (uint_t) hash & mask;
+  while (pool->slot[index] != 0) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  pool->slot[index] = pool->count;
+  
+  return true;
+} /* end m2c_string_pool_add */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_pool_add_literals(pool, root, is_pooled, context)
+ * --------------------------------------------------------------------------
+ * Adds the quoted literals of the AST rooted at root to pool.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_string_pool_add_literals
+  (m2c_string_pool_t pool,                  /* in */
+   m2c_astnode_t root,                      /* in */
+   m2c_string_use_f is_pooled,              /* in */
+   void *context) {                         /* in */
+  
+  collector_t collector;
+  
+  if ((pool == NULL) || (root == NULL)) {
+    return 0;
+  } /* end if */
+  
+  collector.pool = pool;
+  collector.is_pooled = is_pooled;
+  collector.context = context;
+  collector.added = 0;
+  
+  m2c_ast_visit(root, collect_literal, NULL, &collector);
+  
+  return collector.added;
+} /* end m2c_string_pool_add_literals */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_pool_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of distinct strings in pool.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_string_pool_count (m2c_string_pool_t pool) {
+  
+  if (pool == NULL) {
+    return 0;
+  } /* end if */
+  
+  return pool->count;
+} /* end m2c_string_pool_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_string_pool(outfile, pool)
+ * --------------------------------------------------------------------------
+ * Writes the guarded definitions of the strings in pool to outfile.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_string_pool (outfile_t outfile, m2c_string_pool_t pool) {
+  
+  pool_entry_t *entry;
+  uint_t index;
+  
+  if ((outfile == NULL) || (pool == NULL)) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < pool->count; index++) {
+    entry = &pool->entry[index];
+  
+    /* #ifndef M2C_STR_len_HASH */
+    outfile_write_chars(outfile, "#ifndef ");
+    write_name(outfile, entry, true);
+    outfile_write_newline(outfile);
+  
+    /* #define M2C_STR_len_HASH */
+    outfile_write_chars(outfile, "#define ");
+    write_name(outfile, entry, true);
+    outfile_write_newline(outfile);
+  
+    /* static const char m2c_str_len_hash[] = "text"; */
+    outfile_write_chars(outfile, "static const char ");
+    write_name(outfile, entry, false);
+    outfile_write_chars(outfile, "[] = \"");
+    write_string_text(outfile,
+      intstr_char_ptr(entry->lexeme) + 1, entry->length);
+    outfile_write_chars(outfile, "\";");
+    outfile_write_newline(outfile);
+  
+    /* #endif */
+    outfile_write_chars(outfile, "#endif");
+    outfile_write_newline(outfile);
+  } /* end for */
+} /* end m2c_write_string_pool */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_write_string_ref(outfile, pool, lexeme)
+ * --------------------------------------------------------------------------
+ * Writes the name of the array for quoted literal lexeme in pool.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_write_string_ref
+  (outfile_t outfile, m2c_string_pool_t pool, intstr_t lexeme) {
+  
+  const char *text;
+  uint_t length;
+  pool_entry_t *entry;
+  
+  if ((outfile == NULL) || (pool == NULL) ||
+      NOT(string_of_lexeme(lexeme, &text, &length))) {
+    return false;
+  } /* end if */
+  
+  entry = lookup_entry(pool, text, length, string_hash(text, length));
+  
+  if (entry == NULL) {
+    return false;
+  } /* end if */
+  
+  write_name(outfile, entry, false);
+  
+  return true;
+} /* end m2c_write_string_ref */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_string_pool(pool)
+ * --------------------------------------------------------------------------
+ * Deallocates pool.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_string_pool (m2c_string_pool_t pool) {
+  
+  if (pool == NULL) {
+    return;
+  } /* end if */
+  
+  free(pool->entry);
+  free(pool->slot);
+  free(pool);
+} /* end m2c_release_string_pool */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function collect_literal(node, data)
+ * --------------------------------------------------------------------------
+ * Visitor callback.  Adds quoted literal node to the pool of the collector
+ * passed in data,  if the collector's predicate admits it.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_visit_action_t collect_literal (m2c_astnode_t node, void *data) {
+  
+  collector_t *collector = (collector_t *) data;
+  uint_t count;
+  
+  if (m2c_ast_nodetype(node) != AST_QUOTEDVAL) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  if ((collector->is_pooled != NULL) &&
+      NOT(collector->is_pooled(node, collector->context))) {
+    return M2C_AST_VISIT_CONTINUE;
+  } /* end if */
+  
+  count = collector->pool->count;
+  
+  if (m2c_string_pool_add(collector->pool, m2c_ast_value(node)) &&
+      (collector->pool->count > count)) {
+    collector->added++;
+  } /* end if */
+  
+  return M2C_AST_VISIT_CONTINUE;
+} /* end collect_literal */
+
+
+/* --------------------------------------------------------------------------
+ * private function string_of_lexeme(lexeme, text, length)
+ * --------------------------------------------------------------------------
+ * Passes the string of quoted literal lexeme,  without its delimiters,  in
+ * text and length and returns true,  or returns false if lexeme is NULL or
+ * not delimited.  The string is not NUL terminated.
+ * ----------------------------------------------------------------------- */
+
+static bool string_of_lexeme
+  (intstr_t lexeme, const char **text, uint_t *length) {
+  
+  const char *chars;
+  uint_t lexeme_length;
+  
+  if (lexeme == NULL) {
+    return false;
+  } /* end if */
+  
+  chars = intstr_char_ptr(lexeme);
+  lexeme_length = intstr_length(lexeme);
+  
+  if ((chars == NULL) || (lexeme_length < 2) ||
+      ((chars[0] != '"') && (chars[0] != '\'')) ||
+      (chars[lexeme_length - 1] != chars[0])) {
+    return false;
+  } /* end if */
+  
+  *text = chars + 1;
+  *length = lexeme_length - 2;
+  
+  return true;
+} /* end string_of_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * private function string_hash(text, length)
+ * --------------------------------------------------------------------------
+ * Returns the 64-bit FNV-1a hash of the length characters at text.  The
+ * hash is part of the generated names and must not depend on the host.
+ * ----------------------------------------------------------------------- */
+
+#define FNV64_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV64_PRIME 0x100000001b3ull
+
+static uint64_t string_hash (const char *text, uint_t length) {
+  
+  uint64_t hash = FNV64_OFFSET_BASIS;
+  uint_t index;
+  
+  for (index = 0; index < length; index++) {
+    hash = (hash ^ (unsigned char) text[index]) * FNV64_PRIME;
+  } /* end for */
+  
+  return hash;
+} /* end string_hash */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_entry(pool, text, length, hash)
+ * --------------------------------------------------------------------------
+ * Returns the entry of pool for the string of length characters at text
+ * with hash,  or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+static pool_entry_t *lookup_entry
+  (m2c_string_pool_t pool, const char *text, uint_t length, uint64_t hash) {
+  
+  uint_t mask, index;
+  pool_entry_t *entry;
+  
+  mask = pool->slot_count - 1;
+  index = (uint_t) hash & mask;
+  
+  while (pool->slot[index] != 0) {
+    entry = &pool->entry[pool->slot[index] - 1];
+  
+    if ((entry->hash == hash) && (entry->length == length) &&
+        (memcmp(intstr_char_ptr(entry->lexeme) + 1, text, length) == 0)) {
+      return entry;
+    } /* end if */
+  
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end lookup_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_pool(pool)
+ * --------------------------------------------------------------------------
+ * Doubles the entry capacity and the slot count of pool,  keeping the slot
+ * table at most half full.  Returns true on success,  false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_pool (m2c_string_pool_t pool) {
+  
+  pool_entry_t *new_entry;
+  uint_t *new_slot;
+  uint_t index, slot_index, mask;
+  
+  new_entry =
+    realloc(pool->entry, 2 * pool->capacity * sizeof(pool_entry_t));
+  
+  if (new_entry == NULL) {
+    return false;
+  } /* end if */
+  
+  pool->entry = new_entry;
+  
+  new_slot = calloc(2 * pool->slot_count, sizeof(uint_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  pool->capacity = 2 * pool->capacity;
+  
+  /* rehash */
+  mask = 2 * pool->slot_count - 1;
+  for (index = 0; index < pool->count; index++) {
+    slot_index = (uint_t) pool->entry[index].hash & mask;
+  
+    while (new_slot[slot_index] != 0) {
+      slot_index = (slot_index + 1) & mask;
+    } /* end while */
+  
+    new_slot[slot_index] = index + 1;
+  } /* end for */
+  
+  free(pool->slot);
+  pool->slot = new_slot;
+  pool->slot_count = 2 * pool->slot_count;
+  
+  return true;
+} /* end grow_pool */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_name(outfile, entry, upper)
+ * --------------------------------------------------------------------------
+ * Writes the array name of entry to outfile,  or if upper is true,  the
+ * name of its guard macro.
+ * ----------------------------------------------------------------------- */
+
+static void write_name (outfile_t outfile, pool_entry_t *entry, bool upper) {
+  
+  char name[48];
+  
+  snprintf(name, sizeof(name), (upper ? "M2C_STR_%u_%016llX" :
+    "m2c_str_%u_%016llx"), (unsigned) entry->length,
+    (unsigned long long) entry->hash);
+  
+  outfile_write_chars(outfile, name);
+} /* end write_name */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_string_text(outfile, text, length)
+ * --------------------------------------------------------------------------
+ * Writes the length characters at text for use within a C string literal.
+ * Escape sequences \n, \t and \\ are valid in C and written as they are.
+ * Double quotes are escaped,  and a question mark after a question mark is
+ * escaped to rule out trigraphs.
+ * ----------------------------------------------------------------------- */
+
+static void write_string_text (outfile_t outfile, const char *text,
+  uint_t length) {
+  
+  uint_t index;
+  char prev_ch;
+  
+  prev_ch = '\0';
+  for (index = 0; index < length; index++) {
+    switch (text[index]) {
+      case '"' :
+        outfile_write_chars(outfile, "\\\"");
+        break;
+  
+      case '?' :
+        if (prev_ch == '?') {
+          outfile_write_chars(outfile, "\\?");
+        }
+        else {
+          outfile_write_char(outfile, '?');
+        } /* end if */
+        break;
+  
+      case '\\' :
+        /* copy the escape sequence,  the lexer admits only valid ones */
+        outfile_write_char(outfile, '\\');
+        if (index + 1 < length) {
+          index++;
+          outfile_write_char(outfile, text[index]);
+        } /* end if */
+        break;
+  
+      default :
+        outfile_write_char(outfile, text[index]);
+    } /* end switch */
+  
+    prev_ch = text[index];
+  } /* end for */
+} /* end write_string_text */
+
+/* END OF FILE */
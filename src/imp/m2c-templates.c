@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * imp/m2c-templates.c                                                       *
+ *                                                                           *
+ * Implementation of C code generation template module.                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "m2c-templates.h"
+
+#include <stddef.h> /* NULL */
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_template_item_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the kinds of template items.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  TEMPLATE_ITEM_SPAN,     /* literal span of value bytes at text */
+  TEMPLATE_ITEM_SLOT,     /* placeholder for slot value */
+  TEMPLATE_ITEM_FOREACH,  /* iteration over slot value */
+  TEMPLATE_ITEM_INCLUDE   /* inclusion of template value */
+} m2c_template_item_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_template_item_t
+ * --------------------------------------------------------------------------
+ * Record type representing an item of a compiled template.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_template_item_kind_t kind;
+  uint16_t value;
+  const char *text;
+} m2c_template_item_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_template_entry_t
+ * --------------------------------------------------------------------------
+ * Record type representing a compiled template,  a range of items.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *name;
+  uint16_t first;
+  uint16_t count;
+} m2c_template_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * Template tables
+ * --------------------------------------------------------------------------
+ * Generated by utility gen-c-templates from templates/c99-templates.tpl,
+ * defines m2c_template_item and m2c_template_table.
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-template-table.h"
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_template_expand(outfile, template, handler, context)
+ * --------------------------------------------------------------------------
+ * Writes the expansion of template to outfile.
+ * ----------------------------------------------------------------------- */
+
+void m2c_template_expand
+  (outfile_t outfile,
+   m2c_template_t template,
+   m2c_template_slot_handler_t handler,
+   void *context) {
+  
+  const m2c_template_item_t *this_item, *end;
+  
+  if ((outfile == NULL) ||
+      ((unsigned) template >= M2C_TEMPLATE_END_MARK)) {
+    return;
+  } /* end if */
+  
+  this_item = &m2c_template_item[m2c_template_table[template].first];
+  end = this_item + m2c_template_table[template].count;
+  
+  while (this_item < end) {
+    switch (this_item->kind) {
+      
+      case TEMPLATE_ITEM_SPAN :
+        outfile_write_bytes(outfile, this_item->text, this_item->value);
+        break;
+      
+      case TEMPLATE_ITEM_SLOT :
+      case TEMPLATE_ITEM_FOREACH :
+        if (handler != NULL) {
+          handler(outfile, (m2c_template_slot_t) this_item->value,
+            (this_item->kind == TEMPLATE_ITEM_FOREACH), context);
+        } /* end if */
+        break;
+      
+      case TEMPLATE_ITEM_INCLUDE :
+        /* inclusions are acyclic, checked by gen-c-templates */
+        m2c_template_expand
+          (outfile, (m2c_template_t) this_item->value, handler, context);
+        break;
+      
+    } /* end switch */
+    
+    this_item++;
+  } /* end while */
+  
+  return;
+} /* end m2c_template_expand */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_template_name(template)
+ * --------------------------------------------------------------------------
+ * Returns the name of template,  or NULL if template is invalid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_template_name (m2c_template_t template) {
+  
+  if ((unsigned) template >= M2C_TEMPLATE_END_MARK) {
+    return NULL;
+  } /* end if */
+  
+  return m2c_template_table[template].name;
+} /* end m2c_template_name */
+
+
+/* END OF FILE */
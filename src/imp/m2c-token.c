@@ -67,7 +67,6 @@ static const char *token_name_table[] = {
   "RW-CASE\0",
   "RW-CONST\0",
   "RW-COPY\0",
-  "RW-DEFINITION\0",
   "RW-DIV\0",
   "RW-DO\0",
   "RW-ELSE\0",
@@ -79,6 +78,7 @@ static const char *token_name_table[] = {
   "RW-IMPLEMENTATION\0",
   "RW-IMPORT\0",
   "RW-IN\0",
+  "RW-INTERFACE\0",
   "RW-LOOP\0",
   "RW-MOD\0",
   "RW-MODULE\0",
@@ -307,7 +307,7 @@ const char *m2c_lexeme_for_resword (m2c_token_t token) {
 
 const char *m2c_lexeme_for_special_symbol (m2c_token_t token) {
   if (M2C_IS_SPECIAL_SYMBOL_TOKEN(token)) {
-    return special_symbol_lexeme_table[token];
+    return special_symbol_lexeme_table[token - FIRST_SPECIAL_SYMBOL_TOKEN];
   }
   else /* not a special symbol token */ {
     return NULL;
@@ -1 +0,0 @@
-m2c-tokenset.32bit.c
\ No newline at end of file
@@ -0,0 +1,419 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-tokenset.c                                                            *
+ *                                                                           *
+ * Implementation of M2C tokenset type.                                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-tokenset.h"
+#include "m2c-mem-account.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type segment_t
+ * --------------------------------------------------------------------------
+ * Type representing bitmap segments in a tokenset.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_tokenset_segment_t segment_t;
+
+
+/* --------------------------------------------------------------------------
+ * constant SEGMENT_BITWIDTH
+ * --------------------------------------------------------------------------
+ * Size of a segment in bits.
+ * ----------------------------------------------------------------------- */
+
+#define SEGMENT_BITWIDTH M2C_TOKENSET_SEGMENT_BITWIDTH
+
+
+/* --------------------------------------------------------------------------
+ * constant SEGMENT_TYPE_NAME, SEGMENT_HEX_DIGITS
+ * --------------------------------------------------------------------------
+ * Name of the segment type and number of hex digits of a segment literal.
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_TOKENSET_SEGMENT_BITWIDTH == 16)
+#define SEGMENT_TYPE_NAME "uint16_t"
+#elif (M2C_TOKENSET_SEGMENT_BITWIDTH == 32)
+#define SEGMENT_TYPE_NAME "uint32_t"
+#else
+#define SEGMENT_TYPE_NAME "uint64_t"
+#endif
+
+#define SEGMENT_HEX_DIGITS (SEGMENT_BITWIDTH / 4)
+
+
+/* --------------------------------------------------------------------------
+ * constant SEGMENT_COUNT
+ * --------------------------------------------------------------------------
+ * Number of segments in a tokenset.
+ * ----------------------------------------------------------------------- */
+
+#define SEGMENT_COUNT M2C_TOKENSET_SEGMENT_COUNT
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_tokenset_from_list(token_list)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated tokenset object that includes the tokens passed
+ * as arguments of a non-empty variadic argument list.  The argument list
+ * must be explicitly terminated with 0.
+ * ----------------------------------------------------------------------- */
+
+unsigned count_bits_in_set (m2c_tokenset_t set);
+
+m2c_tokenset_t m2c_new_tokenset_from_list (m2c_token_t first_token, ...) {
+  m2c_tokenset_t new_set;
+  unsigned bit, seg_index;
+  m2c_token_t token;
+  
+  va_list token_list;
+  va_start(token_list, first_token);
+  
+  /* allocate new set */
+  new_set = m2c_mem_alloc(M2C_MEM_TOKENSET, sizeof(m2c_tokenset_s));
+  
+  /* bail out if allocation failed */
+  if (new_set == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* initialise */
+  seg_index = 0;
+  while (seg_index < SEGMENT_COUNT) {
+    new_set->segment[seg_index] = 0;
+    seg_index++;
+  } /* end while */
+  
+  /* store tokens from list */
+  token = first_token;
+  while (token != 0) {
+  
+    /* store token in set if in range */
+    if (token < TOKEN_END_MARK) {
+      seg_index = token / SEGMENT_BITWIDTH;
+      bit = token % SEGMENT_BITWIDTH;
+      new_set->segment[seg_index] =
+        new_set->segment[seg_index] | ((segment_t) 1 << bit);
+    } /* end if */
+    
+    /* get next token in list */
+    token = va_arg(token_list, m2c_token_t);
+  } /* end while */
+  
+  /* update element counter */
+  new_set->elem_count = count_bits_in_set(new_set);
+  
+  return new_set;
+} /* end m2c_new_tokenset_from_list */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_tokenset_from_union(set_list)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated tokenset object that represents the set union of
+ * the tokensets passed as arguments of a non-empty variadic argument list.
+ * The argument list must be explicitly terminated with NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_tokenset_t m2c_new_tokenset_from_union (m2c_tokenset_t first_set, ...) {
+  m2c_tokenset_t new_set;
+  unsigned seg_index;
+  m2c_tokenset_t set;
+  
+  va_list set_list;
+  va_start(set_list, first_set);
+  
+  /* allocate new set */
+  new_set = m2c_mem_alloc(M2C_MEM_TOKENSET, sizeof(m2c_tokenset_s));
+  
+  /* bail out if allocation failed */
+  if (new_set == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* initialise */
+  seg_index = 0;
+  while (seg_index < SEGMENT_COUNT) {
+    new_set->segment[seg_index] = 0;
+    seg_index++;
+  } /* end while */
+  
+  set = first_set;
+  /* calculate union with each set in list */
+  while (set != NULL) {
+    /* for each segment ... */
+    seg_index = 0;
+    while (seg_index < SEGMENT_COUNT) {
+      /* ... store union of corresponding segments */
+      new_set->segment[seg_index] =
+        new_set->segment[seg_index] | set->segment[seg_index];
+      
+      /* next segment */
+      seg_index++;
+    } /* end while */
+    
+    /* get next set in list */
+    set = va_arg(set_list, m2c_tokenset_t);
+  } /* end while */
+  
+  /* update element counter */
+  new_set->elem_count = count_bits_in_set(new_set);
+  
+  return new_set;
+} /* m2c_new_tokenset_from_union */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_print_set(set_name, set)
+ * --------------------------------------------------------------------------
+ * Prints a human readable representation of set.
+ * Format: set_name = { comma-separated list of tokens };
+ * ----------------------------------------------------------------------- */
+
+void m2c_tokenset_print_set (const char *set_name, m2c_tokenset_t set) {
+  unsigned bit, seg_index, count;
+  m2c_token_t token;
+  
+  printf("%s = {", set_name);
+  
+  if (set->elem_count == 0) {
+    printf(" ");
+  } /* end if */
+  
+  count = 0; token = 0;
+  while ((count <= set->elem_count) && (token < TOKEN_END_MARK)) {
+    seg_index = token / SEGMENT_BITWIDTH;
+    bit = token % SEGMENT_BITWIDTH;
+    if ((set->segment[seg_index] & ((segment_t) 1 << bit)) != 0) {
+      count++;
+      if (count < set->elem_count) {
+        printf("\n  %s,", m2c_name_for_token(token));
+      }
+      else {
+        printf("\n  %s\n", m2c_name_for_token(token));
+      } /* end if */
+    } /* end if */
+    token++;
+  } /* end while */
+  
+  printf("};\n");
+} /* m2c_tokenset_print_set */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_print_list(set)
+ * --------------------------------------------------------------------------
+ * Prints a human readable list of symbols in set.
+ * Format: first, second, third, ..., secondToLast or last
+ * ----------------------------------------------------------------------- */
+
+void m2c_tokenset_print_list (m2c_tokenset_t set) {
+  char str[M2C_TOKENSET_LIST_STR_SIZE];
+  
+  m2c_tokenset_list_to_str(set, str, sizeof(str));
+  printf("%s.\n", str);
+} /* m2c_tokenset_print_list */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_list_to_str(set, str, size)
+ * --------------------------------------------------------------------------
+ * Writes a human readable list of symbols in set to str.
+ * Format: first, second, third, ..., secondToLast or last
+ * ----------------------------------------------------------------------- */
+
+#define APPEND_TO_STR(_format, _arg) \
+  if (length < size) { \
+    length += snprintf(&str[length], size - length, _format, _arg); \
+  }
+
+void m2c_tokenset_list_to_str (m2c_tokenset_t set, char *str, size_t size) {
+  unsigned bit, seg_index, count;
+  m2c_token_t token;
+  size_t length;
+  
+  if ((str == NULL) || (size == 0)) {
+    return;
+  } /* end if */
+  
+  str[0] = '\0';
+  length = 0;
+  
+  if (set->elem_count == 0) {
+    APPEND_TO_STR("%s", "(nil)");
+  } /* end if */
+  
+  count = 0; token = 0;
+  while ((count <= set->elem_count) && (token < TOKEN_END_MARK)) {
+    seg_index = token / SEGMENT_BITWIDTH;
+    bit = token % SEGMENT_BITWIDTH;
+    
+    if ((set->segment[seg_index] & ((segment_t) 1 << bit)) != 0) {
+      count++;
+      if (count > 1) {
+        if (count < set->elem_count) {
+          APPEND_TO_STR("%s", ", ");
+        }
+        else {
+          APPEND_TO_STR("%s", " or ");
+        } /* end if */
+      } /* end if */
+      
+      if (token == TOKEN_IDENT) {
+        APPEND_TO_STR("%s", "identifier");
+      }
+      else if (token == TOKEN_QUOTED_STRING) {
+        APPEND_TO_STR("%s", "string");
+      }
+      else if (token == TOKEN_WHOLE_NUMBER) {
+        APPEND_TO_STR("%s", "whole number");
+      }
+      else if (token == TOKEN_REAL_NUMBER) {
+        APPEND_TO_STR("%s", "real number");
+      }
+      else if (token == TOKEN_CHAR_CODE) {
+        APPEND_TO_STR("%s", "character code");
+      }
+      else if (M2C_IS_RESWORD_TOKEN(token)) {
+        APPEND_TO_STR("%s", m2c_lexeme_for_resword(token));
+      }
+      else if (M2C_IS_SPECIAL_SYMBOL_TOKEN(token)) {
+        APPEND_TO_STR("'%s'", m2c_lexeme_for_special_symbol(token));
+      }
+      else if (token == TOKEN_EOF) {
+        APPEND_TO_STR("%s", "<EOF>");
+      } /* end if */
+    } /* end if */
+    token++;
+  } /* end while */
+  
+} /* m2c_tokenset_list_to_str */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_print_literal_struct(ident)
+ * --------------------------------------------------------------------------
+ * Prints a struct definition for tokenset literals.
+ * Format: struct ident { uintNN_t s0, s1, s2, ...; unsigned short n };
+ * ----------------------------------------------------------------------- */
+
+void m2c_tokenset_print_literal_struct (const char *ident) {
+  unsigned seg_index;
+  
+  printf("struct %s { %s s0", ident, SEGMENT_TYPE_NAME);
+  
+  seg_index = 1;
+  while (seg_index < SEGMENT_COUNT) {
+    printf(", s%u", seg_index);
+    seg_index++;
+  } /* end while */
+  
+  printf("; unsigned short n; };\n");
+  
+  printf("typedef struct %s %s;\n", ident, ident);
+} /* m2c_tokenset_print_literal_struct */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_print_literal(set)
+ * --------------------------------------------------------------------------
+ * Prints a sequence of hex values representing the bit pattern of set.
+ * Format: { 0xHHHHHHHH, 0xHHHHHHHH, ..., count };
+ * ----------------------------------------------------------------------- */
+
+void m2c_tokenset_print_literal (m2c_tokenset_t set) {
+  unsigned seg_index;
+  
+  /* print list head and first segment */
+  printf("{ /* bits: */ 0x%0*llX",
+    SEGMENT_HEX_DIGITS, (unsigned long long) set->segment[0]);
+  
+  /* print remaining segments */
+  seg_index = 1;
+  while (seg_index < SEGMENT_COUNT) {  
+    printf(", 0x%0*llX",
+      SEGMENT_HEX_DIGITS, (unsigned long long) set->segment[seg_index]);
+    seg_index++;
+  } /* end while */
+  
+/* print counter and list tail */
+  printf(", /* counter: */ %u }\n", set->elem_count);
+} /* m2c_tokenset_print_literal */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_release(set)
+ * --------------------------------------------------------------------------
+ * Deallocates tokenset set.
+ * ----------------------------------------------------------------------- */
+
+void m2c_tokenset_release (m2c_tokenset_t set) {
+  if (set != NULL) {
+    m2c_mem_free(M2C_MEM_TOKENSET, set);
+  } /* end if */
+} /* end m2c_tokenset_release */
+
+
+/* --------------------------------------------------------------------------
+ * private function count_bits_in_set(set)
+ * --------------------------------------------------------------------------
+ * Returns the number of set bits in set.
+ * ----------------------------------------------------------------------- */
+
+unsigned count_bits_in_set (m2c_tokenset_t set) {
+  unsigned seg_index, bit_count;
+  
+  bit_count = 0;
+  seg_index = 0;
+  
+  while (seg_index < SEGMENT_COUNT) {
+    bit_count += M2C_TOKENSET_POPCOUNT(set->segment[seg_index]);
+    seg_index++;
+  } /* end while */
+  
+  return bit_count;
+} /* count_bits_in_set */
+
+/* END OF FILE */
\ No newline at end of file
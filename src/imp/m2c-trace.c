@@ -0,0 +1,440 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-trace.c                                                               *
+ *                                                                           *
+ * Implementation of trace event recorder.                                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
+
+#include "m2c-trace.h"
+
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#if (M2C_TRACE_THREAD_SAFE)
+#include <pthread.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a lane label,  longer labels are truncated
+ * ----------------------------------------------------------------------- */
+
+#define MAX_LANE_LABEL_LENGTH 63
+
+
+/* --------------------------------------------------------------------------
+ * private type trace_state_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of the trace of the process.  Field file is
+ * NULL while no trace is open.  Lanes are numbered in the order in which
+ * threads first record.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* file */        FILE *file;
+  /* pid */         long pid;
+  /* origin */      uint64_t origin;
+  /* event_count */ uint64_t event_count;
+  /* next_lane */   uint_t next_lane;
+#if (M2C_TRACE_THREAD_SAFE)
+  /* lock */        pthread_mutex_t lock;
+  /* lane_key */    pthread_key_t lane_key;
+#endif
+} trace_state_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variable trace
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_TRACE_THREAD_SAFE)
+static trace_state_t trace = { NULL, 0, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER };
+
+static pthread_once_t lane_key_once = PTHREAD_ONCE_INIT;
+#else
+static trace_state_t trace = { NULL, 0, 0, 0, 0 };
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint64_t clock_ns (void);
+
+static uint_t lane_of_caller (void);
+
+static void write_event_head (char phase, const char *name, uint_t lane);
+
+static void write_json_string (const char *str);
+
+#if (M2C_TRACE_THREAD_SAFE)
+static void create_lane_key (void);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_open(path, status)
+ * --------------------------------------------------------------------------
+ * Creates a trace event file at path and starts recording.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_open (const char *path, m2c_trace_status_t *status) {
+  
+  FILE *file;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_TRACE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (trace.file != NULL) {
+    SET_STATUS(status, M2C_TRACE_STATUS_ALREADY_OPEN);
+    return;
+  } /* end if */
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_once(&lane_key_once, create_lane_key);
+#endif
+  
+  file = fopen(path, "w");
+  
+  if (file == NULL) {
+    SET_STATUS(status, M2C_TRACE_STATUS_FILE_ACCESS_DENIED);
+    return;
+  } /* end if */
+  
+  fputs("[\n", file);
+  
+  trace.pid = (long) getpid();
+  trace.origin = clock_ns();
+  trace.event_count = 0;
+  trace.next_lane = 0;
+  trace.file = file;
+  
+  SET_STATUS(status, M2C_TRACE_STATUS_SUCCESS);
+  return;
+} /* end m2c_trace_open */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_trace_enabled()
+ * --------------------------------------------------------------------------
+ * Returns true if a trace is open,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_trace_enabled (void) {
+  return (trace.file != NULL);
+} /* end m2c_trace_enabled */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_begin(name, module)
+ * --------------------------------------------------------------------------
+ * Records the begin of a span on the lane of the calling thread.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_begin (const char *name, const char *module) {
+  
+  uint_t lane;
+  
+  if ((trace.file == NULL) || (name == NULL)) {
+    return;
+  } /* end if */
+  
+  lane = lane_of_caller();
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_lock(&trace.lock);
+#endif
+  
+  write_event_head('B', name, lane);
+  
+  if (module != NULL) {
+    fputs(",\"args\":{\"module\":", trace.file);
+    write_json_string(module);
+    fputc('}', trace.file);
+  } /* end if */
+  
+  fputc('}', trace.file);
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_unlock(&trace.lock);
+#endif
+} /* end m2c_trace_begin */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_end(name)
+ * --------------------------------------------------------------------------
+ * Records the end of the innermost open span on the lane of the caller.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_end (const char *name) {
+  
+  uint_t lane;
+  
+  if ((trace.file == NULL) || (name == NULL)) {
+    return;
+  } /* end if */
+  
+  lane = lane_of_caller();
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_lock(&trace.lock);
+#endif
+  
+  write_event_head('E', name, lane);
+  fputc('}', trace.file);
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_unlock(&trace.lock);
+#endif
+} /* end m2c_trace_end */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_name_thread(name, index)
+ * --------------------------------------------------------------------------
+ * Labels the lane of the calling thread as name followed by index.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_name_thread (const char *name, uint_t index) {
+  
+  char label[MAX_LANE_LABEL_LENGTH + 1];
+  uint_t lane;
+  
+  if ((trace.file == NULL) || (name == NULL)) {
+    return;
+  } /* end if */
+  
+  snprintf(label, sizeof(label), "%s %u", name, index);
+  lane = lane_of_caller();
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_lock(&trace.lock);
+#endif
+  
+  write_event_head('M', "thread_name", lane);
+  fputs(",\"args\":{\"name\":", trace.file);
+  write_json_string(label);
+  fputs("}}", trace.file);
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_unlock(&trace.lock);
+#endif
+} /* end m2c_trace_name_thread */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_close(status)
+ * --------------------------------------------------------------------------
+ * Stops recording,  completes and closes the trace event file.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_close (m2c_trace_status_t *status) {
+  
+  FILE *file;
+  int result;
+  
+  if (trace.file == NULL) {
+    SET_STATUS(status, M2C_TRACE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_lock(&trace.lock);
+#endif
+  
+  file = trace.file;
+  trace.file = NULL;
+  
+#if (M2C_TRACE_THREAD_SAFE)
+  pthread_mutex_unlock(&trace.lock);
+#endif
+  
+  fputs("\n]\n", file);
+  result = ferror(file);
+  
+  if ((fclose(file) != 0) || (result != 0)) {
+    SET_STATUS(status, M2C_TRACE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_TRACE_STATUS_SUCCESS);
+  return;
+} /* end m2c_trace_close */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function clock_ns()
+ * --------------------------------------------------------------------------
+ * Returns the time of a monotonic clock in nanoseconds,  or wall clock time
+ * in whole seconds where no monotonic clock is available.
+ * ----------------------------------------------------------------------- */
+
+static uint64_t clock_ns (void) {
+#if defined(CLOCK_MONOTONIC)
+  struct timespec now;
+  
+  if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+  } /* end if */
+#endif
+  
+  return (uint64_t) time(NULL) * 1000000000;
+} /* end clock_ns */
+
+
+/* --------------------------------------------------------------------------
+ * private function lane_of_caller()
+ * --------------------------------------------------------------------------
+ * Returns the lane of the calling thread,  assigning the next free lane on
+ * its first call.  Returns zero if the recorder is not thread safe.
+ * ----------------------------------------------------------------------- */
+
+static uint_t lane_of_caller (void) {
+#if (M2C_TRACE_THREAD_SAFE)
+  uintptr_t lane;
+  
+  /* lanes are stored plus one,  zero marks a thread without a lane */
+  lane = (uintptr_t) pthread_getspecific(trace.lane_key);
+  
+  if (lane == 0) {
+    pthread_mutex_lock(&trace.lock);
+    trace.next_lane++;
+    lane = trace.next_lane;
+    pthread_mutex_unlock(&trace.lock);
+    
+    pthread_setspecific(trace.lane_key, (void *) lane);
+  } /* end if */
+  
+  return (uint_t) (lane - 1);
+#else
+  return 0;
+#endif
+} /* end lane_of_caller */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_event_head(phase, name, lane)
+ * --------------------------------------------------------------------------
+ * Writes the fields common to all events of event type phase,  leaving the
+ * event object open.  Must be called with the trace lock held.
+ * ----------------------------------------------------------------------- */
+
+static void write_event_head (char phase, const char *name, uint_t lane) {
+  
+  uint64_t elapsed;
+  
+  elapsed = clock_ns() - trace.origin;
+  
+  if (trace.event_count > 0) {
+    fputs(",\n", trace.file);
+  } /* end if */
+  
+  trace.event_count++;
+  
+  fputs("{\"name\":", trace.file);
+  write_json_string(name);
+  fprintf(trace.file,
+    ",\"cat\":\"m2c\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":%ld,\"tid\":%u",
+    phase, (unsigned long long) (elapsed / 1000),
+    (uint_t) (elapsed % 1000), trace.pid, lane);
+} /* end write_event_head */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_json_string(str)
+ * --------------------------------------------------------------------------
+ * Writes str as a quoted JSON string to the trace event file,  escaping
+ * quotes,  backslashes and control characters.
+ * ----------------------------------------------------------------------- */
+
+static void write_json_string (const char *str) {
+  
+  unsigned char ch;
+  
+  fputc('"', trace.file);
+  
+  while (*str != ASCII_NUL) {
+    ch = (unsigned char) *str;
+    
+    if ((ch == '"') || (ch == '\\')) {
+      fputc('\\', trace.file);
+      fputc(ch, trace.file);
+    }
+    else if (ch < 0x20) {
+      fprintf(trace.file, "\\u%04x", ch);
+    }
+    else /* plain character */ {
+      fputc(ch, trace.file);
+    } /* end if */
+    
+    str++;
+  } /* end while */
+  
+  fputc('"', trace.file);
+} /* end write_json_string */
+
+
+#if (M2C_TRACE_THREAD_SAFE)
+/* --------------------------------------------------------------------------
+ * private procedure create_lane_key()
+ * --------------------------------------------------------------------------
+ * Creates the thread specific key holding the lane of a thread.
+ * ----------------------------------------------------------------------- */
+
+static void create_lane_key (void) {
+  pthread_key_create(&trace.lane_key, NULL);
+} /* end create_lane_key */
+#endif
+
+
+/* END OF FILE */
@@ -0,0 +1,658 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-type-table.c                                                          *
+ *                                                                           *
+ * Implementation of the canonical type table.                               *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-type-table.h"
+#include "m2c-ast-nodetype.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type type_entry_t
+ * --------------------------------------------------------------------------
+ * Entry of the type table,  describing one type.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_type_kind_t kind;
+  m2c_type_id_t base[2];
+  intstr_t value;
+  uint32_t hash;
+} type_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_type_table_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a type table.  Array entry is indexed by type
+ * id,  entry zero is unused.  Array index is a hash table of the ids of
+ * anonymous types,  zero marks an empty slot.  It uses open addressing with
+ * linear probing,  its capacity is a power of two.
+ * ----------------------------------------------------------------------- */
+
+#define ENTRY_TABLE_INITIAL_CAPACITY 256
+
+#define HASH_INDEX_INITIAL_CAPACITY 512
+
+struct m2c_type_table_struct_t {
+  type_entry_t *entry;
+  uint_t entry_count;
+  uint_t entry_capacity;
+  m2c_type_id_t *index;
+  uint_t index_count;
+  uint_t index_capacity;
+};
+
+typedef struct m2c_type_table_struct_t m2c_type_table_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint32_t type_hash
+  (m2c_type_kind_t kind, m2c_type_id_t base0, m2c_type_id_t base1,
+   intstr_t value);
+
+static m2c_type_id_t append_entry
+  (m2c_type_table_t table, m2c_type_kind_t kind,
+   m2c_type_id_t base0, m2c_type_id_t base1, intstr_t value, uint32_t hash);
+
+static bool insert_index (m2c_type_table_t table, m2c_type_id_t type_id);
+
+static bool is_valid_id (m2c_type_table_t table, m2c_type_id_t type_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_type_table()
+ * --------------------------------------------------------------------------
+ * Returns a new empty type table,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_table_t m2c_new_type_table (void) {
+  
+  m2c_type_table_t table;
+  
+  table = malloc(sizeof(m2c_type_table_struct_t));
+  
+  if (table == NULL) {
+    return NULL;
+  } /* end if */
+  
+  table->entry =
+    calloc(ENTRY_TABLE_INITIAL_CAPACITY, sizeof(type_entry_t));
+  table->index =
+    calloc(HASH_INDEX_INITIAL_CAPACITY, sizeof(m2c_type_id_t));
+  
+  if ((table->entry == NULL) || (table->index == NULL)) {
+    free(table->entry);
+    free(table->index);
+    free(table);
+    return NULL;
+  } /* end if */
+  
+  /* id zero is M2C_TYPE_ID_NONE */
+  table->entry_count = 1;
+  table->entry_capacity = ENTRY_TABLE_INITIAL_CAPACITY;
+  table->index_count = 0;
+  table->index_capacity = HASH_INDEX_INITIAL_CAPACITY;
+  
+  return table;
+} /* end m2c_new_type_table */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_intern(table, kind, base0, base1, value)
+ * --------------------------------------------------------------------------
+ * Returns the id of the anonymous type of kind with base types base0 and
+ * base1 and value,  entering it into table if it is not yet present.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_intern
+  (m2c_type_table_t table, m2c_type_kind_t kind,
+   m2c_type_id_t base0, m2c_type_id_t base1, intstr_t value) {
+  
+  uint32_t hash;
+  uint_t mask, slot;
+  m2c_type_id_t type_id;
+  type_entry_t *entry;
+  
+  if (table == NULL) {
+    return M2C_TYPE_ID_NONE;
+  } /* end if */
+  
+  switch (kind) {
+    case M2C_TYPE_KIND_RECORD :
+    case M2C_TYPE_KIND_ENUM :
+    case M2C_TYPE_KIND_OPAQUE :
+    case M2C_TYPE_KIND_CAST_ADDRESS :
+    case M2C_TYPE_KIND_CAST_OCTETSEQ :
+      break;
+  
+    case M2C_TYPE_KIND_POINTER :
+      /* a pointer without target type is an untyped address */
+      break;
+  
+    case M2C_TYPE_KIND_SUBRANGE :
+    case M2C_TYPE_KIND_SET :
+    case M2C_TYPE_KIND_ARRAY :
+    case M2C_TYPE_KIND_LIST :
+    case M2C_TYPE_KIND_OPEN_ARRAY :
+    case M2C_TYPE_KIND_CONST_FORMAL :
+    case M2C_TYPE_KIND_VAR_FORMAL :
+    case M2C_TYPE_KIND_ARGLIST :
+      if (NOT(is_valid_id(table, base0))) {
+        return M2C_TYPE_ID_NONE;
+      } /* end if */
+      break;
+  
+    case M2C_TYPE_KIND_PROCEDURE :
+      /* parameterless procedures have neither formals nor result */
+      break;
+  
+    default : /* nominal or invalid */
+      return M2C_TYPE_ID_NONE;
+  } /* end switch */
+  
+  hash = type_hash(kind, base0, base1, value);
+  
+  /* look up structurally equal type */
+  mask = table->index_capacity - 1;
+  slot = hash & mask;
+  
+  while (table->index[slot] != M2C_TYPE_ID_NONE) {
+    entry = &table->entry[table->index[slot]];
+  
+    if ((entry->hash == hash) && (entry->kind == kind) &&
+        (entry->base[0] == base0) && (entry->base[1] == base1) &&
+        (entry->value == value)) {
+      return table->index[slot];
+    } /* end if */
+  
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  /* not present, enter new type */
+  type_id = append_entry(table, kind, base0, base1, value, hash);
+  
+  if ((type_id == M2C_TYPE_ID_NONE) || NOT(insert_index(table, type_id))) {
+    return M2C_TYPE_ID_NONE;
+  } /* end if */
+  
+  return type_id;
+} /* end m2c_type_intern */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_intern_list(table, count, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the id of the list of the count type ids in array type_id.  The
+ * list is built from its tail,  thus lists with a common tail share it.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_intern_list
+  (m2c_type_table_t table, uint_t count, const m2c_type_id_t type_id[]) {
+  
+  m2c_type_id_t list;
+  
+  if ((count == 0) || (type_id == NULL)) {
+    return M2C_TYPE_ID_NONE;
+  } /* end if */
+  
+  list = M2C_TYPE_ID_NONE;
+  
+  while (count > 0) {
+    count--;
+    list = m2c_type_intern(table,
+      M2C_TYPE_KIND_LIST, type_id[count], list, NULL);
+  
+    if (list == M2C_TYPE_ID_NONE) {
+      return M2C_TYPE_ID_NONE;
+    } /* end if */
+  } /* end while */
+  
+  return list;
+} /* end m2c_type_intern_list */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_declare(table, name, structure)
+ * --------------------------------------------------------------------------
+ * Enters a declared type with identifier name and structure  and returns
+ * its new id.  Declared types are not entered into the hash index,  they
+ * are found by name,  not by structure.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_declare
+  (m2c_type_table_t table, intstr_t name, m2c_type_id_t structure) {
+  
+  uint32_t hash;
+  
+  if ((table == NULL) || NOT(is_valid_id(table, structure))) {
+    return M2C_TYPE_ID_NONE;
+  } /* end if */
+  
+  /* the hash of a declared type covers its id */
+  hash = type_hash(M2C_TYPE_KIND_NOMINAL,
+    structure, (m2c_type_id_t) table->entry_count, name);
+  
+  return append_entry(table,
+    M2C_TYPE_KIND_NOMINAL, structure, M2C_TYPE_ID_NONE, name, hash);
+} /* end m2c_type_declare */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_for_formal(table, node, resolver, context)
+ * --------------------------------------------------------------------------
+ * Returns the id of the formal type represented by AST node.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_for_formal
+  (m2c_type_table_t table, m2c_astnode_t node,
+   m2c_type_resolver_f resolver, void *context) {
+  
+  m2c_type_id_t base;
+  m2c_astnode_t subnode;
+  
+  if ((table == NULL) || (resolver == NULL)) {
+    return M2C_TYPE_ID_NONE;
+  } /* end if */
+  
+  subnode = m2c_ast_subnode_at_index(node, 0);
+  
+  switch (m2c_ast_nodetype(node)) {
+    case AST_IDENT :
+    case AST_QUALIDENT :
+      return resolver(node, context);
+  
+    case AST_OPENARRAY :
+      base = resolver(subnode, context);
+      return m2c_type_intern(table,
+        M2C_TYPE_KIND_OPEN_ARRAY, base, M2C_TYPE_ID_NONE, NULL);
+  
+    case AST_CONSTP :
+      base = m2c_type_for_formal(table, subnode, resolver, context);
+      return m2c_type_intern(table,
+        M2C_TYPE_KIND_CONST_FORMAL, base, M2C_TYPE_ID_NONE, NULL);
+  
+    case AST_VARP :
+      base = m2c_type_for_formal(table, subnode, resolver, context);
+      return m2c_type_intern(table,
+        M2C_TYPE_KIND_VAR_FORMAL, base, M2C_TYPE_ID_NONE, NULL);
+  
+    case AST_VARGP :
+      base = m2c_type_for_formal(table, subnode, resolver, context);
+      return m2c_type_intern(table,
+        M2C_TYPE_KIND_ARGLIST, base, M2C_TYPE_ID_NONE, NULL);
+  
+    case AST_CASTP :
+      if (m2c_ast_nodetype(subnode) == AST_ADDR) {
+        return m2c_type_intern(table, M2C_TYPE_KIND_CAST_ADDRESS,
+          M2C_TYPE_ID_NONE, M2C_TYPE_ID_NONE, NULL);
+      }
+      else if (m2c_ast_nodetype(subnode) == AST_OCTSEQ) {
+        return m2c_type_intern(table, M2C_TYPE_KIND_CAST_OCTETSEQ,
+          M2C_TYPE_ID_NONE, M2C_TYPE_ID_NONE, NULL);
+      } /* end if */
+      return M2C_TYPE_ID_NONE;
+  
+    default :
+      return M2C_TYPE_ID_NONE;
+  } /* end switch */
+} /* end m2c_type_for_formal */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_kind(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the kind of type_id.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_kind_t m2c_type_kind
+  (m2c_type_table_t table, m2c_type_id_t type_id) {
+  
+  if (NOT(is_valid_id(table, type_id))) {
+    return M2C_TYPE_KIND_INVALID;
+  } /* end if */
+  
+  return table->entry[type_id].kind;
+} /* end m2c_type_kind */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_base(table, type_id, index)
+ * --------------------------------------------------------------------------
+ * Returns base type index of type_id.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_base
+  (m2c_type_table_t table, m2c_type_id_t type_id, uint_t index) {
+  
+  if ((index > 1) || NOT(is_valid_id(table, type_id))) {
+    return M2C_TYPE_ID_NONE;
+  } /* end if */
+  
+  return table->entry[type_id].base[index];
+} /* end m2c_type_base */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_value(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the value of type_id.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_type_value (m2c_type_table_t table, m2c_type_id_t type_id) {
+  
+  if (NOT(is_valid_id(table, type_id))) {
+    return NULL;
+  } /* end if */
+  
+  return table->entry[type_id].value;
+} /* end m2c_type_value */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_hash(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the structural hash of type_id.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2c_type_hash (m2c_type_table_t table, m2c_type_id_t type_id) {
+  
+  if (NOT(is_valid_id(table, type_id))) {
+    return 0;
+  } /* end if */
+  
+  return table->entry[type_id].hash;
+} /* end m2c_type_hash */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_structure(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the structure of declared type type_id,  or type_id itself.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_structure
+  (m2c_type_table_t table, m2c_type_id_t type_id) {
+  
+  if (m2c_type_kind(table, type_id) == M2C_TYPE_KIND_NOMINAL) {
+    return table->entry[type_id].base[0];
+  } /* end if */
+  
+  return type_id;
+} /* end m2c_type_structure */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_is_formal_compatible(table, formal, actual)
+ * --------------------------------------------------------------------------
+ * Returns true if an actual parameter of type actual may be passed to a
+ * formal parameter of type formal.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_type_is_formal_compatible
+  (m2c_type_table_t table, m2c_type_id_t formal, m2c_type_id_t actual) {
+  
+  m2c_type_id_t structure;
+  
+  if (NOT(is_valid_id(table, formal)) || NOT(is_valid_id(table, actual))) {
+    return false;
+  } /* end if */
+  
+  if (formal == actual) {
+    return true;
+  } /* end if */
+  
+  switch (table->entry[formal].kind) {
+    case M2C_TYPE_KIND_CONST_FORMAL :
+    case M2C_TYPE_KIND_VAR_FORMAL :
+    case M2C_TYPE_KIND_ARGLIST :
+      return m2c_type_is_formal_compatible(table,
+        table->entry[formal].base[0], actual);
+  
+    case M2C_TYPE_KIND_OPEN_ARRAY :
+      structure = m2c_type_structure(table, actual);
+  
+      switch (table->entry[structure].kind) {
+        case M2C_TYPE_KIND_ARRAY :
+        case M2C_TYPE_KIND_OPEN_ARRAY :
+          return (table->entry[structure].base[0] ==
+            table->entry[formal].base[0]);
+  
+        default :
+          return false;
+      } /* end switch */
+  
+    case M2C_TYPE_KIND_CAST_ADDRESS :
+      structure = m2c_type_structure(table, actual);
+  
+      return (table->entry[structure].kind == M2C_TYPE_KIND_POINTER) ||
+        (table->entry[structure].kind == M2C_TYPE_KIND_OPAQUE);
+  
+    case M2C_TYPE_KIND_CAST_OCTETSEQ :
+      return true;
+  
+    default :
+      return false;
+  } /* end switch */
+} /* end m2c_type_is_formal_compatible */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of types in table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_type_count (m2c_type_table_t table) {
+  
+  if (table == NULL) {
+    return 0;
+  } /* end if */
+  
+  return table->entry_count - 1;
+} /* end m2c_type_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_type_table(table)
+ * --------------------------------------------------------------------------
+ * Deallocates table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_type_table (m2c_type_table_t table) {
+  
+  if (table == NULL) {
+    return;
+  } /* end if */
+  
+  free(table->entry);
+  free(table->index);
+  free(table);
+  
+} /* end m2c_release_type_table */
+
+
+/* *********************************************************************** *
+ * P R I V A T E   F U N C T I O N S                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_id(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns true if type_id is an id of table,  else false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_id (m2c_type_table_t table, m2c_type_id_t type_id) {
+  
+  return (table != NULL) &&
+    (type_id != M2C_TYPE_ID_NONE) && (type_id < table->entry_count);
+} /* end is_valid_id */
+
+
+/* --------------------------------------------------------------------------
+ * private function type_hash(kind, base0, base1, value)
+ * --------------------------------------------------------------------------
+ * Returns the structural hash of a type with kind,  base types base0 and
+ * base1 and value.  Values are interned,  their addresses are hashed.
+ * ----------------------------------------------------------------------- */
+
+#define HASH_STEP(_hash, _word) \
+  (((_hash) ^ ((uint32_t) (_word))) * 16777619u)
+
+static uint32_t type_hash
+  (m2c_type_kind_t kind, m2c_type_id_t base0, m2c_type_id_t base1,
+   intstr_t value) {
+  
+  uint32_t hash;
+  
+  hash = 2166136261u;
+  hash = HASH_STEP(hash, kind);
+  hash = HASH_STEP(hash, base0);
+  hash = HASH_STEP(hash, base1);
+  hash = HASH_STEP(hash, ((uintptr_t) value) >> 3);
+  
+  return hash;
+} /* end type_hash */
+
+
+/* --------------------------------------------------------------------------
+ * private function append_entry(table, kind, base0, base1, value, hash)
+ * --------------------------------------------------------------------------
+ * Appends an entry to table  and returns its id.  The entry array is
+ * doubled when full.  Returns M2C_TYPE_ID_NONE if it cannot be enlarged.
+ * ----------------------------------------------------------------------- */
+
+static m2c_type_id_t append_entry
+  (m2c_type_table_t table, m2c_type_kind_t kind,
+   m2c_type_id_t base0, m2c_type_id_t base1, intstr_t value, uint32_t hash) {
+  
+  type_entry_t *new_entry;
+  uint_t new_capacity;
+  m2c_type_id_t type_id;
+  
+  if (table->entry_count == table->entry_capacity) {
+    new_capacity = 2 * table->entry_capacity;
+    new_entry = realloc(table->entry, new_capacity * sizeof(type_entry_t));
+  
+    if (new_entry == NULL) {
+      return M2C_TYPE_ID_NONE;
+    } /* end if */
+  
+    table->entry = new_entry;
+    table->entry_capacity = new_capacity;
+  } /* end if */
+  
+  type_id = (m2c_type_id_t) table->entry_count;
+  
+  table->entry[type_id].kind = kind;
+  table->entry[type_id].base[0] = base0;
+  table->entry[type_id].base[1] = base1;
+  table->entry[type_id].value = value;
+  table->entry[type_id].hash = hash;
+  table->entry_count++;
+  
+  return type_id;
+} /* end append_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function insert_index(table, type_id)
+ * --------------------------------------------------------------------------
+ * Enters anonymous type type_id into the hash index of table.  The index is
+ * doubled when it becomes three quarters full.  Returns false if it cannot
+ * be enlarged,  in which case the entry of type_id is removed again.
+ * ----------------------------------------------------------------------- */
+
+static bool insert_index (m2c_type_table_t table, m2c_type_id_t type_id) {
+  
+  m2c_type_id_t *new_index;
+  uint_t new_capacity, mask, index, slot;
+  
+  if ((4 * (table->index_count + 1)) > (3 * table->index_capacity)) {
+    new_capacity = 2 * table->index_capacity;
+    new_index = calloc(new_capacity, sizeof(m2c_type_id_t));
+  
+    if (new_index == NULL) {
+      /* type_id is the last entry */
+      table->entry_count--;
+      return false;
+    } /* end if */
+  
+    mask = new_capacity - 1;
+  
+    for (index = 0; index < table->index_capacity; index++) {
+      if (table->index[index] != M2C_TYPE_ID_NONE) {
+        slot = table->entry[table->index[index]].hash & mask;
+  
+        while (new_index[slot] != M2C_TYPE_ID_NONE) {
+          slot = (slot + 1) & mask;
+        } /* end while */
+  
+        new_index[slot] = table->index[index];
+      } /* end if */
+    } /* end for */
+  
+    free(table->index);
+    table->index = new_index;
+    table->index_capacity = new_capacity;
+  } /* end if */
+  
+  mask = table->index_capacity - 1;
+  slot = table->entry[type_id].hash & mask;
+  
+  while (table->index[slot] != M2C_TYPE_ID_NONE) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  table->index[slot] = type_id;
+  table->index_count++;
+  
+  return true;
+} /* end insert_index */
+
+
+/* END OF FILE */
@@ -0,0 +1,419 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-unity-build.c                                                         *
+ *                                                                           *
+ * Implementation of unity build module.                                     *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-unity-build.h"
+
+#include "m2c-dep-file.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of module arrays
+ * ----------------------------------------------------------------------- */
+
+#define UNITY_INITIAL_CAPACITY 32
+
+
+/* --------------------------------------------------------------------------
+ * private type module_list_t
+ * --------------------------------------------------------------------------
+ * Record type for a growable array of module identifiers.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  uint_t count;
+  uint_t capacity;
+  intstr_t *module;
+} module_list_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_unity_order_s
+ * --------------------------------------------------------------------------
+ * Record type representing the modules of an import closure in dependency
+ * order.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_unity_order_s {
+  module_list_t modules;
+};
+
+typedef struct m2c_unity_order_s m2c_unity_order_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type closure_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a closure traversal.  Visited holds every
+ * module whose traversal has started,  done the modules whose traversal has
+ * completed in completion order,  which is the dependency order.  Closures
+ * are expected to hold at most a few hundred modules,  membership is tested
+ * by linear search.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *dep_dir;
+  module_list_t visited;
+  module_list_t done;
+  intstr_t failed_module;
+  m2c_unity_status_t status;
+} closure_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool visit_module (closure_t *closure, intstr_t module_id);
+
+static bool list_contains (const module_list_t *list, intstr_t module_id);
+
+static bool list_append (module_list_t *list, intstr_t module_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unity_new_order(program_id, dep_dir, failed_module, status)
+ * --------------------------------------------------------------------------
+ * Returns a new order with the modules of the import closure of program_id.
+ * ----------------------------------------------------------------------- */
+
+m2c_unity_order_t m2c_unity_new_order
+  (intstr_t program_id,
+   const char *dep_dir,
+   intstr_t *failed_module,
+   m2c_unity_status_t *status) {
+  
+  m2c_unity_order_t new_order;
+  closure_t closure;
+  
+  if (failed_module != NULL) {
+    *failed_module = NULL;
+  } /* end if */
+  
+  /* check pre-conditions */
+  if ((program_id == NULL) || (dep_dir == NULL)) {
+    SET_STATUS(status, M2C_UNITY_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  closure.dep_dir = dep_dir;
+  closure.visited.count = 0;
+  closure.visited.capacity = 0;
+  closure.visited.module = NULL;
+  closure.done = closure.visited;
+  closure.failed_module = NULL;
+  closure.status = M2C_UNITY_STATUS_SUCCESS;
+  
+  if (NOT(visit_module(&closure, program_id))) {
+    free(closure.visited.module);
+    free(closure.done.module);
+    if (failed_module != NULL) {
+      *failed_module = closure.failed_module;
+    } /* end if */
+    SET_STATUS(status, closure.status);
+    return NULL;
+  } /* end if */
+  
+  free(closure.visited.module);
+  
+  new_order = malloc(sizeof(m2c_unity_order_s));
+  
+  if (new_order == NULL) {
+    free(closure.done.module);
+    SET_STATUS(status, M2C_UNITY_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  new_order->modules = closure.done;
+  
+  SET_STATUS(status, M2C_UNITY_STATUS_SUCCESS);
+  return new_order;
+} /* end m2c_unity_new_order */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unity_module_count(order)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules in order.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_unity_module_count (m2c_unity_order_t order) {
+  
+  if (order == NULL) {
+    return 0;
+  } /* end if */
+  
+  return order->modules.count;
+} /* end m2c_unity_module_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unity_module_at_index(order, index)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the module at index in order.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_unity_module_at_index (m2c_unity_order_t order, uint_t index) {
+  
+  if ((order == NULL) || (index >= order->modules.count)) {
+    return NULL;
+  } /* end if */
+  
+  return order->modules.module[index];
+} /* end m2c_unity_module_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_unity_write_unit(path, order, written, status)
+ * --------------------------------------------------------------------------
+ * Writes the unity translation unit for order to the file at path.
+ * ----------------------------------------------------------------------- */
+
+void m2c_unity_write_unit
+  (const char *path,
+   m2c_unity_order_t order,
+   bool *written,
+   outfile_status_t *status) {
+  
+  outfile_t outfile;
+  outfile_status_t open_status;
+  uint_t index, last;
+  
+  if (written != NULL) {
+    *written = false;
+  } /* end if */
+  
+  /* check pre-conditions */
+  if ((order == NULL) || (order->modules.count == 0)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  outfile_open_if_changed(&outfile, path, &open_status);
+  
+  if (outfile == NULL) {
+    SET_STATUS(status, open_status);
+    return;
+  } /* end if */
+  
+  last = order->modules.count - 1;
+  
+  /* header comment naming the program module */
+  outfile_write_chars(outfile, "/* unity translation unit of program ");
+  outfile_write_string(outfile, order->modules.module[last]);
+  outfile_write_chars(outfile, ", generated */");
+  outfile_write_newline(outfile);
+  outfile_write_newline(outfile);
+  
+  outfile_write_chars(outfile, "#define " M2C_UNITY_BUILD_MACRO " 1");
+  outfile_write_newline(outfile);
+  outfile_write_newline(outfile);
+  
+  /* #include "Module.c" in dependency order */
+  index = 0;
+  while (index <= last) {
+    outfile_write_chars(outfile, "#include \"");
+    outfile_write_string(outfile, order->modules.module[index]);
+    outfile_write_chars(outfile, ".c\"");
+    outfile_write_newline(outfile);
+    index++;
+  } /* end while */
+  
+  outfile_write_newline(outfile);
+  outfile_write_chars(outfile, "/* END OF FILE */");
+  outfile_write_newline(outfile);
+  
+  outfile_close_if_changed(&outfile, written, status);
+  
+} /* end m2c_unity_write_unit */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_unity_release_order(order)
+ * --------------------------------------------------------------------------
+ * Deallocates order and passes NULL in order.
+ * ----------------------------------------------------------------------- */
+
+void m2c_unity_release_order (m2c_unity_order_t *order) {
+  
+  if ((order == NULL) || (*order == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*order)->modules.module);
+  free(*order);
+  *order = NULL;
+  
+} /* end m2c_unity_release_order */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function visit_module(closure, module_id)
+ * --------------------------------------------------------------------------
+ * Traverses the imports of module_id depth first  and appends module_id to
+ * closure->done  once all its imports are done.  An import that is visited
+ * but not done closes a cycle and is skipped.  The imports of a module are
+ * read in full before descending,  so that at most one dependency file is
+ * open at any time.  Returns false on failure,  with the status recorded in
+ * closure.
+ * ----------------------------------------------------------------------- */
+
+static bool visit_module (closure_t *closure, intstr_t module_id) {
+  
+  m2c_dep_file_status_t dep_status;
+  intstr_t *imports;
+  uint_t index, count;
+  
+  if (NOT(list_append(&closure->visited, module_id))) {
+    closure->status = M2C_UNITY_STATUS_ALLOCATION_FAILED;
+    return false;
+  } /* end if */
+  
+  m2c_read_dep_file
+    (closure->dep_dir, module_id, &count, &imports, &dep_status);
+  
+  if (dep_status != M2C_DEP_FILE_STATUS_SUCCESS) {
+    closure->failed_module = module_id;
+    
+    if (dep_status == M2C_DEP_FILE_STATUS_FILE_NOT_FOUND) {
+      closure->status = M2C_UNITY_STATUS_DEP_FILE_NOT_FOUND;
+    }
+    else if (dep_status == M2C_DEP_FILE_STATUS_INVALID_FORMAT) {
+      closure->status = M2C_UNITY_STATUS_INVALID_DEP_FILE;
+    }
+    else /* allocation failed */ {
+      closure->status = M2C_UNITY_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    return false;
+  } /* end if */
+  
+  index = 0;
+  while (index < count) {
+    if (NOT(list_contains(&closure->visited, imports[index]))) {
+      if (NOT(visit_module(closure, imports[index]))) {
+        free(imports);
+        return false;
+      } /* end if */
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  free(imports);
+  
+  if (NOT(list_append(&closure->done, module_id))) {
+    closure->status = M2C_UNITY_STATUS_ALLOCATION_FAILED;
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end visit_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function list_contains(list, module_id)
+ * --------------------------------------------------------------------------
+ * Returns true if module_id is in list,  otherwise false.  Interned strings
+ * are unique,  identifiers are compared by reference.
+ * ----------------------------------------------------------------------- */
+
+static bool list_contains (const module_list_t *list, intstr_t module_id) {
+  
+  uint_t index;
+  
+  index = 0;
+  while (index < list->count) {
+    if (list->module[index] == module_id) {
+      return true;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  return false;
+} /* end list_contains */
+
+
+/* --------------------------------------------------------------------------
+ * private function list_append(list, module_id)
+ * --------------------------------------------------------------------------
+ * Appends module_id to list,  doubling its capacity when full.  Returns
+ * false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool list_append (module_list_t *list, intstr_t module_id) {
+  
+  intstr_t *new_module;
+  uint_t new_capacity;
+  
+  if (list->count == list->capacity) {
+    if (list->capacity == 0) {
+      new_capacity = UNITY_INITIAL_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * list->capacity;
+    } /* end if */
+    
+    new_module = realloc(list->module, new_capacity * sizeof(intstr_t));
+    
+    if (new_module == NULL) {
+      return false;
+    } /* end if */
+    
+    list->module = new_module;
+    list->capacity = new_capacity;
+  } /* end if */
+  
+  list->module[list->count] = module_id;
+  list->count++;
+  
+  return true;
+} /* end list_append */
+
+
+/* END OF FILE */
@@ -0,0 +1,387 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-write-codegen.c                                                       *
+ *                                                                           *
+ * Implementation of translation of WRITE statements.                        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-write-codegen.h"
+#include "m2c-ast-nodetype.h"
+#include "interned-strings.h"
+
+#include <stddef.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type arg_class_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the classes of output arguments.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  ARG_LITERAL,   /* quoted literal, written into the format string */
+  ARG_VALUE,     /* value of predefined type, written by conversion */
+  ARG_BOUND      /* written by call of bound procedure */
+} arg_class_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type conversion_t
+ * --------------------------------------------------------------------------
+ * Conversion specifier and argument prefix and suffix by write kind.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *spec;
+  const char *prefix;
+  const char *suffix;
+} conversion_t;
+
+static const conversion_t conversion[] = {
+  /* M2C_WRITE_KIND_BOUND */    { NULL, NULL, NULL },
+  /* M2C_WRITE_KIND_BOOLEAN */  { "%s", "((", ") ? \"TRUE\" : \"FALSE\")" },
+  /* M2C_WRITE_KIND_CHAR */     { "%c", "(int) (", ")" },
+  /* M2C_WRITE_KIND_STRING */   { "%s", "(", ")" },
+  /* M2C_WRITE_KIND_CARDINAL */ { "%lu", "(unsigned long) (", ")" },
+  /* M2C_WRITE_KIND_LONGCARD */ { "%llu", "(unsigned long long) (", ")" },
+  /* M2C_WRITE_KIND_INTEGER */  { "%ld", "(long) (", ")" },
+  /* M2C_WRITE_KIND_LONGINT */  { "%lld", "(long long) (", ")" },
+  /* M2C_WRITE_KIND_REAL */     { "%g", "(double) (", ")" },
+  /* M2C_WRITE_KIND_LONGREAL */ { "%Lg", "(long double) (", ")" }
+}; /* conversion */
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static arg_class_t classify_arg
+  (m2c_astnode_t arg, m2c_write_kind_f kind_of, void *context,
+   m2c_write_kind_t *kind);
+
+static uint_t end_of_run
+  (m2c_astnode_t write_node, uint_t first,
+   m2c_write_kind_f kind_of, void *context);
+
+static void write_run
+  (outfile_t outfile, m2c_astnode_t write_node, uint_t first, uint_t end,
+   m2c_write_kind_f kind_of, m2c_write_node_writer_f writer, void *context);
+
+static void write_literal_text (outfile_t outfile, intstr_t lexeme);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_lower_write_statement(outfile, write_node, kind_of, ...)
+ * --------------------------------------------------------------------------
+ * Writes the translation of WRITE statement write_node to outfile.
+ * ----------------------------------------------------------------------- */
+
+void m2c_lower_write_statement
+  (outfile_t outfile,                       /* in */
+   m2c_astnode_t write_node,                /* in */
+   m2c_write_kind_f kind_of,                /* in */
+   m2c_write_node_writer_f writer,          /* in */
+   m2c_write_bound_writer_f bound_writer,   /* in */
+   void *context) {                         /* in */
+  
+  m2c_astnode_t chan, arg;
+  m2c_write_kind_t kind;
+  uint_t index, end, count;
+  
+  if ((outfile == NULL) || (write_node == NULL) ||
+      (kind_of == NULL) || (writer == NULL) || (bound_writer == NULL)) {
+    return;
+  } /* end if */
+  
+  chan = m2c_ast_subnode_at_index(write_node, 0);
+  count = m2c_ast_subnode_count(write_node);
+  
+  index = 1;
+  while (index < count) {
+    if (index > 1) {
+      outfile_write_newline(outfile);
+    } /* end if */
+  
+    arg = m2c_ast_subnode_at_index(write_node, index);
+  
+    if (classify_arg(arg, kind_of, context, &kind) == ARG_BOUND) {
+      bound_writer(outfile, chan, arg, context);
+      index++;
+    }
+    else /* run of literals and values */ {
+      end = end_of_run(write_node, index, kind_of, context);
+      write_run(outfile, write_node, index, end, kind_of, writer, context);
+      index = end;
+    } /* end if */
+  } /* end while */
+} /* end m2c_lower_write_statement */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_write_call_count(write_node, kind_of, context)
+ * --------------------------------------------------------------------------
+ * Returns the number of calls the WRITE statement write_node becomes.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_write_call_count
+  (m2c_astnode_t write_node, m2c_write_kind_f kind_of, void *context) {
+  
+  m2c_write_kind_t kind;
+  uint_t index, count, calls;
+  
+  if ((write_node == NULL) || (kind_of == NULL)) {
+    return 0;
+  } /* end if */
+  
+  count = m2c_ast_subnode_count(write_node);
+  calls = 0;
+  
+  index = 1;
+  while (index < count) {
+    if (classify_arg(m2c_ast_subnode_at_index(write_node, index),
+        kind_of, context, &kind) == ARG_BOUND) {
+      index++;
+    }
+    else {
+      index = end_of_run(write_node, index, kind_of, context);
+    } /* end if */
+  
+    calls++;
+  } /* end while */
+  
+  return calls;
+} /* end m2c_write_call_count */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function classify_arg(arg, kind_of, context, kind)
+ * --------------------------------------------------------------------------
+ * Returns the class of output argument arg and passes its write kind back
+ * in kind.  Formatted arguments are told from unformatted arguments by
+ * their subnode count.
+ *
+ * astnodes:
+ *  (WRITEARG exprNode) | (FMTARG fmtNode exprListNode)
+ * ----------------------------------------------------------------------- */
+
+static arg_class_t classify_arg
+  (m2c_astnode_t arg, m2c_write_kind_f kind_of, void *context,
+   m2c_write_kind_t *kind) {
+  
+  m2c_astnode_t expr;
+  
+  *kind = M2C_WRITE_KIND_BOUND;
+  
+  if (m2c_ast_subnode_count(arg) != 1) {
+    return ARG_BOUND;
+  } /* end if */
+  
+  expr = m2c_ast_subnode_at_index(arg, 0);
+  
+  if (m2c_ast_nodetype(expr) == AST_QUOTEDVAL) {
+    *kind = M2C_WRITE_KIND_STRING;
+    return ARG_LITERAL;
+  } /* end if */
+  
+  *kind = kind_of(expr, context);
+  
+  if ((*kind == M2C_WRITE_KIND_BOUND) || (*kind > M2C_WRITE_KIND_LONGREAL)) {
+    *kind = M2C_WRITE_KIND_BOUND;
+    return ARG_BOUND;
+  } /* end if */
+  
+  return ARG_VALUE;
+} /* end classify_arg */
+
+
+/* --------------------------------------------------------------------------
+ * private function end_of_run(write_node, first, kind_of, context)
+ * --------------------------------------------------------------------------
+ * Returns the index of the first argument of write_node at or after first
+ * that is written by a bound procedure,  or the subnode count if none.
+ * ----------------------------------------------------------------------- */
+
+static uint_t end_of_run
+  (m2c_astnode_t write_node, uint_t first,
+   m2c_write_kind_f kind_of, void *context) {
+  
+  m2c_write_kind_t kind;
+  uint_t index, count;
+  
+  count = m2c_ast_subnode_count(write_node);
+  
+  for (index = first; index < count; index++) {
+    if (classify_arg(m2c_ast_subnode_at_index(write_node, index),
+        kind_of, context, &kind) == ARG_BOUND) {
+      return index;
+    } /* end if */
+  } /* end for */
+  
+  return count;
+} /* end end_of_run */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_run(outfile, write_node, first, end, ...)
+ * --------------------------------------------------------------------------
+ * Writes a single call of M2C_WRITEF for the arguments of write_node from
+ * index first up to but excluding index end.  The format string is written
+ * first,  then the converted values.
+ * ----------------------------------------------------------------------- */
+
+static void write_run
+  (outfile_t outfile, m2c_astnode_t write_node, uint_t first, uint_t end,
+   m2c_write_kind_f kind_of, m2c_write_node_writer_f writer, void *context) {
+  
+  m2c_astnode_t chan, expr;
+  m2c_write_kind_t kind;
+  arg_class_t arg_class;
+  uint_t index;
+  
+  chan = m2c_ast_subnode_at_index(write_node, 0);
+  
+  outfile_write_chars(outfile, "M2C_WRITEF(");
+  
+  if ((chan == NULL) || (m2c_ast_nodetype(chan) == AST_EMPTY)) {
+    outfile_write_chars(outfile, "NULL");
+  }
+  else {
+    writer(outfile, chan, context);
+  } /* end if */
+  
+  /* format string */
+  outfile_write_chars(outfile, ", \"");
+  for (index = first; index < end; index++) {
+    expr = m2c_ast_subnode_at_index(write_node, index);
+    arg_class = classify_arg(expr, kind_of, context, &kind);
+    expr = m2c_ast_subnode_at_index(expr, 0);
+  
+    if (arg_class == ARG_LITERAL) {
+      write_literal_text(outfile, m2c_ast_value(expr));
+    }
+    else /* ARG_VALUE */ {
+      outfile_write_chars(outfile, conversion[kind].spec);
+    } /* end if */
+  } /* end for */
+  outfile_write_char(outfile, '"');
+  
+  /* values */
+  for (index = first; index < end; index++) {
+    expr = m2c_ast_subnode_at_index(write_node, index);
+    arg_class = classify_arg(expr, kind_of, context, &kind);
+  
+    if (arg_class == ARG_VALUE) {
+      outfile_write_chars(outfile, ", ");
+      outfile_write_chars(outfile, conversion[kind].prefix);
+      writer(outfile, m2c_ast_subnode_at_index(expr, 0), context);
+      outfile_write_chars(outfile, conversion[kind].suffix);
+    } /* end if */
+  } /* end for */
+  
+  outfile_write_chars(outfile, ");");
+} /* end write_run */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure write_literal_text(outfile, lexeme)
+ * --------------------------------------------------------------------------
+ * Writes the text of quoted literal lexeme,  without its delimiters,  for
+ * use within a C format string.  Escape sequences \n, \t and \\ are valid
+ * in C and written as they are.  Percent signs are doubled,  double quotes
+ * escaped,  and a question mark after a question mark is escaped to rule
+ * out trigraphs.
+ * ----------------------------------------------------------------------- */
+
+static void write_literal_text (outfile_t outfile, intstr_t lexeme) {
+  
+  const char *text;
+  uint_t index, last;
+  char prev_ch;
+  
+  text = intstr_char_ptr(lexeme);
+  last = intstr_length(lexeme);
+  
+  if ((text == NULL) || (last < 2)) {
+    return;
+  } /* end if */
+  
+  /* skip the delimiters */
+  last--;
+  prev_ch = '\0';
+  for (index = 1; index < last; index++) {
+    switch (text[index]) {
+      case '%' :
+        outfile_write_chars(outfile, "%%");
+        break;
+  
+      case '"' :
+        outfile_write_chars(outfile, "\\\"");
+        break;
+  
+      case '?' :
+        if (prev_ch == '?') {
+          outfile_write_chars(outfile, "\\?");
+        }
+        else {
+          outfile_write_char(outfile, '?');
+        } /* end if */
+        break;
+  
+      case '\\' :
+        /* copy the escape sequence,  the lexer admits only valid ones */
+        outfile_write_char(outfile, '\\');
+        if (index + 1 < last) {
+          index++;
+          outfile_write_char(outfile, text[index]);
+        } /* end if */
+        break;
+  
+      default :
+        outfile_write_char(outfile, text[index]);
+    } /* end switch */
+  
+    prev_ch = text[index];
+  } /* end for */
+} /* end write_literal_text */
+
+/* END OF FILE */
@@ -34,11 +34,19 @@
  */
 
 #include "m2-error.h"
+#include "m2c-diagnostics.h"
 
 #include <stdio.h>
 #include <stddef.h>
 
 
+/* --------------------------------------------------------------------------
+ * Maximum length of a diagnostic message
+ * ----------------------------------------------------------------------- */
+
+#define MAX_MESSAGE_LENGTH (M2C_TOKENSET_LIST_STR_SIZE + 255)
+
+
 /* --------------------------------------------------------------------------
  * array m2c_error_text_array
  * --------------------------------------------------------------------------
@@ -195,15 +203,14 @@ void m2c_emit_error_w_str (m2c_error_t error, const char *offending_str) {
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_error_w_pos(error, line, column)
  * --------------------------------------------------------------------------
- * Emits an error message for error code error to the console.
+ * Emits an error message for error code error to the diagnostic buffer.
  * --------------------------------------------------------------------------
  */
 
 void m2c_emit_error_w_pos
   (m2c_error_t error, uint_t line, uint_t column) {
   if (error < ERROR_END_MARK) {
-    printf("line %u, column %u, error: %s\n",
-      line, column, m2c_error_text_array[error]);
+    m2c_diag_emit(M2C_DIAG_ERROR, line, column, m2c_error_text_array[error]);
   } /* end if */
 } /* end m2c_emit_error_w_pos */
 
@@ -211,7 +218,7 @@ void m2c_emit_error_w_pos
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_error_w_chr(error, line, column, offending_chr)
  * --------------------------------------------------------------------------
- * Emits an error message for error code error to the console.
+ * Emits an error message for error code error to the diagnostic buffer.
  * --------------------------------------------------------------------------
  */
 
@@ -220,15 +227,19 @@ void m2c_emit_error_w_pos
 
 void m2c_emit_error_w_chr
   (m2c_error_t error, uint_t line, uint_t column, char offending_chr) {
-  if (error < ERROR_END_MARK) {
-    printf("line: %u, column: %u, %s",
-      line, column, m2c_error_text_array[error]);
+  char message[MAX_MESSAGE_LENGTH + 1];
+  
+  if ((error < ERROR_END_MARK) && (m2c_diag_accepts(M2C_DIAG_ERROR))) {
     if (IS_PRINTABLE(offending_chr)) {
-      printf(", offending character: '%c'\n", offending_chr);
+      snprintf(message, sizeof(message), "%s, offending character: '%c'",
+        m2c_error_text_array[error], offending_chr);
     }
     else /* non-printable */ {
-      printf(", offending character code: 0u%X\n", offending_chr);
+      snprintf(message, sizeof(message),
+        "%s, offending character code: 0u%X",
+        m2c_error_text_array[error], (unsigned int) offending_chr);
     } /* end if */
+    m2c_diag_emit(M2C_DIAG_ERROR, line, column, message);
   } /* end if */
 } /* end m2c_emit_error_w_chr */
 
@@ -236,30 +247,64 @@ void m2c_emit_error_w_chr
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_error_w_lex(error, line, column, offending_lex)
  * --------------------------------------------------------------------------
- * Emits an error message for error code error to the console.
+ * Emits an error message for error code error to the diagnostic buffer.
  * --------------------------------------------------------------------------
  */
 
 void m2c_emit_error_w_lex
   (m2c_error_t error,
    uint_t line, uint_t column, const char *offending_lex) {
-  if (error < ERROR_END_MARK) {
-    printf("line: %u, column: %u, %s",
-      line, column, m2c_error_text_array[error]);
-    if (offending_lex != NULL) {
-      printf(", offending lexeme: %s\n", offending_lex);
-    }
-    else {
-      printf(", offending lexeme: (null)\n");
+  char message[MAX_MESSAGE_LENGTH + 1];
+  
+  if ((error < ERROR_END_MARK) && (m2c_diag_accepts(M2C_DIAG_ERROR))) {
+    if (offending_lex == NULL) {
+      offending_lex = "(null)";
     } /* end if */
+    snprintf(message, sizeof(message), "%s, offending lexeme: %s",
+      m2c_error_text_array[error], offending_lex);
+    m2c_diag_emit(M2C_DIAG_ERROR, line, column, message);
   } /* end if */
 } /* end m2c_emit_error_w_lex */
 
 
+/* --------------------------------------------------------------------------
+ * private function describe_symbol(message, size, sym, lexeme)
+ * --------------------------------------------------------------------------
+ * Writes a description of offending symbol sym with lexeme to message,
+ * which holds size characters,  and returns the length written.
+ * ----------------------------------------------------------------------- */
+
+static int describe_symbol
+  (char *message, size_t size, m2c_token_t sym, const char *lexeme) {
+  
+  if (sym == TOKEN_IDENTIFIER) {
+    return snprintf(message, size, "identifier '%s'", lexeme);
+  }
+  else if (m2c_is_literal_token(sym)) {
+    return snprintf(message, size, "literal <<%s>>", lexeme);
+  }
+  else if (m2c_is_resword_token(sym)) {
+    return snprintf(message, size,
+      "reserved word %s", m2c_lexeme_for_resword(sym));
+  }
+  else if (m2c_is_special_symbol_token(sym)) {
+    return snprintf(message, size,
+      "symbol '%s'", m2c_lexeme_for_special_symbol(sym));
+  }
+  else if (sym == TOKEN_END_OF_FILE) {
+    return snprintf(message, size, "end of file");
+  }
+  else {
+    return snprintf(message, size, "unknown token");
+  } /* end if */
+} /* end describe_symbol */
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_syntax_error_w_token(line, col, off_sym, off_lex, tokn)
  * --------------------------------------------------------------------------
- * Emits a syntax error message of the following format to the console:
+ * Emits a syntax error message of the following format to the diagnostic
+ * buffer:
  * line: n, column: m, unexpected offending-symbol offending-lexeme found
  *   expected token
  * ----------------------------------------------------------------------- */
@@ -270,51 +315,46 @@ void m2c_emit_syntax_error_w_token
    const char *offending_lex,
    m2c_token_t expected_token) {
   
-  /* print line and column */
-  printf("line %u, column %u, error: unexpected ", line, column);
+  char message[MAX_MESSAGE_LENGTH + 1];
+  char symbol[MAX_MESSAGE_LENGTH + 1];
+  const char *expected;
+  char expected_sym[MAX_MESSAGE_LENGTH + 1];
   
-  /* print offending symbol and its lexeme */
-  if (offending_sym == TOKEN_IDENTIFIER) {
-    printf("identifier '%s'", offending_lex);
-  }
-  else if (m2c_is_literal_token(offending_sym)) {
-    printf("literal <<%s>>", offending_lex);
-  }
-  else if (m2c_is_resword_token(offending_sym)) {
-    printf("reserved word %s", m2c_lexeme_for_resword(offending_sym));
-  }
-  else if (m2c_is_special_symbol_token(offending_sym)) {
-    printf("symbol '%s'", m2c_lexeme_for_special_symbol(offending_sym));
-  }
-  else if (offending_sym == TOKEN_END_OF_FILE) {
-    printf("end of file");
-  }
-  else {
-    printf("unknown token");
+  if (NOT(m2c_diag_accepts(M2C_DIAG_ERROR))) {
+    return;
   } /* end if */
-
-  printf(" found\n");
   
-  /* print name of expected token */
-  printf("  expected ");
+  /* describe offending symbol and its lexeme */
+  describe_symbol(symbol, sizeof(symbol), offending_sym, offending_lex);
+  
+  /* describe expected token */
+  expected = expected_sym;
   
   if (expected_token == TOKEN_IDENTIFIER) {
-    printf("identifier");
+    expected = "identifier";
   }
   else if (m2c_is_literal_token(expected_token)) {
-    printf("integer, real number, character code or string literal");
+    expected = "integer, real number, character code or string literal";
   }
   else if (m2c_is_resword_token(expected_token)) {
-    printf("reserved word %s", m2c_lexeme_for_resword(expected_token));
+    snprintf(expected_sym, sizeof(expected_sym),
+      "reserved word %s", m2c_lexeme_for_resword(expected_token));
   }
   else if (m2c_is_special_symbol_token(expected_token)) {
-    printf("symbol '%s'", m2c_lexeme_for_special_symbol(expected_token));
+    snprintf(expected_sym, sizeof(expected_sym),
+      "symbol '%s'", m2c_lexeme_for_special_symbol(expected_token));
   }
   else if (expected_token == TOKEN_END_OF_FILE) {
-    printf("end of file");
+    expected = "end of file";
+  }
+  else {
+    expected = "";
   } /* end if */
   
-  printf("\n");
+  snprintf(message, sizeof(message),
+    "unexpected %s found\n  expected %s", symbol, expected);
+  
+  m2c_diag_emit(M2C_DIAG_ERROR, line, column, message);
   
 } /* end m2c_emit_syntax_error_w_token */
 
@@ -322,7 +362,8 @@ void m2c_emit_syntax_error_w_token
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_syntax_error_w_set(line, col, off_sym, off_lex, set)
  * --------------------------------------------------------------------------
- * Emits a syntax error message of the following format to the console:
+ * Emits a syntax error message of the following format to the diagnostic
+ * buffer:
  * line: n, column: m, unexpected offending-symbol offending-lexeme found
  *   expected set-symbol-1, set-symbol-2, set-symbol-3, ... or set-symbol-N
  * ----------------------------------------------------------------------- */
@@ -333,34 +374,24 @@ void m2c_emit_syntax_error_w_set
    const char *offending_lex,
    m2c_tokenset_t expected_set) {
   
-  /* print line and column */
-  printf("line %u, column %u, error: unexpected ", line, column);
+  char message[MAX_MESSAGE_LENGTH + 1];
+  char symbol[MAX_MESSAGE_LENGTH + 1];
+  char expected[M2C_TOKENSET_LIST_STR_SIZE];
   
-  /* print offending symbol and its lexeme */
-  if (offending_sym == TOKEN_IDENTIFIER) {
-    printf("identifier '%s'", offending_lex);
-  }
-  else if (m2c_is_literal_token(offending_sym)) {
-    printf("literal <<%s>>", offending_lex);
-  }
-  else if (m2c_is_resword_token(offending_sym)) {
-    printf("reserved word %s", m2c_lexeme_for_resword(offending_sym));
-  }
-  else if (m2c_is_special_symbol_token(offending_sym)) {
-    printf("symbol '%s'", m2c_lexeme_for_special_symbol(offending_sym));
-  }
-  else if (offending_sym == TOKEN_END_OF_FILE) {
-    printf("end of file");
-  }
-  else {
-    printf("unknown token");
+  if (NOT(m2c_diag_accepts(M2C_DIAG_ERROR))) {
+    return;
   } /* end if */
-
-  printf(" found\n");
   
-  /* print list of expected symbols */
-  printf("  expected ");
-  m2c_tokenset_print_list(expected_set);
+  /* describe offending symbol and its lexeme */
+  describe_symbol(symbol, sizeof(symbol), offending_sym, offending_lex);
+  
+  /* list expected symbols */
+  m2c_tokenset_list_to_str(expected_set, expected, sizeof(expected));
+  
+  snprintf(message, sizeof(message),
+    "unexpected %s found\n  expected %s.", symbol, expected);
+  
+  m2c_diag_emit(M2C_DIAG_ERROR, line, column, message);
   
 } /* end m2c_emit_syntax_error_w_set */
 
@@ -368,14 +399,14 @@ void m2c_emit_syntax_error_w_set
 /* --------------------------------------------------------------------------
  * procedure m2c_emit_warning_w_pos(error, line, column)
  * --------------------------------------------------------------------------
- * Emits a warning message for error code error to the console.
+ * Emits a warning message for error code error to the diagnostic buffer.
  * ----------------------------------------------------------------------- */
 
 void m2c_emit_warning_w_pos
   (m2c_error_t error, uint_t line, uint_t column) {
   if (error < ERROR_END_MARK) {
-    printf("line %u, column %u, warning: %s\n",
-      line, column, m2c_error_text_array[error]);
+    m2c_diag_emit(M2C_DIAG_WARNING, line, column,
+      m2c_error_text_array[error]);
   } /* end if */
 } /* end m2c_emit_error_w_pos */
 
@@ -388,9 +419,12 @@ void m2c_emit_warning_w_pos
 
 void m2c_emit_warning_w_range
   (m2c_error_t error, uint_t first_line, uint_t last_line) {
-  if (error < ERROR_END_MARK) {
-    printf("line %u to line %u, warning: %s\n",
-      first_line, last_line, m2c_error_text_array[error]);
+  char message[MAX_MESSAGE_LENGTH + 1];
+  
+  if ((error < ERROR_END_MARK) && (m2c_diag_accepts(M2C_DIAG_WARNING))) {
+    snprintf(message, sizeof(message), "%s through line %u",
+      m2c_error_text_array[error], last_line);
+    m2c_diag_emit(M2C_DIAG_WARNING, first_line, 0, message);
   } /* end if */
 } /* end m2c_emit_warning_w_range */
 
@@ -35,7 +35,7 @@
 
 #include "m2-filereader.h"
 #include "m2-common.h"
-#include "m2-fileutils.h"
+#include "fileutils.h"
 
 #include <stdio.h>
 #include <errno.h>
@@ -58,6 +58,8 @@ struct m2c_infile_struct_t {
   /* marker_set */      bool marker_set;
   /* marker_index */    size_t marked_index;
   /* status */          m2c_infile_status_t status;
+  /* line_count */      uint_t line_count;
+  /* line_start */      size_t *line_start;
   /* buflen */          size_t buflen;
   /* buffer */          char buffer[];
 };
@@ -65,6 +67,16 @@ struct m2c_infile_struct_t {
 typedef struct m2c_infile_struct_t m2c_infile_struct_t;
 
 
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool build_line_index (m2c_infile_t infile);
+
+static bool index_for_line
+  (m2c_infile_t infile, uint_t line, size_t *index);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_open_infile(infile, filename, status)
  * --------------------------------------------------------------------------
@@ -99,6 +111,7 @@ m2c_infile_t m2c_open_infile
   
   FILE *file; size_t size;
   m2c_infile_t new_infile;
+  file_info_t info;
   
   /* check pre-conditions */
   if (filename == NULL) {
@@ -130,8 +143,8 @@ m2c_infile_t m2c_open_infile
     return NULL;
   } /* end if */
   
-  /* allocate new infile */
-  size = filesize(m2c_string_char_ptr(filename));
+  /* allocate new infile, sized from the opened file without a lookup */
+  size = get_stream_file_info(file, &info) ? (size_t) info.size : 0;
   new_infile = malloc(sizeof(m2c_infile_struct_t) + size + 1);
   
   /* if allocation failed, close file, pass status and return */
@@ -163,6 +176,8 @@ m2c_infile_t m2c_open_infile
   new_infile->marker_set = false;
   new_infile->marked_index = 0;
   new_infile->status = M2C_INFILE_STATUS_SUCCESS;
+  new_infile->line_count = 0;
+  new_infile->line_start = NULL;
   
   return new_infile;
 } /* m2c_open_infile */
@@ -314,41 +329,6 @@ m2c_string_t m2c_read_marked_lexeme (m2c_infile_t infile) {
 } /* end m2c_read_marked_lexeme */
 
 
-static size_t m2c_infile_index_for_line (m2c_infile_t infile, uint_t line) {
-  size_t index = 0;
-  uint_t this_line = 1;
-  
-  while (this_line != line) {
-    /* find end of line */
-    while ((index < infile->buflen) &&
-           (infile->buffer[index] != ASCII_CR) &&
-           (infile->buffer[index] != ASCII_LF)) {
-     index++;
-     } /* end while */
-     
-     /* skip LF */
-     if (infile->buffer[index] == ASCII_LF) {
-       index++;
-     }
-     /* skip CR or CR LF */
-     else if (infile->buffer[index] == ASCII_CR) {
-       index++;
-       if (infile->buffer[index] == ASCII_LF) {
-         index++;
-       } /* end if */
-     }
-     else /* target line does not exist */ {
-       return 0;
-     } /* end if */
-     
-     /* next line */
-     this_line++;
-  } /* end while */
-  
-  return index;
-} /* end m2c_infile_index_for_line */
-
-
 /* --------------------------------------------------------------------------
  * function m2c_infile_source_for_line(infile, line)
  * --------------------------------------------------------------------------
@@ -377,9 +357,7 @@ m2c_string_t m2c_infile_source_for_line (m2c_infile_t infile, uint_t line) {
   } /* end if */
   
   /* determine start of line */
-  start = m2c_infile_index_for_line(infile, line);
-  
-  if (start == 0) {
+  if (NOT(index_for_line(infile, line, &start))) {
     return NULL;
   } /* end if */
   
@@ -665,6 +643,7 @@ void m2c_close_infile (m2c_infile_t *infptr, m2c_infile_status_t *status) {
   infile = *infptr;
   
   fclose(infile->file);
+  free(infile->line_start);
   free(infile);
   *infptr = NULL;
   
@@ -672,4 +651,94 @@ void m2c_close_infile (m2c_infile_t *infptr, m2c_infile_status_t *status) {
   return;
 } /* end m2c_close_infile */
 
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function build_line_index(infile)
+ * --------------------------------------------------------------------------
+ * Builds the table of line start offsets of infile.  A line ends with LF,
+ * CR or CR LF.  The table is built on the first lookup of a source line and
+ * is kept until infile is closed.  Returns true on success, false if the
+ * table could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+#define AT_LINE_END(_buffer, _index)   (((_buffer)[_index] == ASCII_LF) || ((_buffer)[_index] == ASCII_CR))
+
+static bool build_line_index (m2c_infile_t infile) {
+  size_t index;
+  uint_t line_count, line;
+  size_t *line_start;
+  
+  /* count lines */
+  line_count = 1;
+  for (index = 0; index < infile->buflen; index++) {
+    if ((infile->buffer[index] == ASCII_LF) ||
+        ((infile->buffer[index] == ASCII_CR) &&
+         ((index + 1 >= infile->buflen) ||
+          (infile->buffer[index + 1] != ASCII_LF)))) {
+      line_count++;
+    } /* end if */
+  } /* end for */
+  
+  line_start = malloc(line_count * sizeof(size_t));
+  
+  if (line_start == NULL) {
+    return false;
+  } /* end if */
+  
+  /* record line starts */
+  line_start[0] = 0;
+  line = 1;
+  index = 0;
+  while (index < infile->buflen) {
+    if (NOT(AT_LINE_END(infile->buffer, index))) {
+      index++;
+    }
+    else /* end of line */ {
+      /* skip LF, CR or CR LF */
+      if ((infile->buffer[index] == ASCII_CR) &&
+          (index + 1 < infile->buflen) &&
+          (infile->buffer[index + 1] == ASCII_LF)) {
+        index++;
+      } /* end if */
+      index++;
+      
+      line_start[line] = index;
+      line++;
+    } /* end if */
+  } /* end while */
+  
+  infile->line_start = line_start;
+  infile->line_count = line_count;
+  
+  return true;
+} /* end build_line_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function index_for_line(infile, line, index)
+ * --------------------------------------------------------------------------
+ * Looks up the buffer index of the start of line in the line index of
+ * infile, building the index on first use.  Passes the index back in index
+ * and returns true if line exists, otherwise returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool index_for_line
+  (m2c_infile_t infile, uint_t line, size_t *index) {
+  
+  if ((infile->line_start == NULL) && (NOT(build_line_index(infile)))) {
+    infile->status = M2C_INFILE_STATUS_ALLOCATION_FAILED;
+    return false;
+  } /* end if */
+  
+  if ((line == 0) || (line > infile->line_count)) {
+    return false;
+  } /* end if */
+  
+  *index = infile->line_start[line - 1];
+  return true;
+} /* end index_for_line */
+
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,1429 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-symfile.c                                                             *
+ *                                                                           *
+ * Implementation of M2C symbol files.                                       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2-symfile.h"
+#include "hash.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped symbol files for POSIX and Unix-like host platforms
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  symbol files are mapped read-only into the
+ * address space and used in place.  On all other hosts  (AmigaOS, OpenVMS,
+ * Windows) the file is read into a buffer.  Define M2C_SYMFILE_USE_MMAP as
+ * 0 to force the buffered implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_SYMFILE_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_SYMFILE_USE_MMAP 1
+#else
+#define M2C_SYMFILE_USE_MMAP 0
+#endif
+#endif
+
+#if (M2C_SYMFILE_THREAD_SAFE)
+#include <pthread.h>
+#endif
+
+#if (M2C_SYMFILE_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_symfile_header_t
+ * --------------------------------------------------------------------------
+ * record type representing the header of a symbol file.
+ *
+ * The header is followed by symbol_count records,  an index of slot_count
+ * 32-bit slots,  a Bloom filter of bloom_words 32-bit words and string_size
+ * bytes of NUL terminated strings.  A slot holds the number of a record
+ * plus one,  or zero if it is free.  Records are found by linear probing
+ * from the slot given by the interned key of their identifier.  The filter
+ * holds the keys of all records,  with four bits per slot,  and is tested
+ * before the index is probed,  so that most lookups of identifiers the
+ * interface does not export are answered without touching the index.
+ * String fields hold offsets into the string table,  or SYMFILE_NULL_OFFSET
+ * for NULL.  Fields c_prefix to c_header hold the C names of the module,
+ * composed once by the writer.  Field probe holds the key of SYMFILE_PROBE
+ * to reject files whose keys were computed by a different hash function.
+ * ----------------------------------------------------------------------- */
+
+#define SYMFILE_MAGIC "M2C-SYM"
+
+#define SYMFILE_BYTE_ORDER 0x01020304
+
+#define SYMFILE_PROBE "M2C"
+
+#define SYMFILE_NULL_OFFSET UINT32_MAX
+
+#define SYMFILE_MIN_SLOT_COUNT 8
+
+#define SYMFILE_BLOOM_BITS_PER_SLOT 4
+
+typedef struct {
+  /* magic */           char magic[8];
+  /* version */         uint32_t version;
+  /* byte_order */      uint32_t byte_order;
+  /* probe */           uint32_t probe;
+  /* symbol_count */    uint32_t symbol_count;
+  /* slot_count */      uint32_t slot_count;
+  /* bloom_words */     uint32_t bloom_words;
+  /* string_size */     uint32_t string_size;
+  /* module */          uint32_t module;
+  /* astpath */         uint32_t astpath;
+  /* c_prefix */        uint32_t c_prefix;
+  /* c_upper_prefix */  uint32_t c_upper_prefix;
+  /* c_import_guard */  uint32_t c_import_guard;
+  /* c_header */        uint32_t c_header;
+} m2c_symfile_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_symfile_record_t
+ * --------------------------------------------------------------------------
+ * record type representing a symbol in a symbol file.  Field definition is
+ * the position of the definition within the module's flat AST,  or zero if
+ * it is not available.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* key */             uint32_t key;
+  /* ident */           uint32_t ident;
+  /* length */          uint32_t length;
+  /* kind */            uint32_t kind;
+  /* type_id */         uint32_t type_id;
+  /* definition */      uint32_t definition;
+} m2c_symfile_record_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_symfile_struct_t
+ * --------------------------------------------------------------------------
+ * record type representing an open symbol file.  Pointers record,  slot,
+ * bloom and string point into the file contents.  The AST file is read on
+ * demand,  guarded by lock if built thread safe.  Fields path and next are
+ * used by files in the import cache,  path is NULL for private files.
+ * Reference counts are guarded by the cache lock.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_symfile_struct_t {
+  /* ref_count */       uint_t ref_count;
+  /* path */            char *path;
+  /* next */            m2c_symfile_t next;
+#if (M2C_SYMFILE_THREAD_SAFE)
+  /* lock */            pthread_mutex_t lock;
+#endif
+  /* file_data */       void *file_data;
+  /* file_size */       size_t file_size;
+  /* is_mapped */       bool is_mapped;
+  /* header */          m2c_symfile_header_t header;
+  /* record */          const m2c_symfile_record_t *record;
+  /* slot */            const uint32_t *slot;
+  /* bloom */           const uint32_t *bloom;
+  /* string */          const char *string;
+  /* ast */             m2c_ast_flat_t ast;
+  /* ast_failed */      bool ast_failed;
+};
+
+typedef struct m2c_symfile_struct_t m2c_symfile_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private variable import_cache
+ * --------------------------------------------------------------------------
+ * List of the symbol files currently held through m2c_import_symfile.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_t import_cache = NULL;
+
+#if (M2C_SYMFILE_THREAD_SAFE)
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type m2c_symfile_builder_t
+ * --------------------------------------------------------------------------
+ * record type representing the state of the symbol file writer.  Strings
+ * are collected in buffer string,  in the order they are written.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_ast_flat_t flat;
+  m2c_symfile_record_t *record;
+  uint32_t record_count;
+  uint32_t record_capacity;
+  char *string;
+  uint32_t string_size;
+  uint32_t string_capacity;
+  const char *module;
+  bool failed;
+} m2c_symfile_builder_t;
+
+
+/* *********************************************************************** *
+ * Public Functions                                                        *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_symfile(symtab, flat, astpath, path, status)
+ * --------------------------------------------------------------------------
+ * Writes the symbols of the top level scope of symtab to a symbol file at
+ * path.  Passes back M2C_SYMFILE_STATUS_SUCCESS,  INVALID_REFERENCE if symtab
+ * or path is NULL,  IO_ERROR if the file could not be written,  or
+ * ALLOCATION_FAILED.
+ * ----------------------------------------------------------------------- */
+
+static void add_symbol
+  (intstr_t ident, const m2c_sym_attr_t *attributes, void *context);
+
+static uint32_t add_string
+  (m2c_symfile_builder_t *builder, const char *str, uint_t length);
+
+static void add_c_names
+  (m2c_symfile_builder_t *builder, m2c_symfile_header_t *header);
+
+static uint32_t *new_index
+  (const m2c_symfile_record_t *record, uint32_t count, uint32_t *slot_count);
+
+static uint32_t *new_bloom
+  (const m2c_symfile_record_t *record, uint32_t count, uint32_t slot_count,
+   uint32_t *bloom_words);
+
+static uint32_t symfile_probe (void);
+
+void m2c_write_symfile
+  (m2c_symtab_t symtab, m2c_ast_flat_t flat, const char *astpath,
+   const char *path, m2c_symfile_status_t *status) {
+  
+  m2c_symfile_builder_t builder;
+  m2c_symfile_header_t header;
+  uint32_t *slot, slot_count, *bloom, bloom_words;
+  FILE *file;
+  bool ok;
+  
+  if ((symtab == NULL) || (path == NULL)) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* definitions can only be recorded with a flat tree and its file */
+  if (astpath == NULL) {
+    flat = NULL;
+  } /* end if */
+  
+  memset(&builder, 0, sizeof(m2c_symfile_builder_t));
+  builder.flat = flat;
+  
+  /* collect records and strings */
+  m2c_symtab_visit_top_scope(symtab, add_symbol, &builder);
+  
+  memset(&header, 0, sizeof(m2c_symfile_header_t));
+  memcpy(header.magic, SYMFILE_MAGIC, sizeof(SYMFILE_MAGIC));
+  header.version = M2C_SYMFILE_VERSION;
+  header.byte_order = SYMFILE_BYTE_ORDER;
+  header.probe = symfile_probe();
+  header.symbol_count = builder.record_count;
+  
+  header.module = add_string(&builder, builder.module,
+    (builder.module != NULL) ? strlen(builder.module) : 0);
+  
+  header.astpath = (flat == NULL) ? SYMFILE_NULL_OFFSET :
+    add_string(&builder, astpath, strlen(astpath));
+  
+  /* C names of the module,  composed here once for all importers */
+  add_c_names(&builder, &header);
+  
+  slot = NULL;
+  bloom = NULL;
+  if (NOT(builder.failed)) {
+    slot = new_index(builder.record, builder.record_count, &slot_count);
+  } /* end if */
+  
+  if (slot != NULL) {
+    bloom = new_bloom(builder.record, builder.record_count,
+      slot_count, &bloom_words);
+  } /* end if */
+  
+  if (bloom == NULL) {
+    free(slot);
+    free(builder.record);
+    free(builder.string);
+    SET_STATUS(status, M2C_SYMFILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  header.slot_count = slot_count;
+  header.bloom_words = bloom_words;
+  header.string_size = builder.string_size;
+  
+  /* write header, records, index, filter and strings */
+  file = fopen(path, "wb");
+  ok = (file != NULL);
+  
+  if (ok) {
+    ok = (fwrite(&header, sizeof(m2c_symfile_header_t), 1, file) == 1) &&
+      ((builder.record_count == 0) ||
+       (fwrite(builder.record, sizeof(m2c_symfile_record_t),
+          builder.record_count, file) == builder.record_count)) &&
+      (fwrite(slot, sizeof(uint32_t), slot_count, file) == slot_count) &&
+      (fwrite(bloom, sizeof(uint32_t), bloom_words, file) == bloom_words) &&
+      ((builder.string_size == 0) ||
+       (fwrite(builder.string, 1, builder.string_size, file) ==
+          builder.string_size));
+    
+    if ((fclose(file) != 0) || NOT(ok)) {
+      remove(path);
+      ok = false;
+    } /* end if */
+  } /* end if */
+  
+  free(slot);
+  free(bloom);
+  free(builder.record);
+  free(builder.string);
+  
+  if (NOT(ok)) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_SYMFILE_STATUS_SUCCESS);
+  return;
+} /* end m2c_write_symfile */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_open_symfile(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the symbol file at path and returns it,  or NULL on failure.  Only
+ * the header and the sizes of the file's sections are checked.  Passes back
+ * M2C_SYMFILE_STATUS_SUCCESS,  INVALID_REFERENCE if path is NULL,  IO_ERROR
+ * if the file could not be read,  INVALID_FILE if it is not a symbol file of
+ * this build,  or ALLOCATION_FAILED.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_status_t read_file_data
+  (m2c_symfile_t symfile, const char *path);
+
+static void release_file_data (m2c_symfile_t symfile);
+
+static bool is_valid_header (m2c_symfile_t symfile);
+
+m2c_symfile_t m2c_open_symfile
+  (const char *path, m2c_symfile_status_t *status) {
+  
+  m2c_symfile_status_t read_status;
+  m2c_symfile_t symfile;
+  const char *data;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  symfile = malloc(sizeof(m2c_symfile_struct_t));
+  
+  if (symfile == NULL) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  memset(symfile, 0, sizeof(m2c_symfile_struct_t));
+  symfile->ref_count = 1;
+  read_status = read_file_data(symfile, path);
+  
+  if (read_status == M2C_SYMFILE_STATUS_SUCCESS) {
+    memcpy(&symfile->header,
+      symfile->file_data, sizeof(m2c_symfile_header_t));
+    
+    if (NOT(is_valid_header(symfile))) {
+      read_status = M2C_SYMFILE_STATUS_INVALID_FILE;
+    } /* end if */
+  } /* end if */
+  
+  if (read_status != M2C_SYMFILE_STATUS_SUCCESS) {
+    release_file_data(symfile);
+    free(symfile);
+    SET_STATUS(status, read_status);
+    return NULL;
+  } /* end if */
+  
+  /* locate sections */
+  data = (const char *) symfile->file_data;
+  
+  symfile->record = (const m2c_symfile_record_t *)
+    (data + sizeof(m2c_symfile_header_t));
+  
+  symfile->slot =
+    (const uint32_t *) &symfile->record[symfile->header.symbol_count];
+  
+  symfile->bloom = &symfile->slot[symfile->header.slot_count];
+  
+  symfile->string =
+    (const char *) &symfile->bloom[symfile->header.bloom_words];
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_init(&symfile->lock, NULL);
+#endif
+  
+  SET_STATUS(status, M2C_SYMFILE_STATUS_SUCCESS);
+  return symfile;
+} /* end m2c_open_symfile */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_symfile(path, status)
+ * --------------------------------------------------------------------------
+ * Returns the symbol file for path from the import cache,  or opens it and
+ * enters it into the cache.  The cache lock is held while the file is
+ * opened,  so that concurrent imports of the same path open it once.
+ * ----------------------------------------------------------------------- */
+
+static void lock_cache (void);
+
+static void unlock_cache (void);
+
+m2c_symfile_t m2c_import_symfile
+  (const char *path, m2c_symfile_status_t *status) {
+  
+  m2c_symfile_t symfile;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_SYMFILE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  lock_cache();
+  
+  /* look for a file already imported from path */
+  symfile = import_cache;
+  while ((symfile != NULL) && (strcmp(symfile->path, path) != 0)) {
+    symfile = symfile->next;
+  } /* end while */
+  
+  if (symfile != NULL) {
+    symfile->ref_count++;
+    unlock_cache();
+    SET_STATUS(status, M2C_SYMFILE_STATUS_SUCCESS);
+    return symfile;
+  } /* end if */
+  
+  /* open and enter it into the cache */
+  symfile = m2c_open_symfile(path, status);
+  
+  if (symfile != NULL) {
+    symfile->path = malloc(strlen(path) + 1);
+    
+    if (symfile->path == NULL) {
+      unlock_cache();
+      m2c_release_symfile(symfile);
+      SET_STATUS(status, M2C_SYMFILE_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+    
+    strcpy(symfile->path, path);
+    symfile->next = import_cache;
+    import_cache = symfile;
+  } /* end if */
+  
+  unlock_cache();
+  
+  return symfile;
+} /* end m2c_import_symfile */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_retain_symfile(symfile)
+ * --------------------------------------------------------------------------
+ * Increments the reference count of symfile.
+ * ----------------------------------------------------------------------- */
+
+void m2c_retain_symfile (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return;
+  } /* end if */
+  
+  lock_cache();
+  symfile->ref_count++;
+  unlock_cache();
+  
+  return;
+} /* end m2c_retain_symfile */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_attach(symfile, symtab)
+ * --------------------------------------------------------------------------
+ * Adds symfile to the imports of symtab.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symtab_status_t import_lookup
+  (void *import, intstr_t ident, m2c_sym_attr_t *attributes);
+
+m2c_symfile_status_t m2c_symfile_attach
+  (m2c_symfile_t symfile, m2c_symtab_t symtab) {
+  
+  m2c_symtab_status_t status;
+  
+  if ((symfile == NULL) || (symtab == NULL)) {
+    return M2C_SYMFILE_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  status = m2c_symtab_add_import(symtab, import_lookup, symfile);
+  
+  if (status == M2C_SYMTAB_STATUS_ALLOCATION_FAILED) {
+    return M2C_SYMFILE_STATUS_ALLOCATION_FAILED;
+  }
+  else if (status != M2C_SYMTAB_STATUS_SUCCESS) {
+    return M2C_SYMFILE_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  return M2C_SYMFILE_STATUS_SUCCESS;
+} /* end m2c_symfile_attach */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_lookup(symfile, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Looks up the symbol for ident in symfile and if found,  passes back its
+ * attributes.  Tests the Bloom filter of symfile first,  then probes the
+ * index from the slot given by the key of ident,  comparing keys first and
+ * characters only if the keys match.
+ * ----------------------------------------------------------------------- */
+
+static const char *string_at (m2c_symfile_t symfile, uint32_t offset);
+
+static m2c_astnode_t definition_at (m2c_symfile_t symfile, uint32_t pos);
+
+m2c_symfile_status_t m2c_symfile_lookup
+  (m2c_symfile_t symfile, intstr_t ident, m2c_sym_attr_t *attributes) {
+  
+  const m2c_symfile_record_t *record;
+  uint32_t key, mask, index, probes, slot, length;
+  m2c_astnode_t definition;
+  
+  if ((symfile == NULL) || (ident == NULL)) {
+    return M2C_SYMFILE_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  key = intstr_hash(ident);
+  
+  /* most identifiers not exported are rejected by the filter */
+  if (NOT(bloom_may_contain(symfile->bloom,
+      32 * symfile->header.bloom_words, key))) {
+    return M2C_SYMFILE_STATUS_IDENT_NOT_FOUND;
+  } /* end if */
+  
+  length = intstr_length(ident);
+  mask = symfile->header.slot_count - 1;
+  index = key & mask;
+  record = NULL;
+  
+  /* probe at most every slot once,  even if the index is malformed */
+  probes = 0;
+  while (probes < symfile->header.slot_count) {
+    slot = symfile->slot[index];
+    
+    if (slot == 0) {
+      break;
+    } /* end if */
+    
+    if (slot > symfile->header.symbol_count) {
+      return M2C_SYMFILE_STATUS_INVALID_FILE;
+    } /* end if */
+    
+    record = &symfile->record[slot - 1];
+    
+    if ((record->key == key) && (record->length == length) &&
+        (string_at(symfile, record->ident) != NULL) &&
+        (record->length < symfile->header.string_size - record->ident) &&
+        (memcmp(&symfile->string[record->ident],
+           intstr_char_ptr(ident), length) == 0)) {
+      break;
+    } /* end if */
+    
+    record = NULL;
+    index = (index + 1) & mask;
+    probes++;
+  } /* end while */
+  
+  if (record == NULL) {
+    return M2C_SYMFILE_STATUS_IDENT_NOT_FOUND;
+  } /* end if */
+  
+  /* check fields of the matched record */
+  if ((record->kind > M2C_SYMTYPE_CONST_PARAM) ||
+      ((record->type_id != SYMFILE_NULL_OFFSET) &&
+       (string_at(symfile, record->type_id) == NULL))) {
+    return M2C_SYMFILE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* materialise the definition,  reading the AST file on first use */
+  definition = NULL;
+  if (record->definition != 0) {
+    definition = definition_at(symfile, record->definition);
+  } /* end if */
+  
+  if (attributes != NULL) {
+    (*attributes).scope = m2c_symfile_module(symfile);
+    (*attributes).kind = (m2c_symtype_t) record->kind;
+    (*attributes).type_id = string_at(symfile, record->type_id);
+    (*attributes).definition = definition;
+  } /* end if */
+  
+  if ((record->definition != 0) && (definition == NULL)) {
+    return M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE;
+  } /* end if */
+  
+  return M2C_SYMFILE_STATUS_SUCCESS;
+} /* end m2c_symfile_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_module(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the module of symfile.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_symfile_module (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return string_at(symfile, symfile->header.module);
+} /* end m2c_symfile_module */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_c_names(symfile, names)
+ * --------------------------------------------------------------------------
+ * Passes the C names of the module of symfile in names and returns true,
+ * or returns false if they were not recorded.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_symfile_c_names
+  (m2c_symfile_t symfile, m2c_ident_xlat_names_t *names) {
+  
+  m2c_ident_xlat_names_t c_names;
+  
+  if ((symfile == NULL) || (names == NULL)) {
+    return false;
+  } /* end if */
+  
+  c_names.prefix = string_at(symfile, symfile->header.c_prefix);
+  c_names.upper_prefix = string_at(symfile, symfile->header.c_upper_prefix);
+  c_names.import_guard = string_at(symfile, symfile->header.c_import_guard);
+  c_names.header_name = string_at(symfile, symfile->header.c_header);
+  
+  if ((c_names.prefix == NULL) || (c_names.upper_prefix == NULL) ||
+      (c_names.import_guard == NULL) || (c_names.header_name == NULL)) {
+    return false;
+  } /* end if */
+  
+  *names = c_names;
+  return true;
+} /* end m2c_symfile_c_names */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_symbol_count(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols stored in symfile.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_symbol_count (m2c_symfile_t symfile) {
+  
+  if (symfile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return symfile->header.symbol_count;
+} /* end m2c_symfile_symbol_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_visit_kind(symfile, kind, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor with context for each symbol of kind kind in symfile.  Only
+ * the identifiers of matching records are interned.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_status_t m2c_symfile_visit_kind
+  (m2c_symfile_t symfile, m2c_symtype_t kind,
+   m2c_symtab_visitor_f visitor, void *context) {
+  
+  const m2c_symfile_record_t *record;
+  m2c_sym_attr_t attributes;
+  intstr_status_t status;
+  intstr_t ident;
+  uint32_t index;
+  
+  if ((symfile == NULL) || (visitor == NULL)) {
+    return M2C_SYMFILE_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  attributes.scope = m2c_symfile_module(symfile);
+  attributes.kind = kind;
+  attributes.definition = NULL;
+  
+  for (index = 0; index < symfile->header.symbol_count; index++) {
+    record = &symfile->record[index];
+    
+    if (record->kind != (uint32_t) kind) {
+      continue;
+    } /* end if */
+    
+    /* check bounds as lookups do */
+    if ((string_at(symfile, record->ident) == NULL) ||
+        (record->length >= symfile->header.string_size - record->ident) ||
+        ((record->type_id != SYMFILE_NULL_OFFSET) &&
+         (string_at(symfile, record->type_id) == NULL))) {
+      return M2C_SYMFILE_STATUS_INVALID_FILE;
+    } /* end if */
+    
+    ident = intstr_for_slice
+      (symfile->string, record->ident, record->length, &status);
+    
+    if (status != INTSTR_STATUS_SUCCESS) {
+      return M2C_SYMFILE_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
+    attributes.type_id = string_at(symfile, record->type_id);
+    visitor(ident, &attributes, context);
+  } /* end for */
+  
+  return M2C_SYMFILE_STATUS_SUCCESS;
+} /* end m2c_symfile_visit_kind */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_intern_strings(symfile)
+ * --------------------------------------------------------------------------
+ * Interns the module identifier,  identifiers and type identifiers of
+ * symfile.  Reading the AST file interns the values of its nodes.
+ * ----------------------------------------------------------------------- */
+
+static bool intern_string_at
+  (m2c_symfile_t symfile, uint32_t offset, uint32_t length);
+
+static m2c_ast_flat_t symfile_ast (m2c_symfile_t symfile);
+
+m2c_symfile_status_t m2c_symfile_intern_strings (m2c_symfile_t symfile) {
+  
+  const m2c_symfile_record_t *record;
+  const char *type_id;
+  uint32_t index;
+  
+  if (symfile == NULL) {
+    return M2C_SYMFILE_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  if ((symfile->header.module != SYMFILE_NULL_OFFSET) &&
+      (string_at(symfile, symfile->header.module) != NULL) &&
+      NOT(intern_string_at(symfile, symfile->header.module,
+        strlen(string_at(symfile, symfile->header.module))))) {
+    return M2C_SYMFILE_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  for (index = 0; index < symfile->header.symbol_count; index++) {
+    record = &symfile->record[index];
+    
+    /* check bounds as lookups do */
+    if ((string_at(symfile, record->ident) == NULL) ||
+        (record->length >= symfile->header.string_size - record->ident) ||
+        ((record->type_id != SYMFILE_NULL_OFFSET) &&
+         (string_at(symfile, record->type_id) == NULL))) {
+      return M2C_SYMFILE_STATUS_INVALID_FILE;
+    } /* end if */
+    
+    if (NOT(intern_string_at(symfile, record->ident, record->length))) {
+      return M2C_SYMFILE_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
+    type_id = string_at(symfile, record->type_id);
+    
+    if ((type_id != NULL) &&
+        NOT(intern_string_at(symfile, record->type_id, strlen(type_id)))) {
+      return M2C_SYMFILE_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+  } /* end for */
+  
+  if ((symfile->header.astpath != SYMFILE_NULL_OFFSET) &&
+      (symfile_ast(symfile) == NULL)) {
+    return M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE;
+  } /* end if */
+  
+  return M2C_SYMFILE_STATUS_SUCCESS;
+} /* end m2c_symfile_intern_strings */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_symfile(symfile)
+ * --------------------------------------------------------------------------
+ * Decrements the reference count of symfile.  When it drops to zero,  removes
+ * symfile from the import cache,  closes it and releases its AST file if it
+ * was read.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_symfile (m2c_symfile_t symfile) {
+  
+  m2c_symfile_t *link;
+  
+  if (symfile == NULL) {
+    return;
+  } /* end if */
+  
+  lock_cache();
+  
+  if (symfile->ref_count > 1) {
+    symfile->ref_count--;
+    unlock_cache();
+    return;
+  } /* end if */
+  
+  /* last reference, unlink from import cache */
+  if (symfile->path != NULL) {
+    link = &import_cache;
+    while ((*link != NULL) && (*link != symfile)) {
+      link = &(*link)->next;
+    } /* end while */
+    
+    if (*link != NULL) {
+      *link = symfile->next;
+    } /* end if */
+  } /* end if */
+  
+  unlock_cache();
+  
+  free(symfile->path);
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_destroy(&symfile->lock);
+#endif
+  
+  if (symfile->ast != NULL) {
+    m2c_ast_release_flat(symfile->ast);
+  } /* end if */
+  
+  release_file_data(symfile);
+  free(symfile);
+  
+  return;
+} /* end m2c_release_symfile */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function import_lookup(import, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Symbol table import function for symbol files.  Looks up ident in the
+ * symbol file passed in import and maps the status to symbol table status.
+ * A symbol whose definition is unavailable is passed back without it.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symtab_status_t import_lookup
+  (void *import, intstr_t ident, m2c_sym_attr_t *attributes) {
+  
+  switch (m2c_symfile_lookup((m2c_symfile_t) import, ident, attributes)) {
+    case M2C_SYMFILE_STATUS_SUCCESS :
+    case M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE :
+      return M2C_SYMTAB_STATUS_SUCCESS;
+    
+    case M2C_SYMFILE_STATUS_INVALID_REFERENCE :
+      return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+    
+    default :
+      return M2C_SYMTAB_STATUS_IDENT_NOT_FOUND;
+  } /* end switch */
+} /* end import_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure lock_cache()
+ * --------------------------------------------------------------------------
+ * Acquires the lock of the import cache if built thread safe.
+ * ----------------------------------------------------------------------- */
+
+static void lock_cache (void) {
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_lock(&cache_lock);
+#endif
+  return;
+} /* end lock_cache */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure unlock_cache()
+ * --------------------------------------------------------------------------
+ * Releases the lock of the import cache if built thread safe.
+ * ----------------------------------------------------------------------- */
+
+static void unlock_cache (void) {
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_unlock(&cache_lock);
+#endif
+  return;
+} /* end unlock_cache */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_symbol(ident, attributes, context)
+ * --------------------------------------------------------------------------
+ * Symbol table visitor that appends a record for ident with attributes to
+ * the builder passed in context.  Sets the failed flag of the builder if
+ * allocation fails.
+ * ----------------------------------------------------------------------- */
+
+static void add_symbol
+  (intstr_t ident, const m2c_sym_attr_t *attributes, void *context) {
+  
+  m2c_symfile_builder_t *builder;
+  m2c_symfile_record_t *record;
+  uint32_t new_capacity;
+  
+  builder = (m2c_symfile_builder_t *) context;
+  builder->module = attributes->scope;
+  
+  if (builder->failed) {
+    return;
+  } /* end if */
+  
+  /* grow record array */
+  if (builder->record_count == builder->record_capacity) {
+    new_capacity = (builder->record_capacity == 0) ?
+      SYMFILE_MIN_SLOT_COUNT : 2 * builder->record_capacity;
+    
+    record = realloc(builder->record,
+      new_capacity * sizeof(m2c_symfile_record_t));
+    
+    if (record == NULL) {
+      builder->failed = true;
+      return;
+    } /* end if */
+    
+    builder->record = record;
+    builder->record_capacity = new_capacity;
+  } /* end if */
+  
+  record = &builder->record[builder->record_count];
+  record->key = intstr_hash(ident);
+  record->length = intstr_length(ident);
+  record->ident =
+    add_string(builder, intstr_char_ptr(ident), intstr_length(ident));
+  record->kind = (uint32_t) attributes->kind;
+  record->type_id = add_string(builder, attributes->type_id,
+    (attributes->type_id != NULL) ? strlen(attributes->type_id) : 0);
+  record->definition =
+    m2c_ast_flat_node_pos(builder->flat, attributes->definition);
+  
+  builder->record_count++;
+  
+  return;
+} /* end add_symbol */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_string(builder, str, length)
+ * --------------------------------------------------------------------------
+ * Appends the first length characters of str and a terminating NUL to the
+ * string buffer of builder and returns their offset,  or returns
+ * SYMFILE_NULL_OFFSET if str is NULL.  Sets the failed flag of the builder
+ * if allocation fails.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t add_string
+  (m2c_symfile_builder_t *builder, const char *str, uint_t length) {
+  
+  uint32_t offset, new_capacity;
+  char *new_string;
+  
+  if ((str == NULL) || (builder->failed)) {
+    return SYMFILE_NULL_OFFSET;
+  } /* end if */
+  
+  /* grow string buffer */
+  if (builder->string_capacity - builder->string_size < length + 1) {
+    new_capacity = (builder->string_capacity == 0) ?
+      256 : builder->string_capacity;
+    
+    while (new_capacity - builder->string_size < length + 1) {
+      new_capacity = 2 * new_capacity;
+    } /* end while */
+    
+    new_string = realloc(builder->string, new_capacity);
+    
+    if (new_string == NULL) {
+      builder->failed = true;
+      return SYMFILE_NULL_OFFSET;
+    } /* end if */
+    
+    builder->string = new_string;
+    builder->string_capacity = new_capacity;
+  } /* end if */
+  
+  offset = builder->string_size;
+  memcpy(&builder->string[offset], str, length);
+  builder->string[offset + length] = ASCII_NUL;
+  builder->string_size = offset + length + 1;
+  
+  return offset;
+} /* end add_string */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_c_names(builder, header)
+ * --------------------------------------------------------------------------
+ * Composes the C names of the module of builder  and appends them to the
+ * string buffer of builder,  passing their offsets in header.  The names
+ * are not recorded if the module is unknown or translation failed,  the
+ * importers then translate the module identifier themselves.
+ * ----------------------------------------------------------------------- */
+
+static void add_c_names
+  (m2c_symfile_builder_t *builder, m2c_symfile_header_t *header) {
+  
+  m2c_ident_xlat_cache_t cache;
+  m2c_ident_xlat_names_t names;
+  
+  header->c_prefix = SYMFILE_NULL_OFFSET;
+  header->c_upper_prefix = SYMFILE_NULL_OFFSET;
+  header->c_import_guard = SYMFILE_NULL_OFFSET;
+  header->c_header = SYMFILE_NULL_OFFSET;
+  
+  if (builder->module == NULL) {
+    return;
+  } /* end if */
+  
+  cache = m2c_ident_xlat_new_cache(intstr_for_cstr(builder->module, NULL));
+  
+  if (cache == NULL) {
+    return;
+  } /* end if */
+  
+  m2c_ident_xlat_cached_names(cache, &names);
+  
+  header->c_prefix =
+    add_string(builder, names.prefix, strlen(names.prefix));
+  header->c_upper_prefix =
+    add_string(builder, names.upper_prefix, strlen(names.upper_prefix));
+  header->c_import_guard =
+    add_string(builder, names.import_guard, strlen(names.import_guard));
+  header->c_header =
+    add_string(builder, names.header_name, strlen(names.header_name));
+  
+  m2c_ident_xlat_release_cache(cache);
+} /* end add_c_names */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_index(record, count, slot_count)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated hash index on the count records of array record
+ * and passes back its number of slots in slot_count.  The index is a power
+ * of two at least twice the number of records.  Returns NULL if allocation
+ * failed.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t *new_index
+  (const m2c_symfile_record_t *record, uint32_t count, uint32_t *slot_count) {
+  
+  uint32_t *slot, index, mask, n;
+  
+  *slot_count = SYMFILE_MIN_SLOT_COUNT;
+  while (*slot_count < 2 * count) {
+    *slot_count = 2 * *slot_count;
+  } /* end while */
+  
+  slot = calloc(*slot_count, sizeof(uint32_t));
+  
+  if (slot == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = *slot_count - 1;
+  
+  for (n = 0; n < count; n++) {
+    index = record[n].key & mask;
+    while (slot[index] != 0) {
+      index = (index + 1) & mask;
+    } /* end while */
+    slot[index] = n + 1;
+  } /* end for */
+  
+  return slot;
+} /* end new_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_bloom(record, count, slot_count, bloom_words)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated Bloom filter on the keys of the count records of
+ * array record for an index of slot_count slots  and passes back its number
+ * of 32-bit words in bloom_words.  The filter has SYMFILE_BLOOM_BITS_PER_SLOT
+ * bits per slot,  a power of two of at least eight bits per record.  Returns
+ * NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t *new_bloom
+  (const m2c_symfile_record_t *record, uint32_t count, uint32_t slot_count,
+   uint32_t *bloom_words) {
+  
+  uint32_t *bloom, n;
+  
+  *bloom_words = slot_count * SYMFILE_BLOOM_BITS_PER_SLOT / 32;
+  bloom = calloc(*bloom_words, sizeof(uint32_t));
+  
+  if (bloom == NULL) {
+    return NULL;
+  } /* end if */
+  
+  for (n = 0; n < count; n++) {
+    bloom_add(bloom, 32 * *bloom_words, record[n].key);
+  } /* end for */
+  
+  return bloom;
+} /* end new_bloom */
+
+
+/* --------------------------------------------------------------------------
+ * private function symfile_probe()
+ * --------------------------------------------------------------------------
+ * Returns the key of SYMFILE_PROBE,  computed the way the string repository
+ * computes the keys of interned strings,  to detect symbol files whose keys
+ * were computed by a different hash function.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t symfile_probe (void) {
+  
+  const char *probe = SYMFILE_PROBE;
+  intstr_hash_t key;
+  
+  key = HASH_INITIAL;
+  while (*probe != ASCII_NUL) {
+    key = HASH_NEXT_CHAR(key, *probe);
+    probe++;
+  } /* end while */
+  
+  return HASH_FINAL(key);
+} /* end symfile_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_header(symfile)
+ * --------------------------------------------------------------------------
+ * Returns true if the header of symfile was written by this build with the
+ * same format,  its index is a power of two larger than its record count,
+ * its filter has as many words as the writer derives from the index,
+ * its string table is NUL terminated and the sizes of all sections add up
+ * to the size of the file,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_header (m2c_symfile_t symfile) {
+  
+  const m2c_symfile_header_t *header;
+  uint64_t size;
+  
+  header = &symfile->header;
+  
+  if ((memcmp(header->magic, SYMFILE_MAGIC, sizeof(SYMFILE_MAGIC)) != 0) ||
+      (header->version != M2C_SYMFILE_VERSION) ||
+      (header->byte_order != SYMFILE_BYTE_ORDER) ||
+      (header->probe != symfile_probe()) ||
+      (header->slot_count <= header->symbol_count) ||
+      ((header->slot_count & (header->slot_count - 1)) != 0) ||
+      (header->slot_count > UINT32_MAX / SYMFILE_BLOOM_BITS_PER_SLOT) ||
+      (header->bloom_words !=
+       header->slot_count * SYMFILE_BLOOM_BITS_PER_SLOT / 32)) {
+    return false;
+  } /* end if */
+  
+  size = (uint64_t) sizeof(m2c_symfile_header_t) +
+    (uint64_t) header->symbol_count * sizeof(m2c_symfile_record_t) +
+    (uint64_t) header->slot_count * sizeof(uint32_t) +
+    (uint64_t) header->bloom_words * sizeof(uint32_t) +
+    (uint64_t) header->string_size;
+  
+  if (size != (uint64_t) symfile->file_size) {
+    return false;
+  } /* end if */
+  
+  return (header->string_size == 0) ||
+    (((const char *) symfile->file_data)[symfile->file_size - 1] == ASCII_NUL);
+} /* end is_valid_header */
+
+
+/* --------------------------------------------------------------------------
+ * private function string_at(symfile, offset)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the string at offset within the string table of
+ * symfile,  or NULL if offset is SYMFILE_NULL_OFFSET or out of range.  The
+ * table is NUL terminated,  so any offset within it yields a C string.
+ * ----------------------------------------------------------------------- */
+
+static const char *string_at (m2c_symfile_t symfile, uint32_t offset) {
+  
+  if (offset >= symfile->header.string_size) {
+    return NULL;
+  } /* end if */
+  
+  return &symfile->string[offset];
+} /* end string_at */
+
+
+/* --------------------------------------------------------------------------
+ * private function definition_at(symfile, pos)
+ * --------------------------------------------------------------------------
+ * Returns the definition node at position pos within the flat AST of the
+ * module of symfile,  or NULL if it is not available.
+ * ----------------------------------------------------------------------- */
+
+static m2c_astnode_t definition_at (m2c_symfile_t symfile, uint32_t pos) {
+  
+  return m2c_ast_flat_node_at(symfile_ast(symfile), pos);
+} /* end definition_at */
+
+
+/* --------------------------------------------------------------------------
+ * private function symfile_ast(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the flat AST of the module of symfile,  or NULL if it is not
+ * available.  The AST file is read on the first call and kept,  a failed
+ * read is not retried.  The lock of symfile serialises the first calls of
+ * threads sharing symfile.
+ * ----------------------------------------------------------------------- */
+
+static m2c_ast_flat_t symfile_ast (m2c_symfile_t symfile) {
+  
+  const char *astpath;
+  m2c_ast_flat_t ast;
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_lock(&symfile->lock);
+#endif
+  
+  if ((symfile->ast == NULL) && NOT(symfile->ast_failed)) {
+    astpath = string_at(symfile, symfile->header.astpath);
+    
+    if (astpath != NULL) {
+      symfile->ast = m2c_ast_read_file(astpath, NULL);
+    } /* end if */
+    
+    symfile->ast_failed = (symfile->ast == NULL);
+  } /* end if */
+  
+  ast = symfile->ast;
+  
+#if (M2C_SYMFILE_THREAD_SAFE)
+  pthread_mutex_unlock(&symfile->lock);
+#endif
+  
+  return ast;
+} /* end symfile_ast */
+
+
+/* --------------------------------------------------------------------------
+ * private function intern_string_at(symfile, offset, length)
+ * --------------------------------------------------------------------------
+ * Interns the length characters at offset within the string table of symfile
+ * and returns true,  or false if the string could not be interned.  Empty
+ * strings are skipped.  The offset and length must be within the string
+ * table.
+ * ----------------------------------------------------------------------- */
+
+static bool intern_string_at
+  (m2c_symfile_t symfile, uint32_t offset, uint32_t length) {
+  
+  intstr_status_t status;
+  
+  if (length == 0) {
+    return true;
+  } /* end if */
+  
+  intstr_for_slice(symfile->string, offset, length, &status);
+  
+  return (status == INTSTR_STATUS_SUCCESS);
+} /* end intern_string_at */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_file_data(symfile, path)
+ * --------------------------------------------------------------------------
+ * Maps or reads the contents of the file at path into memory and records
+ * them in fields file_data,  file_size and is_mapped of symfile.  The file
+ * is never modified,  so it is mapped read-only and may be shared by all
+ * processes importing the same interface.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symfile_status_t read_file_data
+  (m2c_symfile_t symfile, const char *path) {
+  
+#if (M2C_SYMFILE_USE_MMAP)
+  struct stat info;
+  void *map;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return M2C_SYMFILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) || NOT(S_ISREG(info.st_mode))) {
+    close(fd);
+    return M2C_SYMFILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) info.st_size < sizeof(m2c_symfile_header_t)) {
+    close(fd);
+    return M2C_SYMFILE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    return M2C_SYMFILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  symfile->file_data = map;
+  symfile->file_size = (size_t) info.st_size;
+  symfile->is_mapped = true;
+  
+  return M2C_SYMFILE_STATUS_SUCCESS;
+#else
+  FILE *file;
+  void *data;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return M2C_SYMFILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return M2C_SYMFILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) size < sizeof(m2c_symfile_header_t)) {
+    fclose(file);
+    return M2C_SYMFILE_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* malloc'd storage is suitably aligned for the records */
+  data = malloc((size_t) size);
+  
+  if (data == NULL) {
+    fclose(file);
+    return M2C_SYMFILE_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) size, file) != (size_t) size) {
+    free(data);
+    fclose(file);
+    return M2C_SYMFILE_STATUS_IO_ERROR;
+  } /* end if */
+  
+  fclose(file);
+  
+  symfile->file_data = data;
+  symfile->file_size = (size_t) size;
+  symfile->is_mapped = false;
+  
+  return M2C_SYMFILE_STATUS_SUCCESS;
+#endif
+} /* end read_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_file_data(symfile)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates the file contents of symfile.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_symfile_t symfile) {
+  
+  if (symfile->file_data == NULL) {
+    return;
+  } /* end if */
+  
+#if (M2C_SYMFILE_USE_MMAP)
+  if (symfile->is_mapped) {
+    munmap(symfile->file_data, symfile->file_size);
+  }
+  else {
+    free(symfile->file_data);
+  } /* end if */
+#else
+  free(symfile->file_data);
+#endif
+  
+  symfile->file_data = NULL;
+  symfile->file_size = 0;
+  
+  return;
+} /* end release_file_data */
+
+/* END OF FILE */
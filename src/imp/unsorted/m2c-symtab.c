@@ -34,13 +34,51 @@
  */
 
 #include "m2-symtab.h"
-
+#include "m2c-mem-account.h"
 #include "hash.h"
+
+#include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* initial slots of the top level scope, must be a power of two */
+
+#define M2C_SYMTAB_SLOT_COUNT_TOPSCOPE 128
+
+/* slots of a small scope, searched linearly until full */
+
+#define M2C_SYMTAB_SLOT_COUNT_SUBSCOPE 8
+
+/* slots of a small scope once it outgrows linear search, a power of two */
+
+#define M2C_SYMTAB_SLOT_COUNT_HASHED_SUBSCOPE 32
+
+/* maximum load factor of a hashed scope in percent, grows when exceeded */
+
+#define M2C_SYMTAB_MAX_LOAD_PERCENT 75
+
+/* bits of the Bloom filter of a scope per slot, a power of two */
+
+#define M2C_SYMTAB_BLOOM_BITS_PER_SLOT 8
+
+#define SYMTAB_BLOOM_BITS(_slot_count) \
+  ((_slot_count) * M2C_SYMTAB_BLOOM_BITS_PER_SLOT)
+
+#define SYMTAB_BLOOM_SIZE(_slot_count) \
+  (SYMTAB_BLOOM_BITS(_slot_count) / 8)
 
-#define M2C_SYMTAB_BUCKET_COUNT_TOPSCOPE 97
+/* initial number of entries of the import list */
 
-#define M2C_SYMTAB_BUCKET_COUNT_SUBSCOPE 17
+#define M2C_SYMTAB_IMPORT_CAPACITY 8
+
+/* size of the blocks of the scope arena */
+
+#define M2C_SYMTAB_ARENA_BLOCK_SIZE (16 * 1024)
+
+#define SYMTAB_ARENA_ALIGNMENT (sizeof(void *))
+
+#define SYMTAB_ROUND_UP(_size) \
+  (((_size) + SYMTAB_ARENA_ALIGNMENT - 1) & ~(SYMTAB_ARENA_ALIGNMENT - 1))
 
 /* --------------------------------------------------------------------------
  * Logical Representation of Symbol Table
@@ -60,10 +98,38 @@
  *               +------------+                 +------------+
  *
  * symbol
- *               +------------+------------+------------+------------+
- *  fields:      | ident      | kind       | type_id    | definition |
- *               +------------+------------+------------+------------+
- * 
+ *          +----------+----------+----------+----------+------------+
+ *  fields: | key      | ident    | kind     | type_id  | definition |
+ *          +----------+----------+----------+----------+------------+
+ *
+ * Symbols are stored inline in the slot array of their scope.  A small
+ * scope keeps its symbols in insertion order and is searched linearly.
+ * Once it is full,  it is rehashed into an open addressing table,  as is
+ * the top level scope from the start.  A hashed scope is probed linearly
+ * from the slot given by the key,  an empty slot has a NULL ident.  It
+ * doubles in size whenever the load factor would exceed the maximum.
+ *
+ * Identifiers are interned strings,  each is unique and carries the key it
+ * was interned with.  A probe thus compares keys and pointers only, and no
+ * identifier is ever hashed or compared character by character.
+ *
+ * Each scope has a Bloom filter on the keys of its symbols,  of eight bits
+ * per slot.  A lookup tests the filter of a scope before searching it,  so
+ * that most scopes not holding the symbol are passed over without a probe,
+ * as is the search for a duplicate when a new symbol is inserted.  The
+ * filter is rebuilt from the stored keys when the scope is rehashed.
+ *
+ * Scopes and their slot arrays are allocated from an arena owned by the
+ * symbol table and used as a stack.  Each scope records the top of the
+ * arena before it was opened and closing it rolls the arena back to that
+ * mark,  releasing the scope,  its symbols and any scopes nested within it
+ * at once.  Slot arrays abandoned by rehashing are reclaimed the same way.
+ * Blocks popped by a rollback are kept for reuse by subsequent scopes.
+ *
+ * Imported symbol tables are not copied.  The table holds a list of their
+ * lookup functions,  which are called in order if a symbol is not found in
+ * any scope,  so that read-only tables of imported interfaces can be shared
+ * by all tables that import them.
  * ----------------------------------------------------------------------- */
 
 /* --------------------------------------------------------------------------
@@ -74,9 +140,11 @@
 
 typedef struct m2c_symbol_s *m2c_symbol_t;
 
+typedef intstr_hash_t m2c_hash_t;
+
 struct m2c_symbol_s {
-  /* next */ m2c_symbol_t next;
-  /* ident */ const char *ident;
+  /* key */ m2c_hash_t key;
+  /* ident */ intstr_t ident;
   /* kind */ m2c_symtype_t kind;
   /* type_id */ const char *type_id;
   /* definition */ m2c_astnode_t definition;
@@ -85,6 +153,24 @@ struct m2c_symbol_s {
 typedef struct m2c_symbol_s m2c_symbol_s;
 
 
+/* --------------------------------------------------------------------------
+ * private types m2c_symtab_block_s and m2c_symtab_block_t
+ * --------------------------------------------------------------------------
+ * Record and pointer type representing a block of the scope arena.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_symtab_block_s *m2c_symtab_block_t;
+
+struct m2c_symtab_block_s {
+  /* prev */ m2c_symtab_block_t prev;
+  /* size */ size_t size;
+  /* used */ size_t used;
+  /* storage */ char storage[];
+};
+
+typedef struct m2c_symtab_block_s m2c_symtab_block_s;
+
+
 /* --------------------------------------------------------------------------
  * private types m2c_symtab_scope_s and m2c_symtab_scope_t
  * --------------------------------------------------------------------------
@@ -94,15 +180,32 @@ typedef struct m2c_symbol_s m2c_symbol_s;
 typedef struct m2c_symtab_scope_s *m2c_symtab_scope_t;
 
 struct m2c_symtab_scope_s {
+  /* mark_block */ m2c_symtab_block_t mark_block;
+  /* mark_used */ size_t mark_used;
   /* previous */ m2c_symtab_scope_t previous;
   /* ident */ const char *ident;
-  /* bucket_count */ uint_t bucket_count;
-  /* bucket (table) */ m2c_symbol_t bucket[];
+  /* hashed */ bool hashed;
+  /* count */ uint_t count;
+  /* slot_count */ uint_t slot_count;
+  /* slot (table) */ m2c_symbol_s *slot;
+  /* bloom (filter) */ uint32_t *bloom;
 };
 
 typedef struct m2c_symtab_scope_s m2c_symtab_scope_s;
 
 
+/* --------------------------------------------------------------------------
+ * private type m2c_symtab_import_t
+ * --------------------------------------------------------------------------
+ * Record type representing an entry of the import list of a symbol table.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lookup */ m2c_symtab_import_f lookup;
+  /* import */ void *import;
+} m2c_symtab_import_t;
+
+
 /* --------------------------------------------------------------------------
  * hidden type m2c_symtab_struct_t
  * --------------------------------------------------------------------------
@@ -110,10 +213,15 @@ typedef struct m2c_symtab_scope_s m2c_symtab_scope_s;
  * ----------------------------------------------------------------------- */
 
 struct m2c_symtab_struct_t {
+  /* block */ m2c_symtab_block_t block;
+  /* spare */ m2c_symtab_block_t spare;
   /* top */ m2c_symtab_scope_t top;
   /* current */ m2c_symtab_scope_t current;
   /* scope_count */ uint_t scope_count;
   /* symbol_count */ uint_t symbol_count;
+  /* import_count */ uint_t import_count;
+  /* import_capacity */ uint_t import_capacity;
+  /* import (list) */ m2c_symtab_import_t *import;
 };
 
 typedef struct m2c_symtab_struct_t m2c_symtab_struct_t;
@@ -123,17 +231,22 @@ typedef struct m2c_symtab_struct_t m2c_symtab_struct_t;
  * forward declarations
  * ----------------------------------------------------------------------- */
 
-typedef uint32_t m2c_hash_t;
+static m2c_symbol_t scope_lookup
+  (m2c_symtab_scope_t scope, intstr_t ident, m2c_hash_t key);
 
-static m2c_hash_t key_for_cstr (const char *cstr);
+static bool scope_may_contain (m2c_symtab_scope_t scope, m2c_hash_t key);
 
-static m2c_symbol_t new_symbol (const char *ident,
-  m2c_symtype_t kind, const char *type_id, m2c_astnode_t defn);
+static m2c_symbol_t free_slot (m2c_symtab_scope_t scope, m2c_hash_t key);
 
-static m2c_symbol_t scope_lookup
-  (m2c_symtab_scope_t scope, const char *ident, m2c_hash_t key);
+static bool rehash_scope
+  (m2c_symtab_t symtab, m2c_symtab_scope_t scope, uint_t slot_count);
+
+static void *arena_alloc (m2c_symtab_t symtab, size_t size);
 
-static void remove_scope (m2c_symtab_t symtab, m2c_symtab_scope_t scope);
+static void arena_rollback
+  (m2c_symtab_t symtab, m2c_symtab_block_t mark_block, size_t mark_used);
+
+static void arena_dispose (m2c_symtab_t symtab);
 
 
 /* --------------------------------------------------------------------------
@@ -152,23 +265,29 @@ m2c_symtab_t m2c_new_symtab (const char *top_level_scope_id) {
   } /* end if */
   
   /* allocate new table */
-  new_table = malloc(sizeof(m2c_symtab_struct_t));
+  new_table = m2c_mem_alloc(M2C_MEM_SYMTAB, sizeof(m2c_symtab_struct_t));
   
   if (new_table == NULL) {
     return NULL;
   } /* end if */
   
   /* initialise table */
+  new_table->block = NULL;
+  new_table->spare = NULL;
   new_table->top = NULL;
   new_table->current = NULL;
   new_table->scope_count = 0;
   new_table->symbol_count = 0;
+  new_table->import_count = 0;
+  new_table->import_capacity = 0;
+  new_table->import = NULL;
   
   /* allocate and initialise top level scope */
   status = m2c_symtab_open_scope(new_table, top_level_scope_id);
   
   if (status != M2C_SYMTAB_STATUS_SUCCESS) {
-    free(new_table);
+    arena_dispose(new_table);
+    m2c_mem_free(M2C_MEM_SYMTAB, new_table);
     return NULL;
   } /* end if */
   
@@ -185,7 +304,9 @@ m2c_symtab_t m2c_new_symtab (const char *top_level_scope_id) {
 m2c_symtab_status_t m2c_symtab_open_scope
   (m2c_symtab_t symtab, const char *scope_id) {
   
-  uint_t index, bucket_count;
+  uint_t slot_count;
+  size_t mark_used;
+  m2c_symtab_block_t mark_block;
   m2c_symtab_scope_t new_scope;
   
   if (symtab == NULL) {
@@ -197,28 +318,42 @@ m2c_symtab_status_t m2c_symtab_open_scope
   } /* end if */
   
   if (symtab->top == NULL) {
-    bucket_count = M2C_SYMTAB_BUCKET_COUNT_TOPSCOPE;
+    slot_count = M2C_SYMTAB_SLOT_COUNT_TOPSCOPE;
   }
   else {
-    bucket_count = M2C_SYMTAB_BUCKET_COUNT_SUBSCOPE;
+    slot_count = M2C_SYMTAB_SLOT_COUNT_SUBSCOPE;
   } /* end if */
   
-  /* allocate new scope */
-  new_scope =
-    malloc(sizeof(m2c_symtab_scope_s) + bucket_count * sizeof(m2c_symbol_t));
+  /* remember the top of the arena to roll back to when closing */
+  mark_block = symtab->block;
+  mark_used = (mark_block != NULL) ? mark_block->used : 0;
+  
+  /* allocate new scope and its slots */
+  new_scope = arena_alloc(symtab, sizeof(m2c_symtab_scope_s));
   
   if (new_scope == NULL) {
     return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
   } /* end if */
   
-  /* initialise scope */
-  new_scope->ident = scope_id;
-  new_scope->bucket_count = bucket_count;
+  new_scope->slot = arena_alloc(symtab, slot_count * sizeof(m2c_symbol_s));
+  new_scope->bloom = arena_alloc(symtab, SYMTAB_BLOOM_SIZE(slot_count));
   
-  /* initialise buckets */
-  for (index = 0; index < bucket_count; index++) {
-    new_scope->bucket[index] = NULL;
-  } /* end for */
+  if ((new_scope->slot == NULL) || (new_scope->bloom == NULL)) {
+    arena_rollback(symtab, mark_block, mark_used);
+    return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  /* clear slots, a NULL ident marks a free slot */
+  memset(new_scope->slot, 0, slot_count * sizeof(m2c_symbol_s));
+  memset(new_scope->bloom, 0, SYMTAB_BLOOM_SIZE(slot_count));
+  
+  /* initialise scope, only the top level scope is hashed from the start */
+  new_scope->mark_block = mark_block;
+  new_scope->mark_used = mark_used;
+  new_scope->ident = scope_id;
+  new_scope->hashed = (symtab->top == NULL);
+  new_scope->count = 0;
+  new_scope->slot_count = slot_count;
   
   /* link new scope to symbol table */
   if (symtab->top == NULL) {
@@ -246,15 +381,14 @@ m2c_symtab_status_t m2c_symtab_open_scope
 
 m2c_symtab_status_t m2c_symtab_insert
   (m2c_symtab_t symtab,
-   const char *ident,
+   intstr_t ident,
    m2c_symtype_t kind,
    const char *type_id,
    m2c_astnode_t definition) {
   
-  uint_t index;
   m2c_hash_t key;
   m2c_symtab_scope_t scope;
-  m2c_symbol_t prev_symbol, this_symbol;
+  m2c_symbol_t this_symbol;
   
   if (symtab == NULL) {
     return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
@@ -270,37 +404,39 @@ m2c_symtab_status_t m2c_symtab_insert
     return M2C_SYMTAB_STATUS_MISSING_SCOPE;
   } /* end if */
     
-  /* determine bucket index */
-  key = key_for_cstr(ident);
-  index = key % scope->bucket_count;
+  key = intstr_hash(ident);
   
-  /* get first symbol slot in bucket */
-  this_symbol = scope->bucket[index];
+  /* symbol is already present, bail out to avoid duplication */
+  if (scope_may_contain(scope, key) &&
+      (scope_lookup(scope, ident, key) != NULL)) {
+    return M2C_SYMTAB_STATUS_IDENT_NOT_UNIQUE;
+  } /* end if */
   
-  if /* bucket empty */ (this_symbol == NULL) {
-    this_symbol = new_symbol(ident, kind, type_id, definition);
-    scope->bucket[index] = this_symbol;
+  /* make room: a full small scope is hashed, a hashed scope doubles */
+  if (NOT(scope->hashed) && (scope->count == scope->slot_count)) {
+    if (rehash_scope(symtab, scope,
+        M2C_SYMTAB_SLOT_COUNT_HASHED_SUBSCOPE) == false) {
+      return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
+    } /* end if */
   }
-  else /* bucket not empty */ {
-    /* check if symbol is already in bucket */
-    do /* traverse bucket */ {
-      
-      /* symbol is already present, bail out to avoid duplication */
-      if (this_symbol->ident == ident) {
-        return M2C_SYMTAB_STATUS_IDENT_NOT_UNIQUE;
-      } /* end if */
-      
-      /* move to next symbol */
-      prev_symbol = this_symbol;
-      this_symbol = this_symbol->next;
-    } while (this_symbol != NULL);
-    
-    /* symbol not found in bucket, allocate and add new symbol */
-    this_symbol = new_symbol(ident, kind, type_id, definition);
-    prev_symbol->next = this_symbol;
+  else if ((scope->hashed) && ((scope->count + 1) * 100 >
+    scope->slot_count * M2C_SYMTAB_MAX_LOAD_PERCENT)) {
+    if (rehash_scope(symtab, scope, 2 * scope->slot_count) == false) {
+      return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
+    } /* end if */
   } /* end if */
   
-  /* update counter */
+  /* store symbol inline */
+  this_symbol = free_slot(scope, key);
+  this_symbol->key = key;
+  this_symbol->ident = ident;
+  this_symbol->kind = kind;
+  this_symbol->type_id = type_id;
+  this_symbol->definition = definition;
+  bloom_add(scope->bloom, SYMTAB_BLOOM_BITS(scope->slot_count), key);
+  
+  /* update counters */
+  scope->count++;
   symtab->symbol_count++;
   
   return M2C_SYMTAB_STATUS_SUCCESS;
@@ -313,8 +449,11 @@ m2c_symtab_status_t m2c_symtab_insert
  * Looks up the symbol for ident and if found, passes back its attributes.
  * ----------------------------------------------------------------------- */
 
+static m2c_symtab_status_t lookup_imports
+  (m2c_symtab_t symtab, intstr_t ident, m2c_sym_attr_t *attributes);
+
 m2c_symtab_status_t m2c_symtab_lookup
-  (m2c_symtab_t symtab, const char *ident, m2c_sym_attr_t *attributes) {
+  (m2c_symtab_t symtab, intstr_t ident, m2c_sym_attr_t *attributes) {
   
   m2c_hash_t key;
   m2c_symbol_t this_symbol;
@@ -331,24 +470,27 @@ m2c_symtab_status_t m2c_symtab_lookup
   /* start with current scope */
   this_scope = symtab->current;
   
-  key = key_for_cstr(ident);
+  key = intstr_hash(ident);
   
   /* iterate over all scopes */
   while (this_scope != NULL) {
-    /* lookup symbol in this scope */
-    this_symbol = scope_lookup(this_scope, ident, key);
-    
-    /* exit loop if found */
-    if (this_symbol != NULL) {
-      break;
+    /* lookup symbol in this scope unless its filter rules it out */
+    if (scope_may_contain(this_scope, key)) {
+      this_symbol = scope_lookup(this_scope, ident, key);
+      
+      /* exit loop if found */
+      if (this_symbol != NULL) {
+        break;
+      } /* end if */
     } /* end if */
     
     /* move to previous scope */
     this_scope = this_scope->previous;
   } /* end while */
   
+  /* not found in any scope, try imports */
   if (this_scope == NULL) {
-    return M2C_SYMTAB_STATUS_IDENT_NOT_FOUND;
+    return lookup_imports(symtab, ident, attributes);
   } /* end if */
   
   /* pass back symbol's attributes */
@@ -363,6 +505,91 @@ m2c_symtab_status_t m2c_symtab_lookup
 } /* end m2c_symtab_lookup */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_visit_top_scope(symtab, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor with context for each symbol of the top level scope.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_symtab_visit_top_scope
+  (m2c_symtab_t symtab, m2c_symtab_visitor_f visitor, void *context) {
+  
+  uint_t index;
+  m2c_sym_attr_t attributes;
+  m2c_symbol_t this_symbol;
+  
+  if ((symtab == NULL) || (visitor == NULL)) {
+    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  if (symtab->top == NULL) {
+    return M2C_SYMTAB_STATUS_MISSING_SCOPE;
+  } /* end if */
+  
+  attributes.scope = symtab->top->ident;
+  
+  index = 0;
+  while (index < symtab->top->slot_count) {
+    this_symbol = &(symtab->top->slot[index]);
+    
+    if (this_symbol->ident != NULL) {
+      attributes.kind = this_symbol->kind;
+      attributes.type_id = this_symbol->type_id;
+      attributes.definition = this_symbol->definition;
+      visitor(this_symbol->ident, &attributes, context);
+    } /* end if */
+    
+    index++;
+  } /* end while */
+  
+  return M2C_SYMTAB_STATUS_SUCCESS;
+} /* end m2c_symtab_visit_top_scope */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_add_import(symtab, lookup, import)
+ * --------------------------------------------------------------------------
+ * Appends import with lookup function lookup to the import list.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_symtab_add_import
+  (m2c_symtab_t symtab, m2c_symtab_import_f lookup, void *import) {
+  
+  uint_t new_capacity;
+  m2c_symtab_import_t *new_list;
+  
+  if ((symtab == NULL) || (lookup == NULL)) {
+    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+  } /* end if */
+  
+  /* grow import list */
+  if (symtab->import_count == symtab->import_capacity) {
+    if (symtab->import_capacity == 0) {
+      new_capacity = M2C_SYMTAB_IMPORT_CAPACITY;
+    }
+    else {
+      new_capacity = 2 * symtab->import_capacity;
+    } /* end if */
+    
+    new_list = m2c_mem_realloc(M2C_MEM_SYMTAB, symtab->import,
+      new_capacity * sizeof(m2c_symtab_import_t));
+    
+    if (new_list == NULL) {
+      return M2C_SYMTAB_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
+    symtab->import = new_list;
+    symtab->import_capacity = new_capacity;
+  } /* end if */
+  
+  symtab->import[symtab->import_count].lookup = lookup;
+  symtab->import[symtab->import_count].import = import;
+  symtab->import_count++;
+  
+  return M2C_SYMTAB_STATUS_SUCCESS;
+} /* end m2c_symtab_add_import */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_symtab_symbol_count(symtab)
  * --------------------------------------------------------------------------
@@ -404,7 +631,11 @@ uint_t m2c_symtab_scope_count (m2c_symtab_t symtab) {
 m2c_symtab_status_t m2c_symtab_close_scope
   (m2c_symtab_t symtab, const char *scope_id) {
   
-  m2c_symtab_scope_t target_scope, this_scope, prev_scope;
+  m2c_symtab_scope_t target_scope, this_scope;
+  
+  if (symtab == NULL) {
+    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
+  } /* end if */
   
   /* determine if scope_id is valid */
   
@@ -427,16 +658,19 @@ m2c_symtab_status_t m2c_symtab_close_scope
   /* start with current scope */
   this_scope = symtab->current;
   
-  /* remove all scopes up to target scope */
-  while (this_scope != target_scope) {
-    /* remove scope */
-    prev_scope = this_scope->previous;
-    remove_scope(symtab, this_scope);
-    
-    /* move to previous scope */
-    this_scope = prev_scope;
+  /* update counters for all scopes up to target scope */
+  while (this_scope->previous != target_scope) {
+    symtab->symbol_count = symtab->symbol_count - this_scope->count;
+    symtab->scope_count--;
+    this_scope = this_scope->previous;
   } /* end while */
   
+  symtab->symbol_count = symtab->symbol_count - this_scope->count;
+  symtab->scope_count--;
+  
+  /* release them all at once, nested scopes lie above this_scope's mark */
+  arena_rollback(symtab, this_scope->mark_block, this_scope->mark_used);
+  
   if (target_scope == NULL) {
     symtab->top = NULL;
   } /* end if */
@@ -455,22 +689,16 @@ m2c_symtab_status_t m2c_symtab_close_scope
 
 m2c_symtab_status_t m2c_release_symtab (m2c_symtab_t symtab) {
   
-  m2c_symtab_scope_t this_scope, prev_scope;
-  
   if (symtab == NULL) {
    return M2C_SYMTAB_STATUS_INVALID_REFERENCE;
   } /* end if */
   
-  this_scope = symtab->current;
-  
-  while (this_scope != NULL) {
-    prev_scope = this_scope->previous;
-    remove_scope(symtab, this_scope);
-    this_scope = prev_scope;
-  } /* end while */
+  /* all scopes and symbols live in the arena, imports are not owned */
+  arena_dispose(symtab);
+  m2c_mem_free(M2C_MEM_SYMTAB, symtab->import);
   
   symtab->current = NULL;
-  free(symtab);
+  m2c_mem_free(M2C_MEM_SYMTAB, symtab);
   
   return M2C_SYMTAB_STATUS_SUCCESS;
 } /* end m2c_release_symtab */
@@ -481,115 +709,275 @@ m2c_symtab_status_t m2c_release_symtab (m2c_symtab_t symtab) {
  * *********************************************************************** */
 
 /* --------------------------------------------------------------------------
- * private function key_for_cstr(cstr)
+ * private function scope_lookup(scope, ident, key)
  * --------------------------------------------------------------------------
- * Returns hash key for a given NUL terminated C string.
+ * Searches ident in scope and returns matching symbol or NULL if not found.
+ * A small scope is searched linearly,  a hashed scope is probed from the
+ * slot given by key up to the first free slot.
  * ----------------------------------------------------------------------- */
 
-static m2c_hash_t key_for_cstr (const char *cstr) {
+static m2c_symbol_t scope_lookup
+  (m2c_symtab_scope_t scope, intstr_t ident, m2c_hash_t key) {
+  
+  uint_t index, mask;
+  m2c_symbol_t this_symbol;
+  
+  if (NOT(scope->hashed)) {
+    index = 0;
+    while (index < scope->count) {
+      if (scope->slot[index].ident == ident) {
+        return &(scope->slot[index]);
+      } /* end if */
+      index++;
+    } /* end while */
+    
+    return NULL;
+  } /* end if */
+  
+  mask = scope->slot_count - 1;
+  index = key & mask;
+  this_symbol = &(scope->slot[index]);
+  
+  while (this_symbol->ident != NULL) {
+    if ((this_symbol->key == key) && (this_symbol->ident == ident)) {
+      return this_symbol;
+    } /* end if */
+    
+    index = (index + 1) & mask;
+    this_symbol = &(scope->slot[index]);
+  } /* end while */
+  
+  return NULL;
+} /* end scope_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * private function scope_may_contain(scope, key)
+ * --------------------------------------------------------------------------
+ * Returns false if the Bloom filter of scope proves that it holds no symbol
+ * with key,  otherwise true.
+ * ----------------------------------------------------------------------- */
+
+static bool scope_may_contain (m2c_symtab_scope_t scope, m2c_hash_t key) {
+  
+  return bloom_may_contain
+    (scope->bloom, SYMTAB_BLOOM_BITS(scope->slot_count), key);
+} /* end scope_may_contain */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_imports(symtab, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Looks up ident in the imports of symtab in the order they were added and
+ * passes back the attributes of the first match.  Returns status code
+ * M2C_SYMTAB_STATUS_IDENT_NOT_FOUND if no import holds ident.
+ * ----------------------------------------------------------------------- */
+
+static m2c_symtab_status_t lookup_imports
+  (m2c_symtab_t symtab, intstr_t ident, m2c_sym_attr_t *attributes) {
   
-  m2c_hash_t key;
   uint_t index;
-  char ch;
+  m2c_symtab_status_t status;
   
   index = 0;
-  ch = cstr[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
+  while (index < symtab->import_count) {
+    status = symtab->import[index].lookup
+      (symtab->import[index].import, ident, attributes);
+    
+    if (status != M2C_SYMTAB_STATUS_IDENT_NOT_FOUND) {
+      return status;
+    } /* end if */
+    
     index++;
-    ch = cstr[index];
   } /* end while */
   
-  return HASH_FINAL(key);
-} /* end key_for_cstr */
+  return M2C_SYMTAB_STATUS_IDENT_NOT_FOUND;
+} /* end lookup_imports */
 
 
 /* --------------------------------------------------------------------------
- * private function scope_lookup(scope, ident)
+ * private function free_slot(scope, key)
  * --------------------------------------------------------------------------
- * Searches ident in scope and returns matching symbol or NULL if not found.
+ * Returns the slot a new symbol with key is to be stored in,  the next slot
+ * in a small scope,  the first free slot probed from key in a hashed scope.
+ * There must be room for another symbol.
  * ----------------------------------------------------------------------- */
 
-static m2c_symbol_t scope_lookup
-  (m2c_symtab_scope_t scope, const char *ident, m2c_hash_t key) {
+static m2c_symbol_t free_slot (m2c_symtab_scope_t scope, m2c_hash_t key) {
   
-  uint_t index;
-  m2c_symbol_t this_symbol;
-    
-  /* determine bucket index */
-  index = key % scope->bucket_count;
+  uint_t index, mask;
+  
+  if (NOT(scope->hashed)) {
+    return &(scope->slot[scope->count]);
+  } /* end if */
   
-  this_symbol = scope->bucket[index];
+  mask = scope->slot_count - 1;
+  index = key & mask;
   
-  while ((this_symbol != NULL) && (this_symbol->ident != ident)) {
-    this_symbol = this_symbol->next;
+  while (scope->slot[index].ident != NULL) {
+    index = (index + 1) & mask;
   } /* end while */
   
-  return this_symbol;
-} /* end scope_lookup */
+  return &(scope->slot[index]);
+} /* end free_slot */
 
 
 /* --------------------------------------------------------------------------
- * private function new_symbol(ident, kind, type_id, defn)
+ * private function rehash_scope(symtab, scope, slot_count)
  * --------------------------------------------------------------------------
- * Returns a newly allocated symbol, initialised with parameters ident, kind,
- * type_id and defn.  Returns NULL if allocation fails.
+ * Moves the symbols of scope into a new hashed slot array with slot_count
+ * slots,  which must be a power of two,  allocated from the arena of symtab,
+ * and rebuilds its Bloom filter to match.  Keys are stored in the symbols
+ * and not recomputed.  The old slot array and filter are reclaimed when
+ * scope is closed.  Returns false if allocation failed,
+ * leaving scope as it was,  otherwise true.
  * ----------------------------------------------------------------------- */
 
-static m2c_symbol_t new_symbol
-  (const char *ident,
-   m2c_symtype_t kind,
-   const char *type_id,
-   m2c_astnode_t defn) {
+static bool rehash_scope
+  (m2c_symtab_t symtab, m2c_symtab_scope_t scope, uint_t slot_count) {
   
-  m2c_symbol_t new_sym;
+  m2c_symbol_s *old_slot;
+  uint32_t *old_bloom;
+  uint_t index, old_slot_count, old_count;
   
-  new_sym = malloc(sizeof(m2c_symbol_s));
+  old_slot = scope->slot;
+  old_bloom = scope->bloom;
+  old_slot_count = scope->slot_count;
+  old_count = scope->count;
   
-  if (new_sym == NULL) {
-    return NULL;
+  scope->slot = arena_alloc(symtab, slot_count * sizeof(m2c_symbol_s));
+  scope->bloom = arena_alloc(symtab, SYMTAB_BLOOM_SIZE(slot_count));
+  
+  if ((scope->slot == NULL) || (scope->bloom == NULL)) {
+    scope->slot = old_slot;
+    scope->bloom = old_bloom;
+    return false;
   } /* end if */
   
-  new_sym->next = NULL;
-  new_sym->ident = ident;
-  new_sym->kind = kind;
-  new_sym->type_id = type_id;
-  new_sym->definition = defn;
+  memset(scope->slot, 0, slot_count * sizeof(m2c_symbol_s));
+  memset(scope->bloom, 0, SYMTAB_BLOOM_SIZE(slot_count));
+  
+  scope->slot_count = slot_count;
+  scope->hashed = true;
   
-  return new_sym;
-} /* end new_symbol */
+  /* a small scope holds its symbols in its first count slots */
+  for (index = 0; index < old_slot_count; index++) {
+    if (old_slot[index].ident != NULL) {
+      *free_slot(scope, old_slot[index].key) = old_slot[index];
+      bloom_add(scope->bloom,
+        SYMTAB_BLOOM_BITS(slot_count), old_slot[index].key);
+    } /* end if */
+  } /* end for */
+  
+  scope->count = old_count;
+  
+  return true;
+} /* end rehash_scope */
 
 
 /* --------------------------------------------------------------------------
- * private function remove_scope(symtab, scope)
+ * private function arena_alloc(symtab, size)
  * --------------------------------------------------------------------------
- * Deallocates a given scope.  Updates counters of symtab.
+ * Allocates size bytes from the top of the scope arena of symtab and returns
+ * a pointer to them.  Starts a new block,  reusing a spare one if possible,
+ * when the current block is exhausted.  Returns NULL if allocation failed.
  * ----------------------------------------------------------------------- */
 
-static void remove_scope (m2c_symtab_t symtab, m2c_symtab_scope_t scope) {
+static void *arena_alloc (m2c_symtab_t symtab, size_t size) {
   
-  uint_t index;
-  m2c_symbol_t this_symbol, next_symbol;
+  m2c_symtab_block_t block;
+  size_t block_size;
+  void *ptr;
   
-  for (index = 0; index < scope->bucket_count; index++) {
-    /* get first symbol slot in bucket */
-    this_symbol = scope->bucket[index];
+  size = SYMTAB_ROUND_UP(size);
+  block = symtab->block;
+  
+  /* push a new block if there is none or the current one is exhausted */
+  if ((block == NULL) || (block->used + size > block->size)) {
     
-    /* remove all entries in bucket */
-    while (this_symbol != NULL) {
-      next_symbol = this_symbol->next;
-      free(this_symbol);
-      symtab->symbol_count--;
-      this_symbol = next_symbol;
-    } /* end while */
+    if ((symtab->spare != NULL) && (size <= symtab->spare->size)) {
+      block = symtab->spare;
+      symtab->spare = block->prev;
+    }
+    else {
+      if (size > M2C_SYMTAB_ARENA_BLOCK_SIZE) {
+        block_size = size;
+      }
+      else {
+        block_size = M2C_SYMTAB_ARENA_BLOCK_SIZE;
+      } /* end if */
+      
+      block = m2c_mem_alloc(M2C_MEM_SYMTAB,
+        sizeof(m2c_symtab_block_s) + block_size);
+      
+      if (block == NULL) {
+        return NULL;
+      } /* end if */
+      
+      block->size = block_size;
+    } /* end if */
     
-    /* clear first symbol slot */
-    scope->bucket[index] = NULL;
-  } /* end for */
+    block->used = 0;
+    block->prev = symtab->block;
+    symtab->block = block;
+  } /* end if */
   
-  free(scope);
-  symtab->scope_count--;
-} /* end remove_scope */
+  ptr = &block->storage[block->used];
+  block->used = block->used + size;
+  
+  return ptr;
+} /* end arena_alloc */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure arena_rollback(symtab, mark_block, mark_used)
+ * --------------------------------------------------------------------------
+ * Rolls the scope arena of symtab back to the mark given by mark_block and
+ * mark_used,  releasing everything allocated since.  Blocks above the mark
+ * of default size are kept as spares,  oversized blocks are deallocated.
+ * ----------------------------------------------------------------------- */
+
+static void arena_rollback
+  (m2c_symtab_t symtab, m2c_symtab_block_t mark_block, size_t mark_used) {
+  
+  m2c_symtab_block_t block;
+  
+  while (symtab->block != mark_block) {
+    block = symtab->block;
+    symtab->block = block->prev;
+    
+    if (block->size > M2C_SYMTAB_ARENA_BLOCK_SIZE) {
+      m2c_mem_free(M2C_MEM_SYMTAB, block);
+    }
+    else {
+      block->prev = symtab->spare;
+      symtab->spare = block;
+    } /* end if */
+  } /* end while */
+  
+  if (mark_block != NULL) {
+    mark_block->used = mark_used;
+  } /* end if */
+} /* end arena_rollback */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure arena_dispose(symtab)
+ * --------------------------------------------------------------------------
+ * Deallocates all blocks and spare blocks of the scope arena of symtab.
+ * ----------------------------------------------------------------------- */
+
+static void arena_dispose (m2c_symtab_t symtab) {
+  
+  m2c_symtab_block_t block;
+  
+  arena_rollback(symtab, NULL, 0);
+  
+  while (symtab->spare != NULL) {
+    block = symtab->spare;
+    symtab->spare = block->prev;
+    m2c_mem_free(M2C_MEM_SYMTAB, block);
+  } /* end while */
+} /* end arena_dispose */
 
 /* END OF FILE */
\ No newline at end of file
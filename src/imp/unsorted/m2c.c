@@ -38,12 +38,24 @@
   * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "fileutils.h"
+#include "cstring.h"
 #include "m2-lexer.h"
 #include "m2-error.h"
 #include "m2-parser.h"
+#include "m2c-const-fold.h"
+#include "m2c-ast-writer.h"
+#include "m2c-exl-writer.h"
+#include "m2c-exl-table.h"
+#include "m2c-compile-cache.h"
 #include "m2-pathnames.h"
 #include "m2-unique-string.h"
 #include "m2-compiler-options.h"
+#include "m2c-cli-lexer.h"
+#include "m2c-cli-parser.h"
+#include "m2c-statistics.h"
+#include "m2c-trace.h"
+#include "m2c-mem-account.h"
+#include "interned-strings.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -82,7 +94,8 @@ static void print_license(void) {
 
 static void print_usage(void) {
   printf("usage:\n");
-  printf(" m2c sourcefile [options]\n");
+  printf(" m2c sourcefile ... [options]\n");
+  printf(" m2c @responsefile ... [options]\n");
 } /* end print_usage */
 
 
@@ -109,163 +122,461 @@ static void exit_with_version(void) {
 } /* end exit_with_version */
 
 
-int main (int argc, char *argv[]) {
-  /* path of working directory */
-  const char *workdir = NULL;
+/* ---------------------------------------------------------------------------
+ * type batch_totals_t
+ * ---------------------------------------------------------------------------
+ * Warnings, errors and lines summed over all source files of an invocation.
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+  /* files */  uint_t files;
+  /* failed */  uint_t failed;
+  /* warnings */  uint_t warnings;
+  /* errors */  uint_t errors;
+  /* lines */  uint_t lines;
+} batch_totals_t;
+
+
+/* ---------------------------------------------------------------------------
+ * function check_exl_table(tablepath)
+ * ---------------------------------------------------------------------------
+ * Opens the binary export list table at tablepath  and prints its exporter
+ * and identifier count.  Returns true if the table could be opened and its
+ * header is valid.
+ * ------------------------------------------------------------------------ */
+
+static bool check_exl_table (const char *tablepath) {
+  
+  m2c_exl_table_t table;
+  m2c_exl_table_status_t status;
   
-  /* full path to source file */
-  const char *srcpath = NULL;
+  table = m2c_exl_table_open(tablepath, &status);
+  
+  if (table == NULL) {
+    printf("invalid export list table %s\n", tablepath);
+    return false;
+  } /* end if */
+  
+  printf("export list table %s: %u identifiers exported by %s\n",
+    tablepath, m2c_exl_table_count(table), m2c_exl_table_exporter(table));
+  
+  m2c_exl_table_close(&table);
+  
+  return true;
+} /* end check_exl_table */
+
+
+/* ---------------------------------------------------------------------------
+ * function compile_source_file(srcpath, workdir, totals)
+ * ---------------------------------------------------------------------------
+ * Compiles the source file at srcpath, writes its products to workdir and
+ * adds its figures to totals.  Returns true if it compiled without errors.
+ * Invalid or missing source files are reported and count as failed,  the
+ * remaining files of the batch are still compiled.
+ * ------------------------------------------------------------------------ */
 
-  /* directory path of srcpath */
-  const char *dirpath = NULL;
+static bool compile_source_file
+  (const char *srcpath, const char *workdir, batch_totals_t *totals) {
   
-  /* filename of srcpath */
+  /* filename of srcpath, its tail */
   const char *filename = NULL;
   
   /* source file's base name excluding suffix */
   const char *basename = NULL;
   
-  /* source file's suffix */
+  /* source file's suffix, the tail of filename */
   const char *suffix = NULL;
   
-  /* path to log file */
-  const char *logpath = NULL;
-  
   /* path to AST output file */
   const char *astpath = NULL;
   
   /* path to DOT output file */
   const char *dotpath = NULL;
   
-  /* path to SYM output file */
-  const char *sympath = NULL;
+  /* path to export list file */
+  const char *exlpath = NULL;
+  
+  /* path to binary export list table */
+  const char *tablepath = NULL;
   
-  /* path to C output file */
-  const char *tgtpath = NULL;
+  /* path to telemetry file */
+  const char *telpath = NULL;
   
   uint_t index;
+  bool passed, cacheable;
+  m2c_ast_t ast;
   m2c_stats_t stats;
-  m2c_option_status_t cli_status;
+  m2c_const_fold_t folder;
+  m2c_sourcetype_t srctype;
   m2c_parser_status_t parser_status;
+  m2c_exl_writer_status_t exl_status;
+  m2c_cache_status_t cache_status;
+  m2c_cache_key_t cache_key;
+  const char *output_path[M2C_CACHE_OUTPUT_END_MARK];
   m2c_pathname_status_t pathname_status;
+  m2c_pathname_view_t fnview, baseview, suffixview;
+  intstr_stats_t intstr_figures;
   
-  if (argc < 2) {
-    exit_with_usage();
-  } /* end if */
-  
-  /* get command line arguments and filename */
-  srcpath = m2c_get_cli_args(argc, argv, &cli_status);
-  
-  /* check for failure, help or version request */
-  if (cli_status == M2C_OPTION_STATUS_FAILURE) {
-    exit_with_usage();
-  }
-  else if (cli_status == M2C_OPTION_STATUS_HELP_REQUESTED) {
-    exit_with_help();
-  }
-  else if (cli_status == M2C_OPTION_STATUS_VERSION_REQUESTED) {
-    exit_with_version();
-  } /* end if */
+  totals->files++;
   
   /* check source path validity */
   if ((srcpath == NULL) || (srcpath[0] == ASCII_NUL)) {
     m2c_emit_error(M2C_ERROR_MISSING_FILENAME);
-    exit(EXIT_FAILURE);
+    totals->failed++;
+    return false;
   } /* end if */
   
-  /* get directory path and filename */
-  pathname_status = split_pathname(srcpath, &dirpath, &filename, &index);
+  /* get filename within srcpath */
+  pathname_status = split_pathname_view(srcpath, NULL, &fnview, &index);
     
-  if (pathname_status == M2C_PATHNAME_STATUS_INVALID_PATH) {
+  if ((pathname_status == M2C_PATHNAME_STATUS_INVALID_PATH) ||
+      (fnview.length == 0)) {
     m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
-    exit(EXIT_FAILURE);
+    totals->failed++;
+    return false;
   } /* end if */
   
-  if ((filename == NULL) || (filename[0] == ASCII_NUL)) {
-    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, srcpath);
-    exit(EXIT_FAILURE);
-  } /* end if */
+  filename = srcpath + fnview.offset;
   
-  /* get basename and suffix */
-  pathname_status = split_filename(filename, &basename, &suffix, &index);
+  /* get basename and suffix within filename */
+  pathname_status =
+    split_filename_view(filename, &baseview, &suffixview, &index);
   
-  if (pathname_status == M2C_PATHNAME_STATUS_INVALID_FILENAME) {
+  if ((pathname_status == M2C_PATHNAME_STATUS_INVALID_FILENAME) ||
+      (baseview.length == 0)) {
     m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, filename);
-    exit(EXIT_FAILURE);
+    totals->failed++;
+    return false;
   } /* end if */
   
-  if ((basename == NULL) || (basename[0] == ASCII_NUL)) {
-    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME, filename);
-    exit(EXIT_FAILURE);
+  if (suffixview.length != 0) {
+    suffix = filename + suffixview.offset;
   } /* end if */
-    
+  
   /* check suffix validity */
-  if (suffix == NULL) {
-    m2c_emit_error(M2C_ERROR_INVALID_FILENAME_SUFFIX);
-    exit(EXIT_FAILURE);
-  }
-  else if (is_def_suffix(suffix)) {
+  if ((suffix != NULL) && (is_def_suffix(suffix))) {
     srctype = M2C_DEF_SOURCE;
   }
-  else if (is_mod_suffix(suffix)) {
+  else if ((suffix != NULL) && (is_mod_suffix(suffix))) {
     srctype = M2C_MOD_SOURCE;
   }
-  else /* invalid suffix */ {
-    m2c_emit_error(M2C_ERROR_INVALID_FILENAME_SUFFIX);
-    exit(EXIT_FAILURE);
+  else /* missing or invalid suffix */ {
+    m2c_emit_error_w_str(M2C_ERROR_INVALID_FILENAME_SUFFIX, filename);
+    totals->failed++;
+    return false;
   } /* end if */
     
   /* check source file availability */
   if (NOT(file_exists(srcpath))) {
-    m2c_emit_error_w_str(M2C_ERROR_INPUT_FILE_NOT_FOUND, path);
-    exit(EXIT_FAILURE);
+    m2c_emit_error_w_str(M2C_ERROR_INPUT_FILE_NOT_FOUND, srcpath);
+    totals->failed++;
+    return false;
   } /* end if */
-    
-  /* get working directory */
-  workdir = new_path_w_current_working_directory();
   
-  if (workdir == NULL) {
-    printf("unable to get current working directory.\n");
-    exit(EXIT_FAILURE);
+  /* only the basename is needed as a string of its own, for output paths */
+  basename = new_cstr_from_slice(filename, 0, baseview.length);
+  
+  printf("processing %s\n", srcpath);
+  
+  if ((srctype == M2C_MOD_SOURCE) && (m2c_compiler_option_lazy_bodies())) {
+    printf("statement bodies skipped, interfaces only\n");
   } /* end if */
   
-  /* initialise string repo */
-  m2c_init_string_repository(0, NULL);
+  /* export list and table are products of definition modules */
+  for (index = 0; index < M2C_CACHE_OUTPUT_END_MARK; index++) {
+    output_path[index] = NULL;
+  } /* end for */
   
-  /* print banner */
-  print_identification();
+  if (srctype == M2C_DEF_SOURCE) {
+    exlpath = new_path_w_components(workdir, basename, ".exl");
+    output_path[M2C_CACHE_OUTPUT_EXPORT_LIST] = exlpath;
+    
+    if (m2c_compiler_option_binary_exl()) {
+      tablepath = new_cstr_by_concat(exlpath, M2C_EXL_TABLE_SUFFIX, NULL);
+      output_path[M2C_CACHE_OUTPUT_EXPORT_TABLE] = tablepath;
+    } /* end if */
+  } /* end if */
   
-  if (m2c_option_parser_debug()) {
-    m2c_print_options();
+  /* the cache holds export lists, other products need a compile */
+  cacheable = (m2c_compiler_option_compile_cache()) &&
+    (srctype == M2C_DEF_SOURCE) &&
+    (NOT(m2c_compiler_option_ast_required())) &&
+    (NOT(m2c_compiler_option_graph_required()));
+  
+  /* restore the export list from the cache if option --cache is on,
+   * it depends on the source only, not on the interfaces it imports */
+  if (cacheable) {
+    m2c_cache_module_key(srcpath, m2c_compiler_options_snapshot(),
+      0, NULL, NULL, &cache_key, &cache_status);
+    
+    cacheable = (cache_status == M2C_CACHE_STATUS_SUCCESS);
+    
+    if ((cacheable) &&
+        (m2c_cache_fetch(m2c_cache_dir(), &cache_key, output_path, NULL))) {
+      printf("restored export list %s from cache\n", exlpath);
+      
+      free((void *) basename);
+      free((void *) exlpath);
+      free((void *) tablepath);
+      return true;
+    } /* end if */
   } /* end if */
   
-  printf("processing %s\n", srcpath);
+  m2c_trace_begin("module", basename);
   
   /* run parser on input */
   m2c_parse_file(srctype, srcpath, &ast, &stats, &parser_status);
   
+  /* fold constant expressions, each constant definition is folded once */
+  if (ast != NULL) {
+    m2c_stats_begin_phase(stats, M2C_STATS_PHASE_ANALYSIS);
+    
+    folder = m2c_new_const_folder();
+    
+    if (folder != NULL) {
+      m2c_fold_constants(folder, ast);
+      m2c_release_const_folder(folder);
+    } /* end if */
+    
+    m2c_stats_end_phase(stats, M2C_STATS_PHASE_ANALYSIS);
+  } /* end if */
+  
   /* write AST to file */
   if (ast != NULL) {
-    /* write AST in S-expression format */
-    astpath = new_path_w_components(workdir, basename, ".ast", NULL);
-    printf("writing AST to %s\n", astpath);
-    m2c_ast_write_tree(astpath, ast);
+    m2c_stats_begin_phase(stats, M2C_STATS_PHASE_OUTPUT);
+    
+    /* write AST in S-expression format if option --ast is on */
+    if (m2c_compiler_option_ast_required()) {
+      astpath = new_path_w_components(workdir, basename, ".ast", NULL);
+      printf("writing AST to %s\n", astpath);
+      
+      if (NOT(m2c_ast_write_tree(astpath, ast))) {
+        printf("failed to write AST to %s\n", astpath);
+      } /* end if */
+    } /* end if */
     
-    /* write AST in graphviz DOT format */
-    dotpath = new_path_w_components(workdir, basename, ".dot", NULL);
-    printf("writing AST graph to %s\n", dotpath);
-    m2c_ast_draw_tree(dotpath, ast);
+    /* write AST in graphviz DOT format if option --graph is on */
+    if (m2c_compiler_option_graph_required()) {
+      dotpath = new_path_w_components(workdir, basename, ".dot", NULL);
+      printf("writing AST graph to %s\n", dotpath);
+      
+      if (NOT(m2c_ast_draw_tree(dotpath, ast))) {
+        printf("failed to write AST graph to %s\n", dotpath);
+      } /* end if */
+    } /* end if */
+    
+    m2c_stats_end_phase(stats, M2C_STATS_PHASE_OUTPUT);
+  } /* end if */
+  
+  /* write export list of a definition module, with its table if --exlb */
+  if ((srctype == M2C_DEF_SOURCE) && (m2c_stats_errors(stats) == 0)) {
+    m2c_stats_begin_phase(stats, M2C_STATS_PHASE_OUTPUT);
+    
+    printf("writing export list to %s\n", exlpath);
+    
+    m2c_write_exl_for_def
+      (srcpath, exlpath, m2c_compiler_options_snapshot(), &exl_status);
+    
+    if (exl_status != M2C_EXL_WRITER_STATUS_SUCCESS) {
+      printf("failed to write export list to %s\n", exlpath);
+    }
+    else if (((tablepath == NULL) || (check_exl_table(tablepath))) &&
+             (cacheable)) {
+      m2c_cache_store
+        (m2c_cache_dir(), &cache_key, output_path, &cache_status);
+      
+      if (cache_status != M2C_CACHE_STATUS_SUCCESS) {
+        printf("unable to store export list %s in cache\n", exlpath);
+      } /* end if */
+    } /* end if */
+    
+    m2c_stats_end_phase(stats, M2C_STATS_PHASE_OUTPUT);
   } /* end if */
   
   /* TO DO: semantic analysis and final code generation */
   
+  m2c_trace_end("module");
+  
+  /* print phase times if option --time-report or --perf-counters is on */
+  if ((m2c_compiler_option_time_report()) ||
+      (m2c_compiler_option_perf_counters())) {
+    m2c_stats_print_time_report(stats, srcpath);
+    
+    if ((m2c_compiler_option_perf_counters()) &&
+        (NOT(m2c_stats_has_perf_counters(stats)))) {
+      printf("hardware performance counters not available\n");
+    } /* end if */
+  } /* end if */
+  
+  /* append telemetry record if option --telemetry is on */
+  if (m2c_compiler_option_telemetry()) {
+    intstr_stats(&intstr_figures);
+    m2c_stats_set(stats, M2C_STATS_INTERN_COUNT, intstr_figures.entry_count);
+    m2c_stats_set(stats,
+      M2C_STATS_INTERN_HIT_COUNT, intstr_figures.lookup_hits);
+    
+    telpath = new_cstr_by_concat(workdir, "/", M2C_STATS_TELEMETRY_FILE, NULL);
+    
+    if (NOT(m2c_stats_write_telemetry(stats, telpath, basename, srcpath))) {
+      printf("unable to write telemetry to %s\n", telpath);
+    } /* end if */
+  } /* end if */
+  
   /* print statistics */
   printf("warnings: %u\n", m2c_stats_warnings(stats));
   printf("errors: %u\n", m2c_stats_errors(stats));
   printf("lines: %u\n", m2c_stats_lines(stats));
   
+  totals->warnings = totals->warnings + m2c_stats_warnings(stats);
+  totals->errors = totals->errors + m2c_stats_errors(stats);
+  totals->lines = totals->lines + m2c_stats_lines(stats);
+  
+  passed = (m2c_stats_errors(stats) == 0);
+  
+  if (NOT(passed)) {
+    totals->failed++;
+  } /* end if */
+  
+  /* release per-file resources, the batch may hold many files */
+  m2c_stats_release(stats);
+  free((void *) basename);
+  free((void *) astpath);
+  free((void *) dotpath);
+  free((void *) exlpath);
+  free((void *) tablepath);
+  free((void *) telpath);
+  
+  return passed;
+} /* end compile_source_file */
+
+
+/* ---------------------------------------------------------------------------
+ * main program
+ * ---------------------------------------------------------------------------
+ * Parses the command line once,  initialises all tables once and then
+ * compiles each source file given on the command line or in a response file.
+ * ------------------------------------------------------------------------ */
+
+int main (int argc, char *argv[]) {
+  /* path of working directory */
+  const char *workdir = NULL;
+  
+  uint_t index, file_count;
+  batch_totals_t totals = { 0, 0, 0, 0, 0 };
+  cli_parser_status_t cli_status;
+  m2c_trace_status_t trace_status;
+  intstr_status_t intstr_status;
+  
+  if (argc < 2) {
+    exit_with_usage();
+  } /* end if */
+  
+  /* get command line arguments and source files */
+  cli_init(argc, argv);
+  cli_status = cli_parse_args();
+  
+  /* check for failure, help or version request */
+  if (cli_status == CLI_PARSER_STATUS_ERRORS_ENCOUNTERED) {
+    exit_with_usage();
+  }
+  else if (cli_status == CLI_PARSER_STATUS_HELP_REQUESTED) {
+    exit_with_help();
+  }
+  else if (cli_status == CLI_PARSER_STATUS_VERSION_REQUESTED) {
+    exit_with_version();
+  }
+  else if (cli_status == CLI_PARSER_STATUS_LICENSE_REQUESTED) {
+    print_license();
+    exit(EXIT_SUCCESS);
+  } /* end if */
+  
+  file_count = cli_source_file_count();
+  
+  if (file_count == 0) {
+    m2c_emit_error(M2C_ERROR_MISSING_FILENAME);
+    exit(EXIT_FAILURE);
+  } /* end if */
+  
+  /* get working directory */
+  workdir = new_path_w_current_working_directory();
+  
+  if (workdir == NULL) {
+    printf("unable to get current working directory.\n");
+    exit(EXIT_FAILURE);
+  } /* end if */
+  
+  /* initialise string repo, shared by all files of the batch,
+   * in arena mode mapping the worker cache if m2make passed one */
+  if (m2c_compiler_option_worker_cache() != NULL) {
+    intstr_init_arena_repo(0, 0, &intstr_status);
+    
+    if (intstr_status == INTSTR_STATUS_SUCCESS) {
+      intstr_map_snapshot(m2c_compiler_option_worker_cache(), &intstr_status);
+      
+      if (intstr_status != INTSTR_STATUS_SUCCESS) {
+        printf("unable to map worker cache %s\n",
+          m2c_compiler_option_worker_cache());
+      } /* end if */
+    } /* end if */
+  }
+  else {
+    m2c_init_string_repository(0, NULL);
+  } /* end if */
+  
+  /* print banner */
+  print_identification();
+  
+  if (m2c_option_parser_debug()) {
+    m2c_print_options();
+  } /* end if */
+  
+  /* skip statement bodies if no product of the batch depends on them */
+  if ((NOT(m2c_compiler_option_xlat_required())) &&
+      (NOT(m2c_compiler_option_obj_required())) &&
+      (NOT(m2c_compiler_option_ast_required())) &&
+      (NOT(m2c_compiler_option_graph_required()))) {
+    m2c_parser_set_lazy_bodies(true);
+  } /* end if */
+  
+  /* open trace event file if option --trace is given */
+  if (m2c_compiler_option_trace_path() != NULL) {
+    m2c_trace_open(m2c_compiler_option_trace_path(), &trace_status);
+    
+    if (trace_status != M2C_TRACE_STATUS_SUCCESS) {
+      printf("unable to write trace to %s\n",
+        m2c_compiler_option_trace_path());
+    } /* end if */
+  } /* end if */
+  
+  /* compile each source file in order */
+  for (index = 0; index < file_count; index++) {
+    compile_source_file(cli_source_file_at(index), workdir, &totals);
+  } /* end for */
+  
+  if (m2c_trace_enabled()) {
+    m2c_trace_close(NULL);
+  } /* end if */
+  
+  /* print memory usage if option --mem-report is on */
+  if (m2c_compiler_option_mem_report()) {
+    m2c_mem_print_report(stdout);
+  } /* end if */
+  
+  /* print string repository statistics if option --intstr-stats is on */
+  if (m2c_compiler_option_intstr_stats()) {
+    intstr_print_stats(stdout);
+  } /* end if */
+  
+  /* print batch totals if more than one file was given */
+  if (file_count > 1) {
+    printf("files: %u, failed: %u\n", totals.files, totals.failed);
+    printf("total warnings: %u\n", totals.warnings);
+    printf("total errors: %u\n", totals.errors);
+    printf("total lines: %u\n", totals.lines);
+  } /* end if */
+  
   /* pass status code to caller */
-  if (m2c_stats_errors(stats) == 0) {
+  if (totals.failed == 0) {
     return EXIT_SUCCESS;
   }
   else /* errors occurred */ {
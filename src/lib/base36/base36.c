@@ -37,47 +37,43 @@
  * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-#ifndef BASE36_H
-#define BASE36_H
-
 #include "base36.h"
 
-#include <bool.h>
-
 
 /* --------------------------------------------------------------------------
- * Powers of 36 table
+ * Verify BASE36_MAX_DIGITS
  * ----------------------------------------------------------------------- */
 
-static uint32_t pow36_table[BASE36_MAX_DIGITS];
+#if (BASE36_MAX_DIGITS < 1) || (BASE36_MAX_DIGITS > 6)
+#error "the value of BASE36_MAX_DIGITS must be within range 1 to 6"
+#endif
 
 
 /* --------------------------------------------------------------------------
- * private procedure init_base36_table()
- * --------------------------------------------------------------------------
- * Initialises the powers of 36 table.
+ * Powers of 36 table
  * ----------------------------------------------------------------------- */
 
-static bool initialized = false;
+static const uint32_t pow36_table[] = {
+  1, 36, 1296, 46656, 1679616, 60466176, 2176782336u
+}; /* end pow36_table */
 
-static void init_base36_table(void) {
 
-  uint32_t n, value;
-  
-  if (initialized == true) {
-    return;
-  } /* end if */
+/* --------------------------------------------------------------------------
+ * Digit table
+ * ----------------------------------------------------------------------- */
 
-  value = 1;
-  for (n = 0; n < BASE36_MAX_DIGITS; n++) {
-    pow36_table[n] = value;
-    value = value * 36;
-  } /* init_base36_powers */
+static const char digit_table[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
-  initialized = true;
 
-  return;
-} /* init_base36_table */
+/* --------------------------------------------------------------------------
+ * Division by 36
+ * --------------------------------------------------------------------------
+ * Calculates _value / 36 by multiplication with the reciprocal of 36 scaled
+ * by 2^35.  The result is exact for all 32-bit unsigned values.
+ * ----------------------------------------------------------------------- */
+
+#define DIV36(_value) \
+  ((uint32_t) (((uint64_t) (_value) * 0x38E38E39u) >> 35))
 
 
 /* --------------------------------------------------------------------------
@@ -88,10 +84,6 @@ static void init_base36_table(void) {
 
 uint32_t pow32 (uint32_t n) {
   
-  if (initialized == false) {
-    init_base36_table();
-  } /* end if */
-
   if (n > BASE36_MAX_DIGITS) {
     return 0;
   }
@@ -109,24 +101,18 @@ uint32_t pow32 (uint32_t n) {
  * constant BASE36_MAX_DIGITS and whose leading digit is a decimal digit.
  * ----------------------------------------------------------------------- */
 
-#if (BASE36_MAX_DIGITS = 1)
+#if (BASE36_MAX_DIGITS == 1)
   #define BITMASK 0x7
-#elif (BASE36_MAX_DIGITS = 2)
+#elif (BASE36_MAX_DIGITS == 2)
   #define BITMASK 0xff
-#elif (BASE36_MAX_DIGITS = 3)
+#elif (BASE36_MAX_DIGITS == 3)
   #define BITMASK 0x1fff
-#elif (BASE36_MAX_DIGITS = 4)
+#elif (BASE36_MAX_DIGITS == 4)
   #define BITMASK 0x3ffff
-#elif (BASE36_MAX_DIGITS = 5)
+#elif (BASE36_MAX_DIGITS == 5)
   #define BITMASK 0xffffff
-#elif (BASE36_MAX_DIGITS = 6)
+#elif (BASE36_MAX_DIGITS == 6)
   #define BITMASK 0x1fffffff
-#elif (BASE36_MAX_DIGITS = 7)
-  #define BITMASK 0x3ffffffff
-#elif (BASE36_MAX_DIGITS = 8)
-  #define BITMASK 0xfffffffff
-#else
-  #error "the value of BASE36_MAX_DIGITS must be within range 1 to 8"
 #endif
 
 uint32_t truncate_for_n_base36_digits (uint32_t value) {
@@ -139,44 +125,36 @@ uint32_t truncate_for_n_base36_digits (uint32_t value) {
 /* --------------------------------------------------------------------------
  * procedure get_base36_str_for_uint(value, str)
  * --------------------------------------------------------------------------
- * Passes a string with the base-36 representation of value in str.
+ * Passes a string with the base-36 representation of value in str.  Digits
+ * are produced from least to most significant using the digit table and a
+ * multiplicative division,  no powers of 36 are computed.
  * ----------------------------------------------------------------------- */
 
 void get_base36_str_for_uint (uint32_t value, base36_str_t *str) {
-
-  if (initialized == false) {
-    init_base36_table();
-  } /* end if */
   
-  uint32_t n, weight, digit;
+  uint32_t quotient;
+  unsigned index;
   
   /* check for base-36 overflow */
-  if (value > BITMASK) {
-    str[0] = ASCII_NUL;
+  if (value >= pow36_table[BASE36_MAX_DIGITS]) {
+    (*str)[0] = '\0';
     return;
   } /* end if */
   
-  weight = pow36_table[BASE36_MAX_DIGITS];
-  n = BASE36_MAX_DIGITS;
-  for (n < BASE36_MAX_DIGITS) {
-    digit = value / weight;
-    if (digit <= 10) {
-      str[BASE36_MAX_DIGITS - n] = digit + 48;
-    }
-    else /* A .. Z */ {
-      str[BASE36_MAX_DIGITS - n] = digit + 55;
-    } /* end if */
-    value = value & weight;
-    weight = weight / 36;
-    n--;
-  } /* end for */
-  
   /* terminate string */
-  str[BASE36_MAX_DIGITS + 1] = ASCII_NUL;
+  (*str)[BASE36_MAX_DIGITS] = '\0';
+  
+  /* fill in digits from right to left */
+  index = BASE36_MAX_DIGITS;
+  while (index > 0) {
+    index--;
+    quotient = DIV36(value);
+    (*str)[index] = digit_table[value - (quotient * 36)];
+    value = quotient;
+  } /* end while */
+  
   return;
-}; /* end get_base36_hash_str_for_ident */
-
 } /* get_base36_str_for_uint */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -40,11 +40,19 @@
 #ifndef BASE36_H
 #define BASE36_H
 
+#include <stdint.h>
+
+
 /* --------------------------------------------------------------------------
- * Maximum number of digits in a base-36 string
+ * Number of digits in a base-36 string
+ * --------------------------------------------------------------------------
+ * Base-36 strings are always rendered with exactly this number of digits,
+ * padded with leading zeroes.  Must be within range 1 to 6.
  * ----------------------------------------------------------------------- */
 
+#ifndef BASE36_MAX_DIGITS
 #define BASE36_MAX_DIGITS 5
+#endif
 
 
 /* --------------------------------------------------------------------------
@@ -53,13 +61,14 @@
  * Character array type to hold base-36 representations of values.
  * ----------------------------------------------------------------------- */
 
-typedef base36_str_t char[BASE36_MAX_DIGITS + 1];
+typedef char base36_str_t[BASE36_MAX_DIGITS + 1];
 
 
 /* --------------------------------------------------------------------------
  * function pow32(n)
  * --------------------------------------------------------------------------
- * Returns the n-th power of 36.
+ * Returns the n-th power of 36  for n within range 0 to BASE36_MAX_DIGITS,
+ * otherwise zero.
  * ----------------------------------------------------------------------- */
 
 uint32_t pow32 (uint32_t n);
@@ -79,12 +88,15 @@ uint32_t truncate_for_n_base36_digits (uint32_t value);
 /* --------------------------------------------------------------------------
  * procedure get_base36_str_for_uint(value, str)
  * --------------------------------------------------------------------------
- * Passes a string with the base-36 representation of value in str.
+ * Passes a string with the base-36 representation of value in str.  The
+ * representation has exactly BASE36_MAX_DIGITS digits,  with digits 0 to 9
+ * followed by uppercase letters A to Z.  If value cannot be represented
+ * with BASE36_MAX_DIGITS digits,  an empty string is passed back.
  * ----------------------------------------------------------------------- */
 
 void get_base36_str_for_uint (uint32_t value, base36_str_t *str);
 
 
-#endif BASE36_H
+#endif /* BASE36_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,142 @@
+/* AUTO-GENERATED by utility gen-c-resword-hash * DO NOT EDIT! */
+
+#define C_RESWORD_ENTRY_COUNT 46
+#define C_RESWORD_MIN_LENGTH 2
+#define C_RESWORD_MAX_LENGTH 9
+#define C_RESWORD_FIRST_FACTOR 3u
+#define C_RESWORD_LAST_FACTOR 12u
+#define C_RESWORD_LENGTH_FACTOR 7u
+#define C_RESWORD_SLOT_BITS 7
+
+static const c_resword_entry_t c_resword_table[] = {
+  /*   0 */ { NULL, 0, false },
+  /*   1 */ { "double", 6, false },
+  /*   2 */ { NULL, 0, false },
+  /*   3 */ { NULL, 0, false },
+  /*   4 */ { NULL, 0, false },
+  /*   5 */ { "char", 4, false },
+  /*   6 */ { NULL, 0, false },
+  /*   7 */ { NULL, 0, false },
+  /*   8 */ { "alignof", 7, true },
+  /*   9 */ { NULL, 0, false },
+  /*  10 */ { NULL, 0, false },
+  /*  11 */ { NULL, 0, false },
+  /*  12 */ { "continue", 8, false },
+  /*  13 */ { "return", 6, false },
+  /*  14 */ { "for", 3, false },
+  /*  15 */ { "inline", 6, false },
+  /*  16 */ { NULL, 0, false },
+  /*  17 */ { NULL, 0, false },
+  /*  18 */ { NULL, 0, false },
+  /*  19 */ { "imaginary", 9, true },
+  /*  20 */ { NULL, 0, false },
+  /*  21 */ { NULL, 0, false },
+  /*  22 */ { NULL, 0, false },
+  /*  23 */ { NULL, 0, false },
+  /*  24 */ { "union", 5, false },
+  /*  25 */ { "noreturn", 8, true },
+  /*  26 */ { NULL, 0, false },
+  /*  27 */ { "static", 6, false },
+  /*  28 */ { "signed", 6, false },
+  /*  29 */ { "void", 4, false },
+  /*  30 */ { NULL, 0, false },
+  /*  31 */ { NULL, 0, false },
+  /*  32 */ { NULL, 0, false },
+  /*  33 */ { NULL, 0, false },
+  /*  34 */ { NULL, 0, false },
+  /*  35 */ { "long", 4, false },
+  /*  36 */ { "alignas", 7, true },
+  /*  37 */ { NULL, 0, false },
+  /*  38 */ { NULL, 0, false },
+  /*  39 */ { NULL, 0, false },
+  /*  40 */ { NULL, 0, false },
+  /*  41 */ { NULL, 0, false },
+  /*  42 */ { NULL, 0, false },
+  /*  43 */ { "const", 5, false },
+  /*  44 */ { "while", 5, false },
+  /*  45 */ { NULL, 0, false },
+  /*  46 */ { "int", 3, false },
+  /*  47 */ { NULL, 0, false },
+  /*  48 */ { NULL, 0, false },
+  /*  49 */ { "float", 5, false },
+  /*  50 */ { "default", 7, false },
+  /*  51 */ { "exit", 4, true },
+  /*  52 */ { "sizeof", 6, false },
+  /*  53 */ { "unsigned", 8, false },
+  /*  54 */ { NULL, 0, false },
+  /*  55 */ { NULL, 0, false },
+  /*  56 */ { NULL, 0, false },
+  /*  57 */ { NULL, 0, false },
+  /*  58 */ { NULL, 0, false },
+  /*  59 */ { NULL, 0, false },
+  /*  60 */ { NULL, 0, false },
+  /*  61 */ { NULL, 0, false },
+  /*  62 */ { NULL, 0, false },
+  /*  63 */ { "break", 5, false },
+  /*  64 */ { NULL, 0, false },
+  /*  65 */ { "bool", 4, true },
+  /*  66 */ { NULL, 0, false },
+  /*  67 */ { NULL, 0, false },
+  /*  68 */ { NULL, 0, false },
+  /*  69 */ { "volatile", 8, false },
+  /*  70 */ { NULL, 0, false },
+  /*  71 */ { NULL, 0, false },
+  /*  72 */ { NULL, 0, false },
+  /*  73 */ { NULL, 0, false },
+  /*  74 */ { NULL, 0, false },
+  /*  75 */ { "register", 8, false },
+  /*  76 */ { NULL, 0, false },
+  /*  77 */ { NULL, 0, false },
+  /*  78 */ { "typedef", 7, false },
+  /*  79 */ { NULL, 0, false },
+  /*  80 */ { NULL, 0, false },
+  /*  81 */ { NULL, 0, false },
+  /*  82 */ { NULL, 0, false },
+  /*  83 */ { NULL, 0, false },
+  /*  84 */ { "short", 5, false },
+  /*  85 */ { "enum", 4, false },
+  /*  86 */ { NULL, 0, false },
+  /*  87 */ { NULL, 0, false },
+  /*  88 */ { NULL, 0, false },
+  /*  89 */ { NULL, 0, false },
+  /*  90 */ { "switch", 6, false },
+  /*  91 */ { NULL, 0, false },
+  /*  92 */ { NULL, 0, false },
+  /*  93 */ { "do", 2, false },
+  /*  94 */ { NULL, 0, false },
+  /*  95 */ { NULL, 0, false },
+  /*  96 */ { NULL, 0, false },
+  /*  97 */ { NULL, 0, false },
+  /*  98 */ { "case", 4, false },
+  /*  99 */ { "restrict", 8, false },
+  /* 100 */ { NULL, 0, false },
+  /* 101 */ { NULL, 0, false },
+  /* 102 */ { NULL, 0, false },
+  /* 103 */ { "struct", 6, false },
+  /* 104 */ { "auto", 4, false },
+  /* 105 */ { "complex", 7, true },
+  /* 106 */ { NULL, 0, false },
+  /* 107 */ { "NULL", 4, true },
+  /* 108 */ { "main", 4, true },
+  /* 109 */ { NULL, 0, false },
+  /* 110 */ { NULL, 0, false },
+  /* 111 */ { NULL, 0, false },
+  /* 112 */ { NULL, 0, false },
+  /* 113 */ { NULL, 0, false },
+  /* 114 */ { "false", 5, true },
+  /* 115 */ { "else", 4, false },
+  /* 116 */ { "goto", 4, false },
+  /* 117 */ { NULL, 0, false },
+  /* 118 */ { "malloc", 6, true },
+  /* 119 */ { "if", 2, false },
+  /* 120 */ { NULL, 0, false },
+  /* 121 */ { "extern", 6, false },
+  /* 122 */ { NULL, 0, false },
+  /* 123 */ { NULL, 0, false },
+  /* 124 */ { "free", 4, true },
+  /* 125 */ { NULL, 0, false },
+  /* 126 */ { NULL, 0, false },
+  /* 127 */ { NULL, 0, false }
+}; /* c_resword_table */
+
+/* END OF FILE */
@@ -49,7 +49,9 @@
  * Otherwise, function is_c_reswords also tests for pseudo reserved words.
  * ----------------------------------------------------------------------- */
 
+#ifndef C_RESWORDS_INCLUDE_PSEUDO_RESWORDS
 #define C_RESWORDS_INCLUDE_PSEUDO_RESWORDS 1
+#endif
 
 
 /* --------------------------------------------------------------------------
@@ -46,6 +46,8 @@
 
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
 
 
 /* --------------------------------------------------------------------------
@@ -57,6 +59,27 @@
 #endif /* ASCII_NUL */
 
 
+/* --------------------------------------------------------------------------
+ * Machine words for scanning a word at a time
+ * --------------------------------------------------------------------------
+ * HAS_NUL_BYTE(w) is true if any byte of word w is zero.  Words are only
+ * loaded from word aligned addresses.  An aligned word never straddles a
+ * page boundary,  reading past a terminator within its word is thus safe.
+ * ----------------------------------------------------------------------- */
+
+typedef uintptr_t word_t;
+
+#define WORD_SIZE (sizeof(word_t))
+
+#define LOW_BITS ((word_t) -1 / 0xFF)
+
+#define HIGH_BITS (LOW_BITS * 0x80)
+
+#define HAS_NUL_BYTE(_w) ((((_w) - LOW_BITS) & ~(_w) & HIGH_BITS) != 0)
+
+#define IS_WORD_ALIGNED(_ptr) (((uintptr_t) (_ptr) & (WORD_SIZE - 1)) == 0)
+
+
 /* --------------------------------------------------------------------------
  * Sentinel values
  * ----------------------------------------------------------------------- */
@@ -167,6 +190,13 @@ static const short int dict_upper_rank[] = {
 }; /* end rank */
 
 
+/* --------------------------------------------------------------------------
+ * Type of variadic string arguments
+ * ----------------------------------------------------------------------- */
+
+typedef const char *const_char_ptr;
+
+
 /* --------------------------------------------------------------------------
  * Forward declarations
  * ----------------------------------------------------------------------- */
@@ -176,25 +206,46 @@ static inline short int get_rank_of_first_ranking_char
 
 static inline short int collation_rank (char ch, cstr_collation_mode_t mode);
 
+static inline word_t load_word (const char *ptr);
+
+static unsigned concat_list
+  (char *target, unsigned size, const char *first, va_list cstr_list);
+
 
 /* --------------------------------------------------------------------------
  * function cstr_length(cstr)
  * --------------------------------------------------------------------------
- * Returns the length of C string cstr.  Returns 0 if cstr is NULL.
+ * Returns the length of C string cstr.  Returns 0 if cstr is NULL.  Scans
+ * a machine word at a time.
  * ----------------------------------------------------------------------- */
 
 unsigned cstr_length (const char *cstr) {
-  unsigned length = 0;
+  const char *ch;
   
   if (cstr == NULL) {
     return 0;
   } /* end if */
   
-  while (cstr[length] != ASCII_NUL) {
-    length++;
+  /* bytes up to the first word boundary */
+  ch = cstr;
+  while (!IS_WORD_ALIGNED(ch)) {
+    if (*ch == ASCII_NUL) {
+      return (unsigned) (ch - cstr);
+    } /* end if */
+    ch++;
   } /* end while */
   
-  return length;
+  /* whole words up to the word containing the terminator */
+  while (!HAS_NUL_BYTE(load_word(ch))) {
+    ch = ch + WORD_SIZE;
+  } /* end while */
+  
+  /* bytes up to the terminator */
+  while (*ch != ASCII_NUL) {
+    ch++;
+  } /* end while */
+  
+  return (unsigned) (ch - cstr);
 } /* end cstr_length */
 
 
@@ -253,21 +304,47 @@ bool cstr_contains_char(const char *cstr, char ch) {
  * function cstr_match(cstr1, cstr2)
  * --------------------------------------------------------------------------
  * Returns true if cstr1 and cstr2 match, otherwise false.
- * If any argument is NULL, false is returned.
+ * If any argument is NULL, false is returned.  Compares a machine word at
+ * a time where cstr1 and cstr2 are equally aligned.
  * ----------------------------------------------------------------------- */
 
 bool cstr_match (const char *cstr1, const char *cstr2) {
-  unsigned index = 0;
+  word_t word1, word2;
   
   if ((cstr1 == NULL) || (cstr2 == NULL)) {
     return false;
   } /* end if */
   
-  while (cstr1[index] == cstr2[index]) {
-    if (cstr1[index] == ASCII_NUL) {
+  /* bytes up to the first word boundary of cstr1 */
+  while (!IS_WORD_ALIGNED(cstr1)) {
+    if (*cstr1 != *cstr2) {
+      return false;
+    }
+    else if (*cstr1 == ASCII_NUL) {
       return true;
     } /* end if */
-    index++;
+    cstr1++; cstr2++;
+  } /* end while */
+  
+  /* whole words while equal and unterminated, if cstr2 is aligned too */
+  if (IS_WORD_ALIGNED(cstr2)) {
+    word1 = load_word(cstr1);
+    word2 = load_word(cstr2);
+    
+    while ((word1 == word2) && (!HAS_NUL_BYTE(word1))) {
+      cstr1 = cstr1 + WORD_SIZE;
+      cstr2 = cstr2 + WORD_SIZE;
+      word1 = load_word(cstr1);
+      word2 = load_word(cstr2);
+    } /* end while */
+  } /* end if */
+  
+  /* remaining bytes, bytes past a terminator must not decide */
+  while (*cstr1 == *cstr2) {
+    if (*cstr1 == ASCII_NUL) {
+      return true;
+    } /* end if */
+    cstr1++; cstr2++;
   } /* end while */
   
   return false;
@@ -345,7 +422,7 @@ const char *new_cstr_from_slice
   index = 0;
   reqlen = start_index + length;
   for (index = 0; index < reqlen; index++) {
-    if (source[0] == ASCII_NUL) {
+    if (source[index] == ASCII_NUL) {
       return NULL;
     } /* end if */
   } /* end for */
@@ -376,14 +453,12 @@ const char *new_cstr_from_slice
  * Returns a newly allocated and NUL terminated C string containing the
  * concatenation of all its arguments in left-to-right order. The list of
  * arguments must be terminated by NULL.  Returns NULL if first is NULL.
+ * All arguments are measured first,  the result is allocated only once.
  * ----------------------------------------------------------------------- */
 
-typedef const char *const_char_ptr;
-
 const char *new_cstr_by_concat (const char *first, ...) {
-  unsigned reqlen, index, source_index;
+  unsigned reqlen;
   char *target;
-  const char *cstr;
   va_list cstr_list;
   
   /* first must not be NULL */
@@ -393,16 +468,8 @@ const char *new_cstr_by_concat (const char *first, ...) {
   
   /* calculate required length for target */
   va_start(cstr_list, first);
-  reqlen = cstr_length(first);
-  /* get first string in list */
-  cstr = va_arg(cstr_list, const_char_ptr);
-  while (cstr != NULL) {
-    /* add length to tally */
-    reqlen = reqlen + cstr_length(cstr);
-    
-    /* get next string in list */
-    cstr = va_arg(cstr_list, const_char_ptr);
-  } /* end while */
+  reqlen = concat_list(NULL, 0, first, cstr_list);
+  va_end(cstr_list);
   
   /* allocate target string */
   target = malloc(reqlen + 1);
@@ -412,37 +479,51 @@ const char *new_cstr_by_concat (const char *first, ...) {
     return NULL;
   } /* end if */
   
-  /* copy first to target */
-  index = 0;
-  while (first[index] != ASCII_NUL) {
-    target[index] = first[index];
-    index++;
-  } /* end while */
-   
-  /* append strings from list to target */
+  /* copy first and strings from list to target */
   va_start(cstr_list, first);
-  /* get first cstr in list */
-  cstr = va_arg(cstr_list, const_char_ptr);
-  while (cstr != NULL) {
-    /* append cstr */
-    source_index = 0;
-    while (cstr[source_index] != ASCII_NUL) {
-      target[index] = cstr[source_index];
-      index++; source_index++;
-    } /* end while */
-    
-    /* get next cstr in list */
-    cstr = va_arg(cstr_list, const_char_ptr);
-  } /* end while */
+  concat_list(target, reqlen + 1, first, cstr_list);
   va_end(cstr_list);
   
-  /* terminate target */
-  target[index] = ASCII_NUL;
-  
   return (const char *) target;
 } /* end new_cstr_by_concat */
 
 
+/* --------------------------------------------------------------------------
+ * function cstr_concat_into(target, size, first, cstr1, cstr2, ... cstrN)
+ * --------------------------------------------------------------------------
+ * Copies the concatenation of first and the following arguments in left-to-
+ * right order into caller provided buffer target of size bytes  and returns
+ * the length of the concatenation.  The list of arguments must be terminated
+ * by NULL.  At most size - 1 characters are copied  and target is always NUL
+ * terminated if size is not zero.  If the result is not less than size,  the
+ * concatenation was truncated.  Returns 0 if first is NULL.
+ * ----------------------------------------------------------------------- */
+
+unsigned cstr_concat_into
+  (char *target, unsigned size, const char *first, ...) {
+  unsigned length;
+  va_list cstr_list;
+  
+  /* first must not be NULL */
+  if (first == NULL) {
+    if ((target != NULL) && (size > 0)) {
+      target[0] = ASCII_NUL;
+    } /* end if */
+    return 0;
+  } /* end if */
+  
+  if (target == NULL) {
+    size = 0;
+  } /* end if */
+  
+  va_start(cstr_list, first);
+  length = concat_list(target, size, first, cstr_list);
+  va_end(cstr_list);
+  
+  return length;
+} /* end cstr_concat_into */
+
+
 /* *********************************************************************** *
  * Private Functions
  * *********************************************************************** */
@@ -504,4 +585,64 @@ static inline short int collation_rank (char ch, cstr_collation_mode_t mode) {
 } /* end collation_rank */
 
 
+/* --------------------------------------------------------------------------
+ * private function load_word(ptr)
+ * --------------------------------------------------------------------------
+ * Returns the machine word at word aligned address ptr.
+ * ----------------------------------------------------------------------- */
+
+static inline word_t load_word (const char *ptr) {
+  word_t word;
+  
+  /* compiles to a single load, without aliasing a char array as a word */
+  memcpy(&word, ptr, WORD_SIZE);
+  
+  return word;
+} /* end load_word */
+
+
+/* --------------------------------------------------------------------------
+ * private function concat_list(target, size, first, cstr_list)
+ * --------------------------------------------------------------------------
+ * Copies first and the NULL terminated list of strings in cstr_list into
+ * target,  at most size - 1 characters followed by a terminator,  and
+ * returns the length of the whole concatenation.  If size is zero,  target
+ * is not written and may be NULL.
+ * ----------------------------------------------------------------------- */
+
+static unsigned concat_list
+  (char *target, unsigned size, const char *first, va_list cstr_list) {
+  
+  unsigned index, length, count;
+  const char *cstr;
+  
+  index = 0;
+  cstr = first;
+  while (cstr != NULL) {
+    length = cstr_length(cstr);
+    
+    /* copy as much of cstr as fits */
+    if (index + 1 < size) {
+      count = size - 1 - index;
+      if (length < count) {
+        count = length;
+      } /* end if */
+      memcpy(target + index, cstr, count);
+    } /* end if */
+    
+    index = index + length;
+    
+    /* get next cstr in list */
+    cstr = va_arg(cstr_list, const_char_ptr);
+  } /* end while */
+  
+  /* terminate target */
+  if (size > 0) {
+    target[(index < size) ? index : size - 1] = ASCII_NUL;
+  } /* end if */
+  
+  return index;
+} /* end concat_list */
+
+
 /* END OF FILE */
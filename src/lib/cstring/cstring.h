@@ -80,7 +80,8 @@ typedef enum {
 /* --------------------------------------------------------------------------
  * function cstr_length(cstr)
  * --------------------------------------------------------------------------
- * Returns the length of C string cstr.  Returns 0 if cstr is NULL.
+ * Returns the length of C string cstr.  Returns 0 if cstr is NULL.  Scans
+ * a machine word at a time.
  * ----------------------------------------------------------------------- */
 
 unsigned cstr_length (const char *cstr);
@@ -117,7 +118,8 @@ bool cstr_contains_char(const char *cstr, char ch);
  * function cstr_match(cstr1, cstr2)
  * --------------------------------------------------------------------------
  * Returns true if cstr1 and cstr2 match, otherwise false.
- * If any argument is NULL, false is returned.
+ * If any argument is NULL, false is returned.  Compares a machine word at
+ * a time where cstr1 and cstr2 are equally aligned.
  * ----------------------------------------------------------------------- */
 
 bool cstr_match (const char *cstr1, const char *cstr2);
@@ -157,11 +159,27 @@ const char *new_cstr_from_slice
  * Returns a newly allocated and NUL terminated C string containing the
  * concatenation of all its arguments in left-to-right order. The list of
  * arguments must be terminated by NULL.  Returns NULL if first is NULL.
+ * All arguments are measured first,  the result is allocated only once.
  * ----------------------------------------------------------------------- */
 
 const char *new_cstr_by_concat (const char *first, ...);
 
 
+/* --------------------------------------------------------------------------
+ * function cstr_concat_into(target, size, first, cstr1, cstr2, ... cstrN)
+ * --------------------------------------------------------------------------
+ * Copies the concatenation of first and the following arguments in left-to-
+ * right order into caller provided buffer target of size bytes  and returns
+ * the length of the concatenation.  The list of arguments must be terminated
+ * by NULL.  At most size - 1 characters are copied  and target is always NUL
+ * terminated if size is not zero.  If the result is not less than size,  the
+ * concatenation was truncated.  Returns 0 if first is NULL.
+ * ----------------------------------------------------------------------- */
+
+unsigned cstr_concat_into
+  (char *target, unsigned size, const char *first, ...);
+
+
 #endif /* CSTRING_H */
 
 /* END OF FILE */
@@ -0,0 +1,515 @@
+ /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+  * M2C Modula-2 Compiler & Translator                                        *
+  *                                                                           *
+  * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+  *                                                                           *
+  * @synopsis                                                                 *
+  *                                                                           *
+  * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+  * bootstrap subset of the revised Modula-2 language described in            *
+  *                                                                           *
+  * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+  *                                                                           *
+  * In translator mode,  M2C translates Modula-2 source files to semantically *
+  * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+  * source files  to C,  then compiles the resulting C sources  to object and *
+  * executable files using the host system's resident C compiler and linker.  *
+  *                                                                           *
+  * Further information at https://github.com/m2sf/m2c/wiki                   *
+  *                                                                           *
+  * @file                                                                     *
+  *                                                                           *
+  * fifo.c                                                                    *
+  *                                                                           *
+  * Implementation of generic queue library.                                  *
+  *                                                                           *
+  * @license                                                                  *
+  *                                                                           *
+  * M2C is free software:  You can redistribute and modify it under the terms *
+  * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+  * your choice version 3, both published by the Free Software Foundation.    *
+  *                                                                           *
+  * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+  * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+  * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+  *                                                                           *
+  * You should have received  a copy of the GNU Lesser General Public License *
+  * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "fifo.h"
+#include "hash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Minimum number of slots of a membership set
+ * ----------------------------------------------------------------------- */
+
+#define MIN_SET_SIZE 32
+
+
+/* --------------------------------------------------------------------------
+ * private type set_slot_t
+ * --------------------------------------------------------------------------
+ * Record type for a slot of a membership set.  Field count holds the number
+ * of times value is present in the queue.  A slot whose count has dropped
+ * to zero keeps its value,  so probe sequences remain intact,  and is only
+ * cleared when the set is rebuilt.  A slot whose value is NULL is empty.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* value */  m2c_fifo_value_t value;
+  /* count */  uint_t count;
+} set_slot_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_fifo_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing a FIFO queue.  Its count values are stored in
+ * ring buffer value of capacity entries,  a power of two,  starting at
+ * index tail.  Field set holds the membership set of set_size slots,  a
+ * power of two,  of which set_used hold a value,  or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_fifo_struct_t {
+  /* capacity */  uint_t capacity;
+  /* count */     uint_t count;
+  /* tail */      uint_t tail;
+  /* value */     m2c_fifo_value_t *value;
+  /* set_size */  uint_t set_size;
+  /* set_used */  uint_t set_used;
+  /* set */       set_slot_t *set;
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool grow_ring (m2c_fifo_t queue);
+
+static bool build_set (m2c_fifo_t queue);
+
+static set_slot_t *slot_for_value
+  (m2c_fifo_t queue, m2c_fifo_value_t value);
+
+static void discard_set (m2c_fifo_t queue);
+
+
+/* --------------------------------------------------------------------------
+ * procedure print_fifo_info(q, out)
+ * --------------------------------------------------------------------------
+ * Prints the number of entries,  capacity and membership set size of q to
+ * out.  Does nothing if out is NULL.
+ * ----------------------------------------------------------------------- */
+
+void print_fifo_info (m2c_fifo_t q, FILE *out) {
+  
+  if (out == NULL) {
+    return;
+  } /* end if */
+  
+  if (q == NULL) {
+    fprintf(out, "fifo: NULL\n");
+    return;
+  } /* end if */
+  
+  fprintf(out, "fifo: %u entries, capacity %u, set size %u (%u used)\n",
+    (unsigned) q->count, (unsigned) q->capacity,
+    (unsigned) q->set_size, (unsigned) q->set_used);
+} /* end print_fifo_info */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_new_queue(first_value)
+ * --------------------------------------------------------------------------
+ * Allocates a new queue object, stores first_value unless it is NULL and
+ * returns the queue.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_t m2c_fifo_new_queue (m2c_fifo_value_t first_value) {
+  
+  m2c_fifo_t new_queue;
+  
+  new_queue = malloc(sizeof(struct m2c_fifo_struct_t));
+  
+  if (new_queue == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_queue->value =
+    malloc(M2C_FIFO_INITIAL_CAPACITY * sizeof(m2c_fifo_value_t));
+  
+  if (new_queue->value == NULL) {
+    free(new_queue);
+    return NULL;
+  } /* end if */
+  
+  new_queue->capacity = M2C_FIFO_INITIAL_CAPACITY;
+  new_queue->count = 0;
+  new_queue->tail = 0;
+  new_queue->set_size = 0;
+  new_queue->set_used = 0;
+  new_queue->set = NULL;
+  
+  if (first_value != NULL) {
+    new_queue->value[0] = first_value;
+    new_queue->count = 1;
+  } /* end if */
+  
+  return new_queue;
+} /* end m2c_fifo_new_queue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_enqueue(queue, new_value)
+ * --------------------------------------------------------------------------
+ * Adds a value to the head of queue and returns queue, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_t m2c_fifo_enqueue (m2c_fifo_t queue, m2c_fifo_value_t new_value) {
+  
+  set_slot_t *slot;
+  
+  if ((queue == NULL) || (new_value == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  if ((queue->count == queue->capacity) && NOT(grow_ring(queue))) {
+    return NULL;
+  } /* end if */
+  
+  queue->value[(queue->tail + queue->count) & (queue->capacity - 1)] =
+    new_value;
+  queue->count++;
+  
+  /* keep membership set up to date */
+  if (queue->set != NULL) {
+    slot = slot_for_value(queue, new_value);
+    
+    if (slot->value == NULL) {
+      /* keep set at most half full, rebuild with the new value in it */
+      if (2 * (queue->set_used + 1) > queue->set_size) {
+        if (NOT(build_set(queue))) {
+          discard_set(queue);
+        } /* end if */
+        return queue;
+      } /* end if */
+      
+      slot->value = new_value;
+      queue->set_used++;
+    } /* end if */
+    
+    slot->count++;
+  } /* end if */
+  
+  return queue;
+} /* end m2c_fifo_enqueue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_enqueue_unique(queue, new_value)
+ * --------------------------------------------------------------------------
+ * Adds a value to the head of queue if and only if the value is not already
+ * present in queue.  Returns queue on success, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_t m2c_fifo_enqueue_unique
+  (m2c_fifo_t queue, m2c_fifo_value_t new_value) {
+  
+  if (m2c_fifo_entry_exists(queue, new_value)) {
+    return queue;
+  } /* end if */
+  
+  return m2c_fifo_enqueue(queue, new_value);
+} /* end m2c_fifo_enqueue_unique */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_dequeue(queue)
+ * --------------------------------------------------------------------------
+ * Removes the value at the tail of queue and returns it, or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_value_t m2c_fifo_dequeue (m2c_fifo_t queue) {
+  
+  m2c_fifo_value_t value;
+  set_slot_t *slot;
+  
+  if ((queue == NULL) || (queue->count == 0)) {
+    return NULL;
+  } /* end if */
+  
+  value = queue->value[queue->tail];
+  queue->tail = (queue->tail + 1) & (queue->capacity - 1);
+  queue->count--;
+  
+  /* keep membership set up to date */
+  if (queue->set != NULL) {
+    slot = slot_for_value(queue, value);
+    
+    if (slot->count > 0) {
+      slot->count--;
+    } /* end if */
+  } /* end if */
+  
+  return value;
+} /* end m2c_fifo_dequeue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_entry_count(queue)
+ * --------------------------------------------------------------------------
+ * Returns the number of values present in queue. 
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fifo_entry_count (m2c_fifo_t queue) {
+  
+  if (queue == NULL) {
+    return 0;
+  } /* end if */
+  
+  return queue->count;
+} /* end m2c_fifo_entry_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_entry_exists(queue, value)
+ * --------------------------------------------------------------------------
+ * Returns true if value is present in queue, otherwise false.  Builds the
+ * membership set of queue on first use.  Should that fail,  falls back to
+ * a linear scan.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_fifo_entry_exists (m2c_fifo_t queue, m2c_fifo_value_t value) {
+  
+  uint_t index;
+  
+  if ((queue == NULL) || (value == NULL) || (queue->count == 0)) {
+    return false;
+  } /* end if */
+  
+  if ((queue->set != NULL) || (build_set(queue))) {
+    return (slot_for_value(queue, value)->count > 0);
+  } /* end if */
+  
+  /* no memory for the set */
+  for (index = 0; index < queue->count; index++) {
+    if (queue->value[(queue->tail + index) & (queue->capacity - 1)] ==
+        value) {
+      return true;
+    } /* end if */
+  } /* end for */
+  
+  return false;
+} /* end m2c_fifo_entry_exists */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_entry_at_index(queue, index)
+ * --------------------------------------------------------------------------
+ * Returns the value at position index of queue,  counting from the tail,
+ * or NULL if queue is NULL or index is out of range.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_value_t m2c_fifo_entry_at_index (m2c_fifo_t queue, uint_t index) {
+  
+  if ((queue == NULL) || (index >= queue->count)) {
+    return NULL;
+  } /* end if */
+  
+  return queue->value[(queue->tail + index) & (queue->capacity - 1)];
+} /* end m2c_fifo_entry_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_reset_queue(queue)
+ * --------------------------------------------------------------------------
+ * Removes all entries from queue but does not deallocate it.
+ * Returns the queue on success or NULL if queue is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_t m2c_fifo_reset_queue (m2c_fifo_t queue) {
+  
+  if (queue == NULL) {
+    return NULL;
+  } /* end if */
+  
+  queue->count = 0;
+  queue->tail = 0;
+  
+  if (queue->set != NULL) {
+    memset(queue->set, 0, queue->set_size * sizeof(set_slot_t));
+    queue->set_used = 0;
+  } /* end if */
+  
+  return queue;
+} /* end m2c_fifo_reset_queue */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_release_queue(queue)
+ * --------------------------------------------------------------------------
+ * Deallocates queue. 
+ * ----------------------------------------------------------------------- */
+
+void m2c_fifo_release_queue (m2c_fifo_t queue) {
+  
+  if (queue == NULL) {
+    return;
+  } /* end if */
+  
+  free(queue->set);
+  free(queue->value);
+  free(queue);
+} /* end m2c_fifo_release_queue */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function grow_ring(queue)
+ * --------------------------------------------------------------------------
+ * Doubles the capacity of the ring buffer of queue,  moving its values to
+ * the start of the new buffer in order.  Returns true on success,  false if
+ * allocation failed,  in which case queue is unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_ring (m2c_fifo_t queue) {
+  
+  m2c_fifo_value_t *new_value;
+  uint_t first_part;
+  
+  new_value = malloc(2 * queue->capacity * sizeof(m2c_fifo_value_t));
+  
+  if (new_value == NULL) {
+    return false;
+  } /* end if */
+  
+  /* the values run from tail to the end, then wrap around to the start */
+  first_part = queue->capacity - queue->tail;
+  
+  if (first_part > queue->count) {
+    first_part = queue->count;
+  } /* end if */
+  
+  memcpy(new_value, queue->value + queue->tail,
+    first_part * sizeof(m2c_fifo_value_t));
+  memcpy(new_value + first_part, queue->value,
+    (queue->count - first_part) * sizeof(m2c_fifo_value_t));
+  
+  free(queue->value);
+  queue->value = new_value;
+  queue->capacity = 2 * queue->capacity;
+  queue->tail = 0;
+  
+  return true;
+} /* end grow_ring */
+
+
+/* --------------------------------------------------------------------------
+ * private function build_set(queue)
+ * --------------------------------------------------------------------------
+ * Replaces the membership set of queue,  if any,  by a new set of the values
+ * presently in queue that is at most a quarter full,  dropping values that
+ * are no longer present.  Returns true on
+ * success,  false if allocation failed,  in which case queue is unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool build_set (m2c_fifo_t queue) {
+  
+  set_slot_t *old_set, *slot;
+  uint_t distinct, size, index;
+  m2c_fifo_value_t value;
+  
+  /* the distinct values in a present set bound those in the queue */
+  if (queue->set != NULL) {
+    distinct = queue->set_used + 1;
+  }
+  else {
+    distinct = queue->count;
+  } /* end if */
+  
+  size = MIN_SET_SIZE;
+  while (size < 4 * distinct) {
+    size = 2 * size;
+  } /* end while */
+  
+  old_set = queue->set;
+  
+  queue->set = calloc(size, sizeof(set_slot_t));
+  
+  if (queue->set == NULL) {
+    queue->set = old_set;
+    return false;
+  } /* end if */
+  
+  free(old_set);
+  
+  queue->set_size = size;
+  queue->set_used = 0;
+  
+  for (index = 0; index < queue->count; index++) {
+    value = queue->value[(queue->tail + index) & (queue->capacity - 1)];
+    slot = slot_for_value(queue, value);
+    
+    if (slot->value == NULL) {
+      slot->value = value;
+      queue->set_used++;
+    } /* end if */
+    
+    slot->count++;
+  } /* end for */
+  
+  return true;
+} /* end build_set */
+
+
+/* --------------------------------------------------------------------------
+ * private function slot_for_value(queue, value)
+ * --------------------------------------------------------------------------
+ * Returns the slot of the membership set of queue that holds value,  or the
+ * empty slot where value would be inserted.  The set must not be full.
+ * ----------------------------------------------------------------------- */
+
+static set_slot_t *slot_for_value
+  (m2c_fifo_t queue, m2c_fifo_value_t value) {
+  
+  uint_t index, mask;
+  
+  mask = queue->set_size - 1;
+  index =
+    (uint_t) hash_mum((uint64_t) (uintptr_t) value, HASH_SECRET0) & mask;
+  
+  while ((queue->set[index].value != NULL) &&
+         (queue->set[index].value != value)) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return &queue->set[index];
+} /* end slot_for_value */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure discard_set(queue)
+ * --------------------------------------------------------------------------
+ * Deallocates the membership set of queue.  It is rebuilt on next use.
+ * ----------------------------------------------------------------------- */
+
+static void discard_set (m2c_fifo_t queue) {
+  
+  free(queue->set);
+  queue->set = NULL;
+  queue->set_size = 0;
+  queue->set_used = 0;
+} /* end discard_set */
+
+
+/* END OF FILE */
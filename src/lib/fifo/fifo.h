@@ -40,16 +40,29 @@
 #ifndef M2C_FIFO_H
 #define M2C_FIFO_H
 
-#include "m2-common.h"
+#include "m2c-common.h"
 
+#include <stdio.h>
 #include <stdbool.h>
 
 
 /* --------------------------------------------------------------------------
- * Number of entries per FIFO queue segment
+ * FIFO queue storage
+ * --------------------------------------------------------------------------
+ * A queue stores its values in a single ring buffer that doubles in size
+ * when full.  The first test for membership builds a hash set of the values
+ * in the queue alongside,  which is then kept up to date on every enqueue
+ * and dequeue.  Membership tests thus take constant time on average,  and
+ * queues that are never tested do not pay for the set.  Values are compared
+ * by identity,  NULL cannot be stored.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Initial number of entries of a FIFO queue ring buffer
  * ----------------------------------------------------------------------- */
 
-#define M2C_FIFO_SEGMENT_SIZE 16
+#define M2C_FIFO_INITIAL_CAPACITY 16
 
 
 /* --------------------------------------------------------------------------
@@ -70,7 +83,14 @@ typedef void *m2c_fifo_value_t;
 typedef struct m2c_fifo_struct_t *m2c_fifo_t;
 
 
-void print_fifo_info(m2c_fifo_t q);
+/* --------------------------------------------------------------------------
+ * procedure print_fifo_info(q, out)
+ * --------------------------------------------------------------------------
+ * Prints the number of entries,  capacity and membership set size of q to
+ * out.  Does nothing if out is NULL.
+ * ----------------------------------------------------------------------- */
+
+void print_fifo_info (m2c_fifo_t q, FILE *out);
 
 
 /* --------------------------------------------------------------------------
@@ -130,6 +150,17 @@ uint_t m2c_fifo_entry_count (m2c_fifo_t queue);
 bool m2c_fifo_entry_exists (m2c_fifo_t queue, m2c_fifo_value_t value);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_fifo_entry_at_index(queue, index)
+ * --------------------------------------------------------------------------
+ * Returns the value at position index of queue,  counting from the tail,
+ * or NULL if queue is NULL or index is out of range.  The value at index 0
+ * is the next value to be dequeued.
+ * ----------------------------------------------------------------------- */
+
+m2c_fifo_value_t m2c_fifo_entry_at_index (m2c_fifo_t queue, uint_t index);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_fifo_reset_queue(queue)
  * --------------------------------------------------------------------------
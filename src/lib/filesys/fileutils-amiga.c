@@ -184,6 +184,95 @@ bool get_filetime (const char *path, long int *timestamp) {
 } /* end get_filetime */
 
 
+/* --------------------------------------------------------------------------
+ * private procedure copy_file_info(st, info)
+ * --------------------------------------------------------------------------
+ * Copies the type, size and last modification time in st to info.
+ * ----------------------------------------------------------------------- */
+
+static void copy_file_info (const struct stat *st, file_info_t *info) {
+  
+  if (S_ISREG(st->st_mode)) {
+    info->type = FILE_TYPE_REGULAR;
+  }
+  else if (S_ISDIR(st->st_mode)) {
+    info->type = FILE_TYPE_DIRECTORY;
+  }
+  else {
+    info->type = FILE_TYPE_OTHER;
+  } /* end if */
+  
+  info->size = (long int) st->st_size;
+  info->timestamp = (long int) st->st_mtime;
+} /* end copy_file_info */
+
+
+/* --------------------------------------------------------------------------
+ * function get_file_info(path, info)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing filesystem entry
+ * and if so, it copies the entry's type, size and last modification time to
+ * out-parameter info and returns true.  Otherwise it sets the type in info
+ * to FILE_TYPE_NONE and returns false.
+ * ----------------------------------------------------------------------- */
+
+bool get_file_info (const char *path, file_info_t *info) {
+  struct stat st;
+  int status;
+  
+  info->type = FILE_TYPE_NONE;
+  
+  /* path may not be NULL or empty */
+  if ((path == NULL) || (path[0] == 0)) {
+    return false;
+  } /* end if */
+  
+  /* obtain file info */
+  status = stat(path, &st);
+  
+  if (status != 0) {
+    return false;
+  } /* end if */
+  
+  /* pass back file info */
+  copy_file_info(&st, info);
+  
+  return true;
+} /* end get_file_info */
+
+
+/* --------------------------------------------------------------------------
+ * function get_stream_file_info(file, info)
+ * --------------------------------------------------------------------------
+ * Copies the type, size and last modification time of the file underlying
+ * open stream file to out-parameter info and returns true.  Returns false
+ * if the attributes cannot be obtained.
+ * ----------------------------------------------------------------------- */
+
+bool get_stream_file_info (FILE *file, file_info_t *info) {
+  struct stat st;
+  int status;
+  
+  info->type = FILE_TYPE_NONE;
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  /* obtain file info of the open file */
+  status = fstat(fileno(file), &st);
+  
+  if (status != 0) {
+    return false;
+  } /* end if */
+  
+  /* pass back file info */
+  copy_file_info(&st, info);
+  
+  return true;
+} /* end get_stream_file_info */
+
+
 /* --------------------------------------------------------------------------
  * function new_path_w_current_workdir()
  * --------------------------------------------------------------------------
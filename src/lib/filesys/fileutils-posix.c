@@ -33,13 +33,35 @@
  * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* statx */
+#endif
+
 #include "fileutils.h"
+#include "m2c-common.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <sys/stat.h>
 
 
+/* --------------------------------------------------------------------------
+ * Use statx() where available
+ * --------------------------------------------------------------------------
+ * On Linux,  statx() lets get_file_info request only the attributes it
+ * returns,  which spares filesystems the cost of attributes they compute
+ * on demand.  Elsewhere,  stat() is used.
+ * ----------------------------------------------------------------------- */
+
+#if defined(STATX_TYPE) && defined(STATX_SIZE) && defined(STATX_MTIME)
+#define FILEUTILS_USE_STATX 1
+#else
+#define FILEUTILS_USE_STATX 0
+#endif
+
+
 /* --------------------------------------------------------------------------
  * function file_exists(path)
  * --------------------------------------------------------------------------
@@ -183,6 +205,114 @@ bool get_filetime (const char *path, long int *timestamp) {
 } /* end get_filetime */
 
 
+/* --------------------------------------------------------------------------
+ * private procedure copy_file_info(st, info)
+ * --------------------------------------------------------------------------
+ * Copies the type, size and last modification time in st to info.
+ * ----------------------------------------------------------------------- */
+
+static void copy_file_info (const struct stat *st, file_info_t *info) {
+  
+  if (S_ISREG(st->st_mode)) {
+    info->type = FILE_TYPE_REGULAR;
+  }
+  else if (S_ISDIR(st->st_mode)) {
+    info->type = FILE_TYPE_DIRECTORY;
+  }
+  else {
+    info->type = FILE_TYPE_OTHER;
+  } /* end if */
+  
+  info->size = (long int) st->st_size;
+  info->timestamp = (long int) st->st_mtime;
+} /* end copy_file_info */
+
+
+/* --------------------------------------------------------------------------
+ * function get_file_info(path, info)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing filesystem entry
+ * and if so, it copies the entry's type, size and last modification time to
+ * out-parameter info and returns true.  Otherwise it sets the type in info
+ * to FILE_TYPE_NONE and returns false.
+ * ----------------------------------------------------------------------- */
+
+bool get_file_info (const char *path, file_info_t *info) {
+#if (FILEUTILS_USE_STATX)
+  struct statx stx;
+#endif
+  struct stat st;
+  int status;
+  
+  info->type = FILE_TYPE_NONE;
+  
+  /* path may not be NULL or empty */
+  if ((path == NULL) || (path[0] == 0)) {
+    return false;
+  } /* end if */
+  
+#if (FILEUTILS_USE_STATX)
+  /* obtain file info */
+  status = statx(AT_FDCWD, path,
+    AT_STATX_SYNC_AS_STAT, STATX_TYPE | STATX_SIZE | STATX_MTIME, &stx);
+  
+  if (status == 0) {
+    st.st_mode = stx.stx_mode;
+    st.st_size = (off_t) stx.stx_size;
+    st.st_mtime = (time_t) stx.stx_mtime.tv_sec;
+  }
+  /* kernels before 4.11 lack statx */
+  else if (errno == ENOSYS) {
+    status = stat(path, &st);
+  } /* end if */
+#else
+  /* obtain file info */
+  status = stat(path, &st);
+#endif
+  
+  if (status != 0) {
+    return false;
+  } /* end if */
+  
+  /* pass back file info */
+  copy_file_info(&st, info);
+  
+  return true;
+} /* end get_file_info */
+
+
+/* --------------------------------------------------------------------------
+ * function get_stream_file_info(file, info)
+ * --------------------------------------------------------------------------
+ * Copies the type, size and last modification time of the file underlying
+ * open stream file to out-parameter info and returns true.  Returns false
+ * if the attributes cannot be obtained.
+ * ----------------------------------------------------------------------- */
+
+bool get_stream_file_info (FILE *file, file_info_t *info) {
+  struct stat st;
+  int status;
+  
+  info->type = FILE_TYPE_NONE;
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  /* obtain file info of the open file */
+  status = fstat(fileno(file), &st);
+  
+  if (status != 0) {
+    return false;
+  } /* end if */
+  
+  /* pass back file info */
+  copy_file_info(&st, info);
+  
+  return true;
+} /* end get_stream_file_info */
+
+
 /* --------------------------------------------------------------------------
  * function new_path_w_current_workdir()
  * --------------------------------------------------------------------------
@@ -36,9 +36,38 @@
 #ifndef FILEUTILS_H
 #define FILEUTILS_H
 
+#include <stdio.h>
 #include <stdbool.h>
 
 
+/* --------------------------------------------------------------------------
+ * type file_type_t
+ * --------------------------------------------------------------------------
+ * Enumerated type for the type of a filesystem entry.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  FILE_TYPE_NONE,
+  FILE_TYPE_REGULAR,
+  FILE_TYPE_DIRECTORY,
+  FILE_TYPE_OTHER
+} file_type_t;
+
+
+/* --------------------------------------------------------------------------
+ * type file_info_t
+ * --------------------------------------------------------------------------
+ * Record type for the attributes of a filesystem entry.  Size and timestamp
+ * are only meaningful for regular files.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* type */       file_type_t type;
+  /* size */       long int size;
+  /* timestamp */  long int timestamp;
+} file_info_t;
+
+
 /* --------------------------------------------------------------------------
  * function file_exists(path)
  * --------------------------------------------------------------------------
@@ -92,6 +121,32 @@ bool get_filesize (const char *path, long int *size);
 bool get_filetime (const char *path, long int *timestamp);
 
 
+/* --------------------------------------------------------------------------
+ * function get_file_info(path, info)
+ * --------------------------------------------------------------------------
+ * Tests if path is a valid pathname indicating an existing filesystem entry
+ * and if so, it copies the entry's type, size and last modification time to
+ * out-parameter info and returns true.  Otherwise it sets the type in info
+ * to FILE_TYPE_NONE and returns false.  All attributes are obtained by a
+ * single query of the filesystem, callers needing more than one attribute
+ * of a file should use this function instead of the individual tests.
+ * ----------------------------------------------------------------------- */
+
+bool get_file_info (const char *path, file_info_t *info);
+
+
+/* --------------------------------------------------------------------------
+ * function get_stream_file_info(file, info)
+ * --------------------------------------------------------------------------
+ * Copies the type, size and last modification time of the file underlying
+ * open stream file to out-parameter info and returns true.  Returns false
+ * if the attributes cannot be obtained.  The attributes are those of the
+ * file that was opened, no pathname is looked up again.
+ * ----------------------------------------------------------------------- */
+
+bool get_stream_file_info (FILE *file, file_info_t *info);
+
+
 /* --------------------------------------------------------------------------
  * function new_path_w_current_workdir()
  * --------------------------------------------------------------------------
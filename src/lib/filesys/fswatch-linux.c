@@ -0,0 +1,335 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * fswatch-linux.c
+ *
+ * Linux implementation of file system change notification.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "fswatch.h"
+#include "m2c-common.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+
+/* --------------------------------------------------------------------------
+ * Events of interest,  entries written,  renamed or deleted
+ * ----------------------------------------------------------------------- */
+
+#define WATCH_EVENTS \
+  (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE)
+
+
+/* --------------------------------------------------------------------------
+ * Size of the event buffer,  enough for a burst of events
+ * ----------------------------------------------------------------------- */
+
+#define EVENT_BUFFER_SIZE (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the directory table
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_CAPACITY 16
+
+
+/* --------------------------------------------------------------------------
+ * hidden type fswatch_s
+ * --------------------------------------------------------------------------
+ * Record type for a watch.  Directories are kept in a table indexed in the
+ * order they were added,  with the inotify watch descriptor of each.
+ * ----------------------------------------------------------------------- */
+
+struct fswatch_s {
+  /* fd */        int fd;
+  /* count */     unsigned int count;
+  /* capacity */  unsigned int capacity;
+  /* wd */        int *wd;
+  /* dir */       char **dir;
+};
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_new(status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+fswatch_t fswatch_new (fswatch_status_t *status) {
+  
+  fswatch_t watch;
+  
+  watch = malloc(sizeof(struct fswatch_s));
+  
+  if (watch == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  watch->count = 0;
+  watch->capacity = INITIAL_CAPACITY;
+  watch->wd = malloc(INITIAL_CAPACITY * sizeof(int));
+  watch->dir = malloc(INITIAL_CAPACITY * sizeof(char *));
+  
+  if ((watch->fd < 0) || (watch->wd == NULL) || (watch->dir == NULL)) {
+    SET_STATUS(status, (watch->fd < 0) ?
+        FSWATCH_STATUS_IO_ERROR : FSWATCH_STATUS_ALLOCATION_FAILED);
+    fswatch_release(&watch);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+  
+  return watch;
+} /* end fswatch_new */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_add_directory(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds directory path to watch.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_add_directory
+  (fswatch_t watch, const char *path, fswatch_status_t *status) {
+  
+  unsigned int new_capacity;
+  size_t length;
+  char **new_dir;
+  int *new_wd;
+  int wd;
+  
+  if ((watch == NULL) || (path == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (watch->count == watch->capacity) {
+    new_capacity = 2 * watch->capacity;
+    new_wd = realloc(watch->wd, new_capacity * sizeof(int));
+    if (new_wd != NULL) {
+      watch->wd = new_wd;
+    } /* end if */
+    new_dir = realloc(watch->dir, new_capacity * sizeof(char *));
+    if (new_dir != NULL) {
+      watch->dir = new_dir;
+    } /* end if */
+    
+    if ((new_wd == NULL) || (new_dir == NULL)) {
+      SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    watch->capacity = new_capacity;
+  } /* end if */
+  
+  wd = inotify_add_watch(watch->fd, path, WATCH_EVENTS | IN_ONLYDIR);
+  
+  if (wd < 0) {
+    if (errno == ENOSPC) {
+      SET_STATUS(status, FSWATCH_STATUS_LIMIT_EXCEEDED);
+    }
+    else if ((errno == ENOENT) || (errno == ENOTDIR)) {
+      SET_STATUS(status, FSWATCH_STATUS_PATH_NOT_FOUND);
+    }
+    else {
+      SET_STATUS(status, FSWATCH_STATUS_IO_ERROR);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  length = strlen(path);
+  watch->dir[watch->count] = malloc(length + 1);
+  
+  if (watch->dir[watch->count] == NULL) {
+    inotify_rm_watch(watch->fd, wd);
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  memcpy(watch->dir[watch->count], path, length + 1);
+  watch->wd[watch->count] = wd;
+  watch->count++;
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+} /* end fswatch_add_directory */
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_wait(watch, timeout_ms, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Waits for changes and calls handler for each change received.  Reads
+ * all events that are queued once the first one has arrived.
+ * ----------------------------------------------------------------------- */
+
+bool fswatch_wait
+  (fswatch_t watch,
+   int timeout_ms,
+   fswatch_handler_t handler,
+   void *context,
+   fswatch_status_t *status) {
+  
+  const struct inotify_event *event;
+  fswatch_status_t result;
+  size_t dir_length, path_size, needed;
+  struct pollfd poll_fd;
+  unsigned int index;
+  char *buffer, *path, *new_path;
+  ssize_t length;
+  bool reported;
+  int ready;
+  
+  if ((watch == NULL) || (handler == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  poll_fd.fd = watch->fd;
+  poll_fd.events = POLLIN;
+  
+  do {
+    ready = poll(&poll_fd, 1, timeout_ms);
+  } while ((ready < 0) && (errno == EINTR));
+  
+  if (ready <= 0) {
+    SET_STATUS(status, (ready == 0) ?
+        FSWATCH_STATUS_SUCCESS : FSWATCH_STATUS_IO_ERROR);
+    return false;
+  } /* end if */
+  
+  /* events are aligned for struct inotify_event */
+  buffer = malloc(EVENT_BUFFER_SIZE);
+  path_size = 256;
+  path = malloc(path_size);
+  
+  if ((buffer == NULL) || (path == NULL)) {
+    free(buffer);
+    free(path);
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return false;
+  } /* end if */
+  
+  result = FSWATCH_STATUS_SUCCESS;
+  reported = false;
+  
+  while ((result != FSWATCH_STATUS_ALLOCATION_FAILED) &&
+      ((length = read(watch->fd, buffer, EVENT_BUFFER_SIZE)) > 0)) {
+    event = (const struct inotify_event *) buffer;
+    
+    while ((const char *) event < buffer + length) {
+      if (event->mask & IN_Q_OVERFLOW) {
+        result = FSWATCH_STATUS_OVERFLOW;
+        reported = true;
+      }
+      else if ((event->len > 0) && ((event->mask & IN_ISDIR) == 0)) {
+        
+        /* find the directory of the event */
+        index = 0;
+        while ((index < watch->count) && (watch->wd[index] != event->wd)) {
+          index++;
+        } /* end while */
+        
+        if (index < watch->count) {
+          dir_length = strlen(watch->dir[index]);
+          needed = dir_length + strlen(event->name) + 2;
+          
+          if (needed > path_size) {
+            new_path = realloc(path, needed);
+            if (new_path == NULL) {
+              result = FSWATCH_STATUS_ALLOCATION_FAILED;
+              break;
+            } /* end if */
+            path = new_path;
+            path_size = needed;
+          } /* end if */
+          
+          memcpy(path, watch->dir[index], dir_length);
+          path[dir_length] = '/';
+          strcpy(path + dir_length + 1, event->name);
+          
+          handler(path, context);
+          reported = true;
+        } /* end if */
+      } /* end if */
+      
+      event = (const struct inotify_event *)
+        ((const char *) event + sizeof(struct inotify_event) + event->len);
+    } /* end while */
+  } /* end while */
+  
+  free(buffer);
+  free(path);
+  
+  SET_STATUS(status, result);
+  
+  return reported;
+} /* end fswatch_wait */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_release(watch)
+ * --------------------------------------------------------------------------
+ * Stops and deallocates watch and passes NULL in watch.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_release (fswatch_t *watch) {
+  
+  unsigned int index;
+  
+  if ((watch == NULL) || (*watch == NULL)) {
+    return;
+  } /* end if */
+  
+  if ((*watch)->dir != NULL) {
+    for (index = 0; index < (*watch)->count; index++) {
+      free((*watch)->dir[index]);
+    } /* end for */
+  } /* end if */
+  
+  /* closing the descriptor removes all its watches */
+  if ((*watch)->fd >= 0) {
+    close((*watch)->fd);
+  } /* end if */
+  
+  free((*watch)->wd);
+  free((*watch)->dir);
+  free(*watch);
+  *watch = NULL;
+} /* end fswatch_release */
+
+
+/* END OF FILE */
@@ -0,0 +1,463 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * fswatch-mac.c
+ *
+ * macOS implementation of file system change notification.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "fswatch.h"
+#include "m2c-common.h"
+
+#include <CoreServices/CoreServices.h>
+#include <dispatch/dispatch.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+
+/* --------------------------------------------------------------------------
+ * Latency of the event stream in seconds
+ * --------------------------------------------------------------------------
+ * FSEvents coalesces events within this interval before delivering them.
+ * ----------------------------------------------------------------------- */
+
+#define STREAM_LATENCY 0.05
+
+
+/* --------------------------------------------------------------------------
+ * Flags indicating that events have been dropped
+ * ----------------------------------------------------------------------- */
+
+#define DROPPED_EVENTS \
+  (kFSEventStreamEventFlagMustScanSubDirs | \
+   kFSEventStreamEventFlagUserDropped | \
+   kFSEventStreamEventFlagKernelDropped)
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the pending path table
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_CAPACITY 16
+
+
+/* --------------------------------------------------------------------------
+ * hidden type fswatch_s
+ * --------------------------------------------------------------------------
+ * Record type for a watch.  An event stream over all watched directories
+ * delivers events on a serial dispatch queue,  whose callback appends the
+ * paths of changed files to a pending table that fswatch_wait hands out.
+ * ----------------------------------------------------------------------- */
+
+struct fswatch_s {
+  /* dirs */          CFMutableArrayRef dirs;
+  /* stream */        FSEventStreamRef stream;
+  /* queue */         dispatch_queue_t queue;
+  /* lock */          pthread_mutex_t lock;
+  /* changed */       pthread_cond_t changed;
+  /* count */         unsigned int count;
+  /* capacity */      unsigned int capacity;
+  /* pending */       char **pending;
+  /* overflow */      bool overflow;
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void stream_callback
+  (ConstFSEventStreamRef stream, void *info, size_t count,
+   void *paths, const FSEventStreamEventFlags flags[],
+   const FSEventStreamEventId ids[]);
+
+static bool restart_stream (fswatch_t watch);
+
+static void stop_stream (fswatch_t watch);
+
+static void drain_queue (void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_new(status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+fswatch_t fswatch_new (fswatch_status_t *status) {
+  
+  fswatch_t watch;
+  
+  watch = malloc(sizeof(struct fswatch_s));
+  
+  if (watch == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  watch->dirs = CFArrayCreateMutable(NULL, 0, &kCFTypeArrayCallBacks);
+  watch->stream = NULL;
+  watch->queue = dispatch_queue_create("m2c.fswatch", DISPATCH_QUEUE_SERIAL);
+  watch->count = 0;
+  watch->capacity = INITIAL_CAPACITY;
+  watch->pending = malloc(INITIAL_CAPACITY * sizeof(char *));
+  watch->overflow = false;
+  pthread_mutex_init(&watch->lock, NULL);
+  pthread_cond_init(&watch->changed, NULL);
+  
+  if ((watch->dirs == NULL) ||
+      (watch->queue == NULL) || (watch->pending == NULL)) {
+    fswatch_release(&watch);
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+  return watch;
+} /* end fswatch_new */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_add_directory(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds directory path to watch.  Event streams cannot be extended,  the
+ * stream is replaced by one over all directories.  FSEvents reports changes
+ * within subdirectories as well,  which callers may ignore.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_add_directory
+  (fswatch_t watch, const char *path, fswatch_status_t *status) {
+  
+  CFStringRef dir;
+  struct stat st;
+  
+  if ((watch == NULL) || (path == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if ((stat(path, &st) != 0) || NOT(S_ISDIR(st.st_mode))) {
+    SET_STATUS(status, FSWATCH_STATUS_PATH_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  dir = CFStringCreateWithFileSystemRepresentation(NULL, path);
+  
+  if (dir == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  CFArrayAppendValue(watch->dirs, dir);
+  CFRelease(dir);
+  
+  if (NOT(restart_stream(watch))) {
+    SET_STATUS(status, FSWATCH_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+} /* end fswatch_add_directory */
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_wait(watch, timeout_ms, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Waits for the stream callback to post changes,  then takes all pending
+ * paths and calls handler for each outside of the lock.
+ * ----------------------------------------------------------------------- */
+
+bool fswatch_wait
+  (fswatch_t watch,
+   int timeout_ms,
+   fswatch_handler_t handler,
+   void *context,
+   fswatch_status_t *status) {
+  
+  struct timespec deadline;
+  struct timeval now;
+  unsigned int count, index;
+  char **pending;
+  bool overflow;
+  int result;
+  
+  if ((watch == NULL) || (handler == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  if (timeout_ms >= 0) {
+    gettimeofday(&now, NULL);
+    deadline.tv_sec = now.tv_sec + timeout_ms / 1000;
+    deadline.tv_nsec =
+      (long) now.tv_usec * 1000L + (long) (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec = deadline.tv_nsec - 1000000000L;
+    } /* end if */
+  } /* end if */
+  
+  pthread_mutex_lock(&watch->lock);
+  
+  result = 0;
+  while ((watch->count == 0) && NOT(watch->overflow) && (result == 0)) {
+    if (timeout_ms < 0) {
+      result = pthread_cond_wait(&watch->changed, &watch->lock);
+    }
+    else {
+      result =
+        pthread_cond_timedwait(&watch->changed, &watch->lock, &deadline);
+    } /* end if */
+  } /* end while */
+  
+  /* take the pending paths,  the callback starts a new table */
+  count = watch->count;
+  pending = watch->pending;
+  overflow = watch->overflow;
+  
+  if (count > 0) {
+    watch->pending = malloc(INITIAL_CAPACITY * sizeof(char *));
+    watch->capacity = INITIAL_CAPACITY;
+    watch->count = 0;
+    
+    if (watch->pending == NULL) {
+      watch->capacity = 0;
+    } /* end if */
+  } /* end if */
+  
+  watch->overflow = false;
+  
+  pthread_mutex_unlock(&watch->lock);
+  
+  if (count > 0) {
+    for (index = 0; index < count; index++) {
+      handler(pending[index], context);
+      free(pending[index]);
+    } /* end for */
+    free(pending);
+  } /* end if */
+  
+  if (overflow) {
+    SET_STATUS(status, FSWATCH_STATUS_OVERFLOW);
+    return true;
+  } /* end if */
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+  return (count > 0);
+} /* end fswatch_wait */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_release(watch)
+ * --------------------------------------------------------------------------
+ * Stops and deallocates watch and passes NULL in watch.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_release (fswatch_t *watch) {
+  
+  unsigned int index;
+  
+  if ((watch == NULL) || (*watch == NULL)) {
+    return;
+  } /* end if */
+  
+  stop_stream(*watch);
+  
+  if ((*watch)->queue != NULL) {
+    /* wait for a callback in progress */
+    dispatch_sync_f((*watch)->queue, NULL, drain_queue);
+    dispatch_release((*watch)->queue);
+  } /* end if */
+  
+  if ((*watch)->dirs != NULL) {
+    CFRelease((*watch)->dirs);
+  } /* end if */
+  
+  if ((*watch)->pending != NULL) {
+    for (index = 0; index < (*watch)->count; index++) {
+      free((*watch)->pending[index]);
+    } /* end for */
+    free((*watch)->pending);
+  } /* end if */
+  
+  pthread_cond_destroy(&(*watch)->changed);
+  pthread_mutex_destroy(&(*watch)->lock);
+  
+  free(*watch);
+  *watch = NULL;
+} /* end fswatch_release */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure stream_callback(stream, info, count, paths, flags, ids)
+ * --------------------------------------------------------------------------
+ * Event stream callback,  called on the dispatch queue of the watch passed
+ * in info.  Appends the paths of file events to the pending table  and
+ * wakes up a waiting caller.
+ * ----------------------------------------------------------------------- */
+
+static void stream_callback
+  (ConstFSEventStreamRef stream, void *info, size_t count,
+   void *paths, const FSEventStreamEventFlags flags[],
+   const FSEventStreamEventId ids[]) {
+  
+  unsigned int new_capacity;
+  char **path, **new_pending;
+  fswatch_t watch;
+  size_t index, length;
+  char *copy;
+  
+  (void) stream;
+  (void) ids;
+  
+  watch = (fswatch_t) info;
+  path = (char **) paths;
+  
+  pthread_mutex_lock(&watch->lock);
+  
+  for (index = 0; index < count; index++) {
+    if ((flags[index] & DROPPED_EVENTS) != 0) {
+      watch->overflow = true;
+      continue;
+    } /* end if */
+    
+    if ((flags[index] & kFSEventStreamEventFlagItemIsFile) == 0) {
+      continue;
+    } /* end if */
+    
+    if (watch->count == watch->capacity) {
+      new_capacity = (watch->capacity == 0) ?
+        INITIAL_CAPACITY : 2 * watch->capacity;
+      new_pending = realloc(watch->pending, new_capacity * sizeof(char *));
+      
+      if (new_pending == NULL) {
+        watch->overflow = true;
+        continue;
+      } /* end if */
+      
+      watch->pending = new_pending;
+      watch->capacity = new_capacity;
+    } /* end if */
+    
+    length = strlen(path[index]);
+    copy = malloc(length + 1);
+    
+    if (copy == NULL) {
+      watch->overflow = true;
+      continue;
+    } /* end if */
+    
+    memcpy(copy, path[index], length + 1);
+    watch->pending[watch->count] = copy;
+    watch->count++;
+  } /* end for */
+  
+  pthread_cond_broadcast(&watch->changed);
+  pthread_mutex_unlock(&watch->lock);
+} /* end stream_callback */
+
+
+/* --------------------------------------------------------------------------
+ * private function restart_stream(watch)
+ * --------------------------------------------------------------------------
+ * Replaces the event stream of watch by a new one over all its directories,
+ * reporting events since now.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool restart_stream (fswatch_t watch) {
+  
+  FSEventStreamContext stream_context;
+  
+  stop_stream(watch);
+  
+  memset(&stream_context, 0, sizeof(FSEventStreamContext));
+  stream_context.info = watch;
+  
+  watch->stream = FSEventStreamCreate(NULL, stream_callback,
+    &stream_context, watch->dirs, kFSEventStreamEventIdSinceNow,
+    STREAM_LATENCY, kFSEventStreamCreateFlagFileEvents |
+    kFSEventStreamCreateFlagNoDefer);
+  
+  if (watch->stream == NULL) {
+    return false;
+  } /* end if */
+  
+  FSEventStreamSetDispatchQueue(watch->stream, watch->queue);
+  
+  if (NOT(FSEventStreamStart(watch->stream))) {
+    stop_stream(watch);
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end restart_stream */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure stop_stream(watch)
+ * --------------------------------------------------------------------------
+ * Stops and releases the event stream of watch,  if any.
+ * ----------------------------------------------------------------------- */
+
+static void stop_stream (fswatch_t watch) {
+  
+  if (watch->stream == NULL) {
+    return;
+  } /* end if */
+  
+  FSEventStreamStop(watch->stream);
+  FSEventStreamInvalidate(watch->stream);
+  FSEventStreamRelease(watch->stream);
+  watch->stream = NULL;
+} /* end stop_stream */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure drain_queue(context)
+ * --------------------------------------------------------------------------
+ * Does nothing.  Run synchronously on the dispatch queue of a watch,  it
+ * returns once all callbacks queued before it have completed.
+ * ----------------------------------------------------------------------- */
+
+static void drain_queue (void *context) {
+  
+  (void) context;
+} /* end drain_queue */
+
+
+/* END OF FILE */
@@ -0,0 +1,552 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * fswatch-poll.c
+ *
+ * Polling implementation of file system change notification.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "fswatch.h"
+#include "m2c-common.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+
+/* --------------------------------------------------------------------------
+ * Interval between scans of the watched directories in milliseconds
+ * ----------------------------------------------------------------------- */
+
+#define POLL_INTERVAL_MS 250
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of directory and entry tables
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_CAPACITY 16
+
+
+/* --------------------------------------------------------------------------
+ * hidden type entry_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a directory entry as of the last scan.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* name */   char *name;
+  /* mtime */  time_t mtime;
+  /* size */   off_t size;
+} entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type snapshot_t
+ * --------------------------------------------------------------------------
+ * Record type for the entries of a directory as of the last scan,  sorted
+ * by name.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* count */     unsigned int count;
+  /* capacity */  unsigned int capacity;
+  /* entry */     entry_t *entry;
+} snapshot_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type fswatch_s
+ * --------------------------------------------------------------------------
+ * Record type for a watch,  the path and last snapshot of each directory.
+ * ----------------------------------------------------------------------- */
+
+struct fswatch_s {
+  /* count */     unsigned int count;
+  /* capacity */  unsigned int capacity;
+  /* dir */       char **dir;
+  /* snapshot */  snapshot_t *snapshot;
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool scan_directory (const char *dir, snapshot_t *snapshot);
+
+static int compare_entries (const void *left, const void *right);
+
+static bool report_differences
+  (const char *dir, const snapshot_t *old, const snapshot_t *new,
+   fswatch_handler_t handler, void *context);
+
+static void report_entry
+  (const char *dir, const char *name,
+   fswatch_handler_t handler, void *context);
+
+static void clear_snapshot (snapshot_t *snapshot);
+
+static void sleep_ms (int ms);
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_new(status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+fswatch_t fswatch_new (fswatch_status_t *status) {
+  
+  fswatch_t watch;
+  
+  watch = malloc(sizeof(struct fswatch_s));
+  
+  if (watch == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  watch->count = 0;
+  watch->capacity = INITIAL_CAPACITY;
+  watch->dir = malloc(INITIAL_CAPACITY * sizeof(char *));
+  watch->snapshot = malloc(INITIAL_CAPACITY * sizeof(snapshot_t));
+  
+  if ((watch->dir == NULL) || (watch->snapshot == NULL)) {
+    fswatch_release(&watch);
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+  return watch;
+} /* end fswatch_new */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_add_directory(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds directory path to watch and takes its first snapshot.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_add_directory
+  (fswatch_t watch, const char *path, fswatch_status_t *status) {
+  
+  unsigned int new_capacity;
+  snapshot_t *new_snapshot;
+  struct stat st;
+  char **new_dir;
+  size_t length;
+  
+  if ((watch == NULL) || (path == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if ((stat(path, &st) != 0) || NOT(S_ISDIR(st.st_mode))) {
+    SET_STATUS(status, FSWATCH_STATUS_PATH_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  if (watch->count == watch->capacity) {
+    new_capacity = 2 * watch->capacity;
+    new_dir = realloc(watch->dir, new_capacity * sizeof(char *));
+    if (new_dir != NULL) {
+      watch->dir = new_dir;
+    } /* end if */
+    new_snapshot =
+      realloc(watch->snapshot, new_capacity * sizeof(snapshot_t));
+    if (new_snapshot != NULL) {
+      watch->snapshot = new_snapshot;
+    } /* end if */
+    
+    if ((new_dir == NULL) || (new_snapshot == NULL)) {
+      SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    watch->capacity = new_capacity;
+  } /* end if */
+  
+  length = strlen(path);
+  watch->dir[watch->count] = malloc(length + 1);
+  
+  if (watch->dir[watch->count] == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  memcpy(watch->dir[watch->count], path, length + 1);
+  
+  if (NOT(scan_directory(path, &watch->snapshot[watch->count]))) {
+    free(watch->dir[watch->count]);
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  watch->count++;
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+} /* end fswatch_add_directory */
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_wait(watch, timeout_ms, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Rescans all watched directories every POLL_INTERVAL_MS milliseconds  and
+ * reports entries added,  removed,  or whose modification time or size
+ * differ from the previous scan,  until a scan finds changes or the timeout
+ * expires.
+ * ----------------------------------------------------------------------- */
+
+bool fswatch_wait
+  (fswatch_t watch,
+   int timeout_ms,
+   fswatch_handler_t handler,
+   void *context,
+   fswatch_status_t *status) {
+  
+  snapshot_t current;
+  unsigned int index;
+  int waited;
+  bool reported;
+  
+  if ((watch == NULL) || (handler == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  waited = 0;
+  reported = false;
+  
+  while (NOT(reported)) {
+    for (index = 0; index < watch->count; index++) {
+      if (NOT(scan_directory(watch->dir[index], &current))) {
+        SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+        return reported;
+      } /* end if */
+      
+      if (report_differences(watch->dir[index],
+          &watch->snapshot[index], &current, handler, context)) {
+        reported = true;
+      } /* end if */
+      
+      clear_snapshot(&watch->snapshot[index]);
+      watch->snapshot[index] = current;
+    } /* end for */
+    
+    if (NOT(reported)) {
+      if ((timeout_ms >= 0) && (waited >= timeout_ms)) {
+        break;
+      } /* end if */
+      
+      sleep_ms(POLL_INTERVAL_MS);
+      waited = waited + POLL_INTERVAL_MS;
+    } /* end if */
+  } /* end while */
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+  return reported;
+} /* end fswatch_wait */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_release(watch)
+ * --------------------------------------------------------------------------
+ * Deallocates watch and passes NULL in watch.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_release (fswatch_t *watch) {
+  
+  unsigned int index;
+  
+  if ((watch == NULL) || (*watch == NULL)) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < (*watch)->count; index++) {
+    free((*watch)->dir[index]);
+    clear_snapshot(&(*watch)->snapshot[index]);
+  } /* end for */
+  
+  free((*watch)->dir);
+  free((*watch)->snapshot);
+  free(*watch);
+  *watch = NULL;
+} /* end fswatch_release */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function scan_directory(dir, snapshot)
+ * --------------------------------------------------------------------------
+ * Passes a new snapshot of the regular files in directory dir in snapshot,
+ * sorted by name.  A directory that cannot be read yields an empty snapshot.
+ * Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool scan_directory (const char *dir, snapshot_t *snapshot) {
+  
+  struct dirent *dir_entry;
+  size_t dir_length, name_length;
+  entry_t *new_entry;
+  struct stat st;
+  char *path;
+  DIR *handle;
+  
+  snapshot->count = 0;
+  snapshot->capacity = INITIAL_CAPACITY;
+  snapshot->entry = malloc(INITIAL_CAPACITY * sizeof(entry_t));
+  
+  if (snapshot->entry == NULL) {
+    return false;
+  } /* end if */
+  
+  handle = opendir(dir);
+  
+  if (handle == NULL) {
+    return true;
+  } /* end if */
+  
+  dir_length = strlen(dir);
+  
+  while ((dir_entry = readdir(handle)) != NULL) {
+    name_length = strlen(dir_entry->d_name);
+    path = malloc(dir_length + name_length + 2);
+    
+    if (path == NULL) {
+      closedir(handle);
+      clear_snapshot(snapshot);
+      return false;
+    } /* end if */
+    
+    memcpy(path, dir, dir_length);
+    path[dir_length] = '/';
+    memcpy(path + dir_length + 1, dir_entry->d_name, name_length + 1);
+    
+    if ((stat(path, &st) != 0) || NOT(S_ISREG(st.st_mode))) {
+      free(path);
+      continue;
+    } /* end if */
+    
+    free(path);
+    
+    if (snapshot->count == snapshot->capacity) {
+      new_entry = realloc(snapshot->entry,
+        2 * snapshot->capacity * sizeof(entry_t));
+      
+      if (new_entry == NULL) {
+        closedir(handle);
+        clear_snapshot(snapshot);
+        return false;
+      } /* end if */
+      
+      snapshot->entry = new_entry;
+      snapshot->capacity = 2 * snapshot->capacity;
+    } /* end if */
+    
+    new_entry = &snapshot->entry[snapshot->count];
+    new_entry->name = malloc(name_length + 1);
+    
+    if (new_entry->name == NULL) {
+      closedir(handle);
+      clear_snapshot(snapshot);
+      return false;
+    } /* end if */
+    
+    memcpy(new_entry->name, dir_entry->d_name, name_length + 1);
+    new_entry->mtime = st.st_mtime;
+    new_entry->size = st.st_size;
+    snapshot->count++;
+  } /* end while */
+  
+  closedir(handle);
+  
+  qsort(snapshot->entry, snapshot->count, sizeof(entry_t), compare_entries);
+  
+  return true;
+} /* end scan_directory */
+
+
+/* --------------------------------------------------------------------------
+ * private function compare_entries(left, right)
+ * --------------------------------------------------------------------------
+ * Compares two entries by name for qsort.
+ * ----------------------------------------------------------------------- */
+
+static int compare_entries (const void *left, const void *right) {
+  
+  return strcmp(((const entry_t *) left)->name,
+    ((const entry_t *) right)->name);
+} /* end compare_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private function report_differences(dir, old, new, handler, context)
+ * --------------------------------------------------------------------------
+ * Merges the sorted snapshots old and new of directory dir  and calls
+ * handler for each entry that is only in one of them or whose modification
+ * time or size differ.  Returns true if any entry was reported.
+ * ----------------------------------------------------------------------- */
+
+static bool report_differences
+  (const char *dir, const snapshot_t *old, const snapshot_t *new,
+   fswatch_handler_t handler, void *context) {
+  
+  unsigned int old_index, new_index;
+  const entry_t *old_entry, *new_entry;
+  bool reported;
+  int order;
+  
+  old_index = 0;
+  new_index = 0;
+  reported = false;
+  
+  while ((old_index < old->count) || (new_index < new->count)) {
+    old_entry = (old_index < old->count) ? &old->entry[old_index] : NULL;
+    new_entry = (new_index < new->count) ? &new->entry[new_index] : NULL;
+    
+    if (old_entry == NULL) {
+      order = 1;
+    }
+    else if (new_entry == NULL) {
+      order = -1;
+    }
+    else {
+      order = strcmp(old_entry->name, new_entry->name);
+    } /* end if */
+    
+    if (order < 0) {
+      /* removed */
+      report_entry(dir, old_entry->name, handler, context);
+      reported = true;
+      old_index++;
+    }
+    else if (order > 0) {
+      /* added */
+      report_entry(dir, new_entry->name, handler, context);
+      reported = true;
+      new_index++;
+    }
+    else /* present in both */ {
+      if ((old_entry->mtime != new_entry->mtime) ||
+          (old_entry->size != new_entry->size)) {
+        report_entry(dir, new_entry->name, handler, context);
+        reported = true;
+      } /* end if */
+      old_index++;
+      new_index++;
+    } /* end if */
+  } /* end while */
+  
+  return reported;
+} /* end report_differences */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_entry(dir, name, handler, context)
+ * --------------------------------------------------------------------------
+ * Calls handler with the path of entry name in directory dir.
+ * ----------------------------------------------------------------------- */
+
+static void report_entry
+  (const char *dir, const char *name,
+   fswatch_handler_t handler, void *context) {
+  
+  size_t dir_length, name_length;
+  char *path;
+  
+  dir_length = strlen(dir);
+  name_length = strlen(name);
+  path = malloc(dir_length + name_length + 2);
+  
+  /* a change that cannot be reported is picked up by the next scan */
+  if (path == NULL) {
+    return;
+  } /* end if */
+  
+  memcpy(path, dir, dir_length);
+  path[dir_length] = '/';
+  memcpy(path + dir_length + 1, name, name_length + 1);
+  
+  handler(path, context);
+  
+  free(path);
+} /* end report_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure clear_snapshot(snapshot)
+ * --------------------------------------------------------------------------
+ * Deallocates the entries of snapshot.
+ * ----------------------------------------------------------------------- */
+
+static void clear_snapshot (snapshot_t *snapshot) {
+  
+  unsigned int index;
+  
+  if (snapshot->entry == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < snapshot->count; index++) {
+    free(snapshot->entry[index].name);
+  } /* end for */
+  
+  free(snapshot->entry);
+  snapshot->entry = NULL;
+  snapshot->count = 0;
+  snapshot->capacity = 0;
+} /* end clear_snapshot */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure sleep_ms(ms)
+ * --------------------------------------------------------------------------
+ * Suspends the calling thread for ms milliseconds.
+ * ----------------------------------------------------------------------- */
+
+static void sleep_ms (int ms) {
+  
+  struct timespec interval;
+  
+  interval.tv_sec = ms / 1000;
+  interval.tv_nsec = (long) (ms % 1000) * 1000000L;
+  
+  nanosleep(&interval, NULL);
+} /* end sleep_ms */
+
+
+/* END OF FILE */
@@ -0,0 +1,397 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * fswatch-win.c
+ *
+ * Windows implementation of file system change notification.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#include "fswatch.h"
+#include "m2c-common.h"
+
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Changes of interest,  entries created,  renamed,  deleted or written
+ * ----------------------------------------------------------------------- */
+
+#define WATCH_FILTER \
+  (FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | \
+   FILE_NOTIFY_CHANGE_SIZE)
+
+
+/* --------------------------------------------------------------------------
+ * Size of the notification buffer of a directory in DWORDs
+ * ----------------------------------------------------------------------- */
+
+#define NOTIFY_BUFFER_SIZE 16384
+
+
+/* --------------------------------------------------------------------------
+ * Maximum number of directories per watch
+ * --------------------------------------------------------------------------
+ * Directories are waited on with WaitForMultipleObjects,  which takes at
+ * most MAXIMUM_WAIT_OBJECTS handles.
+ * ----------------------------------------------------------------------- */
+
+#define MAX_DIRECTORIES MAXIMUM_WAIT_OBJECTS
+
+
+/* --------------------------------------------------------------------------
+ * hidden type dir_watch_t
+ * --------------------------------------------------------------------------
+ * Record type for a watched directory with its pending overlapped read.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* path */        char *path;
+  /* handle */      HANDLE handle;
+  /* overlapped */  OVERLAPPED overlapped;
+  /* buffer */      DWORD buffer[NOTIFY_BUFFER_SIZE];
+} dir_watch_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type fswatch_s
+ * --------------------------------------------------------------------------
+ * Record type for a watch,  its directories and their completion events.
+ * ----------------------------------------------------------------------- */
+
+struct fswatch_s {
+  /* count */  unsigned int count;
+  /* dir */    dir_watch_t *dir[MAX_DIRECTORIES];
+  /* event */  HANDLE event[MAX_DIRECTORIES];
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool start_read (dir_watch_t *dir);
+
+static bool report_changes
+  (dir_watch_t *dir, fswatch_handler_t handler, void *context);
+
+static void release_dir (dir_watch_t *dir);
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_new(status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+fswatch_t fswatch_new (fswatch_status_t *status) {
+  
+  fswatch_t watch;
+  
+  watch = malloc(sizeof(struct fswatch_s));
+  
+  if (watch == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  watch->count = 0;
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+  return watch;
+} /* end fswatch_new */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_add_directory(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Opens directory path for change notification and starts the first read.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_add_directory
+  (fswatch_t watch, const char *path, fswatch_status_t *status) {
+  
+  dir_watch_t *dir;
+  size_t length;
+  
+  if ((watch == NULL) || (path == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (watch->count == MAX_DIRECTORIES) {
+    SET_STATUS(status, FSWATCH_STATUS_LIMIT_EXCEEDED);
+    return;
+  } /* end if */
+  
+  dir = calloc(1, sizeof(dir_watch_t));
+  
+  if (dir == NULL) {
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  length = strlen(path);
+  dir->path = malloc(length + 1);
+  dir->handle = INVALID_HANDLE_VALUE;
+  dir->overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+  
+  if ((dir->path == NULL) || (dir->overlapped.hEvent == NULL)) {
+    release_dir(dir);
+    SET_STATUS(status, FSWATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  memcpy(dir->path, path, length + 1);
+  
+  dir->handle = CreateFileA(path, FILE_LIST_DIRECTORY,
+    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+    OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+  
+  if (dir->handle == INVALID_HANDLE_VALUE) {
+    release_dir(dir);
+    SET_STATUS(status, FSWATCH_STATUS_PATH_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  if (NOT(start_read(dir))) {
+    release_dir(dir);
+    SET_STATUS(status, FSWATCH_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  watch->dir[watch->count] = dir;
+  watch->event[watch->count] = dir->overlapped.hEvent;
+  watch->count++;
+  
+  SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+} /* end fswatch_add_directory */
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_wait(watch, timeout_ms, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Waits for the first completed read,  then reports the changes of every
+ * directory whose read has completed and restarts those reads.
+ * ----------------------------------------------------------------------- */
+
+bool fswatch_wait
+  (fswatch_t watch,
+   int timeout_ms,
+   fswatch_handler_t handler,
+   void *context,
+   fswatch_status_t *status) {
+  
+  fswatch_status_t result;
+  unsigned int index;
+  DWORD timeout, ready;
+  bool reported;
+  
+  if ((watch == NULL) || (handler == NULL)) {
+    SET_STATUS(status, FSWATCH_STATUS_INVALID_REFERENCE);
+    return false;
+  } /* end if */
+  
+  if (watch->count == 0) {
+    if (timeout_ms >= 0) {
+      Sleep((DWORD) timeout_ms);
+    } /* end if */
+    SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+    return false;
+  } /* end if */
+  
+  timeout = (timeout_ms < 0) ? INFINITE : (DWORD) timeout_ms;
+  ready = WaitForMultipleObjects(watch->count, watch->event, FALSE, timeout);
+  
+  if (ready == WAIT_TIMEOUT) {
+    SET_STATUS(status, FSWATCH_STATUS_SUCCESS);
+    return false;
+  } /* end if */
+  
+  if ((ready < WAIT_OBJECT_0) || (ready >= WAIT_OBJECT_0 + watch->count)) {
+    SET_STATUS(status, FSWATCH_STATUS_IO_ERROR);
+    return false;
+  } /* end if */
+  
+  result = FSWATCH_STATUS_SUCCESS;
+  reported = false;
+  
+  /* the first ready directory and any others that completed meanwhile */
+  for (index = ready - WAIT_OBJECT_0; index < watch->count; index++) {
+    if (WaitForSingleObject(watch->event[index], 0) != WAIT_OBJECT_0) {
+      continue;
+    } /* end if */
+    
+    if (NOT(report_changes(watch->dir[index], handler, context))) {
+      result = FSWATCH_STATUS_OVERFLOW;
+    } /* end if */
+    reported = true;
+    
+    if (NOT(start_read(watch->dir[index]))) {
+      result = FSWATCH_STATUS_IO_ERROR;
+    } /* end if */
+  } /* end for */
+  
+  SET_STATUS(status, result);
+  return reported;
+} /* end fswatch_wait */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_release(watch)
+ * --------------------------------------------------------------------------
+ * Cancels all reads,  closes all directories and deallocates watch.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_release (fswatch_t *watch) {
+  
+  unsigned int index;
+  
+  if ((watch == NULL) || (*watch == NULL)) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < (*watch)->count; index++) {
+    release_dir((*watch)->dir[index]);
+  } /* end for */
+  
+  free(*watch);
+  *watch = NULL;
+} /* end fswatch_release */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function start_read(dir)
+ * --------------------------------------------------------------------------
+ * Starts an overlapped read of change notifications for dir.  Returns true
+ * on success.
+ * ----------------------------------------------------------------------- */
+
+static bool start_read (dir_watch_t *dir) {
+  
+  ResetEvent(dir->overlapped.hEvent);
+  
+  return ReadDirectoryChangesW(dir->handle, dir->buffer, sizeof(dir->buffer),
+    FALSE, WATCH_FILTER, NULL, &dir->overlapped, NULL) != 0;
+} /* end start_read */
+
+
+/* --------------------------------------------------------------------------
+ * private function report_changes(dir, handler, context)
+ * --------------------------------------------------------------------------
+ * Calls handler for each notification in the completed read of dir,  with
+ * the file name converted to UTF-8.  Returns false if notifications have
+ * been dropped because the buffer overflowed.
+ * ----------------------------------------------------------------------- */
+
+static bool report_changes
+  (dir_watch_t *dir, fswatch_handler_t handler, void *context) {
+  
+  const FILE_NOTIFY_INFORMATION *info;
+  size_t dir_length;
+  DWORD transferred;
+  char *path;
+  int name_size;
+  
+  if (NOT(GetOverlappedResult(dir->handle,
+      &dir->overlapped, &transferred, FALSE))) {
+    return false;
+  } /* end if */
+  
+  /* zero bytes transferred means the buffer overflowed */
+  if (transferred == 0) {
+    return false;
+  } /* end if */
+  
+  dir_length = strlen(dir->path);
+  info = (const FILE_NOTIFY_INFORMATION *) dir->buffer;
+  
+  while (true) {
+    name_size = WideCharToMultiByte(CP_UTF8, 0, info->FileName,
+      (int) (info->FileNameLength / sizeof(WCHAR)), NULL, 0, NULL, NULL);
+    path = malloc(dir_length + (size_t) name_size + 2);
+    
+    if (path != NULL) {
+      memcpy(path, dir->path, dir_length);
+      path[dir_length] = '\\';
+      WideCharToMultiByte(CP_UTF8, 0, info->FileName,
+        (int) (info->FileNameLength / sizeof(WCHAR)),
+        path + dir_length + 1, name_size, NULL, NULL);
+      path[dir_length + 1 + (size_t) name_size] = ASCII_NUL;
+      
+      handler(path, context);
+      free(path);
+    } /* end if */
+    
+    if (info->NextEntryOffset == 0) {
+      break;
+    } /* end if */
+    
+    info = (const FILE_NOTIFY_INFORMATION *)
+      ((const char *) info + info->NextEntryOffset);
+  } /* end while */
+  
+  return true;
+} /* end report_changes */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_dir(dir)
+ * --------------------------------------------------------------------------
+ * Cancels the pending read of dir,  closes its handles and deallocates it.
+ * ----------------------------------------------------------------------- */
+
+static void release_dir (dir_watch_t *dir) {
+  
+  DWORD transferred;
+  
+  if (dir->handle != INVALID_HANDLE_VALUE) {
+    /* the buffer must stay valid until the read is cancelled */
+    if (CancelIo(dir->handle)) {
+      GetOverlappedResult(dir->handle, &dir->overlapped, &transferred, TRUE);
+    } /* end if */
+    CloseHandle(dir->handle);
+  } /* end if */
+  
+  if (dir->overlapped.hEvent != NULL) {
+    CloseHandle(dir->overlapped.hEvent);
+  } /* end if */
+  
+  free(dir->path);
+  free(dir);
+} /* end release_dir */
+
+
+/* END OF FILE */
@@ -0,0 +1,70 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * fswatch.c
+ *
+ * Aggregator to select platform specific implementation.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+
+/* --------------------------------------------------------------------------
+ * Select implementation for Linux host platforms
+ * ----------------------------------------------------------------------- */
+
+#if defined(__linux__)
+#include "fswatch-linux.c"
+
+
+/* --------------------------------------------------------------------------
+ * Select implementation for macOS host platforms
+ * ----------------------------------------------------------------------- */
+
+#elif defined(__APPLE__) && defined(__MACH__)
+#include "fswatch-mac.c"
+
+
+/* --------------------------------------------------------------------------
+ * Select implementation for Windows host platforms
+ * ----------------------------------------------------------------------- */
+
+#elif (defined(_WIN32)) && (!defined(__DJGPP__))
+#include "fswatch-win.c"
+
+
+/* --------------------------------------------------------------------------
+ * Select polling implementation for other POSIX host platforms
+ * ----------------------------------------------------------------------- */
+
+#else
+#include "fswatch-poll.c"
+#endif
+
+
+/* END OF FILE */
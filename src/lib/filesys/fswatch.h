@@ -0,0 +1,147 @@
+/* M2C Modula-2 Compiler & Translator
+ * Copyright (c) 2015-2016 Benjamin Kowarsch
+ *
+ * @synopsis
+ *
+ * M2C is a compiler and translator for the classic Modula-2 programming
+ * language as described in the 3rd and 4th editions of Niklaus Wirth's
+ * book "Programming in Modula-2" (PIM) published by Springer Verlag.
+ *
+ * In compiler mode, M2C compiles Modula-2 source via C to object files or
+ * executables using the host system's resident C compiler and linker.
+ * In translator mode, it translates Modula-2 source to C source.
+ *
+ * Further information at http://savannah.nongnu.org/projects/m2c/
+ *
+ * @file
+ *
+ * fswatch.h
+ *
+ * Platform independent interface to file system change notification.
+ *
+ * @license
+ *
+ * M2C is free software: you can redistribute and/or modify it under the
+ * terms of the GNU Lesser General Public License (LGPL) either version 2.1
+ * or at your choice version 3 as published by the Free Software Foundation.
+ *
+ * M2C is distributed in the hope that it will be useful,  but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  Read the license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with m2c.  If not, see <https://www.gnu.org/copyleft/lesser.html>.
+ */
+
+#ifndef FSWATCH_H
+#define FSWATCH_H
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * File system watches
+ * --------------------------------------------------------------------------
+ * A watch reports changes to the entries of a set of directories:  files
+ * written,  created,  renamed or deleted.  It is implemented on inotify on
+ * Linux,  on FSEvents on macOS,  on ReadDirectoryChangesW on Windows  and
+ * by periodically comparing the modification times and sizes of entries on
+ * other hosts.  Each change is reported by the pathname of the entry,  the
+ * path of its watched directory joined with its name.  A burst of writes to
+ * one file may be reported more than once,  callers should collect changes
+ * until the watch has been quiet for a moment.
+ *
+ * When a host drops notifications,  the watch reports an overflow and the
+ * caller must assume that any entry may have changed.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type fswatch_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a file system watch.
+ * ----------------------------------------------------------------------- */
+
+typedef struct fswatch_s *fswatch_t;
+
+
+/* --------------------------------------------------------------------------
+ * type fswatch_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on file system watches.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  FSWATCH_STATUS_SUCCESS,
+  FSWATCH_STATUS_INVALID_REFERENCE,
+  FSWATCH_STATUS_PATH_NOT_FOUND,
+  FSWATCH_STATUS_LIMIT_EXCEEDED,
+  FSWATCH_STATUS_OVERFLOW,
+  FSWATCH_STATUS_IO_ERROR,
+  FSWATCH_STATUS_ALLOCATION_FAILED
+} fswatch_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type fswatch_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure called with the pathname of each changed entry.  The
+ * pathname is valid only during the call.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*fswatch_handler_t) (const char *path, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_new(status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories,  or NULL on failure.  Passes the
+ * status of the operation in status,  unless NULL.
+ * ----------------------------------------------------------------------- */
+
+fswatch_t fswatch_new (fswatch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_add_directory(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds directory path to watch.  Changes to its entries are reported from
+ * now on,  changes within its subdirectories are not,  those must be added
+ * separately.  Passes FSWATCH_STATUS_LIMIT_EXCEEDED in status  if the host
+ * limit of watched directories has been reached.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_add_directory
+  (fswatch_t watch, const char *path, fswatch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function fswatch_wait(watch, timeout_ms, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Waits up to timeout_ms milliseconds,  or indefinitely if timeout_ms is
+ * negative,  for changes to the watched directories  and calls handler with
+ * context for every change received.  Returns true if any change has been
+ * reported,  false on timeout or failure.  Passes FSWATCH_STATUS_OVERFLOW
+ * in status and returns true  if notifications have been dropped.
+ * ----------------------------------------------------------------------- */
+
+bool fswatch_wait
+  (fswatch_t watch,
+   int timeout_ms,
+   fswatch_handler_t handler,
+   void *context,
+   fswatch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure fswatch_release(watch)
+ * --------------------------------------------------------------------------
+ * Stops and deallocates watch and passes NULL in watch.
+ * ----------------------------------------------------------------------- */
+
+void fswatch_release (fswatch_t *watch);
+
+
+#endif /* FSWATCH_H */
+
+/* END OF FILE */
@@ -8,16 +8,127 @@
 #ifndef HASH_H
 #define HASH_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
 // initial value
 #define HASH_INITIAL 0
 
 // iterative value
 #define HASH_NEXT_CHAR(_hash,_ch) \
-    (_ch + (_hash << 6) + (_hash << 16) - _hash)
+    ((_ch) + ((_hash) << 6) + ((_hash) << 16) - (_hash))
 
 // final value
-#define HASH_FINAL(_hash) (hash & 0x7FFFFFFF)
+#define HASH_FINAL(_hash) ((_hash) & 0x7FFFFFFF)
+
+
+/*  Word-at-a-time hash
+ *
+ *  hash_bytes(data, length) hashes a complete byte sequence  eight bytes at
+ *  a time using the multiply-and-fold mixing of wyhash.  Use it  where all
+ *  bytes are at hand;  the macros above remain for hashing one character at
+ *  a time while scanning.  The two produce different values and must not be
+ *  mixed for keys of the same table.  Results depend on byte order and are
+ *  not meant to be stored.  Like HASH_FINAL, the result has 31 bits.
+ */
+
+#define HASH_SECRET0 0xa0761d6478bd642fULL
+#define HASH_SECRET1 0xe7037ed1a0b428dbULL
+#define HASH_SECRET2 0x8ebc6af09c88c6e3ULL
+
+// folded 64 x 64 -> 128 bit product
+static inline uint64_t hash_mum (uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = (__uint128_t) a * b;
+  return (uint64_t) r ^ (uint64_t) (r >> 64);
+#else
+  uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t) a, lb = (uint32_t) b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32), c = t < rl, lo, hi;
+  lo = t + (rm1 << 32); c += lo < t;
+  hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  return lo ^ hi;
+#endif
+} /* end hash_mum */
+
+// unaligned load of eight bytes
+static inline uint64_t hash_load64 (const unsigned char *p) {
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+} /* end hash_load64 */
+
+// unaligned load of one to eight bytes, zero extended
+static inline uint64_t hash_load_tail (const unsigned char *p, size_t n) {
+  uint64_t w = 0;
+  memcpy(&w, p, n);
+  return w;
+} /* end hash_load_tail */
+
+static inline uint32_t hash_bytes (const void *data, size_t length) {
+  const unsigned char *p = (const unsigned char *) data;
+  uint64_t h = HASH_SECRET0 ^ (uint64_t) length;
+  size_t n = length;
+
+  // sixteen bytes per step
+  while (n > 16) {
+    h = hash_mum(hash_load64(p) ^ HASH_SECRET1, hash_load64(p + 8) ^ h);
+    p += 16;
+    n -= 16;
+  } /* end while */
+
+  // remaining one to sixteen bytes
+  if (n > 8) {
+    h = hash_mum(hash_load64(p) ^ HASH_SECRET1,
+                 hash_load_tail(p + 8, n - 8) ^ h);
+  }
+  else if (n > 0) {
+    h = hash_mum(hash_load_tail(p, n) ^ HASH_SECRET1, h);
+  } /* end if */
+
+  h = hash_mum(h ^ HASH_SECRET2, (uint64_t) length ^ HASH_SECRET1);
+
+  return (uint32_t) (h ^ (h >> 32)) & 0x7FFFFFFF;
+} /* end hash_bytes */
+
+
+/*  Bloom filter probes
+ *
+ *  bloom_add(filter, bits, key) sets and bloom_may_contain(filter, bits, key)
+ *  tests two bits for a hash key in a filter of bits bits stored in 32-bit
+ *  words, where bits is a power of two of at least 32. The bit positions are
+ *  taken from the high bits of two multiplicative mixes of the key, so they
+ *  do not follow the low bits by which tables index the same keys. A clear
+ *  bit proves the key absent, two set bits may be a false positive. With
+ *  eight bits per key, about one in twenty absent keys passes the filter.
+ */
+
+#define BLOOM_MIX1 0x9E3779B1U
+#define BLOOM_MIX2 0x85EBCA77U
+
+// bit position of a mixed key in a filter of mask + 1 bits
+static inline uint32_t bloom_bit (uint32_t mixed, uint32_t mask) {
+  return ((mixed >> 16) | (mixed << 16)) & mask;
+} /* end bloom_bit */
+
+static inline void bloom_add (uint32_t *filter, uint32_t bits, uint32_t key) {
+  uint32_t b1 = bloom_bit(key * BLOOM_MIX1, bits - 1);
+  uint32_t b2 = bloom_bit(key * BLOOM_MIX2, bits - 1);
+
+  filter[b1 >> 5] |= (uint32_t) 1 << (b1 & 31);
+  filter[b2 >> 5] |= (uint32_t) 1 << (b2 & 31);
+} /* end bloom_add */
+
+static inline int bloom_may_contain
+  (const uint32_t *filter, uint32_t bits, uint32_t key) {
+  uint32_t b1 = bloom_bit(key * BLOOM_MIX1, bits - 1);
+  uint32_t b2 = bloom_bit(key * BLOOM_MIX2, bits - 1);
+
+  return ((filter[b1 >> 5] >> (b1 & 31)) & 1) &&
+    ((filter[b2 >> 5] >> (b2 & 31)) & 1);
+} /* end bloom_may_contain */
 
 #endif /* HASH_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -52,6 +52,9 @@ typedef enum {
   FILEIO_STATUS_FILE_NOT_FOUND,
   FILEIO_STATUS_ACCESS_DENIED,
   FILEIO_STATUS_DEVICE_ERROR,
+  FILEIO_STATUS_ALLOCATION_FAILED,
+  FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF,
+  FILEIO_STATUS_LEXEME_TOO_LONG,
   /* ... */
 } fileio_status_t;
 
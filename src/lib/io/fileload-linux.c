@@ -0,0 +1,678 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * fileload-linux.c                                                          *
+ *                                                                           *
+ * Linux io_uring implementation of batched file loading.                    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <time.h>
+
+
+/* --------------------------------------------------------------------------
+ * Largest number of bytes requested by a single read,  larger files are
+ * read by several reads in sequence
+ * ----------------------------------------------------------------------- */
+
+#define URING_MAX_READ (1UL << 30)
+
+
+/* --------------------------------------------------------------------------
+ * Interval at which completions are polled if the ring cannot be entered
+ * ----------------------------------------------------------------------- */
+
+#define URING_POLL_INTERVAL_NS 1000000L
+
+
+/* --------------------------------------------------------------------------
+ * private type uring_read_t
+ * --------------------------------------------------------------------------
+ * Record type for the read of a file on the ring,  with its descriptor,
+ * buffer,  size at open and the number of bytes read so far.  Field iov
+ * describes the part of the buffer requested by the read in flight.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* fd */      int fd;
+  /* chars */   char *chars;
+  /* size */    size_t size;
+  /* offset */  size_t offset;
+  /* iov */     struct iovec iov;
+} uring_read_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type backend_s
+ * --------------------------------------------------------------------------
+ * Record type for the state of reads.  If field use_uring is set,  reads are
+ * queued on an io_uring whose mapped rings are described by the fields
+ * that follow,  otherwise they are performed by the pool of reader threads.
+ *
+ * Field queued holds the number of reads queued but not yet submitted,
+ * field in_flight the number of reads submitted but not yet completed,
+ * their sum never exceeds depth.  Field next holds the index of the next
+ * file to open.  Field stopping is set while the batch is released,
+ * completed reads are then discarded.  All fields are protected by the
+ * lock of the batch.
+ * ----------------------------------------------------------------------- */
+
+struct backend_s {
+  /* use_uring */     bool use_uring;
+  /* ring_fd */       int ring_fd;
+  /* sq_ring */       void *sq_ring;
+  /* sq_ring_size */  size_t sq_ring_size;
+  /* cq_ring */       void *cq_ring;
+  /* cq_ring_size */  size_t cq_ring_size;
+  /* sqes */          struct io_uring_sqe *sqes;
+  /* sqes_size */     size_t sqes_size;
+  /* sq_tail */       unsigned *sq_tail;
+  /* sq_mask */       unsigned *sq_mask;
+  /* sq_array */      unsigned *sq_array;
+  /* cq_head */       unsigned *cq_head;
+  /* cq_tail */       unsigned *cq_tail;
+  /* cq_mask */       unsigned *cq_mask;
+  /* cqes */          struct io_uring_cqe *cqes;
+  /* depth */         unsigned depth;
+  /* queued */        unsigned queued;
+  /* in_flight */     unsigned in_flight;
+  /* stopping */      bool stopping;
+  /* next */          uint_t next;
+  /* read */          uring_read_t *read;
+  /* pool */          pool_t pool;
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool uring_setup (fileload_t batch);
+
+static void uring_fill (fileload_t batch);
+
+static void uring_queue_read (backend_t *backend, uint_t index);
+
+static bool uring_enter (backend_t *backend, unsigned min_complete);
+
+static void uring_reap (fileload_t batch);
+
+static void uring_finish_read
+  (fileload_t batch, uint_t index, fileio_status_t status);
+
+static void uring_read_rest (fileload_t batch, uint_t index);
+
+static void uring_fall_back (fileload_t batch);
+
+static void uring_close (backend_t *backend);
+
+
+/* --------------------------------------------------------------------------
+ * private function backend_start(batch)
+ * --------------------------------------------------------------------------
+ * Allocates the backend of batch and queues the first reads on an io_uring,
+ * or starts the reader threads if the host does not permit io_uring.
+ * Returns false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool backend_start (fileload_t batch) {
+  
+  backend_t *backend;
+  
+  backend = malloc(sizeof(backend_t));
+  
+  if (backend == NULL) {
+    return false;
+  } /* end if */
+  
+  batch->backend = backend;
+  backend->use_uring = false;
+  backend->next = 0;
+  
+  if (uring_setup(batch)) {
+    LOCK(&batch->lock);
+    uring_fill(batch);
+    if (NOT(uring_enter(backend, 0))) {
+      uring_fall_back(batch);
+    } /* end if */
+    UNLOCK(&batch->lock);
+    return true;
+  } /* end if */
+  
+  /* io_uring is unavailable or not permitted */
+  if (NOT(pool_start(batch, &backend->pool))) {
+    free(backend);
+    batch->backend = NULL;
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end backend_start */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure backend_wait(batch)
+ * --------------------------------------------------------------------------
+ * Queues further reads up to the depth of the ring,  submits them and waits
+ * for at least one file of batch to be completed.  Called with the lock of
+ * batch held.
+ * ----------------------------------------------------------------------- */
+
+static void backend_wait (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  uint_t done_count;
+  
+  if (NOT(backend->use_uring)) {
+    pool_wait(&backend->pool);
+    return;
+  } /* end if */
+  
+  done_count = batch->done_count;
+  
+  /* files that fail to open are completed at once */
+  uring_fill(batch);
+  uring_reap(batch);
+  
+  if (batch->done_count != done_count) {
+    if ((backend->queued > 0) && NOT(uring_enter(backend, 0))) {
+      uring_fall_back(batch);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  /* submit queued reads and block for a completion */
+  if (NOT(uring_enter(backend, 1))) {
+    uring_fall_back(batch);
+    return;
+  } /* end if */
+  
+  uring_reap(batch);
+} /* end backend_wait */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure backend_stop(batch)
+ * --------------------------------------------------------------------------
+ * Waits for all reads in flight to complete,  discarding their contents,
+ * or stops the reader threads,  and deallocates the backend of batch.
+ * ----------------------------------------------------------------------- */
+
+static void backend_stop (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  
+  LOCK(&batch->lock);
+  backend->stopping = true;
+  
+  while (backend->use_uring &&
+      ((backend->queued > 0) || (backend->in_flight > 0))) {
+    if (NOT(uring_enter(backend, 1))) {
+      uring_fall_back(batch);
+    }
+    else {
+      uring_reap(batch);
+    } /* end if */
+  } /* end while */
+  
+  UNLOCK(&batch->lock);
+  
+  if (backend->use_uring) {
+    uring_close(backend);
+  }
+  else {
+    pool_stop(&backend->pool);
+  } /* end if */
+  
+  free(backend);
+  batch->backend = NULL;
+} /* end backend_stop */
+
+
+/* --------------------------------------------------------------------------
+ * private function uring_setup(batch)
+ * --------------------------------------------------------------------------
+ * Creates an io_uring of FILELOAD_QUEUE_DEPTH entries for batch and maps
+ * its rings.  Returns false if the host does not permit io_uring or on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+static bool uring_setup (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  struct io_uring_params params;
+  unsigned char *sq_ring, *cq_ring;
+  long fd;
+  
+  backend->read = malloc(batch->count * sizeof(uring_read_t));
+  
+  if (backend->read == NULL) {
+    return false;
+  } /* end if */
+  
+  memset(&params, 0, sizeof(params));
+  fd = syscall(__NR_io_uring_setup, FILELOAD_QUEUE_DEPTH, &params);
+  
+  if (fd < 0) {
+    free(backend->read);
+    return false;
+  } /* end if */
+  
+  backend->ring_fd = (int) fd;
+  backend->sq_ring_size =
+    params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  backend->cq_ring_size =
+    params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  
+  /* newer kernels map both rings with one mapping */
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    if (backend->cq_ring_size > backend->sq_ring_size) {
+      backend->sq_ring_size = backend->cq_ring_size;
+    } /* end if */
+    backend->cq_ring_size = 0;
+  } /* end if */
+  
+  backend->sq_ring = mmap(NULL, backend->sq_ring_size,
+    PROT_READ | PROT_WRITE, MAP_SHARED, backend->ring_fd, IORING_OFF_SQ_RING);
+  
+  if (backend->sq_ring == MAP_FAILED) {
+    close(backend->ring_fd);
+    free(backend->read);
+    return false;
+  } /* end if */
+  
+  if (backend->cq_ring_size == 0) {
+    backend->cq_ring = backend->sq_ring;
+  }
+  else {
+    backend->cq_ring = mmap(NULL, backend->cq_ring_size,
+      PROT_READ | PROT_WRITE, MAP_SHARED, backend->ring_fd,
+      IORING_OFF_CQ_RING);
+  } /* end if */
+  
+  backend->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  backend->sqes = mmap(NULL, backend->sqes_size,
+    PROT_READ | PROT_WRITE, MAP_SHARED, backend->ring_fd, IORING_OFF_SQES);
+  
+  if ((backend->cq_ring == MAP_FAILED) || (backend->sqes == MAP_FAILED)) {
+    if (backend->sqes != MAP_FAILED) {
+      munmap(backend->sqes, backend->sqes_size);
+    } /* end if */
+    if ((backend->cq_ring != MAP_FAILED) && (backend->cq_ring_size > 0)) {
+      munmap(backend->cq_ring, backend->cq_ring_size);
+    } /* end if */
+    munmap(backend->sq_ring, backend->sq_ring_size);
+    close(backend->ring_fd);
+    free(backend->read);
+    return false;
+  } /* end if */
+  
+  sq_ring = (unsigned char *) backend->sq_ring;
+  cq_ring = (unsigned char *) backend->cq_ring;
+  
+  backend->sq_tail = (unsigned *) (sq_ring + params.sq_off.tail);
+  backend->sq_mask = (unsigned *) (sq_ring + params.sq_off.ring_mask);
+  backend->sq_array = (unsigned *) (sq_ring + params.sq_off.array);
+  backend->cq_head = (unsigned *) (cq_ring + params.cq_off.head);
+  backend->cq_tail = (unsigned *) (cq_ring + params.cq_off.tail);
+  backend->cq_mask = (unsigned *) (cq_ring + params.cq_off.ring_mask);
+  backend->cqes = (struct io_uring_cqe *) (cq_ring + params.cq_off.cqes);
+  
+  /* the completion ring holds at least as many entries */
+  backend->depth = params.sq_entries;
+  backend->queued = 0;
+  backend->in_flight = 0;
+  backend->stopping = false;
+  backend->use_uring = true;
+  
+  return true;
+} /* end uring_setup */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_fill(batch)
+ * --------------------------------------------------------------------------
+ * Opens the next files of batch and queues their reads until the ring is
+ * full or all files have been opened.  Files that cannot be opened or are
+ * empty are completed at once.  Called with the lock of batch held.
+ * ----------------------------------------------------------------------- */
+
+static void uring_fill (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  fileio_status_t status;
+  uring_read_t *read;
+  uint_t index;
+  
+  while ((NOT(backend->stopping)) && (backend->next < batch->count) &&
+      (backend->queued + backend->in_flight < backend->depth)) {
+    index = backend->next;
+    backend->next++;
+    read = &backend->read[index];
+  
+    if (NOT(open_file(batch->entry[index].path,
+        &read->fd, &read->size, &status))) {
+      complete_entry(batch, index, NULL, 0, status);
+      continue;
+    } /* end if */
+  
+    read->chars = malloc(read->size + 1);
+    read->offset = 0;
+  
+    if (read->chars == NULL) {
+      uring_finish_read(batch, index, FILEIO_STATUS_ALLOCATION_FAILED);
+    }
+    else if (read->size == 0) {
+      uring_finish_read(batch, index, FILEIO_STATUS_SUCCESS);
+    }
+    else {
+      uring_queue_read(backend, index);
+    } /* end if */
+  } /* end while */
+} /* end uring_fill */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_queue_read(backend, index)
+ * --------------------------------------------------------------------------
+ * Queues a read of the unread remainder of the file at index,  of at most
+ * URING_MAX_READ bytes,  on the submission ring of backend.
+ * ----------------------------------------------------------------------- */
+
+static void uring_queue_read (backend_t *backend, uint_t index) {
+  
+  uring_read_t *read = &backend->read[index];
+  struct io_uring_sqe *sqe;
+  unsigned tail, slot;
+  size_t length;
+  
+  length = read->size - read->offset;
+  
+  if (length > URING_MAX_READ) {
+    length = URING_MAX_READ;
+  } /* end if */
+  
+  read->iov.iov_base = read->chars + read->offset;
+  read->iov.iov_len = length;
+  
+  tail = *backend->sq_tail;
+  slot = tail & *backend->sq_mask;
+  sqe = &backend->sqes[slot];
+  
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  sqe->opcode = IORING_OP_READV;
+  sqe->fd = read->fd;
+  sqe->addr = (unsigned long) &read->iov;
+  sqe->len = 1;
+  sqe->off = read->offset;
+  sqe->user_data = index;
+  backend->sq_array[slot] = slot;
+  
+  /* publish the entry before the new tail */
+  __atomic_store_n(backend->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  backend->queued++;
+} /* end uring_queue_read */
+
+
+/* --------------------------------------------------------------------------
+ * private function uring_enter(backend, min_complete)
+ * --------------------------------------------------------------------------
+ * Submits the queued reads of backend and,  if min_complete is not zero
+ * and any read is in flight,  waits for min_complete completions.  Returns
+ * false if the ring could not be entered.
+ * ----------------------------------------------------------------------- */
+
+static bool uring_enter (backend_t *backend, unsigned min_complete) {
+  
+  unsigned flags;
+  long result;
+  
+  if ((backend->queued == 0) && (backend->in_flight == 0)) {
+    return true;
+  } /* end if */
+  
+  flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+  
+  do {
+    result = syscall(__NR_io_uring_enter, backend->ring_fd,
+      backend->queued, min_complete, flags, NULL, 0);
+  } while ((result < 0) && (errno == EINTR));
+  
+  if (result < 0) {
+    return false;
+  } /* end if */
+  
+  backend->queued -= (unsigned) result;
+  backend->in_flight += (unsigned) result;
+  
+  return true;
+} /* end uring_enter */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_reap(batch)
+ * --------------------------------------------------------------------------
+ * Takes all completions from the completion ring of batch.  A read that
+ * has reached the size of its file or its end is completed,  a short read
+ * is queued again for the remainder.  Called with the lock of batch held.
+ * ----------------------------------------------------------------------- */
+
+static void uring_reap (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  struct io_uring_cqe *cqe;
+  uring_read_t *read;
+  unsigned head;
+  uint_t index;
+  int result;
+  
+  head = *backend->cq_head;
+  
+  while (head != __atomic_load_n(backend->cq_tail, __ATOMIC_ACQUIRE)) {
+    cqe = &backend->cqes[head & *backend->cq_mask];
+    index = (uint_t) cqe->user_data;
+    result = cqe->res;
+    head++;
+  
+    /* release the entry to the kernel */
+    __atomic_store_n(backend->cq_head, head, __ATOMIC_RELEASE);
+    backend->in_flight--;
+  
+    read = &backend->read[index];
+  
+    if (backend->stopping) {
+      uring_finish_read(batch, index, FILEIO_STATUS_DEVICE_ERROR);
+    }
+    else if ((result == -EINTR) || (result == -EAGAIN)) {
+      uring_queue_read(backend, index);
+    }
+    else if (result < 0) {
+      uring_finish_read(batch, index, status_for_errno(-result));
+    }
+    else {
+      read->offset += (size_t) result;
+  
+      if ((result == 0) || (read->offset == read->size)) {
+        uring_finish_read(batch, index, FILEIO_STATUS_SUCCESS);
+      }
+      else {
+        uring_queue_read(backend, index);
+      } /* end if */
+    } /* end if */
+  } /* end while */
+} /* end uring_reap */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_finish_read(batch, index, status)
+ * --------------------------------------------------------------------------
+ * Closes the file at index of batch,  terminates its contents  and
+ * completes it with status.
+ * ----------------------------------------------------------------------- */
+
+static void uring_finish_read
+  (fileload_t batch, uint_t index, fileio_status_t status) {
+  
+  uring_read_t *read = &batch->backend->read[index];
+  
+  close(read->fd);
+  
+  if (read->chars != NULL) {
+    read->chars[read->offset] = '\0';
+  } /* end if */
+  
+  complete_entry(batch, index, read->chars, read->offset, status);
+  read->chars = NULL;
+} /* end uring_finish_read */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_read_rest(batch, index)
+ * --------------------------------------------------------------------------
+ * Reads the unread remainder of the file at index of batch with blocking
+ * reads and completes it.
+ * ----------------------------------------------------------------------- */
+
+static void uring_read_rest (fileload_t batch, uint_t index) {
+  
+  uring_read_t *read = &batch->backend->read[index];
+  ssize_t result;
+  
+  while (read->offset < read->size) {
+    result = pread(read->fd, read->chars + read->offset,
+      read->size - read->offset, (off_t) read->offset);
+  
+    if (result > 0) {
+      read->offset += (size_t) result;
+    }
+    else if (result == 0) {
+      break;
+    }
+    else if (errno != EINTR) {
+      uring_finish_read(batch, index, status_for_errno(errno));
+      return;
+    } /* end if */
+  } /* end while */
+  
+  uring_finish_read(batch, index, FILEIO_STATUS_SUCCESS);
+} /* end uring_read_rest */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_fall_back(batch)
+ * --------------------------------------------------------------------------
+ * Abandons the ring of batch after it could not be entered.  Reads not yet
+ * submitted are withdrawn and performed with blocking reads,  completions
+ * of reads in flight are polled until none is left,  and the remaining
+ * files are passed to the pool of reader threads.  Called with the lock of
+ * batch held.
+ * ----------------------------------------------------------------------- */
+
+static void uring_fall_back (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  struct timespec interval;
+  uint_t index;
+  unsigned tail;
+  
+  interval.tv_sec = 0;
+  interval.tv_nsec = URING_POLL_INTERVAL_NS;
+  
+  while ((backend->queued > 0) || (backend->in_flight > 0)) {
+    /* withdraw reads the kernel has not seen */
+    while (backend->queued > 0) {
+      tail = *backend->sq_tail - 1;
+      index = (uint_t)
+        backend->sqes[tail & *backend->sq_mask].user_data;
+      __atomic_store_n(backend->sq_tail, tail, __ATOMIC_RELEASE);
+      backend->queued--;
+  
+      if (backend->stopping) {
+        uring_finish_read(batch, index, FILEIO_STATUS_DEVICE_ERROR);
+      }
+      else {
+        uring_read_rest(batch, index);
+      } /* end if */
+    } /* end while */
+  
+    /* short reads reaped here are queued again and withdrawn above */
+    if (backend->in_flight > 0) {
+      uring_reap(batch);
+      if (backend->in_flight > 0) {
+        nanosleep(&interval, NULL);
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  uring_close(backend);
+  backend->use_uring = false;
+  
+  if (NOT(pool_start(batch, &backend->pool))) {
+    /* read the remaining files by the waiting callers */
+    backend->pool.started = 0;
+  } /* end if */
+  
+  backend->pool.next = backend->next;
+  backend->pool.stop = backend->stopping;
+} /* end uring_fall_back */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure uring_close(backend)
+ * --------------------------------------------------------------------------
+ * Unmaps the rings of backend and closes the ring.
+ * ----------------------------------------------------------------------- */
+
+static void uring_close (backend_t *backend) {
+  
+  munmap(backend->sqes, backend->sqes_size);
+  
+  if (backend->cq_ring_size > 0) {
+    munmap(backend->cq_ring, backend->cq_ring_size);
+  } /* end if */
+  
+  munmap(backend->sq_ring, backend->sq_ring_size);
+  close(backend->ring_fd);
+  free(backend->read);
+} /* end uring_close */
+
+
+/* END OF FILE */
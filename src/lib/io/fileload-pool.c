@@ -0,0 +1,357 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * fileload-pool.c                                                           *
+ *                                                                           *
+ * Thread pool implementation of batched file loading.                       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+/* --------------------------------------------------------------------------
+ * private type pool_t
+ * --------------------------------------------------------------------------
+ * Record type for a pool of reader threads.  Each thread takes the next
+ * unread file of the batch,  reads it in whole with blocking reads  and
+ * signals done_signal when it has completed the file.  Field next holds the
+ * index of the next unread file,  protected by the lock of the batch.  If
+ * no thread could be started,  files are read by the waiting callers.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* batch */        fileload_t batch;
+  /* thread */       pthread_t thread[FILELOAD_THREAD_COUNT];
+  /* started */      uint_t started;
+  /* next */         uint_t next;
+  /* stop */         bool stop;
+  /* done_signal */  pthread_cond_t done_signal;
+} pool_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void *pool_worker (void *pool);
+
+static void read_next_file (pool_t *pool);
+
+static bool open_file
+  (const char *path, int *fd, size_t *size, fileio_status_t *status);
+
+static void read_file
+  (const char *path, char **chars, size_t *length, fileio_status_t *status);
+
+static fileio_status_t status_for_errno (int error);
+
+
+/* --------------------------------------------------------------------------
+ * private function pool_start(batch, pool)
+ * --------------------------------------------------------------------------
+ * Initialises pool and starts up to FILELOAD_THREAD_COUNT reader threads
+ * for the files of batch,  but no more threads than there are files.
+ * Returns false if the pool could not be initialised.
+ * ----------------------------------------------------------------------- */
+
+static bool pool_start (fileload_t batch, pool_t *pool) {
+  
+  pool->batch = batch;
+  pool->started = 0;
+  pool->next = 0;
+  pool->stop = false;
+  
+  if (pthread_cond_init(&pool->done_signal, NULL) != 0) {
+    return false;
+  } /* end if */
+  
+  while ((pool->started < FILELOAD_THREAD_COUNT) &&
+      (pool->started < batch->count) &&
+      (pthread_create(&pool->thread[pool->started], NULL,
+        pool_worker, pool) == 0)) {
+    pool->started++;
+  } /* end while */
+  
+  return true;
+} /* end pool_start */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure pool_wait(pool)
+ * --------------------------------------------------------------------------
+ * Waits for a reader thread of pool to complete a file.  If there are no
+ * reader threads,  reads the next unread file instead.  Called with the
+ * lock of the batch held.
+ * ----------------------------------------------------------------------- */
+
+static void pool_wait (pool_t *pool) {
+  
+  if (pool->started == 0) {
+    read_next_file(pool);
+  }
+  else {
+    pthread_cond_wait(&pool->done_signal, &pool->batch->lock);
+  } /* end if */
+} /* end pool_wait */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure pool_stop(pool)
+ * --------------------------------------------------------------------------
+ * Stops the reader threads of pool once they have completed the files they
+ * are reading,  and waits for them to terminate.
+ * ----------------------------------------------------------------------- */
+
+static void pool_stop (pool_t *pool) {
+  
+  uint_t index;
+  
+  LOCK(&pool->batch->lock);
+  pool->stop = true;
+  UNLOCK(&pool->batch->lock);
+  
+  for (index = 0; index < pool->started; index++) {
+    pthread_join(pool->thread[index], NULL);
+  } /* end for */
+  
+  pool->started = 0;
+  pthread_cond_destroy(&pool->done_signal);
+} /* end pool_stop */
+
+
+/* --------------------------------------------------------------------------
+ * private function pool_worker(pool)
+ * --------------------------------------------------------------------------
+ * Thread body of a reader thread.  Reads files until all files have been
+ * taken by a reader or the pool is stopped.  Returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *pool_worker (void *pool) {
+  
+  pool_t *this_pool = (pool_t *) pool;
+  fileload_t batch = this_pool->batch;
+  
+  LOCK(&batch->lock);
+  
+  while (NOT(this_pool->stop) && (this_pool->next < batch->count)) {
+    read_next_file(this_pool);
+    pthread_cond_broadcast(&this_pool->done_signal);
+  } /* end while */
+  
+  UNLOCK(&batch->lock);
+  
+  return NULL;
+} /* end pool_worker */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure read_next_file(pool)
+ * --------------------------------------------------------------------------
+ * Reads the next unread file of the batch of pool and completes it.  Called
+ * with the lock of the batch held,  which is released during the read.
+ * ----------------------------------------------------------------------- */
+
+static void read_next_file (pool_t *pool) {
+  
+  fileload_t batch = pool->batch;
+  fileio_status_t status;
+  const char *path;
+  uint_t index;
+  size_t length;
+  char *chars;
+  
+  if (pool->next >= batch->count) {
+    return;
+  } /* end if */
+  
+  index = pool->next;
+  pool->next++;
+  path = batch->entry[index].path;
+  
+  UNLOCK(&batch->lock);
+  read_file(path, &chars, &length, &status);
+  LOCK(&batch->lock);
+  
+  complete_entry(batch, index, chars, length, status);
+} /* end read_next_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function open_file(path, fd, size, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path for reading,  passes back its descriptor in fd and
+ * its size in size  and returns true.  On failure,  passes back the status
+ * in status and returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool open_file
+  (const char *path, int *fd, size_t *size, fileio_status_t *status) {
+  
+  struct stat info;
+  int error;
+  
+  do {
+    *fd = open(path, O_RDONLY);
+  } while ((*fd < 0) && (errno == EINTR));
+  
+  if (*fd < 0) {
+    *status = status_for_errno(errno);
+    return false;
+  } /* end if */
+  
+  if (fstat(*fd, &info) != 0) {
+    error = errno;
+    close(*fd);
+    *status = status_for_errno(error);
+    return false;
+  } /* end if */
+  
+  if (S_ISDIR(info.st_mode)) {
+    close(*fd);
+    *status = FILEIO_STATUS_INVALID_FILENAME;
+    return false;
+  } /* end if */
+  
+  /* the size and the terminating NUL must be representable */
+  if ((info.st_size < 0) ||
+      ((unsigned long long) info.st_size >= (unsigned long long) SIZE_MAX)) {
+    close(*fd);
+    *status = FILEIO_STATUS_ALLOCATION_FAILED;
+    return false;
+  } /* end if */
+  
+  *size = (size_t) info.st_size;
+  *status = FILEIO_STATUS_SUCCESS;
+  
+  return true;
+} /* end open_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure read_file(path, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Reads the file at path in whole into a newly allocated buffer terminated
+ * with ASCII NUL and passes back the buffer in chars,  its length in length
+ * and the status in status.  Passes NULL in chars on failure.
+ * ----------------------------------------------------------------------- */
+
+static void read_file
+  (const char *path, char **chars, size_t *length, fileio_status_t *status) {
+  
+  size_t size, offset;
+  ssize_t result;
+  int fd;
+  
+  *chars = NULL;
+  *length = 0;
+  
+  if (NOT(open_file(path, &fd, &size, status))) {
+    return;
+  } /* end if */
+  
+  *chars = malloc(size + 1);
+  
+  if (*chars == NULL) {
+    close(fd);
+    *status = FILEIO_STATUS_ALLOCATION_FAILED;
+    return;
+  } /* end if */
+  
+  /* read up to the size at open,  a shorter file ends early */
+  offset = 0;
+  while (offset < size) {
+    result = read(fd, *chars + offset, size - offset);
+  
+    if (result > 0) {
+      offset += (size_t) result;
+    }
+    else if (result == 0) {
+      break;
+    }
+    else if (errno != EINTR) {
+      *status = status_for_errno(errno);
+      close(fd);
+      free(*chars);
+      *chars = NULL;
+      return;
+    } /* end if */
+  } /* end while */
+  
+  close(fd);
+  
+  (*chars)[offset] = '\0';
+  *length = offset;
+  *status = FILEIO_STATUS_SUCCESS;
+} /* end read_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function status_for_errno(error)
+ * --------------------------------------------------------------------------
+ * Returns the file IO status for system error code error.
+ * ----------------------------------------------------------------------- */
+
+static fileio_status_t status_for_errno (int error) {
+  
+  switch (error) {
+    case ENOENT :
+    case ENOTDIR :
+      return FILEIO_STATUS_FILE_NOT_FOUND;
+  
+    case EACCES :
+    case EPERM :
+      return FILEIO_STATUS_ACCESS_DENIED;
+  
+    case ENAMETOOLONG :
+    case EISDIR :
+      return FILEIO_STATUS_INVALID_FILENAME;
+  
+    case ENOMEM :
+      return FILEIO_STATUS_ALLOCATION_FAILED;
+  
+    default :
+      return FILEIO_STATUS_DEVICE_ERROR;
+  } /* end switch */
+} /* end status_for_errno */
+
+
+/* END OF FILE */
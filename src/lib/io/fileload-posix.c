@@ -0,0 +1,102 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * fileload-posix.c                                                          *
+ *                                                                           *
+ * POSIX implementation of batched file loading.                             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * hidden type backend_s
+ * --------------------------------------------------------------------------
+ * Record type for the state of reads,  a pool of reader threads.
+ * ----------------------------------------------------------------------- */
+
+struct backend_s {
+  /* pool */  pool_t pool;
+};
+
+
+/* --------------------------------------------------------------------------
+ * private function backend_start(batch)
+ * --------------------------------------------------------------------------
+ * Allocates the backend of batch and starts its reader threads.  Returns
+ * false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool backend_start (fileload_t batch) {
+  
+  batch->backend = malloc(sizeof(backend_t));
+  
+  if (batch->backend == NULL) {
+    return false;
+  } /* end if */
+  
+  if (NOT(pool_start(batch, &batch->backend->pool))) {
+    free(batch->backend);
+    batch->backend = NULL;
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end backend_start */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure backend_wait(batch)
+ * --------------------------------------------------------------------------
+ * Waits for a reader thread to complete a file of batch.
+ * ----------------------------------------------------------------------- */
+
+static void backend_wait (fileload_t batch) {
+  
+  pool_wait(&batch->backend->pool);
+} /* end backend_wait */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure backend_stop(batch)
+ * --------------------------------------------------------------------------
+ * Stops the reader threads of batch and deallocates its backend.
+ * ----------------------------------------------------------------------- */
+
+static void backend_stop (fileload_t batch) {
+  
+  pool_stop(&batch->backend->pool);
+  free(batch->backend);
+  batch->backend = NULL;
+} /* end backend_stop */
+
+
+/* END OF FILE */
@@ -0,0 +1,481 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * fileload-win.c                                                            *
+ *                                                                           *
+ * Windows completion port implementation of batched file loading.           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Largest number of bytes requested by a single read,  larger files are
+ * read by several reads in sequence
+ * ----------------------------------------------------------------------- */
+
+#define WIN_MAX_READ (1UL << 30)
+
+
+/* --------------------------------------------------------------------------
+ * private type win_read_t
+ * --------------------------------------------------------------------------
+ * Record type for the overlapped read of a file,  with its handle,  buffer,
+ * size at open and the number of bytes read so far.  Field overlapped must
+ * be the first field,  completions are mapped back to their read by it.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* overlapped */  OVERLAPPED overlapped;
+  /* index */       uint_t index;
+  /* file */        HANDLE file;
+  /* chars */       char *chars;
+  /* size */        size_t size;
+  /* offset */      size_t offset;
+  /* in_flight */   bool in_flight;
+} win_read_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type backend_s
+ * --------------------------------------------------------------------------
+ * Record type for the state of reads,  an I/O completion port with which
+ * the files are associated as they are opened.  Field in_flight holds the
+ * number of reads issued but not yet completed,  which never exceeds
+ * FILELOAD_QUEUE_DEPTH.  Field next holds the index of the next file to
+ * open.  Field stopping is set while the batch is released,  completed
+ * reads are then discarded.  All fields are protected by the lock of the
+ * batch.
+ * ----------------------------------------------------------------------- */
+
+struct backend_s {
+  /* port */       HANDLE port;
+  /* read */       win_read_t *read;
+  /* in_flight */  uint_t in_flight;
+  /* next */       uint_t next;
+  /* stopping */   bool stopping;
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void win_fill (fileload_t batch);
+
+static bool win_open_file
+  (const char *path, HANDLE *file, size_t *size, fileio_status_t *status);
+
+static void win_issue_read (fileload_t batch, uint_t index);
+
+static void win_take_completion (fileload_t batch);
+
+static void win_finish_read
+  (fileload_t batch, uint_t index, fileio_status_t status);
+
+static fileio_status_t status_for_error (DWORD error);
+
+
+/* --------------------------------------------------------------------------
+ * private function backend_start(batch)
+ * --------------------------------------------------------------------------
+ * Allocates the backend of batch,  creates its completion port  and issues
+ * the first reads.  Returns false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool backend_start (fileload_t batch) {
+  
+  backend_t *backend;
+  uint_t index;
+  
+  backend = malloc(sizeof(backend_t));
+  
+  if (backend == NULL) {
+    return false;
+  } /* end if */
+  
+  backend->read = malloc(batch->count * sizeof(win_read_t));
+  
+  if (backend->read == NULL) {
+    free(backend);
+    return false;
+  } /* end if */
+  
+  backend->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+  
+  if (backend->port == NULL) {
+    free(backend->read);
+    free(backend);
+    return false;
+  } /* end if */
+  
+  for (index = 0; index < batch->count; index++) {
+    backend->read[index].index = index;
+    backend->read[index].file = INVALID_HANDLE_VALUE;
+    backend->read[index].chars = NULL;
+    backend->read[index].in_flight = false;
+  } /* end for */
+  
+  backend->in_flight = 0;
+  backend->next = 0;
+  backend->stopping = false;
+  batch->backend = backend;
+  
+  LOCK(&batch->lock);
+  win_fill(batch);
+  UNLOCK(&batch->lock);
+  
+  return true;
+} /* end backend_start */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure backend_wait(batch)
+ * --------------------------------------------------------------------------
+ * Issues further reads up to FILELOAD_QUEUE_DEPTH and waits for a read of
+ * batch to complete.  Called with the lock of batch held.
+ * ----------------------------------------------------------------------- */
+
+static void backend_wait (fileload_t batch) {
+  
+  uint_t done_count;
+  
+  done_count = batch->done_count;
+  
+  /* files that fail to open are completed at once */
+  win_fill(batch);
+  
+  if ((batch->done_count != done_count) ||
+      (batch->backend->in_flight == 0)) {
+    return;
+  } /* end if */
+  
+  win_take_completion(batch);
+} /* end backend_wait */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure backend_stop(batch)
+ * --------------------------------------------------------------------------
+ * Cancels all reads in flight,  waits for their completions,  discarding
+ * their contents,  and deallocates the backend of batch.
+ * ----------------------------------------------------------------------- */
+
+static void backend_stop (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  uint_t index;
+  
+  LOCK(&batch->lock);
+  backend->stopping = true;
+  
+  for (index = 0; index < batch->count; index++) {
+    if (backend->read[index].in_flight) {
+      CancelIoEx(backend->read[index].file,
+        &backend->read[index].overlapped);
+    } /* end if */
+  } /* end for */
+  
+  /* cancelled reads still post their completions */
+  while (backend->in_flight > 0) {
+    win_take_completion(batch);
+  } /* end while */
+  
+  UNLOCK(&batch->lock);
+  
+  CloseHandle(backend->port);
+  free(backend->read);
+  free(backend);
+  batch->backend = NULL;
+} /* end backend_stop */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure win_fill(batch)
+ * --------------------------------------------------------------------------
+ * Opens the next files of batch and issues their reads until
+ * FILELOAD_QUEUE_DEPTH reads are in flight or all files have been opened.
+ * Files that cannot be opened or are empty are completed at once.  Called
+ * with the lock of batch held.
+ * ----------------------------------------------------------------------- */
+
+static void win_fill (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  fileio_status_t status;
+  win_read_t *read;
+  uint_t index;
+  
+  while ((NOT(backend->stopping)) && (backend->next < batch->count) &&
+      (backend->in_flight < FILELOAD_QUEUE_DEPTH)) {
+    index = backend->next;
+    backend->next++;
+    read = &backend->read[index];
+  
+    if (NOT(win_open_file(batch->entry[index].path,
+        &read->file, &read->size, &status))) {
+      complete_entry(batch, index, NULL, 0, status);
+      continue;
+    } /* end if */
+  
+    read->offset = 0;
+  
+    if (CreateIoCompletionPort(read->file, backend->port, 0, 0) == NULL) {
+      win_finish_read(batch, index, status_for_error(GetLastError()));
+      continue;
+    } /* end if */
+  
+    read->chars = malloc(read->size + 1);
+  
+    if (read->chars == NULL) {
+      win_finish_read(batch, index, FILEIO_STATUS_ALLOCATION_FAILED);
+    }
+    else if (read->size == 0) {
+      win_finish_read(batch, index, FILEIO_STATUS_SUCCESS);
+    }
+    else {
+      win_issue_read(batch, index);
+    } /* end if */
+  } /* end while */
+} /* end win_fill */
+
+
+/* --------------------------------------------------------------------------
+ * private function win_open_file(path, file, size, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path for overlapped reading,  passes back its handle in
+ * file and its size in size  and returns true.  On failure,  passes back
+ * the status in status and returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool win_open_file
+  (const char *path, HANDLE *file, size_t *size, fileio_status_t *status) {
+  
+  LARGE_INTEGER file_size;
+  DWORD error;
+  
+  *file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+    OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  
+  if (*file == INVALID_HANDLE_VALUE) {
+    *status = status_for_error(GetLastError());
+    return false;
+  } /* end if */
+  
+  if (NOT(GetFileSizeEx(*file, &file_size))) {
+    error = GetLastError();
+    CloseHandle(*file);
+    *file = INVALID_HANDLE_VALUE;
+    *status = status_for_error(error);
+    return false;
+  } /* end if */
+  
+  /* the size and the terminating NUL must be representable */
+  if ((file_size.QuadPart < 0) ||
+      ((unsigned long long) file_size.QuadPart >=
+       (unsigned long long) SIZE_MAX)) {
+    CloseHandle(*file);
+    *file = INVALID_HANDLE_VALUE;
+    *status = FILEIO_STATUS_ALLOCATION_FAILED;
+    return false;
+  } /* end if */
+  
+  *size = (size_t) file_size.QuadPart;
+  *status = FILEIO_STATUS_SUCCESS;
+  
+  return true;
+} /* end win_open_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure win_issue_read(batch, index)
+ * --------------------------------------------------------------------------
+ * Issues an overlapped read of the unread remainder of the file at index of
+ * batch,  of at most WIN_MAX_READ bytes.  Its completion is posted to the
+ * completion port,  even if the read completes at once.  If the read fails
+ * to be issued,  the file is completed.
+ * ----------------------------------------------------------------------- */
+
+static void win_issue_read (fileload_t batch, uint_t index) {
+  
+  win_read_t *read = &batch->backend->read[index];
+  unsigned long long offset;
+  size_t length;
+  DWORD error;
+  
+  length = read->size - read->offset;
+  
+  if (length > WIN_MAX_READ) {
+    length = WIN_MAX_READ;
+  } /* end if */
+  
+  offset = (unsigned long long) read->offset;
+  memset(&read->overlapped, 0, sizeof(OVERLAPPED));
+  read->overlapped.Offset = (DWORD) (offset & 0xFFFFFFFFULL);
+  read->overlapped.OffsetHigh = (DWORD) (offset >> 32);
+  
+  if (NOT(ReadFile(read->file, read->chars + read->offset,
+      (DWORD) length, NULL, &read->overlapped))) {
+    error = GetLastError();
+  
+    if (error == ERROR_HANDLE_EOF) {
+      win_finish_read(batch, index, FILEIO_STATUS_SUCCESS);
+      return;
+    }
+    else if (error != ERROR_IO_PENDING) {
+      win_finish_read(batch, index, status_for_error(error));
+      return;
+    } /* end if */
+  } /* end if */
+  
+  read->in_flight = true;
+  batch->backend->in_flight++;
+} /* end win_issue_read */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure win_take_completion(batch)
+ * --------------------------------------------------------------------------
+ * Waits for a completion on the completion port of batch.  A read that has
+ * reached the size of its file or its end is completed,  a short read is
+ * issued again for the remainder.  Called with the lock of batch held.
+ * ----------------------------------------------------------------------- */
+
+static void win_take_completion (fileload_t batch) {
+  
+  backend_t *backend = batch->backend;
+  OVERLAPPED *overlapped;
+  win_read_t *read;
+  ULONG_PTR key;
+  DWORD bytes, error;
+  BOOL success;
+  
+  success = GetQueuedCompletionStatus(backend->port,
+    &bytes, &key, &overlapped, INFINITE);
+  
+  /* no completion was dequeued */
+  if (overlapped == NULL) {
+    return;
+  } /* end if */
+  
+  read = (win_read_t *) overlapped;
+  read->in_flight = false;
+  backend->in_flight--;
+  
+  if (backend->stopping) {
+    win_finish_read(batch, read->index, FILEIO_STATUS_DEVICE_ERROR);
+  }
+  else if (NOT(success)) {
+    error = GetLastError();
+  
+    if (error == ERROR_HANDLE_EOF) {
+      win_finish_read(batch, read->index, FILEIO_STATUS_SUCCESS);
+    }
+    else {
+      win_finish_read(batch, read->index, status_for_error(error));
+    } /* end if */
+  }
+  else {
+    read->offset += (size_t) bytes;
+  
+    if ((bytes == 0) || (read->offset == read->size)) {
+      win_finish_read(batch, read->index, FILEIO_STATUS_SUCCESS);
+    }
+    else {
+      win_issue_read(batch, read->index);
+    } /* end if */
+  } /* end if */
+} /* end win_take_completion */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure win_finish_read(batch, index, status)
+ * --------------------------------------------------------------------------
+ * Closes the file at index of batch,  terminates its contents  and
+ * completes it with status.
+ * ----------------------------------------------------------------------- */
+
+static void win_finish_read
+  (fileload_t batch, uint_t index, fileio_status_t status) {
+  
+  win_read_t *read = &batch->backend->read[index];
+  
+  CloseHandle(read->file);
+  read->file = INVALID_HANDLE_VALUE;
+  
+  if (read->chars != NULL) {
+    read->chars[read->offset] = '\0';
+  } /* end if */
+  
+  complete_entry(batch, index, read->chars, read->offset, status);
+  read->chars = NULL;
+} /* end win_finish_read */
+
+
+/* --------------------------------------------------------------------------
+ * private function status_for_error(error)
+ * --------------------------------------------------------------------------
+ * Returns the file IO status for Windows error code error.
+ * ----------------------------------------------------------------------- */
+
+static fileio_status_t status_for_error (DWORD error) {
+  
+  switch (error) {
+    case ERROR_FILE_NOT_FOUND :
+    case ERROR_PATH_NOT_FOUND :
+      return FILEIO_STATUS_FILE_NOT_FOUND;
+  
+    case ERROR_ACCESS_DENIED :
+    case ERROR_SHARING_VIOLATION :
+      return FILEIO_STATUS_ACCESS_DENIED;
+  
+    case ERROR_INVALID_NAME :
+    case ERROR_FILENAME_EXCED_RANGE :
+      return FILEIO_STATUS_INVALID_FILENAME;
+  
+    case ERROR_NOT_ENOUGH_MEMORY :
+    case ERROR_OUTOFMEMORY :
+      return FILEIO_STATUS_ALLOCATION_FAILED;
+  
+    default :
+      return FILEIO_STATUS_DEVICE_ERROR;
+  } /* end switch */
+} /* end status_for_error */
+
+
+/* END OF FILE */
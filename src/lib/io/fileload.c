@@ -0,0 +1,488 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * fileload.c                                                                *
+ *                                                                           *
+ * Implementation of batched file loading.                                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* syscall */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "fileload.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(_WIN32)) && (!defined(__DJGPP__))
+#include <windows.h>
+#define FILELOAD_WINDOWS 1
+#else
+#include <pthread.h>
+#define FILELOAD_WINDOWS 0
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * type lock_t
+ * --------------------------------------------------------------------------
+ * Lock protecting the state of a batch.
+ * ----------------------------------------------------------------------- */
+
+#if (FILELOAD_WINDOWS)
+typedef CRITICAL_SECTION lock_t;
+
+#define LOCK_INIT(_lock) InitializeCriticalSection(_lock)
+#define LOCK_DESTROY(_lock) DeleteCriticalSection(_lock)
+#define LOCK(_lock) EnterCriticalSection(_lock)
+#define UNLOCK(_lock) LeaveCriticalSection(_lock)
+#else
+typedef pthread_mutex_t lock_t;
+
+#define LOCK_INIT(_lock) pthread_mutex_init(_lock, NULL)
+#define LOCK_DESTROY(_lock) pthread_mutex_destroy(_lock)
+#define LOCK(_lock) pthread_mutex_lock(_lock)
+#define UNLOCK(_lock) pthread_mutex_unlock(_lock)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type entry_t
+ * --------------------------------------------------------------------------
+ * Record type for a file of a batch.  Field done is set once the file has
+ * been read or failed to read,  field taken once it has been passed back
+ * to a caller.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* path */    char *path;
+  /* chars */   char *chars;
+  /* length */  size_t length;
+  /* status */  fileio_status_t status;
+  /* done */    bool done;
+  /* taken */   bool taken;
+} entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type backend_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of the host specific implementation of reads,
+ * defined by the implementation.
+ * ----------------------------------------------------------------------- */
+
+typedef struct backend_s backend_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type fileload_s
+ * --------------------------------------------------------------------------
+ * Record type representing a batch load.  Array done holds the indices of
+ * the files read so far in order of completion,  field next_done the index
+ * into array done of the next file to be passed back by fileload_next.  All
+ * fields are protected by lock.
+ * ----------------------------------------------------------------------- */
+
+struct fileload_s {
+  /* count */       uint_t count;
+  /* entry */       entry_t *entry;
+  /* done */        uint_t *done;
+  /* done_count */  uint_t done_count;
+  /* next_done */   uint_t next_done;
+  /* lock */        lock_t lock;
+  /* backend */     backend_t *backend;
+};
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void take_entry
+  (fileload_t batch, uint_t index,
+   const char **chars, size_t *length, fileio_status_t *status);
+
+static void complete_entry
+  (fileload_t batch, uint_t index,
+   char *chars, size_t length, fileio_status_t status);
+
+
+/* --------------------------------------------------------------------------
+ * Host specific implementation of reads
+ * --------------------------------------------------------------------------
+ * procedure backend_start(batch) allocates the backend of batch and starts
+ * the reads of its files.  Returns false if allocation failed.
+ *
+ * procedure backend_wait(batch) is called with the lock of batch held while
+ * any file of batch has not been read,  and blocks until at least one more
+ * file has been completed with complete_entry,  or it may return early,  in
+ * which case it is called again.  It may release and reacquire the lock.
+ *
+ * procedure backend_stop(batch) completes or cancels all reads in flight
+ * and deallocates the backend of batch.  It is called without the lock.
+ * ----------------------------------------------------------------------- */
+
+static bool backend_start (fileload_t batch);
+
+static void backend_wait (fileload_t batch);
+
+static void backend_stop (fileload_t batch);
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_new(count, path, status)
+ * --------------------------------------------------------------------------
+ * Starts reading the count files whose pathnames are in array path  and
+ * returns a new batch load,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+fileload_t fileload_new
+  (uint_t count,                         /* in */
+   const char *const path[],             /* in */
+   fileio_status_t *status) {            /* out */
+  
+  fileload_t batch;
+  size_t size;
+  uint_t index;
+  
+  if ((count > 0) && (path == NULL)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return NULL;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    if (path[index] == NULL) {
+      SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+      return NULL;
+    } /* end if */
+  } /* end for */
+  
+  batch = malloc(sizeof(struct fileload_s));
+  
+  if (batch == NULL) {
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  batch->count = count;
+  batch->entry = calloc((count > 0) ? count : 1, sizeof(entry_t));
+  batch->done = malloc(((count > 0) ? count : 1) * sizeof(uint_t));
+  batch->done_count = 0;
+  batch->next_done = 0;
+  batch->backend = NULL;
+  LOCK_INIT(&batch->lock);
+  
+  if ((batch->entry == NULL) || (batch->done == NULL)) {
+    batch->count = 0;
+    fileload_release(&batch);
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* copy pathnames */
+  for (index = 0; index < count; index++) {
+    size = strlen(path[index]) + 1;
+    batch->entry[index].path = malloc(size);
+  
+    if (batch->entry[index].path == NULL) {
+      fileload_release(&batch);
+      SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+      return NULL;
+    } /* end if */
+  
+    memcpy(batch->entry[index].path, path[index], size);
+  } /* end for */
+  
+  if ((count > 0) && NOT(backend_start(batch))) {
+    fileload_release(&batch);
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  
+  return batch;
+} /* end fileload_new */
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of files of batch,  or zero if batch is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t fileload_count (fileload_t batch) {
+  
+  if (batch == NULL) {
+    return 0;
+  } /* end if */
+  
+  return batch->count;
+} /* end fileload_count */
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_next(batch, index, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Waits for the next file of batch to be read that has not yet been taken
+ * and passes it back.  Returns false once all files have been taken.
+ * ----------------------------------------------------------------------- */
+
+bool fileload_next
+  (fileload_t batch,                     /* in */
+   uint_t *index,                        /* out */
+   const char **chars,                   /* out */
+   size_t *length,                       /* out */
+   fileio_status_t *status) {            /* out */
+  
+  uint_t next;
+  
+  if (batch == NULL) {
+    return false;
+  } /* end if */
+  
+  LOCK(&batch->lock);
+  
+  while (true) {
+    /* files taken by fileload_wait are skipped */
+    while (batch->next_done < batch->done_count) {
+      next = batch->done[batch->next_done];
+      batch->next_done++;
+  
+      if (NOT(batch->entry[next].taken)) {
+        take_entry(batch, next, chars, length, status);
+        UNLOCK(&batch->lock);
+        WRITE_OUTPARAM(index, next);
+        return true;
+      } /* end if */
+    } /* end while */
+  
+    if (batch->done_count == batch->count) {
+      UNLOCK(&batch->lock);
+      return false;
+    } /* end if */
+  
+    backend_wait(batch);
+  } /* end while */
+} /* end fileload_next */
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_wait(batch, index, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Waits for the file at index of batch to be read and passes it back.
+ * Returns false if index is out of range.
+ * ----------------------------------------------------------------------- */
+
+bool fileload_wait
+  (fileload_t batch,                     /* in */
+   uint_t index,                         /* in */
+   const char **chars,                   /* out */
+   size_t *length,                       /* out */
+   fileio_status_t *status) {            /* out */
+  
+  if ((batch == NULL) || (index >= batch->count)) {
+    return false;
+  } /* end if */
+  
+  LOCK(&batch->lock);
+  
+  while (NOT(batch->entry[index].done)) {
+    backend_wait(batch);
+  } /* end while */
+  
+  take_entry(batch, index, chars, length, status);
+  UNLOCK(&batch->lock);
+  
+  return true;
+} /* end fileload_wait */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fileload_discard(batch, index)
+ * --------------------------------------------------------------------------
+ * Deallocates the buffer of the file at index of batch if it has been
+ * taken.
+ * ----------------------------------------------------------------------- */
+
+void fileload_discard (fileload_t batch, uint_t index) {
+  
+  if ((batch == NULL) || (index >= batch->count)) {
+    return;
+  } /* end if */
+  
+  LOCK(&batch->lock);
+  
+  if (batch->entry[index].taken) {
+    free(batch->entry[index].chars);
+    batch->entry[index].chars = NULL;
+    batch->entry[index].length = 0;
+  } /* end if */
+  
+  UNLOCK(&batch->lock);
+} /* end fileload_discard */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fileload_release(batch)
+ * --------------------------------------------------------------------------
+ * Cancels or completes any reads still in flight,  deallocates batch and
+ * all its buffers and passes NULL in batch.
+ * ----------------------------------------------------------------------- */
+
+void fileload_release (fileload_t *batch) {
+  
+  fileload_t this_batch;
+  uint_t index;
+  
+  if ((batch == NULL) || (*batch == NULL)) {
+    return;
+  } /* end if */
+  
+  this_batch = *batch;
+  
+  if (this_batch->backend != NULL) {
+    backend_stop(this_batch);
+  } /* end if */
+  
+  if (this_batch->entry != NULL) {
+    for (index = 0; index < this_batch->count; index++) {
+      free(this_batch->entry[index].path);
+      free(this_batch->entry[index].chars);
+    } /* end for */
+  } /* end if */
+  
+  LOCK_DESTROY(&this_batch->lock);
+  free(this_batch->entry);
+  free(this_batch->done);
+  free(this_batch);
+  
+  *batch = NULL;
+} /* end fileload_release */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure take_entry(batch, index, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Marks the file at index of batch as taken and passes back its contents,
+ * their length and its status.  Called with the lock of batch held.
+ * ----------------------------------------------------------------------- */
+
+static void take_entry
+  (fileload_t batch, uint_t index,
+   const char **chars, size_t *length, fileio_status_t *status) {
+  
+  entry_t *entry;
+  
+  entry = &batch->entry[index];
+  entry->taken = true;
+  
+  WRITE_OUTPARAM(chars, entry->chars);
+  WRITE_OUTPARAM(length, entry->length);
+  SET_STATUS(status, entry->status);
+} /* end take_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure complete_entry(batch, index, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Records the outcome of reading the file at index of batch and appends it
+ * to the files read.  The buffer chars,  which must hold length characters
+ * followed by ASCII NUL,  is owned by batch from now on.  If status is not
+ * FILEIO_STATUS_SUCCESS,  chars is deallocated.  Called with the lock of
+ * batch held.
+ * ----------------------------------------------------------------------- */
+
+static void complete_entry
+  (fileload_t batch, uint_t index,
+   char *chars, size_t length, fileio_status_t status) {
+  
+  entry_t *entry;
+  
+  entry = &batch->entry[index];
+  
+  if (status != FILEIO_STATUS_SUCCESS) {
+    free(chars);
+    chars = NULL;
+    length = 0;
+  } /* end if */
+  
+  entry->chars = chars;
+  entry->length = length;
+  entry->status = status;
+  entry->done = true;
+  
+  batch->done[batch->done_count] = index;
+  batch->done_count++;
+} /* end complete_entry */
+
+
+/* --------------------------------------------------------------------------
+ * Select implementation of reads for Linux host platforms
+ * ----------------------------------------------------------------------- */
+
+#if defined(__linux__)
+#include "fileload-pool.c"
+#include "fileload-linux.c"
+
+
+/* --------------------------------------------------------------------------
+ * Select implementation of reads for Windows host platforms
+ * ----------------------------------------------------------------------- */
+
+#elif (FILELOAD_WINDOWS)
+#include "fileload-win.c"
+
+
+/* --------------------------------------------------------------------------
+ * Select thread pool implementation of reads for other POSIX host platforms
+ * ----------------------------------------------------------------------- */
+
+#else
+#include "fileload-pool.c"
+#include "fileload-posix.c"
+#endif
+
+
+/* END OF FILE */
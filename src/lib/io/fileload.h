@@ -0,0 +1,191 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * fileload.h                                                                *
+ *                                                                           *
+ * Interface of batched file loading.                                        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef FILELOAD_H
+#define FILELOAD_H
+
+
+#include "fileio-status.h"
+#include "m2c-common.h"
+
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Batched file loading
+ * --------------------------------------------------------------------------
+ * A batch load reads a list of files into memory in whole,  each into a
+ * buffer of its own.  All reads are started when the batch is created and
+ * proceed in the background,  the caller takes each file as soon as it has
+ * been read,  so that processing of the files read so far overlaps with the
+ * reading of the others.
+ *
+ * On Linux,  reads are queued on an io_uring,  up to FILELOAD_QUEUE_DEPTH at
+ * a time,  and completions are reaped by the callers that wait for them.  If
+ * the host does not permit io_uring,  the batch falls back to a pool of
+ * FILELOAD_THREAD_COUNT reader threads,  which is also used on other POSIX
+ * hosts.  On Windows,  reads are overlapped and their completions are taken
+ * from an I/O completion port.
+ *
+ * Files are opened and their sizes determined when their reads are queued.
+ * A file that grows while it is read is read up to the size it had when it
+ * was opened.  The buffer of each file is terminated with ASCII NUL.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Maximum number of reads in flight on an io_uring or completion port
+ * ----------------------------------------------------------------------- */
+
+#ifndef FILELOAD_QUEUE_DEPTH
+#define FILELOAD_QUEUE_DEPTH 32
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Number of reader threads of the thread pool fallback
+ * ----------------------------------------------------------------------- */
+
+#ifndef FILELOAD_THREAD_COUNT
+#define FILELOAD_THREAD_COUNT 8
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * opaque type fileload_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a batch load.
+ * ----------------------------------------------------------------------- */
+
+typedef struct fileload_s *fileload_t;
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_new(count, path, status)
+ * --------------------------------------------------------------------------
+ * Starts reading the count files whose pathnames are in array path  and
+ * returns a new batch load,  or NULL on failure.  The pathnames are copied.
+ * Passes the status of the operation in status,  unless NULL.  The status
+ * of reading each file is passed back when the file is taken.
+ *
+ * error-conditions:
+ * o  if path is NULL or holds a NULL pathname,
+ *    FILEIO_STATUS_INVALID_FILENAME,  if allocation failed,
+ *    FILEIO_STATUS_ALLOCATION_FAILED is passed back in status
+ * ----------------------------------------------------------------------- */
+
+fileload_t fileload_new
+  (uint_t count,                         /* in */
+   const char *const path[],             /* in */
+   fileio_status_t *status);             /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of files of batch,  or zero if batch is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t fileload_count (fileload_t batch);
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_next(batch, index, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Waits for the next file of batch to be read that has not yet been taken,
+ * in order of completion,  passes back its index in array path,  a pointer
+ * to its contents and their length  and returns true.  Returns false once
+ * all files of batch have been taken.  The status of reading the file is
+ * passed back in status,  unless NULL.  If the file could not be read,  NULL
+ * is passed back in chars and zero in length.  May be called by several
+ * threads at once,  each file is then taken by one of them.
+ * ----------------------------------------------------------------------- */
+
+bool fileload_next
+  (fileload_t batch,                     /* in */
+   uint_t *index,                        /* out */
+   const char **chars,                   /* out */
+   size_t *length,                       /* out */
+   fileio_status_t *status);             /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function fileload_wait(batch, index, chars, length, status)
+ * --------------------------------------------------------------------------
+ * Waits for the file at index in array path of batch to be read,  passes
+ * back a pointer to its contents and their length  and returns true.  The
+ * file is then taken and no longer returned by fileload_next.  Returns
+ * false if index is out of range.  The status of reading the file is passed
+ * back in status,  unless NULL,  as with fileload_next.
+ * ----------------------------------------------------------------------- */
+
+bool fileload_wait
+  (fileload_t batch,                     /* in */
+   uint_t index,                         /* in */
+   const char **chars,                   /* out */
+   size_t *length,                       /* out */
+   fileio_status_t *status);             /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure fileload_discard(batch, index)
+ * --------------------------------------------------------------------------
+ * Deallocates the buffer of the file at index in array path of batch,  if
+ * it has been taken.  Its contents are no longer accessible.  Otherwise the
+ * buffers of a batch are deallocated when the batch is released.
+ * ----------------------------------------------------------------------- */
+
+void fileload_discard (fileload_t batch, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure fileload_release(batch)
+ * --------------------------------------------------------------------------
+ * Cancels or completes any reads still in flight,  deallocates batch and
+ * all its buffers and passes NULL in batch.  Must not be called while any
+ * other thread uses batch.
+ * ----------------------------------------------------------------------- */
+
+void fileload_release (fileload_t *batch);
+
+
+#endif /* FILELOAD_H */
+
+/* END OF FILE */
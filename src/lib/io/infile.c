@@ -0,0 +1,2005 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * infile.c                                                                  *
+ *                                                                           *
+ * Implementation of infile module.                                          *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * Imports
+ * ----------------------------------------------------------------------- */
+
+#include "infile.h"
+#include "fileutils.h"
+#include "m2c-common.h"
+#include "m2c-mem-account.h"
+
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped input for POSIX and Unix-like host platforms
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  a file that is read in whole is mapped
+ * read-only  and read directly from the page cache.  On all other hosts,
+ * or if a file cannot be mapped,  it is read into the buffer with fread().
+ * Define INFILE_USE_MMAP as 0 to force buffered input.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(INFILE_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define INFILE_USE_MMAP 1
+#else
+#define INFILE_USE_MMAP 0
+#endif
+#endif
+
+#if (INFILE_USE_MMAP)
+#include <sys/mman.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Select vector implementation of the delimiter scanner
+ * --------------------------------------------------------------------------
+ * The scanner computes a bit mask per block of 16 input bytes.  With SSE2
+ * each byte is represented by one bit,  with NEON by four bits.  On other
+ * targets the scanner falls back to a byte at a time loop.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define INFILE_SCAN_SIMD 1
+#define SCAN_BITS_PER_BYTE 1
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define INFILE_SCAN_SIMD 1
+#define SCAN_BITS_PER_BYTE 4
+
+#else
+#define INFILE_SCAN_SIMD 0
+#endif
+
+#define SCAN_BLOCK_SIZE 16
+
+
+/* --------------------------------------------------------------------------
+ * Ring size of a streamed infile
+ * ----------------------------------------------------------------------- */
+
+#define INFILE_RING_SIZE (INFILE_CHUNK_SIZE * INFILE_CHUNK_COUNT)
+
+
+/* --------------------------------------------------------------------------
+ * hidden type infile_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing an input file.
+ *
+ * All positions are absolute offsets from the start of the file.  The buffer
+ * holds the file contents up to, but excluding position end,  the buffer
+ * slot for position pos is (pos & mask).  A file that is read in whole is
+ * never wrapped and its mask has all bits set.  A streamed file is read one
+ * chunk at a time into a ring of INFILE_RING_SIZE bytes.  A chunk may only
+ * overwrite data that precedes both the reading position and the marker.
+ * The capacity of the buffer  may exceed bufsize  when an infile object is
+ * reused for a smaller file.  Field file is NULL once the file is closed,
+ * it is always NULL for an infile reading text held in memory.  Lines are
+ * counted from first_line.  Input that is read in whole is validated when
+ * it is loaded,  field clean is set if it holds no offending characters.
+ * Field buffer points to storage,  or to a read-only mapping of the file if
+ * field mapped is set.  The capacity is that of storage.
+ * Field too_long is set while a marked lexeme that exceeded the ring has
+ * not been fetched,  status FILEIO_STATUS_LEXEME_TOO_LONG is then retained.
+ * ----------------------------------------------------------------------- */
+
+struct infile_struct_t {
+  /* file */ FILE *file;
+  /* streaming */ bool streaming;
+  /* chunk_size */ size_t chunk_size;
+  /* at_eof */ bool at_eof;
+  /* mask */ size_t mask;
+  /* bufsize */ size_t bufsize;
+  /* capacity */ size_t capacity;
+  /* end */ size_t end;
+  /* index */ size_t index;
+  /* first_line */ uint_t first_line;
+  /* line */ uint_t line;
+  /* column */ uint_t column;
+  /* marker_set */ bool marker_set;
+  /* marked_index */ size_t marked_index;
+  /* too_long */ bool too_long;
+  /* status */ infile_status_t status;
+  /* validation */ infile_validation_t validation;
+  /* clean */ bool clean;
+  /* mapped */ bool mapped;
+  /* buffer */ char *buffer;
+  /* storage */ char storage[];
+};
+
+typedef struct infile_struct_t infile_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * private macro SET_INFILE_STATUS(infile, status)
+ * --------------------------------------------------------------------------
+ * Sets the status of infile  unless a lexeme that exceeded the ring has not
+ * been fetched yet.
+ * ----------------------------------------------------------------------- */
+
+#define SET_INFILE_STATUS(_infile,_status) \
+  { if (NOT((_infile)->too_long)) { (_infile)->status = _status; }; }
+
+
+/* --------------------------------------------------------------------------
+ * Print handler
+ * ----------------------------------------------------------------------- */
+
+static print_handler_t print_handler = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void open_infile
+  (infile_t *infile, const char *path, bool prefix, infile_status_t *status);
+
+static void reopen_infile
+  (infile_t *infile, const char *path, bool prefix, infile_status_t *status);
+
+static char *map_file (FILE *file, size_t size);
+
+static void unmap_input (infile_t infile);
+
+static bool fill_upto (infile_t infile, size_t pos);
+
+static void read_chunk (infile_t infile);
+
+static intstr_t get_marked_lexeme
+  (infile_t infile, bool with_hash, intstr_hash_t key);
+
+static size_t scan_to_delimiter
+  (const char *chars, size_t length, char delim1, char delim2, bool clean,
+   uint_t *newlines, size_t *tail);
+
+static void validate_input
+  (const char *chars, size_t length, infile_validation_t *validation);
+
+static void print_buffered_line (infile_t infile, uint_t line_no);
+
+static void print_streamed_line (infile_t infile, uint_t line_no);
+
+static void visit_buffered_lines
+  (infile_t infile, uint_t count, const uint_t line_no[],
+   line_visitor_t visitor, void *context);
+
+static void visit_streamed_lines
+  (infile_t infile, uint_t count, const uint_t line_no[],
+   line_visitor_t visitor, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_open(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path and passes a newly allocated and initialised infile
+ * object back in out-parameter infile. Passes NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void infile_open (infile_t *infile, const char *path, infile_status_t *status) {
+  
+  open_infile(infile, path, false, status);
+  
+} /* end infile_open */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_open_prefix(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path for reading of a prefix  and passes a newly allo-
+ * cated and initialised infile object back in out-parameter infile.  Passes
+ * NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void infile_open_prefix
+  (infile_t *infile, const char *path, infile_status_t *status) {
+  
+  open_infile(infile, path, true, status);
+  
+} /* end infile_open_prefix */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_open_text(infile, chars, length, first_line, status)
+ * --------------------------------------------------------------------------
+ * Passes a newly allocated infile object that reads a copy of the length
+ * characters at chars with lines counted from first_line  back in infile.
+ * Passes NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void infile_open_text
+  (infile_t *infile,                 /* out */
+   const char *chars,                /* in */
+   size_t length,                    /* in */
+   uint_t first_line,                /* in */
+   infile_status_t *status) {        /* out */
+  
+  infile_t new_infile;
+  
+  /* check pre-conditions */
+  if ((infile == NULL) || ((chars == NULL) && (length > 0))) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  /* allocate new infile */
+  new_infile =
+    m2c_mem_alloc(M2C_MEM_INFILE, sizeof(infile_struct_t) + length + 1);
+  
+  if (new_infile == NULL) {
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    *infile = NULL;
+    return;
+  } /* end if */
+  
+  /* the text is held in whole,  as if read from a file */
+  new_infile->file = NULL;
+  new_infile->streaming = false;
+  new_infile->chunk_size = INFILE_CHUNK_SIZE;
+  new_infile->at_eof = true;
+  new_infile->mask = ~((size_t) 0);
+  new_infile->bufsize = length;
+  new_infile->capacity = length;
+  new_infile->end = length;
+  new_infile->index = 0;
+  new_infile->first_line = (first_line > 0) ? first_line : 1;
+  new_infile->line = new_infile->first_line;
+  new_infile->column = 1;
+  new_infile->marker_set = false;
+  new_infile->marked_index = 0;
+  new_infile->too_long = false;
+  new_infile->status = FILEIO_STATUS_SUCCESS;
+  new_infile->mapped = false;
+  new_infile->buffer = new_infile->storage;
+  
+  if (length > 0) {
+    memcpy(new_infile->buffer, chars, length);
+  } /* end if */
+  new_infile->buffer[length] = ASCII_NUL;
+  
+  validate_input(new_infile->buffer, length, &new_infile->validation);
+  new_infile->clean = (new_infile->validation.first_invalid == length);
+  
+  *infile = new_infile;
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  return;
+} /* end infile_open_text */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure open_infile(infile, path, prefix, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path  and passes a newly allocated  and initialised
+ * infile object back in out-parameter infile.  If prefix is true,  the file
+ * is streamed in prefix chunks without stdio buffering.  Passes NULL on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+static FILE *open_file
+  (const char *path, bool prefix, bool *streaming, size_t *bufsize,
+   char **map, infile_status_t *status);
+
+static void init_infile
+  (infile_t infile, FILE *file, bool prefix, bool streaming, size_t bufsize,
+   char *map);
+
+static void open_infile
+  (infile_t *infile, const char *path, bool prefix, infile_status_t *status) {
+  
+  FILE *file;
+  char *map;
+  bool streaming;
+  size_t bufsize, capacity;
+  infile_t new_infile;
+  
+  /* check pre-conditions */
+  if ((infile == NULL) || (path == NULL)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  /* open file */
+  file = open_file(path, prefix, &streaming, &bufsize, &map, status);
+  
+  if (file == NULL) {
+    *infile = NULL;
+    return;
+  } /* end if */
+  
+  /* a mapped file requires no storage */
+  capacity = (map != NULL) ? 0 : bufsize;
+  
+  /* allocate new infile */
+  new_infile =
+    m2c_mem_alloc(M2C_MEM_INFILE, sizeof(infile_struct_t) + capacity + 1);
+  
+  if (new_infile == NULL) {
+#if (INFILE_USE_MMAP)
+    if (map != NULL) {
+      munmap(map, bufsize);
+    } /* end if */
+#endif
+    fclose(file);
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    *infile = NULL;
+    return;
+  } /* end if */
+  
+  new_infile->capacity = capacity;
+  init_infile(new_infile, file, prefix, streaming, bufsize, map);
+  
+  *infile = new_infile;
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  return;
+} /* end open_infile */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_close(infile)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with infile and passes NULL in infile.
+ * ----------------------------------------------------------------------- */
+
+void infile_close (infile_t *infile) {
+  
+  if ((infile == NULL) || (*infile == NULL)) {
+    return;
+  } /* end if */
+  
+  if ((*infile)->file != NULL) {
+    fclose((*infile)->file);
+  } /* end if */
+  
+  unmap_input(*infile);
+  m2c_mem_free(M2C_MEM_INFILE, *infile);
+  *infile = NULL;
+  
+  return;
+} /* end infile_close */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_reopen(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with infile, if still open, and opens the file
+ * at path,  reusing the infile object if its buffer is large enough.
+ * ----------------------------------------------------------------------- */
+
+void infile_reopen
+  (infile_t *infile, const char *path, infile_status_t *status) {
+  
+  reopen_infile(infile, path, false, status);
+  
+} /* end infile_reopen */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_reopen_prefix(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Like infile_reopen but opens the file at path for reading of a prefix.
+ * ----------------------------------------------------------------------- */
+
+void infile_reopen_prefix
+  (infile_t *infile, const char *path, infile_status_t *status) {
+  
+  reopen_infile(infile, path, true, status);
+  
+} /* end infile_reopen_prefix */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure reopen_infile(infile, path, prefix, status)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with infile, if still open, and opens the file
+ * at path.  The infile object is reused if its capacity suffices,  otherwise
+ * it is replaced by one with the capacity required.  On failure the object
+ * is kept without a file and at end of input.
+ * ----------------------------------------------------------------------- */
+
+static void reopen_infile
+  (infile_t *infile, const char *path, bool prefix, infile_status_t *status) {
+  
+  FILE *file;
+  char *map;
+  bool streaming;
+  size_t bufsize, capacity;
+  infile_t this_infile;
+  
+  /* check pre-conditions */
+  if ((infile == NULL) || (path == NULL)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  if (*infile == NULL) {
+    open_infile(infile, path, prefix, status);
+    return;
+  } /* end if */
+  
+  this_infile = *infile;
+  infile_close_file(this_infile);
+  unmap_input(this_infile);
+  
+  /* discard previous input */
+  this_infile->end = 0;
+  this_infile->index = 0;
+  this_infile->first_line = 1;
+  this_infile->line = 1;
+  this_infile->column = 1;
+  this_infile->marker_set = false;
+  
+  /* open file */
+  file = open_file(path, prefix, &streaming, &bufsize, &map, status);
+  
+  if (file == NULL) {
+    this_infile->status = FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF;
+    return;
+  } /* end if */
+  
+  /* a mapped file requires no storage */
+  capacity = (map != NULL) ? 0 : bufsize;
+  
+  /* grow to the capacity required */
+  if (capacity > this_infile->capacity) {
+    this_infile =
+      m2c_mem_alloc(M2C_MEM_INFILE, sizeof(infile_struct_t) + capacity + 1);
+    
+    if (this_infile == NULL) {
+#if (INFILE_USE_MMAP)
+      if (map != NULL) {
+        munmap(map, bufsize);
+      } /* end if */
+#endif
+      fclose(file);
+      (*infile)->status = FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF;
+      SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    m2c_mem_free(M2C_MEM_INFILE, *infile);
+    this_infile->capacity = capacity;
+  } /* end if */
+  
+  init_infile(this_infile, file, prefix, streaming, bufsize, map);
+  
+  *infile = this_infile;
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  return;
+} /* end reopen_infile */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_close_file(infile)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with infile but keeps the infile object and the
+ * input it has buffered so far.
+ * ----------------------------------------------------------------------- */
+
+void infile_close_file (infile_t infile) {
+  
+  if ((infile == NULL) || (infile->file == NULL)) {
+    return;
+  } /* end if */
+  
+  fclose(infile->file);
+  infile->file = NULL;
+  infile->at_eof = true;
+  
+  return;
+} /* end infile_close_file */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_consume_char(infile)
+ * --------------------------------------------------------------------------
+ * Consumes the current lookahead character in infile and returns the result-
+ * ing new lookahead character without consuming it.
+ * ----------------------------------------------------------------------- */
+
+char infile_consume_char (infile_t infile) {
+  
+  char ch;
+  
+  if (infile == NULL) {
+    return ASCII_NUL;
+  } /* end if */
+  
+  if (NOT(fill_upto(infile, infile->index))) {
+    SET_INFILE_STATUS(infile, FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF);
+    return ASCII_EOT;
+  } /* end if */
+  
+  ch = infile->buffer[infile->index & infile->mask];
+  infile->index++;
+  
+  /* if new line encountered, update line and column counters */
+  if (ch == ASCII_LF) {
+    infile->line++;
+    infile->column = 1;
+  }
+  else if (ch == ASCII_CR) {
+    infile->line++;
+    infile->column = 1;
+    
+    /* if LF follows, skip it */
+    if ((fill_upto(infile, infile->index)) &&
+        (infile->buffer[infile->index & infile->mask] == ASCII_LF)) {
+      infile->index++;
+    } /* end if */
+  }
+  else {
+    infile->column++;
+  } /* end if */
+  
+  return infile_lookahead_char(infile);
+} /* end infile_consume_char */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_skip_char(infile)
+ * --------------------------------------------------------------------------
+ * Consumes the current lookahead character in infile and returns the result-
+ * ing new lookahead character without consuming it.
+ * ----------------------------------------------------------------------- */
+
+char infile_skip_char (infile_t infile) {
+  
+  return infile_consume_char(infile);
+} /* end infile_skip_char */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_skip_to_delimiter(infile, delim1, delim2)
+ * --------------------------------------------------------------------------
+ * Consumes all characters  up to but excluding  the next occurrence of delim1
+ * or delim2,  of a carriage return,  of a control character other than TAB
+ * and LF, of a character above 127, or up to the end of the file.  Line and
+ * column counters are updated in bulk.  Returns the new lookahead character.
+ *
+ * The buffered input is scanned one contiguous run at a time, a streamed
+ * infile is refilled between runs.
+ * ----------------------------------------------------------------------- */
+
+char infile_skip_to_delimiter (infile_t infile, char delim1, char delim2) {
+  
+  uint_t newlines;
+  size_t slot, avail, skipped, tail;
+  
+  if (infile == NULL) {
+    return ASCII_NUL;
+  } /* end if */
+  
+  while (fill_upto(infile, infile->index)) {
+    
+    /* determine contiguous run of buffered input */
+    slot = infile->index & infile->mask;
+    avail = infile->end - infile->index;
+    if (slot + avail > infile->bufsize) {
+      avail = infile->bufsize - slot;
+    } /* end if */
+    
+    skipped = scan_to_delimiter(&infile->buffer[slot],
+      avail, delim1, delim2, infile->clean, &newlines, &tail);
+    
+    /* update reading position and counters */
+    infile->index = infile->index + skipped;
+    if (newlines > 0) {
+      infile->line = infile->line + newlines;
+      infile->column = (uint_t) tail + 1;
+    }
+    else {
+      infile->column = infile->column + (uint_t) skipped;
+    } /* end if */
+    
+    /* stopped before end of run */
+    if (skipped < avail) {
+      break;
+    } /* end if */
+  } /* end while */
+  
+  return infile_lookahead_char(infile);
+} /* end infile_skip_to_delimiter */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_lookahead_char(infile)
+ * --------------------------------------------------------------------------
+ * Returns the current lookahead char in infile without consuming any char.
+ * ----------------------------------------------------------------------- */
+
+char infile_lookahead_char (infile_t infile) {
+  
+  char ch;
+  
+  if (infile == NULL) {
+    return ASCII_NUL;
+  } /* end if */
+  
+  if (NOT(fill_upto(infile, infile->index))) {
+    SET_INFILE_STATUS(infile, FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF);
+    return ASCII_EOT;
+  } /* end if */
+  
+  ch = infile->buffer[infile->index & infile->mask];
+  
+  /* return LF for CR */
+  if (ch == ASCII_CR) {
+    ch = ASCII_LF;
+  } /* end if */
+  
+  SET_INFILE_STATUS(infile, FILEIO_STATUS_SUCCESS);
+  return ch;
+} /* end infile_lookahead_char */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_la2_char(infile)
+ * --------------------------------------------------------------------------
+ * Returns the 2nd lookahead char in infile without consuming any char.
+ * ----------------------------------------------------------------------- */
+
+char infile_la2_char (infile_t infile) {
+  
+  char la2;
+  size_t pos;
+  
+  if (infile == NULL) {
+    return ASCII_NUL;
+  } /* end if */
+  
+  pos = infile->index + 1;
+  
+  if (NOT(fill_upto(infile, pos))) {
+    SET_INFILE_STATUS(infile, FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF);
+    return ASCII_EOT;
+  } /* end if */
+  
+  la2 = infile->buffer[pos & infile->mask];
+  
+  /* skip CR LF sequence if encountered */
+  if ((infile->buffer[infile->index & infile->mask] == ASCII_CR) &&
+      (la2 == ASCII_LF)) {
+    pos++;
+    
+    if (NOT(fill_upto(infile, pos))) {
+      SET_INFILE_STATUS(infile, FILEIO_STATUS_ATTEMPT_TO_READ_PAST_EOF);
+      return ASCII_EOT;
+    } /* end if */
+    
+    la2 = infile->buffer[pos & infile->mask];
+  } /* end if */
+  
+  /* return LF for CR */
+  if (la2 == ASCII_CR) {
+    la2 = ASCII_LF;
+  } /* end if */
+  
+  SET_INFILE_STATUS(infile, FILEIO_STATUS_SUCCESS);
+  return la2;
+} /* end infile_la2_char */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_status(infile)
+ * --------------------------------------------------------------------------
+ * Returns status of the last operation.  Status FILEIO_STATUS_LEXEME_TOO_LONG
+ * is retained by subsequent reads until the lexeme has been fetched.
+ * ----------------------------------------------------------------------- */
+
+infile_status_t infile_status (infile_t infile) {
+  
+  if (infile == NULL) {
+    return FILEIO_STATUS_INVALID_FILENAME;
+  } /* end if */
+  
+  return infile->status;
+} /* end infile_status */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_eof(infile)
+ * --------------------------------------------------------------------------
+ * Returns true if infile has reached the end of the file, else false.
+ * ----------------------------------------------------------------------- */
+
+bool infile_eof (infile_t infile) {
+  
+  if (infile == NULL) {
+    return true;
+  } /* end if */
+  
+  return NOT(fill_upto(infile, infile->index));
+} /* end infile_eof */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_bytes_read(infile)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes read from the file of infile so far.
+ * ----------------------------------------------------------------------- */
+
+size_t infile_bytes_read (infile_t infile) {
+  
+  if (infile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return infile->end;
+} /* end infile_bytes_read */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_validation(infile, validation)
+ * --------------------------------------------------------------------------
+ * Passes the result of validating the input of infile back in validation.
+ * Returns false if infile is streamed.
+ * ----------------------------------------------------------------------- */
+
+bool infile_validation (infile_t infile, infile_validation_t *validation) {
+  
+  if ((infile == NULL) || (infile->streaming)) {
+    return false;
+  } /* end if */
+  
+  WRITE_OUTPARAM(validation, infile->validation);
+  return true;
+} /* end infile_validation */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_is_clean(infile)
+ * --------------------------------------------------------------------------
+ * Returns true if the input of infile is validated and clean,  else false.
+ * ----------------------------------------------------------------------- */
+
+bool infile_is_clean (infile_t infile) {
+  
+  if (infile == NULL) {
+    return false;
+  } /* end if */
+  
+  return infile->clean;
+} /* end infile_is_clean */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_line(infile)
+ * --------------------------------------------------------------------------
+ * Returns the line number of the current reading position of infile.
+ * ----------------------------------------------------------------------- */
+
+uint_t infile_line (infile_t infile) {
+  
+  if (infile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return infile->line;
+} /* end infile_line */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_column(infile)
+ * --------------------------------------------------------------------------
+ * Returns the column number of the current reading position of infile.
+ * ----------------------------------------------------------------------- */
+
+uint_t infile_column (infile_t infile) {
+  
+  if (infile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return infile->column;
+} /* end infile_column */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_mark_lexeme(infile)
+ * --------------------------------------------------------------------------
+ * Marks the current lookahead character as the start of a lexeme.
+ * ----------------------------------------------------------------------- */
+
+void infile_mark_lexeme (infile_t infile) {
+  
+  if (infile == NULL) {
+    return;
+  } /* end if */
+  
+  /* a lexeme that exceeded the ring is abandoned */
+  if (infile->too_long) {
+    infile->too_long = false;
+    infile->status = FILEIO_STATUS_SUCCESS;
+  } /* end if */
+  
+  infile->marker_set = true;
+  infile->marked_index = infile->index;
+  
+  return;
+} /* end infile_mark_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_lexeme(infile)
+ * --------------------------------------------------------------------------
+ * Returns the current lexeme.  Returns NULL if no lexeme has been marked, or
+ * if no chars have been consumed since infile_mark_lexeme() has been called.
+ * Returns NULL  with status FILEIO_STATUS_LEXEME_TOO_LONG  if the lexeme of
+ * a streamed infile exceeded the ring.
+ * ----------------------------------------------------------------------- */
+
+intstr_t infile_lexeme (infile_t infile) {
+  
+  return get_marked_lexeme(infile, false, 0);
+} /* end infile_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_lexeme_with_hash(infile, key)
+ * --------------------------------------------------------------------------
+ * Returns the current lexeme  like function infile_lexeme,  but interns it
+ * using the precomputed hash key.
+ * ----------------------------------------------------------------------- */
+
+intstr_t infile_lexeme_with_hash (infile_t infile, intstr_hash_t key) {
+  
+  return get_marked_lexeme(infile, true, key);
+} /* end infile_lexeme_with_hash */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_lexeme_slice(infile, slice)
+ * --------------------------------------------------------------------------
+ * Passes a slice for the current lexeme in slice without copying, clears the
+ * marker and returns true.   Returns false  and leaves the marker unchanged
+ * if no lexeme has been marked,  if no chars have been consumed  since the
+ * lexeme was marked,  or if infile is streamed.
+ * ----------------------------------------------------------------------- */
+
+bool infile_lexeme_slice (infile_t infile, infile_slice_t *slice) {
+  
+  if ((infile == NULL) || (slice == NULL) || (infile->streaming) ||
+      (NOT(infile->marker_set)) || (infile->marked_index == infile->index)) {
+    return false;
+  } /* end if */
+  
+  slice->offset = infile->marked_index;
+  slice->length = infile->index - infile->marked_index;
+  
+  /* clear marker */
+  infile->marker_set = false;
+  
+  return true;
+} /* end infile_lexeme_slice */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_slice_chars(infile, slice)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the first character of slice in the buffer of infile.
+ * The characters are not NUL terminated.  Returns NULL if slice is empty or
+ * does not lie within the buffer of infile.
+ * ----------------------------------------------------------------------- */
+
+const char *infile_slice_chars (infile_t infile, infile_slice_t slice) {
+  
+  if ((infile == NULL) || (infile->streaming) || (slice.length == 0) ||
+      (slice.offset + slice.length > infile->end)) {
+    return NULL;
+  } /* end if */
+  
+  return &infile->buffer[slice.offset];
+} /* end infile_slice_chars */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_slice_lexeme(infile, slice)
+ * --------------------------------------------------------------------------
+ * Returns an interned string  for the characters of slice.  Returns NULL if
+ * slice is empty or invalid,  or if the string could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+intstr_t infile_slice_lexeme (infile_t infile, infile_slice_t slice) {
+  
+  const char *chars;
+  intstr_t lexeme;
+  intstr_status_t status;
+  
+  chars = infile_slice_chars(infile, slice);
+  
+  if (chars == NULL) {
+    return NULL;
+  } /* end if */
+  
+  lexeme = intstr_for_slice(chars, 0, (uint_t) slice.length, &status);
+  
+  if (status == INTSTR_STATUS_ALLOCATION_FAILED) {
+    infile->status = FILEIO_STATUS_ALLOCATION_FAILED;
+    return NULL;
+  } /* end if */
+  
+  return lexeme;
+} /* end infile_slice_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function infile_print_handler_installed()
+ * --------------------------------------------------------------------------
+ * Returns true if a print handler has been installed, else false.
+ * ----------------------------------------------------------------------- */
+
+bool infile_print_handler_installed (void) {
+  
+  return (print_handler != NULL);
+} /* end infile_print_handler_installed */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_install_print_handler(infile, handler)
+ * --------------------------------------------------------------------------
+ * Installs a  print handler  for use by procedure inline_print_line.
+ * ----------------------------------------------------------------------- */
+
+void infile_install_print_handler (print_handler_t handler) {
+  
+  print_handler = handler;
+  
+  return;
+} /* end infile_install_print_handler */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_print_line(infile, line_no)
+ * --------------------------------------------------------------------------
+ * Prints the line with the given line number  within infile  using the print
+ * handler installed by procedure  infile_install_print_handler.  Will return
+ * without action if no print handler has been installed prior to the call. 
+ * ----------------------------------------------------------------------- */
+
+void infile_print_line (infile_t infile, uint_t line_no) {
+  
+  if ((infile == NULL) || (line_no == 0) || (print_handler == NULL)) {
+    return;
+  } /* end if */
+  
+  if (infile->streaming) {
+    print_streamed_line(infile, line_no);
+  }
+  else {
+    print_buffered_line(infile, line_no);
+  } /* end if */
+  
+  return;
+} /* end infile_print_line */
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_visit_lines(infile, count, line_no, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor for each of the count lines whose line numbers are given in
+ * ascending order in array line_no,  fetching all lines in a single pass.
+ * ----------------------------------------------------------------------- */
+
+void infile_visit_lines
+  (infile_t infile,          /* in */
+   uint_t count,             /* in */
+   const uint_t line_no[],   /* in */
+   line_visitor_t visitor,   /* in */
+   void *context) {          /* in */
+  
+  if ((infile == NULL) || (count == 0) ||
+      (line_no == NULL) || (visitor == NULL)) {
+    return;
+  } /* end if */
+  
+  if (infile->streaming) {
+    visit_streamed_lines(infile, count, line_no, visitor, context);
+  }
+  else {
+    visit_buffered_lines(infile, count, line_no, visitor, context);
+  } /* end if */
+  
+  return;
+} /* end infile_visit_lines */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function fill_upto(infile, pos)
+ * --------------------------------------------------------------------------
+ * Reads chunks into the ring of a streamed infile until the character at
+ * position pos is buffered.  Returns true if the character at pos is
+ * available, returns false if pos lies beyond the end of the file.
+ * ----------------------------------------------------------------------- */
+
+static bool fill_upto (infile_t infile, size_t pos) {
+  
+  while (pos >= infile->end) {
+    if (infile->at_eof) {
+      return false;
+    } /* end if */
+    
+    read_chunk(infile);
+  } /* end while */
+  
+  return true;
+} /* end fill_upto */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure read_chunk(infile)
+ * --------------------------------------------------------------------------
+ * Reads up to one chunk from the file associated with a streamed infile into
+ * the ring slot following the last buffered character.
+ *
+ * The oldest character that must be retained is the marked character if a
+ * lexeme has been marked, else the character at the reading position.  If
+ * the chunk would overwrite a marked lexeme, the lexeme exceeds the ring and
+ * the marker is cleared.  Status FILEIO_STATUS_LEXEME_TOO_LONG is then set
+ * and retained until the lexeme is fetched.
+ * ----------------------------------------------------------------------- */
+
+static void read_chunk (infile_t infile) {
+  
+  size_t oldest, slot, count;
+  
+  slot = infile->end & infile->mask;
+  count = infile->chunk_size - (slot & (infile->chunk_size - 1));
+  
+  if (infile->marker_set) {
+    oldest = infile->marked_index;
+    
+    if (infile->end + count - oldest > infile->bufsize) {
+      infile->marker_set = false;
+      infile->too_long = true;
+      infile->status = FILEIO_STATUS_LEXEME_TOO_LONG;
+    } /* end if */
+  } /* end if */
+  
+  count = fread(&infile->buffer[slot], sizeof(char), count, infile->file);
+  
+  if (count == 0) {
+    infile->at_eof = true;
+  } /* end if */
+  
+  infile->end = infile->end + count;
+  
+  return;
+} /* end read_chunk */
+
+
+/* --------------------------------------------------------------------------
+ * private function get_marked_lexeme(infile, with_hash, key)
+ * --------------------------------------------------------------------------
+ * Returns an interned string for the marked lexeme and clears the marker.
+ * If with_hash is true,  the lexeme is interned using precomputed hash key.
+ * Returns NULL if no lexeme has been marked,  or if no chars have been
+ * consumed since the marker was set.  Returns NULL and leaves status
+ * FILEIO_STATUS_LEXEME_TOO_LONG set if the lexeme exceeded the ring.
+ *
+ * A lexeme of a streamed infile that wraps around the end of the ring is
+ * copied into a contiguous buffer before it is interned.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t get_marked_lexeme
+  (infile_t infile, bool with_hash, intstr_hash_t key) {
+  
+  intstr_t lexeme;
+  const char *chars;
+  size_t offset, length, head;
+  intstr_status_t status;
+  char lexbuf[INFILE_RING_SIZE];
+  
+  if (infile == NULL) {
+    return NULL;
+  } /* end if */
+  
+  /* lexeme exceeded the ring, report and release the status */
+  if (infile->too_long) {
+    infile->too_long = false;
+    return NULL;
+  } /* end if */
+  
+  if ((NOT(infile->marker_set)) ||
+      (infile->marked_index == infile->index)) {
+    return NULL;
+  } /* end if */
+  
+  offset = infile->marked_index & infile->mask;
+  length = infile->index - infile->marked_index;
+  
+  if /* contiguous */ (offset + length <= infile->bufsize) {
+    chars = infile->buffer;
+  }
+  else /* wraps around end of ring */ {
+    head = infile->bufsize - offset;
+    memcpy(lexbuf, &infile->buffer[offset], head);
+    memcpy(&lexbuf[head], infile->buffer, length - head);
+    chars = lexbuf;
+    offset = 0;
+  } /* end if */
+  
+  if (with_hash) {
+    lexeme = intstr_for_slice_with_hash(chars, offset, length, key, &status);
+  }
+  else {
+    lexeme = intstr_for_slice(chars, offset, length, &status);
+  } /* end if */
+  
+  if (status == INTSTR_STATUS_ALLOCATION_FAILED) {
+    infile->status = FILEIO_STATUS_ALLOCATION_FAILED;
+    return NULL;
+  } /* end if */
+  
+  /* clear marker */
+  infile->marker_set = false;
+  
+  return lexeme;
+} /* end get_marked_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_scan_stop_char(ch, delim1, delim2)
+ * --------------------------------------------------------------------------
+ * Returns true if ch terminates a delimiter scan, else false.
+ * ----------------------------------------------------------------------- */
+
+#define IS_SCAN_STOP_CHAR(_ch, _delim1, _delim2) \
+  (((_ch) == (_delim1)) || ((_ch) == (_delim2)) || \
+   (((unsigned char) (_ch) < 0x20) && \
+    ((_ch) != ASCII_TAB) && ((_ch) != ASCII_LF)) || \
+   ((unsigned char) (_ch) >= 0x7F))
+
+
+#if (INFILE_SCAN_SIMD)
+/* --------------------------------------------------------------------------
+ * private procedure scan_block(chars, delim1, delim2, clean, ...)
+ * --------------------------------------------------------------------------
+ * Classifies a block of SCAN_BLOCK_SIZE bytes at chars.  Passes back a mask
+ * of stop characters in stop_mask and a mask of line feeds in lf_mask.  The
+ * bits of byte n of the block are at bit position n * SCAN_BITS_PER_BYTE.
+ * If clean is true,  the block holds no control characters other than TAB,
+ * LF and CR and no bytes above 0x7E,  only CR needs to be classified then.
+ * ----------------------------------------------------------------------- */
+
+static void scan_block
+  (const char *chars, char delim1, char delim2, bool clean,
+   uint64_t *stop_mask, uint64_t *lf_mask) {
+  
+#if defined(__SSE2__)
+  __m128i block, stop, lf, ctrl;
+  
+  block = _mm_loadu_si128((const __m128i *) chars);
+  lf = _mm_cmpeq_epi8(block, _mm_set1_epi8(ASCII_LF));
+  
+  if (clean) {
+    ctrl = _mm_cmpeq_epi8(block, _mm_set1_epi8(ASCII_CR));
+  }
+  else /* bytes 0x00 to 0x1F, except TAB and LF, and bytes 0x7F to 0xFF */ {
+    ctrl = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1F)), block);
+    ctrl = _mm_andnot_si128
+      (_mm_cmpeq_epi8(block, _mm_set1_epi8(ASCII_TAB)), ctrl);
+    ctrl = _mm_andnot_si128(lf, ctrl);
+    ctrl = _mm_or_si128(ctrl,
+      _mm_cmpeq_epi8(_mm_max_epu8(block, _mm_set1_epi8(0x7F)), block));
+  } /* end if */
+  
+  stop = _mm_or_si128(ctrl, _mm_or_si128(
+    _mm_cmpeq_epi8(block, _mm_set1_epi8(delim1)),
+    _mm_cmpeq_epi8(block, _mm_set1_epi8(delim2))));
+  
+  *stop_mask = (uint64_t) _mm_movemask_epi8(stop);
+  *lf_mask = (uint64_t) _mm_movemask_epi8(lf);
+  
+#else /* NEON */
+  uint8x16_t block, stop, lf, ctrl;
+  
+  block = vld1q_u8((const uint8_t *) chars);
+  lf = vceqq_u8(block, vdupq_n_u8(ASCII_LF));
+  
+  if (clean) {
+    ctrl = vceqq_u8(block, vdupq_n_u8(ASCII_CR));
+  }
+  else /* bytes 0x00 to 0x1F, except TAB and LF, and bytes 0x7F to 0xFF */ {
+    ctrl = vcleq_u8(block, vdupq_n_u8(0x1F));
+    ctrl = vbicq_u8(ctrl, vceqq_u8(block, vdupq_n_u8(ASCII_TAB)));
+    ctrl = vbicq_u8(ctrl, lf);
+    ctrl = vorrq_u8(ctrl, vcgeq_u8(block, vdupq_n_u8(0x7F)));
+  } /* end if */
+  
+  stop = vorrq_u8(ctrl, vorrq_u8(
+    vceqq_u8(block, vdupq_n_u8((uint8_t) delim1)),
+    vceqq_u8(block, vdupq_n_u8((uint8_t) delim2))));
+  
+  /* narrow each byte to a nibble */
+  *stop_mask = vget_lane_u64(vreinterpret_u64_u8(
+    vshrn_n_u16(vreinterpretq_u16_u8(stop), 4)), 0);
+  *lf_mask = vget_lane_u64(vreinterpret_u64_u8(
+    vshrn_n_u16(vreinterpretq_u16_u8(lf), 4)), 0) & 0x1111111111111111ULL;
+#endif
+  
+  return;
+} /* end scan_block */
+
+
+/* --------------------------------------------------------------------------
+ * private functions trailing_zeros(mask), leading_zeros(mask), popcount(mask)
+ * --------------------------------------------------------------------------
+ * Bit counting on a non-zero 64-bit mask.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__GNUC__)
+#define trailing_zeros(_mask) ((uint_t) __builtin_ctzll(_mask))
+#define leading_zeros(_mask) ((uint_t) __builtin_clzll(_mask))
+#define popcount(_mask) ((uint_t) __builtin_popcountll(_mask))
+#else
+static uint_t trailing_zeros (uint64_t mask) {
+  uint_t count = 0;
+  while ((mask & 1) == 0) { mask = mask >> 1; count++; }
+  return count;
+} /* end trailing_zeros */
+
+static uint_t leading_zeros (uint64_t mask) {
+  uint_t count = 0;
+  while ((mask & 0x8000000000000000ULL) == 0) { mask = mask << 1; count++; }
+  return count;
+} /* end leading_zeros */
+
+static uint_t popcount (uint64_t mask) {
+  uint_t count = 0;
+  while (mask != 0) { mask = mask & (mask - 1); count++; }
+  return count;
+} /* end popcount */
+#endif
+#endif /* INFILE_SCAN_SIMD */
+
+
+/* --------------------------------------------------------------------------
+ * private function scan_to_delimiter(chars, length, delim1, delim2, ...)
+ * --------------------------------------------------------------------------
+ * Scans up to length bytes at chars for the first stop character.  Returns
+ * the number of bytes preceding it, or length if there is none.  Passes the
+ * number of line feeds among the skipped bytes back in newlines and, if any,
+ * the number of skipped bytes after the last line feed back in tail.  If
+ * clean is true,  the bytes at chars are known to be validated and clean.
+ * ----------------------------------------------------------------------- */
+
+static size_t scan_to_delimiter
+  (const char *chars, size_t length, char delim1, char delim2, bool clean,
+   uint_t *newlines, size_t *tail) {
+  
+  size_t index, last_lf;
+  uint_t lines;
+#if (INFILE_SCAN_SIMD)
+  uint64_t stop_mask, lf_mask;
+  uint_t stop_pos;
+#endif
+  
+  index = 0;
+  lines = 0;
+  last_lf = 0;
+  
+#if (INFILE_SCAN_SIMD)
+  /* whole blocks */
+  while (index + SCAN_BLOCK_SIZE <= length) {
+    scan_block
+      (&chars[index], delim1, delim2, clean, &stop_mask, &lf_mask);
+    
+    if (stop_mask != 0) {
+      /* consider only line feeds before the stop character */
+      stop_pos = trailing_zeros(stop_mask) / SCAN_BITS_PER_BYTE;
+      lf_mask = lf_mask & ((((uint64_t) 1) << (stop_pos * SCAN_BITS_PER_BYTE)) - 1);
+      
+      if (lf_mask != 0) {
+        lines = lines + popcount(lf_mask);
+        last_lf = index + (63 - leading_zeros(lf_mask)) / SCAN_BITS_PER_BYTE;
+      } /* end if */
+      
+      *newlines = lines;
+      *tail = index + stop_pos - last_lf - 1;
+      return index + stop_pos;
+    } /* end if */
+    
+    if (lf_mask != 0) {
+      lines = lines + popcount(lf_mask);
+      last_lf = index + (63 - leading_zeros(lf_mask)) / SCAN_BITS_PER_BYTE;
+    } /* end if */
+    
+    index = index + SCAN_BLOCK_SIZE;
+  } /* end while */
+#else
+  (void) clean;
+#endif
+  
+  /* remaining bytes */
+  while ((index < length) &&
+         (NOT(IS_SCAN_STOP_CHAR(chars[index], delim1, delim2)))) {
+    if (chars[index] == ASCII_LF) {
+      lines++;
+      last_lf = index;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  *newlines = lines;
+  *tail = index - last_lf - 1;
+  return index;
+} /* end scan_to_delimiter */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_invalid_char(ch)
+ * --------------------------------------------------------------------------
+ * Returns true if ch is a control character other than TAB,  LF and CR,  or
+ * a character above 126,  else false.
+ * ----------------------------------------------------------------------- */
+
+#define IS_INVALID_CHAR(_ch) \
+  ((((unsigned char) (_ch) < 0x20) && ((_ch) != ASCII_TAB) && \
+    ((_ch) != ASCII_LF) && ((_ch) != ASCII_CR)) || \
+   ((unsigned char) (_ch) >= 0x7F))
+
+
+#if (INFILE_SCAN_SIMD)
+/* --------------------------------------------------------------------------
+ * private procedure validate_block(chars, invalid_mask, eol_mask)
+ * --------------------------------------------------------------------------
+ * Classifies a block of SCAN_BLOCK_SIZE bytes at chars.  Passes back a mask
+ * of invalid characters in invalid_mask and a mask of line feeds and carriage
+ * returns in eol_mask,  with one bit set per character.  The bits of byte n
+ * of the block are at bit position n * SCAN_BITS_PER_BYTE.
+ * ----------------------------------------------------------------------- */
+
+static void validate_block
+  (const char *chars, uint64_t *invalid_mask, uint64_t *eol_mask) {
+  
+#if defined(__SSE2__)
+  __m128i block, eol, invalid;
+  
+  block = _mm_loadu_si128((const __m128i *) chars);
+  
+  eol = _mm_or_si128(
+    _mm_cmpeq_epi8(block, _mm_set1_epi8(ASCII_LF)),
+    _mm_cmpeq_epi8(block, _mm_set1_epi8(ASCII_CR)));
+  
+  /* bytes 0x00 to 0x1F, except TAB, LF and CR, and bytes 0x7F to 0xFF */
+  invalid = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1F)), block);
+  invalid = _mm_andnot_si128
+    (_mm_cmpeq_epi8(block, _mm_set1_epi8(ASCII_TAB)), invalid);
+  invalid = _mm_andnot_si128(eol, invalid);
+  invalid = _mm_or_si128(invalid,
+    _mm_cmpeq_epi8(_mm_max_epu8(block, _mm_set1_epi8(0x7F)), block));
+  
+  *invalid_mask = (uint64_t) _mm_movemask_epi8(invalid);
+  *eol_mask = (uint64_t) _mm_movemask_epi8(eol);
+  
+#else /* NEON */
+  uint8x16_t block, eol, invalid;
+  
+  block = vld1q_u8((const uint8_t *) chars);
+  
+  eol = vorrq_u8(
+    vceqq_u8(block, vdupq_n_u8(ASCII_LF)),
+    vceqq_u8(block, vdupq_n_u8(ASCII_CR)));
+  
+  /* bytes 0x00 to 0x1F, except TAB, LF and CR, and bytes 0x7F to 0xFF */
+  invalid = vcleq_u8(block, vdupq_n_u8(0x1F));
+  invalid = vbicq_u8(invalid, vceqq_u8(block, vdupq_n_u8(ASCII_TAB)));
+  invalid = vbicq_u8(invalid, eol);
+  invalid = vorrq_u8(invalid, vcgeq_u8(block, vdupq_n_u8(0x7F)));
+  
+  /* narrow each byte to a nibble */
+  *invalid_mask = vget_lane_u64(vreinterpret_u64_u8(
+    vshrn_n_u16(vreinterpretq_u16_u8(invalid), 4)), 0);
+  *eol_mask = vget_lane_u64(vreinterpret_u64_u8(
+    vshrn_n_u16(vreinterpretq_u16_u8(eol), 4)), 0) & 0x1111111111111111ULL;
+#endif
+  
+  return;
+} /* end validate_block */
+#endif /* INFILE_SCAN_SIMD */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure end_line(chars, pos, line_start, validation)
+ * --------------------------------------------------------------------------
+ * Records the line terminator at position pos of chars in validation,  the
+ * current line started at position line_start.  A LF that follows a CR
+ * completes the CR LF terminator and ends no line.  Passes the start of
+ * the next line back in line_start.
+ * ----------------------------------------------------------------------- */
+
+static void end_line
+  (const char *chars, size_t pos, size_t *line_start,
+   infile_validation_t *validation) {
+  
+  size_t length;
+  
+  if ((chars[pos] == ASCII_LF) && (pos > 0) &&
+      (chars[pos - 1] == ASCII_CR)) {
+    *line_start = pos + 1;
+    return;
+  } /* end if */
+  
+  length = pos - *line_start;
+  validation->line_count++;
+  
+  if (length > validation->max_line_length) {
+    validation->max_line_length = (uint_t) length;
+  } /* end if */
+  
+  /* first character past the maximum line length */
+  if ((length > INFILE_MAX_LINE_LENGTH) &&
+      (*line_start + INFILE_MAX_LINE_LENGTH < validation->first_invalid)) {
+    validation->first_invalid = *line_start + INFILE_MAX_LINE_LENGTH;
+  } /* end if */
+  
+  *line_start = pos + 1;
+  return;
+} /* end end_line */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure validate_input(chars, length, validation)
+ * --------------------------------------------------------------------------
+ * Validates the length bytes at chars in a single pass and passes the result
+ * back in validation.  Whole blocks are classified with SSE2 or NEON vector
+ * instructions where available,  only line terminators are then visited one
+ * at a time.
+ * ----------------------------------------------------------------------- */
+
+static void validate_input
+  (const char *chars, size_t length, infile_validation_t *validation) {
+  
+  size_t index, line_start;
+#if (INFILE_SCAN_SIMD)
+  uint64_t invalid_mask, eol_mask;
+  size_t pos;
+#endif
+  
+  validation->first_invalid = length;
+  validation->line_count = 0;
+  validation->max_line_length = 0;
+  
+  index = 0;
+  line_start = 0;
+  
+#if (INFILE_SCAN_SIMD)
+  /* whole blocks */
+  while (index + SCAN_BLOCK_SIZE <= length) {
+    validate_block(&chars[index], &invalid_mask, &eol_mask);
+    
+    if (invalid_mask != 0) {
+      pos = index + trailing_zeros(invalid_mask) / SCAN_BITS_PER_BYTE;
+      
+      if (pos < validation->first_invalid) {
+        validation->first_invalid = pos;
+      } /* end if */
+    } /* end if */
+    
+    /* visit line terminators in order */
+    while (eol_mask != 0) {
+      pos = index + trailing_zeros(eol_mask) / SCAN_BITS_PER_BYTE;
+      end_line(chars, pos, &line_start, validation);
+      eol_mask = eol_mask & (eol_mask - 1);
+    } /* end while */
+    
+    index = index + SCAN_BLOCK_SIZE;
+  } /* end while */
+#endif
+  
+  /* remaining bytes */
+  while (index < length) {
+    if ((chars[index] == ASCII_LF) || (chars[index] == ASCII_CR)) {
+      end_line(chars, index, &line_start, validation);
+    }
+    else if ((IS_INVALID_CHAR(chars[index])) &&
+             (index < validation->first_invalid)) {
+      validation->first_invalid = index;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  /* last line without terminator */
+  if (line_start < length) {
+    validation->line_count++;
+    
+    if (length - line_start > validation->max_line_length) {
+      validation->max_line_length = (uint_t) (length - line_start);
+    } /* end if */
+    
+    if ((length - line_start > INFILE_MAX_LINE_LENGTH) &&
+        (line_start + INFILE_MAX_LINE_LENGTH < validation->first_invalid)) {
+      validation->first_invalid = line_start + INFILE_MAX_LINE_LENGTH;
+    } /* end if */
+  } /* end if */
+  
+  return;
+} /* end validate_input */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure print_buffered_line(infile, line_no)
+ * --------------------------------------------------------------------------
+ * Prints line line_no of an infile that has been read in whole.
+ * ----------------------------------------------------------------------- */
+
+static void print_buffered_line (infile_t infile, uint_t line_no) {
+  
+  char ch;
+  uint_t line, count;
+  size_t index;
+  
+  /* find start of line */
+  index = 0;
+  line = infile->first_line;
+  while ((line < line_no) && (index < infile->end)) {
+    ch = infile->buffer[index];
+    index++;
+    
+    if (ch == ASCII_LF) {
+      line++;
+    }
+    else if (ch == ASCII_CR) {
+      line++;
+      if ((index < infile->end) && (infile->buffer[index] == ASCII_LF)) {
+        index++;
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  if (line != line_no) {
+    return;
+  } /* end if */
+  
+  /* print line */
+  count = 0;
+  while ((index < infile->end) && (count < INFILE_MAX_LINE_LENGTH)) {
+    ch = infile->buffer[index];
+    
+    if ((ch == ASCII_LF) || (ch == ASCII_CR)) {
+      break;
+    } /* end if */
+    
+    print_handler(ch);
+    index++;
+    count++;
+  } /* end while */
+  
+  return;
+} /* end print_buffered_line */
+
+
+/* --------------------------------------------------------------------------
+ * private function open_file(path, prefix, streaming, bufsize, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path and returns its stream,  or NULL on failure.  Passes
+ * back in streaming whether the file is to be streamed and in bufsize the
+ * size of buffer it requires.  Prefixes and files beyond the size limit or
+ * of unknown size are streamed.  Passes back in map a read-only mapping of
+ * a file that is read in whole,  or NULL if it is to be read with fread().
+ * ----------------------------------------------------------------------- */
+
+static FILE *open_file
+  (const char *path, bool prefix, bool *streaming, size_t *bufsize,
+   char **map, infile_status_t *status) {
+  
+  FILE *file;
+  file_info_t info;
+  
+  *map = NULL;
+  file = fopen(path, "r");
+  
+  if (file == NULL) {
+    if ((errno == ENOENT) || (errno == ENOTDIR)) {
+      SET_STATUS(status, FILEIO_STATUS_FILE_NOT_FOUND);
+    }
+    else if (errno == ENAMETOOLONG) {
+      SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    }
+    else if (errno == EACCES) {
+      SET_STATUS(status, FILEIO_STATUS_ACCESS_DENIED);
+    }
+    else {
+      SET_STATUS(status, FILEIO_STATUS_DEVICE_ERROR);
+    } /* end if */
+    return NULL;
+  } /* end if */
+  
+  /* the size is that of the file opened,  without a second pathname lookup */
+  if ((prefix) || (get_stream_file_info(file, &info) == false) ||
+      (info.type != FILE_TYPE_REGULAR) || (info.size > M2C_MAX_INFILE_SIZE)) {
+    *streaming = true;
+    *bufsize = INFILE_RING_SIZE;
+  }
+  else /* read in whole */ {
+    *streaming = false;
+    *bufsize = (size_t) info.size;
+    *map = map_file(file, *bufsize);
+  } /* end if */
+  
+  return file;
+} /* end open_file */
+
+
+/* --------------------------------------------------------------------------
+ * private function map_file(file, size)
+ * --------------------------------------------------------------------------
+ * Maps the size bytes of file read-only into memory  and returns a pointer
+ * to the mapping.  Returns NULL if file is empty,  if it cannot be mapped,
+ * or if memory mapped input is not available on the host.
+ * ----------------------------------------------------------------------- */
+
+static char *map_file (FILE *file, size_t size) {
+  
+#if (INFILE_USE_MMAP)
+  void *map;
+  
+  /* an empty file cannot be mapped */
+  if (size == 0) {
+    return NULL;
+  } /* end if */
+  
+  map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  
+  if (map == MAP_FAILED) {
+    return NULL;
+  } /* end if */
+  
+#if defined(MADV_SEQUENTIAL)
+  /* input is read front to back,  advise kernel to read ahead */
+  madvise(map, size, MADV_SEQUENTIAL);
+#endif
+  
+  return (char *) map;
+#else
+  return NULL;
+#endif
+} /* end map_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure unmap_input(infile)
+ * --------------------------------------------------------------------------
+ * Releases the mapping of infile if its input is mapped  and resets its
+ * buffer to its storage.
+ * ----------------------------------------------------------------------- */
+
+static void unmap_input (infile_t infile) {
+  
+#if (INFILE_USE_MMAP)
+  if (infile->mapped) {
+    munmap(infile->buffer, infile->bufsize);
+  } /* end if */
+#endif
+  
+  infile->mapped = false;
+  infile->buffer = infile->storage;
+  
+  return;
+} /* end unmap_input */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure init_infile(infile, file, prefix, streaming, bufsize, map)
+ * --------------------------------------------------------------------------
+ * Initialises infile for reading from file  with a buffer of bufsize bytes.
+ * If map is not NULL,  the buffer is the mapping of the file at map,  else
+ * it is the storage of infile whose capacity bufsize must not exceed.  Reads
+ * a file that is neither streamed nor mapped into the buffer in whole.
+ * ----------------------------------------------------------------------- */
+
+static void init_infile
+  (infile_t infile, FILE *file, bool prefix, bool streaming, size_t bufsize,
+   char *map) {
+  
+  infile->file = file;
+  infile->streaming = streaming;
+  infile->chunk_size = INFILE_CHUNK_SIZE;
+  infile->bufsize = bufsize;
+  infile->end = 0;
+  infile->index = 0;
+  infile->first_line = 1;
+  infile->line = 1;
+  infile->column = 1;
+  infile->marker_set = false;
+  infile->marked_index = 0;
+  infile->too_long = false;
+  infile->status = FILEIO_STATUS_SUCCESS;
+  infile->mapped = (map != NULL);
+  infile->buffer = (map != NULL) ? map : infile->storage;
+  
+  if (prefix) {
+    /* read only what is consumed */
+    setvbuf(file, NULL, _IONBF, 0);
+    infile->chunk_size = INFILE_PREFIX_CHUNK_SIZE;
+  } /* end if */
+  
+  if (streaming) {
+    infile->at_eof = false;
+    infile->mask = INFILE_RING_SIZE - 1;
+    infile->clean = false;
+  }
+  else /* read in whole */ {
+    if (infile->mapped) {
+      /* the mapping holds the file contents */
+      infile->end = bufsize;
+    }
+    else /* read file contents into buffer */ {
+      infile->end = fread(infile->buffer, sizeof(char), bufsize, file);
+      infile->buffer[infile->end] = ASCII_NUL;
+    } /* end if */
+    
+    infile->at_eof = true;
+    infile->mask = ~((size_t) 0);
+    
+    /* validate the entire input once */
+    validate_input(infile->buffer, infile->end, &infile->validation);
+    infile->clean = (infile->validation.first_invalid == infile->end);
+  } /* end if */
+  
+  return;
+} /* end init_infile */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure print_streamed_line(infile, line_no)
+ * --------------------------------------------------------------------------
+ * Prints line line_no of a streamed infile.  The line may no longer be held
+ * in the ring and is therefore read from the file.  The file position is
+ * restored afterwards, the ring is not modified.
+ * ----------------------------------------------------------------------- */
+
+static void print_streamed_line (infile_t infile, uint_t line_no) {
+  
+  int ch;
+  long int saved_pos;
+  uint_t line, count;
+  
+  if (infile->file == NULL) {
+    return;
+  } /* end if */
+  
+  saved_pos = ftell(infile->file);
+  
+  if ((saved_pos < 0) || (fseek(infile->file, 0, SEEK_SET) != 0)) {
+    return;
+  } /* end if */
+  
+  /* find start of line */
+  line = 1;
+  while (line < line_no) {
+    ch = getc(infile->file);
+    
+    if (ch == EOF) {
+      break;
+    }
+    else if (ch == ASCII_LF) {
+      line++;
+    }
+    else if (ch == ASCII_CR) {
+      line++;
+      ch = getc(infile->file);
+      if ((ch != ASCII_LF) && (ch != EOF)) {
+        ungetc(ch, infile->file);
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  /* print line */
+  if (line == line_no) {
+    count = 0;
+    ch = getc(infile->file);
+    while ((ch != EOF) && (ch != ASCII_LF) && (ch != ASCII_CR) &&
+           (count < INFILE_MAX_LINE_LENGTH)) {
+      print_handler((char) ch);
+      count++;
+      ch = getc(infile->file);
+    } /* end while */
+  } /* end if */
+  
+  /* restore file position */
+  clearerr(infile->file);
+  fseek(infile->file, saved_pos, SEEK_SET);
+  
+  return;
+} /* end print_streamed_line */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure visit_buffered_lines(infile, count, line_no, ...)
+ * --------------------------------------------------------------------------
+ * Visits lines of an infile that has been read in whole,  scanning the buffer
+ * once from its start up to the last requested line.
+ * ----------------------------------------------------------------------- */
+
+static void visit_buffered_lines
+  (infile_t infile, uint_t count, const uint_t line_no[],
+   line_visitor_t visitor, void *context) {
+  
+  char ch;
+  uint_t line, next, length;
+  size_t index, start;
+  
+  index = 0;
+  line = infile->first_line;
+  next = 0;
+  
+  while ((next < count) && (index <= infile->end)) {
+    
+    /* skip requested line numbers already passed */
+    if (line_no[next] < line) {
+      next++;
+      continue;
+    } /* end if */
+    
+    /* find end of current line */
+    start = index;
+    while ((index < infile->end) &&
+           (infile->buffer[index] != ASCII_LF) &&
+           (infile->buffer[index] != ASCII_CR)) {
+      index++;
+    } /* end while */
+    
+    if (line == line_no[next]) {
+      length = (uint_t) (index - start);
+      if (length > INFILE_MAX_LINE_LENGTH) {
+        length = INFILE_MAX_LINE_LENGTH;
+      } /* end if */
+      
+      visitor(line, &infile->buffer[start], length, context);
+      next++;
+    } /* end if */
+    
+    if (index >= infile->end) {
+      break;
+    } /* end if */
+    
+    /* skip LF, CR or CR LF */
+    ch = infile->buffer[index];
+    index++;
+    
+    if ((ch == ASCII_CR) &&
+        (index < infile->end) && (infile->buffer[index] == ASCII_LF)) {
+      index++;
+    } /* end if */
+    
+    line++;
+  } /* end while */
+  
+  return;
+} /* end visit_buffered_lines */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure visit_streamed_lines(infile, count, line_no, ...)
+ * --------------------------------------------------------------------------
+ * Visits lines of a streamed infile.  The lines may no longer be held in the
+ * ring and are therefore read from the file in one pass.  The file position
+ * is restored afterwards, the ring is not modified.
+ * ----------------------------------------------------------------------- */
+
+static void visit_streamed_lines
+  (infile_t infile, uint_t count, const uint_t line_no[],
+   line_visitor_t visitor, void *context) {
+  
+  int ch;
+  long int saved_pos;
+  uint_t line, next, length;
+  char chars[INFILE_MAX_LINE_LENGTH + 1];
+  
+  if (infile->file == NULL) {
+    return;
+  } /* end if */
+  
+  saved_pos = ftell(infile->file);
+  
+  if ((saved_pos < 0) || (fseek(infile->file, 0, SEEK_SET) != 0)) {
+    return;
+  } /* end if */
+  
+  line = 1;
+  next = 0;
+  ch = getc(infile->file);
+  
+  while (next < count) {
+    
+    /* skip requested line numbers already passed */
+    if (line_no[next] < line) {
+      next++;
+      continue;
+    } /* end if */
+    
+    /* read current line, collecting it if requested */
+    length = 0;
+    while ((ch != EOF) && (ch != ASCII_LF) && (ch != ASCII_CR)) {
+      if ((line == line_no[next]) && (length < INFILE_MAX_LINE_LENGTH)) {
+        chars[length] = (char) ch;
+        length++;
+      } /* end if */
+      ch = getc(infile->file);
+    } /* end while */
+    
+    if (line == line_no[next]) {
+      chars[length] = ASCII_NUL;
+      visitor(line, chars, length, context);
+      next++;
+    } /* end if */
+    
+    if (ch == EOF) {
+      break;
+    } /* end if */
+    
+    /* skip LF, CR or CR LF */
+    if (ch == ASCII_CR) {
+      ch = getc(infile->file);
+      if (ch == ASCII_LF) {
+        ch = getc(infile->file);
+      } /* end if */
+    }
+    else /* LF */ {
+      ch = getc(infile->file);
+    } /* end if */
+    
+    line++;
+  } /* end while */
+  
+  /* restore file position */
+  clearerr(infile->file);
+  fseek(infile->file, saved_pos, SEEK_SET);
+  
+  return;
+} /* end visit_streamed_lines */
+
+/* END OF FILE */
@@ -45,7 +45,8 @@
 #include "interned-strings.h"
 #include "m2c-build-params.h"
 
-#include <stdbool>
+#include <stddef.h>
+#include <stdbool.h>
 
 
 /* --------------------------------------------------------------------------
@@ -55,11 +56,42 @@
 #define INFILE_MAX_LINE_LENGTH M2C_MAX_INFILE_COLUMNS
 
 
+/* --------------------------------------------------------------------------
+ * Streaming input
+ * --------------------------------------------------------------------------
+ * Files of up to M2C_MAX_INFILE_SIZE bytes are read into memory in whole,
+ * where mmap() is available they are mapped read-only instead of copied.
+ * Larger files are streamed through a fixed ring of INFILE_CHUNK_COUNT input
+ * chunks of INFILE_CHUNK_SIZE bytes each,  memory use is thus bounded by the
+ * size of the ring,  regardless of the size of the file.  The ring holds at
+ * least the longest permitted lexeme plus lookahead, lexemes and lookahead
+ * characters may therefore span chunk boundaries.
+ * ----------------------------------------------------------------------- */
+
+#define INFILE_CHUNK_SIZE M2C_INFILE_CHUNK_SIZE
+
+#define INFILE_CHUNK_COUNT M2C_INFILE_CHUNK_COUNT
+
+
+/* --------------------------------------------------------------------------
+ * Prefix input
+ * --------------------------------------------------------------------------
+ * A file opened with infile_open_prefix is streamed regardless of its size,
+ * in chunks of INFILE_PREFIX_CHUNK_SIZE bytes and without stdio read-ahead,
+ * thus no more than the consumed prefix, rounded up to the next chunk,  is
+ * read from the device.  Must be a power of two and divide the chunk size.
+ * ----------------------------------------------------------------------- */
+
+#ifndef INFILE_PREFIX_CHUNK_SIZE
+#define INFILE_PREFIX_CHUNK_SIZE 256
+#endif
+
+
 /* --------------------------------------------------------------------------
  * type infile_status_t
  * ----------------------------------------------------------------------- */
 
-typedef file_io_status_t infile_status_t;
+typedef fileio_status_t infile_status_t;
 
 
 /* --------------------------------------------------------------------------
@@ -71,6 +103,25 @@ typedef file_io_status_t infile_status_t;
 typedef struct infile_struct_t *infile_t;
 
 
+/* --------------------------------------------------------------------------
+ * type infile_validation_t
+ * --------------------------------------------------------------------------
+ * Record type representing the result of validating the input of an infile
+ * when it is loaded.  Field first_invalid holds the offset of the first
+ * offending character,  that is a control character other than TAB,  LF and
+ * CR,  a character above 126,  or the first character of a line past column
+ * INFILE_MAX_LINE_LENGTH,  or the length of the input if there is none.
+ * Field line_count holds the number of lines,  field max_line_length the
+ * length of the longest line,  excluding its line terminator.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* first_invalid */ size_t first_invalid;
+  /* line_count */ uint_t line_count;
+  /* max_line_length */ uint_t max_line_length;
+} infile_validation_t;
+
+
 /* --------------------------------------------------------------------------
  * procedure infile_open(infile, path, status)
  * --------------------------------------------------------------------------
@@ -78,7 +129,38 @@ typedef struct infile_struct_t *infile_t;
  * object back in out-parameter infile. Passes NULL on failure.
  * ----------------------------------------------------------------------- */
 
-void infile_open (infile_t *infile, char *path, infile_status_t *status);
+void infile_open (infile_t *infile, const char *path, infile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_open_prefix(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Opens the file at path for reading of a prefix,  such as a module header,
+ * and passes a newly allocated and initialised infile object back in out-
+ * parameter infile.  Passes NULL on failure.  Characters are read from the
+ * file only as they are consumed.
+ * ----------------------------------------------------------------------- */
+
+void infile_open_prefix
+  (infile_t *infile, const char *path, infile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_open_text(infile, chars, length, first_line, status)
+ * --------------------------------------------------------------------------
+ * Passes a newly allocated and initialised infile object that reads a copy
+ * of the length characters at chars  back in out-parameter infile.  Lines
+ * are counted from first_line,  thus a slice of a larger text that starts
+ * at the beginning of a line  is reported with the line numbers it has in
+ * that text.  The infile has no associated file.  Passes NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void infile_open_text
+  (infile_t *infile,                 /* out */
+   const char *chars,                /* in */
+   size_t length,                    /* in */
+   uint_t first_line,                /* in */
+   infile_status_t *status);         /* out */
 
 
 /* --------------------------------------------------------------------------
@@ -90,6 +172,46 @@ void infile_open (infile_t *infile, char *path, infile_status_t *status);
 void infile_close (infile_t *infile);
 
 
+/* --------------------------------------------------------------------------
+ * procedure infile_reopen(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with infile, if still open, and opens the file
+ * at path like infile_open,  but reuses the infile object  if its buffer is
+ * large enough to hold the new file,  otherwise it is reallocated to the new
+ * size.  The buffer thus grows  to the largest size required and allocation
+ * is avoided when many files are read in turn.  If infile is NULL upon entry,
+ * the procedure behaves like infile_open.  If the file cannot be opened,  the
+ * infile object is kept without a file and at end of input.  The infile
+ * object may have been moved, it is passed back in infile.
+ * ----------------------------------------------------------------------- */
+
+void infile_reopen
+  (infile_t *infile, const char *path, infile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_reopen_prefix(infile, path, status)
+ * --------------------------------------------------------------------------
+ * Like infile_reopen but opens the file at path for reading of a prefix like
+ * infile_open_prefix.
+ * ----------------------------------------------------------------------- */
+
+void infile_reopen_prefix
+  (infile_t *infile, const char *path, infile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_close_file(infile)
+ * --------------------------------------------------------------------------
+ * Closes the file associated with infile but keeps the infile object and the
+ * input it has buffered so far,  which remains accessible by slice and line.
+ * No further input is read,  infile is at end of input.  The object may be
+ * reused with infile_reopen or deallocated with infile_close.
+ * ----------------------------------------------------------------------- */
+
+void infile_close_file (infile_t infile);
+
+
 /* --------------------------------------------------------------------------
  * function infile_consume_char(infile)
  * --------------------------------------------------------------------------
@@ -97,7 +219,32 @@ void infile_close (infile_t *infile);
  * ing new lookahead character without consuming it.
  * ----------------------------------------------------------------------- */
 
-char infile_consume_char (infile_t *infile);
+char infile_consume_char (infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_skip_char(infile)
+ * --------------------------------------------------------------------------
+ * Consumes the current lookahead character in infile and returns the result-
+ * ing new lookahead character without consuming it.  Used by matchers  that
+ * skip over input without collecting it, otherwise like infile_consume_char.
+ * ----------------------------------------------------------------------- */
+
+char infile_skip_char (infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_skip_to_delimiter(infile, delim1, delim2)
+ * --------------------------------------------------------------------------
+ * Consumes all characters  up to but excluding  the next occurrence of delim1
+ * or delim2,  of a carriage return,  of a control character other than TAB
+ * and LF, of a character above 127, or up to the end of the file.  Line and
+ * column counters are updated in bulk.  Returns the new lookahead character.
+ * Where available, input is scanned with SSE2 or NEON vector instructions.
+ * The input of a clean infile is scanned for delimiters and CR only.
+ * ----------------------------------------------------------------------- */
+
+char infile_skip_to_delimiter (infile_t infile, char delim1, char delim2);
 
 
 /* --------------------------------------------------------------------------
@@ -106,7 +253,7 @@ char infile_consume_char (infile_t *infile);
  * Returns the current lookahead char in infile without consuming any char.
  * ----------------------------------------------------------------------- */
 
-char infile_lookahead_char (infile_t *infile);
+char infile_lookahead_char (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
@@ -115,16 +262,17 @@ char infile_lookahead_char (infile_t *infile);
  * Returns the 2nd lookahead char in infile without consuming any char.
  * ----------------------------------------------------------------------- */
 
-char infile_la2_char (infile_t *infile);
+char infile_la2_char (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
  * function infile_status(infile)
  * --------------------------------------------------------------------------
- * Returns status of the last operation.
+ * Returns status of the last operation.  Status FILEIO_STATUS_LEXEME_TOO_LONG
+ * is retained by subsequent reads until the lexeme has been fetched.
  * ----------------------------------------------------------------------- */
 
-char infile_status (infile_t *infile);
+infile_status_t infile_status (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
@@ -133,7 +281,41 @@ char infile_status (infile_t *infile);
  * Returns true if infile has reached the end of the file, else false.
  * ----------------------------------------------------------------------- */
 
-bool infile_eof (infile_t *infile);
+bool infile_eof (infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_bytes_read(infile)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes read from the file of infile so far.
+ * ----------------------------------------------------------------------- */
+
+size_t infile_bytes_read (infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_validation(infile, validation)
+ * --------------------------------------------------------------------------
+ * Passes the result of validating the input of infile back in validation.
+ * Input that is read in whole is validated in a single vectorised pass when
+ * it is loaded.  Returns false if infile is streamed,  its input is then
+ * not validated and validation is left unchanged.
+ * ----------------------------------------------------------------------- */
+
+bool infile_validation (infile_t infile, infile_validation_t *validation);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_is_clean(infile)
+ * --------------------------------------------------------------------------
+ * Returns true if the input of infile has been validated and holds no
+ * offending characters,  else false.  The input of a clean infile consists
+ * of printable 7-bit characters,  TAB,  LF and CR only,  and its lines do
+ * not exceed INFILE_MAX_LINE_LENGTH.  Matchers may then omit their checks
+ * for illegal characters.
+ * ----------------------------------------------------------------------- */
+
+bool infile_is_clean (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
@@ -142,7 +324,7 @@ bool infile_eof (infile_t *infile);
  * Returns the line number of the current reading position of infile.
  * ----------------------------------------------------------------------- */
 
-uint_t infile_line (infile_t *infile);
+uint_t infile_line (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
@@ -151,7 +333,7 @@ uint_t infile_line (infile_t *infile);
  * Returns the column number of the current reading position of infile.
  * ----------------------------------------------------------------------- */
 
-uint_t infile_column (infile_t *infile);
+uint_t infile_column (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
@@ -160,7 +342,7 @@ uint_t infile_column (infile_t *infile);
  * Marks the current lookahead character as the start of a lexeme.
  * ----------------------------------------------------------------------- */
 
-void infile_mark_lexeme (infile_t *infile);
+void infile_mark_lexeme (infile_t infile);
 
 
 /* --------------------------------------------------------------------------
@@ -168,9 +350,74 @@ void infile_mark_lexeme (infile_t *infile);
  * --------------------------------------------------------------------------
  * Returns the current lexeme.  Returns NULL if no lexeme has been marked, or
  * if no chars have been consumed since infile_mark_lexeme() has been called.
+ * Returns NULL  with status FILEIO_STATUS_LEXEME_TOO_LONG  if the lexeme of
+ * a streamed infile exceeded the ring.
+ * ----------------------------------------------------------------------- */
+
+intstr_t infile_lexeme (infile_t infile);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_lexeme_with_hash(infile, key)
+ * --------------------------------------------------------------------------
+ * Returns the current lexeme like function infile_lexeme,  but interns it
+ * using the precomputed hash key.  The caller must have computed key  over
+ * all characters of the lexeme  using HASH_INITIAL,  HASH_NEXT_CHAR  and
+ * HASH_FINAL as they were consumed.
  * ----------------------------------------------------------------------- */
 
-intstr_t *infile_lexeme (infile_t *infile);
+intstr_t infile_lexeme_with_hash (infile_t infile, intstr_hash_t key);
+
+
+/* --------------------------------------------------------------------------
+ * type infile_slice_t
+ * --------------------------------------------------------------------------
+ * Record type representing a range of characters in the buffer of an infile
+ * by offset and length.  A slice refers to the buffer  without copying and
+ * remains valid until the infile is closed.  A slice of length zero is empty.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  size_t offset;
+  size_t length;
+} infile_slice_t;
+
+#define INFILE_SLICE_NONE { 0, 0 }
+
+
+/* --------------------------------------------------------------------------
+ * function infile_lexeme_slice(infile, slice)
+ * --------------------------------------------------------------------------
+ * Passes a slice for the current lexeme in slice without copying, clears the
+ * marker and returns true.   Returns false  and leaves the marker unchanged
+ * if no lexeme has been marked,  if no chars have been consumed  since the
+ * lexeme was marked,  or if infile is streamed.  The characters of streamed
+ * infiles are overwritten as reading advances,  a caller must then obtain
+ * the lexeme by calling function infile_lexeme instead.
+ * ----------------------------------------------------------------------- */
+
+bool infile_lexeme_slice (infile_t infile, infile_slice_t *slice);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_slice_chars(infile, slice)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the first character of slice in the buffer of infile.
+ * The characters are not NUL terminated.  Returns NULL if slice is empty or
+ * does not lie within the buffer of infile.
+ * ----------------------------------------------------------------------- */
+
+const char *infile_slice_chars (infile_t infile, infile_slice_t slice);
+
+
+/* --------------------------------------------------------------------------
+ * function infile_slice_lexeme(infile, slice)
+ * --------------------------------------------------------------------------
+ * Returns an interned string  for the characters of slice.  Returns NULL if
+ * slice is empty or invalid,  or if the string could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+intstr_t infile_slice_lexeme (infile_t infile, infile_slice_t slice);
 
 
 /* --------------------------------------------------------------------------
@@ -210,7 +457,38 @@ void infile_install_print_handler (print_handler_t handler);
  * without action if no print handler has been installed prior to the call. 
  * ----------------------------------------------------------------------- */
 
-void infile_print_line (infile_t *infile, uint_t line_no);
+void infile_print_line (infile_t infile, uint_t line_no);
+
+
+/* --------------------------------------------------------------------------
+ * type line_visitor_t
+ * --------------------------------------------------------------------------
+ * Function pointer to a procedure passed to infile_visit_lines.  It is called
+ * with the line number,  the characters of the line excluding its end-of-line
+ * marker,  the number of characters and the context passed by the caller.
+ * The characters are only valid for the duration of the call.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*line_visitor_t)
+  (uint_t line_no, const char *chars, uint_t length, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure infile_visit_lines(infile, count, line_no, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor  for each of the count lines  whose line numbers  are given
+ * in ascending order in array line_no,  duplicates are visited once.  All
+ * lines are fetched  in a single pass over the file,  lines are truncated to
+ * INFILE_MAX_LINE_LENGTH characters,  lines past the end are not visited.
+ * The reading position of infile is not changed.
+ * ----------------------------------------------------------------------- */
+
+void infile_visit_lines
+  (infile_t infile,          /* in */
+   uint_t count,             /* in */
+   const uint_t line_no[],   /* in */
+   line_visitor_t visitor,   /* in */
+   void *context);           /* in */
 
 
 #endif /* INFILE_H */
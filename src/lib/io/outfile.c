@@ -0,0 +1,1049 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * outfile.c                                                                 *
+ *                                                                           *
+ * Implementation of file output module.                                     *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * Imports
+ * ----------------------------------------------------------------------- */
+
+#include "outfile.h"
+#include "tabulator.h"
+#include "newline.h"
+#include "m2c-common.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select POSIX output for POSIX and Unix-like host platforms
+ * --------------------------------------------------------------------------
+ * On hosts that provide write() and writev(),  buffers are passed straight
+ * to the operating system.  On all other hosts  (AmigaOS, OpenVMS, Windows)
+ * output goes through an unbuffered stdio stream.  Define OUTFILE_USE_POSIX
+ * as 0 to force the stdio implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(OUTFILE_USE_POSIX)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define OUTFILE_USE_POSIX 1
+#else
+#define OUTFILE_USE_POSIX 0
+#endif
+#endif
+
+#if (OUTFILE_USE_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#else
+#include <stdio.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * hidden type outfile_struct_t
+ * --------------------------------------------------------------------------
+ * Record type representing an output file.
+ *
+ * The buffer holds end bytes of output not yet passed to the operating
+ * system.  Field reserved holds the size of the space handed out by the
+ * last call to outfile_reserve  that has not yet been committed.
+ *
+ * A memory outfile has no associated file.  Buffered output is appended to
+ * the heap allocated block memory  of capacity bytes instead,  of which the
+ * first size bytes are in use.  A write-if-changed outfile is a memory out-
+ * file with a path,  its output is compared with and possibly written to
+ * the file at path when it is closed.
+ * ----------------------------------------------------------------------- */
+
+struct outfile_struct_t {
+#if (OUTFILE_USE_POSIX)
+  /* fd */ int fd;
+#else
+  /* file */ FILE *file;
+#endif
+  /* in_memory */ bool in_memory;
+  /* memory */ char *memory;
+  /* size */ size_t size;
+  /* capacity */ size_t capacity;
+  /* path */ char *path;
+  /* end */ size_t end;
+  /* reserved */ size_t reserved;
+  /* line */ uint_t line;
+  /* column */ uint_t column;
+  /* status */ outfile_status_t status;
+  /* buffer */ char buffer[];
+};
+
+typedef struct outfile_struct_t outfile_struct_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void write_through
+  (outfile_t outfile, const char *bytes, size_t length);
+
+static void update_position
+  (outfile_t outfile, const char *bytes, size_t length);
+
+static void append_to_memory
+  (outfile_t outfile, const char *bytes, size_t length);
+
+static outfile_status_t status_for_errno (int error);
+
+static void store_if_changed (outfile_t outfile, bool *written);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_open(outfile, path, status)
+ * --------------------------------------------------------------------------
+ * Opens file at path and passes a newly allocated and initialised outfile
+ * object back in out-parameter outfile. Passes NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void outfile_open
+  (outfile_t *outfile, const char *path, outfile_status_t *status) {
+  
+  outfile_t new_outfile;
+  
+  /* check pre-conditions */
+  if ((outfile == NULL) || (path == NULL)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  /* allocate new outfile */
+  new_outfile = malloc(sizeof(outfile_struct_t) + OUTFILE_BUFFER_SIZE);
+  
+  if (new_outfile == NULL) {
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    *outfile = NULL;
+    return;
+  } /* end if */
+  
+  /* open file */
+#if (OUTFILE_USE_POSIX)
+  new_outfile->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  
+  if (new_outfile->fd < 0) {
+#else
+  new_outfile->file = fopen(path, "wb");
+  
+  if (new_outfile->file == NULL) {
+#endif
+    SET_STATUS(status, status_for_errno(errno));
+    free(new_outfile);
+    *outfile = NULL;
+    return;
+  } /* end if */
+  
+#if !(OUTFILE_USE_POSIX)
+  /* the outfile buffer replaces stdio buffering */
+  setvbuf(new_outfile->file, NULL, _IONBF, 0);
+#endif
+  
+  /* initialise newly allocated outfile */
+  new_outfile->in_memory = false;
+  new_outfile->memory = NULL;
+  new_outfile->size = 0;
+  new_outfile->capacity = 0;
+  new_outfile->path = NULL;
+  new_outfile->end = 0;
+  new_outfile->reserved = 0;
+  new_outfile->line = 1;
+  new_outfile->column = 1;
+  new_outfile->status = FILEIO_STATUS_SUCCESS;
+  
+  *outfile = new_outfile;
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  return;
+} /* end outfile_open */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_open_memory(outfile, status)
+ * --------------------------------------------------------------------------
+ * Passes a newly allocated and initialised memory outfile back in outfile.
+ * Passes NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void outfile_open_memory (outfile_t *outfile, outfile_status_t *status) {
+  
+  outfile_t new_outfile;
+  
+  /* check pre-conditions */
+  if (outfile == NULL) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  /* allocate new outfile */
+  new_outfile = malloc(sizeof(outfile_struct_t) + OUTFILE_BUFFER_SIZE);
+  
+  if (new_outfile == NULL) {
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    *outfile = NULL;
+    return;
+  } /* end if */
+  
+  /* initialise newly allocated outfile */
+#if (OUTFILE_USE_POSIX)
+  new_outfile->fd = -1;
+#else
+  new_outfile->file = NULL;
+#endif
+  new_outfile->in_memory = true;
+  new_outfile->memory = NULL;
+  new_outfile->size = 0;
+  new_outfile->capacity = 0;
+  new_outfile->path = NULL;
+  new_outfile->end = 0;
+  new_outfile->reserved = 0;
+  new_outfile->line = 1;
+  new_outfile->column = 1;
+  new_outfile->status = FILEIO_STATUS_SUCCESS;
+  
+  *outfile = new_outfile;
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  return;
+} /* end outfile_open_memory */
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_take_output(outfile, length)
+ * --------------------------------------------------------------------------
+ * Returns the output collected by memory outfile  and passes its length in
+ * length,  then resets outfile to empty.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+char *outfile_take_output (outfile_t outfile, size_t *length) {
+  
+  char *output;
+  
+  if ((outfile == NULL) || (!outfile->in_memory) ||
+      (outfile->path != NULL) || (length == NULL)) {
+    return NULL;
+  } /* end if */
+  
+  /* output that fits the buffer is copied into a block of its own size */
+  if ((outfile->memory == NULL) && (outfile->end > 0)) {
+    outfile->memory = malloc(outfile->end);
+    
+    if (outfile->memory == NULL) {
+      outfile->status = FILEIO_STATUS_ALLOCATION_FAILED;
+    }
+    else /* copy */ {
+      memcpy(outfile->memory, outfile->buffer, outfile->end);
+      outfile->size = outfile->end;
+      outfile->capacity = outfile->end;
+    } /* end if */
+    outfile->end = 0;
+  }
+  /* otherwise buffered output is appended to the memory block */
+  else if (outfile->end > 0) {
+    write_through(outfile, NULL, 0);
+  } /* end if */
+  
+  if (outfile->status != FILEIO_STATUS_SUCCESS) {
+    *length = 0;
+    return NULL;
+  } /* end if */
+  
+  output = outfile->memory;
+  *length = outfile->size;
+  
+  /* reset outfile */
+  outfile->memory = NULL;
+  outfile->size = 0;
+  outfile->capacity = 0;
+  outfile->line = 1;
+  outfile->column = 1;
+  
+  return output;
+} /* end outfile_take_output */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_open_if_changed(outfile, path, status)
+ * --------------------------------------------------------------------------
+ * Passes a newly allocated write-if-changed outfile for the file at path
+ * back in outfile.  Passes NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void outfile_open_if_changed
+  (outfile_t *outfile, const char *path, outfile_status_t *status) {
+  
+  outfile_t new_outfile;
+  size_t path_length;
+  
+  /* check pre-conditions */
+  if ((outfile == NULL) || (path == NULL) || (path[0] == ASCII_NUL)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  outfile_open_memory(&new_outfile, status);
+  
+  if (new_outfile == NULL) {
+    *outfile = NULL;
+    return;
+  } /* end if */
+  
+  /* keep a copy of path for closing */
+  path_length = strlen(path);
+  new_outfile->path = malloc(path_length + 1);
+  
+  if (new_outfile->path == NULL) {
+    free(new_outfile);
+    SET_STATUS(status, FILEIO_STATUS_ALLOCATION_FAILED);
+    *outfile = NULL;
+    return;
+  } /* end if */
+  
+  memcpy(new_outfile->path, path, path_length + 1);
+  
+  *outfile = new_outfile;
+  SET_STATUS(status, FILEIO_STATUS_SUCCESS);
+  return;
+} /* end outfile_open_if_changed */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_close_if_changed(outfile, written, status)
+ * --------------------------------------------------------------------------
+ * Closes outfile,  passes whether its file was written in written  and the
+ * status of the operation in status,  and passes NULL in outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_close_if_changed
+  (outfile_t *outfile, bool *written, outfile_status_t *status) {
+  
+  bool file_written;
+  
+  if ((outfile == NULL) || (*outfile == NULL)) {
+    SET_STATUS(written, false);
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  /* write-if-changed outfile */
+  if ((*outfile)->path != NULL) {
+    store_if_changed(*outfile, &file_written);
+  }
+  /* memory outfile */
+  else if ((*outfile)->in_memory) {
+    file_written = false;
+  }
+  /* plain outfile */
+  else {
+    outfile_flush(*outfile);
+    file_written = true;
+  } /* end if */
+  
+  SET_STATUS(written, file_written);
+  SET_STATUS(status, (*outfile)->status);
+  
+#if (OUTFILE_USE_POSIX)
+  if ((*outfile)->fd >= 0) {
+    close((*outfile)->fd);
+  } /* end if */
+#else
+  if ((*outfile)->file != NULL) {
+    fclose((*outfile)->file);
+  } /* end if */
+#endif
+  
+  free((*outfile)->memory);
+  free((*outfile)->path);
+  free(*outfile);
+  *outfile = NULL;
+  
+  return;
+} /* end outfile_close_if_changed */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_close(outfile)
+ * --------------------------------------------------------------------------
+ * Flushes outfile,  closes the associated file  and passes NULL in outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_close (outfile_t *outfile) {
+  
+  if ((outfile == NULL) || (*outfile == NULL)) {
+    return;
+  } /* end if */
+  
+  if ((*outfile)->in_memory) {
+    outfile_close_if_changed(outfile, NULL, NULL);
+    return;
+  } /* end if */
+  
+  outfile_flush(*outfile);
+  
+#if (OUTFILE_USE_POSIX)
+  close((*outfile)->fd);
+#else
+  fclose((*outfile)->file);
+#endif
+  free(*outfile);
+  *outfile = NULL;
+  
+  return;
+} /* end outfile_close */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_char(outfile, ch)
+ * --------------------------------------------------------------------------
+ * Writes character ch to outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_char (outfile_t outfile, char ch) {
+  
+  if (outfile == NULL) {
+    return;
+  } /* end if */
+  
+  if (outfile->end == OUTFILE_BUFFER_SIZE) {
+    outfile_flush(outfile);
+  } /* end if */
+  
+  outfile->buffer[outfile->end] = ch;
+  outfile->end++;
+  
+  if (ch == ASCII_LF) {
+    outfile->line++;
+    outfile->column = 1;
+  }
+  else {
+    outfile->column++;
+  } /* end if */
+  
+  return;
+} /* end outfile_write_char */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_chars(outfile, chars)
+ * --------------------------------------------------------------------------
+ * Writes a NUL terminated char pointer to outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_chars (outfile_t outfile, const char *chars) {
+  
+  if (chars == NULL) {
+    return;
+  } /* end if */
+  
+  outfile_write_bytes(outfile, chars, strlen(chars));
+  
+  return;
+} /* end outfile_write_chars */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_bytes(outfile, bytes, length)
+ * --------------------------------------------------------------------------
+ * Writes length bytes starting at bytes to outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_bytes (outfile_t outfile, const char *bytes, size_t length) {
+  
+  if ((outfile == NULL) || (bytes == NULL) || (length == 0)) {
+    return;
+  } /* end if */
+  
+  update_position(outfile, bytes, length);
+  
+  /* copy into buffer if there is room */
+  if (length <= OUTFILE_BUFFER_SIZE - outfile->end) {
+    memcpy(&outfile->buffer[outfile->end], bytes, length);
+    outfile->end = outfile->end + length;
+  }
+  /* otherwise pass buffer and bytes on together */
+  else {
+    write_through(outfile, bytes, length);
+  } /* end if */
+  
+  return;
+} /* end outfile_write_bytes */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_string(outfile, string)
+ * --------------------------------------------------------------------------
+ * Writes an interned string to outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_string (outfile_t outfile, intstr_t string) {
+  
+  if (string == NULL) {
+    return;
+  } /* end if */
+  
+  outfile_write_bytes
+    (outfile, intstr_char_ptr(string), (size_t) intstr_length(string));
+  
+  return;
+} /* end outfile_write_string */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_tab(outfile)
+ * --------------------------------------------------------------------------
+ * Writes tab to outfile. Expands tabs to spaces if tabwidth > 0.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_tab (outfile_t outfile) {
+  
+  uint_t width, count;
+  char *space;
+  
+  if (outfile == NULL) {
+    return;
+  } /* end if */
+  
+  width = tab_width();
+  
+  if (width == 0) {
+    outfile_write_char(outfile, ASCII_TAB);
+    return;
+  } /* end if */
+  
+  /* pad to the next tab stop */
+  count = width - ((outfile->column - 1) % width);
+  space = outfile_reserve(outfile, count);
+  
+  if (space != NULL) {
+    memset(space, ' ', count);
+    outfile_commit(outfile, count);
+  } /* end if */
+  
+  return;
+} /* end outfile_write_tab */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_newline(outfile)
+ * --------------------------------------------------------------------------
+ * Writes newline to outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_newline (outfile_t outfile) {
+  
+  if (outfile == NULL) {
+    return;
+  } /* end if */
+  
+  switch (newline_mode()) {
+    case NEWLINE_CR :
+      outfile_write_char(outfile, ASCII_CR);
+      break;
+    
+    case NEWLINE_CRLF :
+      outfile_write_char(outfile, ASCII_CR);
+      outfile_write_char(outfile, ASCII_LF);
+      break;
+    
+    default :
+      outfile_write_char(outfile, ASCII_LF);
+  } /* end switch */
+  
+  /* CR only newlines are not counted by outfile_write_char */
+  if (newline_mode() == NEWLINE_CR) {
+    outfile->line++;
+    outfile->column = 1;
+  } /* end if */
+  
+  return;
+} /* end outfile_write_newline */
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_reserve(outfile, length)
+ * --------------------------------------------------------------------------
+ * Reserves length bytes in the buffer of outfile and returns a pointer to
+ * the reserved space.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+char *outfile_reserve (outfile_t outfile, size_t length) {
+  
+  if ((outfile == NULL) || (length > OUTFILE_BUFFER_SIZE)) {
+    return NULL;
+  } /* end if */
+  
+  if (length > OUTFILE_BUFFER_SIZE - outfile->end) {
+    outfile_flush(outfile);
+    
+    if (outfile->end != 0) {
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  outfile->reserved = length;
+  return &outfile->buffer[outfile->end];
+} /* end outfile_reserve */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_commit(outfile, length)
+ * --------------------------------------------------------------------------
+ * Appends the first length bytes of the reserved space to the output.
+ * ----------------------------------------------------------------------- */
+
+void outfile_commit (outfile_t outfile, size_t length) {
+  
+  if (outfile == NULL) {
+    return;
+  } /* end if */
+  
+  /* never commit more than was reserved */
+  if (length > outfile->reserved) {
+    length = outfile->reserved;
+  } /* end if */
+  
+  update_position(outfile, &outfile->buffer[outfile->end], length);
+  
+  outfile->end = outfile->end + length;
+  outfile->reserved = 0;
+  
+  return;
+} /* end outfile_commit */
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_flush(outfile)
+ * --------------------------------------------------------------------------
+ * Passes all buffered output of outfile to the operating system.
+ * ----------------------------------------------------------------------- */
+
+void outfile_flush (outfile_t outfile) {
+  
+  if ((outfile == NULL) || (outfile->end == 0)) {
+    return;
+  } /* end if */
+  
+  write_through(outfile, NULL, 0);
+  
+  return;
+} /* end outfile_flush */
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_status(outfile)
+ * --------------------------------------------------------------------------
+ * Returns status of the last operation.
+ * ----------------------------------------------------------------------- */
+
+outfile_status_t outfile_status (outfile_t outfile) {
+  
+  if (outfile == NULL) {
+    return FILEIO_STATUS_INVALID_FILENAME;
+  } /* end if */
+  
+  return outfile->status;
+} /* end outfile_status */
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_line(outfile)
+ * --------------------------------------------------------------------------
+ * Returns the line number of the current writing position of outfile.
+ * ----------------------------------------------------------------------- */
+
+uint_t outfile_line (outfile_t outfile) {
+  
+  if (outfile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return outfile->line;
+} /* end outfile_line */
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_column(outfile)
+ * --------------------------------------------------------------------------
+ * Returns the column number of the current writing position of outfile.
+ * ----------------------------------------------------------------------- */
+
+uint_t outfile_column (outfile_t outfile) {
+  
+  if (outfile == NULL) {
+    return 0;
+  } /* end if */
+  
+  return outfile->column;
+} /* end outfile_column */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure write_through(outfile, bytes, length)
+ * --------------------------------------------------------------------------
+ * Passes the buffered output of outfile followed by length bytes at bytes
+ * to the operating system and empties the buffer.  With POSIX output both
+ * are passed in a single call to writev,  partial writes are resumed.  Sets
+ * the status of outfile to FILEIO_STATUS_DEVICE_ERROR on failure.  Memory
+ * outfiles append both to their memory block instead.
+ * ----------------------------------------------------------------------- */
+
+static void write_through
+  (outfile_t outfile, const char *bytes, size_t length) {
+  
+#if (OUTFILE_USE_POSIX)
+  struct iovec iov[2];
+  int index, count;
+  ssize_t written;
+#endif
+  
+  if (outfile->in_memory) {
+    append_to_memory(outfile, outfile->buffer, outfile->end);
+    append_to_memory(outfile, bytes, length);
+    outfile->end = 0;
+    return;
+  } /* end if */
+  
+#if (OUTFILE_USE_POSIX)
+  iov[0].iov_base = outfile->buffer;
+  iov[0].iov_len = outfile->end;
+  iov[1].iov_base = (void *) bytes;
+  iov[1].iov_len = length;
+  
+  /* skip empty vectors */
+  index = (outfile->end == 0) ? 1 : 0;
+  count = (length == 0) ? 1 : 2;
+  
+  while (index < count) {
+    written = writev(outfile->fd, &iov[index], count - index);
+    
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      } /* end if */
+      outfile->status = FILEIO_STATUS_DEVICE_ERROR;
+      break;
+    } /* end if */
+    
+    /* advance past written bytes */
+    while ((index < count) && ((size_t) written >= iov[index].iov_len)) {
+      written = written - (ssize_t) iov[index].iov_len;
+      index++;
+    } /* end while */
+    
+    if (index < count) {
+      iov[index].iov_base = (char *) iov[index].iov_base + written;
+      iov[index].iov_len = iov[index].iov_len - (size_t) written;
+    } /* end if */
+  } /* end while */
+#else
+  if ((outfile->end > 0) &&
+      (fwrite(outfile->buffer, 1, outfile->end, outfile->file)
+        != outfile->end)) {
+    outfile->status = FILEIO_STATUS_DEVICE_ERROR;
+  } /* end if */
+  
+  if ((length > 0) &&
+      (fwrite(bytes, 1, length, outfile->file) != length)) {
+    outfile->status = FILEIO_STATUS_DEVICE_ERROR;
+  } /* end if */
+#endif
+  
+  outfile->end = 0;
+  
+  return;
+} /* end write_through */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure update_position(outfile, bytes, length)
+ * --------------------------------------------------------------------------
+ * Advances the line and column counters of outfile past length bytes at
+ * bytes.
+ * ----------------------------------------------------------------------- */
+
+static void update_position
+  (outfile_t outfile, const char *bytes, size_t length) {
+  
+  size_t index, line_start;
+  
+  index = 0;
+  line_start = 0;
+  while (index < length) {
+    if (bytes[index] == ASCII_LF) {
+      outfile->line++;
+      line_start = index + 1;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  if (line_start > 0) {
+    outfile->column = (uint_t) (length - line_start) + 1;
+  }
+  else /* no newline */ {
+    outfile->column = outfile->column + (uint_t) length;
+  } /* end if */
+  
+  return;
+} /* end update_position */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure append_to_memory(outfile, bytes, length)
+ * --------------------------------------------------------------------------
+ * Appends length bytes at bytes to the memory block of outfile,  doubling
+ * its capacity as needed.  Sets the status of outfile to
+ * FILEIO_STATUS_ALLOCATION_FAILED on failure.
+ * ----------------------------------------------------------------------- */
+
+static void append_to_memory
+  (outfile_t outfile, const char *bytes, size_t length) {
+  
+  size_t new_capacity;
+  char *new_memory;
+  
+  if ((length == 0) || (outfile->status != FILEIO_STATUS_SUCCESS)) {
+    return;
+  } /* end if */
+  
+  if (length > outfile->capacity - outfile->size) {
+    new_capacity =
+      (outfile->capacity == 0) ? OUTFILE_BUFFER_SIZE : outfile->capacity;
+    
+    while (length > new_capacity - outfile->size) {
+      new_capacity = 2 * new_capacity;
+    } /* end while */
+    
+    new_memory = realloc(outfile->memory, new_capacity);
+    
+    if (new_memory == NULL) {
+      outfile->status = FILEIO_STATUS_ALLOCATION_FAILED;
+      return;
+    } /* end if */
+    
+    outfile->memory = new_memory;
+    outfile->capacity = new_capacity;
+  } /* end if */
+  
+  memcpy(&outfile->memory[outfile->size], bytes, length);
+  outfile->size = outfile->size + length;
+  
+  return;
+} /* end append_to_memory */
+
+
+/* --------------------------------------------------------------------------
+ * private function status_for_errno(error)
+ * --------------------------------------------------------------------------
+ * Returns the outfile status for a failure to open a file with errno error.
+ * ----------------------------------------------------------------------- */
+
+static outfile_status_t status_for_errno (int error) {
+  
+  if ((error == ENOENT) || (error == ENOTDIR)) {
+    return FILEIO_STATUS_FILE_NOT_FOUND;
+  }
+  else if (error == ENAMETOOLONG) {
+    return FILEIO_STATUS_INVALID_FILENAME;
+  }
+  else if (error == EACCES) {
+    return FILEIO_STATUS_ACCESS_DENIED;
+  }
+  else {
+    return FILEIO_STATUS_DEVICE_ERROR;
+  } /* end if */
+  
+} /* end status_for_errno */
+
+
+/* --------------------------------------------------------------------------
+ * private function same_contents(path, bytes, length, scratch)
+ * --------------------------------------------------------------------------
+ * Returns true if the file at path exists  and holds exactly the length
+ * bytes at bytes,  otherwise false.  The file is read in chunks into the
+ * OUTFILE_BUFFER_SIZE bytes at scratch.  Reading stops at the first chunk
+ * that differs.
+ * ----------------------------------------------------------------------- */
+
+static bool same_contents
+  (const char *path, const char *bytes, size_t length, char *scratch) {
+  
+  size_t offset, chunk;
+  bool same;
+#if (OUTFILE_USE_POSIX)
+  struct stat info;
+  ssize_t got;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return false;
+  } /* end if */
+  
+  /* files of different size differ */
+  if ((fstat(fd, &info) != 0) || (!S_ISREG(info.st_mode)) ||
+      ((off_t) length != info.st_size)) {
+    close(fd);
+    return false;
+  } /* end if */
+#else
+  FILE *file;
+  size_t got;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+#endif
+  
+  offset = 0;
+  same = true;
+  while (same && (offset < length)) {
+    chunk = length - offset;
+    if (chunk > OUTFILE_BUFFER_SIZE) {
+      chunk = OUTFILE_BUFFER_SIZE;
+    } /* end if */
+    
+#if (OUTFILE_USE_POSIX)
+    got = read(fd, scratch, chunk);
+    
+    if ((got < 0) && (errno == EINTR)) {
+      continue;
+    } /* end if */
+    
+    if (got <= 0) {
+      same = false;
+    }
+#else
+    got = fread(scratch, 1, chunk, file);
+    
+    if (got == 0) {
+      same = false;
+    }
+#endif
+    else if (memcmp(scratch, &bytes[offset], (size_t) got) != 0) {
+      same = false;
+    }
+    else /* chunk matches */ {
+      offset = offset + (size_t) got;
+    } /* end if */
+  } /* end while */
+  
+#if (OUTFILE_USE_POSIX)
+  close(fd);
+#else
+  /* the file must end where the output ends */
+  if (same && (fgetc(file) != EOF)) {
+    same = false;
+  } /* end if */
+  
+  fclose(file);
+#endif
+  
+  return same;
+} /* end same_contents */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure store_if_changed(outfile, written)
+ * --------------------------------------------------------------------------
+ * Compares the output of write-if-changed outfile with the contents of the
+ * file at its path.  If they differ or the file does not exist,  writes the
+ * output to the file.  Otherwise leaves the file and its modification time
+ * untouched.  Passes whether the file was written in written and sets the
+ * status of outfile on failure.
+ * ----------------------------------------------------------------------- */
+
+static void store_if_changed (outfile_t outfile, bool *written) {
+  
+  *written = false;
+  
+  /* collect all output in the memory block */
+  if (outfile->end > 0) {
+    write_through(outfile, NULL, 0);
+  } /* end if */
+  
+  if (outfile->status != FILEIO_STATUS_SUCCESS) {
+    return;
+  } /* end if */
+  
+  if (same_contents(outfile->path,
+      outfile->memory, outfile->size, outfile->buffer)) {
+    return;
+  } /* end if */
+  
+  /* turn outfile into a plain outfile and pass the block on in one go */
+#if (OUTFILE_USE_POSIX)
+  outfile->fd = open(outfile->path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  
+  if (outfile->fd < 0) {
+#else
+  outfile->file = fopen(outfile->path, "wb");
+  
+  if (outfile->file == NULL) {
+#endif
+    outfile->status = status_for_errno(errno);
+    return;
+  } /* end if */
+  
+#if !(OUTFILE_USE_POSIX)
+  setvbuf(outfile->file, NULL, _IONBF, 0);
+#endif
+  
+  outfile->in_memory = false;
+  write_through(outfile, outfile->memory, outfile->size);
+  *written = true;
+  
+  return;
+} /* end store_if_changed */
+
+
+/* END OF FILE */
@@ -19,9 +19,9 @@
  *                                                                           *
  * @file                                                                     *
  *                                                                           *
- * basic-fileio.h                                                            *
+ * outfile.h                                                                 *
  *                                                                           *
- * Public interface of basic file IO module.                                 *
+ * Public interface of file output module.                                   *
  *                                                                           *
  * @license                                                                  *
  *                                                                           *
@@ -43,13 +43,30 @@
 
 #include "fileio-status.h"
 #include "interned-strings.h"
+#include "m2c-build-params.h"
+
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Buffered output
+ * --------------------------------------------------------------------------
+ * All output is collected in a user-space buffer of OUTFILE_BUFFER_SIZE
+ * bytes,  which is passed to the operating system in a single write when it
+ * is full,  when the outfile is flushed and when it is closed.  The number
+ * of output system calls is thus bounded by the size of the file divided by
+ * the size of the buffer,  regardless of the number of writes to outfile.
+ * ----------------------------------------------------------------------- */
+
+#define OUTFILE_BUFFER_SIZE M2C_OUTFILE_BUFFER_SIZE
 
 
 /* --------------------------------------------------------------------------
  * type outfile_status_t
  * ----------------------------------------------------------------------- */
 
-typedef file_io_status_t outfile_status_t;
+typedef fileio_status_t outfile_status_t;
 
 
 /* --------------------------------------------------------------------------
@@ -62,19 +79,77 @@ typedef struct outfile_struct_t *outfile_t;
 
 
 /* --------------------------------------------------------------------------
- * procedure outfile_open(infile, path, status)
+ * procedure outfile_open(outfile, path, status)
  * --------------------------------------------------------------------------
  * Opens file at path and passes a newly allocated and initialised outfile
  * object back in out-parameter outfile. Passes NULL on failure.
  * ----------------------------------------------------------------------- */
 
-void outfile_open (outfile_t *outfile, char *path, outfile_status_t *status);
+void outfile_open
+  (outfile_t *outfile, const char *path, outfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_open_memory(outfile, status)
+ * --------------------------------------------------------------------------
+ * Passes a newly allocated and initialised memory outfile  back in out-
+ * parameter outfile.  Passes NULL on failure.  A memory outfile collects
+ * its output on the heap  where it is retrieved by outfile_take_output.
+ * Memory outfiles are for generating parts of a file independently  to be
+ * assembled in a file outfile later.
+ * ----------------------------------------------------------------------- */
+
+void outfile_open_memory (outfile_t *outfile, outfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_take_output(outfile, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to a newly allocated block holding all output written
+ * to memory outfile since it was opened or last taken,  and passes the
+ * number of bytes in the block in out-parameter length.  The caller owns
+ * the block and must free it.  Line and column are reset to one.  Returns
+ * NULL and passes zero if there is no output,  if outfile is not a memory
+ * outfile or if memory could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+char *outfile_take_output (outfile_t outfile, size_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_open_if_changed(outfile, path, status)
+ * --------------------------------------------------------------------------
+ * Passes a newly allocated and initialised write-if-changed outfile for the
+ * file at path back in out-parameter outfile.  Passes NULL on failure.  All
+ * output is collected in memory.  When the outfile is closed,  the output
+ * is compared byte for byte with the contents of the file at path,  and the
+ * file is only written if it does not exist or its contents differ.  An
+ * unchanged file keeps its modification time,  thus build tools do not
+ * recompile what depends on it.  The file is not opened until closing,
+ * failures to write it are reported by outfile_close_if_changed.
+ * ----------------------------------------------------------------------- */
+
+void outfile_open_if_changed
+  (outfile_t *outfile, const char *path, outfile_status_t *status);
 
 
 /* --------------------------------------------------------------------------
- * procedure outfile_close(infile)
+ * procedure outfile_close_if_changed(outfile, written, status)
  * --------------------------------------------------------------------------
- * Closes the file associated with outfile and passes NULL in outfile.
+ * Closes outfile like outfile_close,  passes true in written if a file was
+ * written and false if a write-if-changed outfile found its file unchanged,
+ * and passes the status of the last operation on outfile in status.  For a
+ * memory outfile,  written is false.
+ * ----------------------------------------------------------------------- */
+
+void outfile_close_if_changed
+  (outfile_t *outfile, bool *written, outfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_close(outfile)
+ * --------------------------------------------------------------------------
+ * Flushes outfile,  closes the associated file  and passes NULL in outfile.
  * ----------------------------------------------------------------------- */
 
 void outfile_close (outfile_t *outfile);
@@ -86,7 +161,7 @@ void outfile_close (outfile_t *outfile);
  * Writes character ch to outfile.
  * ----------------------------------------------------------------------- */
 
-void outfile_write_char (outfile_t *outfile, char ch);
+void outfile_write_char (outfile_t outfile, char ch);
 
 
 /* --------------------------------------------------------------------------
@@ -95,7 +170,18 @@ void outfile_write_char (outfile_t *outfile, char ch);
  * Writes a NUL terminated char pointer to outfile.
  * ----------------------------------------------------------------------- */
 
-void outfile_write_chars (outfile_t *outfile, const char *chars);
+void outfile_write_chars (outfile_t outfile, const char *chars);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_write_bytes(outfile, bytes, length)
+ * --------------------------------------------------------------------------
+ * Writes length bytes starting at bytes to outfile.  Spans that do not fit
+ * into the buffer are written together with the buffered output  in one
+ * system call without being copied.
+ * ----------------------------------------------------------------------- */
+
+void outfile_write_bytes (outfile_t outfile, const char *bytes, size_t length);
 
 
 /* --------------------------------------------------------------------------
@@ -104,7 +190,7 @@ void outfile_write_chars (outfile_t *outfile, const char *chars);
  * Writes an interned string to outfile.
  * ----------------------------------------------------------------------- */
 
-void outfile_write_string (outfile_t *outfile, intstr_t *string);
+void outfile_write_string (outfile_t outfile, intstr_t string);
 
 
 /* --------------------------------------------------------------------------
@@ -113,7 +199,7 @@ void outfile_write_string (outfile_t *outfile, intstr_t *string);
  * Writes tab to outfile. Expands tabs to spaces if tabwidth > 0.
  * ----------------------------------------------------------------------- */
 
-void outfile_write_tab (outfile_t *outfile);
+void outfile_write_tab (outfile_t outfile);
 
 
 /* --------------------------------------------------------------------------
@@ -122,7 +208,41 @@ void outfile_write_tab (outfile_t *outfile);
  * Writes newline to outfile.
  * ----------------------------------------------------------------------- */
 
-void outfile_write_newline (outfile_t *outfile);
+void outfile_write_newline (outfile_t outfile);
+
+
+/* --------------------------------------------------------------------------
+ * function outfile_reserve(outfile, length)
+ * --------------------------------------------------------------------------
+ * Reserves length bytes in the buffer of outfile and returns a pointer to
+ * the reserved space,  flushing the buffer first if there is not enough
+ * room.  The caller fills in up to length bytes  and passes the number of
+ * bytes actually filled in to outfile_commit  before any other operation
+ * on outfile.  Length must not exceed OUTFILE_BUFFER_SIZE.  Tabs and new-
+ * lines filled into the reserved space are written as they are.  Returns
+ * NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+char *outfile_reserve (outfile_t outfile, size_t length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_commit(outfile, length)
+ * --------------------------------------------------------------------------
+ * Appends the first length bytes of the space reserved  by the preceding
+ * call to outfile_reserve to the output of outfile.
+ * ----------------------------------------------------------------------- */
+
+void outfile_commit (outfile_t outfile, size_t length);
+
+
+/* --------------------------------------------------------------------------
+ * procedure outfile_flush(outfile)
+ * --------------------------------------------------------------------------
+ * Passes all buffered output of outfile to the operating system.
+ * ----------------------------------------------------------------------- */
+
+void outfile_flush (outfile_t outfile);
 
 
 /* --------------------------------------------------------------------------
@@ -131,7 +251,7 @@ void outfile_write_newline (outfile_t *outfile);
  * Returns status of the last operation.
  * ----------------------------------------------------------------------- */
 
-outfile_status_t outfile_status (outfile_t *outfile);
+outfile_status_t outfile_status (outfile_t outfile);
 
 
 /* --------------------------------------------------------------------------
@@ -140,7 +260,7 @@ outfile_status_t outfile_status (outfile_t *outfile);
  * Returns the line number of the current writing position of outfile.
  * ----------------------------------------------------------------------- */
 
-uint_t outfile_line (outfile_t *outfile);
+uint_t outfile_line (outfile_t outfile);
 
 
 /* --------------------------------------------------------------------------
@@ -149,9 +269,9 @@ uint_t outfile_line (outfile_t *outfile);
  * Returns the column number of the current writing position of outfile.
  * ----------------------------------------------------------------------- */
 
-uint_t outfile_column (outfile_t *outfile);
+uint_t outfile_column (outfile_t outfile);
 
 
 #endif /* OUTFILE_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
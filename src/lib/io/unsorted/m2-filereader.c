@@ -35,7 +35,7 @@
 
 #include "m2-filereader.h"
 #include "m2-common.h"
-#include "m2-fileutils.h"
+#include "fileutils.h"
 
 #include <stdio.h>
 #include <errno.h>
@@ -99,6 +99,7 @@ m2c_infile_t m2c_open_infile
   
   FILE *file; size_t size;
   m2c_infile_t new_infile;
+  file_info_t info;
   
   /* check pre-conditions */
   if (filename == NULL) {
@@ -130,8 +131,8 @@ m2c_infile_t m2c_open_infile
     return NULL;
   } /* end if */
   
-  /* allocate new infile */
-  size = filesize(m2c_string_char_ptr(filename));
+  /* allocate new infile, sized from the opened file without a lookup */
+  size = get_stream_file_info(file, &info) ? (size_t) info.size : 0;
   new_infile = malloc(sizeof(m2c_infile_struct_t) + size + 1);
   
   /* if allocation failed, close file, pass status and return */
@@ -0,0 +1,347 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-mem-account.c                                                         *
+ *                                                                           *
+ * Implementation of accounting allocator.                                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-mem-account.h"
+
+#include <string.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Atomic counter operations
+ * ----------------------------------------------------------------------- */
+
+#if defined(__GNUC__)
+#define COUNTER_LOAD(_counter) \
+  __atomic_load_n(&(_counter), __ATOMIC_RELAXED)
+
+#define COUNTER_ADD(_counter, _amount) \
+  __atomic_add_fetch(&(_counter), (_amount), __ATOMIC_RELAXED)
+
+#define COUNTER_SUB(_counter, _amount) \
+  __atomic_sub_fetch(&(_counter), (_amount), __ATOMIC_RELAXED)
+
+#define COUNTER_RAISE(_counter, _expected, _value) \
+  __atomic_compare_exchange_n(&(_counter), &(_expected), (_value), \
+    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+#define COUNTER_LOAD(_counter) (_counter)
+
+#define COUNTER_ADD(_counter, _amount) ((_counter) += (_amount))
+
+#define COUNTER_SUB(_counter, _amount) ((_counter) -= (_amount))
+
+#define COUNTER_RAISE(_counter, _expected, _value) \
+  (((_counter) = (_value)), true)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type block_header_t
+ * --------------------------------------------------------------------------
+ * Header preceding each accounted allocation,  holding its size.  Its size
+ * is a multiple of the strictest alignment of the basic types,  so that the
+ * memory following the header is suitably aligned for any of them.
+ * ----------------------------------------------------------------------- */
+
+typedef union {
+  /* size */  size_t size;
+  /* for alignment only */
+  long double ld;
+  uint64_t u64;
+  void *ptr;
+} block_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden variable usage_table
+ * ----------------------------------------------------------------------- */
+
+static m2c_mem_usage_t usage_table[M2C_MEM_SUBSYSTEM_COUNT];
+
+
+/* --------------------------------------------------------------------------
+ * hidden table subsystem_name
+ * ----------------------------------------------------------------------- */
+
+static const char *subsystem_name[M2C_MEM_SUBSYSTEM_COUNT] = {
+  /* M2C_MEM_INTSTR */      "interned strings",
+  /* M2C_MEM_AST */         "AST",
+  /* M2C_MEM_SYMTAB */      "symbol tables",
+  /* M2C_MEM_TOKENSET */    "token sets",
+  /* M2C_MEM_SNAKE_DICT */  "snake case dictionary",
+  /* M2C_MEM_INFILE */      "input files"
+}; /* end subsystem_name */
+
+
+#if (M2C_MEM_ACCOUNTING)
+
+/* --------------------------------------------------------------------------
+ * Forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void account_growth (m2c_mem_usage_t *sys, uint64_t amount);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mem_alloc(subsystem, size)
+ * --------------------------------------------------------------------------
+ * Allocates size bytes on behalf of subsystem.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_mem_alloc (m2c_mem_subsystem_t subsystem, size_t size) {
+  
+  block_header_t *header;
+  
+  if (size > SIZE_MAX - sizeof(block_header_t)) {
+    return NULL;
+  } /* end if */
+  
+  header = malloc(sizeof(block_header_t) + size);
+  
+  if (header == NULL) {
+    return NULL;
+  } /* end if */
+  
+  header->size = size;
+  
+  if (subsystem < M2C_MEM_SUBSYSTEM_COUNT) {
+    COUNTER_ADD(usage_table[subsystem].alloc_count, 1);
+    account_growth(&usage_table[subsystem], size);
+  } /* end if */
+  
+  return header + 1;
+} /* end m2c_mem_alloc */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mem_calloc(subsystem, count, size)
+ * --------------------------------------------------------------------------
+ * Allocates zeroed memory for count elements of size bytes on behalf of
+ * subsystem.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_mem_calloc
+  (m2c_mem_subsystem_t subsystem, size_t count, size_t size) {
+  
+  void *ptr;
+  
+  if ((size != 0) && (count > SIZE_MAX / size)) {
+    return NULL;
+  } /* end if */
+  
+  ptr = m2c_mem_alloc(subsystem, count * size);
+  
+  if (ptr != NULL) {
+    memset(ptr, 0, count * size);
+  } /* end if */
+  
+  return ptr;
+} /* end m2c_mem_calloc */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mem_realloc(subsystem, ptr, size)
+ * --------------------------------------------------------------------------
+ * Resizes memory at ptr on behalf of subsystem to size bytes.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_mem_realloc
+  (m2c_mem_subsystem_t subsystem, void *ptr, size_t size) {
+  
+  block_header_t *header, *new_header;
+  size_t old_size;
+  
+  if (ptr == NULL) {
+    return m2c_mem_alloc(subsystem, size);
+  } /* end if */
+  
+  if (size > SIZE_MAX - sizeof(block_header_t)) {
+    return NULL;
+  } /* end if */
+  
+  header = (block_header_t *) ptr - 1;
+  old_size = header->size;
+  
+  new_header = realloc(header, sizeof(block_header_t) + size);
+  
+  if (new_header == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_header->size = size;
+  
+  if (subsystem < M2C_MEM_SUBSYSTEM_COUNT) {
+    if (size > old_size) {
+      account_growth(&usage_table[subsystem], size - old_size);
+    }
+    else {
+      COUNTER_SUB(usage_table[subsystem].live_bytes, old_size - size);
+    } /* end if */
+  } /* end if */
+  
+  return new_header + 1;
+} /* end m2c_mem_realloc */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mem_free(subsystem, ptr)
+ * --------------------------------------------------------------------------
+ * Deallocates memory at ptr on behalf of subsystem.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mem_free (m2c_mem_subsystem_t subsystem, void *ptr) {
+  
+  block_header_t *header;
+  
+  if (ptr == NULL) {
+    return;
+  } /* end if */
+  
+  header = (block_header_t *) ptr - 1;
+  
+  if (subsystem < M2C_MEM_SUBSYSTEM_COUNT) {
+    COUNTER_SUB(usage_table[subsystem].live_bytes, header->size);
+  } /* end if */
+  
+  free(header);
+} /* end m2c_mem_free */
+
+#endif /* M2C_MEM_ACCOUNTING */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mem_usage(subsystem, usage)
+ * --------------------------------------------------------------------------
+ * Passes the memory usage of subsystem in usage.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mem_usage (m2c_mem_subsystem_t subsystem, m2c_mem_usage_t *usage) {
+  
+  if ((usage == NULL) || (subsystem >= M2C_MEM_SUBSYSTEM_COUNT)) {
+    return;
+  } /* end if */
+  
+  usage->live_bytes = COUNTER_LOAD(usage_table[subsystem].live_bytes);
+  usage->peak_bytes = COUNTER_LOAD(usage_table[subsystem].peak_bytes);
+  usage->alloc_count = COUNTER_LOAD(usage_table[subsystem].alloc_count);
+} /* end m2c_mem_usage */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mem_print_report(out)
+ * --------------------------------------------------------------------------
+ * Prints the memory usage of each subsystem and their totals to out.  The
+ * total peak is the sum of the subsystem peaks,  an upper bound of the peak
+ * of all subsystems together.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mem_print_report (FILE *out) {
+  
+  m2c_mem_usage_t sys, total;
+  uint_t index;
+  
+  if (out == NULL) {
+    return;
+  } /* end if */
+  
+  total.live_bytes = 0;
+  total.peak_bytes = 0;
+  total.alloc_count = 0;
+  
+  fprintf(out, "memory report:\n");
+  fprintf(out, "%-22s %14s %14s %12s\n",
+    "subsystem", "live bytes", "peak bytes", "allocations");
+  
+  for (index = 0; index < M2C_MEM_SUBSYSTEM_COUNT; index++) {
+    m2c_mem_usage((m2c_mem_subsystem_t) index, &sys);
+    
+    fprintf(out, "%-22s %14llu %14llu %12llu\n", subsystem_name[index],
+      (unsigned long long) sys.live_bytes,
+      (unsigned long long) sys.peak_bytes,
+      (unsigned long long) sys.alloc_count);
+    
+    total.live_bytes = total.live_bytes + sys.live_bytes;
+    total.peak_bytes = total.peak_bytes + sys.peak_bytes;
+    total.alloc_count = total.alloc_count + sys.alloc_count;
+  } /* end for */
+  
+  fprintf(out, "%-22s %14llu %14llu %12llu\n", "total",
+    (unsigned long long) total.live_bytes,
+    (unsigned long long) total.peak_bytes,
+    (unsigned long long) total.alloc_count);
+} /* end m2c_mem_print_report */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+#if (M2C_MEM_ACCOUNTING)
+
+/* --------------------------------------------------------------------------
+ * private procedure account_growth(sys, amount)
+ * --------------------------------------------------------------------------
+ * Adds amount to the live bytes of usage record sys  and raises its high-
+ * water mark if exceeded.
+ * ----------------------------------------------------------------------- */
+
+static void account_growth (m2c_mem_usage_t *sys, uint64_t amount) {
+  
+  uint64_t live, peak;
+  
+  live = COUNTER_ADD(sys->live_bytes, amount);
+  peak = COUNTER_LOAD(sys->peak_bytes);
+  
+  /* a failed exchange reloads peak,  retry while still below */
+  while (live > peak) {
+    if (COUNTER_RAISE(sys->peak_bytes, peak, live)) {
+      break;
+    } /* end if */
+  } /* end while */
+} /* end account_growth */
+
+#endif /* M2C_MEM_ACCOUNTING */
+
+
+/* END OF FILE */
@@ -0,0 +1,193 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-mem-account.h                                                         *
+ *                                                                           *
+ * Public interface of accounting allocator.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MEM_ACCOUNT_H
+#define M2C_MEM_ACCOUNT_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Memory accounting
+ * --------------------------------------------------------------------------
+ * Subsystems with a sizeable footprint allocate through the accounting
+ * allocator,  which tracks per subsystem the bytes in use,  their high-water
+ * mark and the number of allocations.  Each allocation carries a header
+ * recording its size,  memory obtained from the accounting allocator must
+ * thus be resized and deallocated through it,  passing the same subsystem.
+ * Arena allocators account for their blocks,  not for individual objects.
+ * Memory mapped files are not accounted for.
+ *
+ * Counters are updated atomically on hosts with GCC compatible atomic
+ * builtins,  elsewhere they are exact only for single threaded use.
+ *
+ * Define M2C_MEM_ACCOUNTING as 0 to map the allocator directly to malloc,
+ * calloc,  realloc and free.  All figures are then reported as zero.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_MEM_ACCOUNTING
+#define M2C_MEM_ACCOUNTING 1
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_mem_subsystem_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the subsystems accounted for.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MEM_INTSTR,       /* string repository */
+  M2C_MEM_AST,          /* AST nodes, regions and AST files */
+  M2C_MEM_SYMTAB,       /* symbol tables */
+  M2C_MEM_TOKENSET,     /* token sets */
+  M2C_MEM_SNAKE_DICT,   /* snake case dictionary */
+  M2C_MEM_INFILE,       /* input file buffers */
+  M2C_MEM_SUBSYSTEM_END_MARK
+} m2c_mem_subsystem_t;
+
+#define M2C_MEM_SUBSYSTEM_COUNT M2C_MEM_SUBSYSTEM_END_MARK
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_mem_usage_t
+ * --------------------------------------------------------------------------
+ * Record type for the memory usage of a subsystem.  Field live_bytes holds
+ * the bytes in use,  peak_bytes their high-water mark,  alloc_count the
+ * number of allocations made,  excluding resizes.  Byte counts are those
+ * requested,  excluding the allocation headers.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* live_bytes */   uint64_t live_bytes;
+  /* peak_bytes */   uint64_t peak_bytes;
+  /* alloc_count */  uint64_t alloc_count;
+} m2c_mem_usage_t;
+
+
+#if (M2C_MEM_ACCOUNTING)
+
+/* --------------------------------------------------------------------------
+ * function m2c_mem_alloc(subsystem, size)
+ * --------------------------------------------------------------------------
+ * Allocates size bytes on behalf of subsystem like malloc.  Returns a
+ * pointer to the allocated memory,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_mem_alloc (m2c_mem_subsystem_t subsystem, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mem_calloc(subsystem, count, size)
+ * --------------------------------------------------------------------------
+ * Allocates zeroed memory for count elements of size bytes on behalf of
+ * subsystem like calloc.  Returns a pointer to the allocated memory,  or
+ * NULL on failure or if the total size overflows.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_mem_calloc
+  (m2c_mem_subsystem_t subsystem, size_t count, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mem_realloc(subsystem, ptr, size)
+ * --------------------------------------------------------------------------
+ * Resizes memory at ptr obtained from the accounting allocator for the same
+ * subsystem to size bytes like realloc.  If ptr is NULL,  allocates size
+ * bytes.  Returns a pointer to the resized memory,  or NULL on failure,  in
+ * which case the memory at ptr is left unchanged.
+ * ----------------------------------------------------------------------- */
+
+void *m2c_mem_realloc
+  (m2c_mem_subsystem_t subsystem, void *ptr, size_t size);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mem_free(subsystem, ptr)
+ * --------------------------------------------------------------------------
+ * Deallocates memory at ptr obtained from the accounting allocator for the
+ * same subsystem.  Does nothing if ptr is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mem_free (m2c_mem_subsystem_t subsystem, void *ptr);
+
+#else /* no accounting */
+
+#define m2c_mem_alloc(_subsystem, _size) malloc(_size)
+
+#define m2c_mem_calloc(_subsystem, _count, _size) calloc(_count, _size)
+
+#define m2c_mem_realloc(_subsystem, _ptr, _size) realloc(_ptr, _size)
+
+#define m2c_mem_free(_subsystem, _ptr) free(_ptr)
+
+#endif /* M2C_MEM_ACCOUNTING */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mem_usage(subsystem, usage)
+ * --------------------------------------------------------------------------
+ * Passes the memory usage of subsystem in usage.  Does nothing if usage is
+ * NULL or subsystem is invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mem_usage (m2c_mem_subsystem_t subsystem, m2c_mem_usage_t *usage);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mem_print_report(out)
+ * --------------------------------------------------------------------------
+ * Prints the memory usage of each subsystem and their totals to out,  as
+ * requested by compiler option --mem-report.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mem_print_report (FILE *out);
+
+
+#endif /* M2C_MEM_ACCOUNT_H */
+
+/* END OF FILE */
@@ -80,80 +80,139 @@
 
 
 /* --------------------------------------------------------------------------
- * Settings for MacOS X
+ * Use of plain filenames
+ * --------------------------------------------------------------------------
+ * M2C_PATHNAME_PLAIN_FILENAMES_VALID
+ *   enable (1) if every plain filename is valid on the host,  otherwise (0).
+ *   A plain filename is a pathname component of component characters with
+ *   at most one period and no space.  If enabled,  is_valid_filename accepts
+ *   plain filenames inline without calling into the pathname grammar.
+ *
+ *   Restrictions
+ *   - disable where component names are reserved,  as on MS-DOS and Windows.
  * ----------------------------------------------------------------------- */
 
+
+/* --------------------------------------------------------------------------
+ * Policy selection
+ * --------------------------------------------------------------------------
+ * The build may select a policy by defining M2C_PATHNAME_POLICY as one of
+ * the following identifiers,  for example when cross compiling.  Otherwise
+ * the policy of the host platform is selected.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_PATHNAME_POLICY_MACOS 1
+#define M2C_PATHNAME_POLICY_AMIGAOS 2
+#define M2C_PATHNAME_POLICY_MSDOS 3
+#define M2C_PATHNAME_POLICY_OPENVMS 4
+#define M2C_PATHNAME_POLICY_WINDOWS 5
+#define M2C_PATHNAME_POLICY_UNIX 6
+#define M2C_PATHNAME_POLICY_DEFAULT 7
+
+#if !defined(M2C_PATHNAME_POLICY)
 #if defined(__APPLE__)
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_MACOS
+#elif defined(__amigaos)
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_AMIGAOS
+#elif defined(MSDOS) || defined(OS2)
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_MSDOS
+#elif defined(VMS) || defined(__VMS)
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_OPENVMS
+#elif defined(_WIN32) || defined(_WIN64)
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_WINDOWS
+#elif defined(unix) || defined(__unix__)
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_UNIX
+#else
+#define M2C_PATHNAME_POLICY M2C_PATHNAME_POLICY_DEFAULT
+#endif
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Settings for MacOS X
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_MACOS)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 1
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 1
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 0
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 1
 
 
 /* --------------------------------------------------------------------------
  * Settings for AmigaOS
  * ----------------------------------------------------------------------- */
 
-#elif defined(__amigaos)
+#elif (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_AMIGAOS)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 1
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 1
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 0
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 1
 
 
 /* --------------------------------------------------------------------------
  * Settings for MS-DOS and OS/2
  * ----------------------------------------------------------------------- */
 
-#elif defined(MSDOS) || defined(OS2)
+#elif (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_MSDOS)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 0
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 0
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 1
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 0
 
 
 /* --------------------------------------------------------------------------
  * Settings for OpenVMS
  * ----------------------------------------------------------------------- */
 
-#elif defined(VMS) || defined(__VMS)
+#elif (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_OPENVMS)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 0
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 0
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 1
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 1
 
 
 /* --------------------------------------------------------------------------
  * Settings for Microsoft Windows
  * ----------------------------------------------------------------------- */
 
-#elif defined(_WIN32) || defined(_WIN64)
+#elif (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_WINDOWS)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 0
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 1
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 1
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 0
 
 
 /* --------------------------------------------------------------------------
  * Default settings for Unix or Unix-like systems
  * ----------------------------------------------------------------------- */
 
-#elif defined(unix) || defined(__unix__)
+#elif (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_UNIX)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 1
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 0
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 0
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 1
 
 
 /* --------------------------------------------------------------------------
  * Default settings for any other systems
  * ----------------------------------------------------------------------- */
 
-#else /* D E F A U L T */
+#elif (M2C_PATHNAME_POLICY == M2C_PATHNAME_POLICY_DEFAULT)
 #define M2C_PATHCOMP_MAY_CONTAIN_PERIOD 0
 #define M2C_PATHCOMP_MAY_CONTAIN_SPACE 0
 #define M2C_PATHCOMP_MAY_CONTAIN_MINUS 1
 #define M2C_PATHCOMP_MAY_CONTAIN_TILDE 0
+#define M2C_PATHNAME_PLAIN_FILENAMES_VALID 0
+
+#else
+#error "Unknown pathname policy selected in M2C_PATHNAME_POLICY."
 #endif
 
 #endif /* M2C_PATHNAME_POLICY_H */
@@ -37,8 +37,8 @@
   * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
   * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-#include "m2-pathnames.h"
-#include "m2-pathname-policy.h"
+#include "m2c-pathnames.h"
+#include "m2c-pathname-policy.h"
 
 #include "cstring.h"
 #include <stddef.h>
@@ -148,10 +148,44 @@ m2c_pathname_status_t split_pathname
    char_ptr_t *dirpath,      /* out, pass in NULL to ignore */
    char_ptr_t *filename,     /* out, pass in NULL to ignore */
    uint_t *chars_processed)  /* out, pass in NULL to ignore */ {
+  
+  m2c_pathname_status_t status;
+  m2c_pathname_view_t dirview, fnview;
+  
+  status = split_pathname_view(path, &dirview, &fnview, chars_processed);
+  
+  if (status != M2C_PATHNAME_STATUS_SUCCESS) {
+    return status;
+  } /* end if */
+  
+  /* allocate and copy dirpath, pass it back */
+  WRITE_OUTPARAM(dirpath,
+    new_cstr_from_slice(path, dirview.offset, dirview.length));
+  
+  /* allocate and copy filename, pass it back */
+  WRITE_OUTPARAM(filename,
+    new_cstr_from_slice(path, fnview.offset, fnview.length));
+  
+  return M2C_PATHNAME_STATUS_SUCCESS;
+} /* end split_pathname */
+
+
+/* --------------------------------------------------------------------------
+ * function split_pathname_view(path, dirpath, filename, chars_processed)
+ * --------------------------------------------------------------------------
+ * Verifies path like split_pathname  but passes back the offsets and lengths
+ * of its directory path and filename within path instead of copies.
+ * ----------------------------------------------------------------------- */
+
+m2c_pathname_status_t split_pathname_view
+  (const char *path,               /* in, may not be NULL */
+   m2c_pathname_view_t *dirpath,   /* out, pass in NULL to ignore */
+   m2c_pathname_view_t *filename,  /* out, pass in NULL to ignore */
+   uint_t *chars_processed)        /* out, pass in NULL to ignore */ {
    
-  bool invalid;
+  bool invalid = false;
   int fn_index;
-  uint_t final_index, dplen, fnlen;
+  uint_t final_index, dplen;
   
   if (path == NULL) {
     return M2C_PATHNAME_STATUS_INVALID_REFERENCE;
@@ -168,27 +202,30 @@ m2c_pathname_status_t split_pathname
     WRITE_OUTPARAM(chars_processed, final_index);
     return M2C_PATHNAME_STATUS_INVALID_PATH;
   } /* end if */
-    
+  
   if (fn_index == NO_FILENAME_FOUND) {
     dplen = final_index;
-    fnlen = 0;
   }
   else /* filename found */ {
     dplen = fn_index;
-    fnlen = final_index - dplen;
   } /* end if */
   
-  /* allocate and copy dirpath, pass it back */
-  WRITE_OUTPARAM(dirpath, new_cstr_from_slice(path, 0, dplen));
+  /* pass back dirpath and filename */
+  if (dirpath != NULL) {
+    dirpath->offset = 0;
+    dirpath->length = dplen;
+  } /* end if */
   
-  /* allocate and copy filename, pass it back */
-  WRITE_OUTPARAM(filename, new_cstr_from_slice(path, dplen, fnlen));
+  if (filename != NULL) {
+    filename->offset = dplen;
+    filename->length = final_index - dplen;
+  } /* end if */
   
   /* pass back number of characters processed */
   WRITE_OUTPARAM(chars_processed, final_index);
    
   return M2C_PATHNAME_STATUS_SUCCESS;
-} /* end split_pathname */
+} /* end split_pathname_view */
 
 
 /* --------------------------------------------------------------------------
@@ -198,7 +235,7 @@ m2c_pathname_status_t split_pathname
  * ----------------------------------------------------------------------- */
 
 bool is_valid_pathname (const char *path) {  
-  bool invalid;
+  bool invalid = false;
   
   if ((path == NULL) || (path[0] == ASCII_NUL)) {
     return false;
@@ -252,10 +289,45 @@ m2c_pathname_status_t split_filename
    char_ptr_t *basename,     /* out, pass in NULL to ignore */
    char_ptr_t *suffix,       /* out, pass in NULL to ignore */
    uint_t *chars_processed)  /* out, pass in NULL to ignore */ {
+  
+  m2c_pathname_status_t status;
+  m2c_pathname_view_t baseview, suffixview;
+  
+  status =
+    split_filename_view(filename, &baseview, &suffixview, chars_processed);
+  
+  if (status != M2C_PATHNAME_STATUS_SUCCESS) {
+    return status;
+  } /* end if */
+  
+  /* allocate and copy basename, pass it back */
+  WRITE_OUTPARAM(basename,
+    new_cstr_from_slice(filename, baseview.offset, baseview.length));
+  
+  /* allocate and copy suffix, pass it back */
+  WRITE_OUTPARAM(suffix,
+    new_cstr_from_slice(filename, suffixview.offset, suffixview.length));
+  
+  return M2C_PATHNAME_STATUS_SUCCESS;
+} /* end split_filename */
+
+
+/* --------------------------------------------------------------------------
+ * function split_filename_view(filename, basename, suffix, chars_processed)
+ * --------------------------------------------------------------------------
+ * Verifies filename like split_filename  but passes back the offsets and
+ * lengths of its basename and suffix within filename instead of copies.
+ * ----------------------------------------------------------------------- */
+
+m2c_pathname_status_t split_filename_view
+  (const char *filename,           /* in, may not be NULL */
+   m2c_pathname_view_t *basename,  /* out, pass in NULL to ignore */
+   m2c_pathname_view_t *suffix,    /* out, pass in NULL to ignore */
+   uint_t *chars_processed)        /* out, pass in NULL to ignore */ {
    
-  bool invalid;
+  bool invalid = false;
   int suffixpos;
-  uint_t final_index, baselen, suffixlen;
+  uint_t final_index, baselen;
   
   if (filename == NULL) {
     return M2C_PATHNAME_STATUS_INVALID_REFERENCE;
@@ -275,34 +347,37 @@ m2c_pathname_status_t split_filename
     
   if (suffixpos == NO_SUFFIX_FOUND) {
     baselen = final_index;
-    suffixlen = 0;
   }  
   else /* suffix found */ {
     baselen = suffixpos;
-    suffixlen = final_index - suffixpos;
   } /* end if */
   
-  /* allocate and copy basename, pass it back */
-  WRITE_OUTPARAM(basename, new_cstr_from_slice(filename, 0, baselen));
+  /* pass back basename and suffix */
+  if (basename != NULL) {
+    basename->offset = 0;
+    basename->length = baselen;
+  } /* end if */
   
-  /* allocate and copy suffix, pass it back */
-  WRITE_OUTPARAM(suffix, new_cstr_from_slice(filename, baselen, suffixlen));
+  if (suffix != NULL) {
+    suffix->offset = baselen;
+    suffix->length = final_index - baselen;
+  } /* end if */
   
   /* pass back number of characters processed */
   WRITE_OUTPARAM(chars_processed, final_index);
    
   return M2C_PATHNAME_STATUS_SUCCESS;
-} /* end split_filename */
+} /* end split_filename_view */
 
 
 /* --------------------------------------------------------------------------
- * function is_valid_filename(filename)
+ * function is_valid_filename_by_grammar(filename)
  * --------------------------------------------------------------------------
  * Returns true if filename is a valid filename, otherwise false.
  * ----------------------------------------------------------------------- */
 
-bool is_valid_filename (const char *filename) {  
-  bool invalid;
+bool is_valid_filename_by_grammar (const char *filename) {  
+  bool invalid = false;
   
   if ((filename == NULL) || (filename[0] == ASCII_NUL)) {
     return false;
@@ -311,33 +386,7 @@ bool is_valid_filename (const char *filename) {
   parse_filename(filename, 0, &invalid, NULL);
   
   return (invalid == false);
-} /* end is_valid_filename */
-
-
-/* --------------------------------------------------------------------------
- * function is_def_suffix(suffix)
- * --------------------------------------------------------------------------
- * Returns true if suffix is ".def" or ".DEF", otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool is_def_suffix (const char *suffix) {
-  return (suffix[0] == '.') && (suffix[4] == ASCII_NUL) &&
-    (((suffix[1] == 'd') && (suffix[2] == 'e') && (suffix[3] == 'f')) ||
-     ((suffix[1] == 'D') && (suffix[2] == 'D') && (suffix[3] == 'F')));
-} /* end is_def_suffix */
-
-
-/* --------------------------------------------------------------------------
- * function is_mod_suffix(suffix)
- * --------------------------------------------------------------------------
- * Returns true if suffix is ".mod" or ".MOD", otherwise false.
- * ----------------------------------------------------------------------- */
-
-bool is_mod_suffix (const char *suffix) {
-  return (suffix[0] == '.') && (suffix[4] == ASCII_NUL) &&
-    (((suffix[1] == 'm') && (suffix[2] == 'o') && (suffix[3] == 'd')) ||
-     ((suffix[1] == 'M') && (suffix[2] == 'O') && (suffix[3] == 'D')));
-} /* end is_mod_suffix */
+} /* end is_valid_filename_by_grammar */
 
 
 /* --------------------------------------------------------------------------
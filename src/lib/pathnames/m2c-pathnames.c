@@ -43,7 +43,7 @@
  * ----------------------------------------------------------------------- */
 
 #if defined(__amigaos__)
-#include "m2-pathnames-amiga.c"
+#include "m2c-pathnames-amiga.c"
 
 
 /* --------------------------------------------------------------------------
@@ -52,7 +52,7 @@
 
 #elif (defined(__MACH__)) || (defined(__unix)) || \
       ((defined(__unix__)) && (!defined(_WIN32)))
-#include "m2-pathnames-posix.c"
+#include "m2c-pathnames-posix.c"
 
 
 /* --------------------------------------------------------------------------
@@ -60,7 +60,7 @@
  * ----------------------------------------------------------------------- */
 
 #elif defined(VMS) || defined(__VMS)
-#include "m2-pathnames-vms.c"
+#include "m2c-pathnames-vms.c"
 
 
 /* --------------------------------------------------------------------------
@@ -69,7 +69,7 @@
 
 #elif (defined(_WIN32)) || (defined(_WIN64)) || \
       (defined(MSDOS)) || defined(OS2)
-#include "m2-pathnames-win.c"
+#include "m2c-pathnames-win.c"
 
 
 /* --------------------------------------------------------------------------
@@ -40,7 +40,10 @@
 #ifndef M2C_PATHNAMES_H
 #define M2C_PATHNAMES_H
 
-#include "m2-common.h"
+#include "m2c-common.h"
+#include "m2c-pathname-policy.h"
+
+#include <stddef.h>
 #include <stdbool.h>
 
 /* --------------------------------------------------------------------------
@@ -65,6 +68,20 @@ typedef enum {
 } m2c_pathname_status_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_pathname_view_t
+ * --------------------------------------------------------------------------
+ * Record type for a component of a pathname  given by its offset into and
+ * its length within the string it was split from.  A component that is not
+ * present has length zero.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* offset */  uint_t offset;
+  /* length */  uint_t length;
+} m2c_pathname_view_t;
+
+
 /* --------------------------------------------------------------------------
  * function split_pathname(path, dirpath, filename, chars_processed)
  * --------------------------------------------------------------------------
@@ -88,6 +105,24 @@ m2c_pathname_status_t split_pathname
    uint_t *chars_processed); /* out, pass in NULL to ignore */
 
 
+/* --------------------------------------------------------------------------
+ * function split_pathname_view(path, dirpath, filename, chars_processed)
+ * --------------------------------------------------------------------------
+ * Verifies path like split_pathname  but does not allocate.  If path is
+ * valid,  the offsets and lengths of its directory path component and its
+ * filename component within path are passed back in dirpath and filename.
+ * Since the filename is the final component,  path + filename->offset is
+ * the NUL terminated filename,  which may in turn be passed to procedure
+ * split_filename_view.  NULL may be passed in for any out-parameter.
+ * ----------------------------------------------------------------------- */
+
+m2c_pathname_status_t split_pathname_view
+  (const char *path,               /* in, may not be NULL */
+   m2c_pathname_view_t *dirpath,   /* out, pass in NULL to ignore */
+   m2c_pathname_view_t *filename,  /* out, pass in NULL to ignore */
+   uint_t *chars_processed);       /* out, pass in NULL to ignore */
+
+
 /* --------------------------------------------------------------------------
  * function is_valid_pathname(path)
  * --------------------------------------------------------------------------
@@ -119,31 +154,107 @@ m2c_pathname_status_t split_filename
    uint_t *chars_processed); /* out, pass in NULL to ignore */
 
 
+/* --------------------------------------------------------------------------
+ * function split_filename_view(filename, basename, suffix, chars_processed)
+ * --------------------------------------------------------------------------
+ * Verifies filename like split_filename  but does not allocate.  If filename
+ * is valid,  the offsets and lengths of its basename and suffix components
+ * within filename are passed back in basename and suffix.  Since the suffix
+ * is the final component,  filename + suffix->offset is the NUL terminated
+ * suffix,  or the empty string if there is none.  NULL may be passed in for
+ * any out-parameter.
+ * ----------------------------------------------------------------------- */
+
+m2c_pathname_status_t split_filename_view
+  (const char *filename,           /* in, may not be NULL */
+   m2c_pathname_view_t *basename,  /* out, pass in NULL to ignore */
+   m2c_pathname_view_t *suffix,    /* out, pass in NULL to ignore */
+   uint_t *chars_processed);       /* out, pass in NULL to ignore */
+
+
+/* --------------------------------------------------------------------------
+ * function is_valid_filename_by_grammar(filename)
+ * --------------------------------------------------------------------------
+ * Returns true if filename is a valid filename by the host system's full
+ * pathname grammar,  otherwise false.  Called by is_valid_filename.
+ * ----------------------------------------------------------------------- */
+
+bool is_valid_filename_by_grammar (const char *filename);
+
+
 /* --------------------------------------------------------------------------
  * function is_valid_filename(filename)
  * --------------------------------------------------------------------------
- * Returns true if filename is a valid filename, otherwise false.
+ * Returns true if filename is a valid filename, otherwise false.  A plain
+ * filename is accepted inline where the pathname policy permits,  see
+ * M2C_PATHNAME_PLAIN_FILENAMES_VALID.
  * ----------------------------------------------------------------------- */
 
-bool is_valid_filename (const char *filename);
+static inline bool is_valid_filename (const char *filename) {
+  
+#if (M2C_PATHNAME_PLAIN_FILENAMES_VALID != 0)
+  const char *next;
+  bool period_seen;
+  
+  if (filename == NULL) {
+    return false;
+  } /* end if */
+  
+  next = filename;
+  period_seen = false;
+  
+  /* plain filename, with at most one period */
+  while (IS_ALPHANUMERIC(*next) || (*next == '_')) {
+    next++;
+    while (IS_ALPHANUMERIC(*next) || (*next == '_') ||
+      ((M2C_PATHCOMP_MAY_CONTAIN_MINUS) && (*next == '-')) ||
+      ((M2C_PATHCOMP_MAY_CONTAIN_TILDE) && (*next == '~'))) {
+      next++;
+    } /* end while */
+    
+    if (*next == ASCII_NUL) {
+      return true;
+    } /* end if */
+    
+    if ((*next != '.') || (period_seen)) {
+      break;
+    } /* end if */
+    
+    period_seen = true;
+    next++;
+  } /* end while */
+#endif
+  
+  return is_valid_filename_by_grammar(filename);
+} /* end is_valid_filename */
 
 
 /* --------------------------------------------------------------------------
  * function is_def_suffix(suffix)
  * --------------------------------------------------------------------------
- * Returns true if suffix is ".def" or ".DEF", otherwise false.
+ * Returns true if suffix is ".def" or ".DEF", otherwise false.  The case
+ * of the remaining letters is tested against that of the first one.
  * ----------------------------------------------------------------------- */
 
-bool is_def_suffix (const char *suffix);
+static inline bool is_def_suffix (const char *suffix) {
+  return (suffix[0] == '.') && ((suffix[1] | 0x20) == 'd') &&
+    (suffix[2] == ('E' | (suffix[1] & 0x20))) &&
+    (suffix[3] == ('F' | (suffix[1] & 0x20))) && (suffix[4] == ASCII_NUL);
+} /* end is_def_suffix */
 
 
 /* --------------------------------------------------------------------------
  * function is_mod_suffix(suffix)
  * --------------------------------------------------------------------------
- * Returns true if suffix is ".mod" or ".MOD", otherwise false.
+ * Returns true if suffix is ".mod" or ".MOD", otherwise false.  The case
+ * of the remaining letters is tested against that of the first one.
  * ----------------------------------------------------------------------- */
 
-bool is_mod_suffix (const char *suffix);
+static inline bool is_mod_suffix (const char *suffix) {
+  return (suffix[0] == '.') && ((suffix[1] | 0x20) == 'm') &&
+    (suffix[2] == ('O' | (suffix[1] & 0x20))) &&
+    (suffix[3] == ('D' | (suffix[1] & 0x20))) && (suffix[4] == ASCII_NUL);
+} /* end is_mod_suffix */
 
 
 /* --------------------------------------------------------------------------
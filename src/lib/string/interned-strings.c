@@ -43,6 +43,75 @@
 
 #include "interned-strings.h"
 #include "hash.h"
+#include "m2c-mem-account.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if (INTSTR_THREAD_SAFE)
+#include <pthread.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped snapshots for POSIX and Unix-like host platforms
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  intstr_map_snapshot maps snapshot files
+ * into the address space.  On all other hosts  (AmigaOS, OpenVMS, Windows)
+ * the file is loaded.  Define INTSTR_SNAPSHOT_USE_MMAP as 0 to force loading.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(INTSTR_SNAPSHOT_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define INTSTR_SNAPSHOT_USE_MMAP 1
+#else
+#define INTSTR_SNAPSHOT_USE_MMAP 0
+#endif
+#endif
+
+#if (INTSTR_SNAPSHOT_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Atomic access to client fields of string objects
+ * --------------------------------------------------------------------------
+ * Tags,  flags and translations of shared string objects may be read and
+ * stored by concurrent threads.  Flags and tags are independent values and
+ * are accessed relaxed.  A translation is stored with release semantics and
+ * loaded with acquire semantics,  so that the characters it points to are
+ * visible to any thread that loads it.
+ * ----------------------------------------------------------------------- */
+
+#if (INTSTR_THREAD_SAFE) && defined(__GNUC__)
+#define FIELD_LOAD(_field) \
+  __atomic_load_n(&(_field), __ATOMIC_RELAXED)
+
+#define FIELD_STORE(_field, _value) \
+  __atomic_store_n(&(_field), (_value), __ATOMIC_RELAXED)
+
+#define FIELD_LOAD_ACQUIRE(_field) \
+  __atomic_load_n(&(_field), __ATOMIC_ACQUIRE)
+
+#define FIELD_STORE_RELEASE(_field, _value) \
+  __atomic_store_n(&(_field), (_value), __ATOMIC_RELEASE)
+#else
+#define FIELD_LOAD(_field) (_field)
+
+#define FIELD_STORE(_field, _value) ((_field) = (_value))
+
+#define FIELD_LOAD_ACQUIRE(_field) (_field)
+
+#define FIELD_STORE_RELEASE(_field, _value) ((_field) = (_value))
+#endif
 
 
 /* --------------------------------------------------------------------------
@@ -51,30 +120,56 @@
 
 #define INTSTR_REPO_DEFAULT_BUCKET_COUNT 2011
 
+#define INTSTR_ARENA_ALIGNMENT (sizeof(void *))
+
+#define ARENA_ROUND_UP(_size) \
+  (((_size) + INTSTR_ARENA_ALIGNMENT - 1) & ~(INTSTR_ARENA_ALIGNMENT - 1))
+
+#define INTSTR_REPO_DEFAULT_SHARD_COUNT 16
+
+#define INTSTR_REPO_MAX_SHARD_COUNT 256
+
 
 /* --------------------------------------------------------------------------
- * private type intstr_hash_t
+ * Load factor and rehashing
  * --------------------------------------------------------------------------
- * unsigned integer type representing a 32-bit hash value.
+ * The bucket table grows  when the number of entries exceeds the number of
+ * buckets times INTSTR_REPO_MAX_LOAD.  Entries are then moved from the old
+ * to the new table  INTSTR_REPO_REHASH_STEP buckets at a time  with every
+ * insertion,  thus no single insertion pays for rehashing the whole table.
  * ----------------------------------------------------------------------- */
 
-typedef uint32_t intstr_hash_t;
+#define INTSTR_REPO_MAX_LOAD 1
+
+#define INTSTR_REPO_REHASH_STEP 8
 
 
 /* --------------------------------------------------------------------------
  * hidden type intstr_struct_t
  * --------------------------------------------------------------------------
- * record type representing a dynamic string object.
+ * record type representing a dynamic string object.  Without reference
+ * counting,  the ref_count field is omitted.
  * ----------------------------------------------------------------------- */
 
 struct intstr_struct_t {
+#if !(INTSTR_IMMORTAL)
   uint_t ref_count;
+#endif
+  intstr_hash_t key;
   uint_t length;
+  uint_t tag;
+  uint_t flags;
+  const char *xlat;
   char char_array[];
 };
 
 typedef struct intstr_struct_t intstr_struct_t;
 
+/* static string objects must match the layout of dynamic ones */
+typedef char intstr_static_layout_check
+  [(offsetof(intstr_static_t, char_array) ==
+    offsetof(intstr_struct_t, char_array)) ? 1 : -1];
+
 
 /* --------------------------------------------------------------------------
  * private type intstr_repo_entry_t
@@ -93,18 +188,99 @@ struct intstr_repo_entry_s {
 typedef struct intstr_repo_entry_s intstr_repo_entry_s;
 
 
+/* --------------------------------------------------------------------------
+ * private type intstr_arena_block_t
+ * --------------------------------------------------------------------------
+ * pointer to record representing a storage block of the repository arena.
+ * Blocks are linked from the most recently allocated to the first.
+ * ----------------------------------------------------------------------- */
+
+typedef struct intstr_arena_block_s *intstr_arena_block_t;
+
+struct intstr_arena_block_s {
+  intstr_arena_block_t prev;
+  size_t size;
+  size_t used;
+  char storage[];
+};
+
+typedef struct intstr_arena_block_s intstr_arena_block_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type intstr_mapping_t
+ * --------------------------------------------------------------------------
+ * pointer to record representing a snapshot file mapped into memory.
+ * Mappings are linked from the most recently mapped to the first.
+ * ----------------------------------------------------------------------- */
+
+typedef struct intstr_mapping_s *intstr_mapping_t;
+
+struct intstr_mapping_s {
+  intstr_mapping_t prev;
+  void *data;
+  size_t size;
+};
+
+typedef struct intstr_mapping_s intstr_mapping_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type intstr_shard_t
+ * --------------------------------------------------------------------------
+ * pointer to record representing a shard of the string repository.  Each
+ * shard holds its own bucket table,  arena and, in concurrent mode,  lock.
+ *
+ * While the table is being rehashed,  old_bucket holds the previous table,
+ * whose buckets below rehash_index have already been moved.  Otherwise
+ * old_bucket is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct intstr_shard_s *intstr_shard_t;
+
+struct intstr_shard_s {
+  uint_t entry_count;
+  uint_t bucket_count;
+  intstr_repo_entry_t *bucket;
+  uint_t old_bucket_count;
+  uint_t rehash_index;
+  intstr_repo_entry_t *old_bucket;
+  intstr_arena_block_t arena;
+  uint64_t lookup_hits;
+  uint64_t lookup_misses;
+#if (INTSTR_THREAD_SAFE)
+  pthread_mutex_t lock;
+#endif
+};
+
+typedef struct intstr_shard_s intstr_shard_s;
+
+
 /* --------------------------------------------------------------------------
  * private type intstr_repo_t
  * --------------------------------------------------------------------------
  * pointer to record representing the string repository.
+ *
+ * In arena mode, string objects and repository entries are carved from the
+ * blocks of the arena  and their reference counts are zero.  They are never
+ * deallocated individually but all at once when the repository is disposed.
+ *
+ * In concurrent mode,  the keys are distributed over a power-of-two number
+ * of shards,  each of which is locked while it is searched or extended.  A
+ * string is only ever stored in the shard its key maps to,  thus interned
+ * pointers remain canonical across threads.  Concurrent mode implies arena
+ * mode as reference counts could not otherwise be maintained safely.
  * ----------------------------------------------------------------------- */
 
 typedef struct intstr_repo_s *intstr_repo_t;
 
 struct intstr_repo_s {
-  uint_t entry_count;
-  uint_t bucket_count;
-  intstr_repo_entry_t bucket[];
+  bool use_arena;
+  bool concurrent;
+  size_t block_size;
+  intstr_mapping_t mapping;
+  uint_t shard_mask;
+  intstr_shard_s shard[];
 };
 
 typedef struct intstr_repo_s intstr_repo_s;
@@ -119,12 +295,37 @@ typedef struct intstr_repo_s intstr_repo_s;
 static intstr_repo_t repository = NULL;
 
 
+/* --------------------------------------------------------------------------
+ * private variable tag_handler
+ * --------------------------------------------------------------------------
+ * pointer to installed tag handler, or NULL if none is installed.
+ * ----------------------------------------------------------------------- */
+
+static intstr_tag_handler_t tag_handler = NULL;
+
+
+/* --------------------------------------------------------------------------
+ * private variable static_resolver
+ * --------------------------------------------------------------------------
+ * pointer to installed static resolver, or NULL if none is installed.
+ * ----------------------------------------------------------------------- */
+
+static intstr_static_resolver_t static_resolver = NULL;
+
+static void set_initial_tag (intstr_t str);
+
+static void init_repo
+  (uint_t size, bool use_arena, size_t block_size,
+   bool concurrent, uint_t shard_count, intstr_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * procedure intstr_init_repo(size, status)
  * --------------------------------------------------------------------------
  * Allocates and initialises global string repository.  Parameter size deter-
- * mines the  number of buckets  of the repository's internal hash table.  If
- * size is zero, value STRING_REPO_DEFAULT_BUCKET_COUNT is used.
+ * mines the initial number of buckets of the repository's internal hash table.
+ * If size is zero, value STRING_REPO_DEFAULT_BUCKET_COUNT is used.  The table
+ * grows incrementally as strings are added.
  *
  * pre-conditions:
  * o  global repository must be uninitialised upon entry
@@ -145,318 +346,686 @@ static intstr_repo_t repository = NULL;
 
 void intstr_init_repo (uint_t size, intstr_status_t *status) {
   
-  uint_t index, bucket_count, allocation_size;
+#if (INTSTR_IMMORTAL)
+  init_repo(size, true, INTSTR_ARENA_DEFAULT_BLOCK_SIZE, false, 1, status);
+#else
+  init_repo(size, false, 0, false, 1, status);
+#endif
+} /* end intstr_init_repo */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_init_arena_repo(size, block_size, status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises  the global string repository  in arena mode.
+ * Parameter size determines the number of buckets like intstr_init_repo.
+ * String objects and repository entries  are packed into blocks of at least
+ * block_size bytes.   If block_size is zero,  value
+ * INTSTR_ARENA_DEFAULT_BLOCK_SIZE is used.  Pre-, post- and error-conditions
+ * are those of procedure intstr_init_repo.
+ * ----------------------------------------------------------------------- */
+
+void intstr_init_arena_repo
+  (uint_t size, size_t block_size, intstr_status_t *status) {
   
-  /* check pre-conditions */
-  if (repository != NULL) {
-    SET_STATUS(status, INTSTR_STATUS_ALREADY_INITIALIZED);
-    return;
+  if (block_size == 0) {
+    block_size = INTSTR_ARENA_DEFAULT_BLOCK_SIZE;
   } /* end if */
   
-  /* determine bucket count */
-  if (size == 0) {
-    bucket_count = INTSTR_REPO_DEFAULT_BUCKET_COUNT;
+  init_repo(size, true, block_size, false, 1, status);
+} /* end intstr_init_arena_repo */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_init_concurrent_repo(size, shard_count, status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises the global string repository in concurrent mode
+ * with shard_count shards,  rounded up to a power of two.  If shard_count is
+ * zero, value INTSTR_REPO_DEFAULT_SHARD_COUNT is used.  Parameter size
+ * determines the initial number of buckets of each shard.  Pre-, post- and
+ * error-conditions are those of procedure intstr_init_repo,  in addition
+ * INTSTR_STATUS_NOT_SUPPORTED is passed back in status  if the library has
+ * been built without INTSTR_THREAD_SAFE.
+ * ----------------------------------------------------------------------- */
+
+void intstr_init_concurrent_repo
+  (uint_t size, uint_t shard_count, intstr_status_t *status) {
+  
+  uint_t count;
+  
+#if (INTSTR_THREAD_SAFE)
+  if (shard_count == 0) {
+    shard_count = INTSTR_REPO_DEFAULT_SHARD_COUNT;
   }
-  else /* size != 0 */ {
-    bucket_count = size;
+  else if (shard_count > INTSTR_REPO_MAX_SHARD_COUNT) {
+    shard_count = INTSTR_REPO_MAX_SHARD_COUNT;
   } /* end if */
   
-  /* allocate repository */
-  allocation_size = sizeof(intstr_repo_s) +
-    bucket_count * sizeof(intstr_repo_entry_t);
-  repository = malloc(allocation_size);
+  /* round up to power of two */
+  count = 1;
+  while (count < shard_count) {
+    count = 2 * count;
+  } /* end while */
+  
+  init_repo(size, true, INTSTR_ARENA_DEFAULT_BLOCK_SIZE, true, count, status);
+#else
+  (void) size; (void) shard_count; (void) count;
+  SET_STATUS(status, INTSTR_STATUS_NOT_SUPPORTED);
+#endif
+} /* end intstr_init_concurrent_repo */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_dispose_repo()
+ * --------------------------------------------------------------------------
+ * Deallocates the global string repository and all interned strings.  In
+ * arena mode all storage is released in one pass over the arena blocks.
+ * ----------------------------------------------------------------------- */
+
+static void free_arena_blocks (intstr_arena_block_t block);
+
+static void free_shard_entries (intstr_shard_t shard);
+
+static void unmap_snapshots (intstr_mapping_t mapping);
+
+void intstr_dispose_repo (void) {
+  
+  uint_t index;
+  intstr_shard_t shard;
   
-  /* bail out if allocation failed */
   if (repository == NULL) {
-    SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
     return;
   } /* end if */
   
-  /* set entry and bucket count */
-  repository->entry_count = 0;
-  repository->bucket_count = bucket_count;
+  for (index = 0; index <= repository->shard_mask; index++) {
+    shard = &repository->shard[index];
+    
+    if (repository->use_arena) {
+      free_arena_blocks(shard->arena);
+    }
+    else {
+      free_shard_entries(shard);
+    } /* end if */
+    
+    m2c_mem_free(M2C_MEM_INTSTR, shard->bucket);
+    m2c_mem_free(M2C_MEM_INTSTR, shard->old_bucket);
+    
+#if (INTSTR_THREAD_SAFE)
+    if (repository->concurrent) {
+      pthread_mutex_destroy(&shard->lock);
+    } /* end if */
+#endif
+  } /* end for */
+  
+  unmap_snapshots(repository->mapping);
   
-  /* initialise buckets */
-  index = 0;
-  while (index < bucket_count) {
-    repository->bucket[index] = NULL;
-    index++;
-  } /* end while */
+  m2c_mem_free(M2C_MEM_INTSTR, repository);
+  repository = NULL;
   
-  SET_STATUS(status, INTSTR_STATUS_SUCCESS);
   return;
-} /* end intstr_init_repo */
+} /* end intstr_dispose_repo */
 
 
 /* --------------------------------------------------------------------------
- * function intstr_for_cstr(str, status)
+ * Snapshot file format
  * --------------------------------------------------------------------------
- * Returns an interned string object for str which must be a pointer to a NUL
- * terminated character string.  
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- *
- * post-conditions:
- * o  if a string object for str is present in the internal repository,
- *    that string object is retrieved, retained and returned.
- * o  if no string object for str is present in the repository,
- *    a new string object with a copy of str is created, stored and returned.
- * o  INTSTR_STATUS_SUCCESS is passed back in status, unless NULL
- *
- * error-conditions:
- * o  if str is NULL upon entry, no operation is carried out,
- *    NULL is returned and INTSTR_STATUS_INVALID_REFERENCE is
- *    passed back in status unless status is NULL
- * o  if string object allocation failed, no operation is carried out,
- *    NULL is returned and INTSTR_STATUS_ALLOCATION_FAILED is
- *    passed back in status unless status is NULL
+ * A snapshot file consists of a header followed by count records.  Each
+ * record holds the hash key of a string,  padded to INTSTR_ARENA_ALIGNMENT,
+ * followed by the string object itself in its in-memory layout with its NUL
+ * terminator,  padded to INTSTR_ARENA_ALIGNMENT.  The data section is thus
+ * a valid arena block from which strings are used in place.  The string
+ * objects hold their hash key and tag,  all other fields are zero,  so that
+ * a mapped snapshot need not be written to when its strings are entered.
+ * The layout and probe fields reject snapshots written by builds with a
+ * different object layout or hash function.
  * ----------------------------------------------------------------------- */
 
-static intstr_t new_string_from_string (char *str, uint_t length);
-static intstr_repo_entry_t new_repo_entry (intstr_t str, intstr_hash_t key);
-static bool matches_str_and_len (intstr_t str, const char *cmpstr, uint_t length);
+#define INTSTR_SNAPSHOT_MAGIC "M2CINTS1"
 
-intstr_t intstr_for_cstr (const char *str, intstr_status_t *status) {
-  intstr_repo_entry_t new_entry, this_entry;
-  intstr_t new_string, this_string;
-  uint_t index, length;
-  intstr_hash_t key;
-  char ch;
+#define INTSTR_SNAPSHOT_PROBE "M2C"
+
+#define SNAPSHOT_KEY_SIZE ARENA_ROUND_UP(sizeof(intstr_hash_t))
+
+#define SNAPSHOT_RECORD_SIZE(_length) \
+  ARENA_ROUND_UP(SNAPSHOT_KEY_SIZE + sizeof(intstr_struct_t) + (_length) + 1)
+
+#define SNAPSHOT_MAX_DATA_SIZE \
+  ((uint64_t) (SIZE_MAX - sizeof(intstr_arena_block_s)))
+
+#define SNAPSHOT_LAYOUT \
+  ((uint32_t) sizeof(intstr_struct_t) | \
+   ((uint32_t) INTSTR_ARENA_ALIGNMENT << 8) | \
+   ((uint32_t) INTSTR_IMMORTAL << 16))
+
+typedef struct {
+  char magic[8];
+  uint32_t layout;
+  uint32_t probe;
+  uint32_t count;
+  uint32_t reserved;
+  uint64_t data_size;
+} intstr_snapshot_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_save_snapshot(path, status)
+ * --------------------------------------------------------------------------
+ * Writes all strings in the global string repository  to a snapshot file at
+ * path,  replacing any existing file.  Passes back INTSTR_STATUS_SUCCESS,
+ * or INTSTR_STATUS_NOT_INITIALIZED,  INTSTR_STATUS_INVALID_REFERENCE if path
+ * is NULL,  or INTSTR_STATUS_IO_ERROR if the file could not be written.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t snapshot_probe (void);
+
+static void snapshot_extent (uint32_t *count, uint64_t *data_size);
+
+static bool write_snapshot_records (FILE *file);
+
+void intstr_save_snapshot (const char *path, intstr_status_t *status) {
+  
+  intstr_snapshot_header_t header;
+  FILE *file;
+  bool ok;
   
   /* check repository */
   if (repository == NULL) {
     SET_STATUS(status, INTSTR_STATUS_NOT_INITIALIZED);
-    return NULL;
+    return;
   } /* end if */
   
-  /* check str */
-  if (str == NULL) {
+  /* check path */
+  if (path == NULL) {
     SET_STATUS(status, INTSTR_STATUS_INVALID_REFERENCE);
-    return NULL;
+    return;
   } /* end if */
-    
-  /* determine length and key */
-  index = 0;
-  ch = str[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = str[index];
-  } /* end while */
   
-  length = index + 1;
-  key = HASH_FINAL(key);
+  /* prepare header */
+  memset(&header, 0, sizeof(intstr_snapshot_header_t));
+  memcpy(header.magic, INTSTR_SNAPSHOT_MAGIC, 8);
+  header.layout = SNAPSHOT_LAYOUT;
+  header.probe = snapshot_probe();
+  snapshot_extent(&header.count, &header.data_size);
   
-  /* determine bucket index */
-  index = key % repository->bucket_count;
+  file = fopen(path, "wb");
   
-  /* check if str is already in repository */
-  if /* bucket empty */ (repository->bucket[index] == NULL) {
-    
-    /* create a new string object */
-    new_string = new_string_from_string(str, length);
-    
-    /* create a new repository entry */
-    new_entry = new_repo_entry(new_string, key);
-    
-    /* link the bucket to the new entry */
-    repository->bucket[index] = new_entry;
-    
-    /* update the entry counter */
-    repository->entry_count++;
-    
-    /* set status and return string object */
-    SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-    return new_string;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = repository->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          matches_str_and_len(this_entry->str, str, length)) {
-        
-        /* get string object of matching entry and retain it */
-        this_string = this_entry->str;
-        intstr_retain(this_string);
-        
-        /* set status and return string object */
-        SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-        return this_string;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new string object */
-        new_string = new_string_from_string(str, length);
-        
-        /* create a new repository entry */
-        new_entry = new_repo_entry(new_string, key);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        repository->entry_count++;
-        
-        /* set status and return string object */
-        SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-        return new_string;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */  
-} /* end intstr_for_cstr */
+  if (file == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  /* write header and records */
+  ok = (fwrite(&header, sizeof(intstr_snapshot_header_t), 1, file) == 1) &&
+       write_snapshot_records(file);
+  
+  if ((fclose(file) != 0) || NOT(ok)) {
+    remove(path);
+    SET_STATUS(status, INTSTR_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, INTSTR_STATUS_SUCCESS);
+  return;
+} /* end intstr_save_snapshot */
 
 
 /* --------------------------------------------------------------------------
- * function intstr_for_slice(str, offset, length, status)
+ * procedure intstr_load_snapshot(path, status)
  * --------------------------------------------------------------------------
- * Returns an interned string object for a given slice of str.  Parameter str
- * must be a pointer to a NUL terminated character string.  The position of
- * the first character of the slice is given by parameter offset and the
- * length of the slice is given by parameter length.
- *
- * pre-conditions:
- * o  parameter str must not be NULL upon entry
- * o  slice must be within range of str (NOT GUARDED),
- * o  slice must not contain any characters with code points < 32 or > 126 
- * 
- *
- * post-conditions:
- * o  if a string object for the slice is present in the internal repository,
- *    that string object is retrieved, retained and returned.
- * o  if no string object for the slice is present in the repository, a new
- *    string object with a copy of the slice is created, stored and returned.
- * o  INTSTR_STATUS_SUCCESS is passed back in status, unless NULL
- *
- * error-conditions:
- * o  if precondition #1 is not met, no operation is carried out,
- *    NULL is returned and INTSTR_STATUS_INVALID_REFERENCE is
- *    passed back in status, unless status is NULL
- * o  if precondition #3 is not met, no operation is carried out,
- *    NULL is returned and INTSTR_STATUS_INVALID_INDICES is
- *    passed back in status, unless status is NULL
- * o  if string object allocation failed, no operation is carried out,
- *    NULL is returned and INTSTR_STATUS_ALLOCATION_FAILED is
- *    passed back in status unless status is NULL
+ * Reads a snapshot file at path and adds its strings to the global string
+ * repository,  which must be in arena or concurrent mode.  Strings already
+ * present are kept.  The file is read into a single arena block  and its
+ * string objects are used in place,  only repository entries are allocated.
+ * Passes back INTSTR_STATUS_SUCCESS,  INTSTR_STATUS_NOT_INITIALIZED,
+ * INTSTR_STATUS_INVALID_REFERENCE if path is NULL,
+ * INTSTR_STATUS_NOT_SUPPORTED if the repository is not in arena mode,
+ * INTSTR_STATUS_IO_ERROR if the file could not be opened,
+ * INTSTR_STATUS_INVALID_SNAPSHOT if its contents are not a snapshot of this
+ * build,  or INTSTR_STATUS_ALLOCATION_FAILED.  Must not be called while
+ * other threads are interning strings.
  * ----------------------------------------------------------------------- */
 
-static intstr_t new_string_from_slice (char *str, uint_t offset, uint_t length);
+static intstr_arena_block_t new_arena_block (size_t size);
 
-intstr_t intstr_for_slice
-  (const char *str, uint_t offset, uint_t length, intstr_status_t *status) {
+static void link_full_block
+  (intstr_shard_t shard, intstr_arena_block_t block);
+
+static bool is_valid_snapshot_header
+  (const intstr_snapshot_header_t *header);
+
+static void insert_snapshot_records
+  (char *data, size_t size, uint32_t count, intstr_status_t *status);
+
+void intstr_load_snapshot (const char *path, intstr_status_t *status) {
   
-  intstr_repo_entry_t new_entry, this_entry;
-  intstr_t new_string, this_string;
-  uint_t index;
-  intstr_hash_t key;
-  char ch;
+  intstr_snapshot_header_t header;
+  intstr_arena_block_t block;
+  FILE *file;
   
   /* check repository */
   if (repository == NULL) {
     SET_STATUS(status, INTSTR_STATUS_NOT_INITIALIZED);
-    return NULL;
+    return;
   } /* end if */
   
-  /* check str */
-  if (str == NULL) {
+  /* check path */
+  if (path == NULL) {
     SET_STATUS(status, INTSTR_STATUS_INVALID_REFERENCE);
-    return NULL;
+    return;
   } /* end if */
   
-  /* determine key for slice */
-  index = offset;
-  key = HASH_INITIAL;
-  while (index < length) {
-    ch = str[index];
-    /* bail out if any control codes are found */
-    if (IS_CONTROL_CHAR(ch)) {
-      SET_STATUS(status, INTSTR_STATUS_INVALID_INDICES);
-      return NULL;
-    } /* end if */
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-  } /* end while */
+  /* snapshot strings cannot be deallocated individually */
+  if (NOT(repository->use_arena)) {
+    SET_STATUS(status, INTSTR_STATUS_NOT_SUPPORTED);
+    return;
+  } /* end if */
   
-  key = HASH_FINAL(key);
+  file = fopen(path, "rb");
   
-  /* determine bucket index */
-  index = key % repository->bucket_count;
+  if (file == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_IO_ERROR);
+    return;
+  } /* end if */
   
-  /* check if str is already in repository */
-  if /* bucket empty */ (repository->bucket[index] == NULL) {
-    
-    /* create a new string object */
-    new_string = new_string_from_slice(str, offset, length);
+  /* read and verify header */
+  if (fread(&header, sizeof(intstr_snapshot_header_t), 1, file) != 1) {
+    fclose(file);
+    SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+    return;
+  } /* end if */
+  
+  if (NOT(is_valid_snapshot_header(&header))) {
+    fclose(file);
+    SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+    return;
+  } /* end if */
+  
+  /* read data section into an arena block */
+  block = new_arena_block((size_t) header.data_size);
+  
+  if (block == NULL) {
+    fclose(file);
+    SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  if (fread(block->storage, 1, block->size, file) != block->size) {
+    fclose(file);
+    m2c_mem_free(M2C_MEM_INTSTR, block);
+    SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+    return;
+  } /* end if */
+  
+  fclose(file);
+  
+  /* the block is owned by the first shard from here on */
+  block->used = block->size;
+  link_full_block(&repository->shard[0], block);
+  
+  /* enter records into the repository */
+  insert_snapshot_records(block->storage, block->size, header.count, status);
+  
+  return;
+} /* end intstr_load_snapshot */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_map_snapshot(path, status)
+ * --------------------------------------------------------------------------
+ * Maps a snapshot file at path into memory  and adds its strings to the
+ * global string repository,  which must be in arena or concurrent mode.  The
+ * string objects are used in place within the mapping.  Passes back the
+ * status codes of intstr_load_snapshot.  Loads the file where mmap() is not
+ * available.
+ * ----------------------------------------------------------------------- */
+
+void intstr_map_snapshot (const char *path, intstr_status_t *status) {
+  
+#if (INTSTR_SNAPSHOT_USE_MMAP)
+  intstr_snapshot_header_t header;
+  intstr_mapping_t mapping;
+  struct stat info;
+  void *map;
+  int fd;
+  
+  /* check repository */
+  if (repository == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_NOT_INITIALIZED);
+    return;
+  } /* end if */
+  
+  /* check path */
+  if (path == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* mapped strings cannot be deallocated individually */
+  if (NOT(repository->use_arena)) {
+    SET_STATUS(status, INTSTR_STATUS_NOT_SUPPORTED);
+    return;
+  } /* end if */
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    SET_STATUS(status, INTSTR_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) ||
+      ((uint64_t) info.st_size < sizeof(intstr_snapshot_header_t))) {
+    close(fd);
+    SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+    return;
+  } /* end if */
+  
+  mapping = m2c_mem_alloc(M2C_MEM_INTSTR, sizeof(intstr_mapping_s));
+  
+  if (mapping == NULL) {
+    close(fd);
+    SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* private,  thus a write copies only the page written to */
+  map = mmap(NULL, (size_t) info.st_size,
+    PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    m2c_mem_free(M2C_MEM_INTSTR, mapping);
+    SET_STATUS(status, INTSTR_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  /* verify header and size */
+  memcpy(&header, map, sizeof(intstr_snapshot_header_t));
+  
+  if (NOT(is_valid_snapshot_header(&header)) ||
+      (header.data_size !=
+       (uint64_t) info.st_size - sizeof(intstr_snapshot_header_t))) {
+    munmap(map, (size_t) info.st_size);
+    m2c_mem_free(M2C_MEM_INTSTR, mapping);
+    SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+    return;
+  } /* end if */
+  
+  /* the mapping is owned by the repository from here on */
+  mapping->data = map;
+  mapping->size = (size_t) info.st_size;
+  mapping->prev = repository->mapping;
+  repository->mapping = mapping;
+  
+  /* enter records into the repository */
+  insert_snapshot_records((char *) map + sizeof(intstr_snapshot_header_t),
+    (size_t) header.data_size, header.count, status);
+  
+  return;
+#else
+  intstr_load_snapshot(path, status);
+#endif
+} /* end intstr_map_snapshot */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure init_repo(size, use_arena, block_size, concurrent, ...)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises global string repository in the given mode with
+ * shard_count shards,  which must be a power of two.
+ * ----------------------------------------------------------------------- */
+
+static void init_repo
+  (uint_t size, bool use_arena, size_t block_size,
+   bool concurrent, uint_t shard_count, intstr_status_t *status) {
+  
+  uint_t index, bucket_count, shard_index;
+  intstr_shard_t shard;
+  
+  /* check pre-conditions */
+  if (repository != NULL) {
+    SET_STATUS(status, INTSTR_STATUS_ALREADY_INITIALIZED);
+    return;
+  } /* end if */
+  
+  /* determine bucket count */
+  if (size == 0) {
+    bucket_count = INTSTR_REPO_DEFAULT_BUCKET_COUNT;
+  }
+  else /* size != 0 */ {
+    bucket_count = size;
+  } /* end if */
+  
+  /* allocate repository with its shards */
+  repository =
+    m2c_mem_alloc(M2C_MEM_INTSTR,
+      sizeof(intstr_repo_s) + shard_count * sizeof(intstr_shard_s));
+  
+  /* bail out if allocation failed */
+  if (repository == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* set allocation mode */
+  repository->use_arena = use_arena;
+  repository->concurrent = concurrent;
+  repository->block_size = block_size;
+  repository->mapping = NULL;
+  repository->shard_mask = shard_count - 1;
+  
+  /* initialise shards */
+  for (shard_index = 0; shard_index < shard_count; shard_index++) {
+    shard = &repository->shard[shard_index];
+    shard->entry_count = 0;
+    shard->lookup_hits = 0;
+    shard->lookup_misses = 0;
+    shard->bucket_count = bucket_count;
+    shard->old_bucket_count = 0;
+    shard->rehash_index = 0;
+    shard->old_bucket = NULL;
+    shard->arena = NULL;
+    shard->bucket = m2c_mem_alloc(M2C_MEM_INTSTR,
+      bucket_count * sizeof(intstr_repo_entry_t));
     
-    /* create a new repository entry */
-    new_entry = new_repo_entry(new_string, key);
+    if (shard->bucket == NULL) {
+      /* deallocate shards initialised so far */
+      repository->shard_mask = shard_index - 1;
+      while (shard_index > 0) {
+        shard_index--;
+        m2c_mem_free(M2C_MEM_INTSTR, repository->shard[shard_index].bucket);
+#if (INTSTR_THREAD_SAFE)
+        if (concurrent) {
+          pthread_mutex_destroy(&repository->shard[shard_index].lock);
+        } /* end if */
+#endif
+      } /* end while */
+      
+      m2c_mem_free(M2C_MEM_INTSTR, repository);
+      repository = NULL;
+      SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
     
-    /* link the bucket to the new entry */
-    repository->bucket[index] = new_entry;
+    /* initialise buckets */
+    index = 0;
+    while (index < bucket_count) {
+      shard->bucket[index] = NULL;
+      index++;
+    } /* end while */
     
-    /* update the entry counter */
-    repository->entry_count++;
+#if (INTSTR_THREAD_SAFE)
+    if (concurrent) {
+      pthread_mutex_init(&shard->lock, NULL);
+    } /* end if */
+#endif
+  } /* end for */
+  
+  SET_STATUS(status, INTSTR_STATUS_SUCCESS);
+  return;
+} /* end init_repo */
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_for_cstr(str, status)
+ * --------------------------------------------------------------------------
+ * Returns an interned string object for str which must be a pointer to a NUL
+ * terminated character string.  
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  if a string object for str is present in the internal repository,
+ *    that string object is retrieved, retained and returned.
+ * o  if no string object for str is present in the repository,
+ *    a new string object with a copy of str is created, stored and returned.
+ * o  INTSTR_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_INVALID_REFERENCE is
+ *    passed back in status unless status is NULL
+ * o  if string object allocation failed, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_ALLOCATION_FAILED is
+ *    passed back in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+static intstr_t intern_string
+  (intstr_hash_t key, const char *str1, uint_t len1,
+   const char *str2, uint_t len2, intstr_status_t *status);
+
+intstr_t intstr_for_cstr (const char *str, intstr_status_t *status) {
+  
+  uint_t index, length;
+  intstr_hash_t key;
+  char ch;
+  
+  /* check repository */
+  if (repository == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_NOT_INITIALIZED);
+    return NULL;
+  } /* end if */
+  
+  /* check str */
+  if (str == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
     
-    /* set status and return string object */
-    SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-    return new_string;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = repository->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          matches_str_and_len(this_entry->str, str, length)) {
-        
-        /* get string object of matching entry and retain it */
-        this_string = this_entry->str;
-        intstr_retain(this_string);
-        
-        /* set status and return string object */
-        SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-        return this_string;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new string object */
-        new_string = new_string_from_slice(str, offset, length);
-        
-        /* create a new repository entry */
-        new_entry = new_repo_entry(new_string, key);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        repository->entry_count++;
-        
-        /* set status and return string object */
-        SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-        return new_string;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */  
+  /* determine length and key */
+  index = 0;
+  ch = str[index];
+  key = HASH_INITIAL;
+  while (ch != ASCII_NUL) {
+    key = HASH_NEXT_CHAR(key, ch);
+    index++;
+    ch = str[index];
+  } /* end while */
+  
+  length = index;
+  key = HASH_FINAL(key);
+  
+  /* look up or create, tag and store string object */
+  return intern_string(key, str, length, NULL, 0, status);
+} /* end intstr_for_cstr */
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_for_slice(str, offset, length, status)
+ * --------------------------------------------------------------------------
+ * Returns an interned string object for a given slice of str.  Parameter str
+ * must be a pointer to a NUL terminated character string.  The position of
+ * the first character of the slice is given by parameter offset and the
+ * length of the slice is given by parameter length.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ * o  slice must be within range of str (NOT GUARDED),
+ * o  slice must not contain any characters with code points < 32 or > 126 
+ * 
+ *
+ * post-conditions:
+ * o  if a string object for the slice is present in the internal repository,
+ *    that string object is retrieved, retained and returned.
+ * o  if no string object for the slice is present in the repository, a new
+ *    string object with a copy of the slice is created, stored and returned.
+ * o  INTSTR_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if precondition #1 is not met, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_INVALID_REFERENCE is
+ *    passed back in status, unless status is NULL
+ * o  if precondition #3 is not met, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_INVALID_INDICES is
+ *    passed back in status, unless status is NULL
+ * o  if string object allocation failed, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_ALLOCATION_FAILED is
+ *    passed back in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+intstr_t intstr_for_slice
+  (const char *str, uint_t offset, uint_t length, intstr_status_t *status) {
+  
+  uint_t index;
+  intstr_hash_t key;
+  char ch;
+  
+  /* check str */
+  if (str == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  /* determine key for slice */
+  index = offset;
+  key = HASH_INITIAL;
+  while (index < offset + length) {
+    ch = str[index];
+    /* bail out if any control codes are found */
+    if (IS_CONTROL_CHAR(ch)) {
+      SET_STATUS(status, INTSTR_STATUS_INVALID_INDICES);
+      return NULL;
+    } /* end if */
+    key = HASH_NEXT_CHAR(key, ch);
+    index++;
+  } /* end while */
+  
+  key = HASH_FINAL(key);
+  
+  return intstr_for_slice_with_hash(str, offset, length, key, status);
 } /* end intstr_for_slice */
 
 
+/* --------------------------------------------------------------------------
+ * function intstr_for_slice_with_hash(str, offset, length, key, status)
+ * --------------------------------------------------------------------------
+ * Returns an interned string object for a given slice of str  like function
+ * intstr_for_slice,  but uses  the precomputed hash key  instead of hashing
+ * the slice.
+ * ----------------------------------------------------------------------- */
+
+intstr_t intstr_for_slice_with_hash
+  (const char *str, uint_t offset, uint_t length,
+   intstr_hash_t key, intstr_status_t *status) {
+  
+  /* check repository */
+  if (repository == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_NOT_INITIALIZED);
+    return NULL;
+  } /* end if */
+  
+  /* check str */
+  if (str == NULL) {
+    SET_STATUS(status, INTSTR_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  /* look up or create, tag and store string object */
+  return intern_string(key, &str[offset], length, NULL, 0, status);
+} /* end intstr_for_slice_with_hash */
+
+
 
 /* --------------------------------------------------------------------------
  * function intstr_for_concatenation(str, append_str, status)
@@ -487,15 +1056,10 @@ intstr_t intstr_for_slice
  *    unless NULL
  * ----------------------------------------------------------------------- */
 
-static intstr_t new_string_by_appending
-  (char *str, char *append_str, uint_t str_len, uint_t append_str_len);
-
 intstr_t intstr_for_concatenation
   (const char *str, const char *append_str, intstr_status_t *status) {
   
-  intstr_repo_entry_t new_entry, this_entry;
-  intstr_t new_string, this_string;
-  uint_t index, length, str_len, append_str_len;
+  uint_t index, str_len, append_str_len;
   intstr_hash_t key;
   char ch;
   
@@ -521,91 +1085,24 @@ intstr_t intstr_for_concatenation
     ch = str[index];
   } /* end while */
   
-  str_len = index + 1;
+  str_len = index;
   
-  /* determine key and length of append_str */
+  /* continue key with append_str and determine its length */
   index = 0;
   ch = append_str[index];
-  key = HASH_INITIAL;
   while (ch != ASCII_NUL) {
     key = HASH_NEXT_CHAR(key, ch);
     index++;
     ch = append_str[index];
   } /* end while */
   
-  append_str_len = index + 1;
+  append_str_len = index;
   
-  /* finalise length and key of concatenation */
-  length = str_len + append_str_len;
+  /* finalise key of concatenation */
   key = HASH_FINAL(key);
   
-  /* determine bucket index */
-  index = key % repository->bucket_count;
-  
-  /* check if str is already in repository */
-  if /* bucket empty */ (repository->bucket[index] == NULL) {
-    
-    /* create a new string object */
-    new_string =
-      new_string_by_appending(str, append_str, str_len, append_str_len);
-    
-    /* create a new repository entry */
-    new_entry = new_repo_entry(new_string, key);
-    
-    /* link the bucket to the new entry */
-    repository->bucket[index] = new_entry;
-    
-    /* update the entry counter */
-    repository->entry_count++;
-    
-    /* set status and return string object */
-    SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-    return new_string;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = repository->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          matches_str_and_len(this_entry->str, str, length)) {
-        
-        /* get string object of matching entry and retain it */
-        this_string = this_entry->str;
-        intstr_retain(this_string);
-        
-        /* set status and return string object */
-        SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-        return this_string;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new string object */
-        new_string =
-          new_string_by_appending(str, append_str, str_len, append_str_len);
-        
-        /* create a new repository entry */
-        new_entry = new_repo_entry(new_string, key);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        repository->entry_count++;
-        
-        /* set status and return string object */
-        SET_STATUS(status, INTSTR_STATUS_SUCCESS);
-        return new_string;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */  
+  /* look up or create, tag and store string object */
+  return intern_string(key, str, str_len, append_str, append_str_len, status);
 } /* end intstr_for_concatenation */
 
 
@@ -660,6 +1157,165 @@ const char *intstr_char_ptr (intstr_t str) {
 } /* end intstr_char_ptr */
 
 
+/* --------------------------------------------------------------------------
+ * function intstr_hash(str)
+ * --------------------------------------------------------------------------
+ * Returns the hash key str was interned with.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the hash key cached in str when it was interned is returned
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, zero is returned
+ * ----------------------------------------------------------------------- */
+
+intstr_hash_t intstr_hash (intstr_t str) {
+  
+  if (str == NULL) {
+    return 0;
+  } /* end if */
+  
+  return str->key;
+} /* end intstr_hash */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_install_tag_handler(handler)
+ * --------------------------------------------------------------------------
+ * Installs handler  as the tag handler  that is called once for every newly
+ * interned string to calculate its classification tag.
+ * ----------------------------------------------------------------------- */
+
+void intstr_install_tag_handler (intstr_tag_handler_t handler) {
+  
+  tag_handler = handler;
+} /* end intstr_install_tag_handler */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_install_static_resolver(resolver)
+ * --------------------------------------------------------------------------
+ * Installs resolver  as the static resolver  that is consulted  before the
+ * repository whenever a short string is interned.
+ * ----------------------------------------------------------------------- */
+
+void intstr_install_static_resolver (intstr_static_resolver_t resolver) {
+  
+  static_resolver = resolver;
+} /* end intstr_install_static_resolver */
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_tag(str)
+ * --------------------------------------------------------------------------
+ * Returns the classification tag of str.  Strings interned before the tag
+ * handler was installed are tagged on the first call,  under the lock of
+ * the shard that holds them,  as they would have been when interned.
+ * ----------------------------------------------------------------------- */
+
+static intstr_shard_t shard_for_key (intstr_hash_t key);
+
+static void lock_shard (intstr_shard_t shard);
+
+static void unlock_shard (intstr_shard_t shard);
+
+uint_t intstr_tag (intstr_t str) {
+  
+  uint_t tag;
+  intstr_shard_t shard;
+  
+  if (str == NULL) {
+    return INTSTR_TAG_NONE;
+  } /* end if */
+  
+  tag = FIELD_LOAD(str->tag);
+  
+  if ((tag == INTSTR_TAG_UNKNOWN) && (tag_handler != NULL) &&
+      (repository != NULL)) {
+    shard = shard_for_key(str->key);
+    lock_shard(shard);
+    
+    /* another thread may have tagged str meanwhile */
+    tag = FIELD_LOAD(str->tag);
+    if (tag == INTSTR_TAG_UNKNOWN) {
+      tag = tag_handler(str->char_array, str->length);
+      FIELD_STORE(str->tag, tag);
+    } /* end if */
+    
+    unlock_shard(shard);
+  } /* end if */
+  
+  return tag;
+} /* end intstr_tag */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_set_flags(str, flags)
+ * --------------------------------------------------------------------------
+ * Stores client flags in str,  replacing any previous flags.
+ * ----------------------------------------------------------------------- */
+
+void intstr_set_flags (intstr_t str, uint_t flags) {
+  
+  if (str == NULL) {
+    return;
+  } /* end if */
+  
+  FIELD_STORE(str->flags, flags);
+} /* end intstr_set_flags */
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_flags(str)
+ * --------------------------------------------------------------------------
+ * Returns the client flags stored in str,  or zero if str is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t intstr_flags (intstr_t str) {
+  
+  if (str == NULL) {
+    return 0;
+  } /* end if */
+  
+  return FIELD_LOAD(str->flags);
+} /* end intstr_flags */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_set_xlat(str, xlat)
+ * --------------------------------------------------------------------------
+ * Stores translation xlat in str,  replacing any previous translation.
+ * ----------------------------------------------------------------------- */
+
+void intstr_set_xlat (intstr_t str, const char *xlat) {
+  
+  if (str == NULL) {
+    return;
+  } /* end if */
+  
+  FIELD_STORE_RELEASE(str->xlat, xlat);
+} /* end intstr_set_xlat */
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_xlat(str)
+ * --------------------------------------------------------------------------
+ * Returns the translation stored in str,  or NULL if none is stored.
+ * ----------------------------------------------------------------------- */
+
+const char *intstr_xlat (intstr_t str) {
+  
+  if (str == NULL) {
+    return NULL;
+  } /* end if */
+  
+  return FIELD_LOAD_ACQUIRE(str->xlat);
+} /* end intstr_xlat */
+
+
 /* --------------------------------------------------------------------------
  * function intstr_count()
  * --------------------------------------------------------------------------
@@ -675,20 +1331,147 @@ const char *intstr_char_ptr (intstr_t str) {
  * o  none
  * ----------------------------------------------------------------------- */
 
+static void lock_shard (intstr_shard_t shard);
+
+static void unlock_shard (intstr_shard_t shard);
+
 uint_t intstr_count (void) {
   
   if (repository == NULL) {
     return 0;
   } /* end if */
   
-  return repository->entry_count;
+  intstr_shard_t shard;
+  uint_t index, count;
+  
+  count = 0;
+  for (index = 0; index <= repository->shard_mask; index++) {
+    shard = &repository->shard[index];
+    lock_shard(shard);
+    count = count + shard->entry_count;
+    unlock_shard(shard);
+  } /* end for */
+  
+  return count;
 } /* end intstr_count */
 
 
+/* --------------------------------------------------------------------------
+ * procedure intstr_stats(stats)
+ * --------------------------------------------------------------------------
+ * Passes back statistics of the string repository in stats.
+ * ----------------------------------------------------------------------- */
+
+static void add_table_stats
+  (intstr_stats_t *stats, intstr_repo_entry_t *bucket, uint_t count);
+
+void intstr_stats (intstr_stats_t *stats) {
+  
+  intstr_shard_t shard;
+  intstr_arena_block_t block;
+  uint_t index;
+  
+  if (stats == NULL) {
+    return;
+  } /* end if */
+  
+  memset(stats, 0, sizeof(intstr_stats_t));
+  
+  if (repository == NULL) {
+    return;
+  } /* end if */
+  
+  stats->shard_count = repository->shard_mask + 1;
+  
+  for (index = 0; index <= repository->shard_mask; index++) {
+    shard = &repository->shard[index];
+    lock_shard(shard);
+    
+    stats->entry_count = stats->entry_count + shard->entry_count;
+    stats->lookup_hits = stats->lookup_hits + shard->lookup_hits;
+    stats->lookup_misses = stats->lookup_misses + shard->lookup_misses;
+    
+    add_table_stats(stats, shard->bucket, shard->bucket_count);
+    add_table_stats(stats, shard->old_bucket, shard->old_bucket_count);
+    
+    for (block = shard->arena; block != NULL; block = block->prev) {
+      stats->arena_bytes =
+        stats->arena_bytes + sizeof(intstr_arena_block_s) + block->size;
+    } /* end for */
+    
+    unlock_shard(shard);
+  } /* end for */
+  
+  stats->entry_bytes = stats->entry_count * sizeof(intstr_repo_entry_s);
+  
+  stats->total_bytes = sizeof(intstr_repo_s) +
+    stats->shard_count * sizeof(intstr_shard_s) + stats->table_bytes;
+  
+  if (repository->use_arena) {
+    stats->total_bytes = stats->total_bytes + stats->arena_bytes;
+  }
+  else {
+    stats->total_bytes =
+      stats->total_bytes + stats->string_bytes + stats->entry_bytes;
+  } /* end if */
+  
+  return;
+} /* end intstr_stats */
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_print_stats(out)
+ * --------------------------------------------------------------------------
+ * Prints a report of the statistics of the string repository to out.
+ * ----------------------------------------------------------------------- */
+
+void intstr_print_stats (FILE *out) {
+  
+  intstr_stats_t stats;
+  uint64_t lookups;
+  uint_t index;
+  
+  intstr_stats(&stats);
+  lookups = stats.lookup_hits + stats.lookup_misses;
+  
+  fprintf(out, "interned strings:\n");
+  fprintf(out, "  entries          %u\n", stats.entry_count);
+  fprintf(out, "  shards           %u\n", stats.shard_count);
+  fprintf(out, "  buckets          %u (%u used, %.1f%%)\n",
+    stats.bucket_count, stats.used_bucket_count,
+    (stats.bucket_count > 0) ?
+      100.0 * stats.used_bucket_count / stats.bucket_count : 0.0);
+  fprintf(out, "  load factor      %.2f\n",
+    (stats.bucket_count > 0) ?
+      (double) stats.entry_count / stats.bucket_count : 0.0);
+  fprintf(out, "  longest chain    %u\n", stats.max_chain_length);
+  
+  fprintf(out, "  chain lengths   ");
+  for (index = 0; index < INTSTR_STATS_CHAIN_BINS; index++) {
+    fprintf(out, " %u%s:%u", index,
+      (index == INTSTR_STATS_CHAIN_BINS - 1) ? "+" : "",
+      stats.chain_histogram[index]);
+  } /* end for */
+  fprintf(out, "\n");
+  
+  fprintf(out, "  lookups          %llu (%llu hits, %.1f%%)\n",
+    (unsigned long long) lookups, (unsigned long long) stats.lookup_hits,
+    (lookups > 0) ? 100.0 * stats.lookup_hits / lookups : 0.0);
+  fprintf(out, "  string bytes     %lu\n", (unsigned long) stats.string_bytes);
+  fprintf(out, "  entry bytes      %lu\n", (unsigned long) stats.entry_bytes);
+  fprintf(out, "  table bytes      %lu\n", (unsigned long) stats.table_bytes);
+  fprintf(out, "  arena bytes      %lu\n", (unsigned long) stats.arena_bytes);
+  fprintf(out, "  total bytes      %lu\n", (unsigned long) stats.total_bytes);
+  
+  return;
+} /* end intstr_print_stats */
+
+
 /* --------------------------------------------------------------------------
  * function intstr_retain(str)
  * --------------------------------------------------------------------------
- * Prevents str from deallocation.
+ * Prevents str from deallocation.  Has no effect on strings interned in
+ * arena or concurrent mode.
  *
  * pre-conditions:
  * o  parameter str must not be NULL upon entry
@@ -700,11 +1483,15 @@ uint_t intstr_count (void) {
  * o  if str is not NULL upon entry, no operation is carried out
  * ----------------------------------------------------------------------- */
 
-void intstr_retain (intstr_t str) {
+void (intstr_retain) (intstr_t str) {
   
+#if (INTSTR_IMMORTAL)
+  (void) str;
+#else
   if ((str != NULL) && (str->ref_count > 0)) {
     str->ref_count++;
   } /* end if */
+#endif
   
 } /* end intstr_retain */
 
@@ -713,7 +1500,8 @@ void intstr_retain (intstr_t str) {
  * function intstr_release(str)
  * --------------------------------------------------------------------------
  * Cancels an outstanding retain, or deallocates str if there are no
- * outstanding retains.
+ * outstanding retains.  Has no effect on strings interned in arena or
+ * concurrent mode.
  *
  * pre-conditions:
  * o  parameter str must not be NULL upon entry
@@ -726,11 +1514,16 @@ void intstr_retain (intstr_t str) {
  * o  if str is not NULL upon entry, no operation is carried out
  * ----------------------------------------------------------------------- */
 
-static m2c_hash_t key_for_string (intstr_t str);
+#if !(INTSTR_IMMORTAL)
+static void remove_repo_entry (intstr_t str, intstr_hash_t key);
+#endif
 
-void intstr_release (intstr_t str) {
+void (intstr_release) (intstr_t str) {
   
-  m2c_hash_t key;
+#if (INTSTR_IMMORTAL)
+  (void) str;
+#else
+  intstr_hash_t key;
   
   if (str == NULL) {
     return;
@@ -745,10 +1538,11 @@ void intstr_release (intstr_t str) {
   }
   else if (str->ref_count == 1) {
     /* remove and deallocate */
-    printf("* deallocating string '%s' (%p)\n", intstr_char_ptr(str), str);
+    /* printf("* deallocating string '%s' (%p)\n",
+      intstr_char_ptr(str), str); */
     
     /* remove from repo */
-    key = key_for_string(str);
+    key = str->key;
     remove_repo_entry(str, key);
     
     /* reset */
@@ -757,8 +1551,9 @@ void intstr_release (intstr_t str) {
     str->char_array[0] = ASCII_NUL;
     
     /* deallocate */
-    free(str);
+    m2c_mem_free(M2C_MEM_INTSTR, str);
   } /* end if */
+#endif
 } /* end intstr_release */
 
 
@@ -767,9 +1562,1058 @@ void intstr_release (intstr_t str) {
  * *********************************************************************** */
 
 
-/* TO DO */
+/* --------------------------------------------------------------------------
+ * private procedure set_initial_tag(str)
+ * --------------------------------------------------------------------------
+ * Sets the tag of newly interned string str  using the installed tag hand-
+ * ler,  or to INTSTR_TAG_UNKNOWN if no tag handler is installed.
+ * ----------------------------------------------------------------------- */
+
+static uint_t initial_tag (const char *str, uint_t length);
+
+static void set_initial_tag (intstr_t str) {
+  
+  if (str == NULL) {
+    return;
+  } /* end if */
+  
+  str->tag = initial_tag(str->char_array, str->length);
+} /* end set_initial_tag */
+
+
+/* --------------------------------------------------------------------------
+ * private function initial_tag(str, length)
+ * --------------------------------------------------------------------------
+ * Returns the tag of a newly interned string of length characters at str
+ * as calculated by the installed tag handler,  or INTSTR_TAG_UNKNOWN if no
+ * tag handler is installed.
+ * ----------------------------------------------------------------------- */
+
+static uint_t initial_tag (const char *str, uint_t length) {
+  
+  if (tag_handler != NULL) {
+    return tag_handler(str, length);
+  }
+  else {
+    return INTSTR_TAG_UNKNOWN;
+  } /* end if */
+} /* end initial_tag */
+
+
+/* --------------------------------------------------------------------------
+ * private function intern_string(key, str1, len1, str2, len2, status)
+ * --------------------------------------------------------------------------
+ * Returns the interned string object for the concatenation of str1 and str2
+ * of length len1 and len2 with key.  If it is present in the repository,  it
+ * is retained and returned,  otherwise a new string object is created,
+ * tagged and stored.  The shard for key is locked throughout in concurrent
+ * mode.  A single string is interned by passing zero in len2.
+ * ----------------------------------------------------------------------- */
+
+static intstr_shard_t shard_for_key (intstr_hash_t key);
+
+static intstr_t lookup_string
+  (intstr_shard_t shard, intstr_hash_t key, const char *str1, uint_t len1,
+   const char *str2, uint_t len2);
+
+static intstr_t new_string
+  (intstr_shard_t shard, const char *str1, uint_t len1,
+   const char *str2, uint_t len2);
+
+static bool store_string
+  (intstr_shard_t shard, intstr_t str, intstr_hash_t key);
+
+static intstr_t resolve_static_string
+  (intstr_hash_t key, const char *str1, uint_t len1,
+   const char *str2, uint_t len2);
+
+static intstr_t intern_string
+  (intstr_hash_t key, const char *str1, uint_t len1,
+   const char *str2, uint_t len2, intstr_status_t *status) {
+  
+  intstr_shard_t shard;
+  intstr_t this_string;
+  
+  /* return static string object if the resolver has one */
+  if ((static_resolver != NULL) &&
+      (len1 + len2 <= INTSTR_STATIC_SIZE_LIMIT)) {
+    this_string = resolve_static_string(key, str1, len1, str2, len2);
+    
+    if (this_string != NULL) {
+      SET_STATUS(status, INTSTR_STATUS_SUCCESS);
+      return this_string;
+    } /* end if */
+  } /* end if */
+  
+  shard = shard_for_key(key);
+  lock_shard(shard);
+  
+  /* return existing string object if already in repository */
+  this_string = lookup_string(shard, key, str1, len1, str2, len2);
+  
+  if (this_string != NULL) {
+    shard->lookup_hits++;
+    unlock_shard(shard);
+    intstr_retain(this_string);
+    SET_STATUS(status, INTSTR_STATUS_SUCCESS);
+    return this_string;
+  } /* end if */
+  
+  shard->lookup_misses++;
+  
+  /* create and tag a new string object */
+  this_string = new_string(shard, str1, len1, str2, len2);
+  set_initial_tag(this_string);
+  
+  /* store it in the repository */
+  if (NOT(store_string(shard, this_string, key))) {
+    unlock_shard(shard);
+    SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  unlock_shard(shard);
+  
+  /* set status and return string object */
+  SET_STATUS(status, INTSTR_STATUS_SUCCESS);
+  return this_string;
+} /* end intern_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function resolve_static_string(key, str1, len1, str2, len2)
+ * --------------------------------------------------------------------------
+ * Returns the static string object  the installed resolver  returns for the
+ * concatenation of str1 and str2,  or NULL if there is none.  The combined
+ * length must not exceed INTSTR_STATIC_SIZE_LIMIT.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t resolve_static_string
+  (intstr_hash_t key, const char *str1, uint_t len1,
+   const char *str2, uint_t len2) {
+  
+  char buffer[INTSTR_STATIC_SIZE_LIMIT + 1];
+  
+  if (len2 == 0) {
+    return static_resolver(str1, len1, key);
+  } /* end if */
+  
+  memcpy(buffer, str1, len1);
+  memcpy(buffer + len1, str2, len2);
+  buffer[len1 + len2] = ASCII_NUL;
+  
+  return static_resolver(buffer, len1 + len2, key);
+} /* end resolve_static_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function shard_for_key(key)
+ * --------------------------------------------------------------------------
+ * Returns the shard in which strings with key are stored.  The key is mixed
+ * first as the low bits of the key also select the bucket within the shard.
+ * ----------------------------------------------------------------------- */
+
+static intstr_shard_t shard_for_key (intstr_hash_t key) {
+  
+  uint32_t mixed;
+  
+  mixed = ((uint32_t) key * 0x9E3779B1u) >> 16;
+  
+  return &repository->shard[mixed & repository->shard_mask];
+} /* end shard_for_key */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure lock_shard(shard)
+ * --------------------------------------------------------------------------
+ * Locks shard if the repository is in concurrent mode.
+ * ----------------------------------------------------------------------- */
+
+static void lock_shard (intstr_shard_t shard) {
+  
+#if (INTSTR_THREAD_SAFE)
+  if (repository->concurrent) {
+    pthread_mutex_lock(&shard->lock);
+  } /* end if */
+#else
+  (void) shard;
+#endif
+} /* end lock_shard */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure unlock_shard(shard)
+ * --------------------------------------------------------------------------
+ * Unlocks shard if the repository is in concurrent mode.
+ * ----------------------------------------------------------------------- */
+
+static void unlock_shard (intstr_shard_t shard) {
+  
+#if (INTSTR_THREAD_SAFE)
+  if (repository->concurrent) {
+    pthread_mutex_unlock(&shard->lock);
+  } /* end if */
+#else
+  (void) shard;
+#endif
+} /* end unlock_shard */
+
+
+/* --------------------------------------------------------------------------
+ * private function repo_alloc(shard, size)
+ * --------------------------------------------------------------------------
+ * Allocates size bytes for a string object or repository entry,  from the
+ * arena of shard in arena mode,  otherwise by malloc.  Returns NULL on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+static intstr_arena_block_t new_arena_block (size_t size);
+
+static void link_full_block
+  (intstr_shard_t shard, intstr_arena_block_t block);
 
+static void *repo_alloc (intstr_shard_t shard, size_t size) {
+  
+  intstr_arena_block_t block;
+  void *ptr;
+  
+  if (NOT(repository->use_arena)) {
+    return m2c_mem_alloc(M2C_MEM_INTSTR, size);
+  } /* end if */
+  
+  size = ARENA_ROUND_UP(size);
+  
+  /* oversized requests get a block of their own behind the current one */
+  if (size > repository->block_size) {
+    block = new_arena_block(size);
+    
+    if (block == NULL) {
+      return NULL;
+    } /* end if */
+    
+    block->used = size;
+    link_full_block(shard, block);
+    
+    return block->storage;
+  } /* end if */
+  
+  block = shard->arena;
+  
+  /* start a new block if the current one is exhausted */
+  if ((block == NULL) || (block->used + size > block->size)) {
+    block = new_arena_block(repository->block_size);
+    
+    if (block == NULL) {
+      return NULL;
+    } /* end if */
+    
+    block->prev = shard->arena;
+    shard->arena = block;
+  } /* end if */
+  
+  ptr = &block->storage[block->used];
+  block->used = block->used + size;
+  
+  return ptr;
+} /* end repo_alloc */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_table_stats(stats, bucket, count)
+ * --------------------------------------------------------------------------
+ * Adds the bucket, chain and size figures of count buckets in bucket to the
+ * statistics in stats.
+ * ----------------------------------------------------------------------- */
+
+static void add_table_stats
+  (intstr_stats_t *stats, intstr_repo_entry_t *bucket, uint_t count) {
+  
+  intstr_repo_entry_t this_entry;
+  uint_t index, length;
+  
+  stats->bucket_count = stats->bucket_count + count;
+  stats->table_bytes =
+    stats->table_bytes + count * sizeof(intstr_repo_entry_t);
+  
+  for (index = 0; index < count; index++) {
+    length = 0;
+    for (this_entry = bucket[index];
+         this_entry != NULL; this_entry = this_entry->next) {
+      stats->string_bytes = stats->string_bytes +
+        sizeof(intstr_struct_t) + this_entry->str->length + 1;
+      length++;
+    } /* end for */
+    
+    if (length > 0) {
+      stats->used_bucket_count++;
+    } /* end if */
+    
+    if (length > stats->max_chain_length) {
+      stats->max_chain_length = length;
+    } /* end if */
+    
+    if (length >= INTSTR_STATS_CHAIN_BINS) {
+      length = INTSTR_STATS_CHAIN_BINS - 1;
+    } /* end if */
+    
+    stats->chain_histogram[length]++;
+  } /* end for */
+  
+  return;
+} /* end add_table_stats */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure link_full_block(shard, block)
+ * --------------------------------------------------------------------------
+ * Links exhausted block into the arena of shard behind the current block,
+ * so that allocation continues in the current block.
+ * ----------------------------------------------------------------------- */
+
+static void link_full_block
+  (intstr_shard_t shard, intstr_arena_block_t block) {
+  
+  if (shard->arena == NULL) {
+    block->prev = NULL;
+    shard->arena = block;
+  }
+  else {
+    block->prev = shard->arena->prev;
+    shard->arena->prev = block;
+  } /* end if */
+  
+  return;
+} /* end link_full_block */
+
+
+/* --------------------------------------------------------------------------
+ * private function snapshot_probe()
+ * --------------------------------------------------------------------------
+ * Returns the hash key of INTSTR_SNAPSHOT_PROBE  to detect snapshots whose
+ * keys were computed by a different hash function.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t snapshot_probe (void) {
+  
+  const char *probe = INTSTR_SNAPSHOT_PROBE;
+  intstr_hash_t key;
+  
+  key = HASH_INITIAL;
+  while (*probe != ASCII_NUL) {
+    key = HASH_NEXT_CHAR(key, *probe);
+    probe++;
+  } /* end while */
+  
+  return HASH_FINAL(key);
+} /* end snapshot_probe */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_valid_snapshot_header(header)
+ * --------------------------------------------------------------------------
+ * Returns true if header is the header of a snapshot written by a build with
+ * the same object layout and hash function  whose data size is plausible for
+ * its string count,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_valid_snapshot_header
+  (const intstr_snapshot_header_t *header) {
+  
+  return
+    (memcmp(header->magic, INTSTR_SNAPSHOT_MAGIC, 8) == 0) &&
+    (header->layout == SNAPSHOT_LAYOUT) &&
+    (header->probe == snapshot_probe()) &&
+    (header->data_size <= SNAPSHOT_MAX_DATA_SIZE) &&
+    (header->data_size >= header->count * (uint64_t) SNAPSHOT_RECORD_SIZE(0));
+} /* end is_valid_snapshot_header */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure snapshot_extent(count, data_size)
+ * --------------------------------------------------------------------------
+ * Passes back the number of strings  in the repository  and the size of the
+ * data section of a snapshot holding them.
+ * ----------------------------------------------------------------------- */
+
+static void snapshot_extent (uint32_t *count, uint64_t *data_size) {
+  
+  uint_t shard_index, index;
+  intstr_shard_t shard;
+  intstr_repo_entry_t this_entry;
+  
+  *count = 0;
+  *data_size = 0;
+  
+  for (shard_index = 0;
+       shard_index <= repository->shard_mask; shard_index++) {
+    shard = &repository->shard[shard_index];
+    lock_shard(shard);
+    
+    for (index = 0; index < shard->bucket_count; index++) {
+      for (this_entry = shard->bucket[index];
+           this_entry != NULL; this_entry = this_entry->next) {
+        (*count)++;
+        *data_size += SNAPSHOT_RECORD_SIZE(this_entry->str->length);
+      } /* end for */
+    } /* end for */
+    
+    for (index = 0; index < shard->old_bucket_count; index++) {
+      for (this_entry = shard->old_bucket[index];
+           this_entry != NULL; this_entry = this_entry->next) {
+        (*count)++;
+        *data_size += SNAPSHOT_RECORD_SIZE(this_entry->str->length);
+      } /* end for */
+    } /* end for */
+    
+    unlock_shard(shard);
+  } /* end for */
+  
+  return;
+} /* end snapshot_extent */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_snapshot_records(file)
+ * --------------------------------------------------------------------------
+ * Writes a snapshot record for every string in the repository to file in
+ * the order counted by snapshot_extent.  Returns false on write failure.
+ * ----------------------------------------------------------------------- */
+
+static bool write_bucket_records
+  (FILE *file, intstr_repo_entry_t *bucket, uint_t count);
+
+static bool write_snapshot_records (FILE *file) {
+  
+  uint_t shard_index;
+  intstr_shard_t shard;
+  bool ok;
+  
+  ok = true;
+  for (shard_index = 0;
+       ok && (shard_index <= repository->shard_mask); shard_index++) {
+    shard = &repository->shard[shard_index];
+    lock_shard(shard);
+    
+    ok = write_bucket_records(file, shard->bucket, shard->bucket_count) &&
+      write_bucket_records(file, shard->old_bucket, shard->old_bucket_count);
+    
+    unlock_shard(shard);
+  } /* end for */
+  
+  return ok;
+} /* end write_snapshot_records */
+
+
+/* --------------------------------------------------------------------------
+ * private function write_bucket_records(file, bucket, count)
+ * --------------------------------------------------------------------------
+ * Writes a snapshot record for every entry in count buckets of bucket to
+ * file.  Tags are written as they are,  they are recalculated when loading
+ * but need not be written to if they are current.  Returns false on write
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+static bool write_bucket_records
+  (FILE *file, intstr_repo_entry_t *bucket, uint_t count) {
+  
+  static const char padding[INTSTR_ARENA_ALIGNMENT];
+  char key_field[SNAPSHOT_KEY_SIZE];
+  intstr_struct_t header;
+  intstr_repo_entry_t this_entry;
+  uint_t index;
+  size_t pad;
+  
+  for (index = 0; index < count; index++) {
+    for (this_entry = bucket[index];
+         this_entry != NULL; this_entry = this_entry->next) {
+      
+      /* key padded to alignment */
+      memset(key_field, 0, SNAPSHOT_KEY_SIZE);
+      memcpy(key_field, &this_entry->key, sizeof(intstr_hash_t));
+      
+      /* string object header */
+      memset(&header, 0, sizeof(intstr_struct_t));
+      header.key = this_entry->key;
+      header.length = this_entry->str->length;
+      header.tag = this_entry->str->tag;
+      
+      pad = SNAPSHOT_RECORD_SIZE(header.length) -
+        (SNAPSHOT_KEY_SIZE + sizeof(intstr_struct_t) + header.length + 1);
+      
+      if ((fwrite(key_field, SNAPSHOT_KEY_SIZE, 1, file) != 1) ||
+          (fwrite(&header, sizeof(intstr_struct_t), 1, file) != 1) ||
+          (fwrite(this_entry->str->char_array,
+             header.length + 1, 1, file) != 1) ||
+          ((pad > 0) && (fwrite(padding, pad, 1, file) != 1))) {
+        return false;
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  return true;
+} /* end write_bucket_records */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure insert_snapshot_records(data, size, count, status)
+ * --------------------------------------------------------------------------
+ * Enters the count string objects in the size bytes of snapshot data at data
+ * into the repository unless an equal string is already present.  Fields of
+ * a string object are only written to if they differ from their initial
+ * values,  so that the pages of a mapped snapshot remain shared.  Passes back
+ * INTSTR_STATUS_INVALID_SNAPSHOT if a record is malformed,  in which case
+ * the records preceding it remain entered.
+ * ----------------------------------------------------------------------- */
+
+static void insert_snapshot_records
+  (char *data, size_t size, uint32_t count, intstr_status_t *status) {
+  
+  intstr_shard_t shard;
+  intstr_hash_t key;
+  intstr_t str;
+  uint_t tag;
+  size_t offset, rec_size;
+  uint32_t index;
+  bool ok;
+  
+  offset = 0;
+  for (index = 0; index < count; index++) {
+    
+    /* verify record bounds and terminator */
+    if (size - offset < SNAPSHOT_RECORD_SIZE(0)) {
+      SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+      return;
+    } /* end if */
+    
+    memcpy(&key, &data[offset], sizeof(intstr_hash_t));
+    str = (intstr_t) &data[offset + SNAPSHOT_KEY_SIZE];
+    
+    if ((str->length > size) ||
+        (SNAPSHOT_RECORD_SIZE(str->length) > size - offset) ||
+        (str->char_array[str->length] != ASCII_NUL)) {
+      SET_STATUS(status, INTSTR_STATUS_INVALID_SNAPSHOT);
+      return;
+    } /* end if */
+    
+    rec_size = SNAPSHOT_RECORD_SIZE(str->length);
+    
+    /* enter the string unless already present */
+    shard = shard_for_key(key);
+    lock_shard(shard);
+    
+    ok = true;
+    if (lookup_string(shard, key, str->char_array, str->length, NULL, 0)
+        == NULL) {
+#if !(INTSTR_IMMORTAL)
+      if (str->ref_count != 0) {
+        str->ref_count = 0;
+      } /* end if */
+#endif
+      if (str->flags != 0) {
+        str->flags = 0;
+      } /* end if */
+      
+      if (str->xlat != NULL) {
+        str->xlat = NULL;
+      } /* end if */
+      
+      tag = initial_tag(str->char_array, str->length);
+      
+      if (str->tag != tag) {
+        str->tag = tag;
+      } /* end if */
+      
+      ok = store_string(shard, str, key);
+    } /* end if */
+    
+    unlock_shard(shard);
+    
+    if (NOT(ok)) {
+      SET_STATUS(status, INTSTR_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    offset = offset + rec_size;
+  } /* end for */
+  
+  SET_STATUS(status, INTSTR_STATUS_SUCCESS);
+  return;
+} /* end insert_snapshot_records */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_arena_block(size)
+ * --------------------------------------------------------------------------
+ * Allocates an empty arena block with size bytes of storage.  Returns NULL
+ * if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static intstr_arena_block_t new_arena_block (size_t size) {
+  
+  intstr_arena_block_t block;
+  
+  block = m2c_mem_alloc(M2C_MEM_INTSTR, sizeof(intstr_arena_block_s) + size);
+  
+  if (block == NULL) {
+    return NULL;
+  } /* end if */
+  
+  block->prev = NULL;
+  block->size = size;
+  block->used = 0;
+  
+  return block;
+} /* end new_arena_block */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure free_arena_blocks(block)
+ * --------------------------------------------------------------------------
+ * Deallocates block and all blocks preceding it.
+ * ----------------------------------------------------------------------- */
+
+static void free_arena_blocks (intstr_arena_block_t block) {
+  
+  intstr_arena_block_t prev;
+  
+  while (block != NULL) {
+    prev = block->prev;
+    m2c_mem_free(M2C_MEM_INTSTR, block);
+    block = prev;
+  } /* end while */
+  
+  return;
+} /* end free_arena_blocks */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure unmap_snapshots(mapping)
+ * --------------------------------------------------------------------------
+ * Unmaps and deallocates mapping and all mappings preceding it.
+ * ----------------------------------------------------------------------- */
+
+static void unmap_snapshots (intstr_mapping_t mapping) {
+  
+  intstr_mapping_t prev;
+  
+  while (mapping != NULL) {
+    prev = mapping->prev;
+#if (INTSTR_SNAPSHOT_USE_MMAP)
+    munmap(mapping->data, mapping->size);
+#endif
+    m2c_mem_free(M2C_MEM_INTSTR, mapping);
+    mapping = prev;
+  } /* end while */
+  
+  return;
+} /* end unmap_snapshots */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure free_shard_entries(shard)
+ * --------------------------------------------------------------------------
+ * Deallocates all entries  and string objects of shard  of a repository not
+ * in arena mode,  regardless of outstanding retains.
+ * ----------------------------------------------------------------------- */
+
+static void free_bucket_entries (intstr_repo_entry_t *bucket, uint_t count);
+
+static void free_shard_entries (intstr_shard_t shard) {
+  
+  free_bucket_entries(shard->bucket, shard->bucket_count);
+  
+  if (shard->old_bucket != NULL) {
+    free_bucket_entries
+      (shard->old_bucket, shard->old_bucket_count);
+  } /* end if */
+  
+  shard->entry_count = 0;
+  
+  return;
+} /* end free_shard_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure free_bucket_entries(bucket, count)
+ * --------------------------------------------------------------------------
+ * Deallocates the entries and string objects of count buckets in bucket.
+ * ----------------------------------------------------------------------- */
+
+static void free_bucket_entries (intstr_repo_entry_t *bucket, uint_t count) {
+  
+  uint_t index;
+  intstr_repo_entry_t this_entry, next_entry;
+  
+  for (index = 0; index < count; index++) {
+    this_entry = bucket[index];
+    
+    while (this_entry != NULL) {
+      next_entry = this_entry->next;
+      m2c_mem_free(M2C_MEM_INTSTR, this_entry->str);
+      m2c_mem_free(M2C_MEM_INTSTR, this_entry);
+      this_entry = next_entry;
+    } /* end while */
+    
+    bucket[index] = NULL;
+  } /* end for */
+  
+  return;
+} /* end free_bucket_entries */
+
+
+/* --------------------------------------------------------------------------
+ * private function alloc_string(shard, length)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated and initialised string object with room for
+ * length characters and a terminating NUL,  allocated for shard.  Returns
+ * NULL if allocation failed.  Strings allocated in arena mode are not
+ * reference counted.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t alloc_string (intstr_shard_t shard, uint_t length) {
+  
+  intstr_t new_string;
+  
+  new_string = repo_alloc(shard, sizeof(intstr_struct_t) + length + 1);
+  
+  if (new_string == NULL) {
+    return NULL;
+  } /* end if */
+  
+#if !(INTSTR_IMMORTAL)
+  if (repository->use_arena) {
+    new_string->ref_count = 0;
+  }
+  else {
+    new_string->ref_count = 1;
+  } /* end if */
+#endif
+  
+  new_string->length = length;
+  new_string->tag = INTSTR_TAG_UNKNOWN;
+  new_string->flags = 0;
+  new_string->xlat = NULL;
+  new_string->char_array[length] = ASCII_NUL;
+  
+  return new_string;
+} /* end alloc_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_string(shard, str1, len1, str2, len2)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated string object of shard with the concatenation
+ * of the first len1 characters of str1  and the first len2 characters of
+ * str2.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t new_string
+  (intstr_shard_t shard, const char *str1, uint_t len1,
+   const char *str2, uint_t len2) {
+  
+  intstr_t this_string;
+  
+  this_string = alloc_string(shard, len1 + len2);
+  
+  if (this_string != NULL) {
+    memcpy(this_string->char_array, str1, len1);
+    if (len2 > 0) {
+      memcpy(&this_string->char_array[len1], str2, len2);
+    } /* end if */
+  } /* end if */
+  
+  return this_string;
+} /* end new_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_repo_entry(shard, str, key)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated repository entry of shard for str with key.
+ * Returns NULL if str is NULL or if allocation failed,  in which case str is
+ * deallocated unless the repository is in arena mode.
+ * ----------------------------------------------------------------------- */
+
+static intstr_repo_entry_t new_repo_entry
+  (intstr_shard_t shard, intstr_t str, intstr_hash_t key) {
+  
+  intstr_repo_entry_t new_entry;
+  
+  if (str == NULL) {
+    return NULL;
+  } /* end if */
+  
+  new_entry = repo_alloc(shard, sizeof(intstr_repo_entry_s));
+  
+  if (new_entry == NULL) {
+    if (NOT(repository->use_arena)) {
+      m2c_mem_free(M2C_MEM_INTSTR, str);
+    } /* end if */
+    return NULL;
+  } /* end if */
+  
+  new_entry->key = key;
+  new_entry->str = str;
+  new_entry->next = NULL;
+  
+  return new_entry;
+} /* end new_repo_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function matches_concatenation(str, str1, len1, str2, len2)
+ * --------------------------------------------------------------------------
+ * Returns true if the characters of str match the concatenation of the
+ * first len1 characters of str1 and the first len2 characters of str2.
+ * A single string is matched by passing zero in len2.
+ * ----------------------------------------------------------------------- */
+
+static bool matches_concatenation
+  (intstr_t str, const char *str1, uint_t len1,
+   const char *str2, uint_t len2) {
+  
+  return (str->length == len1 + len2) &&
+    (memcmp(str->char_array, str1, len1) == 0) &&
+    ((len2 == 0) || (memcmp(&str->char_array[len1], str2, len2) == 0));
+} /* end matches_concatenation */
+
+
+/* --------------------------------------------------------------------------
+ * private function lookup_string(shard, key, str1, len1, str2, len2)
+ * --------------------------------------------------------------------------
+ * Returns the string object stored in shard with key  whose characters match
+ * the concatenation of str1 and str2 of length len1 and len2,  or NULL if
+ * there is none.  While rehashing,  the old bucket table is searched as well.
+ * ----------------------------------------------------------------------- */
+
+static intstr_t lookup_string
+  (intstr_shard_t shard, intstr_hash_t key, const char *str1, uint_t len1,
+   const char *str2, uint_t len2) {
+  
+  intstr_repo_entry_t this_entry;
+  
+  this_entry = shard->bucket[key % shard->bucket_count];
+  
+  while (this_entry != NULL) {
+    if ((this_entry->key == key) &&
+        matches_concatenation(this_entry->str, str1, len1, str2, len2)) {
+      return this_entry->str;
+    } /* end if */
+    
+    this_entry = this_entry->next;
+  } /* end while */
+  
+  if (shard->old_bucket == NULL) {
+    return NULL;
+  } /* end if */
+  
+  this_entry = shard->old_bucket[key % shard->old_bucket_count];
+  
+  while (this_entry != NULL) {
+    if ((this_entry->key == key) &&
+        matches_concatenation(this_entry->str, str1, len1, str2, len2)) {
+      return this_entry->str;
+    } /* end if */
+    
+    this_entry = this_entry->next;
+  } /* end while */
+  
+  return NULL;
+} /* end lookup_string */
+
+
+/* --------------------------------------------------------------------------
+ * private function store_string(shard, str, key)
+ * --------------------------------------------------------------------------
+ * Stores str with key in a new entry of the current bucket table of shard,
+ * records key in str unless it is already there,  advances any rehashing in
+ * progress  and starts rehashing  if the load factor has been exceeded.
+ * Returns false if str is NULL or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static void start_rehash (intstr_shard_t shard);
+
+static void rehash_step (intstr_shard_t shard);
+
+static bool store_string
+  (intstr_shard_t shard, intstr_t str, intstr_hash_t key) {
+  
+  intstr_repo_entry_t new_entry;
+  uint_t index;
+  
+  new_entry = new_repo_entry(shard, str, key);
+  
+  if (new_entry == NULL) {
+    return false;
+  } /* end if */
+  
+  /* cache the key for intstr_hash and removal */
+  if (str->key != key) {
+    str->key = key;
+  } /* end if */
+  
+  /* link the new entry at the head of its bucket */
+  index = key % shard->bucket_count;
+  new_entry->next = shard->bucket[index];
+  shard->bucket[index] = new_entry;
+  
+  /* update the entry counter */
+  shard->entry_count++;
+  
+  if (shard->old_bucket != NULL) {
+    rehash_step(shard);
+  }
+  else if (shard->entry_count >
+           shard->bucket_count * INTSTR_REPO_MAX_LOAD) {
+    start_rehash(shard);
+  } /* end if */
+  
+  return true;
+} /* end store_string */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure start_rehash(shard)
+ * --------------------------------------------------------------------------
+ * Allocates a bucket table of about twice the size for shard and makes its
+ * table the old table to be rehashed step by step.  If allocation fails,
+ * the current table is kept.
+ * ----------------------------------------------------------------------- */
+
+static void start_rehash (intstr_shard_t shard) {
+  
+  uint_t index, new_count;
+  intstr_repo_entry_t *new_bucket;
+  
+  new_count = 2 * shard->bucket_count + 1;
+  
+  /* bail out on overflow */
+  if (new_count <= shard->bucket_count) {
+    return;
+  } /* end if */
+  
+  new_bucket = m2c_mem_alloc(M2C_MEM_INTSTR,
+    new_count * sizeof(intstr_repo_entry_t));
+  
+  if (new_bucket == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < new_count; index++) {
+    new_bucket[index] = NULL;
+  } /* end for */
+  
+  shard->old_bucket = shard->bucket;
+  shard->old_bucket_count = shard->bucket_count;
+  shard->rehash_index = 0;
+  shard->bucket = new_bucket;
+  shard->bucket_count = new_count;
+  
+  rehash_step(shard);
+  
+  return;
+} /* end start_rehash */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure rehash_step(shard)
+ * --------------------------------------------------------------------------
+ * Moves the entries of the next INTSTR_REPO_REHASH_STEP buckets of the old
+ * table of shard to its current table,  deallocates the old table when done.
+ * ----------------------------------------------------------------------- */
+
+static void rehash_step (intstr_shard_t shard) {
+  
+  uint_t done, index;
+  intstr_repo_entry_t this_entry, next_entry;
+  
+  for (done = 0; (done < INTSTR_REPO_REHASH_STEP) &&
+       (shard->rehash_index < shard->old_bucket_count); done++) {
+    
+    this_entry = shard->old_bucket[shard->rehash_index];
+    shard->old_bucket[shard->rehash_index] = NULL;
+    
+    while (this_entry != NULL) {
+      next_entry = this_entry->next;
+      index = this_entry->key % shard->bucket_count;
+      this_entry->next = shard->bucket[index];
+      shard->bucket[index] = this_entry;
+      this_entry = next_entry;
+    } /* end while */
+    
+    shard->rehash_index++;
+  } /* end for */
+  
+  if (shard->rehash_index == shard->old_bucket_count) {
+    m2c_mem_free(M2C_MEM_INTSTR, shard->old_bucket);
+    shard->old_bucket = NULL;
+    shard->old_bucket_count = 0;
+    shard->rehash_index = 0;
+  } /* end if */
+  
+  return;
+} /* end rehash_step */
+
+
+#if !(INTSTR_IMMORTAL)
+/* --------------------------------------------------------------------------
+ * private procedure remove_repo_entry(str, key)
+ * --------------------------------------------------------------------------
+ * Unlinks and deallocates the repository entry for str with key,  which may
+ * still be in the old bucket table while rehashing.
+ * ----------------------------------------------------------------------- */
+
+static bool unlink_entry
+  (intstr_shard_t shard, intstr_repo_entry_t *link, intstr_t str);
+
+static void remove_repo_entry (intstr_t str, intstr_hash_t key) {
+  
+  intstr_shard_t shard;
+  
+  shard = shard_for_key(key);
+  
+  if (unlink_entry
+      (shard, &shard->bucket[key % shard->bucket_count], str)) {
+    return;
+  } /* end if */
+  
+  if (shard->old_bucket != NULL) {
+    unlink_entry
+      (shard, &shard->old_bucket[key % shard->old_bucket_count], str);
+  } /* end if */
+  
+  return;
+} /* end remove_repo_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function unlink_entry(shard, link, str)
+ * --------------------------------------------------------------------------
+ * Searches the chain of shard starting at link for the entry of str,
+ * unlinks and deallocates it.  Returns true if the entry was found, else false.
+ * ----------------------------------------------------------------------- */
+
+static bool unlink_entry
+  (intstr_shard_t shard, intstr_repo_entry_t *link, intstr_t str) {
+  
+  intstr_repo_entry_t this_entry;
+  
+  while (*link != NULL) {
+    this_entry = *link;
+    
+    if (this_entry->str == str) {
+      *link = this_entry->next;
+      m2c_mem_free(M2C_MEM_INTSTR, this_entry);
+      shard->entry_count--;
+      return true;
+    } /* end if */
+    
+    link = &this_entry->next;
+  } /* end while */
+  
+  return false;
+} /* end unlink_entry */
+#endif
 
-#endif /* INTSTR_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -40,7 +40,10 @@
 #ifndef INTSTR_H
 #define INTSTR_H
 
-#include "m2-common.h"
+#include "m2c-common.h"
+
+#include <stddef.h>
+#include <stdio.h>
 
 
 /* --------------------------------------------------------------------------
@@ -50,6 +53,39 @@
 #define INTSTR_SIZE_LIMIT 2000
 
 
+/* --------------------------------------------------------------------------
+ * Default block size of the repository arena
+ * ----------------------------------------------------------------------- */
+
+#define INTSTR_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Thread safety
+ * --------------------------------------------------------------------------
+ * Define INTSTR_THREAD_SAFE as 1 to build the library with support for the
+ * concurrent repository.  This requires POSIX threads.
+ * ----------------------------------------------------------------------- */
+
+#ifndef INTSTR_THREAD_SAFE
+#define INTSTR_THREAD_SAFE 0
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Immortal strings
+ * --------------------------------------------------------------------------
+ * Define INTSTR_IMMORTAL as 1 to build the library without reference counts.
+ * Every repository is then allocated in arena mode,  string objects do not
+ * store a reference count  and intstr_retain and intstr_release expand to
+ * no-ops.  Interned strings remain valid until intstr_dispose_repo.
+ * ----------------------------------------------------------------------- */
+
+#ifndef INTSTR_IMMORTAL
+#define INTSTR_IMMORTAL 0
+#endif
+
+
 /* --------------------------------------------------------------------------
  * opaque type intstr_t
  * --------------------------------------------------------------------------
@@ -59,6 +95,103 @@
 typedef struct intstr_struct_t *intstr_t;
 
 
+/* --------------------------------------------------------------------------
+ * type intstr_hash_t
+ * --------------------------------------------------------------------------
+ * unsigned integer type representing a 32-bit hash value.  Hash values are
+ * computed using HASH_INITIAL, HASH_NEXT_CHAR and HASH_FINAL from hash.h.
+ * ----------------------------------------------------------------------- */
+
+typedef uint32_t intstr_hash_t;
+
+
+/* --------------------------------------------------------------------------
+ * type intstr_tag_handler_t
+ * --------------------------------------------------------------------------
+ * function pointer type for  a client supplied handler  that calculates the
+ * classification tag of a newly interned string from its characters.
+ * ----------------------------------------------------------------------- */
+
+typedef uint_t (*intstr_tag_handler_t) (const char *str, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * Classification tag values
+ * --------------------------------------------------------------------------
+ * INTSTR_TAG_NONE is the tag of strings that are not classified by the tag
+ * handler.  INTSTR_TAG_UNKNOWN is the tag of strings interned while no tag
+ * handler was installed,  which is replaced  on the first call to intstr_tag.
+ * ----------------------------------------------------------------------- */
+
+#define INTSTR_TAG_NONE 0
+
+#define INTSTR_TAG_UNKNOWN (~((uint_t) 0))
+
+
+/* --------------------------------------------------------------------------
+ * type intstr_static_t
+ * --------------------------------------------------------------------------
+ * record type for  string objects  that are  preinitialised at compile time
+ * and linked into the binary.  Its layout matches the hidden type of string
+ * objects  up to  the character array,  which holds at most
+ * INTSTR_STATIC_SIZE_LIMIT characters.  A pointer to a static string object
+ * is converted to intstr_t with macro INTSTR_FOR_STATIC.  Static strings are
+ * never deallocated,  retain and release have no effect on them.  They are
+ * made canonical by installing a static resolver that returns them.
+ * ----------------------------------------------------------------------- */
+
+#define INTSTR_STATIC_SIZE_LIMIT 15
+
+typedef struct {
+#if !(INTSTR_IMMORTAL)
+  uint_t ref_count;
+#endif
+  intstr_hash_t key;
+  uint_t length;
+  uint_t tag;
+  uint_t flags;
+  const char *xlat;
+  char char_array[INTSTR_STATIC_SIZE_LIMIT + 1];
+} intstr_static_t;
+
+
+/* --------------------------------------------------------------------------
+ * macro INTSTR_STATIC_INIT(key, length, tag, str)
+ * --------------------------------------------------------------------------
+ * Initialiser for a static string object with string literal str of length
+ * length,  hash key key as calculated by hash.h,  and tag tag.
+ * ----------------------------------------------------------------------- */
+
+#if (INTSTR_IMMORTAL)
+#define INTSTR_STATIC_INIT(_key, _length, _tag, _str) \
+  { (_key), (_length), (_tag), 0, NULL, _str }
+#else
+#define INTSTR_STATIC_INIT(_key, _length, _tag, _str) \
+  { 0, (_key), (_length), (_tag), 0, NULL, _str }
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * macro INTSTR_FOR_STATIC(static_str)
+ * --------------------------------------------------------------------------
+ * Returns the interned string for a pointer to a static string object.
+ * ----------------------------------------------------------------------- */
+
+#define INTSTR_FOR_STATIC(_static_str) ((intstr_t) (_static_str))
+
+
+/* --------------------------------------------------------------------------
+ * type intstr_static_resolver_t
+ * --------------------------------------------------------------------------
+ * function pointer type for a client supplied resolver that returns a static
+ * string object matching length characters at str with hash key key,  or
+ * NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+typedef intstr_t (*intstr_static_resolver_t)
+  (const char *str, uint_t length, intstr_hash_t key);
+
+
 /* --------------------------------------------------------------------------
  * type intstr_status_t
  * --------------------------------------------------------------------------
@@ -73,6 +206,9 @@ typedef enum {
   INTSTR_STATUS_INVALID_INDICES,
   INTSTR_STATUS_ALLOCATION_FAILED,
   INTSTR_STATUS_SIZE_LIMIT_EXCEEDED,
+  INTSTR_STATUS_NOT_SUPPORTED,
+  INTSTR_STATUS_IO_ERROR,
+  INTSTR_STATUS_INVALID_SNAPSHOT
 } intstr_status_t;
 
 
@@ -80,8 +216,9 @@ typedef enum {
  * procedure intstr_init_repo(size, status)
  * --------------------------------------------------------------------------
  * Allocates and initialises global string repository.  Parameter size deter-
- * mines the  number of buckets  of the repository's internal hash table.  If
- * size is zero, value STRING_REPO_DEFAULT_BUCKET_COUNT is used.
+ * mines the initial number of buckets of the repository's internal hash table.
+ * If size is zero, value STRING_REPO_DEFAULT_BUCKET_COUNT is used.  The table
+ * grows incrementally as strings are added.
  *
  * pre-conditions:
  * o  global repository must be uninitialised upon entry
@@ -103,6 +240,136 @@ typedef enum {
 void intstr_init_repo (uint_t size, intstr_status_t *status);
 
 
+/* --------------------------------------------------------------------------
+ * procedure intstr_init_arena_repo(size, block_size, status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises  the global string repository  in arena mode.
+ * Parameter size determines the number of buckets like intstr_init_repo.
+ * String objects and repository entries  are packed into blocks of at least
+ * block_size bytes,  which saves two allocations per interned string.  If
+ * block_size is zero, value INTSTR_ARENA_DEFAULT_BLOCK_SIZE is used.
+ *
+ * Reference counting is turned off in arena mode:  intstr_retain and
+ * intstr_release have no effect and every interned string remains valid
+ * until procedure intstr_dispose_repo is called.  Pre-, post- and error-
+ * conditions are those of procedure intstr_init_repo.
+ * ----------------------------------------------------------------------- */
+
+void intstr_init_arena_repo
+  (uint_t size, size_t block_size, intstr_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_init_concurrent_repo(size, shard_count, status)
+ * --------------------------------------------------------------------------
+ * Allocates and initialises the global string repository in concurrent mode
+ * for interning strings from multiple threads.  The repository is split into
+ * shard_count shards, rounded up to a power of two, each with its own lock
+ * and arena.  If shard_count is zero, a default of 16 is used.  Parameter
+ * size determines the initial number of buckets of each shard.
+ *
+ * Concurrent mode implies arena mode:  intstr_retain and intstr_release have
+ * no effect  and every interned string remains valid  and canonical across
+ * threads until procedure intstr_dispose_repo is called.  The repository must
+ * be initialised,  and any tag handler installed,  before threads start to
+ * intern strings.  Disposal must take place after they have finished.
+ *
+ * Pre-, post- and error-conditions are those of procedure intstr_init_repo.
+ * In addition,  if the library has been built without INTSTR_THREAD_SAFE,
+ * no operation is carried out  and INTSTR_STATUS_NOT_SUPPORTED is passed
+ * back in status unless status is NULL.
+ * ----------------------------------------------------------------------- */
+
+void intstr_init_concurrent_repo
+  (uint_t size, uint_t shard_count, intstr_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_dispose_repo()
+ * --------------------------------------------------------------------------
+ * Deallocates the global string repository and all interned strings, which
+ * become invalid.  In arena mode all storage is released in a single pass
+ * over the arena blocks.  The repository may then be initialised anew.
+ * ----------------------------------------------------------------------- */
+
+void intstr_dispose_repo (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_save_snapshot(path, status)
+ * --------------------------------------------------------------------------
+ * Writes all strings in the global string repository to a snapshot file at
+ * path,  replacing any existing file.  The snapshot holds the string objects
+ * in their in-memory layout and may only be loaded by the same build.
+ *
+ * pre-conditions:
+ * o  global repository must be initialised upon entry
+ * o  parameter path must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  a snapshot of the repository has been written to path
+ * o  INTSTR_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if the repository is not initialised, INTSTR_STATUS_NOT_INITIALIZED,
+ *    if path is NULL, INTSTR_STATUS_INVALID_REFERENCE,
+ *    if the file could not be written, INTSTR_STATUS_IO_ERROR
+ *    is passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+void intstr_save_snapshot (const char *path, intstr_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_load_snapshot(path, status)
+ * --------------------------------------------------------------------------
+ * Adds the strings of a snapshot file at path to the global string reposi-
+ * tory,  which must have been initialised in arena or concurrent mode.  The
+ * file is read into a single block and its string objects are used in place,
+ * thus warm startup costs one allocation per string for its entry.  Strings
+ * already present in the repository are kept.  Tags are recalculated by the
+ * installed tag handler.  Must not be called while other threads intern.
+ *
+ * pre-conditions:
+ * o  global repository must be initialised in arena mode upon entry
+ * o  parameter path must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the strings of the snapshot are present in the repository
+ * o  INTSTR_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if the repository is not initialised, INTSTR_STATUS_NOT_INITIALIZED,
+ *    if path is NULL, INTSTR_STATUS_INVALID_REFERENCE,
+ *    if the repository is not in arena mode, INTSTR_STATUS_NOT_SUPPORTED,
+ *    if the file could not be opened, INTSTR_STATUS_IO_ERROR,
+ *    if the file is not a snapshot of this build,
+ *    INTSTR_STATUS_INVALID_SNAPSHOT,
+ *    if allocation failed, INTSTR_STATUS_ALLOCATION_FAILED
+ *    is passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+void intstr_load_snapshot (const char *path, intstr_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_map_snapshot(path, status)
+ * --------------------------------------------------------------------------
+ * Adds the strings of a snapshot file at path to the global string reposi-
+ * tory like intstr_load_snapshot,  but maps the file into memory instead of
+ * reading it,  where mmap() is available.  The mapping is private,  yet its
+ * pages stay shared with every other process that maps the same file until
+ * a string on a page is modified,  since string objects are only written to
+ * where they differ from the snapshot.  Processes started on the same build
+ * thus share a single copy of the strings in the snapshot.  The mapping is
+ * released by intstr_dispose_repo.  On other hosts,  the file is loaded.
+ *
+ * Pre-,  post- and error-conditions are those of intstr_load_snapshot.
+ * ----------------------------------------------------------------------- */
+
+void intstr_map_snapshot (const char *path, intstr_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function intstr_for_cstr(str, status)
  * --------------------------------------------------------------------------
@@ -168,6 +435,37 @@ intstr_t intstr_for_slice
   (const char *str, uint_t offset, uint_t length, intstr_status_t *status);
 
 
+/* --------------------------------------------------------------------------
+ * function intstr_for_slice_with_hash(str, offset, length, key, status)
+ * --------------------------------------------------------------------------
+ * Returns an interned string object for a given slice of str  like function
+ * intstr_for_slice,  but uses  the precomputed hash key  instead of hashing
+ * the slice.  This permits a caller that has already visited each character
+ * of the slice, such as a lexer, to hash the slice while it is scanned.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ * o  slice must be within range of str (NOT GUARDED)
+ * o  slice must not contain any control characters (NOT GUARDED)
+ * o  key must be the final hash value of the slice (NOT GUARDED)
+ *
+ * post-conditions:
+ * o  as for intstr_for_slice
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_INVALID_REFERENCE is
+ *    passed back in status, unless status is NULL
+ * o  if string object allocation failed, no operation is carried out,
+ *    NULL is returned and INTSTR_STATUS_ALLOCATION_FAILED is
+ *    passed back in status unless status is NULL
+ * ----------------------------------------------------------------------- */
+
+intstr_t intstr_for_slice_with_hash
+  (const char *str, uint_t offset, uint_t length,
+   intstr_hash_t key, intstr_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function intstr_for_concatenation(str, append_str, status)
  * --------------------------------------------------------------------------
@@ -237,6 +535,169 @@ uint_t intstr_length (intstr_t str);
 const char *intstr_char_ptr (intstr_t str);
 
 
+/* --------------------------------------------------------------------------
+ * function intstr_hash(str)
+ * --------------------------------------------------------------------------
+ * Returns the hash key str was interned with.  The key is cached in str and
+ * not recomputed,  clients may use it to key their own tables on str.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the hash key cached in str when it was interned is returned
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, zero is returned
+ * ----------------------------------------------------------------------- */
+
+intstr_hash_t intstr_hash (intstr_t str);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_install_tag_handler(handler)
+ * --------------------------------------------------------------------------
+ * Installs handler  as the tag handler  that is called once for every newly
+ * interned string to calculate its classification tag.
+ *
+ * pre-conditions:
+ * o  none
+ *
+ * post-conditions:
+ * o  handler is installed as tag handler
+ *
+ * error-conditions:
+ * o  if handler is NULL, any installed handler is uninstalled
+ * ----------------------------------------------------------------------- */
+
+void intstr_install_tag_handler (intstr_tag_handler_t handler);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_install_static_resolver(resolver)
+ * --------------------------------------------------------------------------
+ * Installs resolver  as the static resolver  that is consulted  before the
+ * repository whenever a string of at most INTSTR_STATIC_SIZE_LIMIT charac-
+ * ters is interned.  A string the resolver returns a static string object for
+ * is neither looked up in nor stored in the repository.  The resolver must be
+ * installed before the first string is interned and it must be safe to call
+ * from multiple threads in concurrent mode.
+ *
+ * pre-conditions:
+ * o  none
+ *
+ * post-conditions:
+ * o  resolver is installed as static resolver
+ *
+ * error-conditions:
+ * o  if resolver is NULL, any installed resolver is uninstalled
+ * ----------------------------------------------------------------------- */
+
+void intstr_install_static_resolver (intstr_static_resolver_t resolver);
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_tag(str)
+ * --------------------------------------------------------------------------
+ * Returns the classification tag of str.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the tag calculated by the tag handler when str was interned is returned
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, INTSTR_TAG_NONE is returned
+ * o  if no tag handler is installed and str has not been tagged,
+ *    INTSTR_TAG_UNKNOWN is returned
+ * ----------------------------------------------------------------------- */
+
+uint_t intstr_tag (intstr_t str);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_set_flags(str, flags)
+ * --------------------------------------------------------------------------
+ * Stores flags in str,  so that clients can cache one-bit properties of a
+ * string,  such as the result of a test,  with the string itself.  The
+ * meaning of the flags is defined by the client.  Newly interned strings
+ * have no flags set;  flags are not written to snapshots.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  flags are stored in str,  replacing any previous flags
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, no operation is carried out
+ * ----------------------------------------------------------------------- */
+
+void intstr_set_flags (intstr_t str, uint_t flags);
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_flags(str)
+ * --------------------------------------------------------------------------
+ * Returns the flags stored in str.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the flags last stored in str are returned
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, zero is returned
+ * ----------------------------------------------------------------------- */
+
+uint_t intstr_flags (intstr_t str);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_set_xlat(str, xlat)
+ * --------------------------------------------------------------------------
+ * Stores translation xlat in str,  so that clients translating identifiers
+ * can cache the result of a translation with the identifier itself.  The
+ * repository does not copy,  own or deallocate xlat.  Only one translation
+ * can be stored per string;  it is not written to snapshots.  In a repos-
+ * itory built with INTSTR_THREAD_SAFE,  a thread that obtains xlat from
+ * intstr_xlat also observes the characters stored at xlat beforehand.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ * o  xlat must remain valid while it is stored in str
+ *
+ * post-conditions:
+ * o  xlat is stored in str,  replacing any previous translation
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry, no operation is carried out
+ * ----------------------------------------------------------------------- */
+
+void intstr_set_xlat (intstr_t str, const char *xlat);
+
+
+/* --------------------------------------------------------------------------
+ * function intstr_xlat(str)
+ * --------------------------------------------------------------------------
+ * Returns the translation stored in str.
+ *
+ * pre-conditions:
+ * o  parameter str must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  the translation last stored in str is returned
+ *
+ * error-conditions:
+ * o  if str is NULL upon entry or no translation is stored,
+ *    NULL is returned
+ * ----------------------------------------------------------------------- */
+
+const char *intstr_xlat (intstr_t str);
+
+
 /* --------------------------------------------------------------------------
  * function intstr_count()
  * --------------------------------------------------------------------------
@@ -255,10 +716,63 @@ const char *intstr_char_ptr (intstr_t str);
 uint_t intstr_count (void);
 
 
+/* --------------------------------------------------------------------------
+ * type intstr_stats_t
+ * --------------------------------------------------------------------------
+ * record type holding statistics of the string repository.  Bucket figures
+ * cover all shards,  and the old table while the repository is rehashed.
+ * Element i of chain_histogram counts the buckets with i entries,  the last
+ * element those with INTSTR_STATS_CHAIN_BINS-1 or more.  Hits and misses
+ * count the lookups of intstr_for_slice and the other intern functions.
+ * Bytes in use are those of string objects,  entries and bucket tables,  in
+ * arena mode total_bytes counts the arena blocks in place of objects.
+ * ----------------------------------------------------------------------- */
+
+#define INTSTR_STATS_CHAIN_BINS 8
+
+typedef struct {
+  uint_t entry_count;
+  uint_t shard_count;
+  uint_t bucket_count;
+  uint_t used_bucket_count;
+  uint_t max_chain_length;
+  uint_t chain_histogram[INTSTR_STATS_CHAIN_BINS];
+  uint64_t lookup_hits;
+  uint64_t lookup_misses;
+  size_t string_bytes;
+  size_t entry_bytes;
+  size_t table_bytes;
+  size_t arena_bytes;
+  size_t total_bytes;
+} intstr_stats_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_stats(stats)
+ * --------------------------------------------------------------------------
+ * Passes back statistics of the string repository in stats.  All figures
+ * are zero if the repository has not been initialised.  Does nothing if
+ * stats is NULL.
+ * ----------------------------------------------------------------------- */
+
+void intstr_stats (intstr_stats_t *stats);
+
+
+/* --------------------------------------------------------------------------
+ * procedure intstr_print_stats(out)
+ * --------------------------------------------------------------------------
+ * Prints a report of the statistics of the string repository to out,  as
+ * requested by compiler option --intstr-stats.
+ * ----------------------------------------------------------------------- */
+
+void intstr_print_stats (FILE *out);
+
+
 /* --------------------------------------------------------------------------
  * function intstr_retain(str)
  * --------------------------------------------------------------------------
- * Prevents str from deallocation.
+ * Prevents str from deallocation.  Expands to a no-op if the library is
+ * built with INTSTR_IMMORTAL.
  *
  * pre-conditions:
  * o  parameter str must not be NULL upon entry
@@ -272,12 +786,17 @@ uint_t intstr_count (void);
 
 void intstr_retain (intstr_t str);
 
+#if (INTSTR_IMMORTAL)
+#define intstr_retain(_str) ((void) (_str))
+#endif
+
 
 /* --------------------------------------------------------------------------
  * function intstr_release(str)
  * --------------------------------------------------------------------------
  * Cancels an outstanding retain, or deallocates str if there are no
- * outstanding retains.
+ * outstanding retains.  Expands to a no-op if the library is built with
+ * INTSTR_IMMORTAL.
  *
  * pre-conditions:
  * o  parameter str must not be NULL upon entry
@@ -292,6 +811,10 @@ void intstr_retain (intstr_t str);
 
 void intstr_release (intstr_t str);
 
+#if (INTSTR_IMMORTAL)
+#define intstr_release(_str) ((void) (_str))
+#endif
+
 
 #endif /* INTSTR_H */
 
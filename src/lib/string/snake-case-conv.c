@@ -42,10 +42,10 @@
  * ----------------------------------------------------------------------- */
 
 #include "snake-case-conv.h"
-#include "compiler-options.h"
-#include "hash.h"
+#include "m2c-compiler-options.h"
+#include "m2c-mem-account.h"
 
-#include <stdlib.h> /* NULL, malloc */
+#include <stdlib.h> /* NULL, malloc, calloc, free */
 
 
 /* --------------------------------------------------------------------------
@@ -64,10 +64,24 @@
 
 
 /* --------------------------------------------------------------------------
- * Default size for dictionary
+ * Default size for dictionary,  must be a power of two
  * ----------------------------------------------------------------------- */
 
-#define SNAKE_DICT_DEFAULT_BUCKET_COUNT 2011
+#define SNAKE_DICT_DEFAULT_SLOT_COUNT 2048
+
+
+/* --------------------------------------------------------------------------
+ * Maximum load factor of the dictionary in percent,  grows when exceeded
+ * ----------------------------------------------------------------------- */
+
+#define SNAKE_DICT_MAX_LOAD_PERCENT 75
+
+
+/* --------------------------------------------------------------------------
+ * Lowercase conversion
+ * ----------------------------------------------------------------------- */
+
+#define TO_LOWER(_ch) (IS_UPPER(_ch) ? ((_ch) + 32) : (_ch))
 
 
 /* --------------------------------------------------------------------------
@@ -368,71 +382,54 @@ static uint8_t required_length_for_snake_case (const word_map_t *map) {
 
 
 /* --------------------------------------------------------------------------
- * private type snake_xlat_t
+ * private function new_xlat_for_ident(ident)
  * --------------------------------------------------------------------------
- * pointer to record representing a translation.
+ * Returns a newly allocated string  with the snake-case representation of
+ * ident.  The length of the translation is limited to SNAKE_LENGTH_LIMIT.
+ * Returns NULL if ident is malformed or allocation failed.
  * ----------------------------------------------------------------------- */
 
-typedef snake_xlat_s *snake_xlat_t;
-
-typdef struct {
-  uint_t length;
-  char ident[];
-} snake_xlat_s;
-
-
-/* --------------------------------------------------------------------------
- * private function new_xlat_entry(ident)
- * --------------------------------------------------------------------------
- * Returns a newly allocated translation entry  with the snake-case represen-
- * tation of ident.  The length of the translation string is limited to value
- * XLAT_LENGTH_LIMIT.  Returns NULL, if ident is malformed.
- * ----------------------------------------------------------------------- */
-
-static snake_xlat_t new_xlat_entry (const char *ident) {
+static char *new_xlat_for_ident (const char *ident) {
   
-  uint8_t word_count, word_index, word_delim, xlat_len;
-  snake_xlat_t new_xlat;
+  uint8_t word_count, word_index, xlat_len;
+  uint_t src_index, tgt_index, word_delim;
+  char *new_xlat;
   word_map_t map;
   
   get_word_map_for_ident(ident, &map);
-
-  word_count = map->word_count;
-
+  
+  word_count = map.word_count;
+  
   if (word_count == 0) {
     return NULL;
   }; /* end if */
-    
+  
   xlat_len = required_length_for_snake_case(&map);
-  if xlat_len > XLAT_LENGTH_LIMIT {
-    xlat_len = XLAT_LENGTH_LIMIT
+  if (xlat_len > SNAKE_LENGTH_LIMIT) {
+    xlat_len = SNAKE_LENGTH_LIMIT;
+  }; /* end if */
+  
+  new_xlat = m2c_mem_alloc(M2C_MEM_SNAKE_DICT, xlat_len + 1);
+  
+  if (new_xlat == NULL) {
+    return NULL;
   }; /* end if */
-  new_xlat = malloc(sizeof(snake_xlat_s) + xlat_len + 1);
-
-  new_xlat->length = xlat_len;
-
-  /* copy first word */
-  tgt_index = 0;
-  src_index = 0;
-  word_delim = map->word[0].len
-  while ((src_index < word_delim) && (tgt_index < XLAT_LENGTH_LIMIT)) {
-    new_xlat->ident[tgt_index] = to_lower(ident[src_index]);
-    tgt_index++;
-    src_index++;
-  }; /* end while */
   
+  tgt_index = 0;
   word_index = 0;
   
   while (word_index < word_count) {
-    /* append lowline */
-    new_xlat->ident[tgt_index] = '_';
-    tgt_index++;
+    /* append lowline before all but the first word */
+    if ((word_index > 0) && (tgt_index < xlat_len)) {
+      new_xlat[tgt_index] = '_';
+      tgt_index++;
+    }; /* end if */
     
-    /* copy word at index */
-    src_index = map->word[word_index].pos;
-    word_delim = src_index + map->word[word_index].len;
-    while ((src_index < word_delim) && (tgt_index < XLAT_LENGTH_LIMIT)) {
-      new_xlat[tgt_index] = to_lower(ident[src_index]);
+    /* copy word at index in lowercase */
+    src_index = map.word[word_index].pos;
+    word_delim = src_index + map.word[word_index].len;
+    while ((src_index < word_delim) && (tgt_index < xlat_len)) {
+      new_xlat[tgt_index] = TO_LOWER(ident[src_index]);
       tgt_index++;
       src_index++;
     }; /* end while */
@@ -440,71 +437,50 @@ static snake_xlat_t new_xlat_entry (const char *ident) {
     /* next word */
     word_index++;
   }; /* end while */
-
+  
   /* terminate string */
-  new_xlat->ident[tgt_index] = ASCII_NUL;
+  new_xlat[tgt_index] = ASCII_NUL;
   
   return new_xlat;
-}; /* end new_xlat_entry */
+}; /* end new_xlat_for_ident */
 
 
 /* --------------------------------------------------------------------------
- * private type snake_dict_entry_t
+ * private type snake_dict_entry_s
  * --------------------------------------------------------------------------
- * pointer to record representing a dictionary entry.
+ * record representing a dictionary entry.  Entries are stored inline in the
+ * slot array of the dictionary,  an entry with a NULL ident is free.
  * ----------------------------------------------------------------------- */
 
-typedef struct snake_dict_entry_s *snake_dict_entry_t;
-
 typedef struct {
-  snake_hash_t key;
-  uint_t length;
-  char *ident;
-  snake_xlat_t xlat;
+  intstr_t ident;
+  char *xlat;
   uint_t ref_count;
-  snake_dict_entry_t next;
 } snake_dict_entry_s;
 
-
-/* --------------------------------------------------------------------------
- * private function new_dict_entry(key, ident, length, xlat)
- * --------------------------------------------------------------------------
- * Returns a newly allocated and initialised dictionary entry.
- * ----------------------------------------------------------------------- */
-
-static snake_dict_entry_t new_dict_entry
-  (snake_hash_t key, const char *ident, uint_t length, snake_xlat_t xlat) {
-  
-  snake_dict_entry_t new_entry;
-  
-  new_entry = malloc(sizeof(snake_dict_entry_s));
-  
-  new_entry->key = key;
-  new_entry->length = length;
-  new_entry->ident = ident;
-  new_entry->xlat = xlat;
-  new_entry->ref_count = 1;
-  new_entry->next = NULL;
-
-  return new_entry;
-} /* end new_dict_entry */
+typedef snake_dict_entry_s *snake_dict_entry_t;
 
 
 /* --------------------------------------------------------------------------
  * private type snake_dict_t
  * --------------------------------------------------------------------------
- * pointer to record representing the dictionary.
+ * pointer to record representing the dictionary.  The dictionary is an open
+ * addressing table keyed on the interned identifier.  It is probed linearly
+ * from the slot given by the key cached in the identifier and compares
+ * identifiers by pointer,  so that no identifier is ever hashed or compared
+ * character by character.  Its slot count is a power of two and doubles
+ * whenever the load factor would exceed SNAKE_DICT_MAX_LOAD_PERCENT.
  * ----------------------------------------------------------------------- */
 
-typedef struct snake_dict_s *snake_dict_t;
-
 typedef struct {
   uint_t entry_count;
-  uint_t bucket_count;
+  uint_t slot_count;
   snake_status_t last_status;
-  snake_dict_entry_t bucket[];
+  snake_dict_entry_s *slot;
 } snake_dict_s;
 
+typedef snake_dict_s *snake_dict_t;
+
 
 /* --------------------------------------------------------------------------
  * private variable dictionary
@@ -515,15 +491,30 @@ typedef struct {
 static snake_dict_t dictionary = NULL;
 
 
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static snake_dict_entry_t entry_for_ident (intstr_t ident);
+
+static snake_dict_entry_t free_slot_for_ident (intstr_t ident);
+
+static bool grow_dictionary (void);
+
+static void remove_dict_entry (snake_dict_entry_t entry);
+
+
 /* --------------------------------------------------------------------------
  * procedure snake_init_dictionary()
  * --------------------------------------------------------------------------
- * Allocates and initialises the snake-case translation dictionary. 
+ * Allocates and initialises the snake-case translation dictionary.  The
+ * initial slot count is size rounded up to a power of two,  or the default
+ * if size is zero.
  * ----------------------------------------------------------------------- */
 
 void snake_init_dictionary (unsigned size, snake_status_t *status) {
   
-  uint_t index, bucket_count, allocation_size;
+  uint_t slot_count;
   
   /* check pre-conditions */
   if (dictionary != NULL) {
@@ -531,18 +522,19 @@ void snake_init_dictionary (unsigned size, snake_status_t *status) {
     return;
   } /* end if */
   
-  /* determine bucket count */
+  /* determine slot count */
   if (size == 0) {
-    bucket_count = SNAKE_DICT_DEFAULT_BUCKET_COUNT;
+    slot_count = SNAKE_DICT_DEFAULT_SLOT_COUNT;
   }
   else /* size != 0 */ {
-    bucket_count = size;
+    slot_count = 1;
+    while (slot_count < size) {
+      slot_count = 2 * slot_count;
+    } /* end while */
   } /* end if */
   
   /* allocate dictionary */
-  allocation_size = sizeof(snake_dict_s) +
-    bucket_count * sizeof(snake_dict_entry_t);
-  dictionary = malloc(allocation_size);
+  dictionary = m2c_mem_alloc(M2C_MEM_SNAKE_DICT, sizeof(snake_dict_s));
   
   /* bail out if allocation failed */
   if (dictionary == NULL) {
@@ -550,17 +542,22 @@ void snake_init_dictionary (unsigned size, snake_status_t *status) {
     return;
   } /* end if */
   
-  /* set entry and bucket count */
+  /* allocate cleared slots */
+  dictionary->slot = m2c_mem_calloc(M2C_MEM_SNAKE_DICT,
+    slot_count, sizeof(snake_dict_entry_s));
+  
+  if (dictionary->slot == NULL) {
+    m2c_mem_free(M2C_MEM_SNAKE_DICT, dictionary);
+    dictionary = NULL;
+    SET_STATUS(status, SNAKE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* set entry and slot count */
   dictionary->entry_count = 0;
-  dictionary->bucket_count = bucket_count;
+  dictionary->slot_count = slot_count;
+  dictionary->last_status = SNAKE_STATUS_SUCCESS;
   
-  /* initialise buckets */
-  index = 0;
-  while (index < bucket_count) {
-    dictionary->bucket[index] = NULL;
-    index++;
-  } /* end while */
-
   SET_STATUS(status, SNAKE_STATUS_SUCCESS);
   return;
 }; /* end snake_init_dictionary */
@@ -569,20 +566,17 @@ void snake_init_dictionary (unsigned size, snake_status_t *status) {
 /* --------------------------------------------------------------------------
  * function snake_case_for_ident(ident)
  * --------------------------------------------------------------------------
- * Returns the snake-case translation of ident,  or NULL if malformed.
+ * Returns the snake-case translation of ident,  or NULL if malformed.  The
+ * translation is computed on the first request for ident and memoized.
  * ----------------------------------------------------------------------- */
 
-const char* snake_case_for_ident (const char* ident) {
+const char* snake_case_for_ident (intstr_t ident) {
   
-  snake_dict_entry_t new_entry, this_entry;
-  char *new_string, this_string;
-  uint_t index, length;
-  snake_hash_t key;
-  char ch;
+  snake_dict_entry_t this_entry;
+  char *new_xlat;
   
   /* check dictionary */
   if (dictionary == NULL) {
-    dictionary->last_status = SNAKE_STATUS_NOT_INITIALIZED;
     return NULL;
   } /* end if */
   
@@ -592,84 +586,59 @@ const char* snake_case_for_ident (const char* ident) {
     return NULL;
   } /* end if */
   
-  /* determine length and key */
-  index = 0;
-  ch = ident[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = ident[index];
-  } /* end while */
-  
-  length = index + 1;
-  key = HASH_FINAL(key);
-  
-  /* determine bucket index */
-  index = key % dictionary->bucket_count;
+#if (SNAKE_XLAT_ON_INTSTR)
+  /* translation stored on the interned identifier */
+  if (intstr_xlat(ident) != NULL) {
+    dictionary->last_status = SNAKE_STATUS_SUCCESS;
+    return intstr_xlat(ident);
+  } /* end if */
+#endif
   
   /* check if ident is already in dictionary */
-  if /* bucket empty */ (dictionary->bucket[index] == NULL) {
-    
-    /* create a new translation entry */
-    new_xlat = new_xlat_entry(ident);
-    
-    /* create a new dictionary entry */
-    new_entry = new_dict_entry(key, ident, length, xlat);
-    
-    /* link the bucket to the new entry */
-    dictionary->bucket[index] = new_entry;
-    
-    /* update the entry counter */
-    dictionary->entry_count++;
-    
-    /* set status and return string object */
+  this_entry = entry_for_ident(ident);
+  
+  if (this_entry != NULL) {
     dictionary->last_status = SNAKE_STATUS_SUCCESS;
-    new_entry->ref_count++;
-    return new_entry->xlat->ident;
-  }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = dictionary->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          (this_entry->length == length &&)
-          strings_match(this_entry->ident, ident)) {
-        
-        /* set status and return translation string */
-        dictionary->last_status = SNAKE_STATUS_SUCCESS;
-        this_entry->ref_count++;
-        return this_entry->xlat->ident;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        /* create a new translation entry */
-        new_xlat = new_xlat_entry(ident);
-        
-        /* create a new dictionary entry */
-        new_entry = new_dict_entry(key, ident, length, xlat);
-        
-        /* link last entry to the new entry */
-        this_entry->next = new_entry;
-        
-        /* update the entry counter */
-        dictionary->entry_count++;
-        
-        /* set status and return string object */
-        dictionary->last_status = SNAKE_STATUS_SUCCESS;
-        new_entry->ref_count++;
-        return new_entry->xlat->ident;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */    
+    return this_entry->xlat;
+  } /* end if */
+  
+  /* make room for a new entry */
+  if ((dictionary->entry_count + 1) * 100 >
+      dictionary->slot_count * SNAKE_DICT_MAX_LOAD_PERCENT) {
+    if (NOT(grow_dictionary())) {
+      dictionary->last_status = SNAKE_STATUS_ALLOCATION_FAILED;
+      return NULL;
+    } /* end if */
+  } /* end if */
+  
+  /* compute the translation */
+  if (intstr_length(ident) > IDENT_LENGTH_LIMIT) {
+    dictionary->last_status = SNAKE_STATUS_SIZE_LIMIT_EXCEEDED;
+    return NULL;
+  } /* end if */
+  
+  new_xlat = new_xlat_for_ident(intstr_char_ptr(ident));
+  
+  if (new_xlat == NULL) {
+    dictionary->last_status = SNAKE_STATUS_INVALID_REFERENCE;
+    return NULL;
+  } /* end if */
+  
+  /* enter it into the dictionary */
+  this_entry = free_slot_for_ident(ident);
+  this_entry->ident = ident;
+  this_entry->xlat = new_xlat;
+  this_entry->ref_count = 1;
+  
+  /* update the entry counter */
+  dictionary->entry_count++;
+  
+#if (SNAKE_XLAT_ON_INTSTR)
+  intstr_set_xlat(ident, new_xlat);
+#endif
+  
+  dictionary->last_status = SNAKE_STATUS_SUCCESS;
+  return new_xlat;
 }; /* end snake_case_for_ident */
 
 
@@ -689,109 +658,32 @@ uint_t snake_entry_count (void) {
 }; /* end snake_entry_count */
 
 
-static snake_dict_entry_t entry_for_ident
-  (const char* ident, snake_status_t *status) {
-
-  snake_dict_entry_t this_entry;
-  uint_t index, length;
-  snake_hash_t key;
-  char ch;
-  
-  /* check dictionary */
-  if (dictionary == NULL) {
-    SET_STATUS(status, SNAKE_STATUS_NOT_INITIALIZED);
-    return NULL;
-  } /* end if */
-  
-  /* check ident */
-  if (ident == NULL) {
-    SET_STATUS(status, SNAKE_STATUS_INVALID_REFERENCE);
-    return NULL;
-  } /* end if */
-  
-  /* determine length and key */
-  index = 0;
-  ch = ident[index];
-  key = HASH_INITIAL;
-  while (ch != ASCII_NUL) {
-    key = HASH_NEXT_CHAR(key, ch);
-    index++;
-    ch = ident[index];
-  } /* end while */
-  
-  length = index + 1;
-  key = HASH_FINAL(key);
-  
-  /* determine bucket index */
-  index = key % dictionary->bucket_count;
-  
-  /* check if ident is already in dictionary */
-  if /* bucket empty */ (dictionary->bucket[index] == NULL) {
-    
-    SET_STATUS(status, SNAKE_STATUS_INVALID_REFERENCE);
-    return NULL;
-   }
-  else /* bucket not empty */ {
-    
-    /* first entry in bucket is starting point */
-    this_entry = dictionary->bucket[index];
-    
-    /* search bucket for matching string */
-    while (true) {
-      if /* match found in current entry */
-        ((this_entry->key == key) &&
-          (this_entry->length == length &&)
-          strings_match(this_entry->ident, ident)) {
-        
-        SET_STATUS(status, SNAKE_STATUS_SUCCESS);
-        return this_entry;
-      }
-      else if /* last entry reached without match */
-        (this_entry->next == NULL) {
-        
-        SET_STATUS(status, SNAKE_STATUS_INVALID_REFERENCE);
-        return NULL;
-      }
-      else /* not last entry yet, move to next entry */ {
-        this_entry = this_entry->next;
-      } /* end if */
-    } /* end while */      
-  } /* end if */    
-} /* end entry_for_ident */
-
-
 /* --------------------------------------------------------------------------
  * procedure snake_retain_entry(ident)
  * --------------------------------------------------------------------------
  * Prevents the dictionary entry for ident from deallocation.
  * ----------------------------------------------------------------------- */
 
-void snake_retain_entry (const char *ident) {
+void snake_retain_entry (intstr_t ident) {
   
-  snake_status_t status;
-
-  this_entry = entry_for_ident(ident, &status);
-  dictionary->last_status = status;
+  snake_dict_entry_t this_entry;
   
-  if (this_entry != NULL) {
-    this_entry->ref_count++;
+  if (dictionary == NULL) {
+    return;
   } /* end if */
+  
+  this_entry = entry_for_ident(ident);
+  
+  if (this_entry == NULL) {
+    dictionary->last_status = SNAKE_STATUS_INVALID_REFERENCE;
+    return;
+  } /* end if */
+  
+  this_entry->ref_count++;
+  dictionary->last_status = SNAKE_STATUS_SUCCESS;
 }; /* end snake_retain_entry */
 
 
-/* --------------------------------------------------------------------------
- * private procedure remove_dict_entry(entry)
- * --------------------------------------------------------------------------
- * Removes entry from the dictionary and deallocates it. 
- * ----------------------------------------------------------------------- */
-
-void remove_dict_entry (snake_dict_entry_t entry) {
-
-  /* TO DO */
-
-} /* remove_dict_entry */
-
-
 /* --------------------------------------------------------------------------
  * procedure snake_release_entry()
  * --------------------------------------------------------------------------
@@ -799,21 +691,29 @@ void remove_dict_entry (snake_dict_entry_t entry) {
  * retains,  deallocates the entry for ident.
  * ----------------------------------------------------------------------- */
 
-void snake_release_entry (const char *ident) {
+void snake_release_entry (intstr_t ident) {
   
   snake_dict_entry_t this_entry;
-  snake_status_t status;
-
-  this_entry = entry_for_ident(ident, &status);
-  dictionary->last_status = status;
   
-  if (this_entry != NULL) {
-    if (this_entry->ref_count > 1) {}
-      this_entry->ref_count--;
+  if (dictionary == NULL) {
+    return;
+  } /* end if */
+  
+  this_entry = entry_for_ident(ident);
+  
+  if (this_entry == NULL) {
+    dictionary->last_status = SNAKE_STATUS_INVALID_REFERENCE;
+    return;
+  } /* end if */
+  
+  if (this_entry->ref_count > 1) {
+    this_entry->ref_count--;
   }
   else /* ref_count <= 1 */ {
     remove_dict_entry(this_entry);
   } /* end if */
+  
+  dictionary->last_status = SNAKE_STATUS_SUCCESS;
 }; /* end snake_release_entry */
 
 
@@ -838,14 +738,164 @@ snake_status_t snake_last_status (void) {
 /* --------------------------------------------------------------------------
  * procedure snake_dealloc_dictionary()
  * --------------------------------------------------------------------------
- * Deallocates the dictionary. 
+ * Deallocates the dictionary and all its translations.  Translations stored
+ * on interned identifiers are cleared.
  * ----------------------------------------------------------------------- */
 
 void snake_dealloc_dictionary (snake_status_t *status) {
   
-  /* TO DO */
+  uint_t index;
+  
+  if (dictionary == NULL) {
+    SET_STATUS(status, SNAKE_STATUS_NOT_INITIALIZED);
+    return;
+  } /* end if */
+  
+  index = 0;
+  while (index < dictionary->slot_count) {
+    if (dictionary->slot[index].ident != NULL) {
+#if (SNAKE_XLAT_ON_INTSTR)
+      intstr_set_xlat(dictionary->slot[index].ident, NULL);
+#endif
+      m2c_mem_free(M2C_MEM_SNAKE_DICT, dictionary->slot[index].xlat);
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  m2c_mem_free(M2C_MEM_SNAKE_DICT, dictionary->slot);
+  m2c_mem_free(M2C_MEM_SNAKE_DICT, dictionary);
+  dictionary = NULL;
   
+  SET_STATUS(status, SNAKE_STATUS_SUCCESS);
+  return;
 }; /* end snake_dealloc_dictionary */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* --------------------------------------------------------------------------
+ * private function entry_for_ident(ident)
+ * --------------------------------------------------------------------------
+ * Returns the dictionary entry for ident,  or NULL if there is none.
+ * ----------------------------------------------------------------------- */
+
+static snake_dict_entry_t entry_for_ident (intstr_t ident) {
+  
+  uint_t index, mask;
+  
+  if (ident == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = dictionary->slot_count - 1;
+  index = intstr_hash(ident) & mask;
+  
+  while (dictionary->slot[index].ident != NULL) {
+    if (dictionary->slot[index].ident == ident) {
+      return &(dictionary->slot[index]);
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return NULL;
+} /* end entry_for_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function free_slot_for_ident(ident)
+ * --------------------------------------------------------------------------
+ * Returns the first free slot probed from the slot given by the key of ident.
+ * There must be a free slot.
+ * ----------------------------------------------------------------------- */
+
+static snake_dict_entry_t free_slot_for_ident (intstr_t ident) {
+  
+  uint_t index, mask;
+  
+  mask = dictionary->slot_count - 1;
+  index = intstr_hash(ident) & mask;
+  
+  while (dictionary->slot[index].ident != NULL) {
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return &(dictionary->slot[index]);
+} /* end free_slot_for_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_dictionary()
+ * --------------------------------------------------------------------------
+ * Doubles the slot count of the dictionary and reenters all its entries.
+ * Returns false if allocation failed,  leaving the dictionary unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_dictionary (void) {
+  
+  snake_dict_entry_s *old_slot;
+  uint_t index, old_slot_count;
+  
+  old_slot = dictionary->slot;
+  old_slot_count = dictionary->slot_count;
+  
+  dictionary->slot = m2c_mem_calloc(M2C_MEM_SNAKE_DICT,
+    2 * old_slot_count, sizeof(snake_dict_entry_s));
+  
+  if (dictionary->slot == NULL) {
+    dictionary->slot = old_slot;
+    return false;
+  } /* end if */
+  
+  dictionary->slot_count = 2 * old_slot_count;
+  
+  index = 0;
+  while (index < old_slot_count) {
+    if (old_slot[index].ident != NULL) {
+      *free_slot_for_ident(old_slot[index].ident) = old_slot[index];
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  m2c_mem_free(M2C_MEM_SNAKE_DICT, old_slot);
+  return true;
+} /* end grow_dictionary */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure remove_dict_entry(entry)
+ * --------------------------------------------------------------------------
+ * Removes entry from the dictionary and deallocates its translation.  Later
+ * entries of the same probe sequence are shifted back into the vacated slot
+ * so that lookups need no deletion markers.
+ * ----------------------------------------------------------------------- */
+
+static void remove_dict_entry (snake_dict_entry_t entry) {
+  
+  uint_t hole, index, home, mask;
+  
+#if (SNAKE_XLAT_ON_INTSTR)
+  intstr_set_xlat(entry->ident, NULL);
+#endif
+  m2c_mem_free(M2C_MEM_SNAKE_DICT, entry->xlat);
+  
+  mask = dictionary->slot_count - 1;
+  hole = (uint_t) (entry - dictionary->slot);
+  index = (hole + 1) & mask;
+  
+  while (dictionary->slot[index].ident != NULL) {
+    home = intstr_hash(dictionary->slot[index].ident) & mask;
+    
+    /* move the entry if the hole lies between its home slot and its slot */
+    if (((index - home) & mask) >= ((index - hole) & mask)) {
+      dictionary->slot[hole] = dictionary->slot[index];
+      hole = index;
+    } /* end if */
+    
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  dictionary->slot[hole].ident = NULL;
+  dictionary->slot[hole].xlat = NULL;
+  dictionary->slot[hole].ref_count = 0;
+  dictionary->entry_count--;
+} /* remove_dict_entry */
+
+/* END OF FILE */
@@ -40,6 +40,22 @@
 #ifndef SNAKE_CASE_CONV_H
 #define SNAKE_CASE_CONV_H
 
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Translations stored on interned identifiers
+ * --------------------------------------------------------------------------
+ * Define SNAKE_XLAT_ON_INTSTR as 1 to store each translation on its interned
+ * identifier as well,  so that repeated requests for the same identifier
+ * are answered from the identifier without probing the dictionary.  The
+ * translation slot of interned strings must then not be used otherwise.
+ * ----------------------------------------------------------------------- */
+
+#ifndef SNAKE_XLAT_ON_INTSTR
+#define SNAKE_XLAT_ON_INTSTR 0
+#endif
+
 
 /* --------------------------------------------------------------------------
  * type snake_status_t
@@ -60,7 +76,9 @@ typedef enum {
 /* --------------------------------------------------------------------------
  * procedure snake_init_dictionary()
  * --------------------------------------------------------------------------
- * Allocates and initialises the snake-case translation dictionary. 
+ * Allocates and initialises the snake-case translation dictionary  with an
+ * initial capacity of size entries,  or a default if size is zero.  The
+ * dictionary grows as needed.
  * ----------------------------------------------------------------------- */
 
 void snake_init_dictionary (unsigned size, snake_status_t *status);
@@ -69,10 +87,12 @@ void snake_init_dictionary (unsigned size, snake_status_t *status);
 /* --------------------------------------------------------------------------
  * function snake_case_for_ident(ident)
  * --------------------------------------------------------------------------
- * Returns the snake-case translation of ident,  or NULL if malformed.
+ * Returns the snake-case translation of ident,  or NULL if malformed.  The
+ * translation of an identifier is computed once and kept in the dictionary
+ * until the dictionary entry for the identifier is released.
  * ----------------------------------------------------------------------- */
 
-const char* snake_case_for_ident (const char* ident);
+const char* snake_case_for_ident (intstr_t ident);
 
 
 /* --------------------------------------------------------------------------
@@ -90,7 +110,7 @@ uint_t snake_entry_count (void);
  * Prevents the dictionary entry for ident from deallocation.
  * ----------------------------------------------------------------------- */
 
-void snake_retain_entry (const char *ident);
+void snake_retain_entry (intstr_t ident);
 
 
 /* --------------------------------------------------------------------------
@@ -100,7 +120,7 @@ void snake_retain_entry (const char *ident);
  * retains,  deallocates the entry for ident.
  * ----------------------------------------------------------------------- */
 
-void snake_release_entry (const char *ident);
+void snake_release_entry (intstr_t ident);
 
 
 /* --------------------------------------------------------------------------
@@ -48,7 +48,7 @@
 
 
 /* --------------------------------------------------------------------------
- * type m2c_astnode_type_t
+ * type m2c_ast_nodetype_t
  * --------------------------------------------------------------------------
  * Enumerated values representing AST node types.
  * ----------------------------------------------------------------------- */
@@ -88,10 +88,11 @@ typedef enum {
   AST_PROCDECL,         /* procedure declaration */
   AST_UNQ,              /* unqualified alias definition */
   AST_TODO,             /* to do entry */
+  AST_DECL,             /* keyed top-level declaration */
   
   /* Type Constructor Node Types */
   
-  AST_ALIAS             /* alias type */
+  AST_ALIAS,            /* alias type */
   AST_SUBR,             /* subrange type */
   AST_ENUM,             /* enumeration type */
   AST_SET,              /* set type node */
@@ -219,6 +220,7 @@ typedef enum {
   AST_IDENT,            /* identifier */
   AST_FILENAME,         /* module file name */
   AST_KEY,              /* module key */
+  AST_DECLKEY,          /* declaration key */
   
   /* Literal Value Node Types */
   
@@ -231,12 +233,13 @@ typedef enum {
   
   AST_IDENTLIST,        /* identifier list */
   AST_QUALIDENT,        /* qualified identifier */
+  AST_LAZYBODY,         /* unparsed statement sequence */
   
   /* Enumeration Terminator */
   
   AST_END_MARK   /* marks the end of this enumeration */
   
-} m2c_astnode_type_t;
+} m2c_ast_nodetype_t;
 
 
 /* --------------------------------------------------------------------------
@@ -256,7 +259,7 @@ typedef enum {
 #define AST_LAST_TERMINAL AST_QUOTEDVAL
 
 #define AST_FIRST_TERMINAL_LIST AST_IDENTLIST
-#define AST_LAST_TERMINAL_LIST AST_QUALIDENT
+#define AST_LAST_TERMINAL_LIST AST_LAZYBODY
 
 #define AST_FIRST_EXPRESSION AST_EXPR
 #define AST_LAST_EXPRESSION AST_STRUCT
@@ -343,7 +346,7 @@ typedef enum {
  * ----------------------------------------------------------------------- */
 
 #define AST_IS_LIST_NODETYPE(_type) \
-  ((AST_IS_NONTERMINAL_LIST_NODETYPE(_type)) ||
+  ((AST_IS_NONTERMINAL_LIST_NODETYPE(_type)) || \
    (AST_IS_TERMINAL_LIST_NODETYPE(_type)))
 
 
@@ -0,0 +1,173 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-ast-writer.h                                                          *
+ *                                                                           *
+ * Interface for streaming AST dump writers.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_AST_WRITER_H
+#define M2C_AST_WRITER_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "outfile.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * AST dumps
+ * --------------------------------------------------------------------------
+ * An AST is dumped either in S-expression format or as a graph in graphviz
+ * DOT format.  Both writers walk the tree iteratively  and stream their
+ * output into a buffered outfile as they go,  thus neither the depth nor the
+ * size of the tree is limited by the C stack or by memory for the output.
+ *
+ * Nodes of a flat tree are identified in a DOT graph by their position in
+ * the flat tree,  see m2c_ast_flat_node_pos,  other nodes by the order in
+ * which they are reached.  A depth limit cuts off the dump below a given
+ * depth,  a node at the limit is written by its node type followed by an
+ * ellipsis.  To dump a single definition,  its subtree is looked up first
+ * with m2c_ast_find_subtree.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_writer_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for AST dump operations.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_AST_WRITER_STATUS_SUCCESS,
+  M2C_AST_WRITER_STATUS_INVALID_REFERENCE,
+  M2C_AST_WRITER_STATUS_IO_ERROR,
+  M2C_AST_WRITER_STATUS_ALLOCATION_FAILED
+} m2c_ast_writer_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_find_subtree(root, ident)
+ * --------------------------------------------------------------------------
+ * Returns the first definition in the tree rooted at root  that defines
+ * identifier ident,  in pre-order,  or NULL if there is none.  Constant,
+ * type,  variable and procedure definitions and procedure declarations are
+ * searched.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_find_subtree (m2c_astnode_t root, intstr_t ident);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_write_sexpr(outfile, flat, root, max_depth, status)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to outfile in S-expression format,  one
+ * node per line,  indented by depth.  Values are written as quoted strings.
+ * If max_depth is not zero,  nodes at depth max_depth are not expanded,  the
+ * root is at depth zero.  Parameter flat is the flat tree root belongs to,
+ * or NULL,  it is accepted for symmetry with m2c_ast_write_dot.
+ *
+ * pre-conditions:
+ * o  outfile must be open
+ *
+ * post-conditions:
+ * o  the tree has been written to outfile
+ * o  M2C_AST_WRITER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if outfile or root is NULL, M2C_AST_WRITER_STATUS_INVALID_REFERENCE,
+ *    if the traversal stack could not be allocated,
+ *    M2C_AST_WRITER_STATUS_ALLOCATION_FAILED,  if writing failed,
+ *    M2C_AST_WRITER_STATUS_IO_ERROR is passed back in status, unless NULL
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_write_sexpr
+  (outfile_t outfile,                 /* in */
+   m2c_ast_flat_t flat,               /* in */
+   m2c_astnode_t root,                /* in */
+   uint_t max_depth,                  /* in */
+   m2c_ast_writer_status_t *status);  /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_write_dot(outfile, flat, root, max_depth, status)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to outfile as a directed graph in DOT
+ * format,  each node followed by the edge from its parent.  If flat is not
+ * NULL and root is a node of flat,  nodes are identified by their position
+ * in flat,  otherwise by the order in which they are reached.  Parameter
+ * max_depth and failures are as for m2c_ast_write_sexpr.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_write_dot
+  (outfile_t outfile,                 /* in */
+   m2c_ast_flat_t flat,               /* in */
+   m2c_astnode_t root,                /* in */
+   uint_t max_depth,                  /* in */
+   m2c_ast_writer_status_t *status);  /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_write_tree(path, root)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to a file at path in S-expression format,
+ * applying the dump filters of options --dump-depth and --dump-subtree.  The
+ * tree is flattened first,  if that fails it is written as is.  Returns true
+ * on success,  false otherwise.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_write_tree (const char *path, m2c_astnode_t root);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_draw_tree(path, root)
+ * --------------------------------------------------------------------------
+ * Writes the tree rooted at root to a file at path in DOT format,  applying
+ * the dump filters as m2c_ast_write_tree.  Nodes are identified by their
+ * position in the flattened tree.  Returns true on success,  false otherwise.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_draw_tree (const char *path, m2c_astnode_t root);
+
+
+#endif /* M2C_AST_WRITER_H */
+
+/* END OF FILE */
@@ -48,6 +48,8 @@
 #include "interned-strings.h"
 #include "m2c-ast-nodetype.h"
 
+#include <stddef.h>
+
 
 /* --------------------------------------------------------------------------
  * opaque type m2c_astnode_t
@@ -58,6 +60,285 @@
 typedef struct m2c_astnode_struct_t *m2c_astnode_t;
 
 
+/* --------------------------------------------------------------------------
+ * opaque type m2c_ast_region_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a storage region for AST nodes.  While a
+ * region is set as the current region,  all node constructors allocate from
+ * it.  Its nodes are deallocated all at once when the region is released,
+ * typically one region per compilation unit after code generation.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ast_region_struct_t *m2c_ast_region_t;
+
+
+/* --------------------------------------------------------------------------
+ * Default block size of AST regions
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_REGION_DEFAULT_BLOCK_SIZE (32 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Thread safety
+ * --------------------------------------------------------------------------
+ * Define M2C_AST_THREAD_SAFE as 1 to keep the current region per thread,
+ * so that threads may build ASTs in regions of their own at the same time.
+ * A region must only be used by one thread at a time.  This requires
+ * compiler support for thread local storage.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_AST_THREAD_SAFE
+#define M2C_AST_THREAD_SAFE 0
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_region(block_size)
+ * --------------------------------------------------------------------------
+ * Returns a new empty AST region whose nodes are allocated in blocks of at
+ * least block_size bytes,  or NULL on failure.  If block_size is zero,  value
+ * M2C_AST_REGION_DEFAULT_BLOCK_SIZE is used.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_region_t m2c_ast_new_region (size_t block_size);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_set_region(region)
+ * --------------------------------------------------------------------------
+ * Makes region the current region from which node constructors allocate.
+ * Passing NULL reverts to individually allocated nodes.  If built with
+ * M2C_AST_THREAD_SAFE,  the setting applies to the calling thread only.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_set_region (m2c_ast_region_t region);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_current_region()
+ * --------------------------------------------------------------------------
+ * Returns the current region of the calling thread,  or NULL if none is set.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_region_t m2c_ast_current_region (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_region_node_count(region)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes allocated from region.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_ast_region_node_count (m2c_ast_region_t region);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_region_set_hash_consing(region, enabled)
+ * --------------------------------------------------------------------------
+ * Enables or disables hash-consing for region.  While enabled and region is
+ * the current region,  node constructors return an existing node of region
+ * in place of a new one if it has the same node type and the same subnodes
+ * or values,  so that structurally identical subtrees are shared.  Shared
+ * nodes live as long as their region and cannot be modified.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_region_set_hash_consing (m2c_ast_region_t region, bool enabled);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_region_shared_node_count(region)
+ * --------------------------------------------------------------------------
+ * Returns the number of node constructions in region that were satisfied by
+ * an existing node because hash-consing was enabled.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_ast_region_shared_node_count (m2c_ast_region_t region);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_region_reset(region)
+ * --------------------------------------------------------------------------
+ * Deallocates all nodes allocated from region  but keeps the region and its
+ * most recent block for reuse,  so that a region  that is filled and reset
+ * repeatedly does not allocate again after the first fill.  All nodes of
+ * region become invalid,  counters and the hash-consing table are cleared.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_region_reset (m2c_ast_region_t region);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_region(region)
+ * --------------------------------------------------------------------------
+ * Deallocates region and all nodes allocated from it in one pass over its
+ * blocks,  regardless of the number of nodes.  All nodes of region become
+ * invalid.  If region is the current region,  no region is current after.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_region (m2c_ast_region_t region);
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_ast_flat_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a flat copy of an AST.  Its nodes are
+ * stored contiguously in post-order and refer to their subnodes by 32-bit
+ * distance instead of by pointer.  Nodes of a flat tree are read with the
+ * same accessors as regular nodes,  but they cannot be modified.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ast_flat_struct_t *m2c_ast_flat_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flatten(root)
+ * --------------------------------------------------------------------------
+ * Returns a new flat copy of the AST rooted at root,  or NULL on failure.
+ * Subtrees shared within the AST are copied once per reference.  The AST
+ * itself is not modified.
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_flat_t m2c_ast_flatten (m2c_astnode_t root);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_root(flat)
+ * --------------------------------------------------------------------------
+ * Returns the root node of flat,  or NULL if flat is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_flat_root (m2c_ast_flat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_node_count(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes stored in flat.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_ast_flat_node_count (m2c_ast_flat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_size(flat)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes occupied by the nodes and values of flat.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_ast_flat_size (m2c_ast_flat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_node_pos(flat, node)
+ * --------------------------------------------------------------------------
+ * Returns the position of node within flat,  or zero if node is not a node
+ * of flat.  Positions are stable across writing and reading AST files and
+ * may be used to refer to nodes of a flat tree from outside of it.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2c_ast_flat_node_pos (m2c_ast_flat_t flat, m2c_astnode_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_flat_node_at(flat, pos)
+ * --------------------------------------------------------------------------
+ * Returns the node at position pos within flat,  or NULL if pos is outside
+ * of flat or does not hold a node header.  Only pos values obtained from
+ * m2c_ast_flat_node_pos for the same tree are guaranteed to be nodes.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_flat_node_at (m2c_ast_flat_t flat, uint32_t pos);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_release_flat(flat)
+ * --------------------------------------------------------------------------
+ * Deallocates flat.  All nodes of flat become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_release_flat (m2c_ast_flat_t flat);
+
+
+/* --------------------------------------------------------------------------
+ * AST file format version
+ * --------------------------------------------------------------------------
+ * Version of the binary AST file format,  incremented whenever the layout
+ * of AST files or the list of AST node types changes.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_AST_FILE_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_file_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on binary AST files.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_AST_FILE_STATUS_SUCCESS,
+  M2C_AST_FILE_STATUS_INVALID_REFERENCE,
+  M2C_AST_FILE_STATUS_IO_ERROR,
+  M2C_AST_FILE_STATUS_INVALID_FILE,
+  M2C_AST_FILE_STATUS_ALLOCATION_FAILED
+} m2c_ast_file_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ast_write_file(flat, path, status)
+ * --------------------------------------------------------------------------
+ * Writes flat to a binary AST file at path,  replacing any existing file.
+ * The nodes are written in their in-memory layout,  values as strings.
+ *
+ * pre-conditions:
+ * o  flat must be a valid flat tree
+ * o  path must be a valid pathname
+ *
+ * post-conditions:
+ * o  flat has been written to path
+ * o  M2C_AST_FILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if flat or path is NULL, M2C_AST_FILE_STATUS_INVALID_REFERENCE,
+ *    if the file could not be written, M2C_AST_FILE_STATUS_IO_ERROR
+ *    is passed back in status, unless NULL,  and no file is left at path
+ * ----------------------------------------------------------------------- */
+
+void m2c_ast_write_file
+  (m2c_ast_flat_t flat, const char *path, m2c_ast_file_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_read_file(path, status)
+ * --------------------------------------------------------------------------
+ * Reads a binary AST file at path and returns its tree as a flat tree,  or
+ * NULL on failure.  On hosts that provide mmap(),  the file is mapped into
+ * memory and its nodes are used in place,  only values are interned.  Files
+ * written by a build for a different host type or with a different format
+ * version are rejected.
+ *
+ * pre-conditions:
+ * o  path must be a valid pathname
+ * o  the global string repository must be initialised
+ *
+ * post-conditions:
+ * o  a flat tree with the contents of the file is returned
+ * o  M2C_AST_FILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if path is NULL, M2C_AST_FILE_STATUS_INVALID_REFERENCE,
+ *    if the file could not be read, M2C_AST_FILE_STATUS_IO_ERROR,
+ *    if the file is not a valid AST file for this build,
+ *    M2C_AST_FILE_STATUS_INVALID_FILE,  if allocation failed,
+ *    M2C_AST_FILE_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL,  and NULL is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_ast_flat_t m2c_ast_read_file
+  (const char *path, m2c_ast_file_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_empty_node()
  * --------------------------------------------------------------------------
@@ -92,6 +373,63 @@ m2c_astnode_t m2c_ast_new_node
   (m2c_ast_nodetype_t node_type, ...);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node1(node_type, subnode0)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with one subnode and
+ * returns the node,  or NULL on failure.  Unlike m2c_ast_new_node,  it takes
+ * a fixed number of subnodes and does not process a variable argument list.
+ * Node type and arity are only validated in builds without NDEBUG defined,
+ * where a mismatch yields NULL.  Subnodes are stored as passed,  even NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node1
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node2(node_type, subnode0, subnode1)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with two subnodes and
+ * returns the node,  or NULL on failure.  As m2c_ast_new_node1.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node2
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0,
+   m2c_astnode_t subnode1);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node3(node_type, subnode0, subnode1, subnode2)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with three subnodes and
+ * returns the node,  or NULL on failure.  As m2c_ast_new_node1.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node3
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0,
+   m2c_astnode_t subnode1,
+   m2c_astnode_t subnode2);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_new_node4(node_type, subnode0, subnode1, subnode2, subnode3)
+ * --------------------------------------------------------------------------
+ * Allocates a new branch node of the given node type with four subnodes and
+ * returns the node,  or NULL on failure.  As m2c_ast_new_node1.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_ast_new_node4
+  (m2c_ast_nodetype_t node_type,
+   m2c_astnode_t subnode0,
+   m2c_astnode_t subnode1,
+   m2c_astnode_t subnode2,
+   m2c_astnode_t subnode3);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_ast_new_list_node(node_type, node_list)
  * --------------------------------------------------------------------------
@@ -111,7 +449,7 @@ m2c_astnode_t m2c_ast_new_list_node
  * ----------------------------------------------------------------------- */
 
 m2c_astnode_t m2c_ast_new_terminal_node
-  (m2c_ast_nodetype_t type, intstr_t value);
+  (m2c_ast_nodetype_t node_type, intstr_t value);
 
 
 /* --------------------------------------------------------------------------
@@ -178,6 +516,7 @@ intstr_t m2c_ast_value_at_index
  * function m2c_ast_replace_subnode(in_node, at_index, with_subnode)
  * --------------------------------------------------------------------------
  * Replaces a subnode and returns the replaced node,  or NULL on failure.
+ * Nodes of flat trees and nodes shared by hash-consing cannot be modified.
  * ----------------------------------------------------------------------- */
 
 m2c_astnode_t m2c_ast_replace_subnode
@@ -188,6 +527,7 @@ m2c_astnode_t m2c_ast_replace_subnode
  * function m2c_ast_replace_value(in_node, at_index, with_value)
  * --------------------------------------------------------------------------
  * Replaces a value and returns the replaced value,  or NULL on failure.
+ * Nodes of flat trees and nodes shared by hash-consing cannot be modified.
  * ----------------------------------------------------------------------- */
 
 intstr_t m2c_ast_replace_value
@@ -197,12 +537,60 @@ intstr_t m2c_ast_replace_value
 /* --------------------------------------------------------------------------
  * function m2c_ast_release_node(node)
  * --------------------------------------------------------------------------
- * Deallocates node. 
+ * Deallocates node.  Has no effect on nodes allocated from a region  and on
+ * nodes of flat trees.
  * ----------------------------------------------------------------------- */
 
 void m2c_ast_release_node (m2c_astnode_t node);
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_ast_visit_action_t
+ * --------------------------------------------------------------------------
+ * Actions returned by visitor callbacks to steer a traversal.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_AST_VISIT_CONTINUE,  /* continue traversal */
+  M2C_AST_VISIT_SKIP,      /* from pre: skip subnodes and post of the node */
+  M2C_AST_VISIT_STOP       /* end traversal */
+} m2c_ast_visit_action_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ast_visitor_f
+ * --------------------------------------------------------------------------
+ * Visitor callback type,  called with the visited node  and the context
+ * passed to m2c_ast_visit.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_ast_visit_action_t (*m2c_ast_visitor_f)
+  (m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ast_visit(root, pre, post, context)
+ * --------------------------------------------------------------------------
+ * Traverses the tree rooted at root depth-first,  subnodes left to right,
+ * calling pre before and post after the subnodes of each node are visited.
+ * Either callback may be NULL.  NULL subnodes are not visited,  the empty
+ * node is.  The traversal uses an explicit stack on the heap,  so the depth
+ * of the tree is not limited by the C stack.  Subtrees shared by more than
+ * one parent are visited once per parent.
+ *
+ * Nodes are reached in the order the parser allocates them,  subnodes before
+ * their parents,  so post callbacks walk region storage  and flat trees in
+ * ascending address order.
+ *
+ * Returns true if the traversal completed,  false if a callback returned
+ * M2C_AST_VISIT_STOP or the stack could not be allocated.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_ast_visit
+  (m2c_astnode_t root,
+   m2c_ast_visitor_f pre, m2c_ast_visitor_f post, void *context);
+
+
 #endif /* M2C_AST_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -9,6 +9,15 @@
 #define M2C_MAX_INFILE_LINES 12000
 #define M2C_MAX_INFILE_COLUMNS 160
 
+/* infile streaming parameters, both must be powers of two */
+
+#define M2C_INFILE_CHUNK_SIZE 4096
+#define M2C_INFILE_CHUNK_COUNT 4
+
+/* outfile parameters */
+
+#define M2C_OUTFILE_BUFFER_SIZE 65536
+
 /* lexical parameters */
 
 #define M2C_MAX_IDENT_LENGTH 64
@@ -16,11 +25,28 @@
 #define M2C_MAX_STRING_LENGTH 160
 #define M2C_MAX_COMMENT_LENGTH 4096
 
+/* syntax error recovery parameters */
+
+#define M2C_MAX_SKIPPED_SYMBOLS 256  /* per resync, outside of panic mode */
+#define M2C_MAX_SYNTAX_ERRORS 64     /* reported before panic mode */
+
+/* parser engine of m2c_check_syntax, 0 = recursive descent, 1 = LL(1) table */
+
+#ifndef M2C_PARSER_ENGINE_LL1
+#define M2C_PARSER_ENGINE_LL1 0
+#endif
+
 /* code generation parameters */
 
 #define M2C_MAX_C_MACRO_LENGTH 64
 #define M2C_MAX_C_IDENT_LENGTH 64
 
+/* CASE translation, a label set is dense if its labels cover at least
+   M2C_CASE_MIN_DENSITY percent of a span of at most M2C_CASE_MAX_SPAN */
+
+#define M2C_CASE_MAX_SPAN 1024
+#define M2C_CASE_MIN_DENSITY 40
+
 
 #endif /* M2C_BUILD_PARAMS_H */
 
@@ -0,0 +1,209 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-case-codegen.h                                                        *
+ *                                                                           *
+ * Interface for translation of CASE statements.                             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_CASE_CODEGEN_H
+#define M2C_CASE_CODEGEN_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-const-fold.h"
+#include "outfile.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Translation of CASE statements
+ * --------------------------------------------------------------------------
+ * The labels of a CASE statement are folded to whole numbers,  ranges kept
+ * as intervals,  sorted and checked for overlaps.  The translation is then
+ * chosen by the density of the labels,  the share of the span from least to
+ * greatest label that is covered by labels:
+ *
+ * o  dense labels without wide ranges become a C switch statement with one
+ *    case label per value,  which the C compiler turns into a jump table,
+ * o  dense labels with wide ranges become an explicit table that maps each
+ *    value of the span to its branch,  followed by a switch on the branch,
+ * o  sparse labels become a binary search over the sorted intervals that
+ *    selects the branch,  followed by a switch on the branch.
+ *
+ * In all three cases the selector is evaluated once and each statement
+ * sequence is written once.  Thresholds are in m2c-build-params.h.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_case_strategy_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing translation strategies for CASE.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_CASE_SWITCH,        /* C switch with a case label per value */
+  M2C_CASE_JUMP_TABLE,    /* table lookup of the branch, then switch */
+  M2C_CASE_RANGE_SEARCH   /* binary search of the branch, then switch */
+} m2c_case_strategy_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_case_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for CASE analysis.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_CASE_STATUS_SUCCESS,
+  M2C_CASE_STATUS_INVALID_REFERENCE,
+  M2C_CASE_STATUS_NONCONST_LABEL,
+  M2C_CASE_STATUS_DUPLICATE_LABEL,
+  M2C_CASE_STATUS_ALLOCATION_FAILED
+} m2c_case_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_case_plan_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the analysis of a CASE statement.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_case_plan_struct_t *m2c_case_plan_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_case_label_resolver_f
+ * --------------------------------------------------------------------------
+ * Type of a function that passes back the ordinal value of case label node
+ * label in value and returns true,  or returns false if label does not
+ * denote a constant.  Called for labels the constant folder cannot fold,
+ * such as enumerated values.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_case_label_resolver_f)
+  (m2c_astnode_t label, void *context, int64_t *value);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_case_node_writer_f
+ * --------------------------------------------------------------------------
+ * Type of a function that writes the C translation of node to outfile,  an
+ * expression for the selector,  a statement sequence for a branch.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_case_node_writer_f)
+  (outfile_t outfile, m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_case_plan(switch_node, folder, resolver, context, status)
+ * --------------------------------------------------------------------------
+ * Analyses the labels of CASE statement node switch_node  and returns a plan
+ * for its translation.  Labels are folded with folder,  labels it cannot
+ * fold are passed to resolver with context,  unless resolver is NULL.
+ *
+ * astnode: (SWITCH exprNode (CASELIST caseBranchNode+) elseBranchNode)
+ *
+ * pre-conditions:
+ * o  switch_node must be a SWITCH node
+ * o  folder must have bound the constants of the enclosing module
+ *
+ * post-conditions:
+ * o  a new plan is returned
+ * o  M2C_CASE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if switch_node is NULL or not a SWITCH node or folder is NULL,
+ *    M2C_CASE_STATUS_INVALID_REFERENCE,  if a label is not constant,
+ *    M2C_CASE_STATUS_NONCONST_LABEL,  if labels overlap,
+ *    M2C_CASE_STATUS_DUPLICATE_LABEL,  if allocation failed,
+ *    M2C_CASE_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL,  and NULL is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_case_plan_t m2c_new_case_plan
+  (m2c_astnode_t switch_node,               /* in */
+   m2c_const_fold_t folder,                 /* in */
+   m2c_case_label_resolver_f resolver,      /* in */
+   void *context,                           /* in */
+   m2c_case_status_t *status);              /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_case_plan_strategy(plan)
+ * --------------------------------------------------------------------------
+ * Returns the translation strategy chosen for plan.
+ * ----------------------------------------------------------------------- */
+
+m2c_case_strategy_t m2c_case_plan_strategy (m2c_case_plan_t plan);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_case(outfile, plan, writer, context)
+ * --------------------------------------------------------------------------
+ * Writes the C translation of the CASE statement of plan to outfile  by the
+ * strategy of plan,  calling writer with context for the selector and for
+ * each statement sequence.  If the CASE statement has no ELSE branch,  the
+ * default branch is written as a call of M2C_CASE_NO_MATCH(),  a runtime
+ * error handler the generated code is expected to define.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_case
+  (outfile_t outfile,                       /* in */
+   m2c_case_plan_t plan,                    /* in */
+   m2c_case_node_writer_f writer,           /* in */
+   void *context);                          /* in */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_case_plan(plan)
+ * --------------------------------------------------------------------------
+ * Deallocates plan.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_case_plan (m2c_case_plan_t plan);
+
+
+#endif /* M2C_CASE_CODEGEN_H */
+
+/* END OF FILE */
@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-char-class.h                                                          *
+ *                                                                           *
+ * Public interface of character class table.                                *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_CHAR_CLASS_H
+#define M2C_CHAR_CLASS_H
+
+
+/* --------------------------------------------------------------------------
+ * Character class flags
+ * --------------------------------------------------------------------------
+ * Each entry of the character class table is a set of the flags below.
+ * Characters with codes above 127 have no flags set.
+ * ----------------------------------------------------------------------- */
+
+#define CC_UPPER   0x01 /* 'A' .. 'Z' */
+#define CC_LOWER   0x02 /* 'a' .. 'z' */
+#define CC_DIGIT   0x04 /* '0' .. '9' */
+#define CC_HEX     0x08 /* 'A' .. 'F' */
+#define CC_LOWLINE 0x10 /* '_' */
+#define CC_SPACE   0x20 /* space, tab, line feed, carriage return */
+#define CC_CTRL    0x40 /* 0x00 .. 0x1F, 0x7F */
+#define CC_PRINT   0x80 /* 0x20 .. 0x7E */
+
+
+/* --------------------------------------------------------------------------
+ * Character class table
+ * --------------------------------------------------------------------------
+ * Constant 256-entry table, indexed by character code.
+ * ----------------------------------------------------------------------- */
+
+extern const unsigned char m2c_char_class[256];
+
+
+/* --------------------------------------------------------------------------
+ * Character class tests
+ * --------------------------------------------------------------------------
+ * Each test is a single table lookup and mask operation.  The argument is
+ * converted to unsigned char,  thus characters above 127 index the table
+ * correctly whether or not type char is signed.
+ * ----------------------------------------------------------------------- */
+
+#define CHAR_CLASS(_ch) \
+  (m2c_char_class[(unsigned char) (_ch)])
+
+#define CHAR_HAS_CLASS(_ch, _flags) \
+  ((CHAR_CLASS(_ch) & (_flags)) != 0)
+
+#define IS_UPPER_LETTER(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_UPPER)
+
+#define IS_LOWER_LETTER(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_LOWER)
+
+#define IS_DECIMAL_DIGIT(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_DIGIT)
+
+#define IS_BASE16_DIGIT(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_DIGIT | CC_HEX)
+
+#define IS_LETTER_OR_DIGIT(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_UPPER | CC_LOWER | CC_DIGIT)
+
+#define IS_IDENT_TAIL_CHAR(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_UPPER | CC_LOWER | CC_DIGIT | CC_LOWLINE)
+
+#define IS_WHITESPACE(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_SPACE)
+
+#define IS_CTRL_CHAR(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_CTRL)
+
+#define IS_PRINTABLE_CHAR(_ch) \
+  CHAR_HAS_CLASS(_ch, CC_PRINT)
+
+#define IS_LEGAL_CTRL_CHAR(_ch) \
+  ((CHAR_CLASS(_ch) & (CC_CTRL | CC_SPACE)) == (CC_CTRL | CC_SPACE))
+
+#define IS_ILLEGAL_CTRL_CHAR(_ch) \
+  ((CHAR_CLASS(_ch) & (CC_CTRL | CC_SPACE)) == CC_CTRL)
+
+
+#endif /* M2C_CHAR_CLASS_H */
+
+/* END OF FILE */
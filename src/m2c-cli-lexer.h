@@ -89,7 +89,16 @@ typedef enum {
   CLI_TOKEN_LOWLINE_IDENTIFIERS,     /* --lowline-identifiers */
   CLI_TOKEN_NO_LOWLINE_IDENTIFIERS,  /* --no-lowline-identifiers */
   
-  /* source file argument */
+  /* build options */
+  
+  CLI_TOKEN_UNITY,                   /* --unity */
+  CLI_TOKEN_NO_UNITY,                /* --no-unity */
+  CLI_TOKEN_CACHE,                   /* --cache */
+  CLI_TOKEN_NO_CACHE,                /* --no-cache */
+  CLI_TOKEN_EXLB,                    /* --exlb */
+  CLI_TOKEN_NO_EXLB,                 /* --no-exlb */
+  
+  /* source file or @response file argument */
   
   CLI_TOKEN_SOURCE_FILE,
   
@@ -100,6 +109,18 @@ typedef enum {
   CLI_TOKEN_PARSER_DEBUG,            /* --parser-debug */
   CLI_TOKEN_SHOW_SETTINGS,           /* --show-settings */
   CLI_TOKEN_ERRANT_SEMICOLONS,       /* --errant-semicolons */
+  CLI_TOKEN_INTSTR_STATS,            /* --intstr-stats */
+  CLI_TOKEN_PARSER_PROFILE,          /* --parser-profile */
+  CLI_TOKEN_TIME_REPORT,             /* --time-report */
+  CLI_TOKEN_TELEMETRY,               /* --telemetry */
+  CLI_TOKEN_MEM_REPORT,              /* --mem-report */
+  CLI_TOKEN_PERF_COUNTERS,           /* --perf-counters */
+  CLI_TOKEN_MAX_ERRORS,              /* --max-errors */
+  CLI_TOKEN_MAX_WARNINGS,            /* --max-warnings */
+  CLI_TOKEN_TRACE,                   /* --trace */
+  CLI_TOKEN_DUMP_DEPTH,              /* --dump-depth */
+  CLI_TOKEN_DUMP_SUBTREE,            /* --dump-subtree */
+  CLI_TOKEN_WORKER_CACHE,            /* --worker-cache */
   
   /* end of input sentinel */
   
@@ -133,8 +154,11 @@ typedef enum {
 #define CLI_FIRST_CAPABILITY_OPTION_TOKEN CLI_TOKEN_DOLLAR_IDENTIFIERS
 #define CLI_LAST_CAPABILITY_OPTION_TOKEN CLI_TOKEN_NO_LOWLINE_IDENTIFIERS
 
+#define CLI_FIRST_BUILD_OPTION_TOKEN CLI_TOKEN_UNITY
+#define CLI_LAST_BUILD_OPTION_TOKEN CLI_TOKEN_NO_EXLB
+
 #define CLI_FIRST_DIAGNOSTICS_OPTION_TOKEN CLI_TOKEN_VERBOSE
-#define CLI_LAST_DIAGNOSTICS_OPTION_TOKEN CLI_TOKEN_ERRANT_SEMICOLONS
+#define CLI_LAST_DIAGNOSTICS_OPTION_TOKEN CLI_TOKEN_WORKER_CACHE
 
 
 /* ---------------------------------------------------------------------------
@@ -214,6 +238,17 @@ typedef enum {
   && (_token <= CLI_LAST_CAPABILITY_OPTION_TOKEN))
 
 
+/* ---------------------------------------------------------------------------
+ * macro CLI_IS_BUILD_OPTION(token)
+ * ---------------------------------------------------------------------------
+ * Returns true if token represents a build option, else false.
+ * ------------------------------------------------------------------------ */
+
+#define CLI_IS_BUILD_OPTION(_token) \
+  ((_token >= CLI_FIRST_BUILD_OPTION_TOKEN) \
+  && (_token <= CLI_LAST_BUILD_OPTION_TOKEN))
+
+
 /* ---------------------------------------------------------------------------
  * macro CLI_IS_DIAGNOSTICS_OPTION(token)
  * ---------------------------------------------------------------------------
@@ -70,12 +70,33 @@ cli_parser_status_t cli_parse_args (void);
 /* ---------------------------------------------------------------------------
  * function cli_source_file()
  * ---------------------------------------------------------------------------
- * Returns a string with the source file argument.
+ * Returns a string with the first source file argument.
  * ------------------------------------------------------------------------ */
 
 m2c_string_t cli_source_file (void);
 
 
+/* ---------------------------------------------------------------------------
+ * function cli_source_file_count()
+ * ---------------------------------------------------------------------------
+ * Returns the number of source file arguments.  Each argument of the form
+ * @path names a response file listing one source file per line,  its entries
+ * are counted in place of the argument itself.
+ * ------------------------------------------------------------------------ */
+
+uint_t cli_source_file_count (void);
+
+
+/* ---------------------------------------------------------------------------
+ * function cli_source_file_at(index)
+ * ---------------------------------------------------------------------------
+ * Returns the source file argument at index in order of appearance on the
+ * command line,  or NULL if index is out of range.
+ * ------------------------------------------------------------------------ */
+
+const char *cli_source_file_at (uint_t index);
+
+
 /* ---------------------------------------------------------------------------
  * function cli_error_count()
  * ---------------------------------------------------------------------------
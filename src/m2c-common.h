@@ -186,6 +186,30 @@ typedef double m2c_longreal_t;
 #endif
 
 
+/* --------------------------------------------------------------------------
+ * Verify M2C_INFILE_CHUNK_SIZE
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_INFILE_CHUNK_SIZE)
+#error "no value defined for M2C_INFILE_CHUNK_SIZE"
+#elif ((M2C_INFILE_CHUNK_SIZE & (M2C_INFILE_CHUNK_SIZE - 1)) != 0)
+#error "value of M2C_INFILE_CHUNK_SIZE must be a power of two"
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Verify M2C_INFILE_CHUNK_COUNT
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_INFILE_CHUNK_COUNT)
+#error "no value defined for M2C_INFILE_CHUNK_COUNT"
+#elif ((M2C_INFILE_CHUNK_COUNT & (M2C_INFILE_CHUNK_COUNT - 1)) != 0)
+#error "value of M2C_INFILE_CHUNK_COUNT must be a power of two"
+#elif (M2C_INFILE_CHUNK_COUNT < 2)
+#error "value of M2C_INFILE_CHUNK_COUNT must be at least 2"
+#endif
+
+
 /* --------------------------------------------------------------------------
  * Verify M2C_MAX_IDENT_LENGTH
  * ----------------------------------------------------------------------- */
@@ -213,6 +237,25 @@ typedef double m2c_longreal_t;
 #endif
 
 
+/* --------------------------------------------------------------------------
+ * Verify M2C_MAX_COMMENT_LENGTH
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_MAX_COMMENT_LENGTH)
+#error "no value defined for M2C_MAX_COMMENT_LENGTH"
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Verify streaming ring holds the longest lexeme plus lookahead
+ * ----------------------------------------------------------------------- */
+
+#if (((M2C_INFILE_CHUNK_COUNT - 1) * M2C_INFILE_CHUNK_SIZE) < \
+     (M2C_MAX_COMMENT_LENGTH + 2))
+#error "infile chunk ring too small for M2C_MAX_COMMENT_LENGTH"
+#endif
+
+
 /* --------------------------------------------------------------------------
  * Verify M2C_MAX_C_MACRO_LENGTH
  * ----------------------------------------------------------------------- */
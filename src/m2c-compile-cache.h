@@ -0,0 +1,253 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-compile-cache.h                                                       *
+ *                                                                           *
+ * Public interface of local compile cache module.                           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_COMPILE_CACHE_H
+#define M2C_COMPILE_CACHE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-digest.h"
+#include "m2c-compiler-options.h"
+#include "interned-strings.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Content addressed compile cache
+ * --------------------------------------------------------------------------
+ * With option --cache,  the outputs of compiling a module are stored in a
+ * cache directory under a key computed from everything they depend on:  the
+ * contents of the source file,  the compiler option settings that affect
+ * output,  the compiler version,  and the identifiers and effective interface
+ * fingerprints of all imported modules.  Before compiling a module,  m2c
+ * computes its key,  and if the cache holds an entry for the key,  copies
+ * the outputs of the entry into place  and skips lexing,  parsing and code
+ * generation entirely.  Switching between branches thus restores outputs
+ * instead of rebuilding them,  no matter what the modification times are.
+ *
+ * Each entry is a directory named by the key in hexadecimal,  below a
+ * subdirectory named by the first two digits,  holding one file per output.
+ * Entries are written under a temporary name and renamed into place,  thus
+ * concurrent compilers never see a partial entry.  Entries are never
+ * modified,  the cache is cleared by deleting the cache directory.
+ *
+ * The key is a 128-bit hash,  not the 32-bit token digest of the lexer,
+ * which is too short to rule out collisions over the lifetime of a cache.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Environment variable naming the cache directory
+ * ----------------------------------------------------------------------- */
+
+#define M2C_CACHE_DIR_ENV "M2C_CACHE_DIR"
+
+
+/* --------------------------------------------------------------------------
+ * Cache directory used if the environment variable is not set
+ * ----------------------------------------------------------------------- */
+
+#define M2C_CACHE_DEFAULT_DIR ".m2c-cache"
+
+
+/* --------------------------------------------------------------------------
+ * Version of the key derivation and entry layout
+ * ----------------------------------------------------------------------- */
+
+#define M2C_CACHE_FORMAT_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_cache_key_t
+ * --------------------------------------------------------------------------
+ * Record type for a cache key.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* high */  uint64_t high;
+  /* low */   uint64_t low;
+} m2c_cache_key_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_cache_output_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the outputs of compiling a module.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_CACHE_OUTPUT_C_SOURCE,     /* generated .c file */
+  M2C_CACHE_OUTPUT_C_HEADER,     /* generated .h file */
+  M2C_CACHE_OUTPUT_SYMFILE,      /* symbol file .sym */
+  M2C_CACHE_OUTPUT_EXPORT_LIST,  /* export list .exl */
+  M2C_CACHE_OUTPUT_EXPORT_TABLE, /* binary export list table .exlb */
+  M2C_CACHE_OUTPUT_OBJECT,       /* object file */
+  
+  /* Enumeration Terminator */
+  
+  M2C_CACHE_OUTPUT_END_MARK
+} m2c_cache_output_t;
+
+
+/* --------------------------------------------------------------------------
+ * Size of a buffer for the blob name of an output,  see m2c_cache_blob_name
+ * ----------------------------------------------------------------------- */
+
+#define M2C_CACHE_BLOB_NAME_SIZE 40
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_cache_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on the compile cache.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_CACHE_STATUS_SUCCESS,
+  M2C_CACHE_STATUS_INVALID_REFERENCE,
+  M2C_CACHE_STATUS_FILE_NOT_FOUND,
+  M2C_CACHE_STATUS_IO_ERROR,
+  M2C_CACHE_STATUS_ALLOCATION_FAILED
+} m2c_cache_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_cache_dir()
+ * --------------------------------------------------------------------------
+ * Returns the path of the cache directory,  the value of environment
+ * variable M2C_CACHE_DIR if it is set and not empty,  otherwise
+ * M2C_CACHE_DEFAULT_DIR.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_cache_dir (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_cache_module_key(srcpath, options, count, ..., key, status)
+ * --------------------------------------------------------------------------
+ * Computes the cache key of the module with source file srcpath,  compiled
+ * with option snapshot options,  importing the count modules in array
+ * import_id with effective interface fingerprints in array fingerprint,  in
+ * order of import,  and passes it in key.  Diagnostic options that do not
+ * affect output are ignored.  Passes M2C_CACHE_STATUS_FILE_NOT_FOUND in
+ * status if the source file cannot be read.
+ * ----------------------------------------------------------------------- */
+
+void m2c_cache_module_key
+  (const char *srcpath,                       /* in */
+   m2c_compiler_options_t options,            /* in */
+   uint_t count,                              /* in */
+   const intstr_t import_id[],                /* in */
+   const m2c_digest_value_t fingerprint[],    /* in */
+   m2c_cache_key_t *key,                      /* out */
+   m2c_cache_status_t *status);               /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_cache_fetch(cache_dir, key, output_path, status)
+ * --------------------------------------------------------------------------
+ * Looks up key in the cache at cache_dir.  Array output_path is indexed by
+ * m2c_cache_output_t.  If there is an entry that holds every output whose
+ * path in output_path is not NULL,  copies these outputs to their paths
+ * and returns true.  Returns false on a miss,  in which case no output is
+ * written.  Each output is copied under a temporary name and renamed into
+ * place.  Passes M2C_CACHE_STATUS_IO_ERROR in status if an output could not
+ * be written,  which is also reported as a miss.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_cache_fetch
+  (const char *cache_dir,                   /* in */
+   const m2c_cache_key_t *key,              /* in */
+   const char *const output_path[],         /* in */
+   m2c_cache_status_t *status);             /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_cache_store(cache_dir, key, output_path, status)
+ * --------------------------------------------------------------------------
+ * Stores the outputs whose path in array output_path is not NULL as a new
+ * entry for key in the cache at cache_dir,  creating directories as needed.
+ * An existing entry for key is left as is.  Passes the status of the
+ * operation in status,  a failure to store leaves the cache unchanged.
+ * ----------------------------------------------------------------------- */
+
+void m2c_cache_store
+  (const char *cache_dir,                   /* in */
+   const m2c_cache_key_t *key,              /* in */
+   const char *const output_path[],         /* in */
+   m2c_cache_status_t *status);             /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_cache_new_output_path(cache_dir, key, output)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path of the file holding output in the entry for
+ * key in the cache at cache_dir,  or NULL if allocation failed.  The file
+ * need not exist.  Entries are immutable,  the file may be read at any time
+ * while the cache exists.
+ * ----------------------------------------------------------------------- */
+
+char *m2c_cache_new_output_path
+  (const char *cache_dir,                   /* in */
+   const m2c_cache_key_t *key,              /* in */
+   m2c_cache_output_t output);              /* in */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_cache_blob_name(key, output, name)
+ * --------------------------------------------------------------------------
+ * Passes the name of output in the entry for key,  relative to the cache
+ * directory and without the fan-out directory,  in name,  which must have
+ * room for M2C_CACHE_BLOB_NAME_SIZE characters.  The name is of the form
+ * XXXX.../ext  and identifies the output in shared caches.
+ * ----------------------------------------------------------------------- */
+
+void m2c_cache_blob_name
+  (const m2c_cache_key_t *key, m2c_cache_output_t output, char *name);
+
+
+#endif /* M2C_COMPILE_CACHE_H */
+
+/* END OF FILE */
@@ -0,0 +1,245 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-compile-server.h                                                      *
+ *                                                                           *
+ * Public interface of resident compile server module.                       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_COMPILE_SERVER_H
+#define M2C_COMPILE_SERVER_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2-symfile.h"
+#include "m2c-search-path.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Resident compile server
+ * --------------------------------------------------------------------------
+ * A compile server is a long-lived m2c process that accepts compile requests
+ * from thin clients over a Unix domain socket and runs them one after the
+ * other within its own process.  Whatever the compiler initialises once per
+ * process,  the interned string repository,  lexeme and token set tables,
+ * the identifier translation cache,  thus stays warm across requests,  and
+ * so do the interfaces imported by earlier requests,  see function
+ * m2c_server_import_symfile.  The cost of a request is then that of its own
+ * module,  not of starting the compiler and reloading its imports.  The
+ * module search path is likewise kept across requests,  see function
+ * m2c_server_search_path.
+ *
+ * A client passes its working directory,  its arguments and its standard
+ * output and error streams to the server.  The server runs the request in
+ * the client's working directory with the client's streams,  thus requests
+ * behave exactly as if run by the client,  and passes back the exit code.
+ * If no server is running,  the client compiles in its own process.
+ *
+ * A server exits when it receives a shutdown request,  or when it has been
+ * idle for M2C_SERVER_IDLE_TIMEOUT seconds.  The socket is only accessible
+ * to the user who started the server.
+ *
+ * The server is available on POSIX hosts  if M2C_COMPILE_SERVER is 1.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_COMPILE_SERVER)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_COMPILE_SERVER 1
+#else
+#define M2C_COMPILE_SERVER 0
+#endif
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Environment variable holding the path of the server socket
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SERVER_SOCKET_ENV "M2C_SERVER_SOCKET"
+
+
+/* --------------------------------------------------------------------------
+ * Idle time in seconds after which a server exits
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SERVER_IDLE_TIMEOUT 1800
+
+
+/* --------------------------------------------------------------------------
+ * Version of the request protocol
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SERVER_PROTOCOL_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_server_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations of compile servers and clients.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_SERVER_STATUS_SUCCESS,
+  M2C_SERVER_STATUS_INVALID_REFERENCE,
+  M2C_SERVER_STATUS_NOT_AVAILABLE,
+  M2C_SERVER_STATUS_NOT_RUNNING,
+  M2C_SERVER_STATUS_ALREADY_RUNNING,
+  M2C_SERVER_STATUS_PATH_TOO_LONG,
+  M2C_SERVER_STATUS_PROTOCOL_ERROR,
+  M2C_SERVER_STATUS_IO_ERROR,
+  M2C_SERVER_STATUS_ALLOCATION_FAILED
+} m2c_server_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_server_handler_t
+ * --------------------------------------------------------------------------
+ * Type of the procedure a server calls to run a request.  It is called with
+ * the arguments of the client,  in the client's working directory  and with
+ * standard output and error redirected to those of the client.  It returns
+ * the exit code for the client.  A handler must return rather than exit and
+ * must leave no state behind that would affect the next request,  compiler
+ * options are reset by the server before each request.
+ * ----------------------------------------------------------------------- */
+
+typedef int (*m2c_server_handler_t)
+  (int argc, char *argv[], void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_socket_path()
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path of the server socket,  the value of
+ * environment variable M2C_SERVER_SOCKET if set,  otherwise a per-user path
+ * in the temporary directory.  Returns NULL if allocation failed or if the
+ * server is not available on this host.
+ * ----------------------------------------------------------------------- */
+
+char *m2c_server_socket_path (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_server_run(socket_path, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Listens on a Unix domain socket at socket_path  and runs each request it
+ * receives by calling handler with context,  until a shutdown request is
+ * received or the server has been idle for M2C_SERVER_IDLE_TIMEOUT seconds.
+ * A stale socket left by a server that has terminated is replaced.  Passes
+ * M2C_SERVER_STATUS_ALREADY_RUNNING in status  if another server is
+ * listening at socket_path.  Returns when the server terminates.
+ * ----------------------------------------------------------------------- */
+
+void m2c_server_run
+  (const char *socket_path,         /* in */
+   m2c_server_handler_t handler,    /* in */
+   void *context,                   /* in */
+   m2c_server_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_request(socket_path, argc, argv, exit_code, status)
+ * --------------------------------------------------------------------------
+ * Passes arguments argv to the server listening at socket_path  to be run
+ * in the current working directory with the standard output and error of
+ * the calling process,  and waits for the request to complete.  Returns
+ * true and passes the exit code of the request in exit_code on success.
+ * Returns false on failure,  passing M2C_SERVER_STATUS_NOT_RUNNING in status
+ * if no server is listening.  The caller should then run the request in
+ * its own process.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_server_request
+  (const char *socket_path,         /* in */
+   int argc,                        /* in */
+   char *argv[],                    /* in */
+   int *exit_code,                  /* out */
+   m2c_server_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_server_shutdown(socket_path, status)
+ * --------------------------------------------------------------------------
+ * Requests the server listening at socket_path to terminate.  The server
+ * completes the request it is running,  if any.
+ * ----------------------------------------------------------------------- */
+
+void m2c_server_shutdown
+  (const char *socket_path, m2c_server_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_import_symfile(path, status)
+ * --------------------------------------------------------------------------
+ * Returns the shared open symbol file for path like m2c_import_symfile.
+ * Within a server,  imported symbol files are kept open across requests,
+ * each with the modification time and size of its file,  and reopened only
+ * when the file has changed,  thus a later request importing the same
+ * interface finds it loaded.  Outside of a server,  the symbol file is
+ * released by its last holder as usual.  The caller must release it.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_server_import_symfile
+  (const char *path, m2c_symfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_server_search_path(dir_count, dirs, status)
+ * --------------------------------------------------------------------------
+ * Returns the module search path of the process for the dir_count
+ * directories in array dirs.  The search path is created on first use and
+ * kept,  later calls with the same directories refresh it,  relisting the
+ * directories only if one has changed,  see m2c-search-path.h.  Calls with
+ * other directories replace it.  Within a server it is thus kept across
+ * requests.  The search path is owned by the process and released when a
+ * server exits,  the caller must not release it.  Called once per compile
+ * request,  before any worker threads are started.  Returns NULL and passes
+ * the status in status on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_search_path_t m2c_server_search_path
+  (uint_t dir_count,                      /* in */
+   const char *const dirs[],              /* in */
+   m2c_search_path_status_t *status);     /* out */
+
+
+#endif /* M2C_COMPILE_SERVER_H */
+
+/* END OF FILE */
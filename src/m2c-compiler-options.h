@@ -40,6 +40,8 @@
 #ifndef M2C_COMPILER_OPTIONS_H
 #define M2C_COMPILER_OPTIONS_H
 
+#include "m2c-common.h"
+
 #include <stdbool.h>
 
 
@@ -58,6 +60,12 @@ typedef enum {
   M2C_COMPILER_OPTION_PARSER_DEBUG,        /* --parser-debug */
   M2C_COMPILER_OPTION_SHOW_SETTINGS,       /* --show-settings */
   M2C_COMPILER_OPTION_ERRANT_SEMICOLONS,   /* --errant-semicolons */
+  M2C_COMPILER_OPTION_INTSTR_STATS,        /* --intstr-stats */
+  M2C_COMPILER_OPTION_PARSER_PROFILE,      /* --parser-profile */
+  M2C_COMPILER_OPTION_TIME_REPORT,         /* --time-report */
+  M2C_COMPILER_OPTION_TELEMETRY,           /* --telemetry */
+  M2C_COMPILER_OPTION_MEM_REPORT,          /* --mem-report */
+  M2C_COMPILER_OPTION_PERF_COUNTERS,       /* --perf-counters */
 
   /* Build Product Options */
   
@@ -79,6 +87,22 @@ typedef enum {
   /* --lowline-identifiers, --no-lowline-identifiers */
   M2C_COMPILER_OPTION_LOWLINE_IDENTIFIERS,
 
+  /* Build Options */
+  
+  /* --unity, --no-unity */
+  M2C_COMPILER_OPTION_UNITY_BUILD,
+
+  /* --cache, --no-cache */
+  M2C_COMPILER_OPTION_COMPILE_CACHE,
+
+  /* --exlb, --no-exlb */
+  M2C_COMPILER_OPTION_BINARY_EXL,
+
+  /* Parser Options */
+  
+  /* set by m2c_parser_set_lazy_bodies(), no command line option */
+  M2C_COMPILER_OPTION_LAZY_BODIES,
+
   /* Enumeration Terminator */
 
   M2C_COMPILER_OPTION_END_MARK
@@ -86,6 +110,16 @@ typedef enum {
 } m2c_compiler_option_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_compiler_options_t
+ * --------------------------------------------------------------------------
+ * Value type representing a snapshot of all option settings,  one bit per
+ * option.  A snapshot is immutable and may be shared between threads.
+ * ----------------------------------------------------------------------- */
+
+typedef unsigned long m2c_compiler_options_t;
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_compiler_option_set(option, value)
  * ---------------------------------------------------------------------------
@@ -140,6 +174,60 @@ bool m2c_compiler_option_show_settings (void);
 bool m2c_compiler_option_errant_semicolons (void);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_intstr_stats()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --intstr-stats is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_intstr_stats (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_parser_profile()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --parser-profile is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_parser_profile (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_time_report()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --time-report is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_time_report (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_telemetry()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --telemetry is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_telemetry (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_mem_report()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --mem-report is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_mem_report (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_perf_counters()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --perf-counters is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_perf_counters (void);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_compiler_option_ast_required()
  * ---------------------------------------------------------------------------
@@ -203,6 +291,197 @@ bool m2c_compiler_option_lowline_identifiers (void);
 bool m2c_compiler_option_dollar_identifiers (void);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_unity_build()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --unity is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_unity_build (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_compile_cache()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --cache is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_compile_cache (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_binary_exl()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --exlb is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_binary_exl (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_lazy_bodies()
+ * ---------------------------------------------------------------------------
+ * Returns true if lazy parsing of bodies is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_option_lazy_bodies (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_max_errors(value)
+ * ---------------------------------------------------------------------------
+ * Sets the maximum number of errors reported per module,  option --max-errors.
+ * Once the limit is reached,  the remainder of the module is skipped.  Zero
+ * selects the default limit and recovery of the parser.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_max_errors (uint_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_max_errors()
+ * ---------------------------------------------------------------------------
+ * Returns the maximum number of errors reported per module,  or zero if
+ * option --max-errors is not given.  The limit is not part of option
+ * snapshots.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_compiler_option_max_errors (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_max_warnings(value)
+ * ---------------------------------------------------------------------------
+ * Sets the maximum number of warnings reported per module,  option
+ * --max-warnings.  Zero selects no limit.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_max_warnings (uint_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_max_warnings()
+ * ---------------------------------------------------------------------------
+ * Returns the maximum number of warnings reported per module,  or zero if
+ * option --max-warnings is not given.  The limit is not part of option
+ * snapshots.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_compiler_option_max_warnings (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_trace_path(path)
+ * ---------------------------------------------------------------------------
+ * Sets the path of the trace event file to be written,  option --trace.  The
+ * string is not copied,  it must remain valid.  NULL turns tracing off.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_trace_path (const char *path);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_trace_path()
+ * ---------------------------------------------------------------------------
+ * Returns the path of the trace event file,  or NULL if option --trace is
+ * not given.  The trace path is not part of option snapshots.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_compiler_option_trace_path (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_dump_depth(value)
+ * ---------------------------------------------------------------------------
+ * Sets the depth below which AST dumps are cut off,  option --dump-depth.
+ * Zero selects no limit.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_dump_depth (uint_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_dump_depth()
+ * ---------------------------------------------------------------------------
+ * Returns the depth below which AST dumps are cut off,  or zero if option
+ * --dump-depth is not given.  The depth is not part of option snapshots.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_compiler_option_dump_depth (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_dump_subtree(ident)
+ * ---------------------------------------------------------------------------
+ * Sets the identifier of the definition to which AST dumps are restricted,
+ * option --dump-subtree.  The string is not copied,  it must remain valid.
+ * NULL selects the whole tree.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_dump_subtree (const char *ident);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_dump_subtree()
+ * ---------------------------------------------------------------------------
+ * Returns the identifier of the definition to which AST dumps are restricted,
+ * or NULL if option --dump-subtree is not given.  The identifier is not part
+ * of option snapshots.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_compiler_option_dump_subtree (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_option_set_worker_cache(path)
+ * ---------------------------------------------------------------------------
+ * Sets the path of the string snapshot to be mapped at startup,  option
+ * --worker-cache.  The string is not copied,  it must remain valid.  NULL
+ * selects no snapshot.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_option_set_worker_cache (const char *path);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_option_worker_cache()
+ * ---------------------------------------------------------------------------
+ * Returns the path of the string snapshot to be mapped at startup,  or NULL
+ * if option --worker-cache is not given.  The path is not part of option
+ * snapshots.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_compiler_option_worker_cache (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_options_snapshot()
+ * ---------------------------------------------------------------------------
+ * Returns a snapshot of the current settings of all options.
+ * ----------------------------------------------------------------------- */
+
+m2c_compiler_options_t m2c_compiler_options_snapshot (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_compiler_options_reset()
+ * ---------------------------------------------------------------------------
+ * Restores the default settings of all options.
+ * ----------------------------------------------------------------------- */
+
+void m2c_compiler_options_reset (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_compiler_options_flag(options, option)
+ * ---------------------------------------------------------------------------
+ * Returns true if option is turned on in snapshot options, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_compiler_options_flag
+  (m2c_compiler_options_t options, m2c_compiler_option_t option);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_compiler_option_print_settings()
  * ---------------------------------------------------------------------------
@@ -212,6 +491,6 @@ bool m2c_compiler_option_dollar_identifiers (void);
 void m2c_compiler_option_print_settings (void);
 
 
-#endif M2C_COMPILER_OPTIONS_H
+#endif /* M2C_COMPILER_OPTIONS_H */
 
 /* END OF FILE */
\ No newline at end of file
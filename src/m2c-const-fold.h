@@ -0,0 +1,158 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-const-fold.h                                                          *
+ *                                                                           *
+ * Interface for memoizing folding of constant expressions in the AST.       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_CONST_FOLD_H
+#define M2C_CONST_FOLD_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-numeric-value.h"
+#include "interned-strings.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_const_fold_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a constant folder.  A folder caches the
+ * folded value of every node it has evaluated in a side table keyed by node,
+ * thus each constant definition is evaluated once,  not once per use.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_const_fold_struct_t *m2c_const_fold_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_const_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the kinds of folded values.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_CONST_NONE,   /* not constant, or not foldable */
+  M2C_CONST_WHOLE,  /* whole number */
+  M2C_CONST_REAL,   /* real number */
+  M2C_CONST_CHAR    /* character code */
+} m2c_const_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_const_value_t
+ * --------------------------------------------------------------------------
+ * Record type holding a folded value.  Whole numbers and character codes
+ * are held in field whole,  real numbers in field real.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  m2c_const_kind_t kind;
+  int64_t whole;
+  double real;
+} m2c_const_value_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_const_folder()
+ * --------------------------------------------------------------------------
+ * Returns a new constant folder with an empty cache,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_const_fold_t m2c_new_const_folder (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_const_fold_note_literal(folder, node, value)
+ * --------------------------------------------------------------------------
+ * Records value as the value of literal node,  as converted by the lexer,
+ * so that the literal is not converted from its lexeme again.  Called by
+ * the parser for each numeric literal node.  Has no effect if folder or node
+ * is NULL or value is not representable.
+ * ----------------------------------------------------------------------- */
+
+void m2c_const_fold_note_literal
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_numeric_value_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_const_fold_value(folder, node, value)
+ * --------------------------------------------------------------------------
+ * Folds the expression rooted at node,  passes the result in value and
+ * returns true if it is constant,  else passes a value of kind M2C_CONST_NONE
+ * and returns false.  Identifiers are resolved to the constant definitions
+ * bound by a prior call of m2c_fold_constants.  Results are cached.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_const_fold_value
+  (m2c_const_fold_t folder, m2c_astnode_t node, m2c_const_value_t *value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_fold_constants(folder, root)
+ * --------------------------------------------------------------------------
+ * Binds the constant definitions of the tree rooted at root,  then folds the
+ * expressions of constant definitions,  array value counts,  value ranges
+ * of subrange types and case labels  and replaces each folded expression
+ * that is not already a literal by a literal node.  Returns the number of
+ * replaced expressions.
+ *
+ * Constant identifiers defined more than once within root are not resolved.
+ * Negative whole numbers are replaced by a negated literal.  Nodes that
+ * cannot be modified,  such as nodes of flat trees,  are left unchanged.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_fold_constants (m2c_const_fold_t folder, m2c_astnode_t root);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_const_folder(folder)
+ * --------------------------------------------------------------------------
+ * Deallocates folder and its cache.  Replacement nodes remain valid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_const_folder (m2c_const_fold_t folder);
+
+
+#endif /* M2C_CONST_FOLD_H */
+
+/* END OF FILE */
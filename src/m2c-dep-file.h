@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-dep-file.h                                                            *
+ *                                                                           *
+ * Public interface of dependency file reader.                               *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_DEP_FILE_H
+#define M2C_DEP_FILE_H
+
+#include "m2c-common.h"
+
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Dependency files
+ * --------------------------------------------------------------------------
+ * The dependency file of module Foo is Foo.dep,  it lists the identifiers of
+ * the modules imported by Foo,  separated by white space.
+ *
+ * The binary dependency file Foo.depb holds the same list for tools that
+ * read many of them.  It starts with the four bytes "M2CD",  a version byte
+ * and three zero bytes,  followed by the number of identifiers as a 32-bit
+ * little endian integer,  then each identifier as its length in a 16-bit
+ * little endian integer and its characters.  The file is read in one piece
+ * and its identifiers are returned in a single array.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Suffix of dependency files
+ * ----------------------------------------------------------------------- */
+
+#define M2C_DEP_FILE_SUFFIX ".dep"
+
+#define M2C_DEP_BIN_FILE_SUFFIX ".depb"
+
+
+/* --------------------------------------------------------------------------
+ * Version of the binary dependency file format
+ * ----------------------------------------------------------------------- */
+
+#define M2C_DEP_BIN_FILE_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_dep_file_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on dependency files.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_DEP_FILE_STATUS_SUCCESS,
+  M2C_DEP_FILE_STATUS_INVALID_REFERENCE,
+  M2C_DEP_FILE_STATUS_FILE_NOT_FOUND,
+  M2C_DEP_FILE_STATUS_INVALID_FORMAT,
+  M2C_DEP_FILE_STATUS_WRITE_FAILED,
+  M2C_DEP_FILE_STATUS_ALLOCATION_FAILED
+} m2c_dep_file_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_read_dep_file(dep_dir, module_id, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Reads the dependency file of module_id in directory dep_dir,  passes the
+ * number of imports listed in count  and a newly allocated array with their
+ * identifiers in imports,  or NULL if there are none or on failure.  The
+ * caller deallocates the array with free().  The status of the operation is
+ * passed back in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_read_dep_file
+  (const char *dep_dir,              /* in */
+   intstr_t module_id,               /* in */
+   uint_t *count,                    /* out */
+   intstr_t **imports,               /* out */
+   m2c_dep_file_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_dep_file(dep_dir, module_id, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Writes the dependency file of module_id in directory dep_dir,  listing the
+ * count identifiers in array imports,  one per line.  An existing file with
+ * the same contents is left untouched  and keeps its modification time.  The
+ * status of the operation is passed back in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_dep_file
+  (const char *dep_dir,              /* in */
+   intstr_t module_id,               /* in */
+   uint_t count,                     /* in */
+   const intstr_t imports[],         /* in */
+   m2c_dep_file_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_read_dep_bin_file(dep_dir, module_id, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Reads the binary dependency file of module_id in directory dep_dir  like
+ * procedure m2c_read_dep_file.  Passes M2C_DEP_FILE_STATUS_INVALID_FORMAT
+ * in status if the file is truncated or of another version.
+ * ----------------------------------------------------------------------- */
+
+void m2c_read_dep_bin_file
+  (const char *dep_dir,              /* in */
+   intstr_t module_id,               /* in */
+   uint_t *count,                    /* out */
+   intstr_t **imports,               /* out */
+   m2c_dep_file_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_dep_bin_file(dep_dir, module_id, count, imports, ...)
+ * --------------------------------------------------------------------------
+ * Writes the binary dependency file of module_id in directory dep_dir  like
+ * procedure m2c_write_dep_file.  An existing file with the same contents is
+ * left untouched.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_dep_bin_file
+  (const char *dep_dir,              /* in */
+   intstr_t module_id,               /* in */
+   uint_t count,                     /* in */
+   const intstr_t imports[],         /* in */
+   m2c_dep_file_status_t *status);   /* out */
+
+
+#endif /* M2C_DEP_FILE_H */
+
+/* END OF FILE */
@@ -0,0 +1,285 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-diagnostics.h                                                         *
+ *                                                                           *
+ * Public interface of per-module diagnostic buffer.                         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_DIAGNOSTICS_H
+#define M2C_DIAGNOSTICS_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "infile.h"
+#include "m2c-common.h"
+#include "interned-strings.h"
+
+#include <stdio.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Diagnostic buffers
+ * --------------------------------------------------------------------------
+ * A diagnostic buffer collects the errors and warnings reported for one
+ * module while it is lexed and parsed.  When the buffer is flushed,  its
+ * diagnostics are sorted by source position,  the source lines they refer
+ * to are fetched from the source file in a single pass,  and the whole
+ * report is written with a single call.  Reports of modules compiled in
+ * parallel thus do not interleave.
+ *
+ * Each thread has a current buffer into which the emit procedures of the
+ * error reporter add their diagnostics.  While a thread has no current
+ * buffer,  diagnostics are written immediately.
+ *
+ * A buffer may limit the number of errors and warnings it stores.  The
+ * first diagnostic past a limit is replaced by a note  and all further
+ * diagnostics of that severity are discarded,  emitters may then skip
+ * composing their messages altogether,  see m2c_diag_accepts.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Thread safety
+ * --------------------------------------------------------------------------
+ * Define M2C_DIAG_THREAD_SAFE as 1 to keep the current buffer per thread.
+ * This requires POSIX threads.  It is set by default when the string
+ * repository is built thread safe.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_DIAG_THREAD_SAFE
+#define M2C_DIAG_THREAD_SAFE (INTSTR_THREAD_SAFE)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_diag_buffer_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a diagnostic buffer.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_diag_buffer_s *m2c_diag_buffer_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_diag_severity_t
+ * --------------------------------------------------------------------------
+ * Severity of a diagnostic.  A note reports on the compiler's handling of
+ * preceding diagnostics,  such as an error limit having been reached.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_DIAG_ERROR,
+  M2C_DIAG_WARNING,
+  M2C_DIAG_NOTE
+} m2c_diag_severity_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_new_buffer(filename)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated empty diagnostic buffer for the module in source
+ * file filename,  which is printed ahead of the report.  The filename is not
+ * copied and must remain valid while the buffer is in use.  Returns NULL if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_diag_buffer_t m2c_diag_new_buffer (const char *filename);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_add(buffer, severity, line, column, text)
+ * --------------------------------------------------------------------------
+ * Adds a diagnostic of the given severity  with message text  for the given
+ * line and column to buffer.  The text is copied,  it may span more than one
+ * line.  A column of zero refers to the line as a whole.  Diagnostics past
+ * a limit of buffer,  or that cannot be stored for lack of memory,  are
+ * counted but not reported.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_add
+  (m2c_diag_buffer_t buffer,       /* in */
+   m2c_diag_severity_t severity,   /* in */
+   uint_t line,                    /* in */
+   uint_t column,                  /* in */
+   const char *text);              /* in */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_set_limits(buffer, max_errors, max_warnings)
+ * --------------------------------------------------------------------------
+ * Limits the number of errors and warnings stored in buffer to max_errors
+ * and max_warnings.  A limit of zero selects no limit,  which is the default.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_set_limits
+  (m2c_diag_buffer_t buffer, uint_t max_errors, uint_t max_warnings);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_limit_reached(buffer, severity)
+ * --------------------------------------------------------------------------
+ * Returns true if buffer has a limit for severity and holds as many
+ * diagnostics of severity as the limit permits,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_diag_limit_reached
+  (m2c_diag_buffer_t buffer, m2c_diag_severity_t severity);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_count(buffer, severity)
+ * --------------------------------------------------------------------------
+ * Returns the number of diagnostics of the given severity added to buffer
+ * since it was created,  including those already flushed.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_diag_count
+  (m2c_diag_buffer_t buffer, m2c_diag_severity_t severity);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_flush(buffer, infile, show_source, stream)
+ * --------------------------------------------------------------------------
+ * Sorts the pending diagnostics of buffer by position and writes them to
+ * stream with a single call,  then empties the buffer.  If show_source is
+ * true and infile is not NULL,  each diagnostic is followed by its source
+ * line with the column marked by a caret,  all source lines are fetched from
+ * infile in a single pass.  Does nothing if there are no pending diagnostics.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_flush
+  (m2c_diag_buffer_t buffer,   /* in */
+   infile_t infile,            /* in */
+   bool show_source,           /* in */
+   FILE *stream);              /* in */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_merge(target, source)
+ * --------------------------------------------------------------------------
+ * Moves the pending diagnostics of source to target in the order they were
+ * added to source,  then empties source.  The diagnostics are subject to
+ * the limits of target.  Merging the buffers of independent tasks in a fixed
+ * order thus yields the same report regardless of the order in which the
+ * tasks completed.  Does nothing if target and source are the same buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_merge (m2c_diag_buffer_t target, m2c_diag_buffer_t source);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_diag_visitor_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure passed to m2c_diag_visit.  It is called with the
+ * severity,  line,  column and message text of a diagnostic and the context
+ * passed by the caller.  The text is only valid for the duration of the call.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_diag_visitor_t)
+  (m2c_diag_severity_t severity, uint_t line, uint_t column,
+   const char *text, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_visit(buffer, visitor, context)
+ * --------------------------------------------------------------------------
+ * Sorts the pending diagnostics of buffer by position  and calls visitor
+ * with context for each,  then empties the buffer.  For clients that report
+ * diagnostics in a format of their own,  such as language servers.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_visit
+  (m2c_diag_buffer_t buffer,      /* in */
+   m2c_diag_visitor_t visitor,    /* in */
+   void *context);                /* in */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_release(buffer)
+ * --------------------------------------------------------------------------
+ * Deallocates buffer,  discarding any pending diagnostics.  If buffer is the
+ * current buffer of the calling thread,  the thread is left without one.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_release (m2c_diag_buffer_t buffer);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_set_current(buffer)
+ * --------------------------------------------------------------------------
+ * Makes buffer the current buffer of the calling thread.  Passing NULL
+ * leaves the thread without a current buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_set_current (m2c_diag_buffer_t buffer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_current()
+ * --------------------------------------------------------------------------
+ * Returns the current buffer of the calling thread,  or NULL if it has none.
+ * ----------------------------------------------------------------------- */
+
+m2c_diag_buffer_t m2c_diag_current (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_diag_accepts(severity)
+ * --------------------------------------------------------------------------
+ * Returns false if the current buffer of the calling thread discards further
+ * diagnostics of severity,  otherwise true.  Emitters call this function to
+ * avoid composing messages that would be discarded.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_diag_accepts (m2c_diag_severity_t severity);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_diag_emit(severity, line, column, text)
+ * --------------------------------------------------------------------------
+ * Adds a diagnostic to the current buffer of the calling thread,  or writes
+ * it to stdout at once if the thread has no current buffer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_diag_emit
+  (m2c_diag_severity_t severity, uint_t line, uint_t column, const char *text);
+
+
+#endif /* M2C_DIAGNOSTICS_H */
+
+/* END OF FILE */
@@ -44,7 +44,11 @@
  * imports
  * ----------------------------------------------------------------------- */
 
+#include "m2c-token.h"
+#include "interned-strings.h"
+
 #include <stdint.h>
+#include <stdbool.h>
 
 
 /* --------------------------------------------------------------------------
@@ -53,7 +57,7 @@
  * Unsigned integer type to hold a digest value.
  * ----------------------------------------------------------------------- */
 
-typedef m2c_digest_value_t uint32_t;
+typedef uint32_t m2c_digest_value_t;
 
 
 /* --------------------------------------------------------------------------
@@ -68,19 +72,47 @@ typedef enum {
 } m2c_digest_mode_t;
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_digest_s
+ * --------------------------------------------------------------------------
+ * Record type to hold a digest context.  The record is public so that it
+ * can be embedded in client records,  but its fields must only be accessed
+ * through the functions of this interface.  The Fletcher sums are reduced
+ * lazily, once every few hundred words, not on every update.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  uint32_t c0, c1;            /* unreduced Fletcher sums */
+  uint32_t word_count;        /* words added since last reduction */
+  uint8_t odd_byte;           /* pending high byte of an incomplete word */
+  bool has_odd_byte;          /* true if odd_byte is pending */
+  bool finalized;             /* true if digest has been finalized */
+} m2c_digest_s;
+
+
 /* --------------------------------------------------------------------------
  * type m2c_digest_t
  * --------------------------------------------------------------------------
- * Opaque type to hold a digest context.
+ * Pointer type to a digest context.
  * ----------------------------------------------------------------------- */
 
 typedef m2c_digest_s *m2c_digest_t;
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_digest_reset(context)
+ * --------------------------------------------------------------------------
+ * Initialises an embedded or stack allocated digest context.
+ * ----------------------------------------------------------------------- */
+
+void m2c_digest_reset (m2c_digest_t digest);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_digest_init()
  * --------------------------------------------------------------------------
- * Returns a newly allocated and initialised digest context.
+ * Returns a newly allocated and initialised digest context.  Clients that
+ * embed the context should use m2c_digest_reset instead.
  * ----------------------------------------------------------------------- */
 
 m2c_digest_t m2c_digest_init (void);
@@ -129,7 +161,7 @@ m2c_digest_value_t m2c_digest_value (m2c_digest_t digest);
 /* --------------------------------------------------------------------------
  * function m2c_digest_release(context)
  * --------------------------------------------------------------------------
- * Releases context, returns NULL.
+ * Releases a context allocated by m2c_digest_init, returns NULL.
  * ----------------------------------------------------------------------- */
 
 m2c_digest_t m2c_digest_release (m2c_digest_t digest);
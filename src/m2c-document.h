@@ -0,0 +1,269 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-document.h                                                            *
+ *                                                                           *
+ * Interface for resident source documents with incremental reparsing.       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_DOCUMENT_H
+#define M2C_DOCUMENT_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-diagnostics.h"
+#include "m2c-compiler-options.h"
+
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Resident source documents
+ * --------------------------------------------------------------------------
+ * A document holds the text of a source as edited in an editor  together
+ * with its AST and diagnostics,  which are kept up to date as the text is
+ * edited.  For each line,  the document records the state of the lexer at
+ * the start of the line,  that is whether the line starts in code or inside
+ * a comment,  pragma,  string literal or disabled code section.  When a line
+ * range is edited,  the line states are recomputed from the edited lines on
+ * until they agree with those recorded before the edit,  usually right after
+ * the edited lines.
+ *
+ * If the edited lines lie within the lines of a single top-level definition
+ * of a program or implementation module,  including the lines that follow it
+ * up to the next definition,  the definition starts on a line in code and
+ * the line states past the definition are unchanged,  then only the lines of
+ * that definition are reparsed.  If the reparsed definition has the same
+ * declaration keys as before,  the edit did not change the symbols of the
+ * definition and its AST is kept,  otherwise it is replaced in the module
+ * AST.  The lines of the definitions and diagnostics that follow are moved
+ * by the number of lines inserted or removed.  Any other edit reparses the
+ * whole document.
+ *
+ * Syntax errors found while reparsing a single definition are confined to
+ * the lines of that definition.  Error recovery may therefore differ from a
+ * parse of the whole document  if the edit leaves the definition unfinished
+ * but the text that follows it still parses as one definition.  Interface
+ * modules are always reparsed in whole.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_document_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a resident source document.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_document_struct_t *m2c_document_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_document_update_t
+ * --------------------------------------------------------------------------
+ * Enumeration representing the extent of reparsing done for an update.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_DOCUMENT_UPDATE_DEFINITION,   /* a single definition was reparsed */
+  M2C_DOCUMENT_UPDATE_FULL          /* the whole document was reparsed */
+} m2c_document_update_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_new(name, text, length, options)
+ * --------------------------------------------------------------------------
+ * Returns a new document for the source represented by name with a copy of
+ * the length characters at text as its contents,  parsed with compiler
+ * option snapshot options.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_document_t m2c_document_new
+  (const char *name,                  /* in */
+   const char *text,                  /* in */
+   size_t length,                     /* in */
+   m2c_compiler_options_t options);   /* in */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_replace_text(doc, text, length)
+ * --------------------------------------------------------------------------
+ * Replaces the contents of doc by a copy of the length characters at text
+ * and reparses it in whole.  Returns true on success,  false if allocation
+ * failed.  Failures are handled as by m2c_document_edit.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_document_replace_text
+  (m2c_document_t doc, const char *text, size_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_edit(doc, first_line, first_col, ...)
+ * --------------------------------------------------------------------------
+ * Replaces the characters of doc from line first_line,  column first_col up
+ * to but excluding line last_line,  column last_col  by a copy of the length
+ * characters at text  and updates the AST and diagnostics of doc.  Lines and
+ * columns are counted from one,  columns in bytes.  Columns past the end of
+ * a line denote the end of the line.  Returns true on success.  Returns false
+ * if the range is invalid or the text could not be allocated,  in which case
+ * doc is unchanged,  or if allocation failed while reparsing,  in which case
+ * doc holds the edited text with the AST and diagnostics of the previous
+ * update  and is reparsed in whole by the next update.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_document_edit
+  (m2c_document_t doc,               /* in */
+   uint_t first_line,                /* in */
+   uint_t first_col,                 /* in */
+   uint_t last_line,                 /* in */
+   uint_t last_col,                  /* in */
+   const char *text,                 /* in */
+   size_t length);                   /* in */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_last_update(doc)
+ * --------------------------------------------------------------------------
+ * Returns the extent of reparsing done by the most recent update of doc.
+ * ----------------------------------------------------------------------- */
+
+m2c_document_update_t m2c_document_last_update (m2c_document_t doc);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_line_count(doc)
+ * --------------------------------------------------------------------------
+ * Returns the number of lines of doc.  A document always has at least one
+ * line,  a line terminator at the end of the text is followed by an empty
+ * last line.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_line_count (m2c_document_t doc);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_line(doc, line, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters of line line of doc  and passes their
+ * number,  excluding the line terminator,  in length.  Returns NULL and
+ * passes zero if doc has no such line.  The characters are not terminated
+ * and remain valid until doc is next updated.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_document_line
+  (m2c_document_t doc, uint_t line, uint_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_ast(doc)
+ * --------------------------------------------------------------------------
+ * Returns the AST of doc.  The AST remains valid until doc is next updated.
+ *
+ * astnode: (FILE filenameNode keyNode moduleNode)
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_document_ast (m2c_document_t doc);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_revision(doc)
+ * --------------------------------------------------------------------------
+ * Returns the revision of doc,  which is incremented by every update that
+ * changes the AST of doc.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_revision (m2c_document_t doc);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_defn_count(doc)
+ * --------------------------------------------------------------------------
+ * Returns the number of top-level definitions of doc that are tracked for
+ * incremental reparsing.  Returns zero for interface modules.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_defn_count (m2c_document_t doc);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_defn(doc, index)
+ * --------------------------------------------------------------------------
+ * Returns the AST of the top-level definition of doc at index index  in
+ * source order,  or NULL if index is out of range.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_document_defn (m2c_document_t doc, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_document_defn_revision(doc, index)
+ * --------------------------------------------------------------------------
+ * Returns the revision of doc in which the AST of the top-level definition
+ * at index index was last replaced,  or zero if index is out of range.
+ * Clients that cache results per definition compare this revision to that
+ * of their cached result.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_document_defn_revision (m2c_document_t doc, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_document_visit_diagnostics(doc, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor with context for each diagnostic of doc in order of source
+ * position.  Lines and columns are counted from one,  columns in bytes,  a
+ * column of zero refers to the line as a whole.
+ * ----------------------------------------------------------------------- */
+
+void m2c_document_visit_diagnostics
+  (m2c_document_t doc, m2c_diag_visitor_t visitor, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_document_release(doc)
+ * --------------------------------------------------------------------------
+ * Deallocates doc,  its AST and its diagnostics.
+ * ----------------------------------------------------------------------- */
+
+void m2c_document_release (m2c_document_t doc);
+
+
+#endif /* M2C_DOCUMENT_H */
+
+/* END OF FILE */
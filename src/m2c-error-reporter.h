@@ -44,9 +44,19 @@
  * imports
  * ----------------------------------------------------------------------- */
 
-#include "infile.h"
 #include "m2c-common.h"
 #include "m2c-token.h"
+#include "m2c-diagnostics.h"
+
+
+/* --------------------------------------------------------------------------
+ * Emission
+ * --------------------------------------------------------------------------
+ * Errors are added to the current diagnostic buffer of the calling thread,
+ * see m2c-diagnostics.h,  and written when the buffer is flushed,  sorted
+ * by position.  While the thread has no current buffer,  they are written
+ * to the console immediately.
+ * ----------------------------------------------------------------------- */
 
 /* --------------------------------------------------------------------------
  * error codes
@@ -59,32 +69,33 @@ typedef enum {
   M2C_ERROR_MISSING_DIGIT_AFTER_DP,
   M2C_ERROR_MISSING_DIGIT_AFTER_DSEP,
   M2C_ERROR_MISSING_EXPONENT_AFTER_E,
+  M2C_ERROR_EOF_IN_TOKEN,
+  M2C_ERROR_LEXEME_TOO_LONG,
 } m2c_error_t;
 
 
 /* Lexical Errors */
 
 /* --------------------------------------------------------------------------
- * procedure m2c_emit_lex_error(code, infile, ch, line, col)
+ * procedure m2c_emit_lex_error(code, ch, line, col)
  * --------------------------------------------------------------------------
- * Reports a lexical error of type code in infile, without token context, for
- * the given offending character at the given line and column. 
+ * Reports a lexical error of type code, without token context,  for the
+ * given offending character at the given line and column. 
  * ----------------------------------------------------------------------- */
 
 void m2c_emit_lex_error
-  (m2c_error_t code, infile_t infile, char ch, uint_t line, uint_t col);
+  (m2c_error_t code, char ch, uint_t line, uint_t col);
 
 
 /* --------------------------------------------------------------------------
- * procedure m2c_emit_lex_error_in_token(code, infile, token, ch, line, col)
+ * procedure m2c_emit_lex_error_in_token(code, token, ch, line, col)
  * --------------------------------------------------------------------------
- * Reports a lexical error  of type code  in infile  with given token context
- * for the given offending character at the given line and column. 
+ * Reports a lexical error  of type code  with given token context  for the
+ * given offending character at the given line and column. 
  * ----------------------------------------------------------------------- */
 
 void m2c_emit_lex_error_in_token
-  (m2c_error_t code, infile_t infile,
-   m2c_token_t token, char ch, uint_t line, uint_t col);
+  (m2c_error_t code, m2c_token_t token, char ch, uint_t line, uint_t col);
 
 
 /* Syntax Errors */
@@ -92,6 +103,6 @@ void m2c_emit_lex_error_in_token
 /* TO DO */
 
 
-#endif M2C_ERROR_REPORTER_H
+#endif /* M2C_ERROR_REPORTER_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
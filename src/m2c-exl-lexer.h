@@ -40,7 +40,20 @@
 #ifndef M2C_EXL_LEXER_H
 #define M2C_EXL_LEXER_H
 
-#include "string.h"
+#include "m2c-common.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Export list lexer
+ * --------------------------------------------------------------------------
+ * The lexer maps the export list file into memory where mmap() is available,
+ * otherwise it reads the file in one piece.  Identifiers are interned from
+ * the file contents in place,  hashed while they are scanned,  thus a lexer
+ * allocates nothing per symbol.  Section prefixes are recognised by their
+ * first character and the colon that follows it,  qualified identifiers of
+ * section C such as Colour.red are lexed as a single identifier.
+ * ----------------------------------------------------------------------- */
 
 
 /* ---------------------------------------------------------------------------
@@ -64,25 +77,30 @@ typedef enum {
   EXL_TOKEN_VARIABLES,       /* 5 */
   EXL_TOKEN_FUNCTIONS,       /* 6 */
   EXL_TOKEN_PROCEDURES,      /* 7 */
+  EXL_TOKEN_FINGERPRINT,     /* 8 */
  
   /* Identifiers */
   
-  EXL_TOKEN_IDENT,           /* 8 */
-  EXL_TOKEN_LOWLINE_IDENT,   /* 9 */
+  EXL_TOKEN_IDENT,           /* 9 */
+  EXL_TOKEN_LOWLINE_IDENT,   /* 10 */
+  
+  /* Fingerprint Value */
+  
+  EXL_TOKEN_KEY,             /* 11 */
   
   /* Punctuation */
 
-  EXL_TOKEN_COMMA,           /* 10 */
-  EXL_TOKEN_SEMICOLON,       /* 11 */
-  EXL_TOKEN_ASTERISK,        /* 12 */
+  EXL_TOKEN_COMMA,           /* 12 */
+  EXL_TOKEN_SEMICOLON,       /* 13 */
+  EXL_TOKEN_ASTERISK,        /* 14 */
    
   /* End Of File Marker */
   
-  EXL_TOKEN_EOF,             /* 13 */
+  EXL_TOKEN_EOF,             /* 15 */
 
   /* Enumeration Terminator */
 
-  EXL_TOKEN_END_MARK         /* 14 */   /* marks the end of the enumeration */
+  EXL_TOKEN_END_MARK         /* 16 */   /* marks the end of the enumeration */
 
 } m2c_exl_token_t;
 
@@ -105,8 +123,9 @@ typedef struct m2c_exl_lexer_struct_t *m2c_exl_lexer_t;
 typedef enum {
   M2C_EXL_LEXER_STATUS_SUCCESS,
   M2C_EXL_LEXER_STATUS_INVALID_REFERENCE,
-  M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED,
-  /* add more status codes as needed */
+  M2C_EXL_LEXER_STATUS_FILE_NOT_FOUND,
+  M2C_EXL_LEXER_STATUS_FILE_ACCESS_DENIED,
+  M2C_EXL_LEXER_STATUS_ALLOCATION_FAILED
 } m2c_exl_lexer_status_t;
 
 
@@ -122,7 +141,7 @@ typedef enum {
  *
  * post-conditions:
  * o  pointer to newly allocated and opened lexer is passed back in lexer
- * o  M2C_INFILE_STATUS_SUCCESS is passed back in status, unless NULL
+ * o  M2C_EXL_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
  *
  * error-conditions:
  * o  if lexer is not NULL upon entry, no operation is carried out
@@ -137,7 +156,7 @@ typedef enum {
 
 void m2c_exl_new_lexer
   (m2c_exl_lexer_t *lexer,
-   m2c_string_t filename,
+   intstr_t filename,
    m2c_exl_lexer_status_t *status);
 
 
@@ -202,7 +221,7 @@ m2c_exl_token_t m2c_exl_consume_sym (m2c_exl_lexer_t lexer);
  * Returns the filename associated with lexer.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_exl_lexer_filename (m2c_exl_lexer_t lexer);
+intstr_t m2c_exl_lexer_filename (m2c_exl_lexer_t lexer);
 
 
 /* --------------------------------------------------------------------------
@@ -217,25 +236,27 @@ m2c_exl_lexer_status_t m2c_exl_lexer_status (m2c_exl_lexer_t lexer);
 /* --------------------------------------------------------------------------
  * function m2c_exl_lexer_lookahead_lexeme(lexer)
  * --------------------------------------------------------------------------
- * Returns the lexeme of the lookahead symbol.
+ * Returns the lexeme of the lookahead symbol if it is an identifier or a
+ * fingerprint value,  otherwise NULL.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_exl_lexer_lookahead_lexeme (m2c_exl_lexer_t lexer);
+intstr_t m2c_exl_lexer_lookahead_lexeme (m2c_exl_lexer_t lexer);
 
 
 /* --------------------------------------------------------------------------
  * function m2c_exl_lexer_current_lexeme(lexer)
  * --------------------------------------------------------------------------
- * Returns the lexeme of the most recently consumed symbol.
+ * Returns the lexeme of the most recently consumed symbol if it is an
+ * identifier or a fingerprint value,  otherwise NULL.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_exl_lexer_current_lexeme (m2c_exl_lexer_t lexer);
+intstr_t m2c_exl_lexer_current_lexeme (m2c_exl_lexer_t lexer);
 
 
 /* --------------------------------------------------------------------------
  * procedure m2c_exl_release_lexer(lexer, status)
  * --------------------------------------------------------------------------
- * Closes the file associated with lexer, deallocates its file object,
+ * Unmaps or deallocates the file contents associated with lexer,
  * deallocates the lexer object and returns NULL in lexer.
  *
  * pre-conditions:
@@ -243,13 +264,13 @@ m2c_string_t m2c_exl_lexer_current_lexeme (m2c_exl_lexer_t lexer);
  * o  parameter status may be NULL
  *
  * post-conditions:
- * o  file object is deallocated
+ * o  file contents are unmapped or deallocated
  * o  NULL is passed back in lexer
- * o  M2C_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ * o  M2C_EXL_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
  *
  * error-conditions:
  * o  if lexer is NULL upon entry, no operation is carried out
- *    and status M2C_LEXER_STATUS_INVALID_REFERENCE is returned
+ *    and status M2C_EXL_LEXER_STATUS_INVALID_REFERENCE is returned
  * ----------------------------------------------------------------------- */
 
 void m2c_exl_release_lexer
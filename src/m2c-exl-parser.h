@@ -41,6 +41,35 @@
 #define M2C_EXL_PARSER_H
 
 #include "m2c-common.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_exl_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the sections of an export list.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_EXL_KIND_TYPE,        /* T: */
+  M2C_EXL_KIND_CONST,       /* C: */
+  M2C_EXL_KIND_VAR,         /* V: */
+  M2C_EXL_KIND_FUNC,        /* F: */
+  M2C_EXL_KIND_PROC,        /* P: */
+  M2C_EXL_KIND_END_MARK     /* marks the end of the enumeration */
+} m2c_exl_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_exl_list_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the contents of an export list file,
+ * the identifier of the exporting module,  its fingerprint key  and the
+ * exported identifiers by kind.  The identifiers of all sections are held
+ * in a single array.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_exl_list_s *m2c_exl_list_t;
 
 
 /* --------------------------------------------------------------------------
@@ -52,6 +81,8 @@
 typedef enum {
   M2C_EXL_PARSER_STATUS_SUCCESS,
   M2C_EXL_PARSER_STATUS_INVALID_REFERENCE,
+  M2C_EXL_PARSER_STATUS_FILE_NOT_FOUND,
+  M2C_EXL_PARSER_STATUS_SYNTAX_ERROR,
   M2C_EXL_PARSER_STATUS_ALLOCATION_FAILED
 } m2c_exl_parser_status_t;
 
@@ -63,11 +94,60 @@ typedef enum {
  * exported identifiers  by kind  and  passes it back in  list,  or NULL upon
  * failure.  The status of the operation is passed back in status.
  * ----------------------------------------------------------------------- */
- 
- void m2c_exl_parse_file
-   (const char *exlpath,                /* in */
-    m2c_exl_list_t *list,               /* out */
-    m2c_exl_parser_status_t *status);   /* out */
+
+void m2c_exl_parse_file
+  (const char *exlpath,                /* in */
+   m2c_exl_list_t *list,               /* out */
+   m2c_exl_parser_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_exporter(list)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the module whose exports are listed in list.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_list_exporter (m2c_exl_list_t list);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_fingerprint(list)
+ * --------------------------------------------------------------------------
+ * Returns the fingerprint key of list,  or NULL if it has none.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_list_fingerprint (m2c_exl_list_t list);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_count(list, kind)
+ * --------------------------------------------------------------------------
+ * Returns the number of identifiers of the given kind in list.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_exl_list_count (m2c_exl_list_t list, m2c_exl_kind_t kind);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_list_ident_at_index(list, kind, index)
+ * --------------------------------------------------------------------------
+ * Returns the identifier at index of the given kind in list,  in the order
+ * listed,  or NULL if index is out of range.  Constants that are values of
+ * an enumeration type are returned qualified by their type.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_exl_list_ident_at_index
+  (m2c_exl_list_t list, m2c_exl_kind_t kind, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_release_list(list)
+ * --------------------------------------------------------------------------
+ * Deallocates list and passes NULL in list.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_release_list (m2c_exl_list_t *list);
+
 
 #endif /* M2C_EXL_PARSER_H */
 
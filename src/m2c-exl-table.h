@@ -0,0 +1,222 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-exl-table.h                                                           *
+ *                                                                           *
+ * Public interface of binary export list table module.                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_EXL_TABLE_H
+#define M2C_EXL_TABLE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-digest.h"
+#include "m2c-exl-parser.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Binary export list table
+ * --------------------------------------------------------------------------
+ * A binary export list table holds the same identifiers as the export list
+ * Foo.exl in a file Foo.exlb,  sorted by their characters  so that an
+ * importer can check whether and as what an identifier is exported  by a
+ * binary search over the file contents in place,  without parsing the list
+ * or interning any of its identifiers.  Tables are mapped into memory where
+ * mmap() is available,  otherwise read in one piece.
+ *
+ * All integers are little endian.  The file starts with a header of twenty
+ * bytes:  the characters "M2CX",  a version byte,  three zero bytes,  the
+ * interface fingerprint,  the number of entries  and the size of the name
+ * pool as 32-bit integers.  There follows one entry of eight bytes per
+ * identifier,  the offset of its name in the pool as a 32-bit integer,  the
+ * length of its name as a 16-bit integer,  its kind and a zero byte.  The
+ * pool holds the identifier of the exporting module  followed by the names
+ * of all entries,  each terminated by NUL.  Values of enumeration types are
+ * listed as qualified names such as Colour.red.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Suffix appended to the path of an export list for its table
+ * ----------------------------------------------------------------------- */
+
+#define M2C_EXL_TABLE_SUFFIX "b"
+
+
+/* --------------------------------------------------------------------------
+ * Version of the table format
+ * ----------------------------------------------------------------------- */
+
+#define M2C_EXL_TABLE_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_exl_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an open binary export list table.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_exl_table_s *m2c_exl_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_exl_table_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for an identifier to be written to a table,  qualified by
+ * field qualifier unless it is NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* qualifier */  intstr_t qualifier;
+  /* ident */      intstr_t ident;
+  /* kind */       m2c_exl_kind_t kind;
+} m2c_exl_table_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_exl_table_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on binary export list tables.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_EXL_TABLE_STATUS_SUCCESS,
+  M2C_EXL_TABLE_STATUS_INVALID_REFERENCE,
+  M2C_EXL_TABLE_STATUS_FILE_NOT_FOUND,
+  M2C_EXL_TABLE_STATUS_INVALID_FILE,
+  M2C_EXL_TABLE_STATUS_WRITE_FAILED,
+  M2C_EXL_TABLE_STATUS_ALLOCATION_FAILED
+} m2c_exl_table_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_table_write(path, exporter, fingerprint, count, ...)
+ * --------------------------------------------------------------------------
+ * Writes a table with the count identifiers of array entries exported by
+ * module exporter with the given fingerprint to the file at path.  A file
+ * whose contents would not change is left untouched.  Passes the status of
+ * the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_table_write
+  (const char *path,                          /* in */
+   intstr_t exporter,                         /* in */
+   m2c_digest_value_t fingerprint,            /* in */
+   uint_t count,                              /* in */
+   const m2c_exl_table_entry_t entries[],     /* in */
+   m2c_exl_table_status_t *status);           /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_open(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the table at path and returns it,  or NULL on failure.  The header
+ * and section sizes are checked on open.  Passes the status of the
+ * operation in status.
+ * ----------------------------------------------------------------------- */
+
+m2c_exl_table_t m2c_exl_table_open
+  (const char *path, m2c_exl_table_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_exporter(table)
+ * --------------------------------------------------------------------------
+ * Returns the NUL terminated identifier of the exporting module of table.
+ * The identifier is valid until table is closed.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_exl_table_exporter (m2c_exl_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_fingerprint(table)
+ * --------------------------------------------------------------------------
+ * Returns the interface fingerprint recorded in table.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_exl_table_fingerprint (m2c_exl_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of identifiers in table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_exl_table_count (m2c_exl_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_lookup(table, ident, length, kind)
+ * --------------------------------------------------------------------------
+ * Searches table for the length characters at ident.  Returns true and
+ * passes the kind of the identifier in kind if it is exported,  otherwise
+ * returns false.  Kind may be NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_exl_table_lookup
+  (m2c_exl_table_t table,     /* in */
+   const char *ident,         /* in */
+   uint_t length,             /* in */
+   m2c_exl_kind_t *kind);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_exl_table_exports(table, ident)
+ * --------------------------------------------------------------------------
+ * Returns true if interned identifier ident is exported by table,  else
+ * false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_exl_table_exports (m2c_exl_table_t table, intstr_t ident);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_exl_table_close(table)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates table and passes NULL in table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_exl_table_close (m2c_exl_table_t *table);
+
+
+#endif /* M2C_EXL_TABLE_H */
+
+/* END OF FILE */
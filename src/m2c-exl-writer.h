@@ -0,0 +1,96 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-exl-writer.h                                                          *
+ *                                                                           *
+ * Public interface of export list file writer module.                       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_EXL_WRITER_H
+#define M2C_EXL_WRITER_H
+
+#include "m2c-common.h"
+
+#include "m2c-compiler-options.h"
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_exl_writer_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operation m2c_write_exl_for_def.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_EXL_WRITER_STATUS_SUCCESS,
+  M2C_EXL_WRITER_STATUS_INVALID_REFERENCE,
+  M2C_EXL_WRITER_STATUS_INVALID_SOURCETYPE,
+  M2C_EXL_WRITER_STATUS_SYNTAX_ERRORS_FOUND,
+  M2C_EXL_WRITER_STATUS_FILE_ACCESS_FAILED,
+  M2C_EXL_WRITER_STATUS_ALLOCATION_FAILED
+} m2c_exl_writer_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_write_exl_for_def(defpath, exlpath, options, status)
+ * --------------------------------------------------------------------------
+ * Parses the definition module referenced by defpath  and writes the list of
+ * its exported identifiers by kind to the export list file at exlpath,  with
+ * sections in the order T, C, V, F, P  and empty sections omitted.  Values
+ * of enumeration types are listed in section C qualified by their type.
+ * The header holds the interface fingerprint of the module in entry K,  a
+ * digest over its imports and the symbols of its definitions.  An export
+ * list whose contents would not change is not rewritten,  so that build
+ * tools can depend on it instead of the definition module  and skip the
+ * importers of a module after edits to its comments or layout.
+ *
+ * If option --exlb is set in options,  the same identifiers are written as
+ * a binary export list table to exlpath with suffix M2C_EXL_TABLE_SUFFIX
+ * appended,  see m2c-exl-table.h.
+ *
+ * The AST is built in a scratch region of its own  which is released before
+ * returning,  thus the call leaves the current region untouched.  No export
+ * list is written  if the source is not an interface module  or has syntax
+ * errors.  The status of the operation is passed back in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_exl_for_def
+  (const char *defpath,                /* in */
+   const char *exlpath,                /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_exl_writer_status_t *status);   /* out */
+
+
+#endif /* M2C_EXL_WRITER_H */
+
+/* END OF FILE */
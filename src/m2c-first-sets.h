@@ -47,14 +47,71 @@
 #include "m2c-tokenset.h"
 #include "m2c-productions.h"
 
+#include <stddef.h> /* NULL */
+#include <stdint.h> /* uint8_t */
+
+
+/* --------------------------------------------------------------------------
+ * FIRST set table, pruned
+ * --------------------------------------------------------------------------
+ * Static table of first sets with cardinality > 1 and without duplicates.
+ * The sets are constant literals,  no tokenset is built at runtime.
+ * ----------------------------------------------------------------------- */
+
+#define DATA(_prod, _set_literal) M2C_TOKENSET_LITERAL _set_literal,
+
+static const m2c_tokenset_s m2c_first_set_table[] = {
+  { { 0 }, 0 }, /* empty set for pruned entries */
+  #include "m2c-first-set-literals.h"
+}; /* end m2c_first_set_table */
+
+#undef DATA
+
+
+/* --------------------------------------------------------------------------
+ * FIRST set lookup table
+ * --------------------------------------------------------------------------
+ * Table to map productions to pruned first set table indices.
+ * ----------------------------------------------------------------------- */
+
+#define DATA(_prod, _index) _index,
+
+static const uint8_t m2c_first_set_index[] = {
+  0, /* P_INVALID */
+  #include "m2c-first-set-lookup.h"
+}; /* end m2c_first_set_index */
+
+#undef DATA
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_first_set(production)
+ * --------------------------------------------------------------------------
+ * Returns the FIRST set of p if p is valid,  else NULL.  The set is empty
+ * if |FIRST(p)| < 2.  The returned set is a constant and must not be
+ * modified or released.
+ * ----------------------------------------------------------------------- */
+
+static inline m2c_tokenset_t m2c_first_set (m2c_production_t p) {
+  
+  if (IS_VALID_PRODUCTION(p)) {
+    return (m2c_tokenset_t) &m2c_first_set_table[m2c_first_set_index[p]];
+  }
+  else /* invalid production */ {
+    return NULL;
+  } /* end if */
+} /* end m2c_first_set */
+
 
 /* --------------------------------------------------------------------------
- * function FIRST(production)
+ * macro FIRST(production)
  * --------------------------------------------------------------------------
- * Returns the FIRST set of p if p is valid and |FIRST(p)| > 1, else NULL.
+ * Returns the FIRST set of the production with the given name,  eg.
+ * FIRST(STATEMENT_SEQUENCE).  Resolves to a constant address at compile
+ * time,  membership tests against it are inlined bit tests.
  * ----------------------------------------------------------------------- */
 
-const m2c_tokenset_t FIRST (m2c_production_t p);
+#define FIRST(_production) m2c_first_set(P_ ## _production)
 
 
 #endif /* M2C_FIRST_SETS_H */
@@ -44,17 +44,74 @@
  * imports
  * ----------------------------------------------------------------------- */
 
-#include "m2c-token.h"
+#include "m2c-tokenset.h"
 #include "m2c-productions.h"
 
+#include <stddef.h> /* NULL */
+#include <stdint.h> /* uint8_t */
+
+
+/* --------------------------------------------------------------------------
+ * FOLLOW set table, pruned
+ * --------------------------------------------------------------------------
+ * Static table of follow sets with cardinality > 1 and without duplicates.
+ * The sets are constant literals,  no tokenset is built at runtime.
+ * ----------------------------------------------------------------------- */
+
+#define DATA(_prod, _set_literal) M2C_TOKENSET_LITERAL _set_literal,
+
+static const m2c_tokenset_s m2c_follow_set_table[] = {
+  { { 0 }, 0 }, /* empty set for pruned entries */
+  #include "m2c-follow-set-literals.h"
+}; /* end m2c_follow_set_table */
+
+#undef DATA
+
+
+/* --------------------------------------------------------------------------
+ * FOLLOW set lookup table
+ * --------------------------------------------------------------------------
+ * Table to map productions to pruned follow set table indices.
+ * ----------------------------------------------------------------------- */
+
+#define DATA(_prod, _index) _index,
+
+static const uint8_t m2c_follow_set_index[] = {
+  0, /* P_INVALID */
+  #include "m2c-follow-set-lookup.h"
+}; /* end m2c_follow_set_index */
+
+#undef DATA
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_follow_set(production)
+ * --------------------------------------------------------------------------
+ * Returns the FOLLOW set of p if p is valid,  else NULL.  The set is empty
+ * if |FOLLOW(p)| < 2.  The returned set is a constant and must not be
+ * modified or released.
+ * ----------------------------------------------------------------------- */
+
+static inline m2c_tokenset_t m2c_follow_set (m2c_production_t p) {
+  
+  if (IS_VALID_PRODUCTION(p)) {
+    return (m2c_tokenset_t) &m2c_follow_set_table[m2c_follow_set_index[p]];
+  }
+  else /* invalid production */ {
+    return NULL;
+  } /* end if */
+} /* end m2c_follow_set */
+
 
 /* --------------------------------------------------------------------------
- * function FOLLOW(production)
+ * macro FOLLOW(production)
  * --------------------------------------------------------------------------
- * Returns the FOLLOW set for production p,  or NULL if p is invalid.
+ * Returns the FOLLOW set of the production with the given name,  eg.
+ * FOLLOW(STATEMENT_SEQUENCE).  Resolves to a constant address at compile
+ * time,  membership tests against it are inlined bit tests.
  * ----------------------------------------------------------------------- */
 
-const m2c_tokenset_t FOLLOW (m2c_production_t p);
+#define FOLLOW(_production) m2c_follow_set(P_ ## _production)
 
 
 #endif /* M2C_FOLLOW_SETS_H */
@@ -0,0 +1,235 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-for-codegen.h                                                         *
+ *                                                                           *
+ * Interface for translation of FOR loops without bounds checks.             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_FOR_CODEGEN_H
+#define M2C_FOR_CODEGEN_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "outfile.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Bounds-check elimination in FOR loops
+ * --------------------------------------------------------------------------
+ * A FOR loop over an array variable visits each index of the array,  or of
+ * a value range of the array,  exactly once.  The bounds of an array do not
+ * change while the loop runs  and the accessor cannot be assigned to,  thus
+ * a subscript of the array by the accessor within the loop body is always
+ * in range:
+ *
+ *   FOR i, v IN vector DO  ... vector[i] ...  END
+ *
+ * Such loops are proven in advance of translation.  A proven loop is then
+ * written as a loop that increments a pointer to the current element  and
+ * each proven subscript as a dereference of that pointer,  without a bounds
+ * check.  A value range is checked once before the loop.  All other
+ * subscripts are translated with bounds checks as before.
+ *
+ * A subscript is not proven within a nested FOR loop that declares the name
+ * of the accessor or of the array again,  nor are subscripts of a subscript,
+ * e.g. the second index of a two-dimensional access.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_bounds_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a table of proven loops and subscripts.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_bounds_table_struct_t *m2c_bounds_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_array_predicate_f
+ * --------------------------------------------------------------------------
+ * Type of a function that returns true if identifier node ident_node,  an
+ * IDENT or QUALIDENT node,  denotes a variable or parameter of array type,
+ * otherwise false.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_array_predicate_f)
+  (m2c_astnode_t ident_node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_for_node_writer_f
+ * --------------------------------------------------------------------------
+ * Type of a function that writes the C translation of identifier or
+ * expression node to outfile.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_for_node_writer_f)
+  (outfile_t outfile, m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_bounds_table()
+ * --------------------------------------------------------------------------
+ * Returns a new empty bounds table,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_bounds_table_t m2c_new_bounds_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_prove_loop_bounds(table, root, is_array, context)
+ * --------------------------------------------------------------------------
+ * Enters the FOR loops over arrays within the tree rooted at root and the
+ * subscripts within their bodies that are always in range into table, and
+ * returns the number of entered subscripts.  Function is_array is called
+ * with context to decide whether the collection of a loop is an array.  If
+ * the table cannot be enlarged,  remaining loops and subscripts are not
+ * entered and keep their bounds checks.
+ *
+ * astnodes:
+ *  (FOR (ASC accessorNode valueNode iterExprNode) statementSeqNode)
+ *  (FOR (DESC accessorNode valueNode iterExprNode) statementSeqNode)
+ *  (ITEREXPR identNode rangeNode)
+ *  (DESIG identNode (SUBSCRTAIL exprNode tailNode))
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_prove_loop_bounds
+  (m2c_bounds_table_t table,                /* in */
+   m2c_astnode_t root,                      /* in */
+   m2c_array_predicate_f is_array,          /* in */
+   void *context);                          /* in */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bounds_loop_is_proven(table, for_node)
+ * --------------------------------------------------------------------------
+ * Returns true if FOR node for_node is entered in table,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_bounds_loop_is_proven
+  (m2c_bounds_table_t table, m2c_astnode_t for_node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bounds_subscript_is_proven(table, tail_node)
+ * --------------------------------------------------------------------------
+ * Returns true if SUBSCRTAIL node tail_node is entered in table,  otherwise
+ * false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_bounds_subscript_is_proven
+  (m2c_bounds_table_t table, m2c_astnode_t tail_node);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_proven_loop_head(outfile, table, for_node, ...)
+ * --------------------------------------------------------------------------
+ * Writes the head of proven FOR loop for_node to outfile,  opening a block
+ * that declares the element pointer of the loop,  a check of the value
+ * range,  if any,  and the loop itself,  followed by declarations of the
+ * accessor,  if it is used other than in proven subscripts,  and of the
+ * value,  if any.  Element_type is the C type of the array elements,  writer
+ * is called with context to write the array,  accessor and value
+ * identifiers and the bounds of the value range.  A value range that is
+ * out of bounds is reported by M2C_INDEX_ERROR(),  a runtime error handler
+ * the generated code is expected to define,  which must not return.
+ *
+ *   {
+ *     long long m2c_for_lo0 = 0, m2c_for_hi0 = (long long) (a).count - 1;
+ *     T *m2c_for_ptr0 = (a).value, *m2c_for_stop0 = (a).value;
+ *
+ *     if (m2c_for_lo0 <= m2c_for_hi0) {
+ *       m2c_for_ptr0 += m2c_for_lo0;
+ *       m2c_for_stop0 += m2c_for_hi0 + 1;
+ *     }
+ *     for (; m2c_for_ptr0 != m2c_for_stop0; m2c_for_ptr0++) {
+ *       const T v = *m2c_for_ptr0;
+ * ----------------------------------------------------------------------- */
+  
+void m2c_write_proven_loop_head
+  (outfile_t outfile,                       /* in */
+   m2c_bounds_table_t table,                /* in */
+   m2c_astnode_t for_node,                  /* in */
+   intstr_t element_type,                   /* in */
+   m2c_for_node_writer_f writer,            /* in */
+   void *context);                          /* in */
+  
+  
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_proven_loop_tail(outfile, table, for_node)
+ * --------------------------------------------------------------------------
+ * Writes the closing braces of the loop and block of proven FOR loop
+ * for_node to outfile.
+ * ----------------------------------------------------------------------- */
+  
+void m2c_write_proven_loop_tail
+  (outfile_t outfile, m2c_bounds_table_t table, m2c_astnode_t for_node);
+  
+  
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_proven_subscript(outfile, table, tail_node)
+ * --------------------------------------------------------------------------
+ * Writes the array identifier and proven subscript tail_node together as a
+ * dereference of the element pointer of the loop that proved it,  e.g.
+ * vector[i] is written as (*m2c_for_ptr0).  The remainder of the tail,  if
+ * any,  is written by the caller.
+ * ----------------------------------------------------------------------- */
+  
+void m2c_write_proven_subscript
+  (outfile_t outfile, m2c_bounds_table_t table, m2c_astnode_t tail_node);
+  
+  
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_bounds_table(table)
+ * --------------------------------------------------------------------------
+ * Deallocates table.
+ * ----------------------------------------------------------------------- */
+  
+void m2c_release_bounds_table (m2c_bounds_table_t table);
+  
+  
+#endif /* M2C_FOR_CODEGEN_H */
+  
+/* END OF FILE */
+  
\ No newline at end of file
@@ -0,0 +1,159 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-ident-class.h                                                         *
+ *                                                                           *
+ * Interface for classification of identifiers by perfect hash lookup.       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_IDENT_CLASS_H
+#define M2C_IDENT_CLASS_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-token.h"
+#include "m2c-predef-ident.h"
+#include "m2c-bindable-ident.h"
+#include "m2c-schroed-token.h"
+#include "interned-strings.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * identifier class flags
+ * --------------------------------------------------------------------------
+ * Flags indicating the classes of a lexeme.  A lexeme may be a member of
+ * more than one class,  for example  NIL is both a predefined identifier
+ * and a Schroedinger's token.
+ * ----------------------------------------------------------------------- */
+
+#define IDENT_CLASS_RESWORD   0x01
+#define IDENT_CLASS_PREDEF    0x02
+#define IDENT_CLASS_BINDABLE  0x04
+#define IDENT_CLASS_SCHROED   0x08
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ident_info_t
+ * --------------------------------------------------------------------------
+ * Record type  with the classification of a  reserved word,  predefined or
+ * bindable identifier,  or Schroedinger's token.  Values for classes the
+ * lexeme is not a member of are set to their respective invalid sentinel.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *lexstr;       /* NUL terminated lexeme */
+  uint8_t length;           /* length of lexeme */
+  uint8_t classes;          /* set of IDENT_CLASS_* flags */
+  uint8_t token;            /* m2c_token_t or TOKEN_UNKNOWN */
+  uint8_t predef;           /* m2c_predef_t or PREDEF_INVALID */
+  uint8_t bindable;         /* m2c_bindable_t or BINDABLE_INVALID */
+  uint8_t schroed;          /* m2c_schroed_t or SCHROED_INVALID */
+} m2c_ident_info_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ident_class_init()
+ * --------------------------------------------------------------------------
+ * Installs the identifier classifier  as tag handler  of the interned string
+ * repository so that every lexeme is classified once when it is interned.
+ * Also installs  the static lexeme table  as static resolver so that reserved
+ * words and classified identifiers  intern to  preinitialised string objects
+ * linked into the binary.  Should be called before the first lexeme is
+ * interned.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ident_class_init (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_info_for_lexeme(lexeme)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the entry for lexeme in the generated perfect hash
+ * table  of reserved words,  predefined identifiers,  bindable identifiers
+ * and Schroedinger's tokens,  or NULL  if lexeme is not a member of any of
+ * these classes.  Once the classifier is installed, this is a tag load.
+ * ----------------------------------------------------------------------- */
+
+const m2c_ident_info_t *m2c_ident_info_for_lexeme (intstr_t lexeme);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_info_for_slice(str, length)
+ * --------------------------------------------------------------------------
+ * Looks up  the length  characters at str  in the  generated  perfect hash
+ * table.  Returns a pointer to the entry for the characters,  or NULL if
+ * they do not match a reserved word or classified identifier.
+ * ----------------------------------------------------------------------- */
+
+const m2c_ident_info_t *m2c_ident_info_for_slice
+  (const char *str, uint_t length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_lexeme_for_resword(token)
+ * --------------------------------------------------------------------------
+ * Returns the static interned lexeme of the reserved word represented by
+ * token,  or NULL if token does not represent a reserved word.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ident_lexeme_for_resword (m2c_token_t token);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_lexeme_for_predef(value)
+ * --------------------------------------------------------------------------
+ * Returns the static interned lexeme of the predefined identifier represented
+ * by value,  or the empty string if value is invalid.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ident_lexeme_for_predef (m2c_predef_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_lexeme_for_bindable(value)
+ * --------------------------------------------------------------------------
+ * Returns the static interned lexeme of the bindable identifier represented
+ * by value,  or the empty string if value is invalid.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_ident_lexeme_for_bindable (m2c_bindable_t value);
+
+
+#endif /* M2C_IDENT_CLASS_H */
+
+/* END OF FILE */
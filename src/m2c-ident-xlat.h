@@ -105,6 +105,131 @@ const char* m2c_ident_xlat_for_local_name
    intstr_t ident);    /* required */
 
 
+/* --------------------------------------------------------------------------
+ * opaque type m2c_ident_xlat_cache_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the identifier translation cache of a
+ * module.  A cache composes the module prefix once and returns the same
+ * C identifier string  for repeated requests  of the same identifier,  kind
+ * and enumeration.  Strings returned by a cache remain valid until the cache
+ * is released and must not be deallocated by the caller.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_ident_xlat_cache_s *m2c_ident_xlat_cache_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_ident_xlat_names_t
+ * --------------------------------------------------------------------------
+ * Record type holding the C names derived from a module identifier,  the
+ * lowercase and uppercase prefixes of its exported identifiers,  its import
+ * guard and the name of its C header.  The names are composed once when the
+ * interface of a module is compiled and recorded in its symbol file,  from
+ * where importers read them instead of translating the module identifier.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* prefix */        const char *prefix;
+  /* upper_prefix */  const char *upper_prefix;
+  /* import_guard */  const char *import_guard;
+  /* header_name */   const char *header_name;
+} m2c_ident_xlat_names_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_new_cache(module_id)
+ * --------------------------------------------------------------------------
+ * Returns a new translation cache for module_id,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_ident_xlat_cache_t m2c_ident_xlat_new_cache (intstr_t module_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_new_cache_with_names(module_id, names)
+ * --------------------------------------------------------------------------
+ * Returns a new translation cache for module_id that uses the C names in
+ * names,  as recorded in a symbol file,  without translating module_id.
+ * Returns NULL if a name is missing or on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_ident_xlat_cache_t m2c_ident_xlat_new_cache_with_names
+  (intstr_t module_id, const m2c_ident_xlat_names_t *names);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ident_xlat_cached_names(cache, names)
+ * --------------------------------------------------------------------------
+ * Passes the C names of the module of cache in names.  The names remain
+ * valid until cache is released.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ident_xlat_cached_names
+  (m2c_ident_xlat_cache_t cache, m2c_ident_xlat_names_t *names);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_import_guard(cache)
+ * --------------------------------------------------------------------------
+ * Returns the import guard C macro identifier for the module of cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_import_guard (m2c_ident_xlat_cache_t cache);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_exported_name(cache, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns a fully qualified C identifier for ident within the module of
+ * cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_exported_name
+  (m2c_ident_xlat_cache_t cache,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,   /* may be NULL */
+   intstr_t ident);    /* required */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_hidden_name(cache, kind, enum_id, ident)
+ * --------------------------------------------------------------------------
+ * Returns a file level C identifier for ident within the module of cache.
+ * With option --unity,  the identifier is qualified with the module prefix
+ * as all modules of the program share one C translation unit.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_hidden_name
+  (m2c_ident_xlat_cache_t cache,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t enum_id,   /* may be NULL */
+   intstr_t ident);    /* required */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_ident_xlat_cached_local_name(cache, kind, proc_id, ...)
+ * --------------------------------------------------------------------------
+ * Returns a local C identifier from proc_id for ident within the module of
+ * cache.
+ * ----------------------------------------------------------------------- */
+
+const char* m2c_ident_xlat_cached_local_name
+  (m2c_ident_xlat_cache_t cache,
+   m2c_ident_xlat_kind_t kind,
+   intstr_t proc_id,   /* required */
+   intstr_t enum_id,   /* may be NULL */
+   intstr_t ident);    /* required */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ident_xlat_release_cache(cache)
+ * --------------------------------------------------------------------------
+ * Deallocates cache and all translations it returned.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ident_xlat_release_cache (m2c_ident_xlat_cache_t cache);
+
+
 #endif /* M2C_IDENT_XLAT_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,240 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-import-loader.h                                                       *
+ *                                                                           *
+ * Interface of demand-driven loading of imported interfaces.                *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_IMPORT_LOADER_H
+#define M2C_IMPORT_LOADER_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2-symtab.h"
+#include "m2-symfile.h"
+#include "m2c-ident-xlat.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Demand-driven loading of imported interfaces
+ * --------------------------------------------------------------------------
+ * An import table holds the libraries imported by a module,  but does not
+ * load their interfaces when it is built.  Since imports are qualified,
+ * every reference into an imported library is a qualified identifier whose
+ * qualifier names the library.  The interface of a library is loaded when
+ * the first qualified identifier with its qualifier is resolved,  libraries
+ * that are imported but never referenced are never loaded.
+ *
+ * A library re-exported by an imported interface may be referenced as if
+ * it were imported itself.  Its interface is loaded only when a qualified
+ * identifier with its qualifier is resolved.  To find the interface that
+ * re-exports it,  the symbol file of each interface records the libraries
+ * it re-exports,  directly or through other interfaces,  as symbols of kind
+ * M2C_SYMTYPE_MODULE,  see m2c_import_record_reexports.  An unknown
+ * qualifier is looked up in the interfaces imported,  those already loaded
+ * first,  which answers most lookups from their Bloom filters.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_import_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on import tables.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_IMPORT_STATUS_SUCCESS,
+  M2C_IMPORT_STATUS_INVALID_REFERENCE,
+  M2C_IMPORT_STATUS_UNKNOWN_MODULE,
+  M2C_IMPORT_STATUS_LOAD_FAILED,
+  M2C_IMPORT_STATUS_IDENT_NOT_FOUND,
+  M2C_IMPORT_STATUS_ALLOCATION_FAILED
+} m2c_import_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_import_open_f
+ * --------------------------------------------------------------------------
+ * Function type for opening the symbol file of the interface of library
+ * module_id with context.  Returns the symbol file,  with a reference the
+ * import table releases when it is released,  or NULL and passes the
+ * status in status on failure.  Typically locates the file on the module
+ * search path and opens it with m2c_server_import_symfile.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_symfile_t (*m2c_import_open_f)
+  (void *context, intstr_t module_id, m2c_symfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_import_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the import table of a module.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_import_table_struct_t *m2c_import_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_import_table(module, open, context)
+ * --------------------------------------------------------------------------
+ * Collects the libraries imported and re-exported by module AST module
+ * and returns a new import table,  or NULL on allocation failure.  No
+ * interface is loaded,  interfaces are opened with open and context when
+ * first needed.
+ * ----------------------------------------------------------------------- */
+
+m2c_import_table_t m2c_new_import_table
+  (m2c_astnode_t module, m2c_import_open_f open, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_resolve(table, module_id, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Resolves the qualified identifier module_id.ident,  loading the interface
+ * of library module_id if it has not been loaded,  and passes back the
+ * attributes of ident,  unless attributes is NULL.
+ *
+ * error-conditions:
+ * o  if table,  module_id or ident is NULL,
+ *    M2C_IMPORT_STATUS_INVALID_REFERENCE,  if module_id is neither imported
+ *    nor re-exported by an imported interface,
+ *    M2C_IMPORT_STATUS_UNKNOWN_MODULE,  if its interface could not be
+ *    loaded,  M2C_IMPORT_STATUS_LOAD_FAILED,  if it does not export ident,
+ *    M2C_IMPORT_STATUS_IDENT_NOT_FOUND,  if allocation failed,
+ *    M2C_IMPORT_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_import_status_t m2c_import_resolve
+  (m2c_import_table_t table,
+   intstr_t module_id,
+   intstr_t ident,
+   m2c_sym_attr_t *attributes);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_interface(table, module_id, status)
+ * --------------------------------------------------------------------------
+ * Returns the symbol file of the interface of library module_id,  loading
+ * it if it has not been loaded,  or NULL on failure.  The symbol file is
+ * owned by table.  Passes the status in status,  unless NULL,  with the
+ * same error conditions as m2c_import_resolve.
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_import_interface
+  (m2c_import_table_t table,
+   intstr_t module_id,
+   m2c_import_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_xlat_cache(table, module_id, status)
+ * --------------------------------------------------------------------------
+ * Returns the identifier translation cache of library module_id,  loading
+ * its interface if it has not been loaded,  or NULL on failure.  The cache
+ * is created on first use from the C names recorded in the symbol file of
+ * the interface,  the module identifier is translated only if the symbol
+ * file holds none.  The cache is owned by table.  Passes the status in
+ * status,  unless NULL,  with the same error conditions as
+ * m2c_import_resolve.
+ * ----------------------------------------------------------------------- */
+
+m2c_ident_xlat_cache_t m2c_import_xlat_cache
+  (m2c_import_table_t table,
+   intstr_t module_id,
+   m2c_import_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_record_reexports(table, symtab)
+ * --------------------------------------------------------------------------
+ * Inserts a symbol of kind M2C_SYMTYPE_MODULE into the current scope of
+ * symtab for each library re-exported by the module of table and for each
+ * library re-exported by the interfaces of those in turn,  loading the
+ * interfaces of the libraries re-exported by the module.  Called on the
+ * top level scope of the symbol table of an interface module before its
+ * symbol file is written.  Libraries that are already present in symtab
+ * are skipped.
+ *
+ * error-conditions:
+ * o  if table or symtab is NULL, M2C_IMPORT_STATUS_INVALID_REFERENCE,
+ *    if an interface could not be loaded, M2C_IMPORT_STATUS_LOAD_FAILED,
+ *    if allocation failed, M2C_IMPORT_STATUS_ALLOCATION_FAILED
+ *    is returned,  the libraries of interfaces loaded are still inserted
+ * ----------------------------------------------------------------------- */
+
+m2c_import_status_t m2c_import_record_reexports
+  (m2c_import_table_t table, m2c_symtab_t symtab);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of libraries imported or re-exported by the module of
+ * table,  not counting libraries found through re-exports of interfaces.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_import_count (m2c_import_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_loaded_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of interfaces loaded so far by table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_import_loaded_count (m2c_import_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_import_table(table)
+ * --------------------------------------------------------------------------
+ * Releases the symbol files loaded and the translation caches created by
+ * table and deallocates it.  Attributes passed back by resolving identifiers
+ * and translations returned by its caches become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_import_table (m2c_import_table_t table);
+
+
+#endif /* M2C_IMPORT_LOADER_H */
+
+/* END OF FILE */
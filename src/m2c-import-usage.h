@@ -0,0 +1,126 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-import-usage.h                                                        *
+ *                                                                           *
+ * Interface for analysis of the use of imported modules.                    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_IMPORT_USAGE_H
+#define M2C_IMPORT_USAGE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-reachability.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_import_usage_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the result of an import usage analysis.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_import_usage_struct_t *m2c_import_usage_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_analyse_import_usage(module, reach)
+ * --------------------------------------------------------------------------
+ * Determines which of the modules imported by module AST module are referenced
+ * by it  and returns the result,  or NULL on allocation failure.  An import
+ * is used if its identifier occurs outside of the import list,  either on
+ * its own or as the qualifier of a qualified identifier.  Re-exported imports
+ * are always used.  Unless reach is NULL,  references within definitions
+ * found unreachable by reach are disregarded.
+ *
+ * The analysis is conservative.  If the module holds unparsed lazy bodies,
+ * all imports are used.  The module AST must hold its definitions,  ASTs
+ * built by m2c_parse_file_streaming do not.
+ * ----------------------------------------------------------------------- */
+
+m2c_import_usage_t m2c_analyse_import_usage
+  (m2c_astnode_t module, m2c_reachability_t reach);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_is_used(usage, module_id)
+ * --------------------------------------------------------------------------
+ * Returns false if module_id is imported but was found unused by analysis
+ * usage,  otherwise true.  Returns true if usage is NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_import_is_used (m2c_import_usage_t usage, intstr_t module_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_used_imports(usage, count)
+ * --------------------------------------------------------------------------
+ * Returns an array with the identifiers of the used imports in import order
+ * and passes their number in count.  The array is owned by usage  and is
+ * valid until usage is released.  Code generators emit the #include
+ * directives and initialisation calls of these imports only.  The array
+ * may be passed to m2c_write_dep_file as is.  If usage is NULL,  passes zero
+ * in count and returns NULL,  callers then fall back to the import list.
+ * ----------------------------------------------------------------------- */
+
+const intstr_t *m2c_used_imports (m2c_import_usage_t usage, uint_t *count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unused_import_count(usage)
+ * --------------------------------------------------------------------------
+ * Returns the number of imports found unused.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_unused_import_count (m2c_import_usage_t usage);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_import_usage(usage)
+ * --------------------------------------------------------------------------
+ * Deallocates usage.  The analysed AST is not affected.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_import_usage (m2c_import_usage_t usage);
+
+
+#endif /* M2C_IMPORT_USAGE_H */
+
+/* END OF FILE */
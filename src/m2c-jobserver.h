@@ -0,0 +1,187 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-jobserver.h                                                           *
+ *                                                                           *
+ * Public interface of GNU make jobserver client and server.                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_JOBSERVER_H
+#define M2C_JOBSERVER_H
+
+#include "m2c-common.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Jobserver
+ * --------------------------------------------------------------------------
+ * GNU make limits the number of concurrent jobs across recursive makes with
+ * a jobserver,  a pipe holding one token byte per job slot beyond the first.
+ * Every child of make owns one implicit slot,  a child that wants to run
+ * further jobs reads a token before starting each and writes it back when
+ * the job has finished.  Make announces the jobserver to its children in
+ * environment variable MAKEFLAGS.
+ *
+ * A client connects to the jobserver announced in MAKEFLAGS,  thus m2c and
+ * m2make share the job limit of a make that runs them.  A server creates a
+ * jobserver of its own  and announces it in MAKEFLAGS,  thus the compilers
+ * that m2make runs outside of make share the job limit given to m2make.
+ * Token handling is the same for both.  Tokens may be acquired and returned
+ * from any thread.
+ *
+ * Jobservers are available on POSIX hosts.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_JOBSERVER_AVAILABLE)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_JOBSERVER_AVAILABLE 1
+#else
+#define M2C_JOBSERVER_AVAILABLE 0
+#endif
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_jobserver_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a jobserver connection.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_jobserver_s *m2c_jobserver_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_jobserver_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on jobservers.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_JOBSERVER_STATUS_SUCCESS,
+  M2C_JOBSERVER_STATUS_NOT_AVAILABLE,
+  M2C_JOBSERVER_STATUS_IO_ERROR,
+  M2C_JOBSERVER_STATUS_ALLOCATION_FAILED
+} m2c_jobserver_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_connect()
+ * --------------------------------------------------------------------------
+ * Connects to the jobserver announced in environment variable MAKEFLAGS and
+ * returns the connection.  GNU make announces its jobserver as
+ * --jobserver-auth=R,W with inherited pipe descriptors R and W,  as
+ * --jobserver-auth=fifo:PATH with a named pipe at PATH since version 4.4,
+ * and as --jobserver-fds=R,W before 4.2.  The last announcement counts.
+ * Returns NULL if there is none,  or if make has withheld its descriptors
+ * because the command was not marked as recursive.
+ * ----------------------------------------------------------------------- */
+
+m2c_jobserver_t m2c_jobserver_connect (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_new_server(jobs, status)
+ * --------------------------------------------------------------------------
+ * Creates a jobserver for jobs concurrent jobs,  holding jobs - 1 tokens,
+ * announces it in MAKEFLAGS for child processes started from then on  and
+ * returns the connection.  Returns NULL if jobs is less than two.  Passes
+ * the status in status.
+ * ----------------------------------------------------------------------- */
+
+m2c_jobserver_t m2c_jobserver_new_server
+  (uint_t jobs, m2c_jobserver_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_for_jobs(jobs, status)
+ * --------------------------------------------------------------------------
+ * Connects to the jobserver announced in MAKEFLAGS if there is one and
+ * otherwise creates a server for jobs concurrent jobs.  Tools that may run
+ * both from make and standalone call this function.
+ * ----------------------------------------------------------------------- */
+
+m2c_jobserver_t m2c_jobserver_for_jobs
+  (uint_t jobs, m2c_jobserver_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_is_server(jobserver)
+ * --------------------------------------------------------------------------
+ * Returns true if jobserver was created by m2c_jobserver_new_server.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_jobserver_is_server (m2c_jobserver_t jobserver);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_jobserver_acquire(jobserver, timeout, token)
+ * --------------------------------------------------------------------------
+ * Waits up to timeout milliseconds for a token of jobserver,  or without
+ * limit if timeout is negative.  Passes the token in token and returns true
+ * if one was obtained,  otherwise returns false.  A wait interrupted by a
+ * signal returns false.  Without limit,  a token taken by another client
+ * first is waited for again.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_jobserver_acquire
+  (m2c_jobserver_t jobserver, int timeout, char *token);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_jobserver_return(jobserver, token)
+ * --------------------------------------------------------------------------
+ * Returns token to jobserver.  Every token acquired must be returned,  the
+ * jobserver permits one job less for every token that is lost.
+ * ----------------------------------------------------------------------- */
+
+void m2c_jobserver_return (m2c_jobserver_t jobserver, char token);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_jobserver_release(jobserver)
+ * --------------------------------------------------------------------------
+ * Disconnects from jobserver and passes NULL in jobserver.  A server is
+ * shut down and its announcement removed from MAKEFLAGS,  it should only be
+ * released after all child processes using it have finished.
+ * ----------------------------------------------------------------------- */
+
+void m2c_jobserver_release (m2c_jobserver_t *jobserver);
+
+
+#endif /* M2C_JOBSERVER_H */
+
+/* END OF FILE */
@@ -43,6 +43,8 @@
 #include "m2c-token.h"
 #include "m2c-common.h"
 #include "m2c-digest.h"
+#include "m2c-diagnostics.h"
+#include "m2c-numeric-value.h"
 #include "interned-strings.h"
 
 
@@ -101,6 +103,76 @@ void m2c_new_lexer
   (m2c_lexer_t *lexer, intstr_t filename, m2c_lexer_status_t *status);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_new_header_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_new_lexer  but opens the input file for reading of a prefix,  so
+ * that only as much of the file is read as has been lexed.  For parsing of
+ * module headers and import lists.  Pre-, post- and error-conditions are
+ * those of procedure m2c_new_lexer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_new_header_lexer
+  (m2c_lexer_t *lexer, intstr_t filename, m2c_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_new_text_lexer(lexer, filename, text, length, ...)
+ * --------------------------------------------------------------------------
+ * Like m2c_new_lexer  but reads a copy of the length characters at text
+ * instead of a file.  Filename is only used to identify the source.  Lines
+ * are counted from first_line,  thus a slice of a source that starts at the
+ * beginning of a line outside of any comment is lexed with the positions it
+ * has in the source.  For editors that hold unsaved sources in memory.
+ * ----------------------------------------------------------------------- */
+
+void m2c_new_text_lexer
+  (m2c_lexer_t *lexer,                /* out */
+   intstr_t filename,                 /* in */
+   const char *text,                  /* in */
+   size_t length,                     /* in */
+   uint_t first_line,                 /* in */
+   m2c_lexer_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_reset_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Associates an existing lexer with the source file represented by filename
+ * for reuse across files.  The symbols of the previous file are released,
+ * while the lexer object, its digest contexts, its token stream tables and
+ * its input buffer,  grown to the largest file read so far,  are retained.
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  parameter filename must not be NULL upon entry
+ *
+ * post-conditions:
+ * o  lexer reads from the file represented by filename
+ * o  status M2C_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer or filename is NULL upon entry, no operation is carried out
+ *    and status M2C_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if the file cannot be opened,  lexer is left at end of input and the
+ *    status of the failed open operation is returned
+ * ----------------------------------------------------------------------- */
+
+void m2c_reset_lexer
+  (m2c_lexer_t lexer, intstr_t filename, m2c_lexer_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_reset_header_lexer(lexer, filename, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_reset_lexer  but opens the input file for reading of a prefix.
+ * Pre-, post- and error-conditions are those of m2c_reset_lexer.
+ * ----------------------------------------------------------------------- */
+
+void m2c_reset_header_lexer
+  (m2c_lexer_t lexer, intstr_t filename, m2c_lexer_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_read_sym(lexer)
  * --------------------------------------------------------------------------
@@ -180,7 +252,7 @@ m2c_lexer_status_t m2c_lexer_status (m2c_lexer_t lexer);
  * Returns the lexeme of the lookahead symbol.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_lexer_lookahead_lexeme (m2c_lexer_t lexer);
+intstr_t m2c_lexer_lookahead_lexeme (m2c_lexer_t lexer);
 
 
 /* --------------------------------------------------------------------------
@@ -189,7 +261,31 @@ m2c_string_t m2c_lexer_lookahead_lexeme (m2c_lexer_t lexer);
  * Returns the lexeme of the most recently consumed symbol.
  * ----------------------------------------------------------------------- */
 
-m2c_string_t m2c_lexer_current_lexeme (m2c_lexer_t lexer);
+intstr_t m2c_lexer_current_lexeme (m2c_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_lookahead_text(lexer, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters of the lexeme of the lookahead symbol
+ * and passes their number in length.  String literals and comments are not
+ * copied but referenced in the source buffer,  the characters are therefore
+ * not NUL terminated.  Returns NULL and passes zero if there is no lexeme.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_lexer_lookahead_text (m2c_lexer_t lexer, uint_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_current_text(lexer, length)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the characters of the lexeme of the most recently
+ * consumed symbol and passes their number in length.  String literals and
+ * comments are not copied but referenced in the source buffer,  they are
+ * not NUL terminated.  Returns NULL and passes zero if there is no lexeme.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_lexer_current_text (m2c_lexer_t lexer, uint_t *length);
 
 
 /* --------------------------------------------------------------------------
@@ -228,6 +324,26 @@ uint_t m2c_lexer_lookahead_column (m2c_lexer_t lexer);
 uint_t m2c_lexer_current_column (m2c_lexer_t lexer);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_lookahead_value(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the value of the lookahead symbol if it is a numeric literal,
+ * otherwise M2C_NUMERIC_VALUE_NONE.
+ * ----------------------------------------------------------------------- */
+
+m2c_numeric_value_t m2c_lexer_lookahead_value (m2c_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_current_value(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the value of the most recently consumed symbol if it is a numeric
+ * literal, otherwise M2C_NUMERIC_VALUE_NONE.
+ * ----------------------------------------------------------------------- */
+
+m2c_numeric_value_t m2c_lexer_current_value (m2c_lexer_t lexer);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_lexer_digest(lexer)
  * --------------------------------------------------------------------------
@@ -237,6 +353,100 @@ uint_t m2c_lexer_current_column (m2c_lexer_t lexer);
 m2c_digest_value_t m2c_lexer_digest (m2c_lexer_t lexer);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_lexer_begin_decl_digest(lexer)
+ * --------------------------------------------------------------------------
+ * Starts a declaration digest.  From the lookahead symbol on,  every symbol
+ * consumed is added to the declaration digest  in the same way as to the
+ * module digest,  until m2c_lexer_end_decl_digest is called.  A declaration
+ * digest in progress is discarded.
+ * ----------------------------------------------------------------------- */
+
+void m2c_lexer_begin_decl_digest (m2c_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_end_decl_digest(lexer)
+ * --------------------------------------------------------------------------
+ * Ends the declaration digest  and returns its value  over the symbols
+ * consumed since it was started.  Returns zero if none was started.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_lexer_end_decl_digest (m2c_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_symbol_index(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the index of the lookahead symbol within the source file,  where
+ * the first symbol of the file has index zero.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_lexer_symbol_index (m2c_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_bytes_read(lexer)
+ * --------------------------------------------------------------------------
+ * Returns the number of bytes read from the source file so far.
+ * ----------------------------------------------------------------------- */
+
+size_t m2c_lexer_bytes_read (m2c_lexer_t lexer);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_lexer_flush_diagnostics(lexer, buffer, show_source)
+ * --------------------------------------------------------------------------
+ * Flushes diagnostic buffer to the console,  with the source lines of the
+ * source file of lexer if show_source is true,  see m2c_diag_flush.
+ * ----------------------------------------------------------------------- */
+
+void m2c_lexer_flush_diagnostics
+  (m2c_lexer_t lexer, m2c_diag_buffer_t buffer, bool show_source);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lexer_skip_to_symbol(lexer, index)
+ * --------------------------------------------------------------------------
+ * Makes the symbol with the given index the lookahead symbol and returns it.
+ * If the lexer has been pre-tokenised,  any index may be given,  otherwise
+ * symbols are consumed up to index,  which must not precede the lookahead
+ * symbol.  Stops at the end of the file.
+ * ----------------------------------------------------------------------- */
+
+m2c_token_t m2c_lexer_skip_to_symbol (m2c_lexer_t lexer, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_lexer_pretokenize(lexer, status)
+ * --------------------------------------------------------------------------
+ * Lexes the remaining input of the source file associated with lexer into a
+ * token stream held by lexer, then closes the source file.  From then on,
+ * m2c_read_sym, m2c_next_sym, m2c_consume_sym  and the lexeme, line and
+ * column accessors read symbols from the token stream by index.
+ *
+ * pre-conditions:
+ * o  parameter lexer must not be NULL upon entry
+ * o  parameter status may be NULL
+ *
+ * post-conditions:
+ * o  all remaining symbols up to and including EOF are held in lexer
+ * o  the source file associated with lexer is closed
+ * o  M2C_LEXER_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if lexer is NULL upon entry, no operation is carried out
+ *    and status M2C_LEXER_STATUS_INVALID_REFERENCE is returned
+ * o  if the token stream could not be allocated,  no operation is carried
+ *    out and status M2C_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * o  if the token stream could not be enlarged,  lexing stops,  the stream
+ *    is terminated with an EOF symbol and the source file is closed,
+ *    status M2C_LEXER_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+void m2c_lexer_pretokenize (m2c_lexer_t lexer, m2c_lexer_status_t *status);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_release_lexer(lexer, status)
  * --------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-library-bundle.h                                                      *
+ *                                                                           *
+ * Interface for library bundle archives.                                    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_LIBRARY_BUNDLE_H
+#define M2C_LIBRARY_BUNDLE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* --------------------------------------------------------------------------
+ * Library bundles
+ * --------------------------------------------------------------------------
+ * A library bundle holds the files of the modules of a library in a single
+ * file:  definition and implementation module sources,  symbol files and
+ * export list files.  It consists of a header,  one fixed size record per
+ * member,  a hash index on the records keyed on the interned key of the
+ * module identifier,  a table of NUL terminated module identifiers and the
+ * contents of the members,  each aligned to eight bytes,  all in host byte
+ * order.
+ *
+ * On hosts that provide mmap(),  a bundle is mapped into memory read-only
+ * when it is opened and its members are used in place,  thus a library of
+ * any number of modules costs one file open,  and a member is found by a
+ * single hash probe.  A bundle may be given in the module search path in
+ * place of a directory,  see m2c-search-path.h.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Library bundle format version
+ * ----------------------------------------------------------------------- */
+
+#define M2C_BUNDLE_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * Suffix of library bundle files
+ * ----------------------------------------------------------------------- */
+
+#define M2C_BUNDLE_SUFFIX ".m2lib"
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_bundle_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on library bundles.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_BUNDLE_STATUS_SUCCESS,
+  M2C_BUNDLE_STATUS_INVALID_REFERENCE,
+  M2C_BUNDLE_STATUS_IO_ERROR,
+  M2C_BUNDLE_STATUS_INVALID_FILE,
+  M2C_BUNDLE_STATUS_INVALID_MEMBER_NAME,
+  M2C_BUNDLE_STATUS_DUPLICATE_MEMBER,
+  M2C_BUNDLE_STATUS_ALLOCATION_FAILED
+} m2c_bundle_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_bundle_kind_t
+ * --------------------------------------------------------------------------
+ * Kinds of library bundle members,  by the suffix of the file they hold.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_BUNDLE_KIND_DEF,  /* .def */
+  M2C_BUNDLE_KIND_MOD,  /* .mod */
+  M2C_BUNDLE_KIND_SYM,  /* .sym */
+  M2C_BUNDLE_KIND_EXL   /* .exl */
+} m2c_bundle_kind_t;
+
+#define M2C_BUNDLE_KIND_COUNT (M2C_BUNDLE_KIND_EXL + 1)
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_bundle_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an open library bundle.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_bundle_s *m2c_bundle_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_is_bundle_path(path)
+ * --------------------------------------------------------------------------
+ * Returns true if path ends in M2C_BUNDLE_SUFFIX,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_is_bundle_path (const char *path);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_bundle(path, count, files, status)
+ * --------------------------------------------------------------------------
+ * Writes a library bundle to path holding the count files whose pathnames
+ * are in array files,  replacing any existing file.  Each file is entered
+ * as a member for the module and kind given by its basename and suffix.
+ *
+ * pre-conditions:
+ * o  path must be a valid pathname
+ * o  each file must be named <module identifier>.def, .mod, .sym or .exl
+ *
+ * post-conditions:
+ * o  a bundle holding the files has been written to path
+ * o  M2C_BUNDLE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if path or files is NULL, M2C_BUNDLE_STATUS_INVALID_REFERENCE,
+ *    if a file name is not of the required form,
+ *    M2C_BUNDLE_STATUS_INVALID_MEMBER_NAME,  if two files are of the same
+ *    module and kind, M2C_BUNDLE_STATUS_DUPLICATE_MEMBER,  if a file could
+ *    not be read or the bundle not be written, M2C_BUNDLE_STATUS_IO_ERROR,
+ *    if allocation failed, M2C_BUNDLE_STATUS_ALLOCATION_FAILED is passed
+ *    back in status, unless NULL,  and no file is left at path
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_bundle
+  (const char *path,                    /* in */
+   uint_t count,                        /* in */
+   const char *const files[],           /* in */
+   m2c_bundle_status_t *status);        /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_open_bundle(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the library bundle at path and returns it,  or NULL on failure.  On
+ * hosts that provide mmap(),  the bundle is mapped into memory read-only,
+ * otherwise it is read into memory.  The header and the layout of the index
+ * are checked on open,  each record is checked when it is first used.
+ *
+ * pre-conditions:
+ * o  path must be a valid pathname
+ *
+ * post-conditions:
+ * o  an open bundle is returned
+ * o  M2C_BUNDLE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if path is NULL, M2C_BUNDLE_STATUS_INVALID_REFERENCE,
+ *    if the file could not be read, M2C_BUNDLE_STATUS_IO_ERROR,
+ *    if it is not a bundle for this build, M2C_BUNDLE_STATUS_INVALID_FILE,
+ *    if allocation failed, M2C_BUNDLE_STATUS_ALLOCATION_FAILED is passed
+ *    back in status, unless NULL,  and NULL is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_bundle_t m2c_open_bundle
+  (const char *path, m2c_bundle_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bundle_member(bundle, module, kind, size)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the contents of the member of bundle for module of
+ * kind and passes back its size in size,  or returns NULL if there is no
+ * such member or its record is malformed.  The contents are valid until
+ * bundle is released.  They are not NUL terminated.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_bundle_member
+  (m2c_bundle_t bundle,                 /* in */
+   intstr_t module,                     /* in */
+   m2c_bundle_kind_t kind,              /* in */
+   size_t *size);                       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bundle_member_count(bundle)
+ * --------------------------------------------------------------------------
+ * Returns the number of members of bundle,  or zero if bundle is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_bundle_member_count (m2c_bundle_t bundle);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_bundle_member_at(bundle, index, module, kind)
+ * --------------------------------------------------------------------------
+ * Passes back the interned module identifier and the kind of the member at
+ * index in bundle,  in the order the members were written,  and returns
+ * true.  Returns false if index is out of range,  the record is malformed
+ * or the identifier could not be interned.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_bundle_member_at
+  (m2c_bundle_t bundle,                 /* in */
+   uint_t index,                        /* in */
+   intstr_t *module,                    /* out */
+   m2c_bundle_kind_t *kind);            /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_bundle(bundle)
+ * --------------------------------------------------------------------------
+ * Closes bundle and passes NULL in bundle.  All member contents returned
+ * for bundle become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_bundle (m2c_bundle_t *bundle);
+
+
+#endif /* M2C_LIBRARY_BUNDLE_H */
+
+/* END OF FILE */
@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-ll1-parser.h                                                          *
+ *                                                                           *
+ * Public interface of table driven LL(1) syntax checker module.             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_LL1_PARSER_H
+#define M2C_LL1_PARSER_H
+
+#include "m2c-common.h"
+
+#include "m2c-parser.h"
+#include "m2c-compiler-options.h"
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_ll1_check_file(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Checks the syntax of the Modula-2 source file represented by srcpath  with
+ * an explicit stack  driven by the parse table generated by gen-ll1-table
+ * from data/m2c-ll1-grammar.h.  No AST is built.  Prints syntax errors to
+ * stderr,  passes statistics in stats and the status in status.  Uses the
+ * compiler option snapshot options.  Status codes are those of the parser.
+ * ----------------------------------------------------------------------- */
+
+void m2c_ll1_check_file
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status);     /* out */
+
+#endif /* M2C_LL1_PARSER_H */
+
+/* END OF FILE */
@@ -0,0 +1,101 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-lsp-server.h                                                          *
+ *                                                                           *
+ * Interface for language server mode.                                       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_LSP_SERVER_H
+#define M2C_LSP_SERVER_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-compiler-options.h"
+
+#include <stdio.h>
+
+
+/* --------------------------------------------------------------------------
+ * Language server mode
+ * --------------------------------------------------------------------------
+ * In language server mode,  m2c serves an editor over the Language Server
+ * Protocol,  reading JSON-RPC messages framed by Content-Length headers from
+ * an input stream and writing responses and notifications to an output
+ * stream.  Each source opened in the editor is held as a resident document,
+ * see m2c-document.h,  thus its AST is kept across edits,  an edit relexes
+ * only the edited lines  and reparses only the enclosing definition.  The
+ * diagnostics of a source are published after it has been opened and after
+ * every change.
+ *
+ * The server synchronises documents incrementally.  Positions are converted
+ * between the UTF-16 code units of the protocol and the bytes of the source.
+ * The server handles initialize,  shutdown,  exit,  textDocument/didOpen,
+ * textDocument/didChange and textDocument/didClose,  any other request is
+ * answered with a method-not-found error  and any other notification is
+ * ignored.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Maximum size of a message body the server accepts
+ * ----------------------------------------------------------------------- */
+
+#define M2C_LSP_MAX_MESSAGE_SIZE (64 * 1024 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_lsp_serve(in, out, options)
+ * --------------------------------------------------------------------------
+ * Serves the messages read from stream in,  writing to stream out,  until an
+ * exit notification is received or in reaches its end.  Sources are parsed
+ * with compiler option snapshot options.  Returns the exit code of the
+ * server,  zero if the exit notification followed a shutdown request,  one
+ * otherwise.
+ *
+ * pre-conditions:
+ * o  the interned string repository has been initialised
+ * o  in and out are open in binary mode
+ * ----------------------------------------------------------------------- */
+
+int m2c_lsp_serve (FILE *in, FILE *out, m2c_compiler_options_t options);
+
+
+#endif /* M2C_LSP_SERVER_H */
+
+/* END OF FILE */
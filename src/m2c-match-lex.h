@@ -47,6 +47,7 @@
 #include "infile.h"
 #include "m2c-token.h"
 #include "interned-strings.h"
+#include "m2c-numeric-value.h"
 
 
 /* Semantic Symbols */
@@ -87,6 +88,19 @@ char m2c_match_ident_or_resword
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_match_lowline_ident_or_resword(infile, token, lexeme)
+ * --------------------------------------------------------------------------
+ * Matches the input  at the current reading position of infile  to a lowline
+ * identifier  allowing non-leading, non-trailing and non-consecutive lowline
+ * characters or a resword  and consumes it.  Passes  the associated token in
+ * token and its lexeme in lexeme.  Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+char m2c_match_lowline_ident_or_resword
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_match_numeric_literal(infile, token, lexeme)
  * --------------------------------------------------------------------------
@@ -99,6 +113,20 @@ char m2c_match_numeric_literal
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_match_numeric_literal_with_value(infile, token, lexeme, value)
+ * --------------------------------------------------------------------------
+ * Matches  the  input  at  the  current  reading position  of  infile  to  a
+ * numeric literal and consumes it.  Passes the associated token in token,
+ * its lexeme in lexeme and,  unless value is NULL,  its converted value in
+ * value.  Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+char m2c_match_numeric_literal_with_value
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   m2c_numeric_value_t *value);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_match_quoted_literal(infile, token, lexeme)
  * --------------------------------------------------------------------------
@@ -111,6 +139,21 @@ char m2c_match_quoted_literal
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_match_quoted_literal_with_slice(infile, token, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Matches  the  input  at  the  current  reading position  of  infile  to  a
+ * quoted literal  and consumes it.  Passes the associated token in token.
+ * If slice is not NULL  and the literal can be referenced in the buffer of
+ * infile,  passes a slice for it in slice and NULL in lexeme,  otherwise
+ * passes its lexeme in lexeme.  Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+char m2c_match_quoted_literal_with_slice
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   infile_slice_t *slice);
+
+
 /* Non-Semantic Symbols */
 
 /* --------------------------------------------------------------------------
@@ -126,6 +169,21 @@ char m2c_match_line_comment
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_match_line_comment_with_slice(infile, token, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Matches the input  at the  current reading position  of  infile  to a line
+ * comment and consumes it.  Passes the associated token in token.  If option
+ * preserve-comments is enabled,  passes the comment like function
+ * m2c_match_quoted_literal_with_slice,  otherwise passes NULL in lexeme.
+ * Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+char m2c_match_line_comment_with_slice
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   infile_slice_t *slice);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_match_block_comment(infile, token, lexeme)
  * --------------------------------------------------------------------------
@@ -139,6 +197,21 @@ char m2c_match_block_comment
   (infile_t infile, m2c_token_t *token, intstr_t *lexeme);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_match_block_comment_with_slice(infile, token, lexeme, slice)
+ * --------------------------------------------------------------------------
+ * Matches the input  at the  current reading position  of infile  to a block
+ * comment and consumes it.  Passes the associated token in token.  If option
+ * preserve-comments is enabled,  passes the comment like function
+ * m2c_match_quoted_literal_with_slice,  otherwise passes NULL in lexeme.
+ * Returns the new lookahead character.
+ * ----------------------------------------------------------------------- */
+
+char m2c_match_block_comment_with_slice
+  (infile_t infile, m2c_token_t *token, intstr_t *lexeme,
+   infile_slice_t *slice);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_match_pragma(infile, token, lexeme)
  * --------------------------------------------------------------------------
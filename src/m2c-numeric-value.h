@@ -0,0 +1,78 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-numeric-value.h                                                       *
+ *                                                                           *
+ * Interface for values of numeric literals converted during scanning.       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_NUMERIC_VALUE_H
+#define M2C_NUMERIC_VALUE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_numeric_value_t
+ * --------------------------------------------------------------------------
+ * Record type holding the value of a numeric literal as converted by the
+ * lexer.  For whole numbers and character codes the value is held in field
+ * whole,  for real numbers in field real.  Flag overflow is set if a whole
+ * number exceeds 64 bits,  a character code exceeds the Unicode code space,
+ * or a real number exceeds the range of type double.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  uint64_t whole;         /* value of whole number or character code */
+  double real;            /* value of real number */
+  bool is_real;           /* true if value is held in real */
+  bool overflow;          /* true if value is not representable */
+} m2c_numeric_value_t;
+
+
+/* --------------------------------------------------------------------------
+ * null value for initialisation
+ * ----------------------------------------------------------------------- */
+
+#define M2C_NUMERIC_VALUE_NONE { 0, 0.0, false, false }
+
+
+#endif /* M2C_NUMERIC_VALUE_H */
+
+/* END OF FILE */
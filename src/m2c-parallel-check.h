@@ -0,0 +1,202 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-parallel-check.h                                                      *
+ *                                                                           *
+ * Interface for parallel semantic checking of procedure bodies.             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_PARALLEL_CHECK_H
+#define M2C_PARALLEL_CHECK_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-diagnostics.h"
+#include "m2c-reachability.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Parallel semantic checking support
+ * --------------------------------------------------------------------------
+ * Once the module level identifiers of a module have been resolved,  the
+ * body of each module level procedure definition can be checked on its own.
+ * Procedure bodies are checked on a pool of worker threads if the interned
+ * string library is built with INTSTR_THREAD_SAFE set to 1  and diagnostic
+ * buffers are kept per thread.  This requires POSIX threads.  Otherwise
+ * procedure bodies are checked one after another by the calling thread with
+ * identical diagnostics.
+ *
+ * Each worker starts out with an equal share of the procedures,  a worker
+ * that has run out of work steals half of the remaining share of the worker
+ * with the most unchecked procedures.  Procedures of very different sizes
+ * are thus balanced across workers without a shared queue.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_PARALLEL_CHECK_SUPPORTED \
+  ((INTSTR_THREAD_SAFE) && (M2C_DIAG_THREAD_SAFE))
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_local_scope_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the local scope of a procedure,  that is
+ * the formal parameters and the local definitions of its block.  A local
+ * scope is built by the worker checking the procedure and is only valid for
+ * the duration of the handler call it is passed to.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_local_scope_struct_t *m2c_local_scope_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_check_proc_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure that checks the body of procedure definition proc
+ * with local scope scope  and reports its findings by m2c_diag_emit.
+ * Parameter worker is the index of the calling worker,  in the range zero
+ * to the worker count minus one,  for handlers that keep per worker state
+ * in context.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_check_proc_handler_t)
+  (m2c_astnode_t proc, m2c_local_scope_t scope, uint_t worker, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_local_scope_lookup(scope, ident)
+ * --------------------------------------------------------------------------
+ * Returns the node that defines identifier ident in local scope scope,  or
+ * NULL if ident is not defined locally and is thus to be resolved in the
+ * module scope.  Formal parameters are defined by their FPARAMS node,  local
+ * definitions by their CONST,  TYPEDEF,  VARDEF or PROC node.  Values of
+ * local enumeration types are defined by their TYPEDEF node.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_local_scope_lookup
+  (m2c_local_scope_t scope, intstr_t ident);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_local_scope_proc(scope)
+ * --------------------------------------------------------------------------
+ * Returns the procedure definition of local scope scope,  or NULL if scope
+ * is NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_local_scope_proc (m2c_local_scope_t scope);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_local_scope_count(scope)
+ * --------------------------------------------------------------------------
+ * Returns the number of identifiers defined in local scope scope.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_local_scope_count (m2c_local_scope_t scope);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_check_worker_count(count, threads)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers  m2c_check_procedures will use  for count
+ * procedures and a requested number of threads.  If threads is zero,  one
+ * worker per online processor is requested.  Without parallel checking
+ * support the result is always one.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_check_worker_count (uint_t count, uint_t threads);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_collect_procedures(module, reach, count)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated array of the module level procedure definitions
+ * of implementation or program module module in source order  and passes
+ * their number in count.  If reach is not NULL,  procedures that are not
+ * reachable in reach are omitted.  Returns NULL and passes zero in count if
+ * there are no procedures or allocation failed.  The array is to be
+ * deallocated by the caller using free.
+ *
+ * astnode: (IMPMOD moduleIdent implist (BLOCK defnListNode stmtSeqNode))
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t *m2c_collect_procedures
+  (m2c_astnode_t module, m2c_reachability_t reach, uint_t *count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_check_procedures(count, proc, handler, ...)
+ * --------------------------------------------------------------------------
+ * Checks the bodies of the count procedure definitions in array proc by
+ * calling handler for each,  on up to threads worker threads,  and adds the
+ * diagnostics reported to buffer diagnostics in array order.  The calling
+ * thread is one of the workers.  If threads is zero,  one worker per online
+ * processor is used.  Returns true if every procedure has been checked,
+ * false if a parameter is invalid or allocation failed.
+ *
+ * pre-conditions:
+ * o  the interned string repository has been initialised,  in concurrent
+ *    mode if M2C_PARALLEL_CHECK_SUPPORTED is true
+ * o  the module level identifiers have been resolved before the call  and
+ *    handler does not modify the module level symbols or the ASTs
+ * o  handler does not share mutable state between workers other than
+ *    through thread safe libraries
+ *
+ * post-conditions:
+ * o  each handler call has its own local scope and its own current
+ *    diagnostic buffer,  the current buffer of the calling thread is
+ *    restored before the function returns
+ * o  the diagnostics added to diagnostics are identical to those of calling
+ *    handler for proc[0] to proc[count-1] in turn,  regardless of the number
+ *    of workers and the order in which the procedures were checked
+ * ----------------------------------------------------------------------- */
+
+bool m2c_check_procedures
+  (uint_t count,                      /* in */
+   m2c_astnode_t proc[],              /* in */
+   m2c_check_proc_handler_t handler,  /* in */
+   void *context,                     /* in */
+   uint_t threads,                    /* in */
+   m2c_diag_buffer_t diagnostics);    /* in */
+
+
+#endif /* M2C_PARALLEL_CHECK_H */
+
+/* END OF FILE */
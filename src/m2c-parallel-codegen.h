@@ -0,0 +1,125 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-parallel-codegen.h                                                    *
+ *                                                                           *
+ * Public interface of parallel code generation module.                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_PARALLEL_CODEGEN_H
+#define M2C_PARALLEL_CODEGEN_H
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "outfile.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Parallel code generation support
+ * --------------------------------------------------------------------------
+ * Procedure definitions are translated on worker threads  if the interned
+ * string library is built with INTSTR_THREAD_SAFE set to 1.  This requires
+ * POSIX threads.  Otherwise procedures are translated one after another by
+ * the calling thread with identical results.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_PARALLEL_CODEGEN_SUPPORTED (INTSTR_THREAD_SAFE)
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_codegen_proc_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure that writes the C translation of procedure definition
+ * proc to outfile.  Parameter worker is the index of the calling worker,
+ * in the range zero to the worker count minus one,  for handlers that keep
+ * per worker state such as identifier translation caches in context.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_codegen_proc_handler_t)
+  (outfile_t outfile, m2c_astnode_t proc, uint_t worker, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_codegen_worker_count(count, threads)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers  m2c_generate_procedures will use for count
+ * procedures and a requested number of threads.  If threads is zero,  one
+ * worker per online processor is requested.  Without parallel code gene-
+ * ration support the result is always one.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_codegen_worker_count (uint_t count, uint_t threads);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_generate_procedures(outfile, count, proc, ...)
+ * --------------------------------------------------------------------------
+ * Translates the count procedure definitions in array proc by calling
+ * handler for each,  on up to threads worker threads,  and writes their
+ * translations to outfile in array order.  The calling thread is one of the
+ * workers.  Each handler call writes to a memory outfile of its own,  the
+ * collected output is appended to outfile  once all procedures have been
+ * translated.  If threads is zero,  one worker per online processor is
+ * used.  The status of the operation is passed back in status.
+ *
+ * pre-conditions:
+ * o  the interned string repository has been initialised,  in concurrent
+ *    mode if M2C_PARALLEL_CODEGEN_SUPPORTED is true
+ * o  handler does not modify the ASTs  and does not share mutable state
+ *    between workers other than through thread safe libraries
+ *
+ * post-conditions:
+ * o  the output written to outfile is byte identical to the output of
+ *    calling handler for proc[0] to proc[count-1] in turn on outfile
+ * o  status is FILEIO_STATUS_SUCCESS,  or the first failure encountered
+ *
+ * Handlers must not rely on the line and column of outfile,  which start at
+ * one for every procedure.
+ * ----------------------------------------------------------------------- */
+
+void m2c_generate_procedures
+  (outfile_t outfile,                 /* in */
+   uint_t count,                      /* in */
+   m2c_astnode_t proc[],              /* in */
+   m2c_codegen_proc_handler_t handler, /* in */
+   void *context,                     /* in */
+   uint_t threads,                    /* in */
+   outfile_status_t *status);         /* out */
+
+
+#endif /* M2C_PARALLEL_CODEGEN_H */
+
+/* END OF FILE */
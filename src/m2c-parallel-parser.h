@@ -0,0 +1,124 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-parallel-parser.h                                                     *
+ *                                                                           *
+ * Public interface of parallel front end module.                            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_PARALLEL_PARSER_H
+#define M2C_PARALLEL_PARSER_H
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-statistics.h"
+#include "m2c-parser.h"
+#include "m2c-compiler-options.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Parallel parsing support
+ * --------------------------------------------------------------------------
+ * Compilation units are parsed on worker threads  if the interned string
+ * library is built with INTSTR_THREAD_SAFE  and the AST module is built
+ * with M2C_AST_THREAD_SAFE,  both set to 1.  This requires POSIX threads.
+ * Otherwise units are parsed one after another by the calling thread with
+ * identical results.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_PARALLEL_PARSER_SUPPORTED \
+  ((INTSTR_THREAD_SAFE) && (M2C_AST_THREAD_SAFE))
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_parse_result_t
+ * --------------------------------------------------------------------------
+ * Record type for the outcome of parsing a compilation unit.  The AST is
+ * allocated in region,  which is owned by the caller.  Field stats is NULL
+ * if the source file could not be opened.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* ast */     m2c_astnode_t ast;
+  /* region */  m2c_ast_region_t region;
+  /* stats */   m2c_stats_t stats;
+  /* status */  m2c_parser_status_t status;
+} m2c_parse_result_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_parse_files(count, srcpath, options, threads, result)
+ * --------------------------------------------------------------------------
+ * Parses the count source files in array srcpath  on up to threads worker
+ * threads,  using compiler option snapshot options.  The calling thread is
+ * one of the workers.  If threads is zero,  one worker per online processor
+ * is used.  The outcome for srcpath[i] is passed back in result[i],  thus
+ * results are in input order  regardless of the order of completion.  Each
+ * unit is parsed in an AST region of its own.
+ *
+ * pre-conditions:
+ * o  the interned string repository has been initialised,  in concurrent
+ *    mode if M2C_PARALLEL_PARSER_SUPPORTED is true
+ * o  result is an array of at least count elements
+ *
+ * post-conditions:
+ * o  result[i] holds AST, region, statistics and status for srcpath[i]
+ *
+ * The repository is shared by all workers.  Interned strings are canonical
+ * across threads,  thus ASTs are identical to those of sequential parsing.
+ * ----------------------------------------------------------------------- */
+
+void m2c_parse_files
+  (uint_t count,                      /* in */
+   const char *srcpath[],             /* in */
+   m2c_compiler_options_t options,    /* in */
+   uint_t threads,                    /* in */
+   m2c_parse_result_t result[]);      /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_parse_results(count, result)
+ * --------------------------------------------------------------------------
+ * Releases the AST regions and statistics objects of the count results in
+ * array result  and clears the results.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_parse_results (uint_t count, m2c_parse_result_t result[]);
+
+
+#endif /* M2C_PARALLEL_PARSER_H */
+
+/* END OF FILE */
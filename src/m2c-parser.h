@@ -43,7 +43,10 @@
 #include "m2c-common.h"
 
 #include "m2c-ast.h"
-#include "m2c-stats.h"
+#include "m2c-statistics.h"
+#include "m2c-compiler-options.h"
+#include "m2c-const-fold.h"
+#include "m2c-diagnostics.h"
 
 
 /* --------------------------------------------------------------------------
@@ -85,14 +88,216 @@ typedef enum {
  * syntax tree (AST) and returns it.  Returns an incomplete AST if errors are
  * encountered, or an empty AST if the source file cannot be found or opened,
  * or NULL if memory allocation failed.  Prints warnings and errors to stderr
- * and passes statistics in stats.  Passes the status in status.
+ * and passes statistics in stats.  Passes the status in status.  Uses a
+ * snapshot of the current compiler options taken on entry.
  * ----------------------------------------------------------------------- */
  
- m2c_ast_t m2c_parse_file
+ m2c_astnode_t m2c_parse_file
    (const char *srcpath,           /* in */
     m2c_stats_t *stats,            /* out */
     m2c_parser_status_t *status);  /* out */
 
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file_with_options(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file  but uses the compiler option snapshot options.  All
+ * state of a parse is held in a parser context of its own,  thus calls are
+ * reentrant  provided that each thread builds its AST in a region of its
+ * own  and access to the interned string repository is serialised.
+ * ----------------------------------------------------------------------- */
+ 
+ m2c_astnode_t m2c_parse_file_with_options
+   (const char *srcpath,              /* in */
+    m2c_compiler_options_t options,   /* in */
+    m2c_stats_t *stats,               /* out */
+    m2c_parser_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file_folding(srcpath, options, folder, stats, status)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file_with_options  but records the values of numeric
+ * literals as converted by the lexer in folder,  so that a subsequent call
+ * of m2c_fold_constants on the resulting AST need not convert them again.
+ * ----------------------------------------------------------------------- */
+ 
+ m2c_astnode_t m2c_parse_file_folding
+   (const char *srcpath,              /* in */
+    m2c_compiler_options_t options,   /* in */
+    m2c_const_fold_t folder,          /* in */
+    m2c_stats_t *stats,               /* out */
+    m2c_parser_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_header(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Parses the module header and import list of the Modula-2 source file
+ * represented by srcpath  and returns an AST whose module node holds the
+ * module identifier and import list  with an empty body.  Parsing stops
+ * right after the last import  and the file is read only up to the symbol
+ * following it,  rounded up to INFILE_PREFIX_CHUNK_SIZE bytes.  For use by
+ * dependency analysis in m2c and m2mkdep.  Results and status are those of
+ * m2c_parse_file_with_options.
+ * ----------------------------------------------------------------------- */
+ 
+ m2c_astnode_t m2c_parse_header
+   (const char *srcpath,              /* in */
+    m2c_compiler_options_t options,   /* in */
+    m2c_stats_t *stats,               /* out */
+    m2c_parser_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_parser_defn_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure that receives the AST of a top-level definition from
+ * the streaming parser as soon as the definition has been parsed.  The nodes
+ * of defn are deallocated when the handler returns,  a handler that needs to
+ * keep information,  such as symbols for later definitions,  must copy it.
+ * Interned strings remain valid.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_parser_defn_handler_t)
+  (m2c_astnode_t defn, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_file_streaming(srcpath, options, ...)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file_with_options  but for each top-level definition of a
+ * program or implementation module,  calls handler with the AST of the
+ * definition and context  as soon as the definition has been parsed,  then
+ * deallocates the AST of the definition.  The definitions are built in a
+ * scratch region of their own that is reset after each call of handler,
+ * thus peak AST memory is proportional to the largest definition  rather
+ * than to the size of the module.  The returned AST holds the module node
+ * with an empty definition list.  Interface modules are parsed as by
+ * m2c_parse_file_with_options.  For translators that emit C while parsing.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_parse_file_streaming
+  (const char *srcpath,                /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_parser_defn_handler_t handler,  /* in */
+   void *context,                      /* in */
+   m2c_stats_t *stats,                 /* out */
+   m2c_parser_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_check_syntax(srcpath, options, stats, status)
+ * --------------------------------------------------------------------------
+ * Checks the syntax of the Modula-2 source file represented by srcpath  and
+ * discards any AST built.  Uses the recursive descent parser,  or if the
+ * build parameter M2C_PARSER_ENGINE_LL1 is set,  the table driven engine of
+ * module m2c-ll1-parser.  Errors, statistics and status are reported as by
+ * m2c_parse_file_with_options.
+ * ----------------------------------------------------------------------- */
+
+void m2c_check_syntax
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_stats_t *stats,               /* out */
+   m2c_parser_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_parser_set_lazy_bodies(enabled)
+ * --------------------------------------------------------------------------
+ * Enables or disables lazy parsing of bodies.  While enabled,  the parser
+ * skips the statement sequence of every block by tracking the nesting of
+ * END-terminated statements  and records the range of skipped symbols in a
+ * LAZYBODY node in place of the statement sequence.  Suitable for runs that
+ * only need declarations,  such as interface checks and dependency analysis.
+ * Sets option M2C_COMPILER_OPTION_LAZY_BODIES,  which is taken into option
+ * snapshots like all other options.
+ * ----------------------------------------------------------------------- */
+
+void m2c_parser_set_lazy_bodies (bool enabled);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_lazy_body(srcpath, options, body_node, status)
+ * --------------------------------------------------------------------------
+ * Parses the statement sequence recorded in LAZYBODY node body_node  from
+ * the source file represented by srcpath,  which must be unchanged since it
+ * was parsed in lazy mode,  and returns its AST.  Returns NULL if body_node
+ * is not a LAZYBODY node or memory allocation failed,  or an empty AST if
+ * the body is empty.  Uses compiler option snapshot options.  Passes the
+ * status in status.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_parse_lazy_body
+  (const char *srcpath,              /* in */
+   m2c_compiler_options_t options,   /* in */
+   m2c_astnode_t body_node,          /* in */
+   m2c_parser_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_parser_span_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure that receives the AST of a top-level definition and
+ * the line numbers of its first and last symbol  as soon as the definition
+ * has been parsed.  Unlike with m2c_parser_defn_handler_t,  the AST of the
+ * definition is retained as part of the module AST.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_parser_span_handler_t)
+  (m2c_astnode_t defn, uint_t first_line, uint_t last_line, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_text(name, text, length, options, handler, ...)
+ * --------------------------------------------------------------------------
+ * Like m2c_parse_file_with_options  but parses the length characters at
+ * text,  such as the unsaved contents of an editor buffer,  as the source
+ * represented by name.  If handler is not NULL,  it is called with context
+ * for each top-level definition of a program or implementation module.
+ * Diagnostics are not printed but added to buffer diagnostics.  Bodies are
+ * always parsed in full.  Returns the AST,  or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_parse_text
+  (const char *name,                   /* in */
+   const char *text,                   /* in */
+   size_t length,                      /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_parser_span_handler_t handler,  /* in */
+   void *context,                      /* in */
+   m2c_diag_buffer_t diagnostics,      /* in */
+   m2c_parser_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_parse_definitions_text(name, text, length, first_line, ...)
+ * --------------------------------------------------------------------------
+ * Parses a sequence of top-level definitions  from the length characters at
+ * text,  which must start at the beginning of line first_line of the source
+ * represented by name  outside of any comment,  and returns a DEFNLIST node
+ * with the definitions parsed,  an empty node if there are none,  or NULL
+ * if allocation failed.  If handler is not NULL,  it is called with context
+ * for each definition as by m2c_parse_text.  Diagnostics are added to buffer
+ * diagnostics with the line numbers they have in the source.  Parsing stops
+ * at the first symbol that cannot start a definition,  passes true in
+ * complete if that is the end of text.  Declaration keys are those of a
+ * parse of the whole source.  For incremental reparsing by editors.
+ * ----------------------------------------------------------------------- */
+
+m2c_astnode_t m2c_parse_definitions_text
+  (const char *name,                   /* in */
+   const char *text,                   /* in */
+   size_t length,                      /* in */
+   uint_t first_line,                  /* in */
+   m2c_compiler_options_t options,     /* in */
+   m2c_parser_span_handler_t handler,  /* in */
+   void *context,                      /* in */
+   m2c_diag_buffer_t diagnostics,      /* in */
+   bool *complete,                     /* out */
+   m2c_parser_status_t *status);       /* out */
+
 #endif /* M2C_PARSER_H */
 
 /* END OF FILE */
@@ -47,12 +47,12 @@
  * Enumerated values representing Modula-2 grammar productions.
  * ----------------------------------------------------------------------- */
 
-#define PROD(_caps, _id, _first, _follow) P_##_caps
+#define PROD(_caps, _id, _first, _follow) P_##_caps,
 
 typedef enum {  
   P_INVALID,
   #include "production-data.h"  
-, P_END_MARK /* marks the end of the enumeration */
+  P_END_MARK /* marks the end of the enumeration */
 } m2c_production_t;
 
 #undef PROD
@@ -0,0 +1,129 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-reachability.h                                                        *
+ *                                                                           *
+ * Interface for reachability analysis of module level definitions.          *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_REACHABILITY_H
+#define M2C_REACHABILITY_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_reachability_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the result of a reachability analysis.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_reachability_struct_t *m2c_reachability_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_analyse_reachability(module, interface)
+ * --------------------------------------------------------------------------
+ * Determines which module level constant,  type,  variable and procedure
+ * definitions of program or implementation module AST module are reachable
+ * from its roots  and returns the result,  or NULL on allocation failure.
+ * The roots are the module body,  procedures bound to built-in syntax  and
+ * the identifiers defined by interface module AST interface,  which is NULL
+ * for program modules.  A definition is reachable if a root or a reachable
+ * definition refers to its identifier.
+ *
+ * The analysis is conservative.  Identifiers are resolved by name in module
+ * scope,  thus a local identifier shadowing a module level definition keeps
+ * the latter.  If the module holds unparsed lazy bodies or the analysis runs
+ * out of memory,  all definitions are reachable.  The module AST must hold
+ * its definitions,  ASTs built by m2c_parse_file_streaming do not.
+ * ----------------------------------------------------------------------- */
+
+m2c_reachability_t m2c_analyse_reachability
+  (m2c_astnode_t module, m2c_astnode_t interface);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_is_reachable(reach, defn)
+ * --------------------------------------------------------------------------
+ * Returns false if module level definition defn was found unreachable by
+ * analysis reach,  otherwise true.  Code generators do not emit definitions
+ * for which false is returned.  Defn may be wrapped in a keyed DECL node.
+ * Returns true for nodes that are not module level definitions and if reach
+ * is NULL.  A variable definition is reachable if any of its identifiers is.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_is_reachable (m2c_reachability_t reach, m2c_astnode_t defn);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unreachable_count(reach)
+ * --------------------------------------------------------------------------
+ * Returns the number of module level definitions found unreachable.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_unreachable_count (m2c_reachability_t reach);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_filter_reachable(reach, count, defn)
+ * --------------------------------------------------------------------------
+ * Removes the definitions for which m2c_is_reachable returns false from the
+ * count definitions in array defn,  preserving the order of the remaining
+ * ones,  and returns their number.  For use on the procedure array passed
+ * to m2c_generate_procedures.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_filter_reachable
+  (m2c_reachability_t reach, uint_t count, m2c_astnode_t defn[]);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_reachability(reach)
+ * --------------------------------------------------------------------------
+ * Deallocates reach.  The analysed ASTs are not affected.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_reachability (m2c_reachability_t reach);
+
+
+#endif /* M2C_REACHABILITY_H */
+
+/* END OF FILE */
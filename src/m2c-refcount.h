@@ -0,0 +1,196 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-refcount.h                                                            *
+ *                                                                           *
+ * Interface for analysis and translation of reference count updates.        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_REFCOUNT_H
+#define M2C_REFCOUNT_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "outfile.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Reference count updates
+ * --------------------------------------------------------------------------
+ * RETAIN and RELEASE statements are translated to calls of the runtime's
+ * reference counting macros,  which update the count atomically.  Before
+ * translation,  the body of each procedure is analysed to avoid updates:
+ *
+ * o  a RETAIN followed later in the same statement sequence by a RELEASE of
+ *    the same designator is cancelled with it,  provided that no statement
+ *    in between may release an object,  call a procedure or function,  or
+ *    assign to the designator or to a variable it depends on,
+ *
+ * o  updates of the count of an object that is allocated by NEW into a
+ *    local variable which is never assigned otherwise and never escapes,
+ *    i.e. is only used in NEW,  RETAIN and RELEASE and dereferenced,  are
+ *    written as plain,  non-atomic updates,  since no other thread can hold
+ *    a reference to the object.
+ *
+ * Dispositions are recorded per position in a statement sequence.  If a
+ * statement sequence is shared by hash-consing  and analysed with different
+ * outcomes,  the atomic update is kept.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_refcount_mode_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the translation of RETAIN and RELEASE.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_REFCOUNT_ATOMIC,  /* M2C_RETAIN(d), M2C_RELEASE(d) */
+  M2C_REFCOUNT_PLAIN,   /* M2C_RETAIN_LOCAL(d), M2C_RELEASE_LOCAL(d) */
+  M2C_REFCOUNT_ELIDED   /* no code */
+} m2c_refcount_mode_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_refcount_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a table of refcount dispositions.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_refcount_table_struct_t *m2c_refcount_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_local_predicate_f
+ * --------------------------------------------------------------------------
+ * Type of a function that returns true if identifier node ident_node,  an
+ * IDENT node,  denotes a local variable of the procedure being analysed,
+ * and not a parameter,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_local_predicate_f)
+  (m2c_astnode_t ident_node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_refcount_node_writer_f
+ * --------------------------------------------------------------------------
+ * Type of a function that writes the C translation of designator node to
+ * outfile.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_refcount_node_writer_f)
+  (outfile_t outfile, m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_refcount_table()
+ * --------------------------------------------------------------------------
+ * Returns a new empty refcount table,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_refcount_table_t m2c_new_refcount_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_analyse_refcounts(table, body, is_local, context)
+ * --------------------------------------------------------------------------
+ * Analyses the RETAIN and RELEASE statements of procedure body body,  enters
+ * their dispositions into table and returns the number of statements that
+ * were elided or made plain.  Function is_local is called with context to
+ * decide whether an identifier denotes a local variable.  If the table
+ * cannot be enlarged,  remaining statements are not entered and keep their
+ * atomic updates.
+ *
+ * astnodes:
+ *  (STMTSEQ stmtNode+)
+ *  (RETAIN desigNode) | (RELEASE desigNode)
+ *  (NEW desigNode) | (NEWARG desigNode initValNode) | (NEWCAP desigNode ...)
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_analyse_refcounts
+  (m2c_refcount_table_t table,              /* in */
+   m2c_astnode_t body,                      /* in */
+   m2c_local_predicate_f is_local,          /* in */
+   void *context);                          /* in */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_refcount_mode(table, stmt_seq, index)
+ * --------------------------------------------------------------------------
+ * Returns the disposition of the RETAIN or RELEASE statement at index in
+ * statement sequence stmt_seq,  or M2C_REFCOUNT_ATOMIC if none is entered.
+ * ----------------------------------------------------------------------- */
+
+m2c_refcount_mode_t m2c_refcount_mode
+  (m2c_refcount_table_t table, m2c_astnode_t stmt_seq, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_refcount_update(outfile, table, stmt_seq, index, ...)
+ * --------------------------------------------------------------------------
+ * Writes the translation of the RETAIN or RELEASE statement at index in
+ * statement sequence stmt_seq to outfile by its disposition,  calling
+ * writer with context for the designator.  Nothing is written for an
+ * elided statement.  The macros are expected to be defined by the runtime.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_refcount_update
+  (outfile_t outfile,                       /* in */
+   m2c_refcount_table_t table,              /* in */
+   m2c_astnode_t stmt_seq,                  /* in */
+   uint_t index,                            /* in */
+   m2c_refcount_node_writer_f writer,       /* in */
+   void *context);                          /* in */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_refcount_table(table)
+ * --------------------------------------------------------------------------
+ * Deallocates table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_refcount_table (m2c_refcount_table_t table);
+
+
+#endif /* M2C_REFCOUNT_H */
+
+/* END OF FILE */
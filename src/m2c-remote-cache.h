@@ -0,0 +1,237 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-remote-cache.h                                                        *
+ *                                                                           *
+ * Public interface of remote compile cache module.                          *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_REMOTE_CACHE_H
+#define M2C_REMOTE_CACHE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-compile-cache.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Remote compile cache
+ * --------------------------------------------------------------------------
+ * A remote cache shares the entries of the local compile cache between
+ * machines,  such as CI agents and developer workstations.  It stores each
+ * output of an entry as a blob named by its key and output,  see function
+ * m2c_cache_blob_name.  Blobs are transferred by a backend,  a record of
+ * procedures to get and put a blob,  so that transports can be plugged in.
+ * The built-in backend speaks HTTP:  a blob is read with GET and written
+ * with PUT at the URL of the cache followed by the blob name,  which suits
+ * plain web servers with WebDAV as well as dedicated cache services.
+ *
+ * Lookups are local first,  the remote cache is only asked on a miss in the
+ * local cache,  and blobs fetched remotely are entered into the local cache.
+ * Uploads are asynchronous:  they are made by a detached process that reads
+ * the immutable local entry,  thus neither the compiler nor the build tool
+ * waits for them.  All network operations time out after M2C_REMOTE_CACHE_
+ * TIMEOUT_MS milliseconds,  an unreachable cache is treated as a miss.
+ *
+ * The remote cache is configured with environment variable M2C_REMOTE_CACHE
+ * holding its URL,  for example  http://cache.example.org:8080/m2c.  HTTPS is
+ * not supported by the built-in backend,  use a local forwarding proxy.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Environment variable holding the URL of the remote cache
+ * ----------------------------------------------------------------------- */
+
+#define M2C_REMOTE_CACHE_URL_ENV "M2C_REMOTE_CACHE"
+
+
+/* --------------------------------------------------------------------------
+ * Timeout of network operations in milliseconds
+ * ----------------------------------------------------------------------- */
+
+#define M2C_REMOTE_CACHE_TIMEOUT_MS 2000
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_remote_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on remote caches.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_REMOTE_STATUS_SUCCESS,
+  M2C_REMOTE_STATUS_INVALID_REFERENCE,
+  M2C_REMOTE_STATUS_INVALID_URL,
+  M2C_REMOTE_STATUS_NOT_CONFIGURED,
+  M2C_REMOTE_STATUS_BLOB_NOT_FOUND,
+  M2C_REMOTE_STATUS_CONNECTION_FAILED,
+  M2C_REMOTE_STATUS_PROTOCOL_ERROR,
+  M2C_REMOTE_STATUS_IO_ERROR,
+  M2C_REMOTE_STATUS_ALLOCATION_FAILED
+} m2c_remote_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_remote_get_t
+ * --------------------------------------------------------------------------
+ * Type of a backend procedure that reads blob name from the remote cache
+ * into a new file at path  and returns true on success.  The file must be
+ * written under a temporary name and renamed,  thus left untouched on
+ * failure.  Passes M2C_REMOTE_STATUS_BLOB_NOT_FOUND in status if there is
+ * no such blob.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_remote_get_t)
+  (void *context, const char *name, const char *path,
+   m2c_remote_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_remote_put_t
+ * --------------------------------------------------------------------------
+ * Type of a backend procedure that writes the contents of the file at path
+ * as blob name to the remote cache  and returns true on success.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_remote_put_t)
+  (void *context, const char *name, const char *path,
+   m2c_remote_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_remote_release_t
+ * --------------------------------------------------------------------------
+ * Type of a backend procedure that deallocates the context of a backend.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_remote_release_t) (void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_remote_backend_t
+ * --------------------------------------------------------------------------
+ * Record type representing a remote cache backend.  Each procedure is
+ * called with the context of the backend.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* get */      m2c_remote_get_t get;
+  /* put */      m2c_remote_put_t put;
+  /* release */  m2c_remote_release_t release;
+  /* context */  void *context;
+} m2c_remote_backend_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_remote_http_backend(url, backend, status)
+ * --------------------------------------------------------------------------
+ * Initialises backend as an HTTP backend for the remote cache at url  and
+ * returns true on success.  Url must be of the form  http://host[:port][/
+ * path].  No connection is made until the first blob is transferred.
+ * Passes M2C_REMOTE_STATUS_INVALID_URL in status if url is malformed.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_remote_http_backend
+  (const char *url,                         /* in */
+   m2c_remote_backend_t *backend,           /* out */
+   m2c_remote_status_t *status);            /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_remote_backend_from_env(backend, status)
+ * --------------------------------------------------------------------------
+ * Initialises backend as an HTTP backend for the URL in environment
+ * variable M2C_REMOTE_CACHE  and returns true on success.  Passes
+ * M2C_REMOTE_STATUS_NOT_CONFIGURED in status if the variable is not set.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_remote_backend_from_env
+  (m2c_remote_backend_t *backend, m2c_remote_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_remote_cache_fetch(backend, cache_dir, key, output_path, ...)
+ * --------------------------------------------------------------------------
+ * Like m2c_cache_fetch,  but on a miss in the local cache at cache_dir,
+ * gets the requested outputs from the remote cache of backend,  copies them
+ * to their paths  and enters them into the local cache.  Returns true if
+ * all requested outputs were found locally or remotely.  On a remote miss
+ * or failure,  no output is written.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_remote_cache_fetch
+  (const m2c_remote_backend_t *backend,     /* in */
+   const char *cache_dir,                   /* in */
+   const m2c_cache_key_t *key,              /* in */
+   const char *const output_path[],         /* in */
+   m2c_remote_status_t *status);            /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_remote_cache_upload(backend, cache_dir, key, outputs, ...)
+ * --------------------------------------------------------------------------
+ * Starts a detached process that puts the outputs of the local entry for
+ * key in the cache at cache_dir,  for which the element of array outputs is
+ * true,  to the remote cache of backend,  and returns at once.  The entry
+ * must have been stored with m2c_cache_store.  Failed uploads are ignored.
+ * On hosts without fork(),  the upload is made before returning.
+ * ----------------------------------------------------------------------- */
+
+void m2c_remote_cache_upload
+  (const m2c_remote_backend_t *backend,     /* in */
+   const char *cache_dir,                   /* in */
+   const m2c_cache_key_t *key,              /* in */
+   const bool outputs[],                    /* in */
+   m2c_remote_status_t *status);            /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_remote_backend_release(backend)
+ * --------------------------------------------------------------------------
+ * Deallocates the context of backend  and clears backend.
+ * ----------------------------------------------------------------------- */
+
+void m2c_remote_backend_release (m2c_remote_backend_t *backend);
+
+
+#endif /* M2C_REMOTE_CACHE_H */
+
+/* END OF FILE */
@@ -69,6 +69,6 @@ m2c_token_t m2c_resword_token_for_lexeme
 intstr_t m2c_resword_lexeme_for_token (m2c_token_t token);
 
 
-#endif M2C_RESWORDS_H
+#endif /* M2C_RESWORDS_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -19,9 +19,9 @@
  *                                                                           *
  * @file                                                                     *
  *                                                                           *
- * m2c-follow-sets.c                                                         *
+ * m2c-resync-sets.h                                                         *
  *                                                                           *
- * Implementation of FOLLOW sets module.                                     *
+ * Public interface for resync sets module.                                  *
  *                                                                           *
  * @license                                                                  *
  *                                                                           *
@@ -37,64 +37,63 @@
  * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#ifndef M2C_RESYNC_SETS_H
+#define M2C_RESYNC_SETS_H
+
 /* --------------------------------------------------------------------------
  * imports
  * ----------------------------------------------------------------------- */
 
 #include "m2c-tokenset.h"
-#include "m2c-productions.h"
-
-#include <stddef.h> /* NULL */
-#include <stdint.h> /* uint8_t */
 
 
 /* --------------------------------------------------------------------------
- * FOLLOW set table, pruned
+ * type m2c_resync_set_t
  * --------------------------------------------------------------------------
- * Table of follow sets with cardinality > 1 and without duplicates.
+ * Enumerated values representing the resync sets used in error recovery,
+ * each the union of a token and FIRST and FOLLOW sets.  The sets are defined
+ * in resync-data.h of utility gen-first-follow-sets.
  * ----------------------------------------------------------------------- */
 
-#define DATA(_prod, _set_literal) _set_literal,
+#define DATA(_name, _set_literal) RESYNC_ ## _name,
 
-static const m2c_tokenset_t *follow_set[] = {
-  NULL, /* sentinel for pruned entries */
-  #include "m2c-follow-set-literals.h"
-}; /* end first_set */
+typedef enum {
+  #include "m2c-resync-set-literals.h"
+  RESYNC_END_MARK /* marks the end of the enumeration */
+} m2c_resync_set_t;
 
 #undef DATA
 
 
 /* --------------------------------------------------------------------------
- * FOLLOW set lookup table
+ * RESYNC set table
  * --------------------------------------------------------------------------
- * Table to map productions to pruned follow set table indices.
+ * Static table of resync sets.  The sets are constant literals  generated
+ * by gen-resync-sets,  no union is computed at runtime.
  * ----------------------------------------------------------------------- */
 
-typedef uint8_t table_index_t;   /* unsigned char if uint8_t is missing */
-
-#define DATA(_prod, _index) _index,
+#define DATA(_name, _set_literal) M2C_TOKENSET_LITERAL _set_literal,
 
-static const table_index_t index_table[] = {
-  #include "m2c_follow-set-lookup.h"
-}; /* end index_table */
+static const m2c_tokenset_s m2c_resync_set_table[] = {
+  #include "m2c-resync-set-literals.h"
+  { { 0 }, 0 } /* sentinel */
+}; /* end m2c_resync_set_table */
 
 #undef DATA
 
 
 /* --------------------------------------------------------------------------
- * function FOLLOW(production)
+ * macro RESYNC(name)
  * --------------------------------------------------------------------------
- * Returns the FOLLOW set of p if p is valid and |FOLLOW(p)| > 1, else NULL.
+ * Returns the resync set with the given name,  eg.
+ * RESYNC(SEMICOLON_OR_FOLLOW_STATEMENT).  Resolves to a constant address at
+ * compile time.  The set must not be modified or released.
  * ----------------------------------------------------------------------- */
 
-const m2c_tokenset_t FOLLOW (m2c_production_t p) {
- 
-  if (IS_VALID_PRODUCTION(p)) {
-    return follow_set[index_table[p]];
-  }
-  else /* invalid production */ {
-    return NULL;
-  } /* end if */
-} /* end FOLLOW */
-
-/* END OF FILE */
\ No newline at end of file
+#define RESYNC(_name) \
+  ((m2c_tokenset_t) &m2c_resync_set_table[RESYNC_ ## _name])
+
+
+#endif /* M2C_RESYNC_SETS_H */
+
+/* END OF FILE */
@@ -0,0 +1,197 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-search-path.h                                                         *
+ *                                                                           *
+ * Public interface of module search path resolution.                        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_SEARCH_PATH_H
+#define M2C_SEARCH_PATH_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* --------------------------------------------------------------------------
+ * Module search path
+ * --------------------------------------------------------------------------
+ * A search path is a list of directories in which the sources of imported
+ * modules are looked up,  the first directory holding a source of a module
+ * takes precedence.  Instead of testing for a file of the module in every
+ * directory on every lookup,  each directory is listed once  and its source
+ * files are entered into a table keyed on module identifiers,  a lookup is
+ * then a single hash probe  whether the module is found or not.
+ *
+ * A search path records the modification time of each directory when it was
+ * listed.  A refresh relists the directories only if one of them changed,
+ * thus a compile server can keep a search path across requests.
+ *
+ * A library bundle,  see m2c-library-bundle.h,  may be given in place of a
+ * directory.  It is opened when the search path is listed  and its members
+ * are entered like the files of a directory,  under the pathname of the
+ * bundle followed by the name of the member file.  Their contents are held
+ * in memory and obtained with m2c_search_path_contents,  thus resolving an
+ * import from a bundle opens no file.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_search_path_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a module search path.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_search_path_s *m2c_search_path_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_search_path_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on search paths.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_SEARCH_PATH_STATUS_SUCCESS,
+  M2C_SEARCH_PATH_STATUS_INVALID_REFERENCE,
+  M2C_SEARCH_PATH_STATUS_ALLOCATION_FAILED
+} m2c_search_path_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_source_kind_t
+ * --------------------------------------------------------------------------
+ * Kinds of module files found on a search path:  sources,  symbol files and
+ * export list files.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_SOURCE_KIND_DEF,
+  M2C_SOURCE_KIND_MOD,
+  M2C_SOURCE_KIND_SYM,
+  M2C_SOURCE_KIND_EXL
+} m2c_source_kind_t;
+
+#define M2C_SOURCE_KIND_COUNT (M2C_SOURCE_KIND_EXL + 1)
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_search_path(dir_count, dirs, status)
+ * --------------------------------------------------------------------------
+ * Lists the dir_count directories and bundles in array dirs in order and
+ * returns a new search path with their module files.  Directories and
+ * bundles that cannot be read contribute no files.  Passes the status in
+ * status.
+ * ----------------------------------------------------------------------- */
+
+m2c_search_path_t m2c_new_search_path
+  (uint_t dir_count,                      /* in */
+   const char *const dirs[],              /* in */
+   m2c_search_path_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_find(search_path, module, kind)
+ * --------------------------------------------------------------------------
+ * Returns the interned pathname of the file of module of the given kind in
+ * the first directory or bundle of search_path holding one,  or NULL if
+ * there is none.  The result reflects the directories as of their last
+ * listing.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_search_path_find
+  (m2c_search_path_t search_path, intstr_t module, m2c_source_kind_t kind);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_contents(search_path, module, kind, size)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the contents of the file of module of the given kind
+ * found by m2c_search_path_find and passes back its size in size,  if it is
+ * a member of a library bundle.  Returns NULL if the file is not found or is
+ * a file of a directory,  which the caller opens by its pathname.  The
+ * contents are not NUL terminated and remain valid until search_path is
+ * refreshed or released.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_search_path_contents
+  (m2c_search_path_t search_path,         /* in */
+   intstr_t module,                       /* in */
+   m2c_source_kind_t kind,                /* in */
+   size_t *size);                         /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_matches(search_path, dir_count, dirs)
+ * --------------------------------------------------------------------------
+ * Returns true if search_path consists of the dir_count directories in
+ * array dirs in that order,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_search_path_matches
+  (m2c_search_path_t search_path, uint_t dir_count, const char *const dirs[]);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_search_path_refresh(search_path, status)
+ * --------------------------------------------------------------------------
+ * Relists the directories and bundles of search_path if any of them has
+ * changed since it was last listed.  Returns true if they were relisted,
+ * otherwise false.  Passes the status in status,  on failure search_path is
+ * left empty.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_search_path_refresh
+  (m2c_search_path_t search_path, m2c_search_path_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_search_path(search_path)
+ * --------------------------------------------------------------------------
+ * Deallocates search_path and passes NULL in search_path.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_search_path (m2c_search_path_t *search_path);
+
+
+#endif /* M2C_SEARCH_PATH_H */
+
+/* END OF FILE */
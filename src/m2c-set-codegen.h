@@ -0,0 +1,162 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-set-codegen.h                                                         *
+ *                                                                           *
+ * Interface for translation of SET types and set operations.                *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_SET_CODEGEN_H
+#define M2C_SET_CODEGEN_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "m2c-templates.h"
+#include "outfile.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Representation of SET types in C
+ * --------------------------------------------------------------------------
+ * A set type of up to M2C_SET_WORD_BITS elements is translated to a single
+ * uint64_t,  element n being bit n.  Union,  intersection,  difference and
+ * symmetric difference are then written inline as bitwise OR,  AND,  AND NOT
+ * and XOR,  membership as a shift and mask,  thus no set operation costs a
+ * function call or a memory access beyond its operands.
+ *
+ * A set type of more elements is translated to a struct holding a fixed
+ * array of uint64_t words,  the template defines static inline functions for
+ * the operations,  each a loop with a constant trip count over independent
+ * words that the C compiler unrolls or vectorises.  Membership tests a single
+ * bit of a single word.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Number of elements held per word
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SET_WORD_BITS 64
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_set_op_t
+ * --------------------------------------------------------------------------
+ * Set operations for which the translator writes inline code.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_SET_OP_UNION,         /* a + b */
+  M2C_SET_OP_DIFFERENCE,    /* a - b */
+  M2C_SET_OP_INTERSECTION,  /* a * b */
+  M2C_SET_OP_SYMDIFF,       /* a / b, symmetric difference */
+  M2C_SET_OP_IN             /* e IN s */
+} m2c_set_op_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_set_operand_writer_t
+ * --------------------------------------------------------------------------
+ * function pointer type for a client supplied writer that writes the C
+ * expression for operand to outfile.  Context is passed through from
+ * m2c_write_set_op.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_set_operand_writer_t)
+  (outfile_t outfile, m2c_astnode_t operand, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_enum_value_count(enum_node)
+ * --------------------------------------------------------------------------
+ * Returns the number of values declared in enumeration type node enum_node,
+ * or zero if enum_node is not an enumeration type node.  Values inherited
+ * from the base type of an extensible enumeration are not counted.
+ *
+ * astnode: (ENUM baseType (IDENTLIST ident1 ident2 ... identN))
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_enum_value_count (m2c_astnode_t enum_node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_set_word_count(element_count)
+ * --------------------------------------------------------------------------
+ * Returns the number of words needed for a set of element_count elements.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_set_word_count (uint_t element_count);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_set_template(element_count)
+ * --------------------------------------------------------------------------
+ * Returns the template for a set type of element_count elements,  either
+ * M2C_TEMPLATE_SET_WORD or M2C_TEMPLATE_SET_ARRAY.  Slot 2 of the latter is
+ * the word count,  see m2c_set_word_count.
+ * ----------------------------------------------------------------------- */
+
+m2c_template_t m2c_set_template (uint_t element_count);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_set_op(outfile, op, type, count, left, right, ...)
+ * --------------------------------------------------------------------------
+ * Writes the C expression for set operation op on operands left and right
+ * to outfile,  calling writer with context for each operand.  Type is the
+ * identifier of the C type of the set operand(s),  count is the element
+ * count of the set type.  For M2C_SET_OP_IN,  left is the element and right
+ * the set,  the expression yields 1 if the element is a member,  else 0.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_set_op
+  (outfile_t outfile,                   /* in */
+   m2c_set_op_t op,                     /* in */
+   intstr_t type,                       /* in */
+   uint_t element_count,                /* in */
+   m2c_astnode_t left,                  /* in */
+   m2c_astnode_t right,                 /* in */
+   m2c_set_operand_writer_t writer,     /* in */
+   void *context);                      /* in */
+
+
+#endif /* M2C_SET_CODEGEN_H */
+
+/* END OF FILE */
@@ -40,10 +40,19 @@
 #ifndef M2C_STATISTICS_H
 #define M2C_STATISTICS_H
 
+#include "m2c-common.h"
+
+#include <stdbool.h>
+
+
 /* --------------------------------------------------------------------------
  * type m2c_stats_type_t
  * --------------------------------------------------------------------------
- * Enumerated values representing statistics counters.
+ * Enumerated values representing statistics counters.  The parser sets the
+ * token, AST node and byte counters  of the statistics it passes back.  The
+ * intern hit counter is shared by all compilation units,  it is meant to be
+ * set by the driver from the statistics of the string repository,  as are
+ * the interned string count and the compile cache hit and miss counters.
  * ----------------------------------------------------------------------- */
 
 typedef enum {
@@ -56,6 +65,13 @@ typedef enum {
   M2C_STATS_SYNTAX_ERROR_COUNT,
   M2C_STATS_SEMANTIC_WARN_COUNT,
   M2C_STATS_SEMANTIC_ERROR_COUNT,
+  M2C_STATS_TOKEN_COUNT,
+  M2C_STATS_AST_NODE_COUNT,
+  M2C_STATS_INTERN_HIT_COUNT,
+  M2C_STATS_BYTES_READ,
+  M2C_STATS_INTERN_COUNT,
+  M2C_STATS_CACHE_HIT_COUNT,
+  M2C_STATS_CACHE_MISS_COUNT,
   M2C_STATS_END_MARK
 } m2c_stats_type_t;
 
@@ -67,29 +83,114 @@ typedef enum {
 #define STATS_TYPE_COUNT M2C_STATS_END_MARK
 
 
+/* --------------------------------------------------------------------------
+ * type m2c_stats_phase_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing timed compiler phases.  Phase LOAD covers
+ * opening the source file,  phase LEX is only timed apart from phase PARSE
+ * when the source is tokenised ahead of parsing,  phase ANALYSIS covers
+ * symbol resolution and phase OUTPUT the writing of output files.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_STATS_PHASE_LOAD,
+  M2C_STATS_PHASE_LEX,
+  M2C_STATS_PHASE_PARSE,
+  M2C_STATS_PHASE_ANALYSIS,
+  M2C_STATS_PHASE_CODEGEN,
+  M2C_STATS_PHASE_OUTPUT,
+  M2C_STATS_PHASE_END_MARK
+} m2c_stats_phase_t;
+
+
+/* --------------------------------------------------------------------------
+ * constant STATS_PHASE_COUNT
+ * ----------------------------------------------------------------------- */
+
+#define STATS_PHASE_COUNT M2C_STATS_PHASE_END_MARK
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_stats_perf_event_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing hardware performance counters sampled for
+ * each timed phase,  see m2c_stats_open_perf_counters.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_STATS_PERF_CYCLES,
+  M2C_STATS_PERF_INSTRUCTIONS,
+  M2C_STATS_PERF_CACHE_MISSES,
+  M2C_STATS_PERF_BRANCHES,
+  M2C_STATS_PERF_BRANCH_MISSES,
+  M2C_STATS_PERF_END_MARK
+} m2c_stats_perf_event_t;
+
+
+/* --------------------------------------------------------------------------
+ * constant STATS_PERF_EVENT_COUNT
+ * ----------------------------------------------------------------------- */
+
+#define STATS_PERF_EVENT_COUNT M2C_STATS_PERF_END_MARK
+
+
+/* --------------------------------------------------------------------------
+ * Hardware performance counter support
+ * --------------------------------------------------------------------------
+ * Hardware performance counters are read through perf_event_open(),  which
+ * is only available on Linux.  Define M2C_STATS_PERF_COUNTERS as 0 to build
+ * without them elsewhere or where the kernel headers are missing.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_STATS_PERF_COUNTERS)
+#if defined(__linux__)
+#define M2C_STATS_PERF_COUNTERS 1
+#else
+#define M2C_STATS_PERF_COUNTERS 0
+#endif
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Default name of the telemetry file within the working directory
+ * ----------------------------------------------------------------------- */
+
+#define M2C_STATS_TELEMETRY_FILE "m2c-telemetry.jsonl"
+
+
 /* --------------------------------------------------------------------------
  * type m2c_stats_t
  * --------------------------------------------------------------------------
- * Type to hold all statistics counters.
+ * Type to hold all statistics counters and phase timers.
  * ----------------------------------------------------------------------- */
 
-typedef *m2c_stats_t;
+typedef struct m2c_stats_s *m2c_stats_t;
 
 
 /* --------------------------------------------------------------------------
- * macro IS_VALID_STAT_TYPE(p)
+ * macro IS_VALID_STATS_TYPE(p)
  * --------------------------------------------------------------------------
  * Returns true it p is a valid statistics type parameter, otherwise false.
  * ----------------------------------------------------------------------- */
 
 #define IS_VALID_STATS_TYPE(_p) \
   ((_p >= 0) && (_p < STATS_TYPE_COUNT))
+
+
+/* --------------------------------------------------------------------------
+ * macro IS_VALID_STATS_PHASE(p)
+ * --------------------------------------------------------------------------
+ * Returns true it p is a valid statistics phase parameter, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+#define IS_VALID_STATS_PHASE(_p) \
+  ((_p >= 0) && (_p < STATS_PHASE_COUNT))
   
 
 /* --------------------------------------------------------------------------
  * function m2c_stats_new()
  * --------------------------------------------------------------------------
- * Returns a new statistics record.
+ * Returns a new statistics record with all counters and timers zero.
  * ----------------------------------------------------------------------- */
 
 m2c_stats_t m2c_stats_new (void);
@@ -99,18 +200,40 @@ m2c_stats_t m2c_stats_new (void);
  * function m2c_stats_inc(stats, param)
  * --------------------------------------------------------------------------
  * Increments the counter for statistic param of statistics record stats.
+ * Counters saturate at their maximum value.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_inc (m2c_stats_t stats, m2c_stats_type_t param);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_add(stats, param, amount)
+ * --------------------------------------------------------------------------
+ * Adds amount to the counter for statistic param of statistics record stats.
+ * Counters saturate at their maximum value.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_add
+  (m2c_stats_t stats, m2c_stats_type_t param, uint64_t amount);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_set(stats, param, value)
+ * --------------------------------------------------------------------------
+ * Sets the counter for statistic param of statistics record stats to value.
  * ----------------------------------------------------------------------- */
 
-void m2c_stats_inc (m2c_stats_t stats, m2c_stat_type_t param);
+void m2c_stats_set
+  (m2c_stats_t stats, m2c_stats_type_t param, uint64_t value);
 
 
 /* --------------------------------------------------------------------------
- * function m2c_stats_value(stats)
+ * function m2c_stats_value(stats, param)
  * --------------------------------------------------------------------------
  * Returns the counter for statistic param of statistics record stats.
  * ----------------------------------------------------------------------- */
 
-unsigned short m2c_stats_value (m2c_stats_t stats, m2c_stat_type_t param);
+uint64_t m2c_stats_value (m2c_stats_t stats, m2c_stats_type_t param);
 
 
 /* --------------------------------------------------------------------------
@@ -119,7 +242,7 @@ unsigned short m2c_stats_value (m2c_stats_t stats, m2c_stat_type_t param);
  * Sets the line count of statistics record stats to value.
  * ----------------------------------------------------------------------- */
 
-void m2c_stats_set_line_count (m2c_stats_t stats, unsigned short value);
+void m2c_stats_set_line_count (m2c_stats_t stats, uint64_t value);
 
 
 /* --------------------------------------------------------------------------
@@ -128,7 +251,118 @@ void m2c_stats_set_line_count (m2c_stats_t stats, unsigned short value);
  * Returns the line count of statistics record stats.
  * ----------------------------------------------------------------------- */
 
-unsigned short m2c_stats_line_count (m2c_stats_t stats);
+uint64_t m2c_stats_line_count (m2c_stats_t stats);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_begin_phase(stats, phase)
+ * --------------------------------------------------------------------------
+ * Starts the wall clock and CPU timers of phase in statistics record stats.
+ * Has no effect if the timers of phase are already running.  CPU time is
+ * that of the calling thread where the host supports it.  While a trace is
+ * open,  the phase is also recorded as a span,  see m2c-trace.h.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_begin_phase (m2c_stats_t stats, m2c_stats_phase_t phase);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_end_phase(stats, phase)
+ * --------------------------------------------------------------------------
+ * Stops the timers of phase in statistics record stats  and adds the time
+ * elapsed since the matching m2c_stats_begin_phase to their totals.  Has no
+ * effect if the timers of phase are not running.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_end_phase (m2c_stats_t stats, m2c_stats_phase_t phase);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_wall_time(stats, phase)
+ * --------------------------------------------------------------------------
+ * Returns the total wall clock time of phase in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_stats_wall_time (m2c_stats_t stats, m2c_stats_phase_t phase);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_cpu_time(stats, phase)
+ * --------------------------------------------------------------------------
+ * Returns the total CPU time of phase in nanoseconds.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_stats_cpu_time (m2c_stats_t stats, m2c_stats_phase_t phase);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_open_perf_counters(stats)
+ * --------------------------------------------------------------------------
+ * Opens hardware performance counters for the calling thread and attaches
+ * them to statistics record stats.  From then on,  the counters are sampled
+ * at the begin and end of each phase and accumulated per phase.  The stats
+ * record must then only be timed on the calling thread.  Returns true on
+ * success,  false if counters are not supported by the host or the kernel
+ * denies access.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_stats_open_perf_counters (m2c_stats_t stats);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_has_perf_counters(stats)
+ * --------------------------------------------------------------------------
+ * Returns true if hardware performance counters are attached to statistics
+ * record stats,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_stats_has_perf_counters (m2c_stats_t stats);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_perf_count(stats, phase, event)
+ * --------------------------------------------------------------------------
+ * Returns the total count of hardware event event during phase,  or zero if
+ * no counters are attached to statistics record stats.
+ * ----------------------------------------------------------------------- */
+
+uint64_t m2c_stats_perf_count
+  (m2c_stats_t stats, m2c_stats_phase_t phase, m2c_stats_perf_event_t event);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_stats_print_time_report(stats, filename)
+ * --------------------------------------------------------------------------
+ * Prints the wall clock and CPU time of each phase of statistics record
+ * stats for source file filename to the console,  followed by the token,
+ * AST node and line counters and the token and node throughput.  Phases
+ * that were not timed are shown as not run.  If lexing was timed,  a note
+ * in the header states that the source was pretokenized ahead of parsing.  If hardware performance
+ * counters are attached,  the cycles,  instructions,  instructions per cycle,
+ * cache misses per thousand instructions  and branch miss rate of each
+ * phase follow.
+ * ----------------------------------------------------------------------- */
+
+void m2c_stats_print_time_report (m2c_stats_t stats, const char *filename);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_stats_write_telemetry(stats, path, module, srcpath)
+ * --------------------------------------------------------------------------
+ * Appends a telemetry record for module compiled from source file srcpath
+ * with statistics record stats  to the JSON lines file at path,  creating
+ * the file if it does not exist.  The record is a single JSON object on a
+ * line of its own  with the source size,  line count,  token,  AST node and
+ * intern counters,  the wall clock and CPU time of each phase in nanoseconds
+ * or null if not run,  the peak resident memory of the process in KiB  and
+ * the compile cache outcome,  "hit",  "miss" or null if not consulted.  The
+ * record is written with a single write so that concurrent compiler processes
+ * may append to the same file.  Returns true on success,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_stats_write_telemetry
+  (m2c_stats_t stats, const char *path,
+   const char *module, const char *srcpath);
 
 
 /* --------------------------------------------------------------------------
@@ -142,4 +376,4 @@ void m2c_stats_release (m2c_stats_t stats);
 
 #endif /* M2C_STATISTICS_H */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,177 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-string-pool.h                                                         *
+ *                                                                           *
+ * Interface for pooling of string literals in generated C.                  *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_STRING_POOL_H
+#define M2C_STRING_POOL_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "outfile.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * String literal pools
+ * --------------------------------------------------------------------------
+ * The quoted literals of a module are collected into a pool in which each
+ * distinct string occurs once,  regardless of its delimiters and of how
+ * often it occurs.  The pool is written near the top of the generated C
+ * file as static constant character arrays,  and each use of a literal is
+ * translated to a reference to its array.
+ *
+ * The name of an array is derived from the length and a 64-bit FNV-1a hash
+ * of the string,  thus the same string has the same name in every module.
+ * Each definition is guarded by a macro of the same name in upper case,  so
+ * in a unity translation unit,  see m2c-unity-build.h,  a string that
+ * occurs in several modules is defined only once,  by the first module
+ * that uses it,  and shared by all others.
+ *
+ *   #ifndef M2C_STR_11_779A65E7023CD2E7
+ *   #define M2C_STR_11_779A65E7023CD2E7
+ *   static const char m2c_str_11_779a65e7023cd2e7[] = "hello world";
+ *   #endif
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_string_pool_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a string literal pool.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_string_pool_struct_t *m2c_string_pool_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_string_use_f
+ * --------------------------------------------------------------------------
+ * Type of a function that returns true if quoted literal node literal is
+ * translated to a reference to the pool,  or false if it is translated
+ * otherwise,  such as a single character literal used as a CHAR value or a
+ * literal written into the format string of a WRITE statement.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_string_use_f) (m2c_astnode_t literal, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_string_pool()
+ * --------------------------------------------------------------------------
+ * Returns a new empty string literal pool,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_string_pool_t m2c_new_string_pool (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_pool_add(pool, lexeme)
+ * --------------------------------------------------------------------------
+ * Adds quoted literal lexeme,  including its delimiters,  to pool unless
+ * its string is already in pool.  Returns true on success,  false if pool
+ * or lexeme is NULL,  lexeme is not delimited or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_string_pool_add (m2c_string_pool_t pool, intstr_t lexeme);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_pool_add_literals(pool, root, is_pooled, context)
+ * --------------------------------------------------------------------------
+ * Adds the quoted literals of the AST rooted at root to pool,  only those
+ * for which is_pooled returns true unless is_pooled is NULL.  Returns the
+ * number of strings newly added.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_string_pool_add_literals
+  (m2c_string_pool_t pool,                  /* in */
+   m2c_astnode_t root,                      /* in */
+   m2c_string_use_f is_pooled,              /* in */
+   void *context);                          /* in */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_string_pool_count(pool)
+ * --------------------------------------------------------------------------
+ * Returns the number of distinct strings in pool,  or zero if pool is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_string_pool_count (m2c_string_pool_t pool);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_string_pool(outfile, pool)
+ * --------------------------------------------------------------------------
+ * Writes the guarded definitions of the strings in pool to outfile,  in the
+ * order in which they were first added.
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_string_pool (outfile_t outfile, m2c_string_pool_t pool);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_write_string_ref(outfile, pool, lexeme)
+ * --------------------------------------------------------------------------
+ * Writes the name of the array for quoted literal lexeme in pool to outfile
+ * and returns true,  or writes nothing and returns false if the string of
+ * lexeme is not in pool.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_write_string_ref
+  (outfile_t outfile, m2c_string_pool_t pool, intstr_t lexeme);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_string_pool(pool)
+ * --------------------------------------------------------------------------
+ * Deallocates pool.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_string_pool (m2c_string_pool_t pool);
+
+
+#endif /* M2C_STRING_POOL_H */
+
+/* END OF FILE */
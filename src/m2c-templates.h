@@ -0,0 +1,99 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-templates.h                                                           *
+ *                                                                           *
+ * Public interface of C code generation template module.                    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_TEMPLATES_H
+#define M2C_TEMPLATES_H
+
+#include "outfile.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * types m2c_template_t and m2c_template_slot_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the templates  and the placeholder slots
+ * of templates/c99-templates.tpl,  generated by utility gen-c-templates.
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-template-ids.h"
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_template_slot_handler_t
+ * --------------------------------------------------------------------------
+ * function pointer type for a client supplied handler that writes the
+ * substitution for slot to outfile.  If foreach is true,  the slot is the
+ * subject of an @foreach directive  and the handler writes the expansions
+ * of all its elements.  Context is passed through from m2c_template_expand.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_template_slot_handler_t)
+  (outfile_t outfile, m2c_template_slot_t slot, bool foreach, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_template_expand(outfile, template, handler, context)
+ * --------------------------------------------------------------------------
+ * Writes the expansion of template to outfile.  Literal spans are copied
+ * to the output buffer of outfile,  included templates are expanded in
+ * place and handler is called for every slot.  Templates are compiled into
+ * tables at build time,  no template text is parsed at runtime.
+ * ----------------------------------------------------------------------- */
+
+void m2c_template_expand
+  (outfile_t outfile,
+   m2c_template_t template,
+   m2c_template_slot_handler_t handler,
+   void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_template_name(template)
+ * --------------------------------------------------------------------------
+ * Returns the name of template as given in the template file,  or NULL if
+ * template is invalid.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_template_name (m2c_template_t template);
+
+
+#endif /* M2C_TEMPLATES_H */
+
+/* END OF FILE */
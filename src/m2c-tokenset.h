@@ -46,15 +46,113 @@
 
 #include "m2c-token.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * constant M2C_TOKENSET_SEGMENT_BITWIDTH
+ * --------------------------------------------------------------------------
+ * Size of a tokenset segment in bits,  one of 16, 32 or 64.  Must match the
+ * width of the generated FIRST and FOLLOW set literals.  Defaults to 32.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_TOKENSET_SEGMENT_BITWIDTH
+#define M2C_TOKENSET_SEGMENT_BITWIDTH 32
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_tokenset_segment_t
+ * --------------------------------------------------------------------------
+ * Type representing bitmap segments in a tokenset.
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_TOKENSET_SEGMENT_BITWIDTH == 16)
+typedef uint16_t m2c_tokenset_segment_t;
+#elif (M2C_TOKENSET_SEGMENT_BITWIDTH == 32)
+typedef uint32_t m2c_tokenset_segment_t;
+#elif (M2C_TOKENSET_SEGMENT_BITWIDTH == 64)
+typedef uint64_t m2c_tokenset_segment_t;
+#else
+#error "M2C_TOKENSET_SEGMENT_BITWIDTH must be 16, 32 or 64"
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * macro M2C_TOKENSET_POPCOUNT(segment)
+ * --------------------------------------------------------------------------
+ * Returns the number of set bits in a segment.  Uses the population count
+ * builtin of the width of a segment where available.
+ * ----------------------------------------------------------------------- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#if (M2C_TOKENSET_SEGMENT_BITWIDTH == 64)
+#define M2C_TOKENSET_POPCOUNT(_segment) \
+  ((unsigned) __builtin_popcountll(_segment))
+#else
+#define M2C_TOKENSET_POPCOUNT(_segment) \
+  ((unsigned) __builtin_popcountl(_segment))
+#endif
+#else /* portable fallback */
+#define M2C_TOKENSET_POPCOUNT(_segment) m2c_tokenset_popcount(_segment)
+
+static inline unsigned m2c_tokenset_popcount (m2c_tokenset_segment_t seg) {
+  unsigned count = 0;
+  
+  while (seg != 0) {
+    seg = seg & (seg - 1);
+    count++;
+  } /* end while */
+  
+  return count;
+} /* end m2c_tokenset_popcount */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * constant M2C_TOKENSET_SEGMENT_COUNT
+ * --------------------------------------------------------------------------
+ * Number of segments in a tokenset.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_TOKENSET_SEGMENT_COUNT \
+  ((TOKEN_END_MARK / M2C_TOKENSET_SEGMENT_BITWIDTH) + 1)
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_tokenset_s
+ * --------------------------------------------------------------------------
+ * Record type representing a tokenset object.  The record is visible only
+ * so that constant tokensets can be defined as static literals  and tested
+ * inline.  Clients shall not access its fields directly.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_tokenset_struct_t {
+  /* segment */ m2c_tokenset_segment_t segment[M2C_TOKENSET_SEGMENT_COUNT];
+  /* elem_count */ unsigned elem_count;
+};
+
+typedef struct m2c_tokenset_struct_t m2c_tokenset_s;
 
 
 /* --------------------------------------------------------------------------
  * type m2c_tokenset_t
  * --------------------------------------------------------------------------
- * Opaque pointer type representing a Modula-2 token-set object.
+ * Pointer type representing a Modula-2 token-set object.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_tokenset_struct_t *m2c_tokenset_t;
+
+
+/* --------------------------------------------------------------------------
+ * macro M2C_TOKENSET_LITERAL(literal)
+ * --------------------------------------------------------------------------
+ * Expands to the initialiser of a tokenset literal  in the format printed by
+ * m2c_tokenset_print_literal.  The literal is passed in parentheses.
  * ----------------------------------------------------------------------- */
 
-typedef struct m2c_tokenset_opaque_t *m2c_tokenset_t;
+#define M2C_TOKENSET_LITERAL(...) __VA_ARGS__
 
 
 /* --------------------------------------------------------------------------
@@ -82,37 +180,84 @@ m2c_tokenset_t m2c_new_tokenset_from_union (m2c_tokenset_t first_set, ...);
 /* --------------------------------------------------------------------------
  * function m2c_tokenset_element(set, token)
  * --------------------------------------------------------------------------
- * Returns true if token is an element of set, otherwise false.
+ * Returns true if token is an element of set, otherwise false.  Inline,  a
+ * test against a constant set reduces to a single bit test.
  * ----------------------------------------------------------------------- */
 
-bool m2c_tokenset_element (m2c_tokenset_t set, m2c_token_t token);
+static inline bool m2c_tokenset_element
+  (m2c_tokenset_t set, m2c_token_t token) {
+  
+  if (token >= TOKEN_END_MARK) {
+    return false;
+  } /* end if */
+  
+  return ((set->segment[token / M2C_TOKENSET_SEGMENT_BITWIDTH] >>
+    (token % M2C_TOKENSET_SEGMENT_BITWIDTH)) & 1) != 0;
+} /* end m2c_tokenset_element */
 
 
 /* --------------------------------------------------------------------------
  * procedure m2c_tokenset_element_count(set)
  * --------------------------------------------------------------------------
- * Returns the number of elements in set.
+ * Returns the number of elements in set.  The count is kept in the set.
  * ----------------------------------------------------------------------- */
 
-unsigned m2c_tokenset_element_count (m2c_tokenset_t set);
+static inline unsigned m2c_tokenset_element_count (m2c_tokenset_t set) {
+  
+  if (set == NULL) {
+    return 0;
+  } /* end if */
+  
+  return set->elem_count;
+} /* end m2c_tokenset_element_count */
 
 
 /* --------------------------------------------------------------------------
  * function m2c_tokenset_subset(set, subset)
  * --------------------------------------------------------------------------
  * Returns true if each element in subset is also in set, otherwise false.
+ * Inline and branch free,  the segment loop is unrolled by the compiler.
  * ----------------------------------------------------------------------- */
 
-bool m2c_tokenset_subset (m2c_tokenset_t set, m2c_tokenset_t subset);
+static inline bool m2c_tokenset_subset
+  (m2c_tokenset_t set, m2c_tokenset_t subset) {
+  
+  m2c_tokenset_segment_t excess;
+  unsigned seg_index;
+  
+  excess = 0;
+  seg_index = 0;
+  while (seg_index < M2C_TOKENSET_SEGMENT_COUNT) {
+    excess |= subset->segment[seg_index] & ~(set->segment[seg_index]);
+    seg_index++;
+  } /* end while */
+  
+  return (excess == 0);
+} /* end m2c_tokenset_subset */
 
 
 /* --------------------------------------------------------------------------
  * function m2c_tokenset_disjunct(set1, set2)
  * --------------------------------------------------------------------------
  * Returns true if set1 and set2 have no common elements, otherwise false.
+ * Inline and branch free,  the segment loop is unrolled by the compiler.
  * ----------------------------------------------------------------------- */
 
-bool m2c_tokenset_disjunct (m2c_tokenset_t set1, m2c_tokenset_t set2);
+static inline bool m2c_tokenset_disjunct
+  (m2c_tokenset_t set1, m2c_tokenset_t set2) {
+  
+  m2c_tokenset_segment_t common;
+  unsigned seg_index;
+  
+  common = 0;
+  seg_index = 0;
+  while (seg_index < M2C_TOKENSET_SEGMENT_COUNT) {
+    common |= set1->segment[seg_index] & set2->segment[seg_index];
+    seg_index++;
+  } /* end while */
+  
+  return (common == 0);
+} /* end m2c_tokenset_disjunct */
 
 
 /* --------------------------------------------------------------------------
@@ -135,18 +280,32 @@ void m2c_tokenset_print_set (const char *set_name, m2c_tokenset_t set);
 void m2c_tokenset_print_list (m2c_tokenset_t set);
 
 
+/* --------------------------------------------------------------------------
+ * procedure m2c_tokenset_list_to_str(set, str, size)
+ * --------------------------------------------------------------------------
+ * Writes the human readable list of symbols in set  printed by procedure
+ * m2c_tokenset_print_list,  without its terminating period,  to str  which
+ * holds size characters.  The list is truncated if it does not fit.  A size
+ * of M2C_TOKENSET_LIST_STR_SIZE is sufficient for any set.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_TOKENSET_LIST_STR_SIZE 2048
+
+void m2c_tokenset_list_to_str (m2c_tokenset_t set, char *str, size_t size);
+
+
 /* --------------------------------------------------------------------------
  * procedure m2c_tokenset_print_literal_struct(ident)
  * --------------------------------------------------------------------------
  * Prints a struct definition for tokenset literals.
- * Format: struct ident { <largest unsigned> s0, s1, ...; short unsigned n };
- * where type <largest unsigned> depends on platform and implementation file.
+ * Format: struct ident { <segment type> s0, s1, ...; short unsigned n };
+ * where <segment type> depends on M2C_TOKENSET_SEGMENT_BITWIDTH.
  *
- *  #  |  platform  | implementation file  |  type used
- * ----+------------+---------------------------------------------
- *  1  |   16-bit   |   tokenset.16bit.c   |   unsigned
- *  2  |   32-bit   |   tokenset.32bit.c   |   unsigned long
- *  3  |   64-bit   |   tokenset.64bit.c   |   unsigned long long
+ *  #  |  bitwidth  |  type used
+ * ----+------------+------------
+ *  1  |     16     |  uint16_t
+ *  2  |     32     |  uint32_t
+ *  3  |     64     |  uint64_t
  * ----------------------------------------------------------------------- */
 
 void m2c_tokenset_print_literal_struct (const char *ident);
@@ -0,0 +1,156 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-trace.h                                                               *
+ *                                                                           *
+ * Public interface of trace event recorder.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_TRACE_H
+#define M2C_TRACE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Trace event files
+ * --------------------------------------------------------------------------
+ * The trace event recorder writes spans in the Chrome trace event format,
+ * a JSON array of events that is loaded into chrome://tracing or Perfetto
+ * to view a compilation or a build as a timeline.  A span is recorded with
+ * a begin event and an end event on the lane of the calling thread,  spans
+ * of a thread nest.  Timestamps are microseconds since the trace was opened.
+ *
+ * There is one trace per process.  While no trace is open,  the recording
+ * procedures return at once,  they may thus be called unconditionally.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Thread safety
+ * --------------------------------------------------------------------------
+ * Define M2C_TRACE_THREAD_SAFE as 1 to record from multiple threads,  each
+ * thread is then shown on a lane of its own.  This requires POSIX threads.
+ * It is set by default when the string repository is built thread safe.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_TRACE_THREAD_SAFE
+#define M2C_TRACE_THREAD_SAFE (INTSTR_THREAD_SAFE)
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_trace_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on the trace.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_TRACE_STATUS_SUCCESS,
+  M2C_TRACE_STATUS_INVALID_REFERENCE,
+  M2C_TRACE_STATUS_ALREADY_OPEN,
+  M2C_TRACE_STATUS_FILE_ACCESS_DENIED,
+  M2C_TRACE_STATUS_IO_ERROR
+} m2c_trace_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_open(path, status)
+ * --------------------------------------------------------------------------
+ * Creates a trace event file at path,  replacing any existing file,  and
+ * starts recording.  Passes the status of the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_open (const char *path, m2c_trace_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_trace_enabled()
+ * --------------------------------------------------------------------------
+ * Returns true if a trace is open,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_trace_enabled (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_begin(name, module)
+ * --------------------------------------------------------------------------
+ * Records the begin of a span name on the lane of the calling thread.  If
+ * module is not NULL,  it is recorded as argument of the span.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_begin (const char *name, const char *module);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_end(name)
+ * --------------------------------------------------------------------------
+ * Records the end of the innermost open span on the lane of the calling
+ * thread,  which must be one with the given name.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_end (const char *name);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_name_thread(name, index)
+ * --------------------------------------------------------------------------
+ * Labels the lane of the calling thread as name followed by index.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_name_thread (const char *name, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_trace_close(status)
+ * --------------------------------------------------------------------------
+ * Stops recording,  completes and closes the trace event file.  No other
+ * thread may record while the trace is closed.  Passes the status of the
+ * operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_trace_close (m2c_trace_status_t *status);
+
+
+#endif /* M2C_TRACE_H */
+
+/* END OF FILE */
@@ -0,0 +1,291 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-type-table.h                                                          *
+ *                                                                           *
+ * Interface for the canonical type table.                                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_TYPE_TABLE_H
+#define M2C_TYPE_TABLE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "interned-strings.h"
+
+#include <stdint.h>
+
+
+/* --------------------------------------------------------------------------
+ * Canonical types
+ * --------------------------------------------------------------------------
+ * Every type is entered into a type table once  and is thereafter denoted
+ * by its type id.  Anonymous types are hash-consed by structure:  entering
+ * a type of the same kind with the same base types and value again yields
+ * the same id.  Declared types are nominal:  each declaration yields a new
+ * id,  alias declarations reuse the id of the aliased type.  Type equality
+ * is thus the equality of ids  and compatibility checks between formal and
+ * actual parameter types compare ids  rather than ASTs.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_type_id_t
+ * --------------------------------------------------------------------------
+ * Type identifier,  unique within a type table.
+ * ----------------------------------------------------------------------- */
+
+typedef uint32_t m2c_type_id_t;
+
+#define M2C_TYPE_ID_NONE 0
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_type_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the kinds of types.  The shape kinds
+ * RECORD,  ENUM and OPAQUE have no base types,  they are the structures of
+ * declared types whose identity is their declaration.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_TYPE_KIND_INVALID,
+  M2C_TYPE_KIND_NOMINAL,        /* declared type,  base 0: structure */
+  M2C_TYPE_KIND_RECORD,         /* record shape */
+  M2C_TYPE_KIND_ENUM,           /* enumeration shape */
+  M2C_TYPE_KIND_OPAQUE,         /* opaque shape */
+  M2C_TYPE_KIND_SUBRANGE,       /* base 0: base type,  value: bounds */
+  M2C_TYPE_KIND_SET,            /* base 0: element type */
+  M2C_TYPE_KIND_ARRAY,          /* base 0: component type,  value: count */
+  M2C_TYPE_KIND_POINTER,        /* base 0: target type */
+  M2C_TYPE_KIND_PROCEDURE,      /* base 0: formal list,  base 1: result */
+  M2C_TYPE_KIND_LIST,           /* base 0: head,  base 1: tail list */
+  M2C_TYPE_KIND_OPEN_ARRAY,     /* ARRAY OF,  base 0: component type */
+  M2C_TYPE_KIND_CONST_FORMAL,   /* CONST,  base 0: formal type */
+  M2C_TYPE_KIND_VAR_FORMAL,     /* VAR,  base 0: formal type */
+  M2C_TYPE_KIND_ARGLIST,        /* ARGLIST OF,  base 0: formal type */
+  M2C_TYPE_KIND_CAST_ADDRESS,   /* CAST ADDRESS */
+  M2C_TYPE_KIND_CAST_OCTETSEQ   /* CAST OCTETSEQ */
+} m2c_type_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_type_table_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a type table.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_type_table_struct_t *m2c_type_table_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_type_resolver_f
+ * --------------------------------------------------------------------------
+ * Type of a function that returns the type id of the type denoted by type
+ * identifier node ident_node,  an IDENT or QUALIDENT node,  or NONE if the
+ * identifier does not denote a type.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_type_id_t (*m2c_type_resolver_f)
+  (m2c_astnode_t ident_node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_new_type_table()
+ * --------------------------------------------------------------------------
+ * Returns a new empty type table,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_table_t m2c_new_type_table (void);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_intern(table, kind, base0, base1, value)
+ * --------------------------------------------------------------------------
+ * Returns the id of the anonymous type of kind with base types base0 and
+ * base1 and value,  entering it into table if it is not yet present.  Unused
+ * base types are passed as M2C_TYPE_ID_NONE,  an unused value as NULL.
+ * Returns M2C_TYPE_ID_NONE for kind M2C_TYPE_KIND_NOMINAL,  if a base type
+ * required by kind is NONE,  and on allocation failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_intern
+  (m2c_type_table_t table, m2c_type_kind_t kind,
+   m2c_type_id_t base0, m2c_type_id_t base1, intstr_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_intern_list(table, count, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the id of the list of the count type ids in array type_id,  such
+ * as the formal types of a procedure type.  Lists are hash-consed like any
+ * other anonymous type.  Returns M2C_TYPE_ID_NONE if count is zero or on
+ * failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_intern_list
+  (m2c_type_table_t table, uint_t count, const m2c_type_id_t type_id[]);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_declare(table, name, structure)
+ * --------------------------------------------------------------------------
+ * Enters a declared type with identifier name and structure type id
+ * structure into table  and returns its new id,  or M2C_TYPE_ID_NONE on
+ * failure.  Records,  enumerations and opaque types pass the shape of
+ * their kind as structure.  Each call yields a new id.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_declare
+  (m2c_type_table_t table, intstr_t name, m2c_type_id_t structure);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_for_formal(table, node, resolver, context)
+ * --------------------------------------------------------------------------
+ * Returns the id of the formal type represented by AST node,  calling
+ * resolver with context for type identifiers.  Returns M2C_TYPE_ID_NONE if
+ * node does not represent a formal type or an identifier does not resolve.
+ *
+ * astnode: (CONSTP formalType) | (VARP formalType) | formalType
+ *
+ * formalType: (IDENT ident) | (QUALIDENT q0 ... qN ident) |
+ *   (OPENARRAY typeIdent) | (CASTP (ADDR)) | (CASTP (OCTSEQ)) |
+ *   (VARGP formalType)
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_for_formal
+  (m2c_type_table_t table, m2c_astnode_t node,
+   m2c_type_resolver_f resolver, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_kind(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the kind of type_id,  or M2C_TYPE_KIND_INVALID if type_id is not
+ * an id of table.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_kind_t m2c_type_kind
+  (m2c_type_table_t table, m2c_type_id_t type_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_base(table, type_id, index)
+ * --------------------------------------------------------------------------
+ * Returns base type index,  zero or one,  of type_id,  or M2C_TYPE_ID_NONE.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_base
+  (m2c_type_table_t table, m2c_type_id_t type_id, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_value(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the value of type_id,  the identifier of declared types,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_type_value (m2c_type_table_t table, m2c_type_id_t type_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_hash(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the structural hash of type_id,  computed from its kind,  the ids
+ * of its base types and its value.  The hash of a declared type also covers
+ * its id.  Returns zero if type_id is not an id of table.
+ * ----------------------------------------------------------------------- */
+
+uint32_t m2c_type_hash (m2c_type_table_t table, m2c_type_id_t type_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_structure(table, type_id)
+ * --------------------------------------------------------------------------
+ * Returns the structure of declared type type_id,  or type_id itself if it
+ * is anonymous.
+ * ----------------------------------------------------------------------- */
+
+m2c_type_id_t m2c_type_structure
+  (m2c_type_table_t table, m2c_type_id_t type_id);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_is_formal_compatible(table, formal, actual)
+ * --------------------------------------------------------------------------
+ * Returns true if an actual parameter of type actual may be passed to a
+ * formal parameter of type formal,  else false.
+ *
+ * o  any type is compatible with itself
+ * o  CONST T and VAR T accept what T accepts
+ * o  ARGLIST OF T accepts for each argument what T accepts
+ * o  ARRAY OF T accepts arrays and open arrays with component type T
+ * o  CAST ADDRESS accepts pointer and opaque types
+ * o  CAST OCTETSEQ accepts any type
+ *
+ * Each check compares type ids,  the work is bounded by the nesting of the
+ * formal type,  not by the size of the types compared.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_type_is_formal_compatible
+  (m2c_type_table_t table, m2c_type_id_t formal, m2c_type_id_t actual);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_type_count(table)
+ * --------------------------------------------------------------------------
+ * Returns the number of types in table.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_type_count (m2c_type_table_t table);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_type_table(table)
+ * --------------------------------------------------------------------------
+ * Deallocates table.  Its type ids become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_type_table (m2c_type_table_t table);
+
+
+#endif /* M2C_TYPE_TABLE_H */
+
+/* END OF FILE */
@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-unity-build.h                                                         *
+ *                                                                           *
+ * Public interface of unity build module.                                   *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_UNITY_BUILD_H
+#define M2C_UNITY_BUILD_H
+
+#include "m2c-common.h"
+
+#include "outfile.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Unity builds
+ * --------------------------------------------------------------------------
+ * With option --unity,  the modules  of the import closure of a program
+ * module are compiled as a single C translation unit.  The host C compiler
+ * can then inline across module boundaries  and is started only once.  The
+ * unit includes the generated C file of each module,  imported modules
+ * before importing modules,  the program module last.  Hidden names are
+ * qualified with their module prefix  and defined with static linkage,  so
+ * they cannot clash across modules.
+ *
+ * The closure is read from dependency files,  see m2c-dep-file.h.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Macro defined at the top of unity translation units
+ * ----------------------------------------------------------------------- */
+
+#define M2C_UNITY_BUILD_MACRO "M2C_UNITY_BUILD"
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_unity_order_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the modules of a program's import closure
+ * in dependency order.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_unity_order_s *m2c_unity_order_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_unity_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations of the unity build module.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_UNITY_STATUS_SUCCESS,
+  M2C_UNITY_STATUS_INVALID_REFERENCE,
+  M2C_UNITY_STATUS_DEP_FILE_NOT_FOUND,
+  M2C_UNITY_STATUS_INVALID_DEP_FILE,
+  M2C_UNITY_STATUS_ALLOCATION_FAILED
+} m2c_unity_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unity_new_order(program_id, dep_dir, failed_module, status)
+ * --------------------------------------------------------------------------
+ * Reads the dependency files in directory dep_dir  for the import closure
+ * of program module program_id  and returns a new order with the modules of
+ * the closure,  every module after the modules it imports and the program
+ * module last.  Circular imports are permitted,  the import that closes a
+ * cycle is ignored for ordering.  Returns NULL on failure,  passes the
+ * module whose dependency file could not be read in failed_module  and the
+ * status of the operation in status.  Failed_module may be NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_unity_order_t m2c_unity_new_order
+  (intstr_t program_id,            /* in */
+   const char *dep_dir,            /* in */
+   intstr_t *failed_module,        /* out */
+   m2c_unity_status_t *status);    /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unity_module_count(order)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules in order,  or zero if order is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_unity_module_count (m2c_unity_order_t order);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_unity_module_at_index(order, index)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the module at index in order,  or NULL if order
+ * is NULL or index is out of range.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_unity_module_at_index (m2c_unity_order_t order, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_unity_write_unit(path, order, written, status)
+ * --------------------------------------------------------------------------
+ * Writes the unity translation unit for order to the file at path.  The
+ * unit defines M2C_UNITY_BUILD_MACRO  and includes the generated C file of
+ * every module in order.  The file is left untouched  if its contents would
+ * not change.  Passes whether the file was written in written  and the
+ * status in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_unity_write_unit
+  (const char *path,               /* in */
+   m2c_unity_order_t order,        /* in */
+   bool *written,                  /* out */
+   outfile_status_t *status);      /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_unity_release_order(order)
+ * --------------------------------------------------------------------------
+ * Deallocates order and passes NULL in order.
+ * ----------------------------------------------------------------------- */
+
+void m2c_unity_release_order (m2c_unity_order_t *order);
+
+
+#endif /* M2C_UNITY_BUILD_H */
+
+/* END OF FILE */
@@ -0,0 +1,172 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-write-codegen.h                                                       *
+ *                                                                           *
+ * Interface for translation of WRITE statements.                            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_WRITE_CODEGEN_H
+#define M2C_WRITE_CODEGEN_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include "m2c-ast.h"
+#include "outfile.h"
+
+
+/* --------------------------------------------------------------------------
+ * Translation of WRITE statements
+ * --------------------------------------------------------------------------
+ * The arguments of a WRITE statement are translated into as few calls as
+ * possible.  Maximal runs of unformatted arguments of predefined types are
+ * written by a single call of M2C_WRITEF,  see runtime/m2c-rts-io.h,  with
+ * a format string built at translation time from the argument types.  The
+ * text of quoted literals is written into the format string itself.
+ *
+ * Arguments of types with a bound WRITE procedure and formatted arguments,
+ * i.e. arguments written with a bound WRITE # procedure,  end a run and are
+ * written by a call of their bound procedure.
+ *
+ * Thus the statement
+ *
+ *   WRITE "count: ", n, " of ", total, "\n"
+ *
+ * where n is of type CARDINAL and total of type LONGCARD,  becomes
+ *
+ *   M2C_WRITEF(NULL, "count: %lu of %llu\n", (unsigned long) (n),
+ *     (unsigned long long) (total));
+ *
+ * with the call written on a single line.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_write_kind_t
+ * --------------------------------------------------------------------------
+ * Enumerated values representing the ways an argument is written.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_WRITE_KIND_BOUND,     /* by call of bound WRITE procedure */
+  M2C_WRITE_KIND_BOOLEAN,   /* as TRUE or FALSE */
+  M2C_WRITE_KIND_CHAR,      /* as character */
+  M2C_WRITE_KIND_STRING,    /* as NUL terminated character string */
+  M2C_WRITE_KIND_CARDINAL,  /* as unsigned long */
+  M2C_WRITE_KIND_LONGCARD,  /* as unsigned long long */
+  M2C_WRITE_KIND_INTEGER,   /* as long */
+  M2C_WRITE_KIND_LONGINT,   /* as long long */
+  M2C_WRITE_KIND_REAL,      /* as double */
+  M2C_WRITE_KIND_LONGREAL   /* as long double */
+} m2c_write_kind_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_write_kind_f
+ * --------------------------------------------------------------------------
+ * Type of a function that returns the way the value of expression expr is
+ * written,  by its type.  For arguments of type ARRAY OF CHAR,  it returns
+ * M2C_WRITE_KIND_STRING only if the translation of expr is a pointer to a
+ * NUL terminated character string.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_write_kind_t (*m2c_write_kind_f)
+  (m2c_astnode_t expr, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_write_node_writer_f
+ * --------------------------------------------------------------------------
+ * Type of a function that writes the C translation of node to outfile,  an
+ * expression for an argument,  a designator for the channel.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_write_node_writer_f)
+  (outfile_t outfile, m2c_astnode_t node, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_write_bound_writer_f
+ * --------------------------------------------------------------------------
+ * Type of a function that writes to outfile a statement calling the bound
+ * WRITE or WRITE # procedure for output argument arg on channel chan.  The
+ * channel is the empty node if omitted.
+ *
+ * astnodes:
+ *  (WRITEARG exprNode) | (FMTARG fmtNode exprListNode)
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_write_bound_writer_f)
+  (outfile_t outfile, m2c_astnode_t chan, m2c_astnode_t arg, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_lower_write_statement(outfile, write_node, kind_of, ...)
+ * --------------------------------------------------------------------------
+ * Writes the translation of the WRITE statement write_node to outfile as a
+ * sequence of calls,  separated by newlines.  Calls kind_of to determine
+ * the way each unformatted argument is written,  writer to write channels
+ * and arguments of predefined types,  and bound_writer to write the calls
+ * of bound procedures.  Does nothing if any parameter but context is NULL.
+ *
+ * astnode: (WRITE chanNode outputArgsNode+)
+ * ----------------------------------------------------------------------- */
+
+void m2c_lower_write_statement
+  (outfile_t outfile,                       /* in */
+   m2c_astnode_t write_node,                /* in */
+   m2c_write_kind_f kind_of,                /* in */
+   m2c_write_node_writer_f writer,          /* in */
+   m2c_write_bound_writer_f bound_writer,   /* in */
+   void *context);                          /* in */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_write_call_count(write_node, kind_of, context)
+ * --------------------------------------------------------------------------
+ * Returns the number of calls the WRITE statement write_node is translated
+ * into,  or zero if write_node or kind_of is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_write_call_count
+  (m2c_astnode_t write_node, m2c_write_kind_f kind_of, void *context);
+
+
+#endif /* M2C_WRITE_CODEGEN_H */
+
+/* END OF FILE */
@@ -19,9 +19,9 @@
  *                                                                           *
  * @file                                                                     *
  *                                                                           *
- * m2c-first-sets.c                                                          *
+ * m2c-rts-io.c                                                              *
  *                                                                           *
- * Implementation of FIRST sets module.                                      *
+ * Implementation of the runtime output channels of generated programs.      *
  *                                                                           *
  * @license                                                                  *
  *                                                                           *
@@ -41,60 +41,61 @@
  * imports
  * ----------------------------------------------------------------------- */
 
-#include "m2c-tokenset.h"
-#include "m2c-productions.h"
-
-#include <stddef.h> /* NULL */
-#include <stdint.h> /* uint8_t */
+#include "m2c-rts-io.h"
 
 
 /* --------------------------------------------------------------------------
- * FIRST set table, pruned
- * --------------------------------------------------------------------------
- * Table of first sets with cardinality > 1 and without duplicates.
+ * POSIX terminal detection
  * ----------------------------------------------------------------------- */
 
-#define DATA(_prod, _set_literal) _set_literal,
-
-static const m2c_tokenset_t *first_set[] = {
-  NULL, /* sentinel for pruned entries */
-  #include "m2c-first-set-literals.h"
-}; /* end first_set */
+#if !defined(M2C_RTS_USE_POSIX)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_RTS_USE_POSIX 1
+#else
+#define M2C_RTS_USE_POSIX 0
+#endif
+#endif
 
-#undef DATA
+#if (M2C_RTS_USE_POSIX)
+#include <unistd.h>
+#endif
 
 
 /* --------------------------------------------------------------------------
- * FIRST set lookup table
- * --------------------------------------------------------------------------
- * Table to map productions to pruned first set table indices.
+ * private variable stdout_buffer
  * ----------------------------------------------------------------------- */
 
-typedef uint8_t table_index_t;   /* unsigned char if uint8_t is missing */
+static char stdout_buffer[M2C_RTS_OUTPUT_BUFFER_SIZE];
 
-#define DATA(_prod, _index) _index,
 
-static const table_index_t index_table[] = {
-  #include "m2c_first-set-lookup.h"
-}; /* end index_table */
+/* --------------------------------------------------------------------------
+ * procedure m2c_rts_io_init()
+ * --------------------------------------------------------------------------
+ * Sets full buffering on the standard output unless it is a terminal.
+ * ----------------------------------------------------------------------- */
 
-#undef DATA
+void m2c_rts_io_init (void) {
+  
+#if (M2C_RTS_USE_POSIX)
+  /* interactive output must appear line by line */
+  if (isatty(fileno(stdout))) {
+    return;
+  } /* end if */
+#endif
+  
+  setvbuf(stdout, stdout_buffer, _IOFBF, M2C_RTS_OUTPUT_BUFFER_SIZE);
+} /* end m2c_rts_io_init */
 
 
 /* --------------------------------------------------------------------------
- * function FIRST(production)
+ * procedure m2c_rts_flush(chan)
  * --------------------------------------------------------------------------
- * Returns the FIRST set of p if p is valid and |FIRST(p)| > 1, else NULL.
+ * Passes any output buffered for channel chan to the operating system.
  * ----------------------------------------------------------------------- */
 
-const m2c_tokenset_t FIRST (m2c_production_t p) {
- 
-  if (IS_VALID_PRODUCTION(p)) {
-    return first_set[index_table[p]];
-  }
-  else /* invalid production */ {
-    return NULL;
-  } /* end if */
-} /* end FIRST */
+void m2c_rts_flush (m2c_rts_chan_t chan) {
+  fflush(M2C_CHAN(chan));
+} /* end m2c_rts_flush */
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
@@ -0,0 +1,123 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-rts-io.h                                                              *
+ *                                                                           *
+ * Interface of the runtime output channels of generated programs.           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_RTS_IO_H
+#define M2C_RTS_IO_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+
+/* --------------------------------------------------------------------------
+ * Runtime output for generated programs
+ * --------------------------------------------------------------------------
+ * Generated C code translates a WRITE statement into a single call of
+ * M2C_WRITEF on the channel of the statement,  with a format string built
+ * at translation time from the types of the arguments,  see module
+ * m2c-write-codegen.  Arguments of types with a bound WRITE procedure and
+ * formatted arguments are written by calls of the bound procedures.
+ *
+ * Channels are stdio streams.  An omitted channel is passed as NULL and
+ * denotes the standard output.  Each call locks the stream once,  and the
+ * standard output is fully buffered by m2c_rts_io_init() unless it is a
+ * terminal,  thus output is passed to the operating system in blocks of
+ * M2C_RTS_OUTPUT_BUFFER_SIZE bytes rather than per argument or line.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Output buffer size of the standard output
+ * ----------------------------------------------------------------------- */
+
+#define M2C_RTS_OUTPUT_BUFFER_SIZE (64 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_rts_chan_t
+ * --------------------------------------------------------------------------
+ * Channel type.  NULL denotes the standard output.
+ * ----------------------------------------------------------------------- */
+
+typedef FILE *m2c_rts_chan_t;
+
+
+/* --------------------------------------------------------------------------
+ * macro M2C_CHAN(chan)
+ * --------------------------------------------------------------------------
+ * Returns the stream of channel chan.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_CHAN(_chan) (((_chan) == NULL) ? stdout : (_chan))
+
+
+/* --------------------------------------------------------------------------
+ * macro M2C_WRITEF(chan, format, ...)
+ * --------------------------------------------------------------------------
+ * Writes the arguments to channel chan as specified by format.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_WRITEF(_chan, ...) fprintf(M2C_CHAN(_chan), __VA_ARGS__)
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_rts_io_init()
+ * --------------------------------------------------------------------------
+ * Sets full buffering of M2C_RTS_OUTPUT_BUFFER_SIZE bytes on the standard
+ * output unless it is a terminal.  Must be called before any output.  The
+ * buffer is flushed when the program exits.
+ * ----------------------------------------------------------------------- */
+
+void m2c_rts_io_init (void);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_rts_flush(chan)
+ * --------------------------------------------------------------------------
+ * Passes any output buffered for channel chan to the operating system.
+ * ----------------------------------------------------------------------- */
+
+void m2c_rts_flush (m2c_rts_chan_t chan);
+
+
+#endif /* M2C_RTS_IO_H */
+
+/* END OF FILE */
@@ -206,6 +206,41 @@ procdef {%
 %}
 
 
+%% ---------------------------------------------------------------------------
+%% (HIDDEN-VARDEF identList type)
+%% ---------------------------------------------------------------------------
+
+hidden-vardef {%
+/* ---------------------------------------------------------------------------
+ * variable <%0%>, not exported
+ * ------------------------------------------------------------------------ */
+
+static <%1%> <%0%>;
+%}
+
+
+%% ---------------------------------------------------------------------------
+%% (HIDDEN-PROCDECL ident procSig)
+%% ---------------------------------------------------------------------------
+
+hidden-procdecl {%
+static <%1.1%> <%1.0%> <%0%>;
+%}
+
+
+%% ---------------------------------------------------------------------------
+%% (HIDDEN-PROCDEF procDecl block)
+%% ---------------------------------------------------------------------------
+
+hidden-procdef {%
+/* ---------------------------------------------------------------------------
+ * function <%0.0%>, not exported
+ * ------------------------------------------------------------------------ */
+
+static <%0%> <%1%>
+%}
+
+
 %% ---------------------------------------------------------------------------
 %% (ALIAS ident typeIdent)
 %% ---------------------------------------------------------------------------
@@ -215,7 +250,7 @@ alias {%
  * alias type <%0%>
  * ------------------------------------------------------------------------ */
 
-typedef <%1> <%0%>;
+typedef <%1%> <%0%>;
 %}
 
 
@@ -228,7 +263,7 @@ subr {%
  * subrange type <%0%>
  * ------------------------------------------------------------------------ */
 
-typedef <%2> <%0%>;
+typedef <%2%> <%0%>;
 %}
 
 
@@ -242,7 +277,7 @@ enum {%
  * ------------------------------------------------------------------------ */
 
 typedef enum {
-<%2>
+<%1%>
 } <%0%>;
 %}
 
@@ -250,16 +285,61 @@ typedef enum {
 %% ---------------------------------------------------------------------------
 %% (SET ident enumTypeIdent)
 %% ---------------------------------------------------------------------------
+%% sets of up to 64 elements are held in a single machine word,  the set
+%% operations are then written inline by the translator as bit operations
+
+set-word {%
+/* ---------------------------------------------------------------------------
+ * set type <%0%>
+ * ------------------------------------------------------------------------ */
+
+typedef uint64_t <%0%>;
+%}
+
+
+%% ---------------------------------------------------------------------------
+%% (SET ident enumTypeIdent wordCount)
+%% ---------------------------------------------------------------------------
+%% sets of more than 64 elements are held in a fixed array of words,  the
+%% set operations are loops with a constant trip count over independent
+%% words which the C compiler unrolls or vectorises
 
-set {%
+set-array {%
 /* ---------------------------------------------------------------------------
  * set type <%0%>
  * ------------------------------------------------------------------------ */
 
 typedef struct {
-  long long unsigned seg0;
-  long long unsigned seg1;
+  uint64_t word[<%2%>];
 } <%0%>;
+
+static inline <%0%> <%0%>_union (<%0%> a, <%0%> b) {
+  unsigned i;
+  for (i = 0; i < <%2%>; i++) { a.word[i] |= b.word[i]; }
+  return a;
+}
+
+static inline <%0%> <%0%>_intersection (<%0%> a, <%0%> b) {
+  unsigned i;
+  for (i = 0; i < <%2%>; i++) { a.word[i] &= b.word[i]; }
+  return a;
+}
+
+static inline <%0%> <%0%>_difference (<%0%> a, <%0%> b) {
+  unsigned i;
+  for (i = 0; i < <%2%>; i++) { a.word[i] &= ~b.word[i]; }
+  return a;
+}
+
+static inline <%0%> <%0%>_symdiff (<%0%> a, <%0%> b) {
+  unsigned i;
+  for (i = 0; i < <%2%>; i++) { a.word[i] ^= b.word[i]; }
+  return a;
+}
+
+static inline int <%0%>_in (unsigned e, <%0%> s) {
+  return (int) ((s.word[e >> 6] >> (e & 63)) & 1);
+}
 %}
 
 
@@ -275,7 +355,7 @@ array {%
 typedef struct {
   long long unsigned size;
   long long unsigned count;
-  <%2> value[<%1.0%>];
+  <%2%> value[<%1.0%>];
 } <%0%>;
 %}
 
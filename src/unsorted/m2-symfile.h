@@ -0,0 +1,373 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2-symfile.h                                                              *
+ *                                                                           *
+ * Public interface for M2C symbol files.                                    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_SYMFILE_H
+#define M2C_SYMFILE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2-symtab.h"
+#include "m2c-ast.h"
+#include "m2c-ident-xlat.h"
+#include "interned-strings.h"
+
+
+/* --------------------------------------------------------------------------
+ * Symbol file format
+ * --------------------------------------------------------------------------
+ * A symbol file holds the symbols of the top level scope of an interface
+ * module:  identifier,  kind,  type identifier and the position of the
+ * definition within the binary AST file of the module.  It consists of a
+ * header,  one fixed size record per symbol,  a hash index on the records,
+ * a Bloom filter on their keys and a table of NUL terminated strings,  all
+ * in host byte order,  so that importers can use it in place without
+ * parsing the definition module.  The header also records the C names of
+ * the module,  its identifier prefixes,  import guard and header name,  so
+ * that importers need not translate the module identifier.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Thread safety
+ * --------------------------------------------------------------------------
+ * Define M2C_SYMFILE_THREAD_SAFE as 1 to share open symbol files between
+ * threads.  Lookups,  reference counting and the cache of imported symbol
+ * files are then safe to use from any thread,  so that parallel compile
+ * jobs can share one read-only copy of each imported interface.  This
+ * requires POSIX threads and an interned string library built with
+ * INTSTR_THREAD_SAFE.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2C_SYMFILE_THREAD_SAFE
+#define M2C_SYMFILE_THREAD_SAFE 0
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Symbol file format version
+ * --------------------------------------------------------------------------
+ * Version of the binary symbol file format,  incremented whenever the layout
+ * of symbol files or the list of symbol kinds changes.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_SYMFILE_VERSION 3
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_symfile_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on symbol files.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_SYMFILE_STATUS_SUCCESS,
+  M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+  M2C_SYMFILE_STATUS_IO_ERROR,
+  M2C_SYMFILE_STATUS_INVALID_FILE,
+  M2C_SYMFILE_STATUS_IDENT_NOT_FOUND,
+  M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE,
+  M2C_SYMFILE_STATUS_ALLOCATION_FAILED
+} m2c_symfile_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_symfile_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an open symbol file.  An open symbol
+ * file is immutable and reference counted.  It may be referenced by any
+ * number of symbol tables and released by each of its holders.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_symfile_struct_t *m2c_symfile_t;
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_write_symfile(symtab, flat, astpath, path, status)
+ * --------------------------------------------------------------------------
+ * Writes the symbols of the top level scope of symtab to a symbol file at
+ * path,  replacing any existing file.  Definitions are recorded by their
+ * position within flat,  whose binary AST file is expected at astpath.
+ *
+ * pre-conditions:
+ * o  symtab must be a valid symbol table of an interface module
+ * o  the definitions of its symbols should be nodes of flat
+ * o  path must be a valid pathname
+ *
+ * post-conditions:
+ * o  the symbols of symtab's top level scope have been written to path
+ * o  M2C_SYMFILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  definitions that are not nodes of flat,  or all definitions if flat
+ *    or astpath is NULL,  are recorded as unavailable
+ * o  if symtab or path is NULL, M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+ *    if the file could not be written, M2C_SYMFILE_STATUS_IO_ERROR,
+ *    if allocation failed, M2C_SYMFILE_STATUS_ALLOCATION_FAILED
+ *    is passed back in status, unless NULL,  and no file is left at path
+ * ----------------------------------------------------------------------- */
+
+void m2c_write_symfile
+  (m2c_symtab_t symtab, m2c_ast_flat_t flat, const char *astpath,
+   const char *path, m2c_symfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_open_symfile(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the symbol file at path and returns it with a reference count of
+ * one,  or NULL on failure.  The file is private to the caller.  On
+ * hosts that provide mmap(),  the file is mapped into memory read-only and
+ * used in place.  Only the header and overall layout are checked on open,
+ * each symbol is checked when it is first looked up and the AST file with
+ * the definitions is not read until a definition is requested.
+ *
+ * pre-conditions:
+ * o  path must be a valid pathname
+ *
+ * post-conditions:
+ * o  an open symbol file is returned
+ * o  M2C_SYMFILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  if path is NULL, M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+ *    if the file could not be read, M2C_SYMFILE_STATUS_IO_ERROR,
+ *    if the file is not a valid symbol file for this build,
+ *    M2C_SYMFILE_STATUS_INVALID_FILE,  if allocation failed,
+ *    M2C_SYMFILE_STATUS_ALLOCATION_FAILED is passed back in status,
+ *    unless NULL,  and NULL is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_open_symfile
+  (const char *path, m2c_symfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_import_symfile(path, status)
+ * --------------------------------------------------------------------------
+ * Returns the shared open symbol file for path,  opening it on first use,
+ * or NULL on failure.  While a symbol file imported from path is held,
+ * further imports of the same pathname return it with its reference count
+ * incremented,  so that each interface is mapped and materialised once per
+ * process however many compile jobs import it.  Pathnames are compared as
+ * given,  callers should pass them in a canonical form.
+ *
+ * pre-conditions:
+ * o  path must be a valid pathname
+ *
+ * post-conditions:
+ * o  a shared symbol file is returned,  which the caller must release
+ * o  M2C_SYMFILE_STATUS_SUCCESS is passed back in status, unless NULL
+ *
+ * error-conditions:
+ * o  as for m2c_open_symfile
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_t m2c_import_symfile
+  (const char *path, m2c_symfile_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_retain_symfile(symfile)
+ * --------------------------------------------------------------------------
+ * Increments the reference count of symfile,  unless symfile is NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_retain_symfile (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_attach(symfile, symtab)
+ * --------------------------------------------------------------------------
+ * Adds symfile to the imports of symtab,  so that lookups of symbols not
+ * found in any scope of symtab fall through to symfile.  The symbol file is
+ * referenced,  not copied.  The caller's reference must be held until
+ * symtab is released.
+ *
+ * pre-conditions:
+ * o  symfile must be an open symbol file
+ * o  symtab must be a valid symbol table
+ *
+ * post-conditions:
+ * o  symfile has been added to the imports of symtab
+ * o  M2C_SYMFILE_STATUS_SUCCESS is returned
+ *
+ * error-conditions:
+ * o  if symfile or symtab is NULL, M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+ *    if allocation failed, M2C_SYMFILE_STATUS_ALLOCATION_FAILED
+ *    is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_status_t m2c_symfile_attach
+  (m2c_symfile_t symfile, m2c_symtab_t symtab);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_lookup(symfile, ident, attributes)
+ * --------------------------------------------------------------------------
+ * Looks up the symbol for ident in symfile and if found,  passes back its
+ * attributes.  Scope and type identifier point into symfile.  The AST file
+ * holding the definitions is read on the first lookup of a symbol that has
+ * a definition and kept until symfile is released.
+ *
+ * pre-conditions:
+ * o  symfile must be an open symbol file
+ * o  ident must be an interned string
+ * o  the global string repository must be initialised
+ *
+ * post-conditions:
+ * o  if found,  the symbol's attributes are passed back in attributes,
+ *    unless NULL,  and M2C_SYMFILE_STATUS_SUCCESS is returned
+ *
+ * error-conditions:
+ * o  if symfile or ident is NULL, M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+ *    if ident is not found, M2C_SYMFILE_STATUS_IDENT_NOT_FOUND,
+ *    if the symbol's record is malformed, M2C_SYMFILE_STATUS_INVALID_FILE
+ *    is returned
+ * o  if the symbol's definition could not be read,  its other attributes
+ *    are passed back with a NULL definition,  and
+ *    M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_status_t m2c_symfile_lookup
+  (m2c_symfile_t symfile, intstr_t ident, m2c_sym_attr_t *attributes);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_module(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the identifier of the module of symfile,  or NULL if symfile is
+ * NULL or the identifier was not recorded.
+ * ----------------------------------------------------------------------- */
+
+const char *m2c_symfile_module (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_c_names(symfile, names)
+ * --------------------------------------------------------------------------
+ * Passes the C names of the module of symfile,  as composed when the symbol
+ * file was written,  in names and returns true.  The names are valid until
+ * symfile is released.  Returns false and leaves names unchanged if symfile
+ * is NULL or the names were not recorded.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_symfile_c_names
+  (m2c_symfile_t symfile, m2c_ident_xlat_names_t *names);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_symbol_count(symfile)
+ * --------------------------------------------------------------------------
+ * Returns the number of symbols stored in symfile.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_symfile_symbol_count (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_visit_kind(symfile, kind, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor with context for each symbol of kind kind in symfile,  in
+ * no particular order,  passing its interned identifier and attributes.
+ * Definitions are not materialised,  NULL is passed as the definition.
+ *
+ * pre-conditions:
+ * o  symfile must be an open symbol file
+ * o  the global string repository must be initialised
+ *
+ * post-conditions:
+ * o  visitor has been called for each symbol of kind kind
+ * o  M2C_SYMFILE_STATUS_SUCCESS is returned
+ *
+ * error-conditions:
+ * o  if symfile or visitor is NULL, M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+ *    if a record is malformed, M2C_SYMFILE_STATUS_INVALID_FILE,
+ *    if an identifier could not be interned,
+ *    M2C_SYMFILE_STATUS_ALLOCATION_FAILED is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_status_t m2c_symfile_visit_kind
+  (m2c_symfile_t symfile, m2c_symtype_t kind,
+   m2c_symtab_visitor_f visitor, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symfile_intern_strings(symfile)
+ * --------------------------------------------------------------------------
+ * Interns the module identifier,  the identifiers and type identifiers of
+ * symfile  and the values of the definitions in its AST file,  reading the
+ * AST file if it has not been read yet.  Used to collect the strings of
+ * interfaces imported by many modules into a string repository snapshot.
+ *
+ * pre-conditions:
+ * o  symfile must be an open symbol file
+ * o  the global string repository must be initialised
+ *
+ * post-conditions:
+ * o  the strings of symfile have been interned
+ * o  M2C_SYMFILE_STATUS_SUCCESS is returned
+ *
+ * error-conditions:
+ * o  if symfile is NULL, M2C_SYMFILE_STATUS_INVALID_REFERENCE,
+ *    if a record is malformed, M2C_SYMFILE_STATUS_INVALID_FILE,
+ *    if a string could not be interned, M2C_SYMFILE_STATUS_ALLOCATION_FAILED
+ *    is returned
+ * o  if the AST file could not be read,  the strings of the records are
+ *    interned and M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE is returned
+ * ----------------------------------------------------------------------- */
+
+m2c_symfile_status_t m2c_symfile_intern_strings (m2c_symfile_t symfile);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_release_symfile(symfile)
+ * --------------------------------------------------------------------------
+ * Decrements the reference count of symfile and closes it when the count
+ * drops to zero.  All scopes,  type identifiers and definitions passed back
+ * by lookups of a closed symbol file become invalid.
+ * ----------------------------------------------------------------------- */
+
+void m2c_release_symfile (m2c_symfile_t symfile);
+
+
+#endif /* M2C_SYMFILE_H */
+
+/* END OF FILE */
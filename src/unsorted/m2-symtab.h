@@ -37,9 +37,8 @@
 #define M2C_SYMTAB_H
 
 #include "m2-common.h"
-
-//#include "m2-ast.h"
-typedef void *m2c_astnode_t;
+#include "m2c-ast.h"
+#include "interned-strings.h"
 
 
 /* --------------------------------------------------------------------------
@@ -135,7 +134,7 @@ m2c_symtab_status_t m2c_symtab_open_scope
 
 m2c_symtab_status_t m2c_symtab_insert
   (m2c_symtab_t symtab,
-   const char *ident,
+   intstr_t ident,
    m2c_symtype_t kind,
    const char *type_id,
    m2c_astnode_t definition);
@@ -148,7 +147,55 @@ m2c_symtab_status_t m2c_symtab_insert
  * ----------------------------------------------------------------------- */
 
 m2c_symtab_status_t m2c_symtab_lookup
-  (m2c_symtab_t symtab, const char *ident, m2c_sym_attr_t *attributes);
+  (m2c_symtab_t symtab, intstr_t ident, m2c_sym_attr_t *attributes);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_symtab_visitor_f
+ * --------------------------------------------------------------------------
+ * Function type for procedures called once for each symbol of a scope.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_symtab_visitor_f)
+  (intstr_t ident, const m2c_sym_attr_t *attributes, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_visit_top_scope(symtab, visitor, context)
+ * --------------------------------------------------------------------------
+ * Calls visitor with context for each symbol of the top level scope of a
+ * symbol table,  in no particular order.  The table must not be modified
+ * while it is visited.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_symtab_visit_top_scope
+  (m2c_symtab_t symtab, m2c_symtab_visitor_f visitor, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_symtab_import_f
+ * --------------------------------------------------------------------------
+ * Function type for looking up ident in an imported symbol table import and
+ * passing back its attributes.  The import is not modified by the lookup.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_symtab_status_t (*m2c_symtab_import_f)
+  (void *import, intstr_t ident, m2c_sym_attr_t *attributes);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_symtab_add_import(symtab, lookup, import)
+ * --------------------------------------------------------------------------
+ * Adds the read-only symbol table import with lookup function lookup to the
+ * imports of a symbol table.  Symbols not found in any scope of the table
+ * are then looked up in its imports,  in the order they were added.  The
+ * import is referenced,  not copied,  and may be shared by any number of
+ * symbol tables,  also across threads if its lookup function is thread
+ * safe.  It must remain valid until the symbol table is released.
+ * ----------------------------------------------------------------------- */
+
+m2c_symtab_status_t m2c_symtab_add_import
+  (m2c_symtab_t symtab, m2c_symtab_import_f lookup, void *import);
 
 
 /* --------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * c-resword-data.h                                                          *
+ *                                                                           *
+ * C reserved word data for the perfect hash generator.                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * Each entry has the form CLASS(word) where CLASS is either RESWORD for the
+ * reserved words of C99,  or PSEUDO for identifiers  that are not reserved
+ * but must not be redefined  (C_RESWORDS_INCLUDE_PSEUDO_RESWORDS).
+ * ----------------------------------------------------------------------- */
+
+/* Reserved Words */
+
+RESWORD(auto)
+RESWORD(break)
+RESWORD(case)
+RESWORD(char)
+RESWORD(const)
+RESWORD(continue)
+RESWORD(default)
+RESWORD(do)
+RESWORD(double)
+RESWORD(else)
+RESWORD(enum)
+RESWORD(extern)
+RESWORD(float)
+RESWORD(for)
+RESWORD(goto)
+RESWORD(if)
+RESWORD(inline)
+RESWORD(int)
+RESWORD(long)
+RESWORD(register)
+RESWORD(restrict)
+RESWORD(return)
+RESWORD(short)
+RESWORD(signed)
+RESWORD(sizeof)
+RESWORD(static)
+RESWORD(struct)
+RESWORD(switch)
+RESWORD(typedef)
+RESWORD(union)
+RESWORD(unsigned)
+RESWORD(void)
+RESWORD(volatile)
+RESWORD(while)
+
+/* Pseudo Reserved Words */
+
+PSEUDO(NULL)
+PSEUDO(alignas)
+PSEUDO(alignof)
+PSEUDO(bool)
+PSEUDO(complex)
+PSEUDO(exit)
+PSEUDO(false)
+PSEUDO(free)
+PSEUDO(imaginary)
+PSEUDO(main)
+PSEUDO(malloc)
+PSEUDO(noreturn)
+
+
+/* END OF FILE */
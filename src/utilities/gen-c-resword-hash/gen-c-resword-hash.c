@@ -0,0 +1,335 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * gen-c-resword-hash.c                                                      *
+ *                                                                           *
+ * Generates a perfect hash table over the reserved words of C.              *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * hash function, must match lib/c-reswords/c_reswords.c
+ * ----------------------------------------------------------------------- */
+
+#define C_RESWORD_HASH(_first, _second, _last, _len, _a, _b, _c, _bits) \
+  ((((_first) * (_a)) + (_second) + ((_last) * (_b)) + ((_len) * (_c))) \
+    & ((1u << (_bits)) - 1))
+
+#define MAX_FIRST_FACTOR 63
+#define MAX_LAST_FACTOR 63
+#define MAX_LENGTH_FACTOR 15
+#define MAX_SLOT_BITS 8
+
+
+/* --------------------------------------------------------------------------
+ * entry table
+ * ----------------------------------------------------------------------- */
+
+#define MAX_ENTRIES 64
+
+typedef struct {
+  const char *word;
+  bool pseudo;
+} entry_t;
+
+static entry_t entry[MAX_ENTRIES];
+static unsigned entry_count = 0;
+
+
+/* --------------------------------------------------------------------------
+ * function init_entry_table()
+ * --------------------------------------------------------------------------
+ * Initialises the entry table from c-resword-data.h.
+ * ----------------------------------------------------------------------- */
+
+static void init_entry_table (void) {
+  
+  #define RESWORD(_word) \
+    entry[entry_count].word = #_word; \
+    entry[entry_count].pseudo = false; \
+    entry_count++;
+  
+  #define PSEUDO(_word) \
+    entry[entry_count].word = #_word; \
+    entry[entry_count].pseudo = true; \
+    entry_count++;
+  
+  #include "c-resword-data.h"
+  
+  #undef RESWORD
+  #undef PSEUDO
+} /* end init_entry_table */
+
+
+/* --------------------------------------------------------------------------
+ * hash table
+ * ----------------------------------------------------------------------- */
+
+static unsigned slot_bits, first_factor, last_factor, length_factor;
+static unsigned min_length, max_length;
+
+static int slot_entry[1 << MAX_SLOT_BITS];
+
+
+/* --------------------------------------------------------------------------
+ * function slot_for_word(word)
+ * --------------------------------------------------------------------------
+ * Returns the slot of word under the current hash parameters.
+ * ----------------------------------------------------------------------- */
+
+static unsigned slot_for_word (const char *word) {
+  unsigned len = (unsigned) strlen(word);
+  
+  return C_RESWORD_HASH((unsigned char) word[0], (unsigned char) word[1],
+    (unsigned char) word[len - 1], len,
+    first_factor, last_factor, length_factor, slot_bits);
+} /* end slot_for_word */
+
+
+/* --------------------------------------------------------------------------
+ * function try_parameters()
+ * --------------------------------------------------------------------------
+ * Returns true and fills the slot table if all words map to distinct slots
+ * under the current hash parameters,  otherwise returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool try_parameters (void) {
+  unsigned index, slot;
+  
+  for (index = 0; index < (1u << slot_bits); index++) {
+    slot_entry[index] = -1;
+  } /* end for */
+  
+  for (index = 0; index < entry_count; index++) {
+    slot = slot_for_word(entry[index].word);
+    
+    if (slot_entry[slot] >= 0) {
+      return false;
+    } /* end if */
+    
+    slot_entry[slot] = (int) index;
+  } /* end for */
+  
+  return true;
+} /* end try_parameters */
+
+
+/* --------------------------------------------------------------------------
+ * function find_parameters()
+ * --------------------------------------------------------------------------
+ * Searches for the smallest table and hash parameters  that map all words
+ * to distinct slots.  Returns true on success, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool find_parameters (void) {
+  
+  slot_bits = 0;
+  while ((1u << slot_bits) < entry_count) {
+    slot_bits++;
+  } /* end while */
+  
+  for (; slot_bits <= MAX_SLOT_BITS; slot_bits++) {
+    for (first_factor = 1; first_factor <= MAX_FIRST_FACTOR; first_factor++) {
+      for (last_factor = 0; last_factor <= MAX_LAST_FACTOR; last_factor++) {
+        for (length_factor = 0;
+             length_factor <= MAX_LENGTH_FACTOR; length_factor++) {
+          if (try_parameters()) {
+            return true;
+          } /* end if */
+        } /* end for */
+      } /* end for */
+    } /* end for */
+  } /* end for */
+  
+  return false;
+} /* end find_parameters */
+
+
+/* --------------------------------------------------------------------------
+ * function print_table()
+ * --------------------------------------------------------------------------
+ * Calculates the perfect hash and prints the resulting table to stdout.
+ * ----------------------------------------------------------------------- */
+
+#define PREAMBLE \
+  "/* AUTO-GENERATED by utility gen-c-resword-hash * DO NOT EDIT! */\n\n"
+
+#define EOF_MARKER \
+  "\n/* END OF FILE */\n"
+
+static bool print_table (void) {
+  unsigned index, len;
+  const entry_t *this_entry;
+  
+  init_entry_table();
+  
+  if (find_parameters() == false) {
+    return false;
+  } /* end if */
+  
+  min_length = ~0u;
+  max_length = 0;
+  for (index = 0; index < entry_count; index++) {
+    len = (unsigned) strlen(entry[index].word);
+    if (len < min_length) {
+      min_length = len;
+    } /* end if */
+    if (len > max_length) {
+      max_length = len;
+    } /* end if */
+  } /* end for */
+  
+  printf(PREAMBLE);
+  
+  printf("#define C_RESWORD_ENTRY_COUNT %u\n", entry_count);
+  printf("#define C_RESWORD_MIN_LENGTH %u\n", min_length);
+  printf("#define C_RESWORD_MAX_LENGTH %u\n", max_length);
+  printf("#define C_RESWORD_FIRST_FACTOR %uu\n", first_factor);
+  printf("#define C_RESWORD_LAST_FACTOR %uu\n", last_factor);
+  printf("#define C_RESWORD_LENGTH_FACTOR %uu\n", length_factor);
+  printf("#define C_RESWORD_SLOT_BITS %u\n\n", slot_bits);
+  
+  printf("static const c_resword_entry_t c_resword_table[] = {\n");
+  for (index = 0; index < (1u << slot_bits); index++) {
+    if (slot_entry[index] < 0) {
+      printf("  /* %3u */ { NULL, 0, false }", index);
+    }
+    else {
+      this_entry = &entry[slot_entry[index]];
+      printf("  /* %3u */ { \"%s\", %u, %s }",
+        index, this_entry->word, (unsigned) strlen(this_entry->word),
+        this_entry->pseudo ? "true" : "false");
+    } /* end if */
+    printf("%s\n", (index + 1 < (1u << slot_bits)) ? "," : "");
+  } /* end for */
+  printf("}; /* c_resword_table */\n");
+  
+  printf(EOF_MARKER);
+  return true;
+} /* end print_table */
+
+
+/* --------------------------------------------------------------------------
+ * function print_usage()
+ * --------------------------------------------------------------------------
+ * Prints usage info to the console.
+ * ----------------------------------------------------------------------- */
+
+static void print_usage (void) {
+  printf("usage info:\n\n");
+  printf("gen-c-resword-hash option\n\n");
+  printf("options:\n\n");
+  printf("-h prints this info.\n");
+  printf("-t prints the perfect hash table.\n\n");
+  printf("examples:\n\n");
+  printf("$ gen-c-resword-hash -t > "
+    "../../lib/c-reswords/c-resword-table.h\n\n");
+} /* end print_usage */
+
+
+/* --------------------------------------------------------------------------
+ * function print_error()
+ * --------------------------------------------------------------------------
+ * Prints error message to stderr.
+ * ----------------------------------------------------------------------- */
+
+static void print_error (const char *msg) {
+  fprintf(stderr, "%s\n\n", msg);
+} /* end print_error */
+
+
+/* --------------------------------------------------------------------------
+ * utility program gen-c-resword-hash
+ * --------------------------------------------------------------------------
+ * This utility prints a perfect hash table over the C reserved words and
+ * pseudo reserved words listed in c-resword-data.h to the console.  It
+ * should be invoked with output redirection as follows:
+ *
+ * $ gen-c-resword-hash -t > ../../lib/c-reswords/c-resword-table.h
+ *
+ * The table must be regenerated whenever c-resword-data.h or the hash
+ * function are changed.
+ * ----------------------------------------------------------------------- */
+
+#define SUCCESS_RETURN_CODE 0
+#define ERROR_RETURN_CODE (-1)
+
+int main(int argc, const char *argv[]) {
+  const char *argstr;
+  
+  if (argc != 2) {
+    print_error("invalid number of arguments");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  argstr = argv[1];
+  
+  if ((strlen(argstr) == 2) && (argstr[0] == '-')) {
+    switch (argstr[1]) {
+      case 'h' :
+        print_usage();
+        break;
+      case 't' :
+        if (print_table() == false) {
+          print_error("no perfect hash found, increase MAX_SLOT_BITS");
+          return ERROR_RETURN_CODE;
+        } /* end if */
+        break;
+      default :
+        print_error("invalid argument");
+        print_usage();
+        return ERROR_RETURN_CODE;
+    } /* end switch */
+  }
+  else /* invalid args */ {
+    print_error("invalid argument");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  return SUCCESS_RETURN_CODE;
+} /* end main */
+
+
+/* END OF FILE */
@@ -0,0 +1,748 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * gen-c-templates.c                                                         *
+ *                                                                           *
+ * Compiles a C code generation template file into a generated C table.      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Template file syntax
+ * --------------------------------------------------------------------------
+ * Outside of templates,  lines starting with %% are comments and blank lines
+ * are ignored.  A template starts with a line of the form  name {%  and ends
+ * with a line consisting of %} only.  Within a template body
+ *
+ *   <%name%>  is a placeholder,  if name is the name of another template it
+ *             is an inclusion of that template,  otherwise a slot;
+ *
+ *   @foreach var <%name%>
+ *             on a line of its own is an iteration over slot name.
+ *
+ * All other text is copied verbatim.
+ * ----------------------------------------------------------------------- */
+
+#define MAX_TEMPLATES 256
+#define MAX_ITEMS 4096
+#define MAX_SLOTS 256
+
+
+/* --------------------------------------------------------------------------
+ * item table
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  ITEM_SPAN,
+  ITEM_SLOT,
+  ITEM_INCLUDE,
+  ITEM_FOREACH
+} item_kind_t;
+
+typedef struct {
+  item_kind_t kind;
+  const char *text;
+  size_t length;
+  unsigned ref;
+} item_t;
+
+typedef struct {
+  const char *name;
+  size_t length;
+  unsigned first;
+  unsigned count;
+} template_t;
+
+typedef struct {
+  const char *name;
+  size_t length;
+} slot_t;
+
+static template_t template[MAX_TEMPLATES];
+static unsigned template_count = 0;
+
+static item_t item[MAX_ITEMS];
+static unsigned item_count = 0;
+
+static slot_t slot[MAX_SLOTS];
+static unsigned slot_count = 0;
+
+static const char *source_path = NULL;
+static unsigned line_no = 0;
+
+
+/* --------------------------------------------------------------------------
+ * function print_error()
+ * --------------------------------------------------------------------------
+ * Prints error message to stderr.
+ * ----------------------------------------------------------------------- */
+
+static void print_error (const char *msg) {
+  if (line_no > 0) {
+    fprintf(stderr, "%s:%u: %s\n\n", source_path, line_no, msg);
+  }
+  else {
+    fprintf(stderr, "%s\n\n", msg);
+  } /* end if */
+} /* end print_error */
+
+
+/* --------------------------------------------------------------------------
+ * function read_source(path)
+ * --------------------------------------------------------------------------
+ * Returns the NUL terminated contents of the file at path,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+static char *read_source (const char *path) {
+  FILE *file;
+  char *text;
+  long size;
+  
+  file = fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  } /* end if */
+  
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  
+  text = (size < 0) ? NULL : malloc((size_t) size + 1);
+  if (text != NULL) {
+    size = (long) fread(text, 1, (size_t) size, file);
+    text[size] = '\0';
+  } /* end if */
+  
+  fclose(file);
+  return text;
+} /* end read_source */
+
+
+/* --------------------------------------------------------------------------
+ * function add_item(kind, text, length)
+ * --------------------------------------------------------------------------
+ * Appends an item to the item table.  Returns false if the table is full.
+ * ----------------------------------------------------------------------- */
+
+static bool add_item (item_kind_t kind, const char *text, size_t length) {
+  
+  if ((kind == ITEM_SPAN) && (length == 0)) {
+    return true;
+  } /* end if */
+  
+  if (item_count == MAX_ITEMS) {
+    print_error("too many items, increase MAX_ITEMS");
+    return false;
+  } /* end if */
+  
+  /* spans are stored with 16-bit lengths */
+  if (length > 0xFFFF) {
+    print_error("literal span too long");
+    return false;
+  } /* end if */
+  
+  item[item_count].kind = kind;
+  item[item_count].text = text;
+  item[item_count].length = length;
+  item[item_count].ref = 0;
+  item_count++;
+  
+  return true;
+} /* end add_item */
+
+
+/* --------------------------------------------------------------------------
+ * function parse_body(start, end)
+ * --------------------------------------------------------------------------
+ * Splits the template body from start up to end into items.  Returns false
+ * on malformed placeholders.
+ * ----------------------------------------------------------------------- */
+
+#define IS_LINE_START(_p) (((_p) == start) || ((_p)[-1] == '\n'))
+
+static bool parse_body (const char *start, const char *end) {
+  const char *p, *span, *name, *close;
+  
+  p = start;
+  span = start;
+  
+  while (p < end) {
+    /* @foreach directive */
+    if (IS_LINE_START(p) && (strncmp(p, "@foreach", 8) == 0)) {
+      if ((add_item(ITEM_SPAN, span, (size_t) (p - span)) == false)) {
+        return false;
+      } /* end if */
+      
+      name = strstr(p, "<%");
+      close = (name == NULL) ? NULL : strstr(name, "%>");
+      if ((close == NULL) || (close >= end) ||
+          (memchr(p, '\n', (size_t) (name - p)) != NULL)) {
+        print_error("malformed @foreach directive");
+        return false;
+      } /* end if */
+      
+      if (add_item(ITEM_FOREACH, name + 2, (size_t) (close - name - 2))
+          == false) {
+        return false;
+      } /* end if */
+      
+      /* skip to the end of the line */
+      p = close + 2;
+      while ((p < end) && (*p != '\n')) {
+        p++;
+      } /* end while */
+      if (p < end) {
+        p++;
+        line_no++;
+      } /* end if */
+      span = p;
+    }
+    
+    /* placeholder */
+    else if ((p[0] == '<') && (p[1] == '%')) {
+      if ((add_item(ITEM_SPAN, span, (size_t) (p - span)) == false)) {
+        return false;
+      } /* end if */
+      
+      name = p + 2;
+      close = name;
+      while ((close < end) && (*close != '\n') &&
+             ((close[0] != '%') || (close[1] != '>'))) {
+        close++;
+      } /* end while */
+      
+      if ((close >= end) || (*close == '\n') || (close == name)) {
+        print_error("unterminated or empty placeholder");
+        return false;
+      } /* end if */
+      
+      if (add_item(ITEM_SLOT, name, (size_t) (close - name)) == false) {
+        return false;
+      } /* end if */
+      
+      p = close + 2;
+      span = p;
+    }
+    
+    /* verbatim text */
+    else {
+      if (*p == '\n') {
+        line_no++;
+      } /* end if */
+      p++;
+    } /* end if */
+  } /* end while */
+  
+  return add_item(ITEM_SPAN, span, (size_t) (end - span));
+} /* end parse_body */
+
+
+/* --------------------------------------------------------------------------
+ * function parse_source(text)
+ * --------------------------------------------------------------------------
+ * Parses all templates in text into the template and item tables.  Returns
+ * false on syntax errors.
+ * ----------------------------------------------------------------------- */
+
+static bool parse_source (const char *text) {
+  const char *p, *eol, *name_end, *body, *body_end;
+  
+  p = text;
+  line_no = 1;
+  
+  while (*p != '\0') {
+    eol = strchr(p, '\n');
+    if (eol == NULL) {
+      eol = p + strlen(p);
+    } /* end if */
+    
+    /* comment or blank line */
+    if ((strncmp(p, "%%", 2) == 0) ||
+        (strspn(p, " \t\r") == (size_t) (eol - p))) {
+      p = (*eol == '\0') ? eol : eol + 1;
+      line_no++;
+      continue;
+    } /* end if */
+    
+    /* template header */
+    name_end = p;
+    while ((name_end < eol) && (*name_end != ' ')) {
+      name_end++;
+    } /* end while */
+    
+    if ((name_end == p) || (strncmp(name_end, " {%", 3) != 0) ||
+        (name_end + 3 != eol)) {
+      print_error("template header expected");
+      return false;
+    } /* end if */
+    
+    if (template_count == MAX_TEMPLATES) {
+      print_error("too many templates, increase MAX_TEMPLATES");
+      return false;
+    } /* end if */
+    
+    /* template body up to closing line */
+    body = eol + 1;
+    body_end = strstr(body, "\n%}");
+    if (strncmp(body, "%}", 2) == 0) {
+      body_end = body - 1;
+    } /* end if */
+    
+    if (body_end == NULL) {
+      print_error("unterminated template");
+      return false;
+    } /* end if */
+    
+    /* the body includes the newline of its last line */
+    body_end++;
+    
+    template[template_count].name = p;
+    template[template_count].length = (size_t) (name_end - p);
+    template[template_count].first = item_count;
+    
+    line_no++;
+    if (parse_body(body, body_end) == false) {
+      return false;
+    } /* end if */
+    
+    template[template_count].count = item_count -
+      template[template_count].first;
+    template_count++;
+    
+    /* skip closing line */
+    p = body_end + 2;
+    while ((*p != '\0') && (*p != '\n')) {
+      p++;
+    } /* end while */
+    if (*p == '\n') {
+      p++;
+    } /* end if */
+    line_no++;
+  } /* end while */
+  
+  line_no = 0;
+  return true;
+} /* end parse_source */
+
+
+/* --------------------------------------------------------------------------
+ * function resolve_items()
+ * --------------------------------------------------------------------------
+ * Turns placeholders naming templates into inclusions  and numbers all the
+ * remaining slots.  Returns false if there are too many slots.
+ * ----------------------------------------------------------------------- */
+
+static bool resolve_items (void) {
+  unsigned index, other;
+  item_t *this_item;
+  
+  for (index = 0; index < item_count; index++) {
+    this_item = &item[index];
+    
+    if (this_item->kind == ITEM_SPAN) {
+      continue;
+    } /* end if */
+    
+    /* placeholder naming a template */
+    if (this_item->kind == ITEM_SLOT) {
+      for (other = 0; other < template_count; other++) {
+        if ((template[other].length == this_item->length) &&
+            (memcmp(template[other].name, this_item->text,
+              this_item->length) == 0)) {
+          this_item->kind = ITEM_INCLUDE;
+          this_item->ref = other;
+          break;
+        } /* end if */
+      } /* end for */
+      
+      if (this_item->kind == ITEM_INCLUDE) {
+        continue;
+      } /* end if */
+    } /* end if */
+    
+    /* slot */
+    for (other = 0; other < slot_count; other++) {
+      if ((slot[other].length == this_item->length) &&
+          (memcmp(slot[other].name, this_item->text, this_item->length)
+            == 0)) {
+        break;
+      } /* end if */
+    } /* end for */
+    
+    if (other == slot_count) {
+      if (slot_count == MAX_SLOTS) {
+        print_error("too many slots, increase MAX_SLOTS");
+        return false;
+      } /* end if */
+      slot[slot_count].name = this_item->text;
+      slot[slot_count].length = this_item->length;
+      slot_count++;
+    } /* end if */
+    
+    this_item->ref = other;
+  } /* end for */
+  
+  return true;
+} /* end resolve_items */
+
+
+/* --------------------------------------------------------------------------
+ * function includes_template(index, target, depth)
+ * --------------------------------------------------------------------------
+ * Returns true if template index includes template target  directly or
+ * indirectly.
+ * ----------------------------------------------------------------------- */
+
+static bool includes_template
+  (unsigned index, unsigned target, unsigned depth) {
+  unsigned entry;
+  const item_t *this_item;
+  
+  /* any deeper chain must repeat a template */
+  if (depth > template_count) {
+    return true;
+  } /* end if */
+  
+  for (entry = 0; entry < template[index].count; entry++) {
+    this_item = &item[template[index].first + entry];
+    if ((this_item->kind == ITEM_INCLUDE) &&
+        ((this_item->ref == target) ||
+         (includes_template(this_item->ref, target, depth + 1)))) {
+      return true;
+    } /* end if */
+  } /* end for */
+  
+  return false;
+} /* end includes_template */
+
+
+/* --------------------------------------------------------------------------
+ * function check_cycles()
+ * --------------------------------------------------------------------------
+ * Returns false if any template includes itself.
+ * ----------------------------------------------------------------------- */
+
+static bool check_cycles (void) {
+  unsigned index;
+  
+  for (index = 0; index < template_count; index++) {
+    if (includes_template(index, index, 0)) {
+      fprintf(stderr, "%s: template %.*s includes itself\n\n", source_path,
+        (int) template[index].length, template[index].name);
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return true;
+} /* end check_cycles */
+
+
+/* --------------------------------------------------------------------------
+ * function print_ident(prefix, name, length)
+ * --------------------------------------------------------------------------
+ * Prints prefix followed by name  in uppercase  with all characters other
+ * than letters and digits replaced by lowlines.
+ * ----------------------------------------------------------------------- */
+
+static void print_ident (const char *prefix, const char *name, size_t length) {
+  size_t index;
+  char ch;
+  
+  fputs(prefix, stdout);
+  for (index = 0; index < length; index++) {
+    ch = name[index];
+    if ((ch >= 'a') && (ch <= 'z')) {
+      ch = (char) (ch - 32);
+    }
+    else if (!(((ch >= 'A') && (ch <= 'Z')) || ((ch >= '0') && (ch <= '9')))) {
+      ch = '_';
+    } /* end if */
+    putchar(ch);
+  } /* end for */
+} /* end print_ident */
+
+
+/* --------------------------------------------------------------------------
+ * function print_literal(text, length)
+ * --------------------------------------------------------------------------
+ * Prints text as a C string literal,  broken into one literal per line.
+ * ----------------------------------------------------------------------- */
+
+static void print_literal (const char *text, size_t length) {
+  size_t index;
+  char ch;
+  
+  putchar('"');
+  for (index = 0; index < length; index++) {
+    ch = text[index];
+    switch (ch) {
+      case '\n' :
+        fputs("\\n\"", stdout);
+        if (index + 1 < length) {
+          fputs("\n      \"", stdout);
+        }
+        else {
+          return;
+        } /* end if */
+        break;
+      case '\t' :
+        fputs("\\t", stdout);
+        break;
+      case '"' :
+      case '\\' :
+      case '?' :
+        putchar('\\');
+        putchar(ch);
+        break;
+      default :
+        putchar(ch);
+    } /* end switch */
+  } /* end for */
+  putchar('"');
+} /* end print_literal */
+
+
+/* --------------------------------------------------------------------------
+ * function compile_source(path)
+ * --------------------------------------------------------------------------
+ * Reads and compiles the template file at path.  Returns false on failure.
+ * ----------------------------------------------------------------------- */
+
+static bool compile_source (const char *path) {
+  char *text;
+  
+  source_path = path;
+  text = read_source(path);
+  
+  if (text == NULL) {
+    print_error("unable to read template file");
+    return false;
+  } /* end if */
+  
+  return (parse_source(text) && resolve_items() && check_cycles());
+} /* end compile_source */
+
+
+/* --------------------------------------------------------------------------
+ * function print_ids()
+ * --------------------------------------------------------------------------
+ * Prints the template and slot enumerations to stdout.
+ * ----------------------------------------------------------------------- */
+
+#define PREAMBLE \
+  "/* AUTO-GENERATED by utility gen-c-templates * DO NOT EDIT! */\n\n"
+
+#define EOF_MARKER \
+  "\n/* END OF FILE */\n"
+
+static void print_ids (void) {
+  unsigned index;
+  
+  printf(PREAMBLE);
+  
+  printf("typedef enum {\n");
+  for (index = 0; index < template_count; index++) {
+    print_ident("  M2C_TEMPLATE_", template[index].name,
+      template[index].length);
+    printf(",\n");
+  } /* end for */
+  printf("  M2C_TEMPLATE_END_MARK\n");
+  printf("} m2c_template_t;\n\n");
+  
+  printf("typedef enum {\n");
+  for (index = 0; index < slot_count; index++) {
+    print_ident("  M2C_TEMPLATE_SLOT_", slot[index].name,
+      slot[index].length);
+    printf(",  /* <%%%.*s%%> */\n",
+      (int) slot[index].length, slot[index].name);
+  } /* end for */
+  printf("  M2C_TEMPLATE_SLOT_END_MARK\n");
+  printf("} m2c_template_slot_t;\n");
+  
+  printf(EOF_MARKER);
+} /* end print_ids */
+
+
+/* --------------------------------------------------------------------------
+ * function print_table()
+ * --------------------------------------------------------------------------
+ * Prints the template and item tables to stdout.
+ * ----------------------------------------------------------------------- */
+
+static void print_table (void) {
+  unsigned index, entry;
+  const item_t *this_item;
+  
+  printf(PREAMBLE);
+  
+  printf("#define M2C_TEMPLATE_ITEM_COUNT %u\n\n", item_count);
+  
+  printf("static const m2c_template_item_t m2c_template_item[] = {\n");
+  for (index = 0; index < template_count; index++) {
+    printf("  /* %.*s */\n", (int) template[index].length,
+      template[index].name);
+    
+    for (entry = 0; entry < template[index].count; entry++) {
+      this_item = &item[template[index].first + entry];
+      switch (this_item->kind) {
+        case ITEM_SPAN :
+          printf("  { TEMPLATE_ITEM_SPAN, %u,\n      ",
+            (unsigned) this_item->length);
+          print_literal(this_item->text, this_item->length);
+          printf(" }");
+          break;
+        case ITEM_SLOT :
+          print_ident("  { TEMPLATE_ITEM_SLOT, M2C_TEMPLATE_SLOT_",
+            this_item->text, this_item->length);
+          printf(", NULL }");
+          break;
+        case ITEM_FOREACH :
+          print_ident("  { TEMPLATE_ITEM_FOREACH, M2C_TEMPLATE_SLOT_",
+            this_item->text, this_item->length);
+          printf(", NULL }");
+          break;
+        case ITEM_INCLUDE :
+          print_ident("  { TEMPLATE_ITEM_INCLUDE, M2C_TEMPLATE_",
+            template[this_item->ref].name, template[this_item->ref].length);
+          printf(", NULL }");
+          break;
+      } /* end switch */
+      printf("%s\n",
+        (template[index].first + entry + 1 < item_count) ? "," : "");
+    } /* end for */
+  } /* end for */
+  printf("}; /* m2c_template_item */\n\n");
+  
+  printf("static const m2c_template_entry_t m2c_template_table[] = {\n");
+  for (index = 0; index < template_count; index++) {
+    printf("  { \"%.*s\", %u, %u }%s\n",
+      (int) template[index].length, template[index].name,
+      template[index].first, template[index].count,
+      (index + 1 < template_count) ? "," : "");
+  } /* end for */
+  printf("}; /* m2c_template_table */\n");
+  
+  printf(EOF_MARKER);
+} /* end print_table */
+
+
+/* --------------------------------------------------------------------------
+ * function print_usage()
+ * --------------------------------------------------------------------------
+ * Prints usage info to the console.
+ * ----------------------------------------------------------------------- */
+
+static void print_usage (void) {
+  printf("usage info:\n\n");
+  printf("gen-c-templates option template-file\n\n");
+  printf("options:\n\n");
+  printf("-h prints this info.\n");
+  printf("-e prints the template and slot enumerations.\n");
+  printf("-t prints the template table.\n\n");
+  printf("examples:\n\n");
+  printf("$ gen-c-templates -e ../../templates/c99-templates.tpl "
+    "> ../../data/m2c-template-ids.h\n");
+  printf("$ gen-c-templates -t ../../templates/c99-templates.tpl "
+    "> ../../data/m2c-template-table.h\n\n");
+} /* end print_usage */
+
+
+/* --------------------------------------------------------------------------
+ * utility program gen-c-templates
+ * --------------------------------------------------------------------------
+ * This utility compiles a C code generation template file into tables of
+ * literal spans and placeholder slots,  so that code generation needs no
+ * template parsing at runtime.  It should be invoked with output redirection
+ * as follows:
+ *
+ * $ gen-c-templates -e ../../templates/c99-templates.tpl \
+ *     > ../../data/m2c-template-ids.h
+ * $ gen-c-templates -t ../../templates/c99-templates.tpl \
+ *     > ../../data/m2c-template-table.h
+ *
+ * Both files must be regenerated whenever the template file is changed.
+ * ----------------------------------------------------------------------- */
+
+#define SUCCESS_RETURN_CODE 0
+#define ERROR_RETURN_CODE (-1)
+
+int main(int argc, const char *argv[]) {
+  const char *argstr;
+  
+  if ((argc == 2) && (strcmp(argv[1], "-h") == 0)) {
+    print_usage();
+    return SUCCESS_RETURN_CODE;
+  } /* end if */
+  
+  if (argc != 3) {
+    print_error("invalid number of arguments");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  argstr = argv[1];
+  
+  if ((strlen(argstr) == 2) && (argstr[0] == '-') &&
+      ((argstr[1] == 'e') || (argstr[1] == 't'))) {
+    if (compile_source(argv[2]) == false) {
+      return ERROR_RETURN_CODE;
+    } /* end if */
+    
+    if (argstr[1] == 'e') {
+      print_ids();
+    }
+    else /* 't' */ {
+      print_table();
+    } /* end if */
+  }
+  else /* invalid args */ {
+    print_error("invalid argument");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  return SUCCESS_RETURN_CODE;
+} /* end main */
+
+
+/* END OF FILE */
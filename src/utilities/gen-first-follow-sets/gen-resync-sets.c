@@ -0,0 +1,316 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * gen-resync-sets.c                                                         *
+ *                                                                           *
+ * Utility program to generate the resync set database.                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-tokenset.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+
+/* --------------------------------------------------------------------------
+ * enum type production_t
+ * ----------------------------------------------------------------------- */
+
+#define PROD(_caps, _id, _first, _follow) P_ ## _caps,
+
+typedef enum {
+  #include "production-data.h"
+  P_END_MARKER
+} production_t;
+
+#define PRODUCTION_COUNT P_END_MARKER
+
+#undef PROD
+
+
+/* --------------------------------------------------------------------------
+ * sentinel for resync sets without a FIRST or FOLLOW component
+ * ----------------------------------------------------------------------- */
+
+#define P_NONE P_END_MARKER
+
+
+/* --------------------------------------------------------------------------
+ * resync set composition table
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *name;
+  m2c_token_t token;
+  production_t first;
+  production_t follow;
+} resync_entry_t;
+
+#define RESYNC(_caps, _token, _first, _follow) \
+  { #_caps, _token, P_ ## _first, P_ ## _follow },
+
+static const resync_entry_t resync_entry[] = {
+  #include "resync-data.h"
+  { NULL, 0, P_NONE, P_NONE }
+}; /* resync_entry */
+
+#undef RESYNC
+
+#define RESYNC_COUNT \
+  ((sizeof(resync_entry) / sizeof(resync_entry_t)) - 1)
+
+
+/* --------------------------------------------------------------------------
+ * complete first and follow set tables
+ * ----------------------------------------------------------------------- */
+
+static m2c_tokenset_t first_set[PRODUCTION_COUNT + 1];
+
+static m2c_tokenset_t follow_set[PRODUCTION_COUNT + 1];
+
+
+/* --------------------------------------------------------------------------
+ * function init_set_tables()
+ * --------------------------------------------------------------------------
+ * Initialises the complete first and follow set tables from production-
+ * data.h.  The entries at index P_NONE remain NULL.
+ * ----------------------------------------------------------------------- */
+
+static void init_set_tables (void) {
+  
+  #define PROD(_caps, _id, _first, _follow) \
+    first_set[P_ ## _caps] = m2c_new_tokenset_from_list _first ; \
+    follow_set[P_ ## _caps] = m2c_new_tokenset_from_list _follow ;
+  
+  #include "production-data.h"
+  
+  #undef PROD
+} /* init_set_tables */
+  
+  
+/* --------------------------------------------------------------------------
+ * function new_resync_set(entry)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated tokenset holding the union of the components of
+ * resync set entry.
+ * ----------------------------------------------------------------------- */
+  
+static m2c_tokenset_t new_resync_set (const resync_entry_t *entry) {
+  m2c_tokenset_t component[4], token_set, set;
+  unsigned count;
+  
+  token_set = NULL;
+  if (entry->token != 0) {
+    token_set = m2c_new_tokenset_from_list(entry->token, 0);
+  } /* end if */
+  
+  /* the union stops at the first NULL,  thus omit absent components */
+  count = 0;
+  if (token_set != NULL) {
+    component[count] = token_set;
+    count++;
+  } /* end if */
+  
+  if (first_set[entry->first] != NULL) {
+    component[count] = first_set[entry->first];
+    count++;
+  } /* end if */
+  
+  if (follow_set[entry->follow] != NULL) {
+    component[count] = follow_set[entry->follow];
+    count++;
+  } /* end if */
+  
+  while (count < 4) {
+    component[count] = NULL;
+    count++;
+  } /* end while */
+  
+  set = m2c_new_tokenset_from_union
+    (component[0], component[1], component[2], component[3]);
+  
+  if (token_set != NULL) {
+    m2c_tokenset_release(token_set);
+  } /* end if */
+  
+  return set;
+} /* end new_resync_set */
+
+
+/* --------------------------------------------------------------------------
+ * function print_set_literals()
+ * --------------------------------------------------------------------------
+ * Prints set literals of all resync sets as name/value pairs to the console.
+ * Each entry has the format DATA(name, literal),  where name is the name of
+ * the resync set and literal is a literal that represents the set.
+ * ----------------------------------------------------------------------- */
+
+#define PREAMBLE \
+  "/* AUTO-GENERATED by utility gen-resync-sets * DO NOT EDIT! */\n\n"
+
+#define EOF_MARKER \
+  "\n/* END OF FILE */\n"
+
+static void print_set_literals (void) {
+  unsigned index;
+  m2c_tokenset_t set;
+  
+  init_set_tables();
+  
+  printf(PREAMBLE);
+  
+  for (index = 0; index < RESYNC_COUNT; index++) {
+    set = new_resync_set(&resync_entry[index]);
+  
+    if (set == NULL) {
+      fprintf(stderr, "allocation failed\n");
+      return;
+    } /* end if */
+  
+    /* name */
+    printf("DATA(%s /* data-index: %u */, (\n    ",
+      resync_entry[index].name, index);
+  
+    /* set literal */
+    m2c_tokenset_print_literal(set);
+    printf("  )\n");
+  
+    /* separator */
+    printf(")\n");
+  
+    m2c_tokenset_release(set);
+  } /* end for */
+  
+  printf(EOF_MARKER);
+} /* end print_set_literals */
+
+
+/* --------------------------------------------------------------------------
+ * function str_len(str)
+ * ----------------------------------------------------------------------- */
+
+static unsigned str_len(const char *str) {
+  unsigned index;
+  
+  index = 0;
+  while (str[index] != '\0') {
+    index++;
+  } /* end while */
+  return index;
+} /* end str_len */
+
+
+/* --------------------------------------------------------------------------
+ * function print_usage()
+ * --------------------------------------------------------------------------
+ * Prints usage info to the console.
+ * ----------------------------------------------------------------------- */
+
+static void print_usage (void) {
+  printf("usage info:\n\n");
+  printf("gen-resync-sets option\n\n");
+  printf("options:\n\n");
+  printf("-h prints this info.\n");
+  printf("-s prints resync set literals.\n\n");
+  printf("examples:\n\n");
+  printf("$ gen-resync-sets -s > m2c-resync-set-literals.h\n\n");
+} /* end print_usage */
+
+
+/* --------------------------------------------------------------------------
+ * function print_error()
+ * --------------------------------------------------------------------------
+ * Prints error message to stderr.
+ * ----------------------------------------------------------------------- */
+
+static void print_error (const char *msg) {
+  fprintf(stderr, "%s\n\n", msg);
+} /* end print_error */
+
+
+/* --------------------------------------------------------------------------
+ * utility program gen-resync-sets
+ * --------------------------------------------------------------------------
+ * This utility prints the resync sets of resync-data.h as set literals to
+ * the console,  each the union of a token and FIRST and FOLLOW sets of the
+ * grammar in production-data.h,  so that the parser resynchronises on
+ * constant sets and never computes a union at runtime.  It should be
+ * invoked with output redirection as follows:
+ *
+ * $ gen-resync-sets -s > m2c-resync-set-literals.h
+ * ----------------------------------------------------------------------- */
+
+#define SUCCESS_RETURN_CODE 0
+#define ERROR_RETURN_CODE (-1)
+
+int main(int argc, const char *argv[]) {
+  const char *argstr;
+  unsigned len;
+  
+  if (argc != 2) {
+    print_error("invalid number of arguments");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  argstr = argv[1];
+  len = str_len(argstr);
+  
+  if ((len == 2) && (argstr[0] == '-')) {
+    switch (argstr[1]) {
+      case 'h' :
+        print_usage();
+        break;
+      case 's' :
+        print_set_literals();
+        break;
+      default :
+        print_error("invalid argument");
+        print_usage();
+        return ERROR_RETURN_CODE;
+    } /* end switch */
+  }
+  else /* invalid args */ {
+    print_error("invalid argument");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  return SUCCESS_RETURN_CODE;
+} /* end main */
+
+/* END OF FILE */
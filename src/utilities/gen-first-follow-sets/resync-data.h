@@ -0,0 +1,83 @@
+/* Modula-2 R10 parser resynchronisation set database */
+
+/* #define RESYNC(_allcaps, _token, _first, _follow) */
+
+/* Each resync set is the union of token _token,  the FIRST set of production
+ * _first  and the FOLLOW set of production _follow.  A token of 0 or a
+ * production of NONE contributes nothing.  The name of a set reflects its
+ * composition,  eg. SEMICOLON_OR_FOLLOW_STATEMENT. */
+
+RESYNC(COLON_OR_FIRST_NON_ATTR_FORMAL_TYPE,
+  TOKEN_COLON, NON_ATTR_FORMAL_TYPE, NONE)
+RESYNC(COMMA_OR_FIRST_EXPRESSION,
+  TOKEN_COMMA, EXPRESSION, NONE)
+RESYNC(COMMA_OR_FOLLOW_IDENT_LIST,
+  TOKEN_COMMA, NONE, IDENT_LIST)
+RESYNC(DOT_DOT_OR_FIRST_EXPRESSION,
+  TOKEN_DOT_DOT, EXPRESSION, NONE)
+RESYNC(DO_OR_FIRST_ITERABLE_EXPR,
+  TOKEN_DO, ITERABLE_EXPR, NONE)
+RESYNC(DO_OR_FIRST_STATEMENT_SEQUENCE,
+  TOKEN_DO, STATEMENT_SEQUENCE, NONE)
+RESYNC(END_OR_FIRST_STATEMENT_SEQUENCE,
+  TOKEN_END, STATEMENT_SEQUENCE, NONE)
+RESYNC(END_OR_FOLLOW_FOR_STATEMENT,
+  TOKEN_END, NONE, FOR_STATEMENT)
+RESYNC(END_OR_FOLLOW_LOOP_STATEMENT,
+  TOKEN_END, NONE, LOOP_STATEMENT)
+RESYNC(END_OR_FOLLOW_STATEMENT,
+  TOKEN_END, NONE, STATEMENT)
+RESYNC(END_OR_FOLLOW_WHILE_STATEMENT,
+  TOKEN_END, NONE, WHILE_STATEMENT)
+RESYNC(EQUAL_OR_FIRST_EXPRESSION,
+  TOKEN_EQUAL, EXPRESSION, NONE)
+RESYNC(FIRST_EXPRESSION_OR_FOLLOW_CONST_DEFINITION,
+  0, EXPRESSION, CONST_DEFINITION)
+RESYNC(IDENT_OR_FOLLOW_ARRAY_TYPE,
+  TOKEN_IDENT, NONE, ARRAY_TYPE)
+RESYNC(IDENT_OR_FOLLOW_CONST_DEFINITION,
+  TOKEN_IDENT, NONE, CONST_DEFINITION)
+RESYNC(IDENT_OR_FOLLOW_DEFINITION,
+  TOKEN_IDENT, NONE, DEFINITION)
+RESYNC(IDENT_OR_FOLLOW_POINTER_TYPE,
+  TOKEN_IDENT, NONE, POINTER_TYPE)
+RESYNC(IDENT_OR_FOLLOW_PROCEDURE_SIGNATURE,
+  TOKEN_IDENT, NONE, PROCEDURE_SIGNATURE)
+RESYNC(IDENT_OR_FOLLOW_SET_TYPE,
+  TOKEN_IDENT, NONE, SET_TYPE)
+RESYNC(IDENT_OR_FOLLOW_SIMPLE_FORMAL_TYPE,
+  TOKEN_IDENT, NONE, SIMPLE_FORMAL_TYPE)
+RESYNC(IDENT_OR_FOLLOW_SUBRANGE_TYPE,
+  TOKEN_IDENT, NONE, SUBRANGE_TYPE)
+RESYNC(IMPORT_OR_FOLLOW_IMPORT,
+  TOKEN_IMPORT, NONE, IMPORT)
+RESYNC(LBRACKET_OR_FOLLOW_ITERABLE_EXPR,
+  TOKEN_LBRACKET, NONE, ITERABLE_EXPR)
+RESYNC(RBRACKET_OR_FIRST_PROCEDURE_SIGNATURE,
+  TOKEN_RBRACKET, PROCEDURE_SIGNATURE, NONE)
+RESYNC(RBRACKET_OR_FOLLOW_TYPE_DEFINITION,
+  TOKEN_RBRACKET, NONE, TYPE_DEFINITION)
+RESYNC(RBRACKET_OR_FOLLOW_VALUE_RANGE,
+  TOKEN_RBRACKET, NONE, VALUE_RANGE)
+RESYNC(RPAREN_OR_FIRST_FIELD_LIST,
+  TOKEN_RPAREN, FIELD_LIST, NONE)
+RESYNC(RPAREN_OR_FOLLOW_ENUM_TYPE,
+  TOKEN_RPAREN, NONE, ENUM_TYPE)
+RESYNC(RPAREN_OR_FOLLOW_OUTPUT_ARGS,
+  TOKEN_RPAREN, NONE, OUTPUT_ARGS)
+RESYNC(SEMICOLON_OR_FIRST_IMPORT,
+  TOKEN_SEMICOLON, IMPORT, NONE)
+RESYNC(SEMICOLON_OR_FOLLOW_FORMAL_PARAMS,
+  TOKEN_SEMICOLON, NONE, FORMAL_PARAMS)
+RESYNC(SEMICOLON_OR_FOLLOW_IMPORT,
+  TOKEN_SEMICOLON, NONE, IMPORT)
+RESYNC(SEMICOLON_OR_FOLLOW_STATEMENT,
+  TOKEN_SEMICOLON, NONE, STATEMENT)
+RESYNC(SEMICOLON_OR_FOLLOW_TYPE_DEFINITION,
+  TOKEN_SEMICOLON, NONE, TYPE_DEFINITION)
+RESYNC(THEN_OR_FIRST_STATEMENT,
+  TOKEN_THEN, STATEMENT, NONE)
+RESYNC(UNTIL_OR_FIRST_EXPRESSION,
+  TOKEN_UNTIL, EXPRESSION, NONE)
+
+/* END OF FILE */
@@ -0,0 +1,527 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * gen-ident-hash.c                                                          *
+ *                                                                           *
+ * Generates a minimal perfect hash table over reserved words, predefined    *
+ * identifiers, bindable identifiers and Schroedinger's tokens.              *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "hash.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * hash parameters, must match imp/m2c-ident-class.c
+ * ----------------------------------------------------------------------- */
+
+#define IDENT_HASH_MIX(_key, _seed) \
+  ((uint32_t)(((_key) ^ (_seed)) * 0x9E3779B1u))
+
+#define IDENT_HASH_SLOT(_mixed, _disp, _bits) \
+  ((uint32_t)((((_mixed) ^ (_disp)) * 0x85EBCA6Bu)) >> (32 - (_bits)))
+
+#define MAX_SEED_TRIALS 1000
+#define MAX_DISPLACEMENT 0xFFFF
+
+
+/* --------------------------------------------------------------------------
+ * entry table
+ * ----------------------------------------------------------------------- */
+
+#define MAX_ENTRIES 256
+
+typedef struct {
+  const char *lexstr;
+  const char *token;
+  const char *predef;
+  const char *bindable;
+  const char *schroed;
+  unsigned classes;
+  uint32_t key;
+} entry_t;
+
+static entry_t entry[MAX_ENTRIES];
+static unsigned entry_count = 0;
+
+
+/* --------------------------------------------------------------------------
+ * function entry_for_lexeme(lexstr)
+ * --------------------------------------------------------------------------
+ * Returns the entry for lexstr, adding a new entry if there is none yet.
+ * ----------------------------------------------------------------------- */
+
+static entry_t *entry_for_lexeme (const char *lexstr) {
+  unsigned index;
+  entry_t *new_entry;
+  
+  for (index = 0; index < entry_count; index++) {
+    if (strcmp(entry[index].lexstr, lexstr) == 0) {
+      return &entry[index];
+    } /* end if */
+  } /* end for */
+  
+  new_entry = &entry[entry_count];
+  entry_count++;
+  
+  new_entry->lexstr = lexstr;
+  new_entry->token = "TOKEN_UNKNOWN";
+  new_entry->predef = "PREDEF_INVALID";
+  new_entry->bindable = "BINDABLE_INVALID";
+  new_entry->schroed = "SCHROED_INVALID";
+  new_entry->classes = 0;
+  
+  return new_entry;
+} /* end entry_for_lexeme */
+
+
+/* --------------------------------------------------------------------------
+ * function init_entry_table()
+ * --------------------------------------------------------------------------
+ * Initialises the entry table from ident-data.h and calculates hash keys.
+ * ----------------------------------------------------------------------- */
+
+static void init_entry_table (void) {
+  unsigned index;
+  const char *ch;
+  uint32_t key;
+  
+  #define RESWORD(_name) \
+    entry_for_lexeme(#_name)->token = "TOKEN_" #_name; \
+    entry_for_lexeme(#_name)->classes |= 0x01;
+  
+  #define PREDEF(_name) \
+    entry_for_lexeme(#_name)->predef = "PREDEF_" #_name; \
+    entry_for_lexeme(#_name)->classes |= 0x02;
+  
+  #define BINDABLE(_name) \
+    entry_for_lexeme(#_name)->bindable = "BINDABLE_" #_name; \
+    entry_for_lexeme(#_name)->classes |= 0x04;
+  
+  #define SCHROED(_name) \
+    entry_for_lexeme(#_name)->schroed = "SCHROED_" #_name; \
+    entry_for_lexeme(#_name)->classes |= 0x08;
+  
+  #include "ident-data.h"
+  
+  #undef RESWORD
+  #undef PREDEF
+  #undef BINDABLE
+  #undef SCHROED
+  
+  for (index = 0; index < entry_count; index++) {
+    key = HASH_INITIAL;
+    for (ch = entry[index].lexstr; *ch != '\0'; ch++) {
+      key = HASH_NEXT_CHAR(key, (uint32_t) *ch);
+    } /* end for */
+    entry[index].key = HASH_FINAL(key);
+  } /* end for */
+} /* end init_entry_table */
+
+
+/* --------------------------------------------------------------------------
+ * hash table
+ * ----------------------------------------------------------------------- */
+
+static unsigned slot_bits, bucket_bits;
+static uint32_t seed;
+
+static uint16_t displacement[MAX_ENTRIES];
+static int slot_entry[2 * MAX_ENTRIES];
+
+static unsigned bucket_size[MAX_ENTRIES];
+static unsigned bucket_member[MAX_ENTRIES][MAX_ENTRIES];
+
+
+/* --------------------------------------------------------------------------
+ * function log2_ceil(n)
+ * ----------------------------------------------------------------------- */
+
+static unsigned log2_ceil (unsigned n) {
+  unsigned bits = 0;
+  
+  while ((1u << bits) < n) {
+    bits++;
+  } /* end while */
+  return bits;
+} /* end log2_ceil */
+
+
+/* --------------------------------------------------------------------------
+ * function try_displacement(bucket, disp)
+ * --------------------------------------------------------------------------
+ * Returns true and occupies the slots  if all members of bucket map to free
+ * and distinct slots using displacement disp,  otherwise returns false.
+ * ----------------------------------------------------------------------- */
+
+static bool try_displacement (unsigned bucket, uint32_t disp) {
+  unsigned index, other, member;
+  uint32_t slot[MAX_ENTRIES];
+  
+  for (index = 0; index < bucket_size[bucket]; index++) {
+    member = bucket_member[bucket][index];
+    slot[index] = IDENT_HASH_SLOT
+      (IDENT_HASH_MIX(entry[member].key, seed), disp, slot_bits);
+    
+    if (slot_entry[slot[index]] >= 0) {
+      return false;
+    } /* end if */
+    
+    for (other = 0; other < index; other++) {
+      if (slot[other] == slot[index]) {
+        return false;
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  for (index = 0; index < bucket_size[bucket]; index++) {
+    slot_entry[slot[index]] = (int) bucket_member[bucket][index];
+  } /* end for */
+  
+  return true;
+} /* end try_displacement */
+
+
+/* --------------------------------------------------------------------------
+ * function try_seed(trial_seed)
+ * --------------------------------------------------------------------------
+ * Attempts to build the hash table using trial_seed,  placing buckets with
+ * the most members first.  Returns true on success, otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool try_seed (uint32_t trial_seed) {
+  unsigned index, bucket, largest, bucket_count, slot_count;
+  uint32_t mixed, disp;
+  bool placed[MAX_ENTRIES];
+  
+  seed = trial_seed;
+  bucket_count = 1u << bucket_bits;
+  slot_count = 1u << slot_bits;
+  
+  for (index = 0; index < slot_count; index++) {
+    slot_entry[index] = -1;
+  } /* end for */
+  
+  for (bucket = 0; bucket < bucket_count; bucket++) {
+    bucket_size[bucket] = 0;
+    displacement[bucket] = 0;
+    placed[bucket] = false;
+  } /* end for */
+  
+  for (index = 0; index < entry_count; index++) {
+    mixed = IDENT_HASH_MIX(entry[index].key, seed);
+    bucket = mixed >> (32 - bucket_bits);
+    bucket_member[bucket][bucket_size[bucket]] = index;
+    bucket_size[bucket]++;
+  } /* end for */
+  
+  for (;;) {
+    /* find largest bucket not yet placed */
+    largest = bucket_count;
+    for (bucket = 0; bucket < bucket_count; bucket++) {
+      if ((placed[bucket] == false) && (bucket_size[bucket] > 0) &&
+          ((largest == bucket_count) ||
+           (bucket_size[bucket] > bucket_size[largest]))) {
+        largest = bucket;
+      } /* end if */
+    } /* end for */
+    
+    if (largest == bucket_count) {
+      return true;
+    } /* end if */
+    
+    for (disp = 0; disp <= MAX_DISPLACEMENT; disp++) {
+      if (try_displacement(largest, disp)) {
+        break;
+      } /* end if */
+    } /* end for */
+    
+    if (disp > MAX_DISPLACEMENT) {
+      return false;
+    } /* end if */
+    
+    displacement[largest] = (uint16_t) disp;
+    placed[largest] = true;
+  } /* end for */
+} /* end try_seed */
+
+
+/* --------------------------------------------------------------------------
+ * function print_table()
+ * --------------------------------------------------------------------------
+ * Calculates the perfect hash and prints the resulting tables to stdout.
+ * ----------------------------------------------------------------------- */
+
+#define PREAMBLE \
+  "/* AUTO-GENERATED by utility gen-ident-hash * DO NOT EDIT! */\n\n"
+
+#define EOF_MARKER \
+  "/* END OF FILE */\n"
+
+static void print_lexeme_table (void);
+
+static void print_tag_table
+  (const char *name, const char *size, unsigned class);
+
+static bool print_table (void) {
+  unsigned index, trial;
+  const entry_t *this_entry;
+  
+  init_entry_table();
+  
+  bucket_bits = log2_ceil((entry_count + 1) / 2);
+  slot_bits = log2_ceil(entry_count);
+  
+  for (trial = 0; trial < MAX_SEED_TRIALS; trial++) {
+    if (try_seed(0x5BD1E995u * (trial + 1))) {
+      break;
+    } /* end if */
+  } /* end for */
+  
+  if (trial == MAX_SEED_TRIALS) {
+    return false;
+  } /* end if */
+  
+  printf(PREAMBLE);
+  
+  printf("#define IDENT_HASH_ENTRY_COUNT %u\n", entry_count);
+  printf("#define IDENT_HASH_SEED 0x%08Xu\n", seed);
+  printf("#define IDENT_HASH_BUCKET_BITS %u\n", bucket_bits);
+  printf("#define IDENT_HASH_SLOT_BITS %u\n\n", slot_bits);
+  
+  printf("static const uint16_t ident_hash_displacement[] = {");
+  for (index = 0; index < (1u << bucket_bits); index++) {
+    printf("%s%s0x%04X", (index == 0) ? "" : ",",
+      ((index % 8) == 0) ? "\n  " : " ", displacement[index]);
+  } /* end for */
+  printf("\n}; /* ident_hash_displacement */\n\n");
+  
+  printf("static const m2c_ident_info_t ident_hash_table[] = {\n");
+  for (index = 0; index < (1u << slot_bits); index++) {
+    if (slot_entry[index] < 0) {
+      printf("  /* %3u */ { NULL, 0, 0x00, TOKEN_UNKNOWN,\n"
+        "              PREDEF_INVALID, BINDABLE_INVALID, SCHROED_INVALID }",
+        index);
+    }
+    else {
+      this_entry = &entry[slot_entry[index]];
+      printf("  /* %3u */ { \"%s\", %u, 0x%02X, %s,\n"
+        "              %s, %s, %s }",
+        index, this_entry->lexstr, (unsigned) strlen(this_entry->lexstr),
+        this_entry->classes, this_entry->token, this_entry->predef,
+        this_entry->bindable, this_entry->schroed);
+    } /* end if */
+    printf("%s\n", (index + 1 < (1u << slot_bits)) ? "," : "");
+  } /* end for */
+  printf("}; /* ident_hash_table */\n\n");
+  
+  print_lexeme_table();
+  
+  print_tag_table("ident_resword_tag",
+    "LAST_RESWORD_TOKEN + 1", 0x01);
+  print_tag_table("ident_predef_tag", "PREDEF_END_MARK", 0x02);
+  print_tag_table("ident_bindable_tag", "BINDABLE_END_MARK", 0x04);
+  
+  printf(EOF_MARKER);
+  return true;
+} /* end print_table */
+
+
+/* --------------------------------------------------------------------------
+ * function print_lexeme_table()
+ * --------------------------------------------------------------------------
+ * Prints a table of static interned strings in slot order,  one for the
+ * lexeme in each slot, followed by a static interned empty string.  Their
+ * tags are those the classifier assigns, their keys those of hash.h.
+ * ----------------------------------------------------------------------- */
+
+static void print_lexeme_table (void) {
+  unsigned index;
+  const entry_t *this_entry;
+  
+  printf("static intstr_static_t ident_lexeme_table[] = {\n");
+  for (index = 0; index < (1u << slot_bits); index++) {
+    if (slot_entry[index] < 0) {
+      printf("  /* %3u */ INTSTR_STATIC_INIT(0x00000000u, 0, 0, \"\")",
+        index);
+    }
+    else {
+      this_entry = &entry[slot_entry[index]];
+      printf("  /* %3u */ INTSTR_STATIC_INIT(0x%08Xu, %u, %u, \"%s\")",
+        index, this_entry->key, (unsigned) strlen(this_entry->lexstr),
+        index + 1, this_entry->lexstr);
+    } /* end if */
+    printf("%s\n", (index + 1 < (1u << slot_bits)) ? "," : "");
+  } /* end for */
+  printf("}; /* ident_lexeme_table */\n\n");
+  
+  printf("static intstr_static_t ident_empty_lexeme =\n"
+    "  INTSTR_STATIC_INIT(0x%08Xu, 0, 0, \"\");\n\n",
+    HASH_FINAL(HASH_INITIAL));
+} /* end print_lexeme_table */
+
+
+/* --------------------------------------------------------------------------
+ * function print_tag_table(name, size, class)
+ * --------------------------------------------------------------------------
+ * Prints a table of size entries  that maps the enumerated value of each
+ * member of class to the tag of its slot.  Values of non-members map to 0.
+ * ----------------------------------------------------------------------- */
+
+static void print_tag_table
+  (const char *name, const char *size, unsigned class) {
+  
+  unsigned index;
+  const char *value;
+  bool first;
+  
+  printf("static const uint8_t %s[%s] = {", name, size);
+  first = true;
+  for (index = 0; index < (1u << slot_bits); index++) {
+    if ((slot_entry[index] < 0) ||
+        ((entry[slot_entry[index]].classes & class) == 0)) {
+      continue;
+    } /* end if */
+    
+    switch (class) {
+      case 0x01 :
+        value = entry[slot_entry[index]].token;
+        break;
+      case 0x02 :
+        value = entry[slot_entry[index]].predef;
+        break;
+      default :
+        value = entry[slot_entry[index]].bindable;
+        break;
+    } /* end switch */
+    
+    printf("%s\n  [%s] = %u", first ? "" : ",", value, index + 1);
+    first = false;
+  } /* end for */
+  printf("\n}; /* %s */\n\n", name);
+} /* end print_tag_table */
+
+
+/* --------------------------------------------------------------------------
+ * function print_usage()
+ * --------------------------------------------------------------------------
+ * Prints usage info to the console.
+ * ----------------------------------------------------------------------- */
+
+static void print_usage (void) {
+  printf("usage info:\n\n");
+  printf("gen-ident-hash option\n\n");
+  printf("options:\n\n");
+  printf("-h prints this info.\n");
+  printf("-t prints the perfect hash table.\n\n");
+  printf("examples:\n\n");
+  printf("$ gen-ident-hash -t > ../../imp/m2c-ident-hash-table.h\n\n");
+} /* end print_usage */
+
+
+/* --------------------------------------------------------------------------
+ * function print_error()
+ * --------------------------------------------------------------------------
+ * Prints error message to stderr.
+ * ----------------------------------------------------------------------- */
+
+static void print_error (const char *msg) {
+  fprintf(stderr, "%s\n\n", msg);
+} /* end print_error */
+
+
+/* --------------------------------------------------------------------------
+ * utility program gen-ident-hash
+ * --------------------------------------------------------------------------
+ * This utility prints a minimal perfect hash table over the reserved words,
+ * predefined identifiers,  bindable identifiers  and  Schroedinger's tokens
+ * listed in ident-data.h to the console.  It should be invoked with output
+ * redirection as follows:
+ *
+ * $ gen-ident-hash -t > ../../imp/m2c-ident-hash-table.h
+ *
+ * The table must be regenerated whenever ident-data.h, the enumerations it
+ * refers to, or the hash function in hash.h are changed.
+ * ----------------------------------------------------------------------- */
+
+#define SUCCESS_RETURN_CODE 0
+#define ERROR_RETURN_CODE (-1)
+
+int main(int argc, const char *argv[]) {
+  const char *argstr;
+  
+  if (argc != 2) {
+    print_error("invalid number of arguments");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  argstr = argv[1];
+  
+  if ((strlen(argstr) == 2) && (argstr[0] == '-')) {
+    switch (argstr[1]) {
+      case 'h' :
+        print_usage();
+        break;
+      case 't' :
+        if (print_table() == false) {
+          print_error("no perfect hash found, increase MAX_SEED_TRIALS");
+          return ERROR_RETURN_CODE;
+        } /* end if */
+        break;
+      default :
+        print_error("invalid argument");
+        print_usage();
+        return ERROR_RETURN_CODE;
+    } /* end switch */
+  }
+  else /* invalid args */ {
+    print_error("invalid argument");
+    print_usage();
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  return SUCCESS_RETURN_CODE;
+} /* end main */
+
+
+/* END OF FILE */
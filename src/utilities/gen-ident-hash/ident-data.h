@@ -0,0 +1,197 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * ident-data.h                                                              *
+ *                                                                           *
+ * Reserved word, predefined identifier, bindable and Schroedinger data      *
+ * for the perfect hash generator.                                           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * Each entry has the form CLASS(name) where CLASS is one of RESWORD, PREDEF,
+ * BINDABLE and SCHROED,  and name is both the lexeme and the suffix  of the
+ * corresponding enumerated value  in m2c_token_t,  m2c_predef_t,  m2c_bind-
+ * able_t or m2c_schroed_t.  A lexeme may appear in more than one class.
+ * ----------------------------------------------------------------------- */
+
+/* Reserved Words */
+
+RESWORD(ALIAS)
+RESWORD(AND)
+RESWORD(ARGLIST)
+RESWORD(ARRAY)
+RESWORD(BEGIN)
+RESWORD(CASE)
+RESWORD(CONST)
+RESWORD(COPY)
+RESWORD(DIV)
+RESWORD(DO)
+RESWORD(ELSE)
+RESWORD(ELSIF)
+RESWORD(END)
+RESWORD(EXIT)
+RESWORD(FOR)
+RESWORD(IF)
+RESWORD(IMPLEMENTATION)
+RESWORD(IMPORT)
+RESWORD(IN)
+RESWORD(INTERFACE)
+RESWORD(LOOP)
+RESWORD(MOD)
+RESWORD(MODULE)
+RESWORD(NEW)
+RESWORD(NOP)
+RESWORD(NOT)
+RESWORD(OCTETSEQ)
+RESWORD(OF)
+RESWORD(OPAQUE)
+RESWORD(OR)
+RESWORD(POINTER)
+RESWORD(PROCEDURE)
+RESWORD(READ)
+RESWORD(RECORD)
+RESWORD(RELEASE)
+RESWORD(REPEAT)
+RESWORD(RETAIN)
+RESWORD(RETURN)
+RESWORD(SET)
+RESWORD(THEN)
+RESWORD(TO)
+RESWORD(TYPE)
+RESWORD(UNQUALIFIED)
+RESWORD(UNTIL)
+RESWORD(VAR)
+RESWORD(WHILE)
+RESWORD(WRITE)
+
+/* Predefined Identifiers */
+
+PREDEF(TRUE)
+PREDEF(FALSE)
+PREDEF(NIL)
+PREDEF(ARCH)
+PREDEF(BOOLEAN)
+PREDEF(CHAR)
+PREDEF(UNICHAR)
+PREDEF(OCTET)
+PREDEF(CARDINAL)
+PREDEF(INTEGER)
+PREDEF(LONGCARD)
+PREDEF(LONGINT)
+PREDEF(REAL)
+PREDEF(LONGREAL)
+PREDEF(BYTE)
+PREDEF(WORD)
+PREDEF(LONGWORD)
+PREDEF(ADDRESS)
+PREDEF(REGISTER)
+PREDEF(APPEND)
+PREDEF(INSERT)
+PREDEF(REMOVE)
+PREDEF(HALT)
+PREDEF(CODE)
+PREDEF(GETREG)
+PREDEF(SETREG)
+PREDEF(CHR)
+PREDEF(UCHR)
+PREDEF(COLLATION)
+PREDEF(ORD)
+PREDEF(ODD)
+PREDEF(ABS)
+PREDEF(SGN)
+PREDEF(MIN)
+PREDEF(MAX)
+PREDEF(LOG2)
+PREDEF(POW2)
+PREDEF(ENTIER)
+PREDEF(PRED)
+PREDEF(SUCC)
+PREDEF(PTR)
+PREDEF(CAPACITY)
+PREDEF(COUNT)
+PREDEF(LENGTH)
+PREDEF(FIRST)
+PREDEF(LAST)
+PREDEF(PREV)
+PREDEF(NEXT)
+PREDEF(CAST)
+PREDEF(TMIN)
+PREDEF(TMAX)
+PREDEF(TSIZE)
+PREDEF(TLIMIT)
+PREDEF(VALUE)
+PREDEF(ATVALUE)
+PREDEF(STORE)
+PREDEF(ATSTORE)
+PREDEF(ATINSERT)
+PREDEF(ATREMOVE)
+PREDEF(ALLOC)
+PREDEF(DEALLOC)
+PREDEF(STDIN)
+PREDEF(STDOUT)
+PREDEF(UNSAFE)
+PREDEF(ATOMIC)
+PREDEF(ASSEMBLER)
+
+/* Bindable Identifiers */
+
+BINDABLE(COLLATION)
+BINDABLE(TLIMIT)
+BINDABLE(ALLOC)
+BINDABLE(APPEND)
+BINDABLE(ATINSERT)
+BINDABLE(ATREMOVE)
+BINDABLE(ATSTORE)
+BINDABLE(ATVALUE)
+BINDABLE(COUNT)
+BINDABLE(DEALLOC)
+BINDABLE(FIRST)
+BINDABLE(LAST)
+BINDABLE(LENGTH)
+BINDABLE(NEXT)
+BINDABLE(PREV)
+BINDABLE(REMOVE)
+BINDABLE(STDIN)
+BINDABLE(STDOUT)
+BINDABLE(STORE)
+BINDABLE(VALUE)
+
+/* Schroedinger's Tokens */
+
+SCHROED(ADDRESS)
+SCHROED(CAPACITY)
+SCHROED(CAST)
+SCHROED(NIL)
+
+/* END OF FILE */
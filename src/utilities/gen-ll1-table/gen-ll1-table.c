@@ -0,0 +1,595 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * gen-ll1-table.c                                                           *
+ *                                                                           *
+ * Utility program to generate the LL(1) parse table database.               *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-token.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * grammar limits
+ * ----------------------------------------------------------------------- */
+
+#define MAX_RHS_LENGTH 12
+#define MAX_NONTERMINALS 256
+#define MAX_RULES 1024
+
+
+/* --------------------------------------------------------------------------
+ * type symbol_t
+ * --------------------------------------------------------------------------
+ * Terminal or non-terminal symbol on the right hand side of a rule.  A NULL
+ * name marks the end of the right hand side.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* is_terminal */ bool is_terminal;
+  /* token */ m2c_token_t token;
+  /* name */ const char *name;
+} symbol_t;
+
+
+/* --------------------------------------------------------------------------
+ * type rule_t
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* lhs */ const char *lhs;
+  /* rhs */ symbol_t rhs[MAX_RHS_LENGTH + 1];
+} rule_t;
+
+
+/* --------------------------------------------------------------------------
+ * rule table from m2c-ll1-grammar.h
+ * ----------------------------------------------------------------------- */
+
+#define T(_token) { true, _token, #_token }
+#define N(_caps) { false, 0, #_caps }
+#define EMPTY { false, 0, NULL }
+#define RULE(_caps, ...) { #_caps, { __VA_ARGS__ } },
+
+static const rule_t rule[] = {
+  #include "m2c-ll1-grammar.h"
+  { NULL, { EMPTY } }
+}; /* rule */
+
+#undef RULE
+#undef EMPTY
+#undef N
+#undef T
+
+#define RULE_COUNT ((sizeof(rule) / sizeof(rule_t)) - 1)
+
+
+/* --------------------------------------------------------------------------
+ * grammar analysis tables
+ * ----------------------------------------------------------------------- */
+
+static const char *nonterminal_name[MAX_NONTERMINALS];
+static unsigned nonterminal_count;
+
+static unsigned rule_lhs[MAX_RULES];
+static unsigned rule_rhs_nt[MAX_RULES][MAX_RHS_LENGTH];
+static unsigned rule_length[MAX_RULES];
+
+static bool nullable[MAX_NONTERMINALS];
+static bool first_set[MAX_NONTERMINALS][TOKEN_END_MARK];
+static bool follow_set[MAX_NONTERMINALS][TOKEN_END_MARK];
+
+static unsigned table[MAX_NONTERMINALS][TOKEN_END_MARK];
+static unsigned conflict_count;
+
+
+/* --------------------------------------------------------------------------
+ * function nonterminal_index(name)
+ * --------------------------------------------------------------------------
+ * Returns the index of the non-terminal with the given name,  or
+ * MAX_NONTERMINALS if there is none.
+ * ----------------------------------------------------------------------- */
+
+static unsigned nonterminal_index (const char *name) {
+  unsigned index;
+  
+  index = 0;
+  while (index < nonterminal_count) {
+    if (strcmp(nonterminal_name[index], name) == 0) {
+      return index;
+    } /* end if */
+    index++;
+  } /* end while */
+  
+  return MAX_NONTERMINALS;
+} /* end nonterminal_index */
+
+
+/* --------------------------------------------------------------------------
+ * function init_symbol_tables()
+ * --------------------------------------------------------------------------
+ * Numbers the non-terminals in order of the first rule for each  and
+ * resolves the non-terminals on the right hand side of each rule.  Returns
+ * false and prints an error if a non-terminal has no rule or a limit is
+ * exceeded,  otherwise true.
+ * ----------------------------------------------------------------------- */
+
+static bool init_symbol_tables (void) {
+  unsigned index, pos, nt;
+  const symbol_t *sym;
+  
+  if (RULE_COUNT > MAX_RULES) {
+    fprintf(stderr, "too many rules, maximum is %u\n", MAX_RULES);
+    return false;
+  } /* end if */
+  
+  /* number left hand sides */
+  nonterminal_count = 0;
+  for (index = 0; index < RULE_COUNT; index++) {
+    nt = nonterminal_index(rule[index].lhs);
+    
+    if (nt == MAX_NONTERMINALS) {
+      if (nonterminal_count == MAX_NONTERMINALS) {
+        fprintf(stderr, "too many non-terminals, maximum is %u\n",
+          MAX_NONTERMINALS);
+        return false;
+      } /* end if */
+      
+      nt = nonterminal_count;
+      nonterminal_name[nt] = rule[index].lhs;
+      nonterminal_count++;
+    } /* end if */
+    
+    rule_lhs[index] = nt;
+  } /* end for */
+  
+  /* resolve right hand sides */
+  for (index = 0; index < RULE_COUNT; index++) {
+    pos = 0;
+    sym = rule[index].rhs;
+    
+    while (sym[pos].name != NULL) {
+      if (sym[pos].is_terminal == false) {
+        nt = nonterminal_index(sym[pos].name);
+        
+        if (nt == MAX_NONTERMINALS) {
+          fprintf(stderr, "no rule for non-terminal %s in rule of %s\n",
+            sym[pos].name, rule[index].lhs);
+          return false;
+        } /* end if */
+        
+        rule_rhs_nt[index][pos] = nt;
+      } /* end if */
+      pos++;
+    } /* end while */
+    
+    rule_length[index] = pos;
+  } /* end for */
+  
+  return true;
+} /* end init_symbol_tables */
+
+
+/* --------------------------------------------------------------------------
+ * function add_set(target, source)
+ * --------------------------------------------------------------------------
+ * Adds the elements of source to target.  Returns true if target changed.
+ * ----------------------------------------------------------------------- */
+
+static bool add_set (bool *target, const bool *source) {
+  unsigned token;
+  bool changed;
+  
+  changed = false;
+  for (token = 0; token < TOKEN_END_MARK; token++) {
+    if (source[token] && (target[token] == false)) {
+      target[token] = true;
+      changed = true;
+    } /* end if */
+  } /* end for */
+  
+  return changed;
+} /* end add_set */
+
+
+/* --------------------------------------------------------------------------
+ * function add_token(target, token)
+ * --------------------------------------------------------------------------
+ * Adds token to target.  Returns true if target changed.
+ * ----------------------------------------------------------------------- */
+
+static bool add_token (bool *target, m2c_token_t token) {
+  
+  if (target[token]) {
+    return false;
+  } /* end if */
+  
+  target[token] = true;
+  return true;
+} /* end add_token */
+
+
+/* --------------------------------------------------------------------------
+ * function add_first_of_suffix(target, index, pos)
+ * --------------------------------------------------------------------------
+ * Adds the FIRST set of the right hand side of rule index from position pos
+ * onwards to target.  Returns true if the suffix is nullable.  If changed
+ * is not NULL,  sets it to true if target changed.
+ * ----------------------------------------------------------------------- */
+
+static bool add_first_of_suffix
+  (bool *target, unsigned index, unsigned pos, bool *changed) {
+  const symbol_t *sym;
+  unsigned nt;
+  bool grew;
+  
+  sym = rule[index].rhs;
+  
+  while (pos < rule_length[index]) {
+    if (sym[pos].is_terminal) {
+      grew = add_token(target, sym[pos].token);
+      if ((changed != NULL) && grew) {
+        *changed = true;
+      } /* end if */
+      return false;
+    } /* end if */
+    
+    nt = rule_rhs_nt[index][pos];
+    grew = add_set(target, first_set[nt]);
+    if ((changed != NULL) && grew) {
+      *changed = true;
+    } /* end if */
+    
+    if (nullable[nt] == false) {
+      return false;
+    } /* end if */
+    
+    pos++;
+  } /* end while */
+  
+  return true;
+} /* end add_first_of_suffix */
+
+
+/* --------------------------------------------------------------------------
+ * procedure compute_first_sets()
+ * --------------------------------------------------------------------------
+ * Computes nullability and FIRST sets of all non-terminals by iteration to
+ * a fixpoint.
+ * ----------------------------------------------------------------------- */
+
+static void compute_first_sets (void) {
+  unsigned index, nt;
+  bool changed;
+  
+  changed = true;
+  while (changed) {
+    changed = false;
+    
+    for (index = 0; index < RULE_COUNT; index++) {
+      nt = rule_lhs[index];
+      
+      if (add_first_of_suffix(first_set[nt], index, 0, &changed)) {
+        if (nullable[nt] == false) {
+          nullable[nt] = true;
+          changed = true;
+        } /* end if */
+      } /* end if */
+    } /* end for */
+  } /* end while */
+} /* end compute_first_sets */
+
+
+/* --------------------------------------------------------------------------
+ * procedure compute_follow_sets()
+ * --------------------------------------------------------------------------
+ * Computes the FOLLOW sets of all non-terminals by iteration to a fixpoint.
+ * The start symbol is followed by end of file.
+ * ----------------------------------------------------------------------- */
+
+static void compute_follow_sets (void) {
+  unsigned index, pos, nt;
+  bool changed;
+  
+  follow_set[0][TOKEN_EOF] = true;
+  
+  changed = true;
+  while (changed) {
+    changed = false;
+    
+    for (index = 0; index < RULE_COUNT; index++) {
+      for (pos = 0; pos < rule_length[index]; pos++) {
+        if (rule[index].rhs[pos].is_terminal) {
+          continue;
+        } /* end if */
+        
+        nt = rule_rhs_nt[index][pos];
+        
+        if (add_first_of_suffix(follow_set[nt], index, pos + 1, &changed)) {
+          if (add_set(follow_set[nt], follow_set[rule_lhs[index]])) {
+            changed = true;
+          } /* end if */
+        } /* end if */
+      } /* end for */
+    } /* end for */
+  } /* end while */
+} /* end compute_follow_sets */
+
+
+/* --------------------------------------------------------------------------
+ * procedure enter_rule(nt, token, index)
+ * --------------------------------------------------------------------------
+ * Enters rule index into the table entry of nt and token.  On a conflict,
+ * prints a warning  and keeps the earlier rule  unless it is the empty
+ * alternative,  which loses to any other.  This matches the greedy choice
+ * of the recursive descent parser.
+ * ----------------------------------------------------------------------- */
+
+static void enter_rule (unsigned nt, m2c_token_t token, unsigned index) {
+  unsigned prior;
+  
+  if (table[nt][token] == 0) {
+    table[nt][token] = index + 1;
+    return;
+  } /* end if */
+  
+  prior = table[nt][token] - 1;
+  
+  if (prior == index) {
+    return;
+  } /* end if */
+  
+  conflict_count++;
+  fprintf(stderr, "conflict in %s on %s between rules %u and %u",
+    nonterminal_name[nt], m2c_name_for_token(token), prior, index);
+  
+  if ((rule_length[prior] == 0) && (rule_length[index] != 0)) {
+    table[nt][token] = index + 1;
+    prior = index;
+  } /* end if */
+  
+  fprintf(stderr, ", resolved for rule %u\n", prior);
+} /* end enter_rule */
+
+
+/* --------------------------------------------------------------------------
+ * procedure compute_table()
+ * --------------------------------------------------------------------------
+ * Fills the parse table.  An entry holds the index of the rule to expand
+ * plus one,  or zero if the token is not expected.
+ * ----------------------------------------------------------------------- */
+
+static void compute_table (void) {
+  bool rhs_first[TOKEN_END_MARK];
+  unsigned index, nt, token;
+  bool rhs_nullable;
+  
+  for (index = 0; index < RULE_COUNT; index++) {
+    nt = rule_lhs[index];
+    
+    memset(rhs_first, 0, sizeof(rhs_first));
+    rhs_nullable = add_first_of_suffix(rhs_first, index, 0, NULL);
+    
+    for (token = 0; token < TOKEN_END_MARK; token++) {
+      if (rhs_first[token] ||
+          (rhs_nullable && follow_set[nt][token])) {
+        enter_rule(nt, token, index);
+      } /* end if */
+    } /* end for */
+  } /* end for */
+} /* end compute_table */
+
+
+/* --------------------------------------------------------------------------
+ * procedure print_set_literal(set)
+ * --------------------------------------------------------------------------
+ * Prints set as a tokenset literal with 32-bit segments.
+ * ----------------------------------------------------------------------- */
+
+#define SEGMENT_COUNT ((TOKEN_END_MARK / 32) + 1)
+
+static void print_set_literal (const bool *set) {
+  unsigned long segment;
+  unsigned seg_index, bit, count;
+  
+  count = 0;
+  printf("{ { ");
+  
+  for (seg_index = 0; seg_index < SEGMENT_COUNT; seg_index++) {
+    segment = 0;
+    for (bit = 0; bit < 32; bit++) {
+      if ((seg_index * 32 + bit < TOKEN_END_MARK) &&
+          set[seg_index * 32 + bit]) {
+        segment = segment | (1UL << bit);
+        count++;
+      } /* end if */
+    } /* end for */
+    
+    printf("0x%08lX%s", segment, (seg_index + 1 < SEGMENT_COUNT) ? ", " : "");
+  } /* end for */
+  
+  printf(" }, %u }", count);
+} /* end print_set_literal */
+
+
+/* --------------------------------------------------------------------------
+ * procedure print_tables()
+ * --------------------------------------------------------------------------
+ * Prints the non-terminal enumeration,  the right hand sides,  the parse
+ * table and the FIRST and FOLLOW sets of all non-terminals.
+ * ----------------------------------------------------------------------- */
+
+#define PREAMBLE \
+  "/* AUTO-GENERATED by utility gen-ll1-table * DO NOT EDIT! */\n\n"
+
+#define EOF_MARKER \
+  "\n/* END OF FILE */\n"
+
+static void print_tables (void) {
+  unsigned nt, index, pos, start, token;
+  const symbol_t *sym;
+  
+  printf(PREAMBLE);
+  
+  printf("#define LL1_NONTERMINAL_COUNT %u\n", nonterminal_count);
+  printf("#define LL1_RULE_COUNT %u\n", (unsigned) RULE_COUNT);
+  printf("#define LL1_NT(_caps) (TOKEN_END_MARK + LL1_ ## _caps)\n\n");
+  
+  /* non-terminal enumeration and names */
+  printf("typedef enum {\n");
+  for (nt = 0; nt < nonterminal_count; nt++) {
+    printf("  LL1_%s%s /* %u */\n", nonterminal_name[nt],
+      (nt + 1 < nonterminal_count) ? "," : "", nt);
+  } /* end for */
+  printf("} ll1_nonterminal_t;\n\n");
+  
+  printf("static const char *const "
+    "ll1_nonterminal_name[LL1_NONTERMINAL_COUNT] = {\n");
+  for (nt = 0; nt < nonterminal_count; nt++) {
+    printf("  \"%s\"%s\n", nonterminal_name[nt],
+      (nt + 1 < nonterminal_count) ? "," : "");
+  } /* end for */
+  printf("};\n\n");
+  
+  /* right hand sides */
+  printf("static const uint16_t ll1_rhs_symbol[] = {\n");
+  for (index = 0; index < RULE_COUNT; index++) {
+    printf("  /* %u: %s */", index, rule[index].lhs);
+    sym = rule[index].rhs;
+    for (pos = 0; pos < rule_length[index]; pos++) {
+      if (sym[pos].is_terminal) {
+        printf("\n    %s,", sym[pos].name);
+      }
+      else /* non-terminal */ {
+        printf("\n    LL1_NT(%s),", sym[pos].name);
+      } /* end if */
+    } /* end for */
+    printf("\n");
+  } /* end for */
+  printf("  0 /* sentinel */\n};\n\n");
+  
+  printf("static const uint16_t ll1_rule_start[LL1_RULE_COUNT] = {");
+  start = 0;
+  for (index = 0; index < RULE_COUNT; index++) {
+    printf("%s%u%s", (index % 12 == 0) ? "\n  " : " ", start,
+      (index + 1 < RULE_COUNT) ? "," : "");
+    start = start + rule_length[index];
+  } /* end for */
+  printf("\n};\n\n");
+  
+  printf("static const uint8_t ll1_rule_length[LL1_RULE_COUNT] = {");
+  for (index = 0; index < RULE_COUNT; index++) {
+    printf("%s%u%s", (index % 16 == 0) ? "\n  " : " ", rule_length[index],
+      (index + 1 < RULE_COUNT) ? "," : "");
+  } /* end for */
+  printf("\n};\n\n");
+  
+  /* parse table */
+  printf("static const uint16_t "
+    "ll1_table[LL1_NONTERMINAL_COUNT][TOKEN_END_MARK] = {\n");
+  for (nt = 0; nt < nonterminal_count; nt++) {
+    printf("  /* %s */ {", nonterminal_name[nt]);
+    for (token = 0; token < TOKEN_END_MARK; token++) {
+      printf("%s%u%s", (token % 12 == 0) ? "\n    " : " ", table[nt][token],
+        (token + 1 < TOKEN_END_MARK) ? "," : "");
+    } /* end for */
+    printf("\n  }%s\n", (nt + 1 < nonterminal_count) ? "," : "");
+  } /* end for */
+  printf("};\n\n");
+  
+  /* FIRST and FOLLOW sets */
+  printf("static const m2c_tokenset_s "
+    "ll1_first_set[LL1_NONTERMINAL_COUNT] = {\n");
+  for (nt = 0; nt < nonterminal_count; nt++) {
+    printf("  /* %s */\n  ", nonterminal_name[nt]);
+    print_set_literal(first_set[nt]);
+    printf("%s\n", (nt + 1 < nonterminal_count) ? "," : "");
+  } /* end for */
+  printf("};\n\n");
+  
+  printf("static const m2c_tokenset_s "
+    "ll1_follow_set[LL1_NONTERMINAL_COUNT] = {\n");
+  for (nt = 0; nt < nonterminal_count; nt++) {
+    printf("  /* %s */\n  ", nonterminal_name[nt]);
+    print_set_literal(follow_set[nt]);
+    printf("%s\n", (nt + 1 < nonterminal_count) ? "," : "");
+  } /* end for */
+  printf("};\n");
+  
+  printf(EOF_MARKER);
+} /* end print_tables */
+
+
+/* --------------------------------------------------------------------------
+ * utility program gen-ll1-table
+ * --------------------------------------------------------------------------
+ * This utility computes the FIRST and FOLLOW sets and the LL(1) parse table
+ * of the grammar in m2c-ll1-grammar.h  and prints them to the console.  It
+ * should be invoked with output redirection as follows:
+ *
+ * $ gen-ll1-table > m2c-ll1-tables.h
+ *
+ * Conflicts are reported on stderr and resolved as described for procedure
+ * enter_rule.
+ * ----------------------------------------------------------------------- */
+
+#define SUCCESS_RETURN_CODE 0
+#define ERROR_RETURN_CODE (-1)
+
+int main (void) {
+  
+  if (init_symbol_tables() == false) {
+    return ERROR_RETURN_CODE;
+  } /* end if */
+  
+  compute_first_sets();
+  compute_follow_sets();
+  compute_table();
+  
+  print_tables();
+  
+  fprintf(stderr, "%u non-terminals, %u rules, %u conflicts resolved\n",
+    nonterminal_count, (unsigned) RULE_COUNT, conflict_count);
+  
+  return SUCCESS_RETURN_CODE;
+} /* end main */
+
+/* END OF FILE */
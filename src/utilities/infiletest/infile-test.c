@@ -0,0 +1,197 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * infile-test.c                                                             *
+ *                                                                           *
+ * Checks that an overlong lexeme of a streamed infile is reported.          *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "infile.h"
+#include "interned-strings.h"
+#include "m2c-common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * Test parameters
+ * ----------------------------------------------------------------------- */
+
+#define TEST_FILENAME "infile-test.tmp"
+
+#define RING_SIZE (INFILE_CHUNK_SIZE * INFILE_CHUNK_COUNT)
+
+#define LONG_LEXEME_LENGTH (RING_SIZE + RING_SIZE / 2)
+
+
+/* --------------------------------------------------------------------------
+ * Failure counter
+ * ----------------------------------------------------------------------- */
+
+static unsigned int failures = 0;
+
+#define CHECK(_cond, _what) \
+  { if (!(_cond)) { printf("FAIL: %s\n", _what); failures++; }; }
+
+
+/* --------------------------------------------------------------------------
+ * private function write_test_file()
+ * --------------------------------------------------------------------------
+ * Writes a lexeme longer than the ring of a streamed infile,  followed by
+ * a space and a short lexeme.  Returns zero on success.
+ * ----------------------------------------------------------------------- */
+
+static int write_test_file (void) {
+  
+  FILE *file;
+  unsigned long count;
+  
+  file = fopen(TEST_FILENAME, "wb");
+  
+  if (file == NULL) {
+    printf("unable to create %s\n", TEST_FILENAME);
+    return -1;
+  } /* end if */
+  
+  for (count = 0; count < LONG_LEXEME_LENGTH; count++) {
+    fputc('a', file);
+  } /* end for */
+  
+  fputs(" bcd\n", file);
+  fclose(file);
+  
+  return 0;
+} /* end write_test_file */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure test_lexeme_too_long()
+ * --------------------------------------------------------------------------
+ * Reads a lexeme that exceeds the ring of a streamed infile.  Status
+ * FILEIO_STATUS_LEXEME_TOO_LONG must be retained by all subsequent reads
+ * until the lexeme is fetched,  and the following lexeme must be intact.
+ * ----------------------------------------------------------------------- */
+
+static void test_lexeme_too_long (void) {
+  
+  infile_t infile;
+  infile_status_t status;
+  intstr_t lexeme;
+  bool retained;
+  char next_char;
+  
+  /* prefix files are always streamed */
+  infile_open_prefix(&infile, TEST_FILENAME, &status);
+  
+  if (status != FILEIO_STATUS_SUCCESS) {
+    printf("FAIL: unable to open %s\n", TEST_FILENAME);
+    failures++;
+    return;
+  } /* end if */
+  
+  infile_mark_lexeme(infile);
+  retained = true;
+  
+  next_char = infile_lookahead_char(infile);
+  while (next_char == 'a') {
+    next_char = infile_consume_char(infile);
+    
+    if ((infile_column(infile) > RING_SIZE + 1) &&
+        (infile_status(infile) != FILEIO_STATUS_LEXEME_TOO_LONG)) {
+      retained = false;
+    } /* end if */
+  } /* end while */
+  
+  CHECK(retained, "status retained while consuming");
+  
+  next_char = infile_lookahead_char(infile);
+  CHECK(infile_status(infile) == FILEIO_STATUS_LEXEME_TOO_LONG,
+    "status retained by lookahead");
+  
+  lexeme = infile_lexeme(infile);
+  CHECK(lexeme == NULL, "no lexeme for overlong input");
+  CHECK(infile_status(infile) == FILEIO_STATUS_LEXEME_TOO_LONG,
+    "status reported when fetching the lexeme");
+  
+  next_char = infile_consume_char(infile);
+  CHECK(infile_status(infile) == FILEIO_STATUS_SUCCESS,
+    "status released after fetching the lexeme");
+  
+  infile_mark_lexeme(infile);
+  while (next_char != ASCII_LF) {
+    next_char = infile_consume_char(infile);
+  } /* end while */
+  
+  lexeme = infile_lexeme(infile);
+  CHECK((lexeme != NULL) && (intstr_length(lexeme) == 3),
+    "following lexeme intact");
+  
+  infile_close(&infile);
+  
+  return;
+} /* end test_lexeme_too_long */
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * ----------------------------------------------------------------------- */
+
+int main (void) {
+  
+  intstr_init_repo(0, NULL);
+  
+  if (write_test_file() != 0) {
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  test_lexeme_too_long();
+  
+  remove(TEST_FILENAME);
+  
+  if (failures > 0) {
+    printf("%u check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  printf("all checks passed\n");
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* END OF FILE */
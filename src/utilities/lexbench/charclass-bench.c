@@ -0,0 +1,282 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * charclass-bench.c                                                         *
+ *                                                                           *
+ * Microbenchmark comparing range based and table driven character           *
+ * classification on identifier-heavy input.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-char-class.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* --------------------------------------------------------------------------
+ * Benchmark parameters
+ * ----------------------------------------------------------------------- */
+
+#define SYNTHETIC_SIZE (4 * 1024 * 1024)
+
+#define PASS_COUNT 20
+
+
+/* --------------------------------------------------------------------------
+ * Range based classification, as used before the table was introduced
+ * ----------------------------------------------------------------------- */
+
+#define RANGE_IS_UPPER(_ch) (((_ch) >= 'A') && ((_ch) <= 'Z'))
+
+#define RANGE_IS_LOWER(_ch) (((_ch) >= 'a') && ((_ch) <= 'z'))
+
+#define RANGE_IS_DIGIT(_ch) (((_ch) >= '0') && ((_ch) <= '9'))
+
+#define RANGE_IS_LETTER_OR_DIGIT(_ch) \
+  (RANGE_IS_UPPER(_ch) || RANGE_IS_LOWER(_ch) || RANGE_IS_DIGIT(_ch))
+
+
+/* --------------------------------------------------------------------------
+ * Sample text for the synthetic corpus
+ * ----------------------------------------------------------------------- */
+
+static const char *sample =
+  "PROCEDURE insertEntry ( VAR table : SymbolTable; key : KeyType );\n"
+  "VAR index, bucketIndex : CARDINAL; newEntry, thisEntry : EntryPtr;\n"
+  "BEGIN\n"
+  "  bucketIndex := hashValue(key) MOD table^.bucketCount;\n"
+  "  thisEntry := table^.bucket[bucketIndex]; index := 0;\n"
+  "  WHILE (thisEntry # NIL) AND (thisEntry^.key # key) DO\n"
+  "    thisEntry := thisEntry^.next; INC(index)\n"
+  "  END; (* WHILE *)\n"
+  "  NEW(newEntry); newEntry^.key := key; newEntry^.next := thisEntry\n"
+  "END insertEntry;\n";
+
+
+/* --------------------------------------------------------------------------
+ * function scan_with_ranges(buffer, length)
+ * --------------------------------------------------------------------------
+ * Counts identifiers and words in buffer using range comparisons.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long scan_with_ranges (const char *buffer, size_t length) {
+  
+  size_t index = 0;
+  unsigned long count = 0;
+  
+  while (index < length) {
+    if (RANGE_IS_UPPER(buffer[index]) || RANGE_IS_LOWER(buffer[index])) {
+      index++;
+      while ((index < length) && RANGE_IS_LETTER_OR_DIGIT(buffer[index])) {
+        index++;
+      } /* end while */
+      count++;
+    }
+    else {
+      index++;
+    } /* end if */
+  } /* end while */
+  
+  return count;
+} /* end scan_with_ranges */
+
+
+/* --------------------------------------------------------------------------
+ * function scan_with_table(buffer, length)
+ * --------------------------------------------------------------------------
+ * Counts identifiers and words in buffer using the character class table.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long scan_with_table (const char *buffer, size_t length) {
+  
+  size_t index = 0;
+  unsigned long count = 0;
+  
+  while (index < length) {
+    if (CHAR_HAS_CLASS(buffer[index], CC_UPPER | CC_LOWER)) {
+      index++;
+      while ((index < length) && IS_LETTER_OR_DIGIT(buffer[index])) {
+        index++;
+      } /* end while */
+      count++;
+    }
+    else {
+      index++;
+    } /* end if */
+  } /* end while */
+  
+  return count;
+} /* end scan_with_table */
+
+
+/* --------------------------------------------------------------------------
+ * function load_corpus(argc, argv, length)
+ * --------------------------------------------------------------------------
+ * Reads all files named on the command line into a single buffer, or if no
+ * files are given, synthesises an identifier-heavy buffer.  Passes the size
+ * of the buffer back in length and returns the buffer.
+ * ----------------------------------------------------------------------- */
+
+static char *load_corpus (int argc, char *argv[], size_t *length) {
+  
+  FILE *file;
+  char *buffer, *new_buffer;
+  size_t size, file_size, sample_length;
+  int index;
+  
+  /* synthetic corpus */
+  if (argc < 2) {
+    sample_length = strlen(sample);
+    buffer = malloc(SYNTHETIC_SIZE);
+    
+    if (buffer == NULL) {
+      return NULL;
+    } /* end if */
+    
+    size = 0;
+    while (size + sample_length <= SYNTHETIC_SIZE) {
+      memcpy(&buffer[size], sample, sample_length);
+      size = size + sample_length;
+    } /* end while */
+    
+    *length = size;
+    return buffer;
+  } /* end if */
+  
+  /* corpus from files */
+  buffer = NULL;
+  size = 0;
+  for (index = 1; index < argc; index++) {
+    file = fopen(argv[index], "r");
+    
+    if (file == NULL) {
+      fprintf(stderr, "cannot open %s\n", argv[index]);
+      continue;
+    } /* end if */
+    
+    fseek(file, 0, SEEK_END);
+    file_size = (size_t) ftell(file);
+    rewind(file);
+    
+    new_buffer = realloc(buffer, size + file_size + 1);
+    
+    if (new_buffer == NULL) {
+      fclose(file);
+      free(buffer);
+      return NULL;
+    } /* end if */
+    
+    buffer = new_buffer;
+    size = size + fread(&buffer[size], 1, file_size, file);
+    fclose(file);
+  } /* end for */
+  
+  *length = size;
+  return buffer;
+} /* end load_corpus */
+
+
+/* --------------------------------------------------------------------------
+ * function run(name, scan, buffer, length)
+ * --------------------------------------------------------------------------
+ * Runs scan over buffer PASS_COUNT times, prints and returns tokens/sec.
+ * ----------------------------------------------------------------------- */
+
+typedef unsigned long (*scan_func_t) (const char *buffer, size_t length);
+
+static double run
+  (const char *name, scan_func_t scan, const char *buffer, size_t length) {
+  
+  clock_t start, stop;
+  unsigned long tokens;
+  double seconds, tokens_per_sec, mb_per_sec;
+  int pass;
+  
+  tokens = 0;
+  start = clock();
+  for (pass = 0; pass < PASS_COUNT; pass++) {
+    tokens = tokens + scan(buffer, length);
+  } /* end for */
+  stop = clock();
+  
+  seconds = ((double) (stop - start)) / CLOCKS_PER_SEC;
+  if (seconds <= 0.0) {
+    seconds = 1.0 / CLOCKS_PER_SEC;
+  } /* end if */
+  
+  tokens_per_sec = tokens / seconds;
+  mb_per_sec = ((double) length * PASS_COUNT) / (1024.0 * 1024.0) / seconds;
+  
+  printf("%-8s %12.0f tokens/s %10.1f MB/s (%lu tokens)\n",
+    name, tokens_per_sec, mb_per_sec, tokens / PASS_COUNT);
+  
+  return tokens_per_sec;
+} /* end run */
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  char *buffer;
+  size_t length;
+  double ranges, table;
+  
+  buffer = load_corpus(argc, argv, &length);
+  
+  if ((buffer == NULL) || (length == 0)) {
+    fprintf(stderr, "no input\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  printf("corpus: %lu bytes, %d passes\n", (unsigned long) length, PASS_COUNT);
+  
+  ranges = run("ranges", scan_with_ranges, buffer, length);
+  table = run("table", scan_with_table, buffer, length);
+  
+  printf("gain:   %+.1f%%\n", (table / ranges - 1.0) * 100.0);
+  
+  free(buffer);
+  return EXIT_SUCCESS;
+} /* end main */
+
+/* END OF FILE */
@@ -0,0 +1,387 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * lexer-bench.c                                                             *
+ *                                                                           *
+ * Lexer throughput benchmark over a corpus of source files and synthetic    *
+ * stress files, reporting MB/s, tokens/s and allocations per token.         *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-lexer.h"
+#include "m2c-token.h"
+#include "interned-strings.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* --------------------------------------------------------------------------
+ * Benchmark parameters
+ * ----------------------------------------------------------------------- */
+
+#define PASS_COUNT 10
+
+#define STRESS_FILE_SIZE (1024 * 1024)
+
+
+/* --------------------------------------------------------------------------
+ * Allocation counter
+ * --------------------------------------------------------------------------
+ * If built with LEXBENCH_WRAP_MALLOC and the linker option --wrap for each
+ * of malloc, calloc and realloc,  all allocations are counted.  Otherwise
+ * allocations are reported as not available.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long alloc_count = 0;
+
+#ifdef LEXBENCH_WRAP_MALLOC
+
+void *__real_malloc (size_t size);
+void *__real_calloc (size_t count, size_t size);
+void *__real_realloc (void *ptr, size_t size);
+
+void *__wrap_malloc (size_t size) {
+  alloc_count++;
+  return __real_malloc(size);
+} /* end __wrap_malloc */
+
+void *__wrap_calloc (size_t count, size_t size) {
+  alloc_count++;
+  return __real_calloc(count, size);
+} /* end __wrap_calloc */
+
+void *__wrap_realloc (void *ptr, size_t size) {
+  alloc_count++;
+  return __real_realloc(ptr, size);
+} /* end __wrap_realloc */
+
+#define ALLOCS_AVAILABLE 1
+
+#else
+
+#define ALLOCS_AVAILABLE 0
+
+#endif /* LEXBENCH_WRAP_MALLOC */
+
+
+/* --------------------------------------------------------------------------
+ * Synthetic stress files
+ * --------------------------------------------------------------------------
+ * Each stress file  repeats its sample text  up to STRESS_FILE_SIZE bytes,
+ * enclosed in a module header and trailer so that it is a valid compilation
+ * unit.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  const char *filename;
+  const char *sample;
+} stress_file_t;
+
+static const char *stress_header = "IMPLEMENTATION MODULE Stress;\n\n";
+
+static const char *stress_trailer = "\nEND Stress.\n";
+
+static const stress_file_t stress_file[] = {
+  { "stress-mixed.mod",
+    "PROCEDURE insertEntry ( VAR table : SymbolTable; key : KeyType );\n"
+    "VAR index, bucketIndex : CARDINAL; newEntry, thisEntry : EntryPtr;\n"
+    "BEGIN\n"
+    "  bucketIndex := hashValue(key) MOD table^.bucketCount;\n"
+    "  WHILE (thisEntry # NIL) AND (thisEntry^.key # key) DO\n"
+    "    thisEntry := thisEntry^.next; INC(index)\n"
+    "  END; (* WHILE *)\n"
+    "  NEW(newEntry); newEntry^.key := key; newEntry^.next := thisEntry\n"
+    "END insertEntry;\n\n" },
+  
+  { "stress-comments.mod",
+    "(* This is a long block comment which stresses the comment scanner.\n"
+    "   It contains (* nested comments *), punctuation ;:=#<>^ and more\n"
+    "   text to skip over, line after line, without producing tokens. *)\n"
+    "CONST Dummy = 0;\n" },
+  
+  { "stress-numbers.mod",
+    "CONST N0 = 0; N1 = 1234567890; N2 = 0xFFFF; N3 = 0b1111111; N4 = 3.14159;\n"
+    "  N5 = 6.02214076E23; N6 = 0u41; N7 = 0x7FFFFFFF; N8 = 0b10101010;\n"
+    "  N9 = 1.0E-9; N10 = 42; N11 = 99999999; N12 = 0.000001;\n" },
+  
+  { "stress-identifiers.mod",
+    "VAR aVeryLongIdentifierNameThatGoesOnAndOnForQuiteSomeTime,\n"
+    "  anotherExceedinglyLongIdentifierUsedForStressTesting123,\n"
+    "  yetAnotherIdentifierWithManyCharactersInItsSpelling456 : CARDINAL;\n"
+  },
+  
+  { "stress-pragmas.mod",
+    "<*INLINE*> <*NOINLINE*> <*ENCODING=\"UTF8\"*> <*IF (TSIZE(LONGINT)"
+    " = 8) THEN*> <*ELSE*> <*ENDIF*> <*MSG=INFO : \"stress\"*>\n"
+    "CONST Dummy = 0;\n" },
+  
+  { NULL, NULL }
+}; /* stress_file */
+
+
+/* --------------------------------------------------------------------------
+ * function write_stress_file(entry)
+ * --------------------------------------------------------------------------
+ * Writes the stress file described by entry to the current working direc-
+ * tory.  Returns zero on success, otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int write_stress_file (const stress_file_t *entry) {
+  
+  FILE *file;
+  size_t size, sample_length;
+  
+  file = fopen(entry->filename, "w");
+  
+  if (file == NULL) {
+    fprintf(stderr, "cannot create %s\n", entry->filename);
+    return -1;
+  } /* end if */
+  
+  sample_length = strlen(entry->sample);
+  
+  fputs(stress_header, file);
+  size = strlen(stress_header);
+  
+  while (size + sample_length <= STRESS_FILE_SIZE) {
+    fputs(entry->sample, file);
+    size = size + sample_length;
+  } /* end while */
+  
+  fputs(stress_trailer, file);
+  fclose(file);
+  
+  return 0;
+} /* end write_stress_file */
+
+
+/* --------------------------------------------------------------------------
+ * function file_size(path)
+ * --------------------------------------------------------------------------
+ * Returns the size of the file at path in bytes, or zero if it cannot be
+ * opened.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long file_size (const char *path) {
+  
+  FILE *file;
+  long size;
+  
+  file = fopen(path, "r");
+  
+  if (file == NULL) {
+    return 0;
+  } /* end if */
+  
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fclose(file);
+  
+  return (size < 0) ? 0 : (unsigned long) size;
+} /* end file_size */
+
+
+/* --------------------------------------------------------------------------
+ * type bench_result_t
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  unsigned long bytes;
+  unsigned long tokens;
+  unsigned long allocs;
+  double seconds;
+} bench_result_t;
+
+
+/* --------------------------------------------------------------------------
+ * function lex_file(path, result)
+ * --------------------------------------------------------------------------
+ * Lexes the file at path PASS_COUNT times using a single lexer,  reset for
+ * each pass after the first,  and m2c_consume_sym,  adds the measurements
+ * to result.  Returns zero on success, otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int lex_file (const char *path, bench_result_t *result) {
+  
+  m2c_lexer_t lexer;
+  m2c_lexer_status_t status;
+  m2c_token_t token;
+  intstr_t filename;
+  unsigned long tokens, allocs;
+  clock_t start, stop;
+  int pass;
+  
+  filename = intstr_for_cstr(path, NULL);
+  
+  if (filename == NULL) {
+    return -1;
+  } /* end if */
+  
+  tokens = 0;
+  allocs = alloc_count;
+  start = clock();
+  
+  lexer = NULL;
+  
+  for (pass = 0; pass < PASS_COUNT; pass++) {
+    if (lexer == NULL) {
+      m2c_new_lexer(&lexer, filename, &status);
+    }
+    else /* reuse lexer, its buffers and tables */ {
+      m2c_reset_lexer(lexer, filename, &status);
+    } /* end if */
+    
+    if (status != M2C_LEXER_STATUS_SUCCESS) {
+      fprintf(stderr, "cannot lex %s (status %d)\n", path, (int) status);
+      
+      if (lexer != NULL) {
+        m2c_release_lexer(&lexer, &status);
+      } /* end if */
+      
+      return -1;
+    } /* end if */
+    
+    do {
+      token = m2c_consume_sym(lexer);
+      tokens++;
+    } while (token != TOKEN_EOF);
+  } /* end for */
+  
+  m2c_release_lexer(&lexer, &status);
+  
+  stop = clock();
+  
+  result->bytes = result->bytes + file_size(path) * PASS_COUNT;
+  result->tokens = result->tokens + tokens;
+  result->allocs = result->allocs + (alloc_count - allocs);
+  result->seconds =
+    result->seconds + ((double) (stop - start)) / CLOCKS_PER_SEC;
+  
+  return 0;
+} /* end lex_file */
+
+
+/* --------------------------------------------------------------------------
+ * procedure print_result(name, result)
+ * --------------------------------------------------------------------------
+ * Prints MB/s, tokens/s and allocations per token of result.
+ * ----------------------------------------------------------------------- */
+
+static void print_result (const char *name, const bench_result_t *result) {
+  
+  double seconds, mb_per_sec, tokens_per_sec;
+  
+  seconds = result->seconds;
+  if (seconds <= 0.0) {
+    seconds = 1.0 / CLOCKS_PER_SEC;
+  } /* end if */
+  
+  mb_per_sec = ((double) result->bytes) / (1024.0 * 1024.0) / seconds;
+  tokens_per_sec = ((double) result->tokens) / seconds;
+  
+  printf("%-24s %8.1f MB/s %12.0f tokens/s", name, mb_per_sec, tokens_per_sec);
+  
+  if ((ALLOCS_AVAILABLE) && (result->tokens > 0)) {
+    printf(" %8.3f allocs/token\n",
+      ((double) result->allocs) / result->tokens);
+  }
+  else {
+    printf("      n/a allocs/token\n");
+  } /* end if */
+} /* end print_result */
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * --------------------------------------------------------------------------
+ * Lexes the .def and .mod files named on the command line,  or if none are
+ * given, the synthetic stress files which are written to the current work-
+ * ing directory first.  Prints results per file and for the whole corpus.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  bench_result_t total, this_result;
+  const stress_file_t *entry;
+  int index;
+  
+  intstr_init_repo(0, NULL);
+  
+  memset(&total, 0, sizeof(bench_result_t));
+  
+  if (argc < 2) {
+    /* synthetic stress files */
+    for (entry = stress_file; entry->filename != NULL; entry++) {
+      if (write_stress_file(entry) != 0) {
+        return EXIT_FAILURE;
+      } /* end if */
+      
+      memset(&this_result, 0, sizeof(bench_result_t));
+      if (lex_file(entry->filename, &this_result) == 0) {
+        print_result(entry->filename, &this_result);
+        total.bytes = total.bytes + this_result.bytes;
+        total.tokens = total.tokens + this_result.tokens;
+        total.allocs = total.allocs + this_result.allocs;
+        total.seconds = total.seconds + this_result.seconds;
+      } /* end if */
+      
+      remove(entry->filename);
+    } /* end for */
+  }
+  else /* corpus from command line */ {
+    for (index = 1; index < argc; index++) {
+      memset(&this_result, 0, sizeof(bench_result_t));
+      if (lex_file(argv[index], &this_result) == 0) {
+        print_result(argv[index], &this_result);
+        total.bytes = total.bytes + this_result.bytes;
+        total.tokens = total.tokens + this_result.tokens;
+        total.allocs = total.allocs + this_result.allocs;
+        total.seconds = total.seconds + this_result.seconds;
+      } /* end if */
+    } /* end for */
+  } /* end if */
+  
+  print_result("total", &total);
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* END OF FILE */
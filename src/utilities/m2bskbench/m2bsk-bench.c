@@ -0,0 +1,801 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2bsk-bench.c                                                             *
+ *                                                                           *
+ * End-to-end benchmark of lexing, parsing, analysis and translation over    *
+ * the m2bsk bootstrap kernel sources, reporting per-phase time, peak RSS    *
+ * and output size, and comparing against a stored baseline.                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
+
+#include "m2c-lexer.h"
+#include "m2c-token.h"
+#include "m2c-parser.h"
+#include "m2c-ll1-parser.h"
+#include "m2c-ast.h"
+#include "m2c-statistics.h"
+#include "m2c-compiler-options.h"
+#include "m2c-pathnames.h"
+#include "interned-strings.h"
+#include "outfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+
+/* --------------------------------------------------------------------------
+ * Phases
+ * --------------------------------------------------------------------------
+ * The recursive descent parser and the AST do not compile yet,  thus by
+ * default the parse phase runs the LL(1) table driven engine,  which only
+ * checks syntax,  and analysis and translation are skipped,  reporting no
+ * nodes,  no time and no output.  If M2BSK_BENCH_AST is defined as 1,  the
+ * parse phase builds an AST which is then analysed and translated,  see
+ * build.  Results of the two builds are not comparable.
+ * ----------------------------------------------------------------------- */
+
+#ifndef M2BSK_BENCH_AST
+#define M2BSK_BENCH_AST 0
+#endif
+
+#if (M2BSK_BENCH_AST)
+#include "m2c-ast-writer.h"
+#include "m2c-const-fold.h"
+#include "m2c-reachability.h"
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Benchmark parameters
+ * --------------------------------------------------------------------------
+ * Each pass runs all phases over the whole corpus,  the time reported for a
+ * phase is the least of all passes,  which is the most stable figure.
+ * ----------------------------------------------------------------------- */
+
+#define PASS_COUNT 5
+
+#define DEFAULT_TOLERANCE 10
+
+#define MAX_PATH_LENGTH 4096
+
+
+/* --------------------------------------------------------------------------
+ * Result format
+ * --------------------------------------------------------------------------
+ * Results are written one "key value" pair per line in a fixed order,  led
+ * by a format line.  Times are in microseconds,  sizes in bytes,  peak RSS
+ * in kilobytes.  A baseline is a results file written by an earlier run.
+ * ----------------------------------------------------------------------- */
+
+#define RESULT_FORMAT "m2bsk-bench 1"
+
+typedef enum {
+  RESULT_FILES,
+  RESULT_LINES,
+  RESULT_TOKENS,
+  RESULT_NODES,
+  RESULT_LEX_US,
+  RESULT_PARSE_US,
+  RESULT_ANALYSIS_US,
+  RESULT_TRANSLATE_US,
+  RESULT_PEAK_RSS_KB,
+  RESULT_OUTPUT_BYTES,
+  RESULT_END_MARK
+} result_key_t;
+
+#define RESULT_KEY_COUNT RESULT_END_MARK
+
+static const char *key_name[RESULT_KEY_COUNT] = {
+  "files", "lines", "tokens", "nodes",
+  "lex_us", "parse_us", "analysis_us", "translate_us",
+  "peak_rss_kb", "output_bytes"
+}; /* end key_name */
+
+
+/* --------------------------------------------------------------------------
+ * Kinds of result keys
+ * --------------------------------------------------------------------------
+ * Costs regress when they exceed the baseline by more than the tolerance,
+ * figures of the corpus and of the output must match the baseline exactly,
+ * otherwise the corpus or the translation has changed  and the comparison
+ * is void.
+ * ----------------------------------------------------------------------- */
+
+static const bool is_cost[RESULT_KEY_COUNT] = {
+  false, false, false, false,
+  true, true, true, true,
+  true, false
+}; /* end is_cost */
+
+typedef unsigned long result_t[RESULT_KEY_COUNT];
+
+
+/* --------------------------------------------------------------------------
+ * Corpus
+ * ----------------------------------------------------------------------- */
+
+static char **corpus = NULL;
+
+static unsigned corpus_count = 0;
+
+static unsigned corpus_capacity = 0;
+
+
+/* --------------------------------------------------------------------------
+ * procedure add_to_corpus(path)
+ * --------------------------------------------------------------------------
+ * Appends a copy of path to the corpus.  Exits on allocation failure.
+ * ----------------------------------------------------------------------- */
+
+static void add_to_corpus (const char *path) {
+  
+  char **new_corpus;
+  
+  if (corpus_count == corpus_capacity) {
+    corpus_capacity = (corpus_capacity == 0) ? 256 : 2 * corpus_capacity;
+    new_corpus = realloc(corpus, corpus_capacity * sizeof(char *));
+  
+    if (new_corpus == NULL) {
+      fprintf(stderr, "out of memory\n");
+      exit(EXIT_FAILURE);
+    } /* end if */
+  
+    corpus = new_corpus;
+  } /* end if */
+  
+  corpus[corpus_count] = malloc(strlen(path) + 1);
+  
+  if (corpus[corpus_count] == NULL) {
+    fprintf(stderr, "out of memory\n");
+    exit(EXIT_FAILURE);
+  } /* end if */
+  
+  strcpy(corpus[corpus_count], path);
+  corpus_count++;
+} /* end add_to_corpus */
+
+
+/* --------------------------------------------------------------------------
+ * procedure collect_sources(path)
+ * --------------------------------------------------------------------------
+ * Adds path to the corpus if it is a .def or .mod file,  or if it is a
+ * directory,  the .def and .mod files within it and its subdirectories.
+ * ----------------------------------------------------------------------- */
+
+static void collect_sources (const char *path) {
+  
+  char subpath[MAX_PATH_LENGTH];
+  struct dirent *entry;
+  struct stat info;
+  const char *suffix;
+  DIR *dir;
+  
+  if (stat(path, &info) != 0) {
+    fprintf(stderr, "cannot access %s\n", path);
+    return;
+  } /* end if */
+  
+  if (NOT(S_ISDIR(info.st_mode))) {
+    suffix = strrchr(path, '.');
+  
+    if ((suffix != NULL) &&
+        (is_def_suffix(suffix) || is_mod_suffix(suffix))) {
+      add_to_corpus(path);
+    } /* end if */
+  
+    return;
+  } /* end if */
+  
+  dir = opendir(path);
+  
+  if (dir == NULL) {
+    fprintf(stderr, "cannot read %s\n", path);
+    return;
+  } /* end if */
+  
+  while ((entry = readdir(dir)) != NULL) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    } /* end if */
+  
+    if (strlen(path) + strlen(entry->d_name) + 2 > MAX_PATH_LENGTH) {
+      fprintf(stderr, "path too long in %s\n", path);
+      continue;
+    } /* end if */
+  
+    sprintf(subpath, "%s/%s", path, entry->d_name);
+    collect_sources(subpath);
+  } /* end while */
+  
+  closedir(dir);
+} /* end collect_sources */
+
+
+/* --------------------------------------------------------------------------
+ * function compare_paths(a, b)
+ * --------------------------------------------------------------------------
+ * Orders corpus entries by pathname,  so that the order of processing does
+ * not depend on the order of directory entries.
+ * ----------------------------------------------------------------------- */
+
+static int compare_paths (const void *a, const void *b) {
+  return strcmp(*(char *const *) a, *(char *const *) b);
+} /* end compare_paths */
+
+
+/* --------------------------------------------------------------------------
+ * function now_us()
+ * --------------------------------------------------------------------------
+ * Returns the time of a monotonic clock in microseconds.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long now_us (void) {
+  
+  struct timespec now;
+  
+  if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+    return 0;
+  } /* end if */
+  
+  return (unsigned long) now.tv_sec * 1000000 +
+    (unsigned long) now.tv_nsec / 1000;
+} /* end now_us */
+
+
+/* --------------------------------------------------------------------------
+ * function peak_rss_kb()
+ * --------------------------------------------------------------------------
+ * Returns the peak resident set size of the process in kilobytes.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long peak_rss_kb (void) {
+  
+  struct rusage usage;
+  
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  } /* end if */
+  
+#if defined(__APPLE__)
+  return (unsigned long) usage.ru_maxrss / 1024; /* bytes on macOS */
+#else
+  return (unsigned long) usage.ru_maxrss;
+#endif
+} /* end peak_rss_kb */
+
+
+/* --------------------------------------------------------------------------
+ * function lex_file(path, tokens)
+ * --------------------------------------------------------------------------
+ * Lexes the file at path to the end and passes the number of symbols in
+ * tokens.  Returns zero on success,  otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int lex_file (const char *path, unsigned long *tokens) {
+  
+  m2c_lexer_t lexer;
+  m2c_lexer_status_t status;
+  intstr_t filename;
+  unsigned long count;
+  
+  filename = intstr_for_cstr(path, NULL);
+  
+  if (filename == NULL) {
+    return -1;
+  } /* end if */
+  
+  m2c_new_lexer(&lexer, filename, &status);
+  
+  if (status != M2C_LEXER_STATUS_SUCCESS) {
+    fprintf(stderr, "cannot lex %s (status %d)\n", path, (int) status);
+    return -1;
+  } /* end if */
+  
+  count = 0;
+  while (m2c_consume_sym(lexer) != TOKEN_EOF) {
+    count++;
+  } /* end while */
+  
+  m2c_release_lexer(&lexer, &status);
+  
+  *tokens = count + 1;
+  return 0;
+} /* end lex_file */
+
+
+#if (M2BSK_BENCH_AST)
+/* --------------------------------------------------------------------------
+ * function translate_tree(ast, length)
+ * --------------------------------------------------------------------------
+ * Translates ast to an in-memory outfile and passes the size of the output
+ * in length.  Returns zero on success,  otherwise -1.
+ *
+ * The tree is written in the S-expression format of option --ast,  which is
+ * the output the driver produces at present.  This is to be replaced by C
+ * code generation once the driver emits C.
+ * ----------------------------------------------------------------------- */
+
+static int translate_tree (m2c_astnode_t ast, unsigned long *length) {
+  
+  m2c_ast_writer_status_t status;
+  outfile_status_t outfile_status;
+  outfile_t outfile;
+  size_t size;
+  char *output;
+  
+  *length = 0;
+  outfile_open_memory(&outfile, &outfile_status);
+  
+  if (outfile == NULL) {
+    fprintf(stderr, "cannot allocate outfile\n");
+    return -1;
+  } /* end if */
+  
+  m2c_ast_write_sexpr(outfile, NULL, ast, 0, &status);
+  output = outfile_take_output(outfile, &size);
+  outfile_close(&outfile);
+  free(output);
+  
+  if (status != M2C_AST_WRITER_STATUS_SUCCESS) {
+    fprintf(stderr, "cannot translate (status %d)\n", (int) status);
+    return -1;
+  } /* end if */
+  
+  *length = (unsigned long) size;
+  return 0;
+} /* end translate_tree */
+
+
+/* --------------------------------------------------------------------------
+ * function run_phases(path, options, region, result)
+ * --------------------------------------------------------------------------
+ * Parses the file at path into region,  analyses the tree by constant
+ * folding and reachability  and translates it.  Adds the measurements to
+ * result.  Returns zero on success,  otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int run_phases
+  (const char *path, m2c_compiler_options_t options,
+   m2c_ast_region_t region, result_t result) {
+  
+  m2c_parser_status_t status;
+  m2c_reachability_t reach;
+  m2c_const_fold_t folder;
+  unsigned long start, length;
+  m2c_stats_t stats;
+  m2c_astnode_t ast;
+  int outcome;
+  
+  /* parse */
+  start = now_us();
+  ast = m2c_parse_file_with_options(path, options, &stats, &status);
+  result[RESULT_PARSE_US] += now_us() - start;
+  
+  if ((ast == NULL) || ((status != M2C_PARSER_STATUS_SUCCESS) &&
+      (status != M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND))) {
+    fprintf(stderr, "cannot parse %s (status %d)\n", path, (int) status);
+    m2c_stats_release(stats);
+    return -1;
+  } /* end if */
+  
+  result[RESULT_LINES] += m2c_stats_line_count(stats);
+  result[RESULT_NODES] += m2c_ast_region_node_count(region);
+  m2c_stats_release(stats);
+  
+  /* analyse */
+  start = now_us();
+  folder = m2c_new_const_folder();
+  
+  if (folder != NULL) {
+    m2c_fold_constants(folder, ast);
+    m2c_release_const_folder(folder);
+  } /* end if */
+  
+  reach = NULL;
+  if (is_mod_suffix(strrchr(path, '.'))) {
+    reach = m2c_analyse_reachability(ast, NULL);
+  } /* end if */
+  result[RESULT_ANALYSIS_US] += now_us() - start;
+  
+  /* translate */
+  start = now_us();
+  outcome = translate_tree(ast, &length);
+  result[RESULT_TRANSLATE_US] += now_us() - start;
+  result[RESULT_OUTPUT_BYTES] += length;
+  
+  m2c_release_reachability(reach);
+  
+  return outcome;
+} /* end run_phases */
+
+#else
+
+/* --------------------------------------------------------------------------
+ * function run_phases(path, options, result)
+ * --------------------------------------------------------------------------
+ * Checks the syntax of the file at path with the LL(1) engine  and adds the
+ * measurements to result.  Returns zero on success,  otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int run_phases
+  (const char *path, m2c_compiler_options_t options, result_t result) {
+  
+  m2c_parser_status_t status;
+  unsigned long start;
+  m2c_stats_t stats;
+  
+  /* parse */
+  start = now_us();
+  m2c_ll1_check_file(path, options, &stats, &status);
+  result[RESULT_PARSE_US] += now_us() - start;
+  
+  if ((status != M2C_PARSER_STATUS_SUCCESS) &&
+      (status != M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND)) {
+    fprintf(stderr, "cannot parse %s (status %d)\n", path, (int) status);
+    return -1;
+  } /* end if */
+  
+  result[RESULT_LINES] += m2c_stats_line_count(stats);
+  m2c_stats_release(stats);
+  
+  return 0;
+} /* end run_phases */
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function run_file(path, options, result)
+ * --------------------------------------------------------------------------
+ * Runs all phases on the file at path,  lexing it on its own first,  then
+ * parsing,  analysing and translating it in a fresh AST region.  Adds the
+ * measurements to result.  Returns zero on success,  otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int run_file
+  (const char *path, m2c_compiler_options_t options, result_t result) {
+  
+#if (M2BSK_BENCH_AST)
+  m2c_ast_region_t region;
+  int outcome;
+#endif
+  unsigned long tokens, start;
+  
+  /* lex */
+  start = now_us();
+  if (lex_file(path, &tokens) != 0) {
+    return -1;
+  } /* end if */
+  result[RESULT_LEX_US] += now_us() - start;
+  result[RESULT_TOKENS] += tokens;
+  
+#if (M2BSK_BENCH_AST)
+  region = m2c_ast_new_region(0);
+  
+  if (region == NULL) {
+    fprintf(stderr, "cannot allocate AST region\n");
+    return -1;
+  } /* end if */
+  
+  m2c_ast_set_region(region);
+  outcome = run_phases(path, options, region, result);
+  m2c_ast_release_region(region);
+  
+  return outcome;
+#else
+  return run_phases(path, options, result);
+#endif
+} /* end run_file */
+
+
+/* --------------------------------------------------------------------------
+ * function run_corpus(result)
+ * --------------------------------------------------------------------------
+ * Runs PASS_COUNT passes over the corpus,  passes the least time of each
+ * phase and the figures of the last pass in result.  Returns zero on
+ * success,  otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int run_corpus (result_t result) {
+  
+  m2c_compiler_options_t options;
+  result_t pass_result;
+  unsigned index, pass;
+  result_key_t key;
+  
+  options = m2c_compiler_options_snapshot();
+  
+  for (pass = 0; pass < PASS_COUNT; pass++) {
+    memset(pass_result, 0, sizeof(result_t));
+  
+    for (index = 0; index < corpus_count; index++) {
+      if (run_file(corpus[index], options, pass_result) != 0) {
+        return -1;
+      } /* end if */
+    } /* end for */
+  
+    for (key = 0; key < RESULT_KEY_COUNT; key++) {
+      if ((pass == 0) || NOT(is_cost[key]) ||
+          (pass_result[key] < result[key])) {
+        result[key] = pass_result[key];
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  result[RESULT_FILES] = corpus_count;
+  result[RESULT_PEAK_RSS_KB] = peak_rss_kb();
+  
+  return 0;
+} /* end run_corpus */
+
+
+/* --------------------------------------------------------------------------
+ * procedure write_result(file, result)
+ * --------------------------------------------------------------------------
+ * Writes result to file in the result format.
+ * ----------------------------------------------------------------------- */
+
+static void write_result (FILE *file, const result_t result) {
+  
+  result_key_t key;
+  
+  fprintf(file, "%s\n", RESULT_FORMAT);
+  
+  for (key = 0; key < RESULT_KEY_COUNT; key++) {
+    fprintf(file, "%s %lu\n", key_name[key], result[key]);
+  } /* end for */
+} /* end write_result */
+
+
+/* --------------------------------------------------------------------------
+ * function read_result(path, result)
+ * --------------------------------------------------------------------------
+ * Reads a result in the result format from the file at path.  Keys that
+ * are not known are ignored,  keys that are missing are passed as zero.
+ * Returns zero on success,  otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int read_result (const char *path, result_t result) {
+  
+  char line[128], name[64];
+  unsigned long value;
+  result_key_t key;
+  FILE *file;
+  
+  file = fopen(path, "r");
+  
+  if (file == NULL) {
+    fprintf(stderr, "cannot open baseline %s\n", path);
+    return -1;
+  } /* end if */
+  
+  if ((fgets(line, sizeof(line), file) == NULL) ||
+      (strncmp(line, RESULT_FORMAT, strlen(RESULT_FORMAT)) != 0)) {
+    fprintf(stderr, "%s is not an m2bsk-bench result\n", path);
+    fclose(file);
+    return -1;
+  } /* end if */
+  
+  memset(result, 0, sizeof(result_t));
+  
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (sscanf(line, "%63s %lu", name, &value) != 2) {
+      continue;
+    } /* end if */
+  
+    for (key = 0; key < RESULT_KEY_COUNT; key++) {
+      if (strcmp(name, key_name[key]) == 0) {
+        result[key] = value;
+      } /* end if */
+    } /* end for */
+  } /* end while */
+  
+  fclose(file);
+  
+  return 0;
+} /* end read_result */
+
+
+/* --------------------------------------------------------------------------
+ * function compare_result(result, baseline, tolerance)
+ * --------------------------------------------------------------------------
+ * Prints the change of each figure of result against baseline,  marking
+ * costs that exceed the baseline by more than tolerance percent  and
+ * figures that differ from the baseline.  Returns the number of marks.
+ * ----------------------------------------------------------------------- */
+
+static unsigned compare_result
+  (const result_t result, const result_t baseline, unsigned tolerance) {
+  
+  const char *mark;
+  unsigned marks;
+  result_key_t key;
+  double change;
+  
+  marks = 0;
+  for (key = 0; key < RESULT_KEY_COUNT; key++) {
+    change = 0.0;
+    if (baseline[key] != 0) {
+      change = ((double) result[key] / (double) baseline[key] - 1.0) * 100.0;
+    } /* end if */
+  
+    mark = "";
+    if (is_cost[key]) {
+      if (result[key] * 100 > baseline[key] * (100 + tolerance)) {
+        mark = "  REGRESSION";
+      } /* end if */
+    }
+    else if (result[key] != baseline[key]) {
+      mark = "  CHANGED";
+    } /* end if */
+  
+    if (mark[0] != '\0') {
+      marks++;
+    } /* end if */
+  
+    printf("%-14s %12lu %12lu %+8.1f%%%s\n", key_name[key],
+      baseline[key], result[key], change, mark);
+  } /* end for */
+  
+  return marks;
+} /* end compare_result */
+
+
+/* --------------------------------------------------------------------------
+ * procedure exit_with_usage()
+ * ----------------------------------------------------------------------- */
+
+static void exit_with_usage (void) {
+  
+  printf("usage:\n");
+  printf(" m2bsk-bench [-b baseline] [-t tolerance] [-w results] path ...\n");
+  exit(EXIT_FAILURE);
+} /* end exit_with_usage */
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * --------------------------------------------------------------------------
+ * Runs all phases over the .def and .mod files named on the command line or
+ * found in the directories named on the command line  and prints the result
+ * in the result format.  With -w the result is also written to a file,  to
+ * serve as a baseline for later runs.  With -b it is compared against a
+ * baseline,  exiting with failure if a cost exceeds the baseline by more
+ * than the tolerance,  ten percent by default,  or if the corpus or the size
+ * of the output has changed.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  const char *baseline_path, *results_path;
+  result_t result, baseline;
+  unsigned tolerance;
+  int arg_index;
+  FILE *file;
+  
+  baseline_path = NULL;
+  results_path = NULL;
+  tolerance = DEFAULT_TOLERANCE;
+  
+  arg_index = 1;
+  while ((arg_index < argc) && (argv[arg_index][0] == '-')) {
+    if ((arg_index + 1 >= argc) || (argv[arg_index][2] != '\0')) {
+      exit_with_usage();
+    } /* end if */
+  
+    switch (argv[arg_index][1]) {
+      case 'b' :
+        baseline_path = argv[arg_index + 1];
+        break;
+  
+      case 't' :
+        tolerance = (unsigned) strtoul(argv[arg_index + 1], NULL, 10);
+        break;
+  
+      case 'w' :
+        results_path = argv[arg_index + 1];
+        break;
+  
+      default :
+        exit_with_usage();
+    } /* end switch */
+  
+    arg_index = arg_index + 2;
+  } /* end while */
+  
+  if (arg_index >= argc) {
+    exit_with_usage();
+  } /* end if */
+  
+  while (arg_index < argc) {
+    collect_sources(argv[arg_index]);
+    arg_index++;
+  } /* end while */
+  
+  if (corpus_count == 0) {
+    fprintf(stderr, "no sources found\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  qsort(corpus, corpus_count, sizeof(char *), compare_paths);
+  
+  intstr_init_repo(0, NULL);
+  
+  memset(result, 0, sizeof(result_t));
+  if (run_corpus(result) != 0) {
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  write_result(stdout, result);
+  
+  if (results_path != NULL) {
+    file = fopen(results_path, "w");
+  
+    if (file == NULL) {
+      fprintf(stderr, "cannot write %s\n", results_path);
+      return EXIT_FAILURE;
+    } /* end if */
+  
+    write_result(file, result);
+    fclose(file);
+  } /* end if */
+  
+  if (baseline_path != NULL) {
+    if (read_result(baseline_path, baseline) != 0) {
+      return EXIT_FAILURE;
+    } /* end if */
+  
+    printf("\n%-14s %12s %12s %9s\n", "", "baseline", "current", "change");
+  
+    if (compare_result(result, baseline, tolerance) != 0) {
+      return EXIT_FAILURE;
+    } /* end if */
+  } /* end if */
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+/* END OF FILE */
@@ -0,0 +1,114 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2bundle.c                                                                *
+ *                                                                           *
+ * Library bundle archiver,  writes module files given on the command line   *
+ * into a single library bundle file.                                        *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-library-bundle.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * private function status_message(status)
+ * --------------------------------------------------------------------------
+ * Returns a human readable message for a library bundle status.
+ * ----------------------------------------------------------------------- */
+
+static const char *status_message (m2c_bundle_status_t status) {
+  
+  switch (status) {
+    case M2C_BUNDLE_STATUS_INVALID_REFERENCE :
+      return "invalid reference";
+    
+    case M2C_BUNDLE_STATUS_IO_ERROR :
+      return "file could not be read or bundle could not be written";
+    
+    case M2C_BUNDLE_STATUS_INVALID_FILE :
+      return "not a library bundle";
+    
+    case M2C_BUNDLE_STATUS_INVALID_MEMBER_NAME :
+      return "file is not named <module>.def, .mod, .sym or .exl";
+    
+    case M2C_BUNDLE_STATUS_DUPLICATE_MEMBER :
+      return "two files of the same module and kind";
+    
+    case M2C_BUNDLE_STATUS_ALLOCATION_FAILED :
+      return "out of memory";
+    
+    default :
+      return "success";
+  } /* end switch */
+} /* end status_message */
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * --------------------------------------------------------------------------
+ * Usage:  m2bundle <bundle>.m2lib <file> ...
+ *
+ * Writes a library bundle holding the given module files,  replacing any
+ * existing bundle at the same path.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  m2c_bundle_status_t status;
+  
+  if ((argc < 3) || NOT(m2c_is_bundle_path(argv[1]))) {
+    fprintf(stderr, "usage: m2bundle <bundle>%s <file> ...\n",
+      M2C_BUNDLE_SUFFIX);
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  m2c_write_bundle(argv[1], (uint_t) (argc - 2),
+    (const char *const *) &argv[2], &status);
+  
+  if (status != M2C_BUNDLE_STATUS_SUCCESS) {
+    fprintf(stderr, "m2bundle: %s: %s\n", argv[1], status_message(status));
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+/* END OF FILE */
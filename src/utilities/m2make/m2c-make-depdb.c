@@ -0,0 +1,1437 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-depdb.c                                                          *
+ *                                                                           *
+ * Implementation of m2make dependency database.                             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-make-depdb.h"
+#include "fileutils.h"
+#include "hash.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Select memory mapped database files for POSIX and Unix-like hosts
+ * --------------------------------------------------------------------------
+ * On hosts that provide mmap(),  database files are mapped read-only into
+ * the address space and used in place.  On all other hosts  (AmigaOS,
+ * OpenVMS, Windows) the file is read into a buffer.  Define M2C_MAKE_DEPDB_
+ * USE_MMAP as 0 to force the buffered implementation.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_MAKE_DEPDB_USE_MMAP)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_MAKE_DEPDB_USE_MMAP 1
+#else
+#define M2C_MAKE_DEPDB_USE_MMAP 0
+#endif
+#endif
+
+#if (M2C_MAKE_DEPDB_USE_MMAP)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * private type depdb_header_t
+ * --------------------------------------------------------------------------
+ * Record type representing the header of a database file.
+ *
+ * The header is followed by module_count records,  an index of slot_count
+ * 32-bit slots,  an import table of import_count 32-bit string offsets and
+ * string_size bytes of NUL terminated strings.  A slot holds the number of
+ * a record plus one,  or zero if it is free.  Records are found by linear
+ * probing from the slot given by the key of their identifier.  Field probe
+ * holds the key of DEPDB_PROBE to reject files whose keys were computed by
+ * a different hash function.
+ * ----------------------------------------------------------------------- */
+
+#define DEPDB_MAGIC "M2C-DDB"
+
+#define DEPDB_BYTE_ORDER 0x01020304
+
+#define DEPDB_PROBE "M2C"
+
+#define DEPDB_MIN_SLOT_COUNT 8
+
+typedef struct {
+  /* magic */         char magic[8];
+  /* version */       uint32_t version;
+  /* byte_order */    uint32_t byte_order;
+  /* probe */         uint32_t probe;
+  /* module_count */  uint32_t module_count;
+  /* slot_count */    uint32_t slot_count;
+  /* import_count */  uint32_t import_count;
+  /* string_size */   uint32_t string_size;
+  /* reserved */      uint32_t reserved;
+} depdb_header_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type depdb_record_t
+ * --------------------------------------------------------------------------
+ * Record type representing a module in a database file.  Fields ident and
+ * source are string offsets,  the imports of the module are held in the
+ * import table from index first_import on.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* mtime */         int64_t mtime;
+  /* size */          uint64_t size;
+  /* key */           uint32_t key;
+  /* ident */         uint32_t ident;
+  /* source */        uint32_t source;
+  /* digest */        uint32_t digest;
+  /* first_import */  uint32_t first_import;
+  /* import_count */  uint32_t import_count;
+} depdb_record_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type depdb_update_t
+ * --------------------------------------------------------------------------
+ * Record type representing an updated module held in memory.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* module */        intstr_t module;
+  /* source_path */   char *source_path;
+  /* source */        m2c_make_depdb_source_t source;
+  /* import_count */  uint_t import_count;
+  /* imports */       intstr_t *imports;
+} depdb_update_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_make_depdb_s
+ * --------------------------------------------------------------------------
+ * Record type representing an open dependency database.  Pointers record,
+ * slot,  import and string point into the file contents.  Updated modules
+ * are held in table update,  found by linear probing in table update_slot,
+ * whose slot count is a power of two and at least twice the update count.
+ * Field shadowed holds the number of file records replaced by updates.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_make_depdb_s {
+  /* file_data */          void *file_data;
+  /* file_size */          size_t file_size;
+  /* is_mapped */          bool is_mapped;
+  /* header */             depdb_header_t header;
+  /* record */             const depdb_record_t *record;
+  /* slot */               const uint32_t *slot;
+  /* import */             const uint32_t *import;
+  /* string */             const char *string;
+  /* update_count */       uint_t update_count;
+  /* update_capacity */    uint_t update_capacity;
+  /* update */             depdb_update_t *update;
+  /* update_slot_count */  uint_t update_slot_count;
+  /* update_slot */        uint_t *update_slot;
+  /* shadowed */           uint_t shadowed;
+  /* dirty */              bool dirty;
+};
+
+typedef struct m2c_make_depdb_s m2c_make_depdb_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type depdb_builder_t
+ * --------------------------------------------------------------------------
+ * Record type representing the state of the database writer.  Identifiers
+ * are entered once into the string table,  their offsets are found by
+ * linear probing in tables ident_slot and offset_slot.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* record */           depdb_record_t *record;
+  /* record_count */     uint32_t record_count;
+  /* import */           uint32_t *import;
+  /* import_count */     uint32_t import_count;
+  /* string */           char *string;
+  /* string_size */      uint32_t string_size;
+  /* string_capacity */  uint32_t string_capacity;
+  /* ident_slot */       intstr_t *ident_slot;
+  /* offset_slot */      uint32_t *offset_slot;
+  /* slot_count */       uint_t slot_count;
+  /* failed */           bool failed;
+} depdb_builder_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_depdb_status_t read_file_data
+  (m2c_make_depdb_t db, const char *path);
+
+static bool header_is_valid (m2c_make_depdb_t db);
+
+static void release_file_data (m2c_make_depdb_t db);
+
+static const char *string_at (m2c_make_depdb_t db, uint32_t offset);
+
+static const depdb_record_t *record_for_module
+  (m2c_make_depdb_t db, intstr_t module);
+
+static uint_t update_for_module (m2c_make_depdb_t db, intstr_t module);
+
+static uint_t add_update (m2c_make_depdb_t db, intstr_t module);
+
+static bool grow_update_table (m2c_make_depdb_t db);
+
+static void add_entry
+  (depdb_builder_t *builder, intstr_t module, const char *source_path,
+   const m2c_make_depdb_source_t *source);
+
+static uint32_t add_ident (depdb_builder_t *builder, intstr_t ident);
+
+static uint32_t add_chars
+  (depdb_builder_t *builder, const char *chars, uint_t length);
+
+static uint32_t *new_index
+  (const depdb_record_t *record, uint32_t count, uint32_t *slot_count);
+
+static uint32_t key_for_chars (const char *chars, uint_t length);
+
+static uint_t power_of_two_above (uint_t value);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_open(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the dependency database at path and returns it.  Missing and invalid
+ * files yield an empty database.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_depdb_t m2c_make_depdb_open
+  (const char *path, m2c_make_depdb_status_t *status) {
+  
+  m2c_make_depdb_status_t file_status;
+  m2c_make_depdb_t db;
+  
+  if (path == NULL) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  db = calloc(1, sizeof(m2c_make_depdb_s));
+  
+  if (db == NULL) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  if (NOT(file_exists(path))) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_FILE_NOT_FOUND);
+    return db;
+  } /* end if */
+  
+  file_status = read_file_data(db, path);
+  
+  if (file_status != M2C_MAKE_DEPDB_STATUS_SUCCESS) {
+    SET_STATUS(status, file_status);
+    return db;
+  } /* end if */
+  
+  if (NOT(header_is_valid(db))) {
+    release_file_data(db);
+    memset(&db->header, 0, sizeof(depdb_header_t));
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_INVALID_FILE);
+    return db;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_SUCCESS);
+  return db;
+} /* end m2c_make_depdb_open */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_module_count(db)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules in db.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_depdb_module_count (m2c_make_depdb_t db) {
+  
+  if (db == NULL) {
+    return 0;
+  } /* end if */
+  
+  return db->header.module_count - db->shadowed + db->update_count;
+} /* end m2c_make_depdb_module_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_lookup(db, module, source_path, source)
+ * --------------------------------------------------------------------------
+ * Looks up module in db,  updated entries first.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_lookup
+  (m2c_make_depdb_t db,
+   intstr_t module,
+   const char **source_path,
+   m2c_make_depdb_source_t *source) {
+  
+  const depdb_record_t *record;
+  const char *path;
+  uint_t index;
+  
+  if ((db == NULL) || (module == NULL)) {
+    return false;
+  } /* end if */
+  
+  index = update_for_module(db, module);
+  
+  if (index < db->update_count) {
+    SET_STATUS(source_path, db->update[index].source_path);
+    SET_STATUS(source, db->update[index].source);
+    return true;
+  } /* end if */
+  
+  record = record_for_module(db, module);
+  
+  if (record == NULL) {
+    return false;
+  } /* end if */
+  
+  path = string_at(db, record->source);
+  
+  if (path == NULL) {
+    return false;
+  } /* end if */
+  
+  SET_STATUS(source_path, path);
+  
+  if (source != NULL) {
+    source->mtime = record->mtime;
+    source->size = record->size;
+    source->digest = record->digest;
+  } /* end if */
+  
+  return true;
+} /* end m2c_make_depdb_lookup */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_is_current(db, module)
+ * --------------------------------------------------------------------------
+ * Returns true if the source file of module is unchanged since it was
+ * recorded in db.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_is_current (m2c_make_depdb_t db, intstr_t module) {
+  
+  m2c_make_depdb_source_t recorded, current;
+  const char *path;
+  
+  if (NOT(m2c_make_depdb_lookup(db, module, &path, &recorded))) {
+    return false;
+  } /* end if */
+  
+  if (NOT(m2c_make_depdb_stat_source(path, &current))) {
+    return false;
+  } /* end if */
+  
+  return (current.mtime == recorded.mtime) && (current.size == recorded.size);
+} /* end m2c_make_depdb_is_current */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_read_imports(db, module, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Passes the imports of module in db in a newly allocated array.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_read_imports
+  (const void *db_ptr,
+   intstr_t module,
+   uint_t *count,
+   intstr_t **imports,
+   m2c_dep_file_status_t *status) {
+  
+  m2c_make_depdb_t db = (m2c_make_depdb_t) db_ptr;
+  const depdb_record_t *record;
+  const char *ident;
+  intstr_t *list;
+  uint_t index, import_count;
+  
+  if ((db == NULL) || (module == NULL) ||
+      (count == NULL) || (imports == NULL)) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  *count = 0;
+  *imports = NULL;
+  
+  index = update_for_module(db, module);
+  
+  /* updated entry */
+  if (index < db->update_count) {
+    import_count = db->update[index].import_count;
+    
+    if (import_count > 0) {
+      list = malloc(import_count * sizeof(intstr_t));
+      
+      if (list == NULL) {
+        SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+        return;
+      } /* end if */
+      
+      memcpy(list, db->update[index].imports,
+        import_count * sizeof(intstr_t));
+      
+      *count = import_count;
+      *imports = list;
+    } /* end if */
+    
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  record = record_for_module(db, module);
+  
+  if (record == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_FILE_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  /* file entry */
+  if ((record->first_import > db->header.import_count) ||
+      (record->import_count >
+         db->header.import_count - record->first_import)) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_FORMAT);
+    return;
+  } /* end if */
+  
+  if (record->import_count == 0) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  list = malloc(record->import_count * sizeof(intstr_t));
+  
+  if (list == NULL) {
+    SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  index = 0;
+  while (index < record->import_count) {
+    ident = string_at(db, db->import[record->first_import + index]);
+    
+    if (ident == NULL) {
+      free(list);
+      SET_STATUS(status, M2C_DEP_FILE_STATUS_INVALID_FORMAT);
+      return;
+    } /* end if */
+    
+    list[index] = intstr_for_cstr(ident, NULL);
+    
+    if (list[index] == NULL) {
+      free(list);
+      SET_STATUS(status, M2C_DEP_FILE_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    index++;
+  } /* end while */
+  
+  *count = record->import_count;
+  *imports = list;
+  
+  SET_STATUS(status, M2C_DEP_FILE_STATUS_SUCCESS);
+  return;
+} /* end m2c_make_depdb_read_imports */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_update(db, module, path, source, count, ...)
+ * --------------------------------------------------------------------------
+ * Records module with its source and imports in the updates of db.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_update
+  (m2c_make_depdb_t db,
+   intstr_t module,
+   const char *source_path,
+   const m2c_make_depdb_source_t *source,
+   uint_t count,
+   const intstr_t imports[],
+   m2c_make_depdb_status_t *status) {
+  
+  depdb_update_t *entry;
+  intstr_t *new_imports;
+  char *new_path;
+  uint_t index, length;
+  
+  if ((db == NULL) || (module == NULL) || (source_path == NULL) ||
+      (source == NULL) || ((count > 0) && (imports == NULL))) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  length = strlen(source_path);
+  new_path = malloc(length + 1);
+  new_imports = NULL;
+  
+  if (count > 0) {
+    new_imports = malloc(count * sizeof(intstr_t));
+  } /* end if */
+  
+  if ((new_path == NULL) || ((count > 0) && (new_imports == NULL))) {
+    free(new_path);
+    free(new_imports);
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  memcpy(new_path, source_path, length + 1);
+  
+  if (count > 0) {
+    memcpy(new_imports, imports, count * sizeof(intstr_t));
+  } /* end if */
+  
+  index = update_for_module(db, module);
+  
+  /* new entry */
+  if (index == db->update_count) {
+    index = add_update(db, module);
+    
+    if (index == db->update_count) {
+      free(new_path);
+      free(new_imports);
+      SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    if (record_for_module(db, module) != NULL) {
+      db->shadowed++;
+    } /* end if */
+  } /* end if */
+  
+  entry = &db->update[index];
+  
+  free(entry->source_path);
+  free(entry->imports);
+  
+  entry->source_path = new_path;
+  entry->source = *source;
+  entry->import_count = count;
+  entry->imports = new_imports;
+  
+  db->dirty = true;
+  
+  SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_SUCCESS);
+  return;
+} /* end m2c_make_depdb_update */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_write(db, path, status)
+ * --------------------------------------------------------------------------
+ * Writes the updated and unchanged entries of db to a database file at path
+ * if db has been updated.  Identifiers are stored once and shared by the
+ * records and the import table.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_write
+  (m2c_make_depdb_t db,
+   const char *path,
+   m2c_make_depdb_status_t *status) {
+  
+  m2c_make_depdb_source_t source;
+  depdb_builder_t builder;
+  depdb_header_t header;
+  const depdb_record_t *record;
+  const depdb_update_t *entry;
+  const char *ident, *source_path;
+  intstr_t *file_module, import_id;
+  uint32_t *slot, slot_count, import_total, first;
+  uint_t index, import_index, module_count, length;
+  char *tmp_path;
+  FILE *file;
+  bool ok;
+  
+  if ((db == NULL) || (path == NULL)) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (NOT(db->dirty)) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  /* identify file records not replaced by updates */
+  file_module = malloc((db->header.module_count + 1) * sizeof(intstr_t));
+  
+  if (file_module == NULL) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  import_total = 0;
+  index = 0;
+  while (index < db->update_count) {
+    import_total = import_total + db->update[index].import_count;
+    index++;
+  } /* end while */
+  
+  index = 0;
+  while (index < db->header.module_count) {
+    file_module[index] = NULL;
+    ident = string_at(db, db->record[index].ident);
+    
+    if (ident != NULL) {
+      file_module[index] = intstr_for_cstr(ident, NULL);
+    } /* end if */
+    
+    if ((file_module[index] != NULL) &&
+        (update_for_module(db, file_module[index]) < db->update_count)) {
+      file_module[index] = NULL;
+    } /* end if */
+    
+    if (file_module[index] != NULL) {
+      import_total = import_total + db->record[index].import_count;
+    } /* end if */
+    
+    index++;
+  } /* end while */
+  
+  module_count = m2c_make_depdb_module_count(db);
+  
+  memset(&builder, 0, sizeof(depdb_builder_t));
+  builder.record = malloc((module_count + 1) * sizeof(depdb_record_t));
+  builder.import = malloc((import_total + 1) * sizeof(uint32_t));
+  builder.slot_count = power_of_two_above(2 * (module_count + import_total));
+  builder.ident_slot = calloc(builder.slot_count, sizeof(intstr_t));
+  builder.offset_slot = calloc(builder.slot_count, sizeof(uint32_t));
+  
+  builder.failed = (builder.record == NULL) || (builder.import == NULL) ||
+    (builder.ident_slot == NULL) || (builder.offset_slot == NULL);
+  
+  /* updated entries */
+  index = 0;
+  while (NOT(builder.failed) && (index < db->update_count)) {
+    entry = &db->update[index];
+    add_entry(&builder, entry->module, entry->source_path, &entry->source);
+    
+    import_index = 0;
+    while (import_index < entry->import_count) {
+      builder.import[builder.import_count] =
+        add_ident(&builder, entry->imports[import_index]);
+      builder.import_count++;
+      import_index++;
+    } /* end while */
+    
+    builder.record[builder.record_count - 1].import_count =
+      entry->import_count;
+    
+    index++;
+  } /* end while */
+  
+  /* unchanged file entries */
+  index = 0;
+  while (NOT(builder.failed) && (index < db->header.module_count)) {
+    record = &db->record[index];
+    source_path = string_at(db, record->source);
+    
+    if ((file_module[index] != NULL) && (source_path != NULL)) {
+      source.mtime = record->mtime;
+      source.size = record->size;
+      source.digest = record->digest;
+      add_entry(&builder, file_module[index], source_path, &source);
+      first = builder.record[builder.record_count - 1].first_import;
+      
+      /* malformed imports are dropped */
+      import_index = 0;
+      while ((record->first_import <= db->header.import_count) &&
+             (import_index < record->import_count) &&
+             (import_index <
+                db->header.import_count - record->first_import)) {
+        ident = string_at(db, db->import[record->first_import + import_index]);
+        import_id = (ident != NULL) ? intstr_for_cstr(ident, NULL) : NULL;
+        
+        if (import_id != NULL) {
+          builder.import[builder.import_count] =
+            add_ident(&builder, import_id);
+          builder.import_count++;
+        } /* end if */
+        
+        import_index++;
+      } /* end while */
+      
+      builder.record[builder.record_count - 1].import_count =
+        builder.import_count - first;
+    } /* end if */
+    
+    index++;
+  } /* end while */
+  
+  free(file_module);
+  free(builder.ident_slot);
+  free(builder.offset_slot);
+  
+  slot = NULL;
+  if (NOT(builder.failed)) {
+    slot = new_index(builder.record, builder.record_count, &slot_count);
+  } /* end if */
+  
+  /* path.tmp */
+  length = strlen(path);
+  tmp_path = malloc(length + 5);
+  
+  if ((slot == NULL) || (tmp_path == NULL)) {
+    free(slot);
+    free(tmp_path);
+    free(builder.record);
+    free(builder.import);
+    free(builder.string);
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  memcpy(tmp_path, path, length);
+  memcpy(tmp_path + length, ".tmp", 5);
+  
+  memset(&header, 0, sizeof(depdb_header_t));
+  memcpy(header.magic, DEPDB_MAGIC, sizeof(DEPDB_MAGIC));
+  header.version = M2C_MAKE_DEPDB_VERSION;
+  header.byte_order = DEPDB_BYTE_ORDER;
+  header.probe = key_for_chars(DEPDB_PROBE, strlen(DEPDB_PROBE));
+  header.module_count = builder.record_count;
+  header.slot_count = slot_count;
+  header.import_count = builder.import_count;
+  header.string_size = builder.string_size;
+  
+  /* write header, records, index, imports and strings */
+  file = fopen(tmp_path, "wb");
+  ok = (file != NULL);
+  
+  if (ok) {
+    ok = (fwrite(&header, sizeof(depdb_header_t), 1, file) == 1) &&
+      ((builder.record_count == 0) ||
+       (fwrite(builder.record, sizeof(depdb_record_t),
+          builder.record_count, file) == builder.record_count)) &&
+      (fwrite(slot, sizeof(uint32_t), slot_count, file) == slot_count) &&
+      ((builder.import_count == 0) ||
+       (fwrite(builder.import, sizeof(uint32_t),
+          builder.import_count, file) == builder.import_count)) &&
+      ((builder.string_size == 0) ||
+       (fwrite(builder.string, 1, builder.string_size, file) ==
+          builder.string_size));
+    
+    if ((fclose(file) != 0) || NOT(ok) || (rename(tmp_path, path) != 0)) {
+      remove(tmp_path);
+      ok = false;
+    } /* end if */
+  } /* end if */
+  
+  free(tmp_path);
+  free(slot);
+  free(builder.record);
+  free(builder.import);
+  free(builder.string);
+  
+  if (NOT(ok)) {
+    SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_IO_ERROR);
+    return;
+  } /* end if */
+  
+  db->dirty = false;
+  
+  SET_STATUS(status, M2C_MAKE_DEPDB_STATUS_SUCCESS);
+  return;
+} /* end m2c_make_depdb_write */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_close(db)
+ * --------------------------------------------------------------------------
+ * Discards any unwritten updates and deallocates db.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_close (m2c_make_depdb_t *db) {
+  
+  uint_t index;
+  
+  if ((db == NULL) || (*db == NULL)) {
+    return;
+  } /* end if */
+  
+  index = 0;
+  while (index < (*db)->update_count) {
+    free((*db)->update[index].source_path);
+    free((*db)->update[index].imports);
+    index++;
+  } /* end while */
+  
+  free((*db)->update);
+  free((*db)->update_slot);
+  release_file_data(*db);
+  free(*db);
+  
+  *db = NULL;
+  return;
+} /* end m2c_make_depdb_close */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_stat_source(path, source)
+ * --------------------------------------------------------------------------
+ * Passes the modification time and size of the file at path in source.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_stat_source
+  (const char *path, m2c_make_depdb_source_t *source) {
+  
+  file_info_t info;
+  
+  if ((path == NULL) || (source == NULL)) {
+    return false;
+  } /* end if */
+  
+  /* one query of the filesystem per source and run */
+  if (NOT(get_file_info(path, &info)) || (info.type != FILE_TYPE_REGULAR)) {
+    return false;
+  } /* end if */
+  
+  source->mtime = (int64_t) info.timestamp;
+  source->size = (uint64_t) info.size;
+  
+  return true;
+} /* end m2c_make_depdb_stat_source */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_digest_file(path, digest)
+ * --------------------------------------------------------------------------
+ * Passes a digest of the contents of the file at path in digest.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_digest_file
+  (const char *path, m2c_digest_value_t *digest) {
+  
+  FILE *file;
+  char *data;
+  long size;
+  bool ok;
+  
+  if ((path == NULL) || (digest == NULL)) {
+    return false;
+  } /* end if */
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return false;
+  } /* end if */
+  
+  data = malloc((size_t) size + 1);
+  ok = (data != NULL) &&
+    (fread(data, 1, (size_t) size, file) == (size_t) size);
+  
+  fclose(file);
+  
+  if (ok) {
+    *digest = (m2c_digest_value_t) hash_bytes(data, (size_t) size);
+  } /* end if */
+  
+  free(data);
+  return ok;
+} /* end m2c_make_depdb_digest_file */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function read_file_data(db, path)
+ * --------------------------------------------------------------------------
+ * Maps or reads the contents of the file at path into memory and records
+ * them in fields file_data,  file_size and is_mapped of db.  The file is
+ * replaced rather than modified when written,  so it is mapped read-only.
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_depdb_status_t read_file_data
+  (m2c_make_depdb_t db, const char *path) {
+  
+#if (M2C_MAKE_DEPDB_USE_MMAP)
+  struct stat info;
+  void *map;
+  int fd;
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return M2C_MAKE_DEPDB_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fstat(fd, &info) != 0) || NOT(S_ISREG(info.st_mode))) {
+    close(fd);
+    return M2C_MAKE_DEPDB_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) info.st_size < sizeof(depdb_header_t)) {
+    close(fd);
+    return M2C_MAKE_DEPDB_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  
+  if (map == MAP_FAILED) {
+    return M2C_MAKE_DEPDB_STATUS_IO_ERROR;
+  } /* end if */
+  
+  db->file_data = map;
+  db->file_size = (size_t) info.st_size;
+  db->is_mapped = true;
+  
+  return M2C_MAKE_DEPDB_STATUS_SUCCESS;
+#else
+  FILE *file;
+  void *data;
+  long size;
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return M2C_MAKE_DEPDB_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) ||
+      (fseek(file, 0, SEEK_SET) != 0)) {
+    fclose(file);
+    return M2C_MAKE_DEPDB_STATUS_IO_ERROR;
+  } /* end if */
+  
+  if ((size_t) size < sizeof(depdb_header_t)) {
+    fclose(file);
+    return M2C_MAKE_DEPDB_STATUS_INVALID_FILE;
+  } /* end if */
+  
+  /* malloc'd storage is suitably aligned for the records */
+  data = malloc((size_t) size);
+  
+  if (data == NULL) {
+    fclose(file);
+    return M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED;
+  } /* end if */
+  
+  if (fread(data, 1, (size_t) size, file) != (size_t) size) {
+    free(data);
+    fclose(file);
+    return M2C_MAKE_DEPDB_STATUS_IO_ERROR;
+  } /* end if */
+  
+  fclose(file);
+  
+  db->file_data = data;
+  db->file_size = (size_t) size;
+  db->is_mapped = false;
+  
+  return M2C_MAKE_DEPDB_STATUS_SUCCESS;
+#endif
+} /* end read_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private function header_is_valid(db)
+ * --------------------------------------------------------------------------
+ * Copies the header of the file contents of db into field header,  checks
+ * it against this host and version,  checks that the section sizes add up
+ * to the file size  and sets the section pointers of db.  The slot count
+ * must be a power of two exceeding the module count,  the string table must
+ * end in NUL.  Returns true if the file is valid,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool header_is_valid (m2c_make_depdb_t db) {
+  
+  const char *data = (const char *) db->file_data;
+  depdb_header_t *header = &db->header;
+  uint64_t expected_size;
+  
+  memcpy(header, data, sizeof(depdb_header_t));
+  
+  if ((memcmp(header->magic, DEPDB_MAGIC, sizeof(DEPDB_MAGIC)) != 0) ||
+      (header->version != M2C_MAKE_DEPDB_VERSION) ||
+      (header->byte_order != DEPDB_BYTE_ORDER) ||
+      (header->probe != key_for_chars(DEPDB_PROBE, strlen(DEPDB_PROBE)))) {
+    return false;
+  } /* end if */
+  
+  if ((header->slot_count < DEPDB_MIN_SLOT_COUNT) ||
+      ((header->slot_count & (header->slot_count - 1)) != 0) ||
+      (header->slot_count <= header->module_count)) {
+    return false;
+  } /* end if */
+  
+  expected_size = (uint64_t) sizeof(depdb_header_t) +
+    (uint64_t) header->module_count * sizeof(depdb_record_t) +
+    (uint64_t) header->slot_count * sizeof(uint32_t) +
+    (uint64_t) header->import_count * sizeof(uint32_t) +
+    (uint64_t) header->string_size;
+  
+  if (expected_size != (uint64_t) db->file_size) {
+    return false;
+  } /* end if */
+  
+  db->record = (const depdb_record_t *) (data + sizeof(depdb_header_t));
+  db->slot = (const uint32_t *) (db->record + header->module_count);
+  db->import = db->slot + header->slot_count;
+  db->string = (const char *) (db->import + header->import_count);
+  
+  if ((header->string_size > 0) &&
+      (db->string[header->string_size - 1] != ASCII_NUL)) {
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end header_is_valid */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure release_file_data(db)
+ * --------------------------------------------------------------------------
+ * Unmaps or deallocates the file contents of db.
+ * ----------------------------------------------------------------------- */
+
+static void release_file_data (m2c_make_depdb_t db) {
+  
+  if (db->file_data == NULL) {
+    return;
+  } /* end if */
+  
+#if (M2C_MAKE_DEPDB_USE_MMAP)
+  if (db->is_mapped) {
+    munmap(db->file_data, db->file_size);
+  }
+  else {
+    free(db->file_data);
+  } /* end if */
+#else
+  free(db->file_data);
+#endif
+  
+  db->file_data = NULL;
+  db->file_size = 0;
+  
+  return;
+} /* end release_file_data */
+
+
+/* --------------------------------------------------------------------------
+ * private function string_at(db, offset)
+ * --------------------------------------------------------------------------
+ * Returns the string at offset in the string table of db,  or NULL if
+ * offset is out of range.
+ * ----------------------------------------------------------------------- */
+
+static const char *string_at (m2c_make_depdb_t db, uint32_t offset) {
+  
+  if (offset >= db->header.string_size) {
+    return NULL;
+  } /* end if */
+  
+  return db->string + offset;
+} /* end string_at */
+
+
+/* --------------------------------------------------------------------------
+ * private function record_for_module(db, module)
+ * --------------------------------------------------------------------------
+ * Returns the file record of module in db,  or NULL if there is none.  The
+ * probe sequence is bounded by the slot count,  a corrupt index cannot loop.
+ * ----------------------------------------------------------------------- */
+
+static const depdb_record_t *record_for_module
+  (m2c_make_depdb_t db, intstr_t module) {
+  
+  const depdb_record_t *record;
+  const char *chars, *ident;
+  uint32_t key, index, mask, probes, number;
+  uint_t length;
+  
+  if (db->header.module_count == 0) {
+    return NULL;
+  } /* end if */
+  
+  chars = intstr_char_ptr(module);
+  length = intstr_length(module);
+  key = key_for_chars(chars, length);
+  mask = db->header.slot_count - 1;
+  index = key & mask;
+  
+  probes = 0;
+  while ((db->slot[index] != 0) && (probes < db->header.slot_count)) {
+    number = db->slot[index] - 1;
+    
+    if (number < db->header.module_count) {
+      record = &db->record[number];
+      ident = string_at(db, record->ident);
+      
+      if ((record->key == key) && (ident != NULL) &&
+          (strncmp(ident, chars, length) == 0) &&
+          (ident[length] == ASCII_NUL)) {
+        return record;
+      } /* end if */
+    } /* end if */
+    
+    index = (index + 1) & mask;
+    probes++;
+  } /* end while */
+  
+  return NULL;
+} /* end record_for_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function update_for_module(db, module)
+ * --------------------------------------------------------------------------
+ * Returns the index of the updated entry of module in db,  or the update
+ * count of db if there is none.
+ * ----------------------------------------------------------------------- */
+
+static uint_t update_for_module (m2c_make_depdb_t db, intstr_t module) {
+  
+  uint_t index, mask;
+  
+  if (db->update_count == 0) {
+    return 0;
+  } /* end if */
+  
+  mask = db->update_slot_count - 1;
+  index = intstr_hash(module) & mask;
+  
+  while (db->update_slot[index] != 0) {
+    if (db->update[db->update_slot[index] - 1].module == module) {
+      return db->update_slot[index] - 1;
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return db->update_count;
+} /* end update_for_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_update(db, module)
+ * --------------------------------------------------------------------------
+ * Appends an empty updated entry for module to db,  enters it into the
+ * update index and returns its index.  Returns the update count of db if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static uint_t add_update (m2c_make_depdb_t db, intstr_t module) {
+  
+  uint_t index, slot, mask;
+  
+  if (NOT(grow_update_table(db))) {
+    return db->update_count;
+  } /* end if */
+  
+  index = db->update_count;
+  db->update[index].module = module;
+  db->update[index].source_path = NULL;
+  db->update[index].import_count = 0;
+  db->update[index].imports = NULL;
+  db->update_count++;
+  
+  mask = db->update_slot_count - 1;
+  slot = intstr_hash(module) & mask;
+  
+  while (db->update_slot[slot] != 0) {
+    slot = (slot + 1) & mask;
+  } /* end while */
+  
+  db->update_slot[slot] = index + 1;
+  
+  return index;
+} /* end add_update */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_update_table(db)
+ * --------------------------------------------------------------------------
+ * Makes room in the update tables of db for one more entry,  doubling the
+ * entry capacity and the slot count as needed and reentering all entries
+ * into the index.  Returns false if allocation failed,  leaving the tables
+ * unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_update_table (m2c_make_depdb_t db) {
+  
+  depdb_update_t *new_update;
+  uint_t *new_slot, new_capacity, new_slot_count, index, slot, mask;
+  
+  if (db->update_count == db->update_capacity) {
+    new_capacity = (db->update_capacity == 0) ?
+      DEPDB_MIN_SLOT_COUNT : 2 * db->update_capacity;
+    new_update = realloc(db->update, new_capacity * sizeof(depdb_update_t));
+    
+    if (new_update == NULL) {
+      return false;
+    } /* end if */
+    
+    db->update = new_update;
+    db->update_capacity = new_capacity;
+  } /* end if */
+  
+  /* keep the index at most half full */
+  if (2 * (db->update_count + 1) <= db->update_slot_count) {
+    return true;
+  } /* end if */
+  
+  new_slot_count = (db->update_slot_count == 0) ?
+    2 * DEPDB_MIN_SLOT_COUNT : 2 * db->update_slot_count;
+  new_slot = calloc(new_slot_count, sizeof(uint_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  mask = new_slot_count - 1;
+  index = 0;
+  while (index < db->update_count) {
+    slot = intstr_hash(db->update[index].module) & mask;
+    while (new_slot[slot] != 0) {
+      slot = (slot + 1) & mask;
+    } /* end while */
+    new_slot[slot] = index + 1;
+    index++;
+  } /* end while */
+  
+  free(db->update_slot);
+  db->update_slot = new_slot;
+  db->update_slot_count = new_slot_count;
+  
+  return true;
+} /* end grow_update_table */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure add_entry(builder, module, source_path, source)
+ * --------------------------------------------------------------------------
+ * Appends a record for module to builder,  its imports are to be appended
+ * to the import table of builder next.  The import count of the record is
+ * that of the import table at the time of the call.
+ * ----------------------------------------------------------------------- */
+
+static void add_entry
+  (depdb_builder_t *builder, intstr_t module, const char *source_path,
+   const m2c_make_depdb_source_t *source) {
+  
+  depdb_record_t *record;
+  
+  record = &builder->record[builder->record_count];
+  record->mtime = source->mtime;
+  record->size = source->size;
+  record->key = key_for_chars(intstr_char_ptr(module), intstr_length(module));
+  record->ident = add_ident(builder, module);
+  record->source = add_chars(builder, source_path, strlen(source_path));
+  record->digest = source->digest;
+  record->first_import = builder->import_count;
+  record->import_count = 0;
+  
+  builder->record_count++;
+  
+  return;
+} /* end add_entry */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_ident(builder, ident)
+ * --------------------------------------------------------------------------
+ * Returns the offset of ident in the string table of builder,  adding it on
+ * first use.  Sets the failed flag of builder if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t add_ident (depdb_builder_t *builder, intstr_t ident) {
+  
+  uint_t index, mask;
+  
+  mask = builder->slot_count - 1;
+  index = intstr_hash(ident) & mask;
+  
+  while (builder->ident_slot[index] != NULL) {
+    if (builder->ident_slot[index] == ident) {
+      return builder->offset_slot[index];
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  builder->ident_slot[index] = ident;
+  builder->offset_slot[index] =
+    add_chars(builder, intstr_char_ptr(ident), intstr_length(ident));
+  
+  return builder->offset_slot[index];
+} /* end add_ident */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_chars(builder, chars, length)
+ * --------------------------------------------------------------------------
+ * Appends length characters of chars and a NUL terminator to the string
+ * table of builder and returns their offset.  Sets the failed flag of
+ * builder if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t add_chars
+  (depdb_builder_t *builder, const char *chars, uint_t length) {
+  
+  uint32_t offset, new_capacity;
+  char *new_string;
+  
+  if (builder->string_size + length + 1 > builder->string_capacity) {
+    new_capacity = (builder->string_capacity == 0) ?
+      4096 : 2 * builder->string_capacity;
+    
+    while (builder->string_size + length + 1 > new_capacity) {
+      new_capacity = 2 * new_capacity;
+    } /* end while */
+    
+    new_string = realloc(builder->string, new_capacity);
+    
+    if (new_string == NULL) {
+      builder->failed = true;
+      return 0;
+    } /* end if */
+    
+    builder->string = new_string;
+    builder->string_capacity = new_capacity;
+  } /* end if */
+  
+  offset = builder->string_size;
+  memcpy(builder->string + offset, chars, length);
+  builder->string[offset + length] = ASCII_NUL;
+  builder->string_size = offset + length + 1;
+  
+  return offset;
+} /* end add_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_index(record, count, slot_count)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated hash index for count records,  passes its slot
+ * count in slot_count.  Returns NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t *new_index
+  (const depdb_record_t *record, uint32_t count, uint32_t *slot_count) {
+  
+  uint32_t *slot, index, number, mask;
+  
+  *slot_count = power_of_two_above(2 * count);
+  
+  if (*slot_count < DEPDB_MIN_SLOT_COUNT) {
+    *slot_count = DEPDB_MIN_SLOT_COUNT;
+  } /* end if */
+  
+  slot = calloc(*slot_count, sizeof(uint32_t));
+  
+  if (slot == NULL) {
+    return NULL;
+  } /* end if */
+  
+  mask = *slot_count - 1;
+  number = 0;
+  while (number < count) {
+    index = record[number].key & mask;
+    while (slot[index] != 0) {
+      index = (index + 1) & mask;
+    } /* end while */
+    slot[index] = number + 1;
+    number++;
+  } /* end while */
+  
+  return slot;
+} /* end new_index */
+
+
+/* --------------------------------------------------------------------------
+ * private function key_for_chars(chars, length)
+ * --------------------------------------------------------------------------
+ * Returns the hash key of length characters of chars.
+ * ----------------------------------------------------------------------- */
+
+static uint32_t key_for_chars (const char *chars, uint_t length) {
+  return hash_bytes(chars, length);
+} /* end key_for_chars */
+
+
+/* --------------------------------------------------------------------------
+ * private function power_of_two_above(value)
+ * --------------------------------------------------------------------------
+ * Returns the least power of two not less than value,  at least one.
+ * ----------------------------------------------------------------------- */
+
+static uint_t power_of_two_above (uint_t value) {
+  
+  uint_t result;
+  
+  result = 1;
+  while (result < value) {
+    result = 2 * result;
+  } /* end while */
+  
+  return result;
+} /* end power_of_two_above */
+
+
+/* END OF FILE */
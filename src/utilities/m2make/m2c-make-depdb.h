@@ -0,0 +1,273 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-depdb.h                                                          *
+ *                                                                           *
+ * Public interface of m2make dependency database.                           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_DEPDB_H
+#define M2C_MAKE_DEPDB_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-digest.h"
+#include "m2c-dep-file.h"
+#include "interned-strings.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Dependency database
+ * --------------------------------------------------------------------------
+ * A dependency database holds  for every module of a tree  its identifier,
+ * the path of its source file,  the modification time,  size  and content
+ * digest of the source as of its last scan,  and the identifiers of the
+ * modules it imports.  It replaces reading and parsing one dependency file
+ * per module on every run of m2make.
+ *
+ * The database is a single binary file  that is mapped into memory where
+ * mmap() is available  and used in place,  modules are found through a hash
+ * index stored in the file.  A run that changes nothing thus takes one
+ * lookup and one file status query per module.  Updated entries are held in
+ * memory  and written back together with all unchanged entries.  The file
+ * is replaced atomically,  a concurrent reader sees the old or new file.
+ *
+ * The file is in host byte order,  files written on a host of different
+ * byte order or word size,  or by a different version,  are rejected and
+ * must be rebuilt by scanning all sources.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Name of the database file within the dependency directory
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_DEPDB_FILE "m2make.depdb"
+
+
+/* --------------------------------------------------------------------------
+ * Version of the database format
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_DEPDB_VERSION 1
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_make_depdb_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing an open dependency database.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_make_depdb_s *m2c_make_depdb_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_depdb_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on dependency databases.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MAKE_DEPDB_STATUS_SUCCESS,
+  M2C_MAKE_DEPDB_STATUS_INVALID_REFERENCE,
+  M2C_MAKE_DEPDB_STATUS_FILE_NOT_FOUND,
+  M2C_MAKE_DEPDB_STATUS_INVALID_FILE,
+  M2C_MAKE_DEPDB_STATUS_IO_ERROR,
+  M2C_MAKE_DEPDB_STATUS_ALLOCATION_FAILED
+} m2c_make_depdb_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_depdb_source_t
+ * --------------------------------------------------------------------------
+ * Record type for the source attributes of a module.  Field mtime holds the
+ * modification time as returned by get_filetime,  field size the size in
+ * bytes,  field digest the content digest of the source file,  see function
+ * m2c_make_depdb_digest_file.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* mtime */   int64_t mtime;
+  /* size */    uint64_t size;
+  /* digest */  m2c_digest_value_t digest;
+} m2c_make_depdb_source_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_open(path, status)
+ * --------------------------------------------------------------------------
+ * Opens the dependency database at path and returns it.  If the file does
+ * not exist or is not a valid database of this host and version,  returns
+ * an empty database  and passes M2C_MAKE_DEPDB_STATUS_FILE_NOT_FOUND  or
+ * M2C_MAKE_DEPDB_STATUS_INVALID_FILE in status.  Only the header and the
+ * section sizes are checked on open.
+ * Returns NULL if path is NULL or allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_depdb_t m2c_make_depdb_open
+  (const char *path, m2c_make_depdb_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_module_count(db)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules in db,  including updated entries.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_depdb_module_count (m2c_make_depdb_t db);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_lookup(db, module, source_path, source)
+ * --------------------------------------------------------------------------
+ * Looks up module in db.  Returns true if found,  passes the path of its
+ * source file in source_path and its source attributes in source.  The path
+ * is valid until db is written or closed.  Returns false if there is no
+ * entry for module.  Source_path and source may be NULL.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_lookup
+  (m2c_make_depdb_t db,                  /* in */
+   intstr_t module,                 /* in */
+   const char **source_path,        /* out */
+   m2c_make_depdb_source_t *source);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_is_current(db, module)
+ * --------------------------------------------------------------------------
+ * Returns true if db has an entry for module  and the modification time and
+ * size of its source file are those recorded,  otherwise false.  Callers
+ * rescan the source of a module that is not current,  unless its content
+ * digest is unchanged,  in which case only its attributes are updated.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_is_current (m2c_make_depdb_t db, intstr_t module);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_read_imports(db, module, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Passes the number of modules imported by module in db in count  and a
+ * newly allocated array with their identifiers in imports,  or NULL if there
+ * are none or on failure,  like procedure m2c_read_dep_file.  The caller
+ * deallocates the array with free().  Passes M2C_DEP_FILE_STATUS_FILE_NOT_
+ * FOUND in status if db has no entry for module.  Parameter db is passed as
+ * a pointer to void  so that the procedure can serve as an import reader.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_read_imports
+  (const void *db,                   /* in */
+   intstr_t module,                  /* in */
+   uint_t *count,                    /* out */
+   intstr_t **imports,               /* out */
+   m2c_dep_file_status_t *status);   /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_update(db, module, path, source, count, ...)
+ * --------------------------------------------------------------------------
+ * Records in db the source file path and source attributes of module  and
+ * the count modules it imports in array imports,  replacing any previous
+ * entry.  The update is held in memory until db is written.  Passes the
+ * status of the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_update
+  (m2c_make_depdb_t db,                      /* in */
+   intstr_t module,                     /* in */
+   const char *source_path,             /* in */
+   const m2c_make_depdb_source_t *source,    /* in */
+   uint_t count,                        /* in */
+   const intstr_t imports[],            /* in */
+   m2c_make_depdb_status_t *status);         /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_write(db, path, status)
+ * --------------------------------------------------------------------------
+ * Writes db to a database file at path  if db has been updated since it was
+ * opened or last written,  otherwise leaves the file untouched.  The file is
+ * written under a temporary name and then renamed.  Passes the status of
+ * the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_write
+  (m2c_make_depdb_t db,                   /* in */
+   const char *path,                 /* in */
+   m2c_make_depdb_status_t *status);      /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_depdb_close(db)
+ * --------------------------------------------------------------------------
+ * Discards any unwritten updates,  unmaps or deallocates db and passes NULL
+ * in db.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_depdb_close (m2c_make_depdb_t *db);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_stat_source(path, source)
+ * --------------------------------------------------------------------------
+ * Passes the modification time and size of the file at path in source,
+ * leaving its digest unchanged.  Returns true on success,  false if the
+ * file does not exist or is not a regular file.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_stat_source
+  (const char *path, m2c_make_depdb_source_t *source);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_depdb_digest_file(path, digest)
+ * --------------------------------------------------------------------------
+ * Passes a digest of the contents of the file at path in digest.  Returns
+ * true on success,  false if the file cannot be read.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_depdb_digest_file
+  (const char *path, m2c_digest_value_t *digest);
+
+
+#endif /* M2C_MAKE_DEPDB_H */
+
+/* END OF FILE */
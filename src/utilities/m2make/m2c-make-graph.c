@@ -0,0 +1,1664 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-graph.c                                                          *
+ *                                                                           *
+ * Implementation of m2make build graph and scheduler.                       *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#endif
+
+#include "m2c-make-graph.h"
+#include "m2c-dep-file.h"
+#include "m2c-trace.h"
+
+#include <time.h>
+#include <stdlib.h>
+
+#if (M2C_MAKE_PARALLEL)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities of node and edge tables while loading a graph
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_NODE_CAPACITY 64
+
+#define INITIAL_EDGE_CAPACITY 256
+
+
+/* --------------------------------------------------------------------------
+ * Initial number of slots of the node lookup table,  a power of two
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_SLOT_COUNT (2 * INITIAL_NODE_CAPACITY)
+
+
+/* --------------------------------------------------------------------------
+ * private type import_reader_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure that reads the imports of module from source,  with
+ * the parameters and results of procedure m2c_read_dep_file.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*import_reader_t)
+  (const void *source, intstr_t module,
+   uint_t *count, intstr_t **imports, m2c_dep_file_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * private type node_t
+ * --------------------------------------------------------------------------
+ * Record type for a node of a build graph.  The imports of a node are held
+ * contiguously in the import table of its graph,  its dependents,  that is
+ * the nodes importing it,  are held contiguously in the dependent table.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* module */           intstr_t module;
+  /* first_import */     uint_t first_import;
+  /* import_count */     uint_t import_count;
+  /* first_dependent */  uint_t first_dependent;
+  /* dependent_count */  uint_t dependent_count;
+} node_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_make_graph_s
+ * --------------------------------------------------------------------------
+ * Record type representing the import graph of a program.  The slot table
+ * maps interned module identifiers to nodes by open addressing with linear
+ * probing,  a slot holds its node plus one,  or zero if it is free.  The
+ * slot count is a power of two and at least twice the node count.  Field
+ * order holds the build order once the graph is found to be acyclic.  The
+ * priority and duration tables hold an entry for every node.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_make_graph_s {
+  /* node_count */  uint_t node_count;
+  /* edge_count */  uint_t edge_count;
+  /* slot_count */  uint_t slot_count;
+  /* node */        node_t *node;
+  /* import */      uint_t *import;
+  /* dependent */   uint_t *dependent;
+  /* slot */        uint_t *slot;
+  /* order */       uint_t *order;
+  /* priority */    uint_t *priority;
+  /* duration */    uint_t *duration;
+};
+
+typedef struct m2c_make_graph_s m2c_make_graph_s;
+
+
+/* --------------------------------------------------------------------------
+ * private type scc_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a node during the search for strongly
+ * connected components.  Field index is the visiting order of the node,
+ * field lowlink the lowest index reachable,  next_import the position of
+ * the next import to follow.  Field component is the component of the node
+ * once it is complete,  field parent its predecessor while searching for a
+ * cycle within its component.  Unset fields hold the node count.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* index */        uint_t index;
+  /* lowlink */      uint_t lowlink;
+  /* next_import */  uint_t next_import;
+  /* component */    uint_t component;
+  /* parent */       uint_t parent;
+} scc_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type scc_search_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a call to function m2c_make_check_cycles.
+ * Field scc_stack holds the visited nodes not yet assigned to a component,
+ * field call_stack the nodes whose imports are being followed.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* graph */        m2c_make_graph_t graph;
+  /* handler */      m2c_make_cycle_handler_t handler;
+  /* context */      void *context;
+  /* entry */        scc_entry_t *entry;
+  /* scc_stack */    uint_t *scc_stack;
+  /* scc_depth */    uint_t scc_depth;
+  /* call_stack */   uint_t *call_stack;
+  /* call_depth */   uint_t call_depth;
+  /* queue */        uint_t *queue;
+  /* path */         uint_t *path;
+  /* order */        uint_t *order;
+  /* order_count */  uint_t order_count;
+  /* counter */      uint_t counter;
+  /* components */   uint_t components;
+  /* cycles */       uint_t cycles;
+} scc_search_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type ready_queue_t
+ * --------------------------------------------------------------------------
+ * Record type for the queue of ready nodes owned by a worker,  a binary
+ * max-heap on node priority.  The node of highest priority is in slot zero,
+ * the children of slot i are in slots 2i+1 and 2i+2.  Every node is queued
+ * once,  a slot table of node count entries suffices.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* slot */    uint_t *slot;
+  /* count */   uint_t count;
+#if (M2C_MAKE_PARALLEL)
+  /* lock */    pthread_mutex_t lock;
+#endif
+} ready_queue_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type run_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the state shared by the workers of a call to procedure
+ * m2c_make_run.  Field pending holds the number of unbuilt imports of each
+ * node,  field ready_count the number of queued nodes not yet claimed.
+ * Field jobserver is the jobserver of the run,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* graph */        m2c_make_graph_t graph;
+  /* jobserver */    m2c_jobserver_t jobserver;
+  /* handler */      m2c_make_job_handler_t handler;
+  /* context */      void *context;
+  /* workers */      uint_t workers;
+  /* queue */        ready_queue_t *queue;
+  /* pending */      uint_t *pending;
+  /* ready_count */  uint_t ready_count;
+  /* unfinished */   uint_t unfinished;
+  /* failed */       bool failed;
+  /* failed_node */  uint_t failed_node;
+#if (M2C_MAKE_PARALLEL)
+  /* lock */         pthread_mutex_t lock;
+  /* wakeup */       pthread_cond_t wakeup;
+#endif
+} run_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * private type worker_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the arguments of a single worker.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* run */     run_context_t *run;
+  /* worker */  uint_t worker;
+} worker_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_graph_t load_closure
+  (intstr_t program_id, import_reader_t reader, const void *source,
+   intstr_t *failed_module, m2c_make_status_t *status);
+
+static void read_dep_dir
+  (const void *dep_dir, intstr_t module,
+   uint_t *count, intstr_t **imports, m2c_dep_file_status_t *status);
+
+static uint_t find_or_add_node
+  (m2c_make_graph_t graph, uint_t *capacity, intstr_t module);
+
+static bool add_edge
+  (m2c_make_graph_t graph, uint_t *capacity, uint_t target);
+
+static bool grow_slot_table (m2c_make_graph_t graph);
+
+static bool link_dependents (m2c_make_graph_t graph);
+
+static void search_from (scc_search_t *search, uint_t root);
+
+static void visit_node (scc_search_t *search, uint_t node);
+
+static void complete_component (scc_search_t *search, uint_t root);
+
+static uint_t find_cycle
+  (scc_search_t *search, uint_t root, uint_t component);
+
+static uint_t default_thread_count (void);
+
+static uint_t wall_clock_ms (void);
+
+static void queue_node
+  (m2c_make_graph_t graph, ready_queue_t *queue, uint_t node);
+
+static uint_t remove_top (m2c_make_graph_t graph, ready_queue_t *queue);
+
+static uint_t take_node (run_context_t *run, uint_t worker);
+
+static uint_t next_ready_node (run_context_t *run, uint_t worker);
+
+static void complete_node
+  (run_context_t *run, uint_t worker, uint_t node, bool success);
+
+static void *make_worker (void *arg);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_load_graph(program_id, dep_dir, failed_module, status)
+ * --------------------------------------------------------------------------
+ * Reads the dependency files in directory dep_dir  for the import closure of
+ * program module program_id  and returns a new graph with a node for every
+ * module and an edge for every import.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_graph_t m2c_make_load_graph
+  (intstr_t program_id,            /* in */
+   const char *dep_dir,            /* in */
+   intstr_t *failed_module,        /* out */
+   m2c_make_status_t *status) {    /* out */
+  
+  if (dep_dir == NULL) {
+    SET_STATUS(failed_module, NULL);
+    SET_STATUS(status, M2C_MAKE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  return load_closure
+    (program_id, read_dep_dir, dep_dir, failed_module, status);
+} /* end m2c_make_load_graph */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_load_graph_from_db(program_id, db, failed_module, ...)
+ * --------------------------------------------------------------------------
+ * Reads the imports for the import closure of program module program_id
+ * from dependency database db and returns a new graph.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_graph_t m2c_make_load_graph_from_db
+  (intstr_t program_id,            /* in */
+   m2c_make_depdb_t db,            /* in */
+   intstr_t *failed_module,        /* out */
+   m2c_make_status_t *status) {    /* out */
+  
+  if (db == NULL) {
+    SET_STATUS(failed_module, NULL);
+    SET_STATUS(status, M2C_MAKE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  return load_closure
+    (program_id, m2c_make_depdb_read_imports, db, failed_module, status);
+} /* end m2c_make_load_graph_from_db */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_count(graph)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in graph,  or zero if graph is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_count (m2c_make_graph_t graph) {
+  
+  if (graph == NULL) {
+    return 0;
+  } /* end if */
+  
+  return graph->node_count;
+} /* end m2c_make_node_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_module(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the module identifier of node in graph,  or NULL if node is out
+ * of range.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_make_node_module (m2c_make_graph_t graph, uint_t node) {
+  
+  if ((graph == NULL) || (node >= graph->node_count)) {
+    return NULL;
+  } /* end if */
+  
+  return graph->node[node].module;
+} /* end m2c_make_node_module */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_import_count(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules imported by node in graph.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_import_count (m2c_make_graph_t graph, uint_t node) {
+  
+  if ((graph == NULL) || (node >= graph->node_count)) {
+    return 0;
+  } /* end if */
+  
+  return graph->node[node].import_count;
+} /* end m2c_make_import_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_import_at_index(graph, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the node of the module imported at index by node in graph.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_import_at_index
+  (m2c_make_graph_t graph, uint_t node, uint_t index) {
+  
+  if (graph == NULL) {
+    return 0;
+  } /* end if */
+  
+  if ((node >= graph->node_count) ||
+      (index >= graph->node[node].import_count)) {
+    return graph->node_count;
+  } /* end if */
+  
+  return graph->import[graph->node[node].first_import + index];
+} /* end m2c_make_import_at_index */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_check_cycles(graph, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Finds the strongly connected components of graph with Tarjan's algorithm
+ * and returns the number of cycles of imports.  Components are completed
+ * after all the components they import,  their completion order is a build
+ * order if graph is acyclic.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_check_cycles
+  (m2c_make_graph_t graph,              /* in */
+   m2c_make_cycle_handler_t handler,    /* in */
+   void *context,                       /* in */
+   m2c_make_status_t *status) {         /* out */
+  
+  scc_search_t search;
+  uint_t node;
+  
+  if (graph == NULL) {
+    SET_STATUS(status, M2C_MAKE_STATUS_INVALID_REFERENCE);
+    return 0;
+  } /* end if */
+  
+  free(graph->order);
+  graph->order = NULL;
+  
+  search.graph = graph;
+  search.handler = handler;
+  search.context = context;
+  search.entry = malloc(graph->node_count * sizeof(scc_entry_t));
+  search.scc_stack = malloc(graph->node_count * sizeof(uint_t));
+  search.scc_depth = 0;
+  search.call_stack = malloc(graph->node_count * sizeof(uint_t));
+  search.call_depth = 0;
+  search.queue = malloc(graph->node_count * sizeof(uint_t));
+  search.path = malloc(graph->node_count * sizeof(uint_t));
+  search.order = malloc(graph->node_count * sizeof(uint_t));
+  search.order_count = 0;
+  search.counter = 0;
+  search.components = 0;
+  search.cycles = 0;
+  
+  if ((search.entry == NULL) || (search.scc_stack == NULL) ||
+      (search.call_stack == NULL) || (search.queue == NULL) ||
+      (search.path == NULL) || (search.order == NULL)) {
+    free(search.entry);
+    free(search.scc_stack);
+    free(search.call_stack);
+    free(search.queue);
+    free(search.path);
+    free(search.order);
+    SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+    return 0;
+  } /* end if */
+  
+  node = 0;
+  while (node < graph->node_count) {
+    search.entry[node].index = graph->node_count;
+    search.entry[node].lowlink = graph->node_count;
+    search.entry[node].next_import = 0;
+    search.entry[node].component = graph->node_count;
+    search.entry[node].parent = graph->node_count;
+    node++;
+  } /* end while */
+  
+  node = 0;
+  while (node < graph->node_count) {
+    if (search.entry[node].index == graph->node_count) {
+      search_from(&search, node);
+    } /* end if */
+    node++;
+  } /* end while */
+  
+  free(search.entry);
+  free(search.scc_stack);
+  free(search.call_stack);
+  free(search.queue);
+  free(search.path);
+  
+  if (search.cycles > 0) {
+    free(search.order);
+    SET_STATUS(status, M2C_MAKE_STATUS_CYCLIC_IMPORTS);
+    return search.cycles;
+  } /* end if */
+  
+  graph->order = search.order;
+  m2c_make_set_priorities(graph, NULL);
+  
+  SET_STATUS(status, M2C_MAKE_STATUS_SUCCESS);
+  return 0;
+} /* end m2c_make_check_cycles */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_build_order_node(graph, index)
+ * --------------------------------------------------------------------------
+ * Returns the node at index in the build order of graph.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_build_order_node (m2c_make_graph_t graph, uint_t index) {
+  
+  if (graph == NULL) {
+    return 0;
+  } /* end if */
+  
+  if ((graph->order == NULL) || (index >= graph->node_count)) {
+    return graph->node_count;
+  } /* end if */
+  
+  return graph->order[index];
+} /* end m2c_make_build_order_node */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_for_module(graph, module)
+ * --------------------------------------------------------------------------
+ * Returns the node of module in graph,  or the node count if there is none.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_for_module (m2c_make_graph_t graph, intstr_t module) {
+  
+  uint_t index, mask;
+  
+  if (graph == NULL) {
+    return 0;
+  } /* end if */
+  
+  mask = graph->slot_count - 1;
+  index = intstr_hash(module) & mask;
+  
+  while (graph->slot[index] != 0) {
+    if (graph->node[graph->slot[index] - 1].module == module) {
+      return graph->slot[index] - 1;
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  return graph->node_count;
+} /* end m2c_make_node_for_module */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_set_priorities(graph, cost)
+ * --------------------------------------------------------------------------
+ * Sets the priority of every node of graph to the longest weighted path of
+ * builds to the program module.  Dependents follow their imports in the
+ * build order,  visiting it backwards sees every dependent first.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_set_priorities (m2c_make_graph_t graph, const uint_t cost[]) {
+  
+  uint_t position, node, index, dependent, longest;
+  
+  if ((graph == NULL) || (graph->order == NULL)) {
+    return false;
+  } /* end if */
+  
+  position = graph->node_count;
+  while (position > 0) {
+    position--;
+    node = graph->order[position];
+    
+    longest = 0;
+    index = 0;
+    while (index < graph->node[node].dependent_count) {
+      dependent =
+        graph->dependent[graph->node[node].first_dependent + index];
+      if (graph->priority[dependent] > longest) {
+        longest = graph->priority[dependent];
+      } /* end if */
+      index++;
+    } /* end while */
+    
+    if (cost == NULL) {
+      graph->priority[node] = longest + 1;
+    }
+    else {
+      graph->priority[node] = longest + cost[node];
+    } /* end if */
+  } /* end while */
+  
+  return true;
+} /* end m2c_make_set_priorities */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_priority(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the priority of node in graph.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_priority (m2c_make_graph_t graph, uint_t node) {
+  
+  if ((graph == NULL) || (node >= graph->node_count)) {
+    return 0;
+  } /* end if */
+  
+  return graph->priority[node];
+} /* end m2c_make_node_priority */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_duration(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the duration of the last handler call for node in milliseconds.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_duration (m2c_make_graph_t graph, uint_t node) {
+  
+  if ((graph == NULL) || (node >= graph->node_count)) {
+    return 0;
+  } /* end if */
+  
+  return graph->duration[node];
+} /* end m2c_make_node_duration */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_worker_count(graph, jobs)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers used to build graph for a requested number
+ * of jobs.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_worker_count (m2c_make_graph_t graph, uint_t jobs) {
+  
+#if (M2C_MAKE_PARALLEL)
+  if (jobs == 0) {
+    jobs = default_thread_count();
+  } /* end if */
+  
+  if (jobs > m2c_make_node_count(graph)) {
+    jobs = m2c_make_node_count(graph);
+  } /* end if */
+  
+  if (jobs == 0) {
+    jobs = 1;
+  } /* end if */
+  
+  return jobs;
+#else
+  (void) graph;
+  (void) jobs;
+  return 1;
+#endif
+} /* end m2c_make_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_run(graph, jobs, jobserver, handler, context, ...)
+ * --------------------------------------------------------------------------
+ * Calls handler for every node of graph on up to jobs workers,  for each
+ * node only after the handlers of all the nodes it imports have returned.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_run
+  (m2c_make_graph_t graph,            /* in */
+   uint_t jobs,                       /* in */
+   m2c_jobserver_t jobserver,         /* in */
+   m2c_make_job_handler_t handler,    /* in */
+   void *context,                     /* in */
+   intstr_t *failed_module,           /* out */
+   m2c_make_status_t *status) {       /* out */
+  
+  run_context_t run;
+  worker_context_t *worker;
+  uint_t *slot, index, workers, next_queue;
+#if (M2C_MAKE_PARALLEL)
+  pthread_t *thread;
+  uint_t started;
+#endif
+  
+  SET_STATUS(failed_module, NULL);
+  
+  if ((graph == NULL) || (handler == NULL)) {
+    SET_STATUS(status, M2C_MAKE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  workers = m2c_make_worker_count(graph, jobs);
+  
+  run.pending = malloc(graph->node_count * sizeof(uint_t));
+  run.queue = malloc(workers * sizeof(ready_queue_t));
+  slot = malloc(workers * graph->node_count * sizeof(uint_t));
+  worker = malloc(workers * sizeof(worker_context_t));
+  
+  if ((run.pending == NULL) || (run.queue == NULL) ||
+      (slot == NULL) || (worker == NULL)) {
+    free(run.pending);
+    free(run.queue);
+    free(slot);
+    free(worker);
+    SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  run.graph = graph;
+  run.jobserver = jobserver;
+  run.handler = handler;
+  run.context = context;
+  run.workers = workers;
+  run.ready_count = 0;
+  run.unfinished = graph->node_count;
+  run.failed = false;
+  run.failed_node = graph->node_count;
+  
+  index = 0;
+  while (index < workers) {
+    run.queue[index].slot = slot + index * graph->node_count;
+    run.queue[index].count = 0;
+#if (M2C_MAKE_PARALLEL)
+    pthread_mutex_init(&run.queue[index].lock, NULL);
+#endif
+    worker[index].run = &run;
+    worker[index].worker = index;
+    index++;
+  } /* end while */
+  
+  /* deal nodes without imports out to all workers */
+  next_queue = 0;
+  index = 0;
+  while (index < graph->node_count) {
+    run.pending[index] = graph->node[index].import_count;
+    graph->duration[index] = 0;
+    
+    if (run.pending[index] == 0) {
+      queue_node(graph, &run.queue[next_queue], index);
+      next_queue = (next_queue + 1) % workers;
+      run.ready_count++;
+    } /* end if */
+    
+    index++;
+  } /* end while */
+  
+#if (M2C_MAKE_PARALLEL)
+  thread = NULL;
+  started = 0;
+  
+  if (workers > 1) {
+    thread = malloc((workers - 1) * sizeof(pthread_t));
+  } /* end if */
+  
+  pthread_mutex_init(&run.lock, NULL);
+  pthread_cond_init(&run.wakeup, NULL);
+  
+  /* start helper threads, the calling thread is worker zero */
+  if (thread != NULL) {
+    while ((started < workers - 1) &&
+      (pthread_create(&thread[started], NULL,
+        make_worker, &worker[started + 1]) == 0)) {
+      started++;
+    } /* end while */
+  } /* end if */
+  
+  /* workers that could not be started leave their nodes to be stolen */
+  make_worker(&worker[0]);
+  
+  /* wait for helper threads to finish */
+  index = 0;
+  while (index < started) {
+    pthread_join(thread[index], NULL);
+    index++;
+  } /* end while */
+  
+  pthread_cond_destroy(&run.wakeup);
+  pthread_mutex_destroy(&run.lock);
+  
+  index = 0;
+  while (index < workers) {
+    pthread_mutex_destroy(&run.queue[index].lock);
+    index++;
+  } /* end while */
+  
+  free(thread);
+#else
+  /* sequential fallback */
+  make_worker(&worker[0]);
+#endif
+  
+  free(run.pending);
+  free(run.queue);
+  free(slot);
+  free(worker);
+  
+  if (run.failed) {
+    SET_STATUS(failed_module, graph->node[run.failed_node].module);
+    SET_STATUS(status, M2C_MAKE_STATUS_JOB_FAILED);
+  }
+  else if (run.unfinished > 0) {
+    SET_STATUS(status, M2C_MAKE_STATUS_CYCLIC_IMPORTS);
+  }
+  else {
+    SET_STATUS(status, M2C_MAKE_STATUS_SUCCESS);
+  } /* end if */
+  
+  return;
+} /* end m2c_make_run */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_release_graph(graph)
+ * --------------------------------------------------------------------------
+ * Deallocates graph and passes NULL in graph.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_release_graph (m2c_make_graph_t *graph) {
+  
+  if ((graph == NULL) || (*graph == NULL)) {
+    return;
+  } /* end if */
+  
+  free((*graph)->node);
+  free((*graph)->import);
+  free((*graph)->dependent);
+  free((*graph)->slot);
+  free((*graph)->order);
+  free((*graph)->priority);
+  free((*graph)->duration);
+  free(*graph);
+  
+  *graph = NULL;
+  return;
+} /* end m2c_make_release_graph */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function load_closure(program_id, reader, source, failed, status)
+ * --------------------------------------------------------------------------
+ * Reads the imports of program module program_id and of every module in its
+ * import closure with reader from source  and returns a new graph with a
+ * node for every module and an edge for every import,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_graph_t load_closure
+  (intstr_t program_id, import_reader_t reader, const void *source,
+   intstr_t *failed_module, m2c_make_status_t *status) {
+  
+  m2c_dep_file_status_t dep_status;
+  uint_t node_capacity, edge_capacity, index, count;
+  uint_t import_index, target;
+  m2c_make_graph_t graph;
+  intstr_t *imports;
+  
+  SET_STATUS(failed_module, NULL);
+  
+  if (program_id == NULL) {
+    SET_STATUS(status, M2C_MAKE_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  graph = malloc(sizeof(m2c_make_graph_s));
+  
+  if (graph == NULL) {
+    SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  node_capacity = INITIAL_NODE_CAPACITY;
+  edge_capacity = INITIAL_EDGE_CAPACITY;
+  
+  graph->node_count = 0;
+  graph->edge_count = 0;
+  graph->slot_count = INITIAL_SLOT_COUNT;
+  graph->node = malloc(node_capacity * sizeof(node_t));
+  graph->import = malloc(edge_capacity * sizeof(uint_t));
+  graph->dependent = NULL;
+  graph->slot = calloc(INITIAL_SLOT_COUNT, sizeof(uint_t));
+  graph->order = NULL;
+  graph->priority = NULL;
+  graph->duration = NULL;
+  
+  if ((graph->node == NULL) || (graph->import == NULL) ||
+      (graph->slot == NULL) ||
+      (find_or_add_node(graph, &node_capacity, program_id) != 0)) {
+    m2c_make_release_graph(&graph);
+    SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  /* nodes are appended as they are discovered,
+   * read dependency files in order of discovery */
+  index = 0;
+  while (index < graph->node_count) {
+    reader(source, graph->node[index].module, &count, &imports, &dep_status);
+    
+    if (dep_status != M2C_DEP_FILE_STATUS_SUCCESS) {
+      SET_STATUS(failed_module, graph->node[index].module);
+      m2c_make_release_graph(&graph);
+      
+      if (dep_status == M2C_DEP_FILE_STATUS_FILE_NOT_FOUND) {
+        SET_STATUS(status, M2C_MAKE_STATUS_DEP_FILE_NOT_FOUND);
+      }
+      else if (dep_status == M2C_DEP_FILE_STATUS_INVALID_FORMAT) {
+        SET_STATUS(status, M2C_MAKE_STATUS_INVALID_DEP_FILE);
+      }
+      else {
+        SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+      } /* end if */
+      
+      return NULL;
+    } /* end if */
+    
+    graph->node[index].first_import = graph->edge_count;
+    graph->node[index].import_count = count;
+  
+    import_index = 0;
+    while (import_index < count) {
+      target =
+        find_or_add_node(graph, &node_capacity, imports[import_index]);
+  
+      if ((target == graph->node_count) ||
+          NOT(add_edge(graph, &edge_capacity, target))) {
+        free(imports);
+        m2c_make_release_graph(&graph);
+        SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+        return NULL;
+      } /* end if */
+  
+      import_index++;
+    } /* end while */
+  
+    free(imports);
+    index++;
+  } /* end while */
+  
+  graph->priority = calloc(graph->node_count, sizeof(uint_t));
+  graph->duration = calloc(graph->node_count, sizeof(uint_t));
+  
+  if ((graph->priority == NULL) || (graph->duration == NULL) ||
+      NOT(link_dependents(graph))) {
+    m2c_make_release_graph(&graph);
+    SET_STATUS(status, M2C_MAKE_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_MAKE_STATUS_SUCCESS);
+  return graph;
+} /* end load_closure */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure read_dep_dir(dep_dir, module, count, imports, status)
+ * --------------------------------------------------------------------------
+ * Import reader for the dependency files in directory dep_dir.  Reads the
+ * binary dependency file of module if there is one,  else its text file.
+ * ----------------------------------------------------------------------- */
+
+static void read_dep_dir
+  (const void *dep_dir, intstr_t module,
+   uint_t *count, intstr_t **imports, m2c_dep_file_status_t *status) {
+  
+  m2c_dep_file_status_t bin_status;
+  
+  m2c_read_dep_bin_file
+    ((const char *) dep_dir, module, count, imports, &bin_status);
+  
+  if (bin_status != M2C_DEP_FILE_STATUS_FILE_NOT_FOUND) {
+    SET_STATUS(status, bin_status);
+    return;
+  } /* end if */
+  
+  m2c_read_dep_file((const char *) dep_dir, module, count, imports, status);
+} /* end read_dep_dir */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_or_add_node(graph, capacity, module)
+ * --------------------------------------------------------------------------
+ * Returns the node of module in graph,  appending a new node if there is
+ * none,  in which case the node table is enlarged as needed and its new
+ * capacity passed back in capacity.  Returns the node count of graph if
+ * allocation failed.  Nodes are looked up by the hash of their interned
+ * identifiers,  in constant expected time.
+ * ----------------------------------------------------------------------- */
+
+static uint_t find_or_add_node
+  (m2c_make_graph_t graph, uint_t *capacity, intstr_t module) {
+  
+  node_t *new_table;
+  uint_t index, mask, node;
+  
+  /* keep the slot table at most half full */
+  if ((2 * (graph->node_count + 1) > graph->slot_count) &&
+      NOT(grow_slot_table(graph))) {
+    return graph->node_count;
+  } /* end if */
+  
+  mask = graph->slot_count - 1;
+  index = intstr_hash(module) & mask;
+  
+  while (graph->slot[index] != 0) {
+    node = graph->slot[index] - 1;
+    if (graph->node[node].module == module) {
+      return node;
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  if (graph->node_count == *capacity) {
+    new_table = realloc(graph->node, 2 * *capacity * sizeof(node_t));
+    
+    if (new_table == NULL) {
+      return graph->node_count;
+    } /* end if */
+    
+    graph->node = new_table;
+    *capacity = 2 * *capacity;
+  } /* end if */
+  
+  node = graph->node_count;
+  graph->node[node].module = module;
+  graph->node[node].first_import = 0;
+  graph->node[node].import_count = 0;
+  graph->node[node].first_dependent = 0;
+  graph->node[node].dependent_count = 0;
+  graph->node_count++;
+  
+  graph->slot[index] = node + 1;
+  
+  return node;
+} /* end find_or_add_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_slot_table(graph)
+ * --------------------------------------------------------------------------
+ * Doubles the slot count of graph and reenters all its nodes.  Returns false
+ * if allocation failed,  leaving the slot table unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_slot_table (m2c_make_graph_t graph) {
+  
+  uint_t *new_slot;
+  uint_t node, index, mask;
+  
+  new_slot = calloc(2 * graph->slot_count, sizeof(uint_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  free(graph->slot);
+  graph->slot = new_slot;
+  graph->slot_count = 2 * graph->slot_count;
+  mask = graph->slot_count - 1;
+  
+  node = 0;
+  while (node < graph->node_count) {
+    index = intstr_hash(graph->node[node].module) & mask;
+    while (graph->slot[index] != 0) {
+      index = (index + 1) & mask;
+    } /* end while */
+    graph->slot[index] = node + 1;
+    node++;
+  } /* end while */
+  
+  return true;
+} /* end grow_slot_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_edge(graph, capacity, target)
+ * --------------------------------------------------------------------------
+ * Appends target to the import table of graph,  enlarging the table as
+ * needed and passing its new capacity back in capacity.  Returns true on
+ * success,  false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool add_edge
+  (m2c_make_graph_t graph, uint_t *capacity, uint_t target) {
+  
+  uint_t *new_table;
+  
+  if (graph->edge_count == *capacity) {
+    new_table = realloc(graph->import, 2 * *capacity * sizeof(uint_t));
+    
+    if (new_table == NULL) {
+      return false;
+    } /* end if */
+    
+    graph->import = new_table;
+    *capacity = 2 * *capacity;
+  } /* end if */
+  
+  graph->import[graph->edge_count] = target;
+  graph->edge_count++;
+  
+  return true;
+} /* end add_edge */
+
+
+/* --------------------------------------------------------------------------
+ * private function link_dependents(graph)
+ * --------------------------------------------------------------------------
+ * Builds the dependent table of graph from its import table.  Returns true
+ * on success,  false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool link_dependents (m2c_make_graph_t graph) {
+  
+  uint_t node, index, edge, target, first;
+  
+  graph->dependent = malloc((graph->edge_count + 1) * sizeof(uint_t));
+  
+  if (graph->dependent == NULL) {
+    return false;
+  } /* end if */
+  
+  /* count dependents */
+  edge = 0;
+  while (edge < graph->edge_count) {
+    graph->node[graph->import[edge]].dependent_count++;
+    edge++;
+  } /* end while */
+  
+  /* assign table ranges, reset counts for filling */
+  first = 0;
+  node = 0;
+  while (node < graph->node_count) {
+    graph->node[node].first_dependent = first;
+    first = first + graph->node[node].dependent_count;
+    graph->node[node].dependent_count = 0;
+    node++;
+  } /* end while */
+  
+  /* fill ranges */
+  node = 0;
+  while (node < graph->node_count) {
+    index = 0;
+    while (index < graph->node[node].import_count) {
+      target = graph->import[graph->node[node].first_import + index];
+      graph->dependent[graph->node[target].first_dependent +
+        graph->node[target].dependent_count] = node;
+      graph->node[target].dependent_count++;
+      index++;
+    } /* end while */
+    node++;
+  } /* end while */
+  
+  return true;
+} /* end link_dependents */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure search_from(search, root)
+ * --------------------------------------------------------------------------
+ * Visits root and every unvisited node reachable from it,  completing their
+ * components.  Imports are followed on an explicit call stack,  the depth of
+ * long import chains is thus not bounded by the size of the C stack.
+ * ----------------------------------------------------------------------- */
+
+static void search_from (scc_search_t *search, uint_t root) {
+  
+  m2c_make_graph_t graph = search->graph;
+  scc_entry_t *entry = search->entry;
+  uint_t node, caller, target;
+  
+  visit_node(search, root);
+  
+  while (search->call_depth > 0) {
+    node = search->call_stack[search->call_depth - 1];
+    
+    /* follow the next import of node */
+    if (entry[node].next_import < graph->node[node].import_count) {
+      target = graph->import
+        [graph->node[node].first_import + entry[node].next_import];
+      entry[node].next_import++;
+      
+      if (entry[target].index == graph->node_count) {
+        visit_node(search, target);
+      }
+      
+      /* target is visited but its component is incomplete */
+      else if ((entry[target].component == graph->node_count) &&
+               (entry[target].index < entry[node].lowlink)) {
+        entry[node].lowlink = entry[target].index;
+      } /* end if */
+    }
+    
+    /* all imports followed, return to caller */
+    else {
+      search->call_depth--;
+      
+      if (search->call_depth > 0) {
+        caller = search->call_stack[search->call_depth - 1];
+        if (entry[node].lowlink < entry[caller].lowlink) {
+          entry[caller].lowlink = entry[node].lowlink;
+        } /* end if */
+      } /* end if */
+      
+      if (entry[node].lowlink == entry[node].index) {
+        complete_component(search, node);
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  return;
+} /* end search_from */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure visit_node(search, node)
+ * --------------------------------------------------------------------------
+ * Assigns the next index to node and pushes it on both stacks of search.
+ * ----------------------------------------------------------------------- */
+
+static void visit_node (scc_search_t *search, uint_t node) {
+  
+  search->entry[node].index = search->counter;
+  search->entry[node].lowlink = search->counter;
+  search->entry[node].next_import = 0;
+  search->counter++;
+  
+  search->scc_stack[search->scc_depth] = node;
+  search->scc_depth++;
+  
+  search->call_stack[search->call_depth] = node;
+  search->call_depth++;
+  
+  return;
+} /* end visit_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure complete_component(search, root)
+ * --------------------------------------------------------------------------
+ * Pops the component of root from the component stack of search and appends
+ * its nodes to the build order.  If the component is a cycle of imports,
+ * counts it and reports a cycle through root to the handler of search.
+ * ----------------------------------------------------------------------- */
+
+static void complete_component (scc_search_t *search, uint_t root) {
+  
+  m2c_make_graph_t graph = search->graph;
+  uint_t component, node, size, index, length;
+  bool cyclic;
+  
+  component = search->components;
+  search->components++;
+  
+  size = 0;
+  do {
+    search->scc_depth--;
+    node = search->scc_stack[search->scc_depth];
+    search->entry[node].component = component;
+    search->order[search->order_count] = node;
+    search->order_count++;
+    size++;
+  } while (node != root);
+  
+  /* a single node is a cycle only if it imports itself */
+  cyclic = (size > 1);
+  index = 0;
+  while (NOT(cyclic) && (index < graph->node[root].import_count)) {
+    cyclic = (graph->import[graph->node[root].first_import + index] == root);
+    index++;
+  } /* end while */
+  
+  if (NOT(cyclic)) {
+    return;
+  } /* end if */
+  
+  search->cycles++;
+  
+  if (search->handler != NULL) {
+    length = find_cycle(search, root, component);
+    search->handler(graph, length, search->path, search->context);
+  } /* end if */
+  
+  return;
+} /* end complete_component */
+
+
+/* --------------------------------------------------------------------------
+ * private function find_cycle(search, root, component)
+ * --------------------------------------------------------------------------
+ * Searches breadth first within component from root for a node importing
+ * root,  passes a shortest cycle through root in the path of search and
+ * returns its length.  Root must be on a cycle.  Every node belongs to one
+ * component,  all searches together visit every node and import once.
+ * ----------------------------------------------------------------------- */
+
+static uint_t find_cycle
+  (scc_search_t *search, uint_t root, uint_t component) {
+  
+  m2c_make_graph_t graph = search->graph;
+  scc_entry_t *entry = search->entry;
+  uint_t head, tail, node, last, index, target, length;
+  
+  entry[root].parent = root;
+  search->queue[0] = root;
+  head = 0;
+  tail = 1;
+  last = graph->node_count;
+  
+  while (last == graph->node_count) {
+    node = search->queue[head];
+    head++;
+    
+    index = 0;
+    while ((last == graph->node_count) &&
+           (index < graph->node[node].import_count)) {
+      target = graph->import[graph->node[node].first_import + index];
+      
+      if (target == root) {
+        last = node;
+      }
+      else if ((entry[target].component == component) &&
+               (entry[target].parent == graph->node_count)) {
+        entry[target].parent = node;
+        search->queue[tail] = target;
+        tail++;
+      } /* end if */
+      
+      index++;
+    } /* end while */
+  } /* end while */
+  
+  /* count the nodes from last back to root */
+  length = 1;
+  node = last;
+  while (node != root) {
+    node = entry[node].parent;
+    length++;
+  } /* end while */
+  
+  /* fill in the path backwards */
+  index = length;
+  node = last;
+  while (index > 0) {
+    index--;
+    search->path[index] = node;
+    node = entry[node].parent;
+  } /* end while */
+  
+  return length;
+} /* end find_cycle */
+
+
+/* --------------------------------------------------------------------------
+ * private function default_thread_count()
+ * --------------------------------------------------------------------------
+ * Returns the number of online processors,  or one if it is unknown or if
+ * parallel builds are not supported.
+ * ----------------------------------------------------------------------- */
+
+static uint_t default_thread_count (void) {
+  
+#if (M2C_MAKE_PARALLEL) && defined(_SC_NPROCESSORS_ONLN)
+  long cpu_count;
+  
+  cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+  
+  if (cpu_count > 1) {
+    return (uint_t) cpu_count;
+  } /* end if */
+#endif
+  
+  return 1;
+} /* end default_thread_count */
+
+
+/* --------------------------------------------------------------------------
+ * private function wall_clock_ms()
+ * --------------------------------------------------------------------------
+ * Returns the value of a monotonic clock in milliseconds.
+ * ----------------------------------------------------------------------- */
+
+static uint_t wall_clock_ms (void) {
+#if defined(CLOCK_MONOTONIC)
+  struct timespec now;
+  
+  if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+    return (uint_t) (now.tv_sec * 1000 + now.tv_nsec / 1000000);
+  } /* end if */
+#endif
+  
+  return (uint_t) (time(NULL) * 1000);
+} /* end wall_clock_ms */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure queue_node(graph, queue, node)
+ * --------------------------------------------------------------------------
+ * Adds node to queue,  moving it up past all nodes of lower priority.
+ * ----------------------------------------------------------------------- */
+
+static void queue_node
+  (m2c_make_graph_t graph, ready_queue_t *queue, uint_t node) {
+  
+  uint_t index, parent;
+  
+#if (M2C_MAKE_PARALLEL)
+  pthread_mutex_lock(&queue->lock);
+#endif
+  
+  index = queue->count;
+  queue->count++;
+  
+  while ((index > 0) && (graph->priority[node] >
+         graph->priority[queue->slot[(index - 1) / 2]])) {
+    parent = (index - 1) / 2;
+    queue->slot[index] = queue->slot[parent];
+    index = parent;
+  } /* end while */
+  
+  queue->slot[index] = node;
+  
+#if (M2C_MAKE_PARALLEL)
+  pthread_mutex_unlock(&queue->lock);
+#endif
+  
+  return;
+} /* end queue_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function remove_top(graph, queue)
+ * --------------------------------------------------------------------------
+ * Removes and returns the node of highest priority in queue,  or the node
+ * count of graph if queue is empty.  The caller holds the lock of queue.
+ * ----------------------------------------------------------------------- */
+
+static uint_t remove_top (m2c_make_graph_t graph, ready_queue_t *queue) {
+  
+  uint_t top, last, index, child;
+  
+  if (queue->count == 0) {
+    return graph->node_count;
+  } /* end if */
+  
+  top = queue->slot[0];
+  queue->count--;
+  last = queue->slot[queue->count];
+  
+  /* move last down from the root past all nodes of higher priority */
+  index = 0;
+  child = 1;
+  while (child < queue->count) {
+    if ((child + 1 < queue->count) && (graph->priority[queue->slot[child + 1]]
+        > graph->priority[queue->slot[child]])) {
+      child++;
+    } /* end if */
+    
+    if (graph->priority[queue->slot[child]] <= graph->priority[last]) {
+      child = queue->count;
+    }
+    else {
+      queue->slot[index] = queue->slot[child];
+      index = child;
+      child = 2 * index + 1;
+    } /* end if */
+  } /* end while */
+  
+  queue->slot[index] = last;
+  
+  return top;
+} /* end remove_top */
+
+
+/* --------------------------------------------------------------------------
+ * private function take_node(run, worker)
+ * --------------------------------------------------------------------------
+ * Removes and returns the node of highest priority in the queue of worker,
+ * or if it is empty,  the node of highest priority in the first non-empty
+ * queue of another worker.  Returns the node count if all queues are empty.
+ * ----------------------------------------------------------------------- */
+
+static uint_t take_node (run_context_t *run, uint_t worker) {
+  
+  ready_queue_t *queue;
+  uint_t node, offset;
+  
+  node = run->graph->node_count;
+  
+  /* own queue first, then steal from other queues */
+  offset = 0;
+  while ((node == run->graph->node_count) && (offset < run->workers)) {
+    queue = &run->queue[(worker + offset) % run->workers];
+    
+#if (M2C_MAKE_PARALLEL)
+    pthread_mutex_lock(&queue->lock);
+#endif
+    
+    node = remove_top(run->graph, queue);
+    
+#if (M2C_MAKE_PARALLEL)
+    pthread_mutex_unlock(&queue->lock);
+#endif
+    
+    offset++;
+  } /* end while */
+  
+  return node;
+} /* end take_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function next_ready_node(run, worker)
+ * --------------------------------------------------------------------------
+ * Claims a queued node for worker,  waiting until one is queued,  and removes
+ * it from the queues.  Returns the node count once all nodes are built or a
+ * handler has failed.  A claim is taken on ready_count before the queues are
+ * searched,  claimed nodes are never outnumbered by queued nodes.
+ * ----------------------------------------------------------------------- */
+
+static uint_t next_ready_node (run_context_t *run, uint_t worker) {
+  
+  uint_t node;
+  
+#if (M2C_MAKE_PARALLEL)
+  pthread_mutex_lock(&run->lock);
+  
+  while ((run->ready_count == 0) &&
+         (run->unfinished > 0) && NOT(run->failed)) {
+    pthread_cond_wait(&run->wakeup, &run->lock);
+  } /* end while */
+#endif
+  
+  if ((run->ready_count == 0) || run->failed) {
+#if (M2C_MAKE_PARALLEL)
+    pthread_mutex_unlock(&run->lock);
+#endif
+    return run->graph->node_count;
+  } /* end if */
+  
+  run->ready_count--;
+  
+#if (M2C_MAKE_PARALLEL)
+  pthread_mutex_unlock(&run->lock);
+#endif
+  
+  /* another claimant may have taken the node found first, search again */
+  node = take_node(run, worker);
+  while (node == run->graph->node_count) {
+    node = take_node(run, worker);
+  } /* end while */
+  
+  return node;
+} /* end next_ready_node */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure complete_node(run, worker, node, success)
+ * --------------------------------------------------------------------------
+ * Records the outcome of the handler for node.  On success,  every dependent
+ * of node whose imports are now all built is queued on the queue of worker.
+ * On failure,  the failure is recorded unless one has been recorded before.
+ * ----------------------------------------------------------------------- */
+
+static void complete_node
+  (run_context_t *run, uint_t worker, uint_t node, bool success) {
+  
+  m2c_make_graph_t graph = run->graph;
+  uint_t index, dependent;
+  
+#if (M2C_MAKE_PARALLEL)
+  pthread_mutex_lock(&run->lock);
+#endif
+  
+  run->unfinished--;
+  
+  if (NOT(success) && NOT(run->failed)) {
+    run->failed = true;
+    run->failed_node = node;
+  } /* end if */
+  
+  if (success) {
+    index = 0;
+    while (index < graph->node[node].dependent_count) {
+      dependent =
+        graph->dependent[graph->node[node].first_dependent + index];
+      run->pending[dependent]--;
+      
+      if (run->pending[dependent] == 0) {
+        queue_node(graph, &run->queue[worker], dependent);
+        run->ready_count++;
+#if (M2C_MAKE_PARALLEL)
+        pthread_cond_signal(&run->wakeup);
+#endif
+      } /* end if */
+      
+      index++;
+    } /* end while */
+  } /* end if */
+  
+#if (M2C_MAKE_PARALLEL)
+  if (run->failed || (run->unfinished == 0)) {
+    pthread_cond_broadcast(&run->wakeup);
+  } /* end if */
+  
+  pthread_mutex_unlock(&run->lock);
+#endif
+  
+  return;
+} /* end complete_node */
+
+
+/* --------------------------------------------------------------------------
+ * private function make_worker(arg)
+ * --------------------------------------------------------------------------
+ * Claims and builds ready nodes for the worker of worker context arg until
+ * all nodes are built or a handler has failed,  recording the duration of
+ * each build.  Workers other than worker zero hold a jobserver token while
+ * building,  the time spent waiting for it is not counted.  If the job-
+ * server fails,  the node is built without a token.  While a trace is open,
+ * each build is recorded as a span on the lane of the worker.  Always
+ * returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *make_worker (void *arg) {
+  
+  worker_context_t *w = (worker_context_t *) arg;
+  run_context_t *r = w->run;
+  uint_t node, start;
+  bool success, has_token;
+  char token;
+  
+  m2c_trace_name_thread("make worker", w->worker);
+  
+  node = next_ready_node(r, w->worker);
+  
+  while (node < r->graph->node_count) {
+    has_token = false;
+    if ((w->worker > 0) && (r->jobserver != NULL)) {
+      has_token = m2c_jobserver_acquire(r->jobserver, -1, &token);
+    } /* end if */
+    
+    m2c_trace_begin("job", intstr_char_ptr(r->graph->node[node].module));
+    start = wall_clock_ms();
+    success = r->handler(r->graph, node, w->worker, r->context);
+    r->graph->duration[node] = wall_clock_ms() - start;
+    m2c_trace_end("job");
+    
+    if (has_token) {
+      m2c_jobserver_return(r->jobserver, token);
+    } /* end if */
+    
+    /* zero marks nodes not built */
+    if (r->graph->duration[node] == 0) {
+      r->graph->duration[node] = 1;
+    } /* end if */
+    
+    complete_node(r, w->worker, node, success);
+    node = next_ready_node(r, w->worker);
+  } /* end while */
+  
+  return NULL;
+} /* end make_worker */
+
+
+/* END OF FILE */
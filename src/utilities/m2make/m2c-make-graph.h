@@ -0,0 +1,335 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-graph.h                                                          *
+ *                                                                           *
+ * Public interface of m2make build graph and scheduler.                     *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_GRAPH_H
+#define M2C_MAKE_GRAPH_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-make-depdb.h"
+#include "m2c-jobserver.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Parallel scheduling
+ * --------------------------------------------------------------------------
+ * Modules are built on worker threads  if the interned string library is
+ * built with INTSTR_THREAD_SAFE set to 1,  as job handlers intern strings.
+ * This requires POSIX threads.  Otherwise modules are built one after
+ * another by the calling thread,  in an order that respects all imports.
+ *
+ * Each worker owns a queue of ready modules.  A module becomes ready once
+ * all the modules it imports are built,  it is then queued by the worker
+ * that built its last import.  Workers take the module of highest priority
+ * from their own queue  and,  when it is empty,  steal the module of highest
+ * priority from the queue of another worker.  Independent modules of a wide
+ * dependency layer thus build concurrently.
+ *
+ * The priority of a module is the length of the longest path of builds from
+ * the module to the program module,  including both.  Starting the modules
+ * on the critical path first keeps the wall clock time of a build on many
+ * workers close to the length of the critical path.  Lengths are measured
+ * in modules unless build durations recorded by earlier runs are supplied,
+ * see m2c-make-timings.h.
+ *
+ * Workers share a limit of concurrent jobs with the processes they start
+ * through a jobserver,  see m2c-jobserver.h.  Worker zero builds on the
+ * implicit job slot of m2make,  any other worker holds a jobserver token
+ * while it builds a module.  When m2make is run by make,  it connects to
+ * the jobserver of make,  otherwise it runs a jobserver of its own for the
+ * compilers it starts.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_PARALLEL (INTSTR_THREAD_SAFE)
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_make_graph_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing the import graph of a program.  Nodes
+ * are numbered from zero,  the program module is node zero.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_make_graph_s *m2c_make_graph_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on build graphs.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MAKE_STATUS_SUCCESS,
+  M2C_MAKE_STATUS_INVALID_REFERENCE,
+  M2C_MAKE_STATUS_DEP_FILE_NOT_FOUND,
+  M2C_MAKE_STATUS_INVALID_DEP_FILE,
+  M2C_MAKE_STATUS_CYCLIC_IMPORTS,
+  M2C_MAKE_STATUS_JOB_FAILED,
+  M2C_MAKE_STATUS_ALLOCATION_FAILED
+} m2c_make_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_job_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a function that builds the module of node in graph.  Parameter
+ * worker is the index of the calling worker,  in the range zero to the
+ * worker count minus one.  When the handler is called,  the handlers of all
+ * nodes imported by node have returned,  and anything they stored for their
+ * node in context is visible.  Returns true on success,  false on failure.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_make_job_handler_t)
+  (m2c_make_graph_t graph, uint_t node, uint_t worker, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_cycle_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a function that reports a cycle of imports in graph.  Parameter
+ * path holds the length nodes of the cycle,  each importing the next,  the
+ * last node importing the first.  The path is valid only during the call.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_make_cycle_handler_t)
+  (m2c_make_graph_t graph, uint_t length, const uint_t *path, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_load_graph(program_id, dep_dir, failed_module, status)
+ * --------------------------------------------------------------------------
+ * Reads the dependency files in directory dep_dir  for the import closure of
+ * program module program_id  and returns a new graph with a node for every
+ * module and an edge for every import.  Nodes are keyed by their interned
+ * module identifiers.  Cycles of imports are not rejected,  they are found
+ * by function m2c_make_check_cycles.  Returns NULL on failure,  passes the
+ * module whose dependency file could not be read in failed_module  and the
+ * status in status.  Failed_module may be NULL.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_graph_t m2c_make_load_graph
+  (intstr_t program_id,            /* in */
+   const char *dep_dir,            /* in */
+   intstr_t *failed_module,        /* out */
+   m2c_make_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_load_graph_from_db(program_id, db, failed_module, ...)
+ * --------------------------------------------------------------------------
+ * Like function m2c_make_load_graph,  but reads the imports of the modules
+ * from dependency database db.  Passes M2C_MAKE_STATUS_DEP_FILE_NOT_FOUND
+ * in status if a module of the import closure has no entry in db.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_graph_t m2c_make_load_graph_from_db
+  (intstr_t program_id,            /* in */
+   m2c_make_depdb_t db,            /* in */
+   intstr_t *failed_module,        /* out */
+   m2c_make_status_t *status);     /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_count(graph)
+ * --------------------------------------------------------------------------
+ * Returns the number of nodes in graph,  or zero if graph is NULL.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_count (m2c_make_graph_t graph);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_module(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the module identifier of node in graph,  or NULL if node is out
+ * of range.
+ * ----------------------------------------------------------------------- */
+
+intstr_t m2c_make_node_module (m2c_make_graph_t graph, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_import_count(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules imported by node in graph.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_import_count (m2c_make_graph_t graph, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_import_at_index(graph, node, index)
+ * --------------------------------------------------------------------------
+ * Returns the node of the module imported at index by node in graph,  in
+ * the order of its dependency file.  Returns the node count of graph if
+ * node or index is out of range.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_import_at_index
+  (m2c_make_graph_t graph, uint_t node, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_check_cycles(graph, handler, context, status)
+ * --------------------------------------------------------------------------
+ * Finds the strongly connected components of graph in a single pass and
+ * returns the number of cycles of imports,  that is the number of compo-
+ * nents with more than one node or with a node importing itself.  Calls
+ * handler,  unless it is NULL,  for each such component with a shortest
+ * cycle through its first visited node.  If graph is acyclic,  records a
+ * build order in which every node follows the nodes it imports.  Time and
+ * space are linear in the number of nodes and imports.  Passes the status
+ * in status,  M2C_MAKE_STATUS_CYCLIC_IMPORTS if cycles were found.  If
+ * graph is acyclic,  the priorities of its nodes are set for unit costs.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_check_cycles
+  (m2c_make_graph_t graph,              /* in */
+   m2c_make_cycle_handler_t handler,    /* in */
+   void *context,                       /* in */
+   m2c_make_status_t *status);          /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_build_order_node(graph, index)
+ * --------------------------------------------------------------------------
+ * Returns the node at index in the build order of graph recorded by function
+ * m2c_make_check_cycles.  Returns the node count of graph if index is out of
+ * range or no build order has been recorded.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_build_order_node (m2c_make_graph_t graph, uint_t index);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_for_module(graph, module)
+ * --------------------------------------------------------------------------
+ * Returns the node of module in graph,  or the node count of graph if there
+ * is none.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_for_module (m2c_make_graph_t graph, intstr_t module);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_set_priorities(graph, cost)
+ * --------------------------------------------------------------------------
+ * Sets the priority of every node of graph to the longest path of builds
+ * from the node to the program module,  weighing each node by its entry in
+ * array cost,  or by one if cost is NULL.  Returns true on success,  false
+ * if no build order has been recorded for graph.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_set_priorities (m2c_make_graph_t graph, const uint_t cost[]);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_priority(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the priority of node in graph,  or zero if node is out of range.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_priority (m2c_make_graph_t graph, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_node_duration(graph, node)
+ * --------------------------------------------------------------------------
+ * Returns the duration of the handler call for node during the last call to
+ * procedure m2c_make_run on graph in milliseconds,  at least one.  Returns
+ * zero if the handler was not called or node is out of range.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_node_duration (m2c_make_graph_t graph, uint_t node);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_worker_count(graph, jobs)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers used to build graph for a requested number
+ * of jobs.  Zero requests one worker per online processor.  The result is
+ * at most the node count of graph and one if M2C_MAKE_PARALLEL is false.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_worker_count (m2c_make_graph_t graph, uint_t jobs);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_run(graph, jobs, jobserver, handler, context, ...)
+ * --------------------------------------------------------------------------
+ * Calls handler for every node of graph on up to jobs workers,  for each
+ * node only after the handlers of all the nodes it imports have returned.
+ * Workers other than worker zero acquire a token of jobserver for each
+ * call,  if jobserver is not NULL.  The calling thread is worker zero.  Once
+ * a handler fails,  no further handlers are started,  running handlers
+ * complete.  Passes the module of the failed node in failed_module and the
+ * status in status.  Failed_module may be NULL.  Nodes on or above a cycle
+ * of imports are never started,  a graph should be checked with function
+ * m2c_make_check_cycles first.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_run
+  (m2c_make_graph_t graph,            /* in */
+   uint_t jobs,                       /* in */
+   m2c_jobserver_t jobserver,         /* in */
+   m2c_make_job_handler_t handler,    /* in */
+   void *context,                     /* in */
+   intstr_t *failed_module,           /* out */
+   m2c_make_status_t *status);        /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_release_graph(graph)
+ * --------------------------------------------------------------------------
+ * Deallocates graph and passes NULL in graph.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_release_graph (m2c_make_graph_t *graph);
+
+
+#endif /* M2C_MAKE_GRAPH_H */
+
+/* END OF FILE */
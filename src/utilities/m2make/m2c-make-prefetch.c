@@ -0,0 +1,436 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-prefetch.c                                                       *
+ *                                                                           *
+ * Implementation of m2make source prefetching.                              *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* posix_fadvise */
+#endif
+
+#include "m2c-make-prefetch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if (M2C_MAKE_PREFETCH)
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities of the file and path tables
+ * ----------------------------------------------------------------------- */
+
+#define INITIAL_FILE_CAPACITY 64
+
+#define INITIAL_PATH_CAPACITY 4096
+
+
+/* --------------------------------------------------------------------------
+ * private type prefetch_file_t
+ * --------------------------------------------------------------------------
+ * Record type for a file to prefetch.  Field offset is the position of its
+ * NUL terminated path in the path table,  field module the position of the
+ * module reading it in the order modules are started.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* offset */  size_t offset;
+  /* module */  uint_t module;
+} prefetch_file_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_make_prefetch_s
+ * --------------------------------------------------------------------------
+ * Record type representing a prefetcher.  Files are held in the order they
+ * are prefetched,  their paths in a single table.  Field next is the file
+ * to prefetch next,  field started the number of modules started by the
+ * workers.  Fields next,  started and stop are guarded by lock.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_make_prefetch_s {
+  /* window */         uint_t window;
+  /* module_count */   uint_t module_count;
+  /* file_count */     uint_t file_count;
+  /* file_capacity */  uint_t file_capacity;
+  /* file */           prefetch_file_t *file;
+  /* path_length */    size_t path_length;
+  /* path_capacity */  size_t path_capacity;
+  /* path */           char *path;
+  /* next */           uint_t next;
+  /* started */        uint_t started;
+  /* stop */           bool stop;
+  /* running */        bool running;
+#if (M2C_MAKE_PREFETCH)
+  /* lock */           pthread_mutex_t lock;
+  /* wakeup */         pthread_cond_t wakeup;
+  /* thread */         pthread_t thread;
+#endif
+};
+
+typedef struct m2c_make_prefetch_s m2c_make_prefetch_s;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+#if (M2C_MAKE_PREFETCH)
+static void *prefetch_worker (void *arg);
+
+static void prefetch_file (const char *path);
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_new_prefetch(window, status)
+ * --------------------------------------------------------------------------
+ * Returns a new prefetcher that runs window modules ahead of the workers.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_prefetch_t m2c_make_new_prefetch
+  (uint_t window, m2c_make_prefetch_status_t *status) {
+  
+  m2c_make_prefetch_t prefetch;
+  
+  prefetch = malloc(sizeof(m2c_make_prefetch_s));
+  
+  if (prefetch == NULL) {
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  prefetch->window = (window == 0) ? M2C_MAKE_PREFETCH_WINDOW : window;
+  prefetch->module_count = 0;
+  prefetch->file_count = 0;
+  prefetch->file_capacity = INITIAL_FILE_CAPACITY;
+  prefetch->file = malloc(INITIAL_FILE_CAPACITY * sizeof(prefetch_file_t));
+  prefetch->path_length = 0;
+  prefetch->path_capacity = INITIAL_PATH_CAPACITY;
+  prefetch->path = malloc(INITIAL_PATH_CAPACITY);
+  prefetch->next = 0;
+  prefetch->started = 0;
+  prefetch->stop = false;
+  prefetch->running = false;
+  
+  if ((prefetch->file == NULL) || (prefetch->path == NULL)) {
+    free(prefetch->file);
+    free(prefetch->path);
+    free(prefetch);
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+#if (M2C_MAKE_PREFETCH)
+  pthread_mutex_init(&prefetch->lock, NULL);
+  pthread_cond_init(&prefetch->wakeup, NULL);
+#endif
+  
+  SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_SUCCESS);
+  return prefetch;
+} /* end m2c_make_new_prefetch */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_add(prefetch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds a copy of path to the files of the current module of prefetch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_add
+  (m2c_make_prefetch_t prefetch,              /* in */
+   const char *path,                          /* in */
+   m2c_make_prefetch_status_t *status) {      /* out */
+  
+  prefetch_file_t *new_file;
+  size_t length, new_capacity;
+  char *new_path;
+  
+  /* check pre-conditions */
+  if ((prefetch == NULL) || (path == NULL)) {
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (prefetch->running) {
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_ALREADY_STARTED);
+    return;
+  } /* end if */
+  
+  if (prefetch->file_count == prefetch->file_capacity) {
+    new_file = realloc(prefetch->file,
+      2 * prefetch->file_capacity * sizeof(prefetch_file_t));
+    
+    if (new_file == NULL) {
+      SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    prefetch->file = new_file;
+    prefetch->file_capacity = 2 * prefetch->file_capacity;
+  } /* end if */
+  
+  length = strlen(path) + 1;
+  
+  if (prefetch->path_length + length > prefetch->path_capacity) {
+    new_capacity = 2 * prefetch->path_capacity;
+    while (prefetch->path_length + length > new_capacity) {
+      new_capacity = 2 * new_capacity;
+    } /* end while */
+    
+    new_path = realloc(prefetch->path, new_capacity);
+    
+    if (new_path == NULL) {
+      SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    prefetch->path = new_path;
+    prefetch->path_capacity = new_capacity;
+  } /* end if */
+  
+  memcpy(prefetch->path + prefetch->path_length, path, length);
+  
+  prefetch->file[prefetch->file_count].offset = prefetch->path_length;
+  prefetch->file[prefetch->file_count].module = prefetch->module_count;
+  prefetch->file_count++;
+  prefetch->path_length = prefetch->path_length + length;
+  
+  SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_SUCCESS);
+} /* end m2c_make_prefetch_add */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_next_module(prefetch)
+ * --------------------------------------------------------------------------
+ * Completes the current module of prefetch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_next_module (m2c_make_prefetch_t prefetch) {
+  
+  if ((prefetch == NULL) || (prefetch->running)) {
+    return;
+  } /* end if */
+  
+  prefetch->module_count++;
+} /* end m2c_make_prefetch_next_module */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_start(prefetch, status)
+ * --------------------------------------------------------------------------
+ * Starts the background thread of prefetch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_start
+  (m2c_make_prefetch_t prefetch, m2c_make_prefetch_status_t *status) {
+  
+  /* check pre-conditions */
+  if (prefetch == NULL) {
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  if (prefetch->running) {
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_ALREADY_STARTED);
+    return;
+  } /* end if */
+  
+#if (M2C_MAKE_PREFETCH)
+  if (pthread_create(&prefetch->thread,
+      NULL, prefetch_worker, prefetch) != 0) {
+    SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_NOT_AVAILABLE);
+    return;
+  } /* end if */
+  
+  prefetch->running = true;
+  
+  SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_SUCCESS);
+#else
+  SET_STATUS(status, M2C_MAKE_PREFETCH_STATUS_NOT_AVAILABLE);
+#endif
+} /* end m2c_make_prefetch_start */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_advance(prefetch)
+ * --------------------------------------------------------------------------
+ * Moves the window of prefetch on by one module.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_advance (m2c_make_prefetch_t prefetch) {
+  
+  if ((prefetch == NULL) || NOT(prefetch->running)) {
+    return;
+  } /* end if */
+  
+#if (M2C_MAKE_PREFETCH)
+  pthread_mutex_lock(&prefetch->lock);
+  prefetch->started++;
+  pthread_cond_signal(&prefetch->wakeup);
+  pthread_mutex_unlock(&prefetch->lock);
+#endif
+} /* end m2c_make_prefetch_advance */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_release_prefetch(prefetch)
+ * --------------------------------------------------------------------------
+ * Stops the background thread of prefetch and deallocates prefetch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_release_prefetch (m2c_make_prefetch_t *prefetch) {
+  
+  if ((prefetch == NULL) || (*prefetch == NULL)) {
+    return;
+  } /* end if */
+  
+#if (M2C_MAKE_PREFETCH)
+  if ((*prefetch)->running) {
+    pthread_mutex_lock(&(*prefetch)->lock);
+    (*prefetch)->stop = true;
+    pthread_cond_signal(&(*prefetch)->wakeup);
+    pthread_mutex_unlock(&(*prefetch)->lock);
+    
+    pthread_join((*prefetch)->thread, NULL);
+  } /* end if */
+  
+  pthread_cond_destroy(&(*prefetch)->wakeup);
+  pthread_mutex_destroy(&(*prefetch)->lock);
+#endif
+  
+  free((*prefetch)->file);
+  free((*prefetch)->path);
+  free(*prefetch);
+  *prefetch = NULL;
+} /* end m2c_make_release_prefetch */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#if (M2C_MAKE_PREFETCH)
+
+/* --------------------------------------------------------------------------
+ * private function prefetch_worker(arg)
+ * --------------------------------------------------------------------------
+ * Background thread of prefetcher arg.  Prefetches the files of modules
+ * less than window positions ahead of the modules started,  waiting for
+ * the workers to advance once it has caught up,  until all files are
+ * prefetched or it is told to stop.  Always returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *prefetch_worker (void *arg) {
+  
+  m2c_make_prefetch_t prefetch = (m2c_make_prefetch_t) arg;
+  prefetch_file_t *file;
+  
+  pthread_mutex_lock(&prefetch->lock);
+  
+  while (NOT(prefetch->stop) && (prefetch->next < prefetch->file_count)) {
+    file = &prefetch->file[prefetch->next];
+    
+    if (file->module >= prefetch->started + prefetch->window) {
+      pthread_cond_wait(&prefetch->wakeup, &prefetch->lock);
+      continue;
+    } /* end if */
+    
+    prefetch->next++;
+    
+    /* file and path tables are not modified while running */
+    pthread_mutex_unlock(&prefetch->lock);
+    prefetch_file(prefetch->path + file->offset);
+    pthread_mutex_lock(&prefetch->lock);
+  } /* end while */
+  
+  pthread_mutex_unlock(&prefetch->lock);
+  
+  return NULL;
+} /* end prefetch_worker */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure prefetch_file(path)
+ * --------------------------------------------------------------------------
+ * Opens the file at path  and asks the system to read its contents into
+ * the page cache without waiting for the reads.  Opening the file already
+ * fetches its attributes from a network filesystem.  Does nothing if the
+ * file cannot be opened.
+ * ----------------------------------------------------------------------- */
+
+static void prefetch_file (const char *path) {
+  
+  int fd;
+#if !defined(POSIX_FADV_WILLNEED) && defined(F_RDADVISE)
+  struct radvisory advice;
+  struct stat st;
+#endif
+  
+  fd = open(path, O_RDONLY);
+  
+  if (fd < 0) {
+    return;
+  } /* end if */
+  
+#if defined(POSIX_FADV_WILLNEED)
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+  /* macOS lacks posix_fadvise */
+  if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+    advice.ra_offset = 0;
+    advice.ra_count = (st.st_size > INT_MAX) ? INT_MAX : (int) st.st_size;
+    fcntl(fd, F_RDADVISE, &advice);
+  } /* end if */
+#endif
+  
+  close(fd);
+} /* end prefetch_file */
+
+#endif /* M2C_MAKE_PREFETCH */
+
+
+/* END OF FILE */
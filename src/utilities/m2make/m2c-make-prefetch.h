@@ -0,0 +1,183 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-prefetch.h                                                       *
+ *                                                                           *
+ * Public interface of m2make source prefetching.                            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_PREFETCH_H
+#define M2C_MAKE_PREFETCH_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Prefetching
+ * --------------------------------------------------------------------------
+ * m2make knows the modules of a build and the order in which they will be
+ * started before the first one is.  A prefetcher is given the files each
+ * module reads,  its sources and the symbol and export files of its
+ * imports,  in that order,  and a background thread opens them and asks
+ * the system to read them into the page cache  a window of modules ahead
+ * of the workers.  On a network filesystem,  the latency of opening and
+ * reading a file is then spent while earlier modules are being compiled.
+ *
+ * Prefetching is a hint,  files that are missing or cannot be read are
+ * skipped,  and a module started before its files were prefetched simply
+ * reads them itself.
+ *
+ * Prefetching is available on POSIX hosts  if M2C_MAKE_PREFETCH is 1.  On
+ * other hosts,  the operations do nothing.
+ * ----------------------------------------------------------------------- */
+
+#if !defined(M2C_MAKE_PREFETCH)
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_MAKE_PREFETCH 1
+#else
+#define M2C_MAKE_PREFETCH 0
+#endif
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Default number of modules the prefetcher runs ahead of the workers
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_PREFETCH_WINDOW 8
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_make_prefetch_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a prefetcher.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_make_prefetch_s *m2c_make_prefetch_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_prefetch_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on prefetchers.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MAKE_PREFETCH_STATUS_SUCCESS,
+  M2C_MAKE_PREFETCH_STATUS_INVALID_REFERENCE,
+  M2C_MAKE_PREFETCH_STATUS_ALREADY_STARTED,
+  M2C_MAKE_PREFETCH_STATUS_NOT_AVAILABLE,
+  M2C_MAKE_PREFETCH_STATUS_ALLOCATION_FAILED
+} m2c_make_prefetch_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_new_prefetch(window, status)
+ * --------------------------------------------------------------------------
+ * Returns a new prefetcher that runs window modules ahead of the workers,
+ * or M2C_MAKE_PREFETCH_WINDOW modules if window is zero.  Passes the status
+ * in status.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_prefetch_t m2c_make_new_prefetch
+  (uint_t window, m2c_make_prefetch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_add(prefetch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds a copy of path to the files of the current module of prefetch.  A
+ * file read by several modules is best added for the first of them only.
+ * Files may only be added before the prefetcher is started.  Passes the
+ * status in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_add
+  (m2c_make_prefetch_t prefetch,              /* in */
+   const char *path,                          /* in */
+   m2c_make_prefetch_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_next_module(prefetch)
+ * --------------------------------------------------------------------------
+ * Completes the current module of prefetch,  files added from now on are
+ * those of the next module to be started.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_next_module (m2c_make_prefetch_t prefetch);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_start(prefetch, status)
+ * --------------------------------------------------------------------------
+ * Starts the background thread of prefetch,  which prefetches the files of
+ * the first window modules at once.  Passes the status in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_start
+  (m2c_make_prefetch_t prefetch, m2c_make_prefetch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_prefetch_advance(prefetch)
+ * --------------------------------------------------------------------------
+ * Notifies prefetch that a worker has started a module,  which moves the
+ * window on by one module.  Job handlers call it on entry.  Safe to call
+ * from any worker,  and with NULL.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_prefetch_advance (m2c_make_prefetch_t prefetch);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_release_prefetch(prefetch)
+ * --------------------------------------------------------------------------
+ * Stops the background thread of prefetch once the file it is prefetching
+ * is done,  deallocates prefetch and passes NULL in prefetch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_release_prefetch (m2c_make_prefetch_t *prefetch);
+
+
+#endif /* M2C_MAKE_PREFETCH_H */
+
+/* END OF FILE */
@@ -0,0 +1,337 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-stamps.c                                                         *
+ *                                                                           *
+ * Implementation of m2make build stamp module.                              *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-make-stamps.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of the header line of an export list read for its key
+ * ----------------------------------------------------------------------- */
+
+#define MAX_HEADER_LENGTH 255
+
+
+/* --------------------------------------------------------------------------
+ * Length of a fingerprint in hexadecimal notation, 0xHHHHHHHH
+ * ----------------------------------------------------------------------- */
+
+#define KEY_LENGTH 10
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void format_key (m2c_digest_value_t value, char *key);
+
+static char *read_file (const char *path, size_t *length);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_read_fingerprint(exlpath, fingerprint)
+ * --------------------------------------------------------------------------
+ * Reads the interface fingerprint from the header of an export list file.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_read_fingerprint
+  (const char *exlpath, m2c_digest_value_t *fingerprint) {
+  
+  char header[MAX_HEADER_LENGTH + 1], *entry, *end;
+  unsigned long value;
+  FILE *file;
+  
+  if ((exlpath == NULL) || (fingerprint == NULL)) {
+    return false;
+  } /* end if */
+  
+  file = fopen(exlpath, "r");
+  
+  if (file == NULL) {
+    return false;
+  } /* end if */
+  
+  entry = fgets(header, sizeof(header), file);
+  fclose(file);
+  
+  if (entry == NULL) {
+    return false;
+  } /* end if */
+  
+  /* X:Ident; I:*; K:0xHHHHHHHH; */
+  entry = strstr(header, "K:0x");
+  
+  if (entry == NULL) {
+    return false;
+  } /* end if */
+  
+  value = strtoul(entry + 4, &end, 16);
+  
+  if ((end != entry + KEY_LENGTH + 2) || (*end != ';')) {
+    return false;
+  } /* end if */
+  
+  *fingerprint = (m2c_digest_value_t) value;
+  return true;
+} /* end m2c_make_read_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_effective_fingerprint(own, count, imported)
+ * --------------------------------------------------------------------------
+ * Returns the effective fingerprint of a module.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_make_effective_fingerprint
+  (m2c_digest_value_t own,
+   uint_t count,
+   const m2c_digest_value_t imported[]) {
+  
+  char key[KEY_LENGTH + 1];
+  m2c_digest_s digest;
+  uint_t index;
+  
+  if ((count == 0) || (imported == NULL)) {
+    return own;
+  } /* end if */
+  
+  m2c_digest_reset(&digest);
+  
+  format_key(own, key);
+  m2c_digest_add_lexeme(&digest,
+    M2C_DIGEST_DONT_PREPEND_SPACER, intstr_for_cstr(key, NULL));
+  
+  index = 0;
+  while (index < count) {
+    format_key(imported[index], key);
+    m2c_digest_add_lexeme(&digest,
+      M2C_DIGEST_PREPEND_SPACER, intstr_for_cstr(key, NULL));
+    index++;
+  } /* end while */
+  
+  m2c_digest_finalize(&digest);
+  
+  return m2c_digest_value(&digest);
+} /* end m2c_make_effective_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_stamp_is_current(path, count, import_id, fingerprint)
+ * --------------------------------------------------------------------------
+ * Returns true if the stamp file at path records the given imports.  Each
+ * line of a stamp file is of the form  Ident 0xHHHHHHHH.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_stamp_is_current
+  (const char *path,
+   uint_t count,
+   const intstr_t import_id[],
+   const m2c_digest_value_t fingerprint[]) {
+  
+  char key[KEY_LENGTH + 1], *contents;
+  size_t length, pos, id_length;
+  uint_t index;
+  bool current;
+  
+  if ((count > 0) && ((import_id == NULL) || (fingerprint == NULL))) {
+    return false;
+  } /* end if */
+  
+  contents = read_file(path, &length);
+  
+  if (contents == NULL) {
+    return false;
+  } /* end if */
+  
+  current = true;
+  pos = 0;
+  index = 0;
+  while (current && (index < count)) {
+    id_length = intstr_length(import_id[index]);
+    format_key(fingerprint[index], key);
+    
+    /* Ident 0xHHHHHHHH LF */
+    if ((length - pos < id_length + KEY_LENGTH + 2) ||
+      (memcmp(contents + pos, intstr_char_ptr(import_id[index]),
+        id_length) != 0) ||
+      (contents[pos + id_length] != ' ') ||
+      (memcmp(contents + pos + id_length + 1, key, KEY_LENGTH) != 0) ||
+      (contents[pos + id_length + 1 + KEY_LENGTH] != '\n')) {
+      current = false;
+    } /* end if */
+    
+    pos = pos + id_length + KEY_LENGTH + 2;
+    index++;
+  } /* end while */
+  
+  /* no further entries */
+  current = current && (pos == length);
+  
+  free(contents);
+  return current;
+} /* end m2c_make_stamp_is_current */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_write_stamp(path, count, import_id, fingerprint, ...)
+ * --------------------------------------------------------------------------
+ * Writes a stamp file at path recording the given imports.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_write_stamp
+  (const char *path,
+   uint_t count,
+   const intstr_t import_id[],
+   const m2c_digest_value_t fingerprint[],
+   outfile_status_t *status) {
+  
+  char key[KEY_LENGTH + 1];
+  outfile_status_t open_status;
+  outfile_t outfile;
+  uint_t index;
+  
+  if ((count > 0) && ((import_id == NULL) || (fingerprint == NULL))) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  outfile_open_if_changed(&outfile, path, &open_status);
+  
+  if (outfile == NULL) {
+    SET_STATUS(status, open_status);
+    return;
+  } /* end if */
+  
+  /* entries end in LF regardless of the newline mode */
+  index = 0;
+  while (index < count) {
+    format_key(fingerprint[index], key);
+    outfile_write_string(outfile, import_id[index]);
+    outfile_write_char(outfile, ' ');
+    outfile_write_chars(outfile, key);
+    outfile_write_char(outfile, '\n');
+    index++;
+  } /* end while */
+  
+  outfile_close_if_changed(&outfile, NULL, status);
+} /* end m2c_make_write_stamp */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure format_key(value, key)
+ * --------------------------------------------------------------------------
+ * Writes the hexadecimal notation of value to key,  which must have room for
+ * KEY_LENGTH + 1 characters.
+ * ----------------------------------------------------------------------- */
+
+static void format_key (m2c_digest_value_t value, char *key) {
+  snprintf(key, KEY_LENGTH + 1, "0x%08X", (unsigned int) value);
+} /* end format_key */
+
+
+/* --------------------------------------------------------------------------
+ * private function read_file(path, length)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated buffer with the contents of the file at path
+ * and passes its length in length.  Returns NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+static char *read_file (const char *path, size_t *length) {
+  
+  char *buffer, *new_buffer;
+  size_t size, capacity, count;
+  FILE *file;
+  
+  if (path == NULL) {
+    return NULL;
+  } /* end if */
+  
+  file = fopen(path, "rb");
+  
+  if (file == NULL) {
+    return NULL;
+  } /* end if */
+  
+  capacity = 1024;
+  buffer = malloc(capacity);
+  size = 0;
+  
+  while (buffer != NULL) {
+    count = fread(buffer + size, 1, capacity - size, file);
+    size = size + count;
+    
+    if (size < capacity) {
+      break;
+    } /* end if */
+    
+    capacity = 2 * capacity;
+    new_buffer = realloc(buffer, capacity);
+    
+    if (new_buffer == NULL) {
+      free(buffer);
+    } /* end if */
+    
+    buffer = new_buffer;
+  } /* end while */
+  
+  if ((buffer != NULL) && (ferror(file) != 0)) {
+    free(buffer);
+    buffer = NULL;
+  } /* end if */
+  
+  fclose(file);
+  
+  *length = size;
+  return buffer;
+} /* end read_file */
+
+
+/* END OF FILE */
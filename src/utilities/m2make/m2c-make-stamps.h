@@ -0,0 +1,142 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-stamps.h                                                         *
+ *                                                                           *
+ * Public interface of m2make build stamp module.                            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_STAMPS_H
+#define M2C_MAKE_STAMPS_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-digest.h"
+#include "outfile.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Early cutoff
+ * --------------------------------------------------------------------------
+ * A module needs to be rebuilt when an interface it imports changes,  not
+ * when the definition module of that interface is touched.  Export list
+ * files carry the interface fingerprint of their module in header entry K.
+ * Fingerprints are combined along the import graph:  the effective finger-
+ * print of a module is its own fingerprint combined with the effective
+ * fingerprints of the modules it imports,  because generated C headers
+ * include the headers of imported modules.
+ *
+ * After building a module,  m2make records the effective fingerprints of its
+ * imports in a stamp file.  On the next run,  the module is rebuilt only if
+ * its own sources are newer than its products,  or if the recorded finger-
+ * prints differ from the current ones.  Edits to comments,  layout or an
+ * implementation module thus do not trigger rebuilds of importers.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Suffix of stamp files
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_STAMP_SUFFIX ".stamp"
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_read_fingerprint(exlpath, fingerprint)
+ * --------------------------------------------------------------------------
+ * Reads the interface fingerprint from the header of the export list file at
+ * exlpath  and passes it in fingerprint.  Returns true on success,  false if
+ * the file cannot be read or its header has no fingerprint.  Callers treat
+ * a missing fingerprint as changed.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_read_fingerprint
+  (const char *exlpath, m2c_digest_value_t *fingerprint);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_effective_fingerprint(own, count, imported)
+ * --------------------------------------------------------------------------
+ * Returns the effective fingerprint of a module with interface fingerprint
+ * own,  importing count modules with effective fingerprints in array
+ * imported,  in import order.
+ * ----------------------------------------------------------------------- */
+
+m2c_digest_value_t m2c_make_effective_fingerprint
+  (m2c_digest_value_t own,
+   uint_t count,
+   const m2c_digest_value_t imported[]);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_stamp_is_current(path, count, import_id, fingerprint)
+ * --------------------------------------------------------------------------
+ * Returns true if the stamp file at path records exactly the count imports
+ * in array import_id  with the effective fingerprints in array fingerprint,
+ * in order.  Returns false if the file does not exist or differs.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_stamp_is_current
+  (const char *path,
+   uint_t count,
+   const intstr_t import_id[],
+   const m2c_digest_value_t fingerprint[]);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_write_stamp(path, count, import_id, fingerprint, ...)
+ * --------------------------------------------------------------------------
+ * Writes a stamp file at path recording the count imports in array import_id
+ * with the effective fingerprints in array fingerprint.  The file is left
+ * untouched if its contents would not change.  Passes the status of the
+ * operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_write_stamp
+  (const char *path,                        /* in */
+   uint_t count,                            /* in */
+   const intstr_t import_id[],              /* in */
+   const m2c_digest_value_t fingerprint[],  /* in */
+   outfile_status_t *status);               /* out */
+
+
+#endif /* M2C_MAKE_STAMPS_H */
+
+/* END OF FILE */
@@ -0,0 +1,213 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-timings.c                                                        *
+ *                                                                           *
+ * Implementation of m2make build timing history.                            *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-make-timings.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Maximum length of a line of a history file
+ * ----------------------------------------------------------------------- */
+
+#define MAX_LINE_LENGTH 255
+
+
+/* --------------------------------------------------------------------------
+ * Maximum number of decimal digits of a duration
+ * ----------------------------------------------------------------------- */
+
+#define MAX_DURATION_DIGITS 10
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_read_timings(path, graph, cost)
+ * --------------------------------------------------------------------------
+ * Reads the history file at path and passes the cost of every node of graph
+ * in array cost.  Lines that are malformed or list modules outside of graph
+ * are ignored.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_read_timings
+  (const char *path, m2c_make_graph_t graph, uint_t cost[]) {
+  
+  char line[MAX_LINE_LENGTH + 1], *separator, *end;
+  uint_t node, node_count, recorded, mean;
+  unsigned long value;
+  unsigned long long total;
+  FILE *file;
+  
+  if ((graph == NULL) || (cost == NULL)) {
+    return false;
+  } /* end if */
+  
+  node_count = m2c_make_node_count(graph);
+  
+  /* zero marks nodes without a recorded duration */
+  node = 0;
+  while (node < node_count) {
+    cost[node] = 0;
+    node++;
+  } /* end while */
+  
+  file = NULL;
+  if (path != NULL) {
+    file = fopen(path, "r");
+  } /* end if */
+  
+  recorded = 0;
+  total = 0;
+  
+  while ((file != NULL) && (fgets(line, sizeof(line), file) != NULL)) {
+    
+    /* Ident milliseconds LF */
+    separator = strchr(line, ' ');
+    
+    if (separator != NULL) {
+      *separator = ASCII_NUL;
+      value = strtoul(separator + 1, &end, 10);
+      node = m2c_make_node_for_module(graph, intstr_for_cstr(line, NULL));
+      
+      if ((end != separator + 1) && (value > 0) &&
+          (node < node_count) && (cost[node] == 0)) {
+        cost[node] = (uint_t) value;
+        total = total + value;
+        recorded++;
+      } /* end if */
+    } /* end if */
+  } /* end while */
+  
+  if (file != NULL) {
+    fclose(file);
+  } /* end if */
+  
+  /* modules without history cost the mean of the recorded durations */
+  mean = 1;
+  if (recorded > 0) {
+    mean = (uint_t) (total / recorded);
+  } /* end if */
+  
+  node = 0;
+  while (node < node_count) {
+    if (cost[node] == 0) {
+      cost[node] = mean;
+    } /* end if */
+    node++;
+  } /* end while */
+  
+  return (file != NULL);
+} /* end m2c_make_read_timings */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_blend_duration(recorded, measured)
+ * --------------------------------------------------------------------------
+ * Returns the recorded duration updated with a measured duration.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_blend_duration (uint_t recorded, uint_t measured) {
+  
+  if (measured == 0) {
+    return recorded;
+  } /* end if */
+  
+  if (recorded == 0) {
+    return measured;
+  } /* end if */
+  
+  return (uint_t) (((unsigned long long) recorded + 3ULL * measured) / 4);
+} /* end m2c_make_blend_duration */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_write_timings(path, graph, duration, status)
+ * --------------------------------------------------------------------------
+ * Writes a history file at path recording the durations of graph.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_write_timings
+  (const char *path,
+   m2c_make_graph_t graph,
+   const uint_t duration[],
+   outfile_status_t *status) {
+  
+  char digits[MAX_DURATION_DIGITS + 1];
+  outfile_status_t open_status;
+  outfile_t outfile;
+  uint_t node, node_count;
+  
+  if ((graph == NULL) || (duration == NULL)) {
+    SET_STATUS(status, FILEIO_STATUS_INVALID_FILENAME);
+    return;
+  } /* end if */
+  
+  outfile_open_if_changed(&outfile, path, &open_status);
+  
+  if (outfile == NULL) {
+    SET_STATUS(status, open_status);
+    return;
+  } /* end if */
+  
+  node_count = m2c_make_node_count(graph);
+  
+  /* entries end in LF regardless of the newline mode */
+  node = 0;
+  while (node < node_count) {
+    if (duration[node] > 0) {
+      snprintf(digits, sizeof(digits), "%u", duration[node]);
+      outfile_write_string(outfile, m2c_make_node_module(graph, node));
+      outfile_write_char(outfile, ' ');
+      outfile_write_chars(outfile, digits);
+      outfile_write_char(outfile, '\n');
+    } /* end if */
+    node++;
+  } /* end while */
+  
+  outfile_close_if_changed(&outfile, NULL, status);
+} /* end m2c_make_write_timings */
+
+
+/* END OF FILE */
@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-timings.h                                                        *
+ *                                                                           *
+ * Public interface of m2make build timing history.                          *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_TIMINGS_H
+#define M2C_MAKE_TIMINGS_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-make-graph.h"
+#include "outfile.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Build timing history
+ * --------------------------------------------------------------------------
+ * The scheduler starts the modules on the critical path of a build first,
+ * see m2c-make-graph.h.  To weigh the path by the time it takes to build
+ * each module,  m2make records the duration of every module it builds in a
+ * history file and reads it back on the next run.  Each line of a history
+ * file is of the form  Ident milliseconds.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Name of the history file within the dependency directory
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_TIMINGS_FILE "m2make.timings"
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_read_timings(path, graph, cost)
+ * --------------------------------------------------------------------------
+ * Reads the history file at path  and passes in array cost  the recorded
+ * duration of every node of graph listed in the file,  and the mean of the
+ * recorded durations for every other node.  Returns true on success.  If
+ * the file cannot be read,  passes one for every node and returns false.
+ * Array cost must hold an entry for every node of graph.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_make_read_timings
+  (const char *path, m2c_make_graph_t graph, uint_t cost[]);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_blend_duration(recorded, measured)
+ * --------------------------------------------------------------------------
+ * Returns the recorded duration updated with a measured duration,  weighing
+ * the measured duration by three quarters,  so that a single slow build does
+ * not dominate the history.  A measured duration of zero leaves recorded
+ * unchanged.  Callers blend only the durations of modules actually built.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_blend_duration (uint_t recorded, uint_t measured);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_write_timings(path, graph, duration, status)
+ * --------------------------------------------------------------------------
+ * Writes a history file at path recording for every node of graph with a
+ * non-zero entry in array duration  its module and duration.  The file is
+ * left untouched if its contents would not change.  Passes the status of
+ * the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_write_timings
+  (const char *path,              /* in */
+   m2c_make_graph_t graph,        /* in */
+   const uint_t duration[],       /* in */
+   outfile_status_t *status);     /* out */
+
+
+#endif /* M2C_MAKE_TIMINGS_H */
+
+/* END OF FILE */
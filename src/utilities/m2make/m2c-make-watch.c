@@ -0,0 +1,591 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-watch.c                                                          *
+ *                                                                           *
+ * Implementation of m2make watch mode.                                      *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-make-watch.h"
+#include "m2c-pathnames.h"
+#include "fswatch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacity of the table of changed modules
+ * ----------------------------------------------------------------------- */
+
+#define CHANGE_INITIAL_CAPACITY 16
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_make_watch_s
+ * --------------------------------------------------------------------------
+ * Record type for a watch.  Modules changed since the last rebuild are
+ * collected in table change,  each once.  Field overflow is set if file
+ * system notifications have been dropped,  field reload_pending if the
+ * last reload of the graph failed.  Field rebuild_all is set until a
+ * rebuild of every module has succeeded,  modules of a new graph or left
+ * unstarted by a failed build have not been checked yet.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_make_watch_s {
+  /* graph */            m2c_make_graph_t graph;
+  /* fs */               fswatch_t fs;
+  /* change_count */     uint_t change_count;
+  /* change_capacity */  uint_t change_capacity;
+  /* change */           intstr_t *change;
+  /* overflow */         bool overflow;
+  /* out_of_memory */    bool out_of_memory;
+  /* reload_pending */   bool reload_pending;
+  /* rebuild_all */      bool rebuild_all;
+};
+
+typedef struct m2c_make_watch_s m2c_make_watch_s;
+
+
+/* --------------------------------------------------------------------------
+ * type rebuild_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the context of the job handler of a rebuild.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* affected */  const bool *affected;
+  /* handlers */  const m2c_make_watch_handlers_t *handlers;
+} rebuild_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static void collect_change (const char *path, void *context);
+
+static bool collect_changes
+  (m2c_make_watch_t watch, m2c_make_watch_status_t *status);
+
+static bool rescan_changes
+  (m2c_make_watch_t watch, const m2c_make_watch_handlers_t *handlers);
+
+static void rebuild
+  (m2c_make_watch_t watch,
+   uint_t jobs,
+   m2c_jobserver_t jobserver,
+   const m2c_make_watch_handlers_t *handlers);
+
+static bool rebuild_node
+  (m2c_make_graph_t graph, uint_t node, uint_t worker, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_new_watch(graph, status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories for the program of graph.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_watch_t m2c_make_new_watch
+  (m2c_make_graph_t graph, m2c_make_watch_status_t *status) {
+  
+  m2c_make_watch_t watch;
+  fswatch_status_t fs_status;
+  
+  /* check pre-conditions */
+  if (graph == NULL) {
+    SET_STATUS(status, M2C_MAKE_WATCH_STATUS_INVALID_REFERENCE);
+    return NULL;
+  } /* end if */
+  
+  watch = malloc(sizeof(m2c_make_watch_s));
+  
+  if (watch == NULL) {
+    SET_STATUS(status, M2C_MAKE_WATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  watch->graph = NULL;
+  watch->fs = fswatch_new(&fs_status);
+  watch->change_count = 0;
+  watch->change_capacity = CHANGE_INITIAL_CAPACITY;
+  watch->change = malloc(CHANGE_INITIAL_CAPACITY * sizeof(intstr_t));
+  watch->overflow = false;
+  watch->out_of_memory = false;
+  watch->reload_pending = false;
+  watch->rebuild_all = true;
+  
+  if ((watch->fs == NULL) || (watch->change == NULL)) {
+    m2c_make_release_watch(&watch);
+    
+    if (fs_status == FSWATCH_STATUS_ALLOCATION_FAILED) {
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_ALLOCATION_FAILED);
+    }
+    else {
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_WATCH_FAILED);
+    } /* end if */
+    return NULL;
+  } /* end if */
+  
+  watch->graph = graph;
+  
+  SET_STATUS(status, M2C_MAKE_WATCH_STATUS_SUCCESS);
+  return watch;
+} /* end m2c_make_new_watch */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_watch_add_dir(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds source directory path to watch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_watch_add_dir
+  (m2c_make_watch_t watch,
+   const char *path,
+   m2c_make_watch_status_t *status) {
+  
+  fswatch_status_t fs_status;
+  
+  /* check pre-conditions */
+  if ((watch == NULL) || (path == NULL)) {
+    SET_STATUS(status, M2C_MAKE_WATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  fswatch_add_directory(watch->fs, path, &fs_status);
+  
+  switch (fs_status) {
+    case FSWATCH_STATUS_SUCCESS :
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_SUCCESS);
+      break;
+    
+    case FSWATCH_STATUS_PATH_NOT_FOUND :
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_PATH_NOT_FOUND);
+      break;
+    
+    case FSWATCH_STATUS_ALLOCATION_FAILED :
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_ALLOCATION_FAILED);
+      break;
+    
+    default :
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_WATCH_FAILED);
+  } /* end switch */
+} /* end m2c_make_watch_add_dir */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_affected_nodes(graph, changed, affected)
+ * --------------------------------------------------------------------------
+ * Marks the changed nodes of graph and their importers in one pass over the
+ * build order,  in which every node follows the nodes it imports.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_affected_nodes
+  (m2c_make_graph_t graph, const bool changed[], bool affected[]) {
+  
+  uint_t node_count, index, node, import, import_count, count;
+  
+  node_count = m2c_make_node_count(graph);
+  count = 0;
+  
+  for (index = 0; index < node_count; index++) {
+    affected[index] = false;
+  } /* end for */
+  
+  for (index = 0; index < node_count; index++) {
+    node = m2c_make_build_order_node(graph, index);
+    
+    /* no build order recorded */
+    if (node >= node_count) {
+      return 0;
+    } /* end if */
+    
+    affected[node] = changed[node];
+    
+    import_count = m2c_make_import_count(graph, node);
+    import = 0;
+    while (NOT(affected[node]) && (import < import_count)) {
+      affected[node] =
+        affected[m2c_make_import_at_index(graph, node, import)];
+      import++;
+    } /* end while */
+    
+    if (affected[node]) {
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  return count;
+} /* end m2c_make_affected_nodes */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_watch_run(watch, jobs, jobserver, handlers, status)
+ * --------------------------------------------------------------------------
+ * Waits for changes and rebuilds affected modules until the watch fails.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_watch_run
+  (m2c_make_watch_t watch,
+   uint_t jobs,
+   m2c_jobserver_t jobserver,
+   const m2c_make_watch_handlers_t *handlers,
+   m2c_make_watch_status_t *status) {
+  
+  /* check pre-conditions */
+  if ((watch == NULL) || (handlers == NULL) ||
+      (handlers->reload == NULL) || (handlers->build == NULL)) {
+    SET_STATUS(status, M2C_MAKE_WATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  while (collect_changes(watch, status)) {
+    if (watch->out_of_memory) {
+      SET_STATUS(status, M2C_MAKE_WATCH_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+    
+    if ((watch->change_count == 0) && NOT(watch->overflow)) {
+      continue;
+    } /* end if */
+    
+    /* a new graph is used from the next rebuild on */
+    if (rescan_changes(watch, handlers) || watch->reload_pending) {
+      m2c_make_graph_t new_graph;
+      m2c_make_status_t make_status;
+      
+      new_graph = handlers->reload(handlers->context);
+      
+      if (new_graph == NULL) {
+        make_status = M2C_MAKE_STATUS_DEP_FILE_NOT_FOUND;
+      }
+      else {
+        m2c_make_check_cycles(new_graph, NULL, NULL, &make_status);
+      } /* end if */
+      
+      if (make_status != M2C_MAKE_STATUS_SUCCESS) {
+        /* keep building the old graph until the imports are fixed */
+        m2c_make_release_graph(&new_graph);
+        watch->reload_pending = true;
+        
+        if (handlers->report != NULL) {
+          handlers->report(watch->graph,
+            0, make_status, NULL, handlers->context);
+        } /* end if */
+      }
+      else {
+        m2c_make_release_graph(&watch->graph);
+        watch->graph = new_graph;
+        watch->reload_pending = false;
+        watch->rebuild_all = true;
+      } /* end if */
+    } /* end if */
+    
+    rebuild(watch, jobs, jobserver, handlers);
+    
+    watch->change_count = 0;
+    watch->overflow = false;
+  } /* end while */
+} /* end m2c_make_watch_run */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_release_watch(watch)
+ * --------------------------------------------------------------------------
+ * Stops and deallocates watch and its graph and passes NULL in watch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_release_watch (m2c_make_watch_t *watch) {
+  
+  if ((watch == NULL) || (*watch == NULL)) {
+    return;
+  } /* end if */
+  
+  fswatch_release(&(*watch)->fs);
+  m2c_make_release_graph(&(*watch)->graph);
+  free((*watch)->change);
+  free(*watch);
+  *watch = NULL;
+} /* end m2c_make_release_watch */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private procedure collect_change(path, context)
+ * --------------------------------------------------------------------------
+ * File system watch handler.  Adds the module of the source file at path to
+ * the changed modules of the watch passed in context,  unless path is not a
+ * source file or the module is already listed.
+ * ----------------------------------------------------------------------- */
+
+static void collect_change (const char *path, void *context) {
+  
+  const char *name, *suffix, *next;
+  intstr_t module, *new_table;
+  m2c_make_watch_t watch;
+  uint_t index;
+  
+  watch = (m2c_make_watch_t) context;
+  
+  /* the last component of path,  the separator depends on the host */
+  name = path;
+  for (next = path; *next != ASCII_NUL; next++) {
+    if ((*next == '/') || (*next == '\\')) {
+      name = next + 1;
+    } /* end if */
+  } /* end for */
+  
+  suffix = strrchr(name, '.');
+  
+  if ((suffix == NULL) || (suffix == name) ||
+      (NOT(is_def_suffix(suffix)) && NOT(is_mod_suffix(suffix)))) {
+    return;
+  } /* end if */
+  
+  module = intstr_for_slice(path,
+    (uint_t) (name - path), (uint_t) (suffix - name), NULL);
+  
+  /* not a module identifier */
+  if (module == NULL) {
+    return;
+  } /* end if */
+  
+  for (index = 0; index < watch->change_count; index++) {
+    if (watch->change[index] == module) {
+      return;
+    } /* end if */
+  } /* end for */
+  
+  if (watch->change_count == watch->change_capacity) {
+    new_table = realloc(watch->change,
+      2 * watch->change_capacity * sizeof(intstr_t));
+    
+    if (new_table == NULL) {
+      watch->out_of_memory = true;
+      return;
+    } /* end if */
+    
+    watch->change = new_table;
+    watch->change_capacity = 2 * watch->change_capacity;
+  } /* end if */
+  
+  watch->change[watch->change_count] = module;
+  watch->change_count++;
+} /* end collect_change */
+
+
+/* --------------------------------------------------------------------------
+ * private function collect_changes(watch, status)
+ * --------------------------------------------------------------------------
+ * Waits for a change to the watched directories,  then collects changes
+ * until none arrived for M2C_MAKE_WATCH_QUIET_MS milliseconds.  Returns
+ * true on success,  false if the file system watch failed.
+ * ----------------------------------------------------------------------- */
+
+static bool collect_changes
+  (m2c_make_watch_t watch, m2c_make_watch_status_t *status) {
+  
+  fswatch_status_t fs_status;
+  int timeout;
+  
+  timeout = -1;
+  
+  while (fswatch_wait(watch->fs,
+      timeout, collect_change, watch, &fs_status)) {
+    if (fs_status == FSWATCH_STATUS_OVERFLOW) {
+      watch->overflow = true;
+    } /* end if */
+    timeout = M2C_MAKE_WATCH_QUIET_MS;
+  } /* end while */
+  
+  if ((fs_status != FSWATCH_STATUS_SUCCESS) &&
+      (fs_status != FSWATCH_STATUS_OVERFLOW)) {
+    SET_STATUS(status, M2C_MAKE_WATCH_STATUS_WATCH_FAILED);
+    return false;
+  } /* end if */
+  
+  return true;
+} /* end collect_changes */
+
+
+/* --------------------------------------------------------------------------
+ * private function rescan_changes(watch, handlers)
+ * --------------------------------------------------------------------------
+ * Rescans the imports of the changed modules,  or of all modules of the
+ * graph after an overflow.  Modules not in the graph are rescanned too,  a
+ * new module may satisfy an import that failed to load.  Returns true if
+ * any import list has changed.
+ * ----------------------------------------------------------------------- */
+
+static bool rescan_changes
+  (m2c_make_watch_t watch, const m2c_make_watch_handlers_t *handlers) {
+  
+  uint_t index, count;
+  bool changed, any_changed;
+  intstr_t module;
+  
+  if (handlers->rescan == NULL) {
+    return false;
+  } /* end if */
+  
+  if (watch->overflow) {
+    count = m2c_make_node_count(watch->graph);
+  }
+  else {
+    count = watch->change_count;
+  } /* end if */
+  
+  any_changed = false;
+  for (index = 0; index < count; index++) {
+    if (watch->overflow) {
+      module = m2c_make_node_module(watch->graph, index);
+    }
+    else {
+      module = watch->change[index];
+    } /* end if */
+    
+    changed = false;
+    if (handlers->rescan(module, &changed, handlers->context) && changed) {
+      any_changed = true;
+    } /* end if */
+  } /* end for */
+  
+  return any_changed;
+} /* end rescan_changes */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure rebuild(watch, jobs, jobserver, handlers)
+ * --------------------------------------------------------------------------
+ * Rebuilds the changed modules of the graph of watch and their importers,
+ * or all modules after an overflow or while rebuild_all is set,  and reports
+ * the result.
+ * ----------------------------------------------------------------------- */
+
+static void rebuild
+  (m2c_make_watch_t watch,
+   uint_t jobs,
+   m2c_jobserver_t jobserver,
+   const m2c_make_watch_handlers_t *handlers) {
+  
+  uint_t node_count, index, node, affected_count;
+  m2c_make_status_t make_status;
+  rebuild_context_t rebuild;
+  intstr_t failed_module;
+  bool *changed, *affected;
+  
+  node_count = m2c_make_node_count(watch->graph);
+  changed = malloc(node_count * sizeof(bool));
+  affected = malloc(node_count * sizeof(bool));
+  
+  if ((changed == NULL) || (affected == NULL)) {
+    free(changed);
+    free(affected);
+    if (handlers->report != NULL) {
+      handlers->report(watch->graph, 0,
+        M2C_MAKE_STATUS_ALLOCATION_FAILED, NULL, handlers->context);
+    } /* end if */
+    return;
+  } /* end if */
+  
+  for (index = 0; index < node_count; index++) {
+    changed[index] = (watch->overflow) || (watch->rebuild_all);
+  } /* end for */
+  
+  /* modules not in the graph are not imported by the program */
+  for (index = 0; index < watch->change_count; index++) {
+    node = m2c_make_node_for_module(watch->graph, watch->change[index]);
+    if (node < node_count) {
+      changed[node] = true;
+    } /* end if */
+  } /* end for */
+  
+  affected_count = m2c_make_affected_nodes(watch->graph, changed, affected);
+  
+  failed_module = NULL;
+  make_status = M2C_MAKE_STATUS_SUCCESS;
+  
+  if (affected_count > 0) {
+    rebuild.affected = affected;
+    rebuild.handlers = handlers;
+    m2c_make_run(watch->graph, jobs, jobserver,
+      rebuild_node, &rebuild, &failed_module, &make_status);
+    
+    /* modules not started after a failure are checked next time */
+    watch->rebuild_all = (make_status != M2C_MAKE_STATUS_SUCCESS);
+    
+    if (handlers->report != NULL) {
+      handlers->report(watch->graph,
+        affected_count, make_status, failed_module, handlers->context);
+    } /* end if */
+  } /* end if */
+  
+  free(changed);
+  free(affected);
+} /* end rebuild */
+
+
+/* --------------------------------------------------------------------------
+ * private function rebuild_node(graph, node, worker, context)
+ * --------------------------------------------------------------------------
+ * Job handler of a rebuild.  Calls the build handler for affected nodes,
+ * all other nodes are up to date and pass at once.
+ * ----------------------------------------------------------------------- */
+
+static bool rebuild_node
+  (m2c_make_graph_t graph, uint_t node, uint_t worker, void *context) {
+  
+  rebuild_context_t *rebuild;
+  
+  rebuild = (rebuild_context_t *) context;
+  
+  if (NOT(rebuild->affected[node])) {
+    return true;
+  } /* end if */
+  
+  return rebuild->handlers->build(graph,
+    node, worker, rebuild->handlers->context);
+} /* end rebuild_node */
+
+
+/* END OF FILE */
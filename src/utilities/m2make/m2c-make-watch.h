@@ -0,0 +1,235 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-watch.h                                                          *
+ *                                                                           *
+ * Public interface of m2make watch mode.                                    *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_WATCH_H
+#define M2C_MAKE_WATCH_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-make-graph.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Watch mode
+ * --------------------------------------------------------------------------
+ * With option --watch,  m2make stays resident after the initial build.  It
+ * keeps the build graph in memory,  watches the source directories through
+ * the file system watch of lib/filesys  and on every change rebuilds only
+ * the affected modules:  the modules whose sources changed  and the modules
+ * importing them,  directly or indirectly.  The job handler applies early
+ * cutoff as in a normal build,  see m2c-make-stamps.h,  thus an importer is
+ * only recompiled if the interface fingerprint of an import has changed,
+ * the others are checked and skipped.  With job handlers that pass their
+ * compile requests to a resident compile server,  see m2c-compile-server.h,
+ * the latency from saving a file to a completed rebuild is close to the
+ * cost of compiling that one module.
+ *
+ * Changes are collected until the watched directories have been quiet for
+ * M2C_MAKE_WATCH_QUIET_MS milliseconds,  so that saving several files at
+ * once triggers a single rebuild.  The import sections of changed modules
+ * are rescanned,  the build graph is reloaded only if an import list has
+ * changed.  The first rebuild,  the first after a reload  and the first after
+ * a failed rebuild pass every module to the job handler,  since modules of
+ * a new graph or not started by a failed build have not been checked yet.
+ * Early cutoff skips the modules that are up to date.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Quiet period in milliseconds after which collected changes are built
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_WATCH_QUIET_MS 100
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_make_watch_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a watch over the sources of a program.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_make_watch_s *m2c_make_watch_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_watch_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on watches.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MAKE_WATCH_STATUS_SUCCESS,
+  M2C_MAKE_WATCH_STATUS_INVALID_REFERENCE,
+  M2C_MAKE_WATCH_STATUS_PATH_NOT_FOUND,
+  M2C_MAKE_WATCH_STATUS_WATCH_FAILED,
+  M2C_MAKE_WATCH_STATUS_ALLOCATION_FAILED
+} m2c_make_watch_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_rescan_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a function that rescans the import section of the source of
+ * module  and updates the dependency database.  Passes true in changed if
+ * the list of imports differs from the one recorded.  Returns false if the
+ * source could not be scanned,  the module is then rebuilt to report the
+ * errors and the graph is left unchanged.
+ * ----------------------------------------------------------------------- */
+
+typedef bool (*m2c_make_rescan_handler_t)
+  (intstr_t module, bool *changed, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_reload_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a function that returns a new build graph for the program  after
+ * import lists have changed,  or NULL on failure.  The graph is checked for
+ * cycles by the watch.  If reloading fails,  the failure is reported and the
+ * previous graph is kept  until a reload after a later change succeeds.
+ * ----------------------------------------------------------------------- */
+
+typedef m2c_make_graph_t (*m2c_make_reload_handler_t) (void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_report_handler_t
+ * --------------------------------------------------------------------------
+ * Type of a procedure called after each rebuild with the number of modules
+ * affected,  the status of the rebuild  and the module that failed,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef void (*m2c_make_report_handler_t)
+  (m2c_make_graph_t graph, uint_t affected, m2c_make_status_t status,
+   intstr_t failed_module, void *context);
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_watch_handlers_t
+ * --------------------------------------------------------------------------
+ * Record type for the handlers of a watch and the context passed to them.
+ * Handlers rescan and report may be NULL,  all sources are then assumed to
+ * keep their imports,  rebuilds go unreported.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* rescan */   m2c_make_rescan_handler_t rescan;
+  /* reload */   m2c_make_reload_handler_t reload;
+  /* build */    m2c_make_job_handler_t build;
+  /* report */   m2c_make_report_handler_t report;
+  /* context */  void *context;
+} m2c_make_watch_handlers_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_new_watch(graph, status)
+ * --------------------------------------------------------------------------
+ * Returns a new watch without directories for the program of graph,  or
+ * NULL on failure.  The graph must have been checked for cycles.  The watch
+ * takes ownership of graph,  which is released with the watch.
+ * ----------------------------------------------------------------------- */
+
+m2c_make_watch_t m2c_make_new_watch
+  (m2c_make_graph_t graph, m2c_make_watch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_watch_add_dir(watch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds source directory path to watch.  Changes to files with suffix .def
+ * or .mod in path are taken as changes to the module of the same name.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_watch_add_dir
+  (m2c_make_watch_t watch,                /* in */
+   const char *path,                      /* in */
+   m2c_make_watch_status_t *status);      /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_affected_nodes(graph, changed, affected)
+ * --------------------------------------------------------------------------
+ * Passes true in array affected for every node of graph that is marked in
+ * array changed or imports an affected node,  and false for all others.
+ * Returns the number of affected nodes.  Both arrays must hold an entry for
+ * every node.  The graph must have been checked for cycles.  Time is linear
+ * in the number of nodes and imports.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_affected_nodes
+  (m2c_make_graph_t graph, const bool changed[], bool affected[]);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_watch_run(watch, jobs, jobserver, handlers, status)
+ * --------------------------------------------------------------------------
+ * Waits for changes to the watched directories  and rebuilds the affected
+ * modules on up to jobs workers sharing jobserver after each,  calling
+ * handlers.build for each affected node,  until the file system watch
+ * fails.  A failed rebuild is reported and the watch continues,  the next
+ * change retries it.  Passes the status in status.  Does not return unless
+ * the watch fails.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_watch_run
+  (m2c_make_watch_t watch,                       /* in */
+   uint_t jobs,                                  /* in */
+   m2c_jobserver_t jobserver,                    /* in */
+   const m2c_make_watch_handlers_t *handlers,    /* in */
+   m2c_make_watch_status_t *status);             /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_release_watch(watch)
+ * --------------------------------------------------------------------------
+ * Stops and deallocates watch and its graph and passes NULL in watch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_release_watch (m2c_make_watch_t *watch);
+
+
+#endif /* M2C_MAKE_WATCH_H */
+
+/* END OF FILE */
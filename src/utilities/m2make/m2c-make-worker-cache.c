@@ -0,0 +1,176 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-worker-cache.c                                                   *
+ *                                                                           *
+ * Implementation of m2make worker string cache.                             *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-make-worker-cache.h"
+#include "m2-symfile.h"
+#include "interned-strings.h"
+
+#include <stdlib.h>
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_common_interfaces(graph, min_importers, is_common)
+ * --------------------------------------------------------------------------
+ * Counts the importers of every node of graph  and marks the nodes imported
+ * by at least min_importers modules.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_common_interfaces
+  (m2c_make_graph_t graph, uint_t min_importers, bool is_common[]) {
+  
+  uint_t node_count, node, index, imported, marked, *importers;
+  
+  node_count = m2c_make_node_count(graph);
+  
+  if ((node_count == 0) || (is_common == NULL)) {
+    return 0;
+  } /* end if */
+  
+  importers = calloc(node_count, sizeof(uint_t));
+  
+  if (importers == NULL) {
+    for (node = 0; node < node_count; node++) {
+      is_common[node] = false;
+    } /* end for */
+    return 0;
+  } /* end if */
+  
+  for (node = 0; node < node_count; node++) {
+    for (index = 0; index < m2c_make_import_count(graph, node); index++) {
+      imported = m2c_make_import_at_index(graph, node, index);
+      
+      if (imported < node_count) {
+        importers[imported]++;
+      } /* end if */
+    } /* end for */
+  } /* end for */
+  
+  marked = 0;
+  for (node = 0; node < node_count; node++) {
+    is_common[node] =
+      (importers[node] > 0) && (importers[node] >= min_importers);
+    
+    if (is_common[node]) {
+      marked++;
+    } /* end if */
+  } /* end for */
+  
+  free(importers);
+  
+  return marked;
+} /* end m2c_make_common_interfaces */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_write_worker_cache(path, count, sympath, status)
+ * --------------------------------------------------------------------------
+ * Opens each symbol file privately,  interns its strings and releases it,
+ * then saves the string repository.  The interned strings stay in the
+ * repository of m2make,  which is short-lived.
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_write_worker_cache
+  (const char *path,                          /* in */
+   uint_t count,                              /* in */
+   const char *sympath[],                     /* in */
+   m2c_make_worker_cache_status_t *status) {  /* out */
+  
+  m2c_symfile_status_t symstatus;
+  intstr_status_t intstatus;
+  m2c_symfile_t symfile;
+  uint_t index;
+  
+  if ((path == NULL) || (sympath == NULL)) {
+    SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    symfile = m2c_open_symfile(sympath[index], &symstatus);
+    
+    if (symfile != NULL) {
+      symstatus = m2c_symfile_intern_strings(symfile);
+      m2c_release_symfile(symfile);
+    } /* end if */
+    
+    switch (symstatus) {
+      case M2C_SYMFILE_STATUS_SUCCESS :
+      case M2C_SYMFILE_STATUS_DEFINITION_UNAVAILABLE :
+        break;
+      
+      case M2C_SYMFILE_STATUS_ALLOCATION_FAILED :
+        SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_ALLOCATION_FAILED);
+        return;
+      
+      default :
+        SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_INVALID_SYMFILE);
+        return;
+    } /* end switch */
+  } /* end for */
+  
+  intstr_save_snapshot(path, &intstatus);
+  
+  switch (intstatus) {
+    case INTSTR_STATUS_SUCCESS :
+      SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_SUCCESS);
+      break;
+    
+    case INTSTR_STATUS_ALLOCATION_FAILED :
+      SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_ALLOCATION_FAILED);
+      break;
+    
+    case INTSTR_STATUS_NOT_INITIALIZED :
+    case INTSTR_STATUS_INVALID_REFERENCE :
+      SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_INVALID_REFERENCE);
+      break;
+    
+    default :
+      SET_STATUS(status, M2C_MAKE_WORKER_CACHE_STATUS_IO_ERROR);
+  } /* end switch */
+  
+  return;
+} /* end m2c_make_write_worker_cache */
+
+
+/* END OF FILE */
@@ -0,0 +1,153 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-make-worker-cache.h                                                   *
+ *                                                                           *
+ * Interface for m2make worker string cache.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MAKE_WORKER_CACHE_H
+#define M2C_MAKE_WORKER_CACHE_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-make-graph.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Worker cache
+ * --------------------------------------------------------------------------
+ * Every m2c worker started by m2make interns the identifiers of the
+ * interfaces it imports and reads their symbol files  and the AST files with
+ * their definitions.  For interfaces imported by most modules of a build,
+ * every worker thus repeats the same work and holds a private copy of the
+ * same strings.
+ *
+ * With --worker-cache,  m2make interns the strings of the symbol and AST
+ * files of the interfaces imported by at least M2C_MAKE_WORKER_CACHE_MIN_-
+ * IMPORTERS modules once,  before the first job is started,  and saves them
+ * in a string repository snapshot.  Each m2c job is passed the snapshot with
+ * option --worker-cache and maps it at startup,  see intstr_map_snapshot.
+ * The mapping is private,  but pages are only copied when written to,  thus
+ * the pages of the snapshot are shared by all workers in memory.
+ *
+ * Symbol files are themselves mapped read-only and shared by the workers
+ * through the page cache,  thus they are not copied into the snapshot.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Default suffix of worker cache files
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_WORKER_CACHE_SUFFIX ".strings"
+
+
+/* --------------------------------------------------------------------------
+ * Minimum number of importers of an interface in the worker cache
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MAKE_WORKER_CACHE_MIN_IMPORTERS 2
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_make_worker_cache_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for building a worker cache.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MAKE_WORKER_CACHE_STATUS_SUCCESS,
+  M2C_MAKE_WORKER_CACHE_STATUS_INVALID_REFERENCE,
+  M2C_MAKE_WORKER_CACHE_STATUS_INVALID_SYMFILE,
+  M2C_MAKE_WORKER_CACHE_STATUS_IO_ERROR,
+  M2C_MAKE_WORKER_CACHE_STATUS_ALLOCATION_FAILED
+} m2c_make_worker_cache_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_make_common_interfaces(graph, min_importers, is_common)
+ * --------------------------------------------------------------------------
+ * Sets is_common[node] for every node of graph to true if the node is
+ * imported by at least min_importers modules,  false otherwise.  Array
+ * is_common must have room for the node count of graph.  Returns the number
+ * of nodes marked true.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_make_common_interfaces
+  (m2c_make_graph_t graph, uint_t min_importers, bool is_common[]);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_make_write_worker_cache(path, count, sympath, status)
+ * --------------------------------------------------------------------------
+ * Interns the strings of the count symbol files at the pathnames in array
+ * sympath  and of their AST files,  then writes a snapshot of the string
+ * repository to a file at path.  The snapshot holds all strings interned by
+ * m2make,  among them the module identifiers of the build.  Symbol files
+ * whose AST file cannot be read contribute their identifiers only.
+ *
+ * pre-conditions:
+ * o  the global string repository must be initialised
+ * o  path must be a valid pathname
+ *
+ * post-conditions:
+ * o  a snapshot has been written to path
+ * o  M2C_MAKE_WORKER_CACHE_STATUS_SUCCESS is passed back in status
+ *
+ * error-conditions:
+ * o  if path or sympath is NULL,
+ *    M2C_MAKE_WORKER_CACHE_STATUS_INVALID_REFERENCE,  if a symbol file is
+ *    missing or malformed, M2C_MAKE_WORKER_CACHE_STATUS_INVALID_SYMFILE,
+ *    if the snapshot could not be written,
+ *    M2C_MAKE_WORKER_CACHE_STATUS_IO_ERROR,  if allocation failed,
+ *    M2C_MAKE_WORKER_CACHE_STATUS_ALLOCATION_FAILED is passed back in
+ *    status,  and no snapshot is written
+ * ----------------------------------------------------------------------- */
+
+void m2c_make_write_worker_cache
+  (const char *path,                          /* in */
+   uint_t count,                              /* in */
+   const char *sympath[],                     /* in */
+   m2c_make_worker_cache_status_t *status);   /* out */
+
+
+#endif /* M2C_MAKE_WORKER_CACHE_H */
+
+/* END OF FILE */
@@ -37,20 +37,1286 @@
  * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-/* TO DO */
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
 
-/* get command line arguments */
+#include "m2c-make-depdb.h"
+#include "m2c-make-graph.h"
+#include "m2c-make-stamps.h"
+#include "m2c-make-timings.h"
+#include "m2c-make-prefetch.h"
+#include "m2c-make-watch.h"
+#include "m2c-make-worker-cache.h"
+#include "m2c-mkdep-batch.h"
+#include "m2c-jobserver.h"
+#include "m2c-trace.h"
+#include "interned-strings.h"
+#include "fileutils.h"
+#include "cstring.h"
 
-/* get input file */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-/* call m2mkdep to generate dependency file */
 
-/* read dependency file */
+/* --------------------------------------------------------------------------
+ * Host process creation
+ * --------------------------------------------------------------------------
+ * Jobs call the compiler through posix_spawnp() and wait for the child they
+ * started,  thus jobs on different workers never collect each other's
+ * children.  On other hosts,  the compiler is called through system().
+ * ----------------------------------------------------------------------- */
 
-/* check for cycles /*
+#if (defined(__MACH__)) || (defined(__unix)) || \
+    ((defined(__unix__)) && (!defined(_WIN32)))
+#define M2C_MAKE_SPAWN 1
+#else
+#define M2C_MAKE_SPAWN 0
+#endif
 
-/* if any cycles are found, report error and terminate */
+#if (M2C_MAKE_SPAWN)
+#include <spawn.h>
+#include <sys/wait.h>
 
-/* if no cycles are found, call m2c on each file in dependency order */
+extern char **environ;
+#endif
 
-/* END OF FILE */
\ No newline at end of file
+
+/* --------------------------------------------------------------------------
+ * Name of the compiler called for each module
+ * ----------------------------------------------------------------------- */
+
+#define COMPILER "m2c"
+
+
+/* --------------------------------------------------------------------------
+ * Default source directory
+ * ----------------------------------------------------------------------- */
+
+#define DEFAULT_SOURCE_DIR "."
+
+
+/* --------------------------------------------------------------------------
+ * Suffixes of source and export list files
+ * ----------------------------------------------------------------------- */
+
+#define DEF_SUFFIX ".def"
+
+#define MOD_SUFFIX ".mod"
+
+#define EXL_SUFFIX ".exl"
+
+#define SYM_SUFFIX ".sym"
+
+
+/* --------------------------------------------------------------------------
+ * private type build_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the state shared by the jobs of a build  and the handlers
+ * of a watch.  Array fingerprint holds the effective interface fingerprint
+ * of each node built or checked,  array built records whether the compiler
+ * was called for it.  Each job writes only the entries of its own node.
+ * Both arrays hold node_count entries.  Field prefetch is the prefetcher of
+ * a build in progress,  or NULL.  Field worker_cache is the path of the
+ * string snapshot passed to each compiler,  or NULL.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* program */      intstr_t program;
+  /* srcdir */       const char *srcdir;
+  /* db */           m2c_make_depdb_t db;
+  /* node_count */   uint_t node_count;
+  /* fingerprint */  m2c_digest_value_t *fingerprint;
+  /* built */        bool *built;
+  /* prefetch */     m2c_make_prefetch_t prefetch;
+  /* worker_cache */ const char *worker_cache;
+} build_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static bool get_args
+  (int argc, char *argv[],
+   const char **program, const char **srcdir, uint_t *jobs, bool *watch,
+   const char **trace, bool *worker_cache);
+
+static m2c_make_graph_t load_graph
+  (intstr_t program, m2c_make_depdb_t db, const char *srcdir);
+
+static void report_load_failure
+  (m2c_make_status_t status, intstr_t failed, const char *srcdir);
+
+static bool refresh_graph (m2c_make_graph_t graph, m2c_make_depdb_t db);
+
+static bool scan_paths
+  (m2c_make_depdb_t db, uint_t count, const char *path[]);
+
+static void report_cycle
+  (m2c_make_graph_t graph, uint_t length, const uint_t *path, void *context);
+
+static const char *new_worker_cache
+  (m2c_make_graph_t graph, intstr_t program);
+
+static bool resize_context (build_context_t *context, uint_t node_count);
+
+static bool build
+  (m2c_make_graph_t graph, build_context_t *context,
+   uint_t jobs, m2c_jobserver_t jobserver);
+
+static m2c_make_prefetch_t new_build_prefetch
+  (m2c_make_graph_t graph, m2c_make_depdb_t db);
+
+static void watch_sources
+  (m2c_make_graph_t graph, build_context_t *context,
+   uint_t jobs, m2c_jobserver_t jobserver);
+
+static bool rescan_module (intstr_t module, bool *changed, void *context);
+
+static m2c_make_graph_t reload_graph (void *context);
+
+static void report_rebuild
+  (m2c_make_graph_t graph, uint_t affected, m2c_make_status_t status,
+   intstr_t failed_module, void *context);
+
+static bool build_module
+  (m2c_make_graph_t graph, uint_t node, uint_t worker, void *context);
+
+static m2c_digest_value_t source_fingerprint
+  (const m2c_make_depdb_source_t *source, const char *defpath);
+
+static const char *new_def_path (const char *path);
+
+static bool run_compiler
+  (const char *defpath, const char *path, const char *worker_cache);
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * --------------------------------------------------------------------------
+ * Usage:  m2make [-j jobs] [--watch] [--trace file] [--worker-cache]
+ *                <program module> [<source directory>]
+ *
+ * Builds the program module and the modules it imports,  directly or
+ * indirectly,  whose sources are found in the source directory,  by default
+ * the current directory.  The dependency database,  the build timing history,
+ * stamp files and the products of the compiler are kept in the current
+ * directory.  With --watch,  stays resident and rebuilds the modules
+ * affected by each change to the source directory,  see m2c-make-watch.h.
+ * With --trace,  records the dependency scan and a span per module build on
+ * the lane of its worker in a trace event file,  see m2c-trace.h.  In watch
+ * mode,  only the initial build is recorded.  With --worker-cache,  interns
+ * the strings of the interfaces imported by several modules once and passes
+ * them to each compiler in a snapshot,  see m2c-make-worker-cache.h.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  const char *program_name, *srcdir, *trace_path;
+  m2c_jobserver_status_t jobserver_status;
+  m2c_trace_status_t trace_status;
+  m2c_make_depdb_status_t db_status;
+  m2c_jobserver_t jobserver;
+  build_context_t context;
+  m2c_make_status_t status;
+  m2c_make_graph_t graph;
+  m2c_make_depdb_t db;
+  intstr_t program;
+  uint_t jobs;
+  bool passed, watch, worker_cache;
+  
+  /* get command line arguments */
+  if (NOT(get_args(argc, argv, &program_name,
+      &srcdir, &jobs, &watch, &trace_path, &worker_cache))) {
+    fprintf(stderr, "usage: m2make [-j jobs] [--watch] [--trace file] "
+      "[--worker-cache] <program module> [<source directory>]\n");
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  /* jobs and scanning workers intern strings concurrently */
+#if (M2C_MAKE_PARALLEL)
+  intstr_init_concurrent_repo(0, 0, NULL);
+#else
+  intstr_init_repo(0, NULL);
+#endif
+  
+  program = intstr_for_cstr(program_name, NULL);
+  
+  /* open the dependency database, a missing file yields an empty one */
+  db = m2c_make_depdb_open(M2C_MAKE_DEPDB_FILE, &db_status);
+  
+  if ((program == NULL) || (db == NULL)) {
+    fprintf(stderr, "m2make: out of memory\n");
+    intstr_dispose_repo();
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  /* open the trace event file before any job is started */
+  if (trace_path != NULL) {
+    m2c_trace_open(trace_path, &trace_status);
+    
+    if (trace_status != M2C_TRACE_STATUS_SUCCESS) {
+      fprintf(stderr, "m2make: unable to write trace to %s\n", trace_path);
+    } /* end if */
+  } /* end if */
+  
+  /* rescan changed sources and read the import closure of the program */
+  m2c_trace_begin("scan", NULL);
+  graph = load_graph(program, db, srcdir);
+  m2c_trace_end("scan");
+  
+  if (graph == NULL) {
+    m2c_trace_close(&trace_status);
+    m2c_make_depdb_close(&db);
+    intstr_dispose_repo();
+    return EXIT_FAILURE;
+  } /* end if */
+  
+  /* the file is left untouched if nothing was rescanned */
+  m2c_make_depdb_write(db, M2C_MAKE_DEPDB_FILE, &db_status);
+  
+  if (db_status != M2C_MAKE_DEPDB_STATUS_SUCCESS) {
+    fprintf(stderr, "m2make: %s could not be written\n",
+      M2C_MAKE_DEPDB_FILE);
+  } /* end if */
+  
+  context.program = program;
+  context.srcdir = srcdir;
+  context.db = db;
+  context.node_count = 0;
+  context.fingerprint = NULL;
+  context.built = NULL;
+  context.prefetch = NULL;
+  context.worker_cache = NULL;
+  
+  /* report each cycle of imports with its path */
+  passed =
+    (m2c_make_check_cycles(graph, report_cycle, stderr, &status) == 0) &&
+    (resize_context(&context, m2c_make_node_count(graph)));
+  
+  /* write the string snapshot before the first job is started */
+  if ((passed) && (worker_cache)) {
+    context.worker_cache = new_worker_cache(graph, program);
+  } /* end if */
+  
+  /* call m2c on each module in dependency order */
+  if (passed) {
+    /* share the job limit of make, or give one to the compilers we start */
+    jobs = m2c_make_worker_count(graph, jobs);
+    jobserver = m2c_jobserver_for_jobs(jobs, &jobserver_status);
+    
+    passed = build(graph, &context, jobs, jobserver);
+    
+    /* close the trace after the last job, a watch is not recorded */
+    m2c_trace_close(&trace_status);
+    
+    /* a failed build is retried on the next change */
+    if (watch) {
+      watch_sources(graph, &context, jobs, jobserver);
+      graph = NULL;
+      passed = false;
+    } /* end if */
+    
+    m2c_jobserver_release(&jobserver);
+  } /* end if */
+  
+  m2c_trace_close(&trace_status);
+  m2c_make_release_graph(&graph);
+  m2c_make_depdb_close(&db);
+  free(context.fingerprint);
+  free(context.built);
+  free((void *) context.worker_cache);
+  intstr_dispose_repo();
+  
+  return (passed) ? EXIT_SUCCESS : EXIT_FAILURE;
+} /* end main */
+
+
+/* *********************************************************************** *
+ * Private Functions                                                       *
+ * *********************************************************************** */
+
+/* --------------------------------------------------------------------------
+ * private function get_args(argc, argv, program, srcdir, jobs, watch, ...)
+ * --------------------------------------------------------------------------
+ * Reads the command line,  passes the program module identifier in program,
+ * the source directory in srcdir,  the number of jobs in jobs,  zero if
+ * option -j is not given,  whether option --watch is given in watch,  the
+ * path given with option --trace in trace,  or NULL,  and whether option
+ * --worker-cache is given in worker_cache.  Returns false if the command
+ * line is malformed.
+ * ----------------------------------------------------------------------- */
+
+static bool get_args
+  (int argc, char *argv[],
+   const char **program, const char **srcdir, uint_t *jobs, bool *watch,
+   const char **trace, bool *worker_cache) {
+  
+  const char *digits;
+  bool have_srcdir;
+  uint_t value;
+  int index;
+  
+  have_srcdir = false;
+  *program = NULL;
+  *srcdir = DEFAULT_SOURCE_DIR;
+  *jobs = 0;
+  *watch = false;
+  *trace = NULL;
+  *worker_cache = false;
+  
+  for (index = 1; index < argc; index++) {
+    if (strncmp(argv[index], "-j", 2) == 0) {
+      /* -j N or -jN */
+      digits = argv[index] + 2;
+      if ((*digits == '\0') && (index + 1 < argc)) {
+        index++;
+        digits = argv[index];
+      } /* end if */
+      
+      value = 0;
+      if (*digits == '\0') {
+        return false;
+      } /* end if */
+      
+      while ((*digits >= '0') && (*digits <= '9') && (value < 10000)) {
+        value = value * 10 + (uint_t) (*digits - '0');
+        digits++;
+      } /* end while */
+      
+      if ((*digits != '\0') || (value == 0)) {
+        return false;
+      } /* end if */
+      
+      *jobs = value;
+    }
+    else if (strcmp(argv[index], "--watch") == 0) {
+      *watch = true;
+    }
+    else if (strcmp(argv[index], "--trace") == 0) {
+      if (index + 1 == argc) {
+        return false;
+      } /* end if */
+      
+      index++;
+      *trace = argv[index];
+    }
+    else if (strcmp(argv[index], "--worker-cache") == 0) {
+      *worker_cache = true;
+    }
+    else if (argv[index][0] == '-') {
+      return false;
+    }
+    else if (*program == NULL) {
+      *program = argv[index];
+    }
+    else if (NOT(have_srcdir)) {
+      *srcdir = argv[index];
+      have_srcdir = true;
+    }
+    else /* surplus argument */ {
+      return false;
+    } /* end if */
+  } /* end for */
+  
+  return (*program != NULL);
+} /* end get_args */
+
+
+/* --------------------------------------------------------------------------
+ * private function load_graph(program, db, srcdir)
+ * --------------------------------------------------------------------------
+ * Returns the build graph of program read from db,  after rescanning the
+ * sources that have changed since they were recorded.  If db has no entry
+ * for a module of the import closure,  scans all sources in srcdir first.
+ * Reports the failure and returns NULL if the graph cannot be read.
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_graph_t load_graph
+  (intstr_t program, m2c_make_depdb_t db, const char *srcdir) {
+  
+  m2c_make_graph_t graph;
+  m2c_make_status_t status;
+  intstr_t failed;
+  
+  graph = m2c_make_load_graph_from_db(program, db, &failed, &status);
+  
+  /* reload if a rescanned module has changed its imports */
+  if ((graph != NULL) && (refresh_graph(graph, db))) {
+    m2c_make_release_graph(&graph);
+    graph = m2c_make_load_graph_from_db(program, db, &failed, &status);
+  } /* end if */
+  
+  /* a module is not in the database, scan the whole tree */
+  if ((graph == NULL) && (status == M2C_MAKE_STATUS_DEP_FILE_NOT_FOUND)) {
+    scan_paths(db, 1, &srcdir);
+    graph = m2c_make_load_graph_from_db(program, db, &failed, &status);
+  } /* end if */
+  
+  if (graph == NULL) {
+    report_load_failure(status, failed, srcdir);
+  } /* end if */
+  
+  return graph;
+} /* end load_graph */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_load_failure(status, failed, srcdir)
+ * --------------------------------------------------------------------------
+ * Reports that the build graph could not be read with status,  because of
+ * module failed.
+ * ----------------------------------------------------------------------- */
+
+static void report_load_failure
+  (m2c_make_status_t status, intstr_t failed, const char *srcdir) {
+  
+  if (status == M2C_MAKE_STATUS_DEP_FILE_NOT_FOUND) {
+    fprintf(stderr, "m2make: no source for module %s in %s\n",
+      intstr_char_ptr(failed), srcdir);
+  }
+  else if (status == M2C_MAKE_STATUS_ALLOCATION_FAILED) {
+    fprintf(stderr, "m2make: out of memory\n");
+  }
+  else /* invalid entry */ {
+    fprintf(stderr, "m2make: imports of module %s could not be read\n",
+      intstr_char_ptr(failed));
+  } /* end if */
+} /* end report_load_failure */
+
+
+/* --------------------------------------------------------------------------
+ * private function refresh_graph(graph, db)
+ * --------------------------------------------------------------------------
+ * Checks the source of every node of graph against its entry in db.  A
+ * source that was only touched gets its attributes updated,  a source whose
+ * content has changed is rescanned.  Returns true if any source was
+ * rescanned,  in which case graph may be out of date.
+ * ----------------------------------------------------------------------- */
+
+static bool refresh_graph (m2c_make_graph_t graph, m2c_make_depdb_t db) {
+  
+  m2c_make_depdb_source_t recorded, source;
+  m2c_make_depdb_status_t db_status;
+  m2c_dep_file_status_t dep_status;
+  uint_t node, node_count, count, index, import_count;
+  const char *path, *defpath, **rescan;
+  intstr_t module, *imports;
+  bool touched;
+  
+  node_count = m2c_make_node_count(graph);
+  
+  /* at most a source and a definition per node */
+  rescan = malloc(2 * node_count * sizeof(const char *));
+  
+  if (rescan == NULL) {
+    return false;
+  } /* end if */
+  
+  count = 0;
+  for (node = 0; node < node_count; node++) {
+    module = m2c_make_node_module(graph, node);
+    
+    if ((m2c_make_depdb_is_current(db, module)) ||
+        NOT(m2c_make_depdb_lookup(db, module, &path, &recorded))) {
+      continue;
+    } /* end if */
+    
+    source = recorded;
+    touched =
+      (m2c_make_depdb_stat_source(path, &source)) &&
+      (m2c_make_depdb_digest_file(path, &source.digest)) &&
+      (source.digest == recorded.digest);
+    
+    if (touched) {
+      /* same content, keep the recorded imports */
+      m2c_make_depdb_read_imports
+        (db, module, &import_count, &imports, &dep_status);
+      
+      if (dep_status == M2C_DEP_FILE_STATUS_SUCCESS) {
+        m2c_make_depdb_update
+          (db, module, path, &source, import_count, imports, &db_status);
+        free(imports);
+        continue;
+      } /* end if */
+    } /* end if */
+    
+    /* the path is only valid until the entry is updated, copy it */
+    defpath = new_def_path(path);
+    rescan[count] = new_cstr_by_concat(path, NULL);
+    
+    if (rescan[count] != NULL) {
+      count++;
+    } /* end if */
+    
+    if (defpath != NULL) {
+      rescan[count] = defpath;
+      count++;
+    } /* end if */
+  } /* end for */
+  
+  if (count > 0) {
+    scan_paths(db, count, rescan);
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    free((void *) rescan[index]);
+  } /* end for */
+  
+  free(rescan);
+  return (count > 0);
+} /* end refresh_graph */
+
+
+/* --------------------------------------------------------------------------
+ * private function scan_paths(db, count, path)
+ * --------------------------------------------------------------------------
+ * Scans the imports of the sources at the count paths in array path,  each
+ * a source file or a directory to walk,  and records them in db.  Reports
+ * paths that do not exist and sources that fail to parse.  Returns true if
+ * all sources were scanned and recorded.
+ * ----------------------------------------------------------------------- */
+
+static bool scan_paths
+  (m2c_make_depdb_t db, uint_t count, const char *path[]) {
+  
+  m2c_mkdep_batch_status_t status;
+  m2c_mkdep_batch_t batch;
+  uint_t index;
+  bool passed;
+  
+  batch = m2c_mkdep_new_batch(&status);
+  
+  if (batch == NULL) {
+    fprintf(stderr, "m2make: out of memory\n");
+    return false;
+  } /* end if */
+  
+  passed = true;
+  for (index = 0; index < count; index++) {
+    m2c_mkdep_batch_add_path(batch, path[index], &status);
+    
+    if (status != M2C_MKDEP_BATCH_STATUS_SUCCESS) {
+      fprintf(stderr, "m2make: %s not found\n", path[index]);
+      passed = false;
+    } /* end if */
+  } /* end for */
+  
+  /* reads are the bottleneck, use the default number of workers */
+  m2c_mkdep_batch_scan(batch, 0, &status);
+  
+  if (status == M2C_MKDEP_BATCH_STATUS_SCAN_FAILED) {
+    fprintf(stderr, "m2make: %u source(s) failed to parse\n",
+      m2c_mkdep_batch_failed_count(batch));
+    passed = false;
+  } /* end if */
+  
+  m2c_mkdep_batch_update_depdb(batch, db, &status);
+  
+  if (status != M2C_MKDEP_BATCH_STATUS_SUCCESS) {
+    fprintf(stderr, "m2make: dependency database could not be updated\n");
+    passed = false;
+  } /* end if */
+  
+  m2c_mkdep_release_batch(&batch);
+  return passed;
+} /* end scan_paths */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_cycle(graph, length, path, context)
+ * --------------------------------------------------------------------------
+ * Reports a cycle of imports in graph with its path  to the stream passed
+ * in context.
+ * ----------------------------------------------------------------------- */
+
+static void report_cycle
+  (m2c_make_graph_t graph, uint_t length, const uint_t *path, void *context) {
+  
+  FILE *out = (FILE *) context;
+  uint_t index;
+  
+  fprintf(out, "m2make: cyclic imports: ");
+  
+  for (index = 0; index < length; index++) {
+    fprintf(out, "%s -> ",
+      intstr_char_ptr(m2c_make_node_module(graph, path[index])));
+  } /* end for */
+  
+  fprintf(out, "%s\n",
+    intstr_char_ptr(m2c_make_node_module(graph, path[0])));
+} /* end report_cycle */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_worker_cache(graph, program)
+ * --------------------------------------------------------------------------
+ * Writes a string snapshot with the symbol files of the interfaces of graph
+ * imported by at least M2C_MAKE_WORKER_CACHE_MIN_IMPORTERS modules  and
+ * returns its newly allocated path,  named after program.  Symbol files not
+ * yet written by an earlier build are left out.  Reports the failure and
+ * returns NULL if no snapshot could be written,  the build then goes ahead
+ * without it.
+ * ----------------------------------------------------------------------- */
+
+static const char *new_worker_cache
+  (m2c_make_graph_t graph, intstr_t program) {
+  
+  m2c_make_worker_cache_status_t status;
+  uint_t node, node_count, count, index;
+  const char *path, **sympath;
+  bool *is_common;
+  
+  node_count = m2c_make_node_count(graph);
+  is_common = malloc(node_count * sizeof(bool));
+  sympath = malloc(node_count * sizeof(const char *));
+  path = new_cstr_by_concat
+    (intstr_char_ptr(program), M2C_MAKE_WORKER_CACHE_SUFFIX, NULL);
+  
+  if ((is_common == NULL) || (sympath == NULL) || (path == NULL)) {
+    fprintf(stderr, "m2make: out of memory\n");
+    free(is_common);
+    free(sympath);
+    free((void *) path);
+    return NULL;
+  } /* end if */
+  
+  m2c_make_common_interfaces
+    (graph, M2C_MAKE_WORKER_CACHE_MIN_IMPORTERS, is_common);
+  
+  count = 0;
+  for (node = 0; node < node_count; node++) {
+    if (NOT(is_common[node])) {
+      continue;
+    } /* end if */
+    
+    sympath[count] = new_cstr_by_concat
+      (intstr_char_ptr(m2c_make_node_module(graph, node)), SYM_SUFFIX, NULL);
+    
+    if ((sympath[count] != NULL) && (file_exists(sympath[count]))) {
+      count++;
+    }
+    else /* not built yet */ {
+      free((void *) sympath[count]);
+    } /* end if */
+  } /* end for */
+  
+  m2c_make_write_worker_cache(path, count, sympath, &status);
+  
+  if (status != M2C_MAKE_WORKER_CACHE_STATUS_SUCCESS) {
+    fprintf(stderr, "m2make: worker cache %s could not be written\n", path);
+    free((void *) path);
+    path = NULL;
+  } /* end if */
+  
+  for (index = 0; index < count; index++) {
+    free((void *) sympath[index]);
+  } /* end for */
+  
+  free(is_common);
+  free(sympath);
+  
+  return path;
+} /* end new_worker_cache */
+
+
+/* --------------------------------------------------------------------------
+ * private function resize_context(context, node_count)
+ * --------------------------------------------------------------------------
+ * Replaces the arrays of context with cleared arrays for node_count nodes.
+ * Returns false and leaves context unchanged if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool resize_context (build_context_t *context, uint_t node_count) {
+  
+  m2c_digest_value_t *fingerprint;
+  bool *built;
+  
+  fingerprint = calloc(node_count, sizeof(m2c_digest_value_t));
+  built = calloc(node_count, sizeof(bool));
+  
+  if ((fingerprint == NULL) || (built == NULL)) {
+    fprintf(stderr, "m2make: out of memory\n");
+    free(fingerprint);
+    free(built);
+    return false;
+  } /* end if */
+  
+  free(context->fingerprint);
+  free(context->built);
+  
+  context->node_count = node_count;
+  context->fingerprint = fingerprint;
+  context->built = built;
+  
+  return true;
+} /* end resize_context */
+
+
+/* --------------------------------------------------------------------------
+ * private function build(graph, context, jobs, jobserver)
+ * --------------------------------------------------------------------------
+ * Builds the modules of acyclic graph on up to jobs workers sharing
+ * jobserver,  critical path first,  with the sources recorded in the
+ * database of context.  Updates the build timing history with the durations
+ * of the modules built.  Returns true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool build
+  (m2c_make_graph_t graph, build_context_t *context,
+   uint_t jobs, m2c_jobserver_t jobserver) {
+  
+  outfile_status_t timings_status;
+  m2c_make_status_t status;
+  uint_t node, *cost;
+  intstr_t failed;
+  
+  cost = malloc(context->node_count * sizeof(uint_t));
+  
+  if (cost == NULL) {
+    fprintf(stderr, "m2make: out of memory\n");
+    return false;
+  } /* end if */
+  
+  /* weigh the critical path by the durations of earlier builds */
+  m2c_make_read_timings(M2C_MAKE_TIMINGS_FILE, graph, cost);
+  m2c_make_set_priorities(graph, cost);
+  
+  /* read the files of the next modules while earlier ones compile */
+  context->prefetch = new_build_prefetch(graph, context->db);
+  
+  m2c_make_run
+    (graph, jobs, jobserver, build_module, context, &failed, &status);
+  
+  m2c_make_release_prefetch(&context->prefetch);
+  
+  if (status == M2C_MAKE_STATUS_JOB_FAILED) {
+    fprintf(stderr, "m2make: build of module %s failed\n",
+      intstr_char_ptr(failed));
+  }
+  else if (status != M2C_MAKE_STATUS_SUCCESS) {
+    fprintf(stderr, "m2make: build could not be started\n");
+  } /* end if */
+  
+  /* blend the durations of the modules built into the history */
+  for (node = 0; node < context->node_count; node++) {
+    if (context->built[node]) {
+      cost[node] = m2c_make_blend_duration
+        (cost[node], m2c_make_node_duration(graph, node));
+    } /* end if */
+  } /* end for */
+  
+  m2c_make_write_timings
+    (M2C_MAKE_TIMINGS_FILE, graph, cost, &timings_status);
+  
+  free(cost);
+  
+  return (status == M2C_MAKE_STATUS_SUCCESS);
+} /* end build */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_build_prefetch(graph, db)
+ * --------------------------------------------------------------------------
+ * Returns a started prefetcher for the modules of acyclic graph in build
+ * order,  each with its sources recorded in db  and the symbol and export
+ * files of the modules it imports,  each of those with its first importer
+ * only.  Returns NULL if prefetching is not available or failed to start.
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_prefetch_t new_build_prefetch
+  (m2c_make_graph_t graph, m2c_make_depdb_t db) {
+  
+  uint_t index, node, node_count, import_index, import_count, import;
+  m2c_make_prefetch_status_t status;
+  m2c_make_prefetch_t prefetch;
+  const char *path, *file;
+  bool *seen;
+  
+  node_count = m2c_make_node_count(graph);
+  seen = calloc(node_count, sizeof(bool));
+  prefetch = m2c_make_new_prefetch(0, &status);
+  
+  if ((seen == NULL) || (prefetch == NULL)) {
+    free(seen);
+    m2c_make_release_prefetch(&prefetch);
+    return NULL;
+  } /* end if */
+  
+  for (index = 0; index < node_count; index++) {
+    node = m2c_make_build_order_node(graph, index);
+    
+    if (m2c_make_depdb_lookup
+        (db, m2c_make_node_module(graph, node), &path, NULL)) {
+      m2c_make_prefetch_add(prefetch, path, &status);
+      
+      file = new_def_path(path);
+      if (file != NULL) {
+        m2c_make_prefetch_add(prefetch, file, &status);
+        free((void *) file);
+      } /* end if */
+    } /* end if */
+    
+    /* products of imports are read by every importer, add them once */
+    import_count = m2c_make_import_count(graph, node);
+    for (import_index = 0; import_index < import_count; import_index++) {
+      import = m2c_make_import_at_index(graph, node, import_index);
+      
+      if (seen[import]) {
+        continue;
+      } /* end if */
+      
+      seen[import] = true;
+      
+      file = new_cstr_by_concat
+        (intstr_char_ptr(m2c_make_node_module(graph, import)),
+         SYM_SUFFIX, NULL);
+      m2c_make_prefetch_add(prefetch, file, &status);
+      free((void *) file);
+      
+      file = new_cstr_by_concat
+        (intstr_char_ptr(m2c_make_node_module(graph, import)),
+         EXL_SUFFIX, NULL);
+      m2c_make_prefetch_add(prefetch, file, &status);
+      free((void *) file);
+    } /* end for */
+    
+    m2c_make_prefetch_next_module(prefetch);
+  } /* end for */
+  
+  free(seen);
+  
+  m2c_make_prefetch_start(prefetch, &status);
+  
+  if (status != M2C_MAKE_PREFETCH_STATUS_SUCCESS) {
+    m2c_make_release_prefetch(&prefetch);
+  } /* end if */
+  
+  return prefetch;
+} /* end new_build_prefetch */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure watch_sources(graph, context, jobs, jobserver)
+ * --------------------------------------------------------------------------
+ * Watches the source directory of context  and rebuilds the modules of graph
+ * affected by each change on up to jobs workers sharing jobserver.  Takes
+ * ownership of graph.  Returns only if the watch fails.
+ * ----------------------------------------------------------------------- */
+
+static void watch_sources
+  (m2c_make_graph_t graph, build_context_t *context,
+   uint_t jobs, m2c_jobserver_t jobserver) {
+  
+  m2c_make_watch_handlers_t handlers;
+  m2c_make_watch_status_t status;
+  m2c_make_watch_t watch;
+  
+  watch = m2c_make_new_watch(graph, &status);
+  
+  if (watch == NULL) {
+    fprintf(stderr, "m2make: watch could not be started\n");
+    m2c_make_release_graph(&graph);
+    return;
+  } /* end if */
+  
+  m2c_make_watch_add_dir(watch, context->srcdir, &status);
+  
+  if (status != M2C_MAKE_WATCH_STATUS_SUCCESS) {
+    fprintf(stderr, "m2make: %s could not be watched\n", context->srcdir);
+    m2c_make_release_watch(&watch);
+    return;
+  } /* end if */
+  
+  handlers.rescan = rescan_module;
+  handlers.reload = reload_graph;
+  handlers.build = build_module;
+  handlers.report = report_rebuild;
+  handlers.context = context;
+  
+  /* rebuilds count only the modules they compile themselves */
+  memset(context->built, 0, context->node_count * sizeof(bool));
+  
+  printf("m2make: watching %s\n", context->srcdir);
+  fflush(stdout);
+  
+  m2c_make_watch_run(watch, jobs, jobserver, &handlers, &status);
+  
+  fprintf(stderr, "m2make: watch of %s failed\n", context->srcdir);
+  m2c_make_release_watch(&watch);
+} /* end watch_sources */
+
+
+/* --------------------------------------------------------------------------
+ * private function rescan_module(module, changed, context)
+ * --------------------------------------------------------------------------
+ * Rescan handler of a watch.  Rescans the sources of module,  found through
+ * the database of context or,  for a module not yet recorded,  in its source
+ * directory.  Passes true in changed if the imports of module differ from
+ * those recorded before.  Returns false if the sources could not be scanned.
+ * ----------------------------------------------------------------------- */
+
+static bool rescan_module (intstr_t module, bool *changed, void *context) {
+  
+  build_context_t *build = (build_context_t *) context;
+  uint_t old_count, new_count, index, count;
+  m2c_dep_file_status_t old_status, new_status;
+  intstr_t *old_imports, *new_imports;
+  const char *path, *rescan[2];
+  bool passed;
+  
+  m2c_make_depdb_read_imports
+    (build->db, module, &old_count, &old_imports, &old_status);
+  
+  /* the path is only valid until the entry is updated, copy it */
+  if (m2c_make_depdb_lookup(build->db, module, &path, NULL)) {
+    rescan[0] = new_cstr_by_concat(path, NULL);
+  }
+  else /* new module */ {
+    rescan[0] = new_cstr_by_concat
+      (build->srcdir, "/", intstr_char_ptr(module), MOD_SUFFIX, NULL);
+    
+    if ((rescan[0] != NULL) && NOT(file_exists(rescan[0]))) {
+      free((void *) rescan[0]);
+      rescan[0] = new_cstr_by_concat
+        (build->srcdir, "/", intstr_char_ptr(module), DEF_SUFFIX, NULL);
+    } /* end if */
+  } /* end if */
+  
+  if (rescan[0] == NULL) {
+    free(old_imports);
+    return false;
+  } /* end if */
+  
+  rescan[1] = new_def_path(rescan[0]);
+  count = (rescan[1] != NULL) ? 2 : 1;
+  
+  passed = scan_paths(build->db, count, rescan);
+  
+  m2c_make_depdb_read_imports
+    (build->db, module, &new_count, &new_imports, &new_status);
+  
+  *changed =
+    (old_status != new_status) || (old_count != new_count);
+  
+  for (index = 0; NOT(*changed) && (index < new_count); index++) {
+    *changed = (old_imports[index] != new_imports[index]);
+  } /* end for */
+  
+  free(old_imports);
+  free(new_imports);
+  free((void *) rescan[0]);
+  free((void *) rescan[1]);
+  
+  return passed;
+} /* end rescan_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function reload_graph(context)
+ * --------------------------------------------------------------------------
+ * Reload handler of a watch.  Writes the database of context  and returns a
+ * new build graph of the program read from it,  with the arrays of context
+ * resized for the new graph.  Reports the failure and returns NULL if the
+ * graph cannot be read or has cycles of imports.
+ * ----------------------------------------------------------------------- */
+
+static m2c_make_graph_t reload_graph (void *context) {
+  
+  build_context_t *build = (build_context_t *) context;
+  m2c_make_depdb_status_t db_status;
+  m2c_make_status_t status;
+  m2c_make_graph_t graph;
+  intstr_t failed;
+  
+  m2c_make_depdb_write(build->db, M2C_MAKE_DEPDB_FILE, &db_status);
+  
+  graph = m2c_make_load_graph_from_db
+    (build->program, build->db, &failed, &status);
+  
+  if (graph == NULL) {
+    report_load_failure(status, failed, build->srcdir);
+    return NULL;
+  } /* end if */
+  
+  /* the watch keeps the old graph and arrays if this one is rejected */
+  if ((m2c_make_check_cycles(graph, report_cycle, stderr, &status) > 0) ||
+      NOT(resize_context(build, m2c_make_node_count(graph)))) {
+    m2c_make_release_graph(&graph);
+    return NULL;
+  } /* end if */
+  
+  return graph;
+} /* end reload_graph */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure report_rebuild(graph, affected, status, failed, ...)
+ * --------------------------------------------------------------------------
+ * Report handler of a watch.  Reports the result of a rebuild,  counting
+ * the modules of graph the build context records as compiled,  and clears
+ * those records for the next rebuild.
+ * ----------------------------------------------------------------------- */
+
+static void report_rebuild
+  (m2c_make_graph_t graph, uint_t affected, m2c_make_status_t status,
+   intstr_t failed_module, void *context) {
+  
+  build_context_t *build = (build_context_t *) context;
+  uint_t node, compiled;
+  
+  /* modules with current stamps are affected but not compiled */
+  compiled = 0;
+  for (node = 0; node < build->node_count; node++) {
+    if (build->built[node]) {
+      build->built[node] = false;
+      compiled++;
+    } /* end if */
+  } /* end for */
+  
+  if (status == M2C_MAKE_STATUS_SUCCESS) {
+    printf("m2make: %u of %u module(s) affected, %u compiled\n",
+      affected, m2c_make_node_count(graph), compiled);
+  }
+  else if (status == M2C_MAKE_STATUS_JOB_FAILED) {
+    fprintf(stderr, "m2make: build of module %s failed\n",
+      intstr_char_ptr(failed_module));
+  }
+  else /* graph not reloaded */ {
+    fprintf(stderr,
+      "m2make: building previous imports until the sources are fixed\n");
+  } /* end if */
+  
+  fflush(stdout);
+} /* end report_rebuild */
+
+
+/* --------------------------------------------------------------------------
+ * private function build_module(graph, node, worker, context)
+ * --------------------------------------------------------------------------
+ * Job handler.  Calls the compiler on the sources of the module of node on
+ * behalf of worker,  unless its stamp file records the same source
+ * fingerprint and the same effective fingerprints of its imports as now.
+ * Writes the stamp file after a successful build and stores the effective
+ * fingerprint of the module in the build context for its importers.  Returns
+ * true on success.
+ * ----------------------------------------------------------------------- */
+
+static bool build_module
+  (m2c_make_graph_t graph, uint_t node, uint_t worker, void *context) {
+  
+  build_context_t *build = (build_context_t *) context;
+  m2c_digest_value_t own, *fingerprint;
+  m2c_make_depdb_source_t source;
+  outfile_status_t stamp_status;
+  const char *path, *defpath, *stamppath, *exlpath;
+  uint_t count, index, import;
+  intstr_t module, *import_id;
+  bool passed;
+  
+  /* move the prefetch window on by one module */
+  m2c_make_prefetch_advance(build->prefetch);
+  
+  module = m2c_make_node_module(graph, node);
+  
+  if (NOT(m2c_make_depdb_lookup(build->db, module, &path, &source))) {
+    return false;
+  } /* end if */
+  
+  /* entry zero stands for the sources of the module itself */
+  count = m2c_make_import_count(graph, node);
+  import_id = malloc((count + 1) * sizeof(intstr_t));
+  fingerprint = malloc((count + 1) * sizeof(m2c_digest_value_t));
+  defpath = new_def_path(path);
+  
+  stamppath = new_cstr_by_concat
+    (intstr_char_ptr(module), M2C_MAKE_STAMP_SUFFIX, NULL);
+  exlpath = new_cstr_by_concat(intstr_char_ptr(module), EXL_SUFFIX, NULL);
+  
+  if ((import_id == NULL) || (fingerprint == NULL) ||
+      (stamppath == NULL) || (exlpath == NULL)) {
+    passed = false;
+  }
+  else /* check stamp */ {
+    import_id[0] = module;
+    fingerprint[0] = source_fingerprint(&source, defpath);
+    
+    for (index = 0; index < count; index++) {
+      import = m2c_make_import_at_index(graph, node, index);
+      import_id[index + 1] = m2c_make_node_module(graph, import);
+      fingerprint[index + 1] = build->fingerprint[import];
+    } /* end for */
+    
+    if (m2c_make_stamp_is_current
+        (stamppath, count + 1, import_id, fingerprint)) {
+      passed = true;
+    }
+    else /* build */ {
+      build->built[node] = true;
+      
+      printf("m2make: [%u] compiling %s\n", worker, intstr_char_ptr(module));
+      fflush(stdout);
+      
+      passed = run_compiler(defpath, path, build->worker_cache);
+      
+      if (passed) {
+        m2c_make_write_stamp
+          (stamppath, count + 1, import_id, fingerprint, &stamp_status);
+      } /* end if */
+    } /* end if */
+    
+    /* a program module has no export list, use its sources instead */
+    if (passed) {
+      if (NOT(m2c_make_read_fingerprint(exlpath, &own))) {
+        own = fingerprint[0];
+      } /* end if */
+      
+      build->fingerprint[node] =
+        m2c_make_effective_fingerprint(own, count, &fingerprint[1]);
+    } /* end if */
+  } /* end if */
+  
+  free(import_id);
+  free(fingerprint);
+  free((void *) defpath);
+  free((void *) stamppath);
+  free((void *) exlpath);
+  
+  return passed;
+} /* end build_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function source_fingerprint(source, defpath)
+ * --------------------------------------------------------------------------
+ * Returns a fingerprint of the sources of a module,  combining the recorded
+ * digest of its source with the digest of its definition at defpath,  which
+ * the database does not record.  Defpath may be NULL.
+ * ----------------------------------------------------------------------- */
+
+static m2c_digest_value_t source_fingerprint
+  (const m2c_make_depdb_source_t *source, const char *defpath) {
+  
+  m2c_digest_value_t def_digest;
+  
+  if ((defpath == NULL) ||
+      NOT(m2c_make_depdb_digest_file(defpath, &def_digest))) {
+    return m2c_make_effective_fingerprint(source->digest, 0, NULL);
+  } /* end if */
+  
+  return m2c_make_effective_fingerprint(source->digest, 1, &def_digest);
+} /* end source_fingerprint */
+
+
+/* --------------------------------------------------------------------------
+ * private function new_def_path(path)
+ * --------------------------------------------------------------------------
+ * Returns a newly allocated path of the definition module next to the
+ * implementation module at path,  or NULL if path is not an implementation
+ * or program module or there is no such file.
+ * ----------------------------------------------------------------------- */
+
+static const char *new_def_path (const char *path) {
+  
+  uint_t length, suffix_length;
+  char *defpath;
+  
+  length = cstr_length(path);
+  suffix_length = sizeof(MOD_SUFFIX) - 1;
+  
+  if ((length <= suffix_length) ||
+      (strcmp(path + length - suffix_length, MOD_SUFFIX) != 0)) {
+    return NULL;
+  } /* end if */
+  
+  defpath = malloc(length + 1);
+  
+  if (defpath == NULL) {
+    return NULL;
+  } /* end if */
+  
+  memcpy(defpath, path, length - suffix_length);
+  strcpy(defpath + length - suffix_length, DEF_SUFFIX);
+  
+  if (NOT(file_exists(defpath))) {
+    free(defpath);
+    return NULL;
+  } /* end if */
+  
+  return defpath;
+} /* end new_def_path */
+
+
+/* --------------------------------------------------------------------------
+ * private function run_compiler(defpath, path, worker_cache)
+ * --------------------------------------------------------------------------
+ * Calls the compiler on the definition at defpath,  unless it is NULL,  and
+ * the source at path,  passing the string snapshot at worker_cache,  unless
+ * it is NULL,  and waits for it to finish.  Returns true if the compiler
+ * exited with status zero.
+ * ----------------------------------------------------------------------- */
+
+static bool run_compiler
+  (const char *defpath, const char *path, const char *worker_cache) {
+  
+#if (M2C_MAKE_SPAWN)
+  char *argv[6];
+  uint_t argc;
+  pid_t pid;
+  int code;
+  
+  argc = 0;
+  argv[argc++] = COMPILER;
+  
+  if (worker_cache != NULL) {
+    argv[argc++] = "--worker-cache";
+    argv[argc++] = (char *) worker_cache;
+  } /* end if */
+  
+  if (defpath != NULL) {
+    argv[argc++] = (char *) defpath;
+  } /* end if */
+  
+  argv[argc++] = (char *) path;
+  argv[argc] = NULL;
+  
+  if (posix_spawnp(&pid, COMPILER, NULL, NULL, argv, environ) != 0) {
+    fprintf(stderr, "m2make: %s could not be started\n", COMPILER);
+    return false;
+  } /* end if */
+  
+  /* wait for this child only, other workers wait for theirs */
+  if (waitpid(pid, &code, 0) != pid) {
+    return false;
+  } /* end if */
+  
+  return (WIFEXITED(code)) && (WEXITSTATUS(code) == 0);
+#else
+  const char *command, *option, *cache;
+  int code;
+  
+  option = (worker_cache != NULL) ? " --worker-cache " : "";
+  cache = (worker_cache != NULL) ? worker_cache : "";
+  
+  if (defpath != NULL) {
+    command = new_cstr_by_concat
+      (COMPILER, option, cache, " ", defpath, " ", path, NULL);
+  }
+  else /* source only */ {
+    command = new_cstr_by_concat(COMPILER, option, cache, " ", path, NULL);
+  } /* end if */
+  
+  if (command == NULL) {
+    return false;
+  } /* end if */
+  
+  code = system(command);
+  free((void *) command);
+  
+  return (code == 0);
+#endif
+} /* end run_compiler */
+
+/* END OF FILE */
@@ -42,19 +42,26 @@
  * ----------------------------------------------------------------------- */
 
 #include "m2c-dep-list.h"
+#include "fifo.h"
+
+#include <stdlib.h>
+#include <string.h>
 
 
 /* --------------------------------------------------------------------------
  * hidden type m2c_dep_list_s
  * --------------------------------------------------------------------------
- * Module dependency list.
+ * Module dependency list.  The entries follow the header in the same
+ * allocation.
  * ----------------------------------------------------------------------- */
 
-typedef struct {
-  intstr_t module_id;
-  uint entry_count;
-  intstr_t entry[];
-} m2c_dep_list_s;
+struct m2c_dep_list_s {
+  /* module_id */    intstr_t module_id;
+  /* entry_count */  uint_t entry_count;
+  /* entry */        intstr_t entry[];
+};
+
+typedef struct m2c_dep_list_s m2c_dep_list_s;
 
 
 /* --------------------------------------------------------------------------
@@ -73,8 +80,8 @@ static m2c_dep_list_status_t last_status = M2C_DEP_LIST_STATUS_SUCCESS;
 
 m2c_dep_list_t m2c_new_dep_list (intstr_t module_id, m2c_fifo_t item_list) {
 
-  m2c_dep_list_t new_dep_list;
-  uint_t index;
+  m2c_dep_list_t new_list;
+  uint_t index, entry_count;
   
   if (module_id == NULL) {
     last_status = M2C_DEP_LIST_STATUS_INVALID_REFERENCE;
@@ -93,11 +100,10 @@ m2c_dep_list_t m2c_new_dep_list (intstr_t module_id, m2c_fifo_t item_list) {
   
   new_list->module_id = module_id;
   
-  index = 0;
-  while (index < entry_count) {
-    new_list->entry[index] = m2c_fifo_dequeue(item_list);
-    index++;
-  } /* end while */
+  /* copy out of the ring buffer, item_list is left unchanged */
+  for (index = 0; index < entry_count; index++) {
+    new_list->entry[index] = m2c_fifo_entry_at_index(item_list, index);
+  } /* end for */
 
   new_list->entry_count = entry_count;
   
@@ -106,6 +112,43 @@ m2c_dep_list_t m2c_new_dep_list (intstr_t module_id, m2c_fifo_t item_list) {
 } /* end m2c_new_dep_list */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_new_dep_list_from_array(module_id, count, items)
+ * --------------------------------------------------------------------------
+ * Creates a new dependency list for module_id  from the count identifiers
+ * in array items  and returns it,  or NULL on failure.  The status of the
+ * operation is stored in last_status.
+ * ----------------------------------------------------------------------- */
+
+m2c_dep_list_t m2c_new_dep_list_from_array
+  (intstr_t module_id, uint_t count, const intstr_t items[]) {
+  
+  m2c_dep_list_t new_list;
+  
+  if ((module_id == NULL) || ((count > 0) && (items == NULL))) {
+    last_status = M2C_DEP_LIST_STATUS_INVALID_REFERENCE;
+    return NULL;
+  } /* end if */
+  
+  new_list = malloc(sizeof(m2c_dep_list_s) + count * sizeof(intstr_t));
+  
+  if (new_list == NULL) {
+    last_status = M2C_DEP_LIST_STATUS_ALLOCATION_FAILED;
+    return NULL;
+  } /* end if */
+  
+  new_list->module_id = module_id;
+  new_list->entry_count = count;
+  
+  if (count > 0) {
+    memcpy(new_list->entry, items, count * sizeof(intstr_t));
+  } /* end if */
+  
+  last_status = M2C_DEP_LIST_STATUS_SUCCESS;
+  return new_list;
+} /* end m2c_new_dep_list_from_array */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_dep_list_module(dep_list)
  * --------------------------------------------------------------------------
@@ -157,17 +200,37 @@ intstr_t m2c_dep_list_item_at_index (m2c_dep_list_t dep_list, uint_t index) {
     last_status = M2C_DEP_LIST_STATUS_INVALID_REFERENCE;
     return NULL;
   }
-  else (index >= dep_list->entry_count) {
+  else if (index >= dep_list->entry_count) {
     last_status = M2C_DEP_LIST_STATUS_INVALID_INDEX;
     return NULL;
   }
   else {
     last_status = M2C_DEP_LIST_STATUS_SUCCESS;
-    return new_list->entry[index];
+    return dep_list->entry[index];
   } /* end if */
 } /* end m2c_dep_list_item_at_index */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_dep_list_items(dep_list)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the packed array of the dependencies stored in
+ * dep_list,  or NULL if dep_list is invalid.
+ * ----------------------------------------------------------------------- */
+
+const intstr_t *m2c_dep_list_items (m2c_dep_list_t dep_list) {
+
+  if (dep_list == NULL) {
+    last_status = M2C_DEP_LIST_STATUS_INVALID_REFERENCE;
+    return NULL;
+  }
+  else {
+    last_status = M2C_DEP_LIST_STATUS_SUCCESS;
+    return dep_list->entry;
+  } /* end if */
+} /* end m2c_dep_list_items */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_dep_list_last_status()
  * --------------------------------------------------------------------------
@@ -181,15 +244,20 @@ m2c_dep_list_status_t m2c_dep_list_last_status (void) {
 
 
 /* --------------------------------------------------------------------------
- * procedure m2c_dep_list_release(dep_list)
+ * procedure m2c_dep_list_dispose(dep_list)
  * --------------------------------------------------------------------------
  * Deallocates dep_list and passes NULL in dep_list.
  * ----------------------------------------------------------------------- */
 
-void m2c_dep_list_release (m2c_dep_list_t *dep_list) {
+void m2c_dep_list_dispose (m2c_dep_list_t *dep_list) {
 
-/* TO DO */
+  if (dep_list == NULL) {
+    return;
+  } /* end if */
+  
+  free(*dep_list);
+  *dep_list = NULL;
+} /* end m2c_dep_list_dispose */
 
-} /* end m2c_dep_list_release */
 
 /* END OF FILE */
\ No newline at end of file
@@ -47,15 +47,18 @@
 
 #include "interned-strings.h"
 #include "m2c-common.h"
+#include "fifo.h"
 
 
 /* --------------------------------------------------------------------------
  * opaque type m2c_dep_list_t
  * --------------------------------------------------------------------------
- * Module dependency list.
+ * Module dependency list.  The identifiers of the imported modules are held
+ * in a single packed array  that may be read directly,  see function
+ * m2c_dep_list_items.
  * ----------------------------------------------------------------------- */
 
-typedef m2c_dep_list_s *m2c_dep_list_t;
+typedef struct m2c_dep_list_s *m2c_dep_list_t;
 
 
 /* --------------------------------------------------------------------------
@@ -65,8 +68,8 @@ typedef m2c_dep_list_s *m2c_dep_list_t;
 typedef enum {
   M2C_DEP_LIST_STATUS_SUCCESS,
   M2C_DEP_LIST_STATUS_INVALID_REFERENCE,
-  M2C_DEP_LIST_STATUS_ALLOCATION_FAILED
-  M2C_DEP_LIST_STATUS_INVALID_INDEX,
+  M2C_DEP_LIST_STATUS_ALLOCATION_FAILED,
+  M2C_DEP_LIST_STATUS_INVALID_INDEX
 } m2c_dep_list_status_t;
 
 
@@ -80,6 +83,17 @@ typedef enum {
 m2c_dep_list_t m2c_new_dep_list (intstr_t module_id, m2c_fifo_t item_list);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_new_dep_list_from_array(module_id, count, items)
+ * --------------------------------------------------------------------------
+ * Creates a new dependency list for module_id  from the count identifiers
+ * in array items  and returns it,  or NULL on failure.
+ * ----------------------------------------------------------------------- */
+
+m2c_dep_list_t m2c_new_dep_list_from_array
+  (intstr_t module_id, uint_t count, const intstr_t items[]);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_dep_list_module(dep_list)
  * --------------------------------------------------------------------------
@@ -108,6 +122,18 @@ uint_t m2c_dep_list_item_count (m2c_dep_list_t dep_list);
 intstr_t m2c_dep_list_item_at_index (m2c_dep_list_t dep_list, uint_t index);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_dep_list_items(dep_list)
+ * --------------------------------------------------------------------------
+ * Returns a pointer to the packed array of the dependencies stored in
+ * dep_list,  as many as m2c_dep_list_item_count returns,  or NULL if
+ * dep_list is invalid.  The array is valid until dep_list is disposed of
+ * and may be passed as is to m2c_write_dep_file and m2c_write_dep_bin_file.
+ * ----------------------------------------------------------------------- */
+
+const intstr_t *m2c_dep_list_items (m2c_dep_list_t dep_list);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_dep_list_last_status()
  * --------------------------------------------------------------------------
@@ -42,22 +42,11 @@
  * ----------------------------------------------------------------------- */
 
 #include "m2c-import-parser.h"
-#include "m2c-import-lexer.h"
+#include "m2c-parser.h"
+#include "m2c-ast.h"
+#include "m2c-compiler-options.h"
 #include "interned-strings.h"
-
-
-/* --------------------------------------------------------------------------
- * private type parser_context_t
- * ----------------------------------------------------------------------- */
-
-typedef parser_context_s *parser_context_t;
-
-typedef struct {
-  m2c_import_lexer_t lexer;
-  intstr_t module_id;
-  m2c_fifo_t import_list;
-  uint_t error_count;
-} parser_context_s;
+#include "fifo.h"
 
 
 /* --------------------------------------------------------------------------
@@ -69,352 +58,96 @@ typedef struct {
  * is passed back in status.
  * ----------------------------------------------------------------------- */
  
- static m2c_token_t module_header_and_import (parser_context_t p);
- 
- void m2c_parse_imports
-   (const intstr_t src_path,        /* in */
-    m2c_dep_list_t *dep_list,       /* out */
-    m2c_parser_status_t *status) {  /* out */
-
-  import_parser_t parser;
-  import_lexer_t lexer;
-  
-  new_import_lexer(lexer, src_path, lexer_status);
-
-  if ( /*TO DO : check status for errors */ ) {
-    *dep_list = NULL;
-    /* TO DO : set status */
-    return;
-  } /* end if */
-
-  parser = malloc(sizeof(import_parser_s));
+static m2c_ast_visit_action_t collect_ident
+  (m2c_astnode_t node, void *import_list);
 
-  if (parser == NULL) {
-    *dep_list = NULL;
-    *status = M2C_IMPORT_PARSER_STATUS_ALLOCATION_FAILED;
-    return;
-  } /* end if */
+void m2c_parse_imports
+  (const intstr_t src_path,        /* in */
+   m2c_dep_list_t *dep_list,       /* out */
+   m2c_parser_status_t *status) {  /* out */
   
-  parser->lexer = lexer;
-  parser->module_id = NULL;
-  parser->import_list = NULL;
-  parser->error_count = 0;
+  m2c_ast_region_t region;
+  m2c_astnode_t ast, module_node;
+  m2c_parser_status_t parser_status;
+  m2c_fifo_t import_list;
+  m2c_stats_t stats;
+  intstr_t module_id;
   
-  parse_module_header_and_import(&parser);
+  *dep_list = NULL;
   
-  /* TO DO : status */
-
-  *list = m2c_new_dep_list(parser->module_id, parser->import_list);
-
-  /* TO DO : deallocate lexer and parser contexts */
+  /* the header AST is only needed until the list is built */
+  region = m2c_ast_new_region(0);
   
-  return;
-} /* end m2c_parse_imports */
-
-
-/* *********************************************************************** *
- * P R I V A T E   F U N C T I O N S                                       *
- * *********************************************************************** */
-
-/* --------------------------------------------------------------------------
- * private function module_header_and_import(p)
- * --------------------------------------------------------------------------
- * moduleHeaderAndImport :=
- *   defModHdrAndImport | impOrPgmModHdrAndImport
- *   ;
- * ----------------------------------------------------------------------- */
-
-static m2c_token_t def_mod_hdr_and_import (parser_context_t p);
-static m2c_token_t imp_or_pgm_mod_hdr_and_import (parser_context_t p);
-
-static m2c_token_t module_header_and_import (parser_context_t p) {
-  m2c_token_t lookahead;
-
-  lookahead = m2c_next_sym(p->lexer);
-   
-  switch (lookahead) {
-    case TOKEN_DEFINITION :
-      lookahead = def_mod_hdr_and_import(p);
-      break;
-      
-    case TOKEN_IMPLEMENTATION :
-    case TOKEN_MODULE:
-      lookahead = imp_or_pgm_mod_hdr_and_import(p);
-      break;
-  } /* end switch */
+  if (region == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
   
-  return lookahead;
-} /* end module_header_and_import */
-
-
-/* --------------------------------------------------------------------------
- * private function def_mod_hdr_and_import(p)
- * --------------------------------------------------------------------------
- * defModHdrAndImport :=
- *   DEFINITION MODULE moduleIdent ';'
- *   import* endOfDefModImport;
- *   ;
- *
- * alias moduleIdent = Ident ;
- *
- * endOfDefModImport := CONST | TYPE | VAR | PROCEDURE | TO | EndOfFile ;
- * ----------------------------------------------------------------------- */
-
-static m2c_token_t import (parser_context_t p);
-
-static m2c_token_t def_mod_hdr_and_import (parser_context_t p) {
-  m2c_token_t lookahead;
+  m2c_ast_set_region(region);
   
-  /* DEFINITION */
-  lookahead = m2c_consume_sym(p->lexer);
+  stats = NULL;
+  ast = m2c_parse_header(intstr_char_ptr(src_path),
+    m2c_compiler_options_snapshot(), &stats, &parser_status);
   
-  /* MODULE */
-  if (lookahead == TOKEN_MODULE) {
-    lookahead = m2c_consume_sym(p->lexer);
-    
-    /* moduleIdent */
-    if (match_token(TOKEN_IDENTIFIER, RESYNC(IMPORT_OR_DEFINITION_OR_END))) {
-      lookahead = m2c_consume_sym(p->lexer);
-      
-      /* collect module identifier */
-      p->module_id = m2c_lexer_current_lexeme(p->lexer);
-      
-      /* ';' */
-      if (match_token(TOKEN_SEMICOLON, RESYNC(IMPORT_DEFINITION_OR_END))) {
-        lookahead = m2c_consume_sym(p->lexer);
-      }
-      else /* resync */ {
-        lookahead = m2c_next_sym(p->lexer);
-      } /* end if */
-    }
-    else /* resync */ {
-      lookahead = m2c_next_sym(p->lexer);
-    } /* end if */
-  }
-  else /* resync */ {
-    lookahead = m2c_next_sym(p->lexer);
+  if ((ast == NULL) || (stats == NULL)) {
+    m2c_ast_set_region(NULL);
+    m2c_ast_release_region(region);
+    SET_STATUS(status, parser_status);
+    return;
   } /* end if */
   
-  /* initialise list for imported libraries */
-  p->import_list = m2c_fifo_new_queue(NULL);
-
-  /* import* */
-  while (lookahead == TOKEN_IMPORT) {
-    lookahead = import(p->lexer);
-  } /* end while */
+  /* (FILE fnameNode keyNode (MOD identNode importNode emptyNode)) */
+  module_node = m2c_ast_subnode_at_index(ast, 2);
+  module_id = m2c_ast_value(m2c_ast_subnode_at_index(module_node, 0));
   
-  /* endOfDefModImport */
-  if (match_set(FIRST(END_OF_DEF_IMPORT), RESYNC(END_OR_EOF))) {
-    m2c_consume_sym(p->lexer);
-  } /* end if */
+  /* collect identifiers of imported modules */
+  import_list = m2c_fifo_new_queue(NULL);
+  m2c_ast_visit(m2c_ast_subnode_at_index(module_node, 1),
+    collect_ident, NULL, import_list);
   
-  return lookahead;
-} /* end def_mod_hdr_and_import */
-
-
-/* --------------------------------------------------------------------------
- * private function import()
- * --------------------------------------------------------------------------
- * import :=
- *   IMPORT libIdent reExport? ( ',' libIdent reExport? )* ';'
- *   ;
- *
- * alias libIdent = Ident ;
- *
- * alias reExport = '+' ;
- * ----------------------------------------------------------------------- */
-
-static m2c_token_t import (parser_context_t p) {
-  m2c_token_t lookahead;
-  intstr_t library_id = NULL;
+  *dep_list = m2c_new_dep_list(module_id, import_list);
   
-  /* IMPORT */
-  lookahead = m2c_consume_sym(p->lexer);
+  /* clean up */
+  m2c_fifo_release_queue(import_list);
+  m2c_stats_release(stats);
+  m2c_ast_set_region(NULL);
+  m2c_ast_release_region(region);
   
-  /* libIdent */
-  if (match_token(TOKEN_IDENTIFIER, RESYNC(IDENT_OR_COMMA_OR_SEMICOLON))) {
-    lookahead = m2c_consume_sym(p->lexer);
-    
-    /* collect imported library's module identifier */
-    library_id = m2c_lexer_current_lexeme(p->lexer);
-    m2c_fifo_enqueue_unique(p->import_list, library_id);
-
-    /* '+' */
-    if (match_token(TOKEN_PLUS, RESYNC(IDENT_OR_COMMA_OR_SEMICOLON))) {
-      lookahead = m2c_consume_sym(p->lexer);
-    }
-    else /* resync */ {
-      lookahead = m2c_next_sym(p->lexer);
+  if (*dep_list == NULL) {
+    SET_STATUS(status, M2C_PARSER_STATUS_ALLOCATION_FAILED);
   }
-  else /* resync */ {
-    lookahead = m2c_next_sym(p->lexer);
-  } /* end if */
-
-  /* ( ',' libIdent reExport? )* */
-  while (lookahead == TOKEN_COMMA) {
-    lookahead = m2c_consume_sym(p->lexer);
-
-    /* libIdent */
-    if (match_token(TOKEN_IDENTIFIER, RESYNC(IDENT_OR_COMMA_OR_SEMICOLON))) {
-      lookahead = m2c_consume_sym(p->lexer);
-      
-      /* collect imported library's module identifier */
-      library_id = m2c_lexer_current_lexeme(p->lexer);
-      m2c_fifo_enqueue_unique(p->import_list, library_id);
-
-      /* '+' */
-      if (match_token(TOKEN_PLUS, RESYNC(IDENT_OR_COMMA_OR_SEMICOLON))) {
-        lookahead = m2c_consume_sym(p->lexer);
-      }
-      else /* resync */ {
-        lookahead = m2c_next_sym(p->lexer);
-    }
-    else /* resync */ {
-      lookahead = m2c_next_sym(p->lexer);
-    } /* end if */
-  } /* end while */
-
-  /* ';' */
-  if (match_token(TOKEN_SEMICOLON, RESYNC(IMPORT_OR_DEFINITION_OR_END))) {
-    lookahead = m2c_consume_sym(p->lexer);
-  }
-  else /* resync */ {
-    lookahead = m2c_next_sym(p->lexer);
+  else {
+    SET_STATUS(status, parser_status);
   } /* end if */
   
-  return lookahead;
-} /* end import */
-
-
-/* --------------------------------------------------------------------------
- * private function imp_or_pgm_mod_hdr_and_import()
- * --------------------------------------------------------------------------
- * impOrPgmModHdrAndImport :=
- *   IMPLEMENTATION? MODULE moduleIdent ';'
- *   privateImport* endOfImpAndPgmModImport;
- *   ;
- *
- * endOfImpAndPgmModImport := BEGIN | endOfDefModImport ;
- * ----------------------------------------------------------------------- */
-
-static m2c_token_t private_import (parser_context_t p);
+  return;
+} /* end m2c_parse_imports */
 
-static m2c_token_t imp_or_pgm_mod_hdr_and_import (parser_context_t p) {
-  m2c_token_t lookahead;
-  
-  lookahead = m2c_lookahead_sym(p->lexer);
-  
-  /* IMPLEMENTATION? */
-  if (lookahead == TOKEN_IMPLEMENTATION) {
-    lookahead = m2c_consume_sym(p->lexer);
-  } /* end if */
-  
-  /* MODULE */
-  if (lookahead == TOKEN_MODULE) {
-    lookahead = m2c_consume_sym(p->lexer);
-    
-    /* moduleIdent */
-    if (match_token(TOKEN_IDENTIFIER, RESYNC(IMPORT_OR_DECLARATION_OR_END))) {
-      lookahead = m2c_consume_sym(p->lexer);
-      
-      /* collect module identifier */
-      p->module_id = m2c_lexer_current_lexeme(p->lexer);
-      
-      /* ';' */
-      if (match_token(TOKEN_SEMICOLON, RESYNC(IMPORT_OR_DECLARATION_OR_END))) {
-        lookahead = m2c_consume_sym(p->lexer);
-      }
-      else /* resync */ {
-        lookahead = m2c_next_sym(p->lexer);
-      } /* end if */
-    }
-    else /* resync */ {
-      lookahead = m2c_next_sym(p->lexer);
-    } /* end if */
-  }
-  else /* resync */ {
-    lookahead = m2c_next_sym(p->lexer);
-  } /* end if */
-  
-  /* initialise list for imported libraries */
-  p->import_list = m2c_fifo_new_queue(NULL);
-  
-  /* privateImport* */
-  while (lookahead == TOKEN_IMPORT) {
-    lookahead = private_import(p->lexer);
-  } /* end while */
-  
-  /* endOfImpAndPgmModImport */
-  if (match_set(FIRST(END_OF_MOD_IMPORT), RESYNC(END_OR_EOF))) {
-    m2c_consume_sym(p->lexer);
-  } /* end if */
-  
-  return lookahead;
-} /* end imp_or_pgm_mod_hdr_and_import */
 
+/* *********************************************************************** *
+ * P R I V A T E   F U N C T I O N S                                       *
+ * *********************************************************************** */
 
 /* --------------------------------------------------------------------------
- * private function private_import()
+ * private function collect_ident(node, import_list)
  * --------------------------------------------------------------------------
- * privateImport :=
- *   IMPORT moduleList ';'
- *   ;
- *
- * alias moduleList = identList;
- *
- * identList :=
- *   Ident ( ',' Ident )*
- *   ;
+ * Visitor callback to add the value of identifier nodes to import_list.
  * ----------------------------------------------------------------------- */
 
-static m2c_token_t private_import (parser_context_t p) {
-  m2c_token_t lookahead;
-  intstr_t library_id = NULL;
+static m2c_ast_visit_action_t collect_ident
+  (m2c_astnode_t node, void *import_list) {
   
-  /* IMPORT */
-  lookahead = m2c_consume_sym(p->lexer);
+  intstr_t ident;
   
-  /* moduleList */
-
-  /* Ident */
-  if (match_token(TOKEN_IDENTIFIER, RESYNC(IDENT_OR_COMMA_OR_SEMICOLON))) {
-    lookahead = m2c_consume_sym(p->lexer);
+  if (m2c_ast_nodetype(node) == AST_IDENT) {
+    ident = m2c_ast_value(node);
     
-    /* collect imported library's module identifier */
-    library_id = m2c_lexer_current_lexeme(p->lexer);
-    m2c_fifo_enqueue(p->import_list, library_id);
-  }
-  else /* resync */ {
-    lookahead = m2c_next_sym(p->lexer);
-  } /* end if */
-
-  /* ( ',' Ident )* */
-  while (lookahead == TOKEN_COMMA) {
-    lookahead = m2c_consume_sym(p->lexer);
-
-    /* libIdent */
-    if (match_token(TOKEN_IDENTIFIER, RESYNC(IDENT_OR_COMMA_OR_SEMICOLON))) {
-      lookahead = m2c_consume_sym(p->lexer);
-      
-      /* collect imported library's module identifier */
-      library_id = m2c_lexer_current_lexeme(p->lexer);
-      m2c_fifo_enqueue(p->import_list, library_id);
-   }
-    else /* resync */ {
-      lookahead = m2c_next_sym(p->lexer);
-    } /* end if */
-  } /* end while */
-
-  /* ';' */
-  if (match_token(TOKEN_SEMICOLON, RESYNC(IMPORT_OR_DEFINITION_OR_END))) {
-    lookahead = m2c_consume_sym(p->lexer);
-  }
-  else /* resync */ {
-    lookahead = m2c_next_sym(p->lexer);
+    /* each module once, in order of first import */
+    m2c_fifo_enqueue_unique(import_list, ident);
   } /* end if */
   
-  return lookahead;
-} /* end private_import */
+  return M2C_AST_VISIT_CONTINUE;
+} /* end collect_ident */
 
 
-/* END OF FILE */
\ No newline at end of file
+/* END OF FILE */
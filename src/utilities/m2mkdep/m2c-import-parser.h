@@ -44,10 +44,10 @@
  * imports
  * ----------------------------------------------------------------------- */
 
-#include "../lib/strings/interned-strings.h"
+#include "interned-strings.h"
 
 #include "m2c-dep-list.h"
-#include "m2c-parser-status.h"
+#include "m2c-parser.h"
 
 
 /* --------------------------------------------------------------------------
@@ -56,7 +56,8 @@
  * Parses  the import section of the Modula-2 source file located at src_path
  * and  passes a newly allocated dependency list with identifiers of imported
  * modules back in dep_list, or NULL on failure.  The status of the operation
- * is passed back in status.
+ * is passed back in status.  Uses the header only mode of the main parser,
+ * the source file is read no further than its last import.
  * ----------------------------------------------------------------------- */
  
  void m2c_parse_imports
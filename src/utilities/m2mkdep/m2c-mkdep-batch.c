@@ -0,0 +1,931 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-mkdep-batch.c                                                         *
+ *                                                                           *
+ * Implementation of m2mkdep batch scanning.                                 *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-mkdep-batch.h"
+#include "m2c-import-parser.h"
+#include "m2c-dep-list.h"
+#include "m2c-dep-file.h"
+#include "m2c-pathnames.h"
+#include "m2c-ident-class.h"
+#include "fileutils.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (M2C_MKDEP_PARALLEL)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Initial capacities of batch tables
+ * ----------------------------------------------------------------------- */
+
+#define BATCH_INITIAL_CAPACITY 64
+
+#define BATCH_INITIAL_SLOT_COUNT 128
+
+#define IMPORT_INITIAL_CAPACITY 8
+
+
+/* --------------------------------------------------------------------------
+ * type module_entry_t
+ * --------------------------------------------------------------------------
+ * Record type for the collected dependencies of a module.  Field source
+ * holds the index of the source file recorded for the module,  field
+ * import_capacity the allocated length of array imports.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* module */           intstr_t module;
+  /* source */           uint_t source;
+  /* import_count */     uint_t import_count;
+  /* import_capacity */  uint_t import_capacity;
+  /* imports */          intstr_t *imports;
+} module_entry_t;
+
+
+/* --------------------------------------------------------------------------
+ * hidden type m2c_mkdep_batch_s
+ * --------------------------------------------------------------------------
+ * Record type representing a batch.  Array source holds the paths of the
+ * source files,  array entry the modules in order of first scan.  Array
+ * slot is an open addressing hash table of entry index + 1 by module,
+ * zero marks an empty slot.
+ * ----------------------------------------------------------------------- */
+
+struct m2c_mkdep_batch_s {
+  /* source_count */     uint_t source_count;
+  /* source_capacity */  uint_t source_capacity;
+  /* source */           char **source;
+  /* failed_count */     uint_t failed_count;
+  /* entry_count */      uint_t entry_count;
+  /* entry_capacity */   uint_t entry_capacity;
+  /* entry */            module_entry_t *entry;
+  /* slot_count */       uint_t slot_count;
+  /* slot */             uint_t *slot;
+};
+
+typedef struct m2c_mkdep_batch_s m2c_mkdep_batch_s;
+
+
+/* --------------------------------------------------------------------------
+ * type scan_context_t
+ * --------------------------------------------------------------------------
+ * Record type for the state of a scan shared by its workers.  Field next
+ * holds the index of the next unscanned source,  array result the dependency
+ * list of each scanned source,  or NULL if it failed to parse.  Field
+ * out_of_memory is set if any parse failed for lack of memory.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  /* batch */          m2c_mkdep_batch_t batch;
+  /* next */           uint_t next;
+  /* result */         m2c_dep_list_t *result;
+  /* out_of_memory */  bool out_of_memory;
+#if (M2C_MKDEP_PARALLEL)
+  /* lock */           pthread_mutex_t lock;
+#endif
+} scan_context_t;
+
+
+/* --------------------------------------------------------------------------
+ * forward declarations
+ * ----------------------------------------------------------------------- */
+
+static uint_t scan_worker_count (uint_t jobs, uint_t source_count);
+
+static void *scan_worker (void *context);
+
+static bool add_source (m2c_mkdep_batch_t batch, const char *path);
+
+static bool add_directory (m2c_mkdep_batch_t batch, const char *dir_path);
+
+static bool is_source_name (const char *name);
+
+static module_entry_t *entry_for_module
+  (m2c_mkdep_batch_t batch, intstr_t module, uint_t source);
+
+static bool grow_slot_table (m2c_mkdep_batch_t batch);
+
+static bool merge_imports (module_entry_t *entry, m2c_dep_list_t dep_list);
+
+static void reset_entries (m2c_mkdep_batch_t batch);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_new_batch(status)
+ * --------------------------------------------------------------------------
+ * Returns a new empty batch,  or NULL if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+m2c_mkdep_batch_t m2c_mkdep_new_batch (m2c_mkdep_batch_status_t *status) {
+  
+  m2c_mkdep_batch_t batch;
+  
+  batch = malloc(sizeof(m2c_mkdep_batch_s));
+  
+  if (batch == NULL) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  batch->source_count = 0;
+  batch->source_capacity = BATCH_INITIAL_CAPACITY;
+  batch->source = malloc(BATCH_INITIAL_CAPACITY * sizeof(char *));
+  batch->failed_count = 0;
+  batch->entry_count = 0;
+  batch->entry_capacity = BATCH_INITIAL_CAPACITY;
+  batch->entry = malloc(BATCH_INITIAL_CAPACITY * sizeof(module_entry_t));
+  batch->slot_count = BATCH_INITIAL_SLOT_COUNT;
+  batch->slot = calloc(BATCH_INITIAL_SLOT_COUNT, sizeof(uint_t));
+  
+  if ((batch->source == NULL) ||
+      (batch->entry == NULL) || (batch->slot == NULL)) {
+    m2c_mkdep_release_batch(&batch);
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+    return NULL;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SUCCESS);
+  return batch;
+} /* end m2c_mkdep_new_batch */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_add_path(batch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds the source file at path,  or all sources below directory path.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_add_path
+  (m2c_mkdep_batch_t batch,
+   const char *path,
+   m2c_mkdep_batch_status_t *status) {
+  
+  file_info_t info;
+  bool added;
+  
+  /* check pre-conditions */
+  if ((batch == NULL) || (path == NULL)) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  get_file_info(path, &info);
+  
+  if (info.type == FILE_TYPE_DIRECTORY) {
+    added = add_directory(batch, path);
+  }
+  else if (info.type == FILE_TYPE_REGULAR) {
+    added = add_source(batch, path);
+  }
+  else /* no such file or directory */ {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_PATH_NOT_FOUND);
+    return;
+  } /* end if */
+  
+  if (NOT(added)) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SUCCESS);
+} /* end m2c_mkdep_batch_add_path */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_batch_source_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of source files in batch.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_mkdep_batch_source_count (m2c_mkdep_batch_t batch) {
+  
+  if (batch == NULL) {
+    return 0;
+  } /* end if */
+  
+  return batch->source_count;
+} /* end m2c_mkdep_batch_source_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_scan(batch, jobs, status)
+ * --------------------------------------------------------------------------
+ * Parses the import section of every source file in batch on up to jobs
+ * workers.  All sources share the interned string repository  and the
+ * identifier classifier,  each module identifier is interned once no matter
+ * how many sources import it.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_scan
+  (m2c_mkdep_batch_t batch,
+   uint_t jobs,
+   m2c_mkdep_batch_status_t *status) {
+  
+  scan_context_t scan;
+  module_entry_t *entry;
+  const char *suffix;
+  uint_t index, workers;
+  bool merged;
+#if (M2C_MKDEP_PARALLEL)
+  pthread_t *thread;
+  uint_t started;
+#endif
+  
+  /* check pre-conditions */
+  if (batch == NULL) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  /* a rescan replaces the results of any previous scan */
+  reset_entries(batch);
+  
+  if (batch->source_count == 0) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SUCCESS);
+    return;
+  } /* end if */
+  
+  scan.batch = batch;
+  scan.next = 0;
+  scan.result = calloc(batch->source_count, sizeof(m2c_dep_list_t));
+  scan.out_of_memory = false;
+  
+  if (scan.result == NULL) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  /* install the classifier before any worker interns a lexeme */
+  m2c_ident_class_init();
+  
+  workers = scan_worker_count(jobs, batch->source_count);
+  
+#if (M2C_MKDEP_PARALLEL)
+  thread = NULL;
+  if (workers > 1) {
+    thread = malloc((workers - 1) * sizeof(pthread_t));
+  } /* end if */
+  
+  pthread_mutex_init(&scan.lock, NULL);
+  
+  /* the calling thread is a worker too */
+  started = 0;
+  while ((thread != NULL) && (started < workers - 1) &&
+      (pthread_create(&thread[started], NULL, scan_worker, &scan) == 0)) {
+    started++;
+  } /* end while */
+  
+  scan_worker(&scan);
+  
+  for (index = 0; index < started; index++) {
+    pthread_join(thread[index], NULL);
+  } /* end for */
+  
+  pthread_mutex_destroy(&scan.lock);
+  free(thread);
+#else
+  (void) workers;
+  scan_worker(&scan);
+#endif
+  
+  /* merge in order of sources */
+  merged = NOT(scan.out_of_memory);
+  for (index = 0; index < batch->source_count; index++) {
+    if (scan.result[index] == NULL) {
+      continue;
+    } /* end if */
+    
+    if (merged) {
+      entry = entry_for_module(batch,
+        m2c_dep_list_module(scan.result[index]), index);
+      merged = (entry != NULL) && merge_imports(entry, scan.result[index]);
+    } /* end if */
+    
+    /* prefer the implementation or program module as source of record */
+    suffix = strrchr(batch->source[index], '.');
+    if (merged && (suffix != NULL) && is_mod_suffix(suffix)) {
+      entry->source = index;
+    } /* end if */
+    
+    m2c_dep_list_dispose(&scan.result[index]);
+  } /* end for */
+  
+  free(scan.result);
+  
+  if (NOT(merged)) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+    return;
+  } /* end if */
+  
+  if (batch->failed_count > 0) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SCAN_FAILED);
+    return;
+  } /* end if */
+  
+  SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SUCCESS);
+} /* end m2c_mkdep_batch_scan */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_batch_failed_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of source files of batch that failed to parse.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_mkdep_batch_failed_count (m2c_mkdep_batch_t batch) {
+  
+  if (batch == NULL) {
+    return 0;
+  } /* end if */
+  
+  return batch->failed_count;
+} /* end m2c_mkdep_batch_failed_count */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_batch_module_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules whose dependencies batch has collected.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_mkdep_batch_module_count (m2c_mkdep_batch_t batch) {
+  
+  if (batch == NULL) {
+    return 0;
+  } /* end if */
+  
+  return batch->entry_count;
+} /* end m2c_mkdep_batch_module_count */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_write_dep_files(batch, dep_dir, status)
+ * --------------------------------------------------------------------------
+ * Writes a dependency file and a binary dependency file into directory
+ * dep_dir for every module.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_write_dep_files
+  (m2c_mkdep_batch_t batch,
+   const char *dep_dir,
+   m2c_mkdep_batch_status_t *status) {
+  
+  m2c_dep_file_status_t dep_status;
+  module_entry_t *entry;
+  uint_t index;
+  
+  /* check pre-conditions */
+  if ((batch == NULL) || (dep_dir == NULL)) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  for (index = 0; index < batch->entry_count; index++) {
+    entry = &batch->entry[index];
+    m2c_write_dep_file(dep_dir, entry->module,
+      entry->import_count, entry->imports, &dep_status);
+    
+    if (dep_status == M2C_DEP_FILE_STATUS_SUCCESS) {
+      m2c_write_dep_bin_file(dep_dir, entry->module,
+        entry->import_count, entry->imports, &dep_status);
+    } /* end if */
+    
+    if (dep_status != M2C_DEP_FILE_STATUS_SUCCESS) {
+      if (dep_status == M2C_DEP_FILE_STATUS_ALLOCATION_FAILED) {
+        SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+      }
+      else {
+        SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_WRITE_FAILED);
+      } /* end if */
+      return;
+    } /* end if */
+  } /* end for */
+  
+  SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SUCCESS);
+} /* end m2c_mkdep_batch_write_dep_files */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_update_depdb(batch, db, status)
+ * --------------------------------------------------------------------------
+ * Records the dependencies of every module in dependency database db.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_update_depdb
+  (m2c_mkdep_batch_t batch,
+   m2c_make_depdb_t db,
+   m2c_mkdep_batch_status_t *status) {
+  
+  m2c_make_depdb_status_t db_status;
+  m2c_make_depdb_source_t source;
+  module_entry_t *entry;
+  const char *path;
+  uint_t index;
+  
+  /* check pre-conditions */
+  if ((batch == NULL) || (db == NULL)) {
+    SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_INVALID_REFERENCE);
+    return;
+  } /* end if */
+  
+  for (index = 0; index < batch->entry_count; index++) {
+    entry = &batch->entry[index];
+    path = batch->source[entry->source];
+    
+    if (NOT(m2c_make_depdb_stat_source(path, &source)) ||
+        NOT(m2c_make_depdb_digest_file(path, &source.digest))) {
+      SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_PATH_NOT_FOUND);
+      return;
+    } /* end if */
+    
+    m2c_make_depdb_update(db, entry->module, path, &source,
+      entry->import_count, entry->imports, &db_status);
+    
+    if (db_status != M2C_MAKE_DEPDB_STATUS_SUCCESS) {
+      SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED);
+      return;
+    } /* end if */
+  } /* end for */
+  
+  SET_STATUS(status, M2C_MKDEP_BATCH_STATUS_SUCCESS);
+} /* end m2c_mkdep_batch_update_depdb */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_release_batch(batch)
+ * --------------------------------------------------------------------------
+ * Deallocates batch and passes NULL in batch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_release_batch (m2c_mkdep_batch_t *batch) {
+  
+  uint_t index;
+  
+  if ((batch == NULL) || (*batch == NULL)) {
+    return;
+  } /* end if */
+  
+  if ((*batch)->entry != NULL) {
+    reset_entries(*batch);
+  } /* end if */
+  
+  if ((*batch)->source != NULL) {
+    for (index = 0; index < (*batch)->source_count; index++) {
+      free((*batch)->source[index]);
+    } /* end for */
+  } /* end if */
+  
+  free((*batch)->source);
+  free((*batch)->entry);
+  free((*batch)->slot);
+  free(*batch);
+  *batch = NULL;
+} /* end m2c_mkdep_release_batch */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Private Functions                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * private function scan_worker_count(jobs, source_count)
+ * --------------------------------------------------------------------------
+ * Returns the number of workers to scan source_count sources for a requested
+ * number of jobs,  at least one and at most source_count.
+ * ----------------------------------------------------------------------- */
+
+static uint_t scan_worker_count (uint_t jobs, uint_t source_count) {
+  
+#if (M2C_MKDEP_PARALLEL)
+#if defined(_SC_NPROCESSORS_ONLN)
+  long cpu_count;
+#endif
+  
+  if (jobs == 0) {
+    jobs = M2C_MKDEP_JOBS_PER_PROCESSOR;
+#if defined(_SC_NPROCESSORS_ONLN)
+    cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    
+    if (cpu_count > 1) {
+      jobs = M2C_MKDEP_JOBS_PER_PROCESSOR * (uint_t) cpu_count;
+    } /* end if */
+#endif
+  } /* end if */
+  
+  if (jobs > source_count) {
+    jobs = source_count;
+  } /* end if */
+  
+  if (jobs == 0) {
+    jobs = 1;
+  } /* end if */
+  
+  return jobs;
+#else
+  (void) jobs;
+  (void) source_count;
+  return 1;
+#endif
+} /* end scan_worker_count */
+
+
+/* --------------------------------------------------------------------------
+ * private function scan_worker(context)
+ * --------------------------------------------------------------------------
+ * Worker loop of a scan.  Takes the next unscanned source of the scan passed
+ * in context and parses its imports  until all sources are taken.  Each
+ * parse builds its header AST in a region of its own.  Failed parses are
+ * counted in the batch.  Returns NULL.
+ * ----------------------------------------------------------------------- */
+
+static void *scan_worker (void *context) {
+  
+  m2c_parser_status_t parser_status;
+  m2c_dep_list_t dep_list;
+  scan_context_t *scan;
+  intstr_t src_path;
+  uint_t index;
+  
+  scan = (scan_context_t *) context;
+  
+  while (true) {
+#if (M2C_MKDEP_PARALLEL)
+    pthread_mutex_lock(&scan->lock);
+#endif
+    index = scan->next;
+    if (index < scan->batch->source_count) {
+      scan->next++;
+    } /* end if */
+#if (M2C_MKDEP_PARALLEL)
+    pthread_mutex_unlock(&scan->lock);
+#endif
+    
+    if (index >= scan->batch->source_count) {
+      return NULL;
+    } /* end if */
+    
+    dep_list = NULL;
+    src_path = intstr_for_cstr(scan->batch->source[index], NULL);
+    
+    if (src_path != NULL) {
+      m2c_parse_imports(src_path, &dep_list, &parser_status);
+    }
+    else {
+      parser_status = M2C_PARSER_STATUS_ALLOCATION_FAILED;
+    } /* end if */
+    
+    scan->result[index] = dep_list;
+    
+    if (dep_list == NULL) {
+#if (M2C_MKDEP_PARALLEL)
+      pthread_mutex_lock(&scan->lock);
+#endif
+      if (parser_status == M2C_PARSER_STATUS_ALLOCATION_FAILED) {
+        scan->out_of_memory = true;
+      }
+      else {
+        scan->batch->failed_count++;
+      } /* end if */
+#if (M2C_MKDEP_PARALLEL)
+      pthread_mutex_unlock(&scan->lock);
+#endif
+    } /* end if */
+  } /* end while */
+} /* end scan_worker */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_source(batch, path)
+ * --------------------------------------------------------------------------
+ * Appends a copy of path to the source table of batch.  Returns false if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool add_source (m2c_mkdep_batch_t batch, const char *path) {
+  
+  char **new_table, *copy;
+  size_t length;
+  
+  if (batch->source_count == batch->source_capacity) {
+    new_table =
+      realloc(batch->source, 2 * batch->source_capacity * sizeof(char *));
+    
+    if (new_table == NULL) {
+      return false;
+    } /* end if */
+    
+    batch->source = new_table;
+    batch->source_capacity = 2 * batch->source_capacity;
+  } /* end if */
+  
+  length = strlen(path);
+  copy = malloc(length + 1);
+  
+  if (copy == NULL) {
+    return false;
+  } /* end if */
+  
+  memcpy(copy, path, length + 1);
+  batch->source[batch->source_count] = copy;
+  batch->source_count++;
+  
+  return true;
+} /* end add_source */
+
+
+/* --------------------------------------------------------------------------
+ * private function add_directory(batch, dir_path)
+ * --------------------------------------------------------------------------
+ * Adds all source files in directory dir_path and its descendants to batch.
+ * Entries whose names start with a period are skipped.  Returns false if
+ * allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool add_directory (m2c_mkdep_batch_t batch, const char *dir_path) {
+  
+  struct dirent *dir_entry;
+  size_t dir_length, name_length;
+  file_info_t info;
+  char *path;
+  bool success;
+  DIR *dir;
+  
+  dir = opendir(dir_path);
+  
+  /* an unreadable directory contributes no sources */
+  if (dir == NULL) {
+    return true;
+  } /* end if */
+  
+  dir_length = strlen(dir_path);
+  success = true;
+  
+  while (success && ((dir_entry = readdir(dir)) != NULL)) {
+    if (dir_entry->d_name[0] == '.') {
+      continue;
+    } /* end if */
+    
+    name_length = strlen(dir_entry->d_name);
+    path = malloc(dir_length + name_length + 2);
+    
+    if (path == NULL) {
+      success = false;
+      break;
+    } /* end if */
+    
+    memcpy(path, dir_path, dir_length);
+    path[dir_length] = '/';
+    memcpy(path + dir_length + 1, dir_entry->d_name, name_length + 1);
+    
+    /* one query of the filesystem per entry */
+    get_file_info(path, &info);
+    
+    if (info.type == FILE_TYPE_DIRECTORY) {
+      success = add_directory(batch, path);
+    }
+    else if ((info.type == FILE_TYPE_REGULAR) &&
+             is_source_name(dir_entry->d_name)) {
+      success = add_source(batch, path);
+    } /* end if */
+    
+    free(path);
+  } /* end while */
+  
+  closedir(dir);
+  
+  return success;
+} /* end add_directory */
+
+
+/* --------------------------------------------------------------------------
+ * private function is_source_name(name)
+ * --------------------------------------------------------------------------
+ * Returns true if filename name has suffix .def or .mod,  otherwise false.
+ * ----------------------------------------------------------------------- */
+
+static bool is_source_name (const char *name) {
+  
+  const char *suffix;
+  
+  suffix = strrchr(name, '.');
+  
+  return
+    (suffix != NULL) && (is_def_suffix(suffix) || is_mod_suffix(suffix));
+} /* end is_source_name */
+
+
+/* --------------------------------------------------------------------------
+ * private function entry_for_module(batch, module, source)
+ * --------------------------------------------------------------------------
+ * Returns the entry of module in batch,  appending a new entry with source
+ * file index source if there is none.  Returns NULL if allocation failed.
+ * Entries are looked up by the hash of their interned identifiers,  in
+ * constant expected time.
+ * ----------------------------------------------------------------------- */
+
+static module_entry_t *entry_for_module
+  (m2c_mkdep_batch_t batch, intstr_t module, uint_t source) {
+  
+  module_entry_t *new_table, *entry;
+  uint_t index, mask, slot;
+  
+  /* keep the slot table at most half full */
+  if ((2 * (batch->entry_count + 1) > batch->slot_count) &&
+      NOT(grow_slot_table(batch))) {
+    return NULL;
+  } /* end if */
+  
+  mask = batch->slot_count - 1;
+  index = intstr_hash(module) & mask;
+  
+  while (batch->slot[index] != 0) {
+    slot = batch->slot[index] - 1;
+    if (batch->entry[slot].module == module) {
+      return &batch->entry[slot];
+    } /* end if */
+    index = (index + 1) & mask;
+  } /* end while */
+  
+  if (batch->entry_count == batch->entry_capacity) {
+    new_table = realloc(batch->entry,
+      2 * batch->entry_capacity * sizeof(module_entry_t));
+    
+    if (new_table == NULL) {
+      return NULL;
+    } /* end if */
+    
+    batch->entry = new_table;
+    batch->entry_capacity = 2 * batch->entry_capacity;
+  } /* end if */
+  
+  entry = &batch->entry[batch->entry_count];
+  entry->module = module;
+  entry->source = source;
+  entry->import_count = 0;
+  entry->import_capacity = 0;
+  entry->imports = NULL;
+  batch->entry_count++;
+  
+  batch->slot[index] = batch->entry_count;
+  
+  return entry;
+} /* end entry_for_module */
+
+
+/* --------------------------------------------------------------------------
+ * private function grow_slot_table(batch)
+ * --------------------------------------------------------------------------
+ * Doubles the slot count of batch and reenters all its entries.  Returns
+ * false if allocation failed,  leaving the slot table unchanged.
+ * ----------------------------------------------------------------------- */
+
+static bool grow_slot_table (m2c_mkdep_batch_t batch) {
+  
+  uint_t *new_slot;
+  uint_t entry, index, mask;
+  
+  new_slot = calloc(2 * batch->slot_count, sizeof(uint_t));
+  
+  if (new_slot == NULL) {
+    return false;
+  } /* end if */
+  
+  free(batch->slot);
+  batch->slot = new_slot;
+  batch->slot_count = 2 * batch->slot_count;
+  mask = batch->slot_count - 1;
+  
+  for (entry = 0; entry < batch->entry_count; entry++) {
+    index = intstr_hash(batch->entry[entry].module) & mask;
+    while (batch->slot[index] != 0) {
+      index = (index + 1) & mask;
+    } /* end while */
+    batch->slot[index] = entry + 1;
+  } /* end for */
+  
+  return true;
+} /* end grow_slot_table */
+
+
+/* --------------------------------------------------------------------------
+ * private function merge_imports(entry, dep_list)
+ * --------------------------------------------------------------------------
+ * Appends the imports in dep_list that entry does not yet list to entry,
+ * in order.  Returns false if allocation failed.
+ * ----------------------------------------------------------------------- */
+
+static bool merge_imports (module_entry_t *entry, m2c_dep_list_t dep_list) {
+  
+  uint_t index, count, prior_count, known;
+  intstr_t *new_imports, import_id;
+  
+  count = m2c_dep_list_item_count(dep_list);
+  prior_count = entry->import_count;
+  
+  for (index = 0; index < count; index++) {
+    import_id = m2c_dep_list_item_at_index(dep_list, index);
+    
+    /* the list of each source is free of duplicates already,
+     * only imports of a previously scanned source need checking */
+    known = 0;
+    while ((known < prior_count) && (entry->imports[known] != import_id)) {
+      known++;
+    } /* end while */
+    
+    if (known < prior_count) {
+      continue;
+    } /* end if */
+    
+    /* grow array by doubling */
+    if (entry->import_count == entry->import_capacity) {
+      entry->import_capacity = (entry->import_capacity == 0) ?
+        IMPORT_INITIAL_CAPACITY : 2 * entry->import_capacity;
+      new_imports =
+        realloc(entry->imports, entry->import_capacity * sizeof(intstr_t));
+      
+      if (new_imports == NULL) {
+        return false;
+      } /* end if */
+      
+      entry->imports = new_imports;
+    } /* end if */
+    
+    entry->imports[entry->import_count] = import_id;
+    entry->import_count++;
+  } /* end for */
+  
+  return true;
+} /* end merge_imports */
+
+
+/* --------------------------------------------------------------------------
+ * private procedure reset_entries(batch)
+ * --------------------------------------------------------------------------
+ * Deallocates the import arrays of all entries of batch  and empties its
+ * entry and slot tables.
+ * ----------------------------------------------------------------------- */
+
+static void reset_entries (m2c_mkdep_batch_t batch) {
+  
+  uint_t index;
+  
+  for (index = 0; index < batch->entry_count; index++) {
+    free(batch->entry[index].imports);
+  } /* end for */
+  
+  if (batch->slot != NULL) {
+    memset(batch->slot, 0, batch->slot_count * sizeof(uint_t));
+  } /* end if */
+  
+  batch->entry_count = 0;
+  batch->failed_count = 0;
+} /* end reset_entries */
+
+
+/* END OF FILE */
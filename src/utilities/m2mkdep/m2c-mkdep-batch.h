@@ -0,0 +1,231 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * m2c-mkdep-batch.h                                                         *
+ *                                                                           *
+ * Public interface of m2mkdep batch scanning.                               *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M2C_MKDEP_BATCH_H
+#define M2C_MKDEP_BATCH_H
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-common.h"
+#include "m2c-make-depdb.h"
+#include "m2c-ast.h"
+#include "interned-strings.h"
+
+#include <stdbool.h>
+
+
+/* --------------------------------------------------------------------------
+ * Batch scanning
+ * --------------------------------------------------------------------------
+ * A batch holds the source files of any number of modules,  named one by
+ * one or found by walking directories.  All sources of a batch are scanned
+ * in one run of m2mkdep,  which thus initialises the interned string
+ * repository  and the identifier classifier only once  and interns each
+ * module identifier once for the whole tree.  A module may have both a
+ * definition and an implementation source,  its dependencies are the union
+ * of the imports of both in order of first import.  The results are written
+ * as one dependency file per module  or into a single dependency database.
+ * ----------------------------------------------------------------------- */
+
+
+/* --------------------------------------------------------------------------
+ * Parallel scanning
+ * --------------------------------------------------------------------------
+ * If the interned string repository and the AST regions are built thread
+ * safe,  sources are scanned by a pool of worker threads.  Each worker takes
+ * the next unscanned source,  parses its imports with a lexer and AST region
+ * of its own  and stores the resulting dependency list with the source.
+ * Once all sources are scanned,  the lists are merged in the order in which
+ * the sources were added,  thus the results do not depend on the number of
+ * workers or the order in which their reads complete.  The interned string
+ * repository must have been initialised in concurrent mode.
+ *
+ * Scanning is bound by the latency of reads rather than by processing,  in
+ * particular on network filesystems.  By default there are more workers than
+ * processors  to keep several reads outstanding.
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MKDEP_PARALLEL ((INTSTR_THREAD_SAFE) && (M2C_AST_THREAD_SAFE))
+
+
+/* --------------------------------------------------------------------------
+ * Default number of scanning workers per online processor
+ * ----------------------------------------------------------------------- */
+
+#define M2C_MKDEP_JOBS_PER_PROCESSOR 4
+
+
+/* --------------------------------------------------------------------------
+ * opaque type m2c_mkdep_batch_t
+ * --------------------------------------------------------------------------
+ * Opaque pointer type representing a batch of source files.
+ * ----------------------------------------------------------------------- */
+
+typedef struct m2c_mkdep_batch_s *m2c_mkdep_batch_t;
+
+
+/* --------------------------------------------------------------------------
+ * type m2c_mkdep_batch_status_t
+ * --------------------------------------------------------------------------
+ * Status codes for operations on batches.
+ * ----------------------------------------------------------------------- */
+
+typedef enum {
+  M2C_MKDEP_BATCH_STATUS_SUCCESS,
+  M2C_MKDEP_BATCH_STATUS_INVALID_REFERENCE,
+  M2C_MKDEP_BATCH_STATUS_PATH_NOT_FOUND,
+  M2C_MKDEP_BATCH_STATUS_SCAN_FAILED,
+  M2C_MKDEP_BATCH_STATUS_WRITE_FAILED,
+  M2C_MKDEP_BATCH_STATUS_ALLOCATION_FAILED
+} m2c_mkdep_batch_status_t;
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_new_batch(status)
+ * --------------------------------------------------------------------------
+ * Returns a new empty batch,  or NULL if allocation failed.  Passes the
+ * status of the operation in status.
+ * ----------------------------------------------------------------------- */
+
+m2c_mkdep_batch_t m2c_mkdep_new_batch (m2c_mkdep_batch_status_t *status);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_add_path(batch, path, status)
+ * --------------------------------------------------------------------------
+ * Adds the source file at path to batch.  If path is a directory,  adds all
+ * files with suffix .def or .mod found in the directory and its descendant
+ * directories.  Passes M2C_MKDEP_BATCH_STATUS_PATH_NOT_FOUND in status if
+ * path does not exist.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_add_path
+  (m2c_mkdep_batch_t batch,                 /* in */
+   const char *path,                        /* in */
+   m2c_mkdep_batch_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_batch_source_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of source files in batch.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_mkdep_batch_source_count (m2c_mkdep_batch_t batch);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_scan(batch, jobs, status)
+ * --------------------------------------------------------------------------
+ * Parses the import section of every source file in batch on up to jobs
+ * workers  and collects the dependencies of each module.  If jobs is zero,
+ * M2C_MKDEP_JOBS_PER_PROCESSOR workers per online processor are used.  A
+ * source that fails to parse is skipped and counted,  the remaining sources
+ * are still scanned.  Passes M2C_MKDEP_BATCH_STATUS_SCAN_FAILED in status if
+ * any source failed to parse.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_scan
+  (m2c_mkdep_batch_t batch,                 /* in */
+   uint_t jobs,                             /* in */
+   m2c_mkdep_batch_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_batch_failed_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of source files of batch that failed to parse.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_mkdep_batch_failed_count (m2c_mkdep_batch_t batch);
+
+
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_batch_module_count(batch)
+ * --------------------------------------------------------------------------
+ * Returns the number of modules whose dependencies batch has collected.
+ * ----------------------------------------------------------------------- */
+
+uint_t m2c_mkdep_batch_module_count (m2c_mkdep_batch_t batch);
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_write_dep_files(batch, dep_dir, status)
+ * --------------------------------------------------------------------------
+ * Writes a dependency file and a binary dependency file  into directory
+ * dep_dir  for every module whose dependencies batch has collected.  Files
+ * whose contents are unchanged are left untouched.  Passes the status of
+ * the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_write_dep_files
+  (m2c_mkdep_batch_t batch,                 /* in */
+   const char *dep_dir,                     /* in */
+   m2c_mkdep_batch_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_batch_update_depdb(batch, db, status)
+ * --------------------------------------------------------------------------
+ * Records the dependencies of every module collected by batch in dependency
+ * database db,  together with the path and attributes of its source file,
+ * which is its implementation or program module if it has one.  The caller
+ * writes db.  Passes the status of the operation in status.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_batch_update_depdb
+  (m2c_mkdep_batch_t batch,                 /* in */
+   m2c_make_depdb_t db,                     /* in */
+   m2c_mkdep_batch_status_t *status);       /* out */
+
+
+/* --------------------------------------------------------------------------
+ * procedure m2c_mkdep_release_batch(batch)
+ * --------------------------------------------------------------------------
+ * Deallocates batch and passes NULL in batch.
+ * ----------------------------------------------------------------------- */
+
+void m2c_mkdep_release_batch (m2c_mkdep_batch_t *batch);
+
+
+#endif /* M2C_MKDEP_BATCH_H */
+
+/* END OF FILE */
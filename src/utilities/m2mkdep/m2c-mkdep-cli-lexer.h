@@ -73,7 +73,16 @@ typedef enum {
   MKDEP_CLI_TOKEN_LOWLINE_IDENTIFIERS,     /* --lowline-identifiers */
   MKDEP_CLI_TOKEN_NO_LOWLINE_IDENTIFIERS,  /* --no-lowline-identifiers */
   
-  /* source file argument */
+  /* output options */
+  
+  MKDEP_CLI_TOKEN_DEPDB,                   /* --depdb */
+  MKDEP_CLI_TOKEN_NO_DEPDB,                /* --no-depdb */
+  
+  /* scanning options */
+  
+  MKDEP_CLI_TOKEN_JOBS,                    /* --jobs, -j */
+  
+  /* source file or directory arguments */
   
   MKDEP_CLI_TOKEN_SOURCE_FILE,
   
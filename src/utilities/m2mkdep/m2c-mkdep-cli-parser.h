@@ -75,12 +75,41 @@ mkdep_cli_parser_status_t mkdep_cli_parse_args (void);
 /* ---------------------------------------------------------------------------
  * function mkdep_cli_source_file()
  * ---------------------------------------------------------------------------
- * Returns a string with the source file argument.
+ * Returns a string with the first source file or directory argument.
  * ------------------------------------------------------------------------ */
 
 m2c_string_t mkdep_cli_source_file (void);
 
 
+/* ---------------------------------------------------------------------------
+ * function mkdep_cli_source_count()
+ * ---------------------------------------------------------------------------
+ * Returns the number of source file and directory arguments.
+ * ------------------------------------------------------------------------ */
+
+uint_t mkdep_cli_source_count (void);
+
+
+/* ---------------------------------------------------------------------------
+ * function mkdep_cli_source_at_index(index)
+ * ---------------------------------------------------------------------------
+ * Returns a string with the source file or directory argument at index,  or
+ * NULL if index is out of range.  Arguments are indexed in order given.
+ * ------------------------------------------------------------------------ */
+
+m2c_string_t mkdep_cli_source_at_index (uint_t index);
+
+
+/* ---------------------------------------------------------------------------
+ * function mkdep_cli_job_count()
+ * ---------------------------------------------------------------------------
+ * Returns the number of scanning workers given with option --jobs,  or zero
+ * if the option was not given.
+ * ------------------------------------------------------------------------ */
+
+uint_t mkdep_cli_job_count (void);
+
+
 /* ---------------------------------------------------------------------------
  * function mkdep_cli_error_count()
  * ---------------------------------------------------------------------------
@@ -56,6 +56,7 @@
   /* lexer-debug */ false, \
   /* parser-debug */ false, \
   /* graph-required */ false, \
+  /* depdb-output */ false, \
   /* dollar-identifiers */ false, \
   /* lowline-identifiers */ false \
 } /* default_options */
@@ -139,6 +140,19 @@ bool m2c_mkdep_option_graph_required (void) {
 } /* end m2c_mkdep_option_graph_required */
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_option_depdb_output()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --depdb is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_mkdep_option_depdb_output (void) {
+
+  return options[M2C_MKDEP_OPTION_DEPDB_OUTPUT];
+
+} /* end m2c_mkdep_option_depdb_output */
+
+
 /* --------------------------------------------------------------------------
  * function m2c_mkdep_option_dollar_identifiers()
  * ---------------------------------------------------------------------------
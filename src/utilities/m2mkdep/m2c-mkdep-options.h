@@ -60,6 +60,7 @@ typedef enum {
   /* Output Options */
   
   M2C_MKDEP_OPTION_GRAPH_REQUIRED,         /* --graph, --no-graph */
+  M2C_MKDEP_OPTION_DEPDB_OUTPUT,           /* --depdb, --no-depdb */
 
   /* Capability Options */
   
@@ -121,6 +122,15 @@ bool m2c_mkdep_option_parser_debug (void);
 bool m2c_mkdep_option_graph_required (void);
 
 
+/* --------------------------------------------------------------------------
+ * function m2c_mkdep_option_depdb_output()
+ * ---------------------------------------------------------------------------
+ * Returns true if option --depdb is turned on, else false.
+ * ----------------------------------------------------------------------- */
+
+bool m2c_mkdep_option_depdb_output (void);
+
+
 /* --------------------------------------------------------------------------
  * function m2c_mkdep_option_dollar_identifiers()
  * ---------------------------------------------------------------------------
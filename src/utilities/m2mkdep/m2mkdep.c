@@ -41,12 +41,18 @@
 
 /* get command line arguments */
 
-/* get input file */
+/* initialise interned string repository once,
+ * in concurrent mode if sources are scanned in parallel */
 
-/* obtain import list for input file */
+/* create batch and add each source file or directory argument,
+ * directories are walked for .def and .mod files */
 
-/* determine filename for output file */
+/* scan import lists of all sources in batch on --jobs workers,
+ * sharing the repository and identifier classifier */
 
-/* write dependency file */
+/* if --depdb, open m2make.depdb, record batch in it and write it,
+ * otherwise write one dependency file per module */
+
+/* report sources that failed to parse, release batch */
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,733 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * M2C Modula-2 Compiler & Translator                                        *
+ *                                                                           *
+ * Copyright (c) 2015-2023 Benjamin Kowarsch                                 *
+ *                                                                           *
+ * @synopsis                                                                 *
+ *                                                                           *
+ * M2C is a portable  Modula-2 to C translator  and  via-C compiler  for the *
+ * bootstrap subset of the revised Modula-2 language described in            *
+ *                                                                           *
+ * https://github.com/m2sf/m2bsk/wiki/Language-Specification                 *
+ *                                                                           *
+ * In translator mode,  M2C translates Modula-2 source files to semantically *
+ * equivalent C source files.  In compiler mode,  it translates the Modula-2 *
+ * source files  to C,  then compiles the resulting C sources  to object and *
+ * executable files using the host system's resident C compiler and linker.  *
+ *                                                                           *
+ * Further information at https://github.com/m2sf/m2c/wiki                   *
+ *                                                                           *
+ * @file                                                                     *
+ *                                                                           *
+ * parser-bench.c                                                            *
+ *                                                                           *
+ * Parser throughput benchmark over a corpus of source files or synthetic    *
+ * compilation units, reporting lines/s, AST nodes/s and peak RSS.           *
+ *                                                                           *
+ * @license                                                                  *
+ *                                                                           *
+ * M2C is free software:  You can redistribute and modify it under the terms *
+ * of the GNU Lesser General Public License (LGPL)  either version 2.1 or at *
+ * your choice version 3, both published by the Free Software Foundation.    *
+ *                                                                           *
+ * M2C is distributed in the hope it may be useful, but strictly WITHOUT ANY *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS *
+ * FOR ANY PARTICULAR PURPOSE.  Read the license for more details.           *
+ *                                                                           *
+ * You should have received  a copy of the GNU Lesser General Public License *
+ * along with M2C.  If not, see <https://www.gnu.org/copyleft/lesser.html>.  *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* --------------------------------------------------------------------------
+ * imports
+ * ----------------------------------------------------------------------- */
+
+#include "m2c-parser.h"
+#include "m2c-ll1-parser.h"
+#include "m2c-ast.h"
+#include "m2c-statistics.h"
+#include "interned-strings.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+
+/* --------------------------------------------------------------------------
+ * Benchmark parameters
+ * ----------------------------------------------------------------------- */
+
+#define PASS_COUNT 10
+
+#define DEFAULT_UNIT_COUNT 4
+
+#define DEFAULT_PROC_COUNT 200
+
+#define DEFAULT_NESTING_DEPTH 4
+
+#define DEFAULT_SEED 1
+
+
+/* --------------------------------------------------------------------------
+ * Parser engine
+ * --------------------------------------------------------------------------
+ * The recursive descent parser builds an AST,  the LL(1) table driven
+ * engine only checks syntax,  thus it reports no nodes.  Select with -e.
+ * The recursive descent parser and the AST do not compile yet,  they are
+ * only linked in if PARSEBENCH_RD is defined as 1,  see build.
+ * ----------------------------------------------------------------------- */
+
+#ifndef PARSEBENCH_RD
+#define PARSEBENCH_RD 0
+#endif
+
+typedef enum {
+  ENGINE_RD,
+  ENGINE_LL1
+} engine_t;
+
+#if (PARSEBENCH_RD)
+static engine_t engine = ENGINE_RD;
+#else
+static engine_t engine = ENGINE_LL1;
+#endif
+
+
+/* --------------------------------------------------------------------------
+ * Pseudo random numbers
+ * --------------------------------------------------------------------------
+ * A 32-bit xorshift generator,  so that a given seed always generates the
+ * same corpus on every platform.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long rand_state = DEFAULT_SEED;
+
+static unsigned next_rand (unsigned range) {
+  
+  rand_state ^= (rand_state << 13) & 0xFFFFFFFFUL;
+  rand_state ^= rand_state >> 17;
+  rand_state ^= (rand_state << 5) & 0xFFFFFFFFUL;
+  
+  return (unsigned) (rand_state % range);
+} /* end next_rand */
+
+
+/* --------------------------------------------------------------------------
+ * Synthetic compilation units
+ * --------------------------------------------------------------------------
+ * Each synthetic unit is an implementation module  with CONST, TYPE and VAR
+ * definitions at module level  followed by proc_count procedures.  Bodies
+ * nest IF, CASE, WHILE, REPEAT, LOOP and FOR statements up to depth levels
+ * and expressions up to the same depth,  following the productions of the
+ * grammar in grammar/m2c-grammar.gll.
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  unsigned unit_count;
+  unsigned proc_count;
+  unsigned depth;
+} corpus_params_t;
+
+static const char *var_name[] = { "i", "j", "k", "n", "total", "count" };
+
+#define VAR_NAME_COUNT (sizeof(var_name) / sizeof(var_name[0]))
+
+static const char *add_op[] = { "+", "-", "OR" };
+
+static const char *mul_op[] = { "*", "DIV", "MOD", "AND" };
+
+static const char *rel_op[] = { "=", "#", "<", "<=", ">", ">=" };
+
+
+/* --------------------------------------------------------------------------
+ * procedure indent(file, level)
+ * ----------------------------------------------------------------------- */
+
+static void indent (FILE *file, unsigned level) {
+  
+  while (level > 0) {
+    fputs("  ", file);
+    level--;
+  } /* end while */
+} /* end indent */
+
+
+/* --------------------------------------------------------------------------
+ * procedure write_expression(file, depth)
+ * --------------------------------------------------------------------------
+ * Writes an expression of terms and factors nested up to depth levels.
+ * ----------------------------------------------------------------------- */
+
+static void write_expression (FILE *file, unsigned depth) {
+  
+  switch ((depth == 0) ? next_rand(2) : next_rand(5)) {
+    case 0 :
+      fputs(var_name[next_rand(VAR_NAME_COUNT)], file);
+      break;
+      
+    case 1 :
+      fprintf(file, "%u", next_rand(1000));
+      break;
+      
+    case 2 :
+      write_expression(file, depth - 1);
+      fprintf(file, " %s ", add_op[next_rand(3)]);
+      write_expression(file, depth - 1);
+      break;
+      
+    case 3 :
+      write_expression(file, depth - 1);
+      fprintf(file, " %s ", mul_op[next_rand(4)]);
+      write_expression(file, depth - 1);
+      break;
+      
+    default :
+      fputc('(', file);
+      write_expression(file, depth - 1);
+      fputc(')', file);
+  } /* end switch */
+} /* end write_expression */
+
+
+/* --------------------------------------------------------------------------
+ * procedure write_condition(file, depth)
+ * --------------------------------------------------------------------------
+ * Writes a relational expression between two expressions.
+ * ----------------------------------------------------------------------- */
+
+static void write_condition (FILE *file, unsigned depth) {
+  
+  write_expression(file, depth);
+  fprintf(file, " %s ", rel_op[next_rand(6)]);
+  write_expression(file, depth);
+} /* end write_condition */
+
+
+/* --------------------------------------------------------------------------
+ * procedure write_statement_sequence(file, level, depth)
+ * --------------------------------------------------------------------------
+ * Writes a statement sequence at indentation level  with structured state-
+ * ments nested up to depth levels.  No trailing semicolon or newline.
+ * ----------------------------------------------------------------------- */
+
+static void write_statement (FILE *file, unsigned level, unsigned depth);
+
+static void write_statement_sequence
+  (FILE *file, unsigned level, unsigned depth) {
+  
+  unsigned count;
+  
+  count = 1 + next_rand(3);
+  
+  while (count > 0) {
+    write_statement(file, level, depth);
+    count--;
+    
+    if (count > 0) {
+      fputs(";\n", file);
+    } /* end if */
+  } /* end while */
+} /* end write_statement_sequence */
+
+
+/* --------------------------------------------------------------------------
+ * procedure write_statement(file, level, depth)
+ * --------------------------------------------------------------------------
+ * Writes a simple statement,  or at depth > 0,  a structured statement.
+ * ----------------------------------------------------------------------- */
+
+static void write_statement (FILE *file, unsigned level, unsigned depth) {
+  
+  indent(file, level);
+  
+  switch ((depth == 0) ? next_rand(3) : 3 + next_rand(7)) {
+    case 0 :
+    case 3 :
+      fprintf(file, "%s := ", var_name[next_rand(VAR_NAME_COUNT)]);
+      write_expression(file, depth + 1);
+      break;
+      
+    case 1 :
+      fprintf(file, "%s++", var_name[next_rand(VAR_NAME_COUNT)]);
+      break;
+      
+    case 2 :
+      fprintf(file, "Proc%u(", next_rand(DEFAULT_PROC_COUNT));
+      write_expression(file, 1);
+      fputs(", ", file);
+      write_expression(file, 1);
+      fputs(")", file);
+      break;
+      
+    case 4 :
+      fputs("IF ", file);
+      write_condition(file, depth);
+      fputs(" THEN\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("ELSIF ", file);
+      write_condition(file, depth);
+      fputs(" THEN\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("ELSE\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("END", file);
+      break;
+      
+    case 5 :
+      fprintf(file, "CASE %s OF\n", var_name[next_rand(VAR_NAME_COUNT)]);
+      indent(file, level);
+      fprintf(file, "| %u, %u :\n", next_rand(50), 50 + next_rand(50));
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fprintf(file, "| %u :\n", 100 + next_rand(50));
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("ELSE\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("END", file);
+      break;
+      
+    case 6 :
+      fputs("WHILE ", file);
+      write_condition(file, depth);
+      fputs(" DO\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("END", file);
+      break;
+      
+    case 7 :
+      fputs("REPEAT\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("UNTIL ", file);
+      write_condition(file, depth);
+      break;
+      
+    case 8 :
+      fputs("LOOP\n", file);
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputs(";\n", file);
+      indent(file, level + 1);
+      fputs("EXIT\n", file);
+      indent(file, level);
+      fputs("END", file);
+      break;
+      
+    default :
+      fprintf(file, "FOR %s IN [0 .. %u] OF CARDINAL DO\n",
+        var_name[next_rand(VAR_NAME_COUNT)], 1 + next_rand(100));
+      write_statement_sequence(file, level + 1, depth - 1);
+      fputc('\n', file);
+      indent(file, level);
+      fputs("END", file);
+  } /* end switch */
+} /* end write_statement */
+
+
+/* --------------------------------------------------------------------------
+ * procedure write_procedure(file, index, depth)
+ * --------------------------------------------------------------------------
+ * Writes procedure Proc<index> with parameters,  local variables and a body
+ * nested up to depth levels.
+ * ----------------------------------------------------------------------- */
+
+static void write_procedure (FILE *file, unsigned index, unsigned depth) {
+  
+  fprintf(file, "PROCEDURE Proc%u ( VAR i : CARDINAL; j : INTEGER )"
+    " : CARDINAL;\n", index);
+  fputs("VAR\n  k, n, total, count : CARDINAL;\n\n", file);
+  fputs("BEGIN\n", file);
+  write_statement_sequence(file, 1, depth);
+  fputs(";\n  RETURN ", file);
+  write_expression(file, depth);
+  fprintf(file, "\nEND Proc%u;\n\n", index);
+} /* end write_procedure */
+
+
+/* --------------------------------------------------------------------------
+ * function write_unit(path, name, params)
+ * --------------------------------------------------------------------------
+ * Writes implementation module name to the file at path.  Returns zero on
+ * success, otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int write_unit
+  (const char *path, const char *name, const corpus_params_t *params) {
+  
+  FILE *file;
+  unsigned index;
+  
+  file = fopen(path, "w");
+  
+  if (file == NULL) {
+    fprintf(stderr, "cannot create %s\n", path);
+    return -1;
+  } /* end if */
+  
+  fprintf(file, "IMPLEMENTATION MODULE %s;\n\n", name);
+  fputs("IMPORT Storage, String;\n\n", file);
+  
+  /* module level definitions */
+  fputs("CONST\n", file);
+  for (index = 0; index < 8; index++) {
+    fprintf(file, "  Max%u = ", index);
+    write_expression(file, params->depth);
+    fputs(";\n", file);
+  } /* end for */
+  
+  fputs("\nTYPE\n", file);
+  for (index = 0; index < 8; index++) {
+    fprintf(file, "  Rec%u = RECORD\n    key, value : CARDINAL;\n"
+      "    link : Ptr%u\n  END;\n", index, index);
+    fprintf(file, "  Ptr%u = POINTER TO Rec%u;\n", index, index);
+    fprintf(file, "  Vec%u = ARRAY Max%u OF Rec%u;\n", index, index, index);
+  } /* end for */
+  
+  fputs("\nVAR\n  i, j, k, n, total, count : CARDINAL;\n\n", file);
+  
+  /* procedures */
+  for (index = 0; index < params->proc_count; index++) {
+    write_procedure(file, index, params->depth);
+  } /* end for */
+  
+  /* module body */
+  fputs("BEGIN\n", file);
+  write_statement_sequence(file, 1, params->depth);
+  fprintf(file, "\nEND %s.\n", name);
+  
+  fclose(file);
+  
+  return 0;
+} /* end write_unit */
+
+
+/* --------------------------------------------------------------------------
+ * function line_count(path)
+ * --------------------------------------------------------------------------
+ * Returns the number of lines in the file at path, or zero if it cannot be
+ * opened.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long line_count (const char *path) {
+  
+  FILE *file;
+  unsigned long lines;
+  int ch;
+  
+  file = fopen(path, "r");
+  
+  if (file == NULL) {
+    return 0;
+  } /* end if */
+  
+  lines = 0;
+  while ((ch = fgetc(file)) != EOF) {
+    if (ch == '\n') {
+      lines++;
+    } /* end if */
+  } /* end while */
+  
+  fclose(file);
+  
+  return lines;
+} /* end line_count */
+
+
+/* --------------------------------------------------------------------------
+ * function peak_rss_kb()
+ * --------------------------------------------------------------------------
+ * Returns the peak resident set size of the process in kilobytes.
+ * ----------------------------------------------------------------------- */
+
+static unsigned long peak_rss_kb (void) {
+  
+  struct rusage usage;
+  
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  } /* end if */
+  
+#if defined(__APPLE__)
+  return (unsigned long) usage.ru_maxrss / 1024; /* bytes on macOS */
+#else
+  return (unsigned long) usage.ru_maxrss;
+#endif
+} /* end peak_rss_kb */
+
+
+/* --------------------------------------------------------------------------
+ * type bench_result_t
+ * ----------------------------------------------------------------------- */
+
+typedef struct {
+  unsigned long lines;
+  unsigned long nodes;
+  unsigned long errors;
+  double seconds;
+} bench_result_t;
+
+
+/* --------------------------------------------------------------------------
+ * function parse_file(path, result)
+ * --------------------------------------------------------------------------
+ * Parses the file at path PASS_COUNT times with the selected engine,  the
+ * recursive descent parser building each AST in a fresh region,  and adds
+ * the measurements to result.  Returns zero on success, otherwise -1.
+ * ----------------------------------------------------------------------- */
+
+static int parse_file (const char *path, bench_result_t *result) {
+  
+  m2c_compiler_options_t options;
+#if (PARSEBENCH_RD)
+  m2c_ast_region_t region;
+#endif
+  m2c_parser_status_t status;
+  m2c_stats_t stats;
+  unsigned long nodes, errors;
+  clock_t start, elapsed;
+  int pass;
+  
+  options = m2c_compiler_options_snapshot();
+  
+  nodes = 0;
+  errors = 0;
+  elapsed = 0;
+  
+  for (pass = 0; pass < PASS_COUNT; pass++) {
+#if (PARSEBENCH_RD)
+    region = NULL;
+    
+    if (engine == ENGINE_RD) {
+      region = m2c_ast_new_region(0);
+      
+      if (region == NULL) {
+        fprintf(stderr, "cannot allocate AST region\n");
+        return -1;
+      } /* end if */
+      
+      m2c_ast_set_region(region);
+    } /* end if */
+#endif
+    
+    start = clock();
+#if (PARSEBENCH_RD)
+    if (engine == ENGINE_RD) {
+      m2c_parse_file_with_options(path, options, &stats, &status);
+    }
+    else /* ENGINE_LL1 */ {
+      m2c_ll1_check_file(path, options, &stats, &status);
+    } /* end if */
+#else
+    m2c_ll1_check_file(path, options, &stats, &status);
+#endif
+    elapsed = elapsed + (clock() - start);
+    
+    if (status == M2C_PARSER_STATUS_SYNTAX_ERRORS_FOUND) {
+      errors++;
+    }
+    else if (status != M2C_PARSER_STATUS_SUCCESS) {
+      fprintf(stderr, "cannot parse %s (status %d)\n", path, (int) status);
+#if (PARSEBENCH_RD)
+      if (region != NULL) {
+        m2c_ast_release_region(region);
+      } /* end if */
+#endif
+      return -1;
+    } /* end if */
+    
+    m2c_stats_release(stats);
+    
+#if (PARSEBENCH_RD)
+    if (region != NULL) {
+      nodes = nodes + m2c_ast_region_node_count(region);
+      m2c_ast_release_region(region);
+    } /* end if */
+#endif
+  } /* end for */
+  
+  result->lines = result->lines + line_count(path) * PASS_COUNT;
+  result->nodes = result->nodes + nodes;
+  result->errors = result->errors + errors;
+  result->seconds =
+    result->seconds + ((double) elapsed) / CLOCKS_PER_SEC;
+  
+  return 0;
+} /* end parse_file */
+
+
+/* --------------------------------------------------------------------------
+ * procedure add_result(total, result)
+ * ----------------------------------------------------------------------- */
+
+static void add_result (bench_result_t *total, const bench_result_t *result) {
+  
+  total->lines = total->lines + result->lines;
+  total->nodes = total->nodes + result->nodes;
+  total->errors = total->errors + result->errors;
+  total->seconds = total->seconds + result->seconds;
+} /* end add_result */
+
+
+/* --------------------------------------------------------------------------
+ * procedure print_result(name, result)
+ * --------------------------------------------------------------------------
+ * Prints lines/s and nodes/s of result  and the peak RSS so far.
+ * ----------------------------------------------------------------------- */
+
+static void print_result (const char *name, const bench_result_t *result) {
+  
+  double seconds;
+  
+  seconds = result->seconds;
+  if (seconds <= 0.0) {
+    seconds = 1.0 / CLOCKS_PER_SEC;
+  } /* end if */
+  
+  printf("%-24s %12.0f lines/s %12.0f nodes/s %8lu KB peak RSS",
+    name, ((double) result->lines) / seconds,
+    ((double) result->nodes) / seconds, peak_rss_kb());
+  
+  if (result->errors > 0) {
+    printf(" (%lu passes with syntax errors)", result->errors);
+  } /* end if */
+  
+  printf("\n");
+} /* end print_result */
+
+
+/* --------------------------------------------------------------------------
+ * procedure exit_with_usage()
+ * ----------------------------------------------------------------------- */
+
+static void exit_with_usage (void) {
+  
+  printf("usage:\n");
+  printf(" parser-bench [-e rd|ll1] [-u units] [-p procedures] [-d depth]"
+    " [-s seed]\n");
+  printf(" parser-bench [-e rd|ll1] file1 file2 ...\n");
+  exit(EXIT_FAILURE);
+} /* end exit_with_usage */
+
+
+/* --------------------------------------------------------------------------
+ * main program
+ * --------------------------------------------------------------------------
+ * Parses the .def and .mod files named on the command line,  or if none are
+ * given,  synthetic compilation units  which are written to the current
+ * working directory first.  Prints results per file and for the corpus.
+ * ----------------------------------------------------------------------- */
+
+int main (int argc, char *argv[]) {
+  
+  bench_result_t total, this_result;
+  corpus_params_t params;
+  char name[32], path[40];
+  unsigned index;
+  int arg_index;
+  
+  intstr_init_repo(0, NULL);
+  
+  memset(&total, 0, sizeof(bench_result_t));
+  
+  params.unit_count = DEFAULT_UNIT_COUNT;
+  params.proc_count = DEFAULT_PROC_COUNT;
+  params.depth = DEFAULT_NESTING_DEPTH;
+  
+  /* corpus parameters */
+  arg_index = 1;
+  while ((arg_index < argc) && (argv[arg_index][0] == '-')) {
+    if ((arg_index + 1 >= argc) || (argv[arg_index][2] != '\0')) {
+      exit_with_usage();
+    } /* end if */
+    
+    switch (argv[arg_index][1]) {
+      case 'u' :
+        params.unit_count = (unsigned) strtoul(argv[arg_index + 1], NULL, 10);
+        break;
+        
+      case 'p' :
+        params.proc_count = (unsigned) strtoul(argv[arg_index + 1], NULL, 10);
+        break;
+        
+      case 'd' :
+        params.depth = (unsigned) strtoul(argv[arg_index + 1], NULL, 10);
+        break;
+        
+      case 'e' :
+        if ((PARSEBENCH_RD) && (strcmp(argv[arg_index + 1], "rd") == 0)) {
+          engine = ENGINE_RD;
+        }
+        else if (strcmp(argv[arg_index + 1], "ll1") == 0) {
+          engine = ENGINE_LL1;
+        }
+        else /* unknown engine */ {
+          exit_with_usage();
+        } /* end if */
+        break;
+        
+      case 's' :
+        rand_state = strtoul(argv[arg_index + 1], NULL, 10);
+        if (rand_state == 0) {
+          rand_state = DEFAULT_SEED;
+        } /* end if */
+        break;
+        
+      default :
+        exit_with_usage();
+    } /* end switch */
+    
+    arg_index = arg_index + 2;
+  } /* end while */
+  
+  if (arg_index >= argc) {
+    /* synthetic compilation units */
+    for (index = 0; index < params.unit_count; index++) {
+      sprintf(name, "Bench%u", index);
+      sprintf(path, "%s.mod", name);
+      
+      if (write_unit(path, name, &params) != 0) {
+        return EXIT_FAILURE;
+      } /* end if */
+      
+      memset(&this_result, 0, sizeof(bench_result_t));
+      if (parse_file(path, &this_result) == 0) {
+        print_result(path, &this_result);
+        add_result(&total, &this_result);
+      } /* end if */
+      
+      remove(path);
+    } /* end for */
+  }
+  else /* corpus from command line */ {
+    while (arg_index < argc) {
+      memset(&this_result, 0, sizeof(bench_result_t));
+      if (parse_file(argv[arg_index], &this_result) == 0) {
+        print_result(argv[arg_index], &this_result);
+        add_result(&total, &this_result);
+      } /* end if */
+      arg_index++;
+    } /* end while */
+  } /* end if */
+  
+  print_result("total", &total);
+  
+  return EXIT_SUCCESS;
+} /* end main */
+
+
+/* END OF FILE */